@@ -9,6 +9,11 @@
 
 namespace flutter {
 
+// The stride at which Prefetch touches the mappings of assets. Reading one
+// byte of every page of a memory mapped asset makes the kernel read the whole
+// asset.
+static constexpr size_t kPrefetchStride = 4096;
+
 AssetManager::AssetManager() = default;
 
 AssetManager::~AssetManager() = default;
@@ -18,6 +23,7 @@ void AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
     return;
   }
 
+  ClearResolverIndex();
   resolvers_.push_front(std::move(resolver));
 }
 
@@ -26,6 +32,7 @@ void AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
     return;
   }
 
+  ClearResolverIndex();
   resolvers_.push_back(std::move(resolver));
 }
 
@@ -50,13 +57,35 @@ void AssetManager::UpdateResolverByType(
   if (!updated) {
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
+  ClearResolverIndex();
   resolvers_.swap(new_resolvers);
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  ClearResolverIndex();
   return std::move(resolvers_);
 }
 
+void AssetManager::ClearResolverIndex() {
+  std::scoped_lock lock(resolver_index_mutex_);
+  resolver_index_.clear();
+}
+
+void AssetManager::Prefetch(const std::vector<std::string>& asset_names) const {
+  TRACE_EVENT0("flutter", "AssetManager::Prefetch");
+  for (const std::string& asset_name : asset_names) {
+    std::unique_ptr<fml::Mapping> mapping = GetAsMapping(asset_name);
+    if (mapping == nullptr || mapping->GetMapping() == nullptr) {
+      continue;
+    }
+    const volatile uint8_t* bytes = mapping->GetMapping();
+    for (size_t offset = 0; offset < mapping->GetSize();
+         offset += kPrefetchStride) {
+      [[maybe_unused]] uint8_t byte = bytes[offset];
+    }
+  }
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -65,9 +94,28 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  const AssetResolver* indexed_resolver = nullptr;
+  {
+    std::scoped_lock lock(resolver_index_mutex_);
+    auto it = resolver_index_.find(asset_name);
+    if (it != resolver_index_.end()) {
+      indexed_resolver = it->second;
+    }
+  }
+  if (indexed_resolver) {
+    auto mapping = indexed_resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      return mapping;
+    }
+  }
   for (const auto& resolver : resolvers_) {
+    if (resolver.get() == indexed_resolver) {
+      continue;
+    }
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
+      std::scoped_lock lock(resolver_index_mutex_);
+      resolver_index_[asset_name] = resolver.get();
       return mapping;
     }
   }
@@ -7,7 +7,10 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
@@ -56,6 +59,18 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Reads the assets with the given names so that they are in
+  ///             the page cache by the time they are loaded. Names that are
+  ///             not found are skipped.
+  ///
+  ///             This blocks on I/O, so it should be called on a background
+  ///             thread.
+  ///
+  /// @param[in]  asset_names  The names of the assets to read.
+  ///
+  void Prefetch(const std::vector<std::string>& asset_names) const;
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -77,6 +92,15 @@ class AssetManager final : public AssetResolver {
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
+  // The resolver that found each asset that has been looked up, so that
+  // lookups of the asset probe that resolver first instead of every resolver
+  // in front of it. Cleared whenever the resolvers change.
+  mutable std::mutex resolver_index_mutex_;
+  mutable std::unordered_map<std::string, const AssetResolver*>
+      resolver_index_;
+
+  void ClearResolverIndex();
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
 
@@ -0,0 +1,193 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Serves the given assets from memory and counts the lookups made through
+// it, found or not.
+class TestAssetResolver : public AssetResolver {
+ public:
+  TestAssetResolver(std::map<std::string, std::string> assets,
+                    AssetResolverType type = kDirectoryAssetBundle)
+      : assets_(std::move(assets)), type_(type) {}
+
+  size_t lookup_count() const { return lookup_count_; }
+
+  void Remove(const std::string& asset_name) { assets_.erase(asset_name); }
+
+  // |AssetResolver|
+  bool IsValid() const override { return true; }
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  // |AssetResolver|
+  AssetResolverType GetType() const override { return type_; }
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    lookup_count_++;
+    auto found = assets_.find(asset_name);
+    if (found == assets_.end()) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(found->second);
+  }
+
+ private:
+  std::map<std::string, std::string> assets_;
+  const AssetResolverType type_;
+  mutable size_t lookup_count_ = 0;
+};
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  if (!mapping) {
+    return "<null>";
+  }
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+}  // namespace
+
+TEST(AssetManagerTest, LooksUpIndexedAssetsInTheirResolverFirst) {
+  AssetManager manager;
+  auto front = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "front a"}});
+  auto back = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "back a"}, {"b", "back b"}});
+  TestAssetResolver* front_resolver = front.get();
+  TestAssetResolver* back_resolver = back.get();
+  manager.PushBack(std::move(front));
+  manager.PushBack(std::move(back));
+
+  EXPECT_EQ(ToString(manager.GetAsMapping("b")), "back b");
+  EXPECT_EQ(front_resolver->lookup_count(), 1u);
+  EXPECT_EQ(back_resolver->lookup_count(), 1u);
+
+  // The second lookup goes straight to the resolver that found the asset.
+  EXPECT_EQ(ToString(manager.GetAsMapping("b")), "back b");
+  EXPECT_EQ(front_resolver->lookup_count(), 1u);
+  EXPECT_EQ(back_resolver->lookup_count(), 2u);
+
+  // The resolvers in front still take precedence for other assets.
+  EXPECT_EQ(ToString(manager.GetAsMapping("a")), "front a");
+  EXPECT_EQ(back_resolver->lookup_count(), 2u);
+}
+
+TEST(AssetManagerTest, DoesNotIndexMissingAssets) {
+  AssetManager manager;
+  auto resolver = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "a"}});
+  TestAssetResolver* test_resolver = resolver.get();
+  manager.PushBack(std::move(resolver));
+
+  EXPECT_FALSE(manager.GetAsMapping("missing"));
+  EXPECT_FALSE(manager.GetAsMapping("missing"));
+  EXPECT_EQ(test_resolver->lookup_count(), 2u);
+  EXPECT_FALSE(manager.GetAsMapping(""));
+  EXPECT_EQ(test_resolver->lookup_count(), 2u);
+}
+
+TEST(AssetManagerTest, FallsBackWhenTheIndexedResolverLosesTheAsset) {
+  AssetManager manager;
+  auto front = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "front a"}});
+  auto back = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "back a"}});
+  TestAssetResolver* front_resolver = front.get();
+  manager.PushBack(std::move(front));
+  manager.PushBack(std::move(back));
+
+  EXPECT_EQ(ToString(manager.GetAsMapping("a")), "front a");
+  front_resolver->Remove("a");
+  EXPECT_EQ(ToString(manager.GetAsMapping("a")), "back a");
+}
+
+TEST(AssetManagerTest, ClearsTheIndexWhenTheResolversChange) {
+  AssetManager manager;
+  manager.PushBack(std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "first a"}}));
+  EXPECT_EQ(ToString(manager.GetAsMapping("a")), "first a");
+
+  // A resolver pushed in front shadows the indexed one.
+  manager.PushFront(std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "second a"}},
+      AssetResolver::kApkAssetProvider));
+  EXPECT_EQ(ToString(manager.GetAsMapping("a")), "second a");
+
+  // The indexed resolver is replaced, and must not be used after it's gone.
+  manager.UpdateResolverByType(
+      std::make_unique<TestAssetResolver>(
+          std::map<std::string, std::string>{{"a", "third a"}},
+          AssetResolver::kApkAssetProvider),
+      AssetResolver::kApkAssetProvider);
+  EXPECT_EQ(ToString(manager.GetAsMapping("a")), "third a");
+
+  // The indexed resolvers are taken away.
+  auto resolvers = manager.TakeResolvers();
+  EXPECT_EQ(resolvers.size(), 2u);
+  resolvers.clear();
+  EXPECT_FALSE(manager.GetAsMapping("a"));
+}
+
+TEST(AssetManagerTest, PrefetchLooksUpEachAssetOnce) {
+  // Spans several pages, the last of which is only touched at its first byte.
+  const std::string large(3 * 4096 + 1, 'b');
+  AssetManager manager;
+  auto front = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a", "a"}});
+  auto back = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"b", large}, {"empty", ""}});
+  TestAssetResolver* front_resolver = front.get();
+  TestAssetResolver* back_resolver = back.get();
+  manager.PushBack(std::move(front));
+  manager.PushBack(std::move(back));
+
+  // Missing and empty assets are skipped.
+  manager.Prefetch({"a", "b", "missing", "empty", ""});
+  EXPECT_EQ(front_resolver->lookup_count(), 4u);
+  EXPECT_EQ(back_resolver->lookup_count(), 3u);
+
+  // The prefetched assets are indexed like the loaded ones.
+  EXPECT_EQ(ToString(manager.GetAsMapping("b")), large);
+  EXPECT_EQ(front_resolver->lookup_count(), 4u);
+}
+
+TEST(AssetManagerTest, PrefetchReadsMappedFiles) {
+  fml::ScopedTemporaryDirectory assets_dir;
+  const std::string contents(64 * 1024, 'x');
+  ASSERT_TRUE(fml::WriteAtomically(assets_dir.fd(), "asset",
+                                   fml::DataMapping(contents)));
+
+  AssetManager manager;
+  manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::Duplicate(assets_dir.fd().get()), false));
+  manager.Prefetch({"asset", "missing"});
+  EXPECT_EQ(ToString(manager.GetAsMapping("asset")), contents);
+
+  // Prefetching without resolvers does nothing.
+  AssetManager empty_manager;
+  empty_manager.Prefetch({"asset"});
+}
+
+}  // namespace testing
+}  // namespace flutter
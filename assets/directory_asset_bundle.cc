@@ -70,6 +70,7 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
   }
 
   std::regex asset_regex(asset_pattern);
+  std::vector<std::pair<std::string, fml::UniqueFD>> files;
   fml::FileVisitor visitor = [&](const fml::UniqueFD& directory,
                                  const std::string& filename) {
     TRACE_EVENT0("flutter", "DirectoryAssetBundle::GetAsMappings FileVisitor");
@@ -84,13 +85,10 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
         return true;
       }
 
-      auto mapping = std::make_unique<fml::FileMapping>(fd);
-
-      if (mapping && mapping->IsValid()) {
-        mappings.push_back(std::move(mapping));
-      } else {
-        FML_LOG(ERROR) << "Mapping " << filename << " failed";
-      }
+      // The reads of all of the matched files are started here, so that
+      // they overlap instead of each one blocking on its first access.
+      fml::PrefetchFile(fd);
+      files.push_back({filename, std::move(fd)});
     }
     return true;
   };
@@ -107,6 +105,17 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     fml::VisitFiles(subdir_fd, visitor);
   }
 
+  mappings.reserve(files.size());
+  for (const auto& [filename, fd] : files) {
+    auto mapping = std::make_unique<fml::FileMapping>(fd);
+
+    if (mapping && mapping->IsValid()) {
+      mappings.push_back(std::move(mapping));
+    } else {
+      FML_LOG(ERROR) << "Mapping " << filename << " failed";
+    }
+  }
+
   return mappings;
 }
 
@@ -0,0 +1,243 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <cstring>
+#include <limits>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+static constexpr char kMagic[] = "FLTPACK1";
+static constexpr size_t kMagicSize = 8;
+static constexpr size_t kHeaderSize = kMagicSize + 8;
+static constexpr size_t kIndexRecordSize = 40;
+// Deflate can't compress data by more than this ratio, so a larger inflated
+// size can only come from a corrupt index.
+static constexpr uint64_t kMaxDeflateRatio = 1032;
+
+static uint64_t ReadLittleEndian(const uint8_t* bytes, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++) {
+    value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return value;
+}
+
+PackedAssetBundle::PackedAssetBundle(fml::UniqueFD file,
+                                     bool is_valid_after_asset_manager_change) {
+  if (!file.is_valid()) {
+    return;
+  }
+  auto mapping = std::make_shared<fml::FileMapping>(file);
+  if (!mapping->IsValid()) {
+    return;
+  }
+  mapping_ = std::move(mapping);
+  if (!ReadIndex()) {
+    FML_LOG(ERROR) << "Invalid packed asset bundle.";
+    entries_.clear();
+    return;
+  }
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+bool PackedAssetBundle::ReadIndex() {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::ReadIndex");
+  const uint8_t* file = mapping_->GetMapping();
+  const uint64_t file_size = mapping_->GetSize();
+  if (file_size < kHeaderSize || ::memcmp(file, kMagic, kMagicSize) != 0) {
+    return false;
+  }
+  const uint64_t entry_count = ReadLittleEndian(file + kMagicSize, 4);
+  if (entry_count > (file_size - kHeaderSize) / kIndexRecordSize) {
+    return false;
+  }
+  entries_.reserve(entry_count);
+  for (uint64_t i = 0; i < entry_count; i++) {
+    const uint8_t* record = file + kHeaderSize + i * kIndexRecordSize;
+    const uint64_t name_offset = ReadLittleEndian(record, 4);
+    const uint64_t name_size = ReadLittleEndian(record + 4, 4);
+    const uint64_t data_offset = ReadLittleEndian(record + 8, 8);
+    const uint64_t stored_size = ReadLittleEndian(record + 16, 8);
+    const uint64_t size = ReadLittleEndian(record + 24, 8);
+    const uint64_t compression = ReadLittleEndian(record + 32, 4);
+    if (name_offset > file_size || name_size > file_size - name_offset ||
+        data_offset > file_size || stored_size > file_size - data_offset) {
+      return false;
+    }
+    Entry entry;
+    entry.data = file + data_offset;
+    entry.stored_size = stored_size;
+    entry.size = size;
+    switch (compression) {
+      case static_cast<uint32_t>(Compression::kNone):
+        if (stored_size != size) {
+          return false;
+        }
+        entry.compression = Compression::kNone;
+        break;
+      case static_cast<uint32_t>(Compression::kZlib):
+        if (size / kMaxDeflateRatio > stored_size ||
+            size > std::numeric_limits<size_t>::max() ||
+            size > std::numeric_limits<uLongf>::max() ||
+            stored_size > std::numeric_limits<uLong>::max()) {
+          return false;
+        }
+        entry.compression = Compression::kZlib;
+        break;
+      default:
+        return false;
+    }
+    entries_.emplace(
+        std::string(reinterpret_cast<const char*>(file + name_offset),
+                    name_size),
+        entry);
+  }
+  return true;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+std::shared_ptr<const std::vector<uint8_t>>
+PackedAssetBundle::FindInflatedLocked(const std::string& asset_name) const {
+  for (auto it = inflated_.begin(); it != inflated_.end(); ++it) {
+    if (it->first == asset_name) {
+      inflated_.splice(inflated_.begin(), inflated_, it);
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> PackedAssetBundle::GetInflated(
+    const std::string& asset_name,
+    const Entry& entry) const {
+  {
+    std::scoped_lock lock(inflated_mutex_);
+    if (auto data = FindInflatedLocked(asset_name)) {
+      return data;
+    }
+  }
+
+  TRACE_EVENT1("flutter", "PackedAssetBundle::Inflate", "name",
+               asset_name.c_str());
+  auto data = std::make_shared<std::vector<uint8_t>>(entry.size);
+  // The index checked that the sizes fit in the zlib types.
+  uLongf size = static_cast<uLongf>(entry.size);
+  if (::uncompress(data->data(), &size, entry.data,
+                   static_cast<uLong>(entry.stored_size)) != Z_OK ||
+      size != entry.size) {
+    FML_LOG(ERROR) << "Could not inflate asset: " << asset_name;
+    return nullptr;
+  }
+
+  if (entry.size <= kInflatedCacheLimit) {
+    std::scoped_lock lock(inflated_mutex_);
+    // Another thread may have inflated the same entry in the meantime.
+    if (auto cached = FindInflatedLocked(asset_name)) {
+      return cached;
+    }
+    inflated_.emplace_front(asset_name, data);
+    inflated_size_ += entry.size;
+    while (inflated_size_ > kInflatedCacheLimit) {
+      inflated_size_ -= inflated_.back().second->size();
+      inflated_.pop_back();
+    }
+  }
+  return data;
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetEntryMapping(
+    const std::string& asset_name,
+    const Entry& entry) const {
+  if (entry.compression == Compression::kNone) {
+    // The file stays mapped while the asset is used, even if the resolver is
+    // destroyed first.
+    auto file = mapping_;
+    return std::make_unique<fml::NonOwnedMapping>(
+        entry.data, entry.size,
+        [file](const uint8_t* data, size_t size) {},
+        mapping_->IsDontNeedSafe());
+  }
+  std::shared_ptr<const std::vector<uint8_t>> data =
+      GetInflated(asset_name, entry);
+  if (!data) {
+    return nullptr;
+  }
+  return std::make_unique<fml::NonOwnedMapping>(
+      data->data(), data->size(),
+      [data](const uint8_t* bytes, size_t size) {});
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+  auto it = entries_.find(asset_name);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  return GetEntryMapping(it->first, it->second);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  // Like DirectoryAssetBundle, the pattern matches the file names of the
+  // assets anywhere in the bundle, or only directly in |subdir| if given.
+  std::regex asset_regex(asset_pattern);
+  for (const auto& [name, entry] : entries_) {
+    size_t separator = name.rfind('/');
+    std::string directory =
+        separator == std::string::npos ? "" : name.substr(0, separator);
+    std::string filename =
+        separator == std::string::npos ? name : name.substr(separator + 1);
+    if (subdir && directory != subdir.value()) {
+      continue;
+    }
+    if (!std::regex_match(filename, asset_regex)) {
+      continue;
+    }
+    auto mapping = GetEntryMapping(name, entry);
+    if (mapping) {
+      mappings.push_back(std::move(mapping));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace flutter
@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// An asset resolver for a single file that packs all the assets of a bundle,
+/// which saves opening a file per asset. Each entry may be stored compressed
+/// with zlib. The file is memory mapped, so uncompressed entries are served
+/// without copying, and compressed entries are inflated on first access. The
+/// most recently used inflated entries are kept in memory.
+///
+/// All integers in the file are little endian. The file starts with a header:
+///
+///   uint8_t  magic[8]     "FLTPACK1"
+///   uint32_t entry_count
+///   uint32_t reserved
+///
+/// followed by |entry_count| index records:
+///
+///   uint32_t name_offset  offset of the name from the start of the file
+///   uint32_t name_size
+///   uint64_t data_offset  offset of the data from the start of the file
+///   uint64_t stored_size  size of the data in the file
+///   uint64_t size         size of the asset
+///   uint32_t compression  0 for none, 1 for zlib
+///   uint32_t reserved
+///
+/// The names and the data can be anywhere after the index. Names are paths
+/// relative to the root of the bundle, separated by '/'.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  // The name of the packed bundle in the assets directory of an application.
+  static constexpr char kFileName[] = "assets.pack";
+
+  PackedAssetBundle(fml::UniqueFD file,
+                    bool is_valid_after_asset_manager_change);
+
+  ~PackedAssetBundle() override;
+
+ private:
+  enum class Compression : uint32_t {
+    kNone = 0,
+    kZlib = 1,
+  };
+
+  struct Entry {
+    const uint8_t* data;
+    size_t stored_size;
+    size_t size;
+    Compression compression;
+  };
+
+  // The bytes of inflated entries that are kept in memory.
+  static constexpr size_t kInflatedCacheLimit = 4 * 1024 * 1024;
+
+  std::shared_ptr<fml::FileMapping> mapping_;
+  std::unordered_map<std::string, Entry> entries_;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  // The most recently used inflated entries, the most recent first.
+  mutable std::mutex inflated_mutex_;
+  mutable std::list<std::pair<std::string,
+                              std::shared_ptr<const std::vector<uint8_t>>>>
+      inflated_;
+  mutable size_t inflated_size_ = 0;
+
+  bool ReadIndex();
+
+  // Returns the inflated entry named |asset_name| and marks it as the most
+  // recently used, or nullptr if it is not in memory.
+  std::shared_ptr<const std::vector<uint8_t>> FindInflatedLocked(
+      const std::string& asset_name) const;
+
+  std::shared_ptr<const std::vector<uint8_t>> GetInflated(
+      const std::string& asset_name,
+      const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> GetEntryMapping(const std::string& asset_name,
+                                                const Entry& entry) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -0,0 +1,208 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct TestEntry {
+  std::string name;
+  std::vector<uint8_t> data;
+  uint32_t compression;
+  uint64_t size;
+};
+
+void AppendLittleEndian(std::vector<uint8_t>& bytes,
+                        uint64_t value,
+                        size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+// Writes the entries in the format described in packed_asset_bundle.h, with
+// the names and the data following the index.
+std::vector<uint8_t> Pack(const std::vector<TestEntry>& entries) {
+  std::vector<uint8_t> bytes = {'F', 'L', 'T', 'P', 'A', 'C', 'K', '1'};
+  AppendLittleEndian(bytes, entries.size(), 4);
+  AppendLittleEndian(bytes, 0, 4);
+
+  uint64_t offset = bytes.size() + entries.size() * 40;
+  for (const TestEntry& entry : entries) {
+    AppendLittleEndian(bytes, offset, 4);
+    AppendLittleEndian(bytes, entry.name.size(), 4);
+    AppendLittleEndian(bytes, offset + entry.name.size(), 8);
+    AppendLittleEndian(bytes, entry.data.size(), 8);
+    AppendLittleEndian(bytes, entry.size, 8);
+    AppendLittleEndian(bytes, entry.compression, 4);
+    AppendLittleEndian(bytes, 0, 4);
+    offset += entry.name.size() + entry.data.size();
+  }
+  for (const TestEntry& entry : entries) {
+    bytes.insert(bytes.end(), entry.name.begin(), entry.name.end());
+    bytes.insert(bytes.end(), entry.data.begin(), entry.data.end());
+  }
+  return bytes;
+}
+
+TestEntry Stored(const std::string& name, const std::string& contents) {
+  return {name, std::vector<uint8_t>(contents.begin(), contents.end()), 0,
+          contents.size()};
+}
+
+TestEntry Deflated(const std::string& name,
+                   const std::vector<uint8_t>& contents) {
+  uLongf size = ::compressBound(contents.size());
+  std::vector<uint8_t> data(size);
+  EXPECT_EQ(::compress(data.data(), &size, contents.data(), contents.size()),
+            Z_OK);
+  data.resize(size);
+  return {name, std::move(data), 1, contents.size()};
+}
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+class PackedAssetBundleTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<AssetResolver> Open(std::vector<uint8_t> bytes) {
+    std::string name = "assets" + std::to_string(file_count_++) + ".pack";
+    EXPECT_TRUE(fml::WriteAtomically(dir_.fd(), name.c_str(),
+                                     fml::DataMapping(std::move(bytes))));
+    return std::make_unique<PackedAssetBundle>(
+        fml::OpenFileReadOnly(dir_.fd(), name.c_str()), false);
+  }
+
+ private:
+  fml::ScopedTemporaryDirectory dir_;
+  int file_count_ = 0;
+};
+
+}  // namespace
+
+TEST_F(PackedAssetBundleTest, ServesStoredEntries) {
+  auto bundle = Open(Pack({Stored("a.txt", "alpha"), Stored("b/c.txt", "")}));
+  ASSERT_TRUE(bundle->IsValid());
+
+  auto a = bundle->GetAsMapping("a.txt");
+  ASSERT_TRUE(a);
+  EXPECT_EQ(ToString(*a), "alpha");
+  auto c = bundle->GetAsMapping("b/c.txt");
+  ASSERT_TRUE(c);
+  EXPECT_EQ(c->GetSize(), 0u);
+  EXPECT_FALSE(bundle->GetAsMapping("c.txt"));
+
+  auto mappings = bundle->GetAsMappings(".*\\.txt", "b");
+  ASSERT_EQ(mappings.size(), 1u);
+  EXPECT_EQ(mappings[0]->GetSize(), 0u);
+}
+
+TEST_F(PackedAssetBundleTest, InflatesDeflatedEntries) {
+  std::string contents(1000, 'x');
+  auto bundle = Open(Pack({Deflated(
+      "a.txt", std::vector<uint8_t>(contents.begin(), contents.end()))}));
+  ASSERT_TRUE(bundle->IsValid());
+
+  auto a = bundle->GetAsMapping("a.txt");
+  ASSERT_TRUE(a);
+  EXPECT_EQ(ToString(*a), contents);
+}
+
+TEST_F(PackedAssetBundleTest, RejectsTruncatedHeaders) {
+  std::vector<uint8_t> bytes = Pack({Stored("a.txt", "alpha")});
+
+  EXPECT_FALSE(Open(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 12))
+                   ->IsValid());
+
+  std::vector<uint8_t> bad_magic = bytes;
+  bad_magic[7] = '2';
+  EXPECT_FALSE(Open(bad_magic)->IsValid());
+
+  // The index doesn't fit in the file.
+  std::vector<uint8_t> truncated_index(bytes.begin(), bytes.begin() + 40);
+  EXPECT_FALSE(Open(truncated_index)->IsValid());
+
+  std::vector<uint8_t> too_many_entries = bytes;
+  too_many_entries[8] = 2;
+  EXPECT_FALSE(Open(too_many_entries)->IsValid());
+}
+
+TEST_F(PackedAssetBundleTest, RejectsCorruptIndexRecords) {
+  // The data extends past the end of the file.
+  std::vector<uint8_t> truncated_data = Pack({Stored("a.txt", "alpha")});
+  truncated_data.pop_back();
+  EXPECT_FALSE(Open(truncated_data)->IsValid());
+
+  TestEntry wrong_size = Stored("a.txt", "alpha");
+  wrong_size.size = 6;
+  EXPECT_FALSE(Open(Pack({wrong_size}))->IsValid());
+
+  TestEntry unknown_compression = Stored("a.txt", "alpha");
+  unknown_compression.compression = 2;
+  EXPECT_FALSE(Open(Pack({unknown_compression}))->IsValid());
+
+  // No deflated data inflates to more than 1032 times its size, so the size
+  // of the asset can't be trusted.
+  TestEntry too_large = Deflated("a.txt", std::vector<uint8_t>(100, 'x'));
+  too_large.size = too_large.data.size() * 2000;
+  EXPECT_FALSE(Open(Pack({too_large}))->IsValid());
+}
+
+TEST_F(PackedAssetBundleTest, DoesNotServeCorruptDeflatedEntries) {
+  TestEntry corrupt = Deflated("a.txt", std::vector<uint8_t>(100, 'x'));
+  std::memset(corrupt.data.data(), 0xff, corrupt.data.size());
+  TestEntry wrong_size = Deflated("b.txt", std::vector<uint8_t>(100, 'x'));
+  wrong_size.size = 99;
+  auto bundle = Open(Pack({corrupt, wrong_size}));
+  ASSERT_TRUE(bundle->IsValid());
+
+  EXPECT_FALSE(bundle->GetAsMapping("a.txt"));
+  EXPECT_FALSE(bundle->GetAsMapping("b.txt"));
+}
+
+TEST_F(PackedAssetBundleTest, EvictsLeastRecentlyUsedInflatedEntries) {
+  constexpr size_t kMegabyte = 1024 * 1024;
+  auto bundle = Open(Pack({
+      Deflated("a", std::vector<uint8_t>(kMegabyte, 'a')),
+      Deflated("b", std::vector<uint8_t>(kMegabyte, 'b')),
+      Deflated("c", std::vector<uint8_t>(3 * kMegabyte, 'c')),
+  }));
+  ASSERT_TRUE(bundle->IsValid());
+
+  // Inflated entries are shared while they are in memory.
+  auto a = bundle->GetAsMapping("a");
+  auto b = bundle->GetAsMapping("b");
+  ASSERT_TRUE(a && b);
+  EXPECT_EQ(bundle->GetAsMapping("a")->GetMapping(), a->GetMapping());
+  EXPECT_EQ(bundle->GetAsMapping("b")->GetMapping(), b->GetMapping());
+
+  // Using "a" again makes "b" the least recently used entry, which is evicted
+  // to make room for "c".
+  EXPECT_EQ(bundle->GetAsMapping("a")->GetMapping(), a->GetMapping());
+  ASSERT_TRUE(bundle->GetAsMapping("c"));
+  EXPECT_EQ(bundle->GetAsMapping("a")->GetMapping(), a->GetMapping());
+  auto b_again = bundle->GetAsMapping("b");
+  ASSERT_TRUE(b_again);
+  EXPECT_NE(b_again->GetMapping(), b->GetMapping());
+  EXPECT_EQ(ToString(*b_again), ToString(*b));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace benchmarking {
+
+namespace {
+std::atomic<size_t> gAllocationCount = 0;
+
+void* CountedAllocate(size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  // malloc(0) may return null, which operator new mustn't.
+  return std::malloc(size == 0 ? 1 : size);
+}
+}  // namespace
+
+size_t GetAllocationCount() {
+  return gAllocationCount.load(std::memory_order_relaxed);
+}
+
+}  // namespace benchmarking
+
+// The replacements of the aligned variants are left out: their default
+// implementations don't go through the ones below.
+
+void* operator new(size_t size) {
+  void* pointer = benchmarking::CountedAllocate(size);
+  if (!pointer) {
+    // The engine is built without exceptions, so std::bad_alloc can't be
+    // thrown.
+    std::abort();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return benchmarking::CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return benchmarking::CountedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_BENCHMARKING_ALLOCATION_COUNTER_H_
+#define FLUTTER_BENCHMARKING_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+#include "benchmark/benchmark.h"
+
+namespace benchmarking {
+
+// The number of allocations made through the global operator new by all the
+// threads since the process started.
+//
+// The operator is only replaced by the benchmark executables that depend on
+// //flutter/benchmarking:allocation_counter. The allocations that C code makes
+// with malloc directly aren't counted.
+size_t GetAllocationCount();
+
+// Reports the average number of allocations of the iterations of a benchmark
+// as its "allocations" counter.
+class ScopedAllocationCounter {
+ public:
+  explicit ScopedAllocationCounter(::benchmark::State& state)
+      : state_(state), start_(GetAllocationCount()) {}
+
+  ~ScopedAllocationCounter() {
+    state_.counters["allocations"] =
+        ::benchmark::Counter(GetAllocationCount() - start_,
+                             ::benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  ::benchmark::State& state_;
+  const size_t start_;
+};
+
+}  // namespace benchmarking
+
+#endif  // FLUTTER_BENCHMARKING_ALLOCATION_COUNTER_H_
@@ -0,0 +1,296 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/packed_cache_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+size_t HashKey(const void* key, size_t key_size) {
+  return std::hash<std::string_view>()(
+      std::string_view(static_cast<const char*>(key), key_size));
+}
+
+void WriteEntry(uint8_t* destination, const SkData& key, const SkData& value) {
+  PackedCacheFile::EntryHeader header(key.size(), value.size());
+  memcpy(destination, &header, sizeof(header));
+  destination += sizeof(header);
+  memcpy(destination, key.data(), key.size());
+  destination += key.size();
+  memcpy(destination, value.data(), value.size());
+}
+
+}  // namespace
+
+PackedCacheFile::PackedCacheFile(std::shared_ptr<fml::UniqueFD> directory,
+                                 bool read_only)
+    : directory_(std::move(directory)), read_only_(read_only) {
+  std::scoped_lock lock(mutex_);
+  OpenLocked();
+}
+
+PackedCacheFile::~PackedCacheFile() = default;
+
+void PackedCacheFile::OpenLocked() {
+  TRACE_EVENT0("flutter", "PackedCacheFile::Open");
+  mapping_ = nullptr;
+  file_.reset();
+  index_.clear();
+  end_ = 0;
+  superseded_size_ = 0;
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  file_ = read_only_ ? fml::OpenFileReadOnly(*directory_, kFileName)
+                     : fml::OpenFile(*directory_, kFileName, true,
+                                     fml::FilePermission::kReadWrite);
+  if (file_.is_valid() && RemapLocked()) {
+    IndexEntriesLocked(0);
+  }
+}
+
+bool PackedCacheFile::RemapLocked() {
+  if (read_only_) {
+    mapping_ = std::make_unique<fml::FileMapping>(file_);
+  } else {
+    mapping_ = std::make_unique<fml::FileMapping>(
+        file_, std::initializer_list<fml::FileMapping::Protection>{
+                   fml::FileMapping::Protection::kRead,
+                   fml::FileMapping::Protection::kWrite});
+  }
+  if (!mapping_->IsValid()) {
+    mapping_ = nullptr;
+    index_.clear();
+    end_ = 0;
+    return false;
+  }
+  return true;
+}
+
+void PackedCacheFile::IndexEntriesLocked(size_t offset) {
+  const uint8_t* data = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+  // The entries after one that is torn, such as by a crash while it was
+  // appended, are dropped, and overwritten by the next entry appended.
+  while (size - offset >= sizeof(EntryHeader)) {
+    EntryHeader header(0, 0);
+    memcpy(&header, data + offset, sizeof(header));
+    if (header.signature != EntryHeader::kSignature ||
+        header.version != EntryHeader::kVersion1) {
+      break;
+    }
+    const size_t available = size - offset - sizeof(header);
+    if (header.key_size > available ||
+        header.value_size > available - header.key_size) {
+      break;
+    }
+    AddToIndexLocked({offset, header.key_size, header.value_size});
+    offset += sizeof(header) + header.key_size + header.value_size;
+  }
+  end_ = offset;
+}
+
+void PackedCacheFile::AddToIndexLocked(const EntryLocation& location) {
+  const uint8_t* key = GetKeyLocked(location);
+  const size_t hash = HashKey(key, location.key_size);
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const EntryLocation& existing = it->second;
+    if (existing.key_size == location.key_size &&
+        memcmp(GetKeyLocked(existing), key, location.key_size) == 0) {
+      superseded_size_ +=
+          sizeof(EntryHeader) + existing.key_size + existing.value_size;
+      it->second = location;
+      return;
+    }
+  }
+  index_.emplace(hash, location);
+}
+
+const uint8_t* PackedCacheFile::GetKeyLocked(
+    const EntryLocation& location) const {
+  return mapping_->GetMapping() + location.offset + sizeof(EntryHeader);
+}
+
+const PackedCacheFile::EntryLocation* PackedCacheFile::FindLocked(
+    const void* key,
+    size_t key_size) const {
+  auto range = index_.equal_range(HashKey(key, key_size));
+  for (auto it = range.first; it != range.second; ++it) {
+    const EntryLocation& location = it->second;
+    if (location.key_size == key_size &&
+        memcmp(GetKeyLocked(location), key, key_size) == 0) {
+      return &location;
+    }
+  }
+  return nullptr;
+}
+
+sk_sp<SkData> PackedCacheFile::Find(const SkData& key) const {
+  std::scoped_lock lock(mutex_);
+  const EntryLocation* location = FindLocked(key.data(), key.size());
+  if (!location) {
+    return nullptr;
+  }
+  return SkData::MakeWithCopy(GetKeyLocked(*location) + location->key_size,
+                              location->value_size);
+}
+
+bool PackedCacheFile::Append(const SkData& key, const SkData& value) {
+  TRACE_EVENT0("flutter", "PackedCacheFile::Append");
+  std::scoped_lock lock(mutex_);
+  return AppendLocked({{sk_ref_sp(&key), sk_ref_sp(&value)}});
+}
+
+bool PackedCacheFile::Enqueue(const SkData& key, const SkData& value) {
+  std::scoped_lock lock(queue_mutex_);
+  queued_entries_.push_back({SkData::MakeWithCopy(key.data(), key.size()),
+                             SkData::MakeWithCopy(value.data(), value.size())});
+  return queued_entries_.size() == 1;
+}
+
+bool PackedCacheFile::AppendQueued() {
+  std::vector<Entry> entries;
+  {
+    std::scoped_lock lock(queue_mutex_);
+    entries.swap(queued_entries_);
+  }
+  if (entries.empty()) {
+    return true;
+  }
+  TRACE_EVENT1("flutter", "PackedCacheFile::AppendQueued", "entries",
+               entries.size());
+  std::scoped_lock lock(mutex_);
+  return AppendLocked(entries);
+}
+
+bool PackedCacheFile::AppendLocked(const std::vector<Entry>& entries) {
+  if (read_only_ || !file_.is_valid()) {
+    return false;
+  }
+  const size_t offset = end_;
+  size_t entries_size = 0;
+  for (const Entry& entry : entries) {
+    entries_size +=
+        sizeof(EntryHeader) + entry.key->size() + entry.value->size();
+  }
+  // The file can't be resized while it is mapped on all platforms, so all of
+  // the entries are written after a single resize.
+  mapping_ = nullptr;
+  if (!fml::TruncateFile(file_, offset + entries_size)) {
+    RemapLocked();
+    return false;
+  }
+  if (!RemapLocked() || mapping_->GetSize() < offset + entries_size) {
+    OpenLocked();
+    return false;
+  }
+  size_t entry_offset = offset;
+  for (const Entry& entry : entries) {
+    WriteEntry(mapping_->GetMutableMapping() + entry_offset, *entry.key,
+               *entry.value);
+    AddToIndexLocked({entry_offset, entry.key->size(), entry.value->size()});
+    entry_offset +=
+        sizeof(EntryHeader) + entry.key->size() + entry.value->size();
+  }
+  end_ = offset + entries_size;
+  return true;
+}
+
+std::vector<const PackedCacheFile::EntryLocation*>
+PackedCacheFile::GetLocationsLocked() const {
+  std::vector<const EntryLocation*> locations;
+  locations.reserve(index_.size());
+  for (const auto& item : index_) {
+    locations.push_back(&item.second);
+  }
+  std::sort(locations.begin(), locations.end(),
+            [](const EntryLocation* a, const EntryLocation* b) {
+              return a->offset < b->offset;
+            });
+  return locations;
+}
+
+std::vector<PackedCacheFile::Entry> PackedCacheFile::LoadEntries() const {
+  std::scoped_lock lock(mutex_);
+  std::vector<Entry> entries;
+  entries.reserve(index_.size());
+  for (const EntryLocation* location : GetLocationsLocked()) {
+    const uint8_t* key = GetKeyLocked(*location);
+    entries.push_back({SkData::MakeWithCopy(key, location->key_size),
+                       SkData::MakeWithCopy(key + location->key_size,
+                                            location->value_size)});
+  }
+  return entries;
+}
+
+size_t PackedCacheFile::GetSupersededSize() const {
+  std::scoped_lock lock(mutex_);
+  return superseded_size_;
+}
+
+bool PackedCacheFile::Compact(const std::vector<Entry>& entries) {
+  TRACE_EVENT0("flutter", "PackedCacheFile::Compact");
+  std::scoped_lock lock(mutex_);
+  if (read_only_ || !file_.is_valid()) {
+    return false;
+  }
+
+  // The entries of the file were stored after the given ones, which are
+  // only added for the keys the file has no entry for.
+  std::vector<const Entry*> added_entries;
+  size_t size = end_ - superseded_size_;
+  for (const Entry& entry : entries) {
+    if (!FindLocked(entry.key->data(), entry.key->size())) {
+      added_entries.push_back(&entry);
+      size += sizeof(EntryHeader) + entry.key->size() + entry.value->size();
+    }
+  }
+  if (size == 0) {
+    return true;
+  }
+
+  std::vector<uint8_t> contents(size);
+  size_t offset = 0;
+  for (const Entry* entry : added_entries) {
+    WriteEntry(contents.data() + offset, *entry->key, *entry->value);
+    offset += sizeof(EntryHeader) + entry->key->size() + entry->value->size();
+  }
+  for (const EntryLocation* location : GetLocationsLocked()) {
+    const size_t entry_size =
+        sizeof(EntryHeader) + location->key_size + location->value_size;
+    memcpy(contents.data() + offset, mapping_->GetMapping() + location->offset,
+           entry_size);
+    offset += entry_size;
+  }
+  FML_DCHECK(offset == size);
+
+  // The file can't be replaced while it is open on all platforms.
+  mapping_ = nullptr;
+  file_.reset();
+  const bool written = fml::WriteAtomically(
+      *directory_, kFileName, fml::DataMapping(std::move(contents)));
+  if (!written) {
+    FML_LOG(WARNING) << "Could not compact the packed persistent cache.";
+  }
+  OpenLocked();
+  return written;
+}
+
+void PackedCacheFile::Reset() {
+  std::scoped_lock lock(mutex_);
+  OpenLocked();
+}
+
+}  // namespace flutter
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PACKED_CACHE_FILE_H_
+#define FLUTTER_COMMON_GRAPHICS_PACKED_CACHE_FILE_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+/// A file that packs the entries of a persistent cache one after the other.
+///
+/// New entries are appended to the end of the file, which is memory mapped.
+/// The keys of the entries are indexed when the file is opened, so that |Find|
+/// looks an entry up without any system call, unlike the cache files that hold
+/// a single entry each. An entry that is stored again for the same key
+/// supersedes the previous one, which stays in the file until |Compact| writes
+/// the file again.
+///
+/// It is thread-safe, but only one instance may write to a given file.
+class PackedCacheFile {
+ public:
+  static constexpr char kFileName[] = "io.flutter.packed_cache";
+
+  // Header written before the key and the value of each entry of the file.
+  struct EntryHeader {
+    static const uint32_t kSignature = 0x4B434150;
+    static const uint32_t kVersion1 = 1;
+
+    EntryHeader(uint32_t p_key_size, uint32_t p_value_size)
+        : key_size(p_key_size), value_size(p_value_size) {}
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion1;
+    uint32_t key_size;
+    uint32_t value_size;
+  };
+
+  struct Entry {
+    sk_sp<SkData> key;
+    sk_sp<SkData> value;
+  };
+
+  /// Opens the file in the directory, which is created unless the cache is
+  /// read only.
+  PackedCacheFile(std::shared_ptr<fml::UniqueFD> directory, bool read_only);
+
+  ~PackedCacheFile();
+
+  /// Returns a copy of the value of the key, or null if there is none.
+  sk_sp<SkData> Find(const SkData& key) const;
+
+  /// Appends an entry to the file, which supersedes any entry of the same key.
+  bool Append(const SkData& key, const SkData& value);
+
+  /// Copies an entry into a queue for |AppendQueued|, so that the entries
+  /// stored in quick succession are written to the file at once. Returns true
+  /// if the queue was empty, in which case the caller has to arrange for
+  /// |AppendQueued| to be called.
+  bool Enqueue(const SkData& key, const SkData& value);
+
+  /// Appends all of the queued entries to the file with a single resize.
+  bool AppendQueued();
+
+  /// Returns copies of the latest entry of each key, in the order they were
+  /// stored.
+  std::vector<Entry> LoadEntries() const;
+
+  /// The total size of the entries that have been superseded.
+  size_t GetSupersededSize() const;
+
+  /// Writes the file again with only the latest entry of each key, adding the
+  /// given entries for the keys that have none.
+  bool Compact(const std::vector<Entry>& entries);
+
+  /// Opens the file again, such as after it has been deleted.
+  void Reset();
+
+ private:
+  struct EntryLocation {
+    size_t offset;
+    size_t key_size;
+    size_t value_size;
+  };
+
+  void OpenLocked();
+
+  bool AppendLocked(const std::vector<Entry>& entries);
+
+  bool RemapLocked();
+
+  void IndexEntriesLocked(size_t offset);
+
+  void AddToIndexLocked(const EntryLocation& location);
+
+  const EntryLocation* FindLocked(const void* key, size_t key_size) const;
+
+  const uint8_t* GetKeyLocked(const EntryLocation& location) const;
+
+  // The locations of the latest entries, in the order they were stored.
+  std::vector<const EntryLocation*> GetLocationsLocked() const;
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const bool read_only_;
+  mutable std::mutex mutex_;
+  fml::UniqueFD file_;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  // The end of the last valid entry, after which new entries are appended.
+  size_t end_ = 0;
+  size_t superseded_size_ = 0;
+  // The locations of the latest entries, by the hash of their keys.
+  std::unordered_multimap<size_t, EntryLocation> index_;
+  // Guards only the queue, so that queueing doesn't wait for a write.
+  std::mutex queue_mutex_;
+  std::vector<Entry> queued_entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedCacheFile);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PACKED_CACHE_FILE_H_
@@ -4,11 +4,17 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
+#include <cstring>
 #include <future>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <unordered_set>
+#include <utility>
 
+#include "flutter/common/graphics/skia_gpu_statistics.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/hex_codec.h"
@@ -17,6 +23,7 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_flight_recorder.h"
 #include "flutter/shell/version/version.h"
 #include "openssl/sha.h"
 #include "rapidjson/document.h"
@@ -25,6 +32,43 @@
 
 namespace flutter {
 
+static bool IsPackedCacheFile(const std::string& file_name) {
+  // Includes the temporary file of a packed cache file that is written again.
+  return file_name.rfind(PackedCacheFile::kFileName, 0) == 0;
+}
+
+// The key of the Vulkan pipeline cache, which Skia stores as its
+// |GrVkGpu::kPipelineCache_PersistentCacheKeyType|. The keys of the Vulkan
+// shaders are prefixed with |kShader_PersistentCacheKeyType| instead.
+static constexpr uint32_t kVkPipelineCacheKeyType = 1;
+
+static bool IsVkPipelineCacheKey(const SkData& key) {
+  uint32_t type;
+  if (key.size() != sizeof(type)) {
+    return false;
+  }
+  memcpy(&type, key.data(), sizeof(type));
+  return type == kVkPipelineCacheKeyType;
+}
+
+// Whether the data starts with a valid `VK_PIPELINE_CACHE_HEADER_VERSION_ONE`
+// header, which holds the header size, the header version, the vendor ID, the
+// device ID, and the pipeline cache UUID. Skia compares the IDs and the UUID
+// to the ones of the device, but reads the header without checking the size
+// of the data.
+static bool IsValidVkPipelineCache(const SkData& data) {
+  constexpr uint32_t kHeaderVersionOne = 1;
+  constexpr size_t kUUIDSize = 16;
+  constexpr size_t kHeaderSize = 4 * sizeof(uint32_t) + kUUIDSize;
+  uint32_t header[2];
+  if (data.size() < kHeaderSize) {
+    return false;
+  }
+  memcpy(header, data.data(), sizeof(header));
+  return header[0] >= kHeaderSize && header[0] <= data.size() &&
+         header[1] == kHeaderVersionOne;
+}
+
 std::string PersistentCache::cache_base_path_;
 
 std::shared_ptr<AssetManager> PersistentCache::asset_manager_;
@@ -49,6 +93,7 @@ bool PersistentCache::gIsReadOnly = false;
 
 std::atomic<bool> PersistentCache::cache_sksl_ = false;
 std::atomic<bool> PersistentCache::strategy_set_ = false;
+std::atomic<bool> PersistentCache::precompile_incrementally_ = false;
 
 void PersistentCache::SetCacheSkSL(bool value) {
   if (strategy_set_ && value != cache_sksl_) {
@@ -84,8 +129,9 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+  GetWorkerTaskRunner()->PostTask([&removed, cache_directory = cache_directory_,
+                                   packed_cache = packed_cache_,
+                                   sksl_packed_cache = sksl_packed_cache_]() {
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -97,7 +143,10 @@ bool PersistentCache::Purge() {
         }
         return fml::UnlinkFile(directory, filename.c_str());
       };
-      removed.set_value(VisitFilesRecursively(*cache_directory, delete_file));
+      bool result = VisitFilesRecursively(*cache_directory, delete_file);
+      packed_cache->Reset();
+      sksl_packed_cache->Reset();
+      removed.set_value(result);
     } else {
       removed.set_value(false);
     }
@@ -190,8 +239,50 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
   return data;
 }
 
-size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
-  auto known_sksls = LoadSkSLs();
+std::vector<PersistentCache::SkSLCache>
+PersistentCache::LoadSkSLsInPrecompilationOrder() const {
+  std::vector<SkSLCache> known_sksls = LoadSkSLs();
+
+  // The SkSLs that were used in the earliest frames are compiled first, then
+  // the ones used by the most launches, and then the ones that have never been
+  // used, in the order they were stored.
+  std::vector<std::optional<ShaderUsage>> usages;
+  usages.reserve(known_sksls.size());
+  for (const auto& sksl : known_sksls) {
+    usages.push_back(GetShaderUsage(*sksl.key));
+  }
+  std::vector<size_t> order(known_sksls.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&usages](size_t a, size_t b) {
+    if (!usages[a] || !usages[b]) {
+      return usages[a].has_value() && !usages[b].has_value();
+    }
+    if (usages[a]->first_use_frame != usages[b]->first_use_frame) {
+      return usages[a]->first_use_frame < usages[b]->first_use_frame;
+    }
+    return usages[a]->launch_count > usages[b]->launch_count;
+  });
+
+  // The SkSLs that are both gathered and packaged with the application are
+  // only compiled once.
+  std::unordered_set<std::string_view> keys;
+  std::vector<SkSLCache> result;
+  result.reserve(known_sksls.size());
+  for (size_t index : order) {
+    const SkSLCache& sksl = known_sksls[index];
+    if (keys.insert(std::string_view(static_cast<const char*>(sksl.key->data()),
+                                     sksl.key->size()))
+            .second) {
+      result.push_back(sksl);
+    }
+  }
+  return result;
+}
+
+size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) {
+  auto known_sksls = LoadSkSLsInPrecompilationOrder();
   // A trace must be present even if no precompilations have been completed.
   FML_TRACE_EVENT("flutter", "PersistentCache::PrecompileKnownSkSLs", "count",
                   known_sksls.size());
@@ -200,8 +291,16 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
     return 0;
   }
 
+  if (precompile_incrementally_) {
+    std::scoped_lock lock(precompilation_mutex_);
+    QueuedPrecompilation& queued = queued_precompilations_[context];
+    queued.sksls.assign(known_sksls.begin(), known_sksls.end());
+    queued.precompiled_count = 0;
+    return 0;
+  }
+
   size_t precompiled_count = 0;
-  for (const auto& sksl : known_sksls) {
+  for (const SkSLCache& sksl : known_sksls) {
     TRACE_EVENT0("flutter", "PrecompilingSkSL");
     if (context->precompileShader(*sksl.key, *sksl.value)) {
       precompiled_count++;
@@ -214,11 +313,65 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
   return precompiled_count;
 }
 
+bool PersistentCache::PrecompileQueuedSkSLs(GrDirectContext* context,
+                                            fml::TimeDelta budget) {
+  if (context == nullptr) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "PersistentCache::PrecompileQueuedSkSLs");
+  const fml::TimePoint deadline = fml::TimePoint::Now() + budget;
+  bool started = false;
+  bool precompiled = false;
+  while (true) {
+    SkSLCache sksl;
+    {
+      std::scoped_lock lock(precompilation_mutex_);
+      auto found = queued_precompilations_.find(context);
+      if (found == queued_precompilations_.end()) {
+        return false;
+      }
+      QueuedPrecompilation& queued = found->second;
+      if (precompiled) {
+        queued.precompiled_count++;
+      }
+      if (queued.sksls.empty()) {
+        FML_TRACE_COUNTER("flutter", "PersistentCache::PrecompiledSkSLs",
+                          reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                          "Successful", queued.precompiled_count);
+        queued_precompilations_.erase(found);
+        return false;
+      }
+      // At least one SkSL is compiled, however long it takes.
+      if (started && fml::TimePoint::Now() >= deadline) {
+        return true;
+      }
+      started = true;
+      sksl = std::move(queued.sksls.front());
+      queued.sksls.pop_front();
+    }
+    TRACE_EVENT0("flutter", "PrecompilingSkSL");
+    precompiled = context->precompileShader(*sksl.key, *sksl.value);
+  }
+}
+
+bool PersistentCache::HasQueuedSkSLs(GrDirectContext* context) {
+  std::scoped_lock lock(precompilation_mutex_);
+  return queued_precompilations_.count(context) > 0;
+}
+
+void PersistentCache::DropQueuedSkSLs(GrDirectContext* context) {
+  std::scoped_lock lock(precompilation_mutex_);
+  queued_precompilations_.erase(context);
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
   fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
                                        const std::string& filename) {
+    if (IsPackedCacheFile(filename)) {
+      return true;
+    }
     SkSLCache cache = LoadFile(directory, filename, true);
     if (cache.key != nullptr && cache.value != nullptr) {
       result.push_back(cache);
@@ -232,6 +385,12 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
   if (IsValid()) {
+    for (PackedCacheFile::Entry& entry : sksl_packed_cache_->LoadEntries()) {
+      result.push_back({std::move(entry.key), std::move(entry.value)});
+    }
+    // The SkSLs of previous versions, which were stored in a file each, until
+    // they are packed.
+    //
     // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
     fml::UniqueFD fresh_dir =
@@ -275,11 +434,18 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      packed_cache_(
+          std::make_shared<PackedCacheFile>(cache_directory_, read_only)),
+      sksl_packed_cache_(
+          std::make_shared<PackedCacheFile>(sksl_cache_directory_, read_only)),
+      cache_files_packed_(std::make_shared<std::atomic<bool>>(false)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
+    return;
   }
+  LoadShaderUsage();
 }
 
 PersistentCache::~PersistentCache() = default;
@@ -328,18 +494,57 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
-  auto file_name = SkKeyToFilePath(key);
-  if (file_name.size() == 0) {
+  if (key.data() == nullptr || key.size() == 0) {
     return nullptr;
   }
-  auto result =
-      PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
+  if (IsVkPipelineCacheKey(key)) {
+    sk_sp<SkData> pipeline_cache = LoadData(key);
+    if (pipeline_cache != nullptr && !IsValidVkPipelineCache(*pipeline_cache)) {
+      FML_LOG(INFO) << "Persistent Vulkan pipeline cache is corrupt.";
+      return nullptr;
+    }
+    return pipeline_cache;
+  }
+  // Skia builds a program each time it loads a shader, whether the shader is
+  // found or not.
+  built_new_programs_ = true;
+  built_program_count_++;
+  RecordShaderUse(key);
+  return LoadData(key);
+}
+
+sk_sp<SkData> PersistentCache::LoadData(const SkData& key) {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  if (key.data() == nullptr || key.size() == 0) {
+    return nullptr;
+  }
+  auto result = packed_cache_->Find(key);
+  if (result == nullptr && !*cache_files_packed_) {
+    result = PersistentCache::LoadFile(*cache_directory_,
+                                       SkKeyToFilePath(key), false)
+                 .value;
+  }
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
   }
   return result;
 }
 
+static void RunOnWorker(fml::RefPtr<fml::TaskRunner> worker,
+                        fml::closure task) {
+  if (!worker) {
+    FML_LOG(WARNING)
+        << "The persistent cache has no available workers. Performing the task "
+           "on the current thread. This slow operation is going to occur on a "
+           "frame workload.";
+    task();
+  } else {
+    worker->PostTask(std::move(task));
+  }
+}
+
 static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
                                  std::shared_ptr<fml::UniqueFD> cache_directory,
                                  std::string key,
@@ -356,16 +561,26 @@ static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
       FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
     }
   });
+  RunOnWorker(std::move(worker), std::move(task));
+}
 
-  if (!worker) {
-    FML_LOG(WARNING)
-        << "The persistent cache has no available workers. Performing the task "
-           "on the current thread. This slow operation is going to occur on a "
-           "frame workload.";
-    task();
-  } else {
-    worker->PostTask(std::move(task));
+static void PersistentCacheAppend(fml::RefPtr<fml::TaskRunner> worker,
+                                  std::shared_ptr<PackedCacheFile> packed_cache,
+                                  const SkData& key,
+                                  const SkData& value) {
+  // Shaders are often compiled in bursts, so the entries stored before the
+  // worker runs are appended together. The queue keeps copies, as Skia may
+  // release the data before the worker runs.
+  if (!packed_cache->Enqueue(key, value)) {
+    return;
   }
+  auto task = [packed_cache = std::move(packed_cache)]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStore");
+    if (!packed_cache->AppendQueued()) {
+      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
+    }
+  };
+  RunOnWorker(std::move(worker), std::move(task));
 }
 
 std::unique_ptr<fml::MallocMapping> PersistentCache::BuildCacheObject(
@@ -390,7 +605,20 @@ std::unique_ptr<fml::MallocMapping> PersistentCache::BuildCacheObject(
 
 // |GrContextOptions::PersistentCache|
 void PersistentCache::store(const SkData& key, const SkData& data) {
-  stored_new_shaders_ = true;
+  const bool is_pipeline_cache = IsVkPipelineCacheKey(key);
+  if (!is_pipeline_cache) {
+    stored_new_shaders_ = true;
+    fml::tracing::FlightRecord(
+        fml::tracing::FlightRecorderEventType::kShaderCompile, data.size());
+    if (key.data() != nullptr && key.size() > 0) {
+      auto encode_result = fml::Base32Encode(std::string_view(
+          reinterpret_cast<const char*>(key.data()), key.size()));
+      if (encode_result.first) {
+        SkiaGpuStatistics::GetInstance().RecordShaderKey(
+            std::move(encode_result.second));
+      }
+    }
+  }
 
   if (is_read_only_) {
     return;
@@ -400,23 +628,234 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
+  if (key.data() == nullptr || key.size() == 0) {
+    return;
+  }
 
-  if (file_name.size() == 0) {
+  // The pipeline cache isn't an SkSL, and is loaded with |load| when the SkSLs
+  // are cached as well.
+  if (is_pipeline_cache) {
+    PersistentCacheAppend(GetWorkerTaskRunner(), packed_cache_, key, data);
     return;
   }
 
-  std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
-  if (!mapping) {
+  PersistentCacheAppend(GetWorkerTaskRunner(),
+                        cache_sksl_ ? sksl_packed_cache_ : packed_cache_, key,
+                        data);
+}
+
+void PersistentCache::StoreData(const SkData& key, const SkData& data) {
+  if (is_read_only_ || !IsValid()) {
     return;
   }
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+  if (key.data() == nullptr || key.size() == 0) {
+    return;
+  }
+
+  PersistentCacheAppend(GetWorkerTaskRunner(), packed_cache_, key, data);
+}
+
+namespace {
+
+constexpr char kShaderUsageHeader[] = "flutter-shader-usage 1";
+
+// The usage is stored as a line for each shader, with the SHA-1 of its key,
+// the number of its first frame, and the number of launches that used it.
+std::string SerializeShaderUsage(
+    const std::unordered_map<std::string, PersistentCache::ShaderUsage>&
+        usage) {
+  std::ostringstream stream;
+  stream << kShaderUsageHeader << '\n';
+  for (const auto& item : usage) {
+    stream << item.first << ' ' << item.second.first_use_frame << ' '
+           << item.second.launch_count << '\n';
+  }
+  return stream.str();
+}
+
+std::unordered_map<std::string, PersistentCache::ShaderUsage>
+ParseShaderUsage(const SkData& data) {
+  std::unordered_map<std::string, PersistentCache::ShaderUsage> usage;
+  std::istringstream stream(
+      std::string(static_cast<const char*>(data.data()), data.size()));
+  std::string line;
+  if (!std::getline(stream, line) || line != kShaderUsageHeader) {
+    return usage;
+  }
+  std::string key;
+  PersistentCache::ShaderUsage shader_usage;
+  while (stream >> key >> shader_usage.first_use_frame >>
+         shader_usage.launch_count) {
+    usage[key] = shader_usage;
+  }
+  return usage;
+}
+
+}  // namespace
+
+void PersistentCache::LoadShaderUsage() {
+  sk_sp<SkData> key =
+      SkData::MakeWithoutCopy(kShaderUsageKey, sizeof(kShaderUsageKey) - 1);
+  sk_sp<SkData> data = packed_cache_->Find(*key);
+  if (data == nullptr) {
+    return;
+  }
+  std::scoped_lock lock(shader_usage_mutex_);
+  shader_usage_ = ParseShaderUsage(*data);
+}
+
+void PersistentCache::RecordShaderUse(const SkData& key) {
+  const uint64_t frame = frame_number_;
+  // The shaders built before the first frame, such as by the shader warm-up,
+  // may never be drawn.
+  if (frame == 0) {
+    return;
+  }
+  std::string path = SkKeyToFilePath(key);
+  std::scoped_lock lock(shader_usage_mutex_);
+  // Skia loads each shader once per context, but the shaders are counted once
+  // per launch even if the context is created again.
+  if (!used_shaders_.insert(path).second) {
+    return;
+  }
+  auto result =
+      shader_usage_.try_emplace(std::move(path), ShaderUsage{frame, 0});
+  ShaderUsage& usage = result.first->second;
+  usage.first_use_frame = std::min(usage.first_use_frame, frame);
+  usage.launch_count++;
+  shader_usage_changed_ = true;
+}
+
+std::optional<PersistentCache::ShaderUsage> PersistentCache::GetShaderUsage(
+    const SkData& key) const {
+  std::string path = SkKeyToFilePath(key);
+  std::scoped_lock lock(shader_usage_mutex_);
+  auto found = shader_usage_.find(path);
+  if (found == shader_usage_.end()) {
+    return std::nullopt;
+  }
+  return found->second;
+}
+
+void PersistentCache::StoreShaderUsageIfNeeded() {
+  if (is_read_only_ || !IsValid()) {
+    return;
+  }
+  std::unordered_map<std::string, ShaderUsage> usage;
+  {
+    std::scoped_lock lock(shader_usage_mutex_);
+    // The shaders are mostly used in bursts, such as when a route is pushed, so
+    // the usage is stored at most once per second.
+    const fml::TimePoint now = fml::TimePoint::Now();
+    if (!shader_usage_changed_ ||
+        now - last_shader_usage_store_ < fml::TimeDelta::FromSeconds(1)) {
+      return;
+    }
+    shader_usage_changed_ = false;
+    last_shader_usage_store_ = now;
+    usage = shader_usage_;
+  }
+  RunOnWorker(GetWorkerTaskRunner(),
+              fml::MakeCopyable([packed_cache = packed_cache_,
+                                 usage = std::move(usage)]() mutable {
+                TRACE_EVENT0("flutter", "PersistentCache::StoreShaderUsage");
+                const std::string data = SerializeShaderUsage(usage);
+                sk_sp<SkData> key = SkData::MakeWithoutCopy(
+                    kShaderUsageKey, sizeof(kShaderUsageKey) - 1);
+                if (!packed_cache->Append(
+                        *key, *SkData::MakeWithoutCopy(data.data(),
+                                                       data.size()))) {
+                  FML_LOG(WARNING) << "Could not store the shader usage.";
+                }
+              }));
+}
+
+bool PersistentCache::PackCacheFiles(const fml::UniqueFD& directory,
+                                     PackedCacheFile& packed_cache) {
+  std::vector<PackedCacheFile::Entry> entries;
+  std::vector<std::string> file_names;
+  fml::VisitFiles(directory, [&entries, &file_names](
+                                 const fml::UniqueFD& directory,
+                                 const std::string& filename) {
+    if (IsPackedCacheFile(filename) ||
+        fml::IsDirectory(directory, filename.c_str())) {
+      return true;
+    }
+    // Other files, such as the dumped SKPs, have no cache object header.
+    SkSLCache cache = LoadFile(directory, filename, true);
+    if (cache.key != nullptr && cache.value != nullptr) {
+      entries.push_back({std::move(cache.key), std::move(cache.value)});
+      file_names.push_back(filename);
+    }
+    return true;
+  });
+  if (entries.empty() && packed_cache.GetSupersededSize() == 0) {
+    return true;
+  }
+  if (!packed_cache.Compact(entries)) {
+    return false;
+  }
+  for (const std::string& file_name : file_names) {
+    fml::UnlinkFile(directory, file_name.c_str());
+  }
+  return true;
+}
+
+void PersistentCache::CompactIfNeeded() {
+  if (is_read_only_ || !IsValid() || compaction_started_) {
+    return;
+  }
+  fml::RefPtr<fml::TaskRunner> worker = GetWorkerTaskRunner();
+  if (!worker || compaction_started_.exchange(true)) {
+    return;
+  }
+  worker->PostTask([cache_directory = cache_directory_,
+                    sksl_cache_directory = sksl_cache_directory_,
+                    packed_cache = packed_cache_,
+                    sksl_packed_cache = sksl_packed_cache_,
+                    cache_files_packed = cache_files_packed_]() {
+    TRACE_EVENT0("flutter", "PersistentCache::Compact");
+    bool packed = PackCacheFiles(*cache_directory, *packed_cache);
+    if (sksl_cache_directory->is_valid()) {
+      packed = PackCacheFiles(*sksl_cache_directory, *sksl_packed_cache) &&
+               packed;
+    }
+    *cache_files_packed = packed;
+  });
+}
+
+void PersistentCache::StoreVkPipelineCacheIfNeeded(GrDirectContext* context,
+                                                   bool throttle) {
+  if (context == nullptr || context->backend() != GrBackendApi::kVulkan ||
+      is_read_only_ || !IsValid() || !built_new_programs_) {
+    return;
+  }
+  // The pipelines are mostly built in bursts, such as while the first frames
+  // are rasterized, and the driver copies the whole pipeline cache each time.
+  const int64_t now = fml::TimePoint::Now().ToEpochDelta().ToMilliseconds();
+  if (throttle && now - last_vk_pipeline_cache_store_ < 2000) {
+    return;
+  }
+  if (!built_new_programs_.exchange(false)) {
+    return;
+  }
+  last_vk_pipeline_cache_store_ = now;
+  TRACE_EVENT0("flutter", "PersistentCache::StoreVkPipelineCache");
+  // Skia copies the data from the driver, and stores it with |store|, which
+  // writes it on a worker.
+  context->storeVkPipelineCacheData();
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
+  DumpFrame(data, ".skp");
+}
+
+void PersistentCache::DumpDisplayList(const SkData& data) {
+  DumpFrame(data, kDisplayListExtension);
+}
+
+void PersistentCache::DumpFrame(const SkData& data, const char* extension) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
                       "cache.";
@@ -425,7 +864,7 @@ void PersistentCache::DumpSkp(const SkData& data) {
 
   std::stringstream name_stream;
   auto ticks = fml::TimePoint::Now().ToEpochDelta().ToNanoseconds();
-  name_stream << "shader_dump_" << std::to_string(ticks) << ".skp";
+  name_stream << "shader_dump_" << std::to_string(ticks) << extension;
   std::string file_name = name_stream.str();
   FML_LOG(INFO) << "Dumping " << file_name;
   auto mapping = std::make_unique<fml::DataMapping>(
@@ -475,4 +914,14 @@ PersistentCache::GetSkpsFromAssetManager() const {
   return asset_manager_->GetAsMappings(".*\\.skp$", "shaders");
 }
 
+std::vector<std::unique_ptr<fml::Mapping>>
+PersistentCache::GetDisplayListsFromAssetManager() const {
+  if (!asset_manager_) {
+    FML_LOG(ERROR) << "PersistentCache::GetDisplayListsFromAssetManager: Asset "
+                      "manager not set!";
+    return std::vector<std::unique_ptr<fml::Mapping>>();
+  }
+  return asset_manager_->GetAsMappings(".*\\.dl$", "shaders");
+}
+
 }  // namespace flutter
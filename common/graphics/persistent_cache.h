@@ -5,13 +5,21 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/packed_cache_file.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
@@ -77,7 +85,19 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // frame so we can know if Skia tries to compile new shaders in that frame.
   bool StoredNewShaders() const { return stored_new_shaders_; }
   void ResetStoredNewShaders() { stored_new_shaders_ = false; }
+
+  // Counts the frames, so that the number of the frame in which each shader is
+  // first used can be recorded. Called before each frame is rasterized.
+  void BeginFrame() { frame_number_++; }
+
+  // The number of programs that Skia has built in the contexts using this
+  // cache, whether their shaders were found in the cache or not.
+  size_t GetBuiltProgramCount() const { return built_program_count_; }
+
   void DumpSkp(const SkData& data);
+  // Dumps a serialized DisplayList, which the shader warm-up replays once it
+  // is packaged with the application.
+  void DumpDisplayList(const SkData& data);
   bool IsDumpingSkp() const { return is_dumping_skp_; }
   void SetIsDumpingSkp(bool value) { is_dumping_skp_ = value; }
 
@@ -86,14 +106,53 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   bool Purge();
 
   // |GrContextOptions::PersistentCache|
+  //
+  // Skia loads a shader the first time it is used in a context, which records
+  // the use of the shader.
   sk_sp<SkData> load(const SkData& key) override;
 
+  // Loads data other than shaders, without recording a shader use.
+  sk_sp<SkData> LoadData(const SkData& key);
+
+  // Stores data other than shaders, such as the index of the fallback fonts,
+  // which the next launch of the application loads with |LoadData|.
+  void StoreData(const SkData& key, const SkData& data);
+
+  // How a shader has been used over the launches of the application.
+  //
+  // Skia doesn't load the shaders that have been precompiled, so the usage of
+  // those is the one recorded before they were precompiled.
+  struct ShaderUsage {
+    // The number of the first frame that used the shader, the earliest over
+    // the launches.
+    uint64_t first_use_frame;
+    // The number of launches that used the shader.
+    uint64_t launch_count;
+  };
+
+  // Returns the recorded usage of the shader, if any.
+  std::optional<ShaderUsage> GetShaderUsage(const SkData& key) const;
+
+  // Stores the usage of the shaders for the next launches, on a worker, if
+  // shaders have been used for the first time since it was last stored.
+  void StoreShaderUsageIfNeeded();
+
+  static constexpr char kShaderUsageKey[] = "flutter.shader_usage";
+
+  // Moves the entries of the cache files of previous versions, which hold an
+  // entry each, into the packed cache files, and drops the entries that were
+  // stored again. Only runs once per process, on a worker, so that it can be
+  // called whenever the engine is idle.
+  void CompactIfNeeded();
+
   struct SkSLCache {
     sk_sp<SkData> key;
     sk_sp<SkData> value;
   };
 
-  /// Load all the SkSL shader caches in the right directory.
+  /// Load all the SkSL shader caches in the right directory, starting with the
+  /// ones gathered in the order they were first used, followed by the ones
+  /// packaged with the application.
   std::vector<SkSLCache> LoadSkSLs() const;
 
   //----------------------------------------------------------------------------
@@ -105,15 +164,69 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///             recreated. The SkSLs must be precompiled again in the new
   ///             context.
   ///
+  ///             The SkSLs are compiled in the order they were first used, so
+  ///             that the shaders of the first frames are ready first.
+  ///
+  ///             If the SkSLs are precompiled incrementally, they are only
+  ///             queued, for |PrecompileQueuedSkSLs| to compile them between
+  ///             the frames.
+  ///
   /// @param      context  The rendering context to precompile shaders in.
   ///
   /// @return     The number of SkSLs precompiled.
   ///
-  size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
+  size_t PrecompileKnownSkSLs(GrDirectContext* context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompiles the SkSLs queued for the context, until the budget
+  ///             is spent. At least one SkSL is compiled, as a compilation
+  ///             can't be interrupted.
+  ///
+  ///             The shaders that are needed before they are precompiled are
+  ///             still compiled by Skia when a frame draws with them.
+  ///
+  /// @warning    This must be called on the thread that uses the context, with
+  ///             the context current.
+  ///
+  /// @return     Whether SkSLs remain to be precompiled in the context.
+  ///
+  bool PrecompileQueuedSkSLs(GrDirectContext* context, fml::TimeDelta budget);
+
+  /// Whether SkSLs are queued for precompilation in the context.
+  bool HasQueuedSkSLs(GrDirectContext* context);
+
+  /// Drops the SkSLs queued for the context, such as before it is destroyed.
+  void DropQueuedSkSLs(GrDirectContext* context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores the pipeline cache of a Vulkan context, so that the
+  ///             driver doesn't compile the pipelines again in the next
+  ///             launches. Does nothing for the other backends, or if Skia
+  ///             hasn't built any program since the pipeline cache was last
+  ///             stored.
+  ///
+  ///             Skia loads the pipeline cache when the context is created,
+  ///             and only uses it if it was written by a driver with the same
+  ///             vendor, device and pipeline cache UUID.
+  ///
+  /// @warning    This must be called on the thread that uses the context, as
+  ///             the pipeline cache data is copied from the driver there.
+  ///
+  /// @param      context   The rendering context.
+  /// @param      throttle  Whether to store the pipeline cache at most once
+  ///                       every few seconds, which is meant for calls after
+  ///                       each frame.
+  ///
+  void StoreVkPipelineCacheIfNeeded(GrDirectContext* context, bool throttle);
 
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
+  // Return mappings for all the serialized DisplayLists accessible through the
+  // AssetManager.
+  std::vector<std::unique_ptr<fml::Mapping>> GetDisplayListsFromAssetManager()
+      const;
+
   /// Set the asset manager from which PersistentCache can load SkLSs. A nullptr
   /// can be provided to clear the asset manager.
   static void SetAssetManager(std::shared_ptr<AssetManager> value);
@@ -127,8 +240,17 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static void MarkStrategySet() { strategy_set_ = true; }
 
+  static bool precompile_incrementally() { return precompile_incrementally_; }
+
+  // Whether |PrecompileKnownSkSLs| queues the SkSLs, instead of blocking the
+  // first frame until they are all compiled.
+  static void SetPrecompileIncrementally(bool value) {
+    precompile_incrementally_ = value;
+  }
+
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kDisplayListExtension[] = ".dl";
 
  private:
   static std::string cache_base_path_;
@@ -148,9 +270,41 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // strategy_set_ becomes true.
   static std::atomic<bool> strategy_set_;
 
+  static std::atomic<bool> precompile_incrementally_;
+
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<PackedCacheFile> packed_cache_;
+  const std::shared_ptr<PackedCacheFile> sksl_packed_cache_;
+  // Whether the cache files that hold an entry each have all been packed, so
+  // that |load| doesn't look for them anymore.
+  const std::shared_ptr<std::atomic<bool>> cache_files_packed_;
+  std::atomic<bool> compaction_started_ = false;
+
+  struct QueuedPrecompilation {
+    std::deque<SkSLCache> sksls;
+    size_t precompiled_count = 0;
+  };
+  std::mutex precompilation_mutex_;
+  std::unordered_map<GrDirectContext*, QueuedPrecompilation>
+      queued_precompilations_;
+
+  // Whether Skia has built programs, and so pipelines, since the pipeline
+  // cache was last stored.
+  std::atomic<bool> built_new_programs_ = false;
+  std::atomic<int64_t> last_vk_pipeline_cache_store_ = 0;
+  std::atomic<size_t> built_program_count_ = 0;
+
+  std::atomic<uint64_t> frame_number_ = 0;
+  mutable std::mutex shader_usage_mutex_;
+  // The usage of the shaders, by the |SkKeyToFilePath| of their keys.
+  std::unordered_map<std::string, ShaderUsage> shader_usage_;
+  // The shaders that have been used in this launch.
+  std::unordered_set<std::string> used_shaders_;
+  bool shader_usage_changed_ = false;
+  fml::TimePoint last_shader_usage_store_;
+
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
@@ -161,8 +315,22 @@ class PersistentCache : public GrContextOptions::PersistentCache {
                             const std::string& file_name,
                             bool need_key);
 
+  // Packs the entries of the cache files in the directory, which hold an entry
+  // each, into the packed cache file of the directory and removes them.
+  static bool PackCacheFiles(const fml::UniqueFD& directory,
+                             PackedCacheFile& packed_cache);
+
   bool IsValid() const;
 
+  // Loads the SkSLs in the order they are precompiled, without duplicates.
+  std::vector<SkSLCache> LoadSkSLsInPrecompilationOrder() const;
+
+  void LoadShaderUsage();
+
+  void RecordShaderUse(const SkData& key);
+
+  void DumpFrame(const SkData& data, const char* extension);
+
   PersistentCache(bool read_only = false);
 
   // |GrContextOptions::PersistentCache|
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/skia_gpu_statistics.h"
+
+#include <utility>
+
+namespace flutter {
+
+SkiaGpuStatistics& SkiaGpuStatistics::GetInstance() {
+  // Leaked, since Skia may compile shaders until the process exits.
+  static SkiaGpuStatistics* statistics = new SkiaGpuStatistics();
+  return *statistics;
+}
+
+SkiaGpuStatistics::SkiaGpuStatistics() = default;
+
+SkiaGpuStatistics::~SkiaGpuStatistics() = default;
+
+void SkiaGpuStatistics::RecordShaderCompilation(fml::TimePoint start,
+                                                fml::TimeDelta duration) {
+  std::scoped_lock lock(mutex_);
+  counters_.shader_compile_count++;
+  counters_.shader_compile_duration =
+      counters_.shader_compile_duration + duration;
+  if (recent_shader_compilations_.size() == kMaxRecentShaderCompilations) {
+    recent_shader_compilations_.pop_front();
+  }
+  recent_shader_compilations_.push_back({
+      .compilation = {.start = start, .duration = duration},
+      .thread = std::this_thread::get_id(),
+  });
+}
+
+void SkiaGpuStatistics::RecordShaderKey(std::string key) {
+  const std::thread::id thread = std::this_thread::get_id();
+  std::scoped_lock lock(mutex_);
+  for (auto it = recent_shader_compilations_.rbegin();
+       it != recent_shader_compilations_.rend(); ++it) {
+    if (it->thread == thread) {
+      if (it->compilation.key.empty()) {
+        it->compilation.key = std::move(key);
+      }
+      return;
+    }
+  }
+}
+
+void SkiaGpuStatistics::RecordResourceCachePurge(size_t purged_bytes) {
+  std::scoped_lock lock(mutex_);
+  counters_.resource_cache_purge_count++;
+  counters_.resource_cache_purged_bytes += purged_bytes;
+}
+
+SkiaGpuCounters SkiaGpuStatistics::GetCounters() const {
+  std::scoped_lock lock(mutex_);
+  return counters_;
+}
+
+std::vector<ShaderCompilation> SkiaGpuStatistics::GetRecentShaderCompilations()
+    const {
+  std::scoped_lock lock(mutex_);
+  std::vector<ShaderCompilation> compilations;
+  compilations.reserve(recent_shader_compilations_.size());
+  for (const auto& recent : recent_shader_compilations_) {
+    compilations.push_back(recent.compilation);
+  }
+  return compilations;
+}
+
+}  // namespace flutter
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_SKIA_GPU_STATISTICS_H_
+#define FLUTTER_COMMON_GRAPHICS_SKIA_GPU_STATISTICS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// The totals of the GPU work that Skia did outside of the frames themselves,
+/// since the process started.
+struct SkiaGpuCounters {
+  uint64_t shader_compile_count = 0;
+  fml::TimeDelta shader_compile_duration;
+  uint64_t resource_cache_purge_count = 0;
+  uint64_t resource_cache_purged_bytes = 0;
+};
+
+/// A shader that Skia compiled.
+struct ShaderCompilation {
+  fml::TimePoint start;
+  fml::TimeDelta duration;
+  /// The base32 of the key of the shader in the SkSL bundles, or empty if the
+  /// shader wasn't stored in the persistent cache.
+  std::string key;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Records the shader compilations and the purges of the GPU
+///             resource cache, whether or not the timeline is recording, so
+///             that they can be correlated with the frames that missed their
+///             vsync.
+///
+///             The statistics are shared by all the engines of the process and
+///             can be recorded and read on any thread.
+///
+class SkiaGpuStatistics {
+ public:
+  /// The compilations whose keys are kept.
+  static constexpr size_t kMaxRecentShaderCompilations = 64;
+
+  static SkiaGpuStatistics& GetInstance();
+
+  SkiaGpuStatistics();
+
+  ~SkiaGpuStatistics();
+
+  void RecordShaderCompilation(fml::TimePoint start, fml::TimeDelta duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the key of the shader that was compiled last on the
+  ///             calling thread, which Skia stores in the persistent cache
+  ///             right after compiling it.
+  ///
+  void RecordShaderKey(std::string key);
+
+  void RecordResourceCachePurge(size_t purged_bytes);
+
+  SkiaGpuCounters GetCounters() const;
+
+  /// The most recent compilations, oldest first.
+  std::vector<ShaderCompilation> GetRecentShaderCompilations() const;
+
+ private:
+  struct RecentShaderCompilation {
+    ShaderCompilation compilation;
+    std::thread::id thread;
+  };
+
+  mutable std::mutex mutex_;
+  SkiaGpuCounters counters_;
+  std::deque<RecentShaderCompilation> recent_shader_compilations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SkiaGpuStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_SKIA_GPU_STATISTICS_H_
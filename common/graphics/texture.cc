@@ -4,6 +4,8 @@
 
 #include "flutter/common/graphics/texture.h"
 
+#include <algorithm>
+
 namespace flutter {
 
 Texture::Texture(int64_t id) : id_(id) {}
@@ -12,37 +14,72 @@ Texture::~Texture() = default;
 
 TextureRegistry::TextureRegistry() = default;
 
+std::vector<TextureRegistry::Entry>::iterator TextureRegistry::Find(
+    int64_t id) {
+  return std::lower_bound(
+      entries_.begin(), entries_.end(), id,
+      [](const Entry& entry, int64_t id) { return entry.id < id; });
+}
+
+std::vector<TextureRegistry::Entry>::const_iterator TextureRegistry::Find(
+    int64_t id) const {
+  return std::lower_bound(
+      entries_.begin(), entries_.end(), id,
+      [](const Entry& entry, int64_t id) { return entry.id < id; });
+}
+
 void TextureRegistry::RegisterTexture(std::shared_ptr<Texture> texture) {
   if (!texture) {
     return;
   }
-  mapping_[texture->Id()] = texture;
+  const int64_t id = texture->Id();
+  auto found = Find(id);
+  if (found != entries_.end() && found->id == id) {
+    found->texture = std::move(texture);
+    found->frame_count = ++last_frame_count_;
+    return;
+  }
+  entries_.insert(found, {id, std::move(texture), ++last_frame_count_});
 }
 
 void TextureRegistry::UnregisterTexture(int64_t id) {
-  auto found = mapping_.find(id);
-  if (found == mapping_.end()) {
+  auto found = Find(id);
+  if (found == entries_.end() || found->id != id) {
     return;
   }
-  found->second->OnTextureUnregistered();
-  mapping_.erase(found);
+  found->texture->OnTextureUnregistered();
+  entries_.erase(found);
 }
 
 void TextureRegistry::OnGrContextCreated() {
-  for (auto& it : mapping_) {
-    it.second->OnGrContextCreated();
+  for (auto& entry : entries_) {
+    entry.texture->OnGrContextCreated();
   }
 }
 
 void TextureRegistry::OnGrContextDestroyed() {
-  for (auto& it : mapping_) {
-    it.second->OnGrContextDestroyed();
+  for (auto& entry : entries_) {
+    entry.texture->OnGrContextDestroyed();
   }
 }
 
 std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) {
-  auto it = mapping_.find(id);
-  return it != mapping_.end() ? it->second : nullptr;
+  auto found = Find(id);
+  return found != entries_.end() && found->id == id ? found->texture : nullptr;
+}
+
+void TextureRegistry::MarkNewFrameAvailable(int64_t id) {
+  auto found = Find(id);
+  if (found == entries_.end() || found->id != id) {
+    return;
+  }
+  found->frame_count = ++last_frame_count_;
+  found->texture->MarkNewFrameAvailable();
+}
+
+uint64_t TextureRegistry::GetFrameCount(int64_t id) const {
+  auto found = Find(id);
+  return found != entries_.end() && found->id == id ? found->frame_count : 0;
 }
 
 }  // namespace flutter
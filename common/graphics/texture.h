@@ -5,7 +5,8 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_TEXTURE_H_
 #define FLUTTER_COMMON_GRAPHICS_TEXTURE_H_
 
-#include <map>
+#include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -48,6 +49,8 @@ class Texture {
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
+// The textures by id, in a vector sorted by id, since the registries hold a
+// few textures that are looked up by every texture layer of every frame.
 class TextureRegistry {
  public:
   TextureRegistry();
@@ -61,6 +64,16 @@ class TextureRegistry {
   // Called from raster thread.
   std::shared_ptr<Texture> GetTexture(int64_t id);
 
+  // Called from raster thread.
+  void MarkNewFrameAvailable(int64_t id);
+
+  // Changes whenever the texture is registered or has a new frame available,
+  // so that the frames that paint the same frame of the texture can be
+  // recognized. Returns 0 for textures that are not registered.
+  //
+  // Called from raster thread.
+  uint64_t GetFrameCount(int64_t id) const;
+
   // Called from raster thread.
   void OnGrContextCreated();
 
@@ -68,7 +81,18 @@ class TextureRegistry {
   void OnGrContextDestroyed();
 
  private:
-  std::map<int64_t, std::shared_ptr<Texture>> mapping_;
+  struct Entry {
+    int64_t id;
+    std::shared_ptr<Texture> texture;
+    uint64_t frame_count;
+  };
+
+  std::vector<Entry>::iterator Find(int64_t id);
+
+  std::vector<Entry>::const_iterator Find(int64_t id) const;
+
+  std::vector<Entry> entries_;
+  uint64_t last_frame_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TextureRegistry);
 };
@@ -37,7 +37,7 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  static constexpr int kStatisticsCount = kCount + 8;
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
@@ -60,6 +60,43 @@ class FrameTiming {
     picture_cache_bytes_ = picture_cache_bytes;
   }
 
+  // The number of older frames that were discarded by the rasterizer in favor
+  // of this one because they were already late.
+  uint64_t GetSkippedFrameCount() const { return skipped_frame_count_; }
+  void SetSkippedFrameCount(uint64_t skipped_frame_count) {
+    skipped_frame_count_ = skipped_frame_count;
+  }
+
+  // The GPU time of the most recent frame whose GPU time measurement had
+  // completed when this frame was rasterized. The measurements complete
+  // asynchronously, so they usually belong to an earlier frame, whose number
+  // is reported along with it. The frame number is 0 when there was no new
+  // measurement.
+  uint64_t GetGpuFrameNumber() const { return gpu_frame_number_; }
+  fml::TimeDelta GetGpuDuration() const { return gpu_duration_; }
+  void SetGpuDuration(uint64_t frame_number, fml::TimeDelta duration) {
+    gpu_frame_number_ = frame_number;
+    gpu_duration_ = duration;
+  }
+
+  // The shaders that Skia compiled and the bytes that were purged from the GPU
+  // resource cache since the previous frame was rasterized, by any of the
+  // engines of the process.
+  uint64_t GetShaderCompileCount() const { return shader_compile_count_; }
+  fml::TimeDelta GetShaderCompileDuration() const {
+    return shader_compile_duration_;
+  }
+  uint64_t GetResourceCachePurgedBytes() const {
+    return resource_cache_purged_bytes_;
+  }
+  void SetSkiaGpuStatistics(uint64_t shader_compile_count,
+                            fml::TimeDelta shader_compile_duration,
+                            uint64_t resource_cache_purged_bytes) {
+    shader_compile_count_ = shader_compile_count;
+    shader_compile_duration_ = shader_compile_duration;
+    resource_cache_purged_bytes_ = resource_cache_purged_bytes;
+  }
+
  private:
   fml::TimePoint data_[kCount];
   uint64_t frame_number_;
@@ -67,6 +104,12 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  uint64_t skipped_frame_count_ = 0;
+  uint64_t gpu_frame_number_ = 0;
+  fml::TimeDelta gpu_duration_;
+  uint64_t shader_compile_count_ = 0;
+  fml::TimeDelta shader_compile_duration_;
+  uint64_t resource_cache_purged_bytes_ = 0;
 };
 
 using TaskObserverAdd =
@@ -87,6 +130,19 @@ using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
 
+// When the animator begins frames relative to vsync.
+enum class FramePacingPolicy {
+  // Frames begin at vsync.
+  kDefault,
+  // Frames begin as late after vsync as the durations of recent frames allow,
+  // so that they reflect the latest input.
+  kLowLatency,
+  // Frames begin before vsync while building and rasterizing a frame takes
+  // longer than a frame interval, so that the stages of consecutive frames
+  // overlap.
+  kSmooth,
+};
+
 class DartIsolate;
 
 struct Settings {
@@ -125,6 +181,12 @@ struct Settings {
   MappingsCallback application_kernels;
 
   std::string temp_directory_path;
+  // The path of the profile of the snapshot pages accessed during startup,
+  // whose pages are prefetched while the VM is initialized.
+  std::string snapshot_prefetch_profile_path;
+  // Whether the profile is recorded at that path once the first frame has been
+  // rasterized, instead of being used.
+  bool record_snapshot_prefetch_profile = false;
   std::vector<std::string> dart_flags;
   // Arguments passed as a List<String> to Dart's entrypoint function.
   std::vector<std::string> dart_entrypoint_args;
@@ -139,6 +201,13 @@ struct Settings {
   bool trace_systrace = false;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
+  // Whether the known SkSLs are precompiled a few at a time between the frames,
+  // instead of before the first frame.
+  bool precompile_sksls_incrementally = false;
+  // Whether the serialized display lists packaged with the application are
+  // replayed on the resource context when it is created, to build the programs
+  // they need before the first frames.
+  bool warm_up_shaders_with_display_lists = false;
   bool purge_persistent_cache = false;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
@@ -182,6 +251,12 @@ struct Settings {
   // after failing to bind to a specified port.
   bool enable_service_port_fallback = false;
 
+  // Defers the startup of the service isolate and its HTTP server until the
+  // first frame has been rasterized, so that it does not compete with the
+  // launch of the app. Ignored when the isolate starts paused, since the
+  // first frame then waits for a debugger to connect to the service.
+  bool lazy_service_isolate_startup = false;
+
   // Font settings
   bool use_test_fonts = false;
 
@@ -189,12 +264,139 @@ struct Settings {
   // manager before creating the engine.
   bool prefetched_default_font_manager = false;
 
+  // Rasterizes the glyphs that the first frames of the previous launch drew
+  // into the glyph cache on a worker while the root isolate starts, and
+  // records the glyphs of the first frames of this launch for the next one.
+  bool warm_up_glyph_cache = false;
+
+  // Dispatches the platform messages that the platform sends while the UI
+  // thread is busy in a single UI task, in the order they were sent, instead of
+  // posting a task for each of them. This reduces the scheduling overhead of
+  // high-frequency channels, but lets those messages be handled ahead of the
+  // other UI tasks that were posted after the first of them.
+  bool batch_platform_messages = false;
+
+  // The minimum number of milliseconds between two semantics updates sent to
+  // the platform. The updates that the framework sends in between, such as
+  // during animations, are merged into one, which is sent once the interval
+  // has passed. A value of 0 sends every update as soon as it is produced.
+  uint32_t semantics_update_interval_ms = 0;
+
+  // Dispatches one move per touch or stylus each frame, whose position is
+  // resampled at the target time of the frame, instead of the moves as the
+  // platform delivers them.
+  bool enable_pointer_resampling = false;
+
+  // Delivers the pointer events to the UI thread ahead of the tasks that were
+  // posted to it before them, such as the handling of platform messages,
+  // except for Dart micro tasks.
+  bool prioritize_pointer_events = false;
+
+  // Records the messages, bytes, response latency and handler time of each
+  // platform channel, which are reported by the
+  // `_flutter.getPlatformChannelStatistics` service extension and added to the
+  // timeline as counters.
+  bool enable_platform_channel_statistics = false;
+
+  // The channels whose platform messages are dispatched to the framework ahead
+  // of the messages of the other channels that are still waiting for the UI
+  // thread. The messages of each channel are still dispatched in order.
+  std::vector<std::string> high_priority_platform_channels = {
+      "flutter/lifecycle",
+      "flutter/navigation",
+      "flutter/keyevent",
+  };
+
   // Selects the SkParagraph implementation of the text layout engine.
   bool enable_skparagraph = false;
 
   // Selects the DisplayList for storage of rendering operations.
   bool enable_display_list = true;
 
+  // Records the leaf layers of a scene and the links between its layers in
+  // SceneBuilder, and builds the layer tree from the recording on the raster
+  // thread instead of on the UI thread.
+  bool defer_layer_tree_construction = false;
+
+  // Rasterizes display list raster cache entries on the IO thread instead
+  // of during the frame that first asks for them.
+  bool enable_async_raster_cache = false;
+
+  // Packs small raster cache entries into the pages of a shared texture
+  // atlas instead of allocating a texture for each of them.
+  bool enable_raster_cache_atlas = false;
+
+  // The number of bytes of cached images that the raster cache keeps alive
+  // across frames in which they are not used. Entries are evicted least
+  // recently used first once the budget is exceeded. A value of 0 evicts
+  // every entry that is not used in a frame.
+  size_t raster_cache_max_bytes = 0;
+
+  // Shells spawned from a shell with this setting use the raster cache of
+  // the shell they were spawned from, so that pictures drawn by several of
+  // the shells are only rasterized once.
+  bool enable_shared_raster_cache = false;
+
+  // Prerolls the children of container layers concurrently on the worker
+  // threads of the VM, for the subtrees without platform views, textures or
+  // backdrop filters.
+  bool enable_parallel_preroll = false;
+
+  // Attributes the CPU time of the preroll and the paint of each frame to the
+  // layers, which is reported per type of layer and per layer by the
+  // `_flutter.getLayerProfile` service extension and added to the timeline as
+  // an event per layer. Disables the parallel preroll.
+  bool enable_layer_profiling = false;
+
+  // Rasterizes the frames of software surfaces in horizontal bands that are
+  // replayed concurrently on the worker threads of the VM. Frames with
+  // backdrop filters are still rasterized on the raster thread only.
+  bool enable_parallel_software_raster = false;
+
+  // Lets the depth of the pipeline between the UI and raster threads grow up
+  // to three frames while the raster thread is the bottleneck, and shrink back
+  // to one frame while pointer events are delivered.
+  bool enable_adaptive_pipeline_depth = false;
+
+  FramePacingPolicy frame_pacing_policy = FramePacingPolicy::kDefault;
+
+  // Lets the rasterizer discard a layer tree whose target time has already
+  // passed when a newer layer tree is waiting in the pipeline, instead of
+  // rasterizing both.
+  bool enable_raster_frame_skipping = false;
+
+  // Presents frames from a dedicated thread on surfaces that support it, so
+  // that the raster thread can start on the next frame while the previous
+  // one waits for its buffer swap.
+  bool enable_submit_thread = false;
+
+  // Measures the GPU time of the frames on the surfaces that support it and
+  // reports it in the frame timings and on the timeline.
+  bool enable_gpu_frame_timing = false;
+
+  // The number of bytes of decoded images that are kept, keyed by the bytes
+  // they were decoded from and their target size, so that instantiating the
+  // same image again skips its decode and upload. Shells spawned from a shell
+  // with a cache share it. A value of 0 disables the cache.
+  size_t decoded_image_cache_max_bytes = 0;
+
+  // Converts the decoded opaque images to 16 bits per pixel before they are
+  // uploaded, which halves their memory at the cost of some precision of
+  // their colors, which is hidden by dithering them.
+  bool enable_compact_opaque_images = false;
+
+  // Keeps the decoded images in memory instead of uploading them on the IO
+  // thread, so that the images that are never drawn, such as the ones that
+  // are decoded ahead of time, are never uploaded. The other images are
+  // uploaded when they are first drawn, on the raster thread.
+  bool defer_image_uploads = false;
+
+  // The number of bytes of the shaped words that the text layout keeps for
+  // reuse, shared by all the shells in the process. The least recently used
+  // words are shaped again once the budget is exceeded. A value of 0 disables
+  // the cache.
+  size_t text_layout_cache_max_bytes = 2 * 1024 * 1024;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -250,6 +452,9 @@ struct Settings {
   // calls in this callback will cause applications to jank.
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
+  // Render with Vulkan rather than OpenGL ES on the platforms that support
+  // both, falling back to OpenGL ES where Vulkan is missing.
+  bool enable_vulkan = false;
   bool skia_deterministic_rendering_on_cpu = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
@@ -7,6 +7,7 @@
 #include <optional>
 #include "flutter/flow/layers/layer_tree.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkRegion.h"
 
 namespace flutter {
 
@@ -19,6 +20,7 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
                         layer_tree.paint_region_map(),
                         prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
                                          : empty_paint_region_map);
+    context.SetTextureRegistry(texture_registry_);
     context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
                                          layer_tree.frame_size().height()));
     {
@@ -35,6 +37,8 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
       }
       layer_tree.root_layer()->Diff(&context, prev_root_layer);
     }
+    layer_tree.set_retained_layers(context.TakeRetainedLayers());
+    layer_tree.set_unchanged_backdrops(context.TakeUnchangedBackdrops());
 
     damage_ = context.ComputeDamage(additional_damage_);
     return SkRect::Make(damage_->buffer_damage);
@@ -44,12 +48,53 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
 }
 
 CompositorContext::CompositorContext(fml::Milliseconds frame_budget)
-    : raster_time_(frame_budget), ui_time_(frame_budget) {}
+    : raster_cache_(std::make_shared<RasterCache>()),
+      raster_time_(frame_budget),
+      ui_time_(frame_budget) {}
 
-CompositorContext::~CompositorContext() = default;
+CompositorContext::~CompositorContext() {
+  if (raster_cache_.use_count() > 1) {
+    raster_cache_->RemoveSharedClient();
+  }
+}
+
+void CompositorContext::SetFrameBudget(fml::Milliseconds frame_budget) {
+  raster_time_.SetFrameBudget(frame_budget);
+  ui_time_.SetFrameBudget(frame_budget);
+}
+
+void CompositorContext::SetLayerProfilingEnabled(bool enabled) {
+  if (!enabled) {
+    layer_profiler_.reset();
+  } else if (!layer_profiler_) {
+    layer_profiler_ = std::make_unique<LayerProfiler>();
+  }
+}
+
+void CompositorContext::ShareRasterCache(CompositorContext& other) {
+  if (raster_cache_ == other.raster_cache_) {
+    return;
+  }
+  if (raster_cache_.use_count() > 1) {
+    raster_cache_->RemoveSharedClient();
+  }
+  raster_cache_ = other.raster_cache_;
+  raster_cache_->AddSharedClient();
+}
 
 void CompositorContext::BeginFrame(ScopedFrame& frame,
                                    bool enable_instrumentation) {
+  GrDirectContext* gr_context = frame.gr_context();
+  if (gr_context && !raster_cache_->AttachGrContext(gr_context)) {
+    // The images of the cache can't be drawn with this GrDirectContext.
+    if (raster_cache_.use_count() > 1) {
+      raster_cache_->RemoveSharedClient();
+      raster_cache_ = std::make_shared<RasterCache>();
+    } else {
+      raster_cache_->Clear();
+    }
+    raster_cache_->AttachGrContext(gr_context);
+  }
   if (enable_instrumentation) {
     frame_count_.Increment();
     raster_time_.Start();
@@ -132,6 +177,19 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (canvas()) {
     if (clip_rect) {
       canvas()->clipRect(*clip_rect);
+      // Leave the area between separate damage rects untouched. The region
+      // is in device space, so it has to include the root transformation.
+      auto damage_rects = frame_damage->GetBufferDamageRects();
+      const SkMatrix& root_matrix = canvas()->getTotalMatrix();
+      if (damage_rects && damage_rects->size() > 1 &&
+          root_matrix.rectStaysRect()) {
+        SkRegion damage_region;
+        for (const SkIRect& rect : *damage_rects) {
+          damage_region.op(root_matrix.mapRect(SkRect::Make(rect)).roundOut(),
+                           SkRegion::kUnion_Op);
+        }
+        canvas()->clipRegion(damage_region);
+      }
     }
 
     if (needs_save_layer) {
@@ -152,12 +210,12 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 
 void CompositorContext::OnGrContextCreated() {
   texture_registry_.OnGrContextCreated();
-  raster_cache_.Clear();
+  raster_cache_->Clear();
 }
 
 void CompositorContext::OnGrContextDestroyed() {
   texture_registry_.OnGrContextDestroyed();
-  raster_cache_.Clear();
+  raster_cache_->Clear();
 }
 
 }  // namespace flutter
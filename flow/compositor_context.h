@@ -7,14 +7,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layer_profiler.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -69,6 +72,12 @@ class FrameDamage {
     additional_damage_.join(damage);
   }
 
+  // Sets the registry of the textures of the frame. If not set, the regions of
+  // the texture layers are always damaged.
+  void SetTextureRegistry(const TextureRegistry* texture_registry) {
+    texture_registry_ = texture_registry;
+  }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provideddamage.
   // If previous layer tree is not specified, clip rect will be nulloptional,
@@ -86,10 +95,23 @@ class FrameDamage {
     return damage_ ? std::make_optional(damage_->buffer_damage) : std::nullopt;
   }
 
+  // See Damage::frame_damage_rects.
+  std::optional<std::vector<SkIRect>> GetFrameDamageRects() const {
+    return damage_ ? std::make_optional(damage_->frame_damage_rects)
+                   : std::nullopt;
+  }
+
+  // See Damage::buffer_damage_rects.
+  std::optional<std::vector<SkIRect>> GetBufferDamageRects() const {
+    return damage_ ? std::make_optional(damage_->buffer_damage_rects)
+                   : std::nullopt;
+  }
+
  private:
   SkIRect additional_damage_ = SkIRect::MakeEmpty();
   std::optional<Damage> damage_;
   const LayerTree* prev_layer_tree_ = nullptr;
+  const TextureRegistry* texture_registry_ = nullptr;
 };
 
 class CompositorContext {
@@ -155,7 +177,33 @@ class CompositorContext {
 
   void OnGrContextDestroyed();
 
-  RasterCache& raster_cache() { return raster_cache_; }
+  RasterCache& raster_cache() { return *raster_cache_; }
+
+  // Uses the raster cache of |other| instead of a cache of its own, so that
+  // the entries rasterized for one of the contexts can be drawn by the
+  // other. Both contexts must raster on the same thread. If the contexts
+  // end up drawing with different GrDirectContexts, this context goes back
+  // to a cache of its own.
+  void ShareRasterCache(CompositorContext& other);
+
+  // Prerolls independent layer subtrees concurrently on the |task_runner|.
+  // Passing nullptr prerolls the layer tree on the raster thread only.
+  void SetPrerollTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+    preroll_task_runner_ = std::move(task_runner);
+  }
+
+  fml::BasicTaskRunner* preroll_task_runner() const {
+    return preroll_task_runner_.get();
+  }
+
+  // Attributes the raster time of the frames to their layers from now on, or
+  // stops and forgets the stats recorded so far. Disables the concurrent
+  // preroll while it is enabled.
+  void SetLayerProfilingEnabled(bool enabled);
+
+  // The profiler of the layers, or null if layer profiling is disabled.
+  LayerProfiler* layer_profiler() const { return layer_profiler_.get(); }
 
   TextureRegistry& texture_registry() { return texture_registry_; }
 
@@ -165,8 +213,13 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  // Sets the frame budget of the raster and UI time stopwatches.
+  void SetFrameBudget(fml::Milliseconds frame_budget);
+
  private:
-  RasterCache raster_cache_;
+  std::shared_ptr<RasterCache> raster_cache_;
+  std::shared_ptr<fml::BasicTaskRunner> preroll_task_runner_;
+  std::unique_ptr<LayerProfiler> layer_profiler_;
   TextureRegistry texture_registry_;
   Counter frame_count_;
   Stopwatch raster_time_;
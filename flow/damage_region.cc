@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/damage_region.h"
+
+#include <limits>
+
+namespace flutter {
+
+static int64_t Area(const SkIRect& rect) {
+  return int64_t{rect.width()} * rect.height();
+}
+
+static SkIRect Join(const SkIRect& a, const SkIRect& b) {
+  SkIRect result = a;
+  result.join(b);
+  return result;
+}
+
+// The area of the union of the rects that neither of them covers.
+static int64_t WastedArea(const SkIRect& a, const SkIRect& b) {
+  SkIRect intersection;
+  int64_t covered = Area(a) + Area(b);
+  if (intersection.intersect(a, b)) {
+    covered -= Area(intersection);
+  }
+  return Area(Join(a, b)) - covered;
+}
+
+// Rects are merged without regard to the max count if the union of them
+// wastes at most this fraction of the area they cover.
+static constexpr int64_t kMergeWasteDivisor = 4;
+
+static bool ShouldMerge(const SkIRect& a, const SkIRect& b) {
+  return SkIRect::Intersects(a, b) ||
+         WastedArea(a, b) * kMergeWasteDivisor <= Area(a) + Area(b);
+}
+
+void DamageRegion::AddRect(const SkIRect& rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  // A merged rect may now overlap rects it didn't overlap before, so keep
+  // merging until it is disjoint from the others.
+  SkIRect pending = rect;
+  for (size_t i = 0; i < rects_.size();) {
+    if (ShouldMerge(rects_[i], pending)) {
+      pending.join(rects_[i]);
+      rects_.erase(rects_.begin() + i);
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+  if (rects_.size() < kMaxRects) {
+    rects_.push_back(pending);
+    return;
+  }
+
+  // Merge the pair that wastes the least area, which may be the new rect
+  // and one of the others.
+  rects_.push_back(pending);
+  size_t best_a = 0;
+  size_t best_b = 1;
+  int64_t best_waste = std::numeric_limits<int64_t>::max();
+  for (size_t a = 0; a < rects_.size(); a++) {
+    for (size_t b = a + 1; b < rects_.size(); b++) {
+      int64_t waste = WastedArea(rects_[a], rects_[b]);
+      if (waste < best_waste) {
+        best_waste = waste;
+        best_a = a;
+        best_b = b;
+      }
+    }
+  }
+  SkIRect merged = Join(rects_[best_a], rects_[best_b]);
+  rects_.erase(rects_.begin() + best_b);
+  rects_.erase(rects_.begin() + best_a);
+  AddRect(merged);
+}
+
+void DamageRegion::AddRegion(const DamageRegion& region) {
+  for (const SkIRect& rect : region.rects_) {
+    AddRect(rect);
+  }
+}
+
+void DamageRegion::Intersect(const SkIRect& clip) {
+  std::vector<SkIRect> rects;
+  for (SkIRect rect : rects_) {
+    if (rect.intersect(clip)) {
+      rects.push_back(rect);
+    }
+  }
+  rects_ = std::move(rects);
+}
+
+bool DamageRegion::Intersects(const SkIRect& rect) const {
+  for (const SkIRect& r : rects_) {
+    if (SkIRect::Intersects(r, rect)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+SkIRect DamageRegion::ComputeBounds() const {
+  SkIRect bounds = SkIRect::MakeEmpty();
+  for (const SkIRect& rect : rects_) {
+    bounds.join(rect);
+  }
+  return bounds;
+}
+
+}  // namespace flutter
@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DAMAGE_REGION_H_
+#define FLUTTER_FLOW_DAMAGE_REGION_H_
+
+#include <vector>
+
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+// A bounded list of rects that covers all of the damage added to it.
+//
+// Keeping separate rects allows unrelated changes in different parts of the
+// screen (such as a clock in one corner and a ticker in another) to be
+// repainted and presented without the area between them. Rects are merged
+// when they overlap or when their union wastes little area, and once there
+// would be more than |kMaxRects| rects the two rects whose union wastes the
+// least area are merged.
+class DamageRegion {
+ public:
+  // The most rects the region is made of. Presenting many rects has a cost
+  // of its own, and some swap with damage implementations degrade to a full
+  // swap beyond a handful of rects.
+  static constexpr size_t kMaxRects = 8;
+
+  DamageRegion() = default;
+
+  // Adds the |rect| to the region, merging rects as needed.
+  void AddRect(const SkIRect& rect);
+
+  // Adds all of the rects of the |region|.
+  void AddRegion(const DamageRegion& region);
+
+  // Intersects each rect with the |clip| and drops the rects outside of it.
+  void Intersect(const SkIRect& clip);
+
+  // Whether any of the rects intersect the |rect|.
+  bool Intersects(const SkIRect& rect) const;
+
+  const std::vector<SkIRect>& rects() const { return rects_; }
+
+  bool is_empty() const { return rects_.empty(); }
+
+  // The union of all of the rects.
+  SkIRect ComputeBounds() const;
+
+ private:
+  std::vector<SkIRect> rects_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DAMAGE_REGION_H_
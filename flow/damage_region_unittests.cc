@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/damage_region.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DamageRegion, DistantRectsStaySeparate) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeXYWH(0, 0, 10, 10));
+  region.AddRect(SkIRect::MakeXYWH(990, 990, 10, 10));
+  ASSERT_EQ(region.rects().size(), 2u);
+  ASSERT_EQ(region.ComputeBounds(), SkIRect::MakeWH(1000, 1000));
+}
+
+TEST(DamageRegion, OverlappingAndAdjacentRectsMerge) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeXYWH(0, 0, 10, 10));
+  region.AddRect(SkIRect::MakeXYWH(5, 5, 10, 10));
+  ASSERT_EQ(region.rects(), std::vector({SkIRect::MakeWH(15, 15)}));
+
+  region.AddRect(SkIRect::MakeXYWH(15, 0, 10, 15));
+  ASSERT_EQ(region.rects(), std::vector({SkIRect::MakeWH(25, 15)}));
+
+  // A merged rect is merged again with the rects it now overlaps.
+  region.AddRect(SkIRect::MakeXYWH(100, 0, 10, 15));
+  region.AddRect(SkIRect::MakeXYWH(20, 0, 85, 5));
+  ASSERT_EQ(region.rects(), std::vector({SkIRect::MakeWH(110, 15)}));
+}
+
+TEST(DamageRegion, RectCountIsBounded) {
+  DamageRegion region;
+  for (size_t i = 0; i < DamageRegion::kMaxRects * 2; i++) {
+    region.AddRect(SkIRect::MakeXYWH(i * 100, i * 100, 10, 10));
+  }
+  ASSERT_EQ(region.rects().size(), DamageRegion::kMaxRects);
+  size_t count = DamageRegion::kMaxRects * 2;
+  ASSERT_EQ(region.ComputeBounds(),
+            SkIRect::MakeLTRB(0, 0, (count - 1) * 100 + 10,
+                              (count - 1) * 100 + 10));
+}
+
+TEST(DamageRegion, IntersectDropsRectsOutsideOfClip) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeXYWH(0, 0, 10, 10));
+  region.AddRect(SkIRect::MakeXYWH(90, 90, 20, 20));
+  region.AddRect(SkIRect::MakeXYWH(200, 200, 10, 10));
+  region.Intersect(SkIRect::MakeWH(100, 100));
+  ASSERT_EQ(region.rects(), std::vector({SkIRect::MakeWH(10, 10),
+                                         SkIRect::MakeXYWH(90, 90, 10, 10)}));
+  ASSERT_TRUE(region.Intersects(SkIRect::MakeXYWH(5, 5, 1, 1)));
+  ASSERT_FALSE(region.Intersects(SkIRect::MakeXYWH(50, 50, 10, 10)));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -69,27 +69,28 @@ SkRect DiffContext::ApplyFilterBoundsAdjustment(SkRect rect) const {
 
 Damage DiffContext::ComputeDamage(
     const SkIRect& accumulated_buffer_damage) const {
-  SkRect buffer_damage = SkRect::Make(accumulated_buffer_damage);
-  buffer_damage.join(damage_);
-  SkRect frame_damage(damage_);
+  DamageRegion buffer_damage = damage_;
+  buffer_damage.AddRect(accumulated_buffer_damage);
+  DamageRegion frame_damage = damage_;
 
   for (const auto& r : readbacks_) {
-    SkRect rect = SkRect::Make(r.rect);
-    if (rect.intersects(frame_damage)) {
-      frame_damage.join(rect);
+    if (frame_damage.Intersects(r.rect)) {
+      frame_damage.AddRect(r.rect);
     }
-    if (rect.intersects(buffer_damage)) {
-      buffer_damage.join(rect);
+    if (buffer_damage.Intersects(r.rect)) {
+      buffer_damage.AddRect(r.rect);
     }
   }
 
-  Damage res;
-  buffer_damage.roundOut(&res.buffer_damage);
-  frame_damage.roundOut(&res.frame_damage);
-
   SkIRect frame_clip = SkIRect::MakeSize(frame_size_);
-  res.buffer_damage.intersect(frame_clip);
-  res.frame_damage.intersect(frame_clip);
+  buffer_damage.Intersect(frame_clip);
+  frame_damage.Intersect(frame_clip);
+
+  Damage res;
+  res.buffer_damage = buffer_damage.ComputeBounds();
+  res.buffer_damage_rects = buffer_damage.rects();
+  res.frame_damage = frame_damage.ComputeBounds();
+  res.frame_damage_rects = frame_damage.rects();
   return res;
 }
 
@@ -170,6 +171,16 @@ void DiffContext::AddReadbackRegion(const SkIRect& rect) {
   readbacks_.push_back(std::move(readback));
 }
 
+bool DiffContext::IsDamaged(const SkIRect& rect) const {
+  DamageRegion damage = damage_;
+  for (const auto& r : readbacks_) {
+    if (damage.Intersects(r.rect)) {
+      damage.AddRect(r.rect);
+    }
+  }
+  return damage.Intersects(rect);
+}
+
 PaintRegion DiffContext::CurrentSubtreeRegion() const {
   bool has_readback = std::any_of(
       readbacks_.begin(), readbacks_.end(),
@@ -181,12 +192,12 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_.join(r);
+    damage_.AddRect(r.roundOut());
   }
 }
 
 void DiffContext::AddDamage(const SkRect& rect) {
-  damage_.join(rect);
+  damage_.AddRect(rect.roundOut());
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
@@ -194,6 +205,14 @@ void DiffContext::SetLayerPaintRegion(const Layer* layer,
   this_frame_paint_region_map_[layer->unique_id()] = region;
 }
 
+void DiffContext::MarkLayerRetained(const Layer* layer) {
+  retained_layers_.insert(layer->unique_id());
+}
+
+void DiffContext::MarkBackdropUnchanged(const Layer* layer) {
+  unchanged_backdrops_.insert(layer->unique_id());
+}
+
 PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
   auto i = last_frame_paint_region_map_.find(layer->unique_id());
   if (i != last_frame_paint_region_map_.end()) {
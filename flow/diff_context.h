@@ -8,7 +8,9 @@
 #include <functional>
 #include <map>
 #include <optional>
+#include <unordered_set>
 #include <vector>
+#include "flutter/flow/damage_region.h"
 #include "flutter/flow/paint_region.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
@@ -18,6 +20,7 @@
 namespace flutter {
 
 class Layer;
+class TextureRegistry;
 
 // Represents area that needs to be updated in front buffer (frame_damage) and
 // area that is going to be painted to in back buffer (buffer_damage).
@@ -28,12 +31,19 @@ struct Damage {
   // Corresponds to "surface damage" from EGL_KHR_partial_update.
   SkIRect frame_damage;
 
+  // The disjoint rects that frame_damage is the bounds of. Presenting only
+  // these rects avoids recomposing the area between unrelated changes.
+  std::vector<SkIRect> frame_damage_rects;
+
   // Reflects actual change to target framebuffer; This is frame_damage +
   // damage previously acumulated for target framebuffer.
   // All drawing will be clipped to this region. Knowing the affected area
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   SkIRect buffer_damage;
+
+  // The disjoint rects that buffer_damage is the bounds of.
+  std::vector<SkIRect> buffer_damage_rects;
 };
 
 // Layer Unique Id to PaintRegion
@@ -108,6 +118,14 @@ class DiffContext {
   // ensure that we'll Diff the TextureLayer even if inside retained layer.
   void MarkSubtreeHasTextureLayer();
 
+  // The registry of the textures that are painted by the frame, which lets
+  // TextureLayers that paint the same texture frame as in the previous frame
+  // leave their region undamaged. Null if unknown.
+  void SetTextureRegistry(const TextureRegistry* registry) {
+    texture_registry_ = registry;
+  }
+  const TextureRegistry* texture_registry() const { return texture_registry_; }
+
   // Add layer bounds to current paint region; rect is in "local" (layer)
   // coordinates.
   void AddLayerBounds(const SkRect& rect);
@@ -123,6 +141,14 @@ class DiffContext {
   // Readback rect is in screen coordinates.
   void AddReadbackRegion(const SkIRect& rect);
 
+  // Whether the damage added so far, which comes from the layers painted
+  // before the current one, covers any part of the rect. The readback regions
+  // added so far that the damage touches count as damaged as a whole, since
+  // the layers that read them back paint differently.
+  //
+  // Rect is in screen coordinates.
+  bool IsDamaged(const SkIRect& rect) const;
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -151,6 +177,26 @@ class DiffContext {
   // frame layer tree.
   PaintRegion GetOldLayerPaintRegion(const Layer* layer) const;
 
+  // Records that the layer is a retained layer whose subtree will render
+  // identically to the previous frame. Preroll uses this to reuse the
+  // results of the previous preroll of the subtree.
+  void MarkLayerRetained(const Layer* layer);
+
+  // The unique ids of the layers passed to MarkLayerRetained.
+  std::unordered_set<uint64_t> TakeRetainedLayers() {
+    return std::move(retained_layers_);
+  }
+
+  // Records that the backdrop the layer reads back is identical to the one it
+  // read back in the previous frame. Paint uses this to reuse the filtered
+  // backdrop of the previous frame.
+  void MarkBackdropUnchanged(const Layer* layer);
+
+  // The unique ids of the layers passed to MarkBackdropUnchanged.
+  std::unordered_set<uint64_t> TakeUnchangedBackdrops() {
+    return std::move(unchanged_backdrops_);
+  }
+
   class Statistics {
    public:
     // Picture replaced by different picture
@@ -223,10 +269,13 @@ class DiffContext {
   // Rect must be in device coordinates.
   SkRect ApplyFilterBoundsAdjustment(SkRect rect) const;
 
-  SkRect damage_ = SkRect::MakeEmpty();
+  DamageRegion damage_;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
+  std::unordered_set<uint64_t> retained_layers_;
+  std::unordered_set<uint64_t> unchanged_backdrops_;
+  const TextureRegistry* texture_registry_ = nullptr;
 
   void AddDamage(const SkRect& rect);
 
@@ -2,12 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/flow/display_list.h"
 #include "flutter/flow/display_list_canvas.h"
 #include "flutter/flow/display_list_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 
 #include "third_party/skia/include/core/SkImageFilter.h"
 #include "third_party/skia/include/core/SkMaskFilter.h"
@@ -78,7 +80,8 @@ struct DLOp {
                                                              \
     const bool value;                                        \
                                                              \
-    void dispatch(Dispatcher& dispatcher) const {            \
+    template <typename D>                                    \
+    void dispatch(D& dispatcher) const {                     \
       dispatcher.set##name(value);                           \
     }                                                        \
   };
@@ -96,7 +99,8 @@ DEFINE_SET_BOOL_OP(InvertColors)
                                                                    \
     const SkPaint::name value;                                     \
                                                                    \
-    void dispatch(Dispatcher& dispatcher) const {                  \
+    template <typename D>                                          \
+    void dispatch(D& dispatcher) const {                           \
       dispatcher.setStroke##name(value);                           \
     }                                                              \
   };
@@ -112,7 +116,8 @@ struct SetStyleOp final : DLOp {
 
   const SkPaint::Style style;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.setStyle(style); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.setStyle(style); }
 };
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 struct SetStrokeWidthOp final : DLOp {
@@ -122,9 +127,8 @@ struct SetStrokeWidthOp final : DLOp {
 
   const SkScalar width;
 
-  void dispatch(Dispatcher& dispatcher) const {
-    dispatcher.setStrokeWidth(width);
-  }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.setStrokeWidth(width); }
 };
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 struct SetStrokeMiterOp final : DLOp {
@@ -134,9 +138,8 @@ struct SetStrokeMiterOp final : DLOp {
 
   const SkScalar limit;
 
-  void dispatch(Dispatcher& dispatcher) const {
-    dispatcher.setStrokeMiter(limit);
-  }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.setStrokeMiter(limit); }
 };
 
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
@@ -147,7 +150,8 @@ struct SetColorOp final : DLOp {
 
   const SkColor color;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.setColor(color); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.setColor(color); }
 };
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 struct SetBlendModeOp final : DLOp {
@@ -157,7 +161,8 @@ struct SetBlendModeOp final : DLOp {
 
   const SkBlendMode mode;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.setBlendMode(mode); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.setBlendMode(mode); }
 };
 
 // Clear: 4 byte header + unused 4 byte payload uses 8 bytes
@@ -171,7 +176,8 @@ struct SetBlendModeOp final : DLOp {
                                                                       \
     Clear##name##Op() {}                                              \
                                                                       \
-    void dispatch(Dispatcher& dispatcher) const {                     \
+    template <typename D>                                             \
+    void dispatch(D& dispatcher) const {                              \
       dispatcher.set##name(nullptr);                                  \
     }                                                                 \
   };                                                                  \
@@ -182,7 +188,8 @@ struct SetBlendModeOp final : DLOp {
                                                                       \
     sk_sp<Sk##name> field;                                            \
                                                                       \
-    void dispatch(Dispatcher& dispatcher) const {                     \
+    template <typename D>                                             \
+    void dispatch(D& dispatcher) const {                              \
       dispatcher.set##name(field);                                    \
     }                                                                 \
   };
@@ -205,7 +212,8 @@ DEFINE_SET_CLEAR_SKREF_OP(PathEffect, effect)
                                                                            \
     SkScalar sigma;                                                        \
                                                                            \
-    void dispatch(Dispatcher& dispatcher) const {                          \
+    template <typename D>                                                  \
+    void dispatch(D& dispatcher) const {                                   \
       dispatcher.setMaskBlurFilter(style, sigma);                          \
     }                                                                      \
   };
@@ -221,7 +229,8 @@ struct SaveOp final : DLOp {
 
   SaveOp() {}
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.save(); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.save(); }
 };
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 struct SaveLayerOp final : DLOp {
@@ -231,7 +240,8 @@ struct SaveLayerOp final : DLOp {
 
   bool with_paint;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.saveLayer(nullptr, with_paint);
   }
 };
@@ -245,7 +255,8 @@ struct SaveLayerBoundsOp final : DLOp {
   bool with_paint;
   const SkRect rect;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.saveLayer(&rect, with_paint);
   }
 };
@@ -255,7 +266,8 @@ struct RestoreOp final : DLOp {
 
   RestoreOp() {}
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.restore(); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.restore(); }
 };
 
 // 4 byte header + 8 byte payload uses 12 bytes but is rounded up to 16 bytes
@@ -268,7 +280,8 @@ struct TranslateOp final : DLOp {
   const SkScalar tx;
   const SkScalar ty;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.translate(tx, ty); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.translate(tx, ty); }
 };
 // 4 byte header + 8 byte payload uses 12 bytes but is rounded up to 16 bytes
 // (4 bytes unused)
@@ -280,7 +293,8 @@ struct ScaleOp final : DLOp {
   const SkScalar sx;
   const SkScalar sy;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.scale(sx, sy); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.scale(sx, sy); }
 };
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 struct RotateOp final : DLOp {
@@ -290,7 +304,8 @@ struct RotateOp final : DLOp {
 
   const SkScalar degrees;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.rotate(degrees); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.rotate(degrees); }
 };
 // 4 byte header + 8 byte payload uses 12 bytes but is rounded up to 16 bytes
 // (4 bytes unused)
@@ -302,7 +317,8 @@ struct SkewOp final : DLOp {
   const SkScalar sx;
   const SkScalar sy;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.skew(sx, sy); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.skew(sx, sy); }
 };
 // 4 byte header + 24 byte payload uses 28 bytes but is rounded up to 32 bytes
 // (4 bytes unused)
@@ -318,7 +334,8 @@ struct Transform2DAffineOp final : DLOp {
   const SkScalar mxx, mxy, mxt;
   const SkScalar myx, myy, myt;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.transform2DAffine(mxx, mxy, mxt,  //
                                  myx, myy, myt);
   }
@@ -345,7 +362,8 @@ struct TransformFullPerspectiveOp final : DLOp {
   const SkScalar mzx, mzy, mzz, mzt;
   const SkScalar mwx, mwy, mwz, mwt;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.transformFullPerspective(mxx, mxy, mxz, mxt,  //
                                         myx, myy, myz, myt,  //
                                         mzx, mzy, mzz, mzt,  //
@@ -373,7 +391,8 @@ struct TransformFullPerspectiveOp final : DLOp {
     const bool is_aa;                                                      \
     const Sk##shapetype shape;                                             \
                                                                            \
-    void dispatch(Dispatcher& dispatcher) const {                          \
+    template <typename D>                                                  \
+    void dispatch(D& dispatcher) const {                                   \
       dispatcher.clip##shapetype(shape, SkClipOp::k##clipop, is_aa);       \
     }                                                                      \
   };
@@ -393,7 +412,8 @@ DEFINE_CLIP_SHAPE_OP(RRect, Difference)
     const bool is_aa;                                                    \
     const SkPath path;                                                   \
                                                                          \
-    void dispatch(Dispatcher& dispatcher) const {                        \
+    template <typename D>                                                \
+    void dispatch(D& dispatcher) const {                                 \
       dispatcher.clipPath(path, SkClipOp::k##clipop, is_aa);             \
     }                                                                    \
                                                                          \
@@ -413,7 +433,8 @@ struct DrawPaintOp final : DLOp {
 
   DrawPaintOp() {}
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.drawPaint(); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.drawPaint(); }
 };
 // 4 byte header + 8 byte payload uses 12 bytes but is rounded up to 16 bytes
 // (4 bytes unused)
@@ -425,9 +446,8 @@ struct DrawColorOp final : DLOp {
   const SkColor color;
   const SkBlendMode mode;
 
-  void dispatch(Dispatcher& dispatcher) const {
-    dispatcher.drawColor(color, mode);
-  }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.drawColor(color, mode); }
 };
 
 // The common data is a 4 byte header with an unused 4 bytes
@@ -443,7 +463,8 @@ struct DrawColorOp final : DLOp {
                                                                  \
     const arg_type arg_name;                                     \
                                                                  \
-    void dispatch(Dispatcher& dispatcher) const {                \
+    template <typename D>                                        \
+    void dispatch(D& dispatcher) const {                         \
       dispatcher.draw##op_name(arg_name);                        \
     }                                                            \
   };
@@ -461,7 +482,8 @@ struct DrawPathOp final : DLOp {
 
   const SkPath path;
 
-  void dispatch(Dispatcher& dispatcher) const { dispatcher.drawPath(path); }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.drawPath(path); }
 
   DisplayListCompare equals(const DrawPathOp* other) const {
     return path == other->path ? DisplayListCompare::kEqual
@@ -485,7 +507,8 @@ struct DrawPathOp final : DLOp {
     const type1 name1;                                           \
     const type2 name2;                                           \
                                                                  \
-    void dispatch(Dispatcher& dispatcher) const {                \
+    template <typename D>                                        \
+    void dispatch(D& dispatcher) const {                         \
       dispatcher.draw##op_name(name1, name2);                    \
     }                                                            \
   };
@@ -506,7 +529,8 @@ struct DrawArcOp final : DLOp {
   const SkScalar sweep;
   const bool center;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.drawArc(bounds, start, sweep, center);
   }
 };
@@ -525,7 +549,8 @@ struct DrawArcOp final : DLOp {
                                                                        \
     const uint32_t count;                                              \
                                                                        \
-    void dispatch(Dispatcher& dispatcher) const {                      \
+    template <typename D>                                              \
+    void dispatch(D& dispatcher) const {                               \
       const SkPoint* pts = reinterpret_cast<const SkPoint*>(this + 1); \
       dispatcher.drawPoints(SkCanvas::PointMode::mode, count, pts);    \
     }                                                                  \
@@ -545,7 +570,8 @@ struct DrawVerticesOp final : DLOp {
   const SkBlendMode mode;
   const sk_sp<SkVertices> vertices;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.drawVertices(vertices, mode);
   }
 };
@@ -564,7 +590,8 @@ struct DrawVerticesOp final : DLOp {
     const SkSamplingOptions sampling;                                  \
     const sk_sp<SkImage> image;                                        \
                                                                        \
-    void dispatch(Dispatcher& dispatcher) const {                      \
+    template <typename D>                                              \
+    void dispatch(D& dispatcher) const {                               \
       dispatcher.drawImage(image, point, sampling, with_attributes);   \
     }                                                                  \
   };
@@ -596,7 +623,8 @@ struct DrawImageRectOp final : DLOp {
   const SkCanvas::SrcRectConstraint constraint;
   const sk_sp<SkImage> image;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.drawImageRect(image, src, dst, sampling, render_with_attributes,
                              constraint);
   }
@@ -618,7 +646,8 @@ struct DrawImageRectOp final : DLOp {
     const SkFilterMode filter;                                                 \
     const sk_sp<SkImage> image;                                                \
                                                                                \
-    void dispatch(Dispatcher& dispatcher) const {                              \
+    template <typename D>                                                      \
+    void dispatch(D& dispatcher) const {                                       \
       dispatcher.drawImageNine(image, center, dst, filter,                     \
                                render_with_attributes);                        \
     }                                                                          \
@@ -657,7 +686,8 @@ struct DrawImageLatticeOp final : DLOp {
   const SkRect dst;
   const sk_sp<SkImage> image;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     const int* xDivs = reinterpret_cast<const int*>(this + 1);
     const int* yDivs = reinterpret_cast<const int*>(xDivs + x_count);
     const SkColor* colors =
@@ -720,7 +750,8 @@ struct DrawAtlasOp final : DrawAtlasBaseOp {
                         has_colors,
                         render_with_attributes) {}
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     const SkRSXform* xform = reinterpret_cast<const SkRSXform*>(this + 1);
     const SkRect* tex = reinterpret_cast<const SkRect*>(xform + count);
     const SkColor* colors =
@@ -755,7 +786,8 @@ struct DrawAtlasCulledOp final : DrawAtlasBaseOp {
 
   const SkRect cull_rect;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     const SkRSXform* xform = reinterpret_cast<const SkRSXform*>(this + 1);
     const SkRect* tex = reinterpret_cast<const SkRect*>(xform + count);
     const SkColor* colors =
@@ -777,7 +809,8 @@ struct DrawSkPictureOp final : DLOp {
   const bool render_with_attributes;
   const sk_sp<SkPicture> picture;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.drawPicture(picture, nullptr, render_with_attributes);
   }
 };
@@ -797,7 +830,8 @@ struct DrawSkPictureMatrixOp final : DLOp {
   const sk_sp<SkPicture> picture;
   const SkMatrix matrix;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.drawPicture(picture, &matrix, render_with_attributes);
   }
 };
@@ -812,7 +846,8 @@ struct DrawDisplayListOp final : DLOp {
 
   sk_sp<DisplayList> display_list;
 
-  void dispatch(Dispatcher& dispatcher) const {
+  template <typename D>
+  void dispatch(D& dispatcher) const {
     dispatcher.drawDisplayList(display_list);
   }
 };
@@ -829,9 +864,8 @@ struct DrawTextBlobOp final : DLOp {
   const SkScalar y;
   const sk_sp<SkTextBlob> blob;
 
-  void dispatch(Dispatcher& dispatcher) const {
-    dispatcher.drawTextBlob(blob, x, y);
-  }
+  template <typename D>
+  void dispatch(D& dispatcher) const { dispatcher.drawTextBlob(blob, x, y); }
 };
 
 // 4 byte header + 28 byte payload packs evenly into 32 bytes
@@ -850,7 +884,8 @@ struct DrawTextBlobOp final : DLOp {
     const SkScalar dpr;                                                   \
     const SkPath path;                                                    \
                                                                           \
-    void dispatch(Dispatcher& dispatcher) const {                         \
+    template <typename D>                                                 \
+    void dispatch(D& dispatcher) const {                                  \
       dispatcher.drawShadow(path, color, elevation, transparent_occluder, \
                             dpr);                                         \
     }                                                                     \
@@ -861,15 +896,14 @@ DEFINE_DRAW_SHADOW_OP(ShadowTransparentOccluder, true)
 
 #pragma pack(pop, DLOp_Alignment)
 
-void DisplayList::ComputeBounds() {
-  DisplayListBoundsCalculator calculator(&bounds_cull_);
-  Dispatch(calculator);
-  bounds_ = calculator.bounds();
-}
-
-void DisplayList::Dispatch(Dispatcher& dispatcher,
-                           uint8_t* ptr,
-                           uint8_t* end) const {
+// The op records call the methods on the dispatcher using its static
+// type, so when |T| is a concrete (final) Dispatcher implementation the
+// compiler can bind each call directly rather than going through the
+// Dispatcher vtable for every op.
+template <typename T>
+void DisplayList::DispatchOps(T& dispatcher,
+                              uint8_t* ptr,
+                              uint8_t* end) const {
   while (ptr < end) {
     auto op = (const DLOp*)ptr;
     ptr += op->size;
@@ -891,6 +925,250 @@ void DisplayList::Dispatch(Dispatcher& dispatcher,
   }
 }
 
+void DisplayList::Dispatch(Dispatcher& dispatcher,
+                           uint8_t* ptr,
+                           uint8_t* end) const {
+  DispatchOps(dispatcher, ptr, end);
+}
+
+void DisplayList::ComputeBounds() {
+  DisplayListBoundsCalculator calculator(&bounds_cull_);
+  uint8_t* ptr = storage_.get();
+  DispatchOps(calculator, ptr, ptr + byte_count_);
+  bounds_ = calculator.bounds();
+}
+
+// The relative cost of each op, in units of a simple rect fill.
+// Attribute, transform and plain save/restore ops only update the
+// state of the dispatcher and are considered free. Ops whose cost
+// depends on the size of their data are handled in ComputeComplexity.
+static unsigned int OpComplexity(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+      return 10;
+
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipDifferenceRect:
+      return 1;
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipDifferenceRRect:
+      return 3;
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferencePath:
+      return 5;
+
+    case DisplayListOpType::kDrawLine:
+    case DisplayListOpType::kDrawRect:
+    case DisplayListOpType::kDrawOval:
+    case DisplayListOpType::kDrawCircle:
+      return 1;
+    case DisplayListOpType::kDrawPaint:
+    case DisplayListOpType::kDrawColor:
+    case DisplayListOpType::kDrawRRect:
+    case DisplayListOpType::kDrawArc:
+    case DisplayListOpType::kDrawImage:
+    case DisplayListOpType::kDrawImageWithAttr:
+    case DisplayListOpType::kDrawImageRect:
+      return 2;
+    case DisplayListOpType::kDrawDRRect:
+      return 3;
+    case DisplayListOpType::kDrawImageNine:
+    case DisplayListOpType::kDrawImageNineWithAttr:
+    case DisplayListOpType::kDrawImageLattice:
+    case DisplayListOpType::kDrawAtlas:
+    case DisplayListOpType::kDrawAtlasCulled:
+      return 4;
+    case DisplayListOpType::kDrawPath:
+    case DisplayListOpType::kDrawVertices:
+    case DisplayListOpType::kDrawTextBlob:
+      return 5;
+    case DisplayListOpType::kDrawShadow:
+    case DisplayListOpType::kDrawShadowTransparentOccluder:
+      return 15;
+
+    default:
+      return 0;
+  }
+}
+
+void DisplayList::ComputeComplexity() {
+  unsigned int score = 0;
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    ptr += op->size;
+    switch (op->type) {
+      case DisplayListOpType::kDrawPoints:
+        score += 1 + static_cast<const DrawPointsOp*>(op)->count / 16;
+        break;
+      case DisplayListOpType::kDrawLines:
+        score += 1 + static_cast<const DrawLinesOp*>(op)->count / 16;
+        break;
+      case DisplayListOpType::kDrawPolygon:
+        score += 1 + static_cast<const DrawPolygonOp*>(op)->count / 16;
+        break;
+      case DisplayListOpType::kDrawSkPicture:
+        score += static_cast<const DrawSkPictureOp*>(op)
+                     ->picture->approximateOpCount(true);
+        break;
+      case DisplayListOpType::kDrawSkPictureMatrix:
+        score += static_cast<const DrawSkPictureMatrixOp*>(op)
+                     ->picture->approximateOpCount(true);
+        break;
+      case DisplayListOpType::kDrawDisplayList:
+        score += static_cast<const DrawDisplayListOp*>(op)
+                     ->display_list->complexity_score();
+        break;
+      default:
+        score += OpComplexity(op->type);
+        break;
+    }
+  }
+  complexity_score_ = score;
+}
+
+// All of the rendering ops follow the clip ops in the list of op types
+// (see FOR_EACH_DISPLAY_LIST_OP) and so the rendering ops can be
+// identified with a simple range check.
+static bool IsRenderingOp(DisplayListOpType type) {
+  return type >= DisplayListOpType::kDrawPaint;
+}
+
+static bool IsSaveLayerOp(DisplayListOpType type) {
+  return type == DisplayListOpType::kSaveLayer ||
+         type == DisplayListOpType::kSaveLayerBounds;
+}
+
+// Returns the address following the restore that matches the
+// save or saveLayer op that ends at |ptr|.
+static uint8_t* SkipToMatchingRestore(uint8_t* ptr, uint8_t* end) {
+  int depth = 1;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    switch (op->type) {
+      case DisplayListOpType::kSave:
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+        depth++;
+        break;
+      case DisplayListOpType::kRestore:
+        if (--depth == 0) {
+          return ptr;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return end;
+}
+
+void DisplayList::ComputeRTree() {
+  DisplayListBoundsCalculator calculator(&bounds_cull_);
+  std::vector<SkRect> rects;
+  rtree_offsets_.clear();
+
+  // The byte offsets of the currently outstanding save and saveLayer
+  // calls. A |save| is recorded with an offset of -1 since a top-level
+  // rendering op that occurs inside of it is indexed on its own.
+  std::vector<ptrdiff_t> save_offsets;
+
+  uint8_t* start = storage_.get();
+  uint8_t* end = start + byte_count_;
+  uint8_t* ptr = start;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    uint8_t* next = ptr + op->size;
+    ptrdiff_t offset = ptr - start;
+    DispatchOps(calculator, ptr, next);
+    ptrdiff_t indexed_offset = -1;
+    switch (op->type) {
+      case DisplayListOpType::kSave:
+        save_offsets.push_back(-1);
+        break;
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+        save_offsets.push_back(offset);
+        break;
+      case DisplayListOpType::kRestore:
+        // The bounds of a saveLayer are accumulated into the root layer
+        // when it is restored, but the culled dispatch will make its
+        // decision when it reaches the saveLayer op itself.
+        indexed_offset = save_offsets.back();
+        save_offsets.pop_back();
+        break;
+      default:
+        if (IsRenderingOp(op->type)) {
+          indexed_offset = offset;
+        }
+        break;
+    }
+    SkRect op_bounds;
+    if (calculator.TakeRootOpBounds(&op_bounds) && indexed_offset >= 0) {
+      rects.push_back(op_bounds);
+      rtree_offsets_.push_back(indexed_offset);
+    }
+    ptr = next;
+  }
+  bounds_ = calculator.bounds();
+
+  rtree_ = sk_make_sp<RTree>();
+  rtree_->insert(rects.data(), rects.size());
+}
+
+template <typename T>
+void DisplayList::DispatchCulled(T& dispatcher,
+                                 const SkRect& cull_rect) const {
+  uint8_t* start = storage_.get();
+  uint8_t* end = start + byte_count_;
+  if (!rtree_ || cull_rect.contains(bounds_)) {
+    DispatchOps(dispatcher, start, end);
+    return;
+  }
+  std::vector<int> rect_indices;
+  rtree_->search(cull_rect, &rect_indices);
+  std::vector<size_t> offsets;
+  offsets.reserve(rect_indices.size());
+  for (int index : rect_indices) {
+    offsets.push_back(rtree_offsets_[index]);
+  }
+  std::sort(offsets.begin(), offsets.end());
+
+  auto next_offset = offsets.begin();
+  uint8_t* ptr = start;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    uint8_t* next = ptr + op->size;
+    FML_DCHECK(next <= end);
+    size_t offset = ptr - start;
+    bool is_save_layer = IsSaveLayerOp(op->type);
+    if (is_save_layer || IsRenderingOp(op->type)) {
+      if (is_save_layer) {
+        next = SkipToMatchingRestore(next, end);
+      }
+      while (next_offset != offsets.end() && *next_offset < offset) {
+        next_offset++;
+      }
+      if (next_offset != offsets.end() && *next_offset == offset) {
+        DispatchOps(dispatcher, ptr, next);
+        next_offset++;
+      }
+    } else {
+      DispatchOps(dispatcher, ptr, next);
+    }
+    ptr = next;
+  }
+}
+
+void DisplayList::Dispatch(Dispatcher& dispatcher,
+                           const SkRect& cull_rect) const {
+  DispatchCulled(dispatcher, cull_rect);
+}
+
 static void DisposeOps(uint8_t* ptr, uint8_t* end) {
   while (ptr < end) {
     auto op = (const DLOp*)ptr;
@@ -981,9 +1259,472 @@ static bool CompareOps(uint8_t* ptrA,
   return true;
 }
 
-void DisplayList::RenderTo(SkCanvas* canvas) const {
-  DisplayListCanvasDispatcher dispatcher(canvas);
-  Dispatch(dispatcher);
+// Whether a rendering op takes its color from the current attributes
+// such that modulating the alpha of the color is equivalent to applying
+// an opacity to the results of the op. Ops that may overlap themselves,
+// such as point lists, vertex meshes or the glyphs of a text blob, are
+// excluded as are ops that render other lists or pictures.
+static bool IsGroupOpacityCompatible(const DLOp* op) {
+  switch (op->type) {
+    case DisplayListOpType::kDrawPaint:
+    case DisplayListOpType::kDrawLine:
+    case DisplayListOpType::kDrawRect:
+    case DisplayListOpType::kDrawOval:
+    case DisplayListOpType::kDrawCircle:
+    case DisplayListOpType::kDrawRRect:
+    case DisplayListOpType::kDrawDRRect:
+    case DisplayListOpType::kDrawArc:
+    case DisplayListOpType::kDrawPath:
+    case DisplayListOpType::kDrawImageWithAttr:
+    case DisplayListOpType::kDrawImageNineWithAttr:
+      return true;
+    case DisplayListOpType::kDrawImageRect:
+      return static_cast<const DrawImageRectOp*>(op)->render_with_attributes;
+    case DisplayListOpType::kDrawImageLattice:
+      return static_cast<const DrawImageLatticeOp*>(op)->with_paint;
+    default:
+      return false;
+  }
+}
+
+void DisplayList::ComputeGroupOpacity() {
+  can_apply_group_opacity_ = false;
+  if (op_count_ > kMaxGroupOpacityOps) {
+    return;
+  }
+
+  // The attributes that would be affected by modulating the alpha of
+  // the color in a way that differs from applying a group opacity.
+  bool is_src_over = true;
+  bool has_blender = false;
+  bool has_color_filter = false;
+  bool has_image_filter = false;
+  bool invert_colors = false;
+
+  DisplayListBoundsCalculator calculator(&bounds_cull_);
+  std::vector<SkRect> rendered;
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    uint8_t* next = ptr + op->size;
+    DispatchOps(calculator, ptr, next);
+    ptr = next;
+    switch (op->type) {
+      case DisplayListOpType::kSetBlendMode:
+        is_src_over = static_cast<const SetBlendModeOp*>(op)->mode ==
+                      SkBlendMode::kSrcOver;
+        has_blender = false;
+        break;
+      case DisplayListOpType::kSetBlender:
+        has_blender = true;
+        break;
+      case DisplayListOpType::kClearBlender:
+        is_src_over = true;
+        has_blender = false;
+        break;
+      case DisplayListOpType::kSetColorFilter:
+        has_color_filter = true;
+        break;
+      case DisplayListOpType::kClearColorFilter:
+        has_color_filter = false;
+        break;
+      case DisplayListOpType::kSetImageFilter:
+        has_image_filter = true;
+        break;
+      case DisplayListOpType::kClearImageFilter:
+        has_image_filter = false;
+        break;
+      case DisplayListOpType::kSetInvertColors:
+        invert_colors = static_cast<const SetInvertColorsOp*>(op)->value;
+        break;
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+        return;
+      default:
+        break;
+    }
+    if (!IsRenderingOp(op->type)) {
+      continue;
+    }
+    if (!IsGroupOpacityCompatible(op) || !is_src_over || has_blender ||
+        has_color_filter || has_image_filter || invert_colors) {
+      return;
+    }
+    SkRect op_bounds;
+    if (!calculator.TakeRootOpBounds(&op_bounds)) {
+      continue;
+    }
+    for (const SkRect& previous : rendered) {
+      if (previous.intersects(op_bounds)) {
+        return;
+      }
+    }
+    rendered.push_back(op_bounds);
+  }
+  can_apply_group_opacity_ = true;
+}
+
+static bool IsTextureBacked(const sk_sp<SkImage>& image) {
+  return image && image->isTextureBacked();
+}
+
+void DisplayList::ComputeRenderOffThread() {
+  can_render_off_thread_ = false;
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    ptr += op->size;
+    switch (op->type) {
+      case DisplayListOpType::kSetShader: {
+        auto shader_op = static_cast<const SetShaderOp*>(op);
+        SkImage* image = shader_op->shader->isAImage(nullptr, nullptr);
+        if (image && image->isTextureBacked()) {
+          return;
+        }
+        break;
+      }
+      case DisplayListOpType::kSetImageFilter:
+      case DisplayListOpType::kDrawSkPicture:
+      case DisplayListOpType::kDrawSkPictureMatrix:
+        return;
+      case DisplayListOpType::kDrawImage:
+      case DisplayListOpType::kDrawImageWithAttr:
+        // Both variants share the layout of DrawImageOp
+        if (IsTextureBacked(static_cast<const DrawImageOp*>(op)->image)) {
+          return;
+        }
+        break;
+      case DisplayListOpType::kDrawImageRect:
+        if (IsTextureBacked(static_cast<const DrawImageRectOp*>(op)->image)) {
+          return;
+        }
+        break;
+      case DisplayListOpType::kDrawImageNine:
+      case DisplayListOpType::kDrawImageNineWithAttr:
+        // Both variants share the layout of DrawImageNineOp
+        if (IsTextureBacked(static_cast<const DrawImageNineOp*>(op)->image)) {
+          return;
+        }
+        break;
+      case DisplayListOpType::kDrawImageLattice:
+        if (IsTextureBacked(
+                static_cast<const DrawImageLatticeOp*>(op)->image)) {
+          return;
+        }
+        break;
+      case DisplayListOpType::kDrawAtlas:
+      case DisplayListOpType::kDrawAtlasCulled:
+        if (IsTextureBacked(static_cast<const DrawAtlasBaseOp*>(op)->atlas)) {
+          return;
+        }
+        break;
+      case DisplayListOpType::kDrawDisplayList:
+        if (!static_cast<const DrawDisplayListOp*>(op)
+                 ->display_list->can_render_off_thread()) {
+          return;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  can_render_off_thread_ = true;
+}
+
+void DisplayList::ComputeOpaqueBounds() {
+  opaque_bounds_.setEmpty();
+
+  // The attributes that determine whether a fill is opaque.
+  SkColor color = SK_ColorBLACK;
+  SkBlendMode blend_mode = SkBlendMode::kSrcOver;
+  bool has_blender = false;
+  bool is_fill = true;
+  bool has_shader = false;
+  bool has_color_filter = false;
+  bool has_image_filter = false;
+  bool has_mask_filter = false;
+  bool has_path_effect = false;
+
+  // The save depth at which the first transform or clip was applied, and
+  // the depth within the outermost saveLayer, or -1 while there are none.
+  // Ops drawn at or below those depths do not contribute opaque rects.
+  int save_depth = 0;
+  int transform_depth = -1;
+  int layer_depth = -1;
+
+  auto add_opaque_rect = [this](const SkRect& rect) {
+    if (rect.width() * rect.height() >
+        opaque_bounds_.width() * opaque_bounds_.height()) {
+      opaque_bounds_ = rect;
+    }
+  };
+
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    ptr += op->size;
+    switch (op->type) {
+      case DisplayListOpType::kSetColor:
+        color = static_cast<const SetColorOp*>(op)->color;
+        continue;
+      case DisplayListOpType::kSetBlendMode:
+        blend_mode = static_cast<const SetBlendModeOp*>(op)->mode;
+        has_blender = false;
+        continue;
+      case DisplayListOpType::kSetBlender:
+        has_blender = true;
+        continue;
+      case DisplayListOpType::kClearBlender:
+        blend_mode = SkBlendMode::kSrcOver;
+        has_blender = false;
+        continue;
+      case DisplayListOpType::kSetStyle:
+        is_fill = static_cast<const SetStyleOp*>(op)->style ==
+                  SkPaint::kFill_Style;
+        continue;
+      case DisplayListOpType::kSetShader:
+        has_shader = true;
+        continue;
+      case DisplayListOpType::kClearShader:
+        has_shader = false;
+        continue;
+      case DisplayListOpType::kSetColorFilter:
+        has_color_filter = true;
+        continue;
+      case DisplayListOpType::kClearColorFilter:
+        has_color_filter = false;
+        continue;
+      case DisplayListOpType::kSetImageFilter:
+        has_image_filter = true;
+        continue;
+      case DisplayListOpType::kClearImageFilter:
+        has_image_filter = false;
+        continue;
+      case DisplayListOpType::kSetPathEffect:
+        has_path_effect = true;
+        continue;
+      case DisplayListOpType::kClearPathEffect:
+        has_path_effect = false;
+        continue;
+      case DisplayListOpType::kSetMaskFilter:
+      case DisplayListOpType::kSetMaskBlurFilterNormal:
+      case DisplayListOpType::kSetMaskBlurFilterSolid:
+      case DisplayListOpType::kSetMaskBlurFilterOuter:
+      case DisplayListOpType::kSetMaskBlurFilterInner:
+        has_mask_filter = true;
+        continue;
+      case DisplayListOpType::kClearMaskFilter:
+        has_mask_filter = false;
+        continue;
+      case DisplayListOpType::kSave:
+        save_depth++;
+        continue;
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+        // The layer is composited with the current attributes when it is
+        // restored, everything drawn into it only affects the layer.
+        if (layer_depth < 0) {
+          // Both variants store |with_paint| first
+          bool with_paint = static_cast<const SaveLayerOp*>(op)->with_paint;
+          if (with_paint &&
+              (has_blender || blend_mode != SkBlendMode::kSrcOver)) {
+            opaque_bounds_.setEmpty();
+            return;
+          }
+          layer_depth = save_depth + 1;
+        }
+        save_depth++;
+        continue;
+      case DisplayListOpType::kRestore:
+        save_depth--;
+        if (transform_depth > save_depth) {
+          transform_depth = -1;
+        }
+        if (layer_depth > save_depth) {
+          layer_depth = -1;
+        }
+        continue;
+      default:
+        break;
+    }
+    if (!IsRenderingOp(op->type)) {
+      // The remaining ops are transforms and clips.
+      if (transform_depth < 0) {
+        transform_depth = save_depth;
+      }
+      continue;
+    }
+    if (layer_depth >= 0) {
+      continue;
+    }
+    bool is_opaque_paint = SkColorGetA(color) == 0xff && !has_shader &&
+                           !has_color_filter && !has_image_filter &&
+                           !has_mask_filter && !has_path_effect;
+    SkBlendMode op_blend_mode = blend_mode;
+    bool op_has_blender = has_blender;
+    bool is_opaque_fill = false;
+    SkRect fill_rect;
+    switch (op->type) {
+      case DisplayListOpType::kDrawColor: {
+        auto color_op = static_cast<const DrawColorOp*>(op);
+        op_blend_mode = color_op->mode;
+        op_has_blender = false;
+        is_opaque_fill = SkColorGetA(color_op->color) == 0xff;
+        fill_rect = bounds_cull_;
+        break;
+      }
+      case DisplayListOpType::kDrawPaint:
+        is_opaque_fill = is_opaque_paint;
+        fill_rect = bounds_cull_;
+        break;
+      case DisplayListOpType::kDrawRect:
+        is_opaque_fill = is_opaque_paint && is_fill;
+        fill_rect = static_cast<const DrawRectOp*>(op)->rect.makeSorted();
+        break;
+      case DisplayListOpType::kDrawSkPicture:
+      case DisplayListOpType::kDrawSkPictureMatrix:
+      case DisplayListOpType::kDrawDisplayList:
+        // The nested pictures and lists are not analyzed.
+        opaque_bounds_.setEmpty();
+        return;
+      default:
+        break;
+    }
+    // Any other blending can erase the pixels drawn by the previous ops.
+    if (op_has_blender ||
+        !(op_blend_mode == SkBlendMode::kSrcOver ||
+          (op_blend_mode == SkBlendMode::kSrc && is_opaque_fill))) {
+      opaque_bounds_.setEmpty();
+      return;
+    }
+    if (is_opaque_fill && transform_depth < 0) {
+      add_opaque_rect(fill_rect);
+    }
+  }
+}
+
+// A 64-bit FNV-1a style hash accumulated 32 bits at a time. The
+// op structs are always a multiple of 4 bytes in size.
+class ContentHasher {
+ public:
+  void Add(uint32_t word) { hash_ = (hash_ ^ word) * 0x100000001b3ull; }
+
+  void Add(SkScalar value) {
+    uint32_t bits;
+    // Adding 0 turns -0 into 0 so that values which compare as
+    // equal also hash equally.
+    value += 0.0f;
+    memcpy(&bits, &value, sizeof(bits));
+    Add(bits);
+  }
+
+  void AddBytes(const uint8_t* ptr, size_t bytes) {
+    FML_DCHECK((bytes & 3) == 0);
+    for (size_t i = 0; i < bytes; i += sizeof(uint32_t)) {
+      uint32_t word;
+      memcpy(&word, ptr + i, sizeof(word));
+      Add(word);
+    }
+  }
+
+  // Hashes the contents of the path consistently with SkPath::operator==
+  // which compares the fill type, verbs, points and conic weights.
+  void AddPath(const SkPath& path) {
+    Add(static_cast<uint32_t>(path.getFillType()));
+    SkPath::Iter iter(path, false);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+      Add(static_cast<uint32_t>(verb));
+      int count = 0;
+      switch (verb) {
+        case SkPath::kMove_Verb:
+          count = 1;
+          break;
+        case SkPath::kLine_Verb:
+          count = 2;
+          break;
+        case SkPath::kQuad_Verb:
+          count = 3;
+          break;
+        case SkPath::kConic_Verb:
+          count = 3;
+          Add(iter.conicWeight());
+          break;
+        case SkPath::kCubic_Verb:
+          count = 4;
+          break;
+        default:
+          break;
+      }
+      for (int i = 0; i < count; i++) {
+        Add(pts[i].fX);
+        Add(pts[i].fY);
+      }
+    }
+  }
+
+  uint64_t hash() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+// The hash covers the same data as CompareOps. Most ops are compared
+// in bulk, which means their referenced objects are compared by
+// identity, and the path ops are compared by the contents of the path.
+void DisplayList::ComputeContentHash() {
+  ContentHasher hasher;
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    hasher.Add(static_cast<uint32_t>(op->type) |
+               (static_cast<uint32_t>(op->size) << 8));
+    switch (op->type) {
+      case DisplayListOpType::kClipIntersectPath: {
+        auto clip_op = static_cast<const ClipIntersectPathOp*>(op);
+        hasher.Add(static_cast<uint32_t>(clip_op->is_aa));
+        hasher.AddPath(clip_op->path);
+        break;
+      }
+      case DisplayListOpType::kClipDifferencePath: {
+        auto clip_op = static_cast<const ClipDifferencePathOp*>(op);
+        hasher.Add(static_cast<uint32_t>(clip_op->is_aa));
+        hasher.AddPath(clip_op->path);
+        break;
+      }
+      case DisplayListOpType::kDrawPath:
+        hasher.AddPath(static_cast<const DrawPathOp*>(op)->path);
+        break;
+      default:
+        hasher.AddBytes(reinterpret_cast<const uint8_t*>(op + 1),
+                        op->size - sizeof(DLOp));
+        break;
+    }
+  }
+  content_hash_ = hasher.hash();
+}
+
+void DisplayList::RenderTo(SkCanvas* canvas, SkScalar opacity) const {
+  if (opacity < SK_Scalar1 && !can_apply_group_opacity_) {
+    SkAutoCanvasRestore save(canvas, false);
+    canvas->saveLayerAlphaf(&bounds_, opacity);
+    RenderTo(canvas);
+    return;
+  }
+  DisplayListCanvasDispatcher dispatcher(canvas, opacity);
+  if (rtree_) {
+    DispatchCulled(dispatcher, canvas->getLocalClipBounds());
+  } else {
+    uint8_t* ptr = storage_.get();
+    DispatchOps(dispatcher, ptr, ptr + byte_count_);
+  }
 }
 
 bool DisplayList::Equals(const DisplayList& other) const {
@@ -995,22 +1736,35 @@ bool DisplayList::Equals(const DisplayList& other) const {
   if (ptr == o_ptr) {
     return true;
   }
+  // Equal lists always have equal hashes so a mismatch can be
+  // rejected without looking at the ops.
+  if (content_hash_ != other.content_hash_) {
+    return false;
+  }
   return CompareOps(ptr, ptr + byte_count_, o_ptr, o_ptr + other.byte_count_);
 }
 
 DisplayList::DisplayList(uint8_t* ptr,
+                         size_t allocated,
                          size_t byte_count,
                          int op_count,
                          size_t nested_byte_count,
                          int nested_op_count,
                          const SkRect& cull_rect)
     : storage_(ptr),
+      allocated_(allocated),
+      memory_account_(fml::MemoryCategory::kDisplayLists, allocated),
       byte_count_(byte_count),
       op_count_(op_count),
       nested_byte_count_(nested_byte_count),
       nested_op_count_(nested_op_count),
       bounds_({0, 0, -1, -1}),
-      bounds_cull_(cull_rect) {
+      bounds_cull_(cull_rect),
+      complexity_score_(0),
+      content_hash_(0),
+      can_apply_group_opacity_(false),
+      can_render_off_thread_(false),
+      opaque_bounds_({0, 0, 0, 0}) {
   static std::atomic<uint32_t> nextID{1};
   do {
     unique_id_ = nextID.fetch_add(+1, std::memory_order_relaxed);
@@ -1020,6 +1774,80 @@ DisplayList::DisplayList(uint8_t* ptr,
 DisplayList::~DisplayList() {
   uint8_t* ptr = storage_.get();
   DisposeOps(ptr, ptr + byte_count_);
+  if (ptr) {
+    DisplayListStoragePool::Instance().Release(storage_.release(), allocated_);
+  }
+}
+
+DisplayListStoragePool& DisplayListStoragePool::Instance() {
+  static DisplayListStoragePool* pool = new DisplayListStoragePool();
+  return *pool;
+}
+
+uint8_t* DisplayListStoragePool::Acquire(size_t min_bytes, size_t* allocated) {
+  std::scoped_lock lock(mutex_);
+  auto best = buffers_.end();
+  for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+    if (it->allocated >= min_bytes &&
+        (best == buffers_.end() || it->allocated < best->allocated)) {
+      best = it;
+    }
+  }
+  if (best == buffers_.end()) {
+    return nullptr;
+  }
+  uint8_t* ptr = best->ptr;
+  *allocated = best->allocated;
+  pooled_bytes_ -= best->allocated;
+  buffers_.erase(best);
+  return ptr;
+}
+
+void DisplayListStoragePool::Release(uint8_t* ptr, size_t allocated) {
+  if (allocated < kMinPooledBytes || allocated > kMaxPooledBytes) {
+    sk_free(ptr);
+    return;
+  }
+  std::vector<uint8_t*> evicted;
+  {
+    std::scoped_lock lock(mutex_);
+    // The buffers are kept in the order they were released, so the
+    // buffers at the front are the least recently released.
+    while (!buffers_.empty() &&
+           (buffers_.size() >= kMaxPooledBuffers ||
+            pooled_bytes_ + allocated > kMaxPooledBytes)) {
+      evicted.push_back(buffers_.front().ptr);
+      pooled_bytes_ -= buffers_.front().allocated;
+      buffers_.erase(buffers_.begin());
+    }
+    buffers_.push_back({ptr, allocated});
+    pooled_bytes_ += allocated;
+  }
+  for (uint8_t* buffer : evicted) {
+    sk_free(buffer);
+  }
+}
+
+void DisplayListStoragePool::Clear() {
+  std::vector<Buffer> buffers;
+  {
+    std::scoped_lock lock(mutex_);
+    buffers.swap(buffers_);
+    pooled_bytes_ = 0;
+  }
+  for (auto& buffer : buffers) {
+    sk_free(buffer.ptr);
+  }
+}
+
+size_t DisplayListStoragePool::pooled_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return pooled_bytes_;
+}
+
+size_t DisplayListStoragePool::pooled_buffer_count() const {
+  std::scoped_lock lock(mutex_);
+  return buffers_.size();
 }
 
 #define DL_BUILDER_PAGE 4096
@@ -1044,13 +1872,30 @@ void* DisplayListBuilder::Push(size_t pod, int op_inc, Args&&... args) {
     static_assert(SkIsPow2(DL_BUILDER_PAGE),
                   "This math needs updating for non-pow2.");
     // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
-    storage_.realloc(allocated_);
+    size_t needed = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+    size_t pooled_size;
+    uint8_t* pooled =
+        DisplayListStoragePool::Instance().Acquire(needed, &pooled_size);
+    if (pooled) {
+      if (used_ > 0) {
+        memcpy(pooled, storage_.get(), used_);
+      }
+      uint8_t* old_storage = storage_.release();
+      if (old_storage) {
+        DisplayListStoragePool::Instance().Release(old_storage, allocated_);
+      }
+      storage_ = SkAutoTMalloc<uint8_t>(pooled);
+      allocated_ = pooled_size;
+    } else {
+      allocated_ = needed;
+      storage_.realloc(allocated_);
+    }
     FML_DCHECK(storage_.get());
     memset(storage_.get() + used_, 0, allocated_ - used_);
   }
   FML_DCHECK(used_ + size <= allocated_);
   auto op = (T*)(storage_.get() + used_);
+  last_op_offset_ = used_;
   used_ += size;
   new (op) T{std::forward<Args>(args)...};
   op->type = T::kType;
@@ -1059,87 +1904,209 @@ void* DisplayListBuilder::Push(size_t pod, int op_inc, Args&&... args) {
   return op + 1;
 }
 
+bool DisplayListBuilder::PopTrailingSave() {
+  if (last_op_offset_ >= used_) {
+    return false;
+  }
+  auto op = (DLOp*)(storage_.get() + last_op_offset_);
+  switch (op->type) {
+    case DisplayListOpType::kSave:
+      break;
+    case DisplayListOpType::kSaveLayer:
+      if (static_cast<SaveLayerOp*>(op)->with_paint) {
+        return false;
+      }
+      break;
+    case DisplayListOpType::kSaveLayerBounds:
+      if (static_cast<SaveLayerBoundsOp*>(op)->with_paint) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  FML_DCHECK(last_op_offset_ + op->size == used_);
+  // The save ops are all trivially destructible, but the bytes must be
+  // cleared so that the bulk comparisons in |Equals| will not see any
+  // stale data in the padding of the ops recorded at this location.
+  size_t size = op->size;
+  memset(op, 0, size);
+  used_ = last_op_offset_;
+  op_count_--;
+  ElideOp(size);
+  return true;
+}
+
 sk_sp<DisplayList> DisplayListBuilder::Build() {
   while (save_level_ > 0) {
     restore();
   }
+  // The counts are traced after the trailing restores, which can elide the
+  // saves that they close.
+  FML_TRACE_EVENT("flutter", "DisplayListBuilder::Build", "ops", op_count_,
+                  "elided_ops", elided_op_count_, "elided_bytes",
+                  elided_bytes_);
   size_t bytes = used_;
   int count = op_count_;
   size_t nested_bytes = nested_bytes_;
   int nested_count = nested_op_count_;
+  // Lists of at least a page keep up to a page of slack so that their
+  // storage can be recycled through the DisplayListStoragePool for a
+  // later list of a similar size.
+  size_t allocated = bytes;
+  if (bytes >= DL_BUILDER_PAGE) {
+    allocated = (bytes + DL_BUILDER_PAGE - 1) & ~(DL_BUILDER_PAGE - 1);
+  }
+  if (allocated < allocated_) {
+    storage_.realloc(allocated);
+  } else {
+    allocated = allocated_;
+  }
   used_ = allocated_ = op_count_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
-  storage_.realloc(bytes);
-  return sk_sp<DisplayList>(new DisplayList(storage_.release(), bytes, count,
-                                            nested_bytes, nested_count,
-                                            cull_rect_));
+  last_op_offset_ = 0;
+  elided_bytes_ = elided_op_count_ = 0;
+  ResetAttributes();
+  sk_sp<DisplayList> display_list(
+      new DisplayList(storage_.release(), allocated, bytes, count, nested_bytes,
+                      nested_count, cull_rect_));
+  // Computing the bounds and complexity here, on the thread that built
+  // the list, keeps those passes off of the raster thread. The RTree
+  // computation produces the bounds as a side effect.
+  if (prepare_rtree_) {
+    display_list->ComputeRTree();
+  } else {
+    display_list->ComputeBounds();
+  }
+  display_list->ComputeComplexity();
+  display_list->ComputeContentHash();
+  display_list->ComputeGroupOpacity();
+  display_list->ComputeRenderOffThread();
+  display_list->ComputeOpaqueBounds();
+  return display_list;
 }
 
-DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect)
-    : cull_rect_(cull_rect) {}
+DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
+                                       bool prepare_rtree)
+    : cull_rect_(cull_rect), prepare_rtree_(prepare_rtree) {}
 
 DisplayListBuilder::~DisplayListBuilder() {
   uint8_t* ptr = storage_.get();
   if (ptr) {
     DisposeOps(ptr, ptr + used_);
+    DisplayListStoragePool::Instance().Release(storage_.release(), allocated_);
   }
 }
 
+void DisplayListBuilder::ResetAttributes() {
+  current_aa_ = false;
+  current_dither_ = false;
+  current_invert_colors_ = false;
+  current_color_ = 0xFF000000;
+  current_blend_mode_ = SkBlendMode::kSrcOver;
+  current_style_ = SkPaint::Style::kFill_Style;
+  current_stroke_width_ = 0.0;
+  current_miter_limit_ = 4.0;
+  current_cap_ = SkPaint::Cap::kButt_Cap;
+  current_join_ = SkPaint::Join::kMiter_Join;
+  current_blender_ = nullptr;
+  current_shader_ = nullptr;
+  current_color_filter_ = nullptr;
+  current_image_filter_ = nullptr;
+  current_path_effect_ = nullptr;
+}
+
+// Each of the attribute methods below only records an op if the new
+// value differs from the value that a Dispatcher would currently see.
+#define DL_BUILDER_SET_VALUE(op_type, field, value) \
+  if (field == value) {                             \
+    ElideOp(SkAlignPtr(sizeof(op_type)));           \
+  } else {                                          \
+    Push<op_type>(0, 0, field = value);             \
+  }
+#define DL_BUILDER_SET_SKREF(set_type, clear_type, field, value) \
+  if (field == value) {                                          \
+    ElideOp(SkAlignPtr(value ? sizeof(set_type)                  \
+                             : sizeof(clear_type)));             \
+  } else if ((field = std::move(value))) {                       \
+    Push<set_type>(0, 0, field);                                 \
+  } else {                                                       \
+    Push<clear_type>(0, 0);                                      \
+  }
+
 void DisplayListBuilder::setAntiAlias(bool aa) {
-  Push<SetAntiAliasOp>(0, 0, aa);
+  DL_BUILDER_SET_VALUE(SetAntiAliasOp, current_aa_, aa);
 }
 void DisplayListBuilder::setDither(bool dither) {
-  Push<SetDitherOp>(0, 0, dither);
+  DL_BUILDER_SET_VALUE(SetDitherOp, current_dither_, dither);
 }
 void DisplayListBuilder::setInvertColors(bool invert) {
-  Push<SetInvertColorsOp>(0, 0, invert);
+  DL_BUILDER_SET_VALUE(SetInvertColorsOp, current_invert_colors_, invert);
 }
 void DisplayListBuilder::setStrokeCap(SkPaint::Cap cap) {
-  Push<SetStrokeCapOp>(0, 0, cap);
+  DL_BUILDER_SET_VALUE(SetStrokeCapOp, current_cap_, cap);
 }
 void DisplayListBuilder::setStrokeJoin(SkPaint::Join join) {
-  Push<SetStrokeJoinOp>(0, 0, join);
+  DL_BUILDER_SET_VALUE(SetStrokeJoinOp, current_join_, join);
 }
 void DisplayListBuilder::setStyle(SkPaint::Style style) {
-  Push<SetStyleOp>(0, 0, style);
+  DL_BUILDER_SET_VALUE(SetStyleOp, current_style_, style);
 }
 void DisplayListBuilder::setStrokeWidth(SkScalar width) {
-  Push<SetStrokeWidthOp>(0, 0, width);
+  DL_BUILDER_SET_VALUE(SetStrokeWidthOp, current_stroke_width_, width);
 }
 void DisplayListBuilder::setStrokeMiter(SkScalar limit) {
-  Push<SetStrokeMiterOp>(0, 0, limit);
+  DL_BUILDER_SET_VALUE(SetStrokeMiterOp, current_miter_limit_, limit);
 }
 void DisplayListBuilder::setColor(SkColor color) {
-  Push<SetColorOp>(0, 0, color);
+  DL_BUILDER_SET_VALUE(SetColorOp, current_color_, color);
 }
 void DisplayListBuilder::setBlendMode(SkBlendMode mode) {
-  Push<SetBlendModeOp>(0, 0, mode);
+  // Setting a blend mode replaces any custom blender
+  if (!current_blender_ && current_blend_mode_ == mode) {
+    ElideOp(SkAlignPtr(sizeof(SetBlendModeOp)));
+  } else {
+    current_blender_ = nullptr;
+    Push<SetBlendModeOp>(0, 0, current_blend_mode_ = mode);
+  }
 }
 void DisplayListBuilder::setBlender(sk_sp<SkBlender> blender) {
-  blender  //
-      ? Push<SetBlenderOp>(0, 0, std::move(blender))
-      : Push<ClearBlenderOp>(0, 0);
+  if (blender) {
+    if (current_blender_ == blender) {
+      ElideOp(SkAlignPtr(sizeof(SetBlenderOp)));
+    } else {
+      Push<SetBlenderOp>(0, 0, current_blender_ = std::move(blender));
+    }
+  } else {
+    // Clearing the blender reverts to the default kSrcOver blend mode
+    if (!current_blender_ && current_blend_mode_ == SkBlendMode::kSrcOver) {
+      ElideOp(SkAlignPtr(sizeof(ClearBlenderOp)));
+    } else {
+      current_blender_ = nullptr;
+      current_blend_mode_ = SkBlendMode::kSrcOver;
+      Push<ClearBlenderOp>(0, 0);
+    }
+  }
 }
 void DisplayListBuilder::setShader(sk_sp<SkShader> shader) {
-  shader  //
-      ? Push<SetShaderOp>(0, 0, std::move(shader))
-      : Push<ClearShaderOp>(0, 0);
+  DL_BUILDER_SET_SKREF(SetShaderOp, ClearShaderOp, current_shader_, shader);
 }
 void DisplayListBuilder::setImageFilter(sk_sp<SkImageFilter> filter) {
-  filter  //
-      ? Push<SetImageFilterOp>(0, 0, std::move(filter))
-      : Push<ClearImageFilterOp>(0, 0);
+  DL_BUILDER_SET_SKREF(SetImageFilterOp, ClearImageFilterOp,
+                       current_image_filter_, filter);
 }
 void DisplayListBuilder::setColorFilter(sk_sp<SkColorFilter> filter) {
-  filter  //
-      ? Push<SetColorFilterOp>(0, 0, std::move(filter))
-      : Push<ClearColorFilterOp>(0, 0);
+  DL_BUILDER_SET_SKREF(SetColorFilterOp, ClearColorFilterOp,
+                       current_color_filter_, filter);
 }
 void DisplayListBuilder::setPathEffect(sk_sp<SkPathEffect> effect) {
-  effect  //
-      ? Push<SetPathEffectOp>(0, 0, std::move(effect))
-      : Push<ClearPathEffectOp>(0, 0);
+  DL_BUILDER_SET_SKREF(SetPathEffectOp, ClearPathEffectOp,
+                       current_path_effect_, effect);
 }
+
+#undef DL_BUILDER_SET_SKREF
+#undef DL_BUILDER_SET_VALUE
+
 void DisplayListBuilder::setMaskFilter(sk_sp<SkMaskFilter> filter) {
   Push<SetMaskFilterOp>(0, 0, std::move(filter));
 }
@@ -1166,7 +2133,13 @@ void DisplayListBuilder::save() {
 }
 void DisplayListBuilder::restore() {
   if (save_level_ > 0) {
-    Push<RestoreOp>(0, 1);
+    // A |save| or a |saveLayer| without attributes that is immediately
+    // restored has no effect on the rendering.
+    if (PopTrailingSave()) {
+      ElideOp(SkAlignPtr(sizeof(RestoreOp)));
+    } else {
+      Push<RestoreOp>(0, 1);
+    }
     save_level_--;
   }
 }
@@ -1178,16 +2151,32 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds, bool with_paint) {
 }
 
 void DisplayListBuilder::translate(SkScalar tx, SkScalar ty) {
-  Push<TranslateOp>(0, 1, tx, ty);
+  if (tx == 0 && ty == 0) {
+    ElideOp(SkAlignPtr(sizeof(TranslateOp)));
+  } else {
+    Push<TranslateOp>(0, 1, tx, ty);
+  }
 }
 void DisplayListBuilder::scale(SkScalar sx, SkScalar sy) {
-  Push<ScaleOp>(0, 1, sx, sy);
+  if (sx == 1 && sy == 1) {
+    ElideOp(SkAlignPtr(sizeof(ScaleOp)));
+  } else {
+    Push<ScaleOp>(0, 1, sx, sy);
+  }
 }
 void DisplayListBuilder::rotate(SkScalar degrees) {
-  Push<RotateOp>(0, 1, degrees);
+  if (SkScalarMod(degrees, 360.0f) == 0) {
+    ElideOp(SkAlignPtr(sizeof(RotateOp)));
+  } else {
+    Push<RotateOp>(0, 1, degrees);
+  }
 }
 void DisplayListBuilder::skew(SkScalar sx, SkScalar sy) {
-  Push<SkewOp>(0, 1, sx, sy);
+  if (sx == 0 && sy == 0) {
+    ElideOp(SkAlignPtr(sizeof(SkewOp)));
+  } else {
+    Push<SkewOp>(0, 1, sx, sy);
+  }
 }
 
 // clang-format off
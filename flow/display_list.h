@@ -5,6 +5,12 @@
 #ifndef FLUTTER_FLOW_DISPLAY_LIST_H_
 #define FLUTTER_FLOW_DISPLAY_LIST_H_
 
+#include <mutex>
+#include <vector>
+
+#include "flutter/flow/rtree.h"
+#include "flutter/fml/memory/memory_accounting.h"
+
 #include "third_party/skia/include/core/SkBlender.h"
 #include "third_party/skia/include/core/SkBlurTypes.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -27,6 +33,8 @@
 //             or detecting various rendering optimization scenarios
 // DisplayListBuilder: a class for constructing a DisplayList from the same
 //                     calls defined in the Dispatcher
+// DisplayListStoragePool: a cache of the op storage of freed DisplayLists
+//                         that is reused by DisplayListBuilder
 //
 // Other files include various class definitions for dealing with display
 // lists, such as:
@@ -156,6 +164,51 @@ enum class DisplayListOpType { FOR_EACH_DISPLAY_LIST_OP(DL_OP_TO_ENUM_VALUE) };
 class Dispatcher;
 class DisplayListBuilder;
 
+// A thread safe cache of the op storage of recently destroyed DisplayLists.
+//
+// DisplayListBuilder draws its storage from the pool when it needs to grow
+// so that lists which are re-recorded every frame at a similar size (such
+// as those of an animation) reuse the storage of an earlier frame's list
+// rather than growing new storage a page at a time. DisplayLists return
+// their storage to the pool when they are destroyed, which normally
+// happens after the list is released through the SkiaUnrefQueue.
+class DisplayListStoragePool {
+ public:
+  // Buffers smaller than this are cheaper to malloc than to pool.
+  static constexpr size_t kMinPooledBytes = 4096;
+  static constexpr size_t kMaxPooledBuffers = 16;
+  static constexpr size_t kMaxPooledBytes = 4 * 1024 * 1024;
+
+  static DisplayListStoragePool& Instance();
+
+  // Returns the smallest pooled buffer that holds at least |min_bytes|
+  // and stores its size in |*allocated|, or returns nullptr if there is
+  // no such buffer. The contents of the buffer are undefined. The buffer
+  // must be freed with sk_free or handed back through |Release|.
+  uint8_t* Acquire(size_t min_bytes, size_t* allocated);
+
+  // Adds the |ptr| buffer of |allocated| bytes to the pool, or frees it
+  // if it is too small or too large to be pooled. The oldest buffers
+  // are freed to make room if the pool is full.
+  void Release(uint8_t* ptr, size_t allocated);
+
+  // Frees all of the pooled buffers, e.g. in response to memory pressure.
+  void Clear();
+
+  size_t pooled_bytes() const;
+  size_t pooled_buffer_count() const;
+
+ private:
+  struct Buffer {
+    uint8_t* ptr;
+    size_t allocated;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<Buffer> buffers_;
+  size_t pooled_bytes_ = 0;
+};
+
 // The base class that contains a sequence of rendering operations
 // for dispatch to a Dispatcher. These objects must be instantiated
 // through an instance of DisplayListBuilder::build().
@@ -167,13 +220,20 @@ class DisplayList : public SkRefCnt {
   static const SkSamplingOptions CubicSampling;
 
   DisplayList()
-      : byte_count_(0),
+      : allocated_(0),
+        memory_account_(fml::MemoryCategory::kDisplayLists),
+        byte_count_(0),
         op_count_(0),
         nested_byte_count_(0),
         nested_op_count_(0),
         unique_id_(0),
         bounds_({0, 0, 0, 0}),
-        bounds_cull_({0, 0, 0, 0}) {}
+        bounds_cull_({0, 0, 0, 0}),
+        complexity_score_(0),
+        content_hash_(0),
+        can_apply_group_opacity_(false),
+        can_render_off_thread_(false),
+        opaque_bounds_({0, 0, 0, 0}) {}
 
   ~DisplayList();
 
@@ -182,7 +242,27 @@ class DisplayList : public SkRefCnt {
     Dispatch(ctx, ptr, ptr + byte_count_);
   }
 
-  void RenderTo(SkCanvas* canvas) const;
+  // Dispatches only the rendering operations whose bounds intersect
+  // the |cull_rect| (in the coordinate space of the DisplayList).
+  // All attribute, transform, clip and save/restore operations are
+  // still dispatched so that the state seen by the dispatcher for
+  // each rendering operation is identical to a full dispatch.
+  // A top-level saveLayer is dispatched or skipped as a whole
+  // along with all of the operations up to its matching restore.
+  //
+  // If the DisplayList was not built with an RTree (see the
+  // |prepare_rtree| flag on DisplayListBuilder) then this method
+  // is equivalent to |Dispatch(ctx)|.
+  void Dispatch(Dispatcher& ctx, const SkRect& cull_rect) const;
+
+  // Renders the DisplayList to the canvas, culling the rendering
+  // operations against the canvas clip if the list has an RTree.
+  //
+  // An |opacity| of less than 1 is applied to the list as a group. It is
+  // applied by modulating the alpha of each op if the list supports that
+  // (see |can_apply_group_opacity|) and by rendering the list into a
+  // saveLayer otherwise.
+  void RenderTo(SkCanvas* canvas, SkScalar opacity = SK_Scalar1) const;
 
   // SkPicture always includes nested bytes, but nested ops are
   // only included if requested. The defaults used here for these
@@ -196,19 +276,58 @@ class DisplayList : public SkRefCnt {
   }
   uint32_t unique_id() const { return unique_id_; }
 
-  const SkRect& bounds() {
-    if (bounds_.width() < 0.0) {
-      // ComputeBounds() will leave the variable with a
-      // non-negative width and height
-      ComputeBounds();
-    }
-    return bounds_;
-  }
+  // The bounds are computed by |DisplayListBuilder::Build| so that
+  // the raster thread never has to pay for a bounds pass during preroll.
+  const SkRect& bounds() const { return bounds_; }
+
+  // An estimate of the relative cost of rendering this DisplayList,
+  // including the cost of any nested DisplayLists and SkPictures.
+  // Computed by |DisplayListBuilder::Build|. The units are arbitrary,
+  // but a simple fill of a rect scores 1 and scores are additive.
+  unsigned int complexity_score() const { return complexity_score_; }
 
   bool Equals(const DisplayList& other) const;
 
+  // A hash of the recorded ops computed by |DisplayListBuilder::Build|.
+  // Lists that are |Equals| always have the same hash, and lists with
+  // the same hash are equal barring a 64-bit collision. As with
+  // |Equals|, objects such as images and shaders contribute their
+  // identity rather than their contents.
+  uint64_t content_hash() const { return content_hash_; }
+
+  // Indicates whether an opacity can be applied to the list as a whole by
+  // modulating the alpha of the color of each of its rendering ops rather
+  // than by rendering the list into a saveLayer. This is true when all of
+  // the rendering ops draw with the current attributes using the default
+  // blend mode and without color or image filters, and none of the ops
+  // overlap each other. Only lists of up to |kMaxGroupOpacityOps| ops are
+  // analyzed.
+  bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
+  static constexpr int kMaxGroupOpacityOps = 32;
+
+  // Indicates whether this DisplayList can be rendered on a thread other
+  // than the raster thread. This is false if the list, or any list nested
+  // within it, refers to a texture backed image or to an object whose
+  // contents cannot be inspected, such as an SkPicture or image filter.
+  bool can_render_off_thread() const { return can_render_off_thread_; }
+
+  // A rectangle, in the coordinate space of the DisplayList, whose pixels
+  // are all fully opaque once the list has been rendered (except along
+  // anti-aliased edges), or an empty rect if no such area is known.
+  // Computed by |DisplayListBuilder::Build| from the opaque fills of the
+  // list that are not transformed or clipped, and only if no later op can
+  // erase them. Used to skip the rendering of content that the list
+  // covers entirely.
+  const SkRect& opaque_bounds() const { return opaque_bounds_; }
+
+  // Indicates whether this DisplayList has a spatial index of its
+  // top-level rendering operations for use by the culling version of
+  // |Dispatch|.
+  bool has_rtree() const { return rtree_ != nullptr; }
+
  private:
   DisplayList(uint8_t* ptr,
+              size_t allocated,
               size_t byte_count,
               int op_count,
               size_t nested_byte_count,
@@ -216,6 +335,10 @@ class DisplayList : public SkRefCnt {
               const SkRect& cull_rect);
 
   std::unique_ptr<uint8_t, SkFunctionWrapper<void(void*), sk_free>> storage_;
+  // The size of the |storage_| allocation which may exceed the
+  // |byte_count_| by up to a page, see |DisplayListBuilder::Build|.
+  size_t allocated_;
+  fml::ScopedMemoryAccount memory_account_;
   size_t byte_count_;
   int op_count_;
 
@@ -228,9 +351,37 @@ class DisplayList : public SkRefCnt {
   // Only used for drawPaint() and drawColor()
   SkRect bounds_cull_;
 
+  unsigned int complexity_score_;
+  uint64_t content_hash_;
+  bool can_apply_group_opacity_;
+  bool can_render_off_thread_;
+  SkRect opaque_bounds_;
+
+  // The spatial index of the top-level rendering operations, if
+  // requested at build time. The entries in the RTree index into the
+  // |rtree_offsets_| vector which records the byte offset of the op
+  // that each rect in the RTree corresponds to.
+  sk_sp<RTree> rtree_;
+  std::vector<size_t> rtree_offsets_;
+
   void ComputeBounds();
+  void ComputeRTree();
+  void ComputeComplexity();
+  void ComputeContentHash();
+  void ComputeGroupOpacity();
+  void ComputeRenderOffThread();
+  void ComputeOpaqueBounds();
   void Dispatch(Dispatcher& ctx, uint8_t* ptr, uint8_t* end) const;
 
+  // Statically typed versions of the dispatch loops which allow the
+  // compiler to devirtualize the calls on concrete dispatchers such as
+  // DisplayListCanvasDispatcher and DisplayListBoundsCalculator.
+  // Defined (and only instantiated) in display_list.cc.
+  template <typename T>
+  void DispatchOps(T& dispatcher, uint8_t* ptr, uint8_t* end) const;
+  template <typename T>
+  void DispatchCulled(T& dispatcher, const SkRect& cull_rect) const;
+
   friend class DisplayListBuilder;
 };
 
@@ -470,7 +621,12 @@ class Dispatcher {
 // the DisplayListCanvasRecorder class.
 class DisplayListBuilder final : public virtual Dispatcher, public SkRefCnt {
  public:
-  DisplayListBuilder(const SkRect& cull_rect = kMaxCullRect_);
+  // If |prepare_rtree| is true then the DisplayLists produced by
+  // |Build| will compute their bounds eagerly along with a spatial
+  // index of their top-level rendering operations which allows them
+  // to be dispatched with a cull rect. See |DisplayList::Dispatch|.
+  DisplayListBuilder(const SkRect& cull_rect = kMaxCullRect_,
+                     bool prepare_rtree = false);
   ~DisplayListBuilder();
 
   void setAntiAlias(bool aa) override;
@@ -593,12 +749,53 @@ class DisplayListBuilder final : public virtual Dispatcher, public SkRefCnt {
   size_t nested_bytes_ = 0;
   int nested_op_count_ = 0;
 
+  // The offset of the most recently recorded op, used to elide
+  // a |save| or |saveLayer| that is immediately restored.
+  size_t last_op_offset_ = 0;
+
+  // Ops (and their bytes) that were not recorded because they would
+  // have had no effect on the rendering, reported in |Build|.
+  int elided_op_count_ = 0;
+  size_t elided_bytes_ = 0;
+
+  // The current values of the rendering attributes as they will be
+  // seen by a Dispatcher at this point in the stream. Attribute
+  // calls that do not change these values are not recorded.
+  // The initial values match the defaults of an SkPaint.
+  bool current_aa_ = false;
+  bool current_dither_ = false;
+  bool current_invert_colors_ = false;
+  SkColor current_color_ = 0xFF000000;
+  SkBlendMode current_blend_mode_ = SkBlendMode::kSrcOver;
+  SkPaint::Style current_style_ = SkPaint::Style::kFill_Style;
+  SkScalar current_stroke_width_ = 0.0;
+  SkScalar current_miter_limit_ = 4.0;
+  SkPaint::Cap current_cap_ = SkPaint::Cap::kButt_Cap;
+  SkPaint::Join current_join_ = SkPaint::Join::kMiter_Join;
+  sk_sp<SkBlender> current_blender_;
+  sk_sp<SkShader> current_shader_;
+  sk_sp<SkColorFilter> current_color_filter_;
+  sk_sp<SkImageFilter> current_image_filter_;
+  sk_sp<SkPathEffect> current_path_effect_;
+
   SkRect cull_rect_;
+  bool prepare_rtree_;
   static constexpr SkRect kMaxCullRect_ =
       SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
+
+  // Removes the most recently recorded op if it is a |save| or a
+  // |saveLayer| without attributes, returning true if it was removed.
+  bool PopTrailingSave();
+
+  void ResetAttributes();
+
+  void ElideOp(size_t bytes) {
+    elided_op_count_++;
+    elided_bytes_ += bytes;
+  }
 };
 
 }  // namespace flutter
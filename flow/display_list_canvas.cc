@@ -4,35 +4,70 @@
 
 #include "flutter/flow/display_list_canvas.h"
 
+#include "flutter/flow/glyph_usage.h"
 #include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/fml/thread_local.h"
 
 #include "third_party/skia/include/core/SkMaskFilter.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
 
 namespace flutter {
 
+// The atlas draws that a DisplayListCanvasDispatcher has merged into a
+// single draw. The buffers of each thread are kept across frames, and are
+// only used by one dispatcher at a time.
+struct DisplayListAtlasBatch {
+  bool in_use = false;
+  sk_sp<SkImage> atlas;
+  SkBlendMode mode;
+  SkSamplingOptions sampling;
+  bool render_with_attributes;
+  SkPaint paint;
+  bool has_cull_rect;
+  SkRect cull_rect;
+  std::vector<SkRSXform> xforms;
+  std::vector<SkRect> texs;
+  std::vector<SkColor> colors;
+};
+
+namespace {
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<DisplayListAtlasBatch>
+    tls_atlas_batch;
+}  // namespace
+
+DisplayListCanvasDispatcher::~DisplayListCanvasDispatcher() {
+  FlushAtlasBatch();
+}
+
 void DisplayListCanvasDispatcher::save() {
+  FlushAtlasBatch();
   canvas_->save();
 }
 void DisplayListCanvasDispatcher::restore() {
+  FlushAtlasBatch();
   canvas_->restore();
 }
 void DisplayListCanvasDispatcher::saveLayer(const SkRect* bounds,
                                             bool restore_with_paint) {
+  FlushAtlasBatch();
   TRACE_EVENT0("flutter", "Canvas::saveLayer");
   canvas_->saveLayer(bounds, restore_with_paint ? &paint() : nullptr);
 }
 
 void DisplayListCanvasDispatcher::translate(SkScalar tx, SkScalar ty) {
+  FlushAtlasBatch();
   canvas_->translate(tx, ty);
 }
 void DisplayListCanvasDispatcher::scale(SkScalar sx, SkScalar sy) {
+  FlushAtlasBatch();
   canvas_->scale(sx, sy);
 }
 void DisplayListCanvasDispatcher::rotate(SkScalar degrees) {
+  FlushAtlasBatch();
   canvas_->rotate(degrees);
 }
 void DisplayListCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
+  FlushAtlasBatch();
   canvas_->skew(sx, sy);
 }
 // clang-format off
@@ -40,6 +75,7 @@ void DisplayListCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
 void DisplayListCanvasDispatcher::transform2DAffine(
     SkScalar mxx, SkScalar mxy, SkScalar mxt,
     SkScalar myx, SkScalar myy, SkScalar myt) {
+  FlushAtlasBatch();
   // Internally concat(SkMatrix) gets redirected to concat(SkM44)
   // so we just jump directly to the SkM44 version
   canvas_->concat(SkM44(mxx, mxy, 0, mxt,
@@ -53,6 +89,7 @@ void DisplayListCanvasDispatcher::transformFullPerspective(
     SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
     SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
     SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) {
+  FlushAtlasBatch();
   canvas_->concat(SkM44(mxx, mxy, mxz, mxt,
                         myx, myy, myz, myt,
                         mzx, mzy, mzz, mzt,
@@ -63,20 +100,24 @@ void DisplayListCanvasDispatcher::transformFullPerspective(
 void DisplayListCanvasDispatcher::clipRect(const SkRect& rect,
                                            SkClipOp clip_op,
                                            bool is_aa) {
+  FlushAtlasBatch();
   canvas_->clipRect(rect, clip_op, is_aa);
 }
 void DisplayListCanvasDispatcher::clipRRect(const SkRRect& rrect,
                                             SkClipOp clip_op,
                                             bool is_aa) {
+  FlushAtlasBatch();
   canvas_->clipRRect(rrect, clip_op, is_aa);
 }
 void DisplayListCanvasDispatcher::clipPath(const SkPath& path,
                                            SkClipOp clip_op,
                                            bool is_aa) {
+  FlushAtlasBatch();
   canvas_->clipPath(path, clip_op, is_aa);
 }
 
 void DisplayListCanvasDispatcher::drawPaint() {
+  FlushAtlasBatch();
   const SkPaint& sk_paint = paint();
   SkImageFilter* filter = sk_paint.getImageFilter();
   if (filter && !filter->asColorFilter(nullptr)) {
@@ -87,51 +128,63 @@ void DisplayListCanvasDispatcher::drawPaint() {
   canvas_->drawPaint(sk_paint);
 }
 void DisplayListCanvasDispatcher::drawColor(SkColor color, SkBlendMode mode) {
+  FlushAtlasBatch();
   canvas_->drawColor(color, mode);
 }
 void DisplayListCanvasDispatcher::drawLine(const SkPoint& p0,
                                            const SkPoint& p1) {
+  FlushAtlasBatch();
   canvas_->drawLine(p0, p1, paint());
 }
 void DisplayListCanvasDispatcher::drawRect(const SkRect& rect) {
+  FlushAtlasBatch();
   canvas_->drawRect(rect, paint());
 }
 void DisplayListCanvasDispatcher::drawOval(const SkRect& bounds) {
+  FlushAtlasBatch();
   canvas_->drawOval(bounds, paint());
 }
 void DisplayListCanvasDispatcher::drawCircle(const SkPoint& center,
                                              SkScalar radius) {
+  FlushAtlasBatch();
   canvas_->drawCircle(center, radius, paint());
 }
 void DisplayListCanvasDispatcher::drawRRect(const SkRRect& rrect) {
+  FlushAtlasBatch();
   canvas_->drawRRect(rrect, paint());
 }
 void DisplayListCanvasDispatcher::drawDRRect(const SkRRect& outer,
                                              const SkRRect& inner) {
+  FlushAtlasBatch();
   canvas_->drawDRRect(outer, inner, paint());
 }
 void DisplayListCanvasDispatcher::drawPath(const SkPath& path) {
+  FlushAtlasBatch();
   canvas_->drawPath(path, paint());
 }
 void DisplayListCanvasDispatcher::drawArc(const SkRect& bounds,
                                           SkScalar start,
                                           SkScalar sweep,
                                           bool useCenter) {
+  FlushAtlasBatch();
   canvas_->drawArc(bounds, start, sweep, useCenter, paint());
 }
 void DisplayListCanvasDispatcher::drawPoints(SkCanvas::PointMode mode,
                                              uint32_t count,
                                              const SkPoint pts[]) {
+  FlushAtlasBatch();
   canvas_->drawPoints(mode, count, pts, paint());
 }
 void DisplayListCanvasDispatcher::drawVertices(const sk_sp<SkVertices> vertices,
                                                SkBlendMode mode) {
+  FlushAtlasBatch();
   canvas_->drawVertices(vertices, mode, paint());
 }
 void DisplayListCanvasDispatcher::drawImage(const sk_sp<SkImage> image,
                                             const SkPoint point,
                                             const SkSamplingOptions& sampling,
                                             bool render_with_attributes) {
+  FlushAtlasBatch();
   canvas_->drawImage(image, point.fX, point.fY, sampling,
                      render_with_attributes ? &paint() : nullptr);
 }
@@ -142,6 +195,7 @@ void DisplayListCanvasDispatcher::drawImageRect(
     const SkSamplingOptions& sampling,
     bool render_with_attributes,
     SkCanvas::SrcRectConstraint constraint) {
+  FlushAtlasBatch();
   canvas_->drawImageRect(image, src, dst, sampling,
                          render_with_attributes ? &paint() : nullptr,
                          constraint);
@@ -151,6 +205,7 @@ void DisplayListCanvasDispatcher::drawImageNine(const sk_sp<SkImage> image,
                                                 const SkRect& dst,
                                                 SkFilterMode filter,
                                                 bool render_with_attributes) {
+  FlushAtlasBatch();
   canvas_->drawImageNine(image.get(), center, dst, filter,
                          render_with_attributes ? &paint() : nullptr);
 }
@@ -160,6 +215,7 @@ void DisplayListCanvasDispatcher::drawImageLattice(
     const SkRect& dst,
     SkFilterMode filter,
     bool render_with_attributes) {
+  FlushAtlasBatch();
   canvas_->drawImageLattice(image.get(), lattice, dst, filter,
                             render_with_attributes ? &paint() : nullptr);
 }
@@ -172,12 +228,82 @@ void DisplayListCanvasDispatcher::drawAtlas(const sk_sp<SkImage> atlas,
                                             const SkSamplingOptions& sampling,
                                             const SkRect* cullRect,
                                             bool render_with_attributes) {
-  canvas_->drawAtlas(atlas.get(), xform, tex, colors, count, mode, sampling,
-                     cullRect, render_with_attributes ? &paint() : nullptr);
+  const SkPaint* sk_paint = render_with_attributes ? &paint() : nullptr;
+  if (atlas_batch_) {
+    DisplayListAtlasBatch& batch = *atlas_batch_;
+    if (batch.atlas == atlas && batch.mode == mode &&
+        batch.sampling == sampling &&
+        batch.render_with_attributes == render_with_attributes &&
+        (!sk_paint || batch.paint == *sk_paint) &&
+        batch.colors.empty() == (colors == nullptr)) {
+      batch.xforms.insert(batch.xforms.end(), xform, xform + count);
+      batch.texs.insert(batch.texs.end(), tex, tex + count);
+      if (colors) {
+        batch.colors.insert(batch.colors.end(), colors, colors + count);
+      }
+      // The cull rect only lets the canvas skip the whole draw.
+      if (batch.has_cull_rect && cullRect) {
+        batch.cull_rect.join(*cullRect);
+      } else {
+        batch.has_cull_rect = false;
+      }
+      return;
+    }
+    DrawAtlasBatch();
+  }
+  DisplayListAtlasBatch* batch = tls_atlas_batch.get();
+  if (!batch) {
+    batch = new DisplayListAtlasBatch();
+    tls_atlas_batch.reset(batch);
+  }
+  // The image filter of a paint applies to the whole draw, so those draws are
+  // not merged.
+  if (batch->in_use || (sk_paint && sk_paint->getImageFilter())) {
+    canvas_->drawAtlas(atlas.get(), xform, tex, colors, count, mode, sampling,
+                       cullRect, sk_paint);
+    return;
+  }
+  batch->in_use = true;
+  batch->atlas = atlas;
+  batch->mode = mode;
+  batch->sampling = sampling;
+  batch->render_with_attributes = render_with_attributes;
+  if (sk_paint) {
+    batch->paint = *sk_paint;
+  }
+  batch->has_cull_rect = cullRect != nullptr;
+  if (cullRect) {
+    batch->cull_rect = *cullRect;
+  }
+  batch->xforms.assign(xform, xform + count);
+  batch->texs.assign(tex, tex + count);
+  if (colors) {
+    batch->colors.assign(colors, colors + count);
+  }
+  atlas_batch_ = batch;
+}
+
+void DisplayListCanvasDispatcher::DrawAtlasBatch() {
+  DisplayListAtlasBatch& batch = *atlas_batch_;
+  atlas_batch_ = nullptr;
+  canvas_->drawAtlas(batch.atlas.get(), batch.xforms.data(), batch.texs.data(),
+                     batch.colors.empty() ? nullptr : batch.colors.data(),
+                     static_cast<int>(batch.xforms.size()), batch.mode,
+                     batch.sampling,
+                     batch.has_cull_rect ? &batch.cull_rect : nullptr,
+                     batch.render_with_attributes ? &batch.paint : nullptr);
+  // Only the capacity of the buffers is kept.
+  batch.atlas.reset();
+  batch.paint.reset();
+  batch.xforms.clear();
+  batch.texs.clear();
+  batch.colors.clear();
+  batch.in_use = false;
 }
 void DisplayListCanvasDispatcher::drawPicture(const sk_sp<SkPicture> picture,
                                               const SkMatrix* matrix,
                                               bool render_with_attributes) {
+  FlushAtlasBatch();
   if (render_with_attributes) {
     // drawPicture does an implicit saveLayer if an SkPaint is supplied.
     TRACE_EVENT0("flutter", "Canvas::saveLayer");
@@ -188,6 +314,7 @@ void DisplayListCanvasDispatcher::drawPicture(const sk_sp<SkPicture> picture,
 }
 void DisplayListCanvasDispatcher::drawDisplayList(
     const sk_sp<DisplayList> display_list) {
+  FlushAtlasBatch();
   int save_count = canvas_->save();
   {
     DisplayListCanvasDispatcher dispatcher(canvas_);
@@ -198,6 +325,12 @@ void DisplayListCanvasDispatcher::drawDisplayList(
 void DisplayListCanvasDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                                SkScalar x,
                                                SkScalar y) {
+  FlushAtlasBatch();
+  if (GlyphUsage::GetInstance().IsRecording()) {
+    SkMatrix matrix = canvas_->getTotalMatrix();
+    matrix.preTranslate(x, y);
+    GlyphUsage::GetInstance().RecordTextBlob(*blob, matrix, paint());
+  }
   canvas_->drawTextBlob(blob, x, y, paint());
 }
 void DisplayListCanvasDispatcher::drawShadow(const SkPath& path,
@@ -205,13 +338,15 @@ void DisplayListCanvasDispatcher::drawShadow(const SkPath& path,
                                              const SkScalar elevation,
                                              bool transparent_occluder,
                                              SkScalar dpr) {
+  FlushAtlasBatch();
   flutter::PhysicalShapeLayer::DrawShadow(canvas_, path, color, elevation,
                                           transparent_occluder, dpr);
 }
 
-DisplayListCanvasRecorder::DisplayListCanvasRecorder(const SkRect& bounds)
+DisplayListCanvasRecorder::DisplayListCanvasRecorder(const SkRect& bounds,
+                                                     bool prepare_rtree)
     : SkCanvasVirtualEnforcer(bounds.width(), bounds.height()),
-      builder_(sk_make_sp<DisplayListBuilder>(bounds)) {}
+      builder_(sk_make_sp<DisplayListBuilder>(bounds, prepare_rtree)) {}
 
 sk_sp<DisplayList> DisplayListCanvasRecorder::Build() {
   sk_sp<DisplayList> display_list = builder_->Build();
@@ -23,11 +23,23 @@
 
 namespace flutter {
 
+struct DisplayListAtlasBatch;
+
 // Receives all methods on Dispatcher and sends them to an SkCanvas
-class DisplayListCanvasDispatcher : public virtual Dispatcher,
-                                    public SkPaintDispatchHelper {
+//
+// The class is final so that DisplayList can bind the calls to its
+// methods statically when rendering to a canvas.
+class DisplayListCanvasDispatcher final : public virtual Dispatcher,
+                                          public SkPaintDispatchHelper {
  public:
-  DisplayListCanvasDispatcher(SkCanvas* canvas) : canvas_(canvas) {}
+  // The |opacity| is applied to the alpha of every rendering op, which
+  // is only equivalent to a group opacity for lists that report
+  // |DisplayList::can_apply_group_opacity|.
+  DisplayListCanvasDispatcher(SkCanvas* canvas, SkScalar opacity = SK_Scalar1)
+      : SkPaintDispatchHelper(opacity), canvas_(canvas) {}
+
+  // Draws the pending atlas batch, see |drawAtlas|.
+  ~DisplayListCanvasDispatcher();
 
   void save() override;
   void restore() override;
@@ -91,6 +103,10 @@ class DisplayListCanvasDispatcher : public virtual Dispatcher,
                         const SkRect& dst,
                         SkFilterMode filter,
                         bool render_with_attributes) override;
+  // Consecutive atlas draws of the same image with the same attributes are
+  // drawn with a single call to the canvas, when the next operation that is
+  // not an atlas draw of the same kind is dispatched or the dispatcher is
+  // destroyed. Games draw their sprites and particles with many of them.
   void drawAtlas(const sk_sp<SkImage> atlas,
                  const SkRSXform xform[],
                  const SkRect tex[],
@@ -115,6 +131,16 @@ class DisplayListCanvasDispatcher : public virtual Dispatcher,
 
  private:
   SkCanvas* canvas_;
+  // The batch of the atlas draws that have not been drawn yet, if any.
+  DisplayListAtlasBatch* atlas_batch_ = nullptr;
+
+  void FlushAtlasBatch() {
+    if (atlas_batch_) {
+      DrawAtlasBatch();
+    }
+  }
+
+  void DrawAtlasBatch();
 };
 
 // Receives all methods on SkCanvas and sends them to a DisplayListBuilder
@@ -122,7 +148,8 @@ class DisplayListCanvasRecorder
     : public SkCanvasVirtualEnforcer<SkNoDrawCanvas>,
       public SkRefCnt {
  public:
-  DisplayListCanvasRecorder(const SkRect& bounds);
+  // See |DisplayListBuilder| for a description of |prepare_rtree|.
+  DisplayListCanvasRecorder(const SkRect& bounds, bool prepare_rtree = false);
 
   const sk_sp<DisplayListBuilder> builder() { return builder_; }
 
@@ -2363,6 +2363,65 @@ TEST(DisplayListCanvas, DrawShadowTransparentOccluder) {
       CanvasCompareTester::DefaultTolerance.addBoundsPadding(3, 3));
 }
 
+class AtlasCountingCanvas : public SkNoDrawCanvas {
+ public:
+  AtlasCountingCanvas() : SkNoDrawCanvas(100, 100) {}
+
+  int atlas_count() const { return atlas_count_; }
+  int sprite_count() const { return sprite_count_; }
+
+ protected:
+  void onDrawAtlas2(const SkImage*,
+                    const SkRSXform[],
+                    const SkRect[],
+                    const SkColor[],
+                    int count,
+                    SkBlendMode,
+                    const SkSamplingOptions&,
+                    const SkRect*,
+                    const SkPaint*) override {
+    atlas_count_++;
+    sprite_count_ += count;
+  }
+
+ private:
+  int atlas_count_ = 0;
+  int sprite_count_ = 0;
+};
+
+TEST(DisplayListCanvas, DrawAtlasBatchesConsecutiveDraws) {
+  const sk_sp<SkImage> image = CanvasCompareTester::testImage;
+  const SkRSXform xform[] = {
+      SkRSXform::Make(1, 0, 0, 0),
+      SkRSXform::Make(1, 0, 10, 0),
+  };
+  const SkRect tex[] = {
+      SkRect::MakeWH(5, 5),
+      SkRect::MakeXYWH(5, 0, 5, 5),
+  };
+  DisplayListBuilder builder;
+  builder.drawAtlas(image, xform, tex, nullptr, 2, SkBlendMode::kSrcOver,
+                    DisplayList::NearestSampling, nullptr, true);
+  builder.drawAtlas(image, xform, tex, nullptr, 2, SkBlendMode::kSrcOver,
+                    DisplayList::NearestSampling, nullptr, true);
+  builder.drawAtlas(image, xform, tex, nullptr, 1, SkBlendMode::kSrcOver,
+                    DisplayList::NearestSampling, nullptr, true);
+  // A different paint starts a new batch.
+  builder.setColor(SK_ColorRED);
+  builder.drawAtlas(image, xform, tex, nullptr, 2, SkBlendMode::kSrcOver,
+                    DisplayList::NearestSampling, nullptr, true);
+  // So does any other operation.
+  builder.translate(10, 10);
+  builder.drawAtlas(image, xform, tex, nullptr, 2, SkBlendMode::kSrcOver,
+                    DisplayList::NearestSampling, nullptr, true);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  AtlasCountingCanvas canvas;
+  display_list->RenderTo(&canvas);
+  EXPECT_EQ(canvas.atlas_count(), 3);
+  EXPECT_EQ(canvas.sprite_count(), 9);
+}
+
 TEST(DisplayListCanvas, DrawShadowDpr) {
   SkPath path;
   path.addRoundRect(
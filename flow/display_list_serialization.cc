@@ -0,0 +1,1242 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_serialization.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+#include "flutter/fml/logging.h"
+
+#include "third_party/skia/include/core/SkBlender.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPathEffect.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkShader.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+
+namespace {
+
+// "FLDL" in a little endian dump of the file.
+constexpr uint32_t kMagic = 0x4c444c46;
+
+// Used in place of an object id for a null object.
+constexpr uint32_t kNullObject = 0xffffffff;
+
+// One op code per Dispatcher method. The values are part of the format
+// and so new ops must only ever be added at the end of the list, along
+// with an increase in |SerializedDisplayList::kVersion|.
+enum class WireOp : uint8_t {
+  kSetAntiAlias,
+  kSetDither,
+  kSetStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetShader,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetBlender,
+  kSetPathEffect,
+  kSetMaskFilter,
+  kSetMaskBlurFilter,
+  kSetImageFilter,
+
+  kSave,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawImageLattice,
+  kDrawAtlas,
+  kDrawPicture,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawShadow,
+};
+
+// The types of the entries in the object table. As with WireOp, the
+// values are part of the format.
+enum class ObjectType : uint32_t {
+  kPath,
+  kImage,
+  kShader,
+  kColorFilter,
+  kImageFilter,
+  kPathEffect,
+  kMaskFilter,
+  kBlender,
+  kPicture,
+  kTextBlob,
+  kVertices,
+  kDisplayList,
+};
+
+struct BlobHeader {
+  uint32_t magic;
+  uint32_t version;
+  SkRect bounds;
+  uint32_t op_count;
+  uint32_t ops_bytes;
+  uint32_t object_count;
+  uint32_t reserved;
+};
+
+struct ObjectHeader {
+  uint32_t type;
+  uint32_t length;
+};
+
+size_t Align4(size_t size) {
+  return (size + 3) & ~static_cast<size_t>(3);
+}
+
+// SkVertices has no public serialization, so they are stored as an
+// SkPicture containing a single drawVertices call and then recovered
+// by playing that picture back into this canvas.
+class VerticesExtractor final : public SkNoDrawCanvas {
+ public:
+  VerticesExtractor() : SkNoDrawCanvas(1 << 16, 1 << 16) {}
+
+  sk_sp<SkVertices> vertices() const { return vertices_; }
+
+ protected:
+  void onDrawVerticesObject(const SkVertices* vertices,
+                            SkBlendMode mode,
+                            const SkPaint& paint) override {
+    vertices_ = sk_ref_sp(vertices);
+  }
+
+ private:
+  sk_sp<SkVertices> vertices_;
+};
+
+sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& image) {
+  sk_sp<SkData> data = image->refEncodedData();
+  if (data) {
+    return data;
+  }
+  // Texture backed images are only accessible on the raster thread,
+  // in which case the image will be missing from the serialized data.
+  sk_sp<SkImage> raster = image->makeRasterImage();
+  return raster ? raster->encodeToData() : nullptr;
+}
+
+sk_sp<SkData> EncodeVertices(const sk_sp<SkVertices>& vertices) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(vertices->bounds());
+  canvas->drawVertices(vertices.get(), SkBlendMode::kSrcOver, SkPaint());
+  return recorder.finishRecordingAsPicture()->serialize();
+}
+
+// Receives the operations of a DisplayList and writes them, along with
+// the objects they reference, into the serialized form.
+class DisplayListWriter final : public virtual Dispatcher {
+ public:
+  sk_sp<SkData> Finish(const DisplayList& display_list) {
+    BlobHeader header = {};
+    header.magic = kMagic;
+    header.version = SerializedDisplayList::kVersion;
+    header.bounds = display_list.bounds();
+    header.op_count = op_count_;
+    header.ops_bytes = ops_.size();
+    header.object_count = objects_.size();
+
+    size_t size = sizeof(header) + ops_.size();
+    for (auto& object : objects_) {
+      size += sizeof(ObjectHeader) + Align4(object.data->size());
+    }
+    sk_sp<SkData> result = SkData::MakeZeroInitialized(size);
+    uint8_t* ptr = static_cast<uint8_t*>(result->writable_data());
+    memcpy(ptr, &header, sizeof(header));
+    ptr += sizeof(header);
+    memcpy(ptr, ops_.data(), ops_.size());
+    ptr += ops_.size();
+    for (auto& object : objects_) {
+      ObjectHeader object_header = {static_cast<uint32_t>(object.type),
+                                    static_cast<uint32_t>(object.data->size())};
+      memcpy(ptr, &object_header, sizeof(object_header));
+      ptr += sizeof(object_header);
+      memcpy(ptr, object.data->data(), object.data->size());
+      ptr += Align4(object.data->size());
+    }
+    return result;
+  }
+
+  void setAntiAlias(bool aa) override { Write(WireOp::kSetAntiAlias, aa); }
+  void setDither(bool dither) override { Write(WireOp::kSetDither, dither); }
+  void setStyle(SkPaint::Style style) override {
+    Write(WireOp::kSetStyle, style);
+  }
+  void setColor(SkColor color) override { Write(WireOp::kSetColor, color); }
+  void setStrokeWidth(SkScalar width) override {
+    Write(WireOp::kSetStrokeWidth, width);
+  }
+  void setStrokeMiter(SkScalar limit) override {
+    Write(WireOp::kSetStrokeMiter, limit);
+  }
+  void setStrokeCap(SkPaint::Cap cap) override {
+    Write(WireOp::kSetStrokeCap, cap);
+  }
+  void setStrokeJoin(SkPaint::Join join) override {
+    Write(WireOp::kSetStrokeJoin, join);
+  }
+  void setShader(sk_sp<SkShader> shader) override {
+    Write(WireOp::kSetShader, AddFlattenable(ObjectType::kShader, shader));
+  }
+  void setColorFilter(sk_sp<SkColorFilter> filter) override {
+    Write(WireOp::kSetColorFilter,
+          AddFlattenable(ObjectType::kColorFilter, filter));
+  }
+  void setInvertColors(bool invert) override {
+    Write(WireOp::kSetInvertColors, invert);
+  }
+  void setBlendMode(SkBlendMode mode) override {
+    Write(WireOp::kSetBlendMode, mode);
+  }
+  void setBlender(sk_sp<SkBlender> blender) override {
+    Write(WireOp::kSetBlender, AddFlattenable(ObjectType::kBlender, blender));
+  }
+  void setPathEffect(sk_sp<SkPathEffect> effect) override {
+    Write(WireOp::kSetPathEffect,
+          AddFlattenable(ObjectType::kPathEffect, effect));
+  }
+  void setMaskFilter(sk_sp<SkMaskFilter> filter) override {
+    Write(WireOp::kSetMaskFilter,
+          AddFlattenable(ObjectType::kMaskFilter, filter));
+  }
+  void setMaskBlurFilter(SkBlurStyle style, SkScalar sigma) override {
+    Write(WireOp::kSetMaskBlurFilter, style, sigma);
+  }
+  void setImageFilter(sk_sp<SkImageFilter> filter) override {
+    Write(WireOp::kSetImageFilter,
+          AddFlattenable(ObjectType::kImageFilter, filter));
+  }
+
+  void save() override { Write(WireOp::kSave); }
+  void saveLayer(const SkRect* bounds, bool restore_with_paint) override {
+    Write(WireOp::kSaveLayer, bounds != nullptr,
+          bounds ? *bounds : SkRect::MakeEmpty(), restore_with_paint);
+  }
+  void restore() override { Write(WireOp::kRestore); }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    Write(WireOp::kTranslate, tx, ty);
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    Write(WireOp::kScale, sx, sy);
+  }
+  void rotate(SkScalar degrees) override { Write(WireOp::kRotate, degrees); }
+  void skew(SkScalar sx, SkScalar sy) override { Write(WireOp::kSkew, sx, sy); }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    Write(WireOp::kTransform2DAffine,
+          mxx, mxy, mxt,
+          myx, myy, myt);
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    Write(WireOp::kTransformFullPerspective,
+          mxx, mxy, mxz, mxt,
+          myx, myy, myz, myt,
+          mzx, mzy, mzz, mzt,
+          mwx, mwy, mwz, mwt);
+  }
+  // clang-format on
+
+  void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) override {
+    Write(WireOp::kClipRect, rect, clip_op, is_aa);
+  }
+  void clipRRect(const SkRRect& rrect, SkClipOp clip_op, bool is_aa) override {
+    Write(WireOp::kClipRRect, rrect, clip_op, is_aa);
+  }
+  void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) override {
+    Write(WireOp::kClipPath, AddPath(path), clip_op, is_aa);
+  }
+
+  void drawColor(SkColor color, SkBlendMode mode) override {
+    Write(WireOp::kDrawColor, color, mode);
+  }
+  void drawPaint() override { Write(WireOp::kDrawPaint); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    Write(WireOp::kDrawLine, p0, p1);
+  }
+  void drawRect(const SkRect& rect) override { Write(WireOp::kDrawRect, rect); }
+  void drawOval(const SkRect& bounds) override {
+    Write(WireOp::kDrawOval, bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Write(WireOp::kDrawCircle, center, radius);
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    Write(WireOp::kDrawRRect, rrect);
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Write(WireOp::kDrawDRRect, outer, inner);
+  }
+  void drawPath(const SkPath& path) override {
+    Write(WireOp::kDrawPath, AddPath(path));
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Write(WireOp::kDrawArc, oval_bounds, start_degrees, sweep_degrees,
+          use_center);
+  }
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    StartOp(WireOp::kDrawPoints);
+    Put(mode);
+    Put(count);
+    PutArray(points, count * sizeof(SkPoint));
+    EndOp();
+  }
+  void drawVertices(const sk_sp<SkVertices> vertices,
+                    SkBlendMode mode) override {
+    uint32_t id = AddObject(ObjectType::kVertices, vertices.get(),
+                            [&vertices]() { return EncodeVertices(vertices); });
+    Write(WireOp::kDrawVertices, id, mode);
+  }
+  void drawImage(const sk_sp<SkImage> image,
+                 const SkPoint point,
+                 const SkSamplingOptions& sampling,
+                 bool render_with_attributes) override {
+    Write(WireOp::kDrawImage, AddImage(image), point, sampling,
+          render_with_attributes);
+  }
+  void drawImageRect(const sk_sp<SkImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    Write(WireOp::kDrawImageRect, AddImage(image), src, dst, sampling,
+          render_with_attributes, constraint);
+  }
+  void drawImageNine(const sk_sp<SkImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     bool render_with_attributes) override {
+    Write(WireOp::kDrawImageNine, AddImage(image), center, dst, filter,
+          render_with_attributes);
+  }
+  void drawImageLattice(const sk_sp<SkImage> image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool render_with_attributes) override {
+    StartOp(WireOp::kDrawImageLattice);
+    Put(AddImage(image));
+    Put(dst);
+    Put(filter);
+    Put(render_with_attributes);
+    uint32_t x_count = lattice.fXCount;
+    uint32_t y_count = lattice.fYCount;
+    uint32_t cell_count = (x_count + 1) * (y_count + 1);
+    Put(x_count);
+    Put(y_count);
+    Put(lattice.fRectTypes != nullptr);
+    Put(lattice.fBounds != nullptr);
+    Put(lattice.fColors != nullptr);
+    PutArray(lattice.fXDivs, x_count * sizeof(int));
+    PutArray(lattice.fYDivs, y_count * sizeof(int));
+    if (lattice.fRectTypes) {
+      PutArray(lattice.fRectTypes,
+               cell_count * sizeof(SkCanvas::Lattice::RectType));
+    }
+    if (lattice.fBounds) {
+      Put(*lattice.fBounds);
+    }
+    if (lattice.fColors) {
+      PutArray(lattice.fColors, cell_count * sizeof(SkColor));
+    }
+    EndOp();
+  }
+  void drawAtlas(const sk_sp<SkImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    StartOp(WireOp::kDrawAtlas);
+    Put(AddImage(atlas));
+    Put(static_cast<uint32_t>(count));
+    Put(mode);
+    Put(sampling);
+    Put(render_with_attributes);
+    Put(colors != nullptr);
+    Put(cull_rect != nullptr);
+    if (cull_rect) {
+      Put(*cull_rect);
+    }
+    PutArray(xform, count * sizeof(SkRSXform));
+    PutArray(tex, count * sizeof(SkRect));
+    if (colors) {
+      PutArray(colors, count * sizeof(SkColor));
+    }
+    EndOp();
+  }
+  void drawPicture(const sk_sp<SkPicture> picture,
+                   const SkMatrix* matrix,
+                   bool render_with_attributes) override {
+    uint32_t id = AddObject(ObjectType::kPicture, picture.get(),
+                            [&picture]() { return picture->serialize(); });
+    SkScalar values[9];
+    (matrix ? *matrix : SkMatrix::I()).get9(values);
+    Write(WireOp::kDrawPicture, id, matrix != nullptr, values,
+          render_with_attributes);
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    uint32_t id =
+        AddObject(ObjectType::kDisplayList, display_list.get(),
+                  [&display_list]() {
+                    return SerializeDisplayList(*display_list);
+                  });
+    Write(WireOp::kDrawDisplayList, id);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    uint32_t id = AddObject(ObjectType::kTextBlob, blob.get(), [&blob]() {
+      return blob->serialize(SkSerialProcs());
+    });
+    Write(WireOp::kDrawTextBlob, id, x, y);
+  }
+  void drawShadow(const SkPath& path,
+                  const SkColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    Write(WireOp::kDrawShadow, AddPath(path), color, elevation,
+          transparent_occluder, dpr);
+  }
+
+ private:
+  struct ObjectRecord {
+    ObjectType type;
+    sk_sp<SkData> data;
+  };
+
+  std::vector<uint8_t> ops_;
+  size_t op_start_ = 0;
+  int op_count_ = 0;
+  std::vector<ObjectRecord> objects_;
+  std::unordered_map<const void*, uint32_t> object_ids_;
+
+  void StartOp(WireOp op) {
+    op_start_ = ops_.size();
+    Put(static_cast<uint32_t>(op));
+  }
+
+  // Fills in the size of the op in the upper 24 bits of its first word.
+  void EndOp() {
+    uint32_t size = ops_.size() - op_start_;
+    FML_DCHECK(size < (1 << 24));
+    ops_[op_start_ + 1] = size & 0xff;
+    ops_[op_start_ + 2] = (size >> 8) & 0xff;
+    ops_[op_start_ + 3] = (size >> 16) & 0xff;
+    op_count_++;
+  }
+
+  template <typename... Args>
+  void Write(WireOp op, const Args&... args) {
+    StartOp(op);
+    (Put(args), ...);
+    EndOp();
+  }
+
+  void PutArray(const void* data, size_t bytes) {
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    ops_.insert(ops_.end(), ptr, ptr + bytes);
+    ops_.resize(Align4(ops_.size()), 0);
+  }
+
+  template <typename T>
+  void Put(const T& value) {
+    if constexpr (std::is_enum_v<T> || std::is_same_v<T, bool>) {
+      Put(static_cast<uint32_t>(value));
+    } else {
+      static_assert(std::is_trivially_copyable_v<T>);
+      PutArray(&value, sizeof(value));
+    }
+  }
+
+  void Put(const SkRRect& rrect) {
+    uint8_t buffer[SkRRect::kSizeInMemory];
+    rrect.writeToMemory(buffer);
+    PutArray(buffer, sizeof(buffer));
+  }
+
+  void Put(const SkSamplingOptions& sampling) {
+    Put(sampling.useCubic);
+    Put(sampling.cubic.B);
+    Put(sampling.cubic.C);
+    Put(sampling.filter);
+    Put(sampling.mipmap);
+  }
+
+  template <typename F>
+  uint32_t AddObject(ObjectType type, const void* object, const F& encode) {
+    if (object == nullptr) {
+      return kNullObject;
+    }
+    auto it = object_ids_.find(object);
+    if (it != object_ids_.end()) {
+      return it->second;
+    }
+    sk_sp<SkData> data = encode();
+    if (!data) {
+      FML_LOG(ERROR) << "Unable to serialize an object of type "
+                     << static_cast<uint32_t>(type);
+      data = SkData::MakeEmpty();
+    }
+    uint32_t id = objects_.size();
+    objects_.push_back({type, std::move(data)});
+    object_ids_[object] = id;
+    return id;
+  }
+
+  uint32_t AddFlattenable(ObjectType type, const sk_sp<SkFlattenable>& obj) {
+    return AddObject(type, obj.get(), [&obj]() { return obj->serialize(); });
+  }
+
+  uint32_t AddImage(const sk_sp<SkImage>& image) {
+    return AddObject(ObjectType::kImage, image.get(),
+                     [&image]() { return EncodeImage(image); });
+  }
+
+  // Paths are held by value in the DisplayList and so are not shared.
+  uint32_t AddPath(const SkPath& path) {
+    uint32_t id = objects_.size();
+    objects_.push_back({ObjectType::kPath, path.serialize()});
+    return id;
+  }
+};
+
+// Reads the payload of a single op, checking each read against the end
+// of the op.
+class OpReader {
+ public:
+  OpReader(const uint8_t* ptr, const uint8_t* end) : ptr_(ptr), end_(end) {}
+
+  bool ok() const { return ok_; }
+
+  template <typename T>
+  T Get() {
+    if constexpr (std::is_same_v<T, bool>) {
+      return Get<uint32_t>() != 0;
+    } else {
+      static_assert(!std::is_enum_v<T>, "Enums are read with GetEnum.");
+      static_assert(std::is_trivially_copyable_v<T>);
+      T value = {};
+      const void* data = GetArray(sizeof(T));
+      if (data) {
+        memcpy(&value, data, sizeof(T));
+      }
+      return value;
+    }
+  }
+
+  // Reads an enum whose values go from 0 to |last|. A value out of that
+  // range would reach Skia as an invalid enum, so it fails the op.
+  template <typename T>
+  T GetEnum(T last) {
+    static_assert(std::is_enum_v<T>);
+    uint32_t value = Get<uint32_t>();
+    if (value > static_cast<uint32_t>(last)) {
+      ok_ = false;
+      return static_cast<T>(0);
+    }
+    return static_cast<T>(value);
+  }
+
+  SkRRect GetRRect() {
+    SkRRect rrect;
+    const void* data = GetArray(SkRRect::kSizeInMemory);
+    if (data &&
+        rrect.readFromMemory(data, SkRRect::kSizeInMemory) == 0) {
+      ok_ = false;
+    }
+    return rrect;
+  }
+
+  SkSamplingOptions GetSampling() {
+    bool use_cubic = Get<bool>();
+    SkScalar b = Get<SkScalar>();
+    SkScalar c = Get<SkScalar>();
+    SkFilterMode filter = GetEnum(SkFilterMode::kLast);
+    SkMipmapMode mipmap = GetEnum(SkMipmapMode::kLast);
+    if (use_cubic) {
+      return SkSamplingOptions(SkCubicResampler{b, c});
+    }
+    return SkSamplingOptions(filter, mipmap);
+  }
+
+  // Returns a pointer to the next |bytes| of the op without copying
+  // them. The data is always 4 byte aligned.
+  const void* GetArray(size_t bytes) {
+    size_t aligned = Align4(bytes);
+    if (!ok_ || aligned < bytes ||
+        static_cast<size_t>(end_ - ptr_) < aligned) {
+      ok_ = false;
+      return nullptr;
+    }
+    const void* result = ptr_;
+    ptr_ += aligned;
+    return result;
+  }
+
+  template <typename T>
+  const T* GetArray(uint32_t count) {
+    if (count > (1u << 29)) {
+      ok_ = false;
+      return nullptr;
+    }
+    return static_cast<const T*>(GetArray(count * sizeof(T)));
+  }
+
+ private:
+  const uint8_t* ptr_;
+  const uint8_t* end_;
+  bool ok_ = true;
+};
+
+}  // namespace
+
+struct SerializedDisplayList::Object {
+  ObjectType type;
+  SkPath path;
+  sk_sp<SkRefCnt> ref;
+  sk_sp<SkTextBlob> blob;
+  sk_sp<SkVertices> vertices;
+};
+
+sk_sp<SkData> SerializeDisplayList(const DisplayList& display_list) {
+  DisplayListWriter writer;
+  display_list.Dispatch(writer);
+  return writer.Finish(display_list);
+}
+
+SerializedDisplayList::SerializedDisplayList(
+    std::unique_ptr<fml::Mapping> mapping)
+    : mapping_(std::move(mapping)), bounds_(SkRect::MakeEmpty()) {}
+
+SerializedDisplayList::~SerializedDisplayList() = default;
+
+std::unique_ptr<SerializedDisplayList> SerializedDisplayList::Make(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (!mapping || mapping->GetSize() < sizeof(BlobHeader)) {
+    return nullptr;
+  }
+  const uint8_t* base = mapping->GetMapping();
+  if (reinterpret_cast<uintptr_t>(base) & 3) {
+    FML_LOG(ERROR) << "Serialized DisplayList data is not 4 byte aligned";
+    return nullptr;
+  }
+  BlobHeader header;
+  memcpy(&header, base, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion) {
+    FML_LOG(ERROR) << "Unrecognized serialized DisplayList data (version "
+                   << header.version << ")";
+    return nullptr;
+  }
+  size_t size = mapping->GetSize();
+  if (header.ops_bytes > size - sizeof(header) || (header.ops_bytes & 3) ||
+      header.op_count > header.ops_bytes / sizeof(uint32_t)) {
+    return nullptr;
+  }
+
+  std::unique_ptr<SerializedDisplayList> result(
+      new SerializedDisplayList(std::move(mapping)));
+  result->bounds_ = header.bounds;
+  result->op_count_ = header.op_count;
+  result->ops_ = base + sizeof(header);
+  result->ops_end_ = result->ops_ + header.ops_bytes;
+  // Each object takes at least 8 bytes, which bounds the reservation
+  // for malformed data.
+  result->objects_.reserve(std::min<size_t>(
+      header.object_count, (size - sizeof(header)) / sizeof(ObjectHeader)));
+  if (!result->DecodeObjects(result->ops_end_, base + size) ||
+      result->objects_.size() != header.object_count) {
+    return nullptr;
+  }
+  return result;
+}
+
+bool SerializedDisplayList::DecodeObjects(const uint8_t* ptr,
+                                          const uint8_t* end) {
+  while (ptr < end) {
+    ObjectHeader header;
+    if (static_cast<size_t>(end - ptr) < sizeof(header)) {
+      return false;
+    }
+    memcpy(&header, ptr, sizeof(header));
+    ptr += sizeof(header);
+    if (header.length > static_cast<size_t>(end - ptr)) {
+      return false;
+    }
+    const uint8_t* data = ptr;
+    size_t length = header.length;
+    ptr += std::min(Align4(length), static_cast<size_t>(end - ptr));
+
+    Object object;
+    object.type = static_cast<ObjectType>(header.type);
+    switch (object.type) {
+      case ObjectType::kPath:
+        if (object.path.readFromMemory(data, length) == 0) {
+          return false;
+        }
+        break;
+      case ObjectType::kImage:
+        // Images may outlive the mapping, so they get their own copy.
+        if (length > 0) {
+          object.ref = SkImage::MakeFromEncoded(SkData::MakeWithCopy(data,
+                                                                     length));
+        }
+        break;
+      case ObjectType::kShader:
+        object.ref = SkFlattenable::Deserialize(
+            SkFlattenable::kSkShader_Type, data, length);
+        break;
+      case ObjectType::kColorFilter:
+        object.ref = SkFlattenable::Deserialize(
+            SkFlattenable::kSkColorFilter_Type, data, length);
+        break;
+      case ObjectType::kImageFilter:
+        object.ref = SkFlattenable::Deserialize(
+            SkFlattenable::kSkImageFilter_Type, data, length);
+        break;
+      case ObjectType::kPathEffect:
+        object.ref = SkFlattenable::Deserialize(
+            SkFlattenable::kSkPathEffect_Type, data, length);
+        break;
+      case ObjectType::kMaskFilter:
+        object.ref = SkFlattenable::Deserialize(
+            SkFlattenable::kSkMaskFilter_Type, data, length);
+        break;
+      case ObjectType::kBlender:
+        object.ref = SkFlattenable::Deserialize(
+            SkFlattenable::kSkBlender_Type, data, length);
+        break;
+      case ObjectType::kPicture:
+        object.ref = SkPicture::MakeFromData(data, length);
+        break;
+      case ObjectType::kTextBlob:
+        object.blob = SkTextBlob::Deserialize(data, length, SkDeserialProcs());
+        break;
+      case ObjectType::kVertices: {
+        sk_sp<SkPicture> picture = SkPicture::MakeFromData(data, length);
+        if (picture) {
+          VerticesExtractor extractor;
+          picture->playback(&extractor);
+          object.vertices = extractor.vertices();
+        }
+        break;
+      }
+      case ObjectType::kDisplayList: {
+        auto nested = Make(std::make_unique<fml::NonOwnedMapping>(
+            data, length, nullptr, mapping_->IsDontNeedSafe()));
+        if (nested) {
+          object.ref = nested->Build();
+        }
+        break;
+      }
+      default:
+        // An unknown object type is a format error as it means the
+        // version check did not capture a change in the format.
+        return false;
+    }
+    objects_.push_back(std::move(object));
+  }
+  return true;
+}
+
+sk_sp<DisplayList> SerializedDisplayList::Build() const {
+  DisplayListBuilder builder(bounds_);
+  Dispatch(builder);
+  return builder.Build();
+}
+
+bool SerializedDisplayList::Dispatch(Dispatcher& dispatcher) const {
+  // Returns the object with the given id if it is of the indicated
+  // type. A null object is allowed for the attribute setters.
+  auto get_object = [this](uint32_t id, ObjectType type,
+                           bool* ok) -> const Object* {
+    if (id == kNullObject) {
+      return nullptr;
+    }
+    if (id >= objects_.size() || objects_[id].type != type) {
+      *ok = false;
+      return nullptr;
+    }
+    return &objects_[id];
+  };
+  auto get_ref = [&get_object](uint32_t id, ObjectType type,
+                               bool* ok) -> sk_sp<SkRefCnt> {
+    const Object* object = get_object(id, type, ok);
+    return object ? object->ref : nullptr;
+  };
+  auto get_path = [&get_object](uint32_t id, bool* ok) -> const SkPath* {
+    const Object* object = get_object(id, ObjectType::kPath, ok);
+    if (!object) {
+      *ok = false;
+    }
+    return object ? &object->path : nullptr;
+  };
+  auto get_image = [&get_ref](uint32_t id, bool* ok) {
+    return sk_sp<SkImage>(
+        static_cast<SkImage*>(get_ref(id, ObjectType::kImage, ok).release()));
+  };
+  auto get_flattenable = [&get_ref](uint32_t id, ObjectType type, bool* ok) {
+    return sk_sp<SkFlattenable>(
+        static_cast<SkFlattenable*>(get_ref(id, type, ok).release()));
+  };
+
+  const uint8_t* ptr = ops_;
+  while (ptr < ops_end_) {
+    if (ops_end_ - ptr < 4) {
+      return false;
+    }
+    uint32_t op_header;
+    memcpy(&op_header, ptr, sizeof(op_header));
+    uint32_t size = op_header >> 8;
+    if (size < 4 || (size & 3) || size > static_cast<size_t>(ops_end_ - ptr)) {
+      return false;
+    }
+    OpReader reader(ptr + 4, ptr + size);
+    ptr += size;
+    bool ok = true;
+
+    switch (static_cast<WireOp>(op_header & 0xff)) {
+      case WireOp::kSetAntiAlias:
+        dispatcher.setAntiAlias(reader.Get<bool>());
+        break;
+      case WireOp::kSetDither:
+        dispatcher.setDither(reader.Get<bool>());
+        break;
+      case WireOp::kSetStyle:
+        dispatcher.setStyle(reader.GetEnum(SkPaint::kStrokeAndFill_Style));
+        break;
+      case WireOp::kSetColor:
+        dispatcher.setColor(reader.Get<SkColor>());
+        break;
+      case WireOp::kSetStrokeWidth:
+        dispatcher.setStrokeWidth(reader.Get<SkScalar>());
+        break;
+      case WireOp::kSetStrokeMiter:
+        dispatcher.setStrokeMiter(reader.Get<SkScalar>());
+        break;
+      case WireOp::kSetStrokeCap:
+        dispatcher.setStrokeCap(reader.GetEnum(SkPaint::kLast_Cap));
+        break;
+      case WireOp::kSetStrokeJoin:
+        dispatcher.setStrokeJoin(reader.GetEnum(SkPaint::kLast_Join));
+        break;
+      case WireOp::kSetShader: {
+        auto flat = get_flattenable(reader.Get<uint32_t>(),
+                                    ObjectType::kShader, &ok);
+        dispatcher.setShader(
+            sk_sp<SkShader>(static_cast<SkShader*>(flat.release())));
+        break;
+      }
+      case WireOp::kSetColorFilter: {
+        auto flat = get_flattenable(reader.Get<uint32_t>(),
+                                    ObjectType::kColorFilter, &ok);
+        dispatcher.setColorFilter(
+            sk_sp<SkColorFilter>(static_cast<SkColorFilter*>(flat.release())));
+        break;
+      }
+      case WireOp::kSetInvertColors:
+        dispatcher.setInvertColors(reader.Get<bool>());
+        break;
+      case WireOp::kSetBlendMode:
+        dispatcher.setBlendMode(reader.GetEnum(SkBlendMode::kLastMode));
+        break;
+      case WireOp::kSetBlender: {
+        auto flat = get_flattenable(reader.Get<uint32_t>(),
+                                    ObjectType::kBlender, &ok);
+        dispatcher.setBlender(
+            sk_sp<SkBlender>(static_cast<SkBlender*>(flat.release())));
+        break;
+      }
+      case WireOp::kSetPathEffect: {
+        auto flat = get_flattenable(reader.Get<uint32_t>(),
+                                    ObjectType::kPathEffect, &ok);
+        dispatcher.setPathEffect(
+            sk_sp<SkPathEffect>(static_cast<SkPathEffect*>(flat.release())));
+        break;
+      }
+      case WireOp::kSetMaskFilter: {
+        auto flat = get_flattenable(reader.Get<uint32_t>(),
+                                    ObjectType::kMaskFilter, &ok);
+        dispatcher.setMaskFilter(
+            sk_sp<SkMaskFilter>(static_cast<SkMaskFilter*>(flat.release())));
+        break;
+      }
+      case WireOp::kSetMaskBlurFilter: {
+        auto style = reader.GetEnum(kLastEnum_SkBlurStyle);
+        auto sigma = reader.Get<SkScalar>();
+        dispatcher.setMaskBlurFilter(style, sigma);
+        break;
+      }
+      case WireOp::kSetImageFilter: {
+        auto flat = get_flattenable(reader.Get<uint32_t>(),
+                                    ObjectType::kImageFilter, &ok);
+        dispatcher.setImageFilter(
+            sk_sp<SkImageFilter>(static_cast<SkImageFilter*>(flat.release())));
+        break;
+      }
+
+      case WireOp::kSave:
+        dispatcher.save();
+        break;
+      case WireOp::kSaveLayer: {
+        bool has_bounds = reader.Get<bool>();
+        SkRect bounds = reader.Get<SkRect>();
+        bool restore_with_paint = reader.Get<bool>();
+        dispatcher.saveLayer(has_bounds ? &bounds : nullptr,
+                             restore_with_paint);
+        break;
+      }
+      case WireOp::kRestore:
+        dispatcher.restore();
+        break;
+
+      case WireOp::kTranslate: {
+        auto tx = reader.Get<SkScalar>();
+        auto ty = reader.Get<SkScalar>();
+        dispatcher.translate(tx, ty);
+        break;
+      }
+      case WireOp::kScale: {
+        auto sx = reader.Get<SkScalar>();
+        auto sy = reader.Get<SkScalar>();
+        dispatcher.scale(sx, sy);
+        break;
+      }
+      case WireOp::kRotate:
+        dispatcher.rotate(reader.Get<SkScalar>());
+        break;
+      case WireOp::kSkew: {
+        auto sx = reader.Get<SkScalar>();
+        auto sy = reader.Get<SkScalar>();
+        dispatcher.skew(sx, sy);
+        break;
+      }
+      case WireOp::kTransform2DAffine: {
+        auto m = reader.GetArray<SkScalar>(6);
+        if (m) {
+          dispatcher.transform2DAffine(m[0], m[1], m[2],  //
+                                       m[3], m[4], m[5]);
+        }
+        break;
+      }
+      case WireOp::kTransformFullPerspective: {
+        auto m = reader.GetArray<SkScalar>(16);
+        if (m) {
+          dispatcher.transformFullPerspective(m[0], m[1], m[2], m[3],     //
+                                              m[4], m[5], m[6], m[7],     //
+                                              m[8], m[9], m[10], m[11],   //
+                                              m[12], m[13], m[14], m[15]);
+        }
+        break;
+      }
+
+      case WireOp::kClipRect: {
+        auto rect = reader.Get<SkRect>();
+        auto clip_op = reader.GetEnum(SkClipOp::kIntersect);
+        auto is_aa = reader.Get<bool>();
+        dispatcher.clipRect(rect, clip_op, is_aa);
+        break;
+      }
+      case WireOp::kClipRRect: {
+        auto rrect = reader.GetRRect();
+        auto clip_op = reader.GetEnum(SkClipOp::kIntersect);
+        auto is_aa = reader.Get<bool>();
+        dispatcher.clipRRect(rrect, clip_op, is_aa);
+        break;
+      }
+      case WireOp::kClipPath: {
+        auto path = get_path(reader.Get<uint32_t>(), &ok);
+        auto clip_op = reader.GetEnum(SkClipOp::kIntersect);
+        auto is_aa = reader.Get<bool>();
+        if (path) {
+          dispatcher.clipPath(*path, clip_op, is_aa);
+        }
+        break;
+      }
+
+      case WireOp::kDrawColor: {
+        auto color = reader.Get<SkColor>();
+        auto mode = reader.GetEnum(SkBlendMode::kLastMode);
+        dispatcher.drawColor(color, mode);
+        break;
+      }
+      case WireOp::kDrawPaint:
+        dispatcher.drawPaint();
+        break;
+      case WireOp::kDrawLine: {
+        auto p0 = reader.Get<SkPoint>();
+        auto p1 = reader.Get<SkPoint>();
+        dispatcher.drawLine(p0, p1);
+        break;
+      }
+      case WireOp::kDrawRect:
+        dispatcher.drawRect(reader.Get<SkRect>());
+        break;
+      case WireOp::kDrawOval:
+        dispatcher.drawOval(reader.Get<SkRect>());
+        break;
+      case WireOp::kDrawCircle: {
+        auto center = reader.Get<SkPoint>();
+        auto radius = reader.Get<SkScalar>();
+        dispatcher.drawCircle(center, radius);
+        break;
+      }
+      case WireOp::kDrawRRect:
+        dispatcher.drawRRect(reader.GetRRect());
+        break;
+      case WireOp::kDrawDRRect: {
+        auto outer = reader.GetRRect();
+        auto inner = reader.GetRRect();
+        dispatcher.drawDRRect(outer, inner);
+        break;
+      }
+      case WireOp::kDrawPath: {
+        auto path = get_path(reader.Get<uint32_t>(), &ok);
+        if (path) {
+          dispatcher.drawPath(*path);
+        }
+        break;
+      }
+      case WireOp::kDrawArc: {
+        auto bounds = reader.Get<SkRect>();
+        auto start = reader.Get<SkScalar>();
+        auto sweep = reader.Get<SkScalar>();
+        auto use_center = reader.Get<bool>();
+        dispatcher.drawArc(bounds, start, sweep, use_center);
+        break;
+      }
+      case WireOp::kDrawPoints: {
+        auto mode = reader.GetEnum(SkCanvas::kPolygon_PointMode);
+        auto count = reader.Get<uint32_t>();
+        auto points = reader.GetArray<SkPoint>(count);
+        if (points) {
+          dispatcher.drawPoints(mode, count, points);
+        }
+        break;
+      }
+      case WireOp::kDrawVertices: {
+        auto object =
+            get_object(reader.Get<uint32_t>(), ObjectType::kVertices, &ok);
+        auto mode = reader.GetEnum(SkBlendMode::kLastMode);
+        if (object && object->vertices) {
+          dispatcher.drawVertices(object->vertices, mode);
+        }
+        break;
+      }
+      case WireOp::kDrawImage: {
+        auto image = get_image(reader.Get<uint32_t>(), &ok);
+        auto point = reader.Get<SkPoint>();
+        auto sampling = reader.GetSampling();
+        auto with_attributes = reader.Get<bool>();
+        if (image) {
+          dispatcher.drawImage(image, point, sampling, with_attributes);
+        }
+        break;
+      }
+      case WireOp::kDrawImageRect: {
+        auto image = get_image(reader.Get<uint32_t>(), &ok);
+        auto src = reader.Get<SkRect>();
+        auto dst = reader.Get<SkRect>();
+        auto sampling = reader.GetSampling();
+        auto with_attributes = reader.Get<bool>();
+        auto constraint = reader.GetEnum(SkCanvas::kFast_SrcRectConstraint);
+        if (image) {
+          dispatcher.drawImageRect(image, src, dst, sampling, with_attributes,
+                                   constraint);
+        }
+        break;
+      }
+      case WireOp::kDrawImageNine: {
+        auto image = get_image(reader.Get<uint32_t>(), &ok);
+        auto center = reader.Get<SkIRect>();
+        auto dst = reader.Get<SkRect>();
+        auto filter = reader.GetEnum(SkFilterMode::kLast);
+        auto with_attributes = reader.Get<bool>();
+        if (image) {
+          dispatcher.drawImageNine(image, center, dst, filter,
+                                   with_attributes);
+        }
+        break;
+      }
+      case WireOp::kDrawImageLattice: {
+        auto image = get_image(reader.Get<uint32_t>(), &ok);
+        auto dst = reader.Get<SkRect>();
+        auto filter = reader.GetEnum(SkFilterMode::kLast);
+        auto with_attributes = reader.Get<bool>();
+        auto x_count = reader.Get<uint32_t>();
+        auto y_count = reader.Get<uint32_t>();
+        auto has_rect_types = reader.Get<bool>();
+        auto has_bounds = reader.Get<bool>();
+        auto has_colors = reader.Get<bool>();
+        if (x_count > (1u << 14) || y_count > (1u << 14)) {
+          ok = false;
+          break;
+        }
+        uint32_t cell_count = (x_count + 1) * (y_count + 1);
+        SkCanvas::Lattice lattice = {};
+        lattice.fXDivs = reader.GetArray<int>(x_count);
+        lattice.fYDivs = reader.GetArray<int>(y_count);
+        lattice.fXCount = x_count;
+        lattice.fYCount = y_count;
+        if (has_rect_types) {
+          lattice.fRectTypes =
+              reader.GetArray<SkCanvas::Lattice::RectType>(cell_count);
+        }
+        SkIRect bounds;
+        if (has_bounds) {
+          bounds = reader.Get<SkIRect>();
+          lattice.fBounds = &bounds;
+        }
+        if (has_colors) {
+          lattice.fColors = reader.GetArray<SkColor>(cell_count);
+        }
+        if (image && reader.ok()) {
+          dispatcher.drawImageLattice(image, lattice, dst, filter,
+                                      with_attributes);
+        }
+        break;
+      }
+      case WireOp::kDrawAtlas: {
+        auto atlas = get_image(reader.Get<uint32_t>(), &ok);
+        auto count = reader.Get<uint32_t>();
+        auto mode = reader.GetEnum(SkBlendMode::kLastMode);
+        auto sampling = reader.GetSampling();
+        auto with_attributes = reader.Get<bool>();
+        auto has_colors = reader.Get<bool>();
+        auto has_cull_rect = reader.Get<bool>();
+        SkRect cull_rect;
+        if (has_cull_rect) {
+          cull_rect = reader.Get<SkRect>();
+        }
+        auto xform = reader.GetArray<SkRSXform>(count);
+        auto tex = reader.GetArray<SkRect>(count);
+        auto colors = has_colors ? reader.GetArray<SkColor>(count) : nullptr;
+        if (atlas && reader.ok()) {
+          dispatcher.drawAtlas(atlas, xform, tex, colors, count, mode,
+                               sampling, has_cull_rect ? &cull_rect : nullptr,
+                               with_attributes);
+        }
+        break;
+      }
+      case WireOp::kDrawPicture: {
+        auto ref = get_ref(reader.Get<uint32_t>(), ObjectType::kPicture, &ok);
+        auto has_matrix = reader.Get<bool>();
+        auto values = reader.GetArray<SkScalar>(9);
+        auto with_attributes = reader.Get<bool>();
+        if (ref && values) {
+          SkMatrix matrix;
+          matrix.set9(values);
+          dispatcher.drawPicture(
+              sk_sp<SkPicture>(static_cast<SkPicture*>(ref.release())),
+              has_matrix ? &matrix : nullptr, with_attributes);
+        }
+        break;
+      }
+      case WireOp::kDrawDisplayList: {
+        auto ref =
+            get_ref(reader.Get<uint32_t>(), ObjectType::kDisplayList, &ok);
+        if (ref) {
+          dispatcher.drawDisplayList(
+              sk_sp<DisplayList>(static_cast<DisplayList*>(ref.release())));
+        }
+        break;
+      }
+      case WireOp::kDrawTextBlob: {
+        auto object =
+            get_object(reader.Get<uint32_t>(), ObjectType::kTextBlob, &ok);
+        auto x = reader.Get<SkScalar>();
+        auto y = reader.Get<SkScalar>();
+        if (object && object->blob) {
+          dispatcher.drawTextBlob(object->blob, x, y);
+        }
+        break;
+      }
+      case WireOp::kDrawShadow: {
+        auto path = get_path(reader.Get<uint32_t>(), &ok);
+        auto color = reader.Get<SkColor>();
+        auto elevation = reader.Get<SkScalar>();
+        auto transparent_occluder = reader.Get<bool>();
+        auto dpr = reader.Get<SkScalar>();
+        if (path) {
+          dispatcher.drawShadow(*path, color, elevation, transparent_occluder,
+                                dpr);
+        }
+        break;
+      }
+
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok || !reader.ok()) {
+      FML_LOG(ERROR) << "Malformed op in serialized DisplayList";
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace flutter
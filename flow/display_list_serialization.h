@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_SERIALIZATION_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_SERIALIZATION_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/macros.h"
+
+#include "third_party/skia/include/core/SkData.h"
+
+// A versioned binary format for capturing a DisplayList and replaying it
+// later, possibly in another process:
+//
+// SerializeDisplayList:
+//     Writes a DisplayList into a self-contained blob of data.
+// SerializedDisplayList:
+//     Reads a blob written by SerializeDisplayList from an fml::Mapping
+//     (such as a memory mapped file) and dispatches its operations
+//     directly from the mapped data.
+//
+// The blob is laid out as a header, followed by the stream of
+// operations, followed by a table of the objects (paths, images,
+// shaders, filters, text blobs, pictures and nested display lists)
+// referenced by the operations. All sections are 4 byte aligned so
+// that arrays of points, colors and transforms within the operations
+// can be handed to the Dispatcher without copying them. The objects
+// are encoded using the Skia serialization for each type.
+
+namespace flutter {
+
+// Returns the serialized form of the |display_list|.
+sk_sp<SkData> SerializeDisplayList(const DisplayList& display_list);
+
+class SerializedDisplayList {
+ public:
+  // The version of the format written by SerializeDisplayList. Blobs
+  // with any other version are rejected by |Make|.
+  static constexpr uint32_t kVersion = 1;
+
+  // Validates the header and decodes the object table of the serialized
+  // data in the |mapping|. Returns nullptr if the data is not a valid
+  // serialized DisplayList of the current version.
+  static std::unique_ptr<SerializedDisplayList> Make(
+      std::unique_ptr<fml::Mapping> mapping);
+
+  ~SerializedDisplayList();
+
+  // Dispatches the serialized operations to the |dispatcher|. Returns
+  // false if the operation stream is malformed, in which case dispatch
+  // stops after the malformed op. Operations that refer to an object which
+  // could not be decoded (such as a texture backed image that could not
+  // be read back when it was serialized) are skipped.
+  bool Dispatch(Dispatcher& dispatcher) const;
+
+  // Replays the operations into a new DisplayList.
+  sk_sp<DisplayList> Build() const;
+
+  const SkRect& bounds() const { return bounds_; }
+  int op_count() const { return op_count_; }
+
+ private:
+  SerializedDisplayList(std::unique_ptr<fml::Mapping> mapping);
+
+  bool DecodeObjects(const uint8_t* ptr, const uint8_t* end);
+
+  std::unique_ptr<fml::Mapping> mapping_;
+  SkRect bounds_;
+  int op_count_ = 0;
+  const uint8_t* ops_ = nullptr;
+  const uint8_t* ops_end_ = nullptr;
+
+  // Decoded objects, indexed by the object ids in the operation stream.
+  // Only one of the members is set, according to the type of the object.
+  struct Object;
+  std::vector<Object> objects_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SerializedDisplayList);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_SERIALIZATION_H_
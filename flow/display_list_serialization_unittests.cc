@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_serialization.h"
+
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::unique_ptr<SerializedDisplayList> RoundTrip(
+    const DisplayList& display_list) {
+  sk_sp<SkData> data = SerializeDisplayList(display_list);
+  EXPECT_NE(data, nullptr);
+  std::vector<uint8_t> bytes(data->bytes(), data->bytes() + data->size());
+  return SerializedDisplayList::Make(
+      std::make_unique<fml::DataMapping>(std::move(bytes)));
+}
+
+static sk_sp<SkImage> MakeTestImage() {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(10, 10);
+  surface->getCanvas()->clear(SK_ColorBLUE);
+  return surface->makeImageSnapshot();
+}
+
+TEST(DisplayListSerialization, RoundTripIsEqual) {
+  SkPoint points[] = {{10, 10}, {20, 20}, {30, 10}};
+  DisplayListBuilder builder;
+  builder.setAntiAlias(true);
+  builder.setColor(SK_ColorRED);
+  builder.setStyle(SkPaint::kStroke_Style);
+  builder.setStrokeWidth(2.0);
+  builder.save();
+  builder.translate(5, 5);
+  builder.clipRRect(SkRRect::MakeRectXY({0, 0, 50, 50}, 5, 5),
+                    SkClipOp::kIntersect, true);
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawPath(SkPath::Circle(20, 20, 10));
+  builder.drawPoints(SkCanvas::kPolygon_PointMode, 3, points);
+  builder.restore();
+  builder.saveLayer(nullptr, true);
+  builder.drawDRRect(SkRRect::MakeOval({0, 0, 40, 40}),
+                     SkRRect::MakeOval({10, 10, 30, 30}));
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  auto serialized = RoundTrip(*display_list);
+  ASSERT_NE(serialized, nullptr);
+  ASSERT_EQ(serialized->bounds(), display_list->bounds());
+  ASSERT_EQ(serialized->op_count(), display_list->op_count());
+
+  sk_sp<DisplayList> copy = serialized->Build();
+  ASSERT_EQ(copy->bytes(), display_list->bytes());
+  ASSERT_TRUE(copy->Equals(*display_list));
+}
+
+TEST(DisplayListSerialization, RoundTripOfObjects) {
+  SkPoint end_points[] = {{0, 0}, {100, 100}};
+  SkColor colors[] = {SK_ColorGREEN, SK_ColorBLUE};
+  sk_sp<SkShader> shader = SkGradientShader::MakeLinear(
+      end_points, colors, nullptr, 2, SkTileMode::kClamp);
+  sk_sp<SkImage> image = MakeTestImage();
+
+  DisplayListBuilder nested_builder;
+  nested_builder.drawRect({0, 0, 10, 10});
+  nested_builder.drawOval({10, 10, 20, 20});
+  sk_sp<DisplayList> nested = nested_builder.Build();
+
+  DisplayListBuilder builder;
+  builder.setShader(shader);
+  builder.drawPaint();
+  builder.setShader(nullptr);
+  builder.drawImage(image, {10, 10}, DisplayList::LinearSampling, true);
+  builder.drawImageRect(image, {0, 0, 5, 5}, {20, 20, 40, 40},
+                        DisplayList::NearestSampling, false,
+                        SkCanvas::kFast_SrcRectConstraint);
+  builder.drawDisplayList(nested);
+  builder.drawDisplayList(nested);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  auto serialized = RoundTrip(*display_list);
+  ASSERT_NE(serialized, nullptr);
+  sk_sp<DisplayList> copy = serialized->Build();
+
+  // The objects are new instances, so the lists are not Equals
+  ASSERT_EQ(copy->op_count(false), display_list->op_count(false));
+  ASSERT_EQ(copy->op_count(true), display_list->op_count(true));
+  ASSERT_EQ(copy->bytes(), display_list->bytes());
+  ASSERT_EQ(copy->bounds(), display_list->bounds());
+}
+
+TEST(DisplayListSerialization, RejectsInvalidData) {
+  ASSERT_EQ(SerializedDisplayList::Make(nullptr), nullptr);
+
+  std::vector<uint8_t> garbage(100, 0x5a);
+  ASSERT_EQ(SerializedDisplayList::Make(
+                std::make_unique<fml::DataMapping>(std::move(garbage))),
+            nullptr);
+
+  DisplayListBuilder builder;
+  builder.drawRect({10, 10, 20, 20});
+  sk_sp<SkData> data = SerializeDisplayList(*builder.Build());
+  std::vector<uint8_t> truncated(data->bytes(),
+                                 data->bytes() + data->size() - 4);
+  ASSERT_EQ(SerializedDisplayList::Make(
+                std::make_unique<fml::DataMapping>(std::move(truncated))),
+            nullptr);
+
+  // The enums are only read when the ops are dispatched. Two lists that
+  // differ only in their blend mode locate it in the serialized bytes.
+  auto serialize_blend_mode = [](SkBlendMode mode) {
+    DisplayListBuilder builder;
+    builder.setBlendMode(mode);
+    builder.drawRect({10, 10, 20, 20});
+    sk_sp<SkData> data = SerializeDisplayList(*builder.Build());
+    return std::vector<uint8_t>(data->bytes(), data->bytes() + data->size());
+  };
+  std::vector<uint8_t> bytes = serialize_blend_mode(SkBlendMode::kColor);
+  std::vector<uint8_t> other = serialize_blend_mode(SkBlendMode::kLuminosity);
+  ASSERT_EQ(bytes.size(), other.size());
+  size_t offset = 0;
+  while (offset < bytes.size() && bytes[offset] == other[offset]) {
+    offset++;
+  }
+  ASSERT_LT(offset, bytes.size());
+  uint32_t mode = static_cast<uint32_t>(SkBlendMode::kLastMode) + 1;
+  memcpy(bytes.data() + offset, &mode, sizeof(mode));
+  auto serialized = SerializedDisplayList::Make(
+      std::make_unique<fml::DataMapping>(std::move(bytes)));
+  ASSERT_NE(serialized, nullptr);
+  DisplayListBuilder copy;
+  ASSERT_FALSE(serialized->Dispatch(copy));
+}
+
+TEST(DisplayListSerialization, RejectsOtherVersions) {
+  DisplayListBuilder builder;
+  builder.drawRect({10, 10, 20, 20});
+  sk_sp<SkData> data = SerializeDisplayList(*builder.Build());
+  std::vector<uint8_t> bytes(data->bytes(), data->bytes() + data->size());
+  // The version follows the 4 byte magic number
+  uint32_t version = SerializedDisplayList::kVersion + 1;
+  memcpy(bytes.data() + 4, &version, sizeof(version));
+  ASSERT_EQ(SerializedDisplayList::Make(
+                std::make_unique<fml::DataMapping>(std::move(bytes))),
+            nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
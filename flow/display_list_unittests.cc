@@ -272,45 +272,47 @@ struct DisplayListInvocationGroup {
 
 std::vector<DisplayListInvocationGroup> allGroups = {
   { "SetAntiAlias", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setAntiAlias(false);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setAntiAlias(true);}},
+      // Setting an attribute to its current (default) value is ignored
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setAntiAlias(false);}},
     }
   },
   { "SetDither", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setDither(false);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setDither(true);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setDither(false);}},
     }
   },
   { "SetInvertColors", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setInvertColors(false);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setInvertColors(true);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setInvertColors(false);}},
     }
   },
   { "SetStrokeCap", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeCap(SkPaint::kButt_Cap);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeCap(SkPaint::kRound_Cap);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeCap(SkPaint::kSquare_Cap);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setStrokeCap(SkPaint::kButt_Cap);}},
     }
   },
   { "SetStrokeJoin", {
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeJoin(SkPaint::kBevel_Join);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeJoin(SkPaint::kRound_Join);}},
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeJoin(SkPaint::kMiter_Join);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setStrokeJoin(SkPaint::kMiter_Join);}},
     }
   },
   { "SetStyle", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStyle(SkPaint::kFill_Style);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStyle(SkPaint::kStroke_Style);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setStyle(SkPaint::kFill_Style);}},
     }
   },
   { "SetStrokeWidth", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeWidth(0.0);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeWidth(5.0);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setStrokeWidth(0.0);}},
     }
   },
   { "SetStrokeMiter", {
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeMiter(0.0);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setStrokeMiter(5.0);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setStrokeMiter(4.0);}},
     }
   },
   { "SetColor", {
@@ -318,41 +320,40 @@ std::vector<DisplayListInvocationGroup> allGroups = {
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setColor(SK_ColorBLUE);}},
     }
   },
-  { "SetBlendMode", {
+  // Blend modes and blenders share the same underlying attribute so
+  // they are tested as a single group
+  { "SetBlendModeOrBlender", {
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setBlendMode(SkBlendMode::kSrcIn);}},
       {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setBlendMode(SkBlendMode::kDstIn);}},
-    }
-  },
-  { "SetBlender", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setBlender(nullptr);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setBlender(TestBlender1);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setBlender(TestBlender2);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setBlender(TestBlender3);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setBlender(nullptr);}},
     }
   },
   { "SetShader", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setShader(nullptr);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setShader(TestShader1);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setShader(TestShader2);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setShader(TestShader3);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setShader(nullptr);}},
     }
   },
   { "SetImageFilter", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setImageFilter(nullptr);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setImageFilter(TestImageFilter1);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setImageFilter(TestImageFilter2);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setImageFilter(nullptr);}},
     }
   },
   { "SetColorFilter", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setColorFilter(nullptr);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setColorFilter(TestColorFilter1);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setColorFilter(TestColorFilter2);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setColorFilter(nullptr);}},
     }
   },
   { "SetPathEffect", {
-      {0, 8, 0, 0, [](DisplayListBuilder& b) {b.setPathEffect(nullptr);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setPathEffect(TestPathEffect1);}},
       {0, 16, 0, 0, [](DisplayListBuilder& b) {b.setPathEffect(TestPathEffect2);}},
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.setPathEffect(nullptr);}},
     }
   },
   { "SetMaskFilter", {
@@ -366,43 +367,74 @@ std::vector<DisplayListInvocationGroup> allGroups = {
     }
   },
   { "Save(Layer)+Restore", {
-      // cv.save/restore are ignored if there are no draw calls between them
-      {2, 16, 0, 0, [](DisplayListBuilder& b) {b.save(); b.restore();}},
-      {2, 16, 2, 16, [](DisplayListBuilder& b) {b.saveLayer(nullptr, false); b.restore(); }},
+      {4, 64, 4, 64, [](DisplayListBuilder& b) {
+        b.save();
+        b.clipRect({0, 0, 25, 25}, SkClipOp::kIntersect, true);
+        b.drawRect({5, 5, 15, 15});
+        b.restore();
+      }},
+      {4, 64, 4, 64, [](DisplayListBuilder& b) {
+        b.saveLayer(nullptr, false);
+        b.clipRect({0, 0, 25, 25}, SkClipOp::kIntersect, true);
+        b.drawRect({5, 5, 15, 15});
+        b.restore();
+      }},
+      {4, 64, 4, 64, [](DisplayListBuilder& b) {
+        b.saveLayer(nullptr, true);
+        b.clipRect({0, 0, 25, 25}, SkClipOp::kIntersect, true);
+        b.drawRect({5, 5, 15, 15});
+        b.restore();
+      }},
+      {4, 80, 4, 80, [](DisplayListBuilder& b) {
+        b.saveLayer(&TestBounds, false);
+        b.clipRect({0, 0, 25, 25}, SkClipOp::kIntersect, true);
+        b.drawRect({5, 5, 15, 15});
+        b.restore();
+      }},
+      {4, 80, 4, 80, [](DisplayListBuilder& b) {
+        b.saveLayer(&TestBounds, true);
+        b.clipRect({0, 0, 25, 25}, SkClipOp::kIntersect, true);
+        b.drawRect({5, 5, 15, 15});
+        b.restore();
+      }},
+      // A saveLayer with attributes is kept even if it is empty
       {2, 16, 2, 16, [](DisplayListBuilder& b) {b.saveLayer(nullptr, true); b.restore(); }},
-      {2, 32, 2, 32, [](DisplayListBuilder& b) {b.saveLayer(&TestBounds, false); b.restore(); }},
-      {2, 32, 2, 32, [](DisplayListBuilder& b) {b.saveLayer(&TestBounds, true); b.restore(); }},
+      // save/restore (and saveLayer without attributes) are ignored if there
+      // are no calls between them
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.save(); b.restore();}},
     }
   },
   { "Translate", {
-      // cv.translate(0, 0) is ignored
-      {1, 16, 0, 0, [](DisplayListBuilder& b) {b.translate(0, 0);}},
       {1, 16, 1, 16, [](DisplayListBuilder& b) {b.translate(10, 10);}},
       {1, 16, 1, 16, [](DisplayListBuilder& b) {b.translate(10, 15);}},
       {1, 16, 1, 16, [](DisplayListBuilder& b) {b.translate(15, 10);}},
+      // translate(0, 0) is ignored
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.translate(0, 0);}},
     }
   },
   { "Scale", {
-      // cv.scale(1, 1) is ignored
-      {1, 16, 0, 0, [](DisplayListBuilder& b) {b.scale(1, 1);}},
       {1, 16, 1, 16, [](DisplayListBuilder& b) {b.scale(2, 2);}},
       {1, 16, 1, 16, [](DisplayListBuilder& b) {b.scale(2, 3);}},
       {1, 16, 1, 16, [](DisplayListBuilder& b) {b.scale(3, 2);}},
+      // scale(1, 1) is ignored
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.scale(1, 1);}},
     }
   },
   { "Rotate", {
-      // cv.rotate(0) is ignored, otherwise expressed as concat(rotmatrix)
-      {1, 8, 0, 0, [](DisplayListBuilder& b) {b.rotate(0);}},
+      // cv.rotate is expressed as concat(rotmatrix)
       {1, 8, 1, 32, [](DisplayListBuilder& b) {b.rotate(30);}},
       {1, 8, 1, 32, [](DisplayListBuilder& b) {b.rotate(45);}},
+      // rotate(0) is ignored
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.rotate(0);}},
     }
   },
   { "Skew", {
-      // cv.skew(0, 0) is ignored, otherwise expressed as concat(skewmatrix)
-      {1, 16, 0, 0, [](DisplayListBuilder& b) {b.skew(0, 0);}},
+      // cv.skew is expressed as concat(skewmatrix)
       {1, 16, 1, 32, [](DisplayListBuilder& b) {b.skew(0.1, 0.1);}},
       {1, 16, 1, 32, [](DisplayListBuilder& b) {b.skew(0.1, 0.2);}},
       {1, 16, 1, 32, [](DisplayListBuilder& b) {b.skew(0.2, 0.1);}},
+      // skew(0, 0) is ignored
+      {0, 0, 0, 0, [](DisplayListBuilder& b) {b.skew(0, 0);}},
     }
   },
   { "Transform2DAffine", {
@@ -1117,5 +1149,328 @@ TEST(DisplayList, NestedOpCountMetricsSameAsSkPicture) {
   ASSERT_EQ(display_list->op_count(true), 36);
 }
 
+TEST(DisplayList, RedundantAttributesAndSavesAreNotRecorded) {
+  DisplayListBuilder expected_builder;
+  expected_builder.setColor(SK_ColorRED);
+  expected_builder.setShader(TestShader1);
+  expected_builder.drawRect({0, 0, 10, 10});
+  expected_builder.drawRect({10, 10, 20, 20});
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  DisplayListBuilder builder;
+  builder.setAntiAlias(false);
+  builder.setColor(SK_ColorRED);
+  builder.setColor(SK_ColorRED);
+  builder.setShader(TestShader1);
+  builder.setShader(TestShader1);
+  builder.drawRect({0, 0, 10, 10});
+  builder.save();
+  builder.translate(0, 0);
+  builder.restore();
+  builder.saveLayer(nullptr, false);
+  builder.restore();
+  builder.setColor(SK_ColorRED);
+  builder.drawRect({10, 10, 20, 20});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  ASSERT_EQ(display_list->op_count(), expected->op_count());
+  ASSERT_EQ(display_list->bytes(), expected->bytes());
+  ASSERT_TRUE(display_list->Equals(*expected));
+}
+
+TEST(DisplayList, SaveLayerWithAttributesIsRecorded) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorRED);
+  builder.saveLayer(nullptr, true);
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_EQ(display_list->op_count(), 2);
+}
+
+TEST(DisplayList, CulledDispatchWithRTree) {
+  SkRect cull_rect = SkRect::MakeWH(200, 200);
+  auto build = [&cull_rect](bool prepare_rtree) {
+    DisplayListBuilder builder(cull_rect, prepare_rtree);
+    for (int y = 0; y < 10; y++) {
+      for (int x = 0; x < 10; x++) {
+        builder.setColor(((x + y) % 2) == 0 ? SK_ColorRED : SK_ColorBLUE);
+        builder.drawRect(SkRect::MakeXYWH(x * 20, y * 20, 10, 10));
+      }
+    }
+    return builder.Build();
+  };
+  sk_sp<DisplayList> plain_list = build(false);
+  sk_sp<DisplayList> rtree_list = build(true);
+  ASSERT_FALSE(plain_list->has_rtree());
+  ASSERT_TRUE(rtree_list->has_rtree());
+  ASSERT_EQ(plain_list->bounds(), rtree_list->bounds());
+  ASSERT_TRUE(plain_list->Equals(*rtree_list));
+
+  SkRect query = SkRect::MakeLTRB(0, 0, 15, 15);
+  {
+    DisplayListBuilder builder(cull_rect);
+    plain_list->Dispatch(builder, query);
+    ASSERT_EQ(builder.Build()->op_count(), 100);
+  }
+  {
+    DisplayListBuilder builder(cull_rect);
+    rtree_list->Dispatch(builder, query);
+    ASSERT_EQ(builder.Build()->op_count(), 1);
+  }
+  {
+    // A cull rect containing the bounds dispatches everything
+    DisplayListBuilder builder(cull_rect);
+    rtree_list->Dispatch(builder, cull_rect);
+    ASSERT_EQ(builder.Build()->op_count(), 100);
+  }
+  {
+    // An area between the rects dispatches nothing
+    DisplayListBuilder builder(cull_rect);
+    rtree_list->Dispatch(builder, SkRect::MakeLTRB(11, 11, 19, 19));
+    ASSERT_EQ(builder.Build()->op_count(), 0);
+  }
+}
+
+TEST(DisplayList, CulledDispatchSkipsEntireSaveLayer) {
+  SkRect cull_rect = SkRect::MakeWH(200, 200);
+  DisplayListBuilder builder(cull_rect, true);
+  builder.save();
+  builder.translate(100, 100);
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  builder.restore();
+  builder.saveLayer(nullptr, false);
+  builder.drawRect(SkRect::MakeXYWH(150, 150, 10, 10));
+  builder.drawRect(SkRect::MakeXYWH(180, 180, 10, 10));
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_TRUE(display_list->has_rtree());
+  ASSERT_EQ(display_list->bounds(), SkRect::MakeLTRB(100, 100, 190, 190));
+
+  {
+    // Only the translated rect, along with its save/translate/restore
+    DisplayListBuilder recorder(cull_rect);
+    display_list->Dispatch(recorder, SkRect::MakeLTRB(100, 100, 110, 110));
+    ASSERT_EQ(recorder.Build()->op_count(), 4);
+  }
+  {
+    // The entire saveLayer is dispatched for any overlap with its contents
+    // (save, translate, restore, saveLayer, 2 x drawRect, restore)
+    DisplayListBuilder recorder(cull_rect);
+    display_list->Dispatch(recorder, SkRect::MakeLTRB(185, 185, 190, 190));
+    ASSERT_EQ(recorder.Build()->op_count(), 7);
+  }
+}
+
+TEST(DisplayList, BoundsAndComplexityComputedAtBuild) {
+  DisplayListBuilder builder;
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawRect({30, 30, 40, 40});
+  sk_sp<DisplayList> display_list = builder.Build();
+  const DisplayList* const_list = display_list.get();
+
+  ASSERT_EQ(const_list->bounds(), SkRect::MakeLTRB(10, 10, 40, 40));
+  ASSERT_EQ(const_list->complexity_score(), 2u);
+}
+
+TEST(DisplayList, ComplexityScoreWeighsOpsAndIncludesNestedLists) {
+  DisplayListBuilder inner_builder;
+  inner_builder.drawPath(TestPath1);
+  inner_builder.drawRect({10, 10, 20, 20});
+  sk_sp<DisplayList> inner = inner_builder.Build();
+  ASSERT_GT(inner->complexity_score(), 2u);
+
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorRED);
+  builder.translate(10, 10);
+  builder.drawDisplayList(inner);
+  builder.drawRect({10, 10, 20, 20});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  ASSERT_EQ(display_list->complexity_score(), inner->complexity_score() + 1);
+}
+
+TEST(DisplayList, ContentHashMatchesEquals) {
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> dl = group.variants[i].Build();
+      DisplayListBuilder builder;
+      dl->Dispatch(builder);
+      sk_sp<DisplayList> copy = builder.Build();
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + ")";
+      ASSERT_EQ(copy->content_hash(), dl->content_hash()) << desc;
+      for (size_t j = i + 1; j < group.variants.size(); j++) {
+        sk_sp<DisplayList> other = group.variants[j].Build();
+        ASSERT_NE(other->content_hash(), dl->content_hash())
+            << desc << " != variant " << (j + 1);
+      }
+    }
+  }
+}
+
+TEST(DisplayList, ContentHashUsesPathContents) {
+  SkPath path1 = SkPath::Rect({10, 10, 20, 20});
+  SkPath path2 = SkPath::Rect({10, 10, 20, 20});
+  SkPath path3 = SkPath::Rect({10, 10, 20, 30});
+
+  DisplayListBuilder builder1;
+  builder1.drawPath(path1);
+  DisplayListBuilder builder2;
+  builder2.drawPath(path2);
+  DisplayListBuilder builder3;
+  builder3.drawPath(path3);
+  sk_sp<DisplayList> dl1 = builder1.Build();
+  sk_sp<DisplayList> dl2 = builder2.Build();
+  sk_sp<DisplayList> dl3 = builder3.Build();
+
+  ASSERT_EQ(dl1->content_hash(), dl2->content_hash());
+  ASSERT_TRUE(dl1->Equals(*dl2));
+  ASSERT_NE(dl1->content_hash(), dl3->content_hash());
+  ASSERT_FALSE(dl1->Equals(*dl3));
+}
+
+TEST(DisplayList, StorageIsRecycledThroughPool) {
+  DisplayListStoragePool& pool = DisplayListStoragePool::Instance();
+  pool.Clear();
+  auto build = []() {
+    DisplayListBuilder builder;
+    for (int i = 0; i < 500; i++) {
+      builder.drawRect({0, 0, 10.0f + i, 10});
+    }
+    return builder.Build();
+  };
+
+  sk_sp<DisplayList> display_list = build();
+  ASSERT_EQ(pool.pooled_buffer_count(), 0u);
+  display_list.reset();
+  ASSERT_EQ(pool.pooled_buffer_count(), 1u);
+  size_t pooled_bytes = pool.pooled_bytes();
+  ASSERT_GE(pooled_bytes, 500 * sizeof(SkRect));
+
+  // The next list of the same size takes over the pooled storage
+  display_list = build();
+  ASSERT_EQ(pool.pooled_buffer_count(), 0u);
+  display_list.reset();
+  ASSERT_EQ(pool.pooled_buffer_count(), 1u);
+  ASSERT_EQ(pool.pooled_bytes(), pooled_bytes);
+
+  pool.Clear();
+  ASSERT_EQ(pool.pooled_buffer_count(), 0u);
+  ASSERT_EQ(pool.pooled_bytes(), 0u);
+}
+
+TEST(DisplayList, StoragePoolIsBounded) {
+  DisplayListStoragePool& pool = DisplayListStoragePool::Instance();
+  pool.Clear();
+
+  // Buffers that are too small are not worth pooling
+  pool.Release(static_cast<uint8_t*>(sk_malloc_throw(16)), 16);
+  ASSERT_EQ(pool.pooled_buffer_count(), 0u);
+
+  size_t size = DisplayListStoragePool::kMinPooledBytes;
+  for (size_t i = 0; i < DisplayListStoragePool::kMaxPooledBuffers + 4; i++) {
+    pool.Release(static_cast<uint8_t*>(sk_malloc_throw(size)), size);
+  }
+  ASSERT_EQ(pool.pooled_buffer_count(),
+            DisplayListStoragePool::kMaxPooledBuffers);
+
+  size_t allocated = 0;
+  ASSERT_EQ(pool.Acquire(size + 1, &allocated), nullptr);
+  uint8_t* buffer = pool.Acquire(size, &allocated);
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_EQ(allocated, size);
+  sk_free(buffer);
+
+  pool.Clear();
+}
+
+TEST(DisplayList, GroupOpacityWithNonOverlappingOps) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawOval({20, 20, 30, 30});
+  builder.drawCircle({50, 50}, 5);
+  ASSERT_TRUE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NoGroupOpacityWithOverlappingOps) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({5, 5, 15, 15});
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NoGroupOpacityWithSaveLayer) {
+  DisplayListBuilder builder;
+  builder.saveLayer(nullptr, false);
+  builder.drawRect({0, 0, 10, 10});
+  builder.restore();
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NoGroupOpacityWithBlendMode) {
+  DisplayListBuilder builder;
+  builder.setBlendMode(SkBlendMode::kSrc);
+  builder.drawRect({0, 0, 10, 10});
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+
+  // Ops drawn after returning to SrcOver are compatible again
+  DisplayListBuilder builder2;
+  builder2.setBlendMode(SkBlendMode::kSrc);
+  builder2.setBlendMode(SkBlendMode::kSrcOver);
+  builder2.drawRect({0, 0, 10, 10});
+  ASSERT_TRUE(builder2.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, OpaqueBoundsOfOpaqueFills) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({20, 20, 50, 50});
+  builder.setColor(SK_ColorTRANSPARENT);
+  builder.drawRect({0, 0, 100, 100});
+  ASSERT_EQ(builder.Build()->opaque_bounds(), SkRect::MakeLTRB(20, 20, 50, 50));
+
+  DisplayListBuilder color_builder(SkRect::MakeWH(100, 100));
+  color_builder.drawColor(SK_ColorBLUE, SkBlendMode::kSrc);
+  ASSERT_EQ(color_builder.Build()->opaque_bounds(), SkRect::MakeWH(100, 100));
+}
+
+TEST(DisplayList, NoOpaqueBoundsForTransformedOrTranslucentFills) {
+  DisplayListBuilder translucent_builder;
+  translucent_builder.setColor(0x80ff0000);
+  translucent_builder.drawRect({0, 0, 10, 10});
+  ASSERT_TRUE(translucent_builder.Build()->opaque_bounds().isEmpty());
+
+  DisplayListBuilder transform_builder;
+  transform_builder.save();
+  transform_builder.rotate(45);
+  transform_builder.drawRect({0, 0, 10, 10});
+  transform_builder.restore();
+  ASSERT_TRUE(transform_builder.Build()->opaque_bounds().isEmpty());
+
+  // Fills after the transform has been restored count again
+  DisplayListBuilder restore_builder;
+  restore_builder.save();
+  restore_builder.rotate(45);
+  restore_builder.restore();
+  restore_builder.drawRect({0, 0, 10, 10});
+  ASSERT_EQ(restore_builder.Build()->opaque_bounds(), SkRect::MakeWH(10, 10));
+}
+
+TEST(DisplayList, NoOpaqueBoundsWhenLaterOpsErase) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.setBlendMode(SkBlendMode::kClear);
+  builder.drawRect({2, 2, 4, 4});
+  ASSERT_TRUE(builder.Build()->opaque_bounds().isEmpty());
+
+  // Erasing within a layer only affects the layer
+  DisplayListBuilder layer_builder;
+  layer_builder.drawRect({0, 0, 10, 10});
+  layer_builder.saveLayer(nullptr, false);
+  layer_builder.setBlendMode(SkBlendMode::kClear);
+  layer_builder.drawRect({2, 2, 4, 4});
+  layer_builder.restore();
+  ASSERT_EQ(layer_builder.Build()->opaque_bounds(), SkRect::MakeWH(10, 10));
+}
+
 }  // namespace testing
 }  // namespace flutter
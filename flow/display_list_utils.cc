@@ -53,6 +53,9 @@ void SkPaintDispatchHelper::setStrokeMiter(SkScalar limit) {
 }
 void SkPaintDispatchHelper::setColor(SkColor color) {
   paint_.setColor(color);
+  if (opacity_ < SK_Scalar1) {
+    paint_.setAlphaf(paint_.getAlphaf() * opacity_);
+  }
 }
 void SkPaintDispatchHelper::setBlendMode(SkBlendMode mode) {
   paint_.setBlendMode(mode);
@@ -572,8 +575,14 @@ bool DisplayListBoundsCalculator::AdjustBoundsForPaint(SkRect& bounds,
 void DisplayListBoundsCalculator::AccumulateUnbounded() {
   if (has_clip()) {
     accumulator_->accumulate(clip_bounds());
+    if (is_root_accumulator()) {
+      root_op_accumulator_.accumulate(clip_bounds());
+    }
   } else {
     layer_infos_.back()->set_unbounded();
+    if (is_root_accumulator()) {
+      root_op_unbounded_ = true;
+    }
   }
 }
 void DisplayListBoundsCalculator::AccumulateRect(SkRect& rect, int flags) {
@@ -581,12 +590,31 @@ void DisplayListBoundsCalculator::AccumulateRect(SkRect& rect, int flags) {
     matrix().mapRect(&rect);
     if (!has_clip() || rect.intersect(clip_bounds())) {
       accumulator_->accumulate(rect);
+      if (is_root_accumulator()) {
+        root_op_accumulator_.accumulate(rect);
+      }
     }
   } else {
     AccumulateUnbounded();
   }
 }
 
+bool DisplayListBoundsCalculator::TakeRootOpBounds(SkRect* bounds) {
+  bool result;
+  if (root_op_unbounded_) {
+    *bounds = SkRect::MakeLargest();
+    result = true;
+  } else if (root_op_accumulator_.is_not_empty()) {
+    *bounds = root_op_accumulator_.bounds();
+    result = true;
+  } else {
+    result = false;
+  }
+  root_op_accumulator_ = BoundsAccumulator();
+  root_op_unbounded_ = false;
+  return result;
+}
+
 bool DisplayListBoundsCalculator::paint_nops_on_transparency() {
   // SkImageFilter::canComputeFastBounds tests for transparency behavior
   // This test assumes that the blend mode checked down below will
@@ -96,6 +96,14 @@ class IgnoreTransformDispatchHelper : public virtual Dispatcher {
 // which can be accessed at any time via paint().
 class SkPaintDispatchHelper : public virtual Dispatcher {
  public:
+  // The alpha of every color set on the paint is modulated by the
+  // |opacity|, see |DisplayList::can_apply_group_opacity|.
+  SkPaintDispatchHelper(SkScalar opacity = SK_Scalar1) : opacity_(opacity) {
+    if (opacity < SK_Scalar1) {
+      paint_.setAlphaf(opacity);
+    }
+  }
+
   void setAntiAlias(bool aa) override;
   void setDither(bool dither) override;
   void setStyle(SkPaint::Style style) override;
@@ -118,6 +126,7 @@ class SkPaintDispatchHelper : public virtual Dispatcher {
 
  private:
   SkPaint paint_;
+  const SkScalar opacity_;
   bool invert_colors_ = false;
   sk_sp<SkColorFilter> color_filter_;
 
@@ -379,10 +388,30 @@ class DisplayListBoundsCalculator final
     return accumulator_->bounds();
   }
 
+  // Returns true if any rendering was accumulated directly into the
+  // root layer since the last call to this method and stores the
+  // bounds of that rendering into |bounds|. An unbounded operation
+  // at the root layer reports the largest possible bounds.
+  //
+  // Calling this method after every dispatched op produces the bounds
+  // of each top-level rendering operation, where a top-level saveLayer
+  // reports the bounds of its entire contents on its matching restore.
+  // This is used to build a spatial index of the operations.
+  bool TakeRootOpBounds(SkRect* bounds);
+
  private:
   // current accumulator based on saveLayer history
   BoundsAccumulator* accumulator_;
 
+  // accumulates the rendering into the root layer since the last
+  // call to |TakeRootOpBounds|
+  BoundsAccumulator root_op_accumulator_;
+  bool root_op_unbounded_ = false;
+
+  bool is_root_accumulator() const {
+    return accumulator_ == layer_infos_.front()->layer_accumulator();
+  }
+
   // A class that abstracts the information kept for a single
   // |save| or |saveLayer|, including the root information that
   // is kept as a base set of information for the DisplayList
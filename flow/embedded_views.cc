@@ -4,6 +4,8 @@
 
 #include "flutter/flow/embedded_views.h"
 
+#include "flutter/fml/logging.h"
+
 namespace flutter {
 
 void ExternalViewEmbedder::SubmitFrame(GrDirectContext* context,
@@ -11,59 +13,106 @@ void ExternalViewEmbedder::SubmitFrame(GrDirectContext* context,
   frame->Submit();
 };
 
+const Mutator* MutatorsStack::ReverseIterator::operator*() const {
+  return &node_->mutator;
+}
+
+MutatorsStack::ReverseIterator& MutatorsStack::ReverseIterator::operator++() {
+  node_ = node_->next.get();
+  return *this;
+}
+
+const Mutator* MutatorsStack::Iterator::operator*() const {
+  const Node* node = bottom_;
+  while (node->depth > index_ + 1) {
+    node = node->next.get();
+  }
+  return &node->mutator;
+}
+
+template <typename T>
+void MutatorsStack::Push(const T& mutation) {
+  bottom_ = std::make_shared<const Node>(mutation, std::move(bottom_));
+}
+
 void MutatorsStack::PushClipRect(const SkRect& rect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rect);
-  vector_.push_back(element);
+  Push(rect);
 };
 
 void MutatorsStack::PushClipRRect(const SkRRect& rrect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rrect);
-  vector_.push_back(element);
+  Push(rrect);
 };
 
 void MutatorsStack::PushClipPath(const SkPath& path) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(path);
-  vector_.push_back(element);
+  Push(path);
 };
 
 void MutatorsStack::PushTransform(const SkMatrix& matrix) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(matrix);
-  vector_.push_back(element);
+  Push(matrix);
 };
 
 void MutatorsStack::PushOpacity(const int& alpha) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(alpha);
-  vector_.push_back(element);
+  Push(alpha);
 };
 
 void MutatorsStack::Pop() {
-  vector_.pop_back();
+  FML_DCHECK(bottom_);
+  bottom_ = bottom_->next;
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Top() const {
-  return vector_.rend();
+MutatorsStack::ReverseIterator MutatorsStack::Top() const {
+  return ReverseIterator(nullptr);
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Bottom() const {
-  return vector_.rbegin();
+MutatorsStack::ReverseIterator MutatorsStack::Bottom() const {
+  return ReverseIterator(bottom_.get());
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator
-MutatorsStack::Begin() const {
-  return vector_.begin();
+MutatorsStack::Iterator MutatorsStack::Begin() const {
+  return Iterator(bottom_.get(), 0);
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator MutatorsStack::End()
-    const {
-  return vector_.end();
+MutatorsStack::Iterator MutatorsStack::End() const {
+  return Iterator(bottom_.get(), size());
 };
 
+bool MutatorsStack::operator==(const MutatorsStack& other) const {
+  if (size() != other.size()) {
+    return false;
+  }
+  for (auto i = Bottom(), j = other.Bottom(); i != Top(); ++i, ++j) {
+    if (i == j) {
+      // The rest of the stacks are shared.
+      return true;
+    }
+    if (**i != **j) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MutatorsStack::operator==(const std::vector<Mutator>& other) const {
+  if (size() != other.size()) {
+    return false;
+  }
+  size_t index = other.size();
+  for (auto i = Bottom(); i != Top(); ++i) {
+    if (**i != other[--index]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+bool ExternalViewEmbedder::SupportsUnmergedSubmission() {
+  return false;
+}
+
 void ExternalViewEmbedder::Teardown() {}
 
 }  // namespace flutter
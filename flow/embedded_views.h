@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 #define FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 
+#include <iterator>
+#include <memory>
 #include <vector>
 
 #include "flutter/flow/surface_frame.h"
@@ -124,8 +126,75 @@ class Mutator {
 // For example consider the following stack: [T1, T2, T3], where T1 is the top
 // of the stack and T3 is the bottom of the stack. Applying this mutators stack
 // to a platform view P1 will result in T1(T2(T3(P1))).
+//
+// The mutators are stored in immutable nodes that point to the node below
+// them, so that copies of a stack share their nodes. Copying a stack and
+// popping from it never allocate, and pushing allocates a single node.
 class MutatorsStack {
+ private:
+  struct Node;
+
  public:
+  // Visits the mutators from the bottom of the stack to the top, i.e. from
+  // the mutator closest to the leaf node to the one furthest from it.
+  class ReverseIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = const Mutator*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    explicit ReverseIterator(const Node* node) : node_(node) {}
+
+    const Mutator* operator*() const;
+
+    ReverseIterator& operator++();
+
+    bool operator==(const ReverseIterator& other) const {
+      return node_ == other.node_;
+    }
+    bool operator!=(const ReverseIterator& other) const {
+      return node_ != other.node_;
+    }
+
+   private:
+    const Node* node_;
+  };
+
+  // Visits the mutators from the top of the stack to the bottom, i.e. from
+  // the mutator furthest from the leaf node to the one closest to it.
+  //
+  // The nodes only point down the stack, so each step walks the nodes from
+  // the bottom. The stacks are only a few mutators deep.
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = const Mutator*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    Iterator(const Node* bottom, size_t index)
+        : bottom_(bottom), index_(index) {}
+
+    const Mutator* operator*() const;
+
+    Iterator& operator++() {
+      index_++;
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return bottom_ == other.bottom_ && index_ == other.index_;
+    }
+    bool operator!=(const Iterator& other) const { return !operator==(other); }
+
+   private:
+    const Node* bottom_;
+    size_t index_;
+  };
+
   MutatorsStack() = default;
 
   void PushClipRect(const SkRect& rect);
@@ -140,46 +209,24 @@ class MutatorsStack {
 
   // Returns a reverse iterator pointing to the top of the stack, which is the
   // mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Top()
-      const;
+  ReverseIterator Top() const;
   // Returns a reverse iterator pointing to the bottom of the stack, which is
   // the mutator that is closeset from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Bottom()
-      const;
+  ReverseIterator Bottom() const;
 
   // Returns an iterator pointing to the beginning of the mutator vector, which
   // is the mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator Begin() const;
+  Iterator Begin() const;
 
   // Returns an iterator pointing to the end of the mutator vector, which is the
   // mutator that is closest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator End() const;
+  Iterator End() const;
 
-  bool is_empty() const { return vector_.empty(); }
+  bool is_empty() const { return bottom_ == nullptr; }
 
-  bool operator==(const MutatorsStack& other) const {
-    if (vector_.size() != other.vector_.size()) {
-      return false;
-    }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != *other.vector_[i]) {
-        return false;
-      }
-    }
-    return true;
-  }
+  bool operator==(const MutatorsStack& other) const;
 
-  bool operator==(const std::vector<Mutator>& other) const {
-    if (vector_.size() != other.size()) {
-      return false;
-    }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != other[i]) {
-        return false;
-      }
-    }
-    return true;
-  }
+  bool operator==(const std::vector<Mutator>& other) const;
 
   bool operator!=(const MutatorsStack& other) const {
     return !operator==(other);
@@ -190,7 +237,27 @@ class MutatorsStack {
   }
 
  private:
-  std::vector<std::shared_ptr<Mutator>> vector_;
+  struct Node {
+    template <typename T>
+    Node(const T& mutation, std::shared_ptr<const Node> next)
+        : mutator(mutation),
+          next(std::move(next)),
+          depth(this->next ? this->next->depth + 1 : 1) {}
+
+    const Mutator mutator;
+    // The node below this one, which is closer to the top of the stack.
+    const std::shared_ptr<const Node> next;
+    // The number of mutators from the top of the stack to this one.
+    const size_t depth;
+  };
+
+  template <typename T>
+  void Push(const T& mutation);
+
+  size_t size() const { return bottom_ ? bottom_->depth : 0; }
+
+  // The node of the mutator that was pushed last.
+  std::shared_ptr<const Node> bottom_;
 };  // MutatorsStack
 
 class EmbeddedViewParams {
@@ -337,6 +404,14 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether |SubmitFrame| is also called for the frames that are rasterized
+  // while the raster thread isn't merged with the platform thread.
+  //
+  // Embedders that return `true` composite their views from the raster thread,
+  // and only merge the threads from |PostPrerollAction| for the frames they
+  // can't composite there.
+  virtual bool SupportsUnmergedSubmission();
+
   // Called when the rasterizer is being torn down.
   // This method provides a way to release resources associated with the current
   // embedder.
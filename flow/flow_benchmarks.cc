@@ -0,0 +1,381 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the phases of rasterizing a layer tree separately: preroll, the
+// diff against the previous frame, paint, the dispatch of display lists to a
+// canvas and the flush of the GPU work, on the software and GL backends.
+//
+// Besides the synthetic scenes below, the frames captured with
+// --dump-skp-on-shader-compilation are benchmarked when the directory they
+// were dumped to is given in the FLUTTER_FLOW_BENCHMARK_SCENES environment
+// variable. The captured frames are flattened into a single display list, so
+// their layer tree is a single DisplayListLayer.
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/display_list_canvas.h"
+#include "flutter/flow/display_list_serialization.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+#ifdef FLOW_BENCHMARKS_ENABLE_GL
+#include "flutter/testing/test_gl_surface.h"
+#endif  // FLOW_BENCHMARKS_ENABLE_GL
+
+namespace flutter {
+
+namespace {
+
+constexpr SkISize kFrameSize = SkISize::Make(1080, 1920);
+constexpr int kTileColumns = 8;
+constexpr SkScalar kTileWidth = 120;
+constexpr SkScalar kTileHeight = 90;
+constexpr SkScalar kTileSpacing = 15;
+
+struct Scene {
+  std::string name;
+  SkISize frame_size;
+  // Builds a new layer tree for the scene. Each call builds new layers, so
+  // that two trees of the same scene are diffed like consecutive frames.
+  std::function<std::unique_ptr<LayerTree>()> make_layer_tree;
+};
+
+enum class Backend {
+  kSoftware,
+  kGL,
+};
+
+// The surface the benchmarks paint to.
+class BenchmarkSurface {
+ public:
+  static std::unique_ptr<BenchmarkSurface> Make(Backend backend,
+                                                const SkISize& size) {
+    auto surface = std::unique_ptr<BenchmarkSurface>(new BenchmarkSurface());
+    SkImageInfo image_info = SkImageInfo::MakeN32Premul(size);
+    switch (backend) {
+      case Backend::kSoftware:
+        surface->surface_ = SkSurface::MakeRaster(image_info);
+        break;
+      case Backend::kGL:
+#ifdef FLOW_BENCHMARKS_ENABLE_GL
+        surface->gl_surface_ = std::make_unique<testing::TestGLSurface>(size);
+        surface->gl_surface_->MakeCurrent();
+        surface->gr_context_ = surface->gl_surface_->GetGrContext();
+        surface->surface_ = SkSurface::MakeRenderTarget(
+            surface->gr_context_.get(), SkBudgeted::kNo, image_info);
+#endif  // FLOW_BENCHMARKS_ENABLE_GL
+        break;
+    }
+    if (!surface->surface_) {
+      return nullptr;
+    }
+    return surface;
+  }
+
+  ~BenchmarkSurface() {
+    surface_.reset();
+    gr_context_.reset();
+#ifdef FLOW_BENCHMARKS_ENABLE_GL
+    if (gl_surface_) {
+      gl_surface_->ClearCurrent();
+    }
+#endif  // FLOW_BENCHMARKS_ENABLE_GL
+  }
+
+  SkCanvas* canvas() const { return surface_->getCanvas(); }
+
+  GrDirectContext* gr_context() const { return gr_context_.get(); }
+
+  // Submits the work recorded so far and waits for the GPU to finish it.
+  void Flush() const {
+    if (gr_context_) {
+      gr_context_->flushAndSubmit(true);
+    }
+  }
+
+ private:
+#ifdef FLOW_BENCHMARKS_ENABLE_GL
+  std::unique_ptr<testing::TestGLSurface> gl_surface_;
+#endif  // FLOW_BENCHMARKS_ENABLE_GL
+  sk_sp<GrDirectContext> gr_context_;
+  sk_sp<SkSurface> surface_;
+
+  BenchmarkSurface() = default;
+};
+
+std::unique_ptr<CompositorContext::ScopedFrame> AcquireFrame(
+    CompositorContext& compositor_context,
+    const BenchmarkSurface& surface) {
+  return compositor_context.AcquireFrame(surface.gr_context(), surface.canvas(),
+                                         nullptr, SkMatrix::I(), false, true,
+                                         nullptr);
+}
+
+std::shared_ptr<DisplayListLayer> MakeDisplayListLayer(
+    sk_sp<DisplayList> display_list) {
+  return std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject<DisplayList>(std::move(display_list), nullptr), false,
+      false);
+}
+
+// The contents of a tile of the grid, which look like a list item with an
+// avatar and a few lines of text.
+sk_sp<DisplayList> MakeTileDisplayList(int index) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorWHITE);
+  builder.drawRRect(SkRRect::MakeRectXY(
+      SkRect::MakeWH(kTileWidth, kTileHeight), kTileSpacing / 2,
+      kTileSpacing / 2));
+  builder.setColor(0xFF2196F3);
+  builder.drawCircle(SkPoint::Make(24, 24), 16);
+  builder.setColor(0xFF424242);
+  for (int line = 0; line < 4; line++) {
+    SkScalar width = 20 + (index * 37 + line * 53) % 60;
+    builder.drawRect(SkRect::MakeXYWH(48, 12 + line * 18, width, 8));
+  }
+  return builder.Build();
+}
+
+// A grid of tiles that are each transformed, clipped and some of them faded,
+// as is common in scrolling lists and grids. The tiles that don't fit in the
+// frame are culled.
+std::unique_ptr<LayerTree> MakeTileGridLayerTree(int tile_count) {
+  auto layer_tree = std::make_unique<LayerTree>(kFrameSize, 1.0f);
+  auto root = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < tile_count; i++) {
+    SkScalar x =
+        kTileSpacing + (i % kTileColumns) * (kTileWidth + kTileSpacing);
+    SkScalar y =
+        kTileSpacing + (i / kTileColumns) * (kTileHeight + kTileSpacing);
+    auto transform =
+        std::make_shared<TransformLayer>(SkMatrix::Translate(x, y));
+    auto clip = std::make_shared<ClipRRectLayer>(
+        SkRRect::MakeRectXY(SkRect::MakeWH(kTileWidth, kTileHeight),
+                            kTileSpacing / 2, kTileSpacing / 2),
+        Clip::antiAlias);
+    auto opacity = std::make_shared<OpacityLayer>(i % 4 == 0 ? 0x80 : 0xFF,
+                                                  SkPoint::Make(0, 0));
+    opacity->Add(MakeDisplayListLayer(MakeTileDisplayList(i)));
+    clip->Add(opacity);
+    transform->Add(clip);
+    root->Add(transform);
+  }
+  layer_tree->set_root_layer(root);
+  return layer_tree;
+}
+
+void AddCapturedScenes(std::vector<Scene>& scenes) {
+  const char* directory_path = std::getenv("FLUTTER_FLOW_BENCHMARK_SCENES");
+  if (!directory_path) {
+    return;
+  }
+  fml::UniqueFD scenes_directory =
+      fml::OpenDirectory(directory_path, false, fml::FilePermission::kRead);
+  if (!scenes_directory.is_valid()) {
+    FML_LOG(ERROR) << "Could not open the captured scenes in "
+                   << directory_path;
+    return;
+  }
+  auto add_scene = [&scenes](const fml::UniqueFD& directory,
+                             const std::string& filename) {
+    const std::string extension = ".dl";
+    if (filename.size() <= extension.size() ||
+        filename.compare(filename.size() - extension.size(), extension.size(),
+                         extension) != 0) {
+      return true;
+    }
+    auto serialized = SerializedDisplayList::Make(
+        fml::FileMapping::CreateReadOnly(directory, filename));
+    if (!serialized) {
+      FML_LOG(ERROR) << "Could not read the captured scene " << filename;
+      return true;
+    }
+    sk_sp<DisplayList> display_list = serialized->Build();
+    SkISize frame_size = display_list->bounds().roundOut().size();
+    if (frame_size.isEmpty()) {
+      return true;
+    }
+    auto make_layer_tree = [display_list, frame_size]() {
+      auto layer_tree = std::make_unique<LayerTree>(frame_size, 1.0f);
+      layer_tree->set_root_layer(MakeDisplayListLayer(display_list));
+      return layer_tree;
+    };
+    scenes.push_back({filename, frame_size, make_layer_tree});
+    return true;
+  };
+  fml::VisitFiles(scenes_directory, add_scene);
+}
+
+// Records the layer tree into a display list, like the rasterizer does for
+// screenshots.
+sk_sp<DisplayList> FlattenLayerTree(LayerTree& layer_tree) {
+  auto recorder = sk_make_sp<DisplayListCanvasRecorder>(
+      SkRect::Make(layer_tree.frame_size()));
+  CompositorContext compositor_context;
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, recorder.get(), nullptr, SkMatrix::I(), false, true, nullptr);
+  frame->Raster(layer_tree, true, nullptr);
+  return recorder->Build();
+}
+
+void BM_Preroll(benchmark::State& state, const Scene& scene) {
+  auto surface = BenchmarkSurface::Make(Backend::kSoftware, scene.frame_size);
+  std::unique_ptr<LayerTree> layer_tree = scene.make_layer_tree();
+  CompositorContext compositor_context;
+  for (auto _ : state) {
+    auto frame = AcquireFrame(compositor_context, *surface);
+    layer_tree->Preroll(*frame, true);
+  }
+}
+
+void BM_Diff(benchmark::State& state, const Scene& scene) {
+  std::unique_ptr<LayerTree> previous_layer_tree = scene.make_layer_tree();
+  std::unique_ptr<LayerTree> layer_tree = scene.make_layer_tree();
+  // Computes the paint regions of the previous frame.
+  FrameDamage().ComputeClipRect(*previous_layer_tree);
+  for (auto _ : state) {
+    FrameDamage frame_damage;
+    frame_damage.SetPreviousLayerTree(previous_layer_tree.get());
+    benchmark::DoNotOptimize(frame_damage.ComputeClipRect(*layer_tree));
+  }
+}
+
+void BM_Paint(benchmark::State& state, const Scene& scene, Backend backend) {
+  auto surface = BenchmarkSurface::Make(backend, scene.frame_size);
+  if (!surface) {
+    state.SkipWithError("Could not create the surface.");
+    return;
+  }
+  std::unique_ptr<LayerTree> layer_tree = scene.make_layer_tree();
+  CompositorContext compositor_context;
+  for (auto _ : state) {
+    auto frame = AcquireFrame(compositor_context, *surface);
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      layer_tree->Preroll(*frame, true);
+    }
+    layer_tree->Paint(*frame, true);
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      surface->Flush();
+    }
+  }
+}
+
+void BM_DisplayListDispatch(benchmark::State& state,
+                            const sk_sp<DisplayList>& display_list,
+                            const SkISize& frame_size,
+                            Backend backend) {
+  auto surface = BenchmarkSurface::Make(backend, frame_size);
+  if (!surface) {
+    state.SkipWithError("Could not create the surface.");
+    return;
+  }
+  for (auto _ : state) {
+    display_list->RenderTo(surface->canvas());
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      surface->Flush();
+    }
+  }
+}
+
+void BM_Flush(benchmark::State& state, const Scene& scene, Backend backend) {
+  auto surface = BenchmarkSurface::Make(backend, scene.frame_size);
+  if (!surface) {
+    state.SkipWithError("Could not create the surface.");
+    return;
+  }
+  std::unique_ptr<LayerTree> layer_tree = scene.make_layer_tree();
+  CompositorContext compositor_context;
+  for (auto _ : state) {
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      auto frame = AcquireFrame(compositor_context, *surface);
+      frame->Raster(*layer_tree, true, nullptr);
+    }
+    surface->Flush();
+  }
+}
+
+// A whole frame, including the raster cache, as the rasterizer draws it.
+void BM_Raster(benchmark::State& state, const Scene& scene, Backend backend) {
+  auto surface = BenchmarkSurface::Make(backend, scene.frame_size);
+  if (!surface) {
+    state.SkipWithError("Could not create the surface.");
+    return;
+  }
+  std::unique_ptr<LayerTree> layer_tree = scene.make_layer_tree();
+  CompositorContext compositor_context;
+  for (auto _ : state) {
+    {
+      auto frame = AcquireFrame(compositor_context, *surface);
+      frame->Raster(*layer_tree, false, nullptr);
+    }
+    surface->Flush();
+  }
+}
+
+void RegisterBenchmarks(const Scene& scene, Backend backend) {
+  const std::string suffix =
+      "/" + scene.name + (backend == Backend::kGL ? "/GL" : "/Software");
+  sk_sp<DisplayList> display_list = FlattenLayerTree(*scene.make_layer_tree());
+  benchmark::RegisterBenchmark(("BM_Paint" + suffix).c_str(), BM_Paint, scene,
+                               backend);
+  benchmark::RegisterBenchmark(("BM_DisplayListDispatch" + suffix).c_str(),
+                               BM_DisplayListDispatch, display_list,
+                               scene.frame_size, backend);
+  if (backend == Backend::kGL) {
+    benchmark::RegisterBenchmark(("BM_Flush" + suffix).c_str(), BM_Flush,
+                                 scene, backend);
+  }
+  benchmark::RegisterBenchmark(("BM_Raster" + suffix).c_str(), BM_Raster,
+                               scene, backend);
+}
+
+bool RegisterBenchmarks() {
+  std::vector<Scene> scenes;
+  for (int tile_count : {64, 256, 1024}) {
+    auto make_layer_tree = [tile_count]() {
+      return MakeTileGridLayerTree(tile_count);
+    };
+    scenes.push_back({"TileGrid" + std::to_string(tile_count), kFrameSize,
+                      make_layer_tree});
+  }
+  AddCapturedScenes(scenes);
+
+  for (const Scene& scene : scenes) {
+    benchmark::RegisterBenchmark(("BM_Preroll/" + scene.name).c_str(),
+                                 BM_Preroll, scene);
+    benchmark::RegisterBenchmark(("BM_Diff/" + scene.name).c_str(), BM_Diff,
+                                 scene);
+    RegisterBenchmarks(scene, Backend::kSoftware);
+#ifdef FLOW_BENCHMARKS_ENABLE_GL
+    RegisterBenchmarks(scene, Backend::kGL);
+#endif  // FLOW_BENCHMARKS_ENABLE_GL
+  }
+  return true;
+}
+
+[[maybe_unused]] const bool kBenchmarksRegistered = RegisterBenchmarks();
+
+}  // namespace
+
+}  // namespace flutter
@@ -5,7 +5,6 @@
 #include "flutter/flow/frame_timings.h"
 
 #include <memory>
-#include <sstream>
 
 #include "flutter/common/settings.h"
 #include "flutter/fml/logging.h"
@@ -15,19 +14,11 @@ namespace flutter {
 
 std::atomic<uint64_t> FrameTimingsRecorder::frame_number_gen_ = {1};
 
-static std::string ToString(uint64_t val) {
-  std::stringstream stream;
-  stream << val;
-  return stream.str();
-}
-
 FrameTimingsRecorder::FrameTimingsRecorder()
-    : frame_number_(frame_number_gen_++),
-      frame_number_trace_arg_val_(ToString(frame_number_)) {}
+    : frame_number_(frame_number_gen_++) {}
 
 FrameTimingsRecorder::FrameTimingsRecorder(uint64_t frame_number)
-    : frame_number_(frame_number),
-      frame_number_trace_arg_val_(ToString(frame_number_)) {}
+    : frame_number_(frame_number) {}
 
 FrameTimingsRecorder::~FrameTimingsRecorder() = default;
 
@@ -137,6 +128,36 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   raster_start_ = raster_start;
 }
 
+void FrameTimingsRecorder::RecordSkippedFrames(uint64_t skipped_frame_count) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ < State::kRasterEnd);
+  skipped_frame_count_ = skipped_frame_count;
+}
+
+uint64_t FrameTimingsRecorder::GetSkippedFrameCount() const {
+  std::scoped_lock state_lock(state_mutex_);
+  return skipped_frame_count_;
+}
+
+void FrameTimingsRecorder::RecordGpuDuration(uint64_t frame_number,
+                                             fml::TimeDelta gpu_duration) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ < State::kRasterEnd);
+  gpu_frame_number_ = frame_number;
+  gpu_duration_ = gpu_duration;
+}
+
+void FrameTimingsRecorder::RecordSkiaGpuStatistics(
+    uint64_t shader_compile_count,
+    fml::TimeDelta shader_compile_duration,
+    uint64_t resource_cache_purged_bytes) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ < State::kRasterEnd);
+  shader_compile_count_ = shader_compile_count;
+  shader_compile_duration_ = shader_compile_duration;
+  resource_cache_purged_bytes_ = resource_cache_purged_bytes;
+}
+
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterStart);
@@ -163,6 +184,10 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetSkippedFrameCount(skipped_frame_count_);
+  timing_.SetGpuDuration(gpu_frame_number_, gpu_duration_);
+  timing_.SetSkiaGpuStatistics(shader_compile_count_, shader_compile_duration_,
+                               resource_cache_purged_bytes_);
   return timing_;
 }
 
@@ -213,8 +238,4 @@ uint64_t FrameTimingsRecorder::GetFrameNumber() const {
   return frame_number_;
 }
 
-const char* FrameTimingsRecorder::GetFrameNumberTraceArg() const {
-  return frame_number_trace_arg_val_.c_str();
-}
-
 }  // namespace flutter
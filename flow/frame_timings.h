@@ -15,7 +15,7 @@
 
 #define TRACE_EVENT_WITH_FRAME_NUMBER(recorder, category_group, name) \
   TRACE_EVENT1(category_group, name, "frame_number",                  \
-               recorder->GetFrameNumberTraceArg())
+               recorder->GetFrameNumber())
 
 namespace flutter {
 
@@ -95,6 +95,24 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records the number of older frames that were skipped in favor of this
+  /// one. Must be called before `RecordRasterEnd`.
+  void RecordSkippedFrames(uint64_t skipped_frame_count);
+
+  /// Count of the older frames that were skipped in favor of this one.
+  uint64_t GetSkippedFrameCount() const;
+
+  /// Records the GPU time of an earlier frame whose measurement completed
+  /// while this frame was rasterized. Must be called before `RecordRasterEnd`.
+  void RecordGpuDuration(uint64_t frame_number, fml::TimeDelta gpu_duration);
+
+  /// Records the shaders that Skia compiled and the bytes that were purged
+  /// from the GPU resource cache since the previous frame. Must be called
+  /// before `RecordRasterEnd`.
+  void RecordSkiaGpuStatistics(uint64_t shader_compile_count,
+                               fml::TimeDelta shader_compile_duration,
+                               uint64_t resource_cache_purged_bytes);
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -107,9 +125,6 @@ class FrameTimingsRecorder {
   /// built at a later point of time.
   uint64_t GetFrameNumber() const;
 
-  /// Returns the frame number in a fml tracing friendly format.
-  const char* GetFrameNumberTraceArg() const;
-
   /// Returns the recorded time from when `RecordRasterEnd` is called.
   FrameTiming GetRecordedTime() const;
 
@@ -120,7 +135,6 @@ class FrameTimingsRecorder {
   State state_ = State::kUninitialized;
 
   const uint64_t frame_number_;
-  const std::string frame_number_trace_arg_val_;
 
   fml::TimePoint vsync_start_;
   fml::TimePoint vsync_target_;
@@ -135,6 +149,13 @@ class FrameTimingsRecorder {
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
 
+  uint64_t skipped_frame_count_ = 0;
+  uint64_t gpu_frame_number_ = 0;
+  fml::TimeDelta gpu_duration_;
+  uint64_t shader_compile_count_ = 0;
+  fml::TimeDelta shader_compile_duration_;
+  uint64_t resource_cache_purged_bytes_ = 0;
+
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
 
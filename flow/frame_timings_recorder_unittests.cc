@@ -11,6 +11,7 @@
 #include <thread>
 
 #include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/fml/time/time_point.h"
 
 #include "gtest/gtest.h"
@@ -121,10 +122,58 @@ TEST(FrameTimingsRecorderTest, RecordRasterTimesWithCache) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), picture_bytes);
 }
 
+TEST(FrameTimingsRecorderTest, RecordGpuDuration) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMillisecondsF(16));
+  recorder->RecordBuildStart(now);
+  recorder->RecordBuildEnd(now);
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  recorder->RecordGpuDuration(1, fml::TimeDelta::FromMicroseconds(1500));
+  const auto timing = recorder->RecordRasterEnd();
+
+  ASSERT_EQ(timing.GetGpuFrameNumber(), 1u);
+  ASSERT_EQ(timing.GetGpuDuration(), fml::TimeDelta::FromMicroseconds(1500));
+}
+
+TEST(FrameTimingsRecorderTest, RecordSkiaGpuStatistics) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMillisecondsF(16));
+  recorder->RecordBuildStart(now);
+  recorder->RecordBuildEnd(now);
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  recorder->RecordSkiaGpuStatistics(3, fml::TimeDelta::FromMilliseconds(42),
+                                    4096);
+  const auto timing = recorder->RecordRasterEnd();
+
+  ASSERT_EQ(timing.GetShaderCompileCount(), 3u);
+  ASSERT_EQ(timing.GetShaderCompileDuration(),
+            fml::TimeDelta::FromMilliseconds(42));
+  ASSERT_EQ(timing.GetResourceCachePurgedBytes(), 4096u);
+}
+
 // Windows and Fuchsia don't allow testing with killed by signal.
 #if !defined(OS_FUCHSIA) && !defined(OS_WIN) && \
     (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG)
 
+TEST(FrameTimingsRecorderTest, RecordSkippedFrames) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMillisecondsF(16));
+  recorder->RecordBuildStart(now);
+  recorder->RecordBuildEnd(now);
+  recorder->RecordSkippedFrames(2);
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  const auto timing = recorder->RecordRasterEnd();
+
+  ASSERT_EQ(recorder->GetSkippedFrameCount(), 2u);
+  ASSERT_EQ(timing.GetSkippedFrameCount(), 2u);
+}
+
 TEST(FrameTimingsRecorderTest, ThrowWhenRecordBuildBeforeVsync) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -291,7 +340,8 @@ TEST(FrameTimingsRecorderTest, FrameNumberTraceArgIsValid) {
   char buff[50];
   sprintf(buff, "%d", static_cast<int>(recorder->GetFrameNumber()));
   std::string actual_arg = buff;
-  std::string expected_arg = recorder->GetFrameNumberTraceArg();
+  std::string expected_arg =
+      fml::tracing::TraceArgValue(recorder->GetFrameNumber()).c_str();
 
   ASSERT_EQ(actual_arg, expected_arg);
 }
@@ -0,0 +1,253 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/glyph_usage.h"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr char kGlyphUsageHeader[] = "flutter-glyph-usage 1";
+
+// Large enough that the glyphs drawn at its center always touch it.
+constexpr int kWarmUpSurfaceSize = 64;
+
+uint32_t GetFontFlags(const SkFont& font) {
+  return (font.isForceAutoHinting() ? 1 << 0 : 0) |
+         (font.isEmbeddedBitmaps() ? 1 << 1 : 0) |
+         (font.isSubpixel() ? 1 << 2 : 0) |
+         (font.isLinearMetrics() ? 1 << 3 : 0) |
+         (font.isEmbolden() ? 1 << 4 : 0) |
+         (font.isBaselineSnap() ? 1 << 5 : 0);
+}
+
+// Everything but the glyphs and the typeface, as stored before the glyphs.
+std::string SerializeStrikeKey(const GlyphUsage::Strike& strike) {
+  std::ostringstream stream;
+  stream << std::setprecision(std::numeric_limits<float>::max_digits10)
+         << strike.size << ' ' << strike.font_scale_x << ' '
+         << strike.font_skew_x << ' ' << static_cast<int>(strike.edging) << ' '
+         << static_cast<int>(strike.hinting) << ' ' << strike.flags << ' '
+         << strike.scale_x << ' ' << strike.skew_x << ' ' << strike.skew_y
+         << ' ' << strike.scale_y << ' ' << strike.style.weight() << ' '
+         << strike.style.width() << ' '
+         << static_cast<int>(strike.style.slant()) << ' '
+         << strike.family_name;
+  return stream.str();
+}
+
+}  // namespace
+
+SkFont GlyphUsage::Strike::MakeFont() const {
+  SkFont font(typeface, size, font_scale_x, font_skew_x);
+  font.setEdging(edging);
+  font.setHinting(hinting);
+  font.setForceAutoHinting(flags & (1 << 0));
+  font.setEmbeddedBitmaps(flags & (1 << 1));
+  font.setSubpixel(flags & (1 << 2));
+  font.setLinearMetrics(flags & (1 << 3));
+  font.setEmbolden(flags & (1 << 4));
+  font.setBaselineSnap(flags & (1 << 5));
+  return font;
+}
+
+SkMatrix GlyphUsage::Strike::GetMatrix() const {
+  return SkMatrix::MakeAll(scale_x, skew_x, 0, skew_y, scale_y, 0, 0, 0, 1);
+}
+
+GlyphUsage& GlyphUsage::GetInstance() {
+  // Leaked, since frames may be rasterized until the process exits.
+  static GlyphUsage* usage = new GlyphUsage();
+  return *usage;
+}
+
+GlyphUsage::GlyphUsage() = default;
+
+GlyphUsage::~GlyphUsage() = default;
+
+bool GlyphUsage::StartRecording() {
+  std::scoped_lock lock(mutex_);
+  if (started_) {
+    return false;
+  }
+  started_ = true;
+  recording_ = true;
+  return true;
+}
+
+void GlyphUsage::RecordTextBlob(const SkTextBlob& blob,
+                                const SkMatrix& matrix,
+                                const SkPaint& paint) {
+  if (!IsRecording() || matrix.hasPerspective() ||
+      paint.getStyle() != SkPaint::kFill_Style || paint.getMaskFilter() ||
+      paint.getPathEffect()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (!recording_) {
+    return;
+  }
+  SkTextBlob::Iter iter(blob);
+  SkTextBlob::Iter::ExperimentalRun run;
+  while (iter.experimentalNext(&run)) {
+    SkTypeface* typeface = run.font.getTypeface();
+    if (typeface == nullptr) {
+      continue;
+    }
+    Strike strike;
+    SkString family_name;
+    typeface->getFamilyName(&family_name);
+    strike.family_name = family_name.c_str();
+    strike.style = typeface->fontStyle();
+    strike.size = run.font.getSize();
+    strike.font_scale_x = run.font.getScaleX();
+    strike.font_skew_x = run.font.getSkewX();
+    strike.edging = run.font.getEdging();
+    strike.hinting = run.font.getHinting();
+    strike.flags = GetFontFlags(run.font);
+    strike.scale_x = matrix.getScaleX();
+    strike.skew_x = matrix.getSkewX();
+    strike.skew_y = matrix.getSkewY();
+    strike.scale_y = matrix.getScaleY();
+    auto& glyphs = strikes_[SerializeStrikeKey(strike)];
+    if (glyphs.second.empty()) {
+      glyphs.first = std::move(strike);
+    }
+    for (int i = 0; i < run.count && glyph_count_ < kMaxRecordedGlyphs; i++) {
+      if (glyphs.second.insert(run.glyphs[i]).second) {
+        glyph_count_++;
+      }
+    }
+  }
+}
+
+void GlyphUsage::EndFrame() {
+  if (!IsRecording()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (++frame_count_ >= kRecordedFrameCount) {
+    recording_ = false;
+    finished_ = true;
+  }
+}
+
+bool GlyphUsage::TakeFinishedRecording(std::string* serialized) {
+  std::vector<Strike> strikes;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!finished_) {
+      return false;
+    }
+    finished_ = false;
+    for (auto& item : strikes_) {
+      Strike& strike = item.second.first;
+      strike.glyphs.assign(item.second.second.begin(),
+                           item.second.second.end());
+      strikes.push_back(std::move(strike));
+    }
+    strikes_.clear();
+  }
+  if (strikes.empty()) {
+    return false;
+  }
+  *serialized = Serialize(strikes);
+  return true;
+}
+
+// Each strike is stored as a line with its key, which ends with the family
+// name, followed by a line with its glyphs.
+std::string GlyphUsage::Serialize(const std::vector<Strike>& strikes) {
+  std::ostringstream stream;
+  stream << kGlyphUsageHeader << '\n';
+  for (const Strike& strike : strikes) {
+    stream << SerializeStrikeKey(strike) << '\n';
+    for (size_t i = 0; i < strike.glyphs.size(); i++) {
+      stream << (i == 0 ? "" : " ") << strike.glyphs[i];
+    }
+    stream << '\n';
+  }
+  return stream.str();
+}
+
+std::vector<GlyphUsage::Strike> GlyphUsage::Parse(
+    const std::string& serialized) {
+  std::vector<Strike> strikes;
+  std::istringstream stream(serialized);
+  std::string line;
+  if (!std::getline(stream, line) || line != kGlyphUsageHeader) {
+    return strikes;
+  }
+  while (std::getline(stream, line)) {
+    std::istringstream key(line);
+    Strike strike;
+    int edging, hinting, weight, width, slant;
+    if (!(key >> strike.size >> strike.font_scale_x >> strike.font_skew_x >>
+          edging >> hinting >> strike.flags >> strike.scale_x >>
+          strike.skew_x >> strike.skew_y >> strike.scale_y >> weight >>
+          width >> slant)) {
+      return {};
+    }
+    key.get();
+    std::getline(key, strike.family_name);
+    strike.edging = static_cast<SkFont::Edging>(edging);
+    strike.hinting = static_cast<SkFontHinting>(hinting);
+    strike.style = SkFontStyle(weight, width,
+                               static_cast<SkFontStyle::Slant>(slant));
+
+    if (!std::getline(stream, line)) {
+      return {};
+    }
+    std::istringstream glyphs(line);
+    SkGlyphID glyph;
+    while (glyphs >> glyph) {
+      strike.glyphs.push_back(glyph);
+    }
+    strikes.push_back(std::move(strike));
+  }
+  return strikes;
+}
+
+size_t GlyphUsage::WarmUp(const std::vector<Strike>& strikes) {
+  TRACE_EVENT0("flutter", "GlyphUsage::WarmUp");
+  // The glyph cache is shared by the raster and the GPU backends, which only
+  // upload the glyphs that it has already rasterized.
+  sk_sp<SkSurface> surface =
+      SkSurface::MakeRasterN32Premul(kWarmUpSurfaceSize, kWarmUpSurfaceSize);
+  if (!surface) {
+    return 0;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+  SkPaint paint;
+  size_t glyph_count = 0;
+  for (const Strike& strike : strikes) {
+    if (!strike.typeface || strike.glyphs.empty()) {
+      continue;
+    }
+    SkFont font = strike.MakeFont();
+    SkTextBlobBuilder builder;
+    const auto& run = builder.allocRunPos(font, strike.glyphs.size());
+    for (size_t i = 0; i < strike.glyphs.size(); i++) {
+      run.glyphs[i] = strike.glyphs[i];
+      run.points()[i] = SkPoint::Make(0, 0);
+    }
+    SkMatrix matrix = SkMatrix::Translate(kWarmUpSurfaceSize / 2,
+                                          kWarmUpSurfaceSize / 2);
+    matrix.preConcat(strike.GetMatrix());
+    canvas->setMatrix(matrix);
+    canvas->drawTextBlob(builder.make(), 0, 0, paint);
+    glyph_count += strike.glyphs.size();
+  }
+  return glyph_count;
+}
+
+}  // namespace flutter
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_GLYPH_USAGE_H_
+#define FLUTTER_FLOW_GLYPH_USAGE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkFontStyle.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace flutter {
+
+/// Records the glyphs that the first frames of a launch draw, so that later
+/// launches can rasterize them into Skia's glyph cache on a worker during
+/// startup, before the first frames need them.
+///
+/// A recorded strike is identified by the family name and style of its
+/// typeface, so that it can be matched again in a later launch, along with
+/// the attributes of the font and the scale and skew of the matrix it was
+/// drawn with, which make up the key of the strike in the glyph cache.
+class GlyphUsage {
+ public:
+  /// The number of frames whose glyphs are recorded.
+  static constexpr int kRecordedFrameCount = 60;
+
+  /// Bounds the size of the recording of apps that draw a lot of text.
+  static constexpr size_t kMaxRecordedGlyphs = 4096;
+
+  struct Strike {
+    std::string family_name;
+    SkFontStyle style;
+    SkScalar size = 0;
+    SkScalar font_scale_x = 1;
+    SkScalar font_skew_x = 0;
+    SkFont::Edging edging = SkFont::Edging::kAntiAlias;
+    SkFontHinting hinting = SkFontHinting::kNone;
+    // The SkFont flags, as a bit each in the order of |MakeFont|.
+    uint32_t flags = 0;
+    // The 2x2 part of the matrix, without the translation.
+    SkScalar scale_x = 1;
+    SkScalar skew_x = 0;
+    SkScalar skew_y = 0;
+    SkScalar scale_y = 1;
+    std::vector<SkGlyphID> glyphs;
+    // Set by the caller of |WarmUp| to the typeface matched by name.
+    sk_sp<SkTypeface> typeface;
+
+    SkFont MakeFont() const;
+
+    SkMatrix GetMatrix() const;
+  };
+
+  static GlyphUsage& GetInstance();
+
+  GlyphUsage();
+
+  ~GlyphUsage();
+
+  /// Starts recording the glyphs of the next |kRecordedFrameCount| frames.
+  /// Only the first call of a process has an effect, and returns true.
+  bool StartRecording();
+
+  bool IsRecording() const {
+    return recording_.load(std::memory_order_relaxed);
+  }
+
+  /// Records the glyphs of the |blob|, drawn with the |matrix| and the
+  /// |paint|. Blobs drawn with paints that change the shape of the glyphs,
+  /// such as strokes and mask filters, use other strikes and are ignored.
+  void RecordTextBlob(const SkTextBlob& blob,
+                      const SkMatrix& matrix,
+                      const SkPaint& paint);
+
+  /// Counts a rasterized frame, which ends the recording after
+  /// |kRecordedFrameCount| frames.
+  void EndFrame();
+
+  /// Returns the serialized recording once it has ended, and only once.
+  /// Returns false if it has not ended or has no glyphs.
+  bool TakeFinishedRecording(std::string* serialized);
+
+  static std::string Serialize(const std::vector<Strike>& strikes);
+
+  /// Returns the strikes of a recording, or none if it is invalid.
+  static std::vector<Strike> Parse(const std::string& serialized);
+
+  /// Rasterizes the glyphs of the strikes with a typeface into the glyph
+  /// cache. Returns the number of glyphs. Can be called on any thread.
+  static size_t WarmUp(const std::vector<Strike>& strikes);
+
+ private:
+  std::atomic<bool> recording_ = false;
+  std::mutex mutex_;
+  bool started_ = false;
+  bool finished_ = false;
+  int frame_count_ = 0;
+  size_t glyph_count_ = 0;
+  // The glyphs of each strike, by the strike with its glyphs left empty.
+  std::map<std::string, std::pair<Strike, std::set<SkGlyphID>>> strikes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphUsage);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_GLYPH_USAGE_H_
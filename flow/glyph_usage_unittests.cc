@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/glyph_usage.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(GlyphUsageTest, ParsesSerializedStrikes) {
+  GlyphUsage::Strike strike;
+  strike.family_name = "Noto Sans CJK";
+  strike.style = SkFontStyle::Bold();
+  strike.size = 14.5;
+  strike.edging = SkFont::Edging::kSubpixelAntiAlias;
+  strike.hinting = SkFontHinting::kSlight;
+  strike.flags = 1 << 2;
+  strike.scale_x = 2.625;
+  strike.scale_y = 2.625;
+  strike.glyphs = {3, 17, 1024};
+
+  std::vector<GlyphUsage::Strike> strikes =
+      GlyphUsage::Parse(GlyphUsage::Serialize({strike, strike}));
+  ASSERT_EQ(strikes.size(), 2u);
+  const GlyphUsage::Strike& parsed = strikes[1];
+  ASSERT_EQ(parsed.family_name, strike.family_name);
+  ASSERT_EQ(parsed.style, strike.style);
+  ASSERT_EQ(parsed.size, strike.size);
+  ASSERT_EQ(parsed.edging, strike.edging);
+  ASSERT_EQ(parsed.hinting, strike.hinting);
+  ASSERT_EQ(parsed.flags, strike.flags);
+  ASSERT_EQ(parsed.GetMatrix(), strike.GetMatrix());
+  ASSERT_EQ(parsed.glyphs, strike.glyphs);
+}
+
+TEST(GlyphUsageTest, ParsesNothingFromAnInvalidRecording) {
+  ASSERT_TRUE(GlyphUsage::Parse("").empty());
+  ASSERT_TRUE(GlyphUsage::Parse("flutter-glyph-usage 0\n").empty());
+  ASSERT_TRUE(GlyphUsage::Parse("flutter-glyph-usage 1\n14 1 0\n").empty());
+}
+
+TEST(GlyphUsageTest, WarmsUpOnlyStrikesWithATypeface) {
+  GlyphUsage::Strike strike;
+  strike.size = 14;
+  strike.glyphs = {1, 2};
+  ASSERT_EQ(GlyphUsage::WarmUp({strike}), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
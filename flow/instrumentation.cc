@@ -40,6 +40,15 @@ void Stopwatch::SetLapTime(const fml::TimeDelta& delta) {
   laps_[current_sample_] = delta;
 }
 
+void Stopwatch::SetFrameBudget(fml::Milliseconds frame_budget) {
+  if (frame_budget == frame_budget_) {
+    return;
+  }
+  frame_budget_ = frame_budget;
+  // The graph is scaled to the budget, so it has to be redrawn completely.
+  cache_dirty_ = true;
+}
+
 const fml::TimeDelta& Stopwatch::LastLap() const {
   return laps_[(current_sample_ - 1) % kMaxSamples];
 }
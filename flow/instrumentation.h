@@ -38,6 +38,12 @@ class Stopwatch {
 
   void SetLapTime(const fml::TimeDelta& delta);
 
+  // Sets the frame budget the laps are visualized against, e.g. when the
+  // refresh rate of a variable refresh rate display changes.
+  void SetFrameBudget(fml::Milliseconds frame_budget);
+
+  fml::Milliseconds GetFrameBudget() const { return frame_budget_; }
+
  private:
   inline double UnitFrameInterval(double time_ms) const;
   inline double UnitHeight(double time_ms, double max_height) const;
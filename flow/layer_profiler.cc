@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_profiler.h"
+
+#include "flutter/flow/layers/layer.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+void Add(LayerProfiler::Stats& stats,
+         LayerProfiler::Phase phase,
+         fml::TimeDelta inclusive_time,
+         fml::TimeDelta exclusive_time) {
+  LayerProfiler::Timings& timings =
+      phase == LayerProfiler::Phase::kPreroll ? stats.preroll : stats.paint;
+  timings.inclusive_time = timings.inclusive_time + inclusive_time;
+  timings.exclusive_time = timings.exclusive_time + exclusive_time;
+  timings.calls++;
+}
+
+}  // namespace
+
+LayerProfiler::ScopedLayer::ScopedLayer(LayerProfiler* profiler,
+                                        const Layer* layer,
+                                        Phase phase)
+    : profiler_(profiler),
+      layer_(layer),
+      phase_(phase),
+      start_(profiler ? fml::TimePoint::Now() : fml::TimePoint()) {
+  if (profiler_) {
+    fml::tracing::TraceEvent1("flutter", layer_->type_name(), "phase",
+                              phase_ == Phase::kPreroll ? "Preroll" : "Paint");
+    profiler_->Begin();
+  }
+}
+
+LayerProfiler::ScopedLayer::~ScopedLayer() {
+  if (profiler_) {
+    profiler_->End(layer_, phase_, fml::TimePoint::Now() - start_);
+    fml::tracing::TraceEventEnd(layer_->type_name());
+  }
+}
+
+LayerProfiler::LayerProfiler() = default;
+
+LayerProfiler::~LayerProfiler() = default;
+
+void LayerProfiler::Reset() {
+  stats_by_type_.clear();
+  stats_by_layer_.clear();
+}
+
+void LayerProfiler::Begin() {
+  children_time_stack_.push_back(fml::TimeDelta::Zero());
+}
+
+void LayerProfiler::End(const Layer* layer,
+                        Phase phase,
+                        fml::TimeDelta inclusive_time) {
+  FML_DCHECK(!children_time_stack_.empty());
+  fml::TimeDelta exclusive_time = inclusive_time - children_time_stack_.back();
+  children_time_stack_.pop_back();
+  if (!children_time_stack_.empty()) {
+    children_time_stack_.back() = children_time_stack_.back() + inclusive_time;
+  }
+
+  Add(stats_by_type_[layer->type_name()], phase, inclusive_time,
+      exclusive_time);
+  auto result = stats_by_layer_.try_emplace(layer->original_layer_id(),
+                                            LayerStats{layer->type_name()});
+  Add(result.first->second.stats, phase, inclusive_time, exclusive_time);
+}
+
+}  // namespace flutter
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_PROFILER_H_
+#define FLUTTER_FLOW_LAYER_PROFILER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+class Layer;
+
+// Attributes the CPU time spent in the Preroll and the Paint of a layer tree
+// to the layers, aggregated per type of layer and per layer. Each layer also
+// gets a timeline event named after its type.
+//
+// The time of a layer is inclusive of its children, and its exclusive time
+// is what remains after subtracting the time of the children. A layer
+// replaced by another one in a later frame shares its stats with the layer
+// that replaces it, as they have the same |Layer::original_layer_id|.
+//
+// The profiler must only be used on the raster thread.
+class LayerProfiler {
+ public:
+  enum class Phase {
+    kPreroll,
+    kPaint,
+  };
+
+  struct Timings {
+    fml::TimeDelta inclusive_time;
+    fml::TimeDelta exclusive_time;
+    uint64_t calls = 0;
+  };
+
+  struct Stats {
+    Timings preroll;
+    Timings paint;
+  };
+
+  struct LayerStats {
+    // The type of the layer, see |Layer::type_name|.
+    const char* type_name;
+    Stats stats;
+  };
+
+  // Times the Preroll or the Paint of a layer, including the calls to its
+  // children made while the scope is alive. Does nothing if the profiler is
+  // null.
+  class ScopedLayer {
+   public:
+    ScopedLayer(LayerProfiler* profiler, const Layer* layer, Phase phase);
+
+    ~ScopedLayer();
+
+   private:
+    LayerProfiler* profiler_;
+    const Layer* layer_;
+    const Phase phase_;
+    const fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedLayer);
+  };
+
+  LayerProfiler();
+
+  ~LayerProfiler();
+
+  const std::map<std::string, Stats>& stats_by_type() const {
+    return stats_by_type_;
+  }
+
+  // Keyed by the |Layer::original_layer_id| of the layers.
+  const std::unordered_map<uint64_t, LayerStats>& stats_by_layer() const {
+    return stats_by_layer_;
+  }
+
+  // Forgets the stats recorded so far.
+  void Reset();
+
+ private:
+  std::map<std::string, Stats> stats_by_type_;
+  std::unordered_map<uint64_t, LayerStats> stats_by_layer_;
+  // The time spent in the children of each of the layers being timed.
+  std::vector<fml::TimeDelta> children_time_stack_;
+
+  void Begin();
+
+  void End(const Layer* layer, Phase phase, fml::TimeDelta inclusive_time);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerProfiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_PROFILER_H_
@@ -4,6 +4,12 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter,
@@ -34,6 +40,20 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
         filter->filterBounds(input_filter_bounds, SkMatrix::I(),
                              SkImageFilter::kReverse_MapDirection);
 
+    // The backdrop is unchanged when neither the layer nor the layers painted
+    // under it changed in the region it reads back.
+    if (!context->IsSubtreeDirty() && !context->IsDamaged(filter_bounds)) {
+      context->MarkBackdropUnchanged(this);
+      if (prev->readback_bounds_ == filter_bounds) {
+        filtered_backdrop_ = prev->filtered_backdrop_;
+      } else {
+        filtered_backdrop_ = std::nullopt;
+      }
+    } else {
+      filtered_backdrop_ = std::nullopt;
+    }
+    readback_bounds_ = filter_bounds;
+
     context->AddReadbackRegion(filter_bounds);
   }
 
@@ -44,6 +64,7 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
 
 void BackdropFilterLayer::Preroll(PrerollContext* context,
                                   const SkMatrix& matrix) {
+  inside_save_layer_ = context->save_layer_depth > 0;
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
   SkRect child_paint_bounds = SkRect::MakeEmpty();
@@ -58,6 +79,40 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
 
   SkPaint paint;
   paint.setBlendMode(blend_mode_);
+
+  if (filter_) {
+    SkCanvas* canvas = context.leaf_nodes_canvas;
+    if (context.unchanged_backdrops &&
+        context.unchanged_backdrops->count(unique_id()) > 0) {
+      // The surface under the backdrop may not have been repainted in this
+      // frame, so it can only be reused, not filtered again.
+      if (filtered_backdrop_ &&
+          filtered_backdrop_->layer_bounds !=
+              RasterCache::GetDeviceBounds(paint_bounds(),
+                                           canvas->getTotalMatrix())) {
+        filtered_backdrop_ = std::nullopt;
+      }
+    } else {
+      filtered_backdrop_ = FilterBackdrop(context);
+    }
+
+    if (filtered_backdrop_) {
+      Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
+          context, paint_bounds(), &paint,
+          AutoSaveLayer::SaveMode::kLeafNodesCanvas);
+      {
+        SkAutoCanvasRestore auto_restore(canvas, true);
+        canvas->resetMatrix();
+        canvas->drawImageRect(filtered_backdrop_->image,
+                              filtered_backdrop_->src, filtered_backdrop_->dst,
+                              SkSamplingOptions(SkFilterMode::kLinear),
+                              nullptr, SkCanvas::kFast_SrcRectConstraint);
+      }
+      PaintChildren(context);
+      return;
+    }
+  }
+
   Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
       context,
       SkCanvas::SaveLayerRec{&paint_bounds(), &paint, filter_.get(), 0},
@@ -67,4 +122,86 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+std::optional<BackdropFilterLayer::FilteredBackdrop>
+BackdropFilterLayer::FilterBackdrop(const PaintContext& context) const {
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::FilterBackdrop");
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkSurface* surface = canvas->getSurface();
+  const SkMatrix& matrix = canvas->getTotalMatrix();
+  // The filter is applied in device space, which matches the saveLayer only
+  // when the matrix has no rotation, skew or perspective.
+  if (inside_save_layer_ || !surface || !matrix.isScaleTranslate()) {
+    return std::nullopt;
+  }
+
+  const SkIRect surface_bounds =
+      SkIRect::MakeWH(surface->width(), surface->height());
+  const SkIRect layer_bounds =
+      RasterCache::GetDeviceBounds(paint_bounds(), matrix);
+  SkIRect bounds = layer_bounds;
+  if (!bounds.intersect(surface_bounds)) {
+    return std::nullopt;
+  }
+  sk_sp<SkImageFilter> filter = filter_->makeWithLocalMatrix(matrix);
+  SkIRect readback = filter->filterBounds(bounds, SkMatrix::I(),
+                                          SkImageFilter::kReverse_MapDirection);
+  if (!readback.intersect(surface_bounds)) {
+    return std::nullopt;
+  }
+  sk_sp<SkImage> backdrop = surface->makeImageSnapshot(readback);
+  if (!backdrop) {
+    return std::nullopt;
+  }
+
+  // The backdrop is filtered in a space of |scale| device pixels per pixel
+  // with its origin at the origin of |readback|.
+  SkScalar scale = 1;
+  if (blur_sigma_) {
+    const SkScalar sigma_x =
+        blur_sigma_->width() * std::abs(matrix.getScaleX());
+    const SkScalar sigma_y =
+        blur_sigma_->height() * std::abs(matrix.getScaleY());
+    const SkScalar sigma = std::max(sigma_x, sigma_y);
+    if (sigma > kDownsampleBlurSigma) {
+      scale = std::max(kDownsampleBlurSigma / sigma, kMinDownsampleScale);
+      const SkRect downsampled_rect =
+          SkRect::MakeWH(readback.width() * scale, readback.height() * scale);
+      sk_sp<SkSurface> downsampled =
+          surface->makeSurface(std::ceil(downsampled_rect.width()),
+                               std::ceil(downsampled_rect.height()));
+      if (!downsampled) {
+        return std::nullopt;
+      }
+      downsampled->getCanvas()->drawImageRect(
+          backdrop, downsampled_rect, SkSamplingOptions(SkFilterMode::kLinear));
+      backdrop = downsampled->makeImageSnapshot();
+      filter = SkImageFilters::Blur(sigma_x * scale, sigma_y * scale,
+                                    blur_tile_mode_, nullptr);
+    }
+  }
+
+  SkRect clip_bounds =
+      SkRect::Make(bounds.makeOffset(-readback.x(), -readback.y()));
+  clip_bounds.setLTRB(clip_bounds.left() * scale, clip_bounds.top() * scale,
+                      clip_bounds.right() * scale,
+                      clip_bounds.bottom() * scale);
+  SkIRect subset;
+  SkIPoint offset;
+  sk_sp<SkImage> filtered = backdrop->makeWithFilter(
+      context.gr_context, filter.get(),
+      SkIRect::MakeSize(backdrop->dimensions()), clip_bounds.roundOut(),
+      &subset, &offset);
+  if (!filtered) {
+    return std::nullopt;
+  }
+
+  SkRect dst = SkRect::MakeXYWH(offset.x(), offset.y(), subset.width(),
+                                subset.height());
+  dst.setLTRB(readback.x() + dst.left() / scale,
+              readback.y() + dst.top() / scale,
+              readback.x() + dst.right() / scale,
+              readback.y() + dst.bottom() / scale);
+  return FilteredBackdrop{filtered, SkRect::Make(subset), dst, layer_bounds};
+}
+
 }  // namespace flutter
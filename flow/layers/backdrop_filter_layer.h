@@ -5,8 +5,12 @@
 #ifndef FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 
+#include <optional>
+
 #include "flutter/flow/layers/container_layer.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkTileMode.h"
 
 namespace flutter {
 
@@ -14,15 +18,62 @@ class BackdropFilterLayer : public ContainerLayer {
  public:
   BackdropFilterLayer(sk_sp<SkImageFilter> filter, SkBlendMode blend_mode);
 
+  // Tells the layer that its filter is a Gaussian blur with these sigmas, so
+  // that it may blur a downsampled backdrop when the sigmas are large.
+  void set_blur(SkSize sigma, SkTileMode tile_mode) {
+    blur_sigma_ = sigma;
+    blur_tile_mode_ = tile_mode;
+  }
+
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "BackdropFilterLayer"; }
+
+  // The readback affects the raster cache decisions of the layers prerolled
+  // after it.
+  bool can_preroll_concurrently() const override { return false; }
+
  private:
+  // Above this sigma, in physical pixels, a blur is applied to a backdrop
+  // downsampled so that the sigma becomes this one. The blur hides the loss
+  // of the details, while its cost grows with the number of pixels.
+  static constexpr SkScalar kDownsampleBlurSigma = 8.0f;
+  static constexpr SkScalar kMinDownsampleScale = 0.125f;
+
+  // The backdrop with the filter applied, and where it is drawn.
+  struct FilteredBackdrop {
+    sk_sp<SkImage> image;
+    SkRect src;
+    // In device coordinates.
+    SkRect dst;
+    // The device bounds of the layer when the backdrop was filtered.
+    SkIRect layer_bounds;
+  };
+
+  // Filters the backdrop of the layer itself rather than through a saveLayer,
+  // so that the result can be kept for the next frames. Returns nullopt when
+  // the backdrop can't be read from the surface the layer is painted on.
+  std::optional<FilteredBackdrop> FilterBackdrop(
+      const PaintContext& context) const;
+
   sk_sp<SkImageFilter> filter_;
   SkBlendMode blend_mode_;
+  std::optional<SkSize> blur_sigma_;
+  SkTileMode blur_tile_mode_ = SkTileMode::kClamp;
+
+  // The region the filter reads back, in screen coordinates, as of the last
+  // Diff.
+  SkIRect readback_bounds_ = SkIRect::MakeEmpty();
+  // Whether the layer is painted into the saveLayer of an ancestor, where the
+  // backdrop is the content of that layer rather than of the surface.
+  bool inside_save_layer_ = false;
+  // Painted in the previous frame, or taken over from the layer this one
+  // replaces when the backdrop is unchanged.
+  mutable std::optional<FilteredBackdrop> filtered_backdrop_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
@@ -327,5 +327,43 @@ TEST_F(BackdropLayerDiffTest, BackdropLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 190, 190));
 }
 
+TEST_F(BackdropLayerDiffTest, BackdropUnchangedUnlessDamagedUnderneath) {
+  auto filter = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  auto backdrop =
+      std::make_shared<BackdropFilterLayer>(filter, SkBlendMode::kSrcOver);
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeLTRB(20, 20, 60, 60),
+                                              Clip::hardEdge);
+  clip->Add(backdrop);
+
+  auto diff = [](MockLayerTree& layer_tree,
+                 const MockLayerTree& old_layer_tree) {
+    DiffContext dc(layer_tree.size(), 1, layer_tree.paint_region_map(),
+                   old_layer_tree.paint_region_map());
+    dc.PushCullRect(SkRect::MakeIWH(layer_tree.size().width(),
+                                    layer_tree.size().height()));
+    layer_tree.root()->Diff(&dc, old_layer_tree.root());
+    return dc.TakeUnchangedBackdrops();
+  };
+
+  MockLayerTree l1(SkISize::Make(100, 100));
+  l1.root()->Add(clip);
+  EXPECT_TRUE(diff(l1, MockLayerTree(SkISize::Make(100, 100))).empty());
+
+  // path under the layer, just outside of readback region
+  MockLayerTree l2(SkISize::Make(100, 100));
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(90, 90, 95, 95));
+  l2.root()->Add(std::make_shared<MockLayer>(path1));
+  l2.root()->Add(clip);
+  EXPECT_EQ(diff(l2, l1),
+            std::unordered_set<uint64_t>({backdrop->unique_id()}));
+
+  // path under the layer, just inside of readback region
+  MockLayerTree l3(SkISize::Make(100, 100));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(89, 89, 95, 95));
+  l3.root()->Add(std::make_shared<MockLayer>(path2));
+  l3.root()->Add(clip);
+  EXPECT_TRUE(diff(l3, l2).empty());
+}
+
 }  // namespace testing
 }  // namespace flutter
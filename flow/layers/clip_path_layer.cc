@@ -42,9 +42,24 @@ void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
+  children_inside_clip_ = CanElideClip(
+      clip_path_.conservativelyContainsRect(child_paint_bounds),
+      UsesSaveLayer());
   if (child_paint_bounds.intersect(clip_path_bounds)) {
     set_paint_bounds(child_paint_bounds);
   }
+  SkRect clip_inner_bounds;
+  SkRRect clip_rrect;
+  if (clip_path_.isRRect(&clip_rrect)) {
+    clip_inner_bounds = GetRRectInnerBounds(clip_rrect);
+  } else if (!clip_path_.isRect(&clip_inner_bounds)) {
+    clip_inner_bounds.setEmpty();
+  }
+  SkRect opaque_bounds = children_opaque_bounds();
+  if (!opaque_bounds.intersect(clip_inner_bounds)) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_bounds(opaque_bounds);
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -55,8 +70,10 @@ void ClipPathLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipPath(clip_path_,
-                                          clip_behavior_ != Clip::hardEdge);
+  if (!children_inside_clip_) {
+    context.internal_nodes_canvas->clipPath(clip_path_,
+                                            clip_behavior_ != Clip::hardEdge);
+  }
 
   if (UsesSaveLayer()) {
     TRACE_EVENT0("flutter", "Canvas::saveLayer");
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/layers/clip_rect_layer.h"
+
 #include "flutter/flow/paint_utils.h"
 
 namespace flutter {
@@ -41,9 +42,16 @@ void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
+  children_inside_clip_ =
+      CanElideClip(clip_rect_.contains(child_paint_bounds), UsesSaveLayer());
   if (child_paint_bounds.intersect(clip_rect_)) {
     set_paint_bounds(child_paint_bounds);
   }
+  SkRect opaque_bounds = children_opaque_bounds();
+  if (!opaque_bounds.intersect(clip_rect_)) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_bounds(opaque_bounds);
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -54,8 +62,10 @@ void ClipRectLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipRect(clip_rect_,
-                                          clip_behavior_ != Clip::hardEdge);
+  if (!children_inside_clip_) {
+    context.internal_nodes_canvas->clipRect(clip_rect_,
+                                            clip_behavior_ != Clip::hardEdge);
+  }
 
   if (UsesSaveLayer()) {
     TRACE_EVENT0("flutter", "Canvas::saveLayer");
@@ -70,4 +80,17 @@ void ClipRectLayer::Paint(PaintContext& context) const {
   }
 }
 
+bool ClipRectLayer::MergeChild(const Layer* child) {
+  // Two clips to rects intersect to a clip to a rect if they clip alike.
+  // Clips with a save layer each isolate their children, so they are kept.
+  const ClipRectLayer* clip = child->as_clip_rect_layer();
+  if (!clip || clip->clip_behavior_ != clip_behavior_ || UsesSaveLayer()) {
+    return false;
+  }
+  if (!clip_rect_.intersect(clip->clip_rect_)) {
+    clip_rect_.setEmpty();
+  }
+  return true;
+}
+
 }  // namespace flutter
@@ -18,13 +18,21 @@ class ClipRectLayer : public ContainerLayer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "ClipRectLayer"; }
+
+  const ClipRectLayer* as_clip_rect_layer() const override { return this; }
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
+ protected:
+  bool MergeChild(const Layer* child) override;
+
  private:
   SkRect clip_rect_;
   Clip clip_behavior_;
+  bool children_inside_clip_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRectLayer);
 };
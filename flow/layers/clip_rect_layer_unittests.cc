@@ -140,14 +140,12 @@ TEST_F(ClipRectLayerTest, FullyContainedChild) {
   EXPECT_EQ(mock_layer->parent_mutators(),
             std::vector({Mutator(layer_bounds)}));
 
+  // The child lies inside the clip, so the clip is elided.
   layer->Paint(paint_context());
   EXPECT_EQ(
       mock_canvas().draw_calls(),
       std::vector(
           {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
            MockCanvas::DrawCall{
                1, MockCanvas::DrawPathData{child_path, child_paint}},
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
@@ -182,6 +180,37 @@ TEST_F(ClipRectLayerTest, PartiallyContainedChild) {
   EXPECT_EQ(mock_layer->parent_mutators(),
             std::vector({Mutator(layer_bounds)}));
 
+  // The child extends past the clip, so the clip is kept.
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
+                                           MockCanvas::kHard_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
+TEST_F(ClipRectLayerTest, FullyContainedPlatformViewKeepsClip) {
+  const SkMatrix initial_matrix = SkMatrix::Translate(0.5f, 1.0f);
+  const SkRect child_bounds = SkRect::MakeXYWH(1.0, 2.0, 2.0, 2.0);
+  const SkRect layer_bounds = SkRect::MakeXYWH(0.5, 1.0, 5.0, 6.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(
+      child_path, child_paint, true /* fake_has_platform_view */);
+  auto layer = std::make_shared<ClipRectLayer>(layer_bounds, Clip::hardEdge);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), initial_matrix);
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  EXPECT_EQ(layer->paint_bounds(), child_bounds);
+
+  // The embedder relies on the clip of a platform view, so it is kept even
+  // though the platform view lies inside it.
   layer->Paint(paint_context());
   EXPECT_EQ(
       mock_canvas().draw_calls(),
@@ -195,6 +224,38 @@ TEST_F(ClipRectLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipRectLayerTest, FullyContainedChildWithSaveLayerKeepsClip) {
+  const SkMatrix initial_matrix = SkMatrix::Translate(0.5f, 1.0f);
+  const SkRect child_bounds = SkRect::MakeXYWH(1.0, 2.0, 2.0, 2.0);
+  const SkRect layer_bounds = SkRect::MakeXYWH(0.5, 1.0, 5.0, 6.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ClipRectLayer>(layer_bounds,
+                                               Clip::antiAliasWithSaveLayer);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), initial_matrix);
+  EXPECT_EQ(layer->paint_bounds(), child_bounds);
+
+  // The save layer is bounded by the clip, so the clip is kept.
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
+                                           MockCanvas::kSoft_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::SaveLayerData{layer_bounds, SkPaint(), nullptr,
+                                            2}},
+           MockCanvas::DrawCall{
+               2, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{2, MockCanvas::RestoreData{1}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
@@ -254,5 +315,39 @@ TEST_F(ClipRectLayerTest, Readback) {
   EXPECT_TRUE(ReadbackResult(context, save_layer, reader, true));
 }
 
+TEST_F(ClipRectLayerTest, FlattenMergesNestedClips) {
+  const SkRect outer_bounds = SkRect::MakeXYWH(0.0, 0.0, 10.0, 10.0);
+  const SkRect inner_bounds = SkRect::MakeXYWH(5.0, 5.0, 10.0, 10.0);
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(20.0, 20.0));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto inner = std::make_shared<ClipRectLayer>(inner_bounds, Clip::hardEdge);
+  inner->Add(mock_layer);
+  auto outer = std::make_shared<ClipRectLayer>(outer_bounds, Clip::hardEdge);
+  outer->Add(inner);
+
+  outer->Flatten([](const Layer*) { return false; });
+  ASSERT_EQ(outer->layers().size(), 1u);
+  EXPECT_EQ(outer->layers()[0], mock_layer);
+
+  outer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(outer->paint_bounds(), SkRect::MakeXYWH(5.0, 5.0, 5.0, 5.0));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(SkRect::MakeXYWH(5.0, 5.0, 5.0, 5.0))}));
+}
+
+TEST_F(ClipRectLayerTest, FlattenKeepsClipsWithDifferentBehavior) {
+  const SkRect bounds = SkRect::MakeXYWH(0.0, 0.0, 10.0, 10.0);
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(20.0, 20.0));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto inner = std::make_shared<ClipRectLayer>(bounds, Clip::antiAlias);
+  inner->Add(mock_layer);
+  auto outer = std::make_shared<ClipRectLayer>(bounds, Clip::hardEdge);
+  outer->Add(inner);
+
+  outer->Flatten([](const Layer*) { return false; });
+  ASSERT_EQ(outer->layers().size(), 1u);
+  EXPECT_EQ(outer->layers()[0], inner);
+}
+
 }  // namespace testing
 }  // namespace flutter
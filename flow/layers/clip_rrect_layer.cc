@@ -42,9 +42,16 @@ void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
+  children_inside_clip_ =
+      CanElideClip(clip_rrect_.contains(child_paint_bounds), UsesSaveLayer());
   if (child_paint_bounds.intersect(clip_rrect_bounds)) {
     set_paint_bounds(child_paint_bounds);
   }
+  SkRect opaque_bounds = children_opaque_bounds();
+  if (!opaque_bounds.intersect(GetRRectInnerBounds(clip_rrect_))) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_bounds(opaque_bounds);
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -55,8 +62,10 @@ void ClipRRectLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipRRect(clip_rrect_,
-                                           clip_behavior_ != Clip::hardEdge);
+  if (!children_inside_clip_) {
+    context.internal_nodes_canvas->clipRRect(clip_rrect_,
+                                             clip_behavior_ != Clip::hardEdge);
+  }
 
   if (UsesSaveLayer()) {
     TRACE_EVENT0("flutter", "Canvas::saveLayer");
@@ -29,6 +29,15 @@ void ColorFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The filter can change the alpha of the children.
+  set_opaque_bounds(SkRect::MakeEmpty());
+
+  // A color filter maps each pixel on its own, so it can be applied while
+  // drawing the cached children. A filter that animates from frame to frame
+  // then only costs a draw of the cached image.
+  if (ChildrenWorthCaching()) {
+    TryToPrepareRasterCache(context, GetCacheableChild(), matrix);
+  }
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
@@ -38,9 +47,15 @@ void ColorFilterLayer::Paint(PaintContext& context) const {
   SkPaint paint;
   paint.setColorFilter(filter_);
 
+  if (context.raster_cache &&
+      context.raster_cache->Draw(GetCacheableChild(),
+                                 *context.leaf_nodes_canvas, &paint)) {
+    return;
+  }
+
   Layer::AutoSaveLayer save =
       Layer::AutoSaveLayer::Create(context, paint_bounds(), &paint);
-  PaintChildren(context);
+  PaintChildrenTimed(context);
 }
 
 }  // namespace flutter
@@ -10,7 +10,7 @@
 
 namespace flutter {
 
-class ColorFilterLayer : public ContainerLayer {
+class ColorFilterLayer : public MergedContainerLayer {
  public:
   ColorFilterLayer(sk_sp<SkColorFilter> filter);
 
@@ -20,6 +20,8 @@ class ColorFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "ColorFilterLayer"; }
+
  private:
   sk_sp<SkColorFilter> filter_;
 
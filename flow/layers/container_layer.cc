@@ -4,10 +4,22 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <optional>
 
+#include "flutter/flow/layer_profiler.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
+
 namespace flutter {
 
+// The least number of children whose preroll is split across worker
+// threads. Fewer children are not worth the cost of the tasks.
+static constexpr size_t kMinConcurrentPrerollChildren = 2;
+
 ContainerLayer::ContainerLayer() {}
 
 void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
@@ -91,6 +103,7 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // associate their paint region with current layer tree so that we can
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
+        context->MarkLayerRetained(layer.get());
       } else {
         layer->Diff(context, prev_layer.get());
       }
@@ -113,6 +126,7 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_bounds(children_opaque_bounds());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -127,6 +141,15 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // Platform views have no children, so context->has_platform_view should
   // always be false.
   FML_DCHECK(!context->has_platform_view);
+  // Subtrees that are prerolled on a worker thread are prerolled
+  // sequentially within that thread.
+  if (context->concurrent_task_runner && !context->raster_cache_ops &&
+      layers_.size() >= kMinConcurrentPrerollChildren &&
+      can_preroll_concurrently()) {
+    PrerollChildrenConcurrently(context, child_matrix, child_paint_bounds);
+    ComputeOccludedChildren(child_matrix);
+    return;
+  }
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   for (auto& layer : layers_) {
@@ -135,7 +158,11 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // sibling tree.
     context->has_platform_view = false;
 
-    layer->Preroll(context, child_matrix);
+    {
+      LayerProfiler::ScopedLayer profile(context->layer_profiler, layer.get(),
+                                         LayerProfiler::Phase::kPreroll);
+      layer->PrerollSubtree(context, child_matrix);
+    }
     child_paint_bounds->join(layer->paint_bounds());
 
     child_has_platform_view =
@@ -147,6 +174,160 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   set_subtree_has_platform_view(child_has_platform_view);
+  ComputeOccludedChildren(child_matrix);
+}
+
+void ContainerLayer::ComputeOccludedChildren(const SkMatrix& child_matrix) {
+  occluded_children_.assign(layers_.size(), false);
+  children_opaque_bounds_.setEmpty();
+  // The embedders expect every prerolled platform view to be painted, see
+  // needs_painting.
+  if (subtree_has_platform_view()) {
+    return;
+  }
+  bool can_occlude = child_matrix.rectStaysRect();
+  // The device pixels that are fully covered by the opaque bounds of one of
+  // the children above the current one. Only whole pixels are counted so
+  // that the anti-aliased edges of the occluder can't reveal the children
+  // that are skipped.
+  SkIRect occluder = SkIRect::MakeEmpty();
+  for (size_t i = layers_.size(); i-- > 0;) {
+    const Layer* layer = layers_[i].get();
+    if (can_occlude && !layer->paint_bounds().isEmpty() &&
+        occluder.contains(
+            child_matrix.mapRect(layer->paint_bounds()).roundOut())) {
+      occluded_children_[i] = true;
+      continue;
+    }
+    const SkRect& opaque_bounds = layer->opaque_bounds();
+    if (opaque_bounds.isEmpty()) {
+      continue;
+    }
+    if (opaque_bounds.width() * opaque_bounds.height() >
+        children_opaque_bounds_.width() * children_opaque_bounds_.height()) {
+      children_opaque_bounds_ = opaque_bounds;
+    }
+    if (can_occlude) {
+      SkIRect device_bounds = child_matrix.mapRect(opaque_bounds).roundIn();
+      if (int64_t{device_bounds.width()} * device_bounds.height() >
+          int64_t{occluder.width()} * occluder.height()) {
+        occluder = device_bounds;
+      }
+    }
+  }
+}
+
+SkRect ContainerLayer::GetRRectInnerBounds(const SkRRect& rrect) {
+  // The rect minus the widest corners horizontally, or minus the tallest
+  // corners vertically, whichever is larger.
+  SkScalar radius_x = 0;
+  SkScalar radius_y = 0;
+  for (int corner = 0; corner < 4; corner++) {
+    SkVector radii = rrect.radii(static_cast<SkRRect::Corner>(corner));
+    radius_x = std::max(radius_x, radii.fX);
+    radius_y = std::max(radius_y, radii.fY);
+  }
+  SkRect tall = rrect.rect().makeInset(radius_x, 0);
+  SkRect wide = rrect.rect().makeInset(0, radius_y);
+  return tall.width() * tall.height() > wide.width() * wide.height() ? tall
+                                                                     : wide;
+}
+
+bool ContainerLayer::can_preroll_concurrently() const {
+  for (auto& layer : layers_) {
+    if (!layer->can_preroll_concurrently()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ContainerLayer::PrerollChildrenConcurrently(PrerollContext* context,
+                                                 const SkMatrix& child_matrix,
+                                                 SkRect* child_paint_bounds) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenConcurrently");
+
+  // The state of the preroll of one child. The child starts from a copy of
+  // the state of the |context| and records its calls to the raster cache.
+  struct ChildPreroll {
+    ChildPreroll(const PrerollContext* parent, Layer* layer)
+        : layer(layer),
+          mutators_stack(parent->mutators_stack),
+          context{parent->raster_cache,
+                  parent->gr_context,
+                  parent->view_embedder,
+                  mutators_stack,
+                  parent->dst_color_space,
+                  parent->cull_rect,
+                  parent->surface_needs_readback,
+                  parent->raster_time,
+                  parent->ui_time,
+                  parent->texture_registry,
+                  parent->checkerboard_offscreen_layers,
+                  parent->frame_device_pixel_ratio,
+                  parent->has_platform_view,
+                  parent->has_texture_layer,
+                  /* concurrent_task_runner= */ nullptr,
+                  &raster_cache_ops,
+                  parent->retained_layers,
+                  parent->save_layer_depth} {}
+
+    Layer* layer;
+    MutatorsStack mutators_stack;
+    DeferredRasterCacheOps raster_cache_ops;
+    PrerollContext context;
+  };
+
+  // Shared with the worker tasks, which may outlive this call if they only
+  // start once all of the children have been prerolled.
+  struct State {
+    explicit State(size_t count) : latch(count) {}
+
+    std::vector<std::unique_ptr<ChildPreroll>> children;
+    std::atomic_size_t next_child = 0;
+    fml::CountDownLatch latch;
+  };
+
+  auto state = std::make_shared<State>(layers_.size());
+  for (auto& layer : layers_) {
+    state->children.push_back(
+        std::make_unique<ChildPreroll>(context, layer.get()));
+  }
+
+  auto preroll = [state, child_matrix]() {
+    size_t index;
+    while ((index = state->next_child++) < state->children.size()) {
+      ChildPreroll& child = *state->children[index];
+      child.layer->PrerollSubtree(&child.context, child_matrix);
+      state->latch.CountDown();
+    }
+  };
+  for (size_t i = 1; i < layers_.size(); i++) {
+    context->concurrent_task_runner->PostTask(preroll);
+  }
+  // The raster thread takes part so that the preroll completes even if the
+  // workers are busy.
+  preroll();
+  state->latch.Wait();
+
+  bool child_has_texture_layer = context->has_texture_layer;
+  bool child_needs_readback = context->surface_needs_readback;
+  for (auto& child : state->children) {
+    child_paint_bounds->join(child->layer->paint_bounds());
+    child_has_texture_layer =
+        child_has_texture_layer || child->context.has_texture_layer;
+    child_needs_readback =
+        child_needs_readback || child->context.surface_needs_readback;
+    for (auto& op : child->raster_cache_ops) {
+      op(context);
+    }
+  }
+
+  // The children have no platform views, see can_preroll_concurrently.
+  context->has_platform_view = false;
+  context->has_texture_layer = child_has_texture_layer;
+  context->surface_needs_readback = child_needs_readback;
+  set_subtree_has_platform_view(false);
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -158,8 +339,20 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
 
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
-  for (auto& layer : layers_) {
+  for (size_t i = 0; i < layers_.size(); i++) {
+    const Layer* layer = layers_[i].get();
+    // Children that are hidden by the opaque children above them are
+    // skipped, see ComputeOccludedChildren.
+    if (i < occluded_children_.size() && occluded_children_[i]) {
+      continue;
+    }
     if (layer->needs_painting(context)) {
+      LayerProfiler::ScopedLayer profile(context.layer_profiler, layer,
+                                         LayerProfiler::Phase::kPaint);
+      if (layer->subtree_raster_cached() &&
+          layer->DrawSubtreeFromRasterCache(context)) {
+        continue;
+      }
       layer->Paint(context);
     }
   }
@@ -174,7 +367,30 @@ void ContainerLayer::TryToPrepareRasterCache(PrerollContext* context,
     context->raster_cache->Prepare(context, layer, matrix);
   } else if (context->raster_cache) {
     // Don't evict raster cache entry during partial repaint
-    context->raster_cache->Touch(layer, matrix);
+    context->raster_cache->Touch(context, layer, matrix);
+  }
+}
+
+void ContainerLayer::Flatten(
+    const std::function<bool(const Layer*)>& is_shared) {
+  for (auto& child : layers_) {
+    if (is_shared(child.get())) {
+      continue;
+    }
+    child->Flatten(is_shared);
+    // An identity transform with a single child paints just like that
+    // child. Its own children are flattened already, so one step is enough.
+    const TransformLayer* transform = child->as_transform_layer();
+    if (transform && transform->layers().size() == 1 &&
+        transform->transform().isIdentity()) {
+      child = transform->layers()[0];
+    }
+  }
+  while (layers_.size() == 1 && !is_shared(layers_[0].get()) &&
+         MergeChild(layers_[0].get())) {
+    std::vector<std::shared_ptr<Layer>> grandchildren =
+        layers_[0]->as_container_layer()->layers_;
+    layers_ = std::move(grandchildren);
   }
 }
 
@@ -217,6 +433,12 @@ ContainerLayer* MergedContainerLayer::GetChildContainer() const {
   return static_cast<ContainerLayer*>(layers()[0].get());
 }
 
+void MergedContainerLayer::Flatten(
+    const std::function<bool(const Layer*)>& is_shared) {
+  // The child container has to remain the only child of this layer.
+  GetChildContainer()->Flatten(is_shared);
+}
+
 Layer* MergedContainerLayer::GetCacheableChild() const {
   ContainerLayer* child_container = GetChildContainer();
   if (child_container->layers().size() == 1) {
@@ -226,4 +448,48 @@ Layer* MergedContainerLayer::GetCacheableChild() const {
   return child_container;
 }
 
+// Adds the complexity scores of the display lists in the subtree of the
+// |layer| to |score|, stopping once it exceeds |limit|. Returns false if the
+// subtree has layers whose cost cannot be scored.
+static bool AddComplexityScore(const Layer* layer,
+                               unsigned int limit,
+                               unsigned int* score) {
+  if (const DisplayListLayer* display_list_layer =
+          layer->as_display_list_layer()) {
+    *score += display_list_layer->display_list()->complexity_score();
+    return true;
+  }
+  const ContainerLayer* container = layer->as_container_layer();
+  if (!container) {
+    return false;
+  }
+  for (auto& child : container->layers()) {
+    if (*score > limit) {
+      break;
+    }
+    if (!AddComplexityScore(child.get(), limit, score)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MergedContainerLayer::ChildrenWorthCaching() const {
+  if (children_paint_time_ >= kMinimumPaintTimeForCaching) {
+    return true;
+  }
+  unsigned int score = 0;
+  if (!AddComplexityScore(GetChildContainer(),
+                          kMinimumComplexityScoreForCaching, &score)) {
+    return true;
+  }
+  return score > kMinimumComplexityScoreForCaching;
+}
+
+void MergedContainerLayer::PaintChildrenTimed(PaintContext& context) const {
+  fml::TimePoint start = fml::TimePoint::Now();
+  PaintChildren(context);
+  children_paint_time_ = fml::TimePoint::Now() - start;
+}
+
 }  // namespace flutter
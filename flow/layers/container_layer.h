@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/fml/time/time_delta.h"
 
 namespace flutter {
 
@@ -23,8 +24,23 @@ class ContainerLayer : public Layer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "ContainerLayer"; }
+
+  bool can_preroll_concurrently() const override;
+
+  // Replaces the identity TransformLayers with a single child in the subtree
+  // by that child, and lets the layers absorb a single child whose effect they
+  // can fold into their own (see |MergeChild|).
+  //
+  // Layers for which |is_shared| returns true may also be part of a layer
+  // tree that is being rasterized, so neither they nor their subtrees are
+  // modified.
+  void Flatten(const std::function<bool(const Layer*)>& is_shared) override;
+
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
+  const ContainerLayer* as_container_layer() const override { return this; }
+
   virtual void DiffChildren(DiffContext* context,
                             const ContainerLayer* old_layer);
 
@@ -34,6 +50,32 @@ class ContainerLayer : public Layer {
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
 
+  // The largest of the opaque bounds of the children, as of the last call
+  // to PrerollChildren. Layers that paint their children unmodified can use
+  // them as their own opaque bounds.
+  const SkRect& children_opaque_bounds() const {
+    return children_opaque_bounds_;
+  }
+
+  // Whether a clip of this layer can be left out of Paint, given whether its
+  // shape contains the paint bounds of all of the children as of the last
+  // call to PrerollChildren. Such a clip has no visible effect, but platform
+  // views and clips with a save layer keep it, as the embedder and the layer
+  // bounds rely on it.
+  bool CanElideClip(bool clip_contains_children, bool uses_save_layer) const {
+    return clip_contains_children && !uses_save_layer &&
+           !subtree_has_platform_view();
+  }
+
+  // Folds the effect of |child|, the only child of this layer, into the
+  // effect of this layer and returns true, or returns false if they do not
+  // combine. If it returns true, the children of |child| become the children
+  // of this layer.
+  virtual bool MergeChild(const Layer* child) { return false; }
+
+  // Returns the largest rect that is contained within the |rrect|.
+  static SkRect GetRRectInnerBounds(const SkRRect& rrect);
+
   // Try to prepare the raster cache for a given layer.
   //
   // The raster cache would fail if either of the followings is true:
@@ -49,7 +91,21 @@ class ContainerLayer : public Layer {
                                       const SkMatrix& matrix);
 
  private:
+  // Prerolls each of the children on a worker thread of the
+  // concurrent_task_runner of the |context|, then replays their calls to the
+  // raster cache in order.
+  void PrerollChildrenConcurrently(PrerollContext* context,
+                                   const SkMatrix& child_matrix,
+                                   SkRect* child_paint_bounds);
+
+  // Determines which of the children are hidden entirely by the opaque
+  // bounds of the children above them once they are transformed to device
+  // pixels by the |child_matrix|, so that PaintChildren can skip them.
+  void ComputeOccludedChildren(const SkMatrix& child_matrix);
+
   std::vector<std::shared_ptr<Layer>> layers_;
+  std::vector<bool> occluded_children_;
+  SkRect children_opaque_bounds_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -104,6 +160,8 @@ class MergedContainerLayer : public ContainerLayer {
   void DiffChildren(DiffContext* context,
                     const ContainerLayer* old_layer) override;
 
+  void Flatten(const std::function<bool(const Layer*)>& is_shared) override;
+
  protected:
   /**
    * @brief Returns the ContainerLayer used to hold all of the children of the
@@ -128,7 +186,38 @@ class MergedContainerLayer : public ContainerLayer {
    */
   Layer* GetCacheableChild() const;
 
+  /**
+   * @brief Estimates whether the children are expensive enough to draw that
+   * rasterizing them into the raster cache pays for itself.
+   *
+   * The estimate is based on the complexity scores of the display lists
+   * among the children and on the time that the last Paint of the children
+   * outside of the raster cache took. Children whose cost is not known, such
+   * as pictures or textures, are assumed to be worth caching.
+   *
+   * @see PaintChildrenTimed()
+   */
+  bool ChildrenWorthCaching() const;
+
+  /**
+   * @brief Paints the children like PaintChildren() and records how long it
+   * took, for ChildrenWorthCaching().
+   */
+  void PaintChildrenTimed(PaintContext& context) const;
+
  private:
+  // The combined complexity score of the display lists of the children
+  // above which they are worth caching. Matches the threshold that the
+  // RasterCache applies to a single display list.
+  static constexpr unsigned int kMinimumComplexityScoreForCaching = 5;
+
+  // The time to paint the children above which they are worth caching
+  // regardless of their complexity score.
+  static constexpr fml::TimeDelta kMinimumPaintTimeForCaching =
+      fml::TimeDelta::FromMicroseconds(200);
+
+  mutable fml::TimeDelta children_paint_time_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(MergedContainerLayer);
 };
 
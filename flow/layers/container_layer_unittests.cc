@@ -4,9 +4,12 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -251,6 +254,304 @@ TEST_F(ContainerLayerTest, MergedMultipleChildren) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(ContainerLayerTest, PrerollChildrenConcurrently) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  preroll_context()->concurrent_task_runner = task_runner.get();
+
+  SkPath child_path1;
+  child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPath child_path2;
+  child_path2.addRect(8.0f, 2.0f, 16.5f, 14.5f);
+  SkPath child_path3;
+  child_path3.addRect(30.0f, 40.0f, 50.0f, 60.0f);
+  SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+  preroll_context()->mutators_stack.PushTransform(initial_transform);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2);
+  auto mock_layer3 = std::make_shared<MockLayer>(child_path3);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+  layer->Add(mock_layer3);
+  ASSERT_TRUE(layer->can_preroll_concurrently());
+
+  SkRect expected_total_bounds = child_path1.getBounds();
+  expected_total_bounds.join(child_path2.getBounds());
+  expected_total_bounds.join(child_path3.getBounds());
+  layer->Preroll(preroll_context(), initial_transform);
+  EXPECT_FALSE(preroll_context()->has_platform_view);
+  EXPECT_FALSE(preroll_context()->surface_needs_readback);
+  EXPECT_EQ(layer->paint_bounds(), expected_total_bounds);
+  for (auto& mock_layer : {mock_layer1, mock_layer2, mock_layer3}) {
+    EXPECT_EQ(mock_layer->parent_matrix(), initial_transform);
+    EXPECT_EQ(mock_layer->parent_cull_rect(), kGiantRect);
+    EXPECT_EQ(mock_layer->parent_mutators(), preroll_context()->mutators_stack);
+  }
+  loop->Terminate();
+}
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollReplaysRasterCacheCalls) {
+  use_mock_raster_cache();
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  preroll_context()->concurrent_task_runner = task_runner.get();
+
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto opacity_layer1 =
+      std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  opacity_layer1->Add(std::make_shared<MockLayer>(child_path));
+  auto opacity_layer2 =
+      std::make_shared<OpacityLayer>(64, SkPoint::Make(0, 0));
+  opacity_layer2->Add(std::make_shared<MockLayer>(child_path));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(opacity_layer1);
+  layer->Add(opacity_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), 2u);
+  loop->Terminate();
+}
+
+TEST_F(ContainerLayerTest, PlatformViewsPreventConcurrentPreroll) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockLayer>(child_path));
+  auto nested = std::make_shared<ContainerLayer>();
+  nested->Add(std::make_shared<MockLayer>(child_path, SkPaint(), true));
+  layer->Add(nested);
+
+  EXPECT_FALSE(nested->can_preroll_concurrently());
+  EXPECT_FALSE(layer->can_preroll_concurrently());
+}
+
+TEST_F(ContainerLayerTest, RetainedLayerReusesPreroll) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained_layer = std::make_shared<ContainerLayer>();
+  retained_layer->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained_layer);
+
+  std::unordered_set<uint64_t> retained_layers = {retained_layer->unique_id()};
+  preroll_context()->retained_layers = &retained_layers;
+
+  // The first preroll of the retained layer records its results.
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+  EXPECT_TRUE(mock_layer->parent_mutators().is_empty());
+
+  // The mutators are not an input of the cached preroll, so a change to them
+  // shows whether the child was prerolled again.
+  preroll_context()->mutators_stack.PushOpacity(128);
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+  EXPECT_TRUE(mock_layer->parent_mutators().is_empty());
+
+  // A different transform prerolls the subtree again.
+  SkMatrix transform = SkMatrix::Translate(5, 5);
+  layer->Preroll(preroll_context(), transform);
+  EXPECT_EQ(mock_layer->parent_matrix(), transform);
+  EXPECT_FALSE(mock_layer->parent_mutators().is_empty());
+
+  // So does a layer that is not retained.
+  preroll_context()->mutators_stack.Pop();
+  retained_layers.clear();
+  layer->Preroll(preroll_context(), transform);
+  EXPECT_TRUE(mock_layer->parent_mutators().is_empty());
+}
+
+TEST_F(ContainerLayerTest, ReusedLayerIsDrawnFromRasterCache) {
+  use_mock_raster_cache();
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto reused_layer = std::make_shared<ContainerLayer>();
+  reused_layer->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(reused_layer);
+
+  std::unordered_set<uint64_t> reused_layers = {reused_layer->unique_id()};
+  preroll_context()->reused_layers = &reused_layers;
+
+  // The subtree is rasterized once it has been reused for as many frames as
+  // the access threshold of the cache.
+  for (int i = 0; i < 3; i++) {
+    layer->Preroll(preroll_context(), SkMatrix::I());
+    EXPECT_FALSE(reused_layer->subtree_raster_cached());
+  }
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), 0u);
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_TRUE(reused_layer->subtree_raster_cached());
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), 1u);
+
+  // From then on the subtree is not prerolled. The mutators show whether the
+  // child was prerolled again.
+  preroll_context()->mutators_stack.PushOpacity(128);
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_TRUE(reused_layer->subtree_raster_cached());
+  EXPECT_TRUE(mock_layer->parent_mutators().is_empty());
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  // The image can be drawn at any whole pixel translation.
+  layer->Preroll(preroll_context(), SkMatrix::Translate(10, 20));
+  EXPECT_TRUE(reused_layer->subtree_raster_cached());
+  EXPECT_TRUE(mock_layer->parent_mutators().is_empty());
+#endif
+
+  // A scale needs a new image, so the subtree is prerolled again.
+  layer->Preroll(preroll_context(), SkMatrix::Scale(2, 2));
+  EXPECT_FALSE(mock_layer->parent_mutators().is_empty());
+
+  // Layers that are not reused are never drawn from the cache.
+  preroll_context()->mutators_stack.Pop();
+  reused_layers.clear();
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_FALSE(reused_layer->subtree_raster_cached());
+  EXPECT_TRUE(mock_layer->parent_mutators().is_empty());
+}
+
+TEST_F(ContainerLayerTest, OpaqueChildOccludesChildrenBelow) {
+  SkPath child_path1;
+  child_path1.addRect(5.0f, 5.0f, 15.0f, 15.0f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 20.0f, 20.0f);
+  SkPath child_path3;
+  child_path3.addRect(10.0f, 10.0f, 30.0f, 30.0f);
+  SkPaint child_paint1(SkColors::kGray);
+  SkPaint child_paint2(SkColors::kGreen);
+  SkPaint child_paint3(SkColors::kBlue);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint1);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2, child_paint2);
+  auto mock_layer3 = std::make_shared<MockLayer>(child_path3, child_paint3);
+  mock_layer2->set_opaque_bounds(child_path2.getBounds());
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+  layer->Add(mock_layer3);
+
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(layer->opaque_bounds(), child_path2.getBounds());
+
+  // The first child is hidden by the second, the third paints over it.
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector({MockCanvas::DrawCall{
+                       0, MockCanvas::DrawPathData{child_path2, child_paint2}},
+                   MockCanvas::DrawCall{0, MockCanvas::DrawPathData{
+                                               child_path3, child_paint3}}}));
+}
+
+TEST_F(ContainerLayerTest, PartiallyCoveredPixelsDoNotOcclude) {
+  SkPath child_path1;
+  child_path1.addRect(0.0f, 0.0f, 20.0f, 20.0f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 20.0f, 20.0f);
+  SkPaint child_paint1(SkColors::kGray);
+  SkPaint child_paint2(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint1);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2, child_paint2);
+  mock_layer2->set_opaque_bounds(SkRect::MakeLTRB(0.0f, 0.0f, 19.5f, 20.0f));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls().size(), 2u);
+}
+
+TEST_F(ContainerLayerTest, PlatformViewsAreNotOccluded) {
+  SkPath child_path;
+  child_path.addRect(0.0f, 0.0f, 20.0f, 20.0f);
+  auto mock_layer1 = std::make_shared<MockLayer>(
+      child_path, SkPaint(), true /* fake_has_platform_view */);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path);
+  mock_layer2->set_opaque_bounds(child_path.getBounds());
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_TRUE(layer->opaque_bounds().isEmpty());
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls().size(), 2u);
+}
+
+TEST_F(ContainerLayerTest, FlattenRemovesIdentityTransformsAndMergesOthers) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkMatrix transform1 = SkMatrix::Translate(10.0f, 20.0f);
+  SkMatrix transform2 = SkMatrix::Scale(2.0f, 3.0f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto transform_layer2 = std::make_shared<TransformLayer>(transform2);
+  transform_layer2->Add(mock_layer);
+  auto transform_layer1 = std::make_shared<TransformLayer>(transform1);
+  transform_layer1->Add(transform_layer2);
+  auto identity_layer = std::make_shared<TransformLayer>(SkMatrix::I());
+  identity_layer->Add(transform_layer1);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(identity_layer);
+
+  layer->Flatten([](const Layer*) { return false; });
+  ASSERT_EQ(layer->layers().size(), 1u);
+  EXPECT_EQ(layer->layers()[0], transform_layer1);
+  ASSERT_EQ(transform_layer1->layers().size(), 1u);
+  EXPECT_EQ(transform_layer1->layers()[0], mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(mock_layer->parent_matrix(),
+            SkMatrix::Concat(transform1, transform2));
+}
+
+TEST_F(ContainerLayerTest, FlattenLeavesSharedLayersUntouched) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto transform_layer2 =
+      std::make_shared<TransformLayer>(SkMatrix::Scale(2.0f, 3.0f));
+  transform_layer2->Add(mock_layer);
+  auto shared_container = std::make_shared<TransformLayer>(SkMatrix::I());
+  shared_container->Add(transform_layer2);
+  auto transform_layer1 =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(10.0f, 20.0f));
+  transform_layer1->Add(shared_container);
+
+  transform_layer1->Flatten([&shared_container](const Layer* layer) {
+    return layer == shared_container.get();
+  });
+  ASSERT_EQ(transform_layer1->layers().size(), 1u);
+  EXPECT_EQ(transform_layer1->layers()[0], shared_container);
+  ASSERT_EQ(shared_container->layers().size(), 1u);
+  EXPECT_EQ(shared_container->layers()[0], transform_layer2);
+}
+
+TEST_F(ContainerLayerTest, FlattenKeepsChildContainerOfMergedLayers) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto identity_layer = std::make_shared<TransformLayer>(SkMatrix::I());
+  identity_layer->Add(mock_layer);
+  auto layer = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  layer->Add(identity_layer);
+
+  layer->Flatten([](const Layer*) { return false; });
+  ASSERT_EQ(layer->layers().size(), 1u);
+  EXPECT_NE(layer->layers()[0], identity_layer);
+  auto* child_container = layer->layers()[0]->as_container_layer();
+  ASSERT_NE(child_container, nullptr);
+  ASSERT_EQ(child_container->layers().size(), 1u);
+  EXPECT_EQ(child_container->layers()[0], mock_layer);
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -454,5 +755,28 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+TEST_F(ContainerLayerDiffTest, DistantChangesHaveSeparateDamageRects) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(900, 900, 950, 950));
+  auto path1a = SkPath().addRect(SkRect::MakeLTRB(0, 0, 60, 50));
+  auto path2a = SkPath().addRect(SkRect::MakeLTRB(900, 900, 960, 950));
+
+  MockLayerTree t1;
+  t1.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path1)));
+  t1.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path2)));
+  DiffLayerTree(t1, MockLayerTree());
+
+  MockLayerTree t2;
+  t2.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path1a)));
+  t2.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path2a)));
+
+  auto damage = DiffLayerTree(t2, t1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 960, 950));
+  EXPECT_EQ(damage.frame_damage_rects,
+            std::vector({SkIRect::MakeLTRB(0, 0, 60, 50),
+                         SkIRect::MakeLTRB(900, 900, 960, 950)}));
+  EXPECT_EQ(damage.buffer_damage_rects, damage.frame_damage_rects);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -67,20 +67,15 @@ bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
     return false;
   }
 
-  if (op_bytes_1 > kMaxBytesToCompare) {
-    statistics.AddPictureTooComplexToCompare();
+  // The content hash is computed when the display lists are built, so
+  // comparing it avoids a deep compare regardless of the list size.
+  if (dl1->content_hash() != dl2->content_hash()) {
+    statistics.AddNewPicture();
     return false;
   }
 
-  statistics.AddDeepComparePicture();
-
-  auto res = dl1->Equals(*dl2);
-  if (res) {
-    statistics.AddDifferentInstanceButEqualPicture();
-  } else {
-    statistics.AddNewPicture();
-  }
-  return res;
+  statistics.AddDifferentInstanceButEqualPicture();
+  return true;
 }
 
 void DisplayListLayer::Preroll(PrerollContext* context,
@@ -98,10 +93,12 @@ void DisplayListLayer::Preroll(PrerollContext* context,
                      offset_);
     } else {
       // Don't evict raster cache entry during partial repaint
-      cache->Touch(disp_list, matrix);
+      cache->Touch(context, disp_list, matrix);
     }
   }
   set_paint_bounds(bounds);
+  set_opaque_bounds(
+      disp_list->opaque_bounds().makeOffset(offset_.x(), offset_.y()));
 }
 
 void DisplayListLayer::Paint(PaintContext& context) const {
@@ -116,13 +113,20 @@ void DisplayListLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
-  if (context.raster_cache &&
-      context.raster_cache->Draw(*display_list(), *context.leaf_nodes_canvas)) {
-    TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
-    return;
+  if (context.raster_cache) {
+    SkPaint paint;
+    paint.setAlphaf(context.inherited_opacity);
+    SkPaint* cache_paint =
+        context.inherited_opacity < SK_Scalar1 ? &paint : nullptr;
+    if (context.raster_cache->Draw(*display_list(), *context.leaf_nodes_canvas,
+                                   cache_paint)) {
+      TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+      return;
+    }
   }
 
-  display_list()->RenderTo(context.leaf_nodes_canvas);
+  display_list()->RenderTo(context.leaf_nodes_canvas,
+                           context.inherited_opacity);
 }
 
 }  // namespace flutter
@@ -13,8 +13,6 @@ namespace flutter {
 
 class DisplayListLayer : public Layer {
  public:
-  static constexpr size_t kMaxBytesToCompare = 10000;
-
   DisplayListLayer(const SkPoint& offset,
                    SkiaGPUObject<DisplayList> display_list,
                    bool is_complex,
@@ -36,6 +34,8 @@ class DisplayListLayer : public Layer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "DisplayListLayer"; }
+
  private:
   SkPoint offset_;
   flutter::SkiaGPUObject<DisplayList> display_list_;
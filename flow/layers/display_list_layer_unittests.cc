@@ -177,5 +177,33 @@ TEST_F(DisplayListLayerDiffTest, DisplayListCompare) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+TEST_F(DisplayListLayerDiffTest, LargeDisplayListCompare) {
+  // Large enough that a byte by byte comparison would have been skipped
+  auto create_display_list = []() {
+    DisplayListBuilder builder;
+    for (int i = 0; i < 1000; i++) {
+      builder.setColor(i & 1 ? SK_ColorRED : SK_ColorBLUE);
+      builder.drawRect(SkRect::MakeLTRB(10, 10, 60 - (i % 50), 60));
+    }
+    return builder.Build();
+  };
+
+  MockLayerTree tree1;
+  auto display_list1 = create_display_list();
+  tree1.root()->Add(CreateDisplayListLayer(display_list1));
+
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 60, 60));
+
+  MockLayerTree tree2;
+  auto display_list2 = create_display_list();
+  ASSERT_NE(display_list1.get(), display_list2.get());
+  ASSERT_GT(display_list2->bytes(), 10000u);
+  tree2.root()->Add(CreateDisplayListLayer(display_list2));
+
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeEmpty());
+}
+
 }  // namespace testing
 }  // namespace flutter
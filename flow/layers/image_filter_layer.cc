@@ -77,6 +77,12 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
     // instances can do this operation on some transforms and some
     // (filters or transforms) cannot. We can only cache the children
     // and apply the filter on the fly if this operation succeeds.
+    //
+    // Children that are cheap to draw are not worth the memory and the
+    // rasterization of a cache entry, so they are painted each frame.
+    if (!ChildrenWorthCaching()) {
+      return;
+    }
     transformed_filter_ = filter_->makeWithLocalMatrix(matrix);
     if (transformed_filter_) {
       // With a modified SkImageFilter we can now try to cache the
@@ -117,7 +123,7 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
   // modifications that the filter might apply.
   Layer::AutoSaveLayer save_layer = Layer::AutoSaveLayer::Create(
       context, GetChildContainer()->paint_bounds(), &paint);
-  PaintChildren(context);
+  PaintChildrenTimed(context);
 }
 
 }  // namespace flutter
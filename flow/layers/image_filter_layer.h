@@ -20,6 +20,8 @@ class ImageFilterLayer : public MergedContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "ImageFilterLayer"; }
+
  private:
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
@@ -27,7 +29,8 @@ class ImageFilterLayer : public MergedContainerLayer {
   // though, it will cache its children instead and filter their cached
   // output on the fly.
   // Caching just the children saves the time to render them and also
-  // avoids a rendering surface switch to draw them.
+  // avoids a rendering surface switch to draw them, so it is only done
+  // when they are expensive to draw (see ChildrenWorthCaching()).
   // Caching the layer itself avoids all of that and additionally avoids
   // the cost of applying the filter, but can be worse than caching the
   // children if the filter itself is not stable from frame to frame.
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/image_filter_layer.h"
 
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
@@ -334,6 +335,30 @@ TEST_F(ImageFilterLayerTest, ChildrenNotCached) {
   EXPECT_FALSE(raster_cache()->Draw(mock_layer2.get(), cache_canvas));
 }
 
+TEST_F(ImageFilterLayerTest, CheapChildrenNotCached) {
+  auto layer_filter = SkImageFilters::MatrixTransform(
+      SkMatrix(),
+      SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kLinear), nullptr);
+  auto initial_transform = SkMatrix::Translate(50.0, 25.5);
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto display_list_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0.0f, 0.0f),
+      SkiaGPUObject<DisplayList>(builder.Build(), nullptr), false, false);
+  auto layer = std::make_shared<ImageFilterLayer>(layer_filter);
+  layer->Add(display_list_layer);
+
+  SkCanvas cache_canvas;
+  cache_canvas.setMatrix(initial_transform);
+
+  use_mock_raster_cache();
+
+  layer->Preroll(preroll_context(), initial_transform);
+
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), (size_t)0);
+  EXPECT_FALSE(raster_cache()->Draw(display_list_layer.get(), cache_canvas));
+}
+
 using ImageFilterLayerDiffTest = DiffContextTest;
 
 TEST_F(ImageFilterLayerDiffTest, ImageFilterLayer) {
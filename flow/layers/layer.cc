@@ -11,6 +11,7 @@ namespace flutter {
 
 Layer::Layer()
     : paint_bounds_(SkRect::MakeEmpty()),
+      opaque_bounds_(SkRect::MakeEmpty()),
       unique_id_(NextUniqueID()),
       original_layer_id_(unique_id_),
       subtree_has_platform_view_(false) {}
@@ -28,6 +29,126 @@ uint64_t Layer::NextUniqueID() {
 
 void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {}
 
+void Layer::PrerollSubtree(PrerollContext* context, const SkMatrix& matrix) {
+  subtree_raster_cached_ = false;
+  // The raster cache can't be consulted from a worker thread.
+  if (context->reused_layers && context->reused_layers->count(unique_id_) &&
+      context->raster_cache && !context->raster_cache_ops) {
+    PrerollReusedSubtree(context, matrix);
+  } else {
+    reuse_count_ = 0;
+    PrerollRetainedSubtree(context, matrix);
+  }
+}
+
+void Layer::PrerollReusedSubtree(PrerollContext* context,
+                                 const SkMatrix& matrix) {
+  RasterCache* cache = context->raster_cache;
+  SkMatrix ctm = matrix;
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+  bool can_cache = cache->access_threshold() != 0 &&
+                   reuse_count_ >= cache->access_threshold();
+  if (can_cache && cache->HasLayerImage(this, ctm)) {
+    TRACE_EVENT0("flutter", "Layer::PrerollSubtree (Raster Cached)");
+    cache->Touch(context, this, ctm);
+    subtree_raster_cached_ = true;
+    return;
+  }
+
+  // Textures change without a change to the layers, and readbacks and
+  // platform views depend on the layers around the subtree, so subtrees with
+  // any of them can't be cached. Find out by prerolling the subtree on its
+  // own.
+  bool had_texture_layer = context->has_texture_layer;
+  bool needed_readback = context->surface_needs_readback;
+  context->has_texture_layer = false;
+  context->surface_needs_readback = false;
+  PrerollRetainedSubtree(context, matrix);
+  bool can_rasterize = !context->has_texture_layer &&
+                       !context->surface_needs_readback &&
+                       !context->has_platform_view &&
+                       !subtree_has_platform_view_ && !is_empty();
+  context->has_texture_layer = context->has_texture_layer || had_texture_layer;
+  context->surface_needs_readback =
+      context->surface_needs_readback || needed_readback;
+
+  if (!can_rasterize) {
+    reuse_count_ = 0;
+    return;
+  }
+  reuse_count_++;
+  if (can_cache && SkRect::Intersects(context->cull_rect, paint_bounds())) {
+    cache->Prepare(context, this, ctm);
+    subtree_raster_cached_ = cache->HasLayerImage(this, ctm);
+  }
+}
+
+void Layer::PrerollRetainedSubtree(PrerollContext* context,
+                                   const SkMatrix& matrix) {
+  if (!context->retained_layers ||
+      context->retained_layers->count(unique_id_) == 0) {
+    preroll_cache_ = nullptr;
+    Preroll(context, matrix);
+    return;
+  }
+
+  if (preroll_cache_ && preroll_cache_->matrix == matrix &&
+      preroll_cache_->cull_rect == context->cull_rect &&
+      preroll_cache_->raster_cache == context->raster_cache &&
+      preroll_cache_->frame_device_pixel_ratio ==
+          context->frame_device_pixel_ratio &&
+      preroll_cache_->had_texture_layer == context->has_texture_layer &&
+      preroll_cache_->needed_readback == context->surface_needs_readback) {
+    TRACE_EVENT0("flutter", "Layer::PrerollSubtree (Reused)");
+    for (auto& op : preroll_cache_->raster_cache_ops) {
+      op(context);
+    }
+    context->has_texture_layer = preroll_cache_->has_texture_layer;
+    context->surface_needs_readback = preroll_cache_->surface_needs_readback;
+    return;
+  }
+
+  // Record the calls to the raster cache while running them as usual, so
+  // that the next frame can repeat them.
+  auto cache = std::make_unique<PrerollCache>();
+  cache->matrix = matrix;
+  cache->cull_rect = context->cull_rect;
+  cache->raster_cache = context->raster_cache;
+  cache->frame_device_pixel_ratio = context->frame_device_pixel_ratio;
+  cache->had_texture_layer = context->has_texture_layer;
+  cache->needed_readback = context->surface_needs_readback;
+  DeferredRasterCacheOps* outer_raster_cache_ops = context->raster_cache_ops;
+  context->raster_cache_ops = &cache->raster_cache_ops;
+  Preroll(context, matrix);
+  context->raster_cache_ops = outer_raster_cache_ops;
+  for (auto& op : cache->raster_cache_ops) {
+    op(context);
+  }
+  cache->has_texture_layer = context->has_texture_layer;
+  cache->surface_needs_readback = context->surface_needs_readback;
+
+  // Platform views must be prerolled every frame to be composited.
+  if (context->has_platform_view || subtree_has_platform_view_) {
+    preroll_cache_ = nullptr;
+  } else {
+    preroll_cache_ = std::move(cache);
+  }
+}
+
+bool Layer::DrawSubtreeFromRasterCache(const PaintContext& context) const {
+  if (!context.raster_cache) {
+    return false;
+  }
+  SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  context.leaf_nodes_canvas->setMatrix(RasterCache::GetIntegralTransCTM(
+      context.leaf_nodes_canvas->getTotalMatrix()));
+#endif
+  return context.raster_cache->Draw(this, *context.leaf_nodes_canvas);
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
@@ -38,6 +159,7 @@ Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
   if (save_layer_is_active_) {
     prev_surface_needs_readback_ = preroll_context_->surface_needs_readback;
     preroll_context_->surface_needs_readback = false;
+    preroll_context_->save_layer_depth++;
   }
 }
 
@@ -51,6 +173,7 @@ Layer::AutoPrerollSaveLayerState Layer::AutoPrerollSaveLayerState::Create(
 
 Layer::AutoPrerollSaveLayerState::~AutoPrerollSaveLayerState() {
   if (save_layer_is_active_) {
+    preroll_context_->save_layer_depth--;
     preroll_context_->surface_needs_readback =
         (prev_surface_needs_readback_ || layer_itself_performs_readback_);
   }
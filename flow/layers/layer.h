@@ -5,7 +5,9 @@
 #ifndef FLUTTER_FLOW_LAYERS_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_LAYER_H_
 
+#include <functional>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "flutter/common/graphics/texture.h"
@@ -17,6 +19,7 @@
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -39,6 +42,8 @@ static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 // This should be an exact copy of the Clip enum in painting.dart.
 enum Clip { none, hardEdge, antiAlias, antiAliasWithSaveLayer };
 
+class LayerProfiler;
+
 struct PrerollContext {
   RasterCache* raster_cache;
   GrDirectContext* gr_context;
@@ -61,12 +66,43 @@ struct PrerollContext {
   // These allow us to track properties like elevation, opacity, and the
   // prescence of a texture layer during Preroll.
   bool has_texture_layer = false;
+
+  // When set, the preroll of the children of a container layer may be split
+  // across the worker threads of this task runner.
+  fml::BasicTaskRunner* concurrent_task_runner = nullptr;
+
+  // Set for the preroll of a subtree that runs on a worker thread, to record
+  // the calls to the raster cache.
+  DeferredRasterCacheOps* raster_cache_ops = nullptr;
+
+  // The unique ids of the retained layers whose subtrees are unchanged since
+  // the previous frame. See Layer::PrerollSubtree.
+  const std::unordered_set<uint64_t>* retained_layers = nullptr;
+
+  // The number of the ancestors of the layer being prerolled that may paint
+  // their children into a saveLayer. See |AutoPrerollSaveLayerState|.
+  int save_layer_depth = 0;
+
+  // Set when layer profiling is enabled. See |LayerProfiler|.
+  LayerProfiler* layer_profiler = nullptr;
+
+  // The unique ids of the layers that the framework added to the scene again
+  // with SceneBuilder.addRetained. Their subtrees are unchanged since they
+  // were built, so they may be drawn from the raster cache instead of being
+  // prerolled and painted. See Layer::PrerollSubtree.
+  const std::unordered_set<uint64_t>* reused_layers = nullptr;
 };
 
 class PictureLayer;
+class ContainerLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
 class TextureLayer;
+class TransformLayer;
+class OpacityLayer;
+class ClipRectLayer;
+class ClipRRectLayer;
+class ClipPathLayer;
 
 // Represents a single composited layer. Created on the UI thread but then
 // subquently used on the Rasterizer thread.
@@ -100,6 +136,19 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
 
+  // Calls Preroll, unless the layer is one of the retained_layers of the
+  // |context| and was prerolled with the same inputs in the previous frame.
+  // In that case the paint bounds of the subtree are still valid, so only the
+  // calls the previous Preroll made to the raster cache are repeated.
+  //
+  // Layers that are among the reused_layers of the |context| are rasterized
+  // into the raster cache once they have been reused for as many frames as
+  // the access threshold of the cache. From then on, Preroll is skipped as
+  // long as the image can be drawn under the |matrix|, which is the case for
+  // any matrix that only differs in its (whole pixel) translation, and the
+  // parent draws the image instead of calling Paint.
+  void PrerollSubtree(PrerollContext* context, const SkMatrix& matrix);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -147,6 +196,18 @@ class Layer {
     const RasterCache* raster_cache;
     const bool checkerboard_offscreen_layers;
     const float frame_device_pixel_ratio;
+
+    // The opacity that an ancestor OpacityLayer has deferred to its
+    // children instead of rendering them into a saveLayer. Only set
+    // while painting children that reported they can apply it directly.
+    SkScalar inherited_opacity = SK_Scalar1;
+
+    // The unique ids of the backdrop filter layers whose backdrops are
+    // unchanged since the previous frame. See |LayerTree|.
+    const std::unordered_set<uint64_t>* unchanged_backdrops = nullptr;
+
+    // Set when layer profiling is enabled. See |LayerProfiler|.
+    LayerProfiler* layer_profiler = nullptr;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -211,6 +272,23 @@ class Layer {
 
   virtual void Paint(PaintContext& context) const = 0;
 
+  // Whether the last PrerollSubtree decided that the subtree is drawn from
+  // the raster cache, with |DrawSubtreeFromRasterCache|, in place of Paint.
+  bool subtree_raster_cached() const { return subtree_raster_cached_; }
+
+  // Draws the image of the subtree from the raster cache. Returns false if
+  // there is no image for the current matrix of the canvas.
+  bool DrawSubtreeFromRasterCache(const PaintContext& context) const;
+
+  // Shortens the chains of layers with a single child in the subtree of the
+  // layer without changing what it paints. See ContainerLayer::Flatten.
+  virtual void Flatten(const std::function<bool(const Layer*)>& is_shared) {}
+
+  // Whether the Preroll of the layer and its children only changes the
+  // layers themselves and the PrerollContext, so that it can run on a worker
+  // thread concurrently with the Preroll of its siblings.
+  virtual bool can_preroll_concurrently() const { return true; }
+
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
   void set_subtree_has_platform_view(bool value) {
     subtree_has_platform_view_ = value;
@@ -237,6 +315,18 @@ class Layer {
     paint_bounds_ = paint_bounds;
   }
 
+  // Returns a rect in the layer's local coordinate system, like the
+  // paint_bounds, that the layer covers with fully opaque pixels (except
+  // along anti-aliased edges) or an empty rect if no such area is known.
+  // The parent ContainerLayer uses it to skip the painting of the siblings
+  // below the layer that it occludes entirely.
+  const SkRect& opaque_bounds() const { return opaque_bounds_; }
+
+  // Set by Preroll() of layers that know the opaque area of their content.
+  void set_opaque_bounds(const SkRect& opaque_bounds) {
+    opaque_bounds_ = opaque_bounds;
+  }
+
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.isEmpty(); }
 
@@ -267,6 +357,16 @@ class Layer {
 
   uint64_t unique_id() const { return unique_id_; }
 
+  // The name of the type of the layer, which must be a string literal. Used
+  // to attribute the raster time to the types of layers.
+  virtual const char* type_name() const { return "Layer"; }
+
+  virtual const ContainerLayer* as_container_layer() const { return nullptr; }
+  virtual const TransformLayer* as_transform_layer() const { return nullptr; }
+  virtual const OpacityLayer* as_opacity_layer() const { return nullptr; }
+  virtual const ClipRectLayer* as_clip_rect_layer() const { return nullptr; }
+  virtual const ClipRRectLayer* as_clip_rrect_layer() const { return nullptr; }
+  virtual const ClipPathLayer* as_clip_path_layer() const { return nullptr; }
   virtual const PictureLayer* as_picture_layer() const { return nullptr; }
   virtual const DisplayListLayer* as_display_list_layer() const {
     return nullptr;
@@ -278,10 +378,37 @@ class Layer {
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
  private:
+  // The part of PrerollSubtree for the layers that are reused by the
+  // framework, which may draw them from the raster cache.
+  void PrerollReusedSubtree(PrerollContext* context, const SkMatrix& matrix);
+
+  // The part of PrerollSubtree that reuses the results of the previous
+  // Preroll of retained layers.
+  void PrerollRetainedSubtree(PrerollContext* context, const SkMatrix& matrix);
+
+  // The inputs and the results of the last Preroll of a retained layer.
+  struct PrerollCache {
+    SkMatrix matrix;
+    SkRect cull_rect;
+    RasterCache* raster_cache;
+    float frame_device_pixel_ratio;
+    bool had_texture_layer;
+    bool needed_readback;
+    bool has_texture_layer;
+    bool surface_needs_readback;
+    DeferredRasterCacheOps raster_cache_ops;
+  };
+
   SkRect paint_bounds_;
+  SkRect opaque_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
+  std::unique_ptr<PrerollCache> preroll_cache_;
+  // The number of frames in a row that the layer was reused by the framework
+  // with a subtree that can be rasterized.
+  int reuse_count_ = 0;
+  bool subtree_raster_cached_ = false;
 
   static uint64_t NextUniqueID();
 
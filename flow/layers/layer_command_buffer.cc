@@ -0,0 +1,176 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_command_buffer.h"
+
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/performance_overlay_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/platform_view_layer.h"
+#include "flutter/flow/layers/texture_layer.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+LayerCommandBuffer::LayerCommandBuffer(std::shared_ptr<ContainerLayer> root)
+    : root_(std::move(root)) {
+  FML_DCHECK(root_);
+}
+
+LayerCommandBuffer::~LayerCommandBuffer() = default;
+
+void LayerCommandBuffer::Record(Op op, size_t index) {
+  commands_.push_back({op, static_cast<uint32_t>(index)});
+}
+
+void LayerCommandBuffer::Push(std::shared_ptr<ContainerLayer> layer) {
+  Record(Op::kPush, containers_.size());
+  containers_.push_back(std::move(layer));
+}
+
+void LayerCommandBuffer::Pop() {
+  Record(Op::kPop, 0);
+}
+
+void LayerCommandBuffer::AddRetained(
+    std::shared_ptr<Layer> layer,
+    std::shared_ptr<LayerCommandBuffer> source) {
+  // A layer pushed to this buffer is linked when this buffer is built anyway.
+  if (source.get() == this) {
+    source = nullptr;
+  }
+  retained_layers_.insert(layer.get());
+  Record(Op::kAddRetained, retained_.size());
+  retained_.push_back({std::move(layer), std::move(source)});
+}
+
+void LayerCommandBuffer::AddPicture(const SkPoint& offset,
+                                    SkiaGPUObject<SkPicture> picture,
+                                    bool is_complex,
+                                    bool will_change) {
+  Record(Op::kAddPicture, pictures_.size());
+  pictures_.push_back({offset, std::move(picture), is_complex, will_change});
+}
+
+void LayerCommandBuffer::AddDisplayList(
+    const SkPoint& offset,
+    SkiaGPUObject<DisplayList> display_list,
+    bool is_complex,
+    bool will_change) {
+  Record(Op::kAddDisplayList, display_lists_.size());
+  display_lists_.push_back(
+      {offset, std::move(display_list), is_complex, will_change});
+}
+
+void LayerCommandBuffer::AddTexture(const SkPoint& offset,
+                                    const SkSize& size,
+                                    int64_t texture_id,
+                                    bool freeze,
+                                    const SkSamplingOptions& sampling) {
+  Record(Op::kAddTexture, textures_.size());
+  textures_.push_back({offset, size, texture_id, freeze, sampling});
+}
+
+void LayerCommandBuffer::AddPlatformView(const SkPoint& offset,
+                                         const SkSize& size,
+                                         int64_t view_id) {
+  Record(Op::kAddPlatformView, platform_views_.size());
+  platform_views_.push_back({offset, size, view_id});
+}
+
+void LayerCommandBuffer::AddPerformanceOverlay(uint64_t options,
+                                               const SkRect& bounds) {
+  Record(Op::kAddPerformanceOverlay, performance_overlays_.size());
+  performance_overlays_.push_back({options, bounds});
+}
+
+void LayerCommandBuffer::Build() {
+  std::call_once(build_once_, [this]() { BuildOnce(); });
+}
+
+void LayerCommandBuffer::BuildOnce() {
+  TRACE_EVENT0("flutter", "LayerCommandBuffer::Build");
+  std::vector<ContainerLayer*> stack = {root_.get()};
+  for (const Command& command : commands_) {
+    ContainerLayer* parent = stack.back();
+    switch (command.op) {
+      case Op::kPush: {
+        std::shared_ptr<ContainerLayer>& layer = containers_[command.index];
+        parent->Add(layer);
+        stack.push_back(layer.get());
+        break;
+      }
+      case Op::kPop:
+        // The root is never popped, so that adding layers is always valid.
+        if (stack.size() > 1) {
+          stack.pop_back();
+        }
+        break;
+      case Op::kAddRetained: {
+        RetainedArgs& args = retained_[command.index];
+        if (args.source) {
+          args.source->Build();
+        }
+        parent->Add(std::move(args.layer));
+        break;
+      }
+      case Op::kAddPicture: {
+        PictureArgs& args = pictures_[command.index];
+        parent->Add(std::make_shared<PictureLayer>(
+            args.offset, std::move(args.picture), args.is_complex,
+            args.will_change));
+        break;
+      }
+      case Op::kAddDisplayList: {
+        DisplayListArgs& args = display_lists_[command.index];
+        parent->Add(std::make_shared<DisplayListLayer>(
+            args.offset, std::move(args.display_list), args.is_complex,
+            args.will_change));
+        break;
+      }
+      case Op::kAddTexture: {
+        const TextureArgs& args = textures_[command.index];
+        parent->Add(std::make_shared<TextureLayer>(
+            args.offset, args.size, args.texture_id, args.freeze,
+            args.sampling));
+        break;
+      }
+      case Op::kAddPlatformView: {
+        const PlatformViewArgs& args = platform_views_[command.index];
+        parent->Add(std::make_shared<PlatformViewLayer>(args.offset, args.size,
+                                                        args.view_id));
+        break;
+      }
+      case Op::kAddPerformanceOverlay: {
+        const PerformanceOverlayArgs& args =
+            performance_overlays_[command.index];
+        auto layer = std::make_shared<PerformanceOverlayLayer>(args.options);
+        layer->set_paint_bounds(args.bounds);
+        parent->Add(std::move(layer));
+        break;
+      }
+    }
+  }
+
+  // Retained layers may also be part of the layer tree of a previous frame
+  // that is still being drawn, so only the layers of this scene are
+  // flattened.
+  root_->Flatten([this](const Layer* layer) {
+    return retained_layers_.count(layer) > 0;
+  });
+
+  root_ = nullptr;
+  commands_ = {};
+  containers_ = {};
+  retained_ = {};
+  pictures_ = {};
+  display_lists_ = {};
+  textures_ = {};
+  platform_views_ = {};
+  performance_overlays_ = {};
+  retained_layers_ = {};
+}
+
+}  // namespace flutter
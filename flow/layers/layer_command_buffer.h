@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_COMMAND_BUFFER_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_COMMAND_BUFFER_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkSamplingOptions.h"
+
+namespace flutter {
+
+/// Records the push, pop and add operations of a scene, so that its layer
+/// tree is put together on the raster thread instead of the UI thread.
+///
+/// Container layers are still created when they are pushed, because the
+/// framework holds on to them as engine layers. The leaf layers are only
+/// created by |Build|, which also adds every layer to its parent and then
+/// flattens the tree like SceneBuilder.build does without this buffer.
+///
+/// A container that was pushed to this buffer can be added to the scene of
+/// a later buffer with |AddRetained| before this buffer was built. Building
+/// the later buffer then builds this one first. |Build| is therefore called
+/// from the raster thread as well as from the UI thread by Scene.toImage,
+/// and only the first call does any work.
+class LayerCommandBuffer {
+ public:
+  explicit LayerCommandBuffer(std::shared_ptr<ContainerLayer> root);
+
+  ~LayerCommandBuffer();
+
+  // The recording methods must only be called on the UI thread, before the
+  // buffer is built.
+
+  void Push(std::shared_ptr<ContainerLayer> layer);
+
+  // Does nothing if only the root is pushed.
+  void Pop();
+
+  // |source| is the buffer that |layer| was pushed to, if any.
+  void AddRetained(std::shared_ptr<Layer> layer,
+                   std::shared_ptr<LayerCommandBuffer> source);
+
+  void AddPicture(const SkPoint& offset,
+                  SkiaGPUObject<SkPicture> picture,
+                  bool is_complex,
+                  bool will_change);
+
+  void AddDisplayList(const SkPoint& offset,
+                      SkiaGPUObject<DisplayList> display_list,
+                      bool is_complex,
+                      bool will_change);
+
+  void AddTexture(const SkPoint& offset,
+                  const SkSize& size,
+                  int64_t texture_id,
+                  bool freeze,
+                  const SkSamplingOptions& sampling);
+
+  void AddPlatformView(const SkPoint& offset,
+                       const SkSize& size,
+                       int64_t view_id);
+
+  void AddPerformanceOverlay(uint64_t options, const SkRect& bounds);
+
+  /// Creates the recorded layers and links them into the tree of the root.
+  /// Can be called from any thread.
+  void Build();
+
+  size_t command_count() const { return commands_.size(); }
+
+ private:
+  enum class Op : uint8_t {
+    kPush,
+    kPop,
+    kAddRetained,
+    kAddPicture,
+    kAddDisplayList,
+    kAddTexture,
+    kAddPlatformView,
+    kAddPerformanceOverlay,
+  };
+
+  // The arguments of each command are kept in the vector for the type of
+  // the command, at |index|.
+  struct Command {
+    Op op;
+    uint32_t index;
+  };
+
+  struct RetainedArgs {
+    std::shared_ptr<Layer> layer;
+    std::shared_ptr<LayerCommandBuffer> source;
+  };
+
+  struct PictureArgs {
+    SkPoint offset;
+    SkiaGPUObject<SkPicture> picture;
+    bool is_complex;
+    bool will_change;
+  };
+
+  struct DisplayListArgs {
+    SkPoint offset;
+    SkiaGPUObject<DisplayList> display_list;
+    bool is_complex;
+    bool will_change;
+  };
+
+  struct TextureArgs {
+    SkPoint offset;
+    SkSize size;
+    int64_t texture_id;
+    bool freeze;
+    SkSamplingOptions sampling;
+  };
+
+  struct PlatformViewArgs {
+    SkPoint offset;
+    SkSize size;
+    int64_t view_id;
+  };
+
+  struct PerformanceOverlayArgs {
+    uint64_t options;
+    SkRect bounds;
+  };
+
+  void Record(Op op, size_t index);
+
+  void BuildOnce();
+
+  std::once_flag build_once_;
+
+  // Cleared by |Build|, so that the engine layers that keep the buffer alive
+  // don't keep the layers and pictures of the scene alive.
+  std::shared_ptr<ContainerLayer> root_;
+  std::vector<Command> commands_;
+  std::vector<std::shared_ptr<ContainerLayer>> containers_;
+  std::vector<RetainedArgs> retained_;
+  std::vector<PictureArgs> pictures_;
+  std::vector<DisplayListArgs> display_lists_;
+  std::vector<TextureArgs> textures_;
+  std::vector<PlatformViewArgs> platform_views_;
+  std::vector<PerformanceOverlayArgs> performance_overlays_;
+  std::unordered_set<const Layer*> retained_layers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerCommandBuffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_COMMAND_BUFFER_H_
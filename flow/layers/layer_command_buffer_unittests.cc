@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_command_buffer.h"
+
+#include "flutter/flow/layers/texture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+
+namespace flutter {
+namespace testing {
+
+using LayerCommandBufferTest = LayerTest;
+
+TEST_F(LayerCommandBufferTest, BuildLinksLayersInRecordedOrder) {
+  auto root = std::make_shared<ContainerLayer>();
+  auto transform_layer =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(10.0f, 20.0f));
+  LayerCommandBuffer commands(root);
+  commands.Push(transform_layer);
+  commands.AddTexture(SkPoint::Make(1.0f, 2.0f), SkSize::Make(3.0f, 4.0f), 1,
+                      false, SkSamplingOptions());
+  commands.Pop();
+  commands.AddTexture(SkPoint::Make(5.0f, 6.0f), SkSize::Make(7.0f, 8.0f), 2,
+                      false, SkSamplingOptions());
+  // Popping the root has no effect.
+  commands.Pop();
+  EXPECT_EQ(commands.command_count(), 5u);
+  EXPECT_TRUE(root->layers().empty());
+
+  commands.Build();
+  EXPECT_EQ(commands.command_count(), 0u);
+  ASSERT_EQ(root->layers().size(), 2u);
+  EXPECT_EQ(root->layers()[0], transform_layer);
+  ASSERT_EQ(transform_layer->layers().size(), 1u);
+  EXPECT_NE(transform_layer->layers()[0]->as_texture_layer(), nullptr);
+  EXPECT_NE(root->layers()[1]->as_texture_layer(), nullptr);
+
+  // Building again does nothing.
+  commands.Build();
+  EXPECT_EQ(root->layers().size(), 2u);
+}
+
+TEST_F(LayerCommandBufferTest, BuildFlattensAllButRetainedLayers) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+
+  auto previous_root = std::make_shared<ContainerLayer>();
+  auto retained_container = std::make_shared<TransformLayer>(SkMatrix::I());
+  auto previous_commands =
+      std::make_shared<LayerCommandBuffer>(previous_root);
+  previous_commands->Push(retained_container);
+  previous_commands->AddRetained(mock_layer, nullptr);
+
+  auto root = std::make_shared<ContainerLayer>();
+  auto container = std::make_shared<TransformLayer>(SkMatrix::I());
+  LayerCommandBuffer commands(root);
+  commands.Push(container);
+  commands.AddRetained(retained_container, previous_commands);
+
+  // The buffer that the retained container was pushed to is built first, so
+  // that the container has its children.
+  commands.Build();
+  ASSERT_EQ(root->layers().size(), 1u);
+  EXPECT_EQ(root->layers()[0], retained_container);
+  ASSERT_EQ(retained_container->layers().size(), 1u);
+  EXPECT_EQ(retained_container->layers()[0], mock_layer);
+  EXPECT_EQ(previous_commands->command_count(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
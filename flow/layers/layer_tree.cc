@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layer_profiler.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
@@ -22,6 +23,13 @@ LayerTree::LayerTree(const SkISize& frame_size, float device_pixel_ratio)
   FML_CHECK(device_pixel_ratio_ != 0.0f);
 }
 
+void LayerTree::BuildDeferredLayers() {
+  if (layer_commands_) {
+    layer_commands_->Build();
+    layer_commands_ = nullptr;
+  }
+}
+
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache,
                         SkRect cull_rect) {
@@ -50,7 +58,17 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       frame.context().texture_registry(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.concurrent_task_runner = frame.context().preroll_task_runner();
+  context.retained_layers = &retained_layers_;
+  context.reused_layers = &reused_layers_;
+  context.layer_profiler = frame.context().layer_profiler();
+  if (context.layer_profiler) {
+    // The profiler times the layers on the raster thread only.
+    context.concurrent_task_runner = nullptr;
+  }
 
+  LayerProfiler::ScopedLayer profile(context.layer_profiler, root_layer_.get(),
+                                     LayerProfiler::Phase::kPreroll);
   root_layer_->Preroll(&context, frame.root_surface_transformation());
   return context.surface_needs_readback;
 }
@@ -85,14 +103,20 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.unchanged_backdrops = &unchanged_backdrops_;
+  context.layer_profiler = frame.context().layer_profiler();
 
   if (root_layer_->needs_painting(context)) {
+    LayerProfiler::ScopedLayer profile(context.layer_profiler,
+                                       root_layer_.get(),
+                                       LayerProfiler::Phase::kPaint);
     root_layer_->Paint(context);
   }
 }
 
 sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
   TRACE_EVENT0("flutter", "LayerTree::Flatten");
+  BuildDeferredLayers();
 
   SkPictureRecorder recorder;
   auto* canvas = recorder.beginRecording(bounds);
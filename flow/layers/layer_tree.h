@@ -7,9 +7,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <unordered_set>
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_command_buffer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -43,12 +45,43 @@ class LayerTree {
     root_layer_ = std::move(root_layer);
   }
 
+  // The recorded commands that put the layers under the root layer together,
+  // when the scene was built with deferred layer tree construction.
+  void set_layer_commands(std::shared_ptr<LayerCommandBuffer> layer_commands) {
+    layer_commands_ = std::move(layer_commands);
+  }
+
+  // Builds the layers recorded in the layer commands, if any. Must be called
+  // before the layer tree is prerolled, diffed or flattened.
+  void BuildDeferredLayers();
+
   const SkISize& frame_size() const { return frame_size_; }
   float device_pixel_ratio() const { return device_pixel_ratio_; }
 
   const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
   PaintRegionMap& paint_region_map() { return paint_region_map_; }
 
+  // The unique ids of the retained layers whose subtrees the diff with the
+  // previous frame proved unchanged. Preroll reuses the results of the
+  // previous preroll of these subtrees.
+  void set_retained_layers(std::unordered_set<uint64_t> retained_layers) {
+    retained_layers_ = std::move(retained_layers);
+  }
+
+  // The unique ids of the layers that the framework reused from the previous
+  // scene. Preroll may draw their subtrees from the raster cache.
+  void set_reused_layers(std::unordered_set<uint64_t> reused_layers) {
+    reused_layers_ = std::move(reused_layers);
+  }
+
+  // The unique ids of the backdrop filter layers whose backdrops the diff
+  // with the previous frame proved unchanged. Paint reuses the filtered
+  // backdrops of the previous frame for these layers.
+  void set_unchanged_backdrops(
+      std::unordered_set<uint64_t> unchanged_backdrops) {
+    unchanged_backdrops_ = std::move(unchanged_backdrops);
+  }
+
   // The number of frame intervals missed after which the compositor must
   // trace the rasterized picture to a trace file. Specify 0 to disable all
   // tracing
@@ -70,6 +103,7 @@ class LayerTree {
 
  private:
   std::shared_ptr<Layer> root_layer_;
+  std::shared_ptr<LayerCommandBuffer> layer_commands_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
   const float device_pixel_ratio_;  // Logical / Physical pixels ratio.
   uint32_t rasterizer_tracing_threshold_;
@@ -77,6 +111,9 @@ class LayerTree {
   bool checkerboard_offscreen_layers_;
 
   PaintRegionMap paint_region_map_;
+  std::unordered_set<uint64_t> retained_layers_;
+  std::unordered_set<uint64_t> reused_layers_;
+  std::unordered_set<uint64_t> unchanged_backdrops_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
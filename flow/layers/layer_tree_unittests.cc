@@ -193,5 +193,53 @@ TEST_F(LayerTreeTest, NeedsSystemComposite) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(LayerTreeTest, LayerProfilerAttributesTheRasterTimeToTheLayers) {
+  CompositorContext compositor_context;
+  compositor_context.SetLayerProfilingEnabled(true);
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, &mock_canvas(), nullptr, SkMatrix::I(), false, true, nullptr);
+  auto mock_layer1 = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f)));
+  auto mock_layer2 = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(25.0f, 6.0f, 40.5f, 21.5f)));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+  LayerTree layer_tree(SkISize::Make(64, 64), 1.0f);
+  layer_tree.set_root_layer(layer);
+
+  layer_tree.Preroll(*frame);
+  layer_tree.Paint(*frame);
+
+  LayerProfiler* profiler = compositor_context.layer_profiler();
+  ASSERT_NE(profiler, nullptr);
+  const auto& stats_by_type = profiler->stats_by_type();
+  ASSERT_EQ(stats_by_type.size(), 2u);
+  const LayerProfiler::Stats& container = stats_by_type.at("ContainerLayer");
+  EXPECT_EQ(container.preroll.calls, 1u);
+  EXPECT_EQ(container.paint.calls, 1u);
+  EXPECT_LE(container.preroll.exclusive_time, container.preroll.inclusive_time);
+  EXPECT_LE(container.paint.exclusive_time, container.paint.inclusive_time);
+  const LayerProfiler::Stats& mock = stats_by_type.at("Layer");
+  EXPECT_EQ(mock.preroll.calls, 2u);
+  EXPECT_EQ(mock.paint.calls, 2u);
+  EXPECT_LE(mock.paint.inclusive_time, container.paint.inclusive_time);
+
+  const auto& stats_by_layer = profiler->stats_by_layer();
+  ASSERT_EQ(stats_by_layer.size(), 3u);
+  EXPECT_STREQ(stats_by_layer.at(layer->original_layer_id()).type_name,
+               "ContainerLayer");
+  const LayerProfiler::LayerStats& mock_layer1_stats =
+      stats_by_layer.at(mock_layer1->original_layer_id());
+  EXPECT_EQ(mock_layer1_stats.stats.paint.calls, 1u);
+
+  profiler->Reset();
+  EXPECT_TRUE(profiler->stats_by_type().empty());
+  EXPECT_TRUE(profiler->stats_by_layer().empty());
+
+  compositor_context.SetLayerProfilingEnabled(false);
+  EXPECT_EQ(compositor_context.layer_profiler(), nullptr);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include "flutter/flow/layers/display_list_layer.h"
+
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPaint.h"
 
@@ -52,10 +54,21 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   {
     set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
+    set_opaque_bounds(alpha_ == SK_AlphaOPAQUE
+                          ? opaque_bounds().makeOffset(offset_.fX, offset_.fY)
+                          : SkRect::MakeEmpty());
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     child_matrix = RasterCache::GetIntegralTransCTM(child_matrix);
 #endif
-    TryToPrepareRasterCache(context, GetCacheableChild(), child_matrix);
+    Layer* child = GetCacheableChild();
+    const DisplayListLayer* display_list_layer =
+        child ? child->as_display_list_layer() : nullptr;
+    children_can_accept_opacity_ =
+        display_list_layer &&
+        display_list_layer->display_list()->can_apply_group_opacity();
+    if (!children_can_accept_opacity_) {
+      TryToPrepareRasterCache(context, child, child_matrix);
+    }
   }
 
   // Restore cull_rect
@@ -77,6 +90,14 @@ void OpacityLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
+  if (children_can_accept_opacity_) {
+    SkScalar inherited_opacity = context.inherited_opacity;
+    context.inherited_opacity *= alpha_ * (1.0f / SK_AlphaOPAQUE);
+    PaintChildren(context);
+    context.inherited_opacity = inherited_opacity;
+    return;
+  }
+
   if (context.raster_cache &&
       context.raster_cache->Draw(GetCacheableChild(),
                                  *context.leaf_nodes_canvas, &paint)) {
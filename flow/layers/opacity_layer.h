@@ -33,9 +33,16 @@ class OpacityLayer : public MergedContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "OpacityLayer"; }
+
+  const OpacityLayer* as_opacity_layer() const override { return this; }
+
  private:
   SkAlpha alpha_;
   SkPoint offset_;
+  // Set during Preroll when the only child is a DisplayListLayer whose
+  // list can apply the opacity to each of its ops without a saveLayer.
+  bool children_can_accept_opacity_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(OpacityLayer);
 };
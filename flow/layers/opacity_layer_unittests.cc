@@ -2,12 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#define FML_USED_ON_EMBEDDER
+
 #include "flutter/flow/layers/opacity_layer.h"
 
 #include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/flow/testing/skia_gpu_object_layer_test.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -428,6 +432,135 @@ TEST_F(OpacityLayerTest, CullRectIsTransformed) {
   EXPECT_EQ(mockLayer->parent_cull_rect().fTop, -20);
 }
 
+using OpacityLayerDisplayListTest = SkiaGPUObjectLayerTest;
+
+TEST_F(OpacityLayerDisplayListTest, CompatibleChildIsNotCached) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  builder.drawRect(SkRect::MakeLTRB(20, 20, 30, 30));
+  auto display_list = builder.Build();
+  ASSERT_TRUE(display_list->can_apply_group_opacity());
+  auto display_list_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), SkiaGPUObject(display_list, unref_queue()), false,
+      false);
+  auto layer = std::make_shared<OpacityLayer>(255 / 2, SkPoint::Make(0, 0));
+  layer->Add(display_list_layer);
+
+  use_mock_raster_cache();
+  layer->Preroll(preroll_context(), SkMatrix::Translate(50.0, 25.5));
+
+  // The child applies the opacity itself, so it isn't cached as a layer.
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), (size_t)0);
+}
+
+TEST_F(OpacityLayerDisplayListTest, IncompatibleChildIsCached) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  builder.drawRect(SkRect::MakeLTRB(5, 5, 15, 15));
+  auto display_list = builder.Build();
+  ASSERT_FALSE(display_list->can_apply_group_opacity());
+  auto display_list_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), SkiaGPUObject(display_list, unref_queue()), false,
+      false);
+  auto layer = std::make_shared<OpacityLayer>(255 / 2, SkPoint::Make(0, 0));
+  layer->Add(display_list_layer);
+
+  use_mock_raster_cache();
+  layer->Preroll(preroll_context(), SkMatrix::Translate(50.0, 25.5));
+
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), (size_t)1);
+}
+
+#ifndef NDEBUG
+TEST_F(OpacityLayerDisplayListTest, CompatibleChildAppliesOpacity) {
+  const SkRect rect1 = SkRect::MakeLTRB(0, 0, 10, 10);
+  const SkRect rect2 = SkRect::MakeLTRB(20, 20, 30, 30);
+  const SkPoint layer_offset = SkPoint::Make(1.0f, 2.0f);
+  const SkMatrix layer_transform =
+      SkMatrix::Translate(layer_offset.fX, layer_offset.fY);
+  const SkAlpha alpha_half = 255 / 2;
+  DisplayListBuilder builder;
+  builder.drawRect(rect1);
+  builder.drawRect(rect2);
+  auto display_list_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), SkiaGPUObject(builder.Build(), unref_queue()),
+      false, false);
+  auto layer = std::make_shared<OpacityLayer>(alpha_half, layer_offset);
+  layer->Add(display_list_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+
+  // The rects are drawn with the opacity instead of into a saveLayer.
+  SkPaint opacity_paint;
+  opacity_paint.setAlphaf(alpha_half * (1.0f / SK_AlphaOPAQUE));
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkM44(layer_transform)}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{SkM44(layer_transform)}},
+#endif
+       MockCanvas::DrawCall{1, MockCanvas::SaveData{2}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           2, MockCanvas::SetMatrixData{SkM44(layer_transform)}},
+#endif
+       MockCanvas::DrawCall{2, MockCanvas::DrawRectData{rect1, opacity_paint}},
+       MockCanvas::DrawCall{2, MockCanvas::DrawRectData{rect2, opacity_paint}},
+       MockCanvas::DrawCall{2, MockCanvas::RestoreData{1}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
+TEST_F(OpacityLayerDisplayListTest, IncompatibleChildUsesSaveLayer) {
+  const SkRect rect1 = SkRect::MakeLTRB(0, 0, 10, 10);
+  const SkRect rect2 = SkRect::MakeLTRB(5, 5, 15, 15);
+  const SkPoint layer_offset = SkPoint::Make(1.0f, 2.0f);
+  const SkMatrix layer_transform =
+      SkMatrix::Translate(layer_offset.fX, layer_offset.fY);
+  const SkAlpha alpha_half = 255 / 2;
+  DisplayListBuilder builder;
+  builder.drawRect(rect1);
+  builder.drawRect(rect2);
+  auto display_list_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), SkiaGPUObject(builder.Build(), unref_queue()),
+      false, false);
+  auto layer = std::make_shared<OpacityLayer>(alpha_half, layer_offset);
+  layer->Add(display_list_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+
+  // The overlapping rects are drawn opaque into a saveLayer.
+  const SkPaint opacity_paint =
+      SkPaint(SkColor4f::FromColor(SkColorSetA(SK_ColorBLACK, alpha_half)));
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkM44(layer_transform)}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{SkM44(layer_transform)}},
+#endif
+       MockCanvas::DrawCall{
+           1, MockCanvas::SaveLayerData{SkRect::MakeLTRB(0, 0, 15, 15),
+                                        opacity_paint, nullptr, 2}},
+       MockCanvas::DrawCall{2, MockCanvas::SaveData{3}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           3, MockCanvas::SetMatrixData{SkM44(layer_transform)}},
+#endif
+       MockCanvas::DrawCall{3, MockCanvas::DrawRectData{rect1, SkPaint()}},
+       MockCanvas::DrawCall{3, MockCanvas::DrawRectData{rect2, SkPaint()}},
+       MockCanvas::DrawCall{3, MockCanvas::RestoreData{2}},
+       MockCanvas::DrawCall{2, MockCanvas::RestoreData{1}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+#endif
+
 using OpacityLayerDiffTest = DiffContextTest;
 
 TEST_F(OpacityLayerDiffTest, FractionalTranslation) {
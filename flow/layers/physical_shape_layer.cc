@@ -69,14 +69,45 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
     // children to it so we don't need to join the child paint bounds.
     set_paint_bounds(ComputeShadowBounds(
         path_, elevation_, context->frame_device_pixel_ratio, matrix));
+
+    if (auto* cache = context->raster_cache) {
+      TRACE_EVENT0("flutter", "PhysicalShapeLayer::RasterCache (Preroll)");
+      if (!shadow_ || shadow_dpr_ != context->frame_device_pixel_ratio) {
+        shadow_dpr_ = context->frame_device_pixel_ratio;
+        DisplayListBuilder builder;
+        builder.drawShadow(path_, shadow_color_, elevation_,
+                           SkColorGetA(color_) != 0xff, shadow_dpr_);
+        shadow_ = builder.Build();
+      }
+      if (context->cull_rect.intersects(paint_bounds())) {
+        // Shadows are blurred, so they are always worth rasterizing.
+        cache->Prepare(context, shadow_.get(), true, false, matrix);
+      } else {
+        // Don't evict raster cache entry during partial repaint
+        cache->Touch(context, shadow_.get(), matrix);
+      }
+    }
+  }
+
+  // The shape is filled with the color beneath the children, so only its
+  // own area is known to be opaque.
+  SkRect shape_inner_bounds;
+  SkRRect shape_rrect;
+  if (SkColorGetA(color_) != 0xff) {
+    shape_inner_bounds.setEmpty();
+  } else if (path_.isRRect(&shape_rrect)) {
+    shape_inner_bounds = GetRRectInnerBounds(shape_rrect);
+  } else if (!path_.isRect(&shape_inner_bounds)) {
+    shape_inner_bounds.setEmpty();
   }
+  set_opaque_bounds(shape_inner_bounds);
 }
 
 void PhysicalShapeLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PhysicalShapeLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  if (elevation_ != 0) {
+  if (elevation_ != 0 && !DrawCachedShadow(context)) {
     DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
                SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
   }
@@ -125,6 +156,23 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   }
 }
 
+bool PhysicalShapeLayer::DrawCachedShadow(PaintContext& context) const {
+  if (!context.raster_cache || !shadow_ ||
+      shadow_dpr_ != context.frame_device_pixel_ratio) {
+    return false;
+  }
+  SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  context.leaf_nodes_canvas->setMatrix(RasterCache::GetIntegralTransCTM(
+      context.leaf_nodes_canvas->getTotalMatrix()));
+#endif
+  if (context.raster_cache->Draw(*shadow_, *context.leaf_nodes_canvas)) {
+    TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+    return true;
+  }
+  return false;
+}
+
 SkRect PhysicalShapeLayer::ComputeShadowBounds(const SkPath& path,
                                                float elevation,
                                                SkScalar dpr,
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_PHYSICAL_SHAPE_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_PHYSICAL_SHAPE_LAYER_H_
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/container_layer.h"
 
 namespace flutter {
@@ -34,6 +35,8 @@ class PhysicalShapeLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "PhysicalShapeLayer"; }
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
@@ -41,11 +44,21 @@ class PhysicalShapeLayer : public ContainerLayer {
   float elevation() const { return elevation_; }
 
  private:
+  // Draws the image of the shadow from the raster cache, if it has one.
+  bool DrawCachedShadow(PaintContext& context) const;
+
   SkColor color_;
   SkColor shadow_color_;
   float elevation_ = 0.0f;
   SkPath path_;
   Clip clip_behavior_;
+
+  // The shadow alone, recorded for the raster cache. The cache keys display
+  // lists on their contents, so the layers with the same path, elevation,
+  // colors and device pixel ratio share the image of their shadow, across
+  // frames and within one.
+  sk_sp<DisplayList> shadow_;
+  SkScalar shadow_dpr_ = 0;
 };
 
 }  // namespace flutter
@@ -306,6 +306,27 @@ static bool ReadbackResult(PrerollContext* context,
   return context->surface_needs_readback;
 }
 
+TEST_F(PhysicalShapeLayerTest, IdenticalShadowsShareRasterCacheEntry) {
+  SkPath layer_path;
+  layer_path.addRect(0, 0, 80, 40).close();
+  auto layer1 = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorWHITE, SK_ColorBLACK, 4.0f, layer_path, Clip::none);
+  auto layer2 = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorWHITE, SK_ColorBLACK, 4.0f, layer_path, Clip::none);
+  auto layer3 = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorWHITE, SK_ColorBLACK, 8.0f, layer_path, Clip::none);
+
+  use_mock_raster_cache();
+  EXPECT_EQ(raster_cache()->GetPictureCachedEntriesCount(), (size_t)0);
+
+  layer1->Preroll(preroll_context(), SkMatrix::Translate(10, 10));
+  layer2->Preroll(preroll_context(), SkMatrix::Translate(10, 100));
+  EXPECT_EQ(raster_cache()->GetPictureCachedEntriesCount(), (size_t)1);
+
+  layer3->Preroll(preroll_context(), SkMatrix::Translate(10, 200));
+  EXPECT_EQ(raster_cache()->GetPictureCachedEntriesCount(), (size_t)2);
+}
+
 TEST_F(PhysicalShapeLayerTest, Readback) {
   PrerollContext* context = preroll_context();
   SkPath path;
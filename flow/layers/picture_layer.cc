@@ -121,7 +121,7 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
                      offset_);
     } else {
       // Don't evict raster cache entry during partial repaint
-      cache->Touch(sk_picture, matrix);
+      cache->Touch(context, sk_picture, matrix);
     }
   }
 
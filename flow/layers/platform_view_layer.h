@@ -18,6 +18,11 @@ class PlatformViewLayer : public Layer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "PlatformViewLayer"; }
+
+  // Prerolling a platform view updates the ExternalViewEmbedder.
+  bool can_preroll_concurrently() const override { return false; }
+
  private:
   SkPoint offset_;
   SkSize size_;
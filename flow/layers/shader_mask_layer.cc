@@ -31,6 +31,8 @@ void ShaderMaskLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The mask can change the alpha of the children.
+  set_opaque_bounds(SkRect::MakeEmpty());
 }
 
 void ShaderMaskLayer::Paint(PaintContext& context) const {
@@ -21,13 +21,23 @@ TextureLayer::TextureLayer(const SkPoint& offset,
 
 void TextureLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  const TextureRegistry* registry = context->texture_registry();
+  const uint64_t frame_count =
+      registry ? registry->GetFrameCount(texture_id_) : 0;
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(old_layer);
     auto prev = old_layer->as_texture_layer();
-    // TODO(knopp) It would be nice to be able to determine that a texture is
-    // dirty
-    context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    // The layer paints the same pixels as the previous one if the producer of
+    // the texture has not marked a new frame available since. The previous
+    // layer is this one if it is retained.
+    if (frame_count == 0 || prev->frame_count_ != frame_count ||
+        prev->texture_id_ != texture_id_ || prev->offset_ != offset_ ||
+        prev->size_ != size_ || prev->freeze_ != freeze_ ||
+        prev->sampling_ != sampling_) {
+      context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    }
   }
+  frame_count_ = frame_count;
 
   // Make sure DiffContext knows there is a TextureLayer in this subtree.
   // This prevents ContainerLayer from skipping TextureLayer diffing when
@@ -30,12 +30,20 @@ class TextureLayer : public Layer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "TextureLayer"; }
+
+  // The texture affects the raster cache decisions of the layers prerolled
+  // after it.
+  bool can_preroll_concurrently() const override { return false; }
+
  private:
   SkPoint offset_;
   SkSize size_;
   int64_t texture_id_;
   bool freeze_;
   SkSamplingOptions sampling_;
+  // The frame count of the texture when the layer was diffed, or 0.
+  uint64_t frame_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TextureLayer);
 };
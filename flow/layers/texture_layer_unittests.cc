@@ -116,5 +116,31 @@ TEST_F(TextureLayerDiffTest, TextureInRetainedLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
 }
 
+TEST_F(TextureLayerDiffTest, TextureWithoutNewFrame) {
+  TextureRegistry registry;
+  registry.RegisterTexture(std::make_shared<MockTexture>(0));
+  auto make_tree = [] {
+    MockLayerTree tree;
+    tree.root()->Add(std::make_shared<TextureLayer>(
+        SkPoint::Make(0, 0), SkSize::Make(100, 100), 0, false,
+        SkSamplingOptions(SkFilterMode::kLinear)));
+    return tree;
+  };
+
+  MockLayerTree tree1 = make_tree();
+  auto damage =
+      DiffLayerTree(tree1, MockLayerTree(), SkIRect::MakeEmpty(), &registry);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+
+  MockLayerTree tree2 = make_tree();
+  damage = DiffLayerTree(tree2, tree1, SkIRect::MakeEmpty(), &registry);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  registry.MarkNewFrameAvailable(0);
+  MockLayerTree tree3 = make_tree();
+  damage = DiffLayerTree(tree3, tree2, SkIRect::MakeEmpty(), &registry);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+}
+
 }  // namespace testing
 }  // namespace flutter
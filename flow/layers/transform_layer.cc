@@ -61,6 +61,9 @@ void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   transform_.mapRect(&child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_bounds(transform_.rectStaysRect()
+                        ? transform_.mapRect(children_opaque_bounds())
+                        : SkRect::MakeEmpty());
 
   context->cull_rect = previous_cull_rect;
   context->mutators_stack.Pop();
@@ -76,4 +79,13 @@ void TransformLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+bool TransformLayer::MergeChild(const Layer* child) {
+  const TransformLayer* transform = child->as_transform_layer();
+  if (!transform) {
+    return false;
+  }
+  transform_.preConcat(transform->transform_);
+  return true;
+}
+
 }  // namespace flutter
@@ -21,6 +21,15 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* type_name() const override { return "TransformLayer"; }
+
+  const TransformLayer* as_transform_layer() const override { return this; }
+
+  const SkMatrix& transform() const { return transform_; }
+
+ protected:
+  bool MergeChild(const Layer* child) override;
+
  private:
   SkMatrix transform_;
 
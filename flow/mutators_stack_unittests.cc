@@ -36,11 +36,11 @@ TEST(MutatorsStack, CopyAndUpdateTheCopy) {
   ASSERT_TRUE(copy.is_empty());
   ASSERT_TRUE(!stack.is_empty());
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::clip_rrect);
+  ASSERT_TRUE((*iter)->GetRRect() == rrect);
   ++iter;
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE((*iter)->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRect) {
@@ -48,8 +48,8 @@ TEST(MutatorsStack, PushClipRect) {
   auto rect = SkRect::MakeEmpty();
   stack.PushClipRect(rect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE((*iter)->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRRect) {
@@ -57,8 +57,8 @@ TEST(MutatorsStack, PushClipRRect) {
   auto rrect = SkRRect::MakeEmpty();
   stack.PushClipRRect(rrect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::clip_rrect);
+  ASSERT_TRUE((*iter)->GetRRect() == rrect);
 }
 
 TEST(MutatorsStack, PushClipPath) {
@@ -66,8 +66,8 @@ TEST(MutatorsStack, PushClipPath) {
   SkPath path;
   stack.PushClipPath(path);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == flutter::MutatorType::clip_path);
-  ASSERT_TRUE(iter->get()->GetPath() == path);
+  ASSERT_TRUE((*iter)->GetType() == flutter::MutatorType::clip_path);
+  ASSERT_TRUE((*iter)->GetPath() == path);
 }
 
 TEST(MutatorsStack, PushTransform) {
@@ -76,8 +76,8 @@ TEST(MutatorsStack, PushTransform) {
   matrix.setIdentity();
   stack.PushTransform(matrix);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::transform);
-  ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::transform);
+  ASSERT_TRUE((*iter)->GetMatrix() == matrix);
 }
 
 TEST(MutatorsStack, PushOpacity) {
@@ -85,8 +85,8 @@ TEST(MutatorsStack, PushOpacity) {
   int alpha = 240;
   stack.PushOpacity(alpha);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::opacity);
-  ASSERT_TRUE(iter->get()->GetAlpha() == 240);
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::opacity);
+  ASSERT_TRUE((*iter)->GetAlpha() == 240);
 }
 
 TEST(MutatorsStack, Pop) {
@@ -113,16 +113,16 @@ TEST(MutatorsStack, Traversal) {
   while (iter != stack.Top()) {
     switch (index) {
       case 0:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-        ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+        ASSERT_TRUE((*iter)->GetType() == MutatorType::clip_rrect);
+        ASSERT_TRUE((*iter)->GetRRect() == rrect);
         break;
       case 1:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-        ASSERT_TRUE(iter->get()->GetRect() == rect);
+        ASSERT_TRUE((*iter)->GetType() == MutatorType::clip_rect);
+        ASSERT_TRUE((*iter)->GetRect() == rect);
         break;
       case 2:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::transform);
-        ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+        ASSERT_TRUE((*iter)->GetType() == MutatorType::transform);
+        ASSERT_TRUE((*iter)->GetMatrix() == matrix);
         break;
       default:
         break;
@@ -132,6 +132,42 @@ TEST(MutatorsStack, Traversal) {
   }
 }
 
+TEST(MutatorsStack, ForwardTraversal) {
+  MutatorsStack stack;
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+  stack.PushTransform(matrix);
+  auto rect = SkRect::MakeWH(10, 10);
+  stack.PushClipRect(rect);
+  stack.PushOpacity(128);
+  auto iter = stack.Begin();
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::transform);
+  ASSERT_TRUE((*iter)->GetMatrix() == matrix);
+  ++iter;
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE((*iter)->GetRect() == rect);
+  ++iter;
+  ASSERT_TRUE((*iter)->GetType() == MutatorType::opacity);
+  ASSERT_EQ((*iter)->GetAlpha(), 128);
+  ++iter;
+  ASSERT_TRUE(iter == stack.End());
+}
+
+TEST(MutatorsStack, PushingOntoCopyKeepsOriginal) {
+  MutatorsStack stack;
+  auto rect = SkRect::MakeWH(10, 10);
+  stack.PushClipRect(rect);
+  MutatorsStack copy = stack;
+  copy.PushOpacity(128);
+  stack.PushTransform(SkMatrix::Scale(2, 2));
+  ASSERT_TRUE(copy != stack);
+  ASSERT_TRUE((*copy.Bottom())->GetType() == MutatorType::opacity);
+  ASSERT_TRUE((*stack.Bottom())->GetType() == MutatorType::transform);
+  copy.Pop();
+  stack.Pop();
+  ASSERT_TRUE(copy == stack);
+  ASSERT_TRUE(copy == std::vector<Mutator>({Mutator(rect)}));
+}
+
 TEST(MutatorsStack, Equality) {
   MutatorsStack stack;
   SkMatrix matrix = SkMatrix::Scale(1, 1);
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/offscreen_surface_pool.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+
+struct OffscreenSurfacePool::PooledSurface::State {
+  struct Entry {
+    sk_sp<SkSurface> surface;
+    size_t age = 0;
+  };
+  std::vector<Entry> available;
+};
+
+static int RoundUpToBucket(int size) {
+  return (size + OffscreenSurfacePool::kBucketGranularity - 1) /
+         OffscreenSurfacePool::kBucketGranularity *
+         OffscreenSurfacePool::kBucketGranularity;
+}
+
+OffscreenSurfacePool::PooledSurface::PooledSurface(std::weak_ptr<State> pool,
+                                                   sk_sp<SkSurface> surface,
+                                                   const SkISize& size)
+    : pool_(std::move(pool)), surface_(std::move(surface)), size_(size) {
+  // Drop the contents left by the previous lease rather than copying them
+  // if a snapshot of them is still alive.
+  surface_->notifyContentWillChange(SkSurface::kDiscard_ContentChangeMode);
+  SkCanvas* canvas = surface_->getCanvas();
+  canvas->restoreToCount(1);
+  canvas->resetMatrix();
+  canvas->save();
+  canvas->clipRect(SkRect::Make(size_));
+  canvas->clear(SK_ColorTRANSPARENT);
+}
+
+OffscreenSurfacePool::PooledSurface::~PooledSurface() {
+  std::shared_ptr<State> pool = pool_.lock();
+  if (!pool || pool->available.size() >= kMaxAvailableSurfaces) {
+    return;
+  }
+  surface_->getCanvas()->restoreToCount(1);
+  pool->available.push_back({std::move(surface_), 0});
+}
+
+sk_sp<SkImage> OffscreenSurfacePool::PooledSurface::MakeImageSnapshot() const {
+  return surface_->makeImageSnapshot();
+}
+
+sk_sp<SkImage> OffscreenSurfacePool::PooledSurface::MakeRasterImage() const {
+  TRACE_EVENT0("flutter", "DeviceHostTransfer");
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(surface_->imageInfo().makeDimensions(size_))) {
+    return nullptr;
+  }
+  if (!surface_->readPixels(bitmap, 0, 0)) {
+    return nullptr;
+  }
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+OffscreenSurfacePool::OffscreenSurfacePool()
+    : state_(std::make_shared<PooledSurface::State>()) {}
+
+OffscreenSurfacePool::~OffscreenSurfacePool() = default;
+
+std::unique_ptr<OffscreenSurfacePool::PooledSurface>
+OffscreenSurfacePool::Acquire(GrRecordingContext* context,
+                              const SkImageInfo& image_info) {
+  if (image_info.isEmpty()) {
+    return nullptr;
+  }
+  SkImageInfo bucket_info =
+      image_info.makeWH(RoundUpToBucket(image_info.width()),
+                        RoundUpToBucket(image_info.height()));
+  if (context && std::max(bucket_info.width(), bucket_info.height()) >
+                     context->maxRenderTargetSize()) {
+    bucket_info = image_info;
+  }
+
+  auto& available = state_->available;
+  auto it = std::find_if(
+      available.begin(), available.end(), [&](const auto& entry) {
+        const SkImageInfo& info = entry.surface->imageInfo();
+        return entry.surface->recordingContext() == context &&
+               info.dimensions() == bucket_info.dimensions() &&
+               info.colorType() == bucket_info.colorType() &&
+               info.alphaType() == bucket_info.alphaType() &&
+               SkColorSpace::Equals(info.colorSpace(),
+                                    bucket_info.colorSpace());
+      });
+  sk_sp<SkSurface> surface;
+  if (it != available.end()) {
+    surface = std::move(it->surface);
+    available.erase(it);
+  } else {
+    TRACE_EVENT0("flutter", "OffscreenSurfacePool::AllocateSurface");
+    surface = context ? SkSurface::MakeRenderTarget(context, SkBudgeted::kYes,
+                                                    bucket_info)
+                      : SkSurface::MakeRaster(bucket_info);
+    if (!surface) {
+      return nullptr;
+    }
+  }
+  return std::unique_ptr<PooledSurface>(
+      new PooledSurface(state_, std::move(surface), image_info.dimensions()));
+}
+
+void OffscreenSurfacePool::AgeAndCollectOldSurfaces() {
+  auto& available = state_->available;
+  available.erase(std::remove_if(available.begin(), available.end(),
+                                 [](auto& entry) {
+                                   return ++entry.age >= kMaxSurfaceAge;
+                                 }),
+                  available.end());
+}
+
+void OffscreenSurfacePool::Clear() {
+  state_->available.clear();
+}
+
+size_t OffscreenSurfacePool::available_count() const {
+  return state_->available.size();
+}
+
+}  // namespace flutter
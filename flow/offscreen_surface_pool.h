@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_OFFSCREEN_SURFACE_POOL_H_
+#define FLUTTER_FLOW_OFFSCREEN_SURFACE_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrRecordingContext.h"
+
+namespace flutter {
+
+// Keeps the offscreen surfaces that were recently released so that the
+// next offscreen of a similar size can reuse one of them instead of
+// allocating a new render target.
+//
+// The sizes of the surfaces are rounded up to buckets of
+// |kBucketGranularity| pixels, so a pooled surface can be larger than the
+// size that was asked for. Released surfaces that are not reused for
+// |kMaxSurfaceAge| calls to |AgeAndCollectOldSurfaces| are dropped.
+//
+// The pool and its surfaces must be used on a single thread.
+class OffscreenSurfacePool {
+ public:
+  // The granularity in pixels to which surface sizes are rounded up.
+  static constexpr int kBucketGranularity = 32;
+
+  // The number of calls to |AgeAndCollectOldSurfaces|, usually one per
+  // frame, for which a released surface is kept around.
+  static constexpr size_t kMaxSurfaceAge = 3;
+
+  // The max number of released surfaces kept by the pool.
+  static constexpr size_t kMaxAvailableSurfaces = 16;
+
+  // An offscreen surface leased from the pool. The surface goes back to the
+  // pool when this object is destroyed, if the pool is still alive.
+  class PooledSurface {
+   public:
+    ~PooledSurface();
+
+    // The canvas of the surface. It is clipped to |size| and that region has
+    // been cleared to transparent.
+    SkCanvas* canvas() const { return surface_->getCanvas(); }
+
+    // The size that was asked for. The surface itself may be larger.
+    const SkISize& size() const { return size_; }
+
+    // The bytes of the whole surface.
+    size_t surface_bytes() const {
+      return surface_->imageInfo().computeMinByteSize();
+    }
+
+    // A snapshot of the whole surface, of which only the region of |size|
+    // should be drawn. The snapshot must be dropped before this object is
+    // destroyed for the surface to be reused without a copy.
+    sk_sp<SkImage> MakeImageSnapshot() const;
+
+    // Reads the region of |size| back into a raster image.
+    sk_sp<SkImage> MakeRasterImage() const;
+
+   private:
+    friend class OffscreenSurfacePool;
+
+    struct State;
+
+    PooledSurface(std::weak_ptr<State> pool,
+                  sk_sp<SkSurface> surface,
+                  const SkISize& size);
+
+    std::weak_ptr<State> pool_;
+    sk_sp<SkSurface> surface_;
+    const SkISize size_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(PooledSurface);
+  };
+
+  OffscreenSurfacePool();
+
+  ~OffscreenSurfacePool();
+
+  // Returns a surface of at least the size of the |image_info| and with its
+  // color type and color space. The surface is a render target of the
+  // |context|, or a raster surface if the |context| is null.
+  //
+  // Returns nullptr if no surface could be allocated.
+  std::unique_ptr<PooledSurface> Acquire(GrRecordingContext* context,
+                                         const SkImageInfo& image_info);
+
+  // Ages the released surfaces and drops those that have not been reused
+  // for |kMaxSurfaceAge| calls.
+  void AgeAndCollectOldSurfaces();
+
+  // Drops all of the released surfaces. Leased surfaces are dropped when
+  // they are released.
+  void Clear();
+
+  // The number of released surfaces kept by the pool.
+  size_t available_count() const;
+
+ private:
+  std::shared_ptr<PooledSurface::State> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(OffscreenSurfacePool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_OFFSCREEN_SURFACE_POOL_H_
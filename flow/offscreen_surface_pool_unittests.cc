@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/offscreen_surface_pool.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+namespace testing {
+
+static const SkImageInfo kImageInfo = SkImageInfo::MakeN32Premul(40, 20);
+
+TEST(OffscreenSurfacePool, ReleasedSurfacesAreReused) {
+  OffscreenSurfacePool pool;
+  SkCanvas* first_canvas;
+  {
+    auto surface = pool.Acquire(nullptr, kImageInfo);
+    ASSERT_NE(surface, nullptr);
+    ASSERT_EQ(surface->size(), SkISize::Make(40, 20));
+    first_canvas = surface->canvas();
+  }
+  ASSERT_EQ(pool.available_count(), 1u);
+
+  // A size in the same bucket reuses the surface.
+  auto surface = pool.Acquire(nullptr, SkImageInfo::MakeN32Premul(50, 30));
+  ASSERT_NE(surface, nullptr);
+  ASSERT_EQ(surface->canvas(), first_canvas);
+  ASSERT_EQ(surface->size(), SkISize::Make(50, 30));
+  ASSERT_EQ(pool.available_count(), 0u);
+}
+
+TEST(OffscreenSurfacePool, DifferentBucketsAreNotShared) {
+  OffscreenSurfacePool pool;
+  pool.Acquire(nullptr, kImageInfo);
+  auto surface = pool.Acquire(nullptr, SkImageInfo::MakeN32Premul(100, 20));
+  ASSERT_NE(surface, nullptr);
+  ASSERT_EQ(pool.available_count(), 1u);
+}
+
+TEST(OffscreenSurfacePool, OldSurfacesAreCollected) {
+  OffscreenSurfacePool pool;
+  pool.Acquire(nullptr, kImageInfo);
+  for (size_t i = 1; i < OffscreenSurfacePool::kMaxSurfaceAge; i++) {
+    pool.AgeAndCollectOldSurfaces();
+    ASSERT_EQ(pool.available_count(), 1u);
+  }
+  pool.AgeAndCollectOldSurfaces();
+  ASSERT_EQ(pool.available_count(), 0u);
+}
+
+TEST(OffscreenSurfacePool, ReusedSurfaceIsCleared) {
+  OffscreenSurfacePool pool;
+  {
+    auto surface = pool.Acquire(nullptr, kImageInfo);
+    surface->canvas()->clear(SK_ColorRED);
+  }
+  auto surface = pool.Acquire(nullptr, SkImageInfo::MakeN32Premul(36, 12));
+  ASSERT_NE(surface, nullptr);
+  ASSERT_EQ(pool.available_count(), 0u);
+  SkPaint paint;
+  paint.setColor(SK_ColorBLUE);
+  surface->canvas()->drawRect(SkRect::MakeWH(10, 10), paint);
+
+  sk_sp<SkImage> image = surface->MakeRasterImage();
+  ASSERT_NE(image, nullptr);
+  ASSERT_EQ(image->dimensions(), SkISize::Make(36, 12));
+
+  SkBitmap bitmap;
+  bitmap.allocPixels(image->imageInfo());
+  ASSERT_TRUE(image->readPixels(bitmap.pixmap(), 0, 0));
+  ASSERT_EQ(bitmap.getColor(5, 5), SK_ColorBLUE);
+  ASSERT_EQ(bitmap.getColor(20, 5), SK_ColorTRANSPARENT);
+}
+
+TEST(OffscreenSurfacePool, SurfacesReleasedAfterThePoolAreDropped) {
+  auto pool = std::make_unique<OffscreenSurfacePool>();
+  auto surface = pool->Acquire(nullptr, kImageInfo);
+  ASSERT_NE(surface, nullptr);
+  pool.reset();
+  surface.reset();
+}
+
+}  // namespace testing
+}  // namespace flutter
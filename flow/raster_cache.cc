@@ -4,6 +4,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -107,19 +108,37 @@ static bool IsDisplayListWorthRasterizing(DisplayList* display_list,
     return true;
   }
 
-  // TODO(abarth): We should find a better heuristic here that lets us avoid
-  // wasting memory on trivial layers that are easy to re-rasterize every frame.
-  return display_list->op_count(true) > 5;
+  // The complexity score is computed when the display list is built and
+  // weighs the ops by their rendering cost, so a handful of shadows or
+  // paths is worth caching while a handful of rect fills is not.
+  return display_list->complexity_score() > 5;
+}
+
+// Draws an entry into a canvas whose origin is at the origin of the
+// |cache_rect| of the entry.
+static void DrawRasterCacheEntry(
+    SkCanvas* canvas,
+    const SkIRect& cache_rect,
+    const SkMatrix& ctm,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  canvas->translate(-cache_rect.left(), -cache_rect.top());
+  canvas->concat(ctm);
+  draw_function(canvas);
+
+  if (checkerboard) {
+    DrawCheckerboard(canvas, logical_rect);
+  }
 }
 
 /// @note Procedure doesn't copy all closures.
-static std::unique_ptr<RasterCacheResult> Rasterize(
+static sk_sp<SkImage> RasterizeImage(
     GrDirectContext* context,
     const SkMatrix& ctm,
     SkColorSpace* dst_color_space,
     bool checkerboard,
     const SkRect& logical_rect,
-    const char* type,
     const std::function<void(SkCanvas*)>& draw_function) {
   TRACE_EVENT0("flutter", "RasterCachePopulate");
   SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
@@ -138,16 +157,108 @@ static std::unique_ptr<RasterCacheResult> Rasterize(
 
   SkCanvas* canvas = surface->getCanvas();
   canvas->clear(SK_ColorTRANSPARENT);
-  canvas->translate(-cache_rect.left(), -cache_rect.top());
-  canvas->concat(ctm);
-  draw_function(canvas);
+  DrawRasterCacheEntry(canvas, cache_rect, ctm, checkerboard, logical_rect,
+                       draw_function);
 
-  if (checkerboard) {
-    DrawCheckerboard(canvas, logical_rect);
+  return surface->makeImageSnapshot();
+}
+
+namespace {
+
+// An entry that was rasterized into a surface of the offscreen surface pool.
+// The surface is returned to the pool when the entry is evicted.
+class PooledRasterCacheResult : public RasterCacheResult {
+ public:
+  PooledRasterCacheResult(
+      std::unique_ptr<OffscreenSurfacePool::PooledSurface> surface,
+      const SkRect& logical_rect,
+      const char* type)
+      : RasterCacheResult(surface->MakeImageSnapshot(), logical_rect, type),
+        surface_(std::move(surface)) {}
+
+  ~PooledRasterCacheResult() override {
+    // Drop the snapshot first so that the surface can be reused without a
+    // copy.
+    image_ = nullptr;
+  }
+
+  void draw(SkCanvas& canvas, const SkPaint* paint) const override {
+    TRACE_EVENT0("flutter", "RasterCacheResult::draw");
+    SkAutoCanvasRestore auto_restore(&canvas, true);
+    SkIRect bounds =
+        RasterCache::GetDeviceBounds(logical_rect_, canvas.getTotalMatrix());
+    const SkISize& size = surface_->size();
+    FML_DCHECK(std::abs(bounds.size().width() - size.width()) <= 1 &&
+               std::abs(bounds.size().height() - size.height()) <= 1);
+    canvas.resetMatrix();
+    flow_.Step();
+    canvas.drawImageRect(
+        image_, SkRect::Make(size),
+        SkRect::MakeXYWH(bounds.fLeft, bounds.fTop, size.width(),
+                         size.height()),
+        SkSamplingOptions(), paint, SkCanvas::kFast_SrcRectConstraint);
+  }
+
+  SkISize image_dimensions() const override { return surface_->size(); }
+
+  int64_t image_bytes() const override { return surface_->surface_bytes(); }
+
+ private:
+  std::unique_ptr<OffscreenSurfacePool::PooledSurface> surface_;
+};
+
+}  // namespace
+
+/// @note Procedure doesn't copy all closures.
+static std::unique_ptr<RasterCacheResult> Rasterize(
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const char* type,
+    const std::function<void(SkCanvas*)>& draw_function,
+    RasterCacheAtlas* atlas,
+    OffscreenSurfacePool* surface_pool) {
+  if (atlas) {
+    SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
+    std::unique_ptr<RasterCacheResult> result = atlas->Rasterize(
+        context, cache_rect.size(), dst_color_space, logical_rect, type,
+        [&](SkCanvas* canvas) {
+          DrawRasterCacheEntry(canvas, cache_rect, ctm, checkerboard,
+                               logical_rect, draw_function);
+        });
+    if (result) {
+      return result;
+    }
+  }
+
+  // Software rendering allocates cheap raster surfaces and keeps the exact
+  // sizes of the entries.
+  if (context && surface_pool) {
+    TRACE_EVENT0("flutter", "RasterCachePopulate");
+    SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
+    auto surface = surface_pool->Acquire(
+        context,
+        SkImageInfo::MakeN32Premul(cache_rect.width(), cache_rect.height(),
+                                   sk_ref_sp(dst_color_space)));
+    if (!surface) {
+      return nullptr;
+    }
+    DrawRasterCacheEntry(surface->canvas(), cache_rect, ctm, checkerboard,
+                         logical_rect, draw_function);
+    return std::make_unique<PooledRasterCacheResult>(std::move(surface),
+                                                     logical_rect, type);
   }
 
-  return std::make_unique<RasterCacheResult>(surface->makeImageSnapshot(),
-                                             logical_rect, type);
+  sk_sp<SkImage> image = RasterizeImage(context, ctm, dst_color_space,
+                                        checkerboard, logical_rect,
+                                        draw_function);
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(std::move(image), logical_rect,
+                                             type);
 }
 
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
@@ -158,7 +269,8 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
     bool checkerboard) const {
   return Rasterize(context, ctm, dst_color_space, checkerboard,
                    picture->cullRect(), "RasterCacheFlow::SkPicture",
-                   [=](SkCanvas* canvas) { canvas->drawPicture(picture); });
+                   [=](SkCanvas* canvas) { canvas->drawPicture(picture); },
+                   atlas_.get(), &surface_pool_);
 }
 
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizeDisplayList(
@@ -169,21 +281,37 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizeDisplayList(
     bool checkerboard) const {
   return Rasterize(context, ctm, dst_color_space, checkerboard,
                    display_list->bounds(), "RasterCacheFlow::DisplayList",
-                   [=](SkCanvas* canvas) { display_list->RenderTo(canvas); });
+                   [=](SkCanvas* canvas) { display_list->RenderTo(canvas); },
+                   atlas_.get(), &surface_pool_);
 }
 
 void RasterCache::Prepare(PrerollContext* context,
                           Layer* layer,
                           const SkMatrix& ctm) {
-  LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
+  if (context->raster_cache_ops) {
+    context->raster_cache_ops->push_back(
+        [this, layer, ctm](PrerollContext* context) {
+          Prepare(context, layer, ctm);
+        });
+    return;
+  }
+  LayerRasterCacheKey cache_key(layer->unique_id(), ctm, subpixel_steps_);
   Entry& entry = layer_cache_[cache_key];
   entry.access_count++;
   entry.used_this_frame = true;
   if (!entry.image) {
     entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
+    CountNewImage(entry);
   }
 }
 
+bool RasterCache::HasLayerImage(const Layer* layer,
+                                const SkMatrix& ctm) const {
+  LayerRasterCacheKey cache_key(layer->unique_id(), ctm, subpixel_steps_);
+  auto it = layer_cache_.find(cache_key);
+  return it != layer_cache_.end() && it->second.image;
+}
+
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizeLayer(
     PrerollContext* context,
     Layer* layer,
@@ -213,7 +341,10 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizeLayer(
         if (layer->needs_painting(paintContext)) {
           layer->Paint(paintContext);
         }
-      });
+      },
+      // Layers may draw cached children, which could be on the same page
+      // of the atlas, so they are always rasterized into their own surface.
+      nullptr, &surface_pool_);
 }
 
 bool RasterCache::Prepare(PrerollContext* context,
@@ -222,6 +353,15 @@ bool RasterCache::Prepare(PrerollContext* context,
                           bool will_change,
                           const SkMatrix& untranslated_matrix,
                           const SkPoint& offset) {
+  if (context->raster_cache_ops) {
+    context->raster_cache_ops->push_back(
+        [this, picture, is_complex, will_change, untranslated_matrix,
+         offset](PrerollContext* context) {
+          Prepare(context, picture, is_complex, will_change,
+                  untranslated_matrix, offset);
+        });
+    return false;
+  }
   if (!GenerateNewCacheInThisFrame()) {
     return false;
   }
@@ -239,7 +379,8 @@ bool RasterCache::Prepare(PrerollContext* context,
     return false;
   }
 
-  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
+  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix,
+                                  subpixel_steps_);
 
   // Creates an entry, if not present prior.
   Entry& entry = picture_cache_[cache_key];
@@ -258,6 +399,7 @@ bool RasterCache::Prepare(PrerollContext* context,
     entry.image =
         RasterizePicture(picture, context->gr_context, transformation_matrix,
                          context->dst_color_space, checkerboard_images_);
+    CountNewImage(entry);
     picture_cached_this_frame_++;
   }
   return true;
@@ -269,7 +411,19 @@ bool RasterCache::Prepare(PrerollContext* context,
                           bool will_change,
                           const SkMatrix& untranslated_matrix,
                           const SkPoint& offset) {
-  if (!GenerateNewCacheInThisFrame()) {
+  if (context->raster_cache_ops) {
+    context->raster_cache_ops->push_back(
+        [this, display_list, is_complex, will_change, untranslated_matrix,
+         offset](PrerollContext* context) {
+          Prepare(context, display_list, is_complex, will_change,
+                  untranslated_matrix, offset);
+        });
+    return false;
+  }
+  const bool rasterize_async = async_task_runner_ && display_list &&
+                               display_list->can_render_off_thread();
+  if (rasterize_async ? !ScheduleNewAsyncCache()
+                      : !GenerateNewCacheInThisFrame()) {
     return false;
   }
 
@@ -286,11 +440,15 @@ bool RasterCache::Prepare(PrerollContext* context,
     return false;
   }
 
-  DisplayListRasterCacheKey cache_key(display_list->unique_id(),
-                                      transformation_matrix);
+  DisplayListRasterCacheKey cache_key(display_list->content_hash(),
+                                      transformation_matrix, subpixel_steps_);
 
   // Creates an entry, if not present prior.
   Entry& entry = display_list_cache_[cache_key];
+  if (!MatchDisplayList(entry, *display_list)) {
+    // The hash of a different list collided with the hash of this list.
+    return false;
+  }
   if (entry.access_count < access_threshold_) {
     // Frame threshold has not yet been reached.
     return false;
@@ -303,16 +461,51 @@ bool RasterCache::Prepare(PrerollContext* context,
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     transformation_matrix = GetIntegralTransCTM(transformation_matrix);
 #endif
+    if (rasterize_async) {
+      if (!entry.pending) {
+        entry.pending = true;
+        RasterizeDisplayListAsync(cache_key, display_list,
+                                  transformation_matrix,
+                                  context->dst_color_space);
+      }
+      // The entry will be available from the first frame after it has
+      // been rasterized.
+      return false;
+    }
     entry.image = RasterizeDisplayList(
         display_list, context->gr_context, transformation_matrix,
         context->dst_color_space, checkerboard_images_);
+    CountNewImage(entry);
     display_list_cached_this_frame_++;
   }
   return true;
 }
 
-void RasterCache::Touch(Layer* layer, const SkMatrix& ctm) {
-  LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
+bool RasterCache::MatchDisplayList(Entry& entry,
+                                   const DisplayList& display_list) {
+  if (entry.display_list.get() == &display_list) {
+    return true;
+  }
+  if (entry.display_list && !entry.display_list->Equals(display_list)) {
+    return false;
+  }
+  // Remember the most recent list so that later lookups with the same list
+  // only have to compare the pointers.
+  entry.display_list = sk_ref_sp(&display_list);
+  return true;
+}
+
+void RasterCache::Touch(PrerollContext* context,
+                        Layer* layer,
+                        const SkMatrix& ctm) {
+  if (context->raster_cache_ops) {
+    context->raster_cache_ops->push_back(
+        [this, layer, ctm](PrerollContext* context) {
+          Touch(context, layer, ctm);
+        });
+    return;
+  }
+  LayerRasterCacheKey cache_key(layer->unique_id(), ctm, subpixel_steps_);
   auto it = layer_cache_.find(cache_key);
   if (it != layer_cache_.end()) {
     it->second.used_this_frame = true;
@@ -320,9 +513,18 @@ void RasterCache::Touch(Layer* layer, const SkMatrix& ctm) {
   }
 }
 
-void RasterCache::Touch(SkPicture* picture,
+void RasterCache::Touch(PrerollContext* context,
+                        SkPicture* picture,
                         const SkMatrix& transformation_matrix) {
-  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
+  if (context->raster_cache_ops) {
+    context->raster_cache_ops->push_back(
+        [this, picture, transformation_matrix](PrerollContext* context) {
+          Touch(context, picture, transformation_matrix);
+        });
+    return;
+  }
+  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix,
+                                  subpixel_steps_);
   auto it = picture_cache_.find(cache_key);
   if (it != picture_cache_.end()) {
     it->second.used_this_frame = true;
@@ -330,21 +532,32 @@ void RasterCache::Touch(SkPicture* picture,
   }
 }
 
-void RasterCache::Touch(DisplayList* display_list,
+void RasterCache::Touch(PrerollContext* context,
+                        DisplayList* display_list,
                         const SkMatrix& transformation_matrix) {
-  DisplayListRasterCacheKey cache_key(display_list->unique_id(),
-                                      transformation_matrix);
+  if (context->raster_cache_ops) {
+    context->raster_cache_ops->push_back(
+        [this, display_list, transformation_matrix](PrerollContext* context) {
+          Touch(context, display_list, transformation_matrix);
+        });
+    return;
+  }
+  DisplayListRasterCacheKey cache_key(display_list->content_hash(),
+                                      transformation_matrix, subpixel_steps_);
   auto it = display_list_cache_.find(cache_key);
-  if (it != display_list_cache_.end()) {
+  if (it != display_list_cache_.end() &&
+      MatchDisplayList(it->second, *display_list)) {
     it->second.used_this_frame = true;
     it->second.access_count++;
   }
 }
 
 bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
-  PictureRasterCacheKey cache_key(picture.uniqueID(), canvas.getTotalMatrix());
+  PictureRasterCacheKey cache_key(picture.uniqueID(), canvas.getTotalMatrix(),
+                                  subpixel_steps_);
   auto it = picture_cache_.find(cache_key);
   if (it == picture_cache_.end()) {
+    picture_draws_.miss_count++;
     return false;
   }
 
@@ -353,19 +566,24 @@ bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
   entry.used_this_frame = true;
 
   if (entry.image) {
+    picture_draws_.hit_count++;
     entry.image->draw(canvas, nullptr);
     return true;
   }
 
+  picture_draws_.miss_count++;
   return false;
 }
 
 bool RasterCache::Draw(const DisplayList& display_list,
-                       SkCanvas& canvas) const {
-  DisplayListRasterCacheKey cache_key(display_list.unique_id(),
-                                      canvas.getTotalMatrix());
+                       SkCanvas& canvas,
+                       SkPaint* paint) const {
+  DisplayListRasterCacheKey cache_key(
+      display_list.content_hash(), canvas.getTotalMatrix(), subpixel_steps_);
   auto it = display_list_cache_.find(cache_key);
-  if (it == display_list_cache_.end()) {
+  if (it == display_list_cache_.end() ||
+      !MatchDisplayList(it->second, display_list)) {
+    picture_draws_.miss_count++;
     return false;
   }
 
@@ -374,19 +592,23 @@ bool RasterCache::Draw(const DisplayList& display_list,
   entry.used_this_frame = true;
 
   if (entry.image) {
-    entry.image->draw(canvas, nullptr);
+    picture_draws_.hit_count++;
+    entry.image->draw(canvas, paint);
     return true;
   }
 
+  picture_draws_.miss_count++;
   return false;
 }
 
 bool RasterCache::Draw(const Layer* layer,
                        SkCanvas& canvas,
                        SkPaint* paint) const {
-  LayerRasterCacheKey cache_key(layer->unique_id(), canvas.getTotalMatrix());
+  LayerRasterCacheKey cache_key(layer->unique_id(), canvas.getTotalMatrix(),
+                                subpixel_steps_);
   auto it = layer_cache_.find(cache_key);
   if (it == layer_cache_.end()) {
+    layer_draws_.miss_count++;
     return false;
   }
 
@@ -395,36 +617,185 @@ bool RasterCache::Draw(const Layer* layer,
   entry.used_this_frame = true;
 
   if (entry.image) {
+    layer_draws_.hit_count++;
     entry.image->draw(canvas, paint);
     return true;
   }
 
+  layer_draws_.miss_count++;
   return false;
 }
 
 void RasterCache::PrepareNewFrame() {
   picture_cached_this_frame_ = 0;
   display_list_cached_this_frame_ = 0;
+  PublishAsyncResults();
+}
+
+void RasterCache::EnableAsyncRasterization(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    ResourceContextGetter resource_context) {
+  async_task_runner_ = std::move(task_runner);
+  async_resource_context_ = std::move(resource_context);
+  if (!async_results_) {
+    async_results_ = std::make_shared<AsyncResults>();
+  }
+}
+
+void RasterCache::RasterizeDisplayListAsync(
+    const DisplayListRasterCacheKey& cache_key,
+    DisplayList* display_list,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space) {
+  TRACE_EVENT0("flutter", "RasterCache::RasterizeDisplayListAsync");
+  FML_DCHECK(display_list->can_render_off_thread());
+  pending_async_count_++;
+  async_task_runner_->PostTask(
+      [results = async_results_, resource_context = async_resource_context_,
+       cache_key, display_list = sk_ref_sp(display_list), ctm,
+       dst_color_space = sk_ref_sp(dst_color_space),
+       checkerboard = checkerboard_images_]() {
+        const SkRect& logical_rect = display_list->bounds();
+        sk_sp<SkImage> image = RasterizeImage(
+            nullptr, ctm, dst_color_space.get(), checkerboard, logical_rect,
+            [&display_list](SkCanvas* canvas) {
+              display_list->RenderTo(canvas);
+            });
+
+        // Upload the pixels on this thread too, the same way that decoded
+        // images are handed to the raster thread.
+        GrDirectContext* context =
+            resource_context ? resource_context() : nullptr;
+        SkPixmap pixmap;
+        if (image && context && image->peekPixels(&pixmap)) {
+          TRACE_EVENT0("flutter", "MakeCrossContextImageFromPixmap");
+          sk_sp<SkImage> texture_image = SkImage::MakeCrossContextFromPixmap(
+              context,  // context
+              pixmap,   // pixmap
+              false,    // buildMips,
+              false     // limitToMaxTextureSize
+          );
+          if (texture_image) {
+            image = std::move(texture_image);
+          }
+        }
+
+        std::unique_ptr<RasterCacheResult> result;
+        if (image) {
+          result = std::make_unique<RasterCacheResult>(
+              std::move(image), logical_rect, "RasterCacheFlow::DisplayList");
+        }
+        // A null result is still published so that the raster thread can
+        // stop waiting for the entry.
+        std::scoped_lock lock(results->mutex);
+        results->display_lists.emplace_back(cache_key, std::move(result));
+      });
+}
+
+void RasterCache::PublishAsyncResults() {
+  if (!async_results_) {
+    return;
+  }
+  std::vector<std::pair<DisplayListRasterCacheKey,
+                        std::unique_ptr<RasterCacheResult>>>
+      display_lists;
+  {
+    std::scoped_lock lock(async_results_->mutex);
+    display_lists.swap(async_results_->display_lists);
+  }
+  for (auto& [cache_key, result] : display_lists) {
+    FML_DCHECK(pending_async_count_ > 0);
+    pending_async_count_--;
+    auto it = display_list_cache_.find(cache_key);
+    if (it == display_list_cache_.end() || !it->second.pending) {
+      // The entry was evicted while it was being rasterized.
+      continue;
+    }
+    it->second.pending = false;
+    it->second.image = std::move(result);
+    CountNewImage(it->second);
+  }
 }
 
 void RasterCache::CleanupAfterFrame() {
   picture_metrics_ = {};
   layer_metrics_ = {};
+  picture_metrics_.hit_count = picture_draws_.hit_count;
+  picture_metrics_.miss_count = picture_draws_.miss_count;
+  layer_metrics_.hit_count = layer_draws_.hit_count;
+  layer_metrics_.miss_count = layer_draws_.miss_count;
+  total_hit_count_ += picture_draws_.hit_count + layer_draws_.hit_count;
+  total_miss_count_ += picture_draws_.miss_count + layer_draws_.miss_count;
+  picture_draws_ = {};
+  layer_draws_ = {};
+  current_frame_++;
+  cached_bytes_ = 0;
   {
     TRACE_EVENT0("flutter", "RasterCache::SweepCaches");
-    SweepOneCacheAfterFrame(picture_cache_, picture_metrics_);
-    SweepOneCacheAfterFrame(display_list_cache_, picture_metrics_);
-    SweepOneCacheAfterFrame(layer_cache_, layer_metrics_);
+    std::vector<std::pair<size_t, size_t>> retained;
+    SweepOneCacheAfterFrame(picture_cache_, picture_metrics_, retained);
+    SweepOneCacheAfterFrame(display_list_cache_, picture_metrics_, retained);
+    SweepOneCacheAfterFrame(layer_cache_, layer_metrics_, retained);
+    EvictLeastRecentlyUsed(retained);
   }
+  surface_pool_.AgeAndCollectOldSurfaces();
   TraceStatsToTimeline();
 }
 
+void RasterCache::EvictLeastRecentlyUsed(
+    std::vector<std::pair<size_t, size_t>>& retained) {
+  if (max_bytes_ == 0 || cached_bytes_ <= max_bytes_) {
+    return;
+  }
+
+  // Find the most recent frame whose retained entries need to be evicted,
+  // oldest first, to bring the cache within its budget. The entries used
+  // in this frame are never evicted.
+  std::sort(retained.begin(), retained.end());
+  size_t bytes = cached_bytes_;
+  size_t last_used_frame = 0;
+  for (const auto& [frame, entry_bytes] : retained) {
+    if (bytes <= max_bytes_) {
+      break;
+    }
+    bytes -= entry_bytes;
+    last_used_frame = frame;
+  }
+  if (bytes == cached_bytes_) {
+    return;
+  }
+
+  EvictRetainedEntries(picture_cache_, picture_metrics_, last_used_frame);
+  EvictRetainedEntries(display_list_cache_, picture_metrics_,
+                       last_used_frame);
+  EvictRetainedEntries(layer_cache_, layer_metrics_, last_used_frame);
+}
+
 void RasterCache::Clear() {
   picture_cache_.clear();
   display_list_cache_.clear();
   layer_cache_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
+  picture_draws_ = {};
+  layer_draws_ = {};
+  cached_bytes_ = 0;
+  if (atlas_) {
+    atlas_->Clear();
+  }
+  // The entries cleared above have returned their surfaces to the pool.
+  surface_pool_.Clear();
+  gr_context_ = nullptr;
+  gr_context_attached_ = false;
+}
+
+bool RasterCache::AttachGrContext(GrDirectContext* gr_context) {
+  if (!gr_context_attached_) {
+    gr_context_ = gr_context;
+    gr_context_attached_ = true;
+    return true;
+  }
+  return gr_context_ == gr_context;
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
@@ -440,6 +811,26 @@ size_t RasterCache::GetPictureCachedEntriesCount() const {
   return picture_cache_.size() + display_list_cache_.size();
 }
 
+void RasterCache::SetSubpixelSteps(int subpixel_steps) {
+#ifdef SUPPORT_FRACTIONAL_TRANSLATION
+  if (subpixel_steps < 1 || subpixel_steps_ == subpixel_steps) {
+    return;
+  }
+  subpixel_steps_ = subpixel_steps;
+
+  // The existing entries were keyed on the previous grid.
+  Clear();
+#endif
+}
+
+void RasterCache::SetAtlasEnabled(bool enabled) {
+  if (enabled == atlas_enabled()) {
+    return;
+  }
+  // Existing entries keep the pages they were rasterized into.
+  atlas_ = enabled ? std::make_unique<RasterCacheAtlas>() : nullptr;
+}
+
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   if (checkerboard_images_ == checkerboard) {
     return;
@@ -490,4 +881,37 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
+std::vector<RasterCacheEntryInfo> RasterCache::GetEntryInfos() const {
+  std::vector<RasterCacheEntryInfo> infos;
+  infos.reserve(picture_cache_.size() + display_list_cache_.size() +
+                layer_cache_.size());
+  auto add_entries = [this, &infos](const auto& cache,
+                                    RasterCacheEntryInfo::Type type) {
+    for (const auto& item : cache) {
+      const Entry& entry = item.second;
+      RasterCacheEntryInfo info;
+      info.type = type;
+      info.access_count = entry.access_count;
+      info.last_used_frame = entry.last_used_frame;
+      if (entry.image) {
+        info.bytes = entry.image->image_bytes();
+        info.age = current_frame_ - entry.image_frame;
+      }
+      infos.push_back(info);
+    }
+  };
+  add_entries(picture_cache_, RasterCacheEntryInfo::Type::kPicture);
+  add_entries(display_list_cache_, RasterCacheEntryInfo::Type::kDisplayList);
+  add_entries(layer_cache_, RasterCacheEntryInfo::Type::kLayer);
+  return infos;
+}
+
+double RasterCache::GetHitRatio() const {
+  size_t draw_count = total_hit_count_ + total_miss_count_;
+  if (draw_count == 0) {
+    return 0;
+  }
+  return static_cast<double>(total_hit_count_) / draw_count;
+}
+
 }  // namespace flutter
@@ -5,13 +5,20 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/flow/display_list.h"
+#include "flutter/flow/offscreen_surface_pool.h"
+#include "flutter/flow/raster_cache_atlas.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
@@ -36,7 +43,7 @@ class RasterCacheResult {
     return image_ ? image_->imageInfo().computeMinByteSize() : 0;
   };
 
- private:
+ protected:
   sk_sp<SkImage> image_;
   SkRect logical_rect_;
   fml::tracing::TraceFlow flow_;
@@ -44,6 +51,12 @@ class RasterCacheResult {
 
 struct PrerollContext;
 
+// The calls to the raster cache made by a preroll that runs on a worker
+// thread. They are replayed in order on the raster thread, with the
+// PrerollContext of the raster thread.
+using DeferredRasterCacheOps =
+    std::vector<std::function<void(PrerollContext* context)>>;
+
 struct RasterCacheMetrics {
   /**
    * The number of cache entries with images evicted in this frame.
@@ -65,19 +78,74 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images that were not used in this
+   * frame, but were kept because the cache was within its byte budget.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images retained after this frame.
+   */
+  size_t retained_bytes = 0;
+
+  /**
+   * The number of draws in this frame that found a cached image.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * The number of draws in this frame that found no cached image.
+   */
+  size_t miss_count = 0;
+
   /**
    * The total cache entries that had images during this frame whether
-   * they were used in the frame or held memory during the frame and then
-   * were evicted after it ended.
+   * they were used in the frame, retained after it, or held memory during
+   * the frame and then were evicted after it ended.
    */
-  size_t total_count() const { return in_use_count + eviction_count; }
+  size_t total_count() const {
+    return in_use_count + retained_count + eviction_count;
+  }
 
   /**
    * The size of all of the cached images during this frame whether
-   * they were used in the frame or held memory during the frame and then
-   * were evicted after it ended.
+   * they were used in the frame, retained after it, or held memory during
+   * the frame and then were evicted after it ended.
+   */
+  size_t total_bytes() const {
+    return in_use_bytes + retained_bytes + eviction_bytes;
+  }
+};
+
+/**
+ * A snapshot of a single entry of the RasterCache, for telemetry.
+ */
+struct RasterCacheEntryInfo {
+  enum class Type { kPicture, kDisplayList, kLayer };
+
+  Type type;
+
+  /**
+   * The size of the cached image, or 0 if the entry has no image yet.
+   */
+  size_t bytes = 0;
+
+  /**
+   * The number of times the entry was prepared or drawn.
+   */
+  size_t access_count = 0;
+
+  /**
+   * The number of frames since the image of the entry was rasterized.
+   */
+  size_t age = 0;
+
+  /**
+   * The last frame in which the entry was used, as counted by
+   * RasterCache::current_frame.
    */
-  size_t total_bytes() const { return in_use_bytes + eviction_bytes; }
+  size_t last_used_frame = 0;
 };
 
 class RasterCache {
@@ -88,6 +156,26 @@ class RasterCache {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDispLayListCacheLimitPerFrame = 3;
 
+  // The max number of display list rasterizations that may be in flight on
+  // the worker task runner at any one time when the asynchronous mode is
+  // enabled. See |EnableAsyncRasterization|.
+  static constexpr size_t kMaxPendingAsyncRasterizations = 16;
+
+  // The default number of steps per pixel that the fractional translation
+  // of the matrix is rounded to in the cache keys. Builds that do not
+  // support fractional translation snap every cached draw to whole pixels,
+  // so they ignore the translation entirely.
+#ifdef SUPPORT_FRACTIONAL_TRANSLATION
+  static constexpr int kDefaultSubpixelSteps = 4;
+#else
+  static constexpr int kDefaultSubpixelSteps = 1;
+#endif
+
+  // Returns the GrDirectContext that cache entries that are rasterized
+  // asynchronously are uploaded with. Only called on the worker task runner,
+  // and may return nullptr to keep the entries in CPU memory.
+  using ResourceContextGetter = std::function<GrDirectContext*()>;
+
   explicit RasterCache(size_t access_threshold = 3,
                        size_t picture_and_display_list_cache_limit_per_frame =
                            kDefaultPictureAndDispLayListCacheLimitPerFrame);
@@ -179,6 +267,8 @@ class RasterCache {
   // 2. The picture is not worth rasterizing
   // 3. The matrix is singular
   // 4. The picture is accessed too few times
+  // 5. The |context| has raster_cache_ops, in which case the call is
+  //    recorded there to be replayed on the raster thread
   bool Prepare(PrerollContext* context,
                SkPicture* picture,
                bool is_complex,
@@ -196,12 +286,21 @@ class RasterCache {
   // used for this frame in order to not get evicted. This is needed during
   // partial repaint for layers that are outside of current clip and are culled
   // away.
-  void Touch(SkPicture* picture, const SkMatrix& transformation_matrix);
-  void Touch(DisplayList* display_list, const SkMatrix& transformation_matrix);
-  void Touch(Layer* layer, const SkMatrix& ctm);
+  //
+  // Like Prepare, the call is deferred if the |context| has raster_cache_ops.
+  void Touch(PrerollContext* context,
+             SkPicture* picture,
+             const SkMatrix& transformation_matrix);
+  void Touch(PrerollContext* context,
+             DisplayList* display_list,
+             const SkMatrix& transformation_matrix);
+  void Touch(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
+  // Whether an image of the layer has been rasterized for the |ctm|.
+  bool HasLayerImage(const Layer* layer, const SkMatrix& ctm) const;
+
   // Find the raster cache for the picture and draw it to the canvas.
   //
   // Return true if it's found and drawn.
@@ -209,8 +308,13 @@ class RasterCache {
 
   // Find the raster cache for the display list and draw it to the canvas.
   //
+  // Additional paint can be given to change how the raster cache is drawn
+  // (e.g., draw the raster cache with some opacity).
+  //
   // Return true if it's found and drawn.
-  bool Draw(const DisplayList& display_list, SkCanvas& canvas) const;
+  bool Draw(const DisplayList& display_list,
+            SkCanvas& canvas,
+            SkPaint* paint = nullptr) const;
 
   // Find the raster cache for the layer and draw it to the canvas.
   //
@@ -229,6 +333,116 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  /**
+   * @brief Rasterize display list cache entries on the |task_runner| rather
+   * than during the Preroll of the frame that first asks for them.
+   *
+   * Display lists that are eligible for caching are rasterized into a CPU
+   * backed image on the |task_runner| and then uploaded as a cross context
+   * texture with the GrDirectContext returned by |resource_context|. The
+   * entry is published at the start of the first frame after it has been
+   * rasterized. Since the raster thread does not wait for it, these entries
+   * are not subject to the per frame cache limit, but at most
+   * |kMaxPendingAsyncRasterizations| of them can be in flight at a time.
+   *
+   * Display lists which cannot be rendered off the raster thread (see
+   * DisplayList::can_render_off_thread), pictures and layers are still
+   * rasterized synchronously.
+   */
+  void EnableAsyncRasterization(fml::RefPtr<fml::TaskRunner> task_runner,
+                                ResourceContextGetter resource_context);
+
+  bool async_rasterization_enabled() const { return !!async_task_runner_; }
+
+  /**
+   * @brief Set the number of bytes of cached images that the cache may keep.
+   *
+   * Entries that were not used in a frame are normally evicted at the end
+   * of that frame. With a non-zero budget, they are retained instead until
+   * the cached images take more than |max_bytes|, at which point the least
+   * recently used entries are evicted first. No new pictures or display
+   * lists are rasterized while the cache is over its budget.
+   *
+   * A budget of 0, the default, evicts every entry that was not used in a
+   * frame and puts no ceiling on the cache.
+   */
+  void SetMaxBytes(size_t max_bytes) { max_bytes_ = max_bytes; }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief Set the number of steps per pixel that the fractional translation
+   * of the matrix is rounded to when looking up cache entries.
+   *
+   * An image that was cached at one subpixel offset is reused when the same
+   * picture, display list or layer is drawn at any offset that rounds to the
+   * same step, instead of being rasterized again. More steps reuse the
+   * images less, but draw them closer to their exact position.
+   *
+   * Changing the number of steps clears the cache. It has no effect on
+   * builds that do not support fractional translation (see
+   * |kDefaultSubpixelSteps|).
+   */
+  void SetSubpixelSteps(int subpixel_steps);
+
+  int subpixel_steps() const { return subpixel_steps_; }
+
+  /**
+   * @brief Store small entries in the pages of a shared texture atlas rather
+   * than in a texture of their own.
+   *
+   * Entries of up to RasterCacheAtlas::kMaxEntrySize pixels on each side
+   * are packed into a few large pages, which reduces the number of texture
+   * allocations for screens with many small cached items. Layers, entries
+   * that do not fit and entries that are rasterized asynchronously still
+   * use their own textures.
+   */
+  void SetAtlasEnabled(bool enabled);
+
+  bool atlas_enabled() const { return !!atlas_; }
+
+  /**
+   * Return the number of pages allocated by the atlas, if it is enabled.
+   */
+  size_t GetAtlasPageCount() const {
+    return atlas_ ? atlas_->page_count() : 0;
+  }
+
+  /**
+   * @brief The pool of offscreen surfaces that the entries rendered with a
+   * GPU context are rasterized into. Evicted entries return their surfaces
+   * to the pool, and the pool can be shared with other offscreen rendering
+   * on the raster thread, such as snapshots.
+   */
+  OffscreenSurfacePool& surface_pool() { return surface_pool_; }
+
+  /**
+   * @brief Record that another CompositorContext shares this cache, or that
+   * one has stopped sharing it.
+   *
+   * Each of the sharing contexts prepares and cleans up the cache around
+   * its own frames, so an entry is only evicted once it has gone unused for
+   * as many frames as there are contexts sharing the cache. All of them
+   * must use the cache on the same thread.
+   */
+  void AddSharedClient() { client_count_++; }
+  void RemoveSharedClient() {
+    FML_DCHECK(client_count_ > 1);
+    client_count_--;
+  }
+
+  size_t shared_client_count() const { return client_count_; }
+
+  /**
+   * @brief Associate the cache with the GrDirectContext that its images are
+   * rendered with.
+   *
+   * Returns false if the cache is already associated with another context,
+   * in which case its images cannot be drawn with |gr_context|. Clearing
+   * the cache removes the association.
+   */
+  bool AttachGrContext(GrDirectContext* gr_context);
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -278,25 +492,110 @@ class RasterCache {
    */
   int access_threshold() const { return access_threshold_; }
 
+  /**
+   * @brief Return the max number of pictures and display lists that are
+   * rasterized into the cache in a single frame.
+   */
+  size_t picture_and_display_list_cache_limit_per_frame() const {
+    return picture_and_display_list_cache_limit_per_frame_;
+  }
+
+  /**
+   * @brief Return a snapshot of every entry of the cache, including the
+   * entries that have not been populated with an image.
+   */
+  std::vector<RasterCacheEntryInfo> GetEntryInfos() const;
+
+  /**
+   * @brief The number of frames that the cache has been cleaned up after.
+   */
+  size_t current_frame() const { return current_frame_; }
+
+  /**
+   * @brief The number of draws of pictures, display lists and layers that
+   * found a cached image, over the lifetime of the cache.
+   */
+  size_t total_hit_count() const { return total_hit_count_; }
+
+  /**
+   * @brief The number of draws of pictures, display lists and layers that
+   * found no cached image, over the lifetime of the cache.
+   */
+  size_t total_miss_count() const { return total_miss_count_; }
+
+  /**
+   * @brief The fraction of all draws that found a cached image, or 0 if
+   * nothing has been drawn yet.
+   */
+  double GetHitRatio() const;
+
  private:
   struct Entry {
     bool used_this_frame = false;
+    // Set while the image for the entry is being rasterized asynchronously.
+    bool pending = false;
     size_t access_count = 0;
+    // The last frame in which the entry was used, for the LRU eviction of
+    // retained entries.
+    size_t last_used_frame = 0;
+    // The frame in which the image of the entry was rasterized.
+    size_t image_frame = 0;
+    // For display list entries, the list whose contents the entry holds.
+    // Entries are keyed on the content hash of the list, so lookups confirm
+    // that the contents of the list match.
+    sk_sp<const DisplayList> display_list;
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  // The results of asynchronous rasterizations, handed from the worker task
+  // runner to the raster thread. Shared with the tasks in flight so that it
+  // outlives the cache.
+  struct AsyncResults {
+    std::mutex mutex;
+    std::vector<std::pair<DisplayListRasterCacheKey,
+                          std::unique_ptr<RasterCacheResult>>>
+        display_lists;
+  };
+
+  // The draws of the current frame that did or did not find a cached
+  // image, moved into the metrics at the end of the frame.
+  struct DrawCounts {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+  };
+
+  // Unused entries with images are kept when the cache has a byte budget,
+  // and are collected in |retained| along with their last used frame so
+  // that the least recently used can be evicted afterwards if the budget
+  // is exceeded.
   template <class Cache>
-  static void SweepOneCacheAfterFrame(Cache& cache,
-                                      RasterCacheMetrics& metrics) {
+  void SweepOneCacheAfterFrame(
+      Cache& cache,
+      RasterCacheMetrics& metrics,
+      std::vector<std::pair<size_t, size_t>>& retained) {
     std::vector<typename Cache::iterator> dead;
 
     for (auto it = cache.begin(); it != cache.end(); ++it) {
       Entry& entry = it->second;
-      if (!entry.used_this_frame) {
+      // An entry may have been used by one of the other clients in the
+      // frames since the last frame of this client.
+      bool used_by_client =
+          current_frame_ - entry.last_used_frame < client_count_;
+      if (entry.used_this_frame) {
+        entry.last_used_frame = current_frame_;
+        if (entry.image) {
+          metrics.in_use_count++;
+          metrics.in_use_bytes += entry.image->image_bytes();
+          cached_bytes_ += entry.image->image_bytes();
+        }
+      } else if (!used_by_client && (max_bytes_ == 0 || !entry.image)) {
         dead.push_back(it);
       } else if (entry.image) {
-        metrics.in_use_count++;
-        metrics.in_use_bytes += entry.image->image_bytes();
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+        cached_bytes_ += entry.image->image_bytes();
+        retained.emplace_back(entry.last_used_frame,
+                              entry.image->image_bytes());
       }
       entry.used_this_frame = false;
     }
@@ -310,13 +609,64 @@ class RasterCache {
     }
   }
 
+  // Evicts the retained entries that were last used in or before
+  // |last_used_frame|.
+  template <class Cache>
+  void EvictRetainedEntries(Cache& cache,
+                            RasterCacheMetrics& metrics,
+                            size_t last_used_frame) {
+    for (auto it = cache.begin(); it != cache.end();) {
+      Entry& entry = it->second;
+      if (entry.image && entry.last_used_frame < current_frame_ &&
+          entry.last_used_frame <= last_used_frame) {
+        size_t bytes = entry.image->image_bytes();
+        metrics.retained_count--;
+        metrics.retained_bytes -= bytes;
+        metrics.eviction_count++;
+        metrics.eviction_bytes += bytes;
+        cached_bytes_ -= bytes;
+        it = cache.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void EvictLeastRecentlyUsed(
+      std::vector<std::pair<size_t, size_t>>& retained);
+
+  bool IsOverBudget() const {
+    return max_bytes_ != 0 && cached_bytes_ >= max_bytes_;
+  }
+
+  void CountNewImage(Entry& entry) {
+    if (entry.image) {
+      cached_bytes_ += entry.image->image_bytes();
+      entry.image_frame = current_frame_;
+    }
+  }
+
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
-    return access_threshold_ != 0 &&
+    return access_threshold_ != 0 && !IsOverBudget() &&
            picture_cached_this_frame_ + display_list_cached_this_frame_ <
                picture_and_display_list_cache_limit_per_frame_;
   }
 
+  bool ScheduleNewAsyncCache() const {
+    return access_threshold_ != 0 && !IsOverBudget() &&
+           pending_async_count_ < kMaxPendingAsyncRasterizations;
+  }
+
+  void RasterizeDisplayListAsync(const DisplayListRasterCacheKey& cache_key,
+                                 DisplayList* display_list,
+                                 const SkMatrix& ctm,
+                                 SkColorSpace* dst_color_space);
+
+  void PublishAsyncResults();
+
+  static bool MatchDisplayList(Entry& entry, const DisplayList& display_list);
+
   const size_t access_threshold_;
   const size_t picture_and_display_list_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
@@ -327,6 +677,25 @@ class RasterCache {
   mutable DisplayListRasterCacheKey::Map<Entry> display_list_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
   bool checkerboard_images_;
+  fml::RefPtr<fml::TaskRunner> async_task_runner_;
+  ResourceContextGetter async_resource_context_;
+  std::shared_ptr<AsyncResults> async_results_;
+  size_t pending_async_count_ = 0;
+  size_t max_bytes_ = 0;
+  int subpixel_steps_ = kDefaultSubpixelSteps;
+  std::unique_ptr<RasterCacheAtlas> atlas_;
+  mutable OffscreenSurfacePool surface_pool_;
+  size_t client_count_ = 1;
+  GrDirectContext* gr_context_ = nullptr;
+  bool gr_context_attached_ = false;
+  // The bytes of all of the cached images, as of the end of the last frame
+  // plus the images rasterized since.
+  size_t cached_bytes_ = 0;
+  size_t current_frame_ = 0;
+  size_t total_hit_count_ = 0;
+  size_t total_miss_count_ = 0;
+  mutable DrawCounts picture_draws_;
+  mutable DrawCounts layer_draws_;
 
   void TraceStatsToTimeline() const;
 
@@ -0,0 +1,203 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <cstdlib>
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+// Shelves are rounded up to this many pixels in height so that entries of
+// similar sizes can share them.
+static constexpr int kShelfGranularity = 8;
+
+class RasterCacheAtlas::Page {
+ public:
+  static std::shared_ptr<Page> Make(GrDirectContext* context,
+                                    SkColorSpace* dst_color_space) {
+    const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+        kPageSize, kPageSize, sk_ref_sp(dst_color_space));
+    sk_sp<SkSurface> surface =
+        context
+            ? SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, image_info)
+            : SkSurface::MakeRaster(image_info);
+    if (!surface) {
+      return nullptr;
+    }
+    return std::make_shared<Page>(context, std::move(surface));
+  }
+
+  Page(GrDirectContext* context, sk_sp<SkSurface> surface)
+      : context_(context), surface_(std::move(surface)) {}
+
+  bool IsCompatible(GrDirectContext* context,
+                    SkColorSpace* dst_color_space) const {
+    return context_ == context &&
+           SkColorSpace::Equals(surface_->imageInfo().colorSpace(),
+                                dst_color_space);
+  }
+
+  // Finds the shortest shelf with room for the |size|, or starts a new
+  // shelf below the others.
+  bool Allocate(const SkISize& size, SkIRect* slot) {
+    Shelf* best = nullptr;
+    for (Shelf& shelf : shelves_) {
+      if (shelf.height >= size.height() &&
+          shelf.x + size.width() <= kPageSize &&
+          (!best || shelf.height < best->height)) {
+        best = &shelf;
+      }
+    }
+    if (!best) {
+      int height = (size.height() + kShelfGranularity - 1) /
+                   kShelfGranularity * kShelfGranularity;
+      if (next_shelf_y_ + height > kPageSize) {
+        return false;
+      }
+      shelves_.push_back({next_shelf_y_, height, 0});
+      next_shelf_y_ += height;
+      best = &shelves_.back();
+    }
+    *slot = SkIRect::MakeXYWH(best->x, best->y, size.width(), size.height());
+    best->x += size.width();
+    live_count_++;
+    return true;
+  }
+
+  void Release() {
+    FML_DCHECK(live_count_ > 0);
+    if (--live_count_ == 0) {
+      shelves_.clear();
+      next_shelf_y_ = 0;
+    }
+  }
+
+  SkCanvas* canvas() {
+    // Drop the snapshot before drawing so that the surface does not have
+    // to copy its contents to preserve it.
+    snapshot_ = nullptr;
+    return surface_->getCanvas();
+  }
+
+  const sk_sp<SkImage>& image() {
+    if (!snapshot_) {
+      snapshot_ = surface_->makeImageSnapshot();
+    }
+    return snapshot_;
+  }
+
+ private:
+  struct Shelf {
+    int y;
+    int height;
+    int x;
+  };
+
+  GrDirectContext* const context_;
+  sk_sp<SkSurface> surface_;
+  sk_sp<SkImage> snapshot_;
+  std::vector<Shelf> shelves_;
+  int next_shelf_y_ = 0;
+  size_t live_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Page);
+};
+
+class RasterCacheAtlas::Result : public RasterCacheResult {
+ public:
+  Result(std::shared_ptr<Page> page,
+         const SkIRect& slot,
+         const SkRect& logical_rect,
+         const char* type)
+      : RasterCacheResult(nullptr, logical_rect, type),
+        page_(std::move(page)),
+        slot_(slot) {}
+
+  ~Result() override { page_->Release(); }
+
+  void draw(SkCanvas& canvas, const SkPaint* paint) const override {
+    TRACE_EVENT0("flutter", "RasterCacheResult::draw");
+    SkAutoCanvasRestore auto_restore(&canvas, true);
+    SkIRect bounds =
+        RasterCache::GetDeviceBounds(logical_rect_, canvas.getTotalMatrix());
+    FML_DCHECK(std::abs(bounds.size().width() - slot_.width()) <= 1 &&
+               std::abs(bounds.size().height() - slot_.height()) <= 1);
+    canvas.resetMatrix();
+    flow_.Step();
+    canvas.drawImageRect(
+        page_->image(), SkRect::Make(slot_),
+        SkRect::MakeXYWH(bounds.fLeft, bounds.fTop, slot_.width(),
+                         slot_.height()),
+        SkSamplingOptions(), paint, SkCanvas::kFast_SrcRectConstraint);
+  }
+
+  SkISize image_dimensions() const override { return slot_.size(); }
+
+  int64_t image_bytes() const override {
+    return SkImageInfo::MakeN32Premul(slot_.size()).computeMinByteSize();
+  }
+
+ private:
+  std::shared_ptr<Page> page_;
+  const SkIRect slot_;
+};
+
+RasterCacheAtlas::RasterCacheAtlas() = default;
+
+RasterCacheAtlas::~RasterCacheAtlas() = default;
+
+std::unique_ptr<RasterCacheResult> RasterCacheAtlas::Rasterize(
+    GrDirectContext* context,
+    const SkISize& size,
+    SkColorSpace* dst_color_space,
+    const SkRect& logical_rect,
+    const char* type,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  if (size.isEmpty() || size.width() > kMaxEntrySize ||
+      size.height() > kMaxEntrySize) {
+    return nullptr;
+  }
+
+  std::shared_ptr<Page> page;
+  SkIRect slot;
+  for (const auto& candidate : pages_) {
+    if (candidate->IsCompatible(context, dst_color_space) &&
+        candidate->Allocate(size, &slot)) {
+      page = candidate;
+      break;
+    }
+  }
+  if (!page) {
+    if (pages_.size() >= kMaxPages) {
+      return nullptr;
+    }
+    page = Page::Make(context, dst_color_space);
+    if (!page || !page->Allocate(size, &slot)) {
+      return nullptr;
+    }
+    pages_.push_back(page);
+  }
+
+  TRACE_EVENT0("flutter", "RasterCachePopulateAtlas");
+  SkCanvas* canvas = page->canvas();
+  SkAutoCanvasRestore auto_restore(canvas, true);
+  canvas->clipRect(SkRect::Make(slot));
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(slot.left(), slot.top());
+  draw_function(canvas);
+
+  return std::make_unique<Result>(std::move(page), slot, logical_rect, type);
+}
+
+void RasterCacheAtlas::Clear() {
+  pages_.clear();
+}
+
+}  // namespace flutter
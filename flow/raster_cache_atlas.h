@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+#define FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+class RasterCacheResult;
+
+// Packs small raster cache entries into a few large shared surfaces, the
+// pages of the atlas, instead of allocating a texture for each of them.
+// Each entry draws its own region of the page, so an entry is still drawn
+// with a single image blit, and consecutive blits from the same page can be
+// batched by the GPU backend.
+//
+// Pages are packed into horizontal shelves and the space of a page is only
+// reclaimed once all of the entries on it have been evicted.
+class RasterCacheAtlas {
+ public:
+  // The width and height of each page in pixels.
+  static constexpr int kPageSize = 1024;
+
+  // The largest width or height of an entry that is stored in the atlas.
+  static constexpr int kMaxEntrySize = 128;
+
+  // The max number of pages. Entries that don't fit into the pages are
+  // stored in their own textures.
+  static constexpr size_t kMaxPages = 4;
+
+  RasterCacheAtlas();
+
+  ~RasterCacheAtlas();
+
+  // Rasterizes an entry of |size| pixels into a free region of a page that
+  // was allocated with the |context| and |dst_color_space|. The
+  // |draw_function| is called with a canvas whose origin is at the origin of
+  // the region and which is clipped to it.
+  //
+  // Returns nullptr if the entry is too large for the atlas or there is no
+  // room for it.
+  std::unique_ptr<RasterCacheResult> Rasterize(
+      GrDirectContext* context,
+      const SkISize& size,
+      SkColorSpace* dst_color_space,
+      const SkRect& logical_rect,
+      const char* type,
+      const std::function<void(SkCanvas*)>& draw_function);
+
+  // Drops the pages. Entries that are still alive keep their page until
+  // they are evicted.
+  void Clear();
+
+  size_t page_count() const { return pages_.size(); }
+
+ private:
+  class Page;
+  class Result;
+
+  std::vector<std::shared_ptr<Page>> pages_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlas);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include "flutter/flow/raster_cache.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static std::unique_ptr<RasterCacheResult> RasterizeColor(
+    RasterCacheAtlas& atlas,
+    int size,
+    SkColor color) {
+  return atlas.Rasterize(nullptr, SkISize::Make(size, size), nullptr,
+                         SkRect::MakeWH(size, size), "test",
+                         [color](SkCanvas* canvas) { canvas->clear(color); });
+}
+
+TEST(RasterCacheAtlas, SmallEntriesSharePage) {
+  RasterCacheAtlas atlas;
+  auto first = RasterizeColor(atlas, 50, SK_ColorRED);
+  auto second = RasterizeColor(atlas, 30, SK_ColorBLUE);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_EQ(atlas.page_count(), 1u);
+  ASSERT_EQ(first->image_dimensions(), SkISize::Make(50, 50));
+  ASSERT_EQ(second->image_dimensions(), SkISize::Make(30, 30));
+}
+
+TEST(RasterCacheAtlas, LargeEntriesAreNotStored) {
+  RasterCacheAtlas atlas;
+  ASSERT_EQ(
+      RasterizeColor(atlas, RasterCacheAtlas::kMaxEntrySize + 1, SK_ColorRED),
+      nullptr);
+  ASSERT_EQ(atlas.page_count(), 0u);
+}
+
+TEST(RasterCacheAtlas, PagesAreBoundedAndReclaimed) {
+  RasterCacheAtlas atlas;
+  std::vector<std::unique_ptr<RasterCacheResult>> results;
+  while (auto result = RasterizeColor(atlas, RasterCacheAtlas::kMaxEntrySize,
+                                      SK_ColorRED)) {
+    results.push_back(std::move(result));
+  }
+  ASSERT_EQ(atlas.page_count(), RasterCacheAtlas::kMaxPages);
+  int per_side = RasterCacheAtlas::kPageSize / RasterCacheAtlas::kMaxEntrySize;
+  ASSERT_EQ(results.size(), RasterCacheAtlas::kMaxPages * per_side * per_side);
+
+  // Evicting all of the entries of a page makes its space available again.
+  results.erase(results.begin(), results.begin() + per_side * per_side);
+  ASSERT_NE(
+      RasterizeColor(atlas, RasterCacheAtlas::kMaxEntrySize, SK_ColorBLUE),
+      nullptr);
+  ASSERT_EQ(atlas.page_count(), RasterCacheAtlas::kMaxPages);
+}
+
+TEST(RasterCacheAtlas, EntryDrawsItsOwnRegion) {
+  RasterCacheAtlas atlas;
+  auto red = RasterizeColor(atlas, 10, SK_ColorRED);
+  auto blue = RasterizeColor(atlas, 10, SK_ColorBLUE);
+  ASSERT_NE(blue, nullptr);
+
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(20, 20);
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(5, 5);
+  blue->draw(*canvas, nullptr);
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(20, 20);
+  ASSERT_TRUE(surface->readPixels(bitmap, 0, 0));
+  ASSERT_EQ(bitmap.getColor(4, 4), SK_ColorTRANSPARENT);
+  ASSERT_EQ(bitmap.getColor(5, 5), SK_ColorBLUE);
+  ASSERT_EQ(bitmap.getColor(14, 14), SK_ColorBLUE);
+  ASSERT_EQ(bitmap.getColor(15, 15), SK_ColorTRANSPARENT);
+}
+
+TEST(RasterCache, SmallEntriesUseAtlas) {
+  RasterCache cache(1);
+  cache.SetAtlasEnabled(true);
+  ASSERT_EQ(cache.GetAtlasPageCount(), 0u);
+
+  DisplayListBuilder builder(SkRect::MakeWH(20, 20));
+  builder.drawRect({0, 0, 20, 20});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  auto result = cache.RasterizeDisplayList(display_list.get(), nullptr,
+                                           SkMatrix::I(), nullptr, false);
+  ASSERT_NE(result, nullptr);
+  ASSERT_EQ(cache.GetAtlasPageCount(), 1u);
+  ASSERT_EQ(result->image_dimensions(), SkISize::Make(20, 20));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -15,9 +15,17 @@ namespace flutter {
 template <typename ID>
 class RasterCacheKey {
  public:
-  RasterCacheKey(ID id, const SkMatrix& ctm) : id_(id), matrix_(ctm) {
-    matrix_[SkMatrix::kMTransX] = 0;
-    matrix_[SkMatrix::kMTransY] = 0;
+  // Whole pixel translations are ignored so that an image cached for a
+  // picture is reused after the picture moves. The fractional part of the
+  // translation is rounded to the nearest 1/|subpixel_steps| of a pixel, so
+  // that the image is only reused at nearby subpixel offsets. With a single
+  // step the translation is ignored entirely.
+  RasterCacheKey(ID id, const SkMatrix& ctm, int subpixel_steps = 1)
+      : id_(id), matrix_(ctm) {
+    matrix_[SkMatrix::kMTransX] =
+        SubpixelOffset(ctm.getTranslateX(), subpixel_steps);
+    matrix_[SkMatrix::kMTransY] =
+        SubpixelOffset(ctm.getTranslateY(), subpixel_steps);
   }
 
   ID id() const { return id_; }
@@ -40,20 +48,29 @@ class RasterCacheKey {
   using Map = std::unordered_map<RasterCacheKey, Value, Hash, Equal>;
 
  private:
+  static SkScalar SubpixelOffset(SkScalar translate, int subpixel_steps) {
+    if (subpixel_steps <= 1 || !SkScalarIsFinite(translate)) {
+      return 0;
+    }
+    SkScalar fraction = translate - SkScalarFloorToScalar(translate);
+    SkScalar step = SkScalarRoundToScalar(fraction * subpixel_steps);
+    // A fraction that rounds up to the next whole pixel is the same as 0.
+    return step >= subpixel_steps ? 0 : step / subpixel_steps;
+  }
+
   ID id_;
 
-  // ctm where only fractional (0-1) translations are preserved:
-  //   matrix_ = ctm;
-  //   matrix_[SkMatrix::kMTransX] = SkScalarFraction(ctm.getTranslateX());
-  //   matrix_[SkMatrix::kMTransY] = SkScalarFraction(ctm.getTranslateY());
+  // ctm where only the fractional (0-1) translations are preserved, rounded
+  // to the subpixel grid.
   SkMatrix matrix_;
 };
 
 // The ID is the uint32_t picture uniqueID
 using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
 
-// The ID is the uint32_t DisplayList uniqueID
-using DisplayListRasterCacheKey = RasterCacheKey<uint32_t>;
+// The ID is the uint64_t DisplayList content_hash, so that separately built
+// lists with the same contents share an entry
+using DisplayListRasterCacheKey = RasterCacheKey<uint64_t>;
 
 class Layer;
 
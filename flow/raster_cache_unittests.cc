@@ -6,6 +6,8 @@
 #include "flutter/flow/raster_cache.h"
 
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPaint.h"
@@ -473,6 +475,369 @@ TEST(RasterCache, NestedOpCountMetricUsedForDisplayList) {
   ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
 }
 
+TEST(RasterCache, ComplexityScoreUsedForDisplayList) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  // Only 2 ops, but the shadows are expensive enough to be worth caching.
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  SkPath path = SkPath::Rect(SkRect::MakeXYWH(10, 10, 80, 80));
+  builder.drawShadow(path, SK_ColorBLACK, 4.0, false, 1.0);
+  builder.drawShadow(path, SK_ColorBLACK, 8.0, false, 1.0);
+  auto display_list = builder.Build();
+  ASSERT_EQ(display_list->op_count(true), 2);
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), false, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), false, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+}
+
+TEST(RasterCache, DisplayListRasterizedAsynchronously) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  fml::Thread worker("async_raster_cache");
+  cache.EnableAsyncRasterization(worker.GetTaskRunner(),
+                                 []() -> GrDirectContext* { return nullptr; });
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+  ASSERT_TRUE(display_list->can_render_off_thread());
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  // The rasterization is scheduled, but not yet available.
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+
+  fml::AutoResetWaitableEvent latch;
+  worker.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  // The result is published at the start of the frame.
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+}
+
+TEST(RasterCache, DisplayListWithPictureIsRasterizedSynchronously) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  fml::Thread worker("async_raster_cache");
+  cache.EnableAsyncRasterization(worker.GetTaskRunner(),
+                                 []() -> GrDirectContext* { return nullptr; });
+
+  SkMatrix matrix = SkMatrix::I();
+
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.drawPicture(GetSamplePicture(), nullptr, false);
+  auto display_list = builder.Build();
+  ASSERT_FALSE(display_list->can_render_off_thread());
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+}
+
+TEST(RasterCache, UnusedEntriesAreRetainedWithinBudget) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxBytes(1024 * 1024);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().miss_count, 1u);
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().hit_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+
+  // A frame that does not use the entry keeps it.
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  // Without a budget the unused entry is evicted.
+  cache.SetMaxBytes(0);
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, LeastRecentlyUsedEntriesAreEvictedOverBudget) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_a = GetSampleDisplayList();
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80));
+  auto display_list_b = builder.Build();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list_a.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list_b.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list_a, dummy_canvas));
+  ASSERT_FALSE(cache.Draw(*display_list_b, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list_a.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list_b.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list_a, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*display_list_b, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  // Room for one of the two entries.
+  size_t entry_bytes = cache.EstimatePictureCacheByteSize() / 2;
+  cache.SetMaxBytes(entry_bytes + entry_bytes / 2);
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Draw(*display_list_b, dummy_canvas));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, entry_bytes);
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Draw(*display_list_a, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*display_list_b, dummy_canvas));
+  cache.CleanupAfterFrame();
+}
+
+TEST(RasterCache, DisplayListsWithSameContentsShareEntry) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_a = GetSampleDisplayList();
+  auto display_list_b = GetSampleDisplayList();
+  ASSERT_NE(display_list_a->unique_id(), display_list_b->unique_id());
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list_a.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list_a, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list_b.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list_a, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*display_list_b, dummy_canvas));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, SharedCacheKeepsEntriesUsedByOtherClients) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.AddSharedClient();
+  ASSERT_EQ(cache.shared_client_count(), 2u);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  // The frame of the other client does not use the entry.
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  // Once neither client used it, the entry is evicted.
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+
+  cache.RemoveSharedClient();
+  ASSERT_EQ(cache.shared_client_count(), 1u);
+}
+
+TEST(RasterCache, EntryInfosDescribeEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  ASSERT_TRUE(cache.GetEntryInfos().empty());
+  ASSERT_EQ(cache.GetHitRatio(), 0);
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  auto infos = cache.GetEntryInfos();
+  ASSERT_EQ(infos.size(), 1u);
+  ASSERT_EQ(infos[0].type, RasterCacheEntryInfo::Type::kDisplayList);
+  ASSERT_EQ(infos[0].bytes, 0u);
+  ASSERT_EQ(infos[0].access_count, 1u);
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  infos = cache.GetEntryInfos();
+  ASSERT_EQ(infos.size(), 1u);
+  ASSERT_EQ(infos[0].bytes, cache.EstimatePictureCacheByteSize());
+  ASSERT_EQ(infos[0].access_count, 4u);
+  ASSERT_EQ(infos[0].age, 2u);
+  ASSERT_EQ(infos[0].last_used_frame, cache.current_frame());
+  ASSERT_EQ(cache.total_hit_count(), 3u);
+  ASSERT_EQ(cache.total_miss_count(), 1u);
+  ASSERT_EQ(cache.GetHitRatio(), 0.75);
+}
+
+TEST(RasterCache, KeyIgnoresWholePixelTranslation) {
+  SkMatrix scale = SkMatrix::Scale(2, 2);
+  SkMatrix a = SkMatrix::Translate(10, 5) * scale;
+  SkMatrix b = SkMatrix::Translate(20, 7) * scale;
+  DisplayListRasterCacheKey::Equal equal;
+  ASSERT_TRUE(equal(DisplayListRasterCacheKey(1, a),
+                    DisplayListRasterCacheKey(1, b)));
+  ASSERT_TRUE(equal(DisplayListRasterCacheKey(1, a, 4),
+                    DisplayListRasterCacheKey(1, b, 4)));
+  ASSERT_FALSE(equal(DisplayListRasterCacheKey(1, a),
+                     DisplayListRasterCacheKey(1, SkMatrix::I())));
+}
+
+TEST(RasterCache, KeyRoundsTranslationToSubpixelSteps) {
+  SkMatrix a = SkMatrix::Translate(10.3, 0);
+  SkMatrix b = SkMatrix::Translate(10.7, 0);
+  SkMatrix c = SkMatrix::Translate(42.2, 0);
+  SkMatrix d = SkMatrix::Translate(10.9, 0);
+  SkMatrix e = SkMatrix::Translate(11, 0);
+  DisplayListRasterCacheKey::Equal equal;
+
+  // A single step ignores the translation.
+  ASSERT_TRUE(equal(DisplayListRasterCacheKey(1, a, 1),
+                    DisplayListRasterCacheKey(1, b, 1)));
+
+  ASSERT_FALSE(equal(DisplayListRasterCacheKey(1, a, 4),
+                     DisplayListRasterCacheKey(1, b, 4)));
+  ASSERT_TRUE(equal(DisplayListRasterCacheKey(1, a, 4),
+                    DisplayListRasterCacheKey(1, c, 4)));
+  // Fractions that round up to a whole pixel match the whole pixel.
+  ASSERT_TRUE(equal(DisplayListRasterCacheKey(1, d, 4),
+                    DisplayListRasterCacheKey(1, e, 4)));
+}
+
 TEST(RasterCache, SkPictureWithSingularMatrixIsNotCached) {
   size_t threshold = 2;
   flutter::RasterCache cache(threshold);
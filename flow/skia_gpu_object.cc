@@ -27,7 +27,50 @@ void SkiaUnrefQueue::Unref(SkRefCnt* object) {
   if (!drain_pending_) {
     drain_pending_ = true;
     task_runner_->PostDelayedTask(
-        [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
+        [strong = fml::Ref(this)]() { strong->DrainSlice(); }, drain_delay_);
+  }
+}
+
+void SkiaUnrefQueue::DrainSlice() {
+  TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainSlice");
+  // The lock is taken once to take all the queued objects and once to return
+  // the ones left for the next slice, not for every object.
+  std::deque<SkRefCnt*> skia_objects;
+  {
+    std::scoped_lock lock(mutex_);
+    objects_.swap(skia_objects);
+  }
+
+  fml::TimePoint deadline = fml::TimePoint::Now() + kDrainSliceDuration;
+  size_t unref_count = 0;
+  while (unref_count < skia_objects.size()) {
+    skia_objects[unref_count++]->unref();
+    if (fml::TimePoint::Now() >= deadline) {
+      break;
+    }
+  }
+
+  size_t pending_count;
+  {
+    std::scoped_lock lock(mutex_);
+    // The objects left from this slice were queued before the ones that were
+    // queued while it ran.
+    objects_.insert(objects_.begin(), skia_objects.begin() + unref_count,
+                    skia_objects.end());
+    pending_count = objects_.size();
+    drain_pending_ = pending_count > 0;
+  }
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "SkiaUnrefQueue",
+                    reinterpret_cast<int64_t>(this), "PendingObjects",
+                    pending_count);
+#endif  // !FLUTTER_RELEASE
+
+  if (pending_count > 0) {
+    task_runner_->PostTask(
+        [strong = fml::Ref(this)]() { strong->DrainSlice(); });
+  } else if (context_ && unref_count > 0) {
+    context_->performDeferredCleanup(std::chrono::milliseconds(0));
   }
 }
 
@@ -18,6 +18,9 @@ namespace flutter {
 
 // A queue that holds Skia objects that must be destructed on the given task
 // runner.
+//
+// The objects are destructed in slices of a few milliseconds, so that a burst
+// of released objects does not hold up the other tasks of the task runner.
 class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
  public:
   void Unref(SkRefCnt* object);
@@ -30,6 +33,11 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   void Drain();
 
  private:
+  // The time a drain task may spend destructing objects before it leaves the
+  // rest to a task of its own.
+  static constexpr fml::TimeDelta kDrainSliceDuration =
+      fml::TimeDelta::FromMilliseconds(2);
+
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
   std::mutex mutex_;
@@ -37,6 +45,10 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   bool drain_pending_;
   fml::WeakPtr<GrDirectContext> context_;
 
+  // Destructs the queued objects until |kDrainSliceDuration| has passed, and
+  // posts another slice if objects remain.
+  void DrainSlice();
+
   // The `GrDirectContext* context` is only used for signaling Skia to
   // performDeferredCleanup. It can be nullptr when such signaling is not needed
   // (e.g., in unit tests).
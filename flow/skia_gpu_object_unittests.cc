@@ -4,6 +4,7 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <atomic>
 #include <future>
 
 #include "flutter/fml/message_loop.h"
@@ -34,6 +35,23 @@ class TestSkObject : public SkRefCnt {
   fml::TaskQueueId* dtor_task_queue_id_;
 };
 
+class CountedSkObject : public SkRefCnt {
+ public:
+  CountedSkObject(std::shared_ptr<std::atomic<int>> count,
+                  std::shared_ptr<fml::AutoResetWaitableEvent> latch)
+      : count_(count), latch_(latch) {}
+
+  ~CountedSkObject() {
+    if (--*count_ == 0) {
+      latch_->Signal();
+    }
+  }
+
+ private:
+  std::shared_ptr<std::atomic<int>> count_;
+  std::shared_ptr<fml::AutoResetWaitableEvent> latch_;
+};
+
 class SkiaGpuObjectTest : public ThreadTest {
  public:
   SkiaGpuObjectTest()
@@ -84,6 +102,18 @@ TEST_F(SkiaGpuObjectTest, QueueSimple) {
   ASSERT_EQ(dtor_task_queue_id, unref_task_runner()->GetTaskQueueId());
 }
 
+TEST_F(SkiaGpuObjectTest, QueueDrainsBurstOfObjects) {
+  const int object_count = 10000;
+  std::shared_ptr<fml::AutoResetWaitableEvent> latch =
+      std::make_shared<fml::AutoResetWaitableEvent>();
+  auto count = std::make_shared<std::atomic<int>>(object_count);
+  for (int i = 0; i < object_count; i++) {
+    unref_queue()->Unref(new CountedSkObject(count, latch));
+  }
+  latch->Wait();
+  ASSERT_EQ(*count, 0);
+}
+
 TEST_F(SkiaGpuObjectTest, ObjectDestructor) {
   std::shared_ptr<fml::AutoResetWaitableEvent> latch =
       std::make_shared<fml::AutoResetWaitableEvent>();
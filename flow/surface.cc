@@ -22,4 +22,13 @@ bool Surface::AllowsDrawingWhenGpuDisabled() const {
   return true;
 }
 
+void Surface::SetGpuTimingEnabled(bool enabled) {}
+
+std::vector<GpuFrameTiming> Surface::TakeGpuFrameTimings() {
+  return {};
+}
+
+void Surface::SetTileTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {}
+
 }  // namespace flutter
@@ -6,14 +6,24 @@
 #define FLUTTER_FLOW_SURFACE_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface_frame.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 
 namespace flutter {
 
+/// The time the GPU spent executing the commands of a frame.
+struct GpuFrameTiming {
+  /// The number of the frame, from `SurfaceFrame::SubmitInfo::frame_number`.
+  uint64_t frame_number = 0;
+  fml::TimeDelta gpu_duration;
+};
+
 /// Abstract Base Class that represents where we will be rendering content.
 class Surface {
  public:
@@ -35,6 +45,21 @@ class Surface {
 
   virtual bool AllowsDrawingWhenGpuDisabled() const;
 
+  /// Enables or disables measuring the GPU time of the submitted frames on
+  /// surfaces that support it. Does nothing by default.
+  virtual void SetGpuTimingEnabled(bool enabled);
+
+  /// Returns the GPU times of the frames whose measurements completed since
+  /// the last call, in submission order. The GPU finishes a frame after it
+  /// was submitted, so these usually belong to earlier frames.
+  virtual std::vector<GpuFrameTiming> TakeGpuFrameTimings();
+
+  /// Sets the task runner that surfaces which support it rasterize parts of
+  /// their frames concurrently on. Passing nullptr rasterizes the frames on
+  /// the raster thread only, which is also the default.
+  virtual void SetTileTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Surface);
 };
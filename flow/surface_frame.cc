@@ -41,15 +41,42 @@ bool SurfaceFrame::Submit() {
   }
 
   submitted_ = PerformSubmit();
+  if (submitted_ && present_callback_) {
+    submitted_ = present_callback_(submit_info_);
+  }
 
   return submitted_;
 }
 
+SurfaceFrame::DeferredPresent SurfaceFrame::SubmitWithoutPresent() {
+  if (!present_callback_) {
+    Submit();
+    return nullptr;
+  }
+
+  if (submitted_) {
+    return nullptr;
+  }
+
+  submitted_ = PerformSubmit();
+  if (!submitted_) {
+    return nullptr;
+  }
+
+  return [present_callback = present_callback_,
+          submit_info = submit_info_]() {
+    return present_callback(submit_info);
+  };
+}
+
 bool SurfaceFrame::IsSubmitted() const {
   return submitted_;
 }
 
 SkCanvas* SurfaceFrame::SkiaCanvas() {
+  if (canvas_ != nullptr) {
+    return canvas_;
+  }
   return surface_ != nullptr ? surface_->getCanvas() : nullptr;
 }
 
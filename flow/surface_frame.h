@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/fml/macros.h"
@@ -60,20 +61,54 @@ class SurfaceFrame {
     // Corresponds to EGL_KHR_swap_buffers_with_damage
     std::optional<SkIRect> frame_damage;
 
+    // The disjoint rects that make up the frame damage, when it is set.
+    // Compositors that accept a list of damage rects only need to recompose
+    // these rather than all of frame_damage.
+    std::vector<SkIRect> frame_damage_rects;
+
     // The buffer damage for a frame is the area changed since that same buffer
     // was last used. If the buffer has not been used before, the buffer damage
     // is the entire area of the buffer.
     //
     // Corresponds to EGL_KHR_partial_update
     std::optional<SkIRect> buffer_damage;
+
+    // The disjoint rects that make up the buffer damage, when it is set.
+    std::vector<SkIRect> buffer_damage_rects;
+
+    // The number of the frame, which identifies it in measurements that
+    // complete after it was submitted, like its GPU time.
+    uint64_t frame_number = 0;
   };
 
+  // Presents a frame that was already submitted. It does not use the
+  // GrDirectContext of the frame, so it may be called on another thread as
+  // long as the render context of the surface is not current elsewhere.
+  using PresentCallback = std::function<bool(const SubmitInfo& submit_info)>;
+  using DeferredPresent = std::function<bool()>;
+
   bool Submit();
 
+  // Submits the frame without presenting it if the surface set a present
+  // callback, and returns the work that presents it. Otherwise submits and
+  // presents the frame and returns nullptr.
+  DeferredPresent SubmitWithoutPresent();
+
   bool IsSubmitted() const;
 
+  // Set by surfaces whose present can be split from the submission of the
+  // frame. |Submit| still presents the frame right after submitting it.
+  void set_present_callback(PresentCallback present_callback) {
+    present_callback_ = std::move(present_callback);
+  }
+
   SkCanvas* SkiaCanvas();
 
+  // Makes the frame be rendered into |canvas| instead of the canvas of its
+  // surface, for surfaces that record their frames before rasterizing them
+  // in the submit callback. The canvas must outlive the frame.
+  void set_canvas(SkCanvas* canvas) { canvas_ = canvas; }
+
   sk_sp<SkSurface> SkiaSurface() const;
 
   const FramebufferInfo& framebuffer_info() const { return framebuffer_info_; }
@@ -86,9 +121,11 @@ class SurfaceFrame {
  private:
   bool submitted_ = false;
   sk_sp<SkSurface> surface_;
+  SkCanvas* canvas_ = nullptr;
   FramebufferInfo framebuffer_info_;
   SubmitInfo submit_info_;
   SubmitCallback submit_callback_;
+  PresentCallback present_callback_;
   std::unique_ptr<GLContextResult> context_result_;
 
   bool PerformSubmit();
@@ -24,6 +24,10 @@ class MockLayer : public Layer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
+  bool can_preroll_concurrently() const override {
+    return !fake_has_platform_view_ && !fake_reads_surface_;
+  }
+
   const MutatorsStack& parent_mutators() { return parent_mutators_; }
   const SkMatrix& parent_matrix() { return parent_matrix_; }
   const SkRect& parent_cull_rect() { return parent_cull_rect_; }
@@ -95,5 +95,27 @@ TEST(TextureRegistryTest, ReuseSameTextureSlot) {
   ASSERT_TRUE(mock_texture2->unregistered());
 }
 
+TEST(TextureRegistryTest, FrameCountChangesWithNewFrames) {
+  TextureRegistry registry;
+  auto mock_texture1 = std::make_shared<MockTexture>(2);
+  auto mock_texture2 = std::make_shared<MockTexture>(1);
+  ASSERT_EQ(registry.GetFrameCount(1), 0u);
+
+  registry.RegisterTexture(mock_texture1);
+  registry.RegisterTexture(mock_texture2);
+  ASSERT_EQ(registry.GetTexture(1), mock_texture2);
+  ASSERT_EQ(registry.GetTexture(2), mock_texture1);
+  const uint64_t frame_count = registry.GetFrameCount(1);
+  ASSERT_NE(frame_count, 0u);
+
+  registry.MarkNewFrameAvailable(2);
+  ASSERT_EQ(registry.GetFrameCount(1), frame_count);
+  registry.MarkNewFrameAvailable(1);
+  ASSERT_NE(registry.GetFrameCount(1), frame_count);
+
+  registry.UnregisterTexture(1);
+  ASSERT_EQ(registry.GetFrameCount(1), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
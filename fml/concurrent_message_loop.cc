@@ -5,12 +5,69 @@
 #include "flutter/fml/concurrent_message_loop.h"
 
 #include <algorithm>
+#include <optional>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 
+#if defined(OS_ANDROID)
+#include <sys/resource.h>
+#include <unistd.h>
+#elif defined(OS_MACOSX)
+#include <pthread.h>
+#include <pthread/qos.h>
+#elif defined(OS_WIN)
+#include <windows.h>
+#endif
+
 namespace fml {
 
+namespace {
+
+#if defined(OS_ANDROID)
+// Android describes 10 as the priority of "background tasks".
+constexpr int kBackgroundNiceValue = 10;
+#endif
+
+// Lowers the priority of the calling worker for background tasks and returns
+// the value that restores it.
+int LowerCurrentThreadPriority() {
+#if defined(OS_ANDROID)
+  int nice_value = ::getpriority(PRIO_PROCESS, gettid());
+  if (::setpriority(PRIO_PROCESS, gettid(), kBackgroundNiceValue) != 0) {
+    FML_DLOG(ERROR) << "Failed to lower the priority of a worker.";
+  }
+  return nice_value;
+#elif defined(OS_MACOSX)
+  qos_class_t qos_class = qos_class_self();
+  pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+  return static_cast<int>(qos_class);
+#elif defined(OS_WIN)
+  int thread_priority = ::GetThreadPriority(::GetCurrentThread());
+  ::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+  return thread_priority;
+#else
+  // Other platforms, like desktop Linux, don't allow the priority to be raised
+  // again without privileges, so background tasks are only run last.
+  return 0;
+#endif
+}
+
+void RestoreCurrentThreadPriority(int saved_priority) {
+#if defined(OS_ANDROID)
+  if (::setpriority(PRIO_PROCESS, gettid(), saved_priority) != 0) {
+    FML_DLOG(ERROR) << "Failed to restore the priority of a worker.";
+  }
+#elif defined(OS_MACOSX)
+  pthread_set_qos_class_self_np(static_cast<qos_class_t>(saved_priority), 0);
+#elif defined(OS_WIN)
+  ::SetThreadPriority(::GetCurrentThread(), saved_priority);
+#endif
+}
+
+}  // namespace
+
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
     size_t worker_count) {
   return std::shared_ptr<ConcurrentMessageLoop>{
@@ -19,11 +76,18 @@ std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
 
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
+  // The workers acquire the idle mutex before anything else, so they wait for
+  // their thread IDs to be recorded before they take or post tasks.
+  std::scoped_lock lock(idle_mutex_);
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(
           std::string{"io.worker." + std::to_string(i + 1)});
-      WorkerMain();
+      WorkerMain(i);
     });
   }
 
@@ -43,72 +107,199 @@ size_t ConcurrentMessageLoop::GetWorkerCount() const {
   return worker_count_;
 }
 
-std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
-  return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
+std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner(
+    ConcurrentTaskPriority priority) {
+  return std::make_shared<ConcurrentTaskRunner>(weak_from_this(), priority);
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(const fml::closure& task,
+                                     ConcurrentTaskPriority priority) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     task();
     return;
   }
 
-  tasks_.push(task);
+  // Workers keep the tasks they post to themselves, so that the tasks spawned
+  // by a task start on the same thread unless another worker is idle.
+  auto found = std::find(worker_thread_ids_.begin(), worker_thread_ids_.end(),
+                         std::this_thread::get_id());
+  size_t worker_index = found != worker_thread_ids_.end()
+                            ? found - worker_thread_ids_.begin()
+                            : next_worker_queue_++ % worker_count_;
+
+  {
+    const size_t lane = static_cast<size_t>(priority);
+    WorkerQueue& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    queue.tasks[lane].push_back(task);
+    ++pending_tasks_by_priority_[lane];
+    ++pending_tasks_;
+  }
+
+  WakeUpIdleWorkers(1);
+}
+
+void ConcurrentMessageLoop::PostTasks(std::vector<fml::closure> tasks,
+                                      ConcurrentTaskPriority priority) {
+  tasks.erase(std::remove(tasks.begin(), tasks.end(), nullptr), tasks.end());
+  if (tasks.empty()) {
+    return;
+  }
+
+  if (shutdown_) {
+    FML_DLOG(WARNING)
+        << "Tried to post tasks to shutdown concurrent message "
+           "loop. The tasks will be executed on the callers thread.";
+    for (const auto& task : tasks) {
+      task();
+    }
+    return;
+  }
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  auto found = std::find(worker_thread_ids_.begin(), worker_thread_ids_.end(),
+                         std::this_thread::get_id());
+  size_t worker_index = found != worker_thread_ids_.end()
+                            ? found - worker_thread_ids_.begin()
+                            : next_worker_queue_++ % worker_count_;
+
+  // The whole batch goes to one queue, the other workers steal from it.
+  const size_t count = tasks.size();
+  {
+    const size_t lane = static_cast<size_t>(priority);
+    WorkerQueue& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    for (auto& task : tasks) {
+      queue.tasks[lane].push_back(std::move(task));
+    }
+    pending_tasks_by_priority_[lane] += count;
+    pending_tasks_ += count;
+  }
 
-  tasks_condition_.notify_one();
+  WakeUpIdleWorkers(count);
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return tasks_.size() > 0 || shutdown_ || HasThreadTasksLocked();
-    });
+void ConcurrentMessageLoop::WakeUpIdleWorkers(size_t task_count) {
+  // A worker going to sleep increments the idle count before it checks for
+  // pending tasks, so either it sees the new task or it is seen here.
+  if (idle_workers_ == 0) {
+    return;
+  }
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+  // Acquire the mutex so that the notification can't fire between the check
+  // of a worker for pending tasks and its wait.
+  { std::scoped_lock lock(idle_mutex_); }
+  if (task_count == 1) {
+    idle_condition_.notify_one();
+  } else {
+    idle_condition_.notify_all();
+  }
+}
 
-    if (tasks_.size() != 0) {
-      task = tasks_.front();
-      tasks_.pop();
+fml::closure ConcurrentMessageLoop::TakeTask(
+    size_t worker_index,
+    ConcurrentTaskPriority* priority) {
+  for (size_t lane = 0; lane < kPriorityCount; ++lane) {
+    if (pending_tasks_by_priority_[lane] == 0) {
+      continue;
+    }
+    for (size_t i = 0; i < worker_count_; ++i) {
+      WorkerQueue& queue = *worker_queues_[(worker_index + i) % worker_count_];
+      std::scoped_lock lock(queue.mutex);
+      std::deque<fml::closure>& tasks = queue.tasks[lane];
+      if (tasks.empty()) {
+        continue;
+      }
+      fml::closure task;
+      if (i == 0) {
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      } else {
+        task = std::move(tasks.back());
+        tasks.pop_back();
+      }
+      --pending_tasks_by_priority_[lane];
+      --pending_tasks_;
+      *priority = static_cast<ConcurrentTaskPriority>(lane);
+      return task;
     }
+  }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+  return nullptr;
+}
+
+bool ConcurrentMessageLoop::HasThreadTasks(size_t worker_index) {
+  WorkerQueue& queue = *worker_queues_[worker_index];
+  std::scoped_lock lock(queue.mutex);
+  return !queue.thread_tasks.empty();
+}
+
+std::vector<fml::closure> ConcurrentMessageLoop::TakeThreadTasks(
+    size_t worker_index) {
+  WorkerQueue& queue = *worker_queues_[worker_index];
+  std::scoped_lock lock(queue.mutex);
+  std::vector<fml::closure> pending_tasks;
+  std::swap(pending_tasks, queue.thread_tasks);
+  return pending_tasks;
+}
+
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  while (true) {
+    {
+      std::unique_lock lock(idle_mutex_);
+      ++idle_workers_;
+      idle_condition_.wait(lock, [&]() {
+        return pending_tasks_ > 0 || shutdown_ || HasThreadTasks(worker_index);
+      });
+      --idle_workers_;
     }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+    bool shutdown_now = shutdown_;
 
     TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
+    // The priority of the worker is only restored once it runs another kind
+    // of task, so that a burst of background tasks doesn't change it for each
+    // of them.
+    std::optional<int> saved_priority;
+    // Run tasks until there are none left to take. Don't hold onto any of the
+    // mutexes while tasks are being executed as they could themselves try to
+    // post more tasks to the message loop.
+    while (true) {
+      ConcurrentTaskPriority priority = ConcurrentTaskPriority::kUserVisible;
+      fml::closure task =
+          shutdown_now ? nullptr : TakeTask(worker_index, &priority);
+      std::vector<fml::closure> thread_tasks = TakeThreadTasks(worker_index);
+
+      // Thread tasks may set the priority of the worker themselves.
+      if (saved_priority.has_value() &&
+          (priority != ConcurrentTaskPriority::kBackground || !task ||
+           !thread_tasks.empty())) {
+        RestoreCurrentThreadPriority(saved_priority.value());
+        saved_priority.reset();
+      }
+
+      // Execute any thread tasks.
+      for (const auto& thread_task : thread_tasks) {
+        thread_task();
+      }
+
+      if (!task) {
+        break;
+      }
+
+      if (priority == ConcurrentTaskPriority::kBackground &&
+          !saved_priority.has_value()) {
+        saved_priority = LowerCurrentThreadPriority();
+      }
       task();
-    }
-
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      thread_task();
+      shutdown_now = shutdown_;
     }
 
     if (shutdown_now) {
@@ -118,9 +309,9 @@ void ConcurrentMessageLoop::WorkerMain() {
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
+  std::scoped_lock lock(idle_mutex_);
   shutdown_ = true;
-  tasks_condition_.notify_all();
+  idle_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
@@ -128,29 +319,19 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (const auto& queue : worker_queues_) {
+    std::scoped_lock lock(queue->mutex);
+    queue->thread_tasks.emplace_back(task);
   }
-  tasks_condition_.notify_all();
-}
-
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
 
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
+  std::scoped_lock lock(idle_mutex_);
+  idle_condition_.notify_all();
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
-    std::weak_ptr<ConcurrentMessageLoop> weak_loop)
-    : weak_loop_(std::move(weak_loop)) {}
+    std::weak_ptr<ConcurrentMessageLoop> weak_loop,
+    ConcurrentTaskPriority priority)
+    : weak_loop_(std::move(weak_loop)), priority_(priority) {}
 
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
@@ -160,7 +341,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(task, priority_);
     return;
   }
 
@@ -170,4 +351,20 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   task();
 }
 
+void ConcurrentTaskRunner::PostTasks(std::vector<fml::closure> tasks) {
+  if (auto loop = weak_loop_.lock()) {
+    loop->PostTasks(std::move(tasks), priority_);
+    return;
+  }
+
+  FML_DLOG(WARNING)
+      << "Tried to post to a concurrent message loop that has already died. "
+         "Executing the tasks on the callers thread.";
+  for (const auto& task : tasks) {
+    if (task) {
+      task();
+    }
+  }
+}
+
 }  // namespace fml
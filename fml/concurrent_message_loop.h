@@ -5,10 +5,13 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -18,6 +21,30 @@ namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// The lanes of the tasks of a `ConcurrentMessageLoop`. Workers always run
+/// the available task of the most important lane first.
+enum class ConcurrentTaskPriority {
+  /// Work that the current frame is waiting for, like shader compilation.
+  kUserBlocking,
+  /// Work whose result will be shown soon, like the decode of an image that
+  /// is on screen. This is the default.
+  kUserVisible,
+  /// Speculative work or work not visible to the user. The workers run these
+  /// tasks with a lower thread priority where the platform allows to restore
+  /// it afterwards: a higher nice value on Android, the utility QoS class on
+  /// Darwin and a below normal thread priority on Windows.
+  kBackground,
+};
+
+/// A pool of worker threads that run the tasks posted to its task runners in
+/// no particular order.
+///
+/// Each worker has its own queue of tasks. Tasks posted from a worker are
+/// added to the queue of that worker and tasks posted from other threads are
+/// spread over the queues of all of them. A worker that runs out of tasks
+/// steals from the queues of the others before it goes to sleep, so posting
+/// and running tasks only contends on the lock of a single queue. Each queue
+/// has a lane for each `ConcurrentTaskPriority`.
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -28,7 +55,8 @@ class ConcurrentMessageLoop
 
   size_t GetWorkerCount() const;
 
-  std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner();
+  std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner(
+      ConcurrentTaskPriority priority = ConcurrentTaskPriority::kUserVisible);
 
   void Terminate();
 
@@ -37,40 +65,73 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  static constexpr size_t kPriorityCount = 3;
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    // Indexed by ConcurrentTaskPriority.
+    std::deque<fml::closure> tasks[kPriorityCount];
+    // The tasks posted to all of the workers, which can't be stolen.
+    std::vector<fml::closure> thread_tasks;
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
+  // Not modified once the workers have been started.
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
   std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic_size_t next_worker_queue_ = {0};
+  // The number of tasks in all of the worker queues, in total and for each
+  // priority.
+  std::atomic_size_t pending_tasks_ = {0};
+  std::atomic_size_t pending_tasks_by_priority_[kPriorityCount] = {};
+  // Guards the sleep and wake up of the workers.
+  std::mutex idle_mutex_;
+  std::condition_variable idle_condition_;
+  std::atomic_size_t idle_workers_ = {0};
+  std::atomic_bool shutdown_ = {false};
 
   ConcurrentMessageLoop(size_t worker_count);
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
-  void PostTask(const fml::closure& task);
+  void PostTask(const fml::closure& task, ConcurrentTaskPriority priority);
 
-  bool HasThreadTasksLocked() const;
+  void PostTasks(std::vector<fml::closure> tasks,
+                 ConcurrentTaskPriority priority);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  // Takes the oldest task of the most important priority that has tasks from
+  // the queue of the worker, or steals the newest one from another worker if
+  // it has none.
+  fml::closure TakeTask(size_t worker_index, ConcurrentTaskPriority* priority);
+
+  bool HasThreadTasks(size_t worker_index);
+
+  std::vector<fml::closure> TakeThreadTasks(size_t worker_index);
+
+  // Wakes one idle worker for a single task and all of them for more.
+  void WakeUpIdleWorkers(size_t task_count);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
 
 class ConcurrentTaskRunner : public BasicTaskRunner {
  public:
-  ConcurrentTaskRunner(std::weak_ptr<ConcurrentMessageLoop> weak_loop);
+  ConcurrentTaskRunner(
+      std::weak_ptr<ConcurrentMessageLoop> weak_loop,
+      ConcurrentTaskPriority priority = ConcurrentTaskPriority::kUserVisible);
 
   virtual ~ConcurrentTaskRunner();
 
   void PostTask(const fml::closure& task) override;
 
+  void PostTasks(std::vector<fml::closure> tasks) override;
+
  private:
   friend ConcurrentMessageLoop;
 
   std::weak_ptr<ConcurrentMessageLoop> weak_loop_;
+  const ConcurrentTaskPriority priority_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentTaskRunner);
 };
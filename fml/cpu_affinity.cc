@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace fml {
+
+CPUSpeedTracker::CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data) {
+  if (data.empty()) {
+    return;
+  }
+  const auto [slowest, fastest] = std::minmax_element(
+      data.begin(), data.end(),
+      [](const CpuIndexAndSpeed& a, const CpuIndexAndSpeed& b) {
+        return a.speed < b.speed;
+      });
+  const int64_t min_speed = slowest->speed;
+  const int64_t max_speed = fastest->speed;
+  if (min_speed == max_speed || min_speed < 0) {
+    return;
+  }
+  for (const CpuIndexAndSpeed& cpu : data) {
+    if (cpu.speed == max_speed) {
+      performance_.push_back(cpu.index);
+    } else {
+      not_performance_.push_back(cpu.index);
+    }
+    if (cpu.speed == min_speed) {
+      efficiency_.push_back(cpu.index);
+    } else {
+      not_efficiency_.push_back(cpu.index);
+    }
+  }
+  valid_ = true;
+}
+
+bool CPUSpeedTracker::IsValid() const {
+  return valid_;
+}
+
+const std::vector<size_t>& CPUSpeedTracker::GetIndices(
+    CpuAffinity affinity) const {
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      return performance_;
+    case CpuAffinity::kEfficiency:
+      return efficiency_;
+    case CpuAffinity::kNotPerformance:
+      return not_performance_;
+    case CpuAffinity::kNotEfficiency:
+      return not_efficiency_;
+  }
+  return performance_;
+}
+
+int64_t ReadIntFromFile(const std::string& path) {
+  FILE* file = std::fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    return -1;
+  }
+  long long value = -1;
+  if (std::fscanf(file, "%lld", &value) != 1) {
+    value = -1;
+  }
+  std::fclose(file);
+  return value;
+}
+
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+
+static const CPUSpeedTracker& GetCPUSpeedTracker() {
+  static std::optional<CPUSpeedTracker> tracker;
+  static std::once_flag once;
+  std::call_once(once, []() {
+    std::vector<CpuIndexAndSpeed> data;
+    const long count = ::sysconf(_SC_NPROCESSORS_CONF);
+    for (long i = 0; i < count; i++) {
+      const int64_t speed = ReadIntFromFile(
+          "/sys/devices/system/cpu/cpu" + std::to_string(i) +
+          "/cpufreq/cpuinfo_max_freq");
+      // The attributes of the cores that are offline can't be read, leave
+      // those out.
+      if (speed >= 0) {
+        data.push_back({static_cast<size_t>(i), speed});
+      }
+    }
+    tracker.emplace(std::move(data));
+  });
+  return tracker.value();
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  const CPUSpeedTracker& tracker = GetCPUSpeedTracker();
+  if (!tracker.IsValid()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t index : tracker.GetIndices(affinity)) {
+    CPU_SET(index, &set);
+  }
+  if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+    FML_DLOG(ERROR) << "Failed to set the CPU affinity of a thread.";
+    return false;
+  }
+  return true;
+}
+
+#else
+
+bool RequestAffinity(CpuAffinity affinity) {
+  return false;
+}
+
+#endif
+
+}  // namespace fml
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fml {
+
+/// The classes of cores of a heterogeneous, like ARM big.LITTLE, CPU that a
+/// thread may be restricted to.
+enum class CpuAffinity {
+  /// The fastest cores.
+  kPerformance,
+
+  /// The slowest cores.
+  kEfficiency,
+
+  /// All of the cores except for the fastest ones.
+  kNotPerformance,
+
+  /// All of the cores except for the slowest ones.
+  kNotEfficiency,
+};
+
+struct CpuIndexAndSpeed {
+  // The index of the core, as used by the scheduler.
+  size_t index;
+  // The max frequency of the core. Only compared to the other cores.
+  int64_t speed;
+};
+
+/// Sorts the cores of a CPU into the classes of `CpuAffinity` by their max
+/// frequencies.
+class CPUSpeedTracker {
+ public:
+  explicit CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data);
+
+  /// Whether the cores run at different speeds. The indices of a
+  /// homogeneous CPU are all empty, restricting threads to them is
+  /// pointless.
+  bool IsValid() const;
+
+  /// The indices of the cores of the class \p affinity.
+  const std::vector<size_t>& GetIndices(CpuAffinity affinity) const;
+
+ private:
+  bool valid_ = false;
+  std::vector<size_t> performance_;
+  std::vector<size_t> efficiency_;
+  std::vector<size_t> not_performance_;
+  std::vector<size_t> not_efficiency_;
+};
+
+/// Reads an integer from a file like the `cpuinfo_max_freq` attribute files
+/// of sysfs. Returns -1 if the file could not be read.
+int64_t ReadIntFromFile(const std::string& path);
+
+/// Restricts the calling thread to the cores of the class \p affinity.
+///
+/// This is only supported on Android and Linux, where the speeds of the cores
+/// are read from sysfs once. Returns false if the cores could not be sorted
+/// or the scheduler rejected the request, the thread may then run on any
+/// core as before.
+bool RequestAffinity(CpuAffinity affinity);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(CpuAffinity, NonHeterogenousCoresAreInvalid) {
+  CPUSpeedTracker tracker({{0, 1}, {1, 1}, {2, 1}, {3, 1}});
+  ASSERT_FALSE(tracker.IsValid());
+  ASSERT_TRUE(tracker.GetIndices(CpuAffinity::kPerformance).empty());
+}
+
+TEST(CpuAffinity, NoCoresAreInvalid) {
+  CPUSpeedTracker tracker({});
+  ASSERT_FALSE(tracker.IsValid());
+}
+
+TEST(CpuAffinity, SortsCoresBySpeed) {
+  // The layout of a big.LITTLE CPU with a prime core.
+  CPUSpeedTracker tracker({{0, 1800},
+                           {1, 1800},
+                           {2, 1800},
+                           {3, 1800},
+                           {4, 2400},
+                           {5, 2400},
+                           {6, 2400},
+                           {7, 3000}});
+  ASSERT_TRUE(tracker.IsValid());
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            std::vector<size_t>({7}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kEfficiency),
+            std::vector<size_t>({0, 1, 2, 3}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            std::vector<size_t>({0, 1, 2, 3, 4, 5, 6}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kNotEfficiency),
+            std::vector<size_t>({4, 5, 6, 7}));
+}
+
+TEST(CpuAffinity, ReadsIntFromFile) {
+  fml::ScopedTemporaryDirectory dir;
+  fml::DataMapping data("1200000\n");
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "max_freq", data));
+  ASSERT_EQ(ReadIntFromFile(dir.path() + "/max_freq"), 1200000);
+  ASSERT_EQ(ReadIntFromFile(dir.path() + "/missing"), -1);
+}
+
+}  // namespace testing
+}  // namespace fml
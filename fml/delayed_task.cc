@@ -6,14 +6,19 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include <algorithm>
+#include <functional>
+
+#include "flutter/fml/logging.h"
+
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
-                         const fml::closure& task,
+                         fml::closure task,
                          fml::TimePoint target_time,
                          fml::TaskSourceGrade task_source_grade)
     : order_(order),
-      task_(task),
+      task_(std::move(task)),
       target_time_(target_time),
       task_source_grade_(task_source_grade) {}
 
@@ -21,10 +26,20 @@ DelayedTask::~DelayedTask() = default;
 
 DelayedTask::DelayedTask(const DelayedTask& other) = default;
 
+DelayedTask::DelayedTask(DelayedTask&& other) noexcept = default;
+
+DelayedTask& DelayedTask::operator=(const DelayedTask& other) = default;
+
+DelayedTask& DelayedTask::operator=(DelayedTask&& other) noexcept = default;
+
 const fml::closure& DelayedTask::GetTask() const {
   return task_;
 }
 
+fml::closure DelayedTask::TakeTask() {
+  return std::move(task_);
+}
+
 fml::TimePoint DelayedTask::GetTargetTime() const {
   return target_time_;
 }
@@ -40,4 +55,57 @@ bool DelayedTask::operator>(const DelayedTask& other) const {
   return target_time_ > other.target_time_;
 }
 
+DelayedTaskQueue::DelayedTaskQueue() = default;
+
+DelayedTaskQueue::~DelayedTaskQueue() = default;
+
+void DelayedTaskQueue::push(DelayedTask task) {
+  if (fifo_.empty() || task > fifo_.back()) {
+    fifo_.push_back(std::move(task));
+    return;
+  }
+  heap_.push_back(std::move(task));
+  std::push_heap(heap_.begin(), heap_.end(), std::greater<DelayedTask>());
+}
+
+const DelayedTask& DelayedTaskQueue::top() const {
+  FML_DCHECK(!empty());
+  return IsTopInFifo() ? fifo_.front() : heap_.front();
+}
+
+void DelayedTaskQueue::pop() {
+  PopTask();
+}
+
+fml::closure DelayedTaskQueue::PopTask() {
+  FML_DCHECK(!empty());
+  if (IsTopInFifo()) {
+    fml::closure task = fifo_.front().TakeTask();
+    fifo_.pop_front();
+    return task;
+  }
+  std::pop_heap(heap_.begin(), heap_.end(), std::greater<DelayedTask>());
+  fml::closure task = heap_.back().TakeTask();
+  heap_.pop_back();
+  return task;
+}
+
+bool DelayedTaskQueue::empty() const {
+  return fifo_.empty() && heap_.empty();
+}
+
+size_t DelayedTaskQueue::size() const {
+  return fifo_.size() + heap_.size();
+}
+
+bool DelayedTaskQueue::IsTopInFifo() const {
+  if (heap_.empty()) {
+    return true;
+  }
+  if (fifo_.empty()) {
+    return false;
+  }
+  return heap_.front() > fifo_.front();
+}
+
 }  // namespace fml
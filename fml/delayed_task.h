@@ -5,7 +5,8 @@
 #ifndef FLUTTER_FML_DELAYED_TASK_H_
 #define FLUTTER_FML_DELAYED_TASK_H_
 
-#include <queue>
+#include <deque>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/task_source_grade.h"
@@ -16,16 +17,25 @@ namespace fml {
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::closure task,
               fml::TimePoint target_time,
               fml::TaskSourceGrade task_source_grade);
 
   DelayedTask(const DelayedTask& other);
 
+  DelayedTask(DelayedTask&& other) noexcept;
+
+  DelayedTask& operator=(const DelayedTask& other);
+
+  DelayedTask& operator=(DelayedTask&& other) noexcept;
+
   ~DelayedTask();
 
   const fml::closure& GetTask() const;
 
+  /// Moves the task out, leaving this with an empty closure.
+  fml::closure TakeTask();
+
   fml::TimePoint GetTargetTime() const;
 
   fml::TaskSourceGrade GetTaskSourceGrade() const;
@@ -39,9 +49,40 @@ class DelayedTask {
   fml::TaskSourceGrade task_source_grade_;
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A min-heap of `DelayedTask`s ordered by their target times. Unlike a
+/// `std::priority_queue`, the top task can be moved out when it is popped, so
+/// that the closure of a task isn't copied on its way through the queue.
+///
+/// Most tasks are posted to run as soon as possible and so arrive in the order
+/// they run in. Those tasks are kept in a FIFO in front of the heap, pushing
+/// and popping them is O(1). Only the tasks that would run before the last
+/// task of the FIFO, like those posted after a delayed task, go to the heap.
+class DelayedTaskQueue {
+ public:
+  DelayedTaskQueue();
+
+  ~DelayedTaskQueue();
+
+  void push(DelayedTask task);
+
+  const DelayedTask& top() const;
+
+  void pop();
+
+  /// Pops the top task and returns its closure.
+  fml::closure PopTask();
+
+  bool empty() const;
+
+  size_t size() const;
+
+ private:
+  // Sorted by target time and order, each task runs before the next one.
+  std::deque<DelayedTask> fifo_;
+  std::vector<DelayedTask> heap_;
+
+  bool IsTopInFifo() const;
+};
 
 }  // namespace fml
 
@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/delayed_task.h"
+
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(DelayedTaskQueueTests, PopsTasksInOrderOfTargetTime) {
+  DelayedTaskQueue queue;
+  const auto now = fml::TimePoint::Now();
+  std::vector<int> ran;
+  // Immediate tasks interleaved with delayed ones, in the way a message loop
+  // receives them.
+  const int delays[] = {0, 0, 5, 0, 2, 0, 5, 1, 0, 0};
+  const size_t kTaskCount = sizeof(delays) / sizeof(delays[0]);
+  for (size_t i = 0; i < kTaskCount; i++) {
+    const int id = static_cast<int>(i);
+    queue.push({i, [&ran, id]() { ran.push_back(id); },
+                now + fml::TimeDelta::FromMilliseconds(delays[i]),
+                TaskSourceGrade::kUnspecified});
+  }
+  ASSERT_EQ(queue.size(), kTaskCount);
+
+  while (!queue.empty()) {
+    queue.PopTask()();
+  }
+  const std::vector<int> expected = {0, 1, 3, 5, 8, 9, 7, 4, 2, 6};
+  ASSERT_EQ(ran, expected);
+}
+
+TEST(DelayedTaskQueueTests, TopMatchesPoppedTask) {
+  DelayedTaskQueue queue;
+  const auto now = fml::TimePoint::Now();
+  queue.push({1, [] {}, now + fml::TimeDelta::FromMilliseconds(10),
+              TaskSourceGrade::kUnspecified});
+  queue.push({2, [] {}, now, TaskSourceGrade::kUnspecified});
+  queue.push({3, [] {}, now + fml::TimeDelta::FromMilliseconds(20),
+              TaskSourceGrade::kUnspecified});
+  ASSERT_EQ(queue.top().GetTargetTime(), now);
+  queue.pop();
+  ASSERT_EQ(queue.top().GetTargetTime(),
+            now + fml::TimeDelta::FromMilliseconds(10));
+  queue.pop();
+  ASSERT_EQ(queue.top().GetTargetTime(),
+            now + fml::TimeDelta::FromMilliseconds(20));
+  queue.pop();
+  ASSERT_TRUE(queue.empty());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -72,6 +72,11 @@ bool IsFile(const std::string& path);
 
 bool TruncateFile(const fml::UniqueFD& file, size_t size);
 
+// Asks the system to start reading all of the file in the background, so that
+// the reads of several files overlap instead of each one blocking its first
+// access. Returns false if the system does not support it for the file.
+bool PrefetchFile(const fml::UniqueFD& file);
+
 bool FileExists(const fml::UniqueFD& base_directory, const char* path);
 
 bool UnlinkDirectory(const char* path);
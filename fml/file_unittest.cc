@@ -253,6 +253,27 @@ TEST(FileTest, AtomicWriteTest) {
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "precious_data"));
 }
 
+TEST(FileTest, PrefetchFile) {
+  fml::ScopedTemporaryDirectory dir;
+
+  {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", true,
+                              fml::FilePermission::kReadWrite);
+    WriteStringToFile(file, "some content");
+  }
+
+  ASSERT_FALSE(fml::PrefetchFile(fml::UniqueFD()));
+  {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", false,
+                              fml::FilePermission::kRead);
+#if defined(OS_LINUX) || defined(OS_ANDROID) || defined(OS_MACOSX)
+    ASSERT_TRUE(fml::PrefetchFile(file));
+#endif
+    ASSERT_EQ(ReadStringFromFile(file), "some content");
+  }
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
+}
+
 TEST(FileTest, EmptyMappingTest) {
   fml::ScopedTemporaryDirectory dir;
 
@@ -214,6 +214,22 @@ class SymbolMapping final : public Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(SymbolMapping);
 };
 
+// The size of the pages of memory, to which the ranges of the functions below
+// are rounded.
+size_t GetMappingPageSize();
+
+// Advises the system that the pages of the range will be accessed soon, so that
+// they are read ahead of the faults of their first access. It doesn't wait for
+// them to be read. Returns false if the platform can't prefetch them.
+bool PrefetchMappingPages(const void* address, size_t size);
+
+// Sets whether each page of the range is resident in the memory of the
+// process, starting from the page of the address. Returns false if the range
+// isn't entirely mapped or the platform can't tell.
+bool GetResidentMappingPages(const void* address,
+                             size_t size,
+                             std::vector<bool>* resident);
+
 }  // namespace fml
 
 #endif  // FLUTTER_FML_MAPPING_H_
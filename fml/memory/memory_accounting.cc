@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/memory_accounting.h"
+
+#include <atomic>
+
+namespace fml {
+
+namespace {
+
+std::atomic<int64_t> gBytes[kMemoryCategoryCount] = {};
+
+std::atomic<int64_t>& GetCount(MemoryCategory category) {
+  return gBytes[static_cast<size_t>(category)];
+}
+
+}  // namespace
+
+void MemoryAccounting::Add(MemoryCategory category, int64_t bytes) {
+  if (bytes != 0) {
+    GetCount(category).fetch_add(bytes, std::memory_order_relaxed);
+  }
+}
+
+int64_t MemoryAccounting::GetBytes(MemoryCategory category) {
+  return GetCount(category).load(std::memory_order_relaxed);
+}
+
+const char* MemoryAccounting::GetName(MemoryCategory category) {
+  switch (category) {
+    case MemoryCategory::kImages:
+      return "images";
+    case MemoryCategory::kTextLayoutCache:
+      return "textLayoutCache";
+    case MemoryCategory::kDisplayLists:
+      return "displayLists";
+    case MemoryCategory::kPlatformMessages:
+      return "platformMessages";
+    case MemoryCategory::kVulkanDeviceMemory:
+      return "vulkanDeviceMemory";
+  }
+  return "unknown";
+}
+
+ScopedMemoryAccount::ScopedMemoryAccount(MemoryCategory category, size_t bytes)
+    : category_(category), bytes_(bytes) {
+  MemoryAccounting::Add(category_, bytes_);
+}
+
+ScopedMemoryAccount::~ScopedMemoryAccount() {
+  MemoryAccounting::Add(category_, -static_cast<int64_t>(bytes_));
+}
+
+ScopedMemoryAccount::ScopedMemoryAccount(ScopedMemoryAccount&& other)
+    : category_(other.category_), bytes_(other.bytes_) {
+  other.bytes_ = 0;
+}
+
+ScopedMemoryAccount& ScopedMemoryAccount::operator=(
+    ScopedMemoryAccount&& other) {
+  if (this != &other) {
+    Reset();
+    category_ = other.category_;
+    bytes_ = other.bytes_;
+    other.bytes_ = 0;
+  }
+  return *this;
+}
+
+void ScopedMemoryAccount::Reset(size_t bytes) {
+  MemoryAccounting::Add(category_, static_cast<int64_t>(bytes) -
+                                       static_cast<int64_t>(bytes_));
+  bytes_ = bytes;
+}
+
+}  // namespace fml
@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_MEMORY_ACCOUNTING_H_
+#define FLUTTER_FML_MEMORY_MEMORY_ACCOUNTING_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// The engine subsystems whose native memory is accounted for.
+enum class MemoryCategory {
+  /// The images held by `dart:ui` images.
+  kImages,
+  /// The layouts of the words cached by the text layout.
+  kTextLayoutCache,
+  /// The storage of the display lists.
+  kDisplayLists,
+  /// The data of the platform messages in flight.
+  kPlatformMessages,
+  /// The Vulkan device memory that the engine allocates itself, not Skia.
+  kVulkanDeviceMemory,
+};
+
+constexpr size_t kMemoryCategoryCount = 5;
+
+//------------------------------------------------------------------------------
+/// @brief      Counts the bytes allocated by each of the subsystems of the
+///             engine, so that the memory of the process can be attributed to
+///             them.
+///
+///             The counts are shared by all the engines of the process and
+///             can be updated and read on any thread.
+///
+class MemoryAccounting {
+ public:
+  /// Adds the bytes to the count of the category, or removes them if they are
+  /// negative.
+  static void Add(MemoryCategory category, int64_t bytes);
+
+  static int64_t GetBytes(MemoryCategory category);
+
+  /// The name of the category in the reports, e.g. "displayLists".
+  static const char* GetName(MemoryCategory category);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryAccounting);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Accounts for the bytes of an allocation until it is reset or
+///             destroyed.
+///
+class ScopedMemoryAccount {
+ public:
+  ScopedMemoryAccount(MemoryCategory category, size_t bytes = 0);
+
+  ~ScopedMemoryAccount();
+
+  ScopedMemoryAccount(ScopedMemoryAccount&& other);
+
+  ScopedMemoryAccount& operator=(ScopedMemoryAccount&& other);
+
+  /// Replaces the bytes that are accounted for.
+  void Reset(size_t bytes = 0);
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  MemoryCategory category_;
+  size_t bytes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedMemoryAccount);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_MEMORY_ACCOUNTING_H_
@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/memory_accounting.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+TEST(MemoryAccountingTest, AddsAndRemovesBytes) {
+  const int64_t initial = MemoryAccounting::GetBytes(MemoryCategory::kImages);
+  MemoryAccounting::Add(MemoryCategory::kImages, 100);
+  EXPECT_EQ(MemoryAccounting::GetBytes(MemoryCategory::kImages), initial + 100);
+  MemoryAccounting::Add(MemoryCategory::kImages, -100);
+  EXPECT_EQ(MemoryAccounting::GetBytes(MemoryCategory::kImages), initial);
+}
+
+TEST(MemoryAccountingTest, ScopedAccountReleasesItsBytes) {
+  const auto category = MemoryCategory::kPlatformMessages;
+  const int64_t initial = MemoryAccounting::GetBytes(category);
+  {
+    ScopedMemoryAccount account(category, 10);
+    EXPECT_EQ(MemoryAccounting::GetBytes(category), initial + 10);
+    account.Reset(30);
+    EXPECT_EQ(MemoryAccounting::GetBytes(category), initial + 30);
+
+    ScopedMemoryAccount moved(std::move(account));
+    EXPECT_EQ(moved.bytes(), 30u);
+    EXPECT_EQ(account.bytes(), 0u);
+    EXPECT_EQ(MemoryAccounting::GetBytes(category), initial + 30);
+
+    ScopedMemoryAccount assigned(category, 5);
+    assigned = std::move(moved);
+    EXPECT_EQ(MemoryAccounting::GetBytes(category), initial + 30);
+  }
+  EXPECT_EQ(MemoryAccounting::GetBytes(category), initial);
+}
+
+TEST(MemoryAccountingTest, CategoriesHaveNames) {
+  EXPECT_STREQ(MemoryAccounting::GetName(MemoryCategory::kTextLayoutCache),
+               "textLayoutCache");
+  EXPECT_STREQ(MemoryAccounting::GetName(MemoryCategory::kDisplayLists),
+               "displayLists");
+}
+
+}  // namespace
+}  // namespace fml
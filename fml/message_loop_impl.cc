@@ -55,7 +55,8 @@ MessageLoopImpl::~MessageLoopImpl() {
 }
 
 void MessageLoopImpl::PostTask(const fml::closure& task,
-                               fml::TimePoint target_time) {
+                               fml::TimePoint target_time,
+                               fml::TaskSourceGrade task_source_grade) {
   FML_DCHECK(task != nullptr);
   FML_DCHECK(task != nullptr);
   if (terminated_) {
@@ -63,7 +64,16 @@ void MessageLoopImpl::PostTask(const fml::closure& task,
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, task, target_time, task_source_grade);
+}
+
+void MessageLoopImpl::PostTasks(std::vector<fml::closure> tasks,
+                                fml::TimePoint target_time) {
+  if (terminated_) {
+    // Like PostTask, the tasks are destructed synchronously.
+    return;
+  }
+  task_queue_->RegisterTasks(queue_id_, std::move(tasks), target_time);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
@@ -11,6 +11,7 @@
 #include <mutex>
 #include <queue>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/delayed_task.h"
@@ -39,7 +40,12 @@ class MessageLoopImpl : public Wakeable,
 
   virtual void Terminate() = 0;
 
-  void PostTask(const fml::closure& task, fml::TimePoint target_time);
+  void PostTask(const fml::closure& task,
+                fml::TimePoint target_time,
+                fml::TaskSourceGrade task_source_grade =
+                    fml::TaskSourceGrade::kUnspecified);
+
+  void PostTasks(std::vector<fml::closure> tasks, fml::TimePoint target_time);
 
   void AddTaskObserver(intptr_t key, const fml::closure& callback);
 
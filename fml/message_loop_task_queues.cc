@@ -41,7 +41,9 @@ FML_THREAD_LOCAL ThreadLocalUniquePtr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
-    : subsumed_by(_kUnmerged), created_for(created_for_arg) {
+    : wake_time(fml::TimePoint::Max()),
+      subsumed_by(_kUnmerged),
+      created_for(created_for_arg) {
   wakeable = NULL;
   task_observers = TaskObservers();
   task_source = std::make_unique<TaskSource>(created_for);
@@ -58,7 +60,7 @@ fml::RefPtr<MessageLoopTaskQueues> MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
@@ -66,12 +68,14 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {}
+    : queue_meta_mutex_(fml::SharedMutex::Create("MessageLoopTaskQueues")),
+      task_queue_id_counter_(0),
+      order_(0) {}
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -83,7 +87,8 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -103,31 +108,76 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
-  size_t order = order_++;
+  fml::SharedLock lock(*queue_meta_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
+  TaskQueueId loop_to_wake = queue_id;
+  if (queue_entry->subsumed_by != _kUnmerged) {
+    loop_to_wake = queue_entry->subsumed_by;
+  }
+
+  // Posting to the same TaskQueue, or to TaskQueues merged into the same
+  // owner, is serialized so that the wake up is computed from all of their
+  // tasks. Posts to other TaskQueues proceed concurrently.
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
+  size_t order = order_++;
   queue_entry->task_source->RegisterTask(
       {order, task, target_time, task_source_grade});
+
+  // This can happen when the secondary tasks are paused.
+  if (HasPendingTasksUnlocked(loop_to_wake)) {
+    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  }
+}
+
+void MessageLoopTaskQueues::RegisterTasks(
+    TaskQueueId queue_id,
+    std::vector<fml::closure> tasks,
+    fml::TimePoint target_time,
+    fml::TaskSourceGrade task_source_grade) {
+  fml::SharedLock lock(*queue_meta_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != _kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
   }
 
-  // This can happen when the secondary tasks are paused.
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
+  for (auto& task : tasks) {
+    if (!task) {
+      continue;
+    }
+    size_t order = order_++;
+    queue_entry->task_source->RegisterTask(
+        {order, std::move(task), target_time, task_source_grade});
+  }
+
   if (HasPendingTasksUnlocked(loop_to_wake)) {
     WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
   }
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
+
+  // The loop has been woken up for its wake time, so the wakeable has to be
+  // armed again even if the next wake up is at the same time.
+  auto& wake_time = queue_entries_.at(queue_id)->wake_time;
+  if (wake_time <= from_time) {
+    wake_time = fml::TimePoint::Min();
+  }
+
   if (!HasPendingTasksUnlocked(queue_id)) {
+    // Disarm the wakeable so that the loop isn't woken up again only to find
+    // that the tasks it was armed for have already been run.
+    WakeUpUnlocked(queue_id, fml::TimePoint::Max());
     return nullptr;
   }
   TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
@@ -141,26 +191,52 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
-  fml::closure invocation = top.task.GetTask();
-  queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
+  // Popping the task invalidates `top`. The closure is moved out of the task
+  // source instead of being copied.
+  const auto task_source_grade = top.task.GetTaskSourceGrade();
+  fml::closure invocation =
+      queue_entries_.at(top.task_queue_id)
+          ->task_source->PopTask(task_source_grade);
   {
     std::scoped_lock creation(creation_mutex_);
-    const auto task_source_grade = top.task.GetTaskSourceGrade();
-    tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
+    // Reuse the holder of the thread, this runs for every task.
+    if (TaskSourceGradeHolder* holder = tls_task_source_grade.get()) {
+      holder->task_source_grade = task_source_grade;
+    } else {
+      tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
+    }
   }
   return invocation;
 }
 
+std::mutex& MessageLoopTaskQueues::GetGroupMutexUnlocked(
+    TaskQueueId queue_id) const {
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  if (queue_entry->subsumed_by != _kUnmerged) {
+    return queue_entries_.at(queue_entry->subsumed_by)->group_mutex;
+  }
+  return queue_entry->group_mutex;
+}
+
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
                                            fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  if (!queue_entry->wakeable) {
+    return;
+  }
+  // Arming the wakeable is a syscall on most of the platforms. The tasks that
+  // are posted while an earlier task is pending don't move the wake up time,
+  // so they are coalesced into the wake up that is already armed.
+  if (queue_entry->wake_time == time) {
+    return;
   }
+  queue_entry->wake_time = time;
+  queue_entry->wakeable->WakeUp(time);
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
@@ -180,20 +256,23 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
   queue_entries_.at(queue_id)->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   queue_entries_.at(queue_id)->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -216,7 +295,7 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
       << "Wakeable can only be set once.";
   queue_entries_.at(queue_id)->wakeable = wakeable;
@@ -226,7 +305,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
@@ -274,7 +353,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
@@ -318,7 +397,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
   if (owner == _kUnmerged || subsumed == _kUnmerged) {
     return false;
   }
@@ -328,17 +407,19 @@ bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   queue_entries_.at(queue_id)->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  std::lock_guard guard(GetGroupMutexUnlocked(queue_id));
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
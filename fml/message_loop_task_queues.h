@@ -5,7 +5,9 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
@@ -32,6 +34,12 @@ class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
   Wakeable* wakeable;
+
+  /// The time that the |wakeable| was last asked to wake up at, so that it
+  /// isn't asked again when the next wake up time doesn't change. It is
+  /// |fml::TimePoint::Max()| while the |wakeable| isn't armed.
+  fml::TimePoint wake_time;
+
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
 
@@ -45,6 +53,11 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// Guards the tasks and observers of this TaskQueue and of the TaskQueues
+  /// it owns. The tasks of a subsumed TaskQueue are guarded by the mutex of
+  /// its owner.
+  std::mutex group_mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -60,6 +73,13 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// The set of TaskQueues and how they are merged is guarded by a reader/writer
+/// lock, which is only acquired exclusively to create, dispose, merge and
+/// unmerge TaskQueues. All of the other operations hold it shared along with
+/// the \p TaskQueueEntry::group_mutex of the TaskQueue they act on, so that
+/// the threads posting tasks to different TaskQueues don't contend with each
+/// other.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues
@@ -83,6 +103,14 @@ class MessageLoopTaskQueues
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
 
+  // Registers all of |tasks| with a single lock acquisition and wakes the
+  // loop once. Null tasks are skipped.
+  void RegisterTasks(TaskQueueId queue_id,
+                     std::vector<fml::closure> tasks,
+                     fml::TimePoint target_time,
+                     fml::TaskSourceGrade task_source_grade =
+                         fml::TaskSourceGrade::kUnspecified);
+
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
   fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
@@ -144,6 +172,12 @@ class MessageLoopTaskQueues
 
   ~MessageLoopTaskQueues();
 
+  // The methods ending in Unlocked must be called with |queue_meta_mutex_|
+  // held exclusively, or held shared along with the mutex returned by
+  // |GetGroupMutexUnlocked| for the TaskQueue.
+
+  std::mutex& GetGroupMutexUnlocked(TaskQueueId queue_id) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
@@ -155,7 +189,7 @@ class MessageLoopTaskQueues
   static std::mutex creation_mutex_;
   static fml::RefPtr<MessageLoopTaskQueues> instance_;
 
-  mutable std::mutex queue_mutex_;
+  std::unique_ptr<fml::SharedMutex> queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
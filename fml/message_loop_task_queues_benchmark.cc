@@ -66,5 +66,58 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Posts tasks from |state.range(0)| threads at once, each to its own queue,
+// like the platform thread posting channel messages while the raster thread
+// posts its own tasks.
+static void BM_RegisterTasksFromMultipleThreads(
+    benchmark::State& state) {  // NOLINT
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_threads = state.range(0);
+  const int num_tasks_per_thread = 1000;
+  const fml::TimePoint past = fml::TimePoint::Now();
+
+  std::vector<TaskQueueId> queue_ids;
+  for (int i = 0; i < num_threads; i++) {
+    queue_ids.push_back(task_queue->CreateTaskQueue());
+  }
+
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    CountDownLatch threads_ready(num_threads);
+    for (TaskQueueId queue_id : queue_ids) {
+      threads.emplace_back([&task_queue, &threads_ready, queue_id, past]() {
+        threads_ready.CountDown();
+        threads_ready.Wait();
+        for (int j = 0; j < num_tasks_per_thread; j++) {
+          task_queue->RegisterTask(
+              queue_id, [] {}, past);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    state.PauseTiming();
+    for (TaskQueueId queue_id : queue_ids) {
+      task_queue->DisposeTasks(queue_id);
+    }
+    state.ResumeTiming();
+  }
+
+  for (TaskQueueId queue_id : queue_ids) {
+    task_queue->Dispose(queue_id);
+  }
+  state.SetItemsProcessed(state.iterations() * num_threads *
+                          num_tasks_per_thread);
+}
+
+BENCHMARK(BM_RegisterTasksFromMultipleThreads)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -252,8 +252,15 @@ TEST(MessageLoopTaskQueueMergeUnmerge, GetTasksToRunNowBlocksMerge) {
 
   task_queue->RegisterTask(
       queue_id_1, []() {}, ChronoTicksSinceEpoch());
+  // Only the first wake up blocks, the queue is woken up again to be disarmed
+  // once it has no more tasks.
+  bool first_wake_up = true;
   task_queue->SetWakeable(queue_id_1,
                           new TestWakeable([&](fml::TimePoint wake_time) {
+                            if (!first_wake_up) {
+                              return;
+                            }
+                            first_wake_up = false;
                             wake_up_start.Signal();
                             wake_up_end.Wait();
                           }));
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -270,20 +271,84 @@ TEST(MessageLoopTaskQueue, WakeUpIndependentOfTime) {
       queue_id, new TestWakeable(
                     [&num_wakes](fml::TimePoint wake_time) { ++num_wakes; }));
 
+  const auto now = ChronoTicksSinceEpoch();
   task_queue->RegisterTask(
-      queue_id, []() {}, ChronoTicksSinceEpoch());
+      queue_id, []() {}, now + fml::TimeDelta::FromSeconds(1));
   task_queue->RegisterTask(
-      queue_id, []() {}, fml::TimePoint::Max());
+      queue_id, []() {}, now);
 
   ASSERT_TRUE(num_wakes == 2);
 }
 
+TEST(MessageLoopTaskQueue, WakeUpIsCoalescedWhenTheWakeTimeIsUnchanged) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  std::vector<fml::TimePoint> wakes;
+  task_queue->SetWakeable(queue_id,
+                          new TestWakeable([&wakes](fml::TimePoint wake_time) {
+                            wakes.push_back(wake_time);
+                          }));
+
+  const auto time = ChronoTicksSinceEpoch();
+  for (int i = 0; i < 3; i++) {
+    task_queue->RegisterTask(
+        queue_id, []() {}, time + fml::TimeDelta::FromMilliseconds(i));
+  }
+  ASSERT_EQ(wakes, std::vector<fml::TimePoint>({time}));
+
+  // The loop is armed again for the remaining tasks once it was woken up,
+  // and disarmed after they have all been run.
+  const auto run_time = time + fml::TimeDelta::FromSeconds(1);
+  while (auto task = task_queue->GetNextTaskToRun(queue_id, run_time)) {
+    task();
+  }
+  ASSERT_EQ(wakes.back(), fml::TimePoint::Max());
+  const size_t num_wakes = wakes.size();
+
+  task_queue->GetNextTaskToRun(queue_id, run_time);
+  ASSERT_EQ(wakes.size(), num_wakes);
+
+  task_queue->RegisterTask(
+      queue_id, []() {}, time);
+  ASSERT_EQ(wakes.size(), num_wakes + 1);
+  ASSERT_EQ(wakes.back(), time);
+}
+
+TEST(MessageLoopTaskQueue, RegisterTasksWakesUpOnce) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  int num_wakes = 0;
+  task_queue->SetWakeable(
+      queue_id, new TestWakeable(
+                    [&num_wakes](fml::TimePoint wake_time) { ++num_wakes; }));
+
+  std::vector<int> ran;
+  std::vector<fml::closure> tasks;
+  for (int i = 0; i < 3; i++) {
+    tasks.push_back([&ran, i]() { ran.push_back(i); });
+  }
+  tasks.push_back(nullptr);
+  task_queue->RegisterTasks(queue_id, std::move(tasks),
+                            ChronoTicksSinceEpoch());
+
+  ASSERT_EQ(num_wakes, 1);
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_id), 3u);
+  while (auto task =
+             task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Max())) {
+    task();
+  }
+  ASSERT_EQ(ran, std::vector<int>({0, 1, 2}));
+}
+
 TEST(MessageLoopTaskQueue, WokenUpWithNewerTime) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto queue_id = task_queue->CreateTaskQueue();
   fml::CountDownLatch latch(2);
 
-  fml::TimePoint expected = fml::TimePoint::Max();
+  fml::TimePoint expected =
+      ChronoTicksSinceEpoch() + fml::TimeDelta::FromSeconds(1);
 
   task_queue->SetWakeable(
       queue_id, new TestWakeable([&latch, &expected](fml::TimePoint wake_time) {
@@ -292,7 +357,7 @@ TEST(MessageLoopTaskQueue, WokenUpWithNewerTime) {
       }));
 
   task_queue->RegisterTask(
-      queue_id, []() {}, fml::TimePoint::Max());
+      queue_id, []() {}, expected);
 
   const auto now = ChronoTicksSinceEpoch();
   expected = now;
@@ -302,6 +367,41 @@ TEST(MessageLoopTaskQueue, WokenUpWithNewerTime) {
   latch.Wait();
 }
 
+TEST(MessageLoopTaskQueue, ConcurrentRegisterTaskToDifferentQueues) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_queues = 4;
+  const size_t num_tasks_per_queue = 1000;
+  std::vector<fml::TaskQueueId> queue_ids;
+  for (int i = 0; i < num_queues; i++) {
+    queue_ids.push_back(task_queue->CreateTaskQueue());
+  }
+  // Posts to a subsumed queue are serialized with the posts to its owner.
+  ASSERT_TRUE(task_queue->Merge(queue_ids[0], queue_ids[1]));
+
+  std::vector<std::thread> threads;
+  for (fml::TaskQueueId queue_id : queue_ids) {
+    threads.emplace_back([&task_queue, queue_id]() {
+      for (size_t i = 0; i < num_tasks_per_queue; i++) {
+        task_queue->RegisterTask(
+            queue_id, [] {}, ChronoTicksSinceEpoch());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_ids[0]),
+            2 * num_tasks_per_queue);
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_ids[1]), 0u);
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_ids[2]), num_tasks_per_queue);
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_ids[3]), num_tasks_per_queue);
+
+  ASSERT_TRUE(task_queue->Unmerge(queue_ids[0], queue_ids[1]));
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_ids[0]), num_tasks_per_queue);
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_ids[1]), num_tasks_per_queue);
+}
+
 TEST(MessageLoopTaskQueue, NotifyObserversWhileCreatingQueues) {
   auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
   fml::TaskQueueId queue_id = task_queues->CreateTaskQueue();
@@ -445,9 +545,16 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   task_queue->RegisterTask(
       raster_queue, []() {}, time2);
 
-  ASSERT_EQ(3UL, wakes.size());
-  ASSERT_EQ(time1, wakes[1]);
-  ASSERT_EQ(time1, wakes[2]);
+  // The task of the raster queue doesn't move the wake up of the platform
+  // queue.
+  ASSERT_EQ(1UL, wakes.size());
+
+  auto time0 = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(
+      raster_queue, []() {}, time0);
+
+  ASSERT_EQ(2UL, wakes.size());
+  ASSERT_EQ(time0, wakes[1]);
 }
 
 }  // namespace testing
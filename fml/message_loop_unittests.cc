@@ -7,13 +7,17 @@
 #include "flutter/fml/message_loop.h"
 
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/time/chrono_timestamp_provider.h"
 #include "gtest/gtest.h"
 
@@ -108,6 +112,26 @@ TEST(MessageLoop, NonDelayedTasksAreRunInOrder) {
   ASSERT_TRUE(terminated);
 }
 
+TEST(MessageLoop, BatchedTasksAreRunInOrder) {
+  const size_t count = 100;
+  fml::Thread thread;
+  fml::AutoResetWaitableEvent latch;
+  size_t current = 0;
+  std::vector<fml::closure> tasks;
+  for (size_t i = 0; i < count; i++) {
+    tasks.push_back(PLATFORM_SPECIFIC_CAPTURE(&current, &latch, i)() {
+      ASSERT_EQ(current, i);
+      current++;
+      if (count == i + 1) {
+        latch.Signal();
+      }
+    });
+  }
+  thread.GetTaskRunner()->PostTasks(std::move(tasks));
+  latch.Wait();
+  ASSERT_EQ(current, count);
+}
+
 TEST(MessageLoop, DelayedTasksAtSameTimeAreRunInOrder) {
   const size_t count = 100;
   bool started = false;
@@ -298,6 +322,83 @@ TEST(MessageLoop, CanCreateAndShutdownConcurrentMessageLoopsOverAndOver) {
   }
 }
 
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedFromWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  const size_t kSubtaskCount = 10;
+  // The posting tasks count down too, so that the loop is never released by
+  // a worker that is still posting to it.
+  fml::CountDownLatch latch(kCount * (kSubtaskCount + 1));
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() {
+      // Tasks posted from a worker may be stolen by the other workers.
+      for (size_t j = 0; j < kSubtaskCount; ++j) {
+        task_runner->PostTask([&]() { latch.CountDown(); });
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopPostsTaskToAllWorkers) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    std::scoped_lock lock(thread_ids_mutex);
+    thread_ids.insert(std::this_thread::get_id());
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsBatchesOfTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  const size_t kCount = 100;
+  fml::CountDownLatch latch(kCount);
+  std::vector<fml::closure> tasks;
+  for (size_t i = 0; i < kCount; ++i) {
+    tasks.push_back([&latch]() { latch.CountDown(); });
+  }
+  loop->GetTaskRunner()->PostTasks(std::move(tasks));
+  latch.Wait();
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsMoreImportantTasksFirst) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  fml::AutoResetWaitableEvent worker_blocked;
+  fml::AutoResetWaitableEvent unblock_worker;
+  loop->GetTaskRunner()->PostTask([&]() {
+    worker_blocked.Signal();
+    unblock_worker.Wait();
+  });
+  worker_blocked.Wait();
+
+  // The worker is busy, so these tasks are only taken once both are queued.
+  std::vector<fml::ConcurrentTaskPriority> order;
+  fml::CountDownLatch latch(3);
+  for (auto priority : {fml::ConcurrentTaskPriority::kBackground,
+                        fml::ConcurrentTaskPriority::kUserVisible,
+                        fml::ConcurrentTaskPriority::kUserBlocking}) {
+    loop->GetTaskRunner(priority)->PostTask([&order, &latch, priority]() {
+      order.push_back(priority);
+      latch.CountDown();
+    });
+  }
+  unblock_worker.Signal();
+  latch.Wait();
+
+  ASSERT_EQ(order.size(), 3u);
+  ASSERT_EQ(order[0], fml::ConcurrentTaskPriority::kUserBlocking);
+  ASSERT_EQ(order[1], fml::ConcurrentTaskPriority::kUserVisible);
+  ASSERT_EQ(order[2], fml::ConcurrentTaskPriority::kBackground);
+}
+
 TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   auto task_runner = loop->GetTaskRunner();
@@ -10,9 +10,11 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <climits>
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
@@ -159,6 +161,28 @@ bool TruncateFile(const fml::UniqueFD& file, size_t size) {
   return ::ftruncate(file.get(), size) == 0;
 }
 
+bool PrefetchFile(const fml::UniqueFD& file) {
+  if (!file.is_valid()) {
+    return false;
+  }
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  return ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_WILLNEED) == 0;
+#elif defined(OS_MACOSX)
+  struct stat stat_result = {};
+  if (::fstat(file.get(), &stat_result) != 0 ||
+      stat_result.st_size > INT_MAX) {
+    return false;
+  }
+  struct radvisory advisory = {};
+  advisory.ra_offset = 0;
+  advisory.ra_count = static_cast<int>(stat_result.st_size);
+  return ::fcntl(file.get(), F_RDADVISE, &advisory) != -1;
+#else
+  return false;
+#endif
+}
+
 bool UnlinkDirectory(const char* path) {
   return UnlinkDirectory(fml::UniqueFD{AT_FDCWD}, path);
 }
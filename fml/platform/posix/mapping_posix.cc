@@ -10,6 +10,8 @@
 #include <unistd.h>
 
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/eintr_wrapper.h"
@@ -108,4 +110,65 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+size_t GetMappingPageSize() {
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size;
+}
+
+#if !defined(OS_FUCHSIA)
+
+#if defined(OS_MACOSX)
+using MincoreVectorElement = char;
+#else
+using MincoreVectorElement = unsigned char;
+#endif  // defined(OS_MACOSX)
+
+// Returns the start of the first page and the size of the pages of the range.
+static std::pair<uintptr_t, size_t> GetPageRange(const void* address,
+                                                 size_t size) {
+  const uintptr_t page_size = GetMappingPageSize();
+  const uintptr_t start = reinterpret_cast<uintptr_t>(address);
+  const uintptr_t page_start = start & ~(page_size - 1);
+  const uintptr_t page_end = (start + size + page_size - 1) & ~(page_size - 1);
+  return {page_start, page_end - page_start};
+}
+
+#endif  // !defined(OS_FUCHSIA)
+
+bool PrefetchMappingPages(const void* address, size_t size) {
+#if defined(OS_FUCHSIA)
+  return false;
+#else
+  if (address == nullptr || size == 0) {
+    return false;
+  }
+  const auto [page_start, pages_size] = GetPageRange(address, size);
+  return ::madvise(reinterpret_cast<void*>(page_start), pages_size,
+                   MADV_WILLNEED) == 0;
+#endif  // defined(OS_FUCHSIA)
+}
+
+bool GetResidentMappingPages(const void* address,
+                             size_t size,
+                             std::vector<bool>* resident) {
+#if defined(OS_FUCHSIA)
+  return false;
+#else
+  if (address == nullptr || size == 0 || resident == nullptr) {
+    return false;
+  }
+  const auto [page_start, pages_size] = GetPageRange(address, size);
+  std::vector<MincoreVectorElement> pages(pages_size / GetMappingPageSize());
+  if (::mincore(reinterpret_cast<void*>(page_start), pages_size,
+                pages.data()) != 0) {
+    return false;
+  }
+  resident->resize(pages.size());
+  for (size_t i = 0; i < pages.size(); i++) {
+    (*resident)[i] = pages[i] & 1;
+  }
+  return true;
+#endif  // defined(OS_FUCHSIA)
+}
+
 }  // namespace fml
@@ -24,6 +24,14 @@ void SharedMutexPosix::LockShared() {
   pthread_rwlock_rdlock(&rwlock_);
 }
 
+bool SharedMutexPosix::TryLock() {
+  return pthread_rwlock_trywrlock(&rwlock_) == 0;
+}
+
+bool SharedMutexPosix::TryLockShared() {
+  return pthread_rwlock_tryrdlock(&rwlock_) == 0;
+}
+
 void SharedMutexPosix::Unlock() {
   pthread_rwlock_unlock(&rwlock_);
 }
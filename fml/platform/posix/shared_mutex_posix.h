@@ -15,6 +15,8 @@ class SharedMutexPosix : public SharedMutex {
  public:
   virtual void Lock();
   virtual void LockShared();
+  virtual bool TryLock();
+  virtual bool TryLockShared();
   virtual void Unlock();
   virtual void UnlockShared();
 
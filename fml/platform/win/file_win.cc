@@ -378,6 +378,12 @@ bool TruncateFile(const fml::UniqueFD& file, size_t size) {
   return true;
 }
 
+bool PrefetchFile(const fml::UniqueFD& file) {
+  // Windows prefetches mapped files with PrefetchVirtualMemory, which needs
+  // the mapping rather than the file.
+  return false;
+}
+
 bool FileExists(const fml::UniqueFD& base_directory, const char* path) {
   return GetFileAttributesForUtf8Path(base_directory, path) !=
          INVALID_FILE_ATTRIBUTES;
@@ -123,4 +123,20 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+size_t GetMappingPageSize() {
+  SYSTEM_INFO info = {};
+  ::GetSystemInfo(&info);
+  return info.dwPageSize;
+}
+
+bool PrefetchMappingPages(const void* address, size_t size) {
+  return false;
+}
+
+bool GetResidentMappingPages(const void* address,
+                             size_t size,
+                             std::vector<bool>* resident) {
+  return false;
+}
+
 }  // namespace fml
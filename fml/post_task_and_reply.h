@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_POST_TASK_AND_REPLY_H_
+#define FLUTTER_FML_POST_TASK_AND_REPLY_H_
+
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_runner.h"
+
+namespace fml {
+
+/// Runs \p task on \p task_runner and then \p reply on \p reply_runner, once
+/// \p task has returned. Neither of the threads blocks on the other, unlike
+/// when a latch is used to wait for the task.
+///
+/// \p task_runner may be any pointer to a \p BasicTaskRunner, like the
+/// \p ConcurrentTaskRunner of the worker pool. Both the task and the reply may
+/// capture move-only values.
+///
+/// EXAMPLE:
+///
+/// fml::PostTaskAndReply(
+///     io_runner, [image]() { UploadImage(image); },
+///     ui_runner, [callback]() { callback(); });
+template <typename TaskRunnerPtr, typename Task, typename Reply>
+void PostTaskAndReply(const TaskRunnerPtr& task_runner,
+                      Task task,
+                      fml::RefPtr<fml::TaskRunner> reply_runner,
+                      Reply reply) {
+  task_runner->PostTask(fml::MakeCopyable(
+      [task = std::move(task), reply_runner = std::move(reply_runner),
+       reply = std::move(reply)]() mutable {
+        task();
+        reply_runner->PostTask(fml::MakeCopyable(
+            [reply = std::move(reply)]() mutable { reply(); }));
+      }));
+}
+
+/// Like \p PostTaskAndReply, except that the value returned by \p task is
+/// moved into the argument of \p reply.
+///
+/// EXAMPLE:
+///
+/// fml::PostTaskAndReplyWithResult(
+///     worker_runner, [data]() { return DecodeImage(data); },
+///     ui_runner, [callback](sk_sp<SkImage> image) { callback(image); });
+template <typename TaskRunnerPtr, typename Task, typename Reply>
+void PostTaskAndReplyWithResult(const TaskRunnerPtr& task_runner,
+                                Task task,
+                                fml::RefPtr<fml::TaskRunner> reply_runner,
+                                Reply reply) {
+  using Result = std::invoke_result_t<Task&>;
+  static_assert(!std::is_void_v<Result>,
+                "Use PostTaskAndReply for tasks that don't return a value.");
+  task_runner->PostTask(fml::MakeCopyable(
+      [task = std::move(task), reply_runner = std::move(reply_runner),
+       reply = std::move(reply)]() mutable {
+        Result result = task();
+        reply_runner->PostTask(fml::MakeCopyable(
+            [reply = std::move(reply), result = std::move(result)]() mutable {
+              reply(std::move(result));
+            }));
+      }));
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_POST_TASK_AND_REPLY_H_
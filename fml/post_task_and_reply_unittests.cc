@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/post_task_and_reply.h"
+
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(PostTaskAndReply, RunsReplyOnReplyRunnerAfterTask) {
+  fml::Thread task_thread("task");
+  fml::Thread reply_thread("reply");
+  auto task_runner = task_thread.GetTaskRunner();
+  auto reply_runner = reply_thread.GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  bool task_ran = false;
+  fml::PostTaskAndReply(
+      task_runner,
+      [&]() {
+        EXPECT_TRUE(task_runner->RunsTasksOnCurrentThread());
+        task_ran = true;
+      },
+      reply_runner,
+      [&]() {
+        EXPECT_TRUE(reply_runner->RunsTasksOnCurrentThread());
+        EXPECT_TRUE(task_ran);
+        latch.Signal();
+      });
+  latch.Wait();
+}
+
+TEST(PostTaskAndReply, MovesResultIntoReply) {
+  fml::Thread task_thread("task");
+  fml::Thread reply_thread("reply");
+  auto reply_runner = reply_thread.GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  auto captured = std::make_unique<int>(41);
+  int reply_value = 0;
+  fml::PostTaskAndReplyWithResult(
+      task_thread.GetTaskRunner(),
+      [captured = std::move(captured)]() mutable {
+        *captured += 1;
+        return std::move(captured);
+      },
+      reply_runner,
+      [&](std::unique_ptr<int> result) {
+        EXPECT_TRUE(reply_runner->RunsTasksOnCurrentThread());
+        reply_value = *result;
+        latch.Signal();
+      });
+  latch.Wait();
+  ASSERT_EQ(reply_value, 42);
+}
+
+TEST(PostTaskAndReply, CanRunTaskOnConcurrentTaskRunner) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  fml::Thread reply_thread("reply");
+  fml::AutoResetWaitableEvent latch;
+  int reply_value = 0;
+  fml::PostTaskAndReplyWithResult(
+      loop->GetTaskRunner(), []() { return 7; }, reply_thread.GetTaskRunner(),
+      [&](int result) {
+        reply_value = result;
+        latch.Signal();
+      });
+  latch.Wait();
+  ASSERT_EQ(reply_value, 7);
+}
+
+}  // namespace testing
+}  // namespace fml
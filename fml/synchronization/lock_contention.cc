@@ -0,0 +1,200 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/lock_contention.h"
+
+#include <map>
+#include <memory>
+
+#include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+namespace {
+
+struct CounterRegistry {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<LockContentionCounter>, std::less<>>
+      counters;
+};
+
+// Leaked, the locks of static objects may still be used during exit.
+CounterRegistry& GetCounterRegistry() {
+  static CounterRegistry* registry = new CounterRegistry();
+  return *registry;
+}
+
+void UpdateMax(std::atomic<int64_t>& max, int64_t value) {
+  int64_t current = max.load(std::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(current, value,
+                                    std::memory_order_relaxed)) {
+  }
+}
+
+// Records the exclusive acquisitions of a |SharedMutex|. The shared ones are
+// counted but their hold time isn't, since they may be held by many threads
+// at once.
+class TrackedSharedMutex : public SharedMutex {
+ public:
+  TrackedSharedMutex(SharedMutex* mutex, LockContentionCounter* counter)
+      : mutex_(mutex), counter_(counter) {}
+
+  void Lock() override {
+    acquired_ = counter_->Acquire([this]() { return mutex_->TryLock(); },
+                                  [this]() { mutex_->Lock(); });
+  }
+
+  void LockShared() override {
+    counter_->Acquire([this]() { return mutex_->TryLockShared(); },
+                      [this]() { mutex_->LockShared(); });
+  }
+
+  bool TryLock() override {
+    if (!mutex_->TryLock()) {
+      counter_->RecordFailedAcquisition();
+      return false;
+    }
+    counter_->RecordUncontendedAcquisition();
+    acquired_ = fml::TimePoint::Now();
+    return true;
+  }
+
+  bool TryLockShared() override {
+    if (!mutex_->TryLockShared()) {
+      counter_->RecordFailedAcquisition();
+      return false;
+    }
+    counter_->RecordUncontendedAcquisition();
+    return true;
+  }
+
+  void Unlock() override {
+    counter_->RecordHold(fml::TimePoint::Now() - acquired_);
+    mutex_->Unlock();
+  }
+
+  void UnlockShared() override { mutex_->UnlockShared(); }
+
+ private:
+  std::unique_ptr<SharedMutex> mutex_;
+  LockContentionCounter* counter_;
+  fml::TimePoint acquired_;
+};
+
+}  // namespace
+
+LockContentionCounter* LockContentionCounter::ForName(std::string_view name) {
+  if (!IsEnabled()) {
+    return nullptr;
+  }
+  auto& registry = GetCounterRegistry();
+  std::scoped_lock lock(registry.mutex);
+  auto found = registry.counters.find(name);
+  if (found != registry.counters.end()) {
+    return found->second.get();
+  }
+  auto* counter = new LockContentionCounter(std::string(name));
+  registry.counters.emplace(counter->name(),
+                            std::unique_ptr<LockContentionCounter>(counter));
+  return counter;
+}
+
+std::vector<LockContentionStats> LockContentionCounter::GetAllStats() {
+  std::vector<LockContentionStats> stats;
+  auto& registry = GetCounterRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (const auto& counter : registry.counters) {
+    stats.push_back(counter.second->GetStats());
+  }
+  return stats;
+}
+
+LockContentionCounter::LockContentionCounter(std::string name)
+    : name_(std::move(name)) {}
+
+void LockContentionCounter::RecordUncontendedAcquisition() {
+  acquisitions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LockContentionCounter::RecordContendedAcquisition(
+    fml::TimePoint wait_start,
+    fml::TimePoint acquired) {
+  const int64_t wait_nanos = (acquired - wait_start).ToNanoseconds();
+  acquisitions_.fetch_add(1, std::memory_order_relaxed);
+  contentions_.fetch_add(1, std::memory_order_relaxed);
+  total_wait_nanos_.fetch_add(wait_nanos, std::memory_order_relaxed);
+  UpdateMax(max_wait_nanos_, wait_nanos);
+  fml::tracing::TraceEventAsyncComplete("fml", name_.c_str(), wait_start,
+                                        acquired);
+}
+
+void LockContentionCounter::RecordFailedAcquisition() {
+  contentions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LockContentionCounter::RecordHold(fml::TimeDelta hold_time) {
+  const int64_t hold_nanos = hold_time.ToNanoseconds();
+  total_hold_nanos_.fetch_add(hold_nanos, std::memory_order_relaxed);
+  UpdateMax(max_hold_nanos_, hold_nanos);
+}
+
+LockContentionStats LockContentionCounter::GetStats() const {
+  LockContentionStats stats;
+  stats.name = name_;
+  stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+  stats.contentions = contentions_.load(std::memory_order_relaxed);
+  stats.total_wait_time = fml::TimeDelta::FromNanoseconds(
+      total_wait_nanos_.load(std::memory_order_relaxed));
+  stats.max_wait_time = fml::TimeDelta::FromNanoseconds(
+      max_wait_nanos_.load(std::memory_order_relaxed));
+  stats.total_hold_time = fml::TimeDelta::FromNanoseconds(
+      total_hold_nanos_.load(std::memory_order_relaxed));
+  stats.max_hold_time = fml::TimeDelta::FromNanoseconds(
+      max_hold_nanos_.load(std::memory_order_relaxed));
+  return stats;
+}
+
+TrackedMutex::TrackedMutex(std::string_view name)
+    : counter_(LockContentionCounter::ForName(name)) {}
+
+void TrackedMutex::lock() {
+  if (!counter_) {
+    mutex_.lock();
+    return;
+  }
+  acquired_ = counter_->Acquire([this]() { return mutex_.try_lock(); },
+                                [this]() { mutex_.lock(); });
+}
+
+bool TrackedMutex::try_lock() {
+  if (!counter_) {
+    return mutex_.try_lock();
+  }
+  if (!mutex_.try_lock()) {
+    counter_->RecordFailedAcquisition();
+    return false;
+  }
+  counter_->RecordUncontendedAcquisition();
+  acquired_ = fml::TimePoint::Now();
+  return true;
+}
+
+void TrackedMutex::unlock() {
+  if (counter_) {
+    counter_->RecordHold(fml::TimePoint::Now() - acquired_);
+  }
+  mutex_.unlock();
+}
+
+SharedMutex* SharedMutex::Create(std::string_view name) {
+  LockContentionCounter* counter = LockContentionCounter::ForName(name);
+  if (!counter) {
+    return Create();
+  }
+  return new TrackedSharedMutex(Create(), counter);
+}
+
+}  // namespace fml
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SYNCHRONIZATION_LOCK_CONTENTION_H_
+#define FLUTTER_FML_SYNCHRONIZATION_LOCK_CONTENTION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+// Whether the named locks of fml record how contended they are. This is set
+// by the `flutter_enable_lock_contention_tracking` GN argument. The records
+// are kept in atomics that every acquisition writes to, so this is not meant
+// for the builds that are shipped.
+#ifndef FLUTTER_LOCK_CONTENTION_TRACKING
+#define FLUTTER_LOCK_CONTENTION_TRACKING 0
+#endif
+
+namespace fml {
+
+/// A snapshot of the contention of all of the locks with the same name.
+struct LockContentionStats {
+  std::string name;
+  /// The number of times that the locks were acquired.
+  uint64_t acquisitions = 0;
+  /// The number of times that the locks were already held when they were
+  /// first tried. For semaphores, this is the number of failed |TryWait|s.
+  uint64_t contentions = 0;
+  /// The time spent waiting for the locks that were contended.
+  fml::TimeDelta total_wait_time;
+  fml::TimeDelta max_wait_time;
+  /// The time that the locks were held exclusively for.
+  fml::TimeDelta total_hold_time;
+  fml::TimeDelta max_hold_time;
+};
+
+/// Records the acquisitions of all of the locks with the same name. The
+/// counters live as long as the process, so that the locks only have to keep
+/// a pointer to theirs.
+///
+/// The contended acquisitions are also added to the timeline as async events
+/// of the "fml" category that span the wait for the lock.
+class LockContentionCounter {
+ public:
+  /// Returns the counter for the locks called |name|, or null when
+  /// |FLUTTER_LOCK_CONTENTION_TRACKING| is disabled.
+  static LockContentionCounter* ForName(std::string_view name);
+
+  /// Returns the stats of all of the counters, sorted by name. This is empty
+  /// when |FLUTTER_LOCK_CONTENTION_TRACKING| is disabled.
+  static std::vector<LockContentionStats> GetAllStats();
+
+  static constexpr bool IsEnabled() { return FLUTTER_LOCK_CONTENTION_TRACKING; }
+
+  const std::string& name() const { return name_; }
+
+  void RecordUncontendedAcquisition();
+
+  void RecordContendedAcquisition(fml::TimePoint wait_start,
+                                  fml::TimePoint acquired);
+
+  /// Records a failed attempt to acquire a lock that isn't waited on.
+  void RecordFailedAcquisition();
+
+  void RecordHold(fml::TimeDelta hold_time);
+
+  LockContentionStats GetStats() const;
+
+  /// Tries to acquire a lock with |try_lock| and falls back to waiting for it
+  /// with |lock|, timing the wait. Returns the time that the lock was
+  /// acquired at.
+  template <typename TryLock, typename Lock>
+  fml::TimePoint Acquire(const TryLock& try_lock, const Lock& lock) {
+    if (try_lock()) {
+      RecordUncontendedAcquisition();
+      return fml::TimePoint::Now();
+    }
+    const auto wait_start = fml::TimePoint::Now();
+    lock();
+    const auto acquired = fml::TimePoint::Now();
+    RecordContendedAcquisition(wait_start, acquired);
+    return acquired;
+  }
+
+ private:
+  explicit LockContentionCounter(std::string name);
+
+  const std::string name_;
+  std::atomic<uint64_t> acquisitions_ = 0;
+  std::atomic<uint64_t> contentions_ = 0;
+  std::atomic<int64_t> total_wait_nanos_ = 0;
+  std::atomic<int64_t> max_wait_nanos_ = 0;
+  std::atomic<int64_t> total_hold_nanos_ = 0;
+  std::atomic<int64_t> max_hold_nanos_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LockContentionCounter);
+};
+
+/// A |std::mutex| whose contention is recorded under |name| when
+/// |FLUTTER_LOCK_CONTENTION_TRACKING| is enabled.
+class TrackedMutex {
+ public:
+  explicit TrackedMutex(std::string_view name);
+
+  void lock();
+
+  bool try_lock();
+
+  void unlock();
+
+ private:
+  std::mutex mutex_;
+  LockContentionCounter* counter_;
+  fml::TimePoint acquired_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TrackedMutex);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SYNCHRONIZATION_LOCK_CONTENTION_H_
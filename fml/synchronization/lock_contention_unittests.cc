@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/lock_contention.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "flutter/fml/synchronization/semaphore.h"
+#include "flutter/fml/synchronization/shared_mutex.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+static LockContentionStats GetStats(std::string_view name) {
+  for (const auto& stats : LockContentionCounter::GetAllStats()) {
+    if (stats.name == name) {
+      return stats;
+    }
+  }
+  return {};
+}
+
+TEST(LockContentionTest, TrackedLocksWorkWhetherOrNotTrackingIsEnabled) {
+  TrackedMutex mutex("LockContentionTest.Works.Mutex");
+  {
+    std::scoped_lock lock(mutex);
+    std::thread thread([&mutex]() { ASSERT_FALSE(mutex.try_lock()); });
+    thread.join();
+  }
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+
+  std::unique_ptr<SharedMutex> shared_mutex(
+      SharedMutex::Create("LockContentionTest.Works.SharedMutex"));
+  {
+    SharedLock lock(*shared_mutex);
+    ASSERT_TRUE(shared_mutex->TryLockShared());
+    shared_mutex->UnlockShared();
+  }
+  ASSERT_TRUE(shared_mutex->TryLock());
+  shared_mutex->Unlock();
+
+  ASSERT_EQ(LockContentionCounter::ForName("LockContentionTest.Works") !=
+                nullptr,
+            LockContentionCounter::IsEnabled());
+}
+
+TEST(LockContentionTest, CountersAreSharedByName) {
+  if (!LockContentionCounter::IsEnabled()) {
+    GTEST_SKIP() << "Lock contention tracking is disabled.";
+  }
+  auto* counter = LockContentionCounter::ForName("LockContentionTest.Shared");
+  ASSERT_EQ(counter,
+            LockContentionCounter::ForName("LockContentionTest.Shared"));
+  ASSERT_NE(counter, LockContentionCounter::ForName("LockContentionTest.Other"));
+  ASSERT_EQ(counter->name(), "LockContentionTest.Shared");
+}
+
+TEST(LockContentionTest, RecordsWaitsForContendedLocks) {
+  if (!LockContentionCounter::IsEnabled()) {
+    GTEST_SKIP() << "Lock contention tracking is disabled.";
+  }
+  auto* counter = LockContentionCounter::ForName("LockContentionTest.Waits");
+  counter->Acquire([]() { return true; }, []() {});
+  counter->Acquire([]() { return false; },
+                   []() {
+                     std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                   });
+
+  const auto stats = GetStats("LockContentionTest.Waits");
+  ASSERT_EQ(stats.acquisitions, 2u);
+  ASSERT_EQ(stats.contentions, 1u);
+  ASSERT_GE(stats.max_wait_time, fml::TimeDelta::FromMilliseconds(2));
+  ASSERT_EQ(stats.total_wait_time, stats.max_wait_time);
+}
+
+TEST(LockContentionTest, RecordsTrackedMutexContention) {
+  if (!LockContentionCounter::IsEnabled()) {
+    GTEST_SKIP() << "Lock contention tracking is disabled.";
+  }
+  TrackedMutex mutex("LockContentionTest.Mutex");
+  {
+    std::scoped_lock lock(mutex);
+    std::thread thread([&mutex]() { ASSERT_FALSE(mutex.try_lock()); });
+    thread.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const auto stats = GetStats("LockContentionTest.Mutex");
+  ASSERT_EQ(stats.acquisitions, 1u);
+  ASSERT_EQ(stats.contentions, 1u);
+  ASSERT_GE(stats.max_hold_time, fml::TimeDelta::FromMilliseconds(1));
+}
+
+TEST(LockContentionTest, RecordsSharedMutexContention) {
+  if (!LockContentionCounter::IsEnabled()) {
+    GTEST_SKIP() << "Lock contention tracking is disabled.";
+  }
+  std::unique_ptr<SharedMutex> mutex(
+      SharedMutex::Create("LockContentionTest.SharedMutex"));
+  {
+    SharedLock lock(*mutex);
+    ASSERT_FALSE(mutex->TryLock());
+  }
+  { UniqueLock lock(*mutex); }
+
+  const auto stats = GetStats("LockContentionTest.SharedMutex");
+  ASSERT_EQ(stats.acquisitions, 2u);
+  ASSERT_EQ(stats.contentions, 1u);
+}
+
+TEST(LockContentionTest, RecordsFailedSemaphoreWaits) {
+  if (!LockContentionCounter::IsEnabled()) {
+    GTEST_SKIP() << "Lock contention tracking is disabled.";
+  }
+  Semaphore semaphore(1, "LockContentionTest.Semaphore");
+  ASSERT_TRUE(semaphore.TryWait());
+  ASSERT_FALSE(semaphore.TryWait());
+  semaphore.Signal();
+
+  const auto stats = GetStats("LockContentionTest.Semaphore");
+  ASSERT_EQ(stats.acquisitions, 1u);
+  ASSERT_EQ(stats.contentions, 1u);
+}
+
+}  // namespace testing
+}  // namespace fml
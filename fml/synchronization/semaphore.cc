@@ -6,6 +6,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/lock_contention.h"
 
 #if OS_MACOSX
 #include <dispatch/dispatch.h>
@@ -148,6 +149,10 @@ namespace fml {
 
 Semaphore::Semaphore(uint32_t count) : _impl(new PlatformSemaphore(count)) {}
 
+Semaphore::Semaphore(uint32_t count, std::string_view name)
+    : _impl(new PlatformSemaphore(count)),
+      contention_counter_(LockContentionCounter::ForName(name)) {}
+
 Semaphore::~Semaphore() = default;
 
 bool Semaphore::IsValid() const {
@@ -155,7 +160,15 @@ bool Semaphore::IsValid() const {
 }
 
 bool Semaphore::TryWait() {
-  return _impl->TryWait();
+  const bool acquired = _impl->TryWait();
+  if (contention_counter_) {
+    if (acquired) {
+      contention_counter_->RecordUncontendedAcquisition();
+    } else {
+      contention_counter_->RecordFailedAcquisition();
+    }
+  }
+  return acquired;
 }
 
 void Semaphore::Signal() {
@@ -6,18 +6,24 @@
 #define FLUTTER_FML_SYNCHRONIZATION_SEMAPHORE_H_
 
 #include <memory>
+#include <string_view>
 
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/macros.h"
 
 namespace fml {
 
+class LockContentionCounter;
 class PlatformSemaphore;
 
 class Semaphore {
  public:
   explicit Semaphore(uint32_t count);
 
+  /// Creates a semaphore whose failed |TryWait|s are recorded as contentions
+  /// under |name| when |FLUTTER_LOCK_CONTENTION_TRACKING| is enabled.
+  Semaphore(uint32_t count, std::string_view name);
+
   ~Semaphore();
 
   bool IsValid() const;
@@ -28,6 +34,7 @@ class Semaphore {
 
  private:
   std::unique_ptr<PlatformSemaphore> _impl;
+  LockContentionCounter* contention_counter_ = nullptr;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Semaphore);
 };
@@ -5,16 +5,23 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_SHARED_MUTEX_H_
 #define FLUTTER_FML_SYNCHRONIZATION_SHARED_MUTEX_H_
 
+#include <string_view>
+
 namespace fml {
 
 // Interface for a reader/writer lock.
 class SharedMutex {
  public:
   static SharedMutex* Create();
+  // Creates a mutex whose contention is recorded under |name| when
+  // |FLUTTER_LOCK_CONTENTION_TRACKING| is enabled.
+  static SharedMutex* Create(std::string_view name);
   virtual ~SharedMutex() = default;
 
   virtual void Lock() = 0;
   virtual void LockShared() = 0;
+  virtual bool TryLock() = 0;
+  virtual bool TryLockShared() = 0;
   virtual void Unlock() = 0;
   virtual void UnlockShared() = 0;
 };
@@ -18,6 +18,14 @@ void SharedMutexStd::LockShared() {
   mutex_.lock_shared();
 }
 
+bool SharedMutexStd::TryLock() {
+  return mutex_.try_lock();
+}
+
+bool SharedMutexStd::TryLockShared() {
+  return mutex_.try_lock_shared();
+}
+
 void SharedMutexStd::Unlock() {
   mutex_.unlock();
 }
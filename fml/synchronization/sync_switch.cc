@@ -18,7 +18,7 @@ SyncSwitch::Handlers& SyncSwitch::Handlers::SetIfFalse(
   return *this;
 }
 
-SyncSwitch::SyncSwitch(bool value) : value_(value) {}
+SyncSwitch::SyncSwitch(bool value) : mutex_("SyncSwitch"), value_(value) {}
 
 void SyncSwitch::Execute(const SyncSwitch::Handlers& handlers) const {
   std::scoped_lock guard(mutex_);
@@ -7,9 +7,9 @@
 
 #include <forward_list>
 #include <functional>
-#include <mutex>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/lock_contention.h"
 
 namespace fml {
 
@@ -53,7 +53,7 @@ class SyncSwitch {
   void SetSwitch(bool value);
 
  private:
-  mutable std::mutex mutex_;
+  mutable TrackedMutex mutex_;
   bool value_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SyncSwitch);
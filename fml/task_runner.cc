@@ -21,15 +21,40 @@ TaskRunner::TaskRunner(fml::RefPtr<MessageLoopImpl> loop)
 
 TaskRunner::~TaskRunner() = default;
 
+void BasicTaskRunner::PostTasks(std::vector<fml::closure> tasks) {
+  for (const auto& task : tasks) {
+    PostTask(task);
+  }
+}
+
 void TaskRunner::PostTask(const fml::closure& task) {
   loop_->PostTask(task, fml::TimePoint::Now());
 }
 
+void TaskRunner::PostTasks(std::vector<fml::closure> tasks) {
+  // Subclasses without a message loop, like those of embedders, forward
+  // each task from their overrides of PostTask.
+  if (!loop_) {
+    BasicTaskRunner::PostTasks(std::move(tasks));
+    return;
+  }
+  loop_->PostTasks(std::move(tasks), fml::TimePoint::Now());
+}
+
 void TaskRunner::PostTaskForTime(const fml::closure& task,
                                  fml::TimePoint target_time) {
   loop_->PostTask(task, target_time);
 }
 
+void TaskRunner::PostUserInteractionTask(const fml::closure& task) {
+  if (!loop_) {
+    PostTask(task);
+    return;
+  }
+  loop_->PostTask(task, fml::TimePoint::Now(),
+                  fml::TaskSourceGrade::kUserInteraction);
+}
+
 void TaskRunner::PostDelayedTask(const fml::closure& task,
                                  fml::TimeDelta delay) {
   loop_->PostTask(task, fml::TimePoint::Now() + delay);
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FML_TASK_RUNNER_H_
 #define FLUTTER_FML_TASK_RUNNER_H_
 
+#include <vector>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
@@ -22,6 +24,11 @@ class BasicTaskRunner {
   /// Schedules \p task to be executed on the TaskRunner's associated event
   /// loop.
   virtual void PostTask(const fml::closure& task) = 0;
+
+  /// Schedules all of \p tasks to be executed in order. Runners that can
+  /// enqueue a batch of tasks at once, and wake up their event loop only once
+  /// for it, override this. The default posts each task on its own.
+  virtual void PostTasks(std::vector<fml::closure> tasks);
 };
 
 /// The object for scheduling tasks on a \p fml::MessageLoop.
@@ -38,9 +45,19 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
 
   virtual void PostTask(const fml::closure& task) override;
 
+  /// Enqueues \p tasks under a single acquisition of the lock of the task
+  /// queue and wakes the message loop once.
+  virtual void PostTasks(std::vector<fml::closure> tasks) override;
+
   virtual void PostTaskForTime(const fml::closure& task,
                                fml::TimePoint target_time);
 
+  /// Schedules \p task to run right away, ahead of the tasks without a \p
+  /// TaskSourceGrade that were posted before it. Used for the delivery of
+  /// input, which should not wait behind other work.
+  /// \note Subclasses without a message loop post it like any other task.
+  virtual void PostUserInteractionTask(const fml::closure& task);
+
   /// Schedules a task to be run on the MessageLoop after the time \p delay has
   /// passed.
   /// \note There is latency between when the task is schedule and actually
@@ -17,39 +17,39 @@ TaskSource::~TaskSource() {
 
 void TaskSource::ShutDown() {
   primary_task_queue_ = {};
+  user_interaction_task_queue_ = {};
   secondary_task_queue_ = {};
 }
 
-void TaskSource::RegisterTask(const DelayedTask& task) {
+void TaskSource::RegisterTask(DelayedTask task) {
   switch (task.GetTaskSourceGrade()) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
+      user_interaction_task_queue_.push(std::move(task));
       break;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
+      primary_task_queue_.push(std::move(task));
       break;
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.push(task);
+      secondary_task_queue_.push(std::move(task));
       break;
   }
 }
 
-void TaskSource::PopTask(TaskSourceGrade grade) {
+fml::closure TaskSource::PopTask(TaskSourceGrade grade) {
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
-      break;
+      return user_interaction_task_queue_.PopTask();
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.pop();
-      break;
+      return primary_task_queue_.PopTask();
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.pop();
-      break;
+      return secondary_task_queue_.PopTask();
   }
+  return nullptr;
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size =
+      primary_task_queue_.size() + user_interaction_task_queue_.size();
   if (secondary_pause_requests_ == 0) {
     size += secondary_task_queue_.size();
   }
@@ -62,33 +62,31 @@ bool TaskSource::IsEmpty() const {
 
 TaskSource::TopTask TaskSource::Top() const {
   FML_CHECK(!IsEmpty());
+  // The tasks of user interaction are posted to run right away, so they jump
+  // ahead of the primary tasks that were waiting before them.
+  const DelayedTask* primary_top = nullptr;
+  if (!user_interaction_task_queue_.empty()) {
+    primary_top = &user_interaction_task_queue_.top();
+  } else if (!primary_task_queue_.empty()) {
+    primary_top = &primary_task_queue_.top();
+  }
   if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
     return {
         .task_queue_id = task_queue_id_,
-        .task = primary_top,
+        .task = *primary_top,
     };
-  } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
+  }
+  const auto& secondary_top = secondary_task_queue_.top();
+  if (!primary_top || *primary_top > secondary_top) {
     return {
         .task_queue_id = task_queue_id_,
         .task = secondary_top,
     };
-  } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
-    if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
-    } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
-    }
   }
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *primary_top,
+  };
 }
 
 void TaskSource::PauseSecondary() {
@@ -18,7 +18,8 @@ class MessageLoopTaskQueues;
  * wrapper around a primary and secondary task heap with the difference between
  * them being that the secondary task heap can be paused and resumed by the task
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
- * to.
+ * to. The tasks of user interaction are kept in a heap of their own, which is
+ * drained before the primary heap.
  *
  * Registering Tasks
  * -----------------
@@ -49,10 +50,11 @@ class TaskSource {
 
   /// Adds a task to the corresponding task heap as dictated by the
   /// `TaskSourceGrade` of the `DelayedTask`.
-  void RegisterTask(const DelayedTask& task);
+  void RegisterTask(DelayedTask task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade` and returns the
+  /// closure of the popped task.
+  fml::closure PopTask(TaskSourceGrade grade);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
@@ -74,6 +76,7 @@ class TaskSource {
  private:
   const fml::TaskQueueId task_queue_id_;
   fml::DelayedTaskQueue primary_task_queue_;
+  fml::DelayedTaskQueue user_interaction_task_queue_;
   fml::DelayedTaskQueue secondary_task_queue_;
   int secondary_pause_requests_ = 0;
 
@@ -14,7 +14,8 @@ namespace fml {
  */
 enum class TaskSourceGrade {
   /// This `TaskSourceGrade` indicates that a task is critical to user
-  /// interaction.
+  /// interaction. These tasks run ahead of the `kUnspecified` tasks that were
+  /// posted before them, but not ahead of dart micro tasks.
   kUserInteraction,
   /// This `TaskSourceGrade` indicates that a task corresponds to servicing a
   /// dart micro task. These aren't critical to user interaction.
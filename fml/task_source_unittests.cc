@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_source.h"
@@ -50,6 +51,38 @@ TEST(TaskSourceTests, SimpleOrdering) {
   ASSERT_EQ(value, 7);
 }
 
+TEST(TaskSourceTests, TasksAreMovedThroughTheTaskSource) {
+  struct CopyCounter {
+    explicit CopyCounter(int* copies) : copies(copies) {}
+    CopyCounter(const CopyCounter& other) : copies(other.copies) {
+      (*copies)++;
+    }
+    CopyCounter(CopyCounter&& other) = default;
+    void operator()() const {}
+    int* copies;
+  };
+
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  int copies = 0;
+  const size_t kTaskCount = 10;
+  for (size_t i = 0; i < kTaskCount; i++) {
+    // Registered out of order so that the heap is reordered.
+    const int64_t delay = (i * 7) % kTaskCount;
+    task_source.RegisterTask(
+        {i, CopyCounter(&copies),
+         time_stamp + fml::TimeDelta::FromMilliseconds(delay),
+         TaskSourceGrade::kUnspecified});
+  }
+  for (size_t i = 0; i < kTaskCount; i++) {
+    fml::closure task = task_source.PopTask(TaskSourceGrade::kUnspecified);
+    ASSERT_TRUE(task);
+    task();
+  }
+  ASSERT_TRUE(task_source.IsEmpty());
+  ASSERT_EQ(copies, 0);
+}
+
 TEST(TaskSourceTests, SimpleOrderingMultiTaskHeaps) {
   TaskSource task_source = TaskSource(TaskQueueId(1));
   auto time_stamp = ChronoTicksSinceEpoch();
@@ -97,5 +130,26 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   ASSERT_EQ(value, 1);
 }
 
+TEST(TaskSourceTests, UserInteractionTasksJumpAheadOfPrimaryTasks) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  std::vector<int> order;
+  task_source.RegisterTask({1, [&] { order.push_back(1); }, time_stamp,
+                            TaskSourceGrade::kUnspecified});
+  task_source.RegisterTask({2, [&] { order.push_back(2); },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUserInteraction});
+  task_source.RegisterTask({3, [&] { order.push_back(3); },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(2),
+                            TaskSourceGrade::kUserInteraction});
+  ASSERT_EQ(task_source.GetNumPendingTasks(), 3u);
+  while (!task_source.IsEmpty()) {
+    auto top_task = task_source.Top();
+    top_task.task.GetTask()();
+    task_source.PopTask(top_task.task.GetTaskSourceGrade());
+  }
+  ASSERT_EQ(order, std::vector<int>({2, 3, 1}));
+}
+
 }  // namespace testing
 }  // namespace fml
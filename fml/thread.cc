@@ -23,11 +23,19 @@
 
 namespace fml {
 
-Thread::Thread(const std::string& name) : joined_(false) {
+Thread::Thread(const std::string& name)
+    : Thread(SetCurrentThreadConfig, ThreadConfig(name)) {}
+
+Thread::Thread(const ThreadConfigSetter& setter, const ThreadConfig& config)
+    : joined_(false) {
   fml::AutoResetWaitableEvent latch;
   fml::RefPtr<fml::TaskRunner> runner;
-  thread_ = std::make_unique<std::thread>([&latch, &runner, name]() -> void {
-    SetCurrentThreadName(name);
+  thread_ = std::make_unique<std::thread>([&latch, &runner, setter,
+                                           config]() -> void {
+    setter(config);
+    if (config.affinity.has_value()) {
+      RequestAffinity(config.affinity.value());
+    }
     fml::MessageLoop::EnsureInitializedForCurrentThread();
     auto& loop = MessageLoop::GetCurrent();
     runner = loop.GetTaskRunner();
@@ -67,6 +75,10 @@ typedef struct tagTHREADNAME_INFO {
 } THREADNAME_INFO;
 #endif
 
+void Thread::SetCurrentThreadConfig(const ThreadConfig& config) {
+  SetCurrentThreadName(config.name);
+}
+
 void Thread::SetCurrentThreadName(const std::string& name) {
   if (name == "") {
     return;
@@ -6,9 +6,13 @@
 #define FLUTTER_FML_THREAD_H_
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <thread>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -16,8 +20,42 @@ namespace fml {
 
 class Thread {
  public:
+  /// The relative importance of a thread. How it maps to the priorities of
+  /// the OS is up to the `ThreadConfigSetter` of the embedder.
+  enum class ThreadPriority {
+    /// Suitable for work the user doesn't wait on, like the IO thread.
+    kBackground,
+    /// The default priority of threads.
+    kNormal,
+    /// Suitable for the threads that produce frames, like the UI thread.
+    kDisplay,
+    /// Suitable for the thread that rasterizes and presents frames.
+    kRaster,
+  };
+
+  struct ThreadConfig {
+    ThreadConfig(const std::string& name = "",
+                 ThreadPriority priority = ThreadPriority::kNormal,
+                 std::optional<CpuAffinity> affinity = std::nullopt)
+        : name(name), priority(priority), affinity(affinity) {}
+
+    std::string name;
+    ThreadPriority priority;
+    /// The class of cores the thread is restricted to. Unset leaves the
+    /// thread free to run on any core.
+    std::optional<CpuAffinity> affinity;
+  };
+
+  /// Applies the name and priority of a `ThreadConfig` to the calling thread,
+  /// which is the new thread.
+  using ThreadConfigSetter = std::function<void(const ThreadConfig&)>;
+
   explicit Thread(const std::string& name = "");
 
+  /// Starts a thread that applies \p config with \p setter before it runs
+  /// its message loop. The affinity of \p config is requested after that.
+  Thread(const ThreadConfigSetter& setter, const ThreadConfig& config);
+
   ~Thread();
 
   fml::RefPtr<fml::TaskRunner> GetTaskRunner() const;
@@ -26,6 +64,10 @@ class Thread {
 
   static void SetCurrentThreadName(const std::string& name);
 
+  /// The default `ThreadConfigSetter`, which only sets the name of the
+  /// thread.
+  static void SetCurrentThreadConfig(const ThreadConfig& config);
+
  private:
   std::unique_ptr<std::thread> thread_;
   fml::RefPtr<fml::TaskRunner> task_runner_;
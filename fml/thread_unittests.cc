@@ -24,3 +24,17 @@ TEST(Thread, HasARunningMessageLoop) {
   thread.Join();
   ASSERT_TRUE(done);
 }
+
+TEST(Thread, AppliesConfigWithSetter) {
+  fml::Thread::ThreadConfig applied_config;
+  fml::Thread thread(
+      [&applied_config](const fml::Thread::ThreadConfig& config) {
+        applied_config = config;
+      },
+      fml::Thread::ThreadConfig("configured",
+                                fml::Thread::ThreadPriority::kDisplay));
+  // The config is applied before the task runner of the thread is published.
+  ASSERT_TRUE(thread.GetTaskRunner());
+  ASSERT_EQ(applied_config.name, "configured");
+  ASSERT_EQ(applied_config.priority, fml::Thread::ThreadPriority::kDisplay);
+}
@@ -6,6 +6,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <limits>
 #include <utility>
 
 #include "flutter/fml/ascii_trie.h"
@@ -15,6 +18,19 @@
 namespace fml {
 namespace tracing {
 
+TraceArgValue::TraceArgValue(int64_t value) : value_(buffer_) {
+  snprintf(buffer_, sizeof(buffer_), "%" PRId64, value);
+}
+
+TraceArgValue::TraceArgValue(uint64_t value) : value_(buffer_) {
+  snprintf(buffer_, sizeof(buffer_), "%" PRIu64, value);
+}
+
+TraceArgValue::TraceArgValue(double value) : value_(buffer_) {
+  snprintf(buffer_, sizeof(buffer_), "%.*g",
+           std::numeric_limits<double>::digits10, value);
+}
+
 #if FLUTTER_TIMELINE_ENABLED
 
 namespace {
@@ -48,6 +64,10 @@ size_t TraceNonce() {
   return ++gLastItem;
 }
 
+bool TraceEventEnabled(TraceArg name) {
+  return gTimelineEventHandler && gAllowlist.Query(name);
+}
+
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         int64_t timestamp_micros,
@@ -299,6 +319,10 @@ size_t TraceNonce() {
   return 0;
 }
 
+bool TraceEventEnabled(TraceArg name) {
+  return false;
+}
+
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         int64_t timestamp_micros,
@@ -219,6 +219,48 @@ SplitArguments(Key key, Value value, Args... args) {
 
 size_t TraceNonce();
 
+// Whether the events with the name are passed to the timeline, so that call
+// sites can skip computing the arguments of the events that would be dropped.
+bool TraceEventEnabled(TraceArg name);
+
+// A trace argument value. The timeline takes the values as strings, so
+// numbers and booleans are formatted in place, without a heap allocation.
+class TraceArgValue {
+ public:
+  explicit TraceArgValue(const char* value) : value_(value) {}
+
+  explicit TraceArgValue(bool value) : value_(value ? "true" : "false") {}
+
+  explicit TraceArgValue(int64_t value);
+
+  explicit TraceArgValue(uint64_t value);
+
+  explicit TraceArgValue(double value);
+
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  explicit TraceArgValue(T value)
+      : TraceArgValue(static_cast<Integer<T>>(value)) {}
+
+  const char* c_str() const { return value_; }
+
+ private:
+  template <typename T>
+  using Integer = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+
+  // Large enough for any 64-bit integer and any double.
+  char buffer_[32];
+  const char* value_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceArgValue);
+};
+
+// Whether a value can be passed to the typed overloads of the trace events,
+// which also take strings so that they can be mixed with typed values.
+template <typename T>
+constexpr bool kIsTraceArgValue =
+    std::is_arithmetic_v<T> || std::is_same_v<T, const char*> ||
+    std::is_same_v<T, char*>;
+
 template <typename... Args>
 void TraceCounter(TraceArg category,
                   TraceArg name,
@@ -262,6 +304,41 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg2_name,
                  TraceArg arg2_val);
 
+// Overloads for numeric and boolean argument values, which are only formatted
+// if the event is enabled.
+template <typename T1,
+          typename = std::enable_if_t<std::is_arithmetic_v<T1>>>
+void TraceEvent1(TraceArg category_group,
+                 TraceArg name,
+                 TraceArg arg1_name,
+                 T1 arg1_val) {
+#if FLUTTER_TIMELINE_ENABLED
+  if (TraceEventEnabled(name)) {
+    TraceEvent1(category_group, name, arg1_name,
+                TraceArgValue(arg1_val).c_str());
+  }
+#endif  // FLUTTER_TIMELINE_ENABLED
+}
+
+template <typename T1,
+          typename T2,
+          typename = std::enable_if_t<kIsTraceArgValue<T1> &&
+                                      kIsTraceArgValue<T2>>>
+void TraceEvent2(TraceArg category_group,
+                 TraceArg name,
+                 TraceArg arg1_name,
+                 T1 arg1_val,
+                 TraceArg arg2_name,
+                 T2 arg2_val) {
+#if FLUTTER_TIMELINE_ENABLED
+  if (TraceEventEnabled(name)) {
+    TraceEvent2(category_group, name, arg1_name,
+                TraceArgValue(arg1_val).c_str(), arg2_name,
+                TraceArgValue(arg2_val).c_str());
+  }
+#endif  // FLUTTER_TIMELINE_ENABLED
+}
+
 void TraceEventEnd(TraceArg name);
 
 template <typename... Args>
@@ -333,6 +410,39 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg2_name,
                         TraceArg arg2_val);
 
+template <typename T1,
+          typename = std::enable_if_t<std::is_arithmetic_v<T1>>>
+void TraceEventInstant1(TraceArg category_group,
+                        TraceArg name,
+                        TraceArg arg1_name,
+                        T1 arg1_val) {
+#if FLUTTER_TIMELINE_ENABLED
+  if (TraceEventEnabled(name)) {
+    TraceEventInstant1(category_group, name, arg1_name,
+                       TraceArgValue(arg1_val).c_str());
+  }
+#endif  // FLUTTER_TIMELINE_ENABLED
+}
+
+template <typename T1,
+          typename T2,
+          typename = std::enable_if_t<kIsTraceArgValue<T1> &&
+                                      kIsTraceArgValue<T2>>>
+void TraceEventInstant2(TraceArg category_group,
+                        TraceArg name,
+                        TraceArg arg1_name,
+                        T1 arg1_val,
+                        TraceArg arg2_name,
+                        T2 arg2_val) {
+#if FLUTTER_TIMELINE_ENABLED
+  if (TraceEventEnabled(name)) {
+    TraceEventInstant2(category_group, name, arg1_name,
+                       TraceArgValue(arg1_val).c_str(), arg2_name,
+                       TraceArgValue(arg2_val).c_str());
+  }
+#endif  // FLUTTER_TIMELINE_ENABLED
+}
+
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id);
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_flight_recorder.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+namespace tracing {
+
+FlightRecorder& FlightRecorder::GetInstance() {
+  // Leaked, so that the events can be recorded until the process exits.
+  static FlightRecorder* recorder = new FlightRecorder();
+  return *recorder;
+}
+
+FlightRecorder::FlightRecorder(size_t capacity)
+    : capacity_(capacity), slots_(new Slot[capacity]) {
+  FML_DCHECK(capacity_ > 0);
+}
+
+FlightRecorder::~FlightRecorder() = default;
+
+void FlightRecorder::Record(FlightRecorderEventType type, int64_t value) {
+  Record(type, value, TimePoint::Now());
+}
+
+void FlightRecorder::Record(FlightRecorderEventType type,
+                            int64_t value,
+                            TimePoint time) {
+  const uint64_t index = next_index_.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = slots_[index % capacity_];
+  // The slot is marked as being written before its previous event is
+  // overwritten, so that the readers drop it.
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.timestamp_micros.store(time.ToEpochDelta().ToMicroseconds(),
+                              std::memory_order_relaxed);
+  slot.value.store(value, std::memory_order_relaxed);
+  slot.type.store(static_cast<uint32_t>(type), std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+std::vector<FlightRecorderEvent> FlightRecorder::GetEvents(
+    TimeDelta duration,
+    TimePoint now) const {
+  const int64_t start_micros = (now - duration).ToEpochDelta().ToMicroseconds();
+  const uint64_t end_index = next_index_.load(std::memory_order_acquire);
+  const uint64_t start_index =
+      end_index > capacity_ ? end_index - capacity_ : 0;
+
+  std::vector<FlightRecorderEvent> events;
+  events.reserve(end_index - start_index);
+  for (uint64_t index = start_index; index < end_index; index++) {
+    const Slot& slot = slots_[index % capacity_];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != index + 1) {
+      // The event is still being written, or was already overwritten.
+      continue;
+    }
+    FlightRecorderEvent event;
+    event.timestamp_micros =
+        slot.timestamp_micros.load(std::memory_order_relaxed);
+    event.value = slot.value.load(std::memory_order_relaxed);
+    event.type = static_cast<FlightRecorderEventType>(
+        slot.type.load(std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    if (event.timestamp_micros >= start_micros) {
+      events.push_back(event);
+    }
+  }
+  // The threads may record their events slightly out of order.
+  std::stable_sort(events.begin(), events.end(),
+                   [](const FlightRecorderEvent& a,
+                      const FlightRecorderEvent& b) {
+                     return a.timestamp_micros < b.timestamp_micros;
+                   });
+  return events;
+}
+
+const char* FlightRecorder::GetEventTypeName(FlightRecorderEventType type) {
+  switch (type) {
+    case FlightRecorderEventType::kBuildStart:
+      return "buildStart";
+    case FlightRecorderEventType::kBuildEnd:
+      return "buildEnd";
+    case FlightRecorderEventType::kRasterStart:
+      return "rasterStart";
+    case FlightRecorderEventType::kRasterSubmit:
+      return "rasterSubmit";
+    case FlightRecorderEventType::kRasterEnd:
+      return "rasterEnd";
+    case FlightRecorderEventType::kIdleNotification:
+      return "idleNotification";
+    case FlightRecorderEventType::kPlatformMessage:
+      return "platformMessage";
+    case FlightRecorderEventType::kShaderCompile:
+      return "shaderCompile";
+  }
+  return "unknown";
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
+#define FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+/// The engine events that are kept by the flight recorder.
+enum class FlightRecorderEventType : uint32_t {
+  /// The animator started to build a frame. The value is the frame number.
+  kBuildStart,
+  /// The animator received the layer tree of a frame. The value is the frame
+  /// number.
+  kBuildEnd,
+  /// The rasterizer started to paint a frame. The value is the frame number.
+  kRasterStart,
+  /// The rasterizer painted a frame and is submitting it to the surface. The
+  /// value is the frame number.
+  kRasterSubmit,
+  /// The rasterizer submitted a frame. The value is the frame number.
+  kRasterEnd,
+  /// The engine notified the Dart VM that it is idle. The value is the time
+  /// left until the deadline, in microseconds.
+  kIdleNotification,
+  /// A platform message was dispatched to the framework. The value is the size
+  /// of its data.
+  kPlatformMessage,
+  /// Skia compiled a shader that wasn't in the persistent cache. The value is
+  /// the size of the compiled shader.
+  kShaderCompile,
+};
+
+constexpr size_t kFlightRecorderEventTypeCount = 8;
+
+struct FlightRecorderEvent {
+  int64_t timestamp_micros = 0;
+  FlightRecorderEventType type = FlightRecorderEventType::kBuildStart;
+  int64_t value = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the most recent engine events in a fixed size ring
+///             buffer, so that the engine-level trace that preceded a jank can
+///             be reported even when the timeline isn't recording.
+///
+///             Recording an event doesn't allocate nor take a lock, so the
+///             recorder is always enabled, including in release builds. The
+///             events can be recorded and read on any thread. An event that is
+///             overwritten while it is being read is dropped from the events
+///             that are returned.
+///
+class FlightRecorder {
+ public:
+  /// Enough for a few seconds of frames at 120Hz.
+  static constexpr size_t kDefaultCapacity = 8192;
+
+  /// The recorder that is shared by all the engines of the process.
+  static FlightRecorder& GetInstance();
+
+  explicit FlightRecorder(size_t capacity = kDefaultCapacity);
+
+  ~FlightRecorder();
+
+  void Record(FlightRecorderEventType type, int64_t value = 0);
+
+  void Record(FlightRecorderEventType type, int64_t value, TimePoint time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the events that were recorded within the given
+  ///             duration before `now`, oldest first.
+  ///
+  std::vector<FlightRecorderEvent> GetEvents(
+      TimeDelta duration,
+      TimePoint now = TimePoint::Now()) const;
+
+  /// The name of the event type in the reports, e.g. "rasterStart".
+  static const char* GetEventTypeName(FlightRecorderEventType type);
+
+ private:
+  // The sequence of a slot is the index of the event it holds plus one, or 0
+  // while the event is being written.
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<int64_t> timestamp_micros{0};
+    std::atomic<int64_t> value{0};
+    std::atomic<uint32_t> type{0};
+  };
+
+  const size_t capacity_;
+  const std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> next_index_{0};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FlightRecorder);
+};
+
+/// Records the event in the flight recorder of the process.
+inline void FlightRecord(FlightRecorderEventType type, int64_t value = 0) {
+  FlightRecorder::GetInstance().Record(type, value);
+}
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_flight_recorder.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace {
+
+TimePoint Millis(int64_t millis) {
+  return TimePoint::FromEpochDelta(TimeDelta::FromMilliseconds(millis));
+}
+
+TEST(FlightRecorderTest, ReturnsTheEventsOfTheDuration) {
+  FlightRecorder recorder;
+  recorder.Record(FlightRecorderEventType::kBuildStart, 1, Millis(1000));
+  recorder.Record(FlightRecorderEventType::kBuildEnd, 1, Millis(1010));
+  recorder.Record(FlightRecorderEventType::kRasterStart, 1, Millis(1020));
+  recorder.Record(FlightRecorderEventType::kShaderCompile, 512, Millis(1025));
+
+  auto events = recorder.GetEvents(TimeDelta::FromMilliseconds(15),
+                                   /*now=*/Millis(1030));
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, FlightRecorderEventType::kRasterStart);
+  EXPECT_EQ(events[0].timestamp_micros, 1020000);
+  EXPECT_EQ(events[1].type, FlightRecorderEventType::kShaderCompile);
+  EXPECT_EQ(events[1].value, 512);
+
+  events = recorder.GetEvents(TimeDelta::FromSeconds(10), Millis(1030));
+  EXPECT_EQ(events.size(), 4u);
+}
+
+TEST(FlightRecorderTest, OnlyKeepsTheMostRecentEvents) {
+  FlightRecorder recorder(/*capacity=*/3);
+  for (int64_t i = 0; i < 5; i++) {
+    recorder.Record(FlightRecorderEventType::kPlatformMessage, i,
+                    Millis(1000 + i));
+  }
+  auto events = recorder.GetEvents(TimeDelta::FromSeconds(10), Millis(1010));
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].value, 2);
+  EXPECT_EQ(events[1].value, 3);
+  EXPECT_EQ(events[2].value, 4);
+}
+
+TEST(FlightRecorderTest, SortsTheEventsOfTheThreads) {
+  FlightRecorder recorder;
+  recorder.Record(FlightRecorderEventType::kRasterEnd, 2, Millis(1002));
+  recorder.Record(FlightRecorderEventType::kBuildEnd, 1, Millis(1001));
+  auto events = recorder.GetEvents(TimeDelta::FromSeconds(10), Millis(1010));
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, FlightRecorderEventType::kBuildEnd);
+  EXPECT_EQ(events[1].type, FlightRecorderEventType::kRasterEnd);
+}
+
+TEST(FlightRecorderTest, CanRecordOnManyThreads) {
+  FlightRecorder recorder(/*capacity=*/64);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&recorder, i]() {
+      for (int j = 0; j < 1000; j++) {
+        recorder.Record(FlightRecorderEventType::kIdleNotification, i);
+      }
+    });
+  }
+  for (int i = 0; i < 100; i++) {
+    for (const auto& event : recorder.GetEvents(TimeDelta::FromSeconds(10))) {
+      EXPECT_EQ(event.type, FlightRecorderEventType::kIdleNotification);
+      EXPECT_GE(event.value, 0);
+      EXPECT_LT(event.value, 4);
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(recorder.GetEvents(TimeDelta::FromSeconds(10)).size(), 64u);
+}
+
+TEST(FlightRecorderTest, NamesTheEventTypes) {
+  EXPECT_STREQ(
+      FlightRecorder::GetEventTypeName(FlightRecorderEventType::kRasterSubmit),
+      "rasterSubmit");
+  EXPECT_STREQ(FlightRecorder::GetEventTypeName(
+                   FlightRecorderEventType::kIdleNotification),
+               "idleNotification");
+}
+
+}  // namespace
+}  // namespace tracing
+}  // namespace fml
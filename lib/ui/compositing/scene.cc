@@ -29,19 +29,24 @@ DART_BIND_ALL(Scene, FOR_EACH_BINDING)
 
 void Scene::create(Dart_Handle scene_handle,
                    std::shared_ptr<flutter::Layer> rootLayer,
+                   std::unordered_set<uint64_t> reusedLayers,
                    uint32_t rasterizerTracingThreshold,
                    bool checkerboardRasterCacheImages,
-                   bool checkerboardOffscreenLayers) {
+                   bool checkerboardOffscreenLayers,
+                   std::shared_ptr<LayerCommandBuffer> layerCommands) {
   auto scene = fml::MakeRefCounted<Scene>(
-      std::move(rootLayer), rasterizerTracingThreshold,
-      checkerboardRasterCacheImages, checkerboardOffscreenLayers);
+      std::move(rootLayer), std::move(reusedLayers), rasterizerTracingThreshold,
+      checkerboardRasterCacheImages, checkerboardOffscreenLayers,
+      std::move(layerCommands));
   scene->AssociateWithDartWrapper(scene_handle);
 }
 
 Scene::Scene(std::shared_ptr<flutter::Layer> rootLayer,
+             std::unordered_set<uint64_t> reusedLayers,
              uint32_t rasterizerTracingThreshold,
              bool checkerboardRasterCacheImages,
-             bool checkerboardOffscreenLayers) {
+             bool checkerboardOffscreenLayers,
+             std::shared_ptr<LayerCommandBuffer> layerCommands) {
   // Currently only supports a single window.
   auto viewport_metrics = UIDartState::Current()
                               ->platform_configuration()
@@ -53,6 +58,8 @@ Scene::Scene(std::shared_ptr<flutter::Layer> rootLayer,
                     viewport_metrics.physical_height),
       static_cast<float>(viewport_metrics.device_pixel_ratio));
   layer_tree_->set_root_layer(std::move(rootLayer));
+  layer_tree_->set_layer_commands(std::move(layerCommands));
+  layer_tree_->set_reused_layers(std::move(reusedLayers));
   layer_tree_->set_rasterizer_tracing_threshold(rasterizerTracingThreshold);
   layer_tree_->set_checkerboard_raster_cache_images(
       checkerboardRasterCacheImages);
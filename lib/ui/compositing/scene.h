@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <unordered_set>
 
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/lib/ui/dart_wrapper.h"
@@ -26,9 +27,11 @@ class Scene : public RefCountedDartWrappable<Scene> {
   ~Scene() override;
   static void create(Dart_Handle scene_handle,
                      std::shared_ptr<flutter::Layer> rootLayer,
+                     std::unordered_set<uint64_t> reusedLayers,
                      uint32_t rasterizerTracingThreshold,
                      bool checkerboardRasterCacheImages,
-                     bool checkerboardOffscreenLayers);
+                     bool checkerboardOffscreenLayers,
+                     std::shared_ptr<LayerCommandBuffer> layerCommands);
 
   std::unique_ptr<flutter::LayerTree> takeLayerTree();
 
@@ -42,9 +45,11 @@ class Scene : public RefCountedDartWrappable<Scene> {
 
  private:
   explicit Scene(std::shared_ptr<flutter::Layer> rootLayer,
+                 std::unordered_set<uint64_t> reusedLayers,
                  uint32_t rasterizerTracingThreshold,
                  bool checkerboardRasterCacheImages,
-                 bool checkerboardOffscreenLayers);
+                 bool checkerboardOffscreenLayers,
+                 std::shared_ptr<LayerCommandBuffer> layerCommands);
 
   std::unique_ptr<flutter::LayerTree> layer_tree_;
 };
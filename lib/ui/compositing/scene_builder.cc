@@ -71,10 +71,58 @@ void SceneBuilder::RegisterNatives(tonic::DartLibraryNatives* natives) {
        FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
+// Links the |layer| to the layer of the previous frame that it replaces, for
+// diffing. The engine may build different types of layers for the same call
+// from one frame to the next, and layers can only be diffed against layers of
+// the same type.
+static void AssignOldLayerOfSameType(flutter::Layer* layer,
+                                     const fml::RefPtr<EngineLayer>& oldLayer) {
+  if (!oldLayer || !oldLayer->Layer()) {
+    return;
+  }
+  const flutter::Layer* old_layer = oldLayer->Layer().get();
+  // The types of layers that one call may build.
+  bool same_type =
+      !layer->as_transform_layer() == !old_layer->as_transform_layer() &&
+      !layer->as_opacity_layer() == !old_layer->as_opacity_layer() &&
+      !layer->as_clip_rect_layer() == !old_layer->as_clip_rect_layer() &&
+      !layer->as_clip_rrect_layer() == !old_layer->as_clip_rrect_layer() &&
+      !layer->as_clip_path_layer() == !old_layer->as_clip_path_layer();
+  if (same_type) {
+    layer->AssignOldLayer(oldLayer->Layer().get());
+  }
+}
+
+fml::RefPtr<SceneBuilder> SceneBuilder::create() {
+  fml::RefPtr<SceneBuilder> builder =
+      UIDartState::Current()->GetSceneBuilderPool().Take();
+  if (builder) {
+    builder->Reset();
+    return builder;
+  }
+  return fml::MakeRefCounted<SceneBuilder>();
+}
+
 SceneBuilder::SceneBuilder() {
+  Reset();
+}
+
+void SceneBuilder::Reset() {
+  FML_DCHECK(layer_stack_.empty());
+  FML_DCHECK(retained_layers_.empty());
+  rasterizer_tracing_threshold_ = 0;
+  checkerboard_raster_cache_images_ = false;
+  checkerboard_offscreen_layers_ = false;
   // Add a ContainerLayer as the root layer, so that AddLayer operations are
   // always valid.
-  PushLayer(std::make_shared<flutter::ContainerLayer>());
+  auto root = std::make_shared<flutter::ContainerLayer>();
+  if (UIDartState::Current()->defer_layer_tree_construction()) {
+    commands_ = std::make_shared<LayerCommandBuffer>(root);
+    layer_stack_.push_back(std::move(root));
+  } else {
+    commands_ = nullptr;
+    PushLayer(std::move(root));
+  }
 }
 
 SceneBuilder::~SceneBuilder() = default;
@@ -83,11 +131,12 @@ void SceneBuilder::pushTransform(Dart_Handle layer_handle,
                                  tonic::Float64List& matrix4,
                                  fml::RefPtr<EngineLayer> oldLayer) {
   SkMatrix sk_matrix = ToSkMatrix(matrix4);
+  // The flattening in |build| removes identity transforms with one child.
   auto layer = std::make_shared<flutter::TransformLayer>(sk_matrix);
   PushLayer(layer);
   // matrix4 has to be released before we can return another Dart object
   matrix4.Release();
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -101,7 +150,7 @@ void SceneBuilder::pushOffset(Dart_Handle layer_handle,
   SkMatrix sk_matrix = SkMatrix::Translate(dx, dy);
   auto layer = std::make_shared<flutter::TransformLayer>(sk_matrix);
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -120,7 +169,7 @@ void SceneBuilder::pushClipRect(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ClipRectLayer>(clipRect, clip_behavior);
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -135,7 +184,7 @@ void SceneBuilder::pushClipRRect(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ClipRRectLayer>(rrect.sk_rrect, clip_behavior);
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -148,14 +197,28 @@ void SceneBuilder::pushClipPath(Dart_Handle layer_handle,
                                 fml::RefPtr<EngineLayer> oldLayer) {
   flutter::Clip clip_behavior = static_cast<flutter::Clip>(clipBehavior);
   FML_DCHECK(clip_behavior != flutter::Clip::none);
-  auto layer =
-      std::make_shared<flutter::ClipPathLayer>(path->path(), clip_behavior);
+  const SkPath& sk_path = path->GetPathForDrawing();
+  // Rect and rounded rect clips are much cheaper to apply than path clips, so
+  // lower the simple paths the framework hands us to the matching layer.
+  std::shared_ptr<flutter::ContainerLayer> layer;
+  SkRect rect;
+  SkRRect rrect;
+  if (sk_path.isInverseFillType()) {
+    layer = std::make_shared<flutter::ClipPathLayer>(sk_path, clip_behavior);
+  } else if (sk_path.isRect(&rect)) {
+    layer = std::make_shared<flutter::ClipRectLayer>(rect, clip_behavior);
+  } else if (sk_path.isOval(&rect)) {
+    rrect.setOval(rect);
+    layer = std::make_shared<flutter::ClipRRectLayer>(rrect, clip_behavior);
+  } else if (sk_path.isRRect(&rrect)) {
+    layer = std::make_shared<flutter::ClipRRectLayer>(rrect, clip_behavior);
+  } else {
+    layer = std::make_shared<flutter::ClipPathLayer>(sk_path, clip_behavior);
+  }
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayerOfSameType(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
@@ -163,14 +226,20 @@ void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
                                double dx,
                                double dy,
                                fml::RefPtr<EngineLayer> oldLayer) {
-  auto layer =
-      std::make_shared<flutter::OpacityLayer>(alpha, SkPoint::Make(dx, dy));
+  // A fully opaque layer draws its children unchanged, so it only needs
+  // the save layer when it is translucent.
+  std::shared_ptr<flutter::ContainerLayer> layer;
+  if (alpha < SK_AlphaOPAQUE) {
+    layer =
+        std::make_shared<flutter::OpacityLayer>(alpha, SkPoint::Make(dx, dy));
+  } else {
+    layer = std::make_shared<flutter::TransformLayer>(
+        SkMatrix::Translate(dx, dy));
+  }
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayerOfSameType(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
@@ -179,7 +248,7 @@ void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ColorFilterLayer>(color_filter->filter());
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -192,7 +261,7 @@ void SceneBuilder::pushImageFilter(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ImageFilterLayer>(image_filter->filter());
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -205,8 +274,11 @@ void SceneBuilder::pushBackdropFilter(Dart_Handle layer_handle,
                                       fml::RefPtr<EngineLayer> oldLayer) {
   auto layer = std::make_shared<flutter::BackdropFilterLayer>(
       filter->filter(), static_cast<SkBlendMode>(blendMode));
+  if (filter->blur_sigma()) {
+    layer->set_blur(*filter->blur_sigma(), filter->blur_tile_mode());
+  }
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -228,7 +300,7 @@ void SceneBuilder::pushShaderMask(Dart_Handle layer_handle,
   auto layer = std::make_shared<flutter::ShaderMaskLayer>(
       shader->shader(sampling), rect, static_cast<SkBlendMode>(blendMode));
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -244,10 +316,10 @@ void SceneBuilder::pushPhysicalShape(Dart_Handle layer_handle,
                                      fml::RefPtr<EngineLayer> oldLayer) {
   auto layer = std::make_shared<flutter::PhysicalShapeLayer>(
       static_cast<SkColor>(color), static_cast<SkColor>(shadow_color),
-      static_cast<float>(elevation), path->path(),
+      static_cast<float>(elevation), path->GetPathForDrawing(),
       static_cast<flutter::Clip>(clipBehavior));
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  EngineLayer::MakeRetained(layer_handle, layer, commands_);
 
   if (oldLayer && oldLayer->Layer()) {
     layer->AssignOldLayer(oldLayer->Layer().get());
@@ -255,6 +327,11 @@ void SceneBuilder::pushPhysicalShape(Dart_Handle layer_handle,
 }
 
 void SceneBuilder::addRetained(fml::RefPtr<EngineLayer> retainedLayer) {
+  retained_layers_.insert(retainedLayer->Layer().get());
+  if (commands_) {
+    commands_->AddRetained(retainedLayer->Layer(), retainedLayer->commands());
+    return;
+  }
   AddLayer(retainedLayer->Layer());
 }
 
@@ -266,6 +343,19 @@ void SceneBuilder::addPicture(double dx,
                               double dy,
                               Picture* picture,
                               int hints) {
+  if (commands_) {
+    SkPoint offset = SkPoint::Make(dx, dy);
+    if (picture->picture()) {
+      commands_->AddPicture(offset,
+                            UIDartState::CreateGPUObject(picture->picture()),
+                            !!(hints & 1), !!(hints & 2));
+    } else {
+      commands_->AddDisplayList(
+          offset, UIDartState::CreateGPUObject(picture->display_list()),
+          !!(hints & 1), !!(hints & 2));
+    }
+    return;
+  }
   if (picture->picture()) {
     auto layer = std::make_unique<flutter::PictureLayer>(
         SkPoint::Make(dx, dy), UIDartState::CreateGPUObject(picture->picture()),
@@ -288,6 +378,11 @@ void SceneBuilder::addTexture(double dx,
                               bool freeze,
                               int filterQualityIndex) {
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
+  if (commands_) {
+    commands_->AddTexture(SkPoint::Make(dx, dy), SkSize::Make(width, height),
+                          textureId, freeze, sampling);
+    return;
+  }
   auto layer = std::make_unique<flutter::TextureLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), textureId, freeze,
       sampling);
@@ -299,6 +394,11 @@ void SceneBuilder::addPlatformView(double dx,
                                    double width,
                                    double height,
                                    int64_t viewId) {
+  if (commands_) {
+    commands_->AddPlatformView(SkPoint::Make(dx, dy),
+                               SkSize::Make(width, height), viewId);
+    return;
+  }
   auto layer = std::make_unique<flutter::PlatformViewLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), viewId);
   AddLayer(std::move(layer));
@@ -310,6 +410,10 @@ void SceneBuilder::addPerformanceOverlay(uint64_t enabledOptions,
                                          double top,
                                          double bottom) {
   SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
+  if (commands_) {
+    commands_->AddPerformanceOverlay(enabledOptions, rect);
+    return;
+  }
   auto layer =
       std::make_unique<flutter::PerformanceOverlayLayer>(enabledOptions);
   layer->set_paint_bounds(rect);
@@ -331,11 +435,31 @@ void SceneBuilder::setCheckerboardOffscreenLayers(bool checkerboard) {
 void SceneBuilder::build(Dart_Handle scene_handle) {
   FML_DCHECK(layer_stack_.size() >= 1);
 
-  Scene::create(
-      scene_handle, std::move(layer_stack_[0]), rasterizer_tracing_threshold_,
-      checkerboard_raster_cache_images_, checkerboard_offscreen_layers_);
+  // Retained layers may also be part of the layer tree of a previous frame
+  // that the raster thread is still drawing, so only the layers built by
+  // this SceneBuilder are flattened. With deferred layer tree construction
+  // the command buffer flattens the tree once it is built.
+  if (!commands_) {
+    layer_stack_[0]->Flatten([this](const flutter::Layer* layer) {
+      return retained_layers_.count(layer) > 0;
+    });
+  }
+
+  std::unordered_set<uint64_t> reused_layers;
+  for (const Layer* layer : retained_layers_) {
+    reused_layers.insert(layer->unique_id());
+  }
+
+  Scene::create(scene_handle, std::move(layer_stack_[0]),
+                std::move(reused_layers), rasterizer_tracing_threshold_,
+                checkerboard_raster_cache_images_,
+                checkerboard_offscreen_layers_, std::move(commands_));
+  // Clearing keeps the storage of the containers for the next scene that a
+  // recycled builder builds.
   layer_stack_.clear();
-  ClearDartWrapper();  // may delete this object.
+  retained_layers_.clear();
+  UIDartState::Current()->GetSceneBuilderPool().Recycle(fml::Ref(this));
+  ClearDartWrapper();
 }
 
 void SceneBuilder::AddLayer(std::shared_ptr<Layer> layer) {
@@ -347,7 +471,11 @@ void SceneBuilder::AddLayer(std::shared_ptr<Layer> layer) {
 }
 
 void SceneBuilder::PushLayer(std::shared_ptr<ContainerLayer> layer) {
-  AddLayer(layer);
+  if (commands_) {
+    commands_->Push(layer);
+  } else {
+    AddLayer(layer);
+  }
   layer_stack_.push_back(std::move(layer));
 }
 
@@ -355,6 +483,9 @@ void SceneBuilder::PopLayer() {
   // We never pop the root layer, so that AddLayer operations are always valid.
   if (layer_stack_.size() > 1) {
     layer_stack_.pop_back();
+    if (commands_) {
+      commands_->Pop();
+    }
   }
 }
 
@@ -7,9 +7,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_command_buffer.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/color_filter.h"
@@ -28,9 +30,7 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
   FML_FRIEND_MAKE_REF_COUNTED(SceneBuilder);
 
  public:
-  static fml::RefPtr<SceneBuilder> create() {
-    return fml::MakeRefCounted<SceneBuilder>();
-  }
+  static fml::RefPtr<SceneBuilder> create();
   ~SceneBuilder() override;
 
   void pushTransform(Dart_Handle layer_handle,
@@ -128,11 +128,20 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
  private:
   SceneBuilder();
 
+  // Returns a recycled scene builder to the state of a new one.
+  void Reset();
+
   void AddLayer(std::shared_ptr<Layer> layer);
   void PushLayer(std::shared_ptr<ContainerLayer> layer);
   void PopLayer();
 
   std::vector<std::shared_ptr<ContainerLayer>> layer_stack_;
+  // The layers added with addRetained, which are left out of the flattening
+  // of the layer tree in |build|.
+  std::unordered_set<const Layer*> retained_layers_;
+  // Records the layers of the scene instead of linking them, when the layer
+  // tree is built on the raster thread.
+  std::shared_ptr<LayerCommandBuffer> commands_;
   int rasterizer_tracing_threshold_ = 0;
   bool checkerboard_raster_cache_images_ = false;
   bool checkerboard_offscreen_layers_ = false;
@@ -154,5 +154,57 @@ TEST_F(ShellTest, EngineLayerDisposeReleasesReference) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, PushClipPathLowersSimplePaths) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+
+  auto validate_clip_path_lowering = [](Dart_NativeArguments args) {
+    auto handle = Dart_GetNativeArgument(args, 0);
+    intptr_t peer = 0;
+    Dart_Handle result = Dart_GetNativeInstanceField(
+        handle, tonic::DartWrappable::kPeerIndex, &peer);
+    ASSERT_FALSE(Dart_IsError(result));
+    SceneBuilder* scene_builder = reinterpret_cast<SceneBuilder*>(peer);
+    ASSERT_TRUE(scene_builder);
+    // The root layer and one layer per pushClipPath call: a rect, an oval, a
+    // rounded rect and a triangle.
+    const auto& layer_stack = scene_builder->layer_stack();
+    ASSERT_EQ(layer_stack.size(), 5ul);
+    EXPECT_STREQ(layer_stack[1]->type_name(), "ClipRectLayer");
+    EXPECT_STREQ(layer_stack[2]->type_name(), "ClipRRectLayer");
+    EXPECT_STREQ(layer_stack[3]->type_name(), "ClipRRectLayer");
+    EXPECT_STREQ(layer_stack[4]->type_name(), "ClipPathLayer");
+  };
+
+  auto finish = [message_latch](Dart_NativeArguments args) {
+    message_latch->Signal();
+  };
+
+  Settings settings = CreateSettingsForFixture();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("ValidateClipPathLowering",
+                    CREATE_NATIVE_ENTRY(validate_clip_path_lowering));
+  AddNativeCallback("Finish", CREATE_NATIVE_ENTRY(finish));
+
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("validatePushClipPathLowering");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -20,6 +20,7 @@
 #include "flutter/lib/ui/painting/image_filter.h"
 #include "flutter/lib/ui/painting/image_shader.h"
 #include "flutter/lib/ui/painting/immutable_buffer.h"
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
 #include "flutter/lib/ui/painting/path.h"
 #include "flutter/lib/ui/painting/path_measure.h"
 #include "flutter/lib/ui/painting/picture.h"
@@ -52,6 +53,10 @@ const uint8_t* GetSymbol(Dart_NativeFunction native_function) {
   return g_natives->GetSymbol(native_function);
 }
 
+void* ResolveFfiNativeFunction(const char* name, uintptr_t argument_count) {
+  return g_natives->GetFfiNativeFunction(name, argument_count);
+}
+
 }  // namespace
 
 void DartUI::InitForGlobal() {
@@ -72,6 +77,7 @@ void DartUI::InitForGlobal() {
     ImageFilter::RegisterNatives(g_natives);
     ImageShader::RegisterNatives(g_natives);
     ImmutableBuffer::RegisterNatives(g_natives);
+    IncrementalImageDecoder::RegisterNatives(g_natives);
     IsolateNameServerNatives::RegisterNatives(g_natives);
     NativeStringAttribute::RegisterNatives(g_natives);
     Paragraph::RegisterNatives(g_natives);
@@ -89,8 +95,13 @@ void DartUI::InitForGlobal() {
 
 void DartUI::InitForIsolate() {
   FML_DCHECK(g_natives);
-  Dart_Handle result = Dart_SetNativeResolver(
-      Dart_LookupLibrary(ToDart("dart:ui")), GetNativeFunction, GetSymbol);
+  Dart_Handle library = Dart_LookupLibrary(ToDart("dart:ui"));
+  Dart_Handle result =
+      Dart_SetNativeResolver(library, GetNativeFunction, GetSymbol);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  result = Dart_SetFfiNativeResolver(library, ResolveFfiNativeFunction);
   if (Dart_IsError(result)) {
     Dart_PropagateError(result);
   }
@@ -43,6 +43,24 @@ _captureRootLayer(SceneBuilder sceneBuilder) native 'CaptureRootLayer';
 _validateLayerTreeCounts() native 'ValidateLayerTreeCounts';
 _validateEngineLayerDispose() native 'ValidateEngineLayerDispose';
 
+@pragma('vm:entry-point')
+void validatePushClipPathLowering() {
+  final SceneBuilder builder = SceneBuilder();
+  const Rect rect = Rect.fromLTWH(10, 10, 100, 100);
+  builder.pushClipPath(Path()..addRect(rect));
+  builder.pushClipPath(Path()..addOval(rect));
+  builder.pushClipPath(Path()..addRRect(RRect.fromRectAndRadius(rect, const Radius.circular(10))));
+  builder.pushClipPath(Path()
+    ..moveTo(10, 10)
+    ..lineTo(110, 10)
+    ..lineTo(60, 110)
+    ..close());
+  _validateClipPathLowering(builder);
+  builder.build().dispose();
+  _finish();
+}
+_validateClipPathLowering(SceneBuilder builder) native 'ValidateClipPathLowering';
+
 @pragma('vm:entry-point')
 Future<void> createSingleFrameCodec() async {
   final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(Uint8List.fromList(List<int>.filled(4, 100)));
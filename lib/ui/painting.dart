@@ -2309,51 +2309,62 @@ class Path extends NativeFieldWrapperClass1 {
   PathFillType get fillType => PathFillType.values[_getFillType()];
   set fillType(PathFillType value) => _setFillType(value.index);
 
-  int _getFillType() native 'Path_getFillType';
-  void _setFillType(int fillType) native 'Path_setFillType';
+  @FfiNative<Int32 Function(Pointer<Void>)>('Path::getFillType', isLeaf: true)
+  external int _getFillType();
+  @FfiNative<Void Function(Pointer<Void>, Int32)>('Path::setFillType', isLeaf: true)
+  external void _setFillType(int fillType);
 
   /// Starts a new sub-path at the given coordinate.
-  void moveTo(double x, double y) native 'Path_moveTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::moveTo', isLeaf: true)
+  external void moveTo(double x, double y);
 
   /// Starts a new sub-path at the given offset from the current point.
-  void relativeMoveTo(double dx, double dy) native 'Path_relativeMoveTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::relativeMoveTo', isLeaf: true)
+  external void relativeMoveTo(double dx, double dy);
 
   /// Adds a straight line segment from the current point to the given
   /// point.
-  void lineTo(double x, double y) native 'Path_lineTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::lineTo', isLeaf: true)
+  external void lineTo(double x, double y);
 
   /// Adds a straight line segment from the current point to the point
   /// at the given offset from the current point.
-  void relativeLineTo(double dx, double dy) native 'Path_relativeLineTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::relativeLineTo', isLeaf: true)
+  external void relativeLineTo(double dx, double dy);
 
   /// Adds a quadratic bezier segment that curves from the current
   /// point to the given point (x2,y2), using the control point
   /// (x1,y1).
-  void quadraticBezierTo(double x1, double y1, double x2, double y2) native 'Path_quadraticBezierTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::quadraticBezierTo', isLeaf: true)
+  external void quadraticBezierTo(double x1, double y1, double x2, double y2);
 
   /// Adds a quadratic bezier segment that curves from the current
   /// point to the point at the offset (x2,y2) from the current point,
   /// using the control point at the offset (x1,y1) from the current
   /// point.
-  void relativeQuadraticBezierTo(double x1, double y1, double x2, double y2) native 'Path_relativeQuadraticBezierTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::relativeQuadraticBezierTo', isLeaf: true)
+  external void relativeQuadraticBezierTo(double x1, double y1, double x2, double y2);
 
   /// Adds a cubic bezier segment that curves from the current point
   /// to the given point (x3,y3), using the control points (x1,y1) and
   /// (x2,y2).
-  void cubicTo(double x1, double y1, double x2, double y2, double x3, double y3) native 'Path_cubicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Float)>('Path::cubicTo', isLeaf: true)
+  external void cubicTo(double x1, double y1, double x2, double y2, double x3, double y3);
 
   /// Adds a cubic bezier segment that curves from the current point
   /// to the point at the offset (x3,y3) from the current point, using
   /// the control points at the offsets (x1,y1) and (x2,y2) from the
   /// current point.
-  void relativeCubicTo(double x1, double y1, double x2, double y2, double x3, double y3) native 'Path_relativeCubicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Float)>('Path::relativeCubicTo', isLeaf: true)
+  external void relativeCubicTo(double x1, double y1, double x2, double y2, double x3, double y3);
 
   /// Adds a bezier segment that curves from the current point to the
   /// given point (x2,y2), using the control points (x1,y1) and the
   /// weight w. If the weight is greater than 1, then the curve is a
   /// hyperbola; if the weight equals 1, it's a parabola; and if it is
   /// less than 1, it is an ellipse.
-  void conicTo(double x1, double y1, double x2, double y2, double w) native 'Path_conicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float)>('Path::conicTo', isLeaf: true)
+  external void conicTo(double x1, double y1, double x2, double y2, double w);
 
   /// Adds a bezier segment that curves from the current point to the
   /// point at the offset (x2,y2) from the current point, using the
@@ -2361,7 +2372,8 @@ class Path extends NativeFieldWrapperClass1 {
   /// the weight w. If the weight is greater than 1, then the curve is
   /// a hyperbola; if the weight equals 1, it's a parabola; and if it
   /// is less than 1, it is an ellipse.
-  void relativeConicTo(double x1, double y1, double x2, double y2, double w) native 'Path_relativeConicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float)>('Path::relativeConicTo', isLeaf: true)
+  external void relativeConicTo(double x1, double y1, double x2, double y2, double w);
 
   /// If the `forceMoveTo` argument is false, adds a straight line
   /// segment and an arc segment.
@@ -2450,7 +2462,8 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_rectIsValid(rect));
     _addRect(rect.left, rect.top, rect.right, rect.bottom);
   }
-  void _addRect(double left, double top, double right, double bottom) native 'Path_addRect';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::addRect', isLeaf: true)
+  external void _addRect(double left, double top, double right, double bottom);
 
   /// Adds a new sub-path that consists of a curve that forms the
   /// ellipse that fills the given rectangle.
@@ -2461,7 +2474,8 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_rectIsValid(oval));
     _addOval(oval.left, oval.top, oval.right, oval.bottom);
   }
-  void _addOval(double left, double top, double right, double bottom) native 'Path_addOval';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::addOval', isLeaf: true)
+  external void _addOval(double left, double top, double right, double bottom);
 
   /// Adds a new sub-path with one arc segment that consists of the arc
   /// that follows the edge of the oval bounded by the given
@@ -2475,8 +2489,8 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_rectIsValid(oval));
     _addArc(oval.left, oval.top, oval.right, oval.bottom, startAngle, sweepAngle);
   }
-  void _addArc(double left, double top, double right, double bottom,
-               double startAngle, double sweepAngle) native 'Path_addArc';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Float)>('Path::addArc', isLeaf: true)
+  external void _addArc(double left, double top, double right, double bottom, double startAngle, double sweepAngle);
 
   /// Adds a new sub-path with a sequence of line segments that connect the given
   /// points.
@@ -2540,12 +2554,14 @@ class Path extends NativeFieldWrapperClass1 {
 
   /// Closes the last sub-path, as if a straight line had been drawn
   /// from the current point to the first point of the sub-path.
-  void close() native 'Path_close';
+  @FfiNative<Void Function(Pointer<Void>)>('Path::close', isLeaf: true)
+  external void close();
 
   /// Clears the [Path] object of all sub-paths, returning it to the
   /// same state it had when it was created. The _current point_ is
   /// reset to the origin.
-  void reset() native 'Path_reset';
+  @FfiNative<Void Function(Pointer<Void>)>('Path::reset', isLeaf: true)
+  external void reset();
 
   /// Tests to see if the given point is within the path. (That is, whether the
   /// point would be in the visible portion of the path if the path was used
@@ -4111,7 +4127,8 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   ///  * [saveLayer], which does the same thing but additionally also groups the
   ///    commands done until the matching [restore].
-  void save() native 'Canvas_save';
+  @FfiNative<Void Function(Pointer<Void>)>('Canvas::save', isLeaf: true)
+  external void save();
 
   /// Saves a copy of the current transform and clip on the save stack, and then
   /// creates a new group which subsequent calls will become a part of. When the
@@ -4248,7 +4265,8 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// If the state was pushed with with [saveLayer], then this call will also
   /// cause the new layer to be composited into the previous layer.
-  void restore() native 'Canvas_restore';
+  @FfiNative<Void Function(Pointer<Void>)>('Canvas::restore', isLeaf: true)
+  external void restore();
 
   /// Returns the number of items on the save stack, including the
   /// initial state. This means it returns 1 for a clean canvas, and
@@ -4256,11 +4274,13 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// each matching call to [restore] decrements it.
   ///
   /// This number cannot go below 1.
-  int getSaveCount() native 'Canvas_getSaveCount';
+  @FfiNative<Int32 Function(Pointer<Void>)>('Canvas::getSaveCount', isLeaf: true)
+  external int getSaveCount();
 
   /// Add a translation to the current transform, shifting the coordinate space
   /// horizontally by the first argument and vertically by the second argument.
-  void translate(double dx, double dy) native 'Canvas_translate';
+  @FfiNative<Void Function(Pointer<Void>, Double, Double)>('Canvas::translate', isLeaf: true)
+  external void translate(double dx, double dy);
 
   /// Add an axis-aligned scale to the current transform, scaling by the first
   /// argument in the horizontal direction and the second in the vertical
@@ -4270,16 +4290,19 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// directions.
   void scale(double sx, [double? sy]) => _scale(sx, sy ?? sx);
 
-  void _scale(double sx, double sy) native 'Canvas_scale';
+  @FfiNative<Void Function(Pointer<Void>, Double, Double)>('Canvas::scale', isLeaf: true)
+  external void _scale(double sx, double sy);
 
   /// Add a rotation to the current transform. The argument is in radians clockwise.
-  void rotate(double radians) native 'Canvas_rotate';
+  @FfiNative<Void Function(Pointer<Void>, Double)>('Canvas::rotate', isLeaf: true)
+  external void rotate(double radians);
 
   /// Add an axis-aligned skew to the current transform, with the first argument
   /// being the horizontal skew in rise over run units clockwise around the
   /// origin, and the second argument being the vertical skew in rise over run
   /// units clockwise around the origin.
-  void skew(double sx, double sy) native 'Canvas_skew';
+  @FfiNative<Void Function(Pointer<Void>, Double, Double)>('Canvas::skew', isLeaf: true)
+  external void skew(double sx, double sy);
 
   /// Multiply the current transform by the specified 4⨉4 transformation matrix
   /// specified as a list of values in column-major order.
@@ -4667,6 +4690,49 @@ class Canvas extends NativeFieldWrapperClass1 {
                    int pointMode,
                    Float32List points) native 'Canvas_drawPoints';
 
+  /// Draws a sequence of rectangles with the given [Paint], as if
+  /// [drawRect] was called for each of them in turn.
+  ///
+  /// The `rects` argument is interpreted as a list of four floating point
+  /// numbers per rectangle, which are its left, top, right and bottom edges.
+  ///
+  /// Drawing all of the rectangles in one call is much cheaper than calling
+  /// [drawRect] for each of them when there are many rectangles, such as in
+  /// charts.
+  void drawRawRects(Float32List rects, Paint paint) {
+    assert(rects != null);
+    assert(paint != null);
+    if (rects.length % 4 != 0)
+      throw ArgumentError('"rects" must have a multiple of four values.');
+    _drawRects(paint._objects, paint._data, rects);
+  }
+
+  void _drawRects(List<dynamic>? paintObjects,
+                  ByteData paintData,
+                  Float32List rects) native 'Canvas_drawRects';
+
+  /// Draws a sequence of circles with the given [Paint], as if [drawCircle]
+  /// was called for each of them in turn.
+  ///
+  /// The `circles` argument is interpreted as a list of three floating point
+  /// numbers per circle, which are the x and y offsets of its center from the
+  /// origin, followed by its radius.
+  ///
+  /// Drawing all of the circles in one call is much cheaper than calling
+  /// [drawCircle] for each of them when there are many circles, such as in
+  /// scatter plots.
+  void drawRawCircles(Float32List circles, Paint paint) {
+    assert(circles != null);
+    assert(paint != null);
+    if (circles.length % 3 != 0)
+      throw ArgumentError('"circles" must have a multiple of three values.');
+    _drawCircles(paint._objects, paint._data, circles);
+  }
+
+  void _drawCircles(List<dynamic>? paintObjects,
+                    ByteData paintData,
+                    Float32List circles) native 'Canvas_drawCircles';
+
   /// Draws the set of [Vertices] onto the canvas.
   ///
   /// All parameters must not be null.
@@ -5101,6 +5167,34 @@ class Picture extends NativeFieldWrapperClass1 {
 
   String? _toImage(int width, int height, _Callback<_Image?> callback) native 'Picture_toImage';
 
+  /// Creates an image from each of the `pictures`.
+  ///
+  /// Each of the returned images is `width` pixels wide and `height` pixels
+  /// high, like the image [toImage] would return for the picture at the same
+  /// index. All of the pictures are rasterized together, and on platforms
+  /// with a GPU context the resulting images stay in GPU memory. This is
+  /// cheaper than calling [toImage] for each of many pictures, for example
+  /// to create the thumbnails of a grid.
+  static Future<List<Image>> toImages(List<Picture> pictures, int width, int height) {
+    if (width <= 0 || height <= 0)
+      throw Exception('Invalid image dimensions.');
+    if (pictures.isEmpty)
+      return Future<List<Image>>.value(<Image>[]);
+    return _futurize(
+      (_Callback<List<Image>?> callback) => _toImages(pictures, width, height, (List<Object?> images) {
+        if (images.contains(null)) {
+          callback(null);
+        } else {
+          callback(<Image>[
+            for (final Object? image in images) Image._(image! as _Image),
+          ]);
+        }
+      }),
+    );
+  }
+
+  static String? _toImages(List<Picture> pictures, int width, int height, _Callback<List<Object?>> callback) native 'Picture_toImages';
+
   /// Release the resources used by this object. The object is no longer usable
   /// after this method is called.
   void dispose() native 'Picture_dispose';
@@ -5361,7 +5455,7 @@ class Shadow {
 /// The creator of this object is responsible for calling [dispose] when it is
 /// no longer needed.
 class ImmutableBuffer extends NativeFieldWrapperClass1 {
-  ImmutableBuffer._(this.length);
+  ImmutableBuffer._(this._length);
 
   /// Creates a copy of the data from a [Uint8List] suitable for internal use
   /// in the engine.
@@ -5373,8 +5467,36 @@ class ImmutableBuffer extends NativeFieldWrapperClass1 {
   }
   void _init(Uint8List list, _Callback<void> callback) native 'ImmutableBuffer_init';
 
+  /// Create a buffer from the asset with key [assetKey].
+  ///
+  /// The asset is not copied into the Dart heap. Assets that are stored
+  /// uncompressed are memory mapped instead of being read into memory at all.
+  ///
+  /// Throws an [Exception] if the asset does not exist.
+  static Future<ImmutableBuffer> fromAsset(String assetKey) {
+    final ImmutableBuffer instance = ImmutableBuffer._(0);
+    return _futurize((_Callback<int> callback) {
+      return instance._initFromAsset(assetKey, callback);
+    }).then((int length) {
+      if (length == -1) {
+        throw Exception('Asset not found');
+      }
+      return instance.._length = length;
+    });
+  }
+  String? _initFromAsset(String assetKey, _Callback<int> callback) native 'ImmutableBuffer_initFromAsset';
+
+  /// Reads the assets with keys [assetKeys] into memory on a background
+  /// thread, without waiting for the reads to complete.
+  ///
+  /// Call this ahead of time, for example before a route transition starts,
+  /// so that loading the assets of the next route with [fromAsset] doesn't
+  /// wait for storage. Keys of assets that do not exist are ignored.
+  static void prefetchAssets(List<String> assetKeys) native 'ImmutableBuffer_prefetchAssets';
+
   /// The length, in bytes, of the underlying data.
-  final int length;
+  int get length => _length;
+  int _length;
 
   bool _debugDisposed = false;
 
@@ -5513,6 +5635,85 @@ class ImageDescriptor extends NativeFieldWrapperClass1 {
   void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight) native 'ImageDescriptor_instantiateCodec';
 }
 
+/// Decodes an image from its encoded bytes while they are still being
+/// received, for example from the network.
+///
+/// The bytes are added with [addChunk] as they are received. For the formats
+/// that can be decoded progressively, such as PNG and GIF, [onProgress] is
+/// called with an [Image] of the rows decoded so far, with the rest of the
+/// rows left transparent. Other formats are decoded once all of the bytes
+/// have been added.
+///
+/// Once all of the bytes have been added, [close] returns the complete image.
+/// Animated images are decoded to their first frame.
+///
+/// On web, no progress is reported and the image is only decoded by [close].
+class IncrementalImageDecoder extends NativeFieldWrapperClass1 {
+  /// Creates a decoder for an image that is decoded to the given size.
+  ///
+  /// If only one of targetWidth or targetHeight are specified, the other
+  /// dimension will be scaled according to the aspect ratio of the image.
+  ///
+  /// If either targetWidth or targetHeight is less than or equal to zero, it
+  /// will be treated as if it is null.
+  ///
+  /// The images passed to [onProgress] are owned by the callback, and should
+  /// be disposed once they are no longer shown.
+  IncrementalImageDecoder({
+    int? targetWidth,
+    int? targetHeight,
+    void Function(Image image)? onProgress,
+  }) {
+    _constructor(
+      targetWidth ?? 0,
+      targetHeight ?? 0,
+      onProgress == null ? null : (_Image image) {
+        onProgress(Image._(image));
+      },
+    );
+  }
+  void _constructor(int targetWidth, int targetHeight, void Function(_Image)? onProgress) native 'IncrementalImageDecoder_constructor';
+
+  bool _closed = false;
+
+  /// Adds the next bytes of the encoded image.
+  ///
+  /// Throws a [StateError] if the decoder has been closed or disposed.
+  void addChunk(Uint8List chunk) {
+    if (_closed) {
+      throw StateError('Cannot add chunks to a closed IncrementalImageDecoder.');
+    }
+    _addChunk(chunk);
+  }
+  void _addChunk(Uint8List chunk) native 'IncrementalImageDecoder_addChunk';
+
+  /// Marks all of the bytes of the image as added, and returns the complete
+  /// image.
+  ///
+  /// No more chunks can be added after this is called. The future completes
+  /// with an error if the image could not be decoded.
+  Future<Image> close() {
+    if (_closed) {
+      throw StateError('IncrementalImageDecoder.close was already called.');
+    }
+    _closed = true;
+    return _futurize((_Callback<Image?> callback) {
+      return _close((_Image? image) {
+        callback(image == null ? null : Image._(image));
+      });
+    });
+  }
+  String? _close(void Function(_Image?) callback) native 'IncrementalImageDecoder_close';
+
+  /// Stops decoding and releases the resources used by this object. No more
+  /// progress is reported, and a pending [close] never completes.
+  void dispose() {
+    _closed = true;
+    _dispose();
+  }
+  void _dispose() native 'IncrementalImageDecoder_dispose';
+}
+
 /// Generic callback signature, used by [_futurize].
 typedef _Callback<T> = void Function(T result);
 
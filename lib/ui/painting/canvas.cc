@@ -33,15 +33,8 @@ static void Canvas_constructor(Dart_NativeArguments args) {
 IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
 
 #define FOR_EACH_BINDING(V)         \
-  V(Canvas, save)                   \
   V(Canvas, saveLayerWithoutBounds) \
   V(Canvas, saveLayer)              \
-  V(Canvas, restore)                \
-  V(Canvas, getSaveCount)           \
-  V(Canvas, translate)              \
-  V(Canvas, scale)                  \
-  V(Canvas, rotate)                 \
-  V(Canvas, skew)                   \
   V(Canvas, transform)              \
   V(Canvas, clipRect)               \
   V(Canvas, clipRRect)              \
@@ -61,15 +54,28 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawImageNine)          \
   V(Canvas, drawPicture)            \
   V(Canvas, drawPoints)             \
+  V(Canvas, drawRects)              \
+  V(Canvas, drawCircles)            \
   V(Canvas, drawVertices)           \
   V(Canvas, drawAtlas)              \
   V(Canvas, drawShadow)
 
+// These skip the Dart API: painting.dart binds them as leaf FFI natives.
+#define FOR_EACH_FFI_BINDING(V) \
+  V(Canvas, save)               \
+  V(Canvas, restore)            \
+  V(Canvas, getSaveCount)       \
+  V(Canvas, translate)          \
+  V(Canvas, scale)              \
+  V(Canvas, rotate)             \
+  V(Canvas, skew)
+
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
 void Canvas::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({{"Canvas_constructor", Canvas_constructor, 6, true},
                      FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->RegisterFfi({FOR_EACH_FFI_BINDING(DART_REGISTER_FFI_NATIVE)});
 }
 
 fml::RefPtr<Canvas> Canvas::Create(PictureRecorder* recorder,
@@ -82,8 +88,15 @@ fml::RefPtr<Canvas> Canvas::Create(PictureRecorder* recorder,
         ToDart("Canvas constructor called with non-genuine PictureRecorder."));
     return nullptr;
   }
-  fml::RefPtr<Canvas> canvas = fml::MakeRefCounted<Canvas>(
-      recorder->BeginRecording(SkRect::MakeLTRB(left, top, right, bottom)));
+  SkCanvas* sk_canvas =
+      recorder->BeginRecording(SkRect::MakeLTRB(left, top, right, bottom));
+  // A recycled recorder brings the canvas of its previous recording along.
+  fml::RefPtr<Canvas> canvas = recorder->TakeRecycledCanvas();
+  if (canvas) {
+    canvas->canvas_ = sk_canvas;
+  } else {
+    canvas = fml::MakeRefCounted<Canvas>(sk_canvas);
+  }
   recorder->set_canvas(canvas);
   canvas->display_list_recorder_ = recorder->display_list_recorder();
   return canvas;
@@ -204,7 +217,7 @@ void Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
         ToDart("Canvas.clipPath called with non-genuine Path."));
     return;
   }
-  canvas_->clipPath(path->path(), doAntiAlias);
+  canvas_->clipPath(path->GetPathForDrawing(), doAntiAlias);
 }
 
 void Canvas::drawColor(SkColor color, SkBlendMode blend_mode) {
@@ -322,7 +335,7 @@ void Canvas::drawPath(const CanvasPath* path,
         ToDart("Canvas.drawPath called with non-genuine Path."));
     return;
   }
-  canvas_->drawPath(path->path(), *paint.paint());
+  canvas_->drawPath(path->GetPathForDrawing(), *paint.paint());
 }
 
 void Canvas::drawImage(const CanvasImage* image,
@@ -450,6 +463,60 @@ void Canvas::drawPoints(const Paint& paint,
                       *paint.paint());
 }
 
+void Canvas::drawRects(const Paint& paint,
+                       const PaintData& paint_data,
+                       const tonic::Float32List& rects) {
+  if (!canvas_) {
+    return;
+  }
+
+  static_assert(sizeof(SkRect) == sizeof(float) * 4,
+                "SkRect doesn't use floats.");
+
+  const SkRect* sk_rects = reinterpret_cast<const SkRect*>(rects.data());
+  size_t count = rects.num_elements() / 4;  // SkRects have four floats.
+  if (display_list_recorder_) {
+    // The paint is the same for every rect, so its attributes are only
+    // recorded once rather than compared again for each of the rects.
+    display_list_recorder_->RecordPaintAttributes(
+        paint.paint(), DisplayListCanvasRecorder::DrawType::kDrawOpType);
+    sk_sp<DisplayListBuilder> rects_builder = builder();
+    for (size_t i = 0; i < count; i++) {
+      rects_builder->drawRect(sk_rects[i]);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      canvas_->drawRect(sk_rects[i], *paint.paint());
+    }
+  }
+}
+
+void Canvas::drawCircles(const Paint& paint,
+                         const PaintData& paint_data,
+                         const tonic::Float32List& circles) {
+  if (!canvas_) {
+    return;
+  }
+
+  const float* data = circles.data();
+  size_t count = circles.num_elements() / 3;  // x, y and radius.
+  if (display_list_recorder_) {
+    display_list_recorder_->RecordPaintAttributes(
+        paint.paint(), DisplayListCanvasRecorder::DrawType::kDrawOpType);
+    sk_sp<DisplayListBuilder> circles_builder = builder();
+    for (size_t i = 0; i < count; i++) {
+      const float* circle = data + i * 3;
+      circles_builder->drawCircle(SkPoint::Make(circle[0], circle[1]),
+                                  circle[2]);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      const float* circle = data + i * 3;
+      canvas_->drawCircle(circle[0], circle[1], circle[2], *paint.paint());
+    }
+  }
+}
+
 void Canvas::drawVertices(const Vertices* vertices,
                           SkBlendMode blend_mode,
                           const Paint& paint,
@@ -524,16 +591,18 @@ void Canvas::drawShadow(const CanvasPath* path,
     // that situation we bypass the canvas interface and inject the
     // shadow parameters directly into the underlying DisplayList.
     // See: https://bugs.chromium.org/p/skia/issues/detail?id=12125
-    builder()->drawShadow(path->path(), color, elevation, transparentOccluder,
-                          dpr);
+    builder()->drawShadow(path->GetPathForDrawing(), color, elevation,
+                          transparentOccluder, dpr);
   } else {
-    flutter::PhysicalShapeLayer::DrawShadow(
-        canvas_, path->path(), color, elevation, transparentOccluder, dpr);
+    flutter::PhysicalShapeLayer::DrawShadow(canvas_, path->GetPathForDrawing(),
+                                            color, elevation,
+                                            transparentOccluder, dpr);
   }
 }
 
 void Canvas::Invalidate() {
   canvas_ = nullptr;
+  display_list_recorder_ = nullptr;
   if (dart_wrapper()) {
     ClearDartWrapper();
   }
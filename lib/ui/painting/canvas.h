@@ -148,6 +148,14 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                   SkCanvas::PointMode point_mode,
                   const tonic::Float32List& points);
 
+  void drawRects(const Paint& paint,
+                 const PaintData& paint_data,
+                 const tonic::Float32List& rects);
+
+  void drawCircles(const Paint& paint,
+                   const PaintData& paint_data,
+                   const tonic::Float32List& circles);
+
   void drawVertices(const Vertices* vertices,
                     SkBlendMode blend_mode,
                     const Paint& paint,
@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/chunked_image_data.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+class ChunkedImageDataStream final : public SkStream {
+ public:
+  explicit ChunkedImageDataStream(fml::RefPtr<ChunkedImageData> data)
+      : data_(std::move(data)) {}
+
+  // |SkStream|
+  size_t read(void* buffer, size_t size) override {
+    if (!buffer) {
+      // A null buffer skips the bytes instead.
+      const size_t available = data_->size();
+      size = position_ < available ? std::min(size, available - position_) : 0;
+    } else {
+      size = data_->Read(position_, buffer, size);
+    }
+    position_ += size;
+    return size;
+  }
+
+  // |SkStream|
+  size_t peek(void* buffer, size_t size) const override {
+    return data_->Read(position_, buffer, size);
+  }
+
+  // |SkStream|
+  bool isAtEnd() const override {
+    // The size doesn't change once the data is finished.
+    return data_->is_finished() && position_ >= data_->size();
+  }
+
+  // |SkStream|
+  bool rewind() override {
+    position_ = 0;
+    return true;
+  }
+
+  // |SkStream|
+  bool hasPosition() const override { return true; }
+
+  // |SkStream|
+  size_t getPosition() const override { return position_; }
+
+  // |SkStream|
+  bool seek(size_t position) override {
+    position_ = position;
+    return true;
+  }
+
+  // |SkStream|
+  bool move(long offset) override {
+    if (offset < 0 && static_cast<size_t>(-offset) > position_) {
+      position_ = 0;
+    } else {
+      position_ += offset;
+    }
+    return true;
+  }
+
+  // |SkStream|
+  bool hasLength() const override { return data_->is_finished(); }
+
+  // |SkStream|
+  size_t getLength() const override { return data_->size(); }
+
+ private:
+  const fml::RefPtr<ChunkedImageData> data_;
+  size_t position_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ChunkedImageDataStream);
+};
+
+}  // namespace
+
+ChunkedImageData::ChunkedImageData() = default;
+
+ChunkedImageData::~ChunkedImageData() = default;
+
+void ChunkedImageData::Append(sk_sp<SkData> chunk) {
+  if (!chunk || chunk->size() == 0) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  FML_DCHECK(!finished_);
+  offsets_.push_back(size_);
+  size_ += chunk->size();
+  chunks_.push_back(std::move(chunk));
+}
+
+void ChunkedImageData::Finish() {
+  std::scoped_lock lock(mutex_);
+  finished_ = true;
+}
+
+bool ChunkedImageData::is_finished() const {
+  std::scoped_lock lock(mutex_);
+  return finished_;
+}
+
+size_t ChunkedImageData::size() const {
+  std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+size_t ChunkedImageData::Read(size_t offset,
+                              void* buffer,
+                              size_t length) const {
+  std::scoped_lock lock(mutex_);
+  if (offset >= size_) {
+    return 0;
+  }
+  length = std::min(length, size_ - offset);
+
+  // The last chunk that starts at or before the offset.
+  size_t index =
+      std::upper_bound(offsets_.begin(), offsets_.end(), offset) -
+      offsets_.begin() - 1;
+  size_t copied = 0;
+  while (copied < length) {
+    const auto& chunk = chunks_[index];
+    const size_t chunk_offset = offset + copied - offsets_[index];
+    const size_t count = std::min(length - copied, chunk->size() - chunk_offset);
+    memcpy(static_cast<uint8_t*>(buffer) + copied,
+           chunk->bytes() + chunk_offset, count);
+    copied += count;
+    index++;
+  }
+  return copied;
+}
+
+sk_sp<SkData> ChunkedImageData::MakeContiguousData() const {
+  std::scoped_lock lock(mutex_);
+  if (chunks_.empty()) {
+    return SkData::MakeEmpty();
+  }
+  if (chunks_.size() == 1) {
+    return chunks_.front();
+  }
+  auto data = SkData::MakeUninitialized(size_);
+  auto* bytes = static_cast<uint8_t*>(data->writable_data());
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    memcpy(bytes + offsets_[i], chunks_[i]->data(), chunks_[i]->size());
+  }
+  return data;
+}
+
+std::unique_ptr<SkStream> ChunkedImageData::MakeStream() {
+  return std::make_unique<ChunkedImageDataStream>(fml::Ref(this));
+}
+
+}  // namespace flutter
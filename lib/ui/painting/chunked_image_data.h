@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_CHUNKED_IMAGE_DATA_H_
+#define FLUTTER_LIB_UI_PAINTING_CHUNKED_IMAGE_DATA_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace flutter {
+
+/// @brief  The encoded bytes of an image that are still being received, for
+///         example from the network. Chunks are appended as they arrive and
+///         the streams made by `MakeStream` read everything appended so far.
+///
+///         Chunks may be appended on one thread while the streams are read on
+///         others. A stream that has read all of the appended bytes reads
+///         nothing until more are appended, but it is not at its end until
+///         `Finish` has been called. Codecs treat such short reads as
+///         incomplete input rather than as the end of the image.
+class ChunkedImageData : public fml::RefCountedThreadSafe<ChunkedImageData> {
+ public:
+  /// @brief  Appends the next bytes of the image. Must not be called after
+  ///         `Finish`.
+  void Append(sk_sp<SkData> chunk);
+
+  /// @brief  Marks all of the bytes of the image as received.
+  void Finish();
+
+  bool is_finished() const;
+
+  /// @brief  The number of bytes appended so far.
+  size_t size() const;
+
+  /// @brief  Copies up to `length` bytes starting at `offset` into `buffer`.
+  /// @return The number of bytes copied, which is less than `length` if not
+  ///         as many bytes have been appended yet.
+  size_t Read(size_t offset, void* buffer, size_t length) const;
+
+  /// @brief  Returns all of the bytes appended so far as a single buffer.
+  ///         This copies the chunks unless there is only one of them.
+  sk_sp<SkData> MakeContiguousData() const;
+
+  /// @brief  Makes a stream that reads the bytes from the beginning.
+  std::unique_ptr<SkStream> MakeStream();
+
+ private:
+  ChunkedImageData();
+
+  ~ChunkedImageData();
+
+  mutable std::mutex mutex_;
+  std::vector<sk_sp<SkData>> chunks_;
+  // The offset of the first byte of each of the chunks.
+  std::vector<size_t> offsets_;
+  size_t size_ = 0;
+  bool finished_ = false;
+
+  FML_FRIEND_MAKE_REF_COUNTED(ChunkedImageData);
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(ChunkedImageData);
+  FML_DISALLOW_COPY_AND_ASSIGN(ChunkedImageData);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_CHUNKED_IMAGE_DATA_H_
@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/chunked_image_data.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<SkData> MakeData(uint8_t first, size_t size) {
+  auto data = SkData::MakeUninitialized(size);
+  auto* bytes = static_cast<uint8_t*>(data->writable_data());
+  for (size_t i = 0; i < size; i++) {
+    bytes[i] = static_cast<uint8_t>(first + i);
+  }
+  return data;
+}
+
+TEST(ChunkedImageDataTest, ReadsAcrossChunks) {
+  auto data = fml::MakeRefCounted<ChunkedImageData>();
+  data->Append(MakeData(0, 4));
+  data->Append(SkData::MakeEmpty());
+  data->Append(MakeData(4, 4));
+  data->Append(MakeData(8, 4));
+  ASSERT_EQ(data->size(), 12u);
+
+  uint8_t buffer[12] = {};
+  ASSERT_EQ(data->Read(2, buffer, 8), 8u);
+  for (size_t i = 0; i < 8; i++) {
+    EXPECT_EQ(buffer[i], i + 2);
+  }
+
+  // Short reads at the end of the data appended so far.
+  EXPECT_EQ(data->Read(10, buffer, 8), 2u);
+  EXPECT_EQ(buffer[0], 10);
+  EXPECT_EQ(buffer[1], 11);
+  EXPECT_EQ(data->Read(12, buffer, 8), 0u);
+}
+
+TEST(ChunkedImageDataTest, MakesContiguousData) {
+  auto data = fml::MakeRefCounted<ChunkedImageData>();
+  EXPECT_EQ(data->MakeContiguousData()->size(), 0u);
+
+  auto first = MakeData(0, 3);
+  data->Append(first);
+  // A single chunk isn't copied.
+  EXPECT_EQ(data->MakeContiguousData(), first);
+
+  data->Append(MakeData(3, 5));
+  auto contiguous = data->MakeContiguousData();
+  ASSERT_EQ(contiguous->size(), 8u);
+  for (size_t i = 0; i < 8; i++) {
+    EXPECT_EQ(contiguous->bytes()[i], i);
+  }
+}
+
+TEST(ChunkedImageDataTest, StreamIsNotAtEndUntilFinished) {
+  auto data = fml::MakeRefCounted<ChunkedImageData>();
+  auto stream = data->MakeStream();
+  data->Append(MakeData(0, 4));
+
+  uint8_t buffer[8] = {};
+  EXPECT_FALSE(stream->hasLength());
+  EXPECT_EQ(stream->read(buffer, 8), 4u);
+  EXPECT_EQ(stream->getPosition(), 4u);
+  EXPECT_FALSE(stream->isAtEnd());
+
+  // Reads continue with the bytes appended since.
+  data->Append(MakeData(4, 4));
+  EXPECT_EQ(stream->peek(buffer, 2), 2u);
+  EXPECT_EQ(buffer[0], 4);
+  EXPECT_EQ(stream->getPosition(), 4u);
+  EXPECT_EQ(stream->read(buffer, 8), 4u);
+  EXPECT_EQ(buffer[3], 7);
+  EXPECT_FALSE(stream->isAtEnd());
+
+  data->Finish();
+  EXPECT_TRUE(stream->isAtEnd());
+  EXPECT_TRUE(stream->hasLength());
+  EXPECT_EQ(stream->getLength(), 8u);
+}
+
+TEST(ChunkedImageDataTest, StreamSeeks) {
+  auto data = fml::MakeRefCounted<ChunkedImageData>();
+  data->Append(MakeData(0, 6));
+  data->Append(MakeData(6, 6));
+  data->Finish();
+  auto stream = data->MakeStream();
+
+  uint8_t buffer[4] = {};
+  // A null buffer skips the bytes.
+  EXPECT_EQ(stream->read(nullptr, 5), 5u);
+  EXPECT_EQ(stream->read(buffer, 2), 2u);
+  EXPECT_EQ(buffer[0], 5);
+  EXPECT_EQ(buffer[1], 6);
+
+  EXPECT_TRUE(stream->move(-3));
+  EXPECT_EQ(stream->getPosition(), 4u);
+  EXPECT_TRUE(stream->move(-10));
+  EXPECT_EQ(stream->getPosition(), 0u);
+
+  EXPECT_TRUE(stream->seek(10));
+  EXPECT_EQ(stream->read(buffer, 4), 2u);
+  EXPECT_TRUE(stream->isAtEnd());
+
+  EXPECT_TRUE(stream->rewind());
+  EXPECT_EQ(stream->read(buffer, 1), 1u);
+  EXPECT_EQ(buffer[0], 0);
+  EXPECT_FALSE(stream->isAtEnd());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <cstring>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// A 64-bit FNV-1a style hash over 8 bytes at a time. Collisions only cost a
+// comparison of the bytes in |Get|.
+static uint64_t HashBytes(const uint8_t* bytes, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  size_t offset = 0;
+  for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + offset, sizeof(word));
+    hash = (hash ^ word) * 0x100000001b3ull;
+  }
+  for (; offset < size; offset++) {
+    hash = (hash ^ bytes[offset]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+bool DecodedImageCache::Key::operator==(const Key& other) const {
+  return content_hash == other.content_hash &&
+         content_size == other.content_size &&
+         image_info == other.image_info && row_bytes == other.row_bytes &&
+         target_width == other.target_width &&
+         target_height == other.target_height;
+}
+
+size_t DecodedImageCache::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(key.content_hash, key.content_size,
+                          key.image_info.width(), key.image_info.height(),
+                          key.target_width, key.target_height);
+}
+
+DecodedImageCache::Key DecodedImageCache::MakeKey(
+    const SkData& data,
+    const SkImageInfo& image_info,
+    size_t row_bytes,
+    uint32_t target_width,
+    uint32_t target_height) {
+  TRACE_EVENT0("flutter", "DecodedImageCache::MakeKey");
+  Key key;
+  key.content_hash = HashBytes(data.bytes(), data.size());
+  key.content_size = data.size();
+  key.image_info = image_info;
+  key.row_bytes = row_bytes;
+  key.target_width = target_width;
+  key.target_height = target_height;
+  return key;
+}
+
+DecodedImageCache::DecodedImageCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+SkiaGPUObject<SkImage> DecodedImageCache::Get(const Key& key,
+                                              const SkData& data) {
+  std::scoped_lock lock(mutex_);
+  auto found = entries_by_key_.find(key);
+  if (found == entries_by_key_.end()) {
+    return {};
+  }
+  const Entry& entry = *found->second;
+  if (entry.data.get() != &data && !entry.data->equals(&data)) {
+    return {};
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return {entry.image.skia_object(), entry.unref_queue};
+}
+
+void DecodedImageCache::Put(const Key& key,
+                            sk_sp<SkData> data,
+                            sk_sp<SkImage> image,
+                            fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+  if (!data || !image) {
+    return;
+  }
+  const size_t bytes = image->imageInfo().computeMinByteSize() + data->size();
+
+  std::scoped_lock lock(mutex_);
+  if (bytes > max_bytes_) {
+    return;
+  }
+  auto found = entries_by_key_.find(key);
+  if (found != entries_by_key_.end()) {
+    // Either the same image was decoded concurrently or the bytes collided
+    // with those of another image. Keep the newer one.
+    byte_size_ -= found->second->bytes;
+    entries_.erase(found->second);
+    entries_by_key_.erase(found);
+  }
+  EvictUnlocked(max_bytes_ - bytes);
+  entries_.push_front({key, std::move(data),
+                       SkiaGPUObject<SkImage>(image, unref_queue), unref_queue,
+                       bytes});
+  entries_by_key_[key] = entries_.begin();
+  byte_size_ += bytes;
+}
+
+void DecodedImageCache::SetMaxBytes(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_bytes_ = max_bytes;
+  EvictUnlocked(max_bytes_);
+}
+
+size_t DecodedImageCache::max_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return max_bytes_;
+}
+
+void DecodedImageCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  EvictUnlocked(0);
+}
+
+size_t DecodedImageCache::GetByteSize() const {
+  std::scoped_lock lock(mutex_);
+  return byte_size_;
+}
+
+size_t DecodedImageCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+void DecodedImageCache::EvictUnlocked(size_t max_bytes) {
+  while (byte_size_ > max_bytes && !entries_.empty()) {
+    const Entry& entry = entries_.back();
+    byte_size_ -= entry.bytes;
+    entries_by_key_.erase(entry.key);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace flutter
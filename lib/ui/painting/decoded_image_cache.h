@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+
+namespace flutter {
+
+/// A cache of the images decoded by the |ImageDecoder|, keyed by the bytes
+/// they were decoded from and the size they were decoded to, so that
+/// instantiating the same image again skips its decode and upload.
+///
+/// The cache keeps up to |max_bytes| of decoded images along with their
+/// encoded bytes, evicting the least recently used entries first. It may be
+/// used from any thread. The images are released through the unref queue of
+/// the IO manager that uploaded them.
+class DecodedImageCache {
+ public:
+  struct Key {
+    uint64_t content_hash = 0;
+    size_t content_size = 0;
+    // The info and row bytes of the descriptor, which describe the pixels of
+    // the images that are not compressed.
+    SkImageInfo image_info;
+    size_t row_bytes = 0;
+    uint32_t target_width = 0;
+    uint32_t target_height = 0;
+
+    bool operator==(const Key& other) const;
+  };
+
+  /// Hashes the contents of |data| along with the other parameters of a
+  /// decode. This reads all of the bytes, so it should not be done on the UI
+  /// thread.
+  static Key MakeKey(const SkData& data,
+                     const SkImageInfo& image_info,
+                     size_t row_bytes,
+                     uint32_t target_width,
+                     uint32_t target_height);
+
+  explicit DecodedImageCache(size_t max_bytes);
+
+  ~DecodedImageCache();
+
+  /// Returns the image decoded from the same bytes as |data| for |key|, or
+  /// an empty object if there is none.
+  SkiaGPUObject<SkImage> Get(const Key& key, const SkData& data);
+
+  /// Caches |image|, which was decoded from |data|. Images that don't fit in
+  /// the budget at all are not cached.
+  void Put(const Key& key,
+           sk_sp<SkData> data,
+           sk_sp<SkImage> image,
+           fml::RefPtr<SkiaUnrefQueue> unref_queue);
+
+  /// Releases all of the images, for example when the memory is low.
+  void Clear();
+
+  /// Changes the budget, evicting the least recently used entries if the
+  /// cache is over the new budget.
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t max_bytes() const;
+
+  size_t GetByteSize() const;
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    sk_sp<SkData> data;
+    SkiaGPUObject<SkImage> image;
+    fml::RefPtr<SkiaUnrefQueue> unref_queue;
+    size_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void EvictUnlocked(size_t max_bytes);
+
+  mutable std::mutex mutex_;
+  size_t max_bytes_;
+  // In the order of their uses, the most recently used first.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> entries_by_key_;
+  size_t byte_size_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <cstring>
+#include <future>
+
+#include "flutter/testing/thread_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class DecodedImageCacheTest : public ThreadTest {
+ public:
+  DecodedImageCacheTest() : unref_task_runner_(CreateNewThread()) {
+    // The queue must be created on the thread of its task runner.
+    std::promise<bool> queue_created;
+    unref_task_runner_->PostTask([this, &queue_created]() {
+      unref_queue_ = fml::MakeRefCounted<SkiaUnrefQueue>(
+          unref_task_runner_, fml::TimeDelta::FromSeconds(0));
+      queue_created.set_value(true);
+    });
+    queue_created.get_future().wait();
+  }
+
+  fml::RefPtr<SkiaUnrefQueue> unref_queue() { return unref_queue_; }
+
+ private:
+  fml::RefPtr<fml::TaskRunner> unref_task_runner_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+};
+
+static sk_sp<SkData> MakeData(uint8_t value, size_t size = 16) {
+  auto data = SkData::MakeUninitialized(size);
+  memset(data->writable_data(), value, size);
+  return data;
+}
+
+static sk_sp<SkImage> MakeImage(int width, int height) {
+  auto info = SkImageInfo::MakeN32Premul(width, height);
+  return SkImage::MakeRasterData(
+      info, SkData::MakeZeroInitialized(info.computeMinByteSize()),
+      info.minRowBytes());
+}
+
+static DecodedImageCache::Key MakeKey(const SkData& data,
+                                      uint32_t target_width = 10,
+                                      uint32_t target_height = 10) {
+  return DecodedImageCache::MakeKey(data, SkImageInfo(), 0, target_width,
+                                    target_height);
+}
+
+TEST_F(DecodedImageCacheTest, ReturnsTheImagesOfIdenticalBytes) {
+  DecodedImageCache cache(1 << 20);
+  auto data = MakeData(1);
+  auto image = MakeImage(10, 10);
+  cache.Put(MakeKey(*data), data, image, unref_queue());
+
+  // A copy of the bytes, as from another ImmutableBuffer.
+  auto copy = SkData::MakeWithCopy(data->data(), data->size());
+  auto cached = cache.Get(MakeKey(*copy), *copy);
+  ASSERT_EQ(cached.skia_object(), image);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+}
+
+TEST_F(DecodedImageCacheTest, KeysIncludeTheTargetSize) {
+  DecodedImageCache cache(1 << 20);
+  auto data = MakeData(1);
+  cache.Put(MakeKey(*data, 10, 10), data, MakeImage(10, 10), unref_queue());
+
+  ASSERT_FALSE(cache.Get(MakeKey(*data, 20, 20), *data).skia_object());
+  ASSERT_TRUE(cache.Get(MakeKey(*data, 10, 10), *data).skia_object());
+}
+
+TEST_F(DecodedImageCacheTest, DifferentBytesWithTheSameKeyMiss) {
+  DecodedImageCache cache(1 << 20);
+  auto data = MakeData(1);
+  auto key = MakeKey(*data);
+  cache.Put(key, data, MakeImage(10, 10), unref_queue());
+
+  // As if the contents of another buffer hashed to the same key.
+  auto other = MakeData(2);
+  ASSERT_FALSE(cache.Get(key, *other).skia_object());
+}
+
+TEST_F(DecodedImageCacheTest, EvictsTheLeastRecentlyUsedImages) {
+  auto image = MakeImage(10, 10);
+  const size_t entry_bytes = image->imageInfo().computeMinByteSize() + 16;
+  DecodedImageCache cache(entry_bytes * 2);
+
+  auto first = MakeData(1);
+  auto second = MakeData(2);
+  auto third = MakeData(3);
+  cache.Put(MakeKey(*first), first, image, unref_queue());
+  cache.Put(MakeKey(*second), second, MakeImage(10, 10), unref_queue());
+  ASSERT_TRUE(cache.Get(MakeKey(*first), *first).skia_object());
+
+  cache.Put(MakeKey(*third), third, MakeImage(10, 10), unref_queue());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.GetByteSize(), entry_bytes * 2);
+  ASSERT_TRUE(cache.Get(MakeKey(*first), *first).skia_object());
+  ASSERT_FALSE(cache.Get(MakeKey(*second), *second).skia_object());
+  ASSERT_TRUE(cache.Get(MakeKey(*third), *third).skia_object());
+}
+
+TEST_F(DecodedImageCacheTest, DoesNotCacheImagesLargerThanTheBudget) {
+  DecodedImageCache cache(100);
+  auto data = MakeData(1);
+  cache.Put(MakeKey(*data), data, MakeImage(10, 10), unref_queue());
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST_F(DecodedImageCacheTest, ClearReleasesAllOfTheImages) {
+  DecodedImageCache cache(1 << 20);
+  auto first = MakeData(1);
+  auto second = MakeData(2);
+  cache.Put(MakeKey(*first), first, MakeImage(10, 10), unref_queue());
+  cache.Put(MakeKey(*second), second, MakeImage(10, 10), unref_queue());
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+  ASSERT_FALSE(cache.Get(MakeKey(*first), *first).skia_object());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/display_list_cache.h"
+
+namespace flutter {
+
+DisplayListCache::DisplayListCache(size_t capacity) : capacity_(capacity) {}
+
+DisplayListCache::~DisplayListCache() = default;
+
+sk_sp<DisplayList> DisplayListCache::Deduplicate(
+    sk_sp<DisplayList> display_list,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+  if (!display_list || !unref_queue || capacity_ == 0) {
+    return display_list;
+  }
+  const uint64_t hash = display_list->content_hash();
+  auto found = entries_by_hash_.find(hash);
+  if (found != entries_by_hash_.end()) {
+    sk_sp<DisplayList> cached = found->second->skia_object();
+    if (cached->Equals(*display_list)) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      // The new list shares its images with the cached one, so dropping it
+      // here never releases GPU resources on the UI thread.
+      return cached;
+    }
+    // The hashes of different lists collided. Keep the newer one.
+    entries_.erase(found->second);
+    entries_by_hash_.erase(found);
+  }
+  while (entries_.size() >= capacity_) {
+    entries_by_hash_.erase(entries_.back().skia_object()->content_hash());
+    entries_.pop_back();
+  }
+  entries_.emplace_front(display_list, std::move(unref_queue));
+  entries_by_hash_[hash] = entries_.begin();
+  return display_list;
+}
+
+void DisplayListCache::Clear() {
+  entries_by_hash_.clear();
+  entries_.clear();
+}
+
+}  // namespace flutter
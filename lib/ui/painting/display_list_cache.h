@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+/// The display lists of the most recently recorded pictures, so that a
+/// picture that is recorded again with the same content gets the display
+/// list of the previous recording instead of its new copy.
+///
+/// The framework re-records unchanged pictures whenever an ancestor repaint
+/// boundary repaints. Handing the raster thread the same display list then
+/// lets the layer diff and the raster cache recognize the picture by the
+/// identity of its display list.
+///
+/// Lists are only shared if they are |DisplayList::Equals|, which compares
+/// images and other objects by identity, so reusing a list never changes
+/// what is drawn, including after a hot reload. The cache keeps up to
+/// |capacity| lists, evicting the least recently used ones first, and
+/// releases them through their unref queue.
+///
+/// A cache belongs to a UIDartState and must only be used on its UI task
+/// runner.
+class DisplayListCache {
+ public:
+  explicit DisplayListCache(size_t capacity);
+
+  ~DisplayListCache();
+
+  /// Returns the cached list that is equal to |display_list| if there is
+  /// one. Otherwise caches |display_list| and returns it.
+  sk_sp<DisplayList> Deduplicate(sk_sp<DisplayList> display_list,
+                                 fml::RefPtr<SkiaUnrefQueue> unref_queue);
+
+  /// Releases all of the lists.
+  void Clear();
+
+  size_t GetEntryCount() const { return entries_.size(); }
+
+ private:
+  using EntryList = std::list<SkiaGPUObject<DisplayList>>;
+
+  const size_t capacity_;
+  // In the order of their uses, the most recently used first.
+  EntryList entries_;
+  std::unordered_map<uint64_t, EntryList::iterator> entries_by_hash_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_CACHE_H_
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/display_list_cache.h"
+
+#include <future>
+
+#include "flutter/testing/thread_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class DisplayListCacheTest : public ThreadTest {
+ public:
+  DisplayListCacheTest() : unref_task_runner_(CreateNewThread()) {
+    // The queue must be created on the thread of its task runner.
+    std::promise<bool> queue_created;
+    unref_task_runner_->PostTask([this, &queue_created]() {
+      unref_queue_ = fml::MakeRefCounted<SkiaUnrefQueue>(
+          unref_task_runner_, fml::TimeDelta::FromSeconds(0));
+      queue_created.set_value(true);
+    });
+    queue_created.get_future().wait();
+  }
+
+  fml::RefPtr<SkiaUnrefQueue> unref_queue() { return unref_queue_; }
+
+ private:
+  fml::RefPtr<fml::TaskRunner> unref_task_runner_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+};
+
+static sk_sp<DisplayList> MakeDisplayList(SkScalar size) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeWH(size, size));
+  return builder.Build();
+}
+
+TEST_F(DisplayListCacheTest, ReturnsTheCachedListForEqualContent) {
+  DisplayListCache cache(4);
+  auto first = MakeDisplayList(10);
+  ASSERT_EQ(cache.Deduplicate(first, unref_queue()), first);
+
+  auto second = MakeDisplayList(10);
+  ASSERT_NE(second, first);
+  ASSERT_EQ(cache.Deduplicate(second, unref_queue()), first);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+}
+
+TEST_F(DisplayListCacheTest, KeepsListsWithDifferentContent) {
+  DisplayListCache cache(4);
+  auto first = MakeDisplayList(10);
+  auto second = MakeDisplayList(20);
+  ASSERT_EQ(cache.Deduplicate(first, unref_queue()), first);
+  ASSERT_EQ(cache.Deduplicate(second, unref_queue()), second);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST_F(DisplayListCacheTest, EvictsTheLeastRecentlyUsedLists) {
+  DisplayListCache cache(2);
+  auto first = MakeDisplayList(10);
+  auto second = MakeDisplayList(20);
+  cache.Deduplicate(first, unref_queue());
+  cache.Deduplicate(second, unref_queue());
+  ASSERT_EQ(cache.Deduplicate(MakeDisplayList(10), unref_queue()), first);
+
+  cache.Deduplicate(MakeDisplayList(30), unref_queue());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.Deduplicate(MakeDisplayList(10), unref_queue()), first);
+  ASSERT_NE(cache.Deduplicate(MakeDisplayList(20), unref_queue()), second);
+}
+
+TEST_F(DisplayListCacheTest, DoesNotCacheWithoutAnUnrefQueue) {
+  DisplayListCache cache(4);
+  auto first = MakeDisplayList(10);
+  ASSERT_EQ(cache.Deduplicate(first, nullptr), first);
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+}
+
+TEST_F(DisplayListCacheTest, ClearReleasesAllOfTheLists) {
+  DisplayListCache cache(4);
+  cache.Deduplicate(MakeDisplayList(10), unref_queue());
+  cache.Deduplicate(MakeDisplayList(20), unref_queue());
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -20,13 +20,15 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, EngineLayer);
 
 DART_BIND_ALL(EngineLayer, FOR_EACH_BINDING)
 
-EngineLayer::EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer)
-    : layer_(layer) {}
+EngineLayer::EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer,
+                         std::shared_ptr<LayerCommandBuffer> commands)
+    : layer_(layer), commands_(std::move(commands)) {}
 
 EngineLayer::~EngineLayer() = default;
 
 void EngineLayer::dispose() {
   layer_.reset();
+  commands_.reset();
   ClearDartWrapper();
 }
 
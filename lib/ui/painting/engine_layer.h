@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_PAINTING_ENGINE_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_command_buffer.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 
 namespace tonic {
@@ -22,9 +23,14 @@ class EngineLayer : public RefCountedDartWrappable<EngineLayer> {
  public:
   ~EngineLayer() override;
 
-  static void MakeRetained(Dart_Handle dart_handle,
-                           std::shared_ptr<flutter::ContainerLayer> layer) {
-    auto engine_layer = fml::MakeRefCounted<EngineLayer>(layer);
+  // |commands| is the buffer that |layer| was pushed to, when the scene is
+  // built with deferred layer tree construction.
+  static void MakeRetained(
+      Dart_Handle dart_handle,
+      std::shared_ptr<flutter::ContainerLayer> layer,
+      std::shared_ptr<LayerCommandBuffer> commands = nullptr) {
+    auto engine_layer =
+        fml::MakeRefCounted<EngineLayer>(layer, std::move(commands));
     engine_layer->AssociateWithDartWrapper(dart_handle);
   }
 
@@ -34,9 +40,13 @@ class EngineLayer : public RefCountedDartWrappable<EngineLayer> {
 
   std::shared_ptr<flutter::ContainerLayer> Layer() const { return layer_; }
 
+  std::shared_ptr<LayerCommandBuffer> commands() const { return commands_; }
+
  private:
-  explicit EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer);
+  EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer,
+              std::shared_ptr<LayerCommandBuffer> commands);
   std::shared_ptr<flutter::ContainerLayer> layer_;
+  std::shared_ptr<LayerCommandBuffer> commands_;
 
   FML_FRIEND_MAKE_REF_COUNTED(EngineLayer);
 };
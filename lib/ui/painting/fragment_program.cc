@@ -7,6 +7,7 @@
 #include "flutter/lib/ui/painting/fragment_program.h"
 
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/runtime_effect_cache.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkString.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -37,15 +38,21 @@ void FragmentProgram::RegisterNatives(tonic::DartLibraryNatives* natives) {
        FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
+// Enough for the custom shaders of an app, which are only a few.
+static constexpr size_t kMaxCachedRuntimeEffects = 64;
+
 void FragmentProgram::init(std::string sksl, bool debugPrintSksl) {
-  SkRuntimeEffect::Result result =
-      SkRuntimeEffect::MakeForShader(SkString(sksl));
-  runtime_effect_ = result.effect;
+  // Never destroyed, as the effects may be used until the process exits.
+  static RuntimeEffectCache& effects =
+      *new RuntimeEffectCache(kMaxCachedRuntimeEffects);
+  SkString error;
+  runtime_effect_ = effects.GetEffect(sksl, &error);
 
   if (runtime_effect_ == nullptr) {
-    Dart_ThrowException(tonic::ToDart(
-        std::string("Invalid SkSL:\n") + sksl.c_str() +
-        std::string("\nSkSL Error:\n") + result.errorText.c_str()));
+    Dart_ThrowException(tonic::ToDart(std::string("Invalid SkSL:\n") +
+                                      sksl.c_str() +
+                                      std::string("\nSkSL Error:\n") +
+                                      error.c_str()));
     return;
   }
   if (debugPrintSksl) {
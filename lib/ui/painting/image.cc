@@ -35,7 +35,8 @@ void CanvasImage::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
-CanvasImage::CanvasImage() = default;
+CanvasImage::CanvasImage()
+    : memory_account_(fml::MemoryCategory::kImages) {}
 
 CanvasImage::~CanvasImage() = default;
 
@@ -43,17 +44,29 @@ Dart_Handle CanvasImage::toByteData(int format, Dart_Handle callback) {
   return EncodeImage(this, format, callback);
 }
 
+void CanvasImage::set_image(flutter::SkiaGPUObject<SkImage> image) {
+  image_ = std::move(image);
+  memory_account_.Reset(GetImageByteSize());
+}
+
 void CanvasImage::dispose() {
   image_.reset();
+  memory_account_.Reset();
   ClearDartWrapper();
 }
 
-size_t CanvasImage::GetAllocationSize() const {
+size_t CanvasImage::GetImageByteSize() const {
   if (auto image = image_.skia_object()) {
     const auto& info = image->imageInfo();
     const auto kMipmapOverhead = 4.0 / 3.0;
-    const size_t image_byte_size = info.computeMinByteSize() * kMipmapOverhead;
-    return image_byte_size + sizeof(this);
+    return info.computeMinByteSize() * kMipmapOverhead;
+  }
+  return 0;
+}
+
+size_t CanvasImage::GetAllocationSize() const {
+  if (image_.skia_object()) {
+    return GetImageByteSize() + sizeof(this);
   } else {
     return sizeof(CanvasImage);
   }
@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_H_
 
 #include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/memory/memory_accounting.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -35,9 +36,7 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
   void dispose();
 
   sk_sp<SkImage> image() const { return image_.skia_object(); }
-  void set_image(flutter::SkiaGPUObject<SkImage> image) {
-    image_ = std::move(image);
-  }
+  void set_image(flutter::SkiaGPUObject<SkImage> image);
 
   size_t GetAllocationSize() const override;
 
@@ -47,6 +46,9 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
   CanvasImage();
 
   flutter::SkiaGPUObject<SkImage> image_;
+  fml::ScopedMemoryAccount memory_account_;
+
+  size_t GetImageByteSize() const;
 };
 
 }  // namespace flutter
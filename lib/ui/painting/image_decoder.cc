@@ -5,9 +5,13 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 
 #include <algorithm>
+#include <atomic>
+#include <optional>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkCanvas.h"
 
 namespace flutter {
 
@@ -18,6 +22,8 @@ ImageDecoder::ImageDecoder(
     : runners_(std::move(runners)),
       concurrent_task_runner_(std::move(concurrent_task_runner)),
       io_manager_(std::move(io_manager)),
+      upload_batch_(
+          std::make_shared<UploadBatch>(runners_.GetIOTaskRunner())),
       weak_factory_(this) {
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
@@ -26,9 +32,39 @@ ImageDecoder::ImageDecoder(
 
 ImageDecoder::~ImageDecoder() = default;
 
-static sk_sp<SkImage> ResizeRasterImage(sk_sp<SkImage> image,
-                                        const SkISize& resized_dimensions,
-                                        const fml::tracing::TraceFlow& flow) {
+ImageDecoder::UploadBatch::UploadBatch(fml::RefPtr<fml::TaskRunner> io_runner)
+    : io_runner_(std::move(io_runner)) {}
+
+void ImageDecoder::UploadBatch::Add(fml::closure upload) {
+  {
+    std::scoped_lock lock(mutex_);
+    uploads_.push_back(std::move(upload));
+    if (uploads_.size() > 1) {
+      // The task that runs the batch is already pending.
+      return;
+    }
+  }
+  // The batch keeps itself alive until it has run, even if the decoder is
+  // collected in the meantime.
+  io_runner_->PostTask([batch = shared_from_this()]() { batch->Run(); });
+}
+
+void ImageDecoder::UploadBatch::Run() {
+  std::vector<fml::closure> uploads;
+  {
+    std::scoped_lock lock(mutex_);
+    uploads.swap(uploads_);
+  }
+  TRACE_EVENT1("flutter", "ImageDecoder::UploadBatch", "count",
+               uploads.size());
+  for (auto& upload : uploads) {
+    upload();
+  }
+}
+
+sk_sp<SkImage> ResizeRasterImage(sk_sp<SkImage> image,
+                                 const SkISize& resized_dimensions,
+                                 const fml::tracing::TraceFlow& flow) {
   FML_DCHECK(!image->isTextureBacked());
 
   TRACE_EVENT0("flutter", __FUNCTION__);
@@ -160,7 +196,146 @@ sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
   return ResizeRasterImage(std::move(image), resized_dimensions, flow);
 }
 
-static SkiaGPUObject<SkImage> UploadRasterImage(
+namespace {
+
+// The rows of a concurrent decode, which the workers claim one band at a
+// time.
+class BandDecode {
+ public:
+  BandDecode(ImageDescriptor* descriptor,
+             const SkPixmap& pixmap,
+             int band_height)
+      : descriptor_(descriptor),
+        pixmap_(pixmap),
+        band_height_(band_height),
+        band_count_((pixmap.height() + band_height - 1) / band_height),
+        latch_(band_count_) {}
+
+  // Decodes the bands that no worker has claimed yet.
+  void DecodeBands() {
+    int band;
+    while ((band = next_band_.fetch_add(1)) < band_count_) {
+      // The descriptor and pixels are only accessed by claimed bands, which
+      // the worker that started the decode waits for.
+      const int top = band * band_height_;
+      SkPixmap band_pixmap;
+      if (!failed_ &&
+          (!pixmap_.extractSubset(
+               &band_pixmap,
+               SkIRect::MakeLTRB(0, top, pixmap_.width(),
+                                 std::min(top + band_height_,
+                                          pixmap_.height()))) ||
+           !descriptor_->get_band_pixels(band_pixmap, top))) {
+        failed_ = true;
+      }
+      latch_.CountDown();
+    }
+  }
+
+  // Waits for all of the bands to be decoded. Must be called after
+  // `DecodeBands`, so that no band is left to a worker that hasn't started
+  // yet.
+  bool Wait() {
+    latch_.Wait();
+    return !failed_;
+  }
+
+  int band_count() const { return band_count_; }
+
+ private:
+  ImageDescriptor* const descriptor_;
+  const SkPixmap pixmap_;
+  const int band_height_;
+  const int band_count_;
+  std::atomic<int> next_band_ = 0;
+  std::atomic<bool> failed_ = false;
+  fml::CountDownLatch latch_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BandDecode);
+};
+
+}  // namespace
+
+static constexpr int kPixelsPerDecodeBand = 1 << 20;
+static constexpr int64_t kMinConcurrentDecodePixels = 4 * kPixelsPerDecodeBand;
+
+sk_sp<SkImage> ImageFromConcurrentBands(
+    ImageDescriptor* descriptor,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  const SkImageInfo& info = descriptor->image_info();
+  if (!concurrent_task_runner || !descriptor->can_decode_bands_concurrently() ||
+      static_cast<int64_t>(info.width()) * info.height() <
+          kMinConcurrentDecodePixels) {
+    return nullptr;
+  }
+
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << info.computeMinByteSize() << "B";
+    return nullptr;
+  }
+
+  auto decode = std::make_shared<BandDecode>(
+      descriptor, bitmap.pixmap(),
+      std::max(1, kPixelsPerDecodeBand / info.width()));
+  // The workers that start after the bands have all been claimed return
+  // straight away.
+  for (int i = 1; i < decode->band_count(); i++) {
+    concurrent_task_runner->PostTask([decode]() { decode->DecodeBands(); });
+  }
+  decode->DecodeBands();
+  if (!decode->Wait()) {
+    FML_LOG(ERROR) << "Could not decode the bands of the image.";
+    return nullptr;
+  }
+
+  // Marking this as immutable makes the MakeFromBitmap call share the pixels
+  // instead of copying.
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+sk_sp<SkImage> MakeCompactRasterImage(const sk_sp<SkImage>& image,
+                                      const fml::tracing::TraceFlow& flow) {
+  FML_DCHECK(!image->isTextureBacked());
+
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  if (!image->isOpaque()) {
+    return nullptr;
+  }
+  if (image->colorType() == kRGB_565_SkColorType) {
+    return image;
+  }
+
+  SkBitmap compact_bitmap;
+  if (!compact_bitmap.tryAllocPixels(
+          SkImageInfo::Make(image->dimensions(), kRGB_565_SkColorType,
+                            kOpaque_SkAlphaType, image->refColorSpace()))) {
+    FML_LOG(ERROR) << "Failed to allocate memory for a compact bitmap.";
+    return nullptr;
+  }
+
+  // Dithering hides the banding of the smooth gradients of photos.
+  SkCanvas canvas(compact_bitmap);
+  SkPaint paint;
+  paint.setDither(true);
+  paint.setBlendMode(SkBlendMode::kSrc);
+  canvas.drawImage(image, 0, 0, SkSamplingOptions(), &paint);
+
+  // Marking this as immutable makes the MakeFromBitmap call share the pixels
+  // instead of copying.
+  compact_bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(compact_bitmap);
+}
+
+SkiaGPUObject<SkImage> UploadRasterImage(
     sk_sp<SkImage> image,
     fml::WeakPtr<IOManager> io_manager,
     const fml::tracing::TraceFlow& flow) {
@@ -197,7 +372,19 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
             result = {std::move(texture_image), nullptr};
           })
           .SetIfFalse([&result, context = io_manager->GetResourceContext(),
-                       &pixmap, queue = io_manager->GetSkiaUnrefQueue()] {
+                       &pixmap, &image,
+                       queue = io_manager->GetSkiaUnrefQueue()] {
+            // Compact images are uploaded at full precision on the GPUs that
+            // can't sample them.
+            if (!context->colorTypeSupportedAsImage(pixmap.colorType())) {
+              image = image->makeColorTypeAndColorSpace(kN32_SkColorType,
+                                                        image->refColorSpace());
+              if (!image || !image->peekPixels(&pixmap)) {
+                FML_LOG(ERROR) << "Could not convert the image for upload.";
+                result = {};
+                return;
+              }
+            }
             TRACE_EVENT0("flutter", "MakeCrossContextImageFromPixmap");
             sk_sp<SkImage> texture_image = SkImage::MakeCrossContextFromPixmap(
                 context.get(),  // context
@@ -216,6 +403,30 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+// Wraps an image decoded into memory that the GPU can import in a texture of
+// the resource context. Returns null if the memory can't be imported, in which
+// case a copy of the pixels has to be uploaded instead.
+static sk_sp<SkImage> ImportHardwareBufferImage(
+    HardwareBufferImage& hardware_image,
+    const fml::WeakPtr<IOManager>& io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  auto context = io_manager->GetResourceContext();
+  if (!context || !io_manager->GetSkiaUnrefQueue()) {
+    return nullptr;
+  }
+
+  sk_sp<SkImage> texture_image;
+  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse(
+          [&texture_image, &hardware_image, &context] {
+            texture_image = hardware_image.MakeTextureImage(context.get());
+          }));
+  return texture_image;
+}
+
 void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                           uint32_t target_width,
                           uint32_t target_height,
@@ -266,47 +477,128 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
   concurrent_task_runner_->PostTask(
       fml::MakeCopyable([raw_descriptor,                          //
                          io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
                          result,                                  //
                          target_width = target_width,             //
                          target_height = target_height,           //
+                         cache = decoded_image_cache_,            //
+                         concurrent_task_runner =
+                             concurrent_task_runner_,             //
+                         compact = compact_opaque_images_,        //
+                         defer_upload = defer_image_uploads_,     //
+                         upload_batch = upload_batch_,            //
                          flow = std::move(flow)                   //
   ]() mutable {
+        // Step 0: Look for an image decoded from the same bytes at the same
+        // size.
+        // On Worker.
+
+        auto data = raw_descriptor->data();
+        std::optional<DecodedImageCache::Key> cache_key;
+        if (cache) {
+          cache_key = DecodedImageCache::MakeKey(
+              *data, raw_descriptor->image_info(), raw_descriptor->row_bytes(),
+              target_width, target_height);
+          auto cached = cache->Get(*cache_key, *data);
+          if (cached.skia_object()) {
+            result(std::move(cached), std::move(flow));
+            return;
+          }
+        }
+
         // Step 1: Decompress the image.
         // On Worker.
 
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
-
-        if (!decompressed) {
-          FML_DLOG(ERROR) << "Could not decompress image.";
-          result({}, std::move(flow));
-          return;
+        // Images that the generator can decode straight into memory the GPU
+        // can import don't have to be uploaded in step 2.
+        std::unique_ptr<HardwareBufferImage> hardware_image;
+        if (raw_descriptor->is_compressed() &&
+            !raw_descriptor->should_resize(target_width, target_height)) {
+          hardware_image = raw_descriptor->decode_to_hardware_buffer();
+        }
+
+        // Large images are decoded in bands on several workers.
+        sk_sp<SkImage> decompressed;
+        if (!hardware_image && raw_descriptor->is_compressed() &&
+            !raw_descriptor->should_resize(target_width, target_height)) {
+          decompressed = ImageFromConcurrentBands(
+              raw_descriptor, concurrent_task_runner, flow);
+        }
+
+        if (!hardware_image && !decompressed) {
+          decompressed = raw_descriptor->is_compressed()
+                             ? ImageFromCompressedData(raw_descriptor,  //
+                                                       target_width,    //
+                                                       target_height,   //
+                                                       flow)
+                             : ImageFromDecompressedData(raw_descriptor,  //
+                                                         target_width,    //
+                                                         target_height,   //
+                                                         flow);
+
+          if (!decompressed) {
+            FML_DLOG(ERROR) << "Could not decompress image.";
+            result({}, std::move(flow));
+            return;
+          }
+        }
+
+        if (compact && decompressed) {
+          if (auto compact_image = MakeCompactRasterImage(decompressed, flow)) {
+            decompressed = std::move(compact_image);
+          }
         }
 
         // Step 2: Update the image to the GPU.
         // On IO Thread.
 
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
+        upload_batch->Add(fml::MakeCopyable([io_manager, decompressed, result,
+                                             cache, cache_key, defer_upload,
+                                             hardware_image =
+                                                 std::move(hardware_image),
+                                             data = std::move(data),
+                                             flow =
+                                                 std::move(flow)]() mutable {
           if (!io_manager) {
             FML_DLOG(ERROR) << "Could not acquire IO manager.";
             result({}, std::move(flow));
             return;
           }
 
+          auto add_to_cache = [&](const sk_sp<SkImage>& image) {
+            if (cache) {
+              cache->Put(*cache_key, std::move(data), image,
+                         io_manager->GetSkiaUnrefQueue());
+            }
+          };
+
+          if (hardware_image) {
+            auto texture_image =
+                ImportHardwareBufferImage(*hardware_image, io_manager, flow);
+            if (texture_image) {
+              add_to_cache(texture_image);
+              result(
+                  {std::move(texture_image), io_manager->GetSkiaUnrefQueue()},
+                  std::move(flow));
+              return;
+            }
+
+            // Without a GPU that can import the memory, copy the pixels like
+            // any other decoded image.
+            decompressed = hardware_image->MakeRasterImage();
+            hardware_image.reset();
+            if (!decompressed) {
+              FML_DLOG(ERROR) << "Could not read the pixels of the image.";
+              result({}, std::move(flow));
+              return;
+            }
+          }
+
           // If the IO manager does not have a resource context, the caller
           // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
+          // Either way, just return the image as-is. Deferred images are
+          // uploaded by the context they are first drawn with instead.
+          if (defer_upload || !io_manager->GetResourceContext()) {
+            add_to_cache(decompressed);
             result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
                    std::move(flow));
             return;
@@ -322,13 +614,40 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
           }
 
           // Finally, all done.
+          add_to_cache(uploaded.skia_object());
           result(std::move(uploaded), std::move(flow));
         }));
       }));
 }
 
+fml::RefPtr<IncrementalImageDecode> ImageDecoder::DecodeIncrementally(
+    uint32_t target_width,
+    uint32_t target_height,
+    IncrementalImageDecode::Result result) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  return fml::MakeRefCounted<IncrementalImageDecode>(
+      runners_, concurrent_task_runner_, io_manager_, target_width,
+      target_height, std::move(result));
+}
+
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
 
+void ImageDecoder::SetDecodedImageCache(
+    std::shared_ptr<DecodedImageCache> cache) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  decoded_image_cache_ = std::move(cache);
+}
+
+void ImageDecoder::SetCompactOpaqueImages(bool compact_opaque_images) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  compact_opaque_images_ = compact_opaque_images;
+}
+
+void ImageDecoder::SetDeferImageUploads(bool defer_image_uploads) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  defer_image_uploads_ = defer_image_uploads;
+}
+
 }  // namespace flutter
@@ -6,7 +6,9 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/skia_gpu_object.h"
@@ -15,7 +17,9 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/incremental_image_decode.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -50,12 +54,56 @@ class ImageDecoder {
               uint32_t target_height,
               const ImageResult& result);
 
+  // Starts decoding an image whose encoded bytes are appended to the returned
+  // decode as they are received. The result is invoked on the UI thread with
+  // the rows decoded so far and then with the complete image.
+  fml::RefPtr<IncrementalImageDecode> DecodeIncrementally(
+      uint32_t target_width,
+      uint32_t target_height,
+      IncrementalImageDecode::Result result);
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
+  // Sets the cache that the decoded images are looked up in and added to,
+  // or null to decode every image. Must be called on the UI thread.
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  // Sets whether the decoded opaque images are converted to 16 bits per pixel
+  // before they are uploaded. Must be called on the UI thread.
+  void SetCompactOpaqueImages(bool compact_opaque_images);
+
+  // Sets whether the decoded images are returned in memory instead of being
+  // uploaded on the IO thread, in which case they are uploaded when they are
+  // first drawn. Must be called on the UI thread.
+  void SetDeferImageUploads(bool defer_image_uploads);
+
  private:
+  // Runs the uploads of the images decoded while the IO thread is busy in a
+  // single task, instead of a task each.
+  class UploadBatch : public std::enable_shared_from_this<UploadBatch> {
+   public:
+    explicit UploadBatch(fml::RefPtr<fml::TaskRunner> io_runner);
+
+    // Adds an upload to the next batch. May be called on any thread.
+    void Add(fml::closure upload);
+
+   private:
+    void Run();
+
+    const fml::RefPtr<fml::TaskRunner> io_runner_;
+    std::mutex mutex_;
+    std::vector<fml::closure> uploads_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(UploadBatch);
+  };
+
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+  bool compact_opaque_images_ = false;
+  bool defer_image_uploads_ = false;
+  std::shared_ptr<UploadBatch> upload_batch_;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
 };
@@ -65,6 +113,30 @@ sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
                                        uint32_t target_height,
                                        const fml::tracing::TraceFlow& flow);
 
+// Decodes a large image at its full size in bands of rows on several workers
+// of the concurrent task runner, including the calling one. Returns null if
+// the image can't or shouldn't be decoded concurrently.
+sk_sp<SkImage> ImageFromConcurrentBands(
+    ImageDescriptor* descriptor,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+    const fml::tracing::TraceFlow& flow);
+
+// Scales a raster image to the given dimensions on the calling thread.
+sk_sp<SkImage> ResizeRasterImage(sk_sp<SkImage> image,
+                                 const SkISize& resized_dimensions,
+                                 const fml::tracing::TraceFlow& flow);
+
+// Converts an opaque raster image to 16 bits per pixel, dithering its colors.
+// Returns null if the image has transparent pixels or can't be converted.
+sk_sp<SkImage> MakeCompactRasterImage(const sk_sp<SkImage>& image,
+                                      const fml::tracing::TraceFlow& flow);
+
+// Uploads a raster image with the resource context of the IO manager. Must be
+// called on the IO thread.
+SkiaGPUObject<SkImage> UploadRasterImage(sk_sp<SkImage> image,
+                                         fml::WeakPtr<IOManager> io_manager,
+                                         const fml::tracing::TraceFlow& flow);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/image_decoder.h"
 
+#include <atomic>
+
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -261,6 +263,59 @@ TEST_F(ImageDecoderFixtureTest, ValidImageResultsInSuccess) {
   latch.Wait();
 }
 
+TEST_F(ImageDecoderFixtureTest, DeferredUploadsResultInRasterImages) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<TestIOManager> io_manager;
+
+  auto release_io_manager = [&]() {
+    io_manager.reset();
+    latch.Signal();
+  };
+  auto decode_image = [&]() {
+    std::unique_ptr<ImageDecoder> image_decoder =
+        std::make_unique<ImageDecoder>(runners, loop->GetTaskRunner(),
+                                       io_manager->GetWeakIOManager());
+    image_decoder->SetDeferImageUploads(true);
+
+    auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+    ASSERT_TRUE(data);
+
+    ImageGeneratorRegistry registry;
+    std::shared_ptr<ImageGenerator> generator =
+        registry.CreateCompatibleGenerator(data);
+    ASSERT_TRUE(generator);
+
+    auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+        std::move(data), std::move(generator));
+
+    ImageDecoder::ImageResult callback = [&](SkiaGPUObject<SkImage> image) {
+      ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+      ASSERT_TRUE(image.skia_object());
+      EXPECT_FALSE(image.skia_object()->isTextureBacked());
+      runners.GetIOTaskRunner()->PostTask(release_io_manager);
+    };
+    image_decoder->Decode(descriptor, descriptor->width(), descriptor->height(),
+                          callback);
+  };
+
+  auto setup_io_manager_and_decode = [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+    runners.GetUITaskRunner()->PostTask(decode_image);
+  };
+
+  runners.GetIOTaskRunner()->PostTask(setup_io_manager_and_decode);
+  latch.Wait();
+}
+
 TEST_F(ImageDecoderFixtureTest, ExifDataIsRespectedOnDecode) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   TaskRunners runners(GetCurrentTestName(),         // label
@@ -377,6 +432,319 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithoutAGPUContext) {
   latch.Wait();
 }
 
+/// A "hardware buffer" that is a raster image.
+class TestHardwareBufferImage : public HardwareBufferImage {
+ public:
+  TestHardwareBufferImage(sk_sp<SkImage> image,
+                          std::atomic_bool* made_texture_image,
+                          std::atomic_bool* made_raster_image)
+      : image_(std::move(image)),
+        made_texture_image_(made_texture_image),
+        made_raster_image_(made_raster_image) {}
+
+  // |HardwareBufferImage|
+  sk_sp<SkImage> MakeTextureImage(GrDirectContext* context) override {
+    *made_texture_image_ = true;
+    return image_->makeTextureImage(context);
+  }
+
+  // |HardwareBufferImage|
+  sk_sp<SkImage> MakeRasterImage() override {
+    *made_raster_image_ = true;
+    return image_;
+  }
+
+ private:
+  sk_sp<SkImage> image_;
+  std::atomic_bool* made_texture_image_;
+  std::atomic_bool* made_raster_image_;
+};
+
+/// An image generator that decodes into a `TestHardwareBufferImage`, and
+/// records how its image is decoded.
+class HardwareBufferImageGenerator : public ImageGenerator {
+ public:
+  explicit HardwareBufferImageGenerator(
+      std::shared_ptr<ImageGenerator> generator)
+      : generator_(std::move(generator)) {}
+
+  const SkImageInfo& GetInfo() override { return generator_->GetInfo(); }
+
+  unsigned int GetFrameCount() const override { return 1; }
+
+  unsigned int GetPlayCount() const override { return 1; }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) const override {
+    return {std::nullopt, 0, SkCodecAnimation::DisposalMethod::kKeep};
+  }
+
+  SkISize GetScaledDimensions(float scale) override {
+    return generator_->GetScaledDimensions(scale);
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    did_get_pixels = true;
+    return generator_->GetPixels(info, pixels, row_bytes);
+  }
+
+  std::unique_ptr<HardwareBufferImage> DecodeToHardwareBuffer() override {
+    return std::make_unique<TestHardwareBufferImage>(
+        generator_->GetImage(), &made_texture_image, &made_raster_image);
+  }
+
+  std::atomic_bool did_get_pixels = false;
+  std::atomic_bool made_texture_image = false;
+  std::atomic_bool made_raster_image = false;
+
+ private:
+  std::shared_ptr<ImageGenerator> generator_;
+};
+
+TEST_F(ImageDecoderFixtureTest, HardwareBufferImagesAreNotUploaded) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<TestIOManager> io_manager;
+  std::shared_ptr<HardwareBufferImageGenerator> generator;
+
+  auto release_io_manager = [&]() {
+    io_manager.reset();
+    latch.Signal();
+  };
+  auto decode_image = [&]() {
+    std::unique_ptr<ImageDecoder> image_decoder =
+        std::make_unique<ImageDecoder>(runners, loop->GetTaskRunner(),
+                                       io_manager->GetWeakIOManager());
+
+    auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+    ASSERT_TRUE(data);
+
+    ImageGeneratorRegistry registry;
+    generator = std::make_shared<HardwareBufferImageGenerator>(
+        registry.CreateCompatibleGenerator(data));
+
+    auto descriptor =
+        fml::MakeRefCounted<ImageDescriptor>(std::move(data), generator);
+
+    ImageDecoder::ImageResult callback = [&](SkiaGPUObject<SkImage> image) {
+      ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+      ASSERT_TRUE(image.skia_object());
+      EXPECT_TRUE(image.skia_object()->isTextureBacked());
+      EXPECT_TRUE(generator->made_texture_image);
+      EXPECT_FALSE(generator->made_raster_image);
+      EXPECT_FALSE(generator->did_get_pixels);
+      runners.GetIOTaskRunner()->PostTask(release_io_manager);
+    };
+    image_decoder->Decode(descriptor, descriptor->width(), descriptor->height(),
+                          callback);
+  };
+
+  auto setup_io_manager_and_decode = [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+    runners.GetUITaskRunner()->PostTask(decode_image);
+  };
+
+  runners.GetIOTaskRunner()->PostTask(setup_io_manager_and_decode);
+  latch.Wait();
+}
+
+TEST_F(ImageDecoderFixtureTest,
+       HardwareBufferImagesAreCopiedWithoutAGPUContext) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<TestIOManager> io_manager;
+  std::shared_ptr<HardwareBufferImageGenerator> generator;
+
+  auto release_io_manager = [&]() {
+    io_manager.reset();
+    latch.Signal();
+  };
+  auto decode_image = [&]() {
+    std::unique_ptr<ImageDecoder> image_decoder =
+        std::make_unique<ImageDecoder>(runners, loop->GetTaskRunner(),
+                                       io_manager->GetWeakIOManager());
+
+    auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+    ASSERT_TRUE(data);
+
+    ImageGeneratorRegistry registry;
+    generator = std::make_shared<HardwareBufferImageGenerator>(
+        registry.CreateCompatibleGenerator(data));
+
+    auto descriptor =
+        fml::MakeRefCounted<ImageDescriptor>(std::move(data), generator);
+
+    ImageDecoder::ImageResult callback = [&](SkiaGPUObject<SkImage> image) {
+      ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+      ASSERT_TRUE(image.skia_object());
+      EXPECT_FALSE(image.skia_object()->isTextureBacked());
+      EXPECT_FALSE(generator->made_texture_image);
+      EXPECT_TRUE(generator->made_raster_image);
+      runners.GetIOTaskRunner()->PostTask(release_io_manager);
+    };
+    image_decoder->Decode(descriptor, descriptor->width(), descriptor->height(),
+                          callback);
+  };
+
+  auto setup_io_manager_and_decode = [&]() {
+    io_manager =
+        std::make_unique<TestIOManager>(runners.GetIOTaskRunner(), false);
+    runners.GetUITaskRunner()->PostTask(decode_image);
+  };
+
+  runners.GetIOTaskRunner()->PostTask(setup_io_manager_and_decode);
+  latch.Wait();
+}
+
+/// An image generator that fills each band of rows with the index of its
+/// first row, and records the bands it decodes.
+class BandImageGenerator : public ImageGenerator {
+ public:
+  explicit BandImageGenerator(const SkISize& size)
+      : info_(SkImageInfo::MakeN32Premul(size)) {}
+
+  const SkImageInfo& GetInfo() override { return info_; }
+
+  unsigned int GetFrameCount() const override { return 1; }
+
+  unsigned int GetPlayCount() const override { return 1; }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) const override {
+    return {std::nullopt, 0, SkCodecAnimation::DisposalMethod::kKeep};
+  }
+
+  SkISize GetScaledDimensions(float scale) override {
+    return info_.dimensions();
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    return false;
+  }
+
+  bool CanDecodeBandsConcurrently() const override { return true; }
+
+  bool GetBandPixels(const SkPixmap& band, int top) override {
+    EXPECT_EQ(band.width(), info_.width());
+    bands_decoded++;
+    rows_decoded += band.height();
+    for (int y = 0; y < band.height(); y++) {
+      std::fill_n(band.writable_addr32(0, y), band.width(),
+                  static_cast<uint32_t>(top));
+    }
+    return !fail_bands;
+  }
+
+  std::atomic_int bands_decoded = 0;
+  std::atomic_int rows_decoded = 0;
+  bool fail_bands = false;
+
+ private:
+  const SkImageInfo info_;
+};
+
+TEST(ImageDecoderTest, LargeImagesAreDecodedInConcurrentBands) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto generator =
+      std::make_shared<BandImageGenerator>(SkISize::Make(1024, 4100));
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      SkData::MakeWithCString("bands"), generator);
+
+  auto image = ImageFromConcurrentBands(
+      descriptor.get(), loop->GetTaskRunner(), fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->dimensions(), SkISize::Make(1024, 4100));
+  // The last band has the rows that are left over.
+  ASSERT_EQ(generator->bands_decoded, 5);
+  ASSERT_EQ(generator->rows_decoded, 4100);
+
+  SkPixmap pixmap;
+  ASSERT_TRUE(image->peekPixels(&pixmap));
+  ASSERT_EQ(*pixmap.addr32(1023, 0), 0u);
+  ASSERT_EQ(*pixmap.addr32(0, 1023), 0u);
+  ASSERT_EQ(*pixmap.addr32(0, 1024), 1024u);
+  ASSERT_EQ(*pixmap.addr32(0, 4099), 4096u);
+}
+
+TEST(ImageDecoderTest, SmallImagesAreNotDecodedInConcurrentBands) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto generator =
+      std::make_shared<BandImageGenerator>(SkISize::Make(1024, 1024));
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      SkData::MakeWithCString("bands"), generator);
+
+  ASSERT_FALSE(ImageFromConcurrentBands(
+      descriptor.get(), loop->GetTaskRunner(), fml::tracing::TraceFlow("")));
+  ASSERT_EQ(generator->bands_decoded, 0);
+}
+
+TEST(ImageDecoderTest, FailedBandsFailTheConcurrentDecode) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto generator =
+      std::make_shared<BandImageGenerator>(SkISize::Make(2048, 2048));
+  generator->fail_bands = true;
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      SkData::MakeWithCString("bands"), generator);
+
+  ASSERT_FALSE(ImageFromConcurrentBands(
+      descriptor.get(), loop->GetTaskRunner(), fml::tracing::TraceFlow("")));
+}
+
+TEST(ImageDecoderTest, OnlyFullSizeJPEGsAreDecodedInBands) {
+  ImageGeneratorRegistry registry;
+  auto jpeg = registry.CreateCompatibleGenerator(
+      OpenFixtureAsSkData("DashInNooglerHat.jpg"));
+  auto png =
+      registry.CreateCompatibleGenerator(OpenFixtureAsSkData("Horizontal.png"));
+  ASSERT_TRUE(jpeg);
+  ASSERT_TRUE(png);
+  ASSERT_TRUE(jpeg->CanDecodeBandsConcurrently());
+  ASSERT_FALSE(png->CanDecodeBandsConcurrently());
+
+  // The bands of a JPEG match its full decode.
+  const SkImageInfo info = jpeg->GetInfo();
+  SkBitmap expected;
+  ASSERT_TRUE(expected.tryAllocPixels(info));
+  ASSERT_TRUE(jpeg->GetPixels(info, expected.getPixels(), expected.rowBytes()));
+  SkBitmap bands;
+  ASSERT_TRUE(bands.tryAllocPixels(info));
+  const int band_height = info.height() / 3;
+  for (int top = 0; top < info.height(); top += band_height) {
+    SkPixmap band;
+    ASSERT_TRUE(bands.pixmap().extractSubset(
+        &band, SkIRect::MakeLTRB(0, top, info.width(),
+                                 std::min(top + band_height, info.height()))));
+    ASSERT_TRUE(jpeg->GetBandPixels(band, top));
+  }
+  ASSERT_EQ(memcmp(expected.getPixels(), bands.getPixels(),
+                   info.computeMinByteSize()),
+            0);
+}
+
 TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   const auto image_dimensions =
       SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
@@ -578,6 +946,76 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
             SkISize::Make(6, 2));
 }
 
+TEST(ImageDecoderTest, ImagesThatCodecsCannotScaleAreSubsampled) {
+  // PNGs are only scaled by subsampling.
+  auto data = OpenFixtureAsSkData("Horizontal.png");
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  ASSERT_EQ(generator->GetInfo().dimensions(), SkISize::Make(300, 100));
+
+  // Decoded at no less than twice the target size.
+  const SkISize scaled_dimensions = generator->GetScaledDimensions(0.2);
+  ASSERT_EQ(scaled_dimensions, SkISize::Make(150, 50));
+  ASSERT_EQ(generator->GetScaledDimensions(0.5), SkISize::Make(300, 100));
+
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(
+      generator->GetInfo().makeDimensions(scaled_dimensions)));
+  const auto& pixmap = bitmap.pixmap();
+  ASSERT_TRUE(generator->GetPixels(pixmap.info(), pixmap.writable_addr(),
+                                   pixmap.rowBytes()));
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+  ASSERT_EQ(ImageFromCompressedData(descriptor.get(), 60, 20,
+                                    fml::tracing::TraceFlow(""))
+                ->dimensions(),
+            SkISize::Make(60, 20));
+}
+
+TEST(ImageDecoderTest, OpaqueImagesAreMadeCompact) {
+  auto image = SkImage::MakeFromEncoded(OpenFixtureAsSkData("Horizontal.jpg"))
+                   ->makeRasterImage();
+  ASSERT_TRUE(image);
+  ASSERT_TRUE(image->isOpaque());
+
+  auto compact_image =
+      MakeCompactRasterImage(image, fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(compact_image);
+  ASSERT_EQ(compact_image->colorType(), kRGB_565_SkColorType);
+  ASSERT_EQ(compact_image->dimensions(), image->dimensions());
+  ASSERT_EQ(compact_image->imageInfo().computeMinByteSize() * 2,
+            image->imageInfo().computeMinByteSize());
+
+  // The dithered colors are close to the original ones.
+  SkBitmap original;
+  SkBitmap compact;
+  ASSERT_TRUE(original.tryAllocN32Pixels(image->width(), image->height()));
+  ASSERT_TRUE(compact.tryAllocN32Pixels(image->width(), image->height()));
+  ASSERT_TRUE(image->readPixels(original.pixmap(), 0, 0));
+  ASSERT_TRUE(compact_image->readPixels(compact.pixmap(), 0, 0));
+  const SkColor original_color = original.getColor(300, 100);
+  const SkColor compact_color = compact.getColor(300, 100);
+  EXPECT_NEAR(SkColorGetR(original_color), SkColorGetR(compact_color), 12);
+  EXPECT_NEAR(SkColorGetG(original_color), SkColorGetG(compact_color), 12);
+  EXPECT_NEAR(SkColorGetB(original_color), SkColorGetB(compact_color), 12);
+}
+
+TEST(ImageDecoderTest, TransparentImagesAreNotMadeCompact) {
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocN32Pixels(10, 10));
+  bitmap.eraseColor(SK_ColorTRANSPARENT);
+  bitmap.setImmutable();
+  auto image = SkImage::MakeFromBitmap(bitmap);
+  ASSERT_FALSE(image->isOpaque());
+
+  ASSERT_FALSE(MakeCompactRasterImage(image, fml::tracing::TraceFlow("")));
+}
+
 TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   auto data = OpenFixtureAsSkData("Horizontal.jpg");
 
@@ -765,5 +1203,212 @@ TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDidAccessGpuDisabledSyncSwitch) {
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+/// An image generator that records how many times each of its frames is
+/// decoded.
+class FrameCountingImageGenerator : public ImageGenerator {
+ public:
+  explicit FrameCountingImageGenerator(
+      std::shared_ptr<ImageGenerator> generator)
+      : generator_(std::move(generator)),
+        frame_decodes_(generator_->GetFrameCount()) {}
+
+  const SkImageInfo& GetInfo() override { return generator_->GetInfo(); }
+
+  unsigned int GetFrameCount() const override {
+    return generator_->GetFrameCount();
+  }
+
+  unsigned int GetPlayCount() const override {
+    return generator_->GetPlayCount();
+  }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) const override {
+    return generator_->GetFrameInfo(frame_index);
+  }
+
+  SkISize GetScaledDimensions(float scale) override {
+    return generator_->GetScaledDimensions(scale);
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    frame_decodes_[frame_index]++;
+    return generator_->GetPixels(info, pixels, row_bytes, frame_index,
+                                 prior_frame);
+  }
+
+  // Only accessed on the IO thread, where the frames are decoded.
+  const std::vector<int>& frame_decodes() const { return frame_decodes_; }
+
+ private:
+  std::shared_ptr<ImageGenerator> generator_;
+  std::vector<int> frame_decodes_;
+};
+
+TEST_F(ImageDecoderFixtureTest,
+       MultiFrameCodecDecodesAheadAndCachesTheFramesOfLoops) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+
+  auto gif_mapping = OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  auto generator = std::make_shared<FrameCountingImageGenerator>(
+      registry.CreateCompatibleGenerator(gif_mapping));
+  const int frame_count = generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1);
+  ASSERT_EQ(generator->GetPlayCount(), 2u);
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  std::unique_ptr<TestIOManager> io_manager;
+  fml::RefPtr<MultiFrameCodec> codec;
+
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath(),
+                                      io_manager->GetWeakIOManager());
+
+  PostTaskSync(runners.GetUITaskRunner(), [&]() {
+    codec = fml::MakeRefCounted<MultiFrameCodec>(generator);
+  });
+
+  auto get_next_frame = [&]() {
+    PostTaskSync(runners.GetUITaskRunner(), [&]() {
+      EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+        Dart_Handle closure = Dart_GetField(
+            Dart_RootLibrary(), Dart_NewStringFromCString("frameCallback"));
+        if (Dart_IsError(closure) || !Dart_IsClosure(closure)) {
+          return false;
+        }
+        codec->getNextFrame(closure);
+        return true;
+      }));
+    });
+    // The first task decodes the requested frame and posts the decode of the
+    // next one, which the second task waits for.
+    PostTaskSync(runners.GetIOTaskRunner(), [] {});
+    PostTaskSync(runners.GetIOTaskRunner(), [] {});
+  };
+
+  get_next_frame();
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    EXPECT_EQ(generator->frame_decodes()[0], 1);
+    // Decoded ahead of its request.
+    EXPECT_EQ(generator->frame_decodes()[1], 1);
+  });
+
+  // Both loops of the animation.
+  for (int i = 1; i < 2 * frame_count; i++) {
+    get_next_frame();
+  }
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    for (int decodes : generator->frame_decodes()) {
+      EXPECT_EQ(decodes, 1);
+    }
+  });
+
+  isolate = nullptr;
+  PostTaskSync(runners.GetUITaskRunner(), [&]() { codec = nullptr; });
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+}
+
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecsOfTheSameBytesShareFrames) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+
+  auto gif_mapping = OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  auto first_generator = std::make_shared<FrameCountingImageGenerator>(
+      registry.CreateCompatibleGenerator(gif_mapping));
+  auto second_generator = std::make_shared<FrameCountingImageGenerator>(
+      registry.CreateCompatibleGenerator(gif_mapping));
+  const int frame_count = first_generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1);
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  std::unique_ptr<TestIOManager> io_manager;
+  fml::RefPtr<MultiFrameCodec> first_codec;
+  fml::RefPtr<MultiFrameCodec> second_codec;
+
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath(),
+                                      io_manager->GetWeakIOManager());
+
+  PostTaskSync(runners.GetUITaskRunner(), [&]() {
+    first_codec =
+        fml::MakeRefCounted<MultiFrameCodec>(first_generator, gif_mapping);
+    // A copy of the bytes, like those of another load of the same image.
+    second_codec = fml::MakeRefCounted<MultiFrameCodec>(
+        second_generator,
+        SkData::MakeWithCopy(gif_mapping->data(), gif_mapping->size()));
+  });
+
+  auto get_next_frame = [&](MultiFrameCodec* codec) {
+    PostTaskSync(runners.GetUITaskRunner(), [&]() {
+      EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+        Dart_Handle closure = Dart_GetField(
+            Dart_RootLibrary(), Dart_NewStringFromCString("frameCallback"));
+        if (Dart_IsError(closure) || !Dart_IsClosure(closure)) {
+          return false;
+        }
+        codec->getNextFrame(closure);
+        return true;
+      }));
+    });
+    PostTaskSync(runners.GetIOTaskRunner(), [] {});
+    PostTaskSync(runners.GetIOTaskRunner(), [] {});
+  };
+
+  // The second codec starts one loop behind the first one.
+  for (int i = 0; i < frame_count; i++) {
+    get_next_frame(first_codec.get());
+  }
+  for (int i = 0; i < frame_count; i++) {
+    get_next_frame(first_codec.get());
+    get_next_frame(second_codec.get());
+  }
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    for (int decodes : first_generator->frame_decodes()) {
+      EXPECT_EQ(decodes, 1);
+    }
+    for (int decodes : second_generator->frame_decodes()) {
+      EXPECT_EQ(decodes, 0);
+    }
+  });
+
+  isolate = nullptr;
+  PostTaskSync(runners.GetUITaskRunner(), [&]() {
+    first_codec = nullptr;
+    second_codec = nullptr;
+  });
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
@@ -106,6 +107,28 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Decodes this image at its full size into memory that the GPU can
+  ///         import, if its `ImageGenerator` can.
+  /// @see    `ImageGenerator::DecodeToHardwareBuffer`
+  std::unique_ptr<HardwareBufferImage> decode_to_hardware_buffer() const {
+    return generator_ ? generator_->DecodeToHardwareBuffer() : nullptr;
+  }
+
+  /// @brief  Whether the bands of rows of this image can be decoded on
+  ///         several threads at once.
+  /// @see    `ImageGenerator::CanDecodeBandsConcurrently`
+  bool can_decode_bands_concurrently() const {
+    return generator_ && generator_->CanDecodeBandsConcurrently();
+  }
+
+  /// @brief  Decodes the rows of this image from `top` into `band`. May be
+  ///         called on several threads at once.
+  /// @see    `ImageGenerator::GetBandPixels`
+  bool get_band_pixels(const SkPixmap& band, int top) const {
+    FML_DCHECK(generator_);
+    return generator_->GetBandPixels(band, top);
+  }
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -90,10 +90,16 @@ void ConvertImageToRaster(
     return;
   }
 
-  if (sk_sp<SkImage> raster_image = image->makeRasterImage()) {
-    // The image can be converted to a raster image.
-    encode_task(raster_image);
-    return;
+  // Images rendered by the rasterizer (see |Picture::toImages|) are textures
+  // of the onscreen context, which must not be used on this thread.
+  const bool is_raster_texture =
+      image->isTextureBacked() && !image->isValid(resource_context.get());
+  if (!is_raster_texture) {
+    if (sk_sp<SkImage> raster_image = image->makeRasterImage()) {
+      // The image can be converted to a raster image.
+      encode_task(raster_image);
+      return;
+    }
   }
 
   // Cross-context images do not support makeRasterImage. Convert these images
@@ -121,9 +127,13 @@ void ConvertImageToRaster(
   });
 }
 
+// Returns the pixels of the raster image in the given color and alpha types.
+// If |owns_pixels|, no one else references the pixels of the image, which are
+// then returned without copying them when they are already in those types.
 sk_sp<SkData> CopyImageByteData(sk_sp<SkImage> raster_image,
                                 SkColorType color_type,
-                                SkAlphaType alpha_type) {
+                                SkAlphaType alpha_type,
+                                bool owns_pixels) {
   FML_DCHECK(raster_image);
 
   SkPixmap pixmap;
@@ -135,30 +145,36 @@ sk_sp<SkData> CopyImageByteData(sk_sp<SkImage> raster_image,
 
   // The color types already match. No need to swizzle. Return early.
   if (pixmap.colorType() == color_type && pixmap.alphaType() == alpha_type) {
+    if (owns_pixels && pixmap.rowBytes() == pixmap.info().minRowBytes()) {
+      // The data keeps the image, and so its pixels, alive.
+      const size_t size = pixmap.computeByteSize();
+      return SkData::MakeWithProc(
+          pixmap.addr(), size,
+          [](const void* pixels, void* image) {
+            static_cast<SkImage*>(image)->unref();
+          },
+          raster_image.release());
+    }
     return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
   }
 
-  // Perform swizzle if the type doesnt match the specification.
-  auto surface = SkSurface::MakeRaster(
+  // Perform swizzle if the type doesnt match the specification, straight into
+  // the returned data.
+  const SkImageInfo info =
       SkImageInfo::Make(raster_image->width(), raster_image->height(),
-                        color_type, alpha_type, nullptr));
-
-  if (!surface) {
-    FML_LOG(ERROR) << "Could not set up the surface for swizzle.";
-    return nullptr;
-  }
-
-  surface->writePixels(pixmap, 0, 0);
-
-  if (!surface->peekPixels(&pixmap)) {
-    FML_LOG(ERROR) << "Pixel address is not available.";
+                        color_type, alpha_type, nullptr);
+  sk_sp<SkData> data = SkData::MakeUninitialized(info.computeMinByteSize());
+  if (!data || !pixmap.readPixels(info, data->writable_data(),
+                                  info.minRowBytes())) {
+    FML_LOG(ERROR) << "Could not swizzle the pixels of the raster image.";
     return nullptr;
   }
-
-  return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
+  return data;
 }
 
-sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
+sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image,
+                          ImageByteFormat format,
+                          bool owns_pixels) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
   if (!raster_image) {
@@ -178,15 +194,15 @@ sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
     } break;
     case kRawRGBA: {
       return CopyImageByteData(raster_image, kRGBA_8888_SkColorType,
-                               kPremul_SkAlphaType);
+                               kPremul_SkAlphaType, owns_pixels);
     } break;
     case kRawStraightRGBA: {
       return CopyImageByteData(raster_image, kRGBA_8888_SkColorType,
-                               kUnpremul_SkAlphaType);
+                               kUnpremul_SkAlphaType, owns_pixels);
     } break;
     case kRawUnmodified: {
       return CopyImageByteData(raster_image, raster_image->colorType(),
-                               raster_image->alphaType());
+                               raster_image->alphaType(), owns_pixels);
     } break;
   }
 
@@ -201,6 +217,7 @@ void EncodeImageAndInvokeDataCallback(
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
     fml::RefPtr<fml::TaskRunner> io_task_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     fml::WeakPtr<GrDirectContext> resource_context,
     fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
     const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch) {
@@ -209,13 +226,28 @@ void EncodeImageAndInvokeDataCallback(
         InvokeDataCallback(std::move(callback), std::move(encoded));
       });
 
+  // Raster images that were made for this encode, rather than the image
+  // itself, are not referenced by anyone else.
   auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](sk_sp<SkImage> raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
-    ui_task_runner->PostTask([callback_task = std::move(callback_task),
-                              encoded = std::move(encoded)]() mutable {
-      callback_task(std::move(encoded));
-    });
+                      ui_task_runner, concurrent_task_runner,
+                      source_image = image.get()](sk_sp<SkImage> raster_image) {
+    const bool owns_pixels = raster_image && raster_image.get() != source_image;
+    auto encode = [callback_task, format, ui_task_runner, owns_pixels,
+                   raster_image = std::move(raster_image)]() mutable {
+      sk_sp<SkData> encoded =
+          EncodeImage(std::move(raster_image), format, owns_pixels);
+      ui_task_runner->PostTask([callback_task = std::move(callback_task),
+                                encoded = std::move(encoded)]() mutable {
+        callback_task(std::move(encoded));
+      });
+    };
+    // The raster images can be encoded on any thread, which frees the IO
+    // thread for the uploads and encodes of the other images.
+    if (concurrent_task_runner) {
+      concurrent_task_runner->PostTask(std::move(encode));
+    } else {
+      encode();
+    }
   };
 
   ConvertImageToRaster(std::move(image), encode_task, raster_task_runner,
@@ -248,13 +280,16 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_task_runner =
+           UIDartState::Current()->GetConcurrentTaskRunner(),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate =
            UIDartState::Current()->GetSnapshotDelegate()]() mutable {
         EncodeImageAndInvokeDataCallback(
             std::move(image), std::move(callback), image_format,
             std::move(ui_task_runner), std::move(raster_task_runner),
-            std::move(io_task_runner), io_manager->GetResourceContext(),
+            std::move(io_task_runner), std::move(concurrent_task_runner),
+            io_manager->GetResourceContext(),
             std::move(snapshot_delegate),
             io_manager->GetIsGpuDisabledSyncSwitch());
       }));
@@ -80,6 +80,8 @@ void ImageFilter::initBlur(double sigma_x,
                            double sigma_y,
                            SkTileMode tile_mode) {
   filter_ = SkImageFilters::Blur(sigma_x, sigma_y, tile_mode, nullptr, nullptr);
+  blur_sigma_ = SkSize::Make(sigma_x, sigma_y);
+  blur_tile_mode_ = tile_mode;
 }
 
 void ImageFilter::initMatrix(const tonic::Float64List& matrix4,
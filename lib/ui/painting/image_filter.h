@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_FILTER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_FILTER_H_
 
+#include <optional>
+
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/color_filter.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -34,12 +36,18 @@ class ImageFilter : public RefCountedDartWrappable<ImageFilter> {
 
   const sk_sp<SkImageFilter>& filter() const { return filter_; }
 
+  // Set when the filter is a Gaussian blur, see |initBlur|.
+  const std::optional<SkSize>& blur_sigma() const { return blur_sigma_; }
+  SkTileMode blur_tile_mode() const { return blur_tile_mode_; }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
   ImageFilter();
 
   sk_sp<SkImageFilter> filter_;
+  std::optional<SkSize> blur_sigma_;
+  SkTileMode blur_tile_mode_ = SkTileMode::kClamp;
 };
 
 }  // namespace flutter
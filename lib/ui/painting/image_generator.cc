@@ -8,8 +8,33 @@
 
 namespace flutter {
 
+HardwareBufferImage::~HardwareBufferImage() = default;
+
 ImageGenerator::~ImageGenerator() = default;
 
+bool ImageGenerator::StartIncrementalDecode(const SkImageInfo& info,
+                                            void* pixels,
+                                            size_t row_bytes) {
+  return false;
+}
+
+ImageGenerator::IncrementalDecodeResult ImageGenerator::IncrementalDecode(
+    int* rows_decoded) {
+  return IncrementalDecodeResult::kError;
+}
+
+std::unique_ptr<HardwareBufferImage> ImageGenerator::DecodeToHardwareBuffer() {
+  return nullptr;
+}
+
+bool ImageGenerator::CanDecodeBandsConcurrently() const {
+  return false;
+}
+
+bool ImageGenerator::GetBandPixels(const SkPixmap& band, int top) {
+  return false;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -79,7 +104,8 @@ BuiltinSkiaCodecImageGenerator::~BuiltinSkiaCodecImageGenerator() = default;
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
     std::unique_ptr<SkCodec> codec)
-    : codec_generator_(static_cast<SkCodecImageGenerator*>(
+    : codec_(codec.get()),
+      codec_generator_(static_cast<SkCodecImageGenerator*>(
           SkCodecImageGenerator::MakeFromCodec(std::move(codec)).release())) {}
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
@@ -114,7 +140,35 @@ const ImageGenerator::FrameInfo BuiltinSkiaCodecImageGenerator::GetFrameInfo(
 
 SkISize BuiltinSkiaCodecImageGenerator::GetScaledDimensions(
     float desired_scale) {
-  return codec_generator_->getScaledDimensions(desired_scale);
+  const SkISize scaled_dimensions =
+      codec_generator_->getScaledDimensions(desired_scale);
+  if (scaled_dimensions != GetInfo().dimensions()) {
+    // The codec scales the image while decoding it, e.g. JPEG and WebP.
+    return scaled_dimensions;
+  }
+  const int sample_size = GetSampleSize(desired_scale);
+  if (sample_size <= 1) {
+    return scaled_dimensions;
+  }
+  return sampling_codec_->getSampledDimensions(sample_size);
+}
+
+int BuiltinSkiaCodecImageGenerator::GetSampleSize(float desired_scale) {
+  // Skipping pixels aliases the image, which the final resize only hides
+  // when the image is decoded at no less than twice its target size.
+  const int sample_size =
+      desired_scale > 0 ? static_cast<int>(1 / (2 * desired_scale)) : 1;
+  if (sample_size <= 1 || !data_ || !codec_ ||
+      codec_->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return 1;
+  }
+  if (!sampling_codec_) {
+    sampling_codec_ = SkAndroidCodec::MakeFromData(data_);
+    if (!sampling_codec_) {
+      return 1;
+    }
+  }
+  return sample_size;
 }
 
 bool BuiltinSkiaCodecImageGenerator::GetPixels(
@@ -123,6 +177,30 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
     size_t row_bytes,
     unsigned int frame_index,
     std::optional<unsigned int> prior_frame) {
+  if (frame_index == 0 && sampling_codec_ &&
+      info.width() < GetInfo().width()) {
+    // Find the sample size of the dimensions from |GetScaledDimensions|,
+    // whose sampled sizes are rounded up.
+    const int sample_size = GetInfo().width() / info.width();
+    for (int size : {sample_size, sample_size + 1}) {
+      if (sampling_codec_->getSampledDimensions(size) != info.dimensions()) {
+        continue;
+      }
+      SkAndroidCodec::AndroidOptions options;
+      options.fSampleSize = size;
+      switch (sampling_codec_->getAndroidPixels(info, pixels, row_bytes,
+                                                &options)) {
+        case SkCodec::kSuccess:
+        case SkCodec::kIncompleteInput:
+        case SkCodec::kErrorInInput:
+          return true;
+        default:
+          break;
+      }
+      break;
+    }
+  }
+
   SkCodec::Options options;
   options.fFrameIndex = frame_index;
   if (prior_frame.has_value()) {
@@ -131,12 +209,83 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return codec_generator_->getPixels(info, pixels, row_bytes, &options);
 }
 
+bool BuiltinSkiaCodecImageGenerator::StartIncrementalDecode(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes) {
+  // The rows of the generator's info are oriented, but the codec decodes
+  // them in their encoded order.
+  if (!codec_ || codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec_->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return false;
+  }
+  return codec_->startIncrementalDecode(info, pixels, row_bytes) ==
+         SkCodec::kSuccess;
+}
+
+ImageGenerator::IncrementalDecodeResult
+BuiltinSkiaCodecImageGenerator::IncrementalDecode(int* rows_decoded) {
+  FML_DCHECK(codec_);
+  switch (codec_->incrementalDecode(rows_decoded)) {
+    case SkCodec::kSuccess:
+      return IncrementalDecodeResult::kComplete;
+    case SkCodec::kIncompleteInput:
+      return IncrementalDecodeResult::kIncompleteInput;
+    default:
+      return IncrementalDecodeResult::kError;
+  }
+}
+
+bool BuiltinSkiaCodecImageGenerator::CanDecodeBandsConcurrently() const {
+  // JPEG decoders skip the rows above a band without transforming their
+  // pixels, so the bands are mostly decoded in parallel. Decoders of the
+  // other formats have to decode all of the rows above a band.
+  return data_ && codec_ &&
+         codec_->getEncodedFormat() == SkEncodedImageFormat::kJPEG &&
+         codec_->getOrigin() == kTopLeft_SkEncodedOrigin &&
+         codec_->getScanlineOrder() == SkCodec::kTopDown_SkScanlineOrder;
+}
+
+bool BuiltinSkiaCodecImageGenerator::GetBandPixels(const SkPixmap& band,
+                                                   int top) {
+  FML_DCHECK(CanDecodeBandsConcurrently());
+  // Codecs can't be shared by threads, so each band is decoded by a codec of
+  // its own.
+  auto codec = SkCodec::MakeFromData(data_);
+  if (!codec || band.width() != codec->dimensions().width()) {
+    return false;
+  }
+  if (codec->startScanlineDecode(
+          band.info().makeDimensions(codec->dimensions())) !=
+      SkCodec::kSuccess) {
+    return false;
+  }
+  if (top > 0 && !codec->skipScanlines(top)) {
+    return false;
+  }
+  return codec->getScanlines(band.writable_addr(), band.height(),
+                             band.rowBytes()) == band.height();
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(data);
   if (!codec) {
     return nullptr;
   }
+  auto generator =
+      std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec));
+  generator->data_ = std::move(data);
+  return generator;
+}
+
+std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromStream(
+    std::unique_ptr<SkStream> stream,
+    SkCodec::Result* result) {
+  auto codec = SkCodec::MakeFromStream(std::move(stream), result);
+  if (!codec) {
+    return nullptr;
+  }
   return std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec));
 }
 
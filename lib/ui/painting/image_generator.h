@@ -5,13 +5,43 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <memory>
 #include <optional>
 #include "flutter/fml/macros.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"
 
+class GrDirectContext;
+
 namespace flutter {
 
+/// @brief  An image decoded by an `ImageGenerator` into memory that the GPU
+///         can import without copying its pixels, such as an
+///         `AHardwareBuffer` or an `IOSurface`.
+/// @see    `ImageGenerator::DecodeToHardwareBuffer`
+class HardwareBufferImage {
+ public:
+  virtual ~HardwareBufferImage();
+
+  /// @brief   Wraps the decoded pixels in an image that the GPU draws
+  ///          without copying them. Like the images of
+  ///          `SkImage::MakeCrossContextFromPixmap`, the image must be
+  ///          drawable by the onscreen context, which shares its resources
+  ///          with the given one.
+  /// @return  The image, or null if the memory can't be imported by the
+  ///          context, for example because it uses another backend.
+  /// @note    This method is called on the IO thread with the resource
+  ///          context.
+  virtual sk_sp<SkImage> MakeTextureImage(GrDirectContext* context) = 0;
+
+  /// @brief   Copies the decoded pixels into a raster image, for when the
+  ///          image can't be imported by the GPU.
+  /// @return  The raster image, or null if the pixels can't be read.
+  virtual sk_sp<SkImage> MakeRasterImage() = 0;
+};
+
 /// @brief  The minimal interface necessary for defining a decoder that can be
 ///         used for both single and multi-frame image decoding. Image
 ///         generators can also optionally support decoding into a subscaled
@@ -39,6 +69,17 @@ class ImageGenerator {
     SkCodecAnimation::DisposalMethod disposal_method;
   };
 
+  /// @brief  The result of a step of an incremental decode.
+  /// @see    `ImageGenerator::IncrementalDecode`
+  enum class IncrementalDecodeResult {
+    /// All of the rows of the image have been decoded.
+    kComplete,
+    /// More encoded data is needed to decode the remaining rows.
+    kIncompleteInput,
+    /// The image could not be decoded.
+    kError,
+  };
+
   virtual ~ImageGenerator();
 
   /// @brief   Returns basic information about the contents of the encoded
@@ -123,6 +164,63 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Starts decoding the first frame of the image into a given
+  ///             buffer, one batch of rows at a time as the encoded data is
+  ///             received. The rows are decoded with `IncrementalDecode`.
+  ///             Generators that can't decode parts of images, or not in
+  ///             the order of their rows from the top, return false and the
+  ///             image has to be decoded with `GetPixels` once all of its
+  ///             data has been received.
+  /// @param[in]  info       The desired size and color info of the decoded
+  ///                        image, as for `GetPixels`.
+  /// @param[in]  pixels     The location where the decoded rows should be
+  ///                        written. This must remain valid until the
+  ///                        incremental decode is complete.
+  /// @param[in]  row_bytes  The total number of bytes that should make up a
+  ///                        single row of decoded image data.
+  /// @return     True if the incremental decode has started.
+  /// @see        `IncrementalDecode`
+  virtual bool StartIncrementalDecode(const SkImageInfo& info,
+                                      void* pixels,
+                                      size_t row_bytes);
+
+  /// @brief       Decodes as many rows of an incremental decode as the encoded
+  ///              data received so far allows.
+  /// @param[out]  rows_decoded  The number of rows from the top of the image
+  ///                            that have been written, when more data is
+  ///                            needed.
+  /// @return      Whether the image is complete or needs more data.
+  /// @note        This method performs potentially long synchronous work, and
+  ///              so it should never be executed on the UI thread.
+  /// @see         `StartIncrementalDecode`
+  virtual IncrementalDecodeResult IncrementalDecode(int* rows_decoded);
+
+  /// @brief   Decodes the first frame of the image at its full size into
+  ///          memory that the GPU can import without copying the pixels. This
+  ///          skips the upload of the pixels to a texture on the IO thread.
+  ///          Generators that can't decode into such memory return null, and
+  ///          the image is decoded with `GetPixels` and uploaded instead.
+  /// @return  The decoded image, or null.
+  /// @note    This method performs potentially long synchronous work, and so
+  ///          it should never be executed on the UI thread.
+  virtual std::unique_ptr<HardwareBufferImage> DecodeToHardwareBuffer();
+
+  /// @brief   Whether `GetBandPixels` can decode the bands of rows of the
+  ///          first frame concurrently, on several threads at once.
+  virtual bool CanDecodeBandsConcurrently() const;
+
+  /// @brief       Decodes a band of rows of the first frame of the image at
+  ///              its full size. Unlike the other methods of the generator,
+  ///              this may be called on several threads at once if
+  ///              `CanDecodeBandsConcurrently` is true.
+  /// @param[in]   band  The pixels of the rows, which are as wide as the
+  ///                    image.
+  /// @param[in]   top   The first of the rows in the image.
+  /// @return      True if the rows were decoded.
+  /// @note        This method performs potentially long synchronous work, and
+  ///              so it should never be executed on the UI thread.
+  virtual bool GetBandPixels(const SkPixmap& band, int top);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -199,11 +297,49 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool StartIncrementalDecode(const SkImageInfo& info,
+                              void* pixels,
+                              size_t row_bytes) override;
+
+  // |ImageGenerator|
+  IncrementalDecodeResult IncrementalDecode(int* rows_decoded) override;
+
+  // |ImageGenerator|
+  bool CanDecodeBandsConcurrently() const override;
+
+  // |ImageGenerator|
+  bool GetBandPixels(const SkPixmap& band, int top) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
+  /// @brief      Creates a generator for the image encoded in `stream`, which
+  ///             may still be receiving data.
+  /// @param[in]  stream  The stream of the encoded image data.
+  /// @param[out] result  Why the generator could not be created, if it
+  ///                     couldn't. This is `SkCodec::kIncompleteInput` when
+  ///                     the stream does not have enough of the image yet.
+  static std::unique_ptr<ImageGenerator> MakeFromStream(
+      std::unique_ptr<SkStream> stream,
+      SkCodec::Result* result);
+
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(BuiltinSkiaCodecImageGenerator);
+
+  // Returns the sample size that decodes the image at no less than twice
+  // the `desired_scale`, or 1 if the image can't be subsampled.
+  int GetSampleSize(float desired_scale);
+
+  // Owned by the |codec_generator_|. Null for the generators made from
+  // buffers, which can't decode incrementally.
+  SkCodec* codec_ = nullptr;
   std::unique_ptr<SkCodecImageGenerator> codec_generator_;
+  // The encoded data of the generators made from data, which the
+  // |sampling_codec_| decodes again.
+  sk_sp<SkData> data_;
+  // Created when an image is decoded at a size that the |codec_| can't
+  // scale to, for the formats that can only be scaled by subsampling.
+  std::unique_ptr<SkAndroidCodec> sampling_codec_;
 };
 
 }  // namespace flutter
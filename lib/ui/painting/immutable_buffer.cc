@@ -6,7 +6,9 @@
 
 #include <cstring>
 
+#include "flutter/assets/asset_manager.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -19,17 +21,31 @@ namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, ImmutableBuffer);
 
+static std::shared_ptr<AssetManager> GetAssetManager() {
+  PlatformConfiguration* platform_configuration =
+      UIDartState::Current()->platform_configuration();
+  if (!platform_configuration || !platform_configuration->client()) {
+    return nullptr;
+  }
+  return platform_configuration->client()->GetAssetManager();
+}
+
 #define FOR_EACH_BINDING(V)   \
   V(ImmutableBuffer, dispose) \
   V(ImmutableBuffer, length)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+DART_NATIVE_CALLBACK_STATIC(ImmutableBuffer, prefetchAssets)
 
 ImmutableBuffer::~ImmutableBuffer() {}
 
 void ImmutableBuffer::RegisterNatives(tonic::DartLibraryNatives* natives) {
-  natives->Register({{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
-                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->Register(
+      {{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
+       {"ImmutableBuffer_initFromAsset", ImmutableBuffer::initFromAsset, 3,
+        true},
+       DART_REGISTER_NATIVE_STATIC(ImmutableBuffer, prefetchAssets),
+       FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
 void ImmutableBuffer::init(Dart_NativeArguments args) {
@@ -49,6 +65,52 @@ void ImmutableBuffer::init(Dart_NativeArguments args) {
   tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
 }
 
+void ImmutableBuffer::initFromAsset(Dart_NativeArguments args) {
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 2);
+  if (!Dart_IsClosure(callback_handle)) {
+    Dart_SetReturnValue(args, tonic::ToDart("Callback must be a function"));
+    return;
+  }
+
+  Dart_Handle buffer_handle = Dart_GetNativeArgument(args, 0);
+  std::string asset_name = tonic::DartConverter<std::string>::FromDart(
+      Dart_GetNativeArgument(args, 1));
+
+  std::shared_ptr<AssetManager> asset_manager = GetAssetManager();
+  std::unique_ptr<fml::Mapping> mapping =
+      asset_manager ? asset_manager->GetAsMapping(asset_name) : nullptr;
+  if (!mapping) {
+    tonic::DartInvoke(callback_handle, {tonic::ToDart(-1)});
+    return;
+  }
+
+  // The SkData owns the mapping, which keeps the asset mapped until the last
+  // reference to the data is dropped.
+  size_t length = mapping->GetSize();
+  const uint8_t* bytes = mapping->GetMapping();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  auto sk_data = SkData::MakeWithProc(bytes, length, proc, mapping.release());
+  auto buffer = fml::MakeRefCounted<ImmutableBuffer>(sk_data);
+  buffer->AssociateWithDartWrapper(buffer_handle);
+  tonic::DartInvoke(callback_handle,
+                    {tonic::ToDart(static_cast<int64_t>(length))});
+}
+
+void ImmutableBuffer::prefetchAssets(std::vector<std::string> asset_keys) {
+  std::shared_ptr<AssetManager> asset_manager = GetAssetManager();
+  auto task_runner = UIDartState::Current()->GetConcurrentTaskRunner();
+  if (!asset_manager || !task_runner || asset_keys.empty()) {
+    return;
+  }
+  task_runner->PostTask(
+      [asset_manager = std::move(asset_manager),
+       asset_keys = std::move(asset_keys)]() {
+        asset_manager->Prefetch(asset_keys);
+      });
+}
+
 size_t ImmutableBuffer::GetAllocationSize() const {
   return sizeof(ImmutableBuffer) + data_->size();
 }
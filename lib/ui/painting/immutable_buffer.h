@@ -6,6 +6,8 @@
 #define FLUTTER_LIB_UI_PAINTNIG_IMMUTABLE_BUFER_H_
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/dart_wrapper.h"
@@ -39,6 +41,25 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
   /// when the copy has completed.
   static void init(Dart_NativeArguments args);
 
+  /// Initializes a new ImmutableData from an asset of the application.
+  ///
+  /// The zero indexed argument is the caller that will be registered as the
+  /// Dart peer of the native ImmutableBuffer object.
+  ///
+  /// The first indexed argument is the String key of the asset.
+  ///
+  /// The second indexed argument is expected to be a void callback that is
+  /// called with the length of the asset, or with -1 if there is no asset
+  /// with the key.
+  ///
+  /// The buffer wraps the mapping of the asset without copying it, so assets
+  /// that are memory mapped by their asset resolver are never copied.
+  static void initFromAsset(Dart_NativeArguments args);
+
+  /// Reads the assets with the given keys on a background thread, so that
+  /// loading them later doesn't wait for storage. See AssetManager::Prefetch.
+  static void prefetchAssets(std::vector<std::string> asset_keys);
+
   /// The length of the data in bytes.
   size_t length() const {
     FML_DCHECK(data_);
@@ -0,0 +1,256 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/incremental_image_decode.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/post_task_and_reply.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+
+namespace flutter {
+
+SkISize IncrementalImageDecode::GetTargetSize(const SkISize& source,
+                                              uint32_t target_width,
+                                              uint32_t target_height) {
+  if (source.isEmpty() || (target_width == 0 && target_height == 0)) {
+    return source;
+  }
+  const double aspect_ratio =
+      static_cast<double>(source.width()) / source.height();
+  if (target_width == 0) {
+    target_width = static_cast<uint32_t>(
+        std::max(1.0, std::round(target_height * aspect_ratio)));
+  } else if (target_height == 0) {
+    target_height = static_cast<uint32_t>(
+        std::max(1.0, std::round(target_width / aspect_ratio)));
+  }
+  return SkISize::Make(target_width, target_height);
+}
+
+IncrementalImageDecode::IncrementalImageDecode(
+    TaskRunners runners,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
+    fml::WeakPtr<IOManager> io_manager,
+    uint32_t target_width,
+    uint32_t target_height,
+    Result result)
+    : runners_(std::move(runners)),
+      concurrent_task_runner_(std::move(concurrent_task_runner)),
+      io_manager_(std::move(io_manager)),
+      target_width_(target_width),
+      target_height_(target_height),
+      result_(std::move(result)),
+      data_(fml::MakeRefCounted<ChunkedImageData>()) {
+  FML_DCHECK(result_);
+}
+
+IncrementalImageDecode::~IncrementalImageDecode() = default;
+
+void IncrementalImageDecode::AppendData(sk_sp<SkData> chunk) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  data_->Append(std::move(chunk));
+  ScheduleStep();
+}
+
+void IncrementalImageDecode::Finish() {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  data_->Finish();
+  ScheduleStep();
+}
+
+void IncrementalImageDecode::Cancel() {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  cancelled_ = true;
+}
+
+sk_sp<SkData> IncrementalImageDecode::GetData() const {
+  return data_->MakeContiguousData();
+}
+
+void IncrementalImageDecode::ScheduleStep() {
+  {
+    std::scoped_lock lock(step_mutex_);
+    if (step_running_) {
+      step_pending_ = true;
+      return;
+    }
+    step_running_ = true;
+  }
+  concurrent_task_runner_->PostTask([decode = fml::Ref(this)]() {
+    while (true) {
+      decode->Step();
+      std::scoped_lock lock(decode->step_mutex_);
+      if (!decode->step_pending_) {
+        decode->step_running_ = false;
+        return;
+      }
+      decode->step_pending_ = false;
+    }
+  });
+}
+
+void IncrementalImageDecode::Step() {
+  if (cancelled_ || done_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "IncrementalImageDecode::Step");
+
+  // Once this is true, all of the data is available to the decode below.
+  const bool finished = data_->is_finished();
+
+  if (!generator_ && !unsupported_ && !CreateGenerator(finished)) {
+    return;
+  }
+
+  if (!unsupported_) {
+    int rows_decoded = 0;
+    switch (generator_->IncrementalDecode(&rows_decoded)) {
+      case ImageGenerator::IncrementalDecodeResult::kIncompleteInput:
+        if (!finished) {
+          if (rows_decoded > rows_shown_) {
+            rows_shown_ = rows_decoded;
+            // The bitmap is still being decoded into.
+            UploadImage(SkImage::MakeRasterCopy(bitmap_.pixmap()),
+                        Status::kPartial);
+          }
+          return;
+        }
+        // The image is truncated. Like |GetPixels|, keep the rows that
+        // could be decoded.
+        [[fallthrough]];
+      case ImageGenerator::IncrementalDecodeResult::kComplete:
+        done_ = true;
+        generator_.reset();
+        bitmap_.setImmutable();
+        UploadImage(SkImage::MakeFromBitmap(bitmap_), Status::kComplete);
+        bitmap_.reset();
+        return;
+      case ImageGenerator::IncrementalDecodeResult::kError:
+        FML_DLOG(ERROR) << "Could not decode the image incrementally.";
+        unsupported_ = true;
+        generator_.reset();
+        bitmap_.reset();
+        break;
+    }
+  }
+
+  if (finished) {
+    done_ = true;
+    PostResult({}, Status::kUnsupported);
+  }
+}
+
+bool IncrementalImageDecode::CreateGenerator(bool finished) {
+  TRACE_EVENT0("flutter", "IncrementalImageDecode::CreateGenerator");
+  if (!finished && data_->size() < SkCodec::MinBufferedBytesNeeded()) {
+    return false;
+  }
+
+  SkCodec::Result result = SkCodec::kSuccess;
+  generator_ = BuiltinSkiaCodecImageGenerator::MakeFromStream(
+      data_->MakeStream(), &result);
+  if (!generator_) {
+    if (result == SkCodec::kIncompleteInput && !finished) {
+      // Not all of the header has been received yet.
+      return false;
+    }
+    // Another of the registered generators may still be able to decode it.
+    unsupported_ = true;
+    return true;
+  }
+
+  const SkImageInfo& source_info = generator_->GetInfo();
+  const SkISize source_size = source_info.dimensions();
+  target_size_ = GetTargetSize(source_size, target_width_, target_height_);
+
+  // Like |ImageFromCompressedData|, decode at a size close to the target if
+  // the codec can do so efficiently.
+  SkISize decode_size = source_size;
+  if (target_size_ != source_size) {
+    decode_size = generator_->GetScaledDimensions(std::max(
+        static_cast<double>(target_size_.width()) / source_size.width(),
+        static_cast<double>(target_size_.height()) / source_size.height()));
+  }
+  SkImageInfo info = source_info.makeDimensions(decode_size)
+                         .makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+
+  // The rows that haven't been decoded yet are shown as transparent.
+  if (!bitmap_.tryAllocPixels(info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << info.computeMinByteSize() << "B";
+    unsupported_ = true;
+  } else {
+    bitmap_.eraseColor(SK_ColorTRANSPARENT);
+    unsupported_ = !generator_->StartIncrementalDecode(
+        info, bitmap_.getPixels(), bitmap_.rowBytes());
+  }
+  if (unsupported_) {
+    generator_.reset();
+    bitmap_.reset();
+  }
+  return true;
+}
+
+void IncrementalImageDecode::UploadImage(sk_sp<SkImage> image,
+                                         Status status) {
+  fml::tracing::TraceFlow flow(__FUNCTION__);
+  if (image && image->dimensions() != target_size_) {
+    image = ResizeRasterImage(std::move(image), target_size_, flow);
+  }
+  if (!image) {
+    if (status == Status::kComplete) {
+      PostResult({}, status);
+    }
+    return;
+  }
+
+  fml::PostTaskAndReplyWithResult(
+      runners_.GetIOTaskRunner(),
+      [io_manager = io_manager_, image = std::move(image),
+       flow = std::move(flow)]() mutable -> SkiaGPUObject<SkImage> {
+        if (!io_manager) {
+          FML_DLOG(ERROR) << "Could not acquire IO manager.";
+          return {};
+        }
+
+        // Without a resource context, return the image as-is like
+        // |ImageDecoder::Decode|.
+        if (!io_manager->GetResourceContext()) {
+          return {std::move(image), io_manager->GetSkiaUnrefQueue()};
+        }
+
+        return UploadRasterImage(std::move(image), io_manager, flow);
+      },
+      runners_.GetUITaskRunner(),
+      [decode = fml::Ref(this), status](SkiaGPUObject<SkImage> image) {
+        decode->DeliverResult(std::move(image), status);
+      });
+}
+
+void IncrementalImageDecode::PostResult(SkiaGPUObject<SkImage> image,
+                                        Status status) {
+  runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+      [decode = fml::Ref(this), image = std::move(image), status]() mutable {
+        decode->DeliverResult(std::move(image), status);
+      }));
+}
+
+void IncrementalImageDecode::DeliverResult(SkiaGPUObject<SkImage> image,
+                                           Status status) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (cancelled_) {
+    return;
+  }
+  result_(std::move(image), status);
+}
+
+}  // namespace flutter
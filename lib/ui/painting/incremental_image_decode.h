@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODE_H_
+#define FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODE_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "flutter/common/task_runners.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/chunked_image_data.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+
+/// @brief  Decodes an image while its encoded bytes are still being received,
+///         so that the rows decoded so far can be shown before the rest of
+///         the image arrives.
+///
+///         The rows are decoded on the concurrent worker threads every time
+///         data is appended, and a snapshot of the image with the rows
+///         decoded so far is uploaded on the IO thread and returned on the UI
+///         thread. Only one of the workers decodes at a time, and the steps
+///         requested while one is decoding are coalesced into one.
+///
+///         Images that the built-in codecs can't decode incrementally, such
+///         as JPEGs and the images that have to be rotated, are reported as
+///         `kUnsupported` once all of their data has been received. The
+///         caller then decodes the data from `GetData` the regular way.
+///
+///         This is created with `ImageDecoder::DecodeIncrementally`, and must
+///         be fed and cancelled on the UI thread.
+class IncrementalImageDecode
+    : public fml::RefCountedThreadSafe<IncrementalImageDecode> {
+ public:
+  enum class Status {
+    /// The image has more rows than before, but is not complete.
+    kPartial,
+    /// The image is complete. The image is null if it could not be uploaded.
+    kComplete,
+    /// The image can't be decoded incrementally. There is no image.
+    kUnsupported,
+  };
+
+  /// Invoked on the UI thread.
+  using Result = std::function<void(SkiaGPUObject<SkImage>, Status)>;
+
+  /// @brief  The size that an image of `source` dimensions is decoded to for
+  ///         the target dimensions. A target dimension of 0 keeps the aspect
+  ///         ratio of the image, and both keep its size.
+  static SkISize GetTargetSize(const SkISize& source,
+                               uint32_t target_width,
+                               uint32_t target_height);
+
+  /// @brief  Appends the next bytes of the image and decodes the rows they
+  ///         complete.
+  void AppendData(sk_sp<SkData> chunk);
+
+  /// @brief  Marks all of the bytes of the image as received.
+  void Finish();
+
+  /// @brief  Stops decoding. The result is not invoked again.
+  void Cancel();
+
+  /// @brief  All of the encoded bytes received so far.
+  sk_sp<SkData> GetData() const;
+
+ private:
+  IncrementalImageDecode(
+      TaskRunners runners,
+      std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
+      fml::WeakPtr<IOManager> io_manager,
+      uint32_t target_width,
+      uint32_t target_height,
+      Result result);
+
+  ~IncrementalImageDecode();
+
+  void ScheduleStep();
+
+  // On a worker.
+  void Step();
+
+  // On a worker. Returns false if more data is needed before the generator
+  // can be created, and sets |unsupported_| if it can't be.
+  bool CreateGenerator(bool finished);
+
+  // On a worker.
+  void UploadImage(sk_sp<SkImage> image, Status status);
+
+  void PostResult(SkiaGPUObject<SkImage> image, Status status);
+
+  // On the UI thread.
+  void DeliverResult(SkiaGPUObject<SkImage> image, Status status);
+
+  const TaskRunners runners_;
+  const std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
+  const fml::WeakPtr<IOManager> io_manager_;
+  const uint32_t target_width_;
+  const uint32_t target_height_;
+  const Result result_;
+  const fml::RefPtr<ChunkedImageData> data_;
+  std::atomic_bool cancelled_ = false;
+
+  std::mutex step_mutex_;
+  // Whether a worker is running the steps, and whether it should run another
+  // once it is done with the current one.
+  bool step_running_ = false;
+  bool step_pending_ = false;
+
+  // Only accessed by the worker running the steps.
+  std::unique_ptr<ImageGenerator> generator_;
+  SkBitmap bitmap_;
+  SkISize target_size_ = SkISize::MakeEmpty();
+  int rows_shown_ = 0;
+  bool unsupported_ = false;
+  bool done_ = false;
+
+  FML_FRIEND_MAKE_REF_COUNTED(IncrementalImageDecode);
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(IncrementalImageDecode);
+  FML_DISALLOW_COPY_AND_ASSIGN(IncrementalImageDecode);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODE_H_
@@ -0,0 +1,204 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
+
+#include <algorithm>
+
+#include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/immutable_buffer.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/dart_args.h"
+#include "third_party/tonic/dart_binding_macros.h"
+#include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/logging/dart_invoke.h"
+
+namespace flutter {
+
+static void IncrementalImageDecoder_constructor(Dart_NativeArguments args) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  DartCallConstructor(&IncrementalImageDecoder::Create, args);
+}
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, IncrementalImageDecoder);
+
+#define FOR_EACH_BINDING(V)             \
+  V(IncrementalImageDecoder, addChunk)  \
+  V(IncrementalImageDecoder, close)     \
+  V(IncrementalImageDecoder, dispose)
+
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+
+void IncrementalImageDecoder::RegisterNatives(
+    tonic::DartLibraryNatives* natives) {
+  natives->Register({{"IncrementalImageDecoder_constructor",
+                      IncrementalImageDecoder_constructor, 4, true},
+                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+}
+
+fml::RefPtr<IncrementalImageDecoder> IncrementalImageDecoder::Create(
+    Dart_Handle wrapper,
+    int target_width,
+    int target_height,
+    Dart_Handle progress_callback) {
+  return fml::MakeRefCounted<IncrementalImageDecoder>(
+      static_cast<uint32_t>(std::max(target_width, 0)),
+      static_cast<uint32_t>(std::max(target_height, 0)), progress_callback);
+}
+
+IncrementalImageDecoder::IncrementalImageDecoder(uint32_t target_width,
+                                                 uint32_t target_height,
+                                                 Dart_Handle progress_callback)
+    : target_width_(target_width),
+      target_height_(target_height),
+      weak_factory_(this) {
+  // This has to be valid because this is called from Dart.
+  auto* dart_state = UIDartState::Current();
+  image_decoder_ = dart_state->GetImageDecoder();
+  image_generator_registry_ = dart_state->GetImageGeneratorRegistry();
+  if (Dart_IsClosure(progress_callback)) {
+    progress_callback_.Set(dart_state, progress_callback);
+  }
+  if (image_decoder_) {
+    decode_ = image_decoder_->DecodeIncrementally(
+        target_width_, target_height_,
+        [decoder = weak_factory_.GetWeakPtr()](
+            SkiaGPUObject<SkImage> image,
+            IncrementalImageDecode::Status status) {
+          if (decoder) {
+            decoder->OnImage(std::move(image), status);
+          }
+        });
+  }
+}
+
+IncrementalImageDecoder::~IncrementalImageDecoder() {
+  if (decode_) {
+    decode_->Cancel();
+  }
+}
+
+void IncrementalImageDecoder::addChunk(const tonic::Uint8List& chunk) {
+  if (!decode_ || closed_) {
+    return;
+  }
+  decode_->AppendData(ImmutableBuffer::MakeSkDataWithCopy(
+      chunk.data(), chunk.num_elements()));
+}
+
+Dart_Handle IncrementalImageDecoder::close(Dart_Handle callback) {
+  if (!Dart_IsClosure(callback)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+  if (closed_) {
+    return tonic::ToDart("The decoder is already closed");
+  }
+  if (!decode_) {
+    return tonic::ToDart(
+        "Failed to access the internal image decoder on this isolate. Please "
+        "file a bug on https://github.com/flutter/flutter/issues.");
+  }
+  closed_ = true;
+  close_callback_.Set(UIDartState::Current(), callback);
+  pending_close_ = fml::Ref(this);
+  decode_->Finish();
+  return Dart_Null();
+}
+
+void IncrementalImageDecoder::dispose() {
+  if (decode_) {
+    decode_->Cancel();
+    decode_ = nullptr;
+  }
+  closed_ = true;
+  progress_callback_.Clear();
+  close_callback_.Clear();
+  ClearDartWrapper();
+  // Last, as this may be the last reference.
+  pending_close_ = nullptr;
+}
+
+size_t IncrementalImageDecoder::GetAllocationSize() const {
+  return sizeof(*this);
+}
+
+void IncrementalImageDecoder::OnImage(SkiaGPUObject<SkImage> image,
+                                      IncrementalImageDecode::Status status) {
+  switch (status) {
+    case IncrementalImageDecode::Status::kPartial: {
+      if (!image.skia_object() || progress_callback_.is_empty()) {
+        return;
+      }
+      auto state = progress_callback_.dart_state().lock();
+      if (!state) {
+        return;
+      }
+      tonic::DartState::Scope scope(state.get());
+      auto canvas_image = CanvasImage::Create();
+      canvas_image->set_image(std::move(image));
+      tonic::DartInvoke(progress_callback_.value(),
+                        {tonic::ToDart(canvas_image)});
+      return;
+    }
+    case IncrementalImageDecode::Status::kComplete:
+      Complete(std::move(image));
+      return;
+    case IncrementalImageDecode::Status::kUnsupported:
+      if (decode_) {
+        DecodeData(decode_->GetData());
+      }
+      return;
+  }
+}
+
+void IncrementalImageDecoder::DecodeData(sk_sp<SkData> data) {
+  std::shared_ptr<ImageGenerator> generator;
+  if (image_generator_registry_ && data->size() > 0) {
+    generator = image_generator_registry_->CreateCompatibleGenerator(data);
+  }
+  if (!generator || !image_decoder_) {
+    // No compatible image decoder was found.
+    Complete({});
+    return;
+  }
+
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(std::move(data), generator);
+  const SkISize target_size = IncrementalImageDecode::GetTargetSize(
+      descriptor->image_info().dimensions(), target_width_, target_height_);
+  image_decoder_->Decode(descriptor, target_size.width(), target_size.height(),
+                         [decoder = weak_factory_.GetWeakPtr()](auto image) {
+                           if (decoder) {
+                             decoder->Complete(std::move(image));
+                           }
+                         });
+}
+
+void IncrementalImageDecoder::Complete(SkiaGPUObject<SkImage> image) {
+  // Released when this returns, as it may be the last reference.
+  auto pending_close = std::move(pending_close_);
+  decode_ = nullptr;
+  progress_callback_.Clear();
+  if (close_callback_.is_empty()) {
+    return;
+  }
+
+  auto state = close_callback_.dart_state().lock();
+  if (!state) {
+    // The isolate has been terminated before the image could be decoded.
+    return;
+  }
+  tonic::DartState::Scope scope(state.get());
+
+  fml::RefPtr<CanvasImage> canvas_image;
+  if (image.skia_object()) {
+    canvas_image = CanvasImage::Create();
+    canvas_image->set_image(std::move(image));
+  }
+  tonic::DartInvoke(close_callback_.value(), {tonic::ToDart(canvas_image)});
+  close_callback_.Clear();
+}
+
+}  // namespace flutter
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/lib/ui/painting/incremental_image_decode.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/typed_data/typed_list.h"
+
+namespace tonic {
+class DartLibraryNatives;
+}  // namespace tonic
+
+namespace flutter {
+
+/// @brief  The engine side of the `IncrementalImageDecoder` of dart:ui, which
+///         decodes an image from the chunks of its encoded bytes as they are
+///         received.
+///
+///         The images that the built-in codecs can decode incrementally are
+///         decoded by an `IncrementalImageDecode`, which returns the rows
+///         decoded so far to the progress callback. The others are decoded by
+///         the `ImageDecoder` once all of their data has been received, with
+///         the generators of the `ImageGeneratorRegistry` like the images of
+///         `ImageDescriptor`s.
+/// @see    `IncrementalImageDecode`
+class IncrementalImageDecoder
+    : public RefCountedDartWrappable<IncrementalImageDecoder> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(IncrementalImageDecoder);
+
+ public:
+  ~IncrementalImageDecoder() override;
+
+  static fml::RefPtr<IncrementalImageDecoder> Create(
+      Dart_Handle wrapper,
+      int target_width,
+      int target_height,
+      Dart_Handle progress_callback);
+
+  void addChunk(const tonic::Uint8List& chunk);
+
+  Dart_Handle close(Dart_Handle callback);
+
+  void dispose();
+
+  size_t GetAllocationSize() const override;
+
+  static void RegisterNatives(tonic::DartLibraryNatives* natives);
+
+ private:
+  IncrementalImageDecoder(uint32_t target_width,
+                          uint32_t target_height,
+                          Dart_Handle progress_callback);
+
+  void OnImage(SkiaGPUObject<SkImage> image,
+               IncrementalImageDecode::Status status);
+
+  // Decodes the image the regular way, for the images that can't be decoded
+  // incrementally.
+  void DecodeData(sk_sp<SkData> data);
+
+  void Complete(SkiaGPUObject<SkImage> image);
+
+  const uint32_t target_width_;
+  const uint32_t target_height_;
+  fml::WeakPtr<ImageDecoder> image_decoder_;
+  fml::WeakPtr<ImageGeneratorRegistry> image_generator_registry_;
+  fml::RefPtr<IncrementalImageDecode> decode_;
+  tonic::DartPersistentValue progress_callback_;
+  tonic::DartPersistentValue close_callback_;
+  // Keeps this alive while the complete image is decoded, in case the Dart
+  // object is collected first.
+  fml::RefPtr<IncrementalImageDecoder> pending_close_;
+  bool closed_ = false;
+  fml::WeakPtrFactory<IncrementalImageDecoder> weak_factory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IncrementalImageDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
@@ -4,7 +4,13 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -12,72 +18,135 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 sk_sp<SkData> data)
+    : state_(new State(std::move(generator), std::move(data))) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+// The most bytes of decoded frames that are kept for an animation that
+// loops.
+static constexpr size_t kMaxCachedFramesBytes = 8 << 20;
+
+static bool ShouldCacheFrames(ImageGenerator& generator) {
+  const unsigned int frame_count = generator.GetFrameCount();
+  if (frame_count < 2 || generator.GetPlayCount() == 1) {
+    // The frames are never shown again.
+    return false;
+  }
+  const size_t frame_bytes = generator.GetInfo()
+                                 .makeColorType(kN32_SkColorType)
+                                 .computeMinByteSize();
+  return frame_bytes > 0 &&
+         frame_bytes <= kMaxCachedFramesBytes / frame_count;
+}
+
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              sk_sp<SkData> data)
     : generator_(std::move(generator)),
+      data_(std::move(data)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
                            : generator_->GetPlayCount() - 1),
-      nextFrameIndex_(0) {}
-
-static void InvokeNextFrameCallback(
-    fml::RefPtr<CanvasImage> image,
-    int duration,
-    std::unique_ptr<DartPersistentValue> callback,
-    size_t trace_id) {
-  std::shared_ptr<tonic::DartState> dart_state = callback->dart_state().lock();
-  if (!dart_state) {
-    FML_DLOG(ERROR) << "Could not acquire Dart state while attempting to fire "
-                       "next frame callback.";
-    return;
-  }
-  tonic::DartState::Scope scope(dart_state);
-  tonic::DartInvoke(callback->value(),
-                    {tonic::ToDart(image), tonic::ToDart(duration)});
-}
-
-// Copied the source bitmap to the destination. If this cannot occur due to
-// running out of memory or the image info not being compatible, returns false.
-static bool CopyToBitmap(SkBitmap* dst,
-                         SkColorType dstColorType,
-                         const SkBitmap& src) {
-  SkPixmap srcPM;
-  if (!src.peekPixels(&srcPM)) {
-    return false;
+      cacheFrames_(ShouldCacheFrames(*generator_)),
+      nextFrameIndex_(0),
+      decoder_(generator_) {}
+
+MultiFrameCodec::FrameDecoder::FrameDecoder(
+    std::shared_ptr<ImageGenerator> generator)
+    : generator_(std::move(generator)) {}
+
+MultiFrameCodec::SharedFrames::SharedFrames(
+    std::shared_ptr<ImageGenerator> generator,
+    sk_sp<SkData> data,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue)
+    : data_(std::move(data)),
+      unref_queue_(std::move(unref_queue)),
+      decoder_(std::move(generator)),
+      frames_(decoder_.generator_->GetFrameCount()) {}
+
+std::shared_ptr<MultiFrameCodec::SharedFrames>
+MultiFrameCodec::SharedFrames::Get(
+    std::shared_ptr<ImageGenerator> generator,
+    sk_sp<SkData> data,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+  if (!data) {
+    return std::make_shared<SharedFrames>(std::move(generator), nullptr,
+                                          std::move(unref_queue));
   }
 
-  SkBitmap tmpDst;
-  SkImageInfo dstInfo = srcPM.info().makeColorType(dstColorType);
-  if (!tmpDst.setInfo(dstInfo)) {
-    return false;
+  // The shared frames of the animations by the hash of their encoded bytes,
+  // which are kept alive by the states of their codecs.
+  static std::mutex& registry_mutex = *new std::mutex();
+  static auto& registry =
+      *new std::unordered_multimap<uint64_t, std::weak_ptr<SharedFrames>>();
+
+  const uint64_t hash =
+      DecodedImageCache::MakeKey(*data, generator->GetInfo(), 0, 0, 0)
+          .content_hash;
+  std::scoped_lock lock(registry_mutex);
+  auto range = registry.equal_range(hash);
+  for (auto it = range.first; it != range.second;) {
+    auto frames = it->second.lock();
+    if (!frames) {
+      it = registry.erase(it);
+      continue;
+    }
+    // The frames uploaded by another IO manager may not be drawable by this
+    // one's onscreen context.
+    if (frames->unref_queue_ == unref_queue &&
+        frames->data_->equals(data.get())) {
+      return frames;
+    }
+    ++it;
   }
+  auto frames = std::make_shared<SharedFrames>(
+      std::move(generator), std::move(data), std::move(unref_queue));
+  registry.emplace(hash, frames);
+  return frames;
+}
 
-  if (!tmpDst.tryAllocPixels()) {
-    return false;
+sk_sp<SkImage> MultiFrameCodec::SharedFrames::GetFrame(
+    int index,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch) {
+  FML_DCHECK(index >= 0 && index < static_cast<int>(frames_.size()));
+  if (HasFrame(index)) {
+    return frames_[index].skia_object();
   }
 
-  SkPixmap dstPM;
-  if (!tmpDst.peekPixels(&dstPM)) {
-    return false;
+  // Frames that failed to decode are decoded again from the start when they
+  // are requested in the next loop.
+  if (decoder_.nextFrameIndex_ > index) {
+    decoder_.nextFrameIndex_ = 0;
   }
+  int decodeIndex;
+  do {
+    decodeIndex = decoder_.nextFrameIndex_;
+    sk_sp<SkImage> image =
+        decoder_.DecodeNextFrame(resourceContext, gpu_disable_sync_switch);
+    if (image) {
+      frames_[decodeIndex] = {std::move(image), unref_queue_};
+    }
+  } while (decodeIndex != index);
 
-  if (!srcPM.readPixels(dstPM)) {
-    return false;
+  if (std::all_of(frames_.begin(), frames_.end(), [](const auto& frame) {
+        return !!frame.skia_object();
+      })) {
+    // No frame is decoded from the required frames anymore.
+    decoder_.lastRequiredFrame_.reset();
   }
-
-  dst->swap(tmpDst);
-  return true;
+  return frames_[index].skia_object();
 }
 
-sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
+sk_sp<SkImage> MultiFrameCodec::FrameDecoder::DecodeNextFrame(
     fml::WeakPtr<GrDirectContext> resourceContext,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch) {
+  const int frameIndex = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % generator_->GetFrameCount();
+
   SkBitmap bitmap = SkBitmap();
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
@@ -86,8 +155,7 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   }
   bitmap.allocPixels(info);
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -95,7 +163,7 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
 
   if (requiredFrameIndex != SkCodec::kNoFrame) {
     if (lastRequiredFrame_ == nullptr) {
-      FML_LOG(ERROR) << "Frame " << nextFrameIndex_ << " depends on frame "
+      FML_LOG(ERROR) << "Frame " << frameIndex << " depends on frame "
                      << requiredFrameIndex
                      << " and no required frames are cached.";
       return nullptr;
@@ -113,15 +181,15 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   }
 
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
+                             frameIndex, requiredFrameIndex)) {
+    FML_LOG(ERROR) << "Could not getPixels for frame " << frameIndex;
     return nullptr;
   }
 
   // Hold onto this if we need it to decode future frames.
   if (frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep) {
     lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
   }
   sk_sp<SkImage> result;
 
@@ -149,25 +217,91 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   return result;
 }
 
+MultiFrameCodec::SharedFrames& MultiFrameCodec::State::GetSharedFrames(
+    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue) {
+  FML_DCHECK(cacheFrames_);
+  if (!sharedFrames_) {
+    sharedFrames_ = SharedFrames::Get(generator_, data_, unref_queue);
+  }
+  return *sharedFrames_;
+}
+
+sk_sp<SkImage> MultiFrameCodec::State::TakeNextFrameImage(
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch) {
+  sk_sp<SkImage> skImage;
+  if (cacheFrames_) {
+    skImage = GetSharedFrames(unref_queue)
+                  .GetFrame(nextFrameIndex_, resourceContext,
+                            gpu_disable_sync_switch);
+  } else if (lookAheadFrame_.skia_object()) {
+    skImage = lookAheadFrame_.skia_object();
+    lookAheadFrame_.reset();
+  } else {
+    skImage =
+        decoder_.DecodeNextFrame(resourceContext, gpu_disable_sync_switch);
+  }
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+  return skImage;
+}
+
+void MultiFrameCodec::State::DecodeLookAheadFrame(
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch) {
+  if (cacheFrames_) {
+    auto& sharedFrames = GetSharedFrames(unref_queue);
+    if (!sharedFrames.HasFrame(nextFrameIndex_)) {
+      TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeLookAheadFrame");
+      sharedFrames.GetFrame(nextFrameIndex_, resourceContext,
+                            gpu_disable_sync_switch);
+    }
+    return;
+  }
+  if (lookAheadFrame_.skia_object()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeLookAheadFrame");
+  // If the frame can't be decoded, it is requested without a look-ahead
+  // frame and decoded after it.
+  lookAheadFrame_ = {
+      decoder_.DecodeNextFrame(resourceContext, gpu_disable_sync_switch),
+      unref_queue};
+}
+
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<DartPersistentValue> callback,
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
     fml::WeakPtr<GrDirectContext> resourceContext,
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     size_t trace_id) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
-  sk_sp<SkImage> skImage =
-      GetNextFrameImage(resourceContext, gpu_disable_sync_switch);
+  const int frameIndex = nextFrameIndex_;
+  sk_sp<SkImage> skImage = TakeNextFrameImage(resourceContext, unref_queue,
+                                              gpu_disable_sync_switch);
   if (skImage) {
     image = CanvasImage::Create();
-    image->set_image({skImage, std::move(unref_queue)});
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
+    image->set_image({skImage, unref_queue});
+    ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
     duration = frameInfo.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+
+  // Decode the next frame while this one is shown. This is posted before the
+  // callback, so that it runs before the request for the next frame.
+  if (frameCount_ > 1 && image) {
+    io_task_runner->PostTask(
+        [weak_state = weak_from_this(), resourceContext,
+         unref_queue = std::move(unref_queue), gpu_disable_sync_switch]() {
+          if (auto state = weak_state.lock()) {
+            state->DecodeLookAheadFrame(resourceContext, unref_queue,
+                                        gpu_disable_sync_switch);
+          }
+        });
+  }
 
   ui_task_runner->PostTask(fml::MakeCopyable([callback = std::move(callback),
                                               image = std::move(image),
@@ -205,6 +339,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -214,7 +349,8 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
         }
         state->GetNextFrameAndInvokeCallback(
             std::move(callback), std::move(ui_task_runner),
-            io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
+            std::move(io_task_runner), io_manager->GetResourceContext(),
+            io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id);
       }));
 
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
@@ -13,7 +17,11 @@ namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  /// @brief  Creates a codec for the frames of `generator`. The codecs of
+  ///         the same encoded `data` share the frames of short animations
+  ///         that loop.
+  MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                  sk_sp<SkData> data = nullptr);
 
   ~MultiFrameCodec() override;
 
@@ -27,6 +35,59 @@ class MultiFrameCodec : public Codec {
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
  private:
+  // Decodes the frames of an animation in order, keeping the frames that the
+  // next ones are decoded from. Only accessed on the IO thread.
+  struct FrameDecoder {
+    explicit FrameDecoder(std::shared_ptr<ImageGenerator> generator);
+
+    const std::shared_ptr<ImageGenerator> generator_;
+    int nextFrameIndex_ = 0;
+    // The last decoded frame that's required to decode any subsequent frames.
+    std::unique_ptr<SkBitmap> lastRequiredFrame_;
+
+    // The index of the last decoded required frame.
+    int lastRequiredFrameIndex_ = -1;
+
+    // Decodes and uploads the frame at nextFrameIndex_, and advances
+    // nextFrameIndex_.
+    sk_sp<SkImage> DecodeNextFrame(
+        fml::WeakPtr<GrDirectContext> resourceContext,
+        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch);
+  };
+
+  // The frames of a short animation that loops, which are decoded once and
+  // kept. The frames are shared by all of the codecs of the same encoded
+  // bytes whose frames are uploaded by the same IO manager, so an animation
+  // shown in many places is only decoded once. Only accessed on the IO thread
+  // of that IO manager.
+  struct SharedFrames {
+    SharedFrames(std::shared_ptr<ImageGenerator> generator,
+                 sk_sp<SkData> data,
+                 fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue);
+
+    // Returns the frames of the animation encoded in `data` for the unref
+    // queue, which decode with `generator` if no other codec's do. The frames
+    // of codecs without data are not shared.
+    static std::shared_ptr<SharedFrames> Get(
+        std::shared_ptr<ImageGenerator> generator,
+        sk_sp<SkData> data,
+        fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue);
+
+    const sk_sp<SkData> data_;
+    const fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue_;
+    FrameDecoder decoder_;
+    std::vector<SkiaGPUObject<SkImage>> frames_;
+
+    bool HasFrame(int index) const { return !!frames_[index].skia_object(); }
+
+    // Returns the frame at `index`, decoding the frames up to it that haven't
+    // been decoded yet.
+    sk_sp<SkImage> GetFrame(
+        int index,
+        fml::WeakPtr<GrDirectContext> resourceContext,
+        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch);
+  };
+
   // Captures the state shared between the IO and UI task runners.
   //
   // The state is initialized on the UI task runner when the Dart object is
@@ -36,30 +97,56 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
-    State(std::shared_ptr<ImageGenerator> generator);
+  //
+  // While a frame is shown, the next one is decoded ahead of the call to
+  // getNextFrame that requests it. The frames of short animations that loop
+  // are kept in SharedFrames, so that they are only decoded once.
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator, sk_sp<SkData> data);
 
     const std::shared_ptr<ImageGenerator> generator_;
+    // The encoded bytes, which identify the animation's SharedFrames.
+    const sk_sp<SkData> data_;
     const int frameCount_;
     const int repetitionCount_;
+    // Whether all of the frames are kept once they are decoded.
+    const bool cacheFrames_;
 
     // The non-const members and functions below here are only read or written
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
     int nextFrameIndex_;
-    // The last decoded frame that's required to decode any subsequent frames.
-    std::unique_ptr<SkBitmap> lastRequiredFrame_;
+    // Decodes the frames that aren't kept.
+    FrameDecoder decoder_;
 
-    // The index of the last decoded required frame.
-    int lastRequiredFrameIndex_ = -1;
+    // The frame at nextFrameIndex_, if it was decoded ahead of its request.
+    SkiaGPUObject<SkImage> lookAheadFrame_;
+
+    // Set when the first frame is decoded if cacheFrames_.
+    std::shared_ptr<SharedFrames> sharedFrames_;
+
+    SharedFrames& GetSharedFrames(
+        const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue);
+
+    // Returns the frame at nextFrameIndex_, from the look-ahead frame or the
+    // shared frames if it has already been decoded, and advances
+    // nextFrameIndex_.
+    sk_sp<SkImage> TakeNextFrameImage(
+        fml::WeakPtr<GrDirectContext> resourceContext,
+        const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue,
+        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch);
 
-    sk_sp<SkImage> GetNextFrameImage(
+    // Decodes the frame at nextFrameIndex_ ahead of its request, unless it
+    // has already been decoded.
+    void DecodeLookAheadFrame(
         fml::WeakPtr<GrDirectContext> resourceContext,
+        const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch);
 
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<DartPersistentValue> callback,
         fml::RefPtr<fml::TaskRunner> ui_task_runner,
+        fml::RefPtr<fml::TaskRunner> io_task_runner,
         fml::WeakPtr<GrDirectContext> resourceContext,
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
@@ -26,45 +26,49 @@ static void Path_constructor(Dart_NativeArguments args) {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Path);
 
-#define FOR_EACH_BINDING(V)          \
-  V(Path, addArc)                    \
-  V(Path, addOval)                   \
-  V(Path, addPath)                   \
-  V(Path, addPolygon)                \
-  V(Path, addRect)                   \
-  V(Path, addRRect)                  \
-  V(Path, arcTo)                     \
-  V(Path, arcToPoint)                \
-  V(Path, close)                     \
-  V(Path, conicTo)                   \
-  V(Path, contains)                  \
-  V(Path, cubicTo)                   \
-  V(Path, extendWithPath)            \
-  V(Path, extendWithPathAndMatrix)   \
+#define FOR_EACH_BINDING(V)        \
+  V(Path, addPath)                 \
+  V(Path, addPolygon)              \
+  V(Path, addRRect)                \
+  V(Path, arcTo)                   \
+  V(Path, arcToPoint)              \
+  V(Path, contains)                \
+  V(Path, extendWithPath)          \
+  V(Path, extendWithPathAndMatrix) \
+  V(Path, relativeArcToPoint)      \
+  V(Path, shift)                   \
+  V(Path, transform)               \
+  V(Path, getBounds)               \
+  V(Path, addPathWithMatrix)       \
+  V(Path, op)                      \
+  V(Path, clone)
+
+// Natives that only take and return numbers, bound with @FfiNative leaf calls.
+#define FOR_EACH_FFI_BINDING(V)      \
   V(Path, getFillType)               \
-  V(Path, lineTo)                    \
+  V(Path, setFillType)               \
   V(Path, moveTo)                    \
-  V(Path, quadraticBezierTo)         \
-  V(Path, relativeArcToPoint)        \
-  V(Path, relativeConicTo)           \
-  V(Path, relativeCubicTo)           \
-  V(Path, relativeLineTo)            \
   V(Path, relativeMoveTo)            \
+  V(Path, lineTo)                    \
+  V(Path, relativeLineTo)            \
+  V(Path, quadraticBezierTo)         \
   V(Path, relativeQuadraticBezierTo) \
-  V(Path, reset)                     \
-  V(Path, setFillType)               \
-  V(Path, shift)                     \
-  V(Path, transform)                 \
-  V(Path, getBounds)                 \
-  V(Path, addPathWithMatrix)         \
-  V(Path, op)                        \
-  V(Path, clone)
+  V(Path, cubicTo)                   \
+  V(Path, relativeCubicTo)           \
+  V(Path, conicTo)                   \
+  V(Path, relativeConicTo)           \
+  V(Path, addRect)                   \
+  V(Path, addOval)                   \
+  V(Path, addArc)                    \
+  V(Path, close)                     \
+  V(Path, reset)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
 void CanvasPath::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({{"Path_constructor", Path_constructor, 1, true},
                      FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->RegisterFfi({FOR_EACH_FFI_BINDING(DART_REGISTER_FFI_NATIVE)});
 }
 
 CanvasPath::CanvasPath()
@@ -77,6 +81,7 @@ CanvasPath::CanvasPath()
 CanvasPath::~CanvasPath() = default;
 
 void CanvasPath::resetVolatility() {
+  looked_up_shared_path_ = false;
   if (!tracked_path_->tracking_volatility) {
     mutable_path().setIsVolatile(true);
     tracked_path_->frame_count = 0;
@@ -85,6 +90,23 @@ void CanvasPath::resetVolatility() {
   }
 }
 
+const SkPath& CanvasPath::GetPathForDrawing() const {
+  if (!looked_up_shared_path_) {
+    looked_up_shared_path_ = true;
+    const SkPath* shared_path = path_tracker_->FindSharedPath(path());
+    if (shared_path) {
+      // The shared path is already non-volatile, so it no longer needs to be
+      // tracked until it is mutated.
+      tracked_path_->path = *shared_path;
+      if (tracked_path_->tracking_volatility) {
+        tracked_path_->tracking_volatility = false;
+        path_tracker_->Erase(tracked_path_);
+      }
+    }
+  }
+  return path();
+}
+
 void CanvasPath::ReleaseDartWrappableReference() const {
   FML_DCHECK(path_tracker_);
   path_tracker_->Erase(tracked_path_);
@@ -340,9 +362,10 @@ tonic::Float32List CanvasPath::getBounds() {
 }
 
 bool CanvasPath::op(CanvasPath* path1, CanvasPath* path2, int operation) {
-  return Op(path1->path(), path2->path(), static_cast<SkPathOp>(operation),
-            &tracked_path_->path);
+  bool result = Op(path1->path(), path2->path(),
+                   static_cast<SkPathOp>(operation), &tracked_path_->path);
   resetVolatility();
+  return result;
 }
 
 void CanvasPath::clone(Dart_Handle path_handle) {
@@ -111,6 +111,10 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   const SkPath& path() const { return tracked_path_->path; }
 
+  // Returns the path that should be drawn or clipped to, which is shared by
+  // the paths drawn with the same contents.
+  const SkPath& GetPathForDrawing() const;
+
   size_t GetAllocationSize() const override;
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
@@ -122,6 +126,9 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   std::shared_ptr<VolatilePathTracker> path_tracker_;
   std::shared_ptr<VolatilePathTracker::TrackedPath> tracked_path_;
+  // Whether the contents were looked up in the shared paths of the tracker
+  // since they were last mutated.
+  mutable bool looked_up_shared_path_ = false;
 
   // Must be called whenever the path is created or mutated.
   void resetVolatility();
@@ -26,7 +26,13 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Picture);
   V(Picture, dispose)       \
   V(Picture, GetAllocationSize)
 
-DART_BIND_ALL(Picture, FOR_EACH_BINDING)
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+DART_NATIVE_CALLBACK_STATIC(Picture, toImages)
+
+void Picture::RegisterNatives(tonic::DartLibraryNatives* natives) {
+  natives->Register({DART_REGISTER_NATIVE_STATIC(Picture, toImages),
+                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+}
 
 fml::RefPtr<Picture> Picture::Create(
     Dart_Handle dart_handle,
@@ -72,6 +78,31 @@ Dart_Handle Picture::toImage(uint32_t width,
   }
 }
 
+Dart_Handle Picture::toImages(std::vector<Picture*> pictures,
+                              uint32_t width,
+                              uint32_t height,
+                              Dart_Handle raw_images_callback) {
+  std::vector<std::function<void(SkCanvas*)>> draw_callbacks;
+  draw_callbacks.reserve(pictures.size());
+  for (Picture* picture : pictures) {
+    if (!picture) {
+      return tonic::ToDart("Picture is null");
+    }
+    if (auto display_list = picture->display_list()) {
+      draw_callbacks.push_back([display_list](SkCanvas* canvas) {
+        display_list->RenderTo(canvas);
+      });
+    } else if (auto sk_picture = picture->picture()) {
+      draw_callbacks.push_back(
+          [sk_picture](SkCanvas* canvas) { canvas->drawPicture(sk_picture); });
+    } else {
+      return tonic::ToDart("Picture is null");
+    }
+  }
+  return RasterizeToImages(std::move(draw_callbacks), width, height,
+                           raw_images_callback);
+}
+
 void Picture::dispose() {
   picture_.reset();
   display_list_.reset();
@@ -167,4 +198,81 @@ Dart_Handle Picture::RasterizeToImage(
   return Dart_Null();
 }
 
+Dart_Handle Picture::RasterizeToImages(
+    std::vector<std::function<void(SkCanvas*)>> draw_callbacks,
+    uint32_t width,
+    uint32_t height,
+    Dart_Handle raw_images_callback) {
+  if (Dart_IsNull(raw_images_callback) ||
+      !Dart_IsClosure(raw_images_callback)) {
+    return tonic::ToDart("Image callback was invalid");
+  }
+
+  if (width == 0 || height == 0) {
+    return tonic::ToDart("Image dimensions for scene were invalid.");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  auto images_callback = std::make_unique<tonic::DartPersistentValue>(
+      dart_state, raw_images_callback);
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+  auto raster_task_runner = dart_state->GetTaskRunners().GetRasterTaskRunner();
+  auto snapshot_delegate = dart_state->GetSnapshotDelegate();
+
+  auto picture_bounds = SkISize::Make(width, height);
+
+  auto ui_task = fml::MakeCopyable(
+      [images_callback = std::move(images_callback)](
+          std::vector<SkiaGPUObject<SkImage>> images) mutable {
+        auto dart_state = images_callback->dart_state().lock();
+        if (!dart_state) {
+          // The root isolate could have died in the meantime.
+          return;
+        }
+        tonic::DartState::Scope scope(dart_state);
+
+        Dart_Handle dart_images = Dart_NewList(images.size());
+        for (size_t i = 0; i < images.size(); i++) {
+          Dart_Handle dart_image = Dart_Null();
+          if (images[i].skia_object()) {
+            auto canvas_image = CanvasImage::Create();
+            canvas_image->set_image(std::move(images[i]));
+            dart_image = tonic::ToDart(std::move(canvas_image));
+          }
+          Dart_ListSetAt(dart_images, i, dart_image);
+        }
+
+        tonic::DartInvoke(images_callback->Get(), {dart_images});
+
+        // images_callback is associated with the Dart isolate and must be
+        // deleted on the UI thread.
+        images_callback.reset();
+      });
+
+  // All of the pictures are rasterized in a single raster task.
+  fml::TaskRunner::RunNowOrPostTask(
+      raster_task_runner,
+      fml::MakeCopyable([ui_task_runner, snapshot_delegate,
+                         draw_callbacks = std::move(draw_callbacks),
+                         picture_bounds,
+                         ui_task = std::move(ui_task)]() mutable {
+        std::vector<SkiaGPUObject<SkImage>> images;
+        if (snapshot_delegate) {
+          images = snapshot_delegate->MakeGpuSnapshots(draw_callbacks,
+                                                       picture_bounds);
+        } else {
+          images.resize(draw_callbacks.size());
+        }
+
+        fml::TaskRunner::RunNowOrPostTask(
+            ui_task_runner,
+            fml::MakeCopyable([ui_task = std::move(ui_task),
+                               images = std::move(images)]() mutable {
+              ui_task(std::move(images));
+            }));
+      }));
+
+  return Dart_Null();
+}
+
 }  // namespace flutter
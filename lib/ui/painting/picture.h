@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include <vector>
+
 #include "flutter/flow/display_list.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/lib/ui/dart_wrapper.h"
@@ -40,6 +42,11 @@ class Picture : public RefCountedDartWrappable<Picture> {
                       uint32_t height,
                       Dart_Handle raw_image_callback);
 
+  static Dart_Handle toImages(std::vector<Picture*> pictures,
+                              uint32_t width,
+                              uint32_t height,
+                              Dart_Handle raw_images_callback);
+
   void dispose();
 
   size_t GetAllocationSize() const override;
@@ -57,6 +64,15 @@ class Picture : public RefCountedDartWrappable<Picture> {
       uint32_t height,
       Dart_Handle raw_image_callback);
 
+  // Rasterizes all of the |draw_callbacks| in a single raster task into GPU
+  // resident images, and invokes |raw_images_callback| with a list that has
+  // an image, or null, for each of them.
+  static Dart_Handle RasterizeToImages(
+      std::vector<std::function<void(SkCanvas*)>> draw_callbacks,
+      uint32_t width,
+      uint32_t height,
+      Dart_Handle raw_images_callback);
+
  private:
   Picture(flutter::SkiaGPUObject<SkPicture> picture);
   Picture(flutter::SkiaGPUObject<DisplayList> display_list);
@@ -31,6 +31,11 @@ void PictureRecorder::RegisterNatives(tonic::DartLibraryNatives* natives) {
 }
 
 fml::RefPtr<PictureRecorder> PictureRecorder::Create() {
+  fml::RefPtr<PictureRecorder> recorder =
+      UIDartState::Current()->GetPictureRecorderPool().Take();
+  if (recorder) {
+    return recorder;
+  }
   return fml::MakeRefCounted<PictureRecorder>();
 }
 
@@ -41,7 +46,11 @@ PictureRecorder::~PictureRecorder() {}
 SkCanvas* PictureRecorder::BeginRecording(SkRect bounds) {
   bool enable_display_list = UIDartState::Current()->enable_display_list();
   if (enable_display_list) {
-    display_list_recorder_ = sk_make_sp<DisplayListCanvasRecorder>(bounds);
+    // Pictures are frequently only partially visible (scrolled content
+    // or partial repaint) so we prepare an RTree for culling in the same
+    // way that we record SkPictures with an RTree below.
+    display_list_recorder_ =
+        sk_make_sp<DisplayListCanvasRecorder>(bounds, true);
     return display_list_recorder_.get();
   } else {
     return picture_recorder_.beginRecording(bounds, &rtree_factory_);
@@ -56,9 +65,12 @@ fml::RefPtr<Picture> PictureRecorder::endRecording(Dart_Handle dart_picture) {
   fml::RefPtr<Picture> picture;
 
   if (display_list_recorder_) {
+    UIDartState* state = UIDartState::Current();
+    sk_sp<DisplayList> display_list =
+        state->GetDisplayListCache().Deduplicate(
+            display_list_recorder_->Build(), state->GetSkiaUnrefQueue());
     picture = Picture::Create(
-        dart_picture,
-        UIDartState::CreateGPUObject(display_list_recorder_->Build()));
+        dart_picture, UIDartState::CreateGPUObject(std::move(display_list)));
     display_list_recorder_ = nullptr;
   } else {
     picture = Picture::Create(
@@ -67,7 +79,10 @@ fml::RefPtr<Picture> PictureRecorder::endRecording(Dart_Handle dart_picture) {
   }
 
   canvas_->Invalidate();
-  canvas_ = nullptr;
+  recycled_canvas_ = std::move(canvas_);
+  // The Dart wrapper can't reach this recorder anymore once it is cleared,
+  // so it is recycled for the next one instead of being deleted.
+  UIDartState::Current()->GetPictureRecorderPool().Recycle(fml::Ref(this));
   ClearDartWrapper();
   return picture;
 }
@@ -35,6 +35,12 @@ class PictureRecorder : public RefCountedDartWrappable<PictureRecorder> {
 
   void set_canvas(fml::RefPtr<Canvas> canvas) { canvas_ = std::move(canvas); }
 
+  // The canvas of the previous recording if this recorder was recycled, which
+  // a new canvas can reuse instead of allocating.
+  fml::RefPtr<Canvas> TakeRecycledCanvas() {
+    return std::move(recycled_canvas_);
+  }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
@@ -46,6 +52,7 @@ class PictureRecorder : public RefCountedDartWrappable<PictureRecorder> {
   sk_sp<DisplayListCanvasRecorder> display_list_recorder_;
 
   fml::RefPtr<Canvas> canvas_;
+  fml::RefPtr<Canvas> recycled_canvas_;
 };
 
 }  // namespace flutter
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/runtime_effect_cache.h"
+
+namespace flutter {
+
+RuntimeEffectCache::RuntimeEffectCache(size_t capacity)
+    : capacity_(capacity) {}
+
+RuntimeEffectCache::~RuntimeEffectCache() = default;
+
+sk_sp<SkRuntimeEffect> RuntimeEffectCache::GetEffect(const std::string& sksl,
+                                                     SkString* error) {
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = entries_by_sksl_.find(sksl);
+    if (found != entries_by_sksl_.end()) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return found->second->second;
+    }
+  }
+
+  // Compiling can take milliseconds, so it is done outside of the lock. If
+  // two threads compile the same source at once, the first one is kept.
+  SkRuntimeEffect::Result result =
+      SkRuntimeEffect::MakeForShader(SkString(sksl));
+  if (result.effect == nullptr) {
+    *error = result.errorText;
+    return nullptr;
+  }
+  if (capacity_ == 0) {
+    return result.effect;
+  }
+
+  std::scoped_lock lock(mutex_);
+  auto found = entries_by_sksl_.find(sksl);
+  if (found != entries_by_sksl_.end()) {
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->second;
+  }
+  while (entries_.size() >= capacity_) {
+    entries_by_sksl_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+  entries_.emplace_front(sksl, result.effect);
+  entries_by_sksl_[sksl] = entries_.begin();
+  return result.effect;
+}
+
+size_t RuntimeEffectCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace flutter
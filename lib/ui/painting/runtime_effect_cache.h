@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_RUNTIME_EFFECT_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_RUNTIME_EFFECT_CACHE_H_
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkString.h"
+#include "third_party/skia/include/effects/SkRuntimeEffect.h"
+
+namespace flutter {
+
+/// The runtime effects compiled from the SkSL of the most recently used
+/// fragment programs, so that a program that is created again from the same
+/// source, such as after a hot restart or by every instance of a widget,
+/// reuses the effect instead of compiling it again.
+///
+/// The cache keeps up to |capacity| effects, evicting the least recently used
+/// ones first. It may be used from any thread.
+class RuntimeEffectCache {
+ public:
+  explicit RuntimeEffectCache(size_t capacity);
+
+  ~RuntimeEffectCache();
+
+  /// Returns the effect of |sksl|, compiling and caching it if it isn't
+  /// cached yet. Returns null and sets |error| if the SkSL is invalid.
+  sk_sp<SkRuntimeEffect> GetEffect(const std::string& sksl, SkString* error);
+
+  size_t GetEntryCount() const;
+
+ private:
+  using EntryList = std::list<std::pair<std::string, sk_sp<SkRuntimeEffect>>>;
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  // In the order of their uses, the most recently used first.
+  EntryList entries_;
+  std::unordered_map<std::string, EntryList::iterator> entries_by_sksl_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RuntimeEffectCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_RUNTIME_EFFECT_CACHE_H_
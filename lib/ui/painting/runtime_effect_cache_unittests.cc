@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/runtime_effect_cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+// A valid shader that returns |value| in the red channel.
+static std::string MakeSkSL(int value) {
+  return "half4 main(float2 p) { return half4(" + std::to_string(value) +
+         ".0 / 255.0, 0.0, 0.0, 1.0); }";
+}
+
+TEST(RuntimeEffectCacheTest, ReusesTheEffectOfTheSameSource) {
+  RuntimeEffectCache cache(4);
+  SkString error;
+  auto first = cache.GetEffect(MakeSkSL(1), &error);
+  ASSERT_TRUE(first) << error.c_str();
+  ASSERT_EQ(cache.GetEffect(MakeSkSL(1), &error), first);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+
+  auto second = cache.GetEffect(MakeSkSL(2), &error);
+  ASSERT_TRUE(second);
+  ASSERT_NE(second, first);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST(RuntimeEffectCacheTest, EvictsTheLeastRecentlyUsedEffect) {
+  RuntimeEffectCache cache(2);
+  SkString error;
+  auto first = cache.GetEffect(MakeSkSL(1), &error);
+  auto second = cache.GetEffect(MakeSkSL(2), &error);
+  ASSERT_TRUE(first && second);
+
+  // Using the first effect again makes the second one the least recently
+  // used, so it is the one evicted for the third.
+  ASSERT_EQ(cache.GetEffect(MakeSkSL(1), &error), first);
+  ASSERT_TRUE(cache.GetEffect(MakeSkSL(3), &error));
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  ASSERT_EQ(cache.GetEffect(MakeSkSL(1), &error), first);
+  auto second_again = cache.GetEffect(MakeSkSL(2), &error);
+  ASSERT_TRUE(second_again);
+  ASSERT_NE(second_again, second);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST(RuntimeEffectCacheTest, DoesNotCacheInvalidSource) {
+  RuntimeEffectCache cache(4);
+  SkString error;
+  ASSERT_FALSE(cache.GetEffect("not sksl", &error));
+  ASSERT_FALSE(error.isEmpty());
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+}
+
+TEST(RuntimeEffectCacheTest, DoesNotCacheWithoutCapacity) {
+  RuntimeEffectCache cache(0);
+  SkString error;
+  auto first = cache.GetEffect(MakeSkSL(1), &error);
+  ASSERT_TRUE(first);
+  ASSERT_NE(cache.GetEffect(MakeSkSL(1), &error), first);
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -464,9 +464,15 @@ class PlatformDispatcher {
   ///
   /// The framework invokes [callback] in the same zone in which this method was
   /// called.
+  ///
+  /// Messages can also be sent from the background isolates spawned by the
+  /// main isolate with `Isolate.spawn`. Those messages are handled by the host
+  /// platform as if the main isolate had sent them.
   void sendPlatformMessage(String name, ByteData? data, PlatformMessageResponseCallback? callback) {
-    final String? error =
-        _sendPlatformMessage(name, _zonedPlatformMessageResponseCallback(callback), data);
+    final PlatformMessageResponseCallback? zonedCallback = _zonedPlatformMessageResponseCallback(callback);
+    final String? error = _isBackgroundIsolate
+        ? _sendBackgroundPlatformMessage(name, zonedCallback, data)
+        : _sendPlatformMessage(name, zonedCallback, data);
     if (error != null)
       throw Exception(error);
   }
@@ -474,6 +480,28 @@ class PlatformDispatcher {
   String? _sendPlatformMessage(String name, PlatformMessageResponseCallback? callback, ByteData? data)
       native 'PlatformConfiguration_sendPlatformMessage';
 
+  // The isolates without a platform configuration don't run on the UI thread,
+  // so the responses to their messages are received through a port.
+  late final bool _isBackgroundIsolate = !_hasPlatformConfiguration();
+  bool _hasPlatformConfiguration() native 'PlatformConfiguration_hasPlatformConfiguration';
+
+  String? _sendBackgroundPlatformMessage(String name, PlatformMessageResponseCallback? callback, ByteData? data) {
+    if (callback == null)
+      return _sendPortPlatformMessage(name, null, data);
+    final RawReceivePort port = RawReceivePort();
+    port.handler = (Object? response) {
+      port.close();
+      callback(response == null ? null : ByteData.sublistView(response as Uint8List));
+    };
+    final String? error = _sendPortPlatformMessage(name, port.sendPort, data);
+    if (error != null)
+      port.close();
+    return error;
+  }
+
+  String? _sendPortPlatformMessage(String name, SendPort? port, ByteData? data)
+      native 'PlatformConfiguration_sendPortPlatformMessage';
+
   /// Called whenever this platform dispatcher receives a message from a
   /// platform-specific plugin.
   ///
@@ -1193,6 +1221,16 @@ enum _FrameTimingInfo {
   /// The number of bytes used to cache pictures during the frame.
   pictureCacheBytes,
 
+  /// The number of shaders compiled since the previous frame.
+  shaderCompileCount,
+
+  /// The microseconds spent compiling shaders since the previous frame.
+  shaderCompileDuration,
+
+  /// The number of bytes purged from the GPU resource cache since the previous
+  /// frame.
+  resourceCachePurgedBytes,
+
   /// The frame number of the frame.
   frameNumber,
 }
@@ -1228,6 +1266,9 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int shaderCompileCount = 0,
+    int shaderCompileDurationMicros = 0,
+    int resourceCachePurgedBytes = 0,
     int frameNumber = -1,
   }) {
     return FrameTiming._(<int>[
@@ -1241,6 +1282,9 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      shaderCompileCount,
+      shaderCompileDurationMicros,
+      resourceCachePurgedBytes,
       frameNumber,
     ]);
   }
@@ -1332,6 +1376,26 @@ class FrameTiming {
   /// See also [layerCacheCount], [layerCacheBytes], [pictureCacheCount] and [pictureCacheBytes].
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  /// The number of shaders that the engine compiled since the previous frame
+  /// was rasterized.
+  ///
+  /// The compilations are counted even when the timeline isn't recording, so
+  /// that the frames that missed their vsync can be correlated with them. They
+  /// include the compilations of all the engines of the process.
+  ///
+  /// See also [shaderCompileDuration].
+  int get shaderCompileCount => _rawInfo(_FrameTimingInfo.shaderCompileCount);
+
+  /// The time that the engine spent compiling shaders since the previous frame
+  /// was rasterized.
+  ///
+  /// See also [shaderCompileCount].
+  Duration get shaderCompileDuration => Duration(microseconds: _rawInfo(_FrameTimingInfo.shaderCompileDuration));
+
+  /// The number of bytes that were purged from the GPU resource cache since
+  /// the previous frame was rasterized.
+  int get resourceCachePurgedBytes => _rawInfo(_FrameTimingInfo.resourceCachePurgedBytes);
+
   /// The frame key associated with this frame measurement.
   int get frameNumber => _data.last;
 
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_RECYCLING_POOL_H_
+#define FLUTTER_LIB_UI_RECYCLING_POOL_H_
+
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_ptr.h"
+
+namespace flutter {
+
+/// Keeps the native objects of wrappables that the framework creates and
+/// throws away every frame, so that the next wrapper of the same type can
+/// reuse them instead of allocating new ones.
+///
+/// An object is recycled when the end of its use clears its Dart wrapper, for
+/// example in PictureRecorder.endRecording or SceneBuilder.build, which also
+/// means its finalizer never runs. Objects whose wrapper is garbage collected
+/// are deleted as usual. Recycled objects must be reset to the state of a new
+/// object by the caller before they are handed out again.
+///
+/// A pool belongs to a UIDartState and must only be used on its UI task
+/// runner.
+template <typename T>
+class RecyclingPool {
+ public:
+  explicit RecyclingPool(size_t capacity) : capacity_(capacity) {}
+
+  /// Returns a recycled object, or nullptr if there is none.
+  fml::RefPtr<T> Take() {
+    if (objects_.empty()) {
+      return nullptr;
+    }
+    fml::RefPtr<T> object = std::move(objects_.back());
+    objects_.pop_back();
+    return object;
+  }
+
+  /// Keeps |object| for reuse, unless the pool is full.
+  void Recycle(fml::RefPtr<T> object) {
+    if (objects_.size() < capacity_) {
+      objects_.push_back(std::move(object));
+    }
+  }
+
+  size_t size() const { return objects_.size(); }
+
+ private:
+  const size_t capacity_;
+  std::vector<fml::RefPtr<T>> objects_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RecyclingPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_RECYCLING_POOL_H_
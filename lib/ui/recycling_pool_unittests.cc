@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/recycling_pool.h"
+
+#include "flutter/fml/memory/ref_counted.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class Recyclable : public fml::RefCountedThreadSafe<Recyclable> {
+ public:
+  explicit Recyclable(int* deleted_count) : deleted_count_(deleted_count) {}
+
+ private:
+  ~Recyclable() { (*deleted_count_)++; }
+
+  int* deleted_count_;
+
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(Recyclable);
+  FML_FRIEND_MAKE_REF_COUNTED(Recyclable);
+};
+
+}  // namespace
+
+TEST(RecyclingPoolTest, TakeReturnsRecycledObjects) {
+  int deleted_count = 0;
+  RecyclingPool<Recyclable> pool(2);
+  ASSERT_FALSE(pool.Take());
+
+  auto object = fml::MakeRefCounted<Recyclable>(&deleted_count);
+  Recyclable* raw_object = object.get();
+  pool.Recycle(std::move(object));
+  ASSERT_EQ(pool.size(), 1u);
+
+  auto taken = pool.Take();
+  ASSERT_EQ(taken.get(), raw_object);
+  ASSERT_EQ(pool.size(), 0u);
+  ASSERT_EQ(deleted_count, 0);
+}
+
+TEST(RecyclingPoolTest, DeletesObjectsBeyondCapacity) {
+  int deleted_count = 0;
+  {
+    RecyclingPool<Recyclable> pool(1);
+    pool.Recycle(fml::MakeRefCounted<Recyclable>(&deleted_count));
+    pool.Recycle(fml::MakeRefCounted<Recyclable>(&deleted_count));
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_EQ(deleted_count, 1);
+  }
+  ASSERT_EQ(deleted_count, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
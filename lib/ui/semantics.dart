@@ -883,81 +883,108 @@ class SemanticsUpdateBuilder extends NativeFieldWrapperClass1 {
       scrollChildren == 0 || scrollChildren == null || (scrollChildren > 0 && childrenInHitTestOrder != null),
       'If a node has scrollChildren, it must have childrenInHitTestOrder',
     );
-    _updateNode(
-      id,
-      flags,
-      actions,
-      maxValueLength,
-      currentValueLength,
-      textSelectionBase,
-      textSelectionExtent,
-      platformViewId,
-      scrollChildren,
-      scrollIndex,
-      scrollPosition,
-      scrollExtentMax,
-      scrollExtentMin,
-      rect.left,
-      rect.top,
-      rect.right,
-      rect.bottom,
-      elevation,
-      thickness,
-      label,
-      labelAttributes,
-      value,
-      valueAttributes,
-      increasedValue,
-      increasedValueAttributes,
-      decreasedValue,
-      decreasedValueAttributes,
-      hint,
-      hintAttributes,
-      tooltip,
-      textDirection != null ? textDirection.index + 1 : 0,
-      transform,
-      childrenInTraversalOrder,
-      childrenInHitTestOrder,
-      additionalActions,
-    );
+    // The node is packed into the buffers of the builder rather than passed to
+    // the engine argument by argument, so that building an update with many
+    // nodes makes a single native call.
+    _addInt(id);
+    _addInt(flags);
+    _addInt(actions);
+    _addInt(maxValueLength);
+    _addInt(currentValueLength);
+    _addInt(textSelectionBase);
+    _addInt(textSelectionExtent);
+    _addInt(platformViewId);
+    _addInt(scrollChildren);
+    _addInt(scrollIndex);
+    _addInt(textDirection != null ? textDirection.index + 1 : 0);
+    _addString(label, labelAttributes);
+    _addString(value, valueAttributes);
+    _addString(increasedValue, increasedValueAttributes);
+    _addString(decreasedValue, decreasedValueAttributes);
+    _addString(hint, hintAttributes);
+    _addString(tooltip ?? '', const <StringAttribute>[]);
+    _addInts(childrenInTraversalOrder);
+    _addInts(childrenInHitTestOrder);
+    _addInts(additionalActions);
+    _addDouble(scrollPosition);
+    _addDouble(scrollExtentMax);
+    _addDouble(scrollExtentMin);
+    _addDouble(rect.left);
+    _addDouble(rect.top);
+    _addDouble(rect.right);
+    _addDouble(rect.bottom);
+    _addDouble(elevation);
+    _addDouble(thickness);
+    _addTransform(transform);
+  }
+
+  // The layout of a node in these buffers has to match
+  // `SemanticsUpdateBuilder::updateNodes` in the engine. Strings are stored
+  // once each, and referenced by their index in `_strings`.
+  Int32List _ints = Int32List(1024);
+  int _intCount = 0;
+  Float64List _doubles = Float64List(256);
+  int _doubleCount = 0;
+  final List<String> _strings = <String>[];
+  final Map<String, int> _stringIndices = <String, int>{};
+  final List<StringAttribute> _stringAttributes = <StringAttribute>[];
+
+  void _reserveInts(int count) {
+    if (_intCount + count <= _ints.length) {
+      return;
+    }
+    final Int32List ints = Int32List(math.max(_ints.length * 2, _intCount + count));
+    ints.setRange(0, _intCount, _ints);
+    _ints = ints;
+  }
+
+  void _reserveDoubles(int count) {
+    if (_doubleCount + count <= _doubles.length) {
+      return;
+    }
+    final Float64List doubles = Float64List(math.max(_doubles.length * 2, _doubleCount + count));
+    doubles.setRange(0, _doubleCount, _doubles);
+    _doubles = doubles;
+  }
+
+  void _addInt(int value) {
+    _reserveInts(1);
+    _ints[_intCount++] = value;
   }
-  void _updateNode(
-    int id,
-    int flags,
-    int actions,
-    int maxValueLength,
-    int currentValueLength,
-    int textSelectionBase,
-    int textSelectionExtent,
-    int platformViewId,
-    int scrollChildren,
-    int scrollIndex,
-    double scrollPosition,
-    double scrollExtentMax,
-    double scrollExtentMin,
-    double left,
-    double top,
-    double right,
-    double bottom,
-    double elevation,
-    double thickness,
-    String label,
-    List<StringAttribute> labelAttributes,
-    String value,
-    List<StringAttribute> valueAttributes,
-    String increasedValue,
-    List<StringAttribute> increasedValueAttributes,
-    String decreasedValue,
-    List<StringAttribute> decreasedValueAttributes,
-    String hint,
-    List<StringAttribute> hintAttributes,
-    String? tooltip,
-    int textDirection,
-    Float64List transform,
-    Int32List childrenInTraversalOrder,
-    Int32List childrenInHitTestOrder,
-    Int32List additionalActions,
-  ) native 'SemanticsUpdateBuilder_updateNode';
+
+  void _addInts(Int32List values) {
+    _reserveInts(values.length + 1);
+    _ints[_intCount++] = values.length;
+    _ints.setRange(_intCount, _intCount + values.length, values);
+    _intCount += values.length;
+  }
+
+  void _addDouble(double value) {
+    _reserveDoubles(1);
+    _doubles[_doubleCount++] = value;
+  }
+
+  void _addTransform(Float64List transform) {
+    _reserveDoubles(16);
+    _doubles.setRange(_doubleCount, _doubleCount + 16, transform);
+    _doubleCount += 16;
+  }
+
+  void _addString(String string, List<StringAttribute> attributes) {
+    _addInt(_stringIndices.putIfAbsent(string, () {
+      _strings.add(string);
+      return _strings.length - 1;
+    }));
+    _addInt(attributes.length);
+    _stringAttributes.addAll(attributes);
+  }
+
+  void _updateNodes(
+    Int32List ints,
+    Float64List doubles,
+    List<String> strings,
+    List<StringAttribute> stringAttributes,
+  ) native 'SemanticsUpdateBuilder_updateNodes';
 
   /// Update the custom semantics action associated with the given `id`.
   ///
@@ -991,6 +1018,19 @@ class SemanticsUpdateBuilder extends NativeFieldWrapperClass1 {
   /// The returned object can be passed to [PlatformDispatcher.updateSemantics]
   /// to actually update the semantics retained by the system.
   SemanticsUpdate build() {
+    if (_intCount > 0) {
+      _updateNodes(
+        Int32List.sublistView(_ints, 0, _intCount),
+        Float64List.sublistView(_doubles, 0, _doubleCount),
+        _strings,
+        _stringAttributes,
+      );
+      _intCount = 0;
+      _doubleCount = 0;
+      _strings.clear();
+      _stringIndices.clear();
+      _stringAttributes.clear();
+    }
     final SemanticsUpdate semanticsUpdate = SemanticsUpdate._();
     _build(semanticsUpdate);
     return semanticsUpdate;
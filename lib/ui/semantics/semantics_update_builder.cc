@@ -13,14 +13,6 @@
 
 namespace flutter {
 
-void pushStringAttributes(
-    StringAttributes& destination,
-    const std::vector<NativeStringAttribute*>& native_attributes) {
-  for (const auto& native_attribute : native_attributes) {
-    destination.push_back(native_attribute->GetAttribute());
-  }
-}
-
 static void SemanticsUpdateBuilder_constructor(Dart_NativeArguments args) {
   UIDartState::ThrowIfUIOperationsProhibited();
   DartCallConstructor(&SemanticsUpdateBuilder::create, args);
@@ -29,7 +21,7 @@ static void SemanticsUpdateBuilder_constructor(Dart_NativeArguments args) {
 IMPLEMENT_WRAPPERTYPEINFO(ui, SemanticsUpdateBuilder);
 
 #define FOR_EACH_BINDING(V)                     \
-  V(SemanticsUpdateBuilder, updateNode)         \
+  V(SemanticsUpdateBuilder, updateNodes)        \
   V(SemanticsUpdateBuilder, updateCustomAction) \
   V(SemanticsUpdateBuilder, build)
 
@@ -46,93 +38,122 @@ SemanticsUpdateBuilder::SemanticsUpdateBuilder() = default;
 
 SemanticsUpdateBuilder::~SemanticsUpdateBuilder() = default;
 
-void SemanticsUpdateBuilder::updateNode(
-    int id,
-    int flags,
-    int actions,
-    int maxValueLength,
-    int currentValueLength,
-    int textSelectionBase,
-    int textSelectionExtent,
-    int platformViewId,
-    int scrollChildren,
-    int scrollIndex,
-    double scrollPosition,
-    double scrollExtentMax,
-    double scrollExtentMin,
-    double left,
-    double top,
-    double right,
-    double bottom,
-    double elevation,
-    double thickness,
-    std::string label,
-    std::vector<NativeStringAttribute*> labelAttributes,
-    std::string value,
-    std::vector<NativeStringAttribute*> valueAttributes,
-    std::string increasedValue,
-    std::vector<NativeStringAttribute*> increasedValueAttributes,
-    std::string decreasedValue,
-    std::vector<NativeStringAttribute*> decreasedValueAttributes,
-    std::string hint,
-    std::vector<NativeStringAttribute*> hintAttributes,
-    std::string tooltip,
-    int textDirection,
-    const tonic::Float64List& transform,
-    const tonic::Int32List& childrenInTraversalOrder,
-    const tonic::Int32List& childrenInHitTestOrder,
-    const tonic::Int32List& localContextActions) {
-  FML_CHECK(transform.data() && SkScalarsAreFinite(*transform.data(), 9))
-      << "Semantics update transform was not set or not finite.";
-  FML_CHECK(scrollChildren == 0 ||
-            (scrollChildren > 0 && childrenInHitTestOrder.data()))
-      << "Semantics update contained scrollChildren but did not have "
-         "childrenInHitTestOrder";
-  SemanticsNode node;
-  node.id = id;
-  node.flags = flags;
-  node.actions = actions;
-  node.maxValueLength = maxValueLength;
-  node.currentValueLength = currentValueLength;
-  node.textSelectionBase = textSelectionBase;
-  node.textSelectionExtent = textSelectionExtent;
-  node.platformViewId = platformViewId;
-  node.scrollChildren = scrollChildren;
-  node.scrollIndex = scrollIndex;
-  node.scrollPosition = scrollPosition;
-  node.scrollExtentMax = scrollExtentMax;
-  node.scrollExtentMin = scrollExtentMin;
-  node.rect = SkRect::MakeLTRB(left, top, right, bottom);
-  node.elevation = elevation;
-  node.thickness = thickness;
-  node.label = label;
-  pushStringAttributes(node.labelAttributes, labelAttributes);
-  node.value = value;
-  pushStringAttributes(node.valueAttributes, valueAttributes);
-  node.increasedValue = increasedValue;
-  pushStringAttributes(node.increasedValueAttributes, increasedValueAttributes);
-  node.decreasedValue = decreasedValue;
-  pushStringAttributes(node.decreasedValueAttributes, decreasedValueAttributes);
-  node.hint = hint;
-  pushStringAttributes(node.hintAttributes, hintAttributes);
-  node.tooltip = tooltip;
-  node.textDirection = textDirection;
-  SkScalar scalarTransform[16];
-  for (int i = 0; i < 16; ++i) {
-    scalarTransform[i] = transform.data()[i];
+namespace {
+
+// Reads the nodes packed by the Dart side of the builder in order.
+class PackedSemanticsReader {
+ public:
+  PackedSemanticsReader(const tonic::Int32List& ints,
+                        const tonic::Float64List& doubles,
+                        const std::vector<std::string>& strings,
+                        const std::vector<NativeStringAttribute*>& attributes)
+      : ints_(ints),
+        doubles_(doubles),
+        strings_(strings),
+        attributes_(attributes) {}
+
+  bool HasNext() const { return int_index_ < ints_.num_elements(); }
+
+  int32_t ReadInt() {
+    FML_CHECK(int_index_ < ints_.num_elements())
+        << "Semantics update ended in the middle of a node.";
+    return ints_[int_index_++];
+  }
+
+  double ReadDouble() {
+    FML_CHECK(double_index_ < doubles_.num_elements())
+        << "Semantics update ended in the middle of a node.";
+    return doubles_[double_index_++];
+  }
+
+  std::vector<int32_t> ReadInts() {
+    const int32_t count = ReadInt();
+    FML_CHECK(count >= 0 && int_index_ + count <= ints_.num_elements())
+        << "Semantics update contained an invalid list.";
+    const int32_t* begin = ints_.data() + int_index_;
+    int_index_ += count;
+    return std::vector<int32_t>(begin, begin + count);
+  }
+
+  void ReadString(std::string& string, StringAttributes& string_attributes) {
+    const int32_t index = ReadInt();
+    FML_CHECK(index >= 0 && static_cast<size_t>(index) < strings_.size())
+        << "Semantics update referenced an unknown string.";
+    string = strings_[index];
+    const int32_t count = ReadInt();
+    FML_CHECK(count >= 0 && attribute_index_ + count <= attributes_.size())
+        << "Semantics update referenced unknown string attributes.";
+    for (int32_t i = 0; i < count; i++) {
+      string_attributes.push_back(
+          attributes_[attribute_index_++]->GetAttribute());
+    }
+  }
+
+ private:
+  const tonic::Int32List& ints_;
+  const tonic::Float64List& doubles_;
+  const std::vector<std::string>& strings_;
+  const std::vector<NativeStringAttribute*>& attributes_;
+  intptr_t int_index_ = 0;
+  intptr_t double_index_ = 0;
+  size_t attribute_index_ = 0;
+};
+
+}  // namespace
+
+void SemanticsUpdateBuilder::updateNodes(
+    const tonic::Int32List& ints,
+    const tonic::Float64List& doubles,
+    std::vector<std::string> strings,
+    std::vector<NativeStringAttribute*> string_attributes) {
+  PackedSemanticsReader reader(ints, doubles, strings, string_attributes);
+  while (reader.HasNext()) {
+    SemanticsNode node;
+    node.id = reader.ReadInt();
+    node.flags = reader.ReadInt();
+    node.actions = reader.ReadInt();
+    node.maxValueLength = reader.ReadInt();
+    node.currentValueLength = reader.ReadInt();
+    node.textSelectionBase = reader.ReadInt();
+    node.textSelectionExtent = reader.ReadInt();
+    node.platformViewId = reader.ReadInt();
+    node.scrollChildren = reader.ReadInt();
+    node.scrollIndex = reader.ReadInt();
+    node.textDirection = reader.ReadInt();
+    reader.ReadString(node.label, node.labelAttributes);
+    reader.ReadString(node.value, node.valueAttributes);
+    reader.ReadString(node.increasedValue, node.increasedValueAttributes);
+    reader.ReadString(node.decreasedValue, node.decreasedValueAttributes);
+    reader.ReadString(node.hint, node.hintAttributes);
+    StringAttributes tooltip_attributes;
+    reader.ReadString(node.tooltip, tooltip_attributes);
+    node.childrenInTraversalOrder = reader.ReadInts();
+    node.childrenInHitTestOrder = reader.ReadInts();
+    node.customAccessibilityActions = reader.ReadInts();
+    node.scrollPosition = reader.ReadDouble();
+    node.scrollExtentMax = reader.ReadDouble();
+    node.scrollExtentMin = reader.ReadDouble();
+    const double left = reader.ReadDouble();
+    const double top = reader.ReadDouble();
+    const double right = reader.ReadDouble();
+    const double bottom = reader.ReadDouble();
+    node.rect = SkRect::MakeLTRB(left, top, right, bottom);
+    node.elevation = reader.ReadDouble();
+    node.thickness = reader.ReadDouble();
+    SkScalar scalarTransform[16];
+    for (int i = 0; i < 16; ++i) {
+      scalarTransform[i] = reader.ReadDouble();
+    }
+    FML_CHECK(SkScalarsAreFinite(scalarTransform, 16))
+        << "Semantics update transform was not set or not finite.";
+    node.transform = SkM44::ColMajor(scalarTransform);
+    FML_CHECK(node.scrollChildren == 0 ||
+              (node.scrollChildren > 0 && !node.childrenInHitTestOrder.empty()))
+        << "Semantics update contained scrollChildren but did not have "
+           "childrenInHitTestOrder";
+    const int32_t id = node.id;
+    nodes_[id] = std::move(node);
   }
-  node.transform = SkM44::ColMajor(scalarTransform);
-  node.childrenInTraversalOrder =
-      std::vector<int32_t>(childrenInTraversalOrder.data(),
-                           childrenInTraversalOrder.data() +
-                               childrenInTraversalOrder.num_elements());
-  node.childrenInHitTestOrder = std::vector<int32_t>(
-      childrenInHitTestOrder.data(),
-      childrenInHitTestOrder.data() + childrenInHitTestOrder.num_elements());
-  node.customAccessibilityActions = std::vector<int32_t>(
-      localContextActions.data(),
-      localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
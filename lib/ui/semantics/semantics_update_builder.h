@@ -26,41 +26,12 @@ class SemanticsUpdateBuilder
 
   ~SemanticsUpdateBuilder() override;
 
-  void updateNode(int id,
-                  int flags,
-                  int actions,
-                  int maxValueLength,
-                  int currentValueLength,
-                  int textSelectionBase,
-                  int textSelectionExtent,
-                  int platformViewId,
-                  int scrollChildren,
-                  int scrollIndex,
-                  double scrollPosition,
-                  double scrollExtentMax,
-                  double scrollExtentMin,
-                  double left,
-                  double top,
-                  double right,
-                  double bottom,
-                  double elevation,
-                  double thickness,
-                  std::string label,
-                  std::vector<NativeStringAttribute*> labelAttributes,
-                  std::string value,
-                  std::vector<NativeStringAttribute*> valueAttributes,
-                  std::string increasedValue,
-                  std::vector<NativeStringAttribute*> increasedValueAttributes,
-                  std::string decreasedValue,
-                  std::vector<NativeStringAttribute*> decreasedValueAttributes,
-                  std::string hint,
-                  std::vector<NativeStringAttribute*> hintAttributes,
-                  std::string tooltip,
-                  int textDirection,
-                  const tonic::Float64List& transform,
-                  const tonic::Int32List& childrenInTraversalOrder,
-                  const tonic::Int32List& childrenInHitTestOrder,
-                  const tonic::Int32List& customAccessibilityActions);
+  // Decodes the nodes packed by `SemanticsUpdateBuilder.updateNode` in
+  // semantics.dart, which has to be kept in sync with this.
+  void updateNodes(const tonic::Int32List& ints,
+                   const tonic::Float64List& doubles,
+                   std::vector<std::string> strings,
+                   std::vector<NativeStringAttribute*> string_attributes);
 
   void updateCustomAction(int id,
                           std::string label,
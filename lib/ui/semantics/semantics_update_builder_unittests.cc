@@ -60,6 +60,11 @@ TEST_F(SemanticsUpdateBuilderTest, CanHandleAttributedStrings) {
     ASSERT_EQ(node.decreasedValueAttributes[0]->end, 6);
     ASSERT_EQ(node.decreasedValueAttributes[0]->type,
               StringAttributeType::kSpellOut);
+
+    ASSERT_EQ(node.textSelectionBase, -1);
+    ASSERT_EQ(node.platformViewId, -1);
+    ASSERT_EQ(node.rect, SkRect::MakeLTRB(0, 0, 10, 10));
+    ASSERT_TRUE(node.childrenInTraversalOrder.empty());
     message_latch->Signal();
   };
 
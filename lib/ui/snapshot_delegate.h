@@ -5,6 +5,10 @@
 #ifndef FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 #define FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 
+#include <functional>
+#include <vector>
+
+#include "flutter/flow/skia_gpu_object.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
@@ -20,6 +24,14 @@ class SnapshotDelegate {
                                             SkISize picture_size) = 0;
 
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
+
+  // Rasterizes each of the |draw_callbacks| into an image of |picture_size|
+  // in a single pass. Unlike |MakeRasterSnapshot|, the images are not copied
+  // back to the CPU and stay in GPU memory when there is a GPU context. The
+  // result has an image, or an empty object on failure, for each callback.
+  virtual std::vector<SkiaGPUObject<SkImage>> MakeGpuSnapshots(
+      const std::vector<std::function<void(SkCanvas*)>>& draw_callbacks,
+      SkISize picture_size) = 0;
 };
 
 }  // namespace flutter
@@ -3175,6 +3175,43 @@ class Paragraph extends NativeFieldWrapperClass1 {
   void layout(ParagraphConstraints constraints) => _layout(constraints.width);
   void _layout(double width) native 'Paragraph_layout';
 
+  /// Replaces the text from `start` to `end` with `text`, which takes the
+  /// style of the text before it.
+  ///
+  /// The paragraph has to be laid out again, which only breaks the lines of
+  /// the edited text again, so editing a large paragraph is cheaper than
+  /// building it again.
+  ///
+  /// Returns false if the paragraph can't be edited, such as when it has
+  /// placeholders, in which case the paragraph is unchanged and has to be
+  /// built again with the new text.
+  bool replaceText(int start, int end, String text) {
+    assert(start >= 0 && start <= end);
+    return _replaceText(start, end, text);
+  }
+  bool _replaceText(int start, int end, String text) native 'Paragraph_replaceText';
+
+  /// Lays out each of the `paragraphs` with the [ParagraphConstraints] of the
+  /// same index in `constraints`, as if [layout] was called for each of them.
+  ///
+  /// The paragraphs are laid out in parallel on the worker threads of the
+  /// engine, and this returns once all of them are laid out. This is faster
+  /// than calling [layout] for each of many paragraphs, for example to lay
+  /// out the items of a list that is shown for the first time.
+  ///
+  /// A paragraph that is listed more than once ends up laid out with the
+  /// last of its constraints.
+  static void layoutAll(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    final Float64List widths = Float64List(constraints.length);
+    for (int i = 0; i < constraints.length; i++)
+      widths[i] = constraints[i].width;
+    final String? error = _layoutAll(paragraphs, widths);
+    if (error != null)
+      throw Exception(error);
+  }
+  static String? _layoutAll(List<Paragraph> paragraphs, Float64List widths) native 'Paragraph_layoutAll';
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -3308,6 +3345,27 @@ class Paragraph extends NativeFieldWrapperClass1 {
     return metrics;
   }
   Float64List _computeLineMetrics() native 'Paragraph_computeLineMetrics';
+
+  /// Returns the positions of the lines, runs and glyphs of the laid out
+  /// paragraph, all in one buffer.
+  ///
+  /// This is meant for custom text rendering and selection code that would
+  /// otherwise call [getBoxesForRange] or [getPositionForOffset] for every
+  /// glyph. The buffer starts with the number of lines, runs and glyphs, in
+  /// that order, followed by:
+  ///
+  ///  * 7 values for each line: the start and end offsets of its text, its
+  ///    left, top, right and bottom edges, and its baseline.
+  ///  * 10 values for each run of glyphs in a single style and direction: its
+  ///    line number, the [TextDirection.index] of its direction, the start and
+  ///    end offsets of its text, its left, top, right and bottom edges, and the
+  ///    start and end indexes of its glyphs in the list of glyphs.
+  ///  * 4 values for each glyph: the start and end offsets of its text, and its
+  ///    left and right edges. The glyphs of a run are sorted by text offset.
+  ///
+  /// Coordinates are relative to the upper-left corner of the paragraph, where
+  /// positive y values indicate down.
+  Float64List computeGlyphLayout() native 'Paragraph_computeGlyphLayout';
 }
 
 /// Builds a [Paragraph] containing text with the given styling information.
@@ -49,7 +49,8 @@ SkFontStyleSet* AssetManagerFontProvider::MatchFamily(
 }
 
 void AssetManagerFontProvider::RegisterAsset(std::string family_name,
-                                             std::string asset) {
+                                             std::string asset,
+                                             std::optional<SkFontStyle> style) {
   std::string canonical_name = CanonicalFamilyName(family_name);
   auto family_it = registered_families_.find(canonical_name);
 
@@ -61,7 +62,7 @@ void AssetManagerFontProvider::RegisterAsset(std::string family_name,
     family_it = registered_families_.emplace(value).first;
   }
 
-  family_it->second->registerAsset(asset);
+  family_it->second->registerAsset(asset, style);
 }
 
 AssetManagerFontStyleSet::AssetManagerFontStyleSet(
@@ -71,8 +72,9 @@ AssetManagerFontStyleSet::AssetManagerFontStyleSet(
 
 AssetManagerFontStyleSet::~AssetManagerFontStyleSet() = default;
 
-void AssetManagerFontStyleSet::registerAsset(std::string asset) {
-  assets_.emplace_back(asset);
+void AssetManagerFontStyleSet::registerAsset(std::string asset,
+                                             std::optional<SkFontStyle> style) {
+  assets_.emplace_back(std::move(asset), style);
 }
 
 int AssetManagerFontStyleSet::count() {
@@ -84,9 +86,18 @@ void AssetManagerFontStyleSet::getStyle(int index,
                                         SkString* name) {
   FML_DCHECK(index < static_cast<int>(assets_.size()));
   if (style) {
-    sk_sp<SkTypeface> typeface(createTypeface(index));
-    if (typeface) {
-      *style = typeface->fontStyle();
+    TypefaceAsset& asset = assets_[index];
+    if (!asset.style) {
+      // Matching a style reads the styles of all the fonts of the family, so
+      // a font that is only loaded for its style is released again.
+      sk_sp<SkTypeface> typeface =
+          asset.typeface ? asset.typeface : LoadTypeface(asset);
+      if (typeface) {
+        asset.style = typeface->fontStyle();
+      }
+    }
+    if (asset.style) {
+      *style = *asset.style;
     }
   }
   if (name) {
@@ -102,23 +113,8 @@ SkTypeface* AssetManagerFontStyleSet::createTypeface(int i) {
 
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset.asset);
-    if (asset_mapping == nullptr) {
-      return nullptr;
-    }
-
-    fml::Mapping* asset_mapping_ptr = asset_mapping.release();
-    sk_sp<SkData> asset_data = SkData::MakeWithProc(
-        asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
-        MappingReleaseProc, asset_mapping_ptr);
-    std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
-
-    // Ownership of the stream is transferred.
-    asset.typeface = SkTypeface::MakeFromStream(std::move(stream));
+    asset.typeface = LoadTypeface(asset);
     if (!asset.typeface) {
-      FML_DLOG(ERROR) << "Unable to load font asset for family: "
-                      << family_name_;
       return nullptr;
     }
   }
@@ -126,12 +122,37 @@ SkTypeface* AssetManagerFontStyleSet::createTypeface(int i) {
   return SkRef(asset.typeface.get());
 }
 
+sk_sp<SkTypeface> AssetManagerFontStyleSet::LoadTypeface(
+    const TypefaceAsset& asset) const {
+  std::unique_ptr<fml::Mapping> asset_mapping =
+      asset_manager_->GetAsMapping(asset.asset);
+  if (asset_mapping == nullptr) {
+    return nullptr;
+  }
+
+  fml::Mapping* asset_mapping_ptr = asset_mapping.release();
+  sk_sp<SkData> asset_data = SkData::MakeWithProc(
+      asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
+      MappingReleaseProc, asset_mapping_ptr);
+  std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
+
+  // Ownership of the stream is transferred.
+  sk_sp<SkTypeface> typeface = SkTypeface::MakeFromStream(std::move(stream));
+  if (!typeface) {
+    FML_DLOG(ERROR) << "Unable to load font asset for family: "
+                    << family_name_;
+  }
+  return typeface;
+}
+
 SkTypeface* AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern) {
   return matchStyleCSS3(pattern);
 }
 
-AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(std::string a)
-    : asset(std::move(a)) {}
+AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(
+    std::string a,
+    std::optional<SkFontStyle> s)
+    : asset(std::move(a)), style(s) {}
 
 AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(
     const AssetManagerFontStyleSet::TypefaceAsset& other) = default;
@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -25,7 +26,10 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
   ~AssetManagerFontStyleSet() override;
 
-  void registerAsset(std::string asset);
+  // Registers a font of the family, with the style that the font manifest
+  // declares for it if there is one. The font is only loaded once it is used,
+  // or to read its style if the manifest doesn't declare it.
+  void registerAsset(std::string asset, std::optional<SkFontStyle> style);
 
   // |SkFontStyleSet|
   int count() override;
@@ -44,17 +48,20 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
   std::string family_name_;
 
   struct TypefaceAsset {
-    TypefaceAsset(std::string a);
+    TypefaceAsset(std::string a, std::optional<SkFontStyle> s);
 
     TypefaceAsset(const TypefaceAsset& other);
 
     ~TypefaceAsset();
 
     std::string asset;
+    std::optional<SkFontStyle> style;
     sk_sp<SkTypeface> typeface;
   };
   std::vector<TypefaceAsset> assets_;
 
+  sk_sp<SkTypeface> LoadTypeface(const TypefaceAsset& asset) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
 
@@ -64,7 +71,9 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
   ~AssetManagerFontProvider() override;
 
-  void RegisterAsset(std::string family_name, std::string asset);
+  void RegisterAsset(std::string family_name,
+                     std::string asset,
+                     std::optional<SkFontStyle> style = std::nullopt);
 
   // |FontAssetProvider|
   size_t GetFamilyCount() const override;
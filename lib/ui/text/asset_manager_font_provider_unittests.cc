@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/text/asset_manager_font_provider.h"
+
+#include <memory>
+
+#include "flutter/runtime/test_font_data.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Serves the first test font for every asset, and counts the loads.
+class FontAssetResolver : public AssetResolver {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool IsValidAfterAssetManagerChange() const override { return false; }
+
+  AssetResolver::AssetResolverType GetType() const override {
+    return AssetResolver::AssetResolverType::kAssetManager;
+  }
+
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    load_count_++;
+    std::unique_ptr<SkStreamAsset> font = std::move(GetTestFontData()[0]);
+    std::vector<uint8_t> data(font->getLength());
+    font->read(data.data(), data.size());
+    return std::make_unique<fml::DataMapping>(std::move(data));
+  }
+
+  int load_count() const { return load_count_; }
+
+ private:
+  mutable int load_count_ = 0;
+};
+
+}  // namespace
+
+TEST(AssetManagerFontProviderTest, FontsAreOnlyLoadedWhenUsed) {
+  auto resolver = std::make_unique<FontAssetResolver>();
+  FontAssetResolver* resolver_ptr = resolver.get();
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::move(resolver));
+
+  AssetManagerFontProvider provider(asset_manager);
+  provider.RegisterAsset("Family", "regular.ttf", SkFontStyle::Normal());
+  provider.RegisterAsset("Family", "bold.ttf", SkFontStyle::Bold());
+  provider.RegisterAsset("Family", "undeclared.ttf");
+  EXPECT_EQ(resolver_ptr->load_count(), 0);
+
+  sk_sp<SkFontStyleSet> style_set(provider.MatchFamily("Family"));
+  ASSERT_NE(style_set, nullptr);
+  ASSERT_EQ(style_set->count(), 3);
+
+  // The declared styles don't need the fonts.
+  SkFontStyle style;
+  style_set->getStyle(1, &style, nullptr);
+  EXPECT_EQ(style, SkFontStyle::Bold());
+  EXPECT_EQ(resolver_ptr->load_count(), 0);
+
+  // The font without a declared style is loaded to read it, but isn't kept.
+  style_set->getStyle(2, &style, nullptr);
+  EXPECT_EQ(resolver_ptr->load_count(), 1);
+  style_set->getStyle(2, &style, nullptr);
+  EXPECT_EQ(resolver_ptr->load_count(), 1);
+
+  sk_sp<SkTypeface> typeface(style_set->matchStyle(SkFontStyle::Bold()));
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_EQ(resolver_ptr->load_count(), 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -45,6 +45,25 @@ void _LoadFontFromList(Dart_NativeArguments args) {
   tonic::DartCallStatic(LoadFontFromList, args);
 }
 
+// Reads the weight and style that the manifest declares for a font, so that
+// matching a style doesn't have to load every font of the family.
+std::optional<SkFontStyle> GetManifestFontStyle(const rapidjson::Value& font) {
+  auto weight = font.FindMember("weight");
+  auto style = font.FindMember("style");
+  const bool has_weight = weight != font.MemberEnd() && weight->value.IsInt();
+  const bool has_style = style != font.MemberEnd() && style->value.IsString();
+  if (!has_weight && !has_style) {
+    return std::nullopt;
+  }
+  const bool italic =
+      has_style && std::string(style->value.GetString()) == "italic";
+  return SkFontStyle(has_weight ? weight->value.GetInt()
+                                : SkFontStyle::kNormal_Weight,
+                     SkFontStyle::kNormal_Width,
+                     italic ? SkFontStyle::kItalic_Slant
+                            : SkFontStyle::kUpright_Slant);
+}
+
 }  // namespace
 
 FontCollection::FontCollection()
@@ -124,9 +143,9 @@ void FontCollection::RegisterFonts(
         continue;
       }
 
-      // TODO(chinmaygarde): Handle weights and styles.
       font_provider->RegisterAsset(family_name->value.GetString(),
-                                   font_asset->value.GetString());
+                                   font_asset->value.GetString(),
+                                   GetManifestFontStyle(family_font));
     }
   }
 
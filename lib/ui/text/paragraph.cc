@@ -4,10 +4,18 @@
 
 #include "flutter/lib/ui/text/paragraph.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -29,15 +37,64 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
   V(Paragraph, ideographicBaseline)     \
   V(Paragraph, didExceedMaxLines)       \
   V(Paragraph, layout)                  \
+  V(Paragraph, replaceText)             \
   V(Paragraph, paint)                   \
   V(Paragraph, getWordBoundary)         \
   V(Paragraph, getLineBoundary)         \
   V(Paragraph, getRectsForRange)        \
   V(Paragraph, getRectsForPlaceholders) \
   V(Paragraph, getPositionForOffset)    \
-  V(Paragraph, computeLineMetrics)
+  V(Paragraph, computeLineMetrics)      \
+  V(Paragraph, computeGlyphLayout)
+
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+DART_NATIVE_CALLBACK_STATIC(Paragraph, layoutAll)
+
+void Paragraph::RegisterNatives(tonic::DartLibraryNatives* natives) {
+  natives->Register({DART_REGISTER_NATIVE_STATIC(Paragraph, layoutAll),
+                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+}
+
+namespace {
+
+// Lays out paragraphs on the workers that claim them, including the UI thread
+// that started the layout.
+class BatchLayout {
+ public:
+  BatchLayout(std::vector<txt::Paragraph*> paragraphs,
+              std::vector<double> widths)
+      : paragraphs_(std::move(paragraphs)),
+        widths_(std::move(widths)),
+        latch_(paragraphs_.size()) {}
+
+  // Lays out the paragraphs that no worker has claimed yet.
+  void LayoutParagraphs() {
+    size_t index;
+    while ((index = next_paragraph_.fetch_add(1)) < paragraphs_.size()) {
+      // The paragraphs are only accessed once they are claimed, which the UI
+      // thread waits for.
+      paragraphs_[index]->Layout(widths_[index]);
+      latch_.CountDown();
+    }
+  }
 
-DART_BIND_ALL(Paragraph, FOR_EACH_BINDING)
+  // Waits for all of the paragraphs to be laid out. Must be called after
+  // `LayoutParagraphs`, so that no paragraph is left to a worker that hasn't
+  // started yet.
+  void Wait() { latch_.Wait(); }
+
+  size_t paragraph_count() const { return paragraphs_.size(); }
+
+ private:
+  const std::vector<txt::Paragraph*> paragraphs_;
+  const std::vector<double> widths_;
+  std::atomic<size_t> next_paragraph_ = 0;
+  fml::CountDownLatch latch_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BatchLayout);
+};
+
+}  // namespace
 
 Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
     : m_paragraph(std::move(paragraph)) {}
@@ -87,6 +144,63 @@ void Paragraph::layout(double width) {
   m_paragraph->Layout(width);
 }
 
+bool Paragraph::replaceText(unsigned start,
+                            unsigned end,
+                            const std::u16string& text) {
+  return m_paragraph->ReplaceText(start, end, text);
+}
+
+Dart_Handle Paragraph::layoutAll(std::vector<Paragraph*> paragraphs,
+                                 tonic::Float64List widths) {
+  TRACE_EVENT0("flutter", "Paragraph::layoutAll");
+  // The widths are released before any other call into Dart.
+  std::vector<double> layout_widths(widths.data(),
+                                    widths.data() + widths.num_elements());
+  widths.Release();
+  if (paragraphs.size() != layout_widths.size()) {
+    return ToDart("There must be a width for each paragraph.");
+  }
+  // A paragraph that is listed more than once is laid out once, at its last
+  // width, which is where laying it out for each entry in turn leaves it.
+  // Two workers must never lay out the same paragraph at once.
+  std::vector<txt::Paragraph*> txt_paragraphs;
+  std::vector<double> txt_widths;
+  std::unordered_map<txt::Paragraph*, size_t> indexes;
+  txt_paragraphs.reserve(paragraphs.size());
+  txt_widths.reserve(paragraphs.size());
+  for (size_t i = 0; i < paragraphs.size(); i++) {
+    if (!paragraphs[i]) {
+      return ToDart("Paragraph is null");
+    }
+    txt::Paragraph* txt_paragraph = paragraphs[i]->m_paragraph.get();
+    auto [index, inserted] =
+        indexes.try_emplace(txt_paragraph, txt_paragraphs.size());
+    if (inserted) {
+      txt_paragraphs.push_back(txt_paragraph);
+      txt_widths.push_back(layout_widths[i]);
+    } else {
+      txt_widths[index->second] = layout_widths[i];
+    }
+  }
+
+  auto layout = std::make_shared<BatchLayout>(std::move(txt_paragraphs),
+                                              std::move(txt_widths));
+  auto runner = UIDartState::Current()->GetConcurrentTaskRunner();
+  if (runner) {
+    // The workers that start after the paragraphs have all been claimed
+    // return straight away, so the UI thread never waits for busy workers.
+    const size_t worker_count = std::min<size_t>(
+        layout->paragraph_count(),
+        std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t i = 1; i < worker_count; i++) {
+      runner->PostTask([layout]() { layout->LayoutParagraphs(); });
+    }
+  }
+  layout->LayoutParagraphs();
+  layout->Wait();
+  return Dart_Null();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   SkCanvas* sk_canvas = canvas->canvas();
   if (!sk_canvas) {
@@ -190,4 +304,56 @@ tonic::Float64List Paragraph::computeLineMetrics() {
   return result;
 }
 
+tonic::Float64List Paragraph::computeGlyphLayout() {
+  const std::vector<txt::LineMetrics>& metrics = m_paragraph->GetLineMetrics();
+  const txt::Paragraph::GlyphLayout layout = m_paragraph->GetGlyphLayout();
+
+  // Layout:
+  // The first 3 values are the numbers of lines, runs and glyphs.
+  // Then there are groups of 7 for the lines, which are the start and end
+  // of the line followed by LTRB and the baseline.
+  // Then there are groups of 10 for the runs, which are the line number, the
+  // text direction index, the start and end of the run, LTRB, and the range of
+  // the glyphs of the run.
+  // Then there are groups of 4 for the glyphs, which are the start and end of
+  // the glyph followed by its left and right.
+  tonic::Float64List result(Dart_NewTypedData(
+      Dart_TypedData_kFloat64, 3 + metrics.size() * 7 +
+                                   layout.runs.size() * 10 +
+                                   layout.glyphs.size() * 4));
+  uint64_t position = 0;
+  result[position++] = static_cast<double>(metrics.size());
+  result[position++] = static_cast<double>(layout.runs.size());
+  result[position++] = static_cast<double>(layout.glyphs.size());
+  for (const txt::LineMetrics& line : metrics) {
+    result[position++] = static_cast<double>(line.start_index);
+    result[position++] = static_cast<double>(line.end_index);
+    result[position++] = line.left;
+    result[position++] = line.baseline - line.ascent;
+    result[position++] = line.left + line.width;
+    result[position++] = line.baseline + line.descent;
+    result[position++] = line.baseline;
+  }
+  for (const txt::Paragraph::GlyphRunInfo& run : layout.runs) {
+    result[position++] = static_cast<double>(run.line_number);
+    result[position++] = static_cast<double>(run.direction);
+    result[position++] = static_cast<double>(run.start);
+    result[position++] = static_cast<double>(run.end);
+    result[position++] = run.bounds.fLeft;
+    result[position++] = run.bounds.fTop;
+    result[position++] = run.bounds.fRight;
+    result[position++] = run.bounds.fBottom;
+    result[position++] = static_cast<double>(run.glyph_start);
+    result[position++] = static_cast<double>(run.glyph_end);
+  }
+  for (const txt::Paragraph::GlyphInfo& glyph : layout.glyphs) {
+    result[position++] = static_cast<double>(glyph.start);
+    result[position++] = static_cast<double>(glyph.end);
+    result[position++] = glyph.left;
+    result[position++] = glyph.right;
+  }
+
+  return result;
+}
+
 }  // namespace flutter
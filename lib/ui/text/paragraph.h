@@ -41,6 +41,13 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   bool didExceedMaxLines();
 
   void layout(double width);
+  bool replaceText(unsigned start, unsigned end, const std::u16string& text);
+
+  // Lays out each paragraph at the width of the same index, on the concurrent
+  // workers as well as on the calling thread, and returns once all of them
+  // are laid out. Returns an error string if the arguments are invalid.
+  static Dart_Handle layoutAll(std::vector<Paragraph*> paragraphs,
+                               tonic::Float64List widths);
   void paint(Canvas* canvas, double x, double y);
 
   tonic::Float32List getRectsForRange(unsigned start,
@@ -52,6 +59,7 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   Dart_Handle getWordBoundary(unsigned offset);
   Dart_Handle getLineBoundary(unsigned offset);
   tonic::Float64List computeLineMetrics();
+  tonic::Float64List computeGlyphLayout();
 
   size_t GetAllocationSize() const override;
 
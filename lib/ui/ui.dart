@@ -17,8 +17,9 @@ import 'dart:async';
 import 'dart:collection' as collection;
 import 'dart:convert';
 import 'dart:developer' as developer;
+import 'dart:ffi' show FfiNative, Double, Float, Int32, Pointer, Void;
 import 'dart:io'; // ignore: unused_import
-import 'dart:isolate' show SendPort;
+import 'dart:isolate' show RawReceivePort, SendPort;
 import 'dart:math' as math;
 import 'dart:nativewrappers'; // ignore: unused_import
 import 'dart:typed_data';
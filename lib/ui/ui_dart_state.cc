@@ -7,6 +7,8 @@
 #include <iostream>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/lib/ui/compositing/scene_builder.h"
+#include "flutter/lib/ui/painting/picture_recorder.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_message_handler.h"
@@ -24,6 +26,16 @@ using tonic::ToDart;
 
 namespace flutter {
 
+// Enough for the pictures of the repaint boundaries that typically repaint
+// in a frame.
+static constexpr size_t kPictureRecorderPoolCapacity = 16;
+
+// The framework builds one scene per frame.
+static constexpr size_t kSceneBuilderPoolCapacity = 2;
+
+// Enough for the pictures of the repaint boundaries of a few frames.
+static constexpr size_t kDisplayListCacheCapacity = 64;
+
 UIDartState::Context::Context(const TaskRunners& task_runners)
     : task_runners(task_runners) {}
 
@@ -57,6 +69,7 @@ UIDartState::UIDartState(
     bool is_root_isolate,
     bool enable_skparagraph,
     bool enable_display_list,
+    bool defer_layer_tree_construction,
     const UIDartState::Context& context)
     : add_callback_(std::move(add_callback)),
       remove_callback_(std::move(remove_callback)),
@@ -67,7 +80,11 @@ UIDartState::UIDartState(
       isolate_name_server_(std::move(isolate_name_server)),
       enable_skparagraph_(enable_skparagraph),
       enable_display_list_(enable_display_list),
-      context_(std::move(context)) {
+      defer_layer_tree_construction_(defer_layer_tree_construction),
+      context_(std::move(context)),
+      picture_recorder_pool_(kPictureRecorderPoolCapacity),
+      scene_builder_pool_(kSceneBuilderPoolCapacity),
+      display_list_cache_(kDisplayListCacheCapacity) {
   AddOrRemoveTaskObserver(true /* add */);
 }
 
@@ -137,6 +154,16 @@ std::shared_ptr<VolatilePathTracker> UIDartState::GetVolatilePathTracker()
   return context_.volatile_path_tracker;
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+UIDartState::GetConcurrentTaskRunner() const {
+  return context_.concurrent_task_runner;
+}
+
+const UIDartState::PlatformMessageSender&
+UIDartState::GetPlatformMessageSender() const {
+  return context_.platform_message_sender;
+}
+
 void UIDartState::ScheduleMicrotask(Dart_Handle closure) {
   if (tonic::LogIfError(closure) || !Dart_IsClosure(closure)) {
     return;
@@ -244,4 +271,8 @@ bool UIDartState::enable_display_list() const {
   return enable_display_list_;
 }
 
+bool UIDartState::defer_layer_tree_construction() const {
+  return defer_layer_tree_construction_;
+}
+
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_UI_DART_STATE_H_
 #define FLUTTER_LIB_UI_UI_DART_STATE_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -13,13 +14,17 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/io_manager.h"
 #include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
+#include "flutter/lib/ui/painting/display_list_cache.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/recycling_pool.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
+#include "flutter/lib/ui/window/platform_message.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/tonic/dart_microtask_queue.h"
@@ -29,12 +34,19 @@
 namespace flutter {
 class FontSelector;
 class ImageGeneratorRegistry;
+class PictureRecorder;
 class PlatformConfiguration;
+class SceneBuilder;
 
 class UIDartState : public tonic::DartState {
  public:
   static UIDartState* Current();
 
+  /// Sends a platform message to the host platform on behalf of an isolate.
+  /// Callable on any thread.
+  using PlatformMessageSender =
+      std::function<void(std::unique_ptr<PlatformMessage>)>;
+
   /// @brief  The subset of state which is owned by the shell or engine
   ///         and passed through the RuntimeController into DartIsolates.
   ///         If a shell-owned resource needs to be exposed to the framework via
@@ -89,6 +101,16 @@ class UIDartState : public tonic::DartState {
 
     /// Cache for tracking path volatility.
     std::shared_ptr<VolatilePathTracker> volatile_path_tracker;
+
+    /// The task runner of the workers that the CPU intensive work of the
+    /// isolate's asynchronous operations, such as encoding images, is done
+    /// on. If null, that work is done on the IO thread.
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner;
+
+    /// Sends the platform messages of the isolates that don't have a platform
+    /// configuration, such as the background isolates spawned in the group of
+    /// the root isolate. If null, those isolates can't send platform messages.
+    PlatformMessageSender platform_message_sender;
   };
 
   Dart_Port main_port() const { return main_port_; }
@@ -118,6 +140,10 @@ class UIDartState : public tonic::DartState {
 
   std::shared_ptr<VolatilePathTracker> GetVolatilePathTracker() const;
 
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentTaskRunner() const;
+
+  const PlatformMessageSender& GetPlatformMessageSender() const;
+
   fml::WeakPtr<SnapshotDelegate> GetSnapshotDelegate() const;
 
   fml::WeakPtr<GrDirectContext> GetResourceContext() const;
@@ -145,6 +171,21 @@ class UIDartState : public tonic::DartState {
 
   bool enable_display_list() const;
 
+  bool defer_layer_tree_construction() const;
+
+  // Picture recorders, with their canvases, and scene builders that finished,
+  // for reuse by the next ones.
+  RecyclingPool<PictureRecorder>& GetPictureRecorderPool() {
+    return picture_recorder_pool_;
+  }
+  RecyclingPool<SceneBuilder>& GetSceneBuilderPool() {
+    return scene_builder_pool_;
+  }
+
+  // The display lists of recent pictures, for sharing with the pictures that
+  // are recorded again with the same content.
+  DisplayListCache& GetDisplayListCache() { return display_list_cache_; }
+
   template <class T>
   static flutter::SkiaGPUObject<T> CreateGPUObject(sk_sp<T> object) {
     if (!object) {
@@ -166,6 +207,7 @@ class UIDartState : public tonic::DartState {
               bool is_root_isolate_,
               bool enable_skparagraph,
               bool enable_display_list,
+              bool defer_layer_tree_construction,
               const UIDartState::Context& context);
 
   ~UIDartState() override;
@@ -193,7 +235,11 @@ class UIDartState : public tonic::DartState {
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   const bool enable_skparagraph_;
   const bool enable_display_list_;
+  const bool defer_layer_tree_construction_;
   UIDartState::Context context_;
+  RecyclingPool<PictureRecorder> picture_recorder_pool_;
+  RecyclingPool<SceneBuilder> scene_builder_pool_;
+  DisplayListCache display_list_cache_;
 
   void AddOrRemoveTaskObserver(bool add);
 };
@@ -4,8 +4,51 @@
 
 #include "flutter/lib/ui/volatile_path_tracker.h"
 
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 
+namespace {
+
+// Hashes the contents of the path consistently with SkPath::operator==,
+// which compares the fill type, verbs, points and conic weights.
+size_t HashPath(const SkPath& path) {
+  size_t hash = fml::HashCombine(static_cast<int>(path.getFillType()));
+  SkPath::Iter iter(path, false);
+  SkPoint pts[4];
+  SkPath::Verb verb;
+  while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+    int count = 0;
+    switch (verb) {
+      case SkPath::kMove_Verb:
+        count = 1;
+        break;
+      case SkPath::kLine_Verb:
+        count = 2;
+        break;
+      case SkPath::kQuad_Verb:
+        count = 3;
+        break;
+      case SkPath::kConic_Verb:
+        count = 3;
+        fml::HashCombineSeed(hash, iter.conicWeight());
+        break;
+      case SkPath::kCubic_Verb:
+        count = 4;
+        break;
+      default:
+        break;
+    }
+    fml::HashCombineSeed(hash, static_cast<int>(verb));
+    for (int i = 0; i < count; i++) {
+      fml::HashCombineSeed(hash, pts[i].fX, pts[i].fY);
+    }
+  }
+  return hash;
+}
+
+}  // namespace
+
 VolatilePathTracker::VolatilePathTracker(
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
     bool enabled)
@@ -42,9 +85,8 @@ void VolatilePathTracker::OnFrame() {
   if (!enabled_) {
     return;
   }
-  std::string total_count = std::to_string(paths_.size());
   TRACE_EVENT1("flutter", "VolatilePathTracker::OnFrame", "total_count",
-               total_count.c_str());
+               paths_.size());
 
   Drain();
 
@@ -59,9 +101,40 @@ void VolatilePathTracker::OnFrame() {
     }
   }
   paths_.swap(surviving_paths_);
-  std::string post_removal_count = std::to_string(paths_.size());
   TRACE_EVENT_INSTANT1("flutter", "VolatilePathTracker::OnFrame",
-                       "remaining_count", post_removal_count.c_str());
+                       "remaining_count", paths_.size());
+}
+
+const SkPath* VolatilePathTracker::FindSharedPath(const SkPath& path) {
+  FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
+  if (!enabled_ || path.isEmpty()) {
+    return nullptr;
+  }
+  size_t hash = HashPath(path);
+  auto range = shared_paths_by_hash_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->path == path) {
+      shared_paths_.splice(shared_paths_.begin(), shared_paths_, it->second);
+      return &shared_paths_.front().path;
+    }
+  }
+
+  if (shared_paths_.size() >= kMaxSharedPaths) {
+    const SharedPath& oldest = shared_paths_.back();
+    auto oldest_range = shared_paths_by_hash_.equal_range(oldest.hash);
+    for (auto it = oldest_range.first; it != oldest_range.second; ++it) {
+      if (it->second == std::prev(shared_paths_.end())) {
+        shared_paths_by_hash_.erase(it);
+        break;
+      }
+    }
+    shared_paths_.pop_back();
+  }
+  // The copy shares the points of |path| until either of them is mutated.
+  shared_paths_.push_front({hash, path});
+  shared_paths_.front().path.setIsVolatile(false);
+  shared_paths_by_hash_.emplace(hash, shared_paths_.begin());
+  return nullptr;
 }
 
 void VolatilePathTracker::Drain() {
@@ -73,9 +146,8 @@ void VolatilePathTracker::Drain() {
       paths_to_remove.swap(paths_to_remove_);
       needs_drain_ = false;
     }
-    std::string count = std::to_string(paths_to_remove.size());
     TRACE_EVENT_INSTANT1("flutter", "VolatilePathTracker::Drain", "count",
-                         count.c_str());
+                         paths_to_remove.size());
     for (auto& path : paths_to_remove) {
       paths_.erase(path);
     }
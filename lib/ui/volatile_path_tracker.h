@@ -6,8 +6,10 @@
 #define FLUTTER_LIB_VOLATILE_PATH_TRACKER_H_
 
 #include <deque>
+#include <list>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
@@ -28,6 +30,12 @@ namespace flutter {
 /// when paths are rendered. If deterministic rendering is needed, e.g. for a
 /// screen diffing test, this class will not cache any paths and will
 /// automatically set the volatility of the path to false.
+///
+/// The cache also remembers the contents of the last |kMaxSharedPaths| paths
+/// that were drawn, so that paths which widgets rebuild with identical
+/// contents every frame can share a single non-volatile SkPath. Sharing the
+/// SkPath keeps its generation ID stable, which lets Skia reuse the masks and
+/// tessellations it cached for the path.
 class VolatilePathTracker {
  public:
   /// The fields of this struct must only accessed on the UI task runner.
@@ -42,6 +50,8 @@ class VolatilePathTracker {
 
   static constexpr int kFramesOfVolatility = 2;
 
+  static constexpr size_t kMaxSharedPaths = 256;
+
   // Starts tracking a path.
   // Must be called from the UI task runner.
   //
@@ -62,14 +72,33 @@ class VolatilePathTracker {
   // Must be called from the UI task runner.
   void OnFrame();
 
+  // Looks up a path that was drawn before with the same contents as |path|.
+  //
+  // The first time some contents are looked up they are remembered and null
+  // is returned, so that paths that change every frame stay volatile. Later
+  // lookups return the shared, non-volatile path, which stays valid until the
+  // next call to this method.
+  //
+  // Must be called from the UI task runner.
+  const SkPath* FindSharedPath(const SkPath& path);
+
   bool enabled() const { return enabled_; }
 
  private:
+  struct SharedPath {
+    size_t hash;
+    SkPath path;
+  };
+
   fml::RefPtr<fml::TaskRunner> ui_task_runner_;
   std::atomic_bool needs_drain_ = false;
   std::mutex paths_to_remove_mutex_;
   std::deque<std::shared_ptr<TrackedPath>> paths_to_remove_;
   std::set<std::shared_ptr<TrackedPath>> paths_;
+  // Most recently used first.
+  std::list<SharedPath> shared_paths_;
+  std::unordered_multimap<size_t, std::list<SharedPath>::iterator>
+      shared_paths_by_hash_;
   bool enabled_ = true;
 
   void Drain();
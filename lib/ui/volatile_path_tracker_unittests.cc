@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/volatile_path_tracker.h"
+
+#include "flutter/testing/thread_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+using VolatilePathTrackerTest = ThreadTest;
+
+namespace {
+
+SkPath MakeTriangle(float size) {
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(size, 0);
+  path.lineTo(0, size);
+  path.close();
+  return path;
+}
+
+}  // namespace
+
+TEST_F(VolatilePathTrackerTest, IdenticalPathsShareThePathDrawnFirst) {
+  VolatilePathTracker tracker(GetCurrentTaskRunner(), true);
+  SkPath first = MakeTriangle(10);
+  first.setIsVolatile(true);
+  EXPECT_EQ(tracker.FindSharedPath(first), nullptr);
+
+  SkPath second = MakeTriangle(10);
+  const SkPath* shared = tracker.FindSharedPath(second);
+  ASSERT_NE(shared, nullptr);
+  EXPECT_EQ(*shared, second);
+  EXPECT_EQ(shared->getGenerationID(), first.getGenerationID());
+  EXPECT_FALSE(shared->isVolatile());
+
+  // Mutating the path drawn first leaves the shared path untouched.
+  first.lineTo(5, 5);
+  EXPECT_EQ(*tracker.FindSharedPath(MakeTriangle(10)), second);
+
+  EXPECT_EQ(tracker.FindSharedPath(MakeTriangle(20)), nullptr);
+}
+
+TEST_F(VolatilePathTrackerTest, LeastRecentlyDrawnPathsAreForgotten) {
+  VolatilePathTracker tracker(GetCurrentTaskRunner(), true);
+  for (size_t i = 0; i <= VolatilePathTracker::kMaxSharedPaths; i++) {
+    EXPECT_EQ(tracker.FindSharedPath(MakeTriangle(i + 1)), nullptr);
+  }
+  EXPECT_EQ(tracker.FindSharedPath(MakeTriangle(1)), nullptr);
+  EXPECT_NE(tracker.FindSharedPath(MakeTriangle(3)), nullptr);
+}
+
+TEST_F(VolatilePathTrackerTest, DoesNotSharePathsWhenDisabled) {
+  VolatilePathTracker tracker(GetCurrentTaskRunner(), false);
+  EXPECT_EQ(tracker.FindSharedPath(MakeTriangle(10)), nullptr);
+  EXPECT_EQ(tracker.FindSharedPath(MakeTriangle(10)), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
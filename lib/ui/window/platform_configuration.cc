@@ -4,11 +4,13 @@
 
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#include <cstdlib>
 #include <cstring>
 
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
+#include "flutter/lib/ui/window/platform_message_response_dart_port.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
 #include "flutter/lib/ui/window/window.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -141,6 +143,50 @@ void _SendPlatformMessage(Dart_NativeArguments args) {
   tonic::DartCallStatic(&SendPlatformMessage, args);
 }
 
+bool HasPlatformConfiguration(Dart_Handle window) {
+  return UIDartState::Current()->platform_configuration() != nullptr;
+}
+
+void _HasPlatformConfiguration(Dart_NativeArguments args) {
+  tonic::DartCallStatic(&HasPlatformConfiguration, args);
+}
+
+Dart_Handle SendPortPlatformMessage(Dart_Handle window,
+                                    const std::string& name,
+                                    Dart_Handle send_port,
+                                    Dart_Handle data_handle) {
+  UIDartState* dart_state = UIDartState::Current();
+
+  const auto& sender = dart_state->GetPlatformMessageSender();
+  if (!sender) {
+    return tonic::ToDart(
+        "Platform messages can only be sent from the main isolate or from the "
+        "isolates spawned in its group");
+  }
+
+  fml::RefPtr<PlatformMessageResponse> response;
+  if (!Dart_IsNull(send_port)) {
+    Dart_Port port = ILLEGAL_PORT;
+    Dart_SendPortGetId(send_port, &port);
+    response = fml::MakeRefCounted<PlatformMessageResponseDartPort>(port);
+  }
+  if (Dart_IsNull(data_handle)) {
+    sender(std::make_unique<PlatformMessage>(name, response));
+  } else {
+    tonic::DartByteData data(data_handle);
+    const uint8_t* buffer = static_cast<const uint8_t*>(data.data());
+    sender(std::make_unique<PlatformMessage>(
+        name, fml::MallocMapping::Copy(buffer, data.length_in_bytes()),
+        response));
+  }
+
+  return Dart_Null();
+}
+
+void _SendPortPlatformMessage(Dart_NativeArguments args) {
+  tonic::DartCallStatic(&SendPortPlatformMessage, args);
+}
+
 void RespondToPlatformMessage(Dart_Handle window,
                               int response_id,
                               const tonic::DartByteData& data) {
@@ -190,8 +236,27 @@ void _RespondToKeyData(Dart_NativeArguments args) {
   tonic::DartCallStatic(&RespondToKeyData, args);
 }
 
-Dart_Handle ToByteData(const fml::Mapping& buffer) {
-  return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
+// Small buffers are copied into the Dart heap, where they are cheaper to
+// allocate than the external typed data that wraps the larger ones.
+constexpr size_t kExternalByteDataThreshold = 1000;
+
+void FreeByteData(void* isolate_callback_data, void* peer) {
+  free(peer);
+}
+
+// Hands the buffer over to Dart without copying it when it's large.
+Dart_Handle ToByteData(fml::MallocMapping buffer) {
+  const size_t size = buffer.GetSize();
+  if (size < kExternalByteDataThreshold) {
+    return tonic::DartByteData::Create(buffer.GetMapping(), size);
+  }
+  uint8_t* data = buffer.Release();
+  Dart_Handle byte_data = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, data, size, data, size, FreeByteData);
+  if (Dart_IsError(byte_data)) {
+    free(data);
+  }
+  return byte_data;
 }
 
 }  // namespace
@@ -317,7 +382,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -348,7 +413,7 @@ void PlatformConfiguration::DispatchSemanticsAction(int32_t id,
   tonic::DartState::Scope scope(dart_state);
 
   Dart_Handle args_handle =
-      (args.GetSize() <= 0) ? Dart_Null() : ToByteData(args);
+      (args.GetSize() <= 0) ? Dart_Null() : ToByteData(std::move(args));
 
   if (Dart_IsError(args_handle)) {
     return;
@@ -493,6 +558,10 @@ void PlatformConfiguration::RegisterNatives(
       {"PlatformConfiguration_scheduleFrame", ScheduleFrame, 1, true},
       {"PlatformConfiguration_sendPlatformMessage", _SendPlatformMessage, 4,
        true},
+      {"PlatformConfiguration_hasPlatformConfiguration",
+       _HasPlatformConfiguration, 1, true},
+      {"PlatformConfiguration_sendPortPlatformMessage",
+       _SendPortPlatformMessage, 4, true},
       {"PlatformConfiguration_respondToPlatformMessage",
        _RespondToPlatformMessage, 3, true},
       {"PlatformConfiguration_respondToKeyData", _RespondToKeyData, 3, true},
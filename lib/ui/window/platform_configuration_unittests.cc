@@ -32,6 +32,7 @@ class DummyPlatformConfigurationClient : public PlatformConfigurationClient {
   void HandlePlatformMessage(
       std::unique_ptr<PlatformMessage> message) override {}
   FontCollection& GetFontCollection() override { return font_collection_; }
+  std::shared_ptr<AssetManager> GetAssetManager() override { return nullptr; }
   void UpdateIsolateDescription(const std::string isolate_name,
                                 int64_t isolate_port) override {}
   void SetNeedsReportTimings(bool value) override {}
@@ -14,13 +14,16 @@ PlatformMessage::PlatformMessage(std::string channel,
     : channel_(std::move(channel)),
       data_(std::move(data)),
       hasData_(true),
-      response_(std::move(response)) {}
+      response_(std::move(response)),
+      memory_account_(fml::MemoryCategory::kPlatformMessages,
+                      data_.GetSize()) {}
 PlatformMessage::PlatformMessage(std::string channel,
                                  fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
       data_(),
       hasData_(false),
-      response_(std::move(response)) {}
+      response_(std::move(response)),
+      memory_account_(fml::MemoryCategory::kPlatformMessages) {}
 
 PlatformMessage::~PlatformMessage() = default;
 
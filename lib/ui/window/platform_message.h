@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "flutter/fml/memory/memory_accounting.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
@@ -31,13 +32,18 @@ class PlatformMessage {
     return response_;
   }
 
-  fml::MallocMapping releaseData() { return std::move(data_); }
+  // The data is no longer accounted for once it is released.
+  fml::MallocMapping releaseData() {
+    memory_account_.Reset();
+    return std::move(data_);
+  }
 
  private:
   std::string channel_;
   fml::MallocMapping data_;
   bool hasData_;
   fml::RefPtr<PlatformMessageResponse> response_;
+  fml::ScopedMemoryAccount memory_account_;
 };
 
 }  // namespace flutter
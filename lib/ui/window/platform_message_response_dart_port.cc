@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_response_dart_port.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "third_party/dart/runtime/include/dart_native_api.h"
+
+namespace flutter {
+
+PlatformMessageResponseDartPort::PlatformMessageResponseDartPort(
+    Dart_Port send_port)
+    : send_port_(send_port) {
+  FML_DCHECK(send_port != ILLEGAL_PORT);
+}
+
+PlatformMessageResponseDartPort::~PlatformMessageResponseDartPort() {
+  // The isolate waits on the port for the response, so a message that is
+  // dropped without one must still close the wait.
+  if (!is_complete_) {
+    CompleteEmpty();
+  }
+}
+
+void PlatformMessageResponseDartPort::Complete(
+    std::unique_ptr<fml::Mapping> data) {
+  if (!data) {
+    CompleteEmpty();
+    return;
+  }
+  FML_DCHECK(!is_complete_);
+  is_complete_ = true;
+  Dart_CObject response;
+  response.type = Dart_CObject_kTypedData;
+  response.value.as_typed_data.type = Dart_TypedData_kUint8;
+  response.value.as_typed_data.length = data->GetSize();
+  response.value.as_typed_data.values =
+      const_cast<uint8_t*>(data->GetMapping());
+  // The data is copied into the isolate of the port.
+  if (!Dart_PostCObject(send_port_, &response)) {
+    FML_DLOG(WARNING) << "Could not post the platform message response.";
+  }
+}
+
+void PlatformMessageResponseDartPort::CompleteEmpty() {
+  FML_DCHECK(!is_complete_);
+  is_complete_ = true;
+  Dart_CObject response;
+  response.type = Dart_CObject_kNull;
+  if (!Dart_PostCObject(send_port_, &response)) {
+    FML_DLOG(WARNING) << "Could not post the platform message response.";
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_RESPONSE_DART_PORT_H_
+#define FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_RESPONSE_DART_PORT_H_
+
+#include "flutter/lib/ui/window/platform_message_response.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+/// A \ref PlatformMessageResponse that posts the response to a Dart port.
+///
+/// This is used for the messages of the isolates that don't run on the UI
+/// thread, such as the background isolates spawned in the group of the root
+/// isolate. The response is received as a `Uint8List`, or as null if the
+/// message had no response.
+class PlatformMessageResponseDartPort : public PlatformMessageResponse {
+  FML_FRIEND_MAKE_REF_COUNTED(PlatformMessageResponseDartPort);
+
+ public:
+  // Callable on any thread.
+  void Complete(std::unique_ptr<fml::Mapping> data) override;
+  void CompleteEmpty() override;
+
+ protected:
+  explicit PlatformMessageResponseDartPort(Dart_Port send_port);
+  ~PlatformMessageResponseDartPort() override;
+
+  Dart_Port send_port_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_RESPONSE_DART_PORT_H_
@@ -20,4 +20,14 @@ void PointerDataPacket::SetPointerData(size_t i, const PointerData& data) {
   memcpy(&data_[i * sizeof(PointerData)], &data, sizeof(PointerData));
 }
 
+void PointerDataPacket::Resize(size_t count) {
+  data_.resize(count * sizeof(PointerData));
+}
+
+PointerData PointerDataPacket::GetPointerData(size_t i) const {
+  PointerData data;
+  memcpy(&data, &data_[i * sizeof(PointerData)], sizeof(PointerData));
+  return data;
+}
+
 }  // namespace flutter
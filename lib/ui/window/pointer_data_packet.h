@@ -20,6 +20,10 @@ class PointerDataPacket {
   ~PointerDataPacket();
 
   void SetPointerData(size_t i, const PointerData& data);
+  PointerData GetPointerData(size_t i) const;
+  size_t GetLength() const { return data_.size() / sizeof(PointerData); }
+  // Changes the number of pointer data in the packet, keeping the first ones.
+  void Resize(size_t count);
   const std::vector<uint8_t>& data() const { return data_; }
 
  private:
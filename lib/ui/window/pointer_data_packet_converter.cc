@@ -4,41 +4,62 @@
 
 #include "flutter/lib/ui/window/pointer_data_packet_converter.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "flutter/fml/logging.h"
 
 namespace flutter {
 
+PointerStates::PointerStates() = default;
+
+PointerStates::~PointerStates() = default;
+
+PointerStates::iterator PointerStates::find(int64_t device) {
+  return std::find_if(
+      entries_.begin(), entries_.end(),
+      [device](const Entry& entry) { return entry.first == device; });
+}
+
+PointerState& PointerStates::operator[](int64_t device) {
+  auto iter = find(device);
+  if (iter != entries_.end()) {
+    return iter->second;
+  }
+  return entries_.emplace_back(device, PointerState{}).second;
+}
+
+void PointerStates::erase(int64_t device) {
+  auto iter = find(device);
+  if (iter != entries_.end()) {
+    // The order of the states doesn't matter.
+    *iter = std::move(entries_.back());
+    entries_.pop_back();
+  }
+}
+
 PointerDataPacketConverter::PointerDataPacketConverter() : pointer_(0) {}
 
 PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     std::unique_ptr<PointerDataPacket> packet) {
-  size_t kBytesPerPointerData = kPointerDataFieldCount * kBytesPerField;
-  auto buffer = packet->data();
-  size_t buffer_length = buffer.size();
-
-  std::vector<PointerData> converted_pointers;
+  converted_pointers_.clear();
   // Converts each pointer data in the buffer and stores it in the
-  // converted_pointers.
-  for (size_t i = 0; i < buffer_length / kBytesPerPointerData; i++) {
-    PointerData pointer_data;
-    memcpy(&pointer_data, &buffer[i * kBytesPerPointerData],
-           sizeof(PointerData));
-    ConvertPointerData(pointer_data, converted_pointers);
+  // converted_pointers_.
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    ConvertPointerData(packet->GetPointerData(i), converted_pointers_);
   }
 
-  // Writes converted_pointers into converted_packet.
-  auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
+  // Writes converted_pointers_ back into the packet, whose buffer only grows
+  // when pointer data was synthesized.
+  packet->Resize(converted_pointers_.size());
   size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
-    converted_packet->SetPointerData(count++, converted_pointer);
+  for (auto& converted_pointer : converted_pointers_) {
+    packet->SetPointerData(count++, converted_pointer);
   }
 
-  return converted_packet;
+  return packet;
 }
 
 void PointerDataPacketConverter::ConvertPointerData(
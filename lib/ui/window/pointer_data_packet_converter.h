@@ -6,8 +6,8 @@
 #define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_PACKET_CONVERTER_H_
 
 #include <cstring>
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -35,6 +35,37 @@ struct PointerState {
   int64_t buttons;
 };
 
+//------------------------------------------------------------------------------
+/// The states of the pointers that are currently added, keyed by their device.
+///
+/// There are only ever a handful of pointers, so the states are kept in a
+/// vector that is searched linearly instead of a tree, which would allocate a
+/// node whenever a pointer is added.
+///
+class PointerStates {
+ public:
+  using Entry = std::pair<int64_t, PointerState>;
+  using iterator = std::vector<Entry>::iterator;
+
+  PointerStates();
+  ~PointerStates();
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+
+  iterator find(int64_t device);
+
+  // Returns the state of the device, adding a default one if there is none.
+  PointerState& operator[](int64_t device);
+
+  void erase(int64_t device);
+
+ private:
+  std::vector<Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerStates);
+};
+
 //------------------------------------------------------------------------------
 /// Converter to convert the raw pointer data packet from the platforms.
 ///
@@ -87,15 +118,20 @@ class PointerDataPacketConverter {
   /// filled.
   ///             It may contain synthetic pointer data as the result of
   ///             converter's attempt to correct illegal pointer transitions.
+  ///             The converted packet reuses the buffer of the raw packet.
   ///
   std::unique_ptr<PointerDataPacket> Convert(
       std::unique_ptr<PointerDataPacket> packet);
 
  private:
-  std::map<int64_t, PointerState> states_;
+  PointerStates states_;
 
   int64_t pointer_;
 
+  // Holds the converted pointers of a packet until they are written back to
+  // it, and is kept between packets so that its storage is reused.
+  std::vector<PointerData> converted_pointers_;
+
   void ConvertPointerData(PointerData pointer_data,
                           std::vector<PointerData>& converted_pointers);
 
@@ -599,5 +599,44 @@ TEST(PointerDataPacketConverterTest, CanConvetScroll) {
   ASSERT_EQ(result[6].scroll_delta_y, 0.0);
 }
 
+TEST(PointerDataPacketConverterTest, ReusesTheBufferOfTheRawPacket) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(2);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(1, data);
+  const uint8_t* raw_buffer = packet->data().data();
+  auto converted_packet = converter.Convert(std::move(packet));
+  ASSERT_EQ(converted_packet->data().data(), raw_buffer);
+  ASSERT_EQ(converted_packet->GetLength(), 2u);
+
+  // Removing the first device must keep the state of the second one.
+  packet = std::make_unique<PointerDataPacket>(4);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 1, 5.0, 0.0, 1);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kUp, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kRemove, 0, 0.0, 0.0,
+                             0);
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 1, 5.0, 7.0, 1);
+  packet->SetPointerData(3, data);
+  converted_packet = converter.Convert(std::move(packet));
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+  // A synthesized add for device 1 is followed by its down.
+  ASSERT_EQ(result.size(), (size_t)5);
+  ASSERT_EQ(result[0].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[0].synthesized, 1);
+  ASSERT_EQ(result[4].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[4].device, 1);
+  ASSERT_EQ(result[4].pointer_identifier, 2);
+  ASSERT_EQ(result[4].physical_delta_x, 0.0);
+  ASSERT_EQ(result[4].physical_delta_y, 7.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
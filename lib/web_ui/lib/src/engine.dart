@@ -290,6 +290,8 @@ export 'engine/text/canvas_paragraph.dart';
 
 export 'engine/text/font_collection.dart';
 
+export 'engine/text/glyph_layout.dart';
+
 export 'engine/text/layout_service.dart';
 
 export 'engine/text/line_break_properties.dart';
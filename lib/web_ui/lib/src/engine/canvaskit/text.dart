@@ -2,9 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:typed_data';
+
 import 'package:meta/meta.dart';
 import 'package:ui/ui.dart' as ui;
 
+import '../text/glyph_layout.dart';
 import '../util.dart';
 import 'canvaskit_api.dart';
 import 'font_fallbacks.dart';
@@ -653,6 +656,53 @@ class CkParagraph extends SkiaObject<SkParagraph> implements ui.Paragraph {
     }
   }
 
+  /// The text of the paragraph, without its placeholders.
+  String get _text => _paragraphCommands
+      .where((_ParagraphCommand command) =>
+          command.type == _ParagraphCommandType.addText)
+      .map((_ParagraphCommand command) => command.text!)
+      .join();
+
+  @override
+  bool replaceText(int start, int end, String text) {
+    final bool hasPlaceholders = _paragraphCommands.any(
+        (_ParagraphCommand command) =>
+            command.type == _ParagraphCommandType.addPlaceholder);
+    final String oldText = _text;
+    if (start < 0 || start > end || end > oldText.length ||
+        oldText.isEmpty || hasPlaceholders) {
+      return false;
+    }
+
+    // CanvasKit paragraphs can't be edited, so the paragraph is built again
+    // from the edited commands and laid out with the last constraints.
+    final String newText = oldText.replaceRange(start, end, text);
+    int offset = 0;
+    for (int i = 0; i < _paragraphCommands.length; i++) {
+      final _ParagraphCommand command = _paragraphCommands[i];
+      if (command.type != _ParagraphCommandType.addText) {
+        continue;
+      }
+      final int commandEnd = offset + command.text!.length;
+      _paragraphCommands[i] = _ParagraphCommand.addText(newText.substring(
+        offsetAfterReplacement(offset, start, end, text.length),
+        offsetAfterReplacement(commandEnd, start, end, text.length),
+      ));
+      offset = commandEnd;
+    }
+
+    final SkParagraph? paragraph = _skParagraph;
+    if (paragraph != null) {
+      paragraph.delete();
+      _skParagraph = null;
+      final ui.ParagraphConstraints? constraints = _lastLayoutConstraints;
+      if (constraints != null) {
+        _ensureInitialized(constraints);
+      }
+    }
+    return true;
+  }
+
   @override
   void delete() {
     _skParagraph!.delete();
@@ -791,6 +841,11 @@ class CkParagraph extends SkiaObject<SkParagraph> implements ui.Paragraph {
     }
     return result;
   }
+
+  @override
+  Float64List computeGlyphLayout() {
+    return computeGlyphLayoutFromBoxes(this, _text);
+  }
 }
 
 class CkLineMetrics implements ui.LineMetrics {
@@ -428,6 +428,33 @@ class SurfaceCanvas implements ui.Canvas {
     _canvas.drawRawPoints(pointMode, points, paint as SurfacePaint);
   }
 
+  @override
+  void drawRawRects(Float32List rects, ui.Paint paint) {
+    assert(rects != null); // ignore: unnecessary_null_comparison
+    assert(paint != null); // ignore: unnecessary_null_comparison
+    if (rects.length % 4 != 0) {
+      throw ArgumentError('"rects" must have a multiple of four values.');
+    }
+    for (int i = 0; i < rects.length; i += 4) {
+      drawRect(
+        ui.Rect.fromLTRB(rects[i], rects[i + 1], rects[i + 2], rects[i + 3]),
+        paint,
+      );
+    }
+  }
+
+  @override
+  void drawRawCircles(Float32List circles, ui.Paint paint) {
+    assert(circles != null); // ignore: unnecessary_null_comparison
+    assert(paint != null); // ignore: unnecessary_null_comparison
+    if (circles.length % 3 != 0) {
+      throw ArgumentError('"circles" must have a multiple of three values.');
+    }
+    for (int i = 0; i < circles.length; i += 3) {
+      drawCircle(ui.Offset(circles[i], circles[i + 1]), circles[i + 2], paint);
+    }
+  }
+
   @override
   void drawVertices(
       ui.Vertices vertices, ui.BlendMode blendMode, ui.Paint paint) {
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 import 'dart:html' as html;
+import 'dart:typed_data';
 
 import 'package:ui/ui.dart' as ui;
 
@@ -10,6 +11,7 @@ import '../dom_renderer.dart';
 import '../html/bitmap_canvas.dart';
 import '../profiler.dart';
 import '../util.dart';
+import 'glyph_layout.dart';
 import 'layout_service.dart';
 import 'paint_service.dart';
 import 'paragraph.dart';
@@ -36,13 +38,13 @@ class CanvasParagraph implements EngineParagraph {
   });
 
   /// The flat list of spans that make up this paragraph.
-  final List<ParagraphSpan> spans;
+  List<ParagraphSpan> spans;
 
   /// General styling information for this paragraph.
   final EngineParagraphStyle paragraphStyle;
 
   /// The full textual content of the paragraph.
-  final String plainText;
+  String plainText;
 
   /// The number of placeholders in this paragraph.
   final int placeholderCount;
@@ -117,6 +119,35 @@ class CanvasParagraph implements EngineParagraph {
     _cachedDomElement = null;
   }
 
+  @override
+  bool replaceText(int start, int end, String text) {
+    if (start < 0 || start > end || end > plainText.length ||
+        placeholderCount > 0 || spans.isEmpty) {
+      return false;
+    }
+
+    // There is no incremental layout, so the paragraph is laid out again from
+    // scratch with the new text.
+    spans = <ParagraphSpan>[
+      for (final ParagraphSpan span in spans)
+        FlatTextSpan(
+          style: (span as FlatTextSpan).style,
+          start: offsetAfterReplacement(span.start, start, end, text.length),
+          end: offsetAfterReplacement(span.end, start, end, text.length),
+        ),
+    ];
+    plainText = plainText.replaceRange(start, end, text);
+    isLaidOut = false;
+    _cachedDomElement = null;
+
+    final ui.ParagraphConstraints? constraints = _lastUsedConstraints;
+    if (constraints != null) {
+      _lastUsedConstraints = null;
+      layout(constraints);
+    }
+    return true;
+  }
+
   // TODO(mdebbar): Returning true means we always require a bitmap canvas. Revisit
   // this decision once `CanvasParagraph` is fully implemented.
   @override
@@ -289,6 +320,11 @@ class CanvasParagraph implements EngineParagraph {
   List<EngineLineMetrics> computeLineMetrics() {
     return _layoutService.lines;
   }
+
+  @override
+  Float64List computeGlyphLayout() {
+    return computeGlyphLayoutFromBoxes(this, plainText);
+  }
 }
 
 /// Applies a paragraph [style] to an [element], translating the properties to
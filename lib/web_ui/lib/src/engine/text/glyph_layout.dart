@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:typed_data';
+
+import 'package:ui/ui.dart' as ui;
+
+/// Computes the buffer returned by `Paragraph.computeGlyphLayout` from the
+/// boxes of the characters of a laid out [paragraph] with the given [text].
+///
+/// Neither web renderer exposes its glyphs, so every character, or surrogate
+/// pair, is a glyph and its boxes are queried one at a time. Runs are split by
+/// line and direction, but not by style.
+Float64List computeGlyphLayoutFromBoxes(ui.Paragraph paragraph, String text) {
+  final List<ui.LineMetrics> lines = paragraph.computeLineMetrics();
+  if (lines.isEmpty) {
+    return Float64List(3);
+  }
+  final List<_GlyphBox> glyphs = <_GlyphBox>[];
+
+  int offset = 0;
+  while (offset < text.length) {
+    int end = offset + 1;
+    if (end < text.length &&
+        _isHighSurrogate(text.codeUnitAt(offset)) &&
+        _isLowSurrogate(text.codeUnitAt(end))) {
+      end++;
+    }
+    final List<ui.TextBox> boxes = paragraph.getBoxesForRange(offset, end);
+    if (boxes.isNotEmpty) {
+      double left = boxes.first.left;
+      double right = boxes.first.right;
+      for (final ui.TextBox box in boxes) {
+        left = left < box.left ? left : box.left;
+        right = right > box.right ? right : box.right;
+      }
+      final ui.TextBox first = boxes.first;
+      glyphs.add(_GlyphBox(
+        start: offset,
+        end: end,
+        left: left,
+        right: right,
+        line: _lineOf(lines, (first.top + first.bottom) / 2),
+        direction: first.direction,
+      ));
+    }
+    offset = end;
+  }
+
+  final List<_GlyphRun> runs = <_GlyphRun>[];
+  for (int i = 0; i < glyphs.length; i++) {
+    final _GlyphBox glyph = glyphs[i];
+    final _GlyphRun? run = runs.isEmpty ? null : runs.last;
+    if (run != null &&
+        run.line == glyph.line &&
+        run.direction == glyph.direction) {
+      run.glyphEnd = i + 1;
+    } else {
+      runs.add(_GlyphRun(glyph.line, glyph.direction, i));
+    }
+  }
+
+  final Float64List result = Float64List(
+      3 + lines.length * 7 + runs.length * 10 + glyphs.length * 4);
+  int position = 0;
+  result[position++] = lines.length.toDouble();
+  result[position++] = runs.length.toDouble();
+  result[position++] = glyphs.length.toDouble();
+
+  final List<int> lineEnds = List<int>.filled(lines.length, 0);
+  for (final _GlyphBox glyph in glyphs) {
+    lineEnds[glyph.line] = glyph.end;
+  }
+  int lineStart = 0;
+  for (int i = 0; i < lines.length; i++) {
+    final ui.LineMetrics line = lines[i];
+    final int lineEnd = lineEnds[i] > lineStart ? lineEnds[i] : lineStart;
+    result[position++] = lineStart.toDouble();
+    result[position++] = lineEnd.toDouble();
+    result[position++] = line.left;
+    result[position++] = line.baseline - line.ascent;
+    result[position++] = line.left + line.width;
+    result[position++] = line.baseline + line.descent;
+    result[position++] = line.baseline;
+    lineStart = lineEnd;
+  }
+
+  for (final _GlyphRun run in runs) {
+    final ui.LineMetrics line = lines[run.line];
+    double left = glyphs[run.glyphStart].left;
+    double right = glyphs[run.glyphStart].right;
+    for (int i = run.glyphStart; i < run.glyphEnd; i++) {
+      left = left < glyphs[i].left ? left : glyphs[i].left;
+      right = right > glyphs[i].right ? right : glyphs[i].right;
+    }
+    result[position++] = run.line.toDouble();
+    result[position++] = run.direction.index.toDouble();
+    result[position++] = glyphs[run.glyphStart].start.toDouble();
+    result[position++] = glyphs[run.glyphEnd - 1].end.toDouble();
+    result[position++] = left;
+    result[position++] = line.baseline - line.ascent;
+    result[position++] = right;
+    result[position++] = line.baseline + line.descent;
+    result[position++] = run.glyphStart.toDouble();
+    result[position++] = run.glyphEnd.toDouble();
+  }
+
+  for (final _GlyphBox glyph in glyphs) {
+    result[position++] = glyph.start.toDouble();
+    result[position++] = glyph.end.toDouble();
+    result[position++] = glyph.left;
+    result[position++] = glyph.right;
+  }
+  assert(position == result.length);
+  return result;
+}
+
+bool _isHighSurrogate(int codeUnit) => (codeUnit & 0xFC00) == 0xD800;
+
+bool _isLowSurrogate(int codeUnit) => (codeUnit & 0xFC00) == 0xDC00;
+
+/// Returns the index of the line that contains [y], or of the last line above
+/// it.
+int _lineOf(List<ui.LineMetrics> lines, double y) {
+  for (int i = 0; i < lines.length; i++) {
+    if (y < lines[i].baseline + lines[i].descent) {
+      return i;
+    }
+  }
+  return lines.length - 1;
+}
+
+class _GlyphBox {
+  _GlyphBox({
+    required this.start,
+    required this.end,
+    required this.left,
+    required this.right,
+    required this.line,
+    required this.direction,
+  });
+
+  final int start;
+  final int end;
+  final double left;
+  final double right;
+  final int line;
+  final ui.TextDirection direction;
+}
+
+class _GlyphRun {
+  _GlyphRun(this.line, this.direction, this.glyphStart)
+      : glyphEnd = glyphStart + 1;
+
+  final int line;
+  final ui.TextDirection direction;
+  final int glyphStart;
+  int glyphEnd;
+}
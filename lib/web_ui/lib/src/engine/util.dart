@@ -530,6 +530,23 @@ int clampInt(int value, int min, int max) {
   }
 }
 
+/// Maps [offset] to the new text after the range from [start] to [end] was
+/// replaced with [length] code units.
+///
+/// Offsets in the replaced range move past the new text, so the span that ends
+/// at [start] takes the new text, like in `Paragraph.replaceText`. Offset 0
+/// doesn't move, so the first span takes text inserted at the beginning.
+int offsetAfterReplacement(int offset, int start, int end, int length) {
+  assert(start <= end);
+  if (offset == 0 || offset < start) {
+    return offset;
+  } else if (offset >= end) {
+    return offset + length - (end - start);
+  } else {
+    return start + length;
+  }
+}
+
 /// Prints a warning message to the console.
 ///
 /// This function can be overridden in tests. This could be useful, for example,
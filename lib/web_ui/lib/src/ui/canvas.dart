@@ -122,6 +122,8 @@ abstract class Canvas {
   void drawParagraph(Paragraph paragraph, Offset offset);
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint);
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint);
+  void drawRawRects(Float32List rects, Paint paint);
+  void drawRawCircles(Float32List circles, Paint paint);
 
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint);
   void drawAtlas(
@@ -151,6 +153,11 @@ abstract class Canvas {
 }
 
 abstract class Picture {
+  static Future<List<Image>> toImages(List<Picture> pictures, int width, int height) {
+    return Future.wait<Image>(<Future<Image>>[
+      for (final Picture picture in pictures) picture.toImage(width, height),
+    ]);
+  }
   Future<Image> toImage(int width, int height);
   void dispose();
   int get approximateBytesUsed;
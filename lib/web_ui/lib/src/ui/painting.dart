@@ -722,15 +722,25 @@ class ImageShader extends Shader {
 }
 
 class ImmutableBuffer {
-  ImmutableBuffer._(this.length);
+  ImmutableBuffer._(this._length);
   static Future<ImmutableBuffer> fromUint8List(Uint8List list) async {
     final ImmutableBuffer instance = ImmutableBuffer._(list.length);
     instance._list = list;
     return instance;
   }
 
+  static Future<ImmutableBuffer> fromAsset(String assetKey) async {
+    final ByteData data = await webOnlyAssetManager.load(assetKey);
+    return fromUint8List(data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes));
+  }
+
+  static void prefetchAssets(List<String> assetKeys) {
+    // The browser caches the responses of asset requests on its own.
+  }
+
   Uint8List? _list;
-  final int length;
+  int get length => _length;
+  int _length;
 
   bool get debugDisposed {
     late bool disposed;
@@ -801,6 +811,49 @@ class ImageDescriptor {
   }
 }
 
+class IncrementalImageDecoder {
+  IncrementalImageDecoder({
+    int? targetWidth,
+    int? targetHeight,
+    void Function(Image image)? onProgress,
+  })  : _targetWidth = targetWidth,
+        _targetHeight = targetHeight;
+
+  final int? _targetWidth;
+  final int? _targetHeight;
+  final BytesBuilder _bytes = BytesBuilder(copy: true);
+  bool _closed = false;
+
+  void addChunk(Uint8List chunk) {
+    if (_closed) {
+      throw StateError('Cannot add chunks to a closed IncrementalImageDecoder.');
+    }
+    _bytes.add(chunk);
+  }
+
+  // There is no incremental decoding on web, the image is only decoded once
+  // all of its bytes have been added.
+  Future<Image> close() async {
+    if (_closed) {
+      throw StateError('IncrementalImageDecoder.close was already called.');
+    }
+    _closed = true;
+    final Codec codec = await instantiateImageCodec(
+      _bytes.takeBytes(),
+      targetWidth: _targetWidth,
+      targetHeight: _targetHeight,
+    );
+    final FrameInfo frame = await codec.getNextFrame();
+    codec.dispose();
+    return frame.image;
+  }
+
+  void dispose() {
+    _closed = true;
+    _bytes.clear();
+  }
+}
+
 class FragmentProgram {
   static Future<FragmentProgram> compile({
     required ByteBuffer spirv,
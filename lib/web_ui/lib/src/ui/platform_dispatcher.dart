@@ -212,6 +212,9 @@ enum _FrameTimingInfo {
   layerCacheBytes,
   pictureCacheCount,
   pictureCacheBytes,
+  shaderCompileCount,
+  shaderCompileDuration,
+  resourceCachePurgedBytes,
   frameNumber,
 }
 
@@ -227,6 +230,9 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int shaderCompileCount = 0,
+    int shaderCompileDurationMicros = 0,
+    int resourceCachePurgedBytes = 0,
     int frameNumber = 1,
   }) {
     return FrameTiming._(<int>[
@@ -240,6 +246,9 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      shaderCompileCount,
+      shaderCompileDurationMicros,
+      resourceCachePurgedBytes,
       frameNumber,
     ]);
   }
@@ -278,6 +287,13 @@ class FrameTiming {
 
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  int get shaderCompileCount => _rawInfo(_FrameTimingInfo.shaderCompileCount);
+
+  Duration get shaderCompileDuration =>
+      Duration(microseconds: _rawInfo(_FrameTimingInfo.shaderCompileDuration));
+
+  int get resourceCachePurgedBytes => _rawInfo(_FrameTimingInfo.resourceCachePurgedBytes);
+
   int get frameNumber => _data.last;
 
   final List<int> _data;  // some elements in microseconds, some in bytes, some are counts
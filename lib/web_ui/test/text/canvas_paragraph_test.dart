@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:typed_data';
+
 import 'package:test/bootstrap/browser.dart';
 import 'package:test/test.dart';
 import 'package:ui/src/engine.dart';
@@ -780,6 +782,89 @@ Future<void> testMain() async {
     expect(paragraph.width, 30);
     expect(paragraph.height, 10);
   });
+
+  test('$CanvasParagraph.computeGlyphLayout', () {
+    final CanvasParagraph paragraph = plain(ahemStyle, 'Lorem ipsum')
+      ..layout(constrain(60.0));
+
+    final Float64List layout = paragraph.computeGlyphLayout();
+    // 2 lines, 2 runs and 11 glyphs.
+    expect(layout.sublist(0, 3), <double>[2, 2, 11]);
+
+    // The lines "Lorem " and "ipsum".
+    const int lines = 3;
+    expect(layout.sublist(lines, lines + 2), <double>[0, 6]);
+    expect(layout.sublist(lines + 7, lines + 9), <double>[6, 11]);
+
+    // One left-to-right run on each line.
+    const int runs = lines + 2 * 7;
+    expect(layout.sublist(runs, runs + 5), <double>[0, 1, 0, 6, 0]);
+    expect(layout[runs + 6], 60);
+    expect(layout.sublist(runs + 8, runs + 10), <double>[0, 6]);
+    expect(layout.sublist(runs + 10, runs + 15), <double>[1, 1, 6, 11, 0]);
+    expect(layout[runs + 16], 50);
+    expect(layout.sublist(runs + 18, runs + 20), <double>[6, 11]);
+
+    // The glyphs "o" and "i".
+    const int glyphs = runs + 2 * 10;
+    expect(layout.sublist(glyphs + 4, glyphs + 8), <double>[1, 2, 10, 20]);
+    expect(layout.sublist(glyphs + 24, glyphs + 28), <double>[6, 7, 0, 10]);
+  });
+
+  group('$CanvasParagraph.replaceText', () {
+    test('gives new text the style of the text before it', () {
+      final CanvasParagraph paragraph = rich(ahemStyle, (CanvasParagraphBuilder builder) {
+        builder.pushStyle(EngineTextStyle.only(color: blue));
+        builder.addText('Lorem ');
+        builder.pushStyle(EngineTextStyle.only(color: green));
+        builder.addText('ipsum');
+      })
+        ..layout(constrain(double.infinity));
+
+      expect(paragraph.replaceText(6, 6, 'dolor '), isTrue);
+      expect(paragraph.toPlainText(), 'Lorem dolor ipsum');
+      expect(paragraph.spans, hasLength(2));
+      expect(paragraph.spans[0].start, 0);
+      expect(paragraph.spans[0].end, 12);
+      expect(paragraph.spans[1].start, 12);
+      expect(paragraph.spans[1].end, 17);
+
+      // The paragraph is laid out again with the last constraints.
+      expect(paragraph.isLaidOut, isTrue);
+      expect(paragraph.maxIntrinsicWidth, 170);
+    });
+
+    test('replaces text across spans', () {
+      final CanvasParagraph paragraph = rich(ahemStyle, (CanvasParagraphBuilder builder) {
+        builder.pushStyle(EngineTextStyle.only(color: blue));
+        builder.addText('Lorem ');
+        builder.pushStyle(EngineTextStyle.only(color: green));
+        builder.addText('ipsum');
+      })
+        ..layout(constrain(double.infinity));
+
+      expect(paragraph.replaceText(0, 8, 'x'), isTrue);
+      expect(paragraph.toPlainText(), 'xsum');
+      expect(paragraph.spans[0].start, 0);
+      expect(paragraph.spans[0].end, 1);
+      expect(paragraph.spans[1].start, 1);
+      expect(paragraph.spans[1].end, 4);
+      expect(paragraph.maxIntrinsicWidth, 40);
+    });
+
+    test('rejects invalid ranges and placeholders', () {
+      final CanvasParagraph paragraph = plain(ahemStyle, 'abc');
+      expect(paragraph.replaceText(2, 1, 'x'), isFalse);
+      expect(paragraph.replaceText(0, 4, 'x'), isFalse);
+      expect(paragraph.toPlainText(), 'abc');
+
+      final CanvasParagraph withPlaceholder = rich(ahemStyle, (CanvasParagraphBuilder builder) {
+        builder.addText('abc');
+        builder.addPlaceholder(10, 10, ui.PlaceholderAlignment.bottom);
+      });
+      expect(withPlaceholder.replaceText(0, 1, 'x'), isFalse);
+    });
+  });
 }
 
 /// Shortcut to create a [ui.TextBox] with an optional [ui.TextDirection].
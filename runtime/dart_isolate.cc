@@ -18,6 +18,7 @@
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/runtime/isolate_configuration.h"
+#include "flutter/runtime/startup_timings.h"
 #include "fml/message_loop_task_queues.h"
 #include "fml/task_source.h"
 #include "fml/time/time_point.h"
@@ -131,6 +132,8 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     std::unique_ptr<IsolateConfiguration> isolate_configuration,
     const UIDartState::Context& context,
     const DartIsolate* spawning_isolate) {
+  StartupTimings::ScopedPhase phase(
+      StartupTimings::Phase::kRootIsolateCreation);
   if (!isolate_snapshot) {
     FML_LOG(ERROR) << "Invalid isolate snapshot.";
     return {};
@@ -243,6 +246,8 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRootIsolate(
               isolate_create_callback,             // isolate create callback
               isolate_shutdown_callback            // isolate shutdown callback
               )));
+  (*isolate_group_data)
+      ->SetPlatformMessageSender(context.platform_message_sender);
 
   auto isolate_data = std::make_unique<std::shared_ptr<DartIsolate>>(
       std::shared_ptr<DartIsolate>(new DartIsolate(
@@ -323,6 +328,7 @@ DartIsolate::DartIsolate(const Settings& settings,
                   is_root_isolate,
                   settings.enable_skparagraph,
                   settings.enable_display_list,
+                  settings.defer_layer_tree_construction,
                   std::move(context)),
       may_insecurely_connect_to_all_domains_(
           settings.may_insecurely_connect_to_all_domains),
@@ -837,6 +843,11 @@ Dart_Isolate DartIsolate::DartCreateAndStartServiceIsolate(
     return nullptr;
   }
 
+  {
+    TRACE_EVENT0("flutter", "DartServiceIsolate::WaitUntilStartupAllowed");
+    DartServiceIsolate::WaitUntilStartupAllowed();
+  }
+
   flags->load_vmservice_library = true;
 
 #if (FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_DEBUG)
@@ -958,6 +969,8 @@ Dart_Isolate DartIsolate::DartIsolateGroupCreateCallback(
               parent_group_data.GetChildIsolatePreparer(),
               parent_group_data.GetIsolateCreateCallback(),
               parent_group_data.GetIsolateShutdownCallback())));
+  (*isolate_group_data)
+      ->SetPlatformMessageSender(parent_group_data.GetPlatformMessageSender());
 
   TaskRunners null_task_runners(advisory_script_uri,
                                 /* platform= */ nullptr,
@@ -968,6 +981,8 @@ Dart_Isolate DartIsolate::DartIsolateGroupCreateCallback(
   UIDartState::Context context(null_task_runners);
   context.advisory_script_uri = advisory_script_uri;
   context.advisory_script_entrypoint = advisory_script_entrypoint;
+  context.platform_message_sender =
+      parent_group_data.GetPlatformMessageSender();
   auto isolate_data = std::make_unique<std::shared_ptr<DartIsolate>>(
       std::shared_ptr<DartIsolate>(
           new DartIsolate((*isolate_group_data)->GetSettings(),  // settings
@@ -1021,6 +1036,8 @@ bool DartIsolate::DartIsolateInitializeCallback(void** child_callback_data,
   context.advisory_script_uri = (*isolate_group_data)->GetAdvisoryScriptURI();
   context.advisory_script_entrypoint =
       (*isolate_group_data)->GetAdvisoryScriptEntrypoint();
+  context.platform_message_sender =
+      (*isolate_group_data)->GetPlatformMessageSender();
   auto embedder_isolate = std::make_unique<std::shared_ptr<DartIsolate>>(
       std::shared_ptr<DartIsolate>(
           new DartIsolate((*isolate_group_data)->GetSettings(),  // settings
@@ -64,4 +64,16 @@ void DartIsolateGroupData::SetChildIsolatePreparer(
   child_isolate_preparer_ = value;
 }
 
+UIDartState::PlatformMessageSender
+DartIsolateGroupData::GetPlatformMessageSender() const {
+  std::scoped_lock lock(platform_message_sender_mutex_);
+  return platform_message_sender_;
+}
+
+void DartIsolateGroupData::SetPlatformMessageSender(
+    const UIDartState::PlatformMessageSender& value) {
+  std::scoped_lock lock(platform_message_sender_mutex_);
+  platform_message_sender_ = value;
+}
+
 }  // namespace flutter
@@ -11,6 +11,7 @@
 #include "flutter/common/settings.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 
 namespace flutter {
 
@@ -53,6 +54,14 @@ class DartIsolateGroupData {
 
   void SetChildIsolatePreparer(const ChildIsolatePreparer& value);
 
+  // The sender of the platform messages of the isolates of the group that
+  // don't have a platform configuration. It is the one of the root isolate
+  // that created the group.
+  UIDartState::PlatformMessageSender GetPlatformMessageSender() const;
+
+  void SetPlatformMessageSender(
+      const UIDartState::PlatformMessageSender& value);
+
  private:
   const Settings settings_;
   const fml::RefPtr<const DartSnapshot> isolate_snapshot_;
@@ -60,6 +69,8 @@ class DartIsolateGroupData {
   const std::string advisory_script_entrypoint_;
   mutable std::mutex child_isolate_preparer_mutex_;
   ChildIsolatePreparer child_isolate_preparer_;
+  mutable std::mutex platform_message_sender_mutex_;
+  UIDartState::PlatformMessageSender platform_message_sender_;
   const fml::closure isolate_create_callback_;
   const fml::closure isolate_shutdown_callback_;
 
@@ -332,6 +332,64 @@ TEST_F(DartSecondaryIsolateTest, CanLaunchSecondaryIsolates) {
   // root isolate will be auto-shutdown
 }
 
+TEST_F(DartIsolateTest, BackgroundIsolateCanSendPlatformMessages) {
+  AddNativeCallback("NotifyNative",
+                    CREATE_NATIVE_ENTRY(([this](Dart_NativeArguments args) {
+                      ASSERT_TRUE(tonic::DartConverter<bool>::FromDart(
+                          Dart_GetNativeArgument(args, 0)));
+                      Signal();
+                    })));
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  ASSERT_TRUE(vm_ref);
+  auto vm_data = vm_ref.GetVMData();
+  ASSERT_TRUE(vm_data);
+  TaskRunners task_runners(GetCurrentTestName(),    //
+                           GetCurrentTaskRunner(),  //
+                           GetCurrentTaskRunner(),  //
+                           GetCurrentTaskRunner(),  //
+                           GetCurrentTaskRunner()   //
+  );
+
+  auto isolate_configuration =
+      IsolateConfiguration::InferFromSettings(settings);
+
+  const std::string entrypoint = "testBackgroundIsolateCanSendPlatformMessages";
+  UIDartState::Context context(std::move(task_runners));
+  context.advisory_script_uri = "main.dart";
+  context.advisory_script_entrypoint = entrypoint;
+  // Replies with the sum of the bytes of the message.
+  context.platform_message_sender =
+      [](std::unique_ptr<PlatformMessage> message) {
+        ASSERT_EQ(message->channel(), "flutter/test");
+        uint8_t sum = 0;
+        for (size_t i = 0; i < message->data().GetSize(); i++) {
+          sum += message->data().GetMapping()[i];
+        }
+        ASSERT_TRUE(message->response());
+        message->response()->Complete(
+            std::make_unique<fml::DataMapping>(std::vector<uint8_t>{sum}));
+      };
+  auto weak_isolate = DartIsolate::CreateRunningRootIsolate(
+      vm_data->GetSettings(),              // settings
+      vm_data->GetIsolateSnapshot(),       // isolate snapshot
+      nullptr,                             // platform configuration
+      DartIsolate::Flags{},                // flags
+      nullptr,                             // root_isolate_create_callback
+      settings.isolate_create_callback,    // isolate create callback
+      settings.isolate_shutdown_callback,  // isolate shutdown callback
+      entrypoint,                          // dart entrypoint
+      std::nullopt,                        // dart entrypoint library
+      std::move(isolate_configuration),    // isolate configuration
+      std::move(context)                   // engine context
+  );
+  auto root_isolate = weak_isolate.lock();
+  ASSERT_TRUE(root_isolate);
+  ASSERT_EQ(root_isolate->GetPhase(), DartIsolate::Phase::Running);
+  Wait();
+  ASSERT_TRUE(root_isolate->Shutdown());
+}
+
 TEST_F(DartIsolateTest, CanRecieveArguments) {
   AddNativeCallback("NotifyNative",
                     CREATE_NATIVE_ENTRY(([this](Dart_NativeArguments args) {
@@ -5,6 +5,7 @@
 #include "flutter/runtime/dart_service_isolate.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstring>
 
 #include "flutter/fml/logging.h"
@@ -34,6 +35,9 @@ namespace {
 static Dart_LibraryTagHandler g_embedder_tag_handler;
 static tonic::DartLibraryNatives* g_natives;
 static std::string g_observatory_uri;
+static std::mutex g_startup_mutex;
+static std::condition_variable g_startup_allowed;
+static bool g_startup_deferred = false;
 
 Dart_NativeFunction GetNativeFunction(Dart_Handle name,
                                       int argument_count,
@@ -122,6 +126,27 @@ bool DartServiceIsolate::RemoveServerStatusCallback(
   return true;
 }
 
+void DartServiceIsolate::DeferStartup() {
+  std::scoped_lock lock(g_startup_mutex);
+  g_startup_deferred = true;
+}
+
+void DartServiceIsolate::AllowStartup() {
+  {
+    std::scoped_lock lock(g_startup_mutex);
+    if (!g_startup_deferred) {
+      return;
+    }
+    g_startup_deferred = false;
+  }
+  g_startup_allowed.notify_all();
+}
+
+void DartServiceIsolate::WaitUntilStartupAllowed() {
+  std::unique_lock lock(g_startup_mutex);
+  g_startup_allowed.wait(lock, [] { return !g_startup_deferred; });
+}
+
 void DartServiceIsolate::Shutdown(Dart_NativeArguments args) {
   // NO-OP.
 }
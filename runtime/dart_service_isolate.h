@@ -95,6 +95,31 @@ class DartServiceIsolate {
   ///
   static bool RemoveServerStatusCallback(CallbackHandle handle);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the next calls to `WaitUntilStartupAllowed` block until
+  ///             `AllowStartup` is called, so that the service isolate and its
+  ///             HTTP server do not compete with the launch of the app.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void DeferStartup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unblocks the current and the next calls to
+  ///             `WaitUntilStartupAllowed`. Calls after the first one have no
+  ///             effect until the startup is deferred again.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void AllowStartup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks the calling thread while the startup of the service
+  ///             isolate is deferred. Must only be called on the thread the VM
+  ///             creates the service isolate on.
+  ///
+  static void WaitUntilStartupAllowed();
+
  private:
   // Native entries.
   static void NotifyServerState(Dart_NativeArguments args);
@@ -4,6 +4,10 @@
 
 #include "flutter/runtime/dart_service_isolate.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "flutter/testing/testing.h"
 
 namespace flutter {
@@ -15,4 +19,24 @@ TEST(DartServiceIsolateTest, CanAddAndRemoveHandles) {
   ASSERT_TRUE(DartServiceIsolate::RemoveServerStatusCallback(handle));
 }
 
+TEST(DartServiceIsolateTest, DeferredStartupWaitsUntilAllowed) {
+  DartServiceIsolate::DeferStartup();
+  std::atomic<bool> started = false;
+  std::thread thread([&started]() {
+    DartServiceIsolate::WaitUntilStartupAllowed();
+    started = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(started);
+
+  DartServiceIsolate::AllowStartup();
+  thread.join();
+  EXPECT_TRUE(started);
+
+  // The startup stays allowed until it is deferred again.
+  DartServiceIsolate::AllowStartup();
+  DartServiceIsolate::WaitUntilStartupAllowed();
+}
+
 }  // namespace flutter
@@ -11,6 +11,7 @@
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/snapshot/snapshot.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/startup_timings.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 
 namespace flutter {
@@ -174,6 +175,7 @@ static std::shared_ptr<const fml::Mapping> ResolveIsolateInstructions(
 fml::RefPtr<const DartSnapshot> DartSnapshot::VMSnapshotFromSettings(
     const Settings& settings) {
   TRACE_EVENT0("flutter", "DartSnapshot::VMSnapshotFromSettings");
+  StartupTimings::ScopedPhase phase(StartupTimings::Phase::kVMSnapshotMapping);
   auto snapshot =
       fml::MakeRefCounted<DartSnapshot>(ResolveVMData(settings),         //
                                         ResolveVMInstructions(settings)  //
@@ -187,6 +189,8 @@ fml::RefPtr<const DartSnapshot> DartSnapshot::VMSnapshotFromSettings(
 fml::RefPtr<const DartSnapshot> DartSnapshot::IsolateSnapshotFromSettings(
     const Settings& settings) {
   TRACE_EVENT0("flutter", "DartSnapshot::IsolateSnapshotFromSettings");
+  StartupTimings::ScopedPhase phase(
+      StartupTimings::Phase::kIsolateSnapshotMapping);
   auto snapshot =
       fml::MakeRefCounted<DartSnapshot>(ResolveIsolateData(settings),         //
                                         ResolveIsolateInstructions(settings)  //
@@ -249,6 +253,14 @@ const uint8_t* DartSnapshot::GetInstructionsMapping() const {
   return instructions_ ? instructions_->GetMapping() : nullptr;
 }
 
+size_t DartSnapshot::GetDataSize() const {
+  return data_ ? data_->GetSize() : 0;
+}
+
+size_t DartSnapshot::GetInstructionsSize() const {
+  return instructions_ ? instructions_->GetSize() : 0;
+}
+
 bool DartSnapshot::IsDontNeedSafe() const {
   if (data_ && !data_->IsDontNeedSafe())
     return false;
@@ -160,6 +160,23 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///
   const uint8_t* GetInstructionsMapping() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the size of the heap snapshot, which is zero if it isn't
+  ///             known, such as for the snapshots found through symbols.
+  ///
+  /// @return     The size of the data mapping.
+  ///
+  size_t GetDataSize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the size of the instructions snapshot, which is zero if
+  ///             it isn't known, such as for the snapshots found through
+  ///             symbols.
+  ///
+  /// @return     The size of the instructions mapping.
+  ///
+  size_t GetInstructionsSize() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Returns whether both the data and instructions mappings are
   ///             safe to use with madvise(DONTNEED).
@@ -26,6 +26,8 @@
 #include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm_initializer.h"
 #include "flutter/runtime/ptrace_check.h"
+#include "flutter/runtime/snapshot_prefetch_profile.h"
+#include "flutter/runtime/startup_timings.h"
 #include "third_party/dart/runtime/include/bin/dart_io_api.h"
 #include "third_party/skia/include/core/SkExecutor.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -258,6 +260,7 @@ std::shared_ptr<DartVM> DartVM::Create(
     fml::RefPtr<const DartSnapshot> vm_snapshot,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
     std::shared_ptr<IsolateNameServer> isolate_name_server) {
+  StartupTimings::ScopedPhase phase(StartupTimings::Phase::kVMInitialization);
   auto vm_data = DartVMData::Create(settings,                    //
                                     std::move(vm_snapshot),      //
                                     std::move(isolate_snapshot)  //
@@ -284,7 +287,8 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
     : settings_(vm_data->GetSettings()),
       concurrent_message_loop_(fml::ConcurrentMessageLoop::Create()),
       skia_concurrent_executor_(
-          [runner = concurrent_message_loop_->GetTaskRunner()](
+          [runner = concurrent_message_loop_->GetTaskRunner(
+               fml::ConcurrentTaskPriority::kUserBlocking)](
               fml::closure work) { runner->PostTask(work); }),
       vm_data_(vm_data),
       isolate_name_server_(std::move(isolate_name_server)),
@@ -301,6 +305,24 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
 
+  // The snapshot pages accessed during startup are read ahead while the VM and
+  // the root isolate are being initialized.
+  if (!settings_.snapshot_prefetch_profile_path.empty() &&
+      !settings_.record_snapshot_prefetch_profile) {
+    GetConcurrentWorkerTaskRunner(fml::ConcurrentTaskPriority::kUserBlocking)
+        ->PostTask([vm_data = vm_data_,
+                    path = settings_.snapshot_prefetch_profile_path]() {
+          auto profile = SnapshotPrefetchProfile::ReadFromFile(path);
+          auto isolate_snapshot = vm_data->GetIsolateSnapshot();
+          if (!profile || !isolate_snapshot) {
+            FML_LOG(WARNING) << "Could not read the snapshot prefetch profile "
+                             << path;
+            return;
+          }
+          profile->Prefetch(vm_data->GetVMSnapshot(), *isolate_snapshot);
+        });
+  }
+
   {
     TRACE_EVENT0("flutter", "dart::bin::BootstrapDartIo");
     dart::bin::BootstrapDartIo();
@@ -427,6 +449,13 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
 
   DartUI::InitForGlobal();
 
+  if (settings_.enable_observatory && settings_.lazy_service_isolate_startup &&
+      !settings_.start_paused) {
+    // The VM creates the service isolate on a thread of its own, which waits
+    // for the first frame of any shell or the shutdown of the VM.
+    DartServiceIsolate::DeferStartup();
+  }
+
   {
     TRACE_EVENT0("flutter", "Dart_Initialize");
     Dart_InitializeParams params = {};
@@ -494,6 +523,9 @@ DartVM::~DartVM() {
     Dart_ExitIsolate();
   }
 
+  // The VM waits for a service isolate that is starting before shutting down.
+  DartServiceIsolate::AllowStartup();
+
   DartVMInitializer::Cleanup();
 
   dart::bin::CleanupDartIo();
@@ -516,8 +548,9 @@ std::shared_ptr<IsolateNameServer> DartVM::GetIsolateNameServer() const {
 }
 
 std::shared_ptr<fml::ConcurrentTaskRunner>
-DartVM::GetConcurrentWorkerTaskRunner() const {
-  return concurrent_message_loop_->GetTaskRunner();
+DartVM::GetConcurrentWorkerTaskRunner(
+    fml::ConcurrentTaskPriority priority) const {
+  return concurrent_message_loop_->GetTaskRunner(priority);
 }
 
 std::shared_ptr<fml::ConcurrentMessageLoop> DartVM::GetConcurrentMessageLoop() {
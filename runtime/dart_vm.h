@@ -142,10 +142,14 @@ class DartVM {
   ///             Dart VM lifecycle for the lifecycle of the concurrent worker
   ///             pool as well.
   ///
+  /// @param[in]  priority  The lane of the worker pool the tasks posted to the
+  ///                       task runner are queued on.
+  ///
   /// @return     The task runner for the concurrent worker thread pool.
   ///
-  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
-      const;
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner(
+      fml::ConcurrentTaskPriority priority =
+          fml::ConcurrentTaskPriority::kUserVisible) const;
 
   //----------------------------------------------------------------------------
   /// @brief      The concurrent message loop hosts threads that are used by the
@@ -4,6 +4,7 @@
 
 #include "flutter/runtime/dart_vm.h"
 
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/testing/fixture_test.h"
 #include "gtest/gtest.h"
@@ -43,5 +44,22 @@ TEST_F(DartVMTest, OldGenHeapSize) {
   ASSERT_TRUE(vm);
 }
 
+TEST_F(DartVMTest, ShutdownAllowsDeferredServiceIsolateStartup) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  auto settings = CreateSettingsForFixture();
+  settings.enable_observatory = true;
+  settings.lazy_service_isolate_startup = true;
+  settings.start_paused = false;
+  {
+    // No frame is drawn, so the service isolate waits for the shutdown of the
+    // VM, which waits for it in turn.
+    auto vm = DartVMRef::Create(settings);
+    ASSERT_TRUE(vm);
+  }
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  // Returns right away as the shutdown allowed the startup.
+  DartServiceIsolate::WaitUntilStartupAllowed();
+}
+
 }  // namespace testing
 }  // namespace flutter
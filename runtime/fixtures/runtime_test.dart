@@ -4,6 +4,7 @@
 
 import 'dart:async';
 import 'dart:isolate';
+import 'dart:typed_data';
 import 'dart:ui';
 
 import 'split_lib_test.dart' deferred as splitlib;
@@ -64,6 +65,21 @@ void testCanLaunchSecondaryIsolate() {
   Isolate.spawn(secondaryIsolateMain, 'Hello from root isolate.', onExit: onExit.sendPort);
 }
 
+void backgroundIsolateMain(Object? message) {
+  PlatformDispatcher.instance.sendPlatformMessage(
+    'flutter/test',
+    ByteData.sublistView(Uint8List.fromList(<int>[1, 2, 3])),
+    (ByteData? reply) {
+      notifyResult(reply != null && reply.lengthInBytes == 1 && reply.getUint8(0) == 6);
+    },
+  );
+}
+
+@pragma('vm:entry-point')
+void testBackgroundIsolateCanSendPlatformMessages() {
+  Isolate.spawn(backgroundIsolateMain, null);
+}
+
 @pragma('vm:entry-point')
 void testCanRecieveArguments(List<String> args) {
   notifyResult(args.length == 1 && args[0] == 'arg1');
@@ -37,6 +37,22 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view ServiceProtocol::kGetRasterCacheEntriesExtensionName =
+    "_flutter.getRasterCacheEntries";
+const std::string_view ServiceProtocol::kGetLockContentionExtensionName =
+    "_flutter.getLockContention";
+const std::string_view
+    ServiceProtocol::kGetPlatformChannelStatisticsExtensionName =
+        "_flutter.getPlatformChannelStatistics";
+const std::string_view ServiceProtocol::kGetLayerProfileExtensionName =
+    "_flutter.getLayerProfile";
+const std::string_view
+    ServiceProtocol::kGetFrameTimingStatisticsExtensionName =
+        "_flutter.getFrameTimingStatistics";
+const std::string_view ServiceProtocol::kGetEngineMemoryUsageExtensionName =
+    "_flutter.getEngineMemoryUsage";
+const std::string_view ServiceProtocol::kGetFlightRecordExtensionName =
+    "_flutter.getFlightRecord";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -56,8 +72,15 @@ ServiceProtocol::ServiceProtocol()
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetRasterCacheEntriesExtensionName,
+          kGetLockContentionExtensionName,
+          kGetPlatformChannelStatisticsExtensionName,
+          kGetLayerProfileExtensionName,
+          kGetFrameTimingStatisticsExtensionName,
+          kGetEngineMemoryUsageExtensionName,
+          kGetFlightRecordExtensionName,
       }),
-      handlers_mutex_(fml::SharedMutex::Create()) {}
+      handlers_mutex_(fml::SharedMutex::Create("ServiceProtocol")) {}
 
 ServiceProtocol::~ServiceProtocol() {
   ToggleHooks(false);
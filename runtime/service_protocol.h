@@ -29,6 +29,13 @@ class ServiceProtocol {
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetRasterCacheEntriesExtensionName;
+  static const std::string_view kGetLockContentionExtensionName;
+  static const std::string_view kGetPlatformChannelStatisticsExtensionName;
+  static const std::string_view kGetLayerProfileExtensionName;
+  static const std::string_view kGetFrameTimingStatisticsExtensionName;
+  static const std::string_view kGetEngineMemoryUsageExtensionName;
+  static const std::string_view kGetFlightRecordExtensionName;
 
   class Handler {
    public:
@@ -0,0 +1,235 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_prefetch_profile.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/size.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr char kProfileHeader[] = "flutter-snapshot-prefetch-profile 1";
+
+// The size of the snapshots found through symbols isn't known, so their
+// residency is looked up in chunks until the end of the mapped memory.
+constexpr size_t kUnknownSizeChunk = 1 << 20;
+constexpr size_t kUnknownSizeLimit = 512 << 20;
+
+constexpr const char* kBufferNames[] = {
+    "vm_data",
+    "vm_instructions",
+    "isolate_data",
+    "isolate_instructions",
+};
+
+struct BufferLocation {
+  const uint8_t* address;
+  // Zero if the size isn't known.
+  size_t size;
+};
+
+BufferLocation GetBufferLocation(SnapshotPrefetchProfile::Buffer buffer,
+                                 const DartSnapshot& vm_snapshot,
+                                 const DartSnapshot& isolate_snapshot) {
+  switch (buffer) {
+    case SnapshotPrefetchProfile::Buffer::kVMData:
+      return {vm_snapshot.GetDataMapping(), vm_snapshot.GetDataSize()};
+    case SnapshotPrefetchProfile::Buffer::kVMInstructions:
+      return {vm_snapshot.GetInstructionsMapping(),
+              vm_snapshot.GetInstructionsSize()};
+    case SnapshotPrefetchProfile::Buffer::kIsolateData:
+      return {isolate_snapshot.GetDataMapping(),
+              isolate_snapshot.GetDataSize()};
+    case SnapshotPrefetchProfile::Buffer::kIsolateInstructions:
+      return {isolate_snapshot.GetInstructionsMapping(),
+              isolate_snapshot.GetInstructionsSize()};
+  }
+  return {nullptr, 0};
+}
+
+// Returns the residency of the pages of the buffer, from its first page.
+std::vector<bool> GetResidentPages(const BufferLocation& location) {
+  std::vector<bool> resident;
+  if (location.size > 0) {
+    fml::GetResidentMappingPages(location.address, location.size, &resident);
+    return resident;
+  }
+
+  const size_t page_size = fml::GetMappingPageSize();
+  const uintptr_t page_start =
+      reinterpret_cast<uintptr_t>(location.address) & ~(page_size - 1);
+  const uint8_t* chunk = reinterpret_cast<const uint8_t*>(page_start);
+  std::vector<bool> chunk_resident;
+  while (resident.size() * page_size < kUnknownSizeLimit) {
+    if (fml::GetResidentMappingPages(chunk, kUnknownSizeChunk,
+                                     &chunk_resident)) {
+      resident.insert(resident.end(), chunk_resident.begin(),
+                      chunk_resident.end());
+      chunk += kUnknownSizeChunk;
+      continue;
+    }
+    // The mapped memory ends within the chunk.
+    while (fml::GetResidentMappingPages(chunk, page_size, &chunk_resident)) {
+      resident.push_back(chunk_resident[0]);
+      chunk += page_size;
+    }
+    break;
+  }
+  return resident;
+}
+
+}  // namespace
+
+SnapshotPrefetchProfile::SnapshotPrefetchProfile() = default;
+
+SnapshotPrefetchProfile::SnapshotPrefetchProfile(std::vector<Range> ranges)
+    : ranges_(std::move(ranges)) {}
+
+SnapshotPrefetchProfile::~SnapshotPrefetchProfile() = default;
+
+std::optional<SnapshotPrefetchProfile> SnapshotPrefetchProfile::Parse(
+    const fml::Mapping& mapping) {
+  if (mapping.GetMapping() == nullptr) {
+    return std::nullopt;
+  }
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                  mapping.GetSize()));
+  std::string line;
+  if (!std::getline(stream, line) || line != kProfileHeader) {
+    return std::nullopt;
+  }
+
+  std::vector<Range> ranges;
+  while (std::getline(stream, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream line_stream(line);
+    std::string name;
+    size_t offset = 0;
+    size_t size = 0;
+    if (!(line_stream >> name >> offset >> size)) {
+      return std::nullopt;
+    }
+    auto it = std::find(std::begin(kBufferNames), std::end(kBufferNames), name);
+    if (it == std::end(kBufferNames)) {
+      return std::nullopt;
+    }
+    ranges.push_back(
+        {static_cast<Buffer>(it - std::begin(kBufferNames)), offset, size});
+  }
+  return SnapshotPrefetchProfile(std::move(ranges));
+}
+
+std::optional<SnapshotPrefetchProfile> SnapshotPrefetchProfile::ReadFromFile(
+    const std::string& path) {
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping) {
+    return std::nullopt;
+  }
+  return Parse(*mapping);
+}
+
+SnapshotPrefetchProfile SnapshotPrefetchProfile::Record(
+    const DartSnapshot& vm_snapshot,
+    const DartSnapshot& isolate_snapshot) {
+  TRACE_EVENT0("flutter", "SnapshotPrefetchProfile::Record");
+  const size_t page_size = fml::GetMappingPageSize();
+  std::vector<Range> ranges;
+  for (size_t i = 0; i < fml::size(kBufferNames); i++) {
+    const auto buffer = static_cast<Buffer>(i);
+    const BufferLocation location =
+        GetBufferLocation(buffer, vm_snapshot, isolate_snapshot);
+    if (location.address == nullptr) {
+      continue;
+    }
+    // The first page may start before the buffer.
+    const size_t first_page_offset =
+        reinterpret_cast<uintptr_t>(location.address) & (page_size - 1);
+    const std::vector<bool> resident = GetResidentPages(location);
+    size_t page = 0;
+    while (page < resident.size()) {
+      if (!resident[page]) {
+        page++;
+        continue;
+      }
+      const size_t start = page;
+      while (page < resident.size() && resident[page]) {
+        page++;
+      }
+      const size_t begin =
+          start == 0 ? 0 : start * page_size - first_page_offset;
+      size_t end = page * page_size - first_page_offset;
+      if (location.size > 0) {
+        end = std::min(end, location.size);
+      }
+      ranges.push_back({buffer, begin, end - begin});
+    }
+  }
+  return SnapshotPrefetchProfile(std::move(ranges));
+}
+
+std::string SnapshotPrefetchProfile::Serialize() const {
+  std::ostringstream stream;
+  stream << kProfileHeader << "\n";
+  for (const Range& range : ranges_) {
+    stream << kBufferNames[static_cast<size_t>(range.buffer)] << " "
+           << range.offset << " " << range.size << "\n";
+  }
+  return stream.str();
+}
+
+bool SnapshotPrefetchProfile::WriteToFile(const std::string& path) const {
+  const std::string directory_path = fml::paths::GetDirectoryName(path);
+  const std::string file_name = directory_path.empty()
+                                    ? path
+                                    : path.substr(directory_path.size() + 1);
+  fml::UniqueFD directory =
+      fml::OpenDirectory(directory_path.empty() ? "." : directory_path.c_str(),
+                         false, fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    return false;
+  }
+  std::string serialized = Serialize();
+  return fml::WriteAtomically(
+      directory, file_name.c_str(),
+      fml::DataMapping(std::vector<uint8_t>(serialized.begin(),
+                                            serialized.end())));
+}
+
+size_t SnapshotPrefetchProfile::Prefetch(
+    const DartSnapshot& vm_snapshot,
+    const DartSnapshot& isolate_snapshot) const {
+  TRACE_EVENT0("flutter", "SnapshotPrefetchProfile::Prefetch");
+  size_t prefetched_bytes = 0;
+  for (const Range& range : ranges_) {
+    const BufferLocation location =
+        GetBufferLocation(range.buffer, vm_snapshot, isolate_snapshot);
+    if (location.address == nullptr) {
+      continue;
+    }
+    size_t size = range.size;
+    // A profile recorded for other snapshots can't point outside of these.
+    if (location.size > 0) {
+      if (range.offset >= location.size) {
+        continue;
+      }
+      size = std::min(size, location.size - range.offset);
+    }
+    if (fml::PrefetchMappingPages(location.address + range.offset, size)) {
+      prefetched_bytes += size;
+    }
+  }
+  return prefetched_bytes;
+}
+
+}  // namespace flutter
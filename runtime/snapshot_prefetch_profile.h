@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_PREFETCH_PROFILE_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_PREFETCH_PROFILE_H_
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/runtime/dart_snapshot.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The ranges of the snapshot buffers that were accessed during a
+///             launch of the application.
+///
+///             A profile is recorded once the first frame of a test run has
+///             been rasterized, from the pages of the snapshots that are
+///             resident in the process at that point. At the next launches,
+///             those ranges are prefetched from a background thread so that
+///             the VM and the root isolate don't fault them in one page at a
+///             time.
+///
+///             The ranges are relative to the start of each buffer, so that
+///             the profile stays valid wherever the snapshots are mapped, as
+///             long as the snapshots don't change.
+///
+class SnapshotPrefetchProfile {
+ public:
+  enum class Buffer {
+    kVMData,
+    kVMInstructions,
+    kIsolateData,
+    kIsolateInstructions,
+  };
+
+  struct Range {
+    Buffer buffer;
+    size_t offset;
+    size_t size;
+  };
+
+  SnapshotPrefetchProfile();
+
+  explicit SnapshotPrefetchProfile(std::vector<Range> ranges);
+
+  ~SnapshotPrefetchProfile();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parses a profile written by `Serialize`, or returns
+  ///             `std::nullopt` if the data isn't a valid profile.
+  ///
+  static std::optional<SnapshotPrefetchProfile> Parse(
+      const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads and parses the profile at the path, or returns
+  ///             `std::nullopt` if there is no valid profile there.
+  ///
+  static std::optional<SnapshotPrefetchProfile> ReadFromFile(
+      const std::string& path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the ranges of the snapshots whose pages are resident
+  ///             in the process.
+  ///
+  static SnapshotPrefetchProfile Record(const DartSnapshot& vm_snapshot,
+                                        const DartSnapshot& isolate_snapshot);
+
+  std::string Serialize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the serialized profile to the path, replacing any
+  ///             previous profile.
+  ///
+  bool WriteToFile(const std::string& path) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Advises the system to read the ranges of the snapshots ahead
+  ///             of their first access.
+  ///
+  /// @return     The number of bytes that were prefetched.
+  ///
+  size_t Prefetch(const DartSnapshot& vm_snapshot,
+                  const DartSnapshot& isolate_snapshot) const;
+
+  const std::vector<Range>& GetRanges() const { return ranges_; }
+
+ private:
+  std::vector<Range> ranges_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_PREFETCH_PROFILE_H_
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_prefetch_profile.h"
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(SnapshotPrefetchProfileTest, CanSerializeAndParse) {
+  SnapshotPrefetchProfile profile({
+      {SnapshotPrefetchProfile::Buffer::kVMData, 0, 4096},
+      {SnapshotPrefetchProfile::Buffer::kIsolateInstructions, 8192, 12288},
+  });
+  std::string serialized = profile.Serialize();
+  fml::NonOwnedMapping mapping(
+      reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size());
+
+  auto parsed = SnapshotPrefetchProfile::Parse(mapping);
+  ASSERT_TRUE(parsed);
+  ASSERT_EQ(parsed->GetRanges().size(), 2u);
+  EXPECT_EQ(parsed->GetRanges()[1].buffer,
+            SnapshotPrefetchProfile::Buffer::kIsolateInstructions);
+  EXPECT_EQ(parsed->GetRanges()[1].offset, 8192u);
+  EXPECT_EQ(parsed->GetRanges()[1].size, 12288u);
+}
+
+TEST(SnapshotPrefetchProfileTest, RejectsInvalidProfiles) {
+  for (std::string data : {
+           "",
+           "vm_data 0 4096\n",
+           "flutter-snapshot-prefetch-profile 1\nkernel 0 4096\n",
+           "flutter-snapshot-prefetch-profile 1\nvm_data zero\n",
+       }) {
+    fml::NonOwnedMapping mapping(reinterpret_cast<const uint8_t*>(data.data()),
+                                 data.size());
+    EXPECT_FALSE(SnapshotPrefetchProfile::Parse(mapping)) << data;
+  }
+}
+
+TEST(SnapshotPrefetchProfileTest, RecordsTheResidentPagesOfTheSnapshots) {
+  auto data = std::make_shared<fml::DataMapping>(
+      std::vector<uint8_t>(16 * fml::GetMappingPageSize(), 1));
+  auto snapshot = DartSnapshot::IsolateSnapshotFromMappings(data, nullptr);
+  ASSERT_TRUE(snapshot);
+
+  auto profile = SnapshotPrefetchProfile::Record(*snapshot, *snapshot);
+  size_t recorded_size = 0;
+  for (const auto& range : profile.GetRanges()) {
+    EXPECT_TRUE(range.buffer == SnapshotPrefetchProfile::Buffer::kVMData ||
+                range.buffer == SnapshotPrefetchProfile::Buffer::kIsolateData);
+    EXPECT_LE(range.offset + range.size, data->GetSize());
+    recorded_size += range.size;
+  }
+  // The data was written, so all of its pages are resident.
+  EXPECT_EQ(recorded_size, 2 * data->GetSize());
+  EXPECT_EQ(profile.Prefetch(*snapshot, *snapshot), recorded_size);
+}
+
+TEST(SnapshotPrefetchProfileTest, CanWriteAndReadFiles) {
+  fml::ScopedTemporaryDirectory directory;
+  const std::string path =
+      fml::paths::JoinPaths({directory.path(), "snapshot_profile"});
+  EXPECT_FALSE(SnapshotPrefetchProfile::ReadFromFile(path));
+
+  SnapshotPrefetchProfile profile(
+      {{SnapshotPrefetchProfile::Buffer::kVMInstructions, 4096, 4096}});
+  ASSERT_TRUE(profile.WriteToFile(path));
+  auto read = SnapshotPrefetchProfile::ReadFromFile(path);
+  ASSERT_TRUE(read);
+  ASSERT_EQ(read->GetRanges().size(), 1u);
+  EXPECT_EQ(read->GetRanges()[0].buffer,
+            SnapshotPrefetchProfile::Buffer::kVMInstructions);
+}
+
+}  // namespace testing
+}  // namespace flutter
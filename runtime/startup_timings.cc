@@ -0,0 +1,171 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/startup_timings.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+namespace flutter {
+
+namespace {
+
+std::mutex gStartupTimingsMutex;
+StartupTimings::Timings gStartupTimings;
+
+// Whether the phase at |outer| contains the one at |inner|. Of two phases with
+// the same interval, the one that comes first contains the other.
+bool Contains(const StartupTimings::Timings& timings,
+              size_t outer,
+              size_t inner) {
+  const StartupTimings::Interval& outer_interval = *timings[outer];
+  const StartupTimings::Interval& inner_interval = *timings[inner];
+  if (outer == inner || inner_interval.start < outer_interval.start ||
+      inner_interval.end > outer_interval.end) {
+    return false;
+  }
+  if (inner_interval.start == outer_interval.start &&
+      inner_interval.end == outer_interval.end) {
+    return outer < inner;
+  }
+  return true;
+}
+
+// Adds the critical path among |phases|, which are nested in a phase of the
+// path that started at |start| if there is one.
+void AddCriticalPath(const StartupTimings::Timings& timings,
+                     const std::vector<size_t>& phases,
+                     size_t depth,
+                     std::optional<fml::TimePoint> start,
+                     std::vector<StartupTimings::CriticalPathStep>& path) {
+  // The nested phases are only walked with the phase that contains them.
+  std::vector<size_t> outermost;
+  for (size_t phase : phases) {
+    if (std::none_of(phases.begin(), phases.end(), [&](size_t other) {
+          return Contains(timings, other, phase);
+        })) {
+      outermost.push_back(phase);
+    }
+  }
+
+  // Walks back from the phase that ended last.
+  std::vector<size_t> chain;
+  while (true) {
+    std::optional<size_t> gate;
+    for (size_t phase : outermost) {
+      const StartupTimings::Interval& interval = *timings[phase];
+      if (!chain.empty() &&
+          (interval.end > timings[chain.back()]->start ||
+           std::find(chain.begin(), chain.end(), phase) != chain.end())) {
+        continue;
+      }
+      if (!gate || interval.end > timings[*gate]->end) {
+        gate = phase;
+      }
+    }
+    if (!gate) {
+      break;
+    }
+    chain.push_back(*gate);
+  }
+  std::reverse(chain.begin(), chain.end());
+
+  for (size_t i = 0; i < chain.size(); i++) {
+    const StartupTimings::Interval& interval = *timings[chain[i]];
+    StartupTimings::CriticalPathStep step;
+    step.phase = static_cast<StartupTimings::Phase>(chain[i]);
+    step.interval = interval;
+    step.depth = depth;
+    if (i > 0) {
+      step.wait = interval.start - timings[chain[i - 1]]->end;
+    } else if (start) {
+      step.wait = interval.start - *start;
+    }
+    path.push_back(step);
+
+    std::vector<size_t> nested;
+    for (size_t phase : phases) {
+      if (Contains(timings, chain[i], phase)) {
+        nested.push_back(phase);
+      }
+    }
+    AddCriticalPath(timings, nested, depth + 1, interval.start, path);
+  }
+}
+
+}  // namespace
+
+void StartupTimings::Record(Phase phase,
+                            fml::TimePoint start,
+                            fml::TimePoint end) {
+  std::scoped_lock lock(gStartupTimingsMutex);
+  auto& interval = gStartupTimings[static_cast<size_t>(phase)];
+  if (!interval) {
+    interval = Interval{start, end};
+  }
+}
+
+std::optional<StartupTimings::Interval> StartupTimings::Get(Phase phase) {
+  std::scoped_lock lock(gStartupTimingsMutex);
+  return gStartupTimings[static_cast<size_t>(phase)];
+}
+
+StartupTimings::Timings StartupTimings::GetAll() {
+  std::scoped_lock lock(gStartupTimingsMutex);
+  return gStartupTimings;
+}
+
+const char* StartupTimings::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kVMSnapshotMapping:
+      return "vm_snapshot_mapping";
+    case Phase::kIsolateSnapshotMapping:
+      return "isolate_snapshot_mapping";
+    case Phase::kVMInitialization:
+      return "vm_initialization";
+    case Phase::kRootIsolateCreation:
+      return "root_isolate_creation";
+    case Phase::kFirstFrame:
+      return "first_frame";
+    case Phase::kShellCreation:
+      return "shell_creation";
+    case Phase::kFirstLayerTree:
+      return "first_layer_tree";
+    case Phase::kFirstRaster:
+      return "first_raster";
+    case Phase::kFirstPresent:
+      return "first_present";
+    case Phase::kCount:
+      break;
+  }
+  return "unknown";
+}
+
+std::vector<StartupTimings::CriticalPathStep>
+StartupTimings::ComputeCriticalPath(const Timings& timings) {
+  std::vector<size_t> phases;
+  for (size_t phase = 0; phase < timings.size(); phase++) {
+    if (timings[phase]) {
+      phases.push_back(phase);
+    }
+  }
+  std::vector<CriticalPathStep> path;
+  AddCriticalPath(timings, phases, 0, std::nullopt, path);
+  return path;
+}
+
+void StartupTimings::ResetForTesting() {
+  std::scoped_lock lock(gStartupTimingsMutex);
+  gStartupTimings.fill(std::nullopt);
+}
+
+StartupTimings::ScopedPhase::ScopedPhase(Phase phase)
+    : phase_(phase), start_(fml::TimePoint::Now()) {}
+
+StartupTimings::ScopedPhase::~ScopedPhase() {
+  Record(phase_, start_, fml::TimePoint::Now());
+}
+
+}  // namespace flutter
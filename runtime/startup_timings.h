@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_STARTUP_TIMINGS_H_
+#define FLUTTER_RUNTIME_STARTUP_TIMINGS_H_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Records when the phases of the engine startup began and ended
+///             in the process, so that embedders can report them without a
+///             tracing session.
+///
+///             The VM and its snapshots are shared by all the engines of the
+///             process, so each phase is only recorded the first time it
+///             runs. The timings are thread-safe.
+///
+class StartupTimings {
+ public:
+  enum class Phase {
+    // Mapping the VM snapshot, in `DartSnapshot::VMSnapshotFromSettings`.
+    kVMSnapshotMapping,
+    // Mapping the isolate snapshot, in
+    // `DartSnapshot::IsolateSnapshotFromSettings`.
+    kIsolateSnapshotMapping,
+    // Initializing the VM, in `DartVM::Create`.
+    kVMInitialization,
+    // Creating and running the root isolate, in
+    // `DartIsolate::CreateRunningRootIsolate`.
+    kRootIsolateCreation,
+    // Building and rasterizing the first frame, from the start of its build
+    // to the end of its rasterization.
+    kFirstFrame,
+    // Creating the shell, in `Shell::Create`.
+    kShellCreation,
+    // Building the layer tree of the first frame on the UI thread.
+    kFirstLayerTree,
+    // Rasterizing the first frame on the raster thread.
+    kFirstRaster,
+    // Submitting the first frame to the surface.
+    kFirstPresent,
+    kCount,
+  };
+
+  struct Interval {
+    fml::TimePoint start;
+    fml::TimePoint end;
+  };
+
+  using Timings =
+      std::array<std::optional<Interval>, static_cast<size_t>(Phase::kCount)>;
+
+  /// A phase on the critical path of the startup.
+  struct CriticalPathStep {
+    Phase phase;
+    Interval interval;
+    /// The number of the phases of the path that contain this one.
+    size_t depth = 0;
+    /// The time from the end of the phase that gated this one, or from the
+    /// start of the phase that contains it, to its start. It is spent outside
+    /// of the phases, e.g. in task queues or in the Dart code of the app.
+    fml::TimeDelta wait;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the interval of the phase, unless one was already
+  ///             recorded for it.
+  ///
+  static void Record(Phase phase, fml::TimePoint start, fml::TimePoint end);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the interval recorded for the phase, if it has run.
+  ///
+  static std::optional<Interval> Get(Phase phase);
+
+  static Timings GetAll();
+
+  /// The name of the phase in the reports, e.g. "vm_initialization".
+  static const char* GetPhaseName(Phase phase);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the chain of phases that gated the end of the
+  ///             startup, which is the end of the phase that ended last.
+  ///
+  ///             A phase is gated by the phase that ended last before it
+  ///             started. The phases that ran concurrently with the path,
+  ///             e.g. on other threads, are left out. The phases that are
+  ///             nested in a phase of the path have their own path within it,
+  ///             which follows it in the returned steps, so that the steps
+  ///             are in the order in which the phases started.
+  ///
+  static std::vector<CriticalPathStep> ComputeCriticalPath(
+      const Timings& timings);
+
+  static void ResetForTesting();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a phase from its construction to its destruction.
+  ///
+  class ScopedPhase {
+   public:
+    explicit ScopedPhase(Phase phase);
+
+    ~ScopedPhase();
+
+   private:
+    const Phase phase_;
+    const fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedPhase);
+  };
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(StartupTimings);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_STARTUP_TIMINGS_H_
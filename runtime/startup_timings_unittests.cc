@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/startup_timings.h"
+
+#include "flutter/runtime/dart_vm_lifecycle.h"
+#include "flutter/testing/fixture_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+using StartupTimingsTest = FixtureTest;
+
+namespace {
+StartupTimings::Interval Millis(int64_t start, int64_t end) {
+  return {
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMilliseconds(start)),
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMilliseconds(end)),
+  };
+}
+}  // namespace
+
+TEST_F(StartupTimingsTest, OnlyTheFirstIntervalOfAPhaseIsRecorded) {
+  StartupTimings::ResetForTesting();
+  ASSERT_FALSE(StartupTimings::Get(StartupTimings::Phase::kFirstFrame));
+
+  const auto start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1));
+  const auto end = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(2));
+  StartupTimings::Record(StartupTimings::Phase::kFirstFrame, start, end);
+  StartupTimings::Record(StartupTimings::Phase::kFirstFrame, end, end);
+
+  auto interval = StartupTimings::Get(StartupTimings::Phase::kFirstFrame);
+  ASSERT_TRUE(interval);
+  EXPECT_EQ(interval->start, start);
+  EXPECT_EQ(interval->end, end);
+  StartupTimings::ResetForTesting();
+}
+
+TEST_F(StartupTimingsTest, VMCreationRecordsItsPhases) {
+  StartupTimings::ResetForTesting();
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  {
+    auto vm = DartVMRef::Create(CreateSettingsForFixture());
+    ASSERT_TRUE(vm);
+  }
+
+  for (auto phase : {StartupTimings::Phase::kVMSnapshotMapping,
+                     StartupTimings::Phase::kIsolateSnapshotMapping,
+                     StartupTimings::Phase::kVMInitialization}) {
+    auto interval = StartupTimings::Get(phase);
+    ASSERT_TRUE(interval);
+    EXPECT_LE(interval->start, interval->end);
+  }
+  EXPECT_FALSE(
+      StartupTimings::Get(StartupTimings::Phase::kRootIsolateCreation));
+  StartupTimings::ResetForTesting();
+}
+
+TEST_F(StartupTimingsTest, ComputesTheCriticalPathOfNestedPhases) {
+  using Phase = StartupTimings::Phase;
+  StartupTimings::Timings timings;
+  timings[static_cast<size_t>(Phase::kShellCreation)] = Millis(0, 50);
+  timings[static_cast<size_t>(Phase::kVMSnapshotMapping)] = Millis(1, 5);
+  timings[static_cast<size_t>(Phase::kIsolateSnapshotMapping)] = Millis(5, 9);
+  timings[static_cast<size_t>(Phase::kVMInitialization)] = Millis(10, 40);
+  timings[static_cast<size_t>(Phase::kRootIsolateCreation)] = Millis(55, 80);
+  timings[static_cast<size_t>(Phase::kFirstFrame)] = Millis(100, 130);
+  timings[static_cast<size_t>(Phase::kFirstLayerTree)] = Millis(100, 110);
+  timings[static_cast<size_t>(Phase::kFirstRaster)] = Millis(112, 130);
+  timings[static_cast<size_t>(Phase::kFirstPresent)] = Millis(125, 129);
+
+  const auto path = StartupTimings::ComputeCriticalPath(timings);
+  struct ExpectedStep {
+    Phase phase;
+    size_t depth;
+    int64_t wait_millis;
+  };
+  const std::vector<ExpectedStep> expected = {
+      {Phase::kShellCreation, 0, 0},
+      {Phase::kVMSnapshotMapping, 1, 1},
+      {Phase::kIsolateSnapshotMapping, 1, 0},
+      {Phase::kVMInitialization, 1, 1},
+      {Phase::kRootIsolateCreation, 0, 5},
+      {Phase::kFirstFrame, 0, 20},
+      {Phase::kFirstLayerTree, 1, 0},
+      {Phase::kFirstRaster, 1, 2},
+      {Phase::kFirstPresent, 2, 13},
+  };
+  ASSERT_EQ(path.size(), expected.size());
+  for (size_t i = 0; i < path.size(); i++) {
+    EXPECT_EQ(path[i].phase, expected[i].phase) << i;
+    EXPECT_EQ(path[i].depth, expected[i].depth) << i;
+    EXPECT_EQ(path[i].wait.ToMilliseconds(), expected[i].wait_millis) << i;
+  }
+}
+
+TEST_F(StartupTimingsTest, CriticalPathLeavesOutTheConcurrentPhases) {
+  using Phase = StartupTimings::Phase;
+  StartupTimings::Timings timings;
+  timings[static_cast<size_t>(Phase::kShellCreation)] = Millis(0, 50);
+  timings[static_cast<size_t>(Phase::kVMInitialization)] = Millis(10, 40);
+  // Overlaps the shell creation without being nested in it.
+  timings[static_cast<size_t>(Phase::kRootIsolateCreation)] = Millis(20, 60);
+  timings[static_cast<size_t>(Phase::kFirstFrame)] = Millis(70, 100);
+
+  const auto path = StartupTimings::ComputeCriticalPath(timings);
+  ASSERT_EQ(path.size(), 2u);
+  EXPECT_EQ(path[0].phase, Phase::kRootIsolateCreation);
+  EXPECT_EQ(path[1].phase, Phase::kFirstFrame);
+  EXPECT_EQ(path[1].wait.ToMilliseconds(), 10);
+  EXPECT_TRUE(StartupTimings::ComputeCriticalPath({}).empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,8 +5,10 @@
 #include "flutter/shell/common/animator.h"
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_flight_recorder.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 namespace flutter {
@@ -19,6 +21,16 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// The number of frames that keep the pipeline one frame deep after pointer
+// events, so that the frames that follow a gesture are not delayed behind
+// frames queued for the raster thread.
+constexpr int kLatencySensitiveFrameCount = 10;
+
+// How long after a pointer event frames are not limited by the idle frame
+// rate limit.
+constexpr fml::TimeDelta kIdleFrameRateLimitInputTimeout =
+    fml::TimeDelta::FromSeconds(1);
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
@@ -39,7 +51,7 @@ Animator::Animator(Delegate& delegate,
               ? 1
               : 2)),
 #endif  // SHELL_ENABLE_METAL
-      pending_frame_semaphore_(1),
+      pending_frame_semaphore_(1, "Animator::pending_frame"),
       weak_factory_(this) {
 }
 
@@ -64,6 +76,85 @@ void Animator::SetDimensionChangePending() {
   dimension_change_pending_ = true;
 }
 
+void Animator::EnableAdaptivePipelineDepth() {
+  // Platforms on which the raster and platform task runners are the same
+  // can't overlap frames.
+  if (task_runners_.GetPlatformTaskRunner() ==
+      task_runners_.GetRasterTaskRunner()) {
+    return;
+  }
+  FML_DCHECK(!producer_continuation_);
+  adaptive_pipeline_depth_ = true;
+  layer_tree_pipeline_ =
+      std::make_shared<LayerTreePipeline>(kMaxAdaptivePipelineDepth);
+  layer_tree_pipeline_->SetActiveDepth(1);
+}
+
+void Animator::SetFramePacingPolicy(FramePacingPolicy policy) {
+  frame_scheduler_.SetPolicy(policy);
+}
+
+void Animator::OnFrameRasterized(const FrameTiming& timing) {
+  frame_scheduler_.RecordFrame(timing);
+}
+
+void Animator::OnDisplayRefreshRateChanged(double refresh_rate) {
+  waiter_->OnDisplayRefreshRateChanged(refresh_rate);
+}
+
+void Animator::SetIdleFrameRateLimit(double frames_per_second) {
+  min_idle_frame_interval_ =
+      frames_per_second > 0
+          ? fml::TimeDelta::FromSecondsF(1 / frames_per_second)
+          : fml::TimeDelta::Zero();
+}
+
+fml::TimePoint Animator::GetEarliestIdleFrameTime() const {
+  if (min_idle_frame_interval_ <= fml::TimeDelta::Zero() ||
+      dimension_change_pending_ || !has_rendered_) {
+    return fml::TimePoint();
+  }
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (now - last_pointer_event_time_ < kIdleFrameRateLimitInputTimeout) {
+    return fml::TimePoint();
+  }
+  return last_frame_begin_time_ + min_idle_frame_interval_;
+}
+
+void Animator::UpdatePipelineDepth() {
+  // A pointer event since the last frame means the user is interacting with
+  // the app, which is when a deeper pipeline adds the most noticeable
+  // latency.
+  if (!trace_flow_ids_.empty()) {
+    latency_sensitive_frames_ = kLatencySensitiveFrameCount;
+  }
+
+  uint32_t depth = 1;
+  if (latency_sensitive_frames_ > 0) {
+    latency_sensitive_frames_--;
+  } else if (frame_scheduler_.HasSamples()) {
+    const fml::TimeDelta build = frame_scheduler_.GetAverageBuildDuration();
+    const fml::TimeDelta raster = frame_scheduler_.GetAverageRasterDuration();
+    const fml::TimeDelta budget =
+        frame_timings_recorder_->GetVsyncTargetTime() -
+        frame_timings_recorder_->GetVsyncStartTime();
+    if (raster > budget) {
+      // The raster thread is the bottleneck. Let the UI thread build ahead
+      // so that it can absorb the frames that are slow to build.
+      depth = kMaxAdaptivePipelineDepth;
+    } else if (build + raster > budget) {
+      // Each stage fits in a frame but not both of them, overlap them.
+      depth = 2;
+    }
+  }
+
+  if (depth != layer_tree_pipeline_->GetActiveDepth()) {
+    layer_tree_pipeline_->SetActiveDepth(depth);
+    FML_TRACE_COUNTER("flutter", "Adaptive Pipeline Depth",
+                      reinterpret_cast<int64_t>(this), "depth", depth);
+  }
+}
+
 void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
@@ -73,6 +164,13 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
         }
         self->trace_flow_ids_.push_back(trace_flow_id);
         self->ScheduleMaybeClearTraceFlowIds();
+        self->last_pointer_event_time_ = fml::TimePoint::Now();
+        if (self->frame_request_delayed_) {
+          // The user started interacting, stop holding back the frame.
+          self->frame_request_delayed_ = false;
+          self->delayed_frame_request_id_++;
+          self->AwaitVSync();
+        }
       });
 }
 
@@ -100,9 +198,14 @@ void Animator::BeginFrame(
 
   frame_timings_recorder_ = std::move(frame_timings_recorder);
   frame_timings_recorder_->RecordBuildStart(fml::TimePoint::Now());
+  fml::tracing::FlightRecord(fml::tracing::FlightRecorderEventType::kBuildStart,
+                             frame_timings_recorder_->GetFrameNumber());
 
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder_, "flutter",
                                 "Animator::BeginFrame");
+  if (adaptive_pipeline_depth_) {
+    UpdatePipelineDepth();
+  }
   while (!trace_flow_ids_.empty()) {
     uint64_t trace_flow_id = trace_flow_ids_.front();
     TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_id);
@@ -110,6 +213,7 @@ void Animator::BeginFrame(
   }
 
   frame_scheduled_ = false;
+  last_frame_begin_time_ = fml::TimePoint::Now();
   notify_idle_task_id_++;
   regenerate_layer_tree_ = false;
   pending_frame_semaphore_.Signal();
@@ -139,6 +243,9 @@ void Animator::BeginFrame(
       frame_timings_recorder_->GetBuildStartTime());
   const fml::TimePoint frame_target_time =
       frame_timings_recorder_->GetVsyncTargetTime();
+  last_vsync_target_time_ = frame_target_time;
+  last_frame_budget_ =
+      frame_target_time - frame_timings_recorder_->GetVsyncStartTime();
   dart_frame_deadline_ = FxlToDartOrEarlier(frame_target_time);
   {
     TRACE_EVENT2("flutter", "Framework Workload", "mode", "basic", "frame",
@@ -194,6 +301,8 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder_, "flutter",
                                 "Animator::Render");
+  fml::tracing::FlightRecord(fml::tracing::FlightRecorderEventType::kBuildEnd,
+                             frame_timings_recorder_->GetFrameNumber());
   frame_timings_recorder_->RecordBuildEnd(fml::TimePoint::Now());
 
   // Commit the pending continuation.
@@ -213,6 +322,7 @@ bool Animator::CanReuseLastLayerTree() {
 void Animator::DrawLastLayerTree(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
   pending_frame_semaphore_.Signal();
+  last_frame_begin_time_ = fml::TimePoint::Now();
   // In this case BeginFrame doesn't get called, we need to
   // adjust frame timings to update build start and end times,
   // given that the frame doesn't get built in this case, we
@@ -252,21 +362,43 @@ void Animator::RequestFrame(bool regenerate_layer_tree) {
         }
         TRACE_EVENT_ASYNC_BEGIN0("flutter", "Frame Request Pending",
                                  frame_request_number);
+        const fml::TimePoint earliest_frame_time =
+            self->GetEarliestIdleFrameTime();
+        if (earliest_frame_time > fml::TimePoint::Now()) {
+          // Coalesce the requests made until the idle frame rate limit lets
+          // the next frame begin.
+          TRACE_EVENT0("flutter", "IdleFrameRateLimit");
+          self->frame_request_delayed_ = true;
+          self->task_runners_.GetUITaskRunner()->PostTaskForTime(
+              [self, request_id = self->delayed_frame_request_id_]() {
+                if (!self || !self->frame_request_delayed_ ||
+                    request_id != self->delayed_frame_request_id_) {
+                  return;
+                }
+                self->frame_request_delayed_ = false;
+                self->AwaitVSync();
+              },
+              earliest_frame_time);
+          return;
+        }
         self->AwaitVSync();
       });
   frame_scheduled_ = true;
 }
 
 void Animator::AwaitVSync() {
+  if (!CanReuseLastLayerTree() &&
+      frame_scheduler_.ShouldBeginFrameEarly(fml::TimePoint::Now(),
+                                             last_vsync_target_time_,
+                                             last_frame_budget_)) {
+    BeginFrameEarly();
+    return;
+  }
   waiter_->AsyncWaitForVsync(
       [self = weak_factory_.GetWeakPtr()](
           std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
         if (self) {
-          if (self->CanReuseLastLayerTree()) {
-            self->DrawLastLayerTree(std::move(frame_timings_recorder));
-          } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
-          }
+          self->OnVsync(std::move(frame_timings_recorder));
         }
       });
   if (has_rendered_) {
@@ -275,11 +407,69 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::OnVsync(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (CanReuseLastLayerTree()) {
+    DrawLastLayerTree(std::move(frame_timings_recorder));
+    return;
+  }
+
+  if (frame_timings_recorder->GetVsyncTargetTime() <=
+      early_vsync_target_time_) {
+    // A frame that began early already targets this vsync interval.
+    TRACE_EVENT0("flutter", "FrameAlreadyBegunEarly");
+    AwaitVSync();
+    return;
+  }
+
+  const fml::TimePoint begin_time = frame_scheduler_.GetBeginFrameTime(
+      frame_timings_recorder->GetVsyncStartTime(),
+      frame_timings_recorder->GetVsyncTargetTime());
+  if (begin_time > fml::TimePoint::Now()) {
+    // Wait for the latest input the frame can still include.
+    TRACE_EVENT0("flutter", "DelayBeginFrame");
+    task_runners_.GetUITaskRunner()->PostTaskForTime(
+        fml::MakeCopyable(
+            [self = weak_factory_.GetWeakPtr(),
+             recorder = std::move(frame_timings_recorder)]() mutable {
+              if (self) {
+                self->BeginFrame(std::move(recorder));
+              }
+            }),
+        begin_time);
+    return;
+  }
+
+  BeginFrame(std::move(frame_timings_recorder));
+}
+
+void Animator::BeginFrameEarly() {
+  TRACE_EVENT0("flutter", "BeginFrameEarly");
+  task_runners_.GetUITaskRunner()->PostTask(
+      [self = weak_factory_.GetWeakPtr()]() {
+        if (!self) {
+          return;
+        }
+        // The frame begins now and targets the vsync after the one targeted
+        // by the last frame.
+        self->early_vsync_target_time_ =
+            self->last_vsync_target_time_ + self->last_frame_budget_;
+        auto frame_timings_recorder = std::make_unique<FrameTimingsRecorder>();
+        frame_timings_recorder->RecordVsync(fml::TimePoint::Now(),
+                                            self->early_vsync_target_time_);
+        self->BeginFrame(std::move(frame_timings_recorder));
+      });
+}
+
 void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                               const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(id, callback);
 }
 
+fml::TimePoint Animator::GetLastVsyncTargetTime() const {
+  return waiter_->GetLastFrameTargetTime();
+}
+
 void Animator::ScheduleMaybeClearTraceFlowIds() {
   waiter_->ScheduleSecondaryCallback(
       reinterpret_cast<uintptr_t>(this), [self = weak_factory_.GetWeakPtr()] {
@@ -7,12 +7,14 @@
 
 #include <deque>
 
+#include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_scheduler.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -72,12 +74,41 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  /// @brief    The target time of the frame of the last vsync, including the
+  ///           vsyncs that only fired secondary callbacks.
+  ///
+  /// @see      `PointerDataDispatcher::GetLastVsyncTargetTime`.
+  fml::TimePoint GetLastVsyncTargetTime() const;
+
   void Start();
 
   void Stop();
 
   void SetDimensionChangePending();
 
+  // Lets the depth of the layer tree pipeline vary between one and
+  // |kMaxAdaptivePipelineDepth| with the durations of recent frames, as
+  // reported to |OnFrameRasterized|. Must be called before the first frame.
+  void EnableAdaptivePipelineDepth();
+
+  // Sets when frames begin relative to vsync.
+  void SetFramePacingPolicy(FramePacingPolicy policy);
+
+  // Records the timings of a rasterized frame for the adaptive pipeline
+  // depth and the frame pacing policy.
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  // Forwards a change of the refresh rate of the main display to the vsync
+  // waiter.
+  void OnDisplayRefreshRateChanged(double refresh_rate);
+
+  // Limits the rate at which frames begin to |frames_per_second| while the
+  // user isn't interacting with the app, which is until a second after the
+  // last pointer event. Frame requests made sooner than that after the last
+  // frame are coalesced into a single frame. A limit of zero or less removes
+  // the limit.
+  void SetIdleFrameRateLimit(double frames_per_second);
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // active rendering.
@@ -86,6 +117,8 @@ class Animator final {
  private:
   using LayerTreePipeline = Pipeline<flutter::LayerTree>;
 
+  static constexpr uint32_t kMaxAdaptivePipelineDepth = 3;
+
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
   bool CanReuseLastLayerTree();
@@ -95,8 +128,21 @@ class Animator final {
 
   void AwaitVSync();
 
+  // Returns the earliest time at which the next frame may begin under the
+  // idle frame rate limit, which is in the past when it may begin now.
+  fml::TimePoint GetEarliestIdleFrameTime() const;
+
+  void OnVsync(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
+  // Begins the frame of the vsync interval that follows the one targeted by
+  // the last frame, without waiting for its vsync.
+  void BeginFrameEarly();
+
   const char* FrameParity();
 
+  // Picks the pipeline depth for the frame that is about to begin.
+  void UpdatePipelineDepth();
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
@@ -118,6 +164,24 @@ class Animator final {
   SkISize last_layer_tree_size_ = {0, 0};
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  bool adaptive_pipeline_depth_ = false;
+  FrameScheduler frame_scheduler_;
+  // The vsync interval of the last frame that began.
+  fml::TimePoint last_vsync_target_time_;
+  fml::TimeDelta last_frame_budget_;
+  // The target time of the last frame that began early.
+  fml::TimePoint early_vsync_target_time_;
+  // The number of frames to keep a depth of one for after pointer events.
+  int latency_sensitive_frames_ = 0;
+  // The minimum interval between frames while the user isn't interacting with
+  // the app, or zero when frames aren't limited.
+  fml::TimeDelta min_idle_frame_interval_;
+  fml::TimePoint last_frame_begin_time_;
+  fml::TimePoint last_pointer_event_time_;
+  // Identifies the frame request that is delayed by the idle frame rate
+  // limit, so that it can be superseded when the user starts interacting.
+  uint64_t delayed_frame_request_id_ = 0;
+  bool frame_request_delayed_ = false;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
@@ -32,9 +32,12 @@ class FakeAnimatorDelegate : public Animator::Delegate {
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {}
 
   void OnAnimatorDrawLastLayerTree(
-      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {}
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {
+    draw_last_layer_tree_count_++;
+  }
 
   bool notify_idle_called_ = false;
+  int draw_last_layer_tree_count_ = 0;
 };
 
 TEST_F(ShellTest, VSyncTargetTime) {
@@ -223,5 +226,82 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyIdleBeforeRender) {
   latch.Wait();
 }
 
+TEST_F(ShellTest, AnimatorLimitsIdleFrameRateUntilPointerEvent) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  auto clock = std::make_shared<ShellTestVsyncClock>();
+  fml::AutoResetWaitableEvent latch;
+  std::shared_ptr<Animator> animator;
+
+  auto flush_vsync_task = [&] {
+    fml::AutoResetWaitableEvent ui_latch;
+    task_runners.GetUITaskRunner()->PostTask([&] { ui_latch.Signal(); });
+    do {
+      clock->SimulateVSync();
+    } while (ui_latch.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(1)));
+    latch.Signal();
+  };
+
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<ShellTestVsyncWaiter>(task_runners, clock));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter));
+    animator->Start();
+    animator->Render(std::make_unique<LayerTree>(SkISize::Make(600, 800), 1.0));
+    task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
+  });
+  latch.Wait();
+
+  // Without a limit, the last layer tree is drawn again at the next vsync.
+  int draw_count = 0;
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    draw_count = delegate.draw_last_layer_tree_count_;
+    animator->RequestFrame(false);
+    task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
+  });
+  latch.Wait();
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    EXPECT_EQ(delegate.draw_last_layer_tree_count_, draw_count + 1);
+    draw_count = delegate.draw_last_layer_tree_count_;
+    // One frame every 100 seconds.
+    animator->SetIdleFrameRateLimit(0.01);
+    animator->RequestFrame(false);
+    animator->RequestFrame(false);
+    task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
+  });
+  latch.Wait();
+
+  // The requests are held back until the user interacts.
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    EXPECT_EQ(delegate.draw_last_layer_tree_count_, draw_count);
+    animator->EnqueueTraceFlowId(1);
+    task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
+  });
+  latch.Wait();
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    EXPECT_EQ(delegate.draw_last_layer_tree_count_, draw_count + 1);
+    latch.Signal();
+  });
+  latch.Wait();
+
+  animator->Stop();
+  task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
+  latch.Wait();
+
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    animator.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 }  // namespace testing
 }  // namespace flutter
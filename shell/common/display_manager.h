@@ -20,7 +20,10 @@ enum class DisplayUpdateType {
   ///    1. The frame buffer hardware is connected.
   ///    2. The display is drawable, e.g. it isn't being mirrored from another
   ///       connected display or sleeping.
-  kStartup
+  kStartup,
+  /// The configuration of the active `flutter::Display`s changed after
+  /// start-up, e.g. the refresh rate of a variable refresh rate display.
+  kConfigurationChanged
 };
 
 /// Manages lifecycle of the connected displays. This class is thread-safe.
@@ -10,12 +10,15 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/settings.h"
+#include "flutter/flow/glyph_usage.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_flight_recorder.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/lib/snapshot/snapshot.h"
 #include "flutter/lib/ui/text/font_collection.h"
@@ -35,6 +38,10 @@ static constexpr char kNavigationChannel[] = "flutter/navigation";
 static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
+// The key of the index of the fallback fonts in the persistent cache.
+static constexpr char kFallbackFontIndexKey[] = "flutter.fallback_font_index";
+// The key of the glyphs of the first frames in the persistent cache.
+static constexpr char kGlyphUsageKey[] = "flutter.glyph_usage";
 
 namespace {
 fml::MallocMapping MakeMapping(const std::string& str) {
@@ -63,6 +70,8 @@ Engine::Engine(
       task_runners_(std::move(task_runners)),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  image_decoder_.SetCompactOpaqueImages(settings_.enable_compact_opaque_images);
+  image_decoder_.SetDeferImageUploads(settings_.defer_image_uploads);
 }
 
 Engine::Engine(Delegate& delegate,
@@ -86,6 +95,31 @@ Engine::Engine(Delegate& delegate,
              io_manager,
              std::make_shared<FontCollection>(),
              nullptr) {
+  UIDartState::Context context{
+      task_runners_,                           // task runners
+      std::move(snapshot_delegate),            // snapshot delegate
+      std::move(io_manager),                   // io manager
+      std::move(unref_queue),                  // Skia unref queue
+      image_decoder_.GetWeakPtr(),             // image decoder
+      image_generator_registry_.GetWeakPtr(),  // image generator registry
+      settings_.advisory_script_uri,           // advisory script uri
+      settings_.advisory_script_entrypoint,    // advisory script entrypoint
+      std::move(volatile_path_tracker),        // volatile path tracker
+  };
+  context.concurrent_task_runner = vm.GetConcurrentWorkerTaskRunner();
+  // The background isolates of the root isolate group run on their own
+  // threads, so their messages are handed over to the UI thread as if the
+  // root isolate had sent them.
+  context.platform_message_sender =
+      [ui_task_runner = task_runners_.GetUITaskRunner(),
+       engine = GetWeakPtr()](std::unique_ptr<PlatformMessage> message) {
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [engine, message = std::move(message)]() mutable {
+              if (engine) {
+                engine->HandlePlatformMessage(std::move(message));
+              }
+            }));
+      };
   runtime_controller_ = std::make_unique<RuntimeController>(
       *this,                                 // runtime delegate
       &vm,                                   // VM
@@ -95,17 +129,7 @@ Engine::Engine(Delegate& delegate,
       settings_.isolate_create_callback,     // isolate create callback
       settings_.isolate_shutdown_callback,   // isolate shutdown callback
       settings_.persistent_isolate_data,     // persistent isolate data
-      UIDartState::Context{
-          task_runners_,                           // task runners
-          std::move(snapshot_delegate),            // snapshot delegate
-          std::move(io_manager),                   // io manager
-          std::move(unref_queue),                  // Skia unref queue
-          image_decoder_.GetWeakPtr(),             // image decoder
-          image_generator_registry_.GetWeakPtr(),  // image generator registry
-          settings_.advisory_script_uri,           // advisory script uri
-          settings_.advisory_script_entrypoint,    // advisory script entrypoint
-          std::move(volatile_path_tracker),        // volatile path tracker
-      });
+      context);
 }
 
 std::unique_ptr<Engine> Engine::Spawn(
@@ -135,6 +159,10 @@ std::unique_ptr<Engine> Engine::Spawn(
       settings_.persistent_isolate_data      // persistent isolate data
   );
   result->initial_route_ = initial_route;
+  // The fonts of the assets are already registered with the shared font
+  // collection, so running the spawned engine with the same assets doesn't
+  // register them again.
+  result->asset_manager_ = asset_manager_;
   return result;
 }
 
@@ -147,6 +175,68 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 void Engine::SetupDefaultFontManager() {
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
+  LoadFallbackFontIndex();
+}
+
+void Engine::LoadFallbackFontIndex() {
+  TRACE_EVENT0("flutter", "Engine::LoadFallbackFontIndex");
+  sk_sp<SkData> key = SkData::MakeWithCString(kFallbackFontIndexKey);
+  sk_sp<SkData> index = PersistentCache::GetCacheForProcess()->LoadData(*key);
+  if (!index) {
+    return;
+  }
+  if (!font_collection_->GetFontCollection()->LoadFallbackFontIndex(
+          std::string(static_cast<const char*>(index->data()),
+                      index->size()))) {
+    FML_LOG(WARNING) << "Could not load the index of the fallback fonts.";
+  }
+}
+
+void Engine::StoreFallbackFontIndexIfNeeded() {
+  std::shared_ptr<txt::FontCollection> collection =
+      font_collection_->GetFontCollection();
+  if (!collection->HasNewFallbackFonts()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Engine::StoreFallbackFontIndex");
+  const std::string index = collection->SerializeFallbackFontIndex();
+  PersistentCache::GetCacheForProcess()->StoreData(
+      *SkData::MakeWithCString(kFallbackFontIndexKey),
+      *SkData::MakeWithCopy(index.data(), index.size()));
+}
+
+void Engine::WarmUpGlyphCache() {
+  TRACE_EVENT0("flutter", "Engine::WarmUpGlyphCache");
+  sk_sp<SkData> key = SkData::MakeWithCString(kGlyphUsageKey);
+  sk_sp<SkData> data = PersistentCache::GetCacheForProcess()->LoadData(*key);
+  if (!data) {
+    return;
+  }
+  std::vector<GlyphUsage::Strike> strikes = GlyphUsage::Parse(
+      std::string(static_cast<const char*>(data->data()), data->size()));
+  // The typefaces are matched here, since the fonts can only be registered
+  // with the collection on this thread.
+  std::shared_ptr<txt::FontCollection> collection =
+      font_collection_->GetFontCollection();
+  for (GlyphUsage::Strike& strike : strikes) {
+    strike.typeface =
+        collection->MatchTypeface(strike.family_name, strike.style);
+  }
+  runtime_controller_->GetDartVM()->GetConcurrentWorkerTaskRunner()->PostTask(
+      fml::MakeCopyable([strikes = std::move(strikes)]() {
+        GlyphUsage::WarmUp(strikes);
+      }));
+}
+
+void Engine::StoreGlyphUsageIfNeeded() {
+  std::string usage;
+  if (!GlyphUsage::GetInstance().TakeFinishedRecording(&usage)) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Engine::StoreGlyphUsage");
+  PersistentCache::GetCacheForProcess()->StoreData(
+      *SkData::MakeWithCString(kGlyphUsageKey),
+      *SkData::MakeWithCopy(usage.data(), usage.size()));
 }
 
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
@@ -157,6 +247,10 @@ fml::WeakPtr<ImageGeneratorRegistry> Engine::GetImageGeneratorRegistry() {
   return image_generator_registry_.GetWeakPtr();
 }
 
+void Engine::SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache) {
+  image_decoder_.SetDecodedImageCache(std::move(cache));
+}
+
 bool Engine::UpdateAssetManager(
     std::shared_ptr<AssetManager> new_asset_manager) {
   if (asset_manager_ == new_asset_manager) {
@@ -213,6 +307,12 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
     if (settings_.prefetched_default_font_manager) {
       SetupDefaultFontManager();
     }
+    // The glyphs are rasterized on a worker while the root isolate runs its
+    // entrypoint and builds the first frame.
+    if (settings_.warm_up_glyph_cache &&
+        GlyphUsage::GetInstance().StartRecording()) {
+      WarmUpGlyphCache();
+    }
   };
 
   if (!runtime_controller_->LaunchRootIsolate(
@@ -246,11 +346,43 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
 
+void Engine::OnFrameRasterized(const FrameTiming& timing) {
+  animator_->OnFrameRasterized(timing);
+}
+
+void Engine::OnDisplayRefreshRateChanged(double refresh_rate) {
+  animator_->OnDisplayRefreshRateChanged(refresh_rate);
+}
+
+void Engine::SetIdleFrameRateLimit(double frames_per_second) {
+  animator_->SetIdleFrameRateLimit(frames_per_second);
+}
+
 void Engine::NotifyIdle(int64_t deadline) {
   auto trace_event = std::to_string(deadline - Dart_TimelineGetMicros());
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
                trace_event.c_str());
+  fml::tracing::FlightRecord(
+      fml::tracing::FlightRecorderEventType::kIdleNotification,
+      deadline - Dart_TimelineGetMicros());
   runtime_controller_->NotifyIdle(deadline);
+
+  // The fallback fonts that were matched while building the frames are stored
+  // for the next launch, which writes them on a worker.
+  StoreFallbackFontIndexIfNeeded();
+  // So are the glyphs of the first frames, once they have been rasterized.
+  StoreGlyphUsageIfNeeded();
+  // The persistent cache is compacted on a worker once per launch, and the
+  // usage of the shaders is stored for the precompilation of the next launch.
+  PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
+  persistent_cache->CompactIfNeeded();
+  persistent_cache->StoreShaderUsageIfNeeded();
+
+  const int64_t idle_micros = deadline - Dart_TimelineGetMicros();
+  if (idle_micros > 0) {
+    idle_task_queue_->RunUntil(fml::TimePoint::Now() +
+                               fml::TimeDelta::FromMicroseconds(idle_micros));
+  }
 }
 
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -320,6 +452,9 @@ void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
     return;
   }
 
+  fml::tracing::FlightRecord(
+      fml::tracing::FlightRecorderEventType::kPlatformMessage,
+      message->hasData() ? message->data().GetSize() : 0);
   if (runtime_controller_->IsRootIsolateRunning() &&
       runtime_controller_->DispatchPlatformMessage(std::move(message))) {
     return;
@@ -474,6 +609,7 @@ std::string Engine::DefaultRouteName() {
 }
 
 void Engine::ScheduleFrame(bool regenerate_layer_tree) {
+  idle_task_queue_->Interrupt();
   StartAnimatorIfPossible();
   animator_->RequestFrame(regenerate_layer_tree);
 }
@@ -529,6 +665,7 @@ FontCollection& Engine::GetFontCollection() {
 
 void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
   animator_->EnqueueTraceFlowId(trace_flow_id);
   if (runtime_controller_) {
     runtime_controller_->DispatchPointerDataPacket(*packet);
@@ -540,6 +677,10 @@ void Engine::ScheduleSecondaryVsyncCallback(uintptr_t id,
   animator_->ScheduleSecondaryVsyncCallback(id, callback);
 }
 
+fml::TimePoint Engine::GetLastVsyncTargetTime() {
+  return animator_->GetLastVsyncTargetTime();
+}
+
 void Engine::HandleAssetPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   fml::RefPtr<PlatformMessageResponse> response = message->response();
@@ -27,6 +27,7 @@
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
+#include "flutter/shell/common/idle_task_queue.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -544,12 +545,27 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   //  to remember that the unit is microseconds (which is no used anywhere else
   //  in the engine).
   ///
+  ///             The tasks of the idle task queue run after the Dart VM was
+  ///             notified, as long as the deadline allows.
+  ///
   /// @param[in]  deadline  The deadline as a timepoint in microseconds measured
   ///                       against the system monotonic clock. Use
   ///                       `Dart_TimelineGetMicros()`, for consistency.
   ///
   void NotifyIdle(int64_t deadline);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The queue of deferrable native work that runs on the UI task
+  ///             runner while the engine is idle. Tasks may be posted to it
+  ///             from any thread. Requesting a frame ends the current idle
+  ///             period, the remaining tasks run in the next one.
+  ///
+  /// @see        `NotifyIdle`
+  ///
+  const std::shared_ptr<IdleTaskQueue>& GetIdleTaskQueue() const {
+    return idle_task_queue_;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Dart code cannot fully measure the time it takes for a
   ///             specific frame to be rendered. This is because Dart code only
@@ -583,6 +599,39 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the raster thread has finished a
+  ///             frame. The animator uses the timings to adapt the depth of
+  ///             the layer tree pipeline when
+  ///             `Settings::enable_adaptive_pipeline_depth` is set, and to
+  ///             pace frames according to `Settings::frame_pacing_policy`.
+  ///
+  /// @param[in]  timing  The timings of the rasterized frame.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the refresh rate of the main display
+  ///             changed, so that vsync waiters which keep their own clock
+  ///             can follow it.
+  ///
+  /// @param[in]  refresh_rate  The new refresh rate in frames per second.
+  ///
+  void OnDisplayRefreshRateChanged(double refresh_rate);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Limits the rate at which frames begin while the user isn't
+  ///             interacting with the app, so that apps whose screen rarely
+  ///             changes don't render at the refresh rate of the display for
+  ///             small animations.
+  ///
+  /// @see        `Animator::SetIdleFrameRateLimit`
+  ///
+  /// @param[in]  frames_per_second  The maximum frame rate, or zero or less to
+  ///                                remove the limit.
+  ///
+  void SetIdleFrameRateLimit(double frames_per_second);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -803,8 +852,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   // |RuntimeDelegate|
   FontCollection& GetFontCollection() override;
 
-  // Return the asset manager associated with the current engine, or nullptr.
-  std::shared_ptr<AssetManager> GetAssetManager();
+  // |RuntimeDelegate|
+  std::shared_ptr<AssetManager> GetAssetManager() override;
 
   //----------------------------------------------------------------------------
   /// @brief      Get the `ImageGeneratorRegistry` associated with the current
@@ -814,6 +863,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   fml::WeakPtr<ImageGeneratorRegistry> GetImageGeneratorRegistry();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the cache that the image decoder of this engine reuses
+  ///             the decoded images of, or null to decode every image.
+  ///
+  /// @param[in]  cache  The cache, which may be shared with other engines.
+  ///
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
   // |PointerDataDispatcher::Delegate|
   void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                         uint64_t trace_flow_id) override;
@@ -822,6 +879,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback) override;
 
+  // |PointerDataDispatcher::Delegate|
+  fml::TimePoint GetLastVsyncTargetTime() override;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint that was used in the RunConfiguration
   ///             when |Engine::Run| was called.
@@ -954,6 +1014,19 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void HandleAssetPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  // Loads the fallback fonts that were matched in the previous launches from
+  // the persistent cache, which saves the first frames with text in other
+  // scripts or emoji from searching the fonts of the system.
+  void LoadFallbackFontIndex();
+
+  void StoreFallbackFontIndexIfNeeded();
+
+  // Matches the typefaces of the glyphs that the first frames of the previous
+  // launch drew, and rasterizes the glyphs into the glyph cache on a worker.
+  void WarmUpGlyphCache();
+
+  void StoreGlyphUsageIfNeeded();
+
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
   friend class testing::ShellTest;
@@ -962,6 +1035,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   const Settings settings_;
   std::unique_ptr<Animator> animator_;
   std::unique_ptr<RuntimeController> runtime_controller_;
+  std::shared_ptr<IdleTaskQueue> idle_task_queue_ =
+      std::make_shared<IdleTaskQueue>();
 
   // The pointer_data_dispatcher_ depends on animator_ and runtime_controller_.
   // So it should be defined after them to ensure that pointer_data_dispatcher_
@@ -247,3 +247,12 @@ void canAccessResourceFromAssetDir() async {
     },
   );
 }
+
+@pragma('vm:entry-point')
+void notifyPlatformMessages() {
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    notifyMessage(utf8.decode(data!.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes)));
+  };
+  notifyNative();
+}
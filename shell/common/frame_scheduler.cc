@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+FrameScheduler::FrameScheduler() = default;
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::RecordFrame(const FrameTiming& timing) {
+  durations_.emplace_back(timing.Get(FrameTiming::kBuildFinish) -
+                              timing.Get(FrameTiming::kBuildStart),
+                          timing.Get(FrameTiming::kRasterFinish) -
+                              timing.Get(FrameTiming::kRasterStart));
+  if (durations_.size() > kSampleCount) {
+    durations_.pop_front();
+  }
+}
+
+fml::TimeDelta FrameScheduler::GetAverageBuildDuration() const {
+  if (durations_.empty()) {
+    return fml::TimeDelta::Zero();
+  }
+  fml::TimeDelta total;
+  for (const auto& durations : durations_) {
+    total = total + durations.first;
+  }
+  return total / static_cast<int64_t>(durations_.size());
+}
+
+fml::TimeDelta FrameScheduler::GetAverageRasterDuration() const {
+  if (durations_.empty()) {
+    return fml::TimeDelta::Zero();
+  }
+  fml::TimeDelta total;
+  for (const auto& durations : durations_) {
+    total = total + durations.second;
+  }
+  return total / static_cast<int64_t>(durations_.size());
+}
+
+fml::TimeDelta FrameScheduler::GetMaxFrameDuration() const {
+  fml::TimeDelta max;
+  for (const auto& durations : durations_) {
+    max = std::max(max, durations.first + durations.second);
+  }
+  return max;
+}
+
+fml::TimePoint FrameScheduler::GetBeginFrameTime(
+    fml::TimePoint vsync_start,
+    fml::TimePoint vsync_target) const {
+  if (policy_ != FramePacingPolicy::kLowLatency || !HasSamples()) {
+    return vsync_start;
+  }
+  const fml::TimeDelta budget = vsync_target - vsync_start;
+  const fml::TimeDelta slack =
+      budget - GetMaxFrameDuration() - kLowLatencyMargin;
+  // Never give up more than half of the interval, so that a frame that is
+  // slower than the recent ones still has a chance to make it.
+  return vsync_start + std::clamp(slack, fml::TimeDelta::Zero(), budget / 2);
+}
+
+bool FrameScheduler::ShouldBeginFrameEarly(fml::TimePoint now,
+                                           fml::TimePoint last_vsync_target,
+                                           fml::TimeDelta frame_budget) const {
+  if (policy_ != FramePacingPolicy::kSmooth || !HasSamples()) {
+    return false;
+  }
+  // The next vsync has passed, or a frame has already begun early.
+  if (now >= last_vsync_target || now < last_vsync_target - frame_budget) {
+    return false;
+  }
+  return GetAverageBuildDuration() + GetAverageRasterDuration() >
+         frame_budget;
+}
+
+}  // namespace flutter
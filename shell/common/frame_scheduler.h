@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+
+#include <deque>
+#include <utility>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Predicts the durations of the next frame from the build and raster
+/// durations of the last few rasterized frames, and decides when the
+/// |Animator| begins frames according to a |FramePacingPolicy|.
+class FrameScheduler {
+ public:
+  /// The number of recent frames that the predictions are based on.
+  static constexpr size_t kSampleCount = 8;
+
+  /// The time left between the predicted end of a frame and its target time
+  /// under |FramePacingPolicy::kLowLatency|.
+  static constexpr fml::TimeDelta kLowLatencyMargin =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  FrameScheduler();
+
+  ~FrameScheduler();
+
+  void SetPolicy(FramePacingPolicy policy) { policy_ = policy; }
+
+  FramePacingPolicy GetPolicy() const { return policy_; }
+
+  void RecordFrame(const FrameTiming& timing);
+
+  bool HasSamples() const { return !durations_.empty(); }
+
+  fml::TimeDelta GetAverageBuildDuration() const;
+
+  fml::TimeDelta GetAverageRasterDuration() const;
+
+  /// The longest build plus raster duration of the recent frames.
+  fml::TimeDelta GetMaxFrameDuration() const;
+
+  /// Returns the time at which the frame of the vsync interval between
+  /// |vsync_start| and |vsync_target| should begin.
+  ///
+  /// Under |FramePacingPolicy::kLowLatency| the frame begins as late as the
+  /// recent frames allow it to still be rasterized before |vsync_target|, so
+  /// that it reflects the latest input. Otherwise it begins at |vsync_start|.
+  fml::TimePoint GetBeginFrameTime(fml::TimePoint vsync_start,
+                                   fml::TimePoint vsync_target) const;
+
+  /// Whether the next frame should begin right away, rather than at the next
+  /// vsync, when the last frame targets |last_vsync_target| and the frame
+  /// interval is |frame_budget|.
+  ///
+  /// Under |FramePacingPolicy::kSmooth| this is the case while building and
+  /// rasterizing a frame takes longer than a frame interval, so that the
+  /// build of a frame overlaps the raster of the previous one. Frames only
+  /// ever begin one interval ahead.
+  bool ShouldBeginFrameEarly(fml::TimePoint now,
+                             fml::TimePoint last_vsync_target,
+                             fml::TimeDelta frame_budget) const;
+
+ private:
+  FramePacingPolicy policy_ = FramePacingPolicy::kDefault;
+  // The build and raster durations of the recent frames.
+  std::deque<std::pair<fml::TimeDelta, fml::TimeDelta>> durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
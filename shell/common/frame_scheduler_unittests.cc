@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr fml::TimeDelta kBudget = fml::TimeDelta::FromMilliseconds(16);
+
+static FrameTiming MakeTiming(int64_t build_ms, int64_t raster_ms) {
+  const fml::TimePoint start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, start);
+  timing.Set(FrameTiming::kBuildStart, start);
+  timing.Set(FrameTiming::kBuildFinish,
+             start + fml::TimeDelta::FromMilliseconds(build_ms));
+  timing.Set(FrameTiming::kRasterStart,
+             start + fml::TimeDelta::FromMilliseconds(build_ms));
+  timing.Set(FrameTiming::kRasterFinish,
+             start + fml::TimeDelta::FromMilliseconds(build_ms + raster_ms));
+  return timing;
+}
+
+TEST(FrameSchedulerTest, AveragesRecentFrames) {
+  FrameScheduler scheduler;
+  ASSERT_FALSE(scheduler.HasSamples());
+  scheduler.RecordFrame(MakeTiming(2, 4));
+  scheduler.RecordFrame(MakeTiming(4, 8));
+  ASSERT_EQ(scheduler.GetAverageBuildDuration().ToMilliseconds(), 3);
+  ASSERT_EQ(scheduler.GetAverageRasterDuration().ToMilliseconds(), 6);
+  ASSERT_EQ(scheduler.GetMaxFrameDuration().ToMilliseconds(), 12);
+
+  for (size_t i = 0; i < FrameScheduler::kSampleCount; i++) {
+    scheduler.RecordFrame(MakeTiming(1, 1));
+  }
+  ASSERT_EQ(scheduler.GetMaxFrameDuration().ToMilliseconds(), 2);
+}
+
+TEST(FrameSchedulerTest, DefaultPolicyBeginsFramesAtVsync) {
+  FrameScheduler scheduler;
+  scheduler.RecordFrame(MakeTiming(1, 1));
+  const fml::TimePoint vsync_start = fml::TimePoint::Now();
+  ASSERT_EQ(scheduler.GetBeginFrameTime(vsync_start, vsync_start + kBudget),
+            vsync_start);
+  scheduler.RecordFrame(MakeTiming(12, 12));
+  ASSERT_FALSE(scheduler.ShouldBeginFrameEarly(
+      vsync_start, vsync_start + kBudget / 2, kBudget));
+}
+
+TEST(FrameSchedulerTest, LowLatencyDelaysFramesByTheirSlack) {
+  FrameScheduler scheduler;
+  scheduler.SetPolicy(FramePacingPolicy::kLowLatency);
+  const fml::TimePoint vsync_start = fml::TimePoint::Now();
+  const fml::TimePoint vsync_target = vsync_start + kBudget;
+
+  // Nothing is known about the frames yet.
+  ASSERT_EQ(scheduler.GetBeginFrameTime(vsync_start, vsync_target),
+            vsync_start);
+
+  scheduler.RecordFrame(MakeTiming(4, 6));
+  ASSERT_EQ(scheduler.GetBeginFrameTime(vsync_start, vsync_target),
+            vsync_target - fml::TimeDelta::FromMilliseconds(10) -
+                FrameScheduler::kLowLatencyMargin);
+
+  // Frames never give up more than half of the interval.
+  scheduler.RecordFrame(MakeTiming(1, 1));
+  for (size_t i = 0; i < FrameScheduler::kSampleCount; i++) {
+    scheduler.RecordFrame(MakeTiming(1, 1));
+  }
+  ASSERT_EQ(scheduler.GetBeginFrameTime(vsync_start, vsync_target),
+            vsync_start + kBudget / 2);
+
+  // Frames that don't fit begin at vsync.
+  scheduler.RecordFrame(MakeTiming(10, 10));
+  ASSERT_EQ(scheduler.GetBeginFrameTime(vsync_start, vsync_target),
+            vsync_start);
+}
+
+TEST(FrameSchedulerTest, SmoothBeginsSlowFramesOneIntervalEarly) {
+  FrameScheduler scheduler;
+  scheduler.SetPolicy(FramePacingPolicy::kSmooth);
+  const fml::TimePoint now = fml::TimePoint::Now();
+
+  scheduler.RecordFrame(MakeTiming(6, 6));
+  ASSERT_FALSE(scheduler.ShouldBeginFrameEarly(now, now + kBudget / 2,
+                                               kBudget));
+
+  scheduler.RecordFrame(MakeTiming(12, 14));
+  ASSERT_TRUE(scheduler.ShouldBeginFrameEarly(now, now + kBudget / 2,
+                                              kBudget));
+  // The vsync targeted by the last frame has passed.
+  ASSERT_FALSE(scheduler.ShouldBeginFrameEarly(now, now, kBudget));
+  // The last frame already began an interval early.
+  ASSERT_FALSE(scheduler.ShouldBeginFrameEarly(
+      now, now + kBudget + kBudget / 2, kBudget));
+}
+
+}  // namespace testing
+}  // namespace flutter
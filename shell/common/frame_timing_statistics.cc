@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// The nearest-rank percentiles of the durations, which are sorted in place.
+FrameTimingPercentiles GetPercentiles(std::vector<fml::TimeDelta>& durations) {
+  if (durations.empty()) {
+    return {};
+  }
+  std::sort(durations.begin(), durations.end());
+  auto percentile = [&durations](double fraction) {
+    size_t rank = static_cast<size_t>(std::ceil(fraction * durations.size()));
+    return durations[std::clamp<size_t>(rank, 1, durations.size()) - 1];
+  };
+  return {
+      .p50 = percentile(0.5),
+      .p90 = percentile(0.9),
+      .p99 = percentile(0.99),
+      .max = durations.back(),
+  };
+}
+
+}  // namespace
+
+FrameTimingStatistics::FrameTimingStatistics(size_t window_size)
+    : window_size_(window_size) {
+  FML_DCHECK(window_size_ > 0);
+  samples_.reserve(window_size_);
+}
+
+FrameTimingStatistics::~FrameTimingStatistics() = default;
+
+uint64_t FrameTimingStatistics::MissedVsyncs(fml::TimeDelta build,
+                                             fml::TimeDelta raster,
+                                             fml::TimeDelta frame_budget) {
+  if (frame_budget <= fml::TimeDelta::Zero()) {
+    return 0;
+  }
+  const int64_t slowest = std::max(build, raster).ToMicroseconds();
+  const int64_t budget = frame_budget.ToMicroseconds();
+  if (slowest <= budget) {
+    return 0;
+  }
+  // A phase that takes a little over one budget pushes the frame to the next
+  // vsync.
+  return (slowest - 1) / budget;
+}
+
+void FrameTimingStatistics::Record(const FrameTiming& timing,
+                                   fml::TimeDelta frame_budget) {
+  FrameSample sample;
+  sample.build = timing.Get(FrameTiming::kBuildFinish) -
+                 timing.Get(FrameTiming::kBuildStart);
+  sample.raster = timing.Get(FrameTiming::kRasterFinish) -
+                  timing.Get(FrameTiming::kRasterStart);
+  sample.total = timing.Get(FrameTiming::kRasterFinish) -
+                 timing.Get(FrameTiming::kVsyncStart);
+  sample.missed_vsyncs =
+      MissedVsyncs(sample.build, sample.raster, frame_budget);
+
+  std::scoped_lock lock(mutex_);
+  if (samples_.size() < window_size_) {
+    samples_.push_back(sample);
+  } else {
+    samples_[next_sample_] = sample;
+  }
+  next_sample_ = (next_sample_ + 1) % window_size_;
+  frame_budget_ = frame_budget;
+  total_frame_count_++;
+  if (sample.missed_vsyncs > 0) {
+    total_janky_frame_count_++;
+  }
+}
+
+FrameTimingSummary FrameTimingStatistics::GetSummary() const {
+  FrameTimingSummary summary;
+  std::vector<fml::TimeDelta> build;
+  std::vector<fml::TimeDelta> raster;
+  std::vector<fml::TimeDelta> total;
+  {
+    std::scoped_lock lock(mutex_);
+    summary.frame_count = samples_.size();
+    summary.frame_budget = frame_budget_;
+    summary.total_frame_count = total_frame_count_;
+    summary.total_janky_frame_count = total_janky_frame_count_;
+    build.reserve(samples_.size());
+    raster.reserve(samples_.size());
+    total.reserve(samples_.size());
+    for (const auto& sample : samples_) {
+      build.push_back(sample.build);
+      raster.push_back(sample.raster);
+      total.push_back(sample.total);
+      const size_t bucket =
+          std::min<uint64_t>(sample.missed_vsyncs,
+                             summary.missed_vsync_histogram.size() - 1);
+      summary.missed_vsync_histogram[bucket]++;
+      if (sample.missed_vsyncs > 0) {
+        summary.janky_frame_count++;
+        summary.missed_vsync_count += sample.missed_vsyncs;
+      }
+    }
+  }
+  // The percentiles are computed outside of the lock, which the raster thread
+  // takes for every frame.
+  summary.build = GetPercentiles(build);
+  summary.raster = GetPercentiles(raster);
+  summary.total = GetPercentiles(total);
+  return summary;
+}
+
+void FrameTimingStatistics::Reset() {
+  std::scoped_lock lock(mutex_);
+  samples_.clear();
+  next_sample_ = 0;
+  total_frame_count_ = 0;
+  total_janky_frame_count_ = 0;
+}
+
+}  // namespace flutter
@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// The distribution of the durations of a phase over the recent frames.
+struct FrameTimingPercentiles {
+  fml::TimeDelta p50;
+  fml::TimeDelta p90;
+  fml::TimeDelta p99;
+  fml::TimeDelta max;
+};
+
+/// A snapshot of the timings of the recent frames.
+struct FrameTimingSummary {
+  /// The number of frames that the histograms cover, at most the size of the
+  /// window of the statistics.
+  uint64_t frame_count = 0;
+  /// The frame budget when the most recent frame was rasterized.
+  fml::TimeDelta frame_budget;
+  /// From the start to the end of the build on the UI thread.
+  FrameTimingPercentiles build;
+  /// From the start to the end of the rasterization on the raster thread.
+  FrameTimingPercentiles raster;
+  /// From the vsync that the frame was scheduled for to the end of its
+  /// rasterization.
+  FrameTimingPercentiles total;
+  /// The number of frames that missed 0, 1, 2... vsyncs. The last bucket
+  /// counts the frames that missed that many vsyncs or more.
+  std::array<uint64_t, 4> missed_vsync_histogram = {};
+  /// The frames that missed at least one vsync, and the vsyncs they missed.
+  uint64_t janky_frame_count = 0;
+  uint64_t missed_vsync_count = 0;
+  /// The frames since the statistics were created or reset, which are not
+  /// limited to the window.
+  uint64_t total_frame_count = 0;
+  uint64_t total_janky_frame_count = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Aggregates the timings of the rasterized frames into rolling
+///             histograms, so that the jank can be reported by the engine
+///             without the timings going through Dart.
+///
+///             A frame misses a vsync for each frame budget beyond the first
+///             that the slower of its build and its rasterization takes. The
+///             phases of consecutive frames overlap, so the total latency of a
+///             frame isn't held against the budget.
+///
+///             All methods can be called on any thread.
+///
+class FrameTimingStatistics {
+ public:
+  /// 10 seconds at 120Hz.
+  static constexpr size_t kDefaultWindowSize = 1200;
+
+  explicit FrameTimingStatistics(size_t window_size = kDefaultWindowSize);
+
+  ~FrameTimingStatistics();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a frame that was rasterized, evicting the oldest
+  ///             frame of the window once it is full.
+  ///
+  void Record(const FrameTiming& timing, fml::TimeDelta frame_budget);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the percentiles and the jank counts of the frames in
+  ///             the window.
+  ///
+  FrameTimingSummary GetSummary() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all of the recorded frames.
+  ///
+  void Reset();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of vsyncs that a frame with the given build and
+  ///             raster durations missed.
+  ///
+  static uint64_t MissedVsyncs(fml::TimeDelta build,
+                               fml::TimeDelta raster,
+                               fml::TimeDelta frame_budget);
+
+ private:
+  struct FrameSample {
+    fml::TimeDelta build;
+    fml::TimeDelta raster;
+    fml::TimeDelta total;
+    uint64_t missed_vsyncs = 0;
+  };
+
+  const size_t window_size_;
+  mutable std::mutex mutex_;
+  // A ring buffer of the most recent frames, whose oldest frame is at
+  // `next_sample_` once it is full.
+  std::vector<FrameSample> samples_;
+  size_t next_sample_ = 0;
+  fml::TimeDelta frame_budget_;
+  uint64_t total_frame_count_ = 0;
+  uint64_t total_janky_frame_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_statistics.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+constexpr fml::TimeDelta kBudget = fml::TimeDelta::FromMicroseconds(16000);
+
+FrameTiming MakeTiming(int64_t build_micros, int64_t raster_micros) {
+  FrameTiming timing;
+  fml::TimePoint time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  timing.Set(FrameTiming::kVsyncStart, time);
+  timing.Set(FrameTiming::kBuildStart, time);
+  time = time + fml::TimeDelta::FromMicroseconds(build_micros);
+  timing.Set(FrameTiming::kBuildFinish, time);
+  timing.Set(FrameTiming::kRasterStart, time);
+  time = time + fml::TimeDelta::FromMicroseconds(raster_micros);
+  timing.Set(FrameTiming::kRasterFinish, time);
+  return timing;
+}
+}  // namespace
+
+TEST(FrameTimingStatisticsTest, MissedVsyncs) {
+  auto micros = [](int64_t micros) {
+    return fml::TimeDelta::FromMicroseconds(micros);
+  };
+  EXPECT_EQ(FrameTimingStatistics::MissedVsyncs(micros(16000), micros(1000),
+                                                kBudget),
+            0u);
+  EXPECT_EQ(FrameTimingStatistics::MissedVsyncs(micros(1000), micros(16001),
+                                                kBudget),
+            1u);
+  EXPECT_EQ(FrameTimingStatistics::MissedVsyncs(micros(32000), micros(1000),
+                                                kBudget),
+            1u);
+  EXPECT_EQ(FrameTimingStatistics::MissedVsyncs(micros(1000), micros(48001),
+                                                kBudget),
+            3u);
+  EXPECT_EQ(FrameTimingStatistics::MissedVsyncs(micros(48001), micros(1000),
+                                                fml::TimeDelta::Zero()),
+            0u);
+}
+
+TEST(FrameTimingStatisticsTest, ComputesPercentilesOfThePhases) {
+  FrameTimingStatistics statistics;
+  for (int64_t i = 1; i <= 100; i++) {
+    statistics.Record(MakeTiming(i * 100, i * 10), kBudget);
+  }
+  const FrameTimingSummary summary = statistics.GetSummary();
+  EXPECT_EQ(summary.frame_count, 100u);
+  EXPECT_EQ(summary.frame_budget, kBudget);
+  EXPECT_EQ(summary.build.p50.ToMicroseconds(), 5000);
+  EXPECT_EQ(summary.build.p90.ToMicroseconds(), 9000);
+  EXPECT_EQ(summary.build.p99.ToMicroseconds(), 9900);
+  EXPECT_EQ(summary.build.max.ToMicroseconds(), 10000);
+  EXPECT_EQ(summary.raster.p50.ToMicroseconds(), 500);
+  EXPECT_EQ(summary.raster.max.ToMicroseconds(), 1000);
+  EXPECT_EQ(summary.total.max.ToMicroseconds(), 11000);
+  EXPECT_EQ(summary.janky_frame_count, 0u);
+  EXPECT_EQ(summary.missed_vsync_histogram[0], 100u);
+}
+
+TEST(FrameTimingStatisticsTest, CountsTheMissedVsyncs) {
+  FrameTimingStatistics statistics;
+  statistics.Record(MakeTiming(1000, 1000), kBudget);
+  statistics.Record(MakeTiming(20000, 1000), kBudget);
+  statistics.Record(MakeTiming(1000, 40000), kBudget);
+  statistics.Record(MakeTiming(100000, 1000), kBudget);
+  const FrameTimingSummary summary = statistics.GetSummary();
+  EXPECT_EQ(summary.missed_vsync_histogram[0], 1u);
+  EXPECT_EQ(summary.missed_vsync_histogram[1], 1u);
+  EXPECT_EQ(summary.missed_vsync_histogram[2], 1u);
+  // The frame that missed 6 vsyncs is in the last bucket.
+  EXPECT_EQ(summary.missed_vsync_histogram[3], 1u);
+  EXPECT_EQ(summary.janky_frame_count, 3u);
+  EXPECT_EQ(summary.missed_vsync_count, 9u);
+  EXPECT_EQ(summary.total_janky_frame_count, 3u);
+}
+
+TEST(FrameTimingStatisticsTest, OnlyKeepsTheFramesOfTheWindow) {
+  FrameTimingStatistics statistics(/*window_size=*/2);
+  statistics.Record(MakeTiming(40000, 1000), kBudget);
+  statistics.Record(MakeTiming(1000, 1000), kBudget);
+  statistics.Record(MakeTiming(2000, 1000), kBudget);
+  FrameTimingSummary summary = statistics.GetSummary();
+  EXPECT_EQ(summary.frame_count, 2u);
+  EXPECT_EQ(summary.build.max.ToMicroseconds(), 2000);
+  EXPECT_EQ(summary.janky_frame_count, 0u);
+  // The totals aren't limited to the window.
+  EXPECT_EQ(summary.total_frame_count, 3u);
+  EXPECT_EQ(summary.total_janky_frame_count, 1u);
+
+  statistics.Reset();
+  summary = statistics.GetSummary();
+  EXPECT_EQ(summary.frame_count, 0u);
+  EXPECT_EQ(summary.total_frame_count, 0u);
+  EXPECT_EQ(summary.build.max, fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskQueue::IdleTaskQueue() = default;
+
+IdleTaskQueue::~IdleTaskQueue() = default;
+
+IdleTaskQueue::TaskId IdleTaskQueue::PostTask(fml::closure task) {
+  std::scoped_lock lock(mutex_);
+  TaskId task_id = next_task_id_++;
+  tasks_.emplace_back(task_id, std::move(task));
+  return task_id;
+}
+
+void IdleTaskQueue::CancelTask(TaskId task_id) {
+  std::scoped_lock lock(mutex_);
+  auto it = std::find_if(tasks_.begin(), tasks_.end(), [&](const auto& task) {
+    return task.first == task_id;
+  });
+  if (it != tasks_.end()) {
+    tasks_.erase(it);
+  }
+}
+
+void IdleTaskQueue::Interrupt() {
+  std::scoped_lock lock(mutex_);
+  interrupted_ = true;
+}
+
+size_t IdleTaskQueue::RunUntil(fml::TimePoint deadline) {
+  {
+    std::scoped_lock lock(mutex_);
+    if (tasks_.empty()) {
+      return 0;
+    }
+    interrupted_ = false;
+  }
+
+  TRACE_EVENT0("flutter", "IdleTaskQueue::RunUntil");
+  size_t run_count = 0;
+  while (fml::TimePoint::Now() < deadline) {
+    fml::closure task;
+    {
+      std::scoped_lock lock(mutex_);
+      if (interrupted_ || tasks_.empty()) {
+        break;
+      }
+      task = std::move(tasks_.front().second);
+      tasks_.pop_front();
+    }
+    // The lock is not held so that the task can post more tasks.
+    task();
+    run_count++;
+  }
+  return run_count;
+}
+
+size_t IdleTaskQueue::GetPendingTaskCount() const {
+  std::scoped_lock lock(mutex_);
+  return tasks_.size();
+}
+
+}  // namespace flutter
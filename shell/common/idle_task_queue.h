@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Holds deferrable native work that runs on the UI thread while the
+/// |Animator| reports it as idle, such as prewarming caches or prefetching
+/// resources that the next frames may need.
+///
+/// Tasks may be posted and cancelled from any thread. They run in the order
+/// they were posted, each idle period running as many of them as fit before
+/// its deadline. A task that starts before the deadline runs to completion,
+/// so tasks should be short and split larger work into several tasks.
+class IdleTaskQueue {
+ public:
+  using TaskId = uint64_t;
+
+  IdleTaskQueue();
+
+  ~IdleTaskQueue();
+
+  /// Queues |task| for one of the next idle periods and returns an id that
+  /// can be used to cancel it.
+  TaskId PostTask(fml::closure task);
+
+  /// Drops the task with the |task_id| if it has not run yet.
+  void CancelTask(TaskId task_id);
+
+  /// Ends the current idle period early. Called when a frame is requested,
+  /// so that the remaining tasks wait for the next idle period instead of
+  /// delaying the frame.
+  void Interrupt();
+
+  /// Runs the queued tasks until the |deadline| passes, the queue is empty
+  /// or |Interrupt| is called. Returns the number of tasks that ran.
+  size_t RunUntil(fml::TimePoint deadline);
+
+  size_t GetPendingTaskCount() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<std::pair<TaskId, fml::closure>> tasks_;
+  TaskId next_task_id_ = 1;
+  bool interrupted_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
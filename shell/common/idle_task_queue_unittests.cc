@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static fml::TimePoint FarDeadline() {
+  return fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(60);
+}
+
+TEST(IdleTaskQueueTest, RunsTasksInOrder) {
+  IdleTaskQueue queue;
+  std::vector<int> order;
+  queue.PostTask([&] { order.push_back(1); });
+  queue.PostTask([&] { order.push_back(2); });
+  EXPECT_EQ(queue.RunUntil(FarDeadline()), 2u);
+  EXPECT_EQ(order, std::vector<int>({1, 2}));
+  EXPECT_EQ(queue.GetPendingTaskCount(), 0u);
+}
+
+TEST(IdleTaskQueueTest, PassedDeadlineRunsNoTasks) {
+  IdleTaskQueue queue;
+  bool ran = false;
+  queue.PostTask([&] { ran = true; });
+  EXPECT_EQ(queue.RunUntil(fml::TimePoint::Now()), 0u);
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(queue.GetPendingTaskCount(), 1u);
+}
+
+TEST(IdleTaskQueueTest, CancelledTasksDoNotRun) {
+  IdleTaskQueue queue;
+  bool ran = false;
+  IdleTaskQueue::TaskId task_id = queue.PostTask([&] { ran = true; });
+  queue.CancelTask(task_id);
+  EXPECT_EQ(queue.RunUntil(FarDeadline()), 0u);
+  EXPECT_FALSE(ran);
+}
+
+TEST(IdleTaskQueueTest, InterruptDefersRemainingTasks) {
+  IdleTaskQueue queue;
+  bool second_ran = false;
+  queue.PostTask([&] { queue.Interrupt(); });
+  queue.PostTask([&] { second_ran = true; });
+  EXPECT_EQ(queue.RunUntil(FarDeadline()), 1u);
+  EXPECT_FALSE(second_ran);
+
+  // An interrupt only ends the idle period it happened in.
+  EXPECT_EQ(queue.RunUntil(FarDeadline()), 1u);
+  EXPECT_TRUE(second_ran);
+}
+
+TEST(IdleTaskQueueTest, TasksCanPostTasks) {
+  IdleTaskQueue queue;
+  bool nested_ran = false;
+  queue.PostTask([&] { queue.PostTask([&] { nested_ran = true; }); });
+  EXPECT_EQ(queue.RunUntil(FarDeadline()), 2u);
+  EXPECT_TRUE(nested_ran);
+}
+
+}  // namespace testing
+}  // namespace flutter
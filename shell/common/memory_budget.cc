@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_budget.h"
+
+#include <algorithm>
+
+#include "flutter/fml/build_config.h"
+
+#if OS_WIN
+#include <windows.h>
+#elif OS_FUCHSIA
+#include <zircon/syscalls.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace flutter {
+
+static double DeviceScale(size_t total_memory_bytes) {
+  if (total_memory_bytes == 0) {
+    return 1.0;
+  }
+  double scale = static_cast<double>(total_memory_bytes) /
+                 MemoryBudget::kFullBudgetMemoryBytes;
+  return std::clamp(scale, MemoryBudget::kMinimumDeviceScale, 1.0);
+}
+
+MemoryBudget::MemoryBudget(size_t total_memory_bytes)
+    : device_scale_(DeviceScale(total_memory_bytes)) {}
+
+MemoryBudget::~MemoryBudget() = default;
+
+size_t MemoryBudget::GetTotalMemoryBytes() {
+#if OS_WIN
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (!::GlobalMemoryStatusEx(&status)) {
+    return 0;
+  }
+  return static_cast<size_t>(status.ullTotalPhys);
+#elif OS_FUCHSIA
+  return static_cast<size_t>(zx_system_get_physmem());
+#else
+  long pages = ::sysconf(_SC_PHYS_PAGES);
+  long page_size = ::sysconf(_SC_PAGESIZE);
+  if (pages <= 0 || page_size <= 0) {
+    return 0;
+  }
+  return static_cast<size_t>(pages) * static_cast<size_t>(page_size);
+#endif
+}
+
+size_t MemoryBudget::Scale(size_t bytes) const {
+  return static_cast<size_t>(bytes * device_scale_) >> pressure_level_;
+}
+
+void MemoryBudget::OnMemoryPressure(fml::TimePoint now) {
+  pressure_level_ = std::min(pressure_level_ + 1, kMaxPressureLevel);
+  last_change_ = now;
+}
+
+bool MemoryBudget::Recover(fml::TimePoint now) {
+  if (pressure_level_ == 0 || now - last_change_ < kRecoveryDelay) {
+    return false;
+  }
+  pressure_level_--;
+  last_change_ = now;
+  return true;
+}
+
+}  // namespace flutter
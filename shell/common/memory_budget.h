@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_BUDGET_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_BUDGET_H_
+
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Scales the byte budgets of the caches of the engine, the Skia
+///             resource cache, the raster cache and the decoded image cache,
+///             to the memory of the device and to the memory pressure that
+///             the platform reports.
+///
+///             Devices with less than |kFullBudgetMemoryBytes| of memory get
+///             proportionally smaller budgets, down to |kMinimumDeviceScale|.
+///             Each low memory warning halves the budgets, down to
+///             1 / 2^|kMaxPressureLevel|, and they double again for each
+///             |kRecoveryDelay| without a warning.
+///
+class MemoryBudget {
+ public:
+  static constexpr size_t kFullBudgetMemoryBytes = size_t{4} << 30;
+  static constexpr double kMinimumDeviceScale = 0.25;
+  static constexpr int kMaxPressureLevel = 3;
+  static constexpr fml::TimeDelta kRecoveryDelay =
+      fml::TimeDelta::FromSeconds(30);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  total_memory_bytes  The physical memory of the device, or 0
+  ///                                 if it is not known, in which case the
+  ///                                 budgets are not scaled down for the
+  ///                                 device.
+  ///
+  explicit MemoryBudget(size_t total_memory_bytes);
+
+  ~MemoryBudget();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The physical memory of the device, or 0 if it can't be
+  ///             determined on this platform.
+  ///
+  static size_t GetTotalMemoryBytes();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The budget for a cache whose budget would be |bytes| on a
+  ///             device with plenty of memory and no memory pressure.
+  ///
+  size_t Scale(size_t bytes) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Halves the budgets after a low memory warning.
+  ///
+  void OnMemoryPressure(fml::TimePoint now);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Doubles the budgets if there was no warning for
+  ///             |kRecoveryDelay|.
+  ///
+  /// @return     Whether the budgets changed.
+  ///
+  bool Recover(fml::TimePoint now);
+
+  bool under_pressure() const { return pressure_level_ > 0; }
+
+ private:
+  const double device_scale_;
+  int pressure_level_ = 0;
+  fml::TimePoint last_change_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MemoryBudget);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_BUDGET_H_
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_budget.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+constexpr size_t kGigabyte = size_t{1} << 30;
+
+fml::TimePoint SecondsToTimePoint(int64_t seconds) {
+  return fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(seconds));
+}
+}  // namespace
+
+TEST(MemoryBudgetTest, ScalesToDeviceMemory) {
+  EXPECT_EQ(MemoryBudget(8 * kGigabyte).Scale(1000), 1000u);
+  EXPECT_EQ(MemoryBudget(4 * kGigabyte).Scale(1000), 1000u);
+  EXPECT_EQ(MemoryBudget(2 * kGigabyte).Scale(1000), 500u);
+  EXPECT_EQ(MemoryBudget(kGigabyte / 2).Scale(1000), 250u);
+  // Unknown memory.
+  EXPECT_EQ(MemoryBudget(0).Scale(1000), 1000u);
+}
+
+TEST(MemoryBudgetTest, ShrinksUnderPressureAndRecovers) {
+  MemoryBudget budget(8 * kGigabyte);
+  EXPECT_FALSE(budget.under_pressure());
+
+  budget.OnMemoryPressure(SecondsToTimePoint(100));
+  EXPECT_TRUE(budget.under_pressure());
+  EXPECT_EQ(budget.Scale(1000), 500u);
+  for (int i = 0; i < 5; i++) {
+    budget.OnMemoryPressure(SecondsToTimePoint(101));
+  }
+  EXPECT_EQ(budget.Scale(1000), 125u);
+
+  EXPECT_FALSE(budget.Recover(SecondsToTimePoint(130)));
+  EXPECT_TRUE(budget.Recover(SecondsToTimePoint(131)));
+  EXPECT_EQ(budget.Scale(1000), 250u);
+  EXPECT_FALSE(budget.Recover(SecondsToTimePoint(140)));
+  EXPECT_TRUE(budget.Recover(SecondsToTimePoint(161)));
+  EXPECT_TRUE(budget.Recover(SecondsToTimePoint(191)));
+  EXPECT_FALSE(budget.under_pressure());
+  EXPECT_EQ(budget.Scale(1000), 1000u);
+  EXPECT_FALSE(budget.Recover(SecondsToTimePoint(500)));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -14,12 +14,14 @@
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/version/version.h"
 #include "flutter/testing/testing.h"
 #include "include/core/SkPicture.h"
+#include "include/gpu/GrDirectContext.h"
 
 namespace flutter {
 namespace testing {
@@ -402,5 +404,256 @@ TEST_F(PersistentCacheTest,
   DestroyShell(std::move(shell));
 }
 
+TEST(PackedCacheFileTest, FindsTheLatestEntryOfEachKey) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  sk_sp<SkData> key_a = SkData::MakeWithCString("A");
+  sk_sp<SkData> key_b = SkData::MakeWithCString("B");
+
+  {
+    PackedCacheFile packed_cache(directory, false);
+    ASSERT_EQ(packed_cache.Find(*key_a), nullptr);
+    ASSERT_TRUE(packed_cache.Append(*key_a, *SkData::MakeWithCString("x")));
+    ASSERT_TRUE(packed_cache.Append(*key_b, *SkData::MakeWithCString("y")));
+    ASSERT_TRUE(packed_cache.Append(*key_a, *SkData::MakeWithCString("z")));
+    CheckTextSkData(packed_cache.Find(*key_a), std::string("z", 2));
+    CheckTextSkData(packed_cache.Find(*key_b), std::string("y", 2));
+    ASSERT_GT(packed_cache.GetSupersededSize(), 0u);
+  }
+
+  // The entries are indexed again when the file is opened again.
+  PackedCacheFile packed_cache(directory, false);
+  CheckTextSkData(packed_cache.Find(*key_a), std::string("z", 2));
+  ASSERT_EQ(packed_cache.LoadEntries().size(), 2u);
+
+  ASSERT_TRUE(packed_cache.Compact({}));
+  ASSERT_EQ(packed_cache.GetSupersededSize(), 0u);
+  CheckTextSkData(packed_cache.Find(*key_a), std::string("z", 2));
+  CheckTextSkData(packed_cache.Find(*key_b), std::string("y", 2));
+}
+
+TEST(PackedCacheFileTest, AppendsQueuedEntriesTogether) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  PackedCacheFile packed_cache(directory, false);
+  sk_sp<SkData> key_a = SkData::MakeWithCString("A");
+  sk_sp<SkData> key_b = SkData::MakeWithCString("B");
+
+  // Only the first entry of a batch asks for |AppendQueued|.
+  ASSERT_TRUE(packed_cache.Enqueue(*key_a, *SkData::MakeWithCString("x")));
+  ASSERT_FALSE(packed_cache.Enqueue(*key_b, *SkData::MakeWithCString("y")));
+  ASSERT_EQ(packed_cache.Find(*key_a), nullptr);
+
+  ASSERT_TRUE(packed_cache.AppendQueued());
+  CheckTextSkData(packed_cache.Find(*key_a), std::string("x", 2));
+  CheckTextSkData(packed_cache.Find(*key_b), std::string("y", 2));
+  ASSERT_TRUE(packed_cache.AppendQueued());
+
+  ASSERT_TRUE(packed_cache.Enqueue(*key_a, *SkData::MakeWithCString("z")));
+  ASSERT_TRUE(packed_cache.AppendQueued());
+  CheckTextSkData(packed_cache.Find(*key_a), std::string("z", 2));
+  ASSERT_EQ(packed_cache.LoadEntries().size(), 2u);
+}
+
+TEST(PackedCacheFileTest, LoadsTheEntriesInTheOrderTheyWereStored) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  PackedCacheFile packed_cache(directory, false);
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+  for (const char* key : {"A", "B", "C", "A"}) {
+    ASSERT_TRUE(packed_cache.Append(*SkData::MakeWithCString(key), *value));
+  }
+
+  // The order is kept when the file is compacted.
+  for (int i = 0; i < 2; i++) {
+    std::vector<PackedCacheFile::Entry> entries = packed_cache.LoadEntries();
+    ASSERT_EQ(entries.size(), 3u);
+    CheckTextSkData(entries[0].key, std::string("B", 2));
+    CheckTextSkData(entries[1].key, std::string("C", 2));
+    CheckTextSkData(entries[2].key, std::string("A", 2));
+    ASSERT_TRUE(packed_cache.Compact({}));
+  }
+}
+
+TEST_F(PersistentCacheTest, CompactionPacksTheCacheFiles) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  auto cache_dir = fml::CreateDirectory(
+      base_dir.fd(),
+      {"flutter_engine", GetFlutterEngineVersion(), "skia", GetSkiaVersion()},
+      fml::FilePermission::kReadWrite);
+
+  // A cache file of a previous version, which holds a single entry.
+  sk_sp<SkData> key = SkData::MakeWithCString("key");
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+  const std::string file_name = PersistentCache::SkKeyToFilePath(*key);
+  ASSERT_TRUE(fml::WriteAtomically(
+      cache_dir, file_name.c_str(),
+      *PersistentCache::BuildCacheObject(*key, *value)));
+
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache* cache = PersistentCache::GetCacheForProcess();
+  CheckTextSkData(cache->load(*key), std::string("value", 6));
+
+  fml::Thread worker("worker");
+  cache->AddWorkerTaskRunner(worker.GetTaskRunner());
+  cache->CompactIfNeeded();
+  std::promise<bool> compacted;
+  worker.GetTaskRunner()->PostTask(
+      [&compacted]() { compacted.set_value(true); });
+  compacted.get_future().wait();
+  cache->RemoveWorkerTaskRunner(worker.GetTaskRunner());
+
+  ASSERT_FALSE(fml::FileExists(cache_dir, file_name.c_str()));
+  ASSERT_TRUE(fml::FileExists(cache_dir, PackedCacheFile::kFileName));
+  CheckTextSkData(cache->load(*key), std::string("value", 6));
+
+  // Cleanup
+  PersistentCache::ResetCacheForProcess();
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, RecordsTheShaderUsageOverTheLaunches) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  sk_sp<SkData> key_a = SkData::MakeWithCString("A");
+  sk_sp<SkData> key_b = SkData::MakeWithCString("B");
+  fml::Thread worker("worker");
+
+  auto store_usage = [&worker](PersistentCache* cache) {
+    cache->AddWorkerTaskRunner(worker.GetTaskRunner());
+    cache->StoreShaderUsageIfNeeded();
+    std::promise<bool> stored;
+    worker.GetTaskRunner()->PostTask([&stored]() { stored.set_value(true); });
+    stored.get_future().wait();
+    cache->RemoveWorkerTaskRunner(worker.GetTaskRunner());
+  };
+
+  PersistentCache* cache = PersistentCache::GetCacheForProcess();
+  ASSERT_FALSE(cache->GetShaderUsage(*key_a).has_value());
+  cache->BeginFrame();
+  cache->BeginFrame();
+  cache->load(*key_a);
+  cache->BeginFrame();
+  cache->load(*key_b);
+  // A shader is only counted once per launch.
+  cache->load(*key_a);
+  store_usage(cache);
+
+  PersistentCache::ResetCacheForProcess();
+  cache = PersistentCache::GetCacheForProcess();
+  std::optional<PersistentCache::ShaderUsage> usage_a =
+      cache->GetShaderUsage(*key_a);
+  ASSERT_TRUE(usage_a.has_value());
+  ASSERT_EQ(usage_a->first_use_frame, 2u);
+  ASSERT_EQ(usage_a->launch_count, 1u);
+
+  // The first use frame is the earliest over the launches.
+  cache->BeginFrame();
+  cache->load(*key_b);
+  store_usage(cache);
+  PersistentCache::ResetCacheForProcess();
+  cache = PersistentCache::GetCacheForProcess();
+  std::optional<PersistentCache::ShaderUsage> usage_b =
+      cache->GetShaderUsage(*key_b);
+  ASSERT_TRUE(usage_b.has_value());
+  ASSERT_EQ(usage_b->first_use_frame, 1u);
+  ASSERT_EQ(usage_b->launch_count, 2u);
+
+  // Cleanup
+  PersistentCache::ResetCacheForProcess();
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, StoresTheVulkanPipelineCacheWithTheShaders) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+  PersistentCache* cache = PersistentCache::GetCacheForProcess();
+
+  // The key Skia stores the pipeline cache with, and a pipeline cache with a
+  // `VK_PIPELINE_CACHE_HEADER_VERSION_ONE` header.
+  const uint32_t key_type = 1;
+  sk_sp<SkData> key = SkData::MakeWithCopy(&key_type, sizeof(key_type));
+  std::vector<uint32_t> pipeline_cache = {32, 1, 0x1002, 0x67DF, 0, 0, 0, 0, 7};
+  sk_sp<SkData> value = SkData::MakeWithCopy(
+      pipeline_cache.data(), pipeline_cache.size() * sizeof(uint32_t));
+  cache->ResetStoredNewShaders();
+  StorePersistentCache(cache, *key, *value);
+
+  // It isn't an SkSL, nor a new shader.
+  ASSERT_FALSE(cache->StoredNewShaders());
+  ASSERT_EQ(cache->LoadSkSLs().size(), 0u);
+  sk_sp<SkData> loaded = cache->load(*key);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_TRUE(loaded->equals(value.get()));
+
+  // A pipeline cache with an unknown header isn't given to Skia.
+  pipeline_cache[1] = 2;
+  StorePersistentCache(
+      cache, *key,
+      *SkData::MakeWithCopy(pipeline_cache.data(),
+                            pipeline_cache.size() * sizeof(uint32_t)));
+  ASSERT_EQ(cache->load(*key), nullptr);
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  PersistentCache::ResetCacheForProcess();
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, PrecompilesTheQueuedSkSLsIncrementally) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  auto sksl_dir = fml::CreateDirectory(
+      base_dir.fd(),
+      {"flutter_engine", GetFlutterEngineVersion(), "skia", GetSkiaVersion(),
+       PersistentCache::kSkSLSubdirName},
+      fml::FilePermission::kReadWrite);
+  for (const char* name : {"A", "B", "C"}) {
+    sk_sp<SkData> key = SkData::MakeWithCString(name);
+    sk_sp<SkData> value = SkData::MakeWithCString("sksl");
+    ASSERT_TRUE(fml::WriteAtomically(
+        sksl_dir, name, *PersistentCache::BuildCacheObject(*key, *value)));
+  }
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetPrecompileIncrementally(true);
+  PersistentCache* cache = PersistentCache::GetCacheForProcess();
+  sk_sp<GrDirectContext> context = GrDirectContext::MakeMock(nullptr);
+
+  // The SkSLs are only queued, and compiled one at a time without a budget.
+  ASSERT_EQ(cache->PrecompileKnownSkSLs(context.get()), 0u);
+  ASSERT_TRUE(cache->HasQueuedSkSLs(context.get()));
+  ASSERT_TRUE(
+      cache->PrecompileQueuedSkSLs(context.get(), fml::TimeDelta::Zero()));
+  ASSERT_TRUE(
+      cache->PrecompileQueuedSkSLs(context.get(), fml::TimeDelta::Zero()));
+  ASSERT_FALSE(
+      cache->PrecompileQueuedSkSLs(context.get(), fml::TimeDelta::Zero()));
+  ASSERT_FALSE(cache->HasQueuedSkSLs(context.get()));
+
+  ASSERT_EQ(cache->PrecompileKnownSkSLs(context.get()), 0u);
+  cache->DropQueuedSkSLs(context.get());
+  ASSERT_FALSE(
+      cache->PrecompileQueuedSkSLs(context.get(), fml::TimeDelta::Zero()));
+
+  // Cleanup
+  PersistentCache::SetPrecompileIncrementally(false);
+  PersistentCache::ResetCacheForProcess();
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
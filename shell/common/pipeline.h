@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -91,14 +93,28 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth),
+        active_depth_(depth),
+        empty_(depth, "Pipeline::empty"),
+        available_(0, "Pipeline::available"),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// Limits the number of resources in flight to |depth|, which is clamped
+  /// between one and the depth the pipeline was created with. Resources that
+  /// are already in flight are not dropped when the depth shrinks, the
+  /// producer waits for them to be consumed instead.
+  void SetActiveDepth(uint32_t depth) {
+    active_depth_ = std::clamp<uint32_t>(depth, 1, depth_);
+  }
+
+  uint32_t GetActiveDepth() const { return active_depth_; }
+
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!HasRoomForActiveDepth() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -118,7 +134,7 @@ class Pipeline {
   // Prefer using |Produce|. ProducerContinuation returned by this method
   // doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!HasRoomForActiveDepth() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -135,6 +151,14 @@ class Pipeline {
 
   using Consumer = std::function<void(ResourcePtr)>;
 
+  /// Returns the number of resources that have been produced but not
+  /// consumed yet. When called from a consumer, the resource being consumed
+  /// is not counted.
+  size_t GetQueueSize() {
+    std::scoped_lock lock(queue_mutex_);
+    return queue_.size();
+  }
+
   /// @note Procedure doesn't copy all closures.
   [[nodiscard]] PipelineConsumeResult Consume(const Consumer& consumer) {
     if (consumer == nullptr) {
@@ -173,12 +197,17 @@ class Pipeline {
 
  private:
   const uint32_t depth_;
+  std::atomic<uint32_t> active_depth_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  bool HasRoomForActiveDepth() const {
+    return inflight_.load() < static_cast<int>(active_depth_.load());
+  }
+
   bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
     {
       std::scoped_lock lock(queue_mutex_);
@@ -131,5 +131,60 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, QueueSizeExcludesResourceBeingConsumed) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  ASSERT_EQ(pipeline->GetQueueSize(), 0u);
+
+  ASSERT_TRUE(pipeline->Produce().Complete(std::make_unique<int>(1)));
+  ASSERT_TRUE(pipeline->Produce().Complete(std::make_unique<int>(2)));
+  ASSERT_EQ(pipeline->GetQueueSize(), 2u);
+
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([&pipeline](std::unique_ptr<int> v) {
+        ASSERT_EQ(*v, 1);
+        ASSERT_EQ(pipeline->GetQueueSize(), 1u);
+      });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pipeline->GetQueueSize(), 1u);
+}
+
+TEST(PipelineTest, ActiveDepthLimitsResourcesInFlight) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  pipeline->SetActiveDepth(1);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetActiveDepth(2);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+
+  // Shrinking the depth keeps the resources in flight.
+  pipeline->SetActiveDepth(1);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+  PipelineConsumeResult consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  ASSERT_FALSE(pipeline->Produce());
+  consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 2); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+TEST(PipelineTest, ActiveDepthIsClampedToDepth) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  pipeline->SetActiveDepth(5);
+  ASSERT_EQ(pipeline->GetActiveDepth(), 2u);
+  pipeline->SetActiveDepth(0);
+  ASSERT_EQ(pipeline->GetActiveDepth(), 1u);
+}
+
 }  // namespace testing
 }  // namespace flutter
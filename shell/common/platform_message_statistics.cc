@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/platform_message_statistics.h"
+
+#include <algorithm>
+#include <set>
+
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/window/platform_message_response.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns a copy of the name that lives as long as the process, as the
+// timeline requires of the names of its events.
+const char* InternTraceName(const std::string& name) {
+  static std::mutex mutex;
+  static std::set<std::string>* names = new std::set<std::string>();
+  std::scoped_lock lock(mutex);
+  return names->insert(name).first->c_str();
+}
+
+// Forwards the response to a message to its original response, recording how
+// long the message took to be responded to.
+class TimedPlatformMessageResponse : public PlatformMessageResponse {
+ public:
+  TimedPlatformMessageResponse(
+      fml::RefPtr<PlatformMessageResponse> response,
+      std::weak_ptr<PlatformMessageStatistics> statistics,
+      std::string channel)
+      : response_(std::move(response)),
+        statistics_(std::move(statistics)),
+        channel_(std::move(channel)),
+        start_(fml::TimePoint::Now()) {}
+
+  // |PlatformMessageResponse|
+  void Complete(std::unique_ptr<fml::Mapping> data) override {
+    is_complete_ = true;
+    RecordLatency();
+    response_->Complete(std::move(data));
+  }
+
+  // |PlatformMessageResponse|
+  void CompleteEmpty() override {
+    is_complete_ = true;
+    RecordLatency();
+    response_->CompleteEmpty();
+  }
+
+ private:
+  const fml::RefPtr<PlatformMessageResponse> response_;
+  const std::weak_ptr<PlatformMessageStatistics> statistics_;
+  const std::string channel_;
+  const fml::TimePoint start_;
+
+  void RecordLatency() {
+    if (auto statistics = statistics_.lock()) {
+      statistics->RecordResponseLatency(channel_,
+                                        fml::TimePoint::Now() - start_);
+    }
+  }
+};
+
+}  // namespace
+
+PlatformMessageStatistics::PlatformMessageStatistics() = default;
+
+PlatformMessageStatistics::~PlatformMessageStatistics() = default;
+
+std::unique_ptr<PlatformMessage> PlatformMessageStatistics::RecordMessage(
+    std::unique_ptr<PlatformMessage> message,
+    Direction direction) {
+  {
+    std::scoped_lock lock(mutex_);
+    ChannelRecord& record = GetChannelRecord(message->channel());
+    PlatformChannelStats& stats = record.stats;
+    if (direction == Direction::kFromPlatform) {
+      stats.messages_from_platform++;
+      stats.bytes_from_platform += message->data().GetSize();
+    } else {
+      stats.messages_to_platform++;
+      stats.bytes_to_platform += message->data().GetSize();
+    }
+    FML_TRACE_COUNTER("flutter", record.trace_name, 0,  //
+                      "messages",
+                      stats.messages_from_platform + stats.messages_to_platform,
+                      "bytes",
+                      stats.bytes_from_platform + stats.bytes_to_platform);
+  }
+
+  if (!message->response()) {
+    return message;
+  }
+  auto response = fml::MakeRefCounted<TimedPlatformMessageResponse>(
+      message->response(), weak_from_this(), message->channel());
+  if (message->hasData()) {
+    return std::make_unique<PlatformMessage>(
+        message->channel(), message->releaseData(), std::move(response));
+  }
+  return std::make_unique<PlatformMessage>(message->channel(),
+                                           std::move(response));
+}
+
+void PlatformMessageStatistics::RecordHandlerTime(const std::string& channel,
+                                                  fml::TimeDelta time) {
+  std::scoped_lock lock(mutex_);
+  PlatformChannelStats& stats = GetChannelRecord(channel).stats;
+  stats.handler_invocations++;
+  stats.total_handler_time = stats.total_handler_time + time;
+  stats.max_handler_time = std::max(stats.max_handler_time, time);
+}
+
+void PlatformMessageStatistics::RecordResponseLatency(
+    const std::string& channel,
+    fml::TimeDelta latency) {
+  std::scoped_lock lock(mutex_);
+  PlatformChannelStats& stats = GetChannelRecord(channel).stats;
+  stats.responses++;
+  stats.total_response_latency = stats.total_response_latency + latency;
+  stats.max_response_latency = std::max(stats.max_response_latency, latency);
+}
+
+std::vector<PlatformChannelStats> PlatformMessageStatistics::GetAllStats()
+    const {
+  std::scoped_lock lock(mutex_);
+  std::vector<PlatformChannelStats> all_stats;
+  all_stats.reserve(channels_.size());
+  for (const auto& [channel, record] : channels_) {
+    all_stats.push_back(record.stats);
+  }
+  return all_stats;
+}
+
+PlatformMessageStatistics::ChannelRecord&
+PlatformMessageStatistics::GetChannelRecord(const std::string& channel) {
+  auto it = channels_.find(channel);
+  if (it == channels_.end()) {
+    ChannelRecord record;
+    record.stats.channel = channel;
+    record.trace_name = InternTraceName("PlatformChannel:" + channel);
+    it = channels_.emplace(channel, std::move(record)).first;
+  }
+  return it->second;
+}
+
+}  // namespace flutter
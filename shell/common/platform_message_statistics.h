@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PLATFORM_MESSAGE_STATISTICS_H_
+#define FLUTTER_SHELL_COMMON_PLATFORM_MESSAGE_STATISTICS_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/lib/ui/window/platform_message.h"
+
+namespace flutter {
+
+/// A snapshot of the traffic of a platform channel.
+struct PlatformChannelStats {
+  std::string channel;
+  /// The messages sent by the platform to the framework.
+  uint64_t messages_from_platform = 0;
+  uint64_t bytes_from_platform = 0;
+  /// The messages sent by the framework to the platform.
+  uint64_t messages_to_platform = 0;
+  uint64_t bytes_to_platform = 0;
+  /// The responses to the messages in either direction, and the time from
+  /// the messages being sent to them being responded to.
+  uint64_t responses = 0;
+  fml::TimeDelta total_response_latency;
+  fml::TimeDelta max_response_latency;
+  /// The time spent in the handlers of the messages, on the thread that they
+  /// were delivered on.
+  uint64_t handler_invocations = 0;
+  fml::TimeDelta total_handler_time;
+  fml::TimeDelta max_handler_time;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Records the traffic of each platform channel, so that the
+///             channels that load the platform and UI threads the most can be
+///             found.
+///
+///             The message and byte counts are also added to the timeline as
+///             counters named after the channels.
+///
+///             All methods can be called on any thread.
+///
+class PlatformMessageStatistics
+    : public std::enable_shared_from_this<PlatformMessageStatistics> {
+ public:
+  enum class Direction {
+    kFromPlatform,
+    kToPlatform,
+  };
+
+  PlatformMessageStatistics();
+
+  ~PlatformMessageStatistics();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a message that is being sent, and returns it with a
+  ///             response that records the latency of the response before
+  ///             forwarding it to the original one.
+  ///
+  std::unique_ptr<PlatformMessage> RecordMessage(
+      std::unique_ptr<PlatformMessage> message,
+      Direction direction);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the time that the handler of a message on the channel
+  ///             took.
+  ///
+  void RecordHandlerTime(const std::string& channel, fml::TimeDelta time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the time from a message on the channel being sent to
+  ///             it being responded to.
+  ///
+  void RecordResponseLatency(const std::string& channel,
+                             fml::TimeDelta latency);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the stats of all of the channels that had traffic,
+  ///             sorted by channel name.
+  ///
+  std::vector<PlatformChannelStats> GetAllStats() const;
+
+ private:
+  struct ChannelRecord {
+    PlatformChannelStats stats;
+    // The name of the timeline counter of the channel, which must outlive the
+    // VM.
+    const char* trace_name = nullptr;
+  };
+
+  mutable std::mutex mutex_;
+  std::map<std::string, ChannelRecord> channels_;
+
+  ChannelRecord& GetChannelRecord(const std::string& channel);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformMessageStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_PLATFORM_MESSAGE_STATISTICS_H_
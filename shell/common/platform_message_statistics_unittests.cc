@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/platform_message_statistics.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+class MockResponse : public PlatformMessageResponse {
+ public:
+  MOCK_METHOD1(Complete, void(std::unique_ptr<fml::Mapping> data));
+  MOCK_METHOD0(CompleteEmpty, void());
+};
+
+std::unique_ptr<PlatformMessage> MakeMessage(
+    const std::string& channel,
+    size_t size,
+    fml::RefPtr<PlatformMessageResponse> response) {
+  std::vector<uint8_t> data(size, 0);
+  return std::make_unique<PlatformMessage>(
+      channel, fml::MallocMapping::Copy(data.data(), data.size()),
+      std::move(response));
+}
+}  // namespace
+
+TEST(PlatformMessageStatisticsTest, CountsMessagesAndBytesPerChannel) {
+  auto statistics = std::make_shared<PlatformMessageStatistics>();
+  statistics->RecordMessage(MakeMessage("b", 3, nullptr),
+                            PlatformMessageStatistics::Direction::kToPlatform);
+  statistics->RecordMessage(
+      MakeMessage("a", 5, nullptr),
+      PlatformMessageStatistics::Direction::kFromPlatform);
+  statistics->RecordMessage(
+      MakeMessage("a", 7, nullptr),
+      PlatformMessageStatistics::Direction::kFromPlatform);
+
+  auto all_stats = statistics->GetAllStats();
+  ASSERT_EQ(all_stats.size(), 2u);
+  EXPECT_EQ(all_stats[0].channel, "a");
+  EXPECT_EQ(all_stats[0].messages_from_platform, 2u);
+  EXPECT_EQ(all_stats[0].bytes_from_platform, 12u);
+  EXPECT_EQ(all_stats[0].messages_to_platform, 0u);
+  EXPECT_EQ(all_stats[1].channel, "b");
+  EXPECT_EQ(all_stats[1].messages_to_platform, 1u);
+  EXPECT_EQ(all_stats[1].bytes_to_platform, 3u);
+}
+
+TEST(PlatformMessageStatisticsTest, RecordsResponsesAndForwardsThem) {
+  auto statistics = std::make_shared<PlatformMessageStatistics>();
+  auto response = fml::MakeRefCounted<MockResponse>();
+  auto message = statistics->RecordMessage(
+      MakeMessage("a", 4, response),
+      PlatformMessageStatistics::Direction::kFromPlatform);
+  ASSERT_TRUE(message->hasData());
+  EXPECT_EQ(message->data().GetSize(), 4u);
+  ASSERT_NE(message->response(), response);
+
+  EXPECT_CALL(*response, CompleteEmpty());
+  message->response()->CompleteEmpty();
+  EXPECT_TRUE(message->response()->is_complete());
+
+  auto all_stats = statistics->GetAllStats();
+  ASSERT_EQ(all_stats.size(), 1u);
+  EXPECT_EQ(all_stats[0].responses, 1u);
+  EXPECT_GE(all_stats[0].max_response_latency, fml::TimeDelta::Zero());
+}
+
+TEST(PlatformMessageStatisticsTest, RecordsHandlerTime) {
+  auto statistics = std::make_shared<PlatformMessageStatistics>();
+  statistics->RecordHandlerTime("a", fml::TimeDelta::FromMicroseconds(3));
+  statistics->RecordHandlerTime("a", fml::TimeDelta::FromMicroseconds(5));
+
+  auto all_stats = statistics->GetAllStats();
+  ASSERT_EQ(all_stats.size(), 1u);
+  EXPECT_EQ(all_stats[0].handler_invocations, 2u);
+  EXPECT_EQ(all_stats[0].total_handler_time,
+            fml::TimeDelta::FromMicroseconds(8));
+  EXPECT_EQ(all_stats[0].max_handler_time,
+            fml::TimeDelta::FromMicroseconds(5));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -169,6 +169,15 @@ void PlatformView::LoadDartDeferredLibrary(
     std::unique_ptr<const fml::Mapping> snapshot_data,
     std::unique_ptr<const fml::Mapping> snapshot_instructions) {}
 
+void PlatformView::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  delegate_.PrefetchDartDeferredLibrary(loading_unit_id,
+                                        std::move(snapshot_data),
+                                        std::move(snapshot_instructions));
+}
+
 void PlatformView::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                                 const std::string error_message,
                                                 bool transient) {}
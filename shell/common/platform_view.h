@@ -263,6 +263,29 @@ class PlatformView {
         std::unique_ptr<const fml::Mapping> snapshot_data,
         std::unique_ptr<const fml::Mapping> snapshot_instructions) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Prepares a deferred library ahead of the `loadLibrary()`
+    ///             call that requests it. Its pages are read on a worker, and
+    ///             the next `RequestDartDeferredLibrary` of the loading unit
+    ///             loads it without asking the embedder for it again.
+    ///
+    ///             Loading units can be prefetched concurrently. A loading
+    ///             unit that is already being prefetched is ignored.
+    ///
+    /// @param[in]  loading_unit_id  The unique id of the deferred library's
+    ///                              loading unit.
+    ///
+    /// @param[in]  snapshot_data    Dart snapshot data of the loading unit's
+    ///                              shared library.
+    ///
+    /// @param[in]  snapshot_instructions  Dart snapshot instructions of the
+    ///                                   loading unit's shared library.
+    ///
+    virtual void PrefetchDartDeferredLibrary(
+        intptr_t loading_unit_id,
+        std::unique_ptr<const fml::Mapping> snapshot_data,
+        std::unique_ptr<const fml::Mapping> snapshot_instructions) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Indicates to the dart VM that the request to load a deferred
     ///             library with the specified loading unit id has failed.
@@ -739,6 +762,31 @@ class PlatformView {
       std::unique_ptr<const fml::Mapping> snapshot_data,
       std::unique_ptr<const fml::Mapping> snapshot_instructions);
 
+  //--------------------------------------------------------------------------
+  /// @brief      Prepares a deferred library ahead of the `loadLibrary()`
+  ///             call that requests it, so that the request loads it without
+  ///             a call to `RequestDartDeferredLibrary`. Its pages are read on
+  ///             a worker, and several loading units can be prefetched
+  ///             concurrently.
+  ///
+  ///             The mappings are resolved like the ones passed to
+  ///             `LoadDartDeferredLibrary`, whose ownership is assumed in the
+  ///             same way once the loading unit is requested.
+  ///
+  /// @param[in]  loading_unit_id  The unique id of the deferred library's
+  ///                              loading unit.
+  ///
+  /// @param[in]  snapshot_data    Dart snapshot data of the loading unit's
+  ///                              shared library.
+  ///
+  /// @param[in]  snapshot_instructions  Dart snapshot instructions of the
+  ///                                   loading unit's shared library.
+  ///
+  virtual void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
   //--------------------------------------------------------------------------
   /// @brief      Indicates to the dart VM that the request to load a deferred
   ///             library with the specified loading unit id has failed.
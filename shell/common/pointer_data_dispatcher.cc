@@ -4,10 +4,34 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+namespace {
+
+// Samples that are closer together than this are too noisy to estimate the
+// velocity of the pointer from.
+constexpr int64_t kMinResampleDelta = 2000;  // microseconds
+
+// Samples that are further apart than this belong to a pointer that stopped,
+// and must not be extrapolated from.
+constexpr int64_t kMaxResampleDelta = 20000;  // microseconds
+
+// How far past its last sample the position of a pointer is predicted.
+constexpr int64_t kMaxResamplePrediction = 8000;  // microseconds
+
+bool IsResampledKind(const PointerData& data) {
+  return data.signal_kind == PointerData::SignalKind::kNone &&
+         (data.kind == PointerData::DeviceKind::kTouch ||
+          data.kind == PointerData::DeviceKind::kStylus ||
+          data.kind == PointerData::DeviceKind::kInvertedStylus);
+}
+
+}  // namespace
+
 PointerDataDispatcher::~PointerDataDispatcher() = default;
 DefaultPointerDataDispatcher::~DefaultPointerDataDispatcher() = default;
 
@@ -15,6 +39,11 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -68,4 +97,177 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  const size_t length = packet->GetLength();
+  bool has_only_moves = length > 0;
+  for (size_t i = 0; i < length && has_only_moves; i++) {
+    const PointerData data = packet->GetPointerData(i);
+    has_only_moves = data.change == PointerData::Change::kMove &&
+                     IsResampledKind(data) && pointers_.count(data.device) > 0;
+  }
+  if (has_only_moves) {
+    const int64_t arrival_time =
+        fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+    for (size_t i = 0; i < length; i++) {
+      AddMove(packet->GetPointerData(i), arrival_time);
+    }
+    pending_trace_flow_ids_.push_back(trace_flow_id);
+    ScheduleSecondaryVsyncCallback();
+    return;
+  }
+
+  // Any other event is dispatched right away, together with the moves that
+  // were held back so that it doesn't overtake them.
+  std::vector<PointerData> events;
+  for (auto& [device, state] : pointers_) {
+    if (state.has_pending_move) {
+      events.push_back(state.latest);
+      state.has_pending_move = false;
+      state.dispatched_x = state.latest.physical_x;
+      state.dispatched_y = state.latest.physical_y;
+    }
+  }
+  for (size_t i = 0; i < length; i++) {
+    const PointerData data = packet->GetPointerData(i);
+    events.push_back(data);
+    switch (data.change) {
+      case PointerData::Change::kDown:
+        if (IsResampledKind(data)) {
+          if (pointers_.empty()) {
+            // The offset of the clocks is estimated anew for each gesture, in
+            // case either of them was adjusted in the meantime.
+            clock_offset_.reset();
+          }
+          PointerState& state = pointers_[data.device];
+          state = PointerState();
+          state.latest = data;
+          state.dispatched_x = data.physical_x;
+          state.dispatched_y = data.physical_y;
+        }
+        break;
+      case PointerData::Change::kMove:
+        if (auto found = pointers_.find(data.device);
+            found != pointers_.end()) {
+          found->second.previous = found->second.latest;
+          found->second.latest = data;
+          found->second.dispatched_x = data.physical_x;
+          found->second.dispatched_y = data.physical_y;
+        }
+        break;
+      case PointerData::Change::kUp:
+      case PointerData::Change::kCancel:
+      case PointerData::Change::kRemove:
+        pointers_.erase(data.device);
+        break;
+      default:
+        break;
+    }
+  }
+
+  for (uint64_t merged_trace_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", merged_trace_flow_id);
+  }
+  pending_trace_flow_ids_.clear();
+  auto events_packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    events_packet->SetPointerData(i, events[i]);
+  }
+  delegate_.DoDispatchPacket(std::move(events_packet), trace_flow_id);
+}
+
+void ResamplingPointerDataDispatcher::AddMove(const PointerData& data,
+                                              int64_t arrival_time) {
+  PointerState& state = pointers_[data.device];
+  state.previous = state.latest;
+  state.latest = data;
+  state.has_pending_move = true;
+
+  const int64_t offset = arrival_time - data.time_stamp;
+  clock_offset_ = clock_offset_ ? std::min(*clock_offset_, offset) : offset;
+}
+
+void ResamplingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  if (is_vsync_callback_scheduled_) {
+    return;
+  }
+  is_vsync_callback_scheduled_ = true;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->is_vsync_callback_scheduled_ = false;
+          dispatcher->DispatchResampledMoves();
+        }
+      });
+}
+
+void ResamplingPointerDataDispatcher::DispatchResampledMoves() {
+  TRACE_EVENT0("flutter",
+               "ResamplingPointerDataDispatcher::DispatchResampledMoves");
+  const int64_t sample_time = delegate_.GetLastVsyncTargetTime()
+                                  .ToEpochDelta()
+                                  .ToMicroseconds() -
+                              clock_offset_.value_or(0);
+  std::vector<PointerData> moves;
+  for (auto& [device, state] : pointers_) {
+    if (!state.has_pending_move) {
+      continue;
+    }
+    PointerData move = Resample(state, sample_time);
+    move.physical_delta_x = move.physical_x - state.dispatched_x;
+    move.physical_delta_y = move.physical_y - state.dispatched_y;
+    state.dispatched_x = move.physical_x;
+    state.dispatched_y = move.physical_y;
+    state.has_pending_move = false;
+    moves.push_back(move);
+  }
+  if (moves.empty()) {
+    return;
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(moves.size());
+  for (size_t i = 0; i < moves.size(); i++) {
+    packet->SetPointerData(i, moves[i]);
+  }
+  // The moves of all the packets that were held back are dispatched at once.
+  FML_DCHECK(!pending_trace_flow_ids_.empty());
+  const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (uint64_t merged_trace_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", merged_trace_flow_id);
+  }
+  pending_trace_flow_ids_.clear();
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
+PointerData ResamplingPointerDataDispatcher::Resample(
+    const PointerState& state,
+    int64_t sample_time) const {
+  PointerData result = state.latest;
+  if (!state.previous) {
+    return result;
+  }
+  const PointerData& a = *state.previous;
+  const PointerData& b = state.latest;
+  const int64_t delta = b.time_stamp - a.time_stamp;
+  if (delta < kMinResampleDelta || delta > kMaxResampleDelta ||
+      sample_time < a.time_stamp) {
+    return result;
+  }
+  sample_time = std::min(
+      sample_time,
+      b.time_stamp + std::min(kMaxResamplePrediction, delta / 2));
+  const double alpha = static_cast<double>(sample_time - a.time_stamp) / delta;
+  result.time_stamp = sample_time;
+  result.physical_x = a.physical_x + alpha * (b.physical_x - a.physical_x);
+  result.physical_y = a.physical_y + alpha * (b.physical_y - a.physical_y);
+  return result;
+}
+
 }  // namespace flutter
@@ -5,6 +5,10 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -64,6 +68,14 @@ class PointerDataDispatcher {
     virtual void ScheduleSecondaryVsyncCallback(
         uintptr_t id,
         const fml::closure& callback) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief    The target time of the frame of the last vsync, which is the
+    ///           vsync of a secondary callback while it runs.
+    ///
+    ///           This is used by `ResamplingPointerDataDispatcher` to sample
+    ///           the pointers at the time their frame is shown.
+    virtual fml::TimePoint GetLastVsyncTargetTime() = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -162,6 +174,67 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds back the moves of touches and styluses until the
+/// next vsync, and then dispatches a single move per pointer whose position is
+/// resampled at the target time of the frame.
+///
+/// Touch panels sample faster than the display refreshes on many devices, and
+/// the samples a frame receives are not evenly spaced in time, so a dragged
+/// object appears to move jerkily. Resampling gives every frame one event that
+/// matches the time it is shown at, and the framework handles one move per
+/// pointer per frame however fast the panel samples.
+///
+/// The position is interpolated between the last two samples of the pointer,
+/// or extrapolated by at most `kMaxResamplePrediction` and half of the time
+/// between them past the last one. Samples that are too close together or too
+/// far apart to estimate a velocity from are dispatched as they are. Packets
+/// with any other event are dispatched right away, after the moves that were
+/// held back.
+///
+/// The events are timestamped with the clock of the platform, which may differ
+/// from that of the vsync. The offset between the two is estimated as the
+/// smallest difference between the arrival time and timestamp of the moves of
+/// the current gesture.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit ResamplingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+ private:
+  struct PointerState {
+    // The last sample of the pointer, and the one before it if there is one.
+    PointerData latest;
+    std::optional<PointerData> previous;
+    // Whether |latest| is a move that has not been dispatched yet.
+    bool has_pending_move = false;
+    // The position of the last event dispatched for the pointer, which the
+    // deltas of the resampled moves are relative to.
+    double dispatched_x = 0;
+    double dispatched_y = 0;
+  };
+
+  void AddMove(const PointerData& data, int64_t arrival_time);
+  void DispatchResampledMoves();
+  void ScheduleSecondaryVsyncCallback();
+  PointerData Resample(const PointerState& state, int64_t sample_time) const;
+
+  std::unordered_map<int64_t, PointerState> pointers_;
+  // The arrival time minus the timestamp of the moves, in microseconds.
+  std::optional<int64_t> clock_offset_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  bool is_vsync_callback_scheduled_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
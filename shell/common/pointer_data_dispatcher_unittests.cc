@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    std::vector<PointerData> events;
+    for (size_t i = 0; i < packet->GetLength(); i++) {
+      events.push_back(packet->GetPointerData(i));
+    }
+    packets.push_back(events);
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  fml::TimePoint GetLastVsyncTargetTime() override {
+    return fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromMicroseconds(target_time));
+  }
+
+  void FireVsync(int64_t frame_target_time) {
+    target_time = frame_target_time;
+    auto callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    ASSERT_TRUE(callback);
+    callback();
+  }
+
+  std::vector<std::vector<PointerData>> packets;
+  fml::closure vsync_callback;
+  int64_t target_time = 0;
+};
+
+int64_t NowInMicroseconds() {
+  return fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+}
+
+PointerData CreateTouch(PointerData::Change change,
+                        int64_t time_stamp,
+                        double x) {
+  PointerData data;
+  data.Clear();
+  data.time_stamp = time_stamp;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.physical_x = x;
+  return data;
+}
+
+void Dispatch(PointerDataDispatcher& dispatcher, const PointerData& data) {
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  packet->SetPointerData(0, data);
+  dispatcher.DispatchPacket(std::move(packet), 0);
+}
+
+}  // namespace
+
+TEST(ResamplingPointerDataDispatcherTest, DispatchesOneMovePerFrame) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  // The timestamps are in the past, so that the clocks seem to be in sync.
+  const int64_t now = NowInMicroseconds();
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kDown, now - 16000, 0));
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kMove, now - 8000, 0));
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kMove, now, 8));
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  // The prediction is limited to half of the time between the samples.
+  delegate.FireVsync(now + 16000);
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  ASSERT_EQ(delegate.packets[1].size(), 1u);
+  const PointerData& move = delegate.packets[1][0];
+  EXPECT_EQ(move.change, PointerData::Change::kMove);
+  EXPECT_EQ(move.time_stamp, now + 4000);
+  EXPECT_DOUBLE_EQ(move.physical_x, 12);
+  EXPECT_DOUBLE_EQ(move.physical_delta_x, 12);
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, InterpolatesBetweenSamples) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  const int64_t now = NowInMicroseconds();
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kDown, now - 16000, 0));
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kMove, now - 8000, 0));
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kMove, now, 8));
+
+  delegate.FireVsync(now - 4000);
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  // The clock offset is a little larger than 0, as the moves arrive after
+  // they were sampled.
+  EXPECT_NEAR(delegate.packets[1][0].physical_x, 4, 1);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, DispatchesHeldBackMovesBeforeUp) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  const int64_t now = NowInMicroseconds();
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kDown, now - 8000, 0));
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kMove, now - 4000, 4));
+  Dispatch(dispatcher, CreateTouch(PointerData::Change::kUp, now, 8));
+
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  ASSERT_EQ(delegate.packets[1].size(), 2u);
+  EXPECT_EQ(delegate.packets[1][0].change, PointerData::Change::kMove);
+  EXPECT_DOUBLE_EQ(delegate.packets[1][0].physical_x, 4);
+  EXPECT_EQ(delegate.packets[1][1].change, PointerData::Change::kUp);
+
+  // The callback that was scheduled for the move has nothing left to do.
+  delegate.FireVsync(now + 8000);
+  EXPECT_EQ(delegate.packets.size(), 2u);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, DoesNotHoldBackMouseEvents) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  PointerData hover = CreateTouch(PointerData::Change::kHover, 0, 4);
+  hover.kind = PointerData::DeviceKind::kMouse;
+  Dispatch(dispatcher, hover);
+  EXPECT_EQ(delegate.packets.size(), 1u);
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,13 +5,20 @@
 #include "flutter/shell/common/rasterizer.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <utility>
 
 #include "flow/frame_timings.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/common/graphics/skia_gpu_statistics.h"
+#include "flutter/flow/display_list_canvas.h"
+#include "flutter/flow/display_list_serialization.h"
+#include "flutter/flow/glyph_usage.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_flight_recorder.h"
+#include "flutter/runtime/startup_timings.h"
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "fml/make_copyable.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
@@ -28,11 +35,47 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// Purges the resources of the GPU resource cache that weren't used within the
+// expiration, and records the bytes that were freed.
+static void PerformDeferredSkiaCleanup(GrDirectContext* context,
+                                       std::chrono::milliseconds expiration) {
+  size_t bytes_before = 0;
+  context->getResourceCacheUsage(nullptr, &bytes_before);
+  context->performDeferredCleanup(expiration);
+  size_t bytes_after = 0;
+  context->getResourceCacheUsage(nullptr, &bytes_after);
+  if (bytes_after < bytes_before) {
+    SkiaGpuStatistics::GetInstance().RecordResourceCachePurge(bytes_before -
+                                                              bytes_after);
+  }
+}
+
+// The time spent precompiling the queued SkSLs in each task between the
+// frames, after which the task yields, unless the compilation of a single
+// SkSL takes longer.
+static constexpr fml::TimeDelta kSkSLPrecompilationBudget =
+    fml::TimeDelta::FromMilliseconds(4);
+
+// Returns the vsync interval the frame was produced for. On variable refresh
+// rate displays this can differ from frame to frame, so it is preferred over
+// the budget derived from the refresh rate of the display.
+static fml::Milliseconds GetFrameInterval(
+    const FrameTimingsRecorder& frame_timings_recorder,
+    fml::Milliseconds display_frame_budget) {
+  const fml::TimeDelta interval = frame_timings_recorder.GetVsyncTargetTime() -
+                                  frame_timings_recorder.GetVsyncStartTime();
+  if (interval <= fml::TimeDelta::Zero()) {
+    return display_frame_budget;
+  }
+  return fml::Milliseconds(interval.ToMillisecondsF());
+}
+
 Rasterizer::Rasterizer(Delegate& delegate)
     : delegate_(delegate),
       compositor_context_(std::make_unique<flutter::CompositorContext>(
           delegate.GetFrameBudget())),
       user_override_resource_cache_bytes_(false),
+      last_skia_gpu_counters_(SkiaGpuStatistics::GetInstance().GetCounters()),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
 }
@@ -61,6 +104,16 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+  if (gpu_timing_enabled_) {
+    surface_->SetGpuTimingEnabled(true);
+  }
+
+  if (tile_task_runner_) {
+    surface_->SetTileTaskRunner(tile_task_runner_);
+  }
+
+  PrecompileQueuedSkSLs();
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -82,12 +135,24 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
 }
 
 void Rasterizer::Teardown() {
+  WaitForPendingPresent();
   auto context_switch =
       surface_ ? surface_->MakeRenderContextCurrent() : nullptr;
   if (context_switch && context_switch->GetResult()) {
+    // The pipelines built since the pipeline cache was last stored, such as
+    // before the application is paused.
+    PersistentCache::GetCacheForProcess()->StoreVkPipelineCacheIfNeeded(
+        surface_->GetContext(), /*throttle=*/false);
     compositor_context_->OnGrContextDestroyed();
+    if (snapshot_unref_queue_) {
+      snapshot_unref_queue_->Drain();
+    }
   }
 
+  if (surface_) {
+    PersistentCache::GetCacheForProcess()->DropQueuedSkSLs(
+        surface_->GetContext());
+  }
   surface_.reset();
   last_layer_tree_.reset();
 
@@ -127,11 +192,12 @@ void Rasterizer::NotifyLowMemoryWarning() const {
         << "Rasterizer::NotifyLowMemoryWarning called with no GrContext.";
     return;
   }
+  WaitForPendingPresent();
   auto context_switch = surface_->MakeRenderContextCurrent();
   if (!context_switch->GetResult()) {
     return;
   }
-  context->performDeferredCleanup(std::chrono::milliseconds(0));
+  PerformDeferredSkiaCleanup(context, std::chrono::milliseconds(0));
 }
 
 flutter::TextureRegistry* Rasterizer::GetTextureRegistry() {
@@ -170,17 +236,34 @@ RasterStatus Rasterizer::Draw(
           FrameTimingsRecorder::State::kBuildEnd);
 
   RasterStatus raster_status = RasterStatus::kFailed;
+  uint64_t skipped_frame_count = 0;
+  bool frame_skipped = false;
   Pipeline<flutter::LayerTree>::Consumer consumer =
       [&](std::unique_ptr<LayerTree> layer_tree) {
+        frame_skipped = false;
         if (discard_callback(*layer_tree.get())) {
           raster_status = RasterStatus::kDiscarded;
+        } else if (frame_skipping_enabled_ && pipeline->GetQueueSize() > 0 &&
+                   fml::TimePoint::Now() >
+                       frame_timings_recorder->GetVsyncTargetTime()) {
+          TRACE_EVENT0("flutter", "Rasterizer::SkipStaleFrame");
+          raster_status = RasterStatus::kDiscarded;
+          frame_skipped = true;
+          skipped_frame_count++;
         } else {
+          frame_timings_recorder->RecordSkippedFrames(skipped_frame_count);
           raster_status =
               DoDraw(std::move(frame_timings_recorder), std::move(layer_tree));
         }
       };
 
   PipelineConsumeResult consume_result = pipeline->Consume(consumer);
+  // Move on to the newer layer trees right away instead of yielding the event
+  // loop, so that the newest one is rasterized for this frame.
+  while (frame_skipped &&
+         consume_result == PipelineConsumeResult::MoreAvailable) {
+    consume_result = pipeline->Consume(consumer);
+  }
   // if the raster status is to resubmit the frame, we push the frame to the
   // front of the queue and also change the consume status to more available.
 
@@ -226,6 +309,52 @@ RasterStatus Rasterizer::Draw(
   return raster_status;
 }
 
+void Rasterizer::SetFrameSkippingEnabled(bool enabled) {
+  frame_skipping_enabled_ = enabled;
+}
+
+void Rasterizer::SetGpuTimingEnabled(bool enabled) {
+  gpu_timing_enabled_ = enabled;
+  if (surface_) {
+    // The surface uses the render context to set up its measurements.
+    WaitForPendingPresent();
+    surface_->SetGpuTimingEnabled(enabled);
+  }
+}
+
+void Rasterizer::SetTileTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  tile_task_runner_ = std::move(task_runner);
+  if (surface_) {
+    surface_->SetTileTaskRunner(tile_task_runner_);
+  }
+}
+
+void Rasterizer::SetSubmitThreadEnabled(bool enabled) {
+  if (!enabled) {
+    WaitForPendingPresent();
+    submit_thread_.reset();
+    return;
+  }
+  if (!submit_thread_) {
+    submit_thread_ = std::make_unique<fml::Thread>("io.flutter.submit");
+  }
+}
+
+void Rasterizer::WaitForPendingPresent() const {
+  if (!pending_present_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::WaitForPendingPresent");
+  pending_present_->Wait();
+  pending_present_.reset();
+  if (surface_) {
+    // Frames presented on the raster thread leave the context current, keep
+    // doing the same for the users of the context between frames.
+    surface_->MakeRenderContextCurrent();
+  }
+}
+
 namespace {
 sk_sp<SkImage> DrawSnapshot(
     sk_sp<SkSurface> surface,
@@ -262,6 +391,7 @@ sk_sp<SkImage> Rasterizer::DoMakeRasterSnapshot(
     SkISize size,
     std::function<void(SkCanvas*)> draw_callback) {
   TRACE_EVENT0("flutter", __FUNCTION__);
+  WaitForPendingPresent();
   sk_sp<SkImage> result;
   SkImageInfo image_info = SkImageInfo::MakeN32Premul(
       size.width(), size.height(), SkColorSpace::MakeSRGB());
@@ -314,19 +444,40 @@ sk_sp<SkImage> Rasterizer::DoMakeRasterSnapshot(
 
               // When there is an on screen surface, we need a render target
               // SkSurface because we want to access texture backed images.
-              sk_sp<SkSurface> sk_surface =
-                  SkSurface::MakeRenderTarget(context,          // context
-                                              SkBudgeted::kNo,  // budgeted
-                                              image_info        // image info
-                  );
-              if (!sk_surface) {
+              if (snapshot_surface != surface_.get()) {
+                sk_sp<SkSurface> sk_surface =
+                    SkSurface::MakeRenderTarget(context,          // context
+                                                SkBudgeted::kNo,  // budgeted
+                                                image_info  // image info
+                    );
+                if (!sk_surface) {
+                  FML_LOG(ERROR) << "DoMakeRasterSnapshot can not create GPU "
+                                    "render target";
+                  return;
+                }
+
+                sk_surface->getCanvas()->scale(scale_factor, scale_factor);
+                result = DrawSnapshot(sk_surface, draw_callback);
+                return;
+              }
+
+              // The render targets of the onscreen context are pooled, which
+              // is cleared before the context goes away. The snapshot is
+              // copied back to the CPU, so the render target can go back to
+              // the pool right away.
+              auto pooled_surface =
+                  compositor_context_->raster_cache().surface_pool().Acquire(
+                      context, image_info);
+              if (!pooled_surface) {
                 FML_LOG(ERROR)
                     << "DoMakeRasterSnapshot can not create GPU render target";
                 return;
               }
 
-              sk_surface->getCanvas()->scale(scale_factor, scale_factor);
-              result = DrawSnapshot(sk_surface, draw_callback);
+              SkCanvas* canvas = pooled_surface->canvas();
+              canvas->scale(scale_factor, scale_factor);
+              draw_callback(canvas);
+              result = pooled_surface->MakeRasterImage();
             }));
   }
 
@@ -368,6 +519,75 @@ sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
                               });
 }
 
+std::vector<SkiaGPUObject<SkImage>> Rasterizer::MakeGpuSnapshots(
+    const std::vector<std::function<void(SkCanvas*)>>& draw_callbacks,
+    SkISize picture_size) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  WaitForPendingPresent();
+  if (!snapshot_unref_queue_) {
+    snapshot_unref_queue_ = fml::MakeRefCounted<SkiaUnrefQueue>(
+        delegate_.GetTaskRunners().GetRasterTaskRunner(),
+        fml::TimeDelta::FromMilliseconds(8));
+  }
+
+  std::vector<sk_sp<SkImage>> images;
+  images.reserve(draw_callbacks.size());
+  auto make_raster_snapshots = [&]() {
+    for (const auto& draw_callback : draw_callbacks) {
+      images.push_back(DoMakeRasterSnapshot(picture_size, draw_callback));
+    }
+  };
+
+  GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (!context || std::max(picture_size.width(), picture_size.height()) >
+                      context->maxRenderTargetSize()) {
+    // Without an onscreen context, or for snapshots that have to be scaled
+    // down, fall back to the regular snapshots.
+    make_raster_snapshots();
+  } else {
+    delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+        fml::SyncSwitch::Handlers()
+            .SetIfTrue(make_raster_snapshots)
+            .SetIfFalse([&] {
+              auto context_switch = surface_->MakeRenderContextCurrent();
+              if (!context_switch->GetResult()) {
+                return;
+              }
+              const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+                  picture_size.width(), picture_size.height(),
+                  SkColorSpace::MakeSRGB());
+              for (const auto& draw_callback : draw_callbacks) {
+                // Budgeted render targets are backed by the scratch textures
+                // Skia keeps in its resource cache, instead of fresh
+                // allocations.
+                sk_sp<SkSurface> sk_surface = SkSurface::MakeRenderTarget(
+                    context, SkBudgeted::kYes, image_info);
+                if (!sk_surface) {
+                  FML_LOG(ERROR)
+                      << "MakeGpuSnapshots can not create GPU render target";
+                  images.push_back(nullptr);
+                  continue;
+                }
+                draw_callback(sk_surface->getCanvas());
+                images.push_back(sk_surface->makeImageSnapshot());
+              }
+              // A single flush submits the work for all of the snapshots.
+              context->flushAndSubmit();
+            }));
+  }
+
+  std::vector<SkiaGPUObject<SkImage>> results;
+  results.reserve(draw_callbacks.size());
+  for (size_t i = 0; i < draw_callbacks.size(); i++) {
+    if (i < images.size() && images[i]) {
+      results.emplace_back(std::move(images[i]), snapshot_unref_queue_);
+    } else {
+      results.emplace_back();
+    }
+  }
+  return results;
+}
+
 RasterStatus Rasterizer::DoDraw(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
     std::unique_ptr<flutter::LayerTree> layer_tree) {
@@ -379,13 +599,17 @@ RasterStatus Rasterizer::DoDraw(
     return RasterStatus::kFailed;
   }
 
+  layer_tree->BuildDeferredLayers();
+
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
+  persistent_cache->BeginFrame();
 
   RasterStatus raster_status =
       DrawToSurface(*frame_timings_recorder, *layer_tree);
   if (raster_status == RasterStatus::kSuccess) {
     last_layer_tree_ = std::move(layer_tree);
+    GlyphUsage::GetInstance().EndFrame();
   } else if (raster_status == RasterStatus::kResubmit ||
              raster_status == RasterStatus::kSkipAndRetry) {
     resubmitted_layer_tree_ = std::move(layer_tree);
@@ -399,8 +623,20 @@ RasterStatus Rasterizer::DoDraw(
     auto screenshot =
         ScreenshotLastLayerTree(ScreenshotType::SkiaPicture, false);
     persistent_cache->DumpSkp(*screenshot.data);
+    // The display list of the frame can be packaged with the application for
+    // the shader warm-up.
+    auto display_list =
+        ScreenshotLastLayerTree(ScreenshotType::DisplayList, false);
+    if (display_list.data) {
+      persistent_cache->DumpDisplayList(*display_list.data);
+    }
   }
 
+  persistent_cache->StoreVkPipelineCacheIfNeeded(surface_->GetContext(),
+                                                 /*throttle=*/true);
+  // The surface may have queued the known SkSLs while the frame was drawn.
+  PrecompileQueuedSkSLs();
+
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
@@ -416,7 +652,9 @@ RasterStatus Rasterizer::DoDraw(
   if (raster_finish_time > frame_target_time) {
     fml::TimePoint latest_frame_target_time =
         delegate_.GetLatestFrameTargetTime();
-    const auto frame_budget_millis = delegate_.GetFrameBudget().count();
+    const auto frame_budget_millis =
+        GetFrameInterval(*frame_timings_recorder, delegate_.GetFrameBudget())
+            .count();
     if (latest_frame_target_time < raster_finish_time) {
       latest_frame_target_time =
           latest_frame_target_time +
@@ -496,7 +734,10 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     flutter::LayerTree& layer_tree) {
   TRACE_EVENT0("flutter", "Rasterizer::DrawToSurfaceUnsafe");
   FML_DCHECK(surface_);
+  WaitForPendingPresent();
 
+  compositor_context_->SetFrameBudget(
+      GetFrameInterval(frame_timings_recorder, delegate_.GetFrameBudget()));
   compositor_context_->ui_time().SetLapTime(
       frame_timings_recorder.GetBuildDuration());
 
@@ -539,18 +780,25 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   if (compositor_frame) {
     compositor_context_->raster_cache().PrepareNewFrame();
     frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
+    fml::tracing::FlightRecord(
+        fml::tracing::FlightRecorderEventType::kRasterStart,
+        frame_timings_recorder.GetFrameNumber());
+
+    const bool submit_to_external_view_embedder =
+        external_view_embedder_ &&
+        (!raster_thread_merger_ || raster_thread_merger_->IsMerged() ||
+         external_view_embedder_->SupportsUnmergedSubmission());
 
     // Disable partial repaint if external_view_embedder_ SubmitFrame is
     // involved - ExternalViewEmbedder unconditionally clears the entire
     // surface and also partial repaint with platform view present is something
     // that still need to be figured out.
-    bool disable_partial_repaint =
-        external_view_embedder_ &&
-        (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+    bool disable_partial_repaint = submit_to_external_view_embedder;
 
     FrameDamage damage;
     if (!disable_partial_repaint && frame->framebuffer_info().existing_damage) {
       damage.SetPreviousLayerTree(last_layer_tree_.get());
+      damage.SetTextureRegistry(GetTextureRegistry());
       damage.AddAdditonalDamage(*frame->framebuffer_info().existing_damage);
     }
 
@@ -564,26 +812,67 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     SurfaceFrame::SubmitInfo submit_info;
     submit_info.frame_damage = damage.GetFrameDamage();
     submit_info.buffer_damage = damage.GetBufferDamage();
+    submit_info.frame_damage_rects =
+        damage.GetFrameDamageRects().value_or(std::vector<SkIRect>());
+    submit_info.buffer_damage_rects =
+        damage.GetBufferDamageRects().value_or(std::vector<SkIRect>());
+    submit_info.frame_number = frame_timings_recorder.GetFrameNumber();
 
     frame->set_submit_info(submit_info);
+    fml::tracing::FlightRecord(
+        fml::tracing::FlightRecorderEventType::kRasterSubmit,
+        frame_timings_recorder.GetFrameNumber());
 
-    if (external_view_embedder_ &&
-        (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
+    SurfaceFrame::DeferredPresent deferred_present;
+    const fml::TimePoint submit_start = fml::TimePoint::Now();
+    if (submit_to_external_view_embedder) {
       FML_DCHECK(!frame->IsSubmitted());
       external_view_embedder_->SubmitFrame(surface_->GetContext(),
                                            std::move(frame));
+    } else if (submit_thread_) {
+      deferred_present = frame->SubmitWithoutPresent();
     } else {
       frame->Submit();
     }
+    if (!presented_first_frame_) {
+      presented_first_frame_ = true;
+      StartupTimings::Record(StartupTimings::Phase::kFirstPresent,
+                             submit_start, fml::TimePoint::Now());
+    }
+
+    if (gpu_timing_enabled_) {
+      RecordGpuFrameTimings(frame_timings_recorder);
+    }
+
+    RecordSkiaGpuStatistics(frame_timings_recorder);
 
     compositor_context_->raster_cache().CleanupAfterFrame();
     frame_timings_recorder.RecordRasterEnd(
         &compositor_context_->raster_cache());
+    fml::tracing::FlightRecord(
+        fml::tracing::FlightRecorderEventType::kRasterEnd,
+        frame_timings_recorder.GetFrameNumber());
     FireNextFrameCallbackIfPresent();
 
     if (surface_->GetContext()) {
       TRACE_EVENT0("flutter", "PerformDeferredSkiaCleanup");
-      surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
+      PerformDeferredSkiaCleanup(surface_->GetContext(),
+                                 kSkiaCleanupExpiration);
+    }
+
+    if (deferred_present) {
+      // The render context can only be current on one thread at a time, so
+      // it is handed to the submit thread, which releases it after presenting.
+      surface_->ClearRenderContext();
+      pending_present_ = std::make_shared<fml::AutoResetWaitableEvent>();
+      submit_thread_->GetTaskRunner()->PostTask(
+          [surface = surface_.get(), present = std::move(deferred_present),
+           presented = pending_present_]() {
+            TRACE_EVENT0("flutter", "Rasterizer::Present");
+            present();
+            surface->ClearRenderContext();
+            presented->Signal();
+          });
     }
 
     return raster_status;
@@ -592,7 +881,37 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   return RasterStatus::kFailed;
 }
 
-static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
+void Rasterizer::RecordGpuFrameTimings(
+    FrameTimingsRecorder& frame_timings_recorder) {
+  std::vector<GpuFrameTiming> timings = surface_->TakeGpuFrameTimings();
+  if (timings.empty()) {
+    return;
+  }
+  for (const GpuFrameTiming& timing : timings) {
+    FML_TRACE_COUNTER("flutter", "GPUFrameTime",
+                      reinterpret_cast<int64_t>(this), "GPUMicros",
+                      timing.gpu_duration.ToMicroseconds());
+  }
+  // The frame timing reports the most recent measurement.
+  frame_timings_recorder.RecordGpuDuration(timings.back().frame_number,
+                                           timings.back().gpu_duration);
+}
+
+void Rasterizer::RecordSkiaGpuStatistics(
+    FrameTimingsRecorder& frame_timings_recorder) {
+  const SkiaGpuCounters counters =
+      SkiaGpuStatistics::GetInstance().GetCounters();
+  frame_timings_recorder.RecordSkiaGpuStatistics(
+      counters.shader_compile_count -
+          last_skia_gpu_counters_.shader_compile_count,
+      counters.shader_compile_duration -
+          last_skia_gpu_counters_.shader_compile_duration,
+      counters.resource_cache_purged_bytes -
+          last_skia_gpu_counters_.resource_cache_purged_bytes);
+  last_skia_gpu_counters_ = counters;
+}
+
+static sk_sp<SkPicture> RecordLayerTreeAsPicture(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context) {
   FML_DCHECK(tree != nullptr);
@@ -610,6 +929,28 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
       root_surface_transformation, false, true, nullptr);
   frame->Raster(*tree, true, nullptr);
 
+  return recorder.finishRecordingAsPicture();
+}
+
+static sk_sp<DisplayList> RecordLayerTreeAsDisplayList(
+    flutter::LayerTree* tree,
+    flutter::CompositorContext& compositor_context) {
+  FML_DCHECK(tree != nullptr);
+  auto recorder = sk_make_sp<DisplayListCanvasRecorder>(
+      SkRect::MakeWH(tree->frame_size().width(), tree->frame_size().height()));
+
+  SkMatrix root_surface_transformation;
+  root_surface_transformation.reset();
+
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, recorder.get(), nullptr, root_surface_transformation, false,
+      true, nullptr);
+  frame->Raster(*tree, true, nullptr);
+
+  return recorder->Build();
+}
+
+static sk_sp<SkData> SerializeScreenshotPicture(const SkPicture& picture) {
 #if defined(OS_FUCHSIA)
   SkSerialProcs procs = {0};
   procs.fImageProc = SerializeImageWithoutData;
@@ -619,7 +960,21 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   procs.fTypefaceProc = SerializeTypefaceWithData;
 #endif
 
-  return recorder.finishRecordingAsPicture()->serialize(&procs);
+  return picture.serialize(&procs);
+}
+
+static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
+    flutter::LayerTree* tree,
+    flutter::CompositorContext& compositor_context) {
+  return SerializeScreenshotPicture(
+      *RecordLayerTreeAsPicture(tree, compositor_context));
+}
+
+static sk_sp<SkData> Base64EncodeScreenshot(const SkData& data) {
+  size_t b64_size = SkBase64::Encode(data.data(), data.size(), nullptr);
+  auto b64_data = SkData::MakeUninitialized(b64_size);
+  SkBase64::Encode(data.data(), data.size(), b64_data->writable_data());
+  return b64_data;
 }
 
 static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
@@ -640,11 +995,10 @@ static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
   return SkSurface::MakeRaster(image_info);
 }
 
-sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
+sk_sp<SkImage> Rasterizer::DrawLayerTreeForScreenshot(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context,
-    GrDirectContext* surface_context,
-    bool compressed) {
+    GrDirectContext* surface_context) {
   // Attempt to create a snapshot surface depending on whether we have access to
   // a valid GPU rendering context.
   auto snapshot_surface =
@@ -683,6 +1037,18 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
   auto potentially_gpu_snapshot = snapshot_surface->makeImageSnapshot();
   if (!potentially_gpu_snapshot) {
     FML_LOG(ERROR) << "Screenshot: unable to make image screenshot";
+  }
+  return potentially_gpu_snapshot;
+}
+
+sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
+    flutter::LayerTree* tree,
+    flutter::CompositorContext& compositor_context,
+    GrDirectContext* surface_context,
+    bool compressed) {
+  auto potentially_gpu_snapshot =
+      DrawLayerTreeForScreenshot(tree, compositor_context, surface_context);
+  if (!potentially_gpu_snapshot) {
     return nullptr;
   }
 
@@ -711,6 +1077,7 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
 Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
     Rasterizer::ScreenshotType type,
     bool base64_encode) {
+  WaitForPendingPresent();
   auto* layer_tree = GetLastLayerTree();
   if (layer_tree == nullptr) {
     FML_LOG(ERROR) << "Last layer tree was null when screenshotting.";
@@ -734,6 +1101,10 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
       data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
                                         surface_context, true);
       break;
+    case ScreenshotType::DisplayList:
+      data = SerializeDisplayList(
+          *RecordLayerTreeAsDisplayList(layer_tree, *compositor_context_));
+      break;
   }
 
   if (data == nullptr) {
@@ -742,15 +1113,228 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   }
 
   if (base64_encode) {
-    size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
-    auto b64_data = SkData::MakeUninitialized(b64_size);
-    SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
-    return Rasterizer::Screenshot{b64_data, layer_tree->frame_size()};
+    return Rasterizer::Screenshot{Base64EncodeScreenshot(*data),
+                                  layer_tree->frame_size()};
   }
 
   return Rasterizer::Screenshot{data, layer_tree->frame_size()};
 }
 
+namespace {
+
+// The state of an asynchronous screenshot that is carried from the raster
+// thread to the encode task runner.
+struct AsyncScreenshot {
+  SkISize frame_size;
+  bool compressed = false;
+  bool base64_encode = false;
+  std::shared_ptr<fml::BasicTaskRunner> encode_task_runner;
+  Rasterizer::ScreenshotChunkCallback callback;
+  // Invoked on the raster thread once the pixels were read back.
+  fml::closure on_read_back;
+};
+
+}  // namespace
+
+static void DeliverScreenshot(const AsyncScreenshot& screenshot,
+                              sk_sp<SkData> data) {
+  if (!data || data->isEmpty()) {
+    FML_LOG(ERROR) << "Screenshot data was null.";
+    screenshot.callback({}, true);
+    return;
+  }
+  if (screenshot.base64_encode) {
+    data = Base64EncodeScreenshot(*data);
+  }
+  for (size_t offset = 0; offset < data->size();
+       offset += Rasterizer::kScreenshotChunkSize) {
+    size_t length =
+        std::min(Rasterizer::kScreenshotChunkSize, data->size() - offset);
+    screenshot.callback(
+        Rasterizer::Screenshot{SkData::MakeSubset(data.get(), offset, length),
+                               screenshot.frame_size},
+        offset + length == data->size());
+  }
+}
+
+// Invoked by Skia on the raster thread once the pixels of a screenshot were
+// read back. Only copies the pixels, the encoding happens on the encode task
+// runner.
+static void OnScreenshotPixelsRead(
+    SkImage::ReadPixelsContext context,
+    std::unique_ptr<const SkImage::AsyncReadResult> result) {
+  std::unique_ptr<AsyncScreenshot> screenshot(
+      static_cast<AsyncScreenshot*>(context));
+  screenshot->on_read_back();
+
+  sk_sp<SkData> pixels;
+  const SkImageInfo image_info =
+      SkImageInfo::MakeN32Premul(screenshot->frame_size);
+  if (result && result->count() == 1) {
+    // Pack the rows, the readback may have padded them.
+    const size_t row_bytes = image_info.minRowBytes();
+    pixels = SkData::MakeUninitialized(image_info.computeMinByteSize());
+    auto* dst = static_cast<uint8_t*>(pixels->writable_data());
+    const auto* src = static_cast<const uint8_t*>(result->data(0));
+    for (int y = 0; y < image_info.height(); y++) {
+      memcpy(dst + y * row_bytes, src + y * result->rowBytes(0), row_bytes);
+    }
+  } else {
+    FML_LOG(ERROR) << "Screenshot: unable to read back the pixels";
+  }
+
+  auto encode_task_runner = screenshot->encode_task_runner;
+  encode_task_runner->PostTask(fml::MakeCopyable(
+      [screenshot = std::move(screenshot), pixels = std::move(pixels),
+       image_info]() mutable {
+        TRACE_EVENT0("flutter", "Rasterizer::EncodeScreenshot");
+        if (pixels && screenshot->compressed) {
+          auto image = SkImage::MakeRasterData(image_info, pixels,
+                                               image_info.minRowBytes());
+          pixels = image ? image->encodeToData() : nullptr;
+        }
+        DeliverScreenshot(*screenshot, std::move(pixels));
+      }));
+}
+
+void Rasterizer::ScreenshotLastLayerTreeAsync(
+    Rasterizer::ScreenshotType type,
+    bool base64_encode,
+    std::shared_ptr<fml::BasicTaskRunner> encode_task_runner,
+    ScreenshotChunkCallback callback) {
+  TRACE_EVENT0("flutter", "Rasterizer::ScreenshotLastLayerTreeAsync");
+  FML_DCHECK(encode_task_runner);
+  WaitForPendingPresent();
+  auto* layer_tree = GetLastLayerTree();
+  if (layer_tree == nullptr) {
+    FML_LOG(ERROR) << "Last layer tree was null when screenshotting.";
+    callback({}, true);
+    return;
+  }
+
+  auto screenshot = std::make_unique<AsyncScreenshot>();
+  screenshot->frame_size = layer_tree->frame_size();
+  screenshot->compressed = type == ScreenshotType::CompressedImage;
+  screenshot->base64_encode = base64_encode;
+  screenshot->encode_task_runner = std::move(encode_task_runner);
+  screenshot->callback = std::move(callback);
+  screenshot->on_read_back = [rasterizer = GetWeakPtr()]() {
+    if (rasterizer) {
+      rasterizer->pending_screenshot_readbacks_--;
+    }
+  };
+
+  if (type == ScreenshotType::SkiaPicture) {
+    // Recording the picture is cheap compared to serializing it, so only the
+    // recording happens on the raster thread.
+    sk_sp<SkPicture> picture =
+        RecordLayerTreeAsPicture(layer_tree, *compositor_context_);
+    auto encode_task_runner = screenshot->encode_task_runner;
+    encode_task_runner->PostTask(fml::MakeCopyable(
+        [screenshot = std::move(screenshot),
+         picture = std::move(picture)]() mutable {
+          TRACE_EVENT0("flutter", "Rasterizer::EncodeScreenshot");
+          DeliverScreenshot(*screenshot, SerializeScreenshotPicture(*picture));
+        }));
+    return;
+  }
+
+  if (type == ScreenshotType::DisplayList) {
+    sk_sp<DisplayList> display_list =
+        RecordLayerTreeAsDisplayList(layer_tree, *compositor_context_);
+    auto encode_task_runner = screenshot->encode_task_runner;
+    encode_task_runner->PostTask(fml::MakeCopyable(
+        [screenshot = std::move(screenshot),
+         display_list = std::move(display_list)]() mutable {
+          TRACE_EVENT0("flutter", "Rasterizer::EncodeScreenshot");
+          DeliverScreenshot(*screenshot, SerializeDisplayList(*display_list));
+        }));
+    return;
+  }
+
+  GrDirectContext* surface_context =
+      surface_ ? surface_->GetContext() : nullptr;
+  auto image = DrawLayerTreeForScreenshot(layer_tree, *compositor_context_,
+                                          surface_context);
+  if (!image) {
+    screenshot->callback({}, true);
+    return;
+  }
+
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    FML_LOG(ERROR) << "Screenshot: unable to read back the pixels";
+    screenshot->callback({}, true);
+    return;
+  }
+
+  pending_screenshot_readbacks_++;
+  // The readback of a GPU image completes once the GPU has caught up, the
+  // result is delivered from a later call into the context. A raster image is
+  // read back right away.
+  image->asyncRescaleAndReadPixels(
+      SkImageInfo::MakeN32Premul(screenshot->frame_size),
+      SkIRect::MakeSize(screenshot->frame_size), SkImage::RescaleGamma::kSrc,
+      SkImage::RescaleMode::kNearest, &OnScreenshotPixelsRead,
+      screenshot.release());
+  if (surface_context) {
+    surface_context->flushAndSubmit();
+  }
+  CheckScreenshotReadbacks();
+}
+
+void Rasterizer::CheckScreenshotReadbacks() {
+  if (pending_screenshot_readbacks_ == 0 || !surface_) {
+    return;
+  }
+  if (GrDirectContext* context = surface_->GetContext()) {
+    auto context_switch = surface_->MakeRenderContextCurrent();
+    if (context_switch->GetResult()) {
+      context->checkAsyncWorkCompletion();
+    }
+  }
+  if (pending_screenshot_readbacks_ == 0) {
+    return;
+  }
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [rasterizer = GetWeakPtr()]() {
+        if (rasterizer) {
+          rasterizer->CheckScreenshotReadbacks();
+        }
+      },
+      fml::TimeDelta::FromMilliseconds(4));
+}
+
+void Rasterizer::PrecompileQueuedSkSLs() {
+  if (!PersistentCache::precompile_incrementally() ||
+      sksl_precompilation_scheduled_ || !surface_ ||
+      !PersistentCache::GetCacheForProcess()->HasQueuedSkSLs(
+          surface_->GetContext())) {
+    return;
+  }
+  sksl_precompilation_scheduled_ = true;
+  // The frames posted in the meantime are drawn before the task runs.
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+      [rasterizer = GetWeakPtr()]() {
+        if (!rasterizer) {
+          return;
+        }
+        rasterizer->sksl_precompilation_scheduled_ = false;
+        if (!rasterizer->surface_) {
+          return;
+        }
+        auto context_switch = rasterizer->surface_->MakeRenderContextCurrent();
+        if (!context_switch->GetResult()) {
+          return;
+        }
+        if (PersistentCache::GetCacheForProcess()->PrecompileQueuedSkSLs(
+                rasterizer->surface_->GetContext(),
+                kSkSLPrecompilationBudget)) {
+          rasterizer->PrecompileQueuedSkSLs();
+        }
+      });
+}
+
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
   next_frame_callback_ = callback;
 }
@@ -819,6 +1403,19 @@ std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
   return std::nullopt;
 }
 
+std::optional<size_t> Rasterizer::GetResourceCacheUsage() const {
+  if (!surface_) {
+    return std::nullopt;
+  }
+  GrDirectContext* context = surface_->GetContext();
+  if (context) {
+    size_t bytes;
+    context->getResourceCacheUsage(nullptr, &bytes);
+    return bytes;
+  }
+  return std::nullopt;
+}
+
 Rasterizer::Screenshot::Screenshot() {}
 
 Rasterizer::Screenshot::Screenshot(sk_sp<SkData> p_data, SkISize p_size)
@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/common/graphics/skia_gpu_statistics.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/compositor_context.h"
@@ -20,6 +21,7 @@
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
@@ -238,6 +240,64 @@ class Rasterizer final : public SnapshotDelegate {
       std::shared_ptr<Pipeline<flutter::LayerTree>> pipeline,
       LayerTreeDiscardCallback discard_callback = NoDiscard);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Enables or disables frame skipping. When enabled, `Draw`
+  ///             discards a layer tree whose target time has already passed
+  ///             if a newer layer tree is waiting in the pipeline, and
+  ///             rasterizes the newest one instead. The number of skipped
+  ///             layer trees is recorded in the `FrameTiming` of the frame
+  ///             that is rasterized.
+  ///
+  ///             Under load this drops a late frame to avoid the backlog of
+  ///             rasterizing every queued frame late.
+  ///
+  /// @see        `Settings::enable_raster_frame_skipping`
+  ///
+  /// @param[in]  enabled  Whether stale frames are skipped.
+  ///
+  void SetFrameSkippingEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables or disables presenting frames on a dedicated submit
+  ///             thread. When enabled and the surface can present a frame
+  ///             separately from flushing it, the flushed frame is presented
+  ///             on the submit thread so that the raster thread can move on
+  ///             while the present call blocks, e.g. in `eglSwapBuffers`.
+  ///             The raster thread waits for the pending present before it
+  ///             uses the render context again.
+  ///
+  /// @see        `Settings::enable_submit_thread`
+  ///
+  /// @param[in]  enabled  Whether frames are presented on the submit thread.
+  ///
+  void SetSubmitThreadEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables or disables measuring the GPU time of the frames on
+  ///             surfaces that support it. The measurements complete after
+  ///             the GPU has finished a frame, so the most recent one is
+  ///             reported in the `FrameTiming` of a later frame, along with
+  ///             the number of the frame it belongs to, and each of them is
+  ///             added to the timeline as the `GPUFrameTime` counter.
+  ///
+  /// @see        `Settings::enable_gpu_frame_timing`
+  ///
+  /// @param[in]  enabled  Whether the GPU time of the frames is measured.
+  ///
+  void SetGpuTimingEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the task runner that the surface rasterizes parts of its
+  ///             frames concurrently on, for surfaces that support it. The
+  ///             task runner is kept for the surfaces that are set up later.
+  ///
+  /// @see        `Settings::enable_parallel_software_raster`
+  ///
+  /// @param[in]  task_runner  The task runner to rasterize on, or nullptr to
+  ///                          rasterize on the raster thread only.
+  ///
+  void SetTileTaskRunner(std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
   //----------------------------------------------------------------------------
   /// @brief      The type of the screenshot to obtain of the previously
   ///             rendered layer tree.
@@ -266,6 +326,12 @@ class Rasterizer final : public SnapshotDelegate {
     /// container is used.
     ///
     CompressedImage,
+
+    //--------------------------------------------------------------------------
+    /// A format used to denote a serialized `DisplayList`, which can be
+    /// replayed, such as by the shader warm-up, with `SerializedDisplayList`.
+    ///
+    DisplayList,
   };
 
   //----------------------------------------------------------------------------
@@ -329,6 +395,43 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the chunks in which the data of an asynchronous
+  ///             screenshot is delivered.
+  ///
+  static constexpr size_t kScreenshotChunkSize = 64 * 1024;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Receives the data of an asynchronous screenshot in chunks of
+  ///             at most `kScreenshotChunkSize` bytes. Each chunk carries the
+  ///             frame size of the screenshot and `is_last` is set on the
+  ///             final chunk. A screenshot that could not be captured is
+  ///             reported as a single empty chunk.
+  ///
+  using ScreenshotChunkCallback =
+      std::function<void(const Screenshot& chunk, bool is_last)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Screenshots the last layer tree like
+  ///             `ScreenshotLastLayerTree`, but without blocking the raster
+  ///             thread on the GPU readback or the encoding of the data. Only
+  ///             the layer tree is drawn on the raster thread. The pixels are
+  ///             read back asynchronously, and the PNG and Base 64 encoding
+  ///             happen on the `encode_task_runner`.
+  ///
+  /// @param[in]  type                The type of the screenshot to gather.
+  /// @param[in]  base64_encode       Whether Base 64 encoding must be applied
+  ///                                 to the data.
+  /// @param[in]  encode_task_runner  The task runner that encodes the
+  ///                                 screenshot and invokes the `callback`.
+  /// @param[in]  callback            Receives the chunks of the screenshot.
+  ///
+  void ScreenshotLastLayerTreeAsync(
+      ScreenshotType type,
+      bool base64_encode,
+      std::shared_ptr<fml::BasicTaskRunner> encode_task_runner,
+      ScreenshotChunkCallback callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Sets a callback that will be executed when the next layer tree
   ///             in rendered to the on-screen surface. This is used by
@@ -423,6 +526,16 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of the resources in Skia's resource cache, if a
+  ///             surface is present.
+  ///
+  /// @see        `GetResourceCacheMaxBytes`
+  ///
+  /// @return     The bytes in use by Skia's resource cache, if available.
+  ///
+  std::optional<size_t> GetResourceCacheUsage() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -460,12 +573,30 @@ class Rasterizer final : public SnapshotDelegate {
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
+  // |SnapshotDelegate|
+  std::vector<SkiaGPUObject<SkImage>> MakeGpuSnapshots(
+      const std::vector<std::function<void(SkCanvas*)>>& draw_callbacks,
+      SkISize picture_size) override;
+
+  sk_sp<SkImage> DrawLayerTreeForScreenshot(
+      flutter::LayerTree* tree,
+      flutter::CompositorContext& compositor_context,
+      GrDirectContext* surface_context);
+
   sk_sp<SkData> ScreenshotLayerTreeAsImage(
       flutter::LayerTree* tree,
       flutter::CompositorContext& compositor_context,
       GrDirectContext* surface_context,
       bool compressed);
 
+  // Drives the completion of the asynchronous screenshot readbacks while
+  // there are any, even if no frames are drawn in the meantime.
+  void CheckScreenshotReadbacks();
+
+  // Precompiles the SkSLs queued for the context of the surface a few at a
+  // time, in tasks that yield to the frames, while there are any.
+  void PrecompileQueuedSkSLs();
+
   sk_sp<SkImage> DoMakeRasterSnapshot(
       SkISize size,
       std::function<void(SkCanvas*)> draw_callback);
@@ -482,6 +613,18 @@ class Rasterizer final : public SnapshotDelegate {
 
   void FireNextFrameCallbackIfPresent();
 
+  // Traces the GPU times that the surface measured since the last frame and
+  // records the most recent one into the timings of the current frame.
+  void RecordGpuFrameTimings(FrameTimingsRecorder& frame_timings_recorder);
+
+  // Records the shader compilations and the resource cache purges since the
+  // last frame into the timings of the current frame.
+  void RecordSkiaGpuStatistics(FrameTimingsRecorder& frame_timings_recorder);
+
+  // Waits for the frame being presented on the submit thread, if any, and
+  // makes the render context current on the raster thread again.
+  void WaitForPendingPresent() const;
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
 
   Delegate& delegate_;
@@ -496,9 +639,23 @@ class Rasterizer final : public SnapshotDelegate {
   std::unique_ptr<flutter::LayerTree> resubmitted_layer_tree_;
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
+  bool frame_skipping_enabled_ = false;
+  bool gpu_timing_enabled_ = false;
+  SkiaGpuCounters last_skia_gpu_counters_;
+  bool presented_first_frame_ = false;
+  std::shared_ptr<fml::BasicTaskRunner> tile_task_runner_;
   std::optional<size_t> max_cache_bytes_;
+  size_t pending_screenshot_readbacks_ = 0;
+  bool sksl_precompilation_scheduled_ = false;
+  // Releases the GPU snapshots, whose textures belong to the onscreen
+  // context, on the raster thread.
+  fml::RefPtr<SkiaUnrefQueue> snapshot_unref_queue_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
+  // Presents frames while the raster thread works on the next one. Declared
+  // after |surface_| so that it is joined before the surface is destroyed.
+  std::unique_ptr<fml::Thread> submit_thread_;
+  mutable std::shared_ptr<fml::AutoResetWaitableEvent> pending_present_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
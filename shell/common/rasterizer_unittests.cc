@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
@@ -46,6 +47,10 @@ class MockSurface : public Surface {
   MOCK_METHOD0(MakeRenderContextCurrent, std::unique_ptr<GLContextResult>());
   MOCK_METHOD0(ClearRenderContext, bool());
   MOCK_CONST_METHOD0(AllowsDrawingWhenGpuDisabled, bool());
+  MOCK_METHOD1(SetGpuTimingEnabled, void(bool enabled));
+  MOCK_METHOD0(TakeGpuFrameTimings, std::vector<GpuFrameTiming>());
+  MOCK_METHOD1(SetTileTaskRunner,
+               void(std::shared_ptr<fml::BasicTaskRunner> task_runner));
 };
 
 class MockExternalViewEmbedder : public ExternalViewEmbedder {
@@ -71,6 +76,7 @@ class MockExternalViewEmbedder : public ExternalViewEmbedder {
                void(bool should_resubmit_frame,
                     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger));
   MOCK_METHOD0(SupportsDynamicThreadMerging, bool());
+  MOCK_METHOD0(SupportsUnmergedSubmission, bool());
 };
 }  // namespace
 
@@ -116,6 +122,32 @@ TEST(RasterizerTest, drawEmptyPipeline) {
   latch.Wait();
 }
 
+TEST(RasterizerTest, setupForwardsTileTaskRunnerToSurface) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  std::shared_ptr<fml::BasicTaskRunner> tile_task_runner =
+      loop->GetTaskRunner();
+  rasterizer->SetTileTaskRunner(tile_task_runner);
+
+  auto surface = std::make_unique<MockSurface>();
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+  EXPECT_CALL(*surface, SetTileTaskRunner(tile_task_runner));
+  rasterizer->Setup(std::move(surface));
+  loop->Terminate();
+}
+
 TEST(RasterizerTest,
      drawWithExternalViewEmbedderExternalViewEmbedderSubmitFrameCalled) {
   std::string test_name =
@@ -238,6 +270,68 @@ TEST(
   latch.Wait();
 }
 
+TEST(
+    RasterizerTest,
+    drawWithExternalViewEmbedderSupportingUnmergedSubmissionSubmitFrameCalled) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*external_view_embedder, SupportsUnmergedSubmission)
+      .WillRepeatedly(Return(true));
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, framebuffer_info,
+      /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) { return true; });
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(true));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  EXPECT_CALL(*external_view_embedder,
+              BeginFrame(/*frame_size=*/SkISize(), /*context=*/nullptr,
+                         /*device_pixel_ratio=*/2.0,
+                         /*raster_thread_merger=*/_))
+      .Times(1);
+  // The threads aren't merged, but the embedder still gets the frame.
+  EXPECT_CALL(*external_view_embedder, SubmitFrame).Times(1);
+  EXPECT_CALL(*external_view_embedder, EndFrame(/*should_resubmit_frame=*/false,
+                                                /*raster_thread_merger=*/_))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<Pipeline<LayerTree>>(/*depth=*/10);
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    rasterizer->Draw(CreateFinishedBuildRecorder(), pipeline, no_discard);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST(
     RasterizerTest,
     drawWithExternalViewEmbedderAndThreadsMergedExternalViewEmbedderSubmitFrameCalled) {
@@ -542,4 +636,209 @@ TEST(
   latch.Wait();
 }
 
+TEST(RasterizerTest, drawSkipsStaleFrameWhenNewerFrameIsQueued) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  uint64_t skipped_frame_count = 0;
+  EXPECT_CALL(delegate, OnFrameRasterized(_))
+      .WillOnce([&](const FrameTiming& frame_timing) {
+        skipped_frame_count = frame_timing.GetSkippedFrameCount();
+      });
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  rasterizer->SetFrameSkippingEnabled(true);
+  auto surface = std::make_unique<MockSurface>();
+  auto is_gpu_disabled_sync_switch =
+      std::make_shared<const fml::SyncSwitch>(false);
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*framebuffer_info=*/framebuffer_info,
+      /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) { return true; });
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(false));
+  EXPECT_CALL(delegate, GetIsGpuDisabledSyncSwitch())
+      .WillOnce(Return(is_gpu_disabled_sync_switch));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<Pipeline<LayerTree>>(/*depth=*/10);
+    for (int i = 0; i < 2; i++) {
+      auto layer_tree =
+          std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                      /*device_pixel_ratio=*/2.0f);
+      bool result = pipeline->Produce().Complete(std::move(layer_tree));
+      EXPECT_TRUE(result);
+    }
+    auto no_discard = [](LayerTree&) { return false; };
+    // The target time of the recorder has passed by the time it is drawn.
+    RasterStatus status =
+        rasterizer->Draw(CreateFinishedBuildRecorder(), pipeline, no_discard);
+    EXPECT_EQ(status, RasterStatus::kSuccess);
+    EXPECT_EQ(pipeline->GetQueueSize(), 0u);
+    latch.Signal();
+  });
+  latch.Wait();
+  EXPECT_EQ(skipped_frame_count, 1u);
+}
+
+
+TEST(RasterizerTest, drawReportsGpuFrameTimingOfEarlierFrame) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  FrameTiming reported_timing;
+  EXPECT_CALL(delegate, OnFrameRasterized(_))
+      .WillOnce([&](const FrameTiming& frame_timing) {
+        reported_timing = frame_timing;
+      });
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  rasterizer->SetGpuTimingEnabled(true);
+  auto surface = std::make_unique<MockSurface>();
+  auto is_gpu_disabled_sync_switch =
+      std::make_shared<const fml::SyncSwitch>(false);
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+
+  std::unique_ptr<FrameTimingsRecorder> recorder =
+      CreateFinishedBuildRecorder();
+  const uint64_t frame_number = recorder->GetFrameNumber();
+  uint64_t submitted_frame_number = 0;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*framebuffer_info=*/framebuffer_info,
+      /*submit_callback=*/[&](const SurfaceFrame& frame, SkCanvas*) {
+        submitted_frame_number = frame.submit_info().frame_number;
+        return true;
+      });
+  EXPECT_CALL(*surface, SetGpuTimingEnabled(true));
+  EXPECT_CALL(*surface, TakeGpuFrameTimings())
+      .WillOnce(Return(std::vector<GpuFrameTiming>{
+          {frame_number - 2, fml::TimeDelta::FromMicroseconds(3000)},
+          {frame_number - 1, fml::TimeDelta::FromMicroseconds(2000)}}));
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(false));
+  EXPECT_CALL(delegate, GetIsGpuDisabledSyncSwitch())
+      .WillOnce(Return(is_gpu_disabled_sync_switch));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<Pipeline<LayerTree>>(/*depth=*/10);
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    RasterStatus status =
+        rasterizer->Draw(std::move(recorder), pipeline, no_discard);
+    EXPECT_EQ(status, RasterStatus::kSuccess);
+    latch.Signal();
+  });
+  latch.Wait();
+  EXPECT_EQ(submitted_frame_number, frame_number);
+  EXPECT_EQ(reported_timing.GetGpuFrameNumber(), frame_number - 1);
+  EXPECT_EQ(reported_timing.GetGpuDuration(),
+            fml::TimeDelta::FromMicroseconds(2000));
+}
+
+TEST(RasterizerTest, drawPresentsFrameOnSubmitThread) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  rasterizer->SetSubmitThreadEnabled(true);
+  auto surface = std::make_unique<MockSurface>();
+  auto is_gpu_disabled_sync_switch =
+      std::make_shared<const fml::SyncSwitch>(false);
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+
+  bool submitted_on_raster_thread = false;
+  bool presented_on_raster_thread = true;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*framebuffer_info=*/framebuffer_info,
+      /*submit_callback=*/[&](const SurfaceFrame&, SkCanvas*) {
+        submitted_on_raster_thread =
+            task_runners.GetRasterTaskRunner()->RunsTasksOnCurrentThread();
+        return true;
+      });
+  surface_frame->set_present_callback([&](const SurfaceFrame::SubmitInfo&) {
+    presented_on_raster_thread =
+        task_runners.GetRasterTaskRunner()->RunsTasksOnCurrentThread();
+    return true;
+  });
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(false));
+  EXPECT_CALL(delegate, GetIsGpuDisabledSyncSwitch())
+      .WillOnce(Return(is_gpu_disabled_sync_switch));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  // The context is made current for the frame and again once the submit
+  // thread released it.
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))))
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+  EXPECT_CALL(*surface, ClearRenderContext())
+      .Times(2)
+      .WillRepeatedly(Return(true));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<Pipeline<LayerTree>>(/*depth=*/10);
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    RasterStatus status =
+        rasterizer->Draw(CreateFinishedBuildRecorder(), pipeline, no_discard);
+    EXPECT_EQ(status, RasterStatus::kSuccess);
+    // Disabling the submit thread waits for the frame to be presented.
+    rasterizer->SetSubmitThreadEnabled(false);
+    latch.Signal();
+  });
+  latch.Wait();
+  EXPECT_TRUE(submitted_on_raster_thread);
+  EXPECT_FALSE(presented_on_raster_thread);
+}
+
 }  // namespace flutter
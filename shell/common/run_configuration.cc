@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
@@ -24,10 +25,18 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
-  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+  fml::UniqueFD assets_directory = fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead);
+  // Assets that are packed into a single file are found before the loose
+  // files of the bundle.
+  if (assets_directory.is_valid() &&
+      fml::FileExists(assets_directory, PackedAssetBundle::kFileName)) {
+    asset_manager->PushBack(std::make_unique<PackedAssetBundle>(
+        fml::OpenFileReadOnly(assets_directory, PackedAssetBundle::kFileName),
+        true));
+  }
+  asset_manager->PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(assets_directory), true));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shader_warm_up.h"
+
+#include <algorithm>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/display_list_canvas.h"
+#include "flutter/flow/display_list_serialization.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+static constexpr int kWarmUpSurfaceSize = 256;
+
+size_t WarmUpShadersWithDisplayLists(
+    GrDirectContext* context,
+    std::vector<std::unique_ptr<fml::Mapping>> display_lists) {
+  TRACE_EVENT0("flutter", "WarmUpShadersWithDisplayLists");
+  if (context == nullptr || display_lists.empty()) {
+    return 0;
+  }
+
+  sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(
+      context, SkBudgeted::kNo,
+      SkImageInfo::MakeN32Premul(kWarmUpSurfaceSize, kWarmUpSurfaceSize));
+  if (surface == nullptr) {
+    FML_LOG(ERROR) << "Could not create the shader warm-up surface.";
+    return 0;
+  }
+
+  // The count is shared by the contexts, so it includes the programs built by
+  // the frames drawn in the meantime.
+  PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
+  const size_t built_program_count = persistent_cache->GetBuiltProgramCount();
+
+  SkCanvas* canvas = surface->getCanvas();
+  size_t replayed_count = 0;
+  for (auto& mapping : display_lists) {
+    auto display_list = SerializedDisplayList::Make(std::move(mapping));
+    if (!display_list) {
+      FML_LOG(ERROR) << "Could not read a display list for the shader warm-up.";
+      continue;
+    }
+    TRACE_EVENT0("flutter", "WarmUpDisplayList");
+    // The draws outside of the surface would be culled.
+    const SkRect& bounds = display_list->bounds();
+    canvas->save();
+    if (!bounds.isEmpty()) {
+      const SkScalar scale =
+          std::min({SK_Scalar1, kWarmUpSurfaceSize / bounds.width(),
+                    kWarmUpSurfaceSize / bounds.height()});
+      canvas->scale(scale, scale);
+      canvas->translate(-bounds.left(), -bounds.top());
+    }
+    {
+      // Each display list starts with the default attributes. The dispatcher
+      // draws its pending operations when it is destroyed.
+      DisplayListCanvasDispatcher dispatcher(canvas);
+      display_list->Dispatch(dispatcher);
+    }
+    canvas->restoreToCount(1);
+    // Skia builds the programs when the draws are flushed.
+    context->flushAndSubmit();
+    replayed_count++;
+  }
+
+  const size_t built_count =
+      persistent_cache->GetBuiltProgramCount() - built_program_count;
+  FML_LOG(INFO) << "Shader warm-up replayed " << replayed_count
+                << " display lists, which built " << built_count
+                << " programs.";
+  return built_count;
+}
+
+}  // namespace flutter
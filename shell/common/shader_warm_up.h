@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SHADER_WARM_UP_H_
+#define FLUTTER_SHELL_COMMON_SHADER_WARM_UP_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Replays serialized display lists, such as the frames dumped
+///             with `--dump-skp-on-shader-compilation`, onto a small offscreen
+///             surface of the context, so that Skia builds the programs they
+///             draw with, and stores their shaders in the persistent cache,
+///             before the frames need them.
+///
+///             The frames are scaled down to fit the surface, which only
+///             rarely changes the programs they need.
+///
+/// @param[in]  context        The context to draw the display lists with,
+///                            usually the resource context of the IO thread.
+/// @param[in]  display_lists  The serialized display lists.
+///
+/// @return     The number of programs that Skia built meanwhile.
+///
+size_t WarmUpShadersWithDisplayLists(
+    GrDirectContext* context,
+    std::vector<std::unique_ptr<fml::Mapping>> display_lists);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SHADER_WARM_UP_H_
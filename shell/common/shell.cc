@@ -5,30 +5,46 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/common/graphics/skia_gpu_statistics.h"
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/layer_profiler.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/memory/memory_accounting.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/lock_contention.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/snapshot_prefetch_profile.h"
+#include "flutter/runtime/startup_timings.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/shader_warm_up.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/third_party/txt/src/minikin/Layout.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
@@ -39,6 +55,9 @@ constexpr char kSkiaChannel[] = "flutter/skia";
 constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
+// The duration of the flight record that is kept when a frame misses a vsync,
+// which is also reported by default by `_flutter.getFlightRecord`.
+constexpr fml::TimeDelta kFlightRecordDuration = fml::TimeDelta::FromSeconds(3);
 
 namespace {
 
@@ -119,6 +138,48 @@ void PerformInitializationTasks(Settings& settings) {
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  PersistentCache::SetPrecompileIncrementally(
+      settings.precompile_sksls_incrementally);
+  minikin::Layout::setCacheMaxBytes(settings.text_layout_cache_max_bytes);
+}
+
+// Hands the message to the handler, recording how long it took if there are
+// platform channel statistics.
+template <typename Handler>
+void HandlePlatformMessageTimed(PlatformMessageStatistics* statistics,
+                                std::unique_ptr<PlatformMessage> message,
+                                const Handler& handler) {
+  if (!statistics) {
+    handler(std::move(message));
+    return;
+  }
+  std::string channel = message->channel();
+  const fml::TimePoint start = fml::TimePoint::Now();
+  handler(std::move(message));
+  statistics->RecordHandlerTime(channel, fml::TimePoint::Now() - start);
+}
+
+// Advises the system to read the pages of a loading unit's snapshot ahead of
+// their first access. The size of the snapshots found through symbols isn't
+// known, so their pages are prefetched in chunks until the end of the mapped
+// memory of their library, up to a limit.
+void PrefetchLoadingUnitPages(const fml::Mapping& mapping) {
+  constexpr size_t kUnknownSizeChunk = 1 << 20;
+  constexpr size_t kUnknownSizeLimit = 64 << 20;
+  const uint8_t* address = mapping.GetMapping();
+  if (address == nullptr) {
+    return;
+  }
+  if (mapping.GetSize() > 0) {
+    fml::PrefetchMappingPages(address, mapping.GetSize());
+    return;
+  }
+  for (size_t offset = 0; offset < kUnknownSizeLimit;
+       offset += kUnknownSizeChunk) {
+    if (!fml::PrefetchMappingPages(address + offset, kUnknownSizeChunk)) {
+      break;
+    }
+  }
 }
 
 }  // namespace
@@ -130,6 +191,8 @@ std::unique_ptr<Shell> Shell::Create(
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
     bool is_gpu_disabled) {
+  StartupTimings::ScopedPhase phase(StartupTimings::Phase::kShellCreation);
+
   // This must come first as it initializes tracing.
   PerformInitializationTasks(settings);
 
@@ -151,6 +214,7 @@ std::unique_ptr<Shell> Shell::Create(
   return CreateWithSnapshot(std::move(platform_data),            //
                             std::move(task_runners),             //
                             /*parent_merger=*/nullptr,           //
+                            /*parent_io_manager=*/nullptr,       //
                             std::move(settings),                 //
                             std::move(vm),                       //
                             std::move(isolate_snapshot),         //
@@ -162,6 +226,7 @@ std::unique_ptr<Shell> Shell::Create(
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     DartVMRef vm,
     fml::RefPtr<fml::RasterThreadMerger> parent_merger,
+    std::shared_ptr<ShellIOManager> parent_io_manager,
     TaskRunners task_runners,
     const PlatformData& platform_data,
     Settings settings,
@@ -182,6 +247,17 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
 
+  // The default font manager is set up on the UI thread once the engine has
+  // been created. It is a singleton owned by Skia, whose initialization
+  // doesn't depend on any of the subsystems, so it is started on a worker
+  // while they are being set up.
+  if (!settings.prefetched_default_font_manager) {
+    shell->GetDartVM()->GetConcurrentWorkerTaskRunner()->PostTask([]() {
+      TRACE_EVENT0("flutter", "ShellPrefetchDefaultFontManager");
+      SkFontMgr::RefDefault();
+    });
+  }
+
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
   auto rasterizer_future = rasterizer_promise.get_future();
@@ -200,23 +276,31 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
       });
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
-  if (!platform_view || !platform_view->GetWeakPtr()) {
-    return nullptr;
-  }
+  std::unique_ptr<PlatformView> platform_view;
+  std::unique_ptr<VsyncWaiter> vsync_waiter;
+  {
+    TRACE_EVENT0("flutter", "ShellSetupPlatformSubsystem");
+    platform_view = on_create_platform_view(*shell.get());
+    if (!platform_view || !platform_view->GetWeakPtr()) {
+      return nullptr;
+    }
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
-    return nullptr;
+    // Ask the platform view for the vsync waiter. This will be used by the
+    // engine to create the animator.
+    vsync_waiter = platform_view->CreateVSyncWaiter();
+    if (!vsync_waiter) {
+      return nullptr;
+    }
   }
 
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
   // first be booted and the necessary references obtained to initialize the
   // other subsystems.
-  std::promise<std::unique_ptr<ShellIOManager>> io_manager_promise;
+  //
+  // Spawned shells use the IO manager of their spawner instead, so that they
+  // don't set up a resource context and unref queue of their own.
+  std::promise<std::shared_ptr<ShellIOManager>> io_manager_promise;
   auto io_manager_future = io_manager_promise.get_future();
   std::promise<fml::WeakPtr<ShellIOManager>> weak_io_manager_promise;
   auto weak_io_manager_future = weak_io_manager_promise.get_future();
@@ -230,27 +314,38 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // constructed on the platform thread.
   //
   // https://github.com/flutter/flutter/issues/42948
-  fml::TaskRunner::RunNowOrPostTask(
-      io_task_runner,
-      [&io_manager_promise,                                               //
-       &weak_io_manager_promise,                                          //
-       &unref_queue_promise,                                              //
-       platform_view = platform_view->GetWeakPtr(),                       //
-       io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
-  ]() {
-        TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
-        auto io_manager = std::make_unique<ShellIOManager>(
-            platform_view.getUnsafe()->CreateResourceContext(),
-            is_backgrounded_sync_switch, io_task_runner);
-        weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
-        unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
-        io_manager_promise.set_value(std::move(io_manager));
-      });
+  if (parent_io_manager) {
+    weak_io_manager_promise.set_value(parent_io_manager->GetWeakPtr());
+    unref_queue_promise.set_value(parent_io_manager->GetSkiaUnrefQueue());
+    io_manager_promise.set_value(std::move(parent_io_manager));
+  } else {
+    fml::TaskRunner::RunNowOrPostTask(
+        io_task_runner,
+        [&io_manager_promise,                                               //
+         &weak_io_manager_promise,                                          //
+         &unref_queue_promise,                                              //
+         platform_view = platform_view->GetWeakPtr(),                       //
+         io_task_runner,                                                    //
+         is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+    ]() {
+          TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+          auto io_manager = std::make_shared<ShellIOManager>(
+              platform_view.getUnsafe()->CreateResourceContext(),
+              is_backgrounded_sync_switch, io_task_runner);
+          weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
+          unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
+          io_manager_promise.set_value(std::move(io_manager));
+        });
+  }
 
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (shell->GetSettings().enable_pointer_resampling) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(delegate);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -274,6 +369,15 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
+        if (shell->GetSettings().enable_adaptive_pipeline_depth) {
+          animator->EnableAdaptivePipelineDepth();
+        }
+        animator->SetFramePacingPolicy(
+            shell->GetSettings().frame_pacing_policy);
+        // Displays reported while the shell was being created have not been
+        // forwarded to the vsync waiter yet.
+        animator->OnDisplayRefreshRateChanged(
+            shell->GetMainDisplayRefreshRate());
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -290,10 +394,22 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                              shell->volatile_path_tracker_));
       }));
 
+  // The subsystems are set up concurrently on their threads, and the time this
+  // thread then spends waiting for them is traced on its own.
+  std::unique_ptr<Engine> engine;
+  std::unique_ptr<Rasterizer> rasterizer;
+  std::shared_ptr<ShellIOManager> io_manager;
+  {
+    TRACE_EVENT0("flutter", "ShellWaitForSubsystems");
+    engine = engine_future.get();
+    rasterizer = rasterizer_future.get();
+    io_manager = io_manager_future.get();
+  }
+
   if (!shell->Setup(std::move(platform_view),  //
-                    engine_future.get(),       //
-                    rasterizer_future.get(),   //
-                    io_manager_future.get())   //
+                    std::move(engine),         //
+                    std::move(rasterizer),     //
+                    std::move(io_manager))     //
   ) {
     return nullptr;
   }
@@ -305,6 +421,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
     const PlatformData& platform_data,
     TaskRunners task_runners,
     fml::RefPtr<fml::RasterThreadMerger> parent_thread_merger,
+    std::shared_ptr<ShellIOManager> parent_io_manager,
     Settings settings,
     DartVMRef vm,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -331,6 +448,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
           [&latch,                                                        //
            &shell,                                                        //
            parent_thread_merger,                                          //
+           parent_io_manager = std::move(parent_io_manager),              //
            task_runners = std::move(task_runners),                        //
            platform_data = std::move(platform_data),                      //
            settings = std::move(settings),                                //
@@ -343,6 +461,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
             shell = CreateShellOnPlatformThread(
                 std::move(vm),                       //
                 parent_thread_merger,                //
+                std::move(parent_io_manager),        //
                 std::move(task_runners),             //
                 std::move(platform_data),            //
                 std::move(settings),                 //
@@ -356,6 +475,68 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
   return shell;
 }
 
+class Shell::DeferredLibraryPrefetches {
+ public:
+  struct LoadingUnit {
+    std::unique_ptr<const fml::Mapping> snapshot_data;
+    std::unique_ptr<const fml::Mapping> snapshot_instructions;
+  };
+
+  // Returns false if the loading unit is already being prefetched or waiting
+  // to be requested.
+  bool Start(intptr_t loading_unit_id) {
+    std::scoped_lock lock(mutex_);
+    return prefetches_.emplace(loading_unit_id, Prefetch{}).second;
+  }
+
+  // Keeps the prefetched loading unit until it is requested, or returns it if
+  // it has been requested while it was being prefetched.
+  std::optional<LoadingUnit> Finish(intptr_t loading_unit_id,
+                                    LoadingUnit loading_unit) {
+    std::scoped_lock lock(mutex_);
+    auto found = prefetches_.find(loading_unit_id);
+    if (found == prefetches_.end()) {
+      return std::nullopt;
+    }
+    if (found->second.requested) {
+      prefetches_.erase(found);
+      return loading_unit;
+    }
+    found->second.loading_unit = std::move(loading_unit);
+    found->second.finished = true;
+    return std::nullopt;
+  }
+
+  // Returns true if the loading unit has been prefetched, in which case it is
+  // moved to |loading_unit|, or is being prefetched, in which case |Finish|
+  // returns it.
+  bool Request(intptr_t loading_unit_id,
+               std::optional<LoadingUnit>* loading_unit) {
+    std::scoped_lock lock(mutex_);
+    auto found = prefetches_.find(loading_unit_id);
+    if (found == prefetches_.end()) {
+      return false;
+    }
+    if (!found->second.finished) {
+      found->second.requested = true;
+      return true;
+    }
+    *loading_unit = std::move(found->second.loading_unit);
+    prefetches_.erase(found);
+    return true;
+  }
+
+ private:
+  struct Prefetch {
+    LoadingUnit loading_unit;
+    bool finished = false;
+    bool requested = false;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<intptr_t, Prefetch> prefetches_;
+};
+
 Shell::Shell(DartVMRef vm,
              TaskRunners task_runners,
              fml::RefPtr<fml::RasterThreadMerger> parent_merger,
@@ -368,6 +549,12 @@ Shell::Shell(DartVMRef vm,
       vm_(std::move(vm)),
       is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
+      platform_message_statistics_(
+          settings_.enable_platform_channel_statistics
+              ? std::make_shared<PlatformMessageStatistics>()
+              : nullptr),
+      low_memory_freed_bytes_(
+          std::make_shared<std::map<std::string, int64_t>>()),
       weak_factory_gpu_(nullptr),
       weak_factory_(this) {
   FML_CHECK(vm_) << "Must have access to VM to create a shell.";
@@ -375,6 +562,7 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
   display_manager_ = std::make_unique<DisplayManager>();
+  deferred_library_prefetches_ = std::make_shared<DeferredLibraryPrefetches>();
 
   // Generate a WeakPtrFactory for use with the raster thread. This does not
   // need to wait on a latch because it can only ever be used from the raster
@@ -423,6 +611,39 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetRasterCacheEntriesExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetRasterCacheEntries, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetLockContentionExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetLockContention, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetPlatformChannelStatisticsExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetPlatformChannelStatistics,
+                    this, std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetEngineMemoryUsageExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetEngineMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetFlightRecordExtensionName] =
+      {task_runners_.GetRasterTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetFlightRecord, this,
+                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingStatisticsExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetLayerProfileExtensionName] =
+      {task_runners_.GetRasterTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetLayerProfile, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -456,8 +677,11 @@ Shell::~Shell() {
       fml::MakeCopyable([io_manager = std::move(io_manager_),
                          platform_view = platform_view_.get(),
                          &io_latch]() mutable {
+        // The resource context is only released by the last of the shells
+        // that share the IO manager.
+        const bool is_last_io_manager_owner = io_manager.use_count() == 1;
         io_manager.reset();
-        if (platform_view) {
+        if (platform_view && is_last_io_manager_owner) {
           platform_view->ReleaseResourceContext();
         }
         io_latch.Signal();
@@ -484,10 +708,34 @@ std::unique_ptr<Shell> Shell::Spawn(
     const CreateCallback<PlatformView>& on_create_platform_view,
     const CreateCallback<Rasterizer>& on_create_rasterizer) const {
   FML_DCHECK(task_runners_.IsValid());
+  // The spawned engine runs with the asset manager of this engine rather than
+  // the one of the run configuration, which resolves the same assets. Its fonts
+  // are already registered with the font collection the engines share, and its
+  // resolvers aren't duplicated.
+  std::shared_ptr<AssetManager> asset_manager;
+  fml::AutoResetWaitableEvent asset_manager_latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, &asset_manager, &asset_manager_latch]() {
+        if (engine) {
+          asset_manager = engine->GetAssetManager();
+        }
+        asset_manager_latch.Signal();
+      });
+  asset_manager_latch.Wait();
+  if (!asset_manager) {
+    asset_manager = run_configuration.GetAssetManager();
+  }
+  RunConfiguration spawn_configuration(
+      run_configuration.TakeIsolateConfiguration(), std::move(asset_manager));
+  spawn_configuration.SetEntrypointAndLibrary(
+      run_configuration.GetEntrypoint(),
+      run_configuration.GetEntrypointLibrary());
+
   auto shell_maker = [&](bool is_gpu_disabled) {
     std::unique_ptr<Shell> result(CreateWithSnapshot(
         PlatformData{}, task_runners_, rasterizer_->GetRasterThreadMerger(),
-        GetSettings(), vm_, vm_->GetVMData()->GetIsolateSnapshot(),
+        io_manager_, GetSettings(), vm_, vm_->GetVMData()->GetIsolateSnapshot(),
         on_create_platform_view, on_create_rasterizer,
         [engine = this->engine_.get(), initial_route](
             Engine::Delegate& delegate,
@@ -514,30 +762,162 @@ std::unique_ptr<Shell> Shell::Spawn(
           .SetIfFalse([&] { result = shell_maker(false); })
           .SetIfTrue([&] { result = shell_maker(true); }));
   result->shared_resource_context_ = io_manager_->GetSharedResourceContext();
-  result->RunEngine(std::move(run_configuration));
+  if (decoded_image_cache_) {
+    result->SetDecodedImageCache(decoded_image_cache_);
+  }
+  if (settings_.enable_shared_raster_cache) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [parent = rasterizer_->GetWeakPtr(),
+         child = result->rasterizer_->GetWeakPtr()]() {
+          if (parent && child) {
+            child->compositor_context()->ShareRasterCache(
+                *parent->compositor_context());
+          }
+        });
+  }
+  result->RunEngine(std::move(spawn_configuration));
   return result;
 }
 
+// The native memory of the engine by subsystem, whose counts can be read on
+// any thread.
+static std::map<std::string, int64_t> SampleNativeMemoryUsage() {
+  std::map<std::string, int64_t> usage;
+  for (size_t i = 0; i < fml::kMemoryCategoryCount; i++) {
+    const auto category = static_cast<fml::MemoryCategory>(i);
+    usage[fml::MemoryAccounting::GetName(category)] =
+        fml::MemoryAccounting::GetBytes(category);
+  }
+  usage["displayListStoragePool"] =
+      DisplayListStoragePool::Instance().pooled_bytes();
+  return usage;
+}
+
 void Shell::NotifyLowMemoryWarning() const {
   auto trace_id = fml::tracing::TraceNonce();
   TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
                            trace_id);
+  auto usage_before = SampleNativeMemoryUsage();
   // This does not require a current isolate but does require a running VM.
   // Since a valid shell will not be returned to the embedder without a valid
   // DartVMRef, we can be certain that this is a safe spot to assume a VM is
   // running.
   ::Dart_NotifyLowMemory();
 
+  // Recycled DisplayList storage is only an optimization for the next
+  // frames and can be released immediately.
+  DisplayListStoragePool::Instance().Clear();
+
+  // The images are released on the IO thread through the unref queues they
+  // were created with.
+  if (decoded_image_cache_) {
+    decoded_image_cache_->Clear();
+  }
+
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
+      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id,
+       usage_before = std::move(usage_before),
+       freed_bytes = low_memory_freed_bytes_]() {
+        int64_t skia_bytes_before = 0;
         if (rasterizer) {
+          skia_bytes_before = rasterizer->GetResourceCacheUsage().value_or(0);
           rasterizer->NotifyLowMemoryWarning();
         }
+        // The images that are released on the IO thread or collected by the
+        // Dart VM later are not counted.
+        auto usage_after = SampleNativeMemoryUsage();
+        freed_bytes->clear();
+        for (const auto& [name, bytes] : usage_before) {
+          (*freed_bytes)[name] = bytes - usage_after[name];
+        }
+        if (rasterizer) {
+          (*freed_bytes)["skiaResourceCache"] =
+              skia_bytes_before -
+              static_cast<int64_t>(
+                  rasterizer->GetResourceCacheUsage().value_or(0));
+        }
         TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
                                trace_id);
       });
   // The IO Manager uses resource cache limits of 0, so it is not necessary
   // to purge them.
+
+  // This may be called on any thread through the embedder API.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetPlatformTaskRunner(),
+      [shell = weak_factory_.GetWeakPtr()] {
+        if (shell) {
+          shell->OnMemoryPressure();
+        }
+      });
+}
+
+void Shell::OnMemoryPressure() {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  memory_budget_.OnMemoryPressure(fml::TimePoint::Now());
+  ApplyMemoryBudget();
+  ScheduleMemoryBudgetRecovery();
+}
+
+void Shell::ScheduleMemoryBudgetRecovery() {
+  if (memory_budget_recovery_pending_ || !memory_budget_.under_pressure()) {
+    return;
+  }
+  memory_budget_recovery_pending_ = true;
+  task_runners_.GetPlatformTaskRunner()->PostDelayedTask(
+      [shell = weak_factory_.GetWeakPtr()] {
+        if (!shell) {
+          return;
+        }
+        shell->memory_budget_recovery_pending_ = false;
+        if (shell->memory_budget_.Recover(fml::TimePoint::Now())) {
+          shell->ApplyMemoryBudget();
+        }
+        shell->ScheduleMemoryBudgetRecovery();
+      },
+      MemoryBudget::kRecoveryDelay);
+}
+
+void Shell::ApplyMemoryBudget() {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  if (resource_cache_base_bytes_ > 0) {
+    task_runners_.GetRasterTaskRunner()->PostTask(
+        [rasterizer = rasterizer_->GetWeakPtr(),
+         max_bytes = memory_budget_.Scale(resource_cache_base_bytes_)] {
+          if (rasterizer) {
+            rasterizer->SetResourceCacheMaxBytes(max_bytes, false);
+          }
+        });
+  }
+
+  if (settings_.raster_cache_max_bytes > 0) {
+    task_runners_.GetRasterTaskRunner()->PostTask(
+        [rasterizer = weak_rasterizer_,
+         max_bytes = memory_budget_.Scale(settings_.raster_cache_max_bytes)] {
+          if (rasterizer) {
+            rasterizer->compositor_context()->raster_cache().SetMaxBytes(
+                max_bytes);
+          }
+        });
+  }
+
+  if (decoded_image_cache_) {
+    decoded_image_cache_->SetMaxBytes(
+        memory_budget_.Scale(settings_.decoded_image_cache_max_bytes));
+  }
+}
+
+void Shell::SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  decoded_image_cache_ = cache;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, cache = std::move(cache)]() mutable {
+        if (engine) {
+          engine->SetDecodedImageCache(std::move(cache));
+        }
+      });
 }
 
 void Shell::RunEngine(RunConfiguration run_configuration) {
@@ -615,7 +995,7 @@ bool Shell::IsSetup() const {
 bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
                   std::unique_ptr<Engine> engine,
                   std::unique_ptr<Rasterizer> rasterizer,
-                  std::unique_ptr<ShellIOManager> io_manager) {
+                  std::shared_ptr<ShellIOManager> io_manager) {
   if (is_setup_) {
     return false;
   }
@@ -652,6 +1032,121 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
                                       });
   }
 
+  if (settings_.enable_async_raster_cache) {
+    auto resource_context = [io_manager = io_manager_->GetWeakPtr()]() {
+      GrDirectContext* context = nullptr;
+      if (io_manager) {
+        io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+            fml::SyncSwitch::Handlers().SetIfFalse([&] {
+              context = io_manager->GetResourceContext().get();
+            }));
+      }
+      return context;
+    };
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         io_task_runner = task_runners_.GetIOTaskRunner(), resource_context] {
+          if (rasterizer) {
+            rasterizer->compositor_context()
+                ->raster_cache()
+                .EnableAsyncRasterization(io_task_runner, resource_context);
+          }
+        });
+  }
+
+  if (settings_.raster_cache_max_bytes > 0) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         max_bytes = memory_budget_.Scale(settings_.raster_cache_max_bytes)] {
+          if (rasterizer) {
+            rasterizer->compositor_context()->raster_cache().SetMaxBytes(
+                max_bytes);
+          }
+        });
+  }
+
+  if (settings_.decoded_image_cache_max_bytes > 0) {
+    SetDecodedImageCache(std::make_shared<DecodedImageCache>(
+        memory_budget_.Scale(settings_.decoded_image_cache_max_bytes)));
+  }
+
+  if (settings_.enable_raster_cache_atlas) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_] {
+          if (rasterizer) {
+            rasterizer->compositor_context()->raster_cache().SetAtlasEnabled(
+                true);
+          }
+        });
+  }
+
+  if (settings_.enable_raster_frame_skipping) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_] {
+          if (rasterizer) {
+            rasterizer->SetFrameSkippingEnabled(true);
+          }
+        });
+  }
+
+  if (settings_.enable_submit_thread) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_] {
+          if (rasterizer) {
+            rasterizer->SetSubmitThreadEnabled(true);
+          }
+        });
+  }
+
+  if (settings_.enable_gpu_frame_timing) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_] {
+          if (rasterizer) {
+            rasterizer->SetGpuTimingEnabled(true);
+          }
+        });
+  }
+
+  if (settings_.enable_parallel_preroll) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         worker_task_runner = vm_->GetConcurrentWorkerTaskRunner(
+             fml::ConcurrentTaskPriority::kUserBlocking)] {
+          if (rasterizer) {
+            rasterizer->compositor_context()->SetPrerollTaskRunner(
+                worker_task_runner);
+          }
+        });
+  }
+
+  if (settings_.enable_layer_profiling) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(), [rasterizer = weak_rasterizer_] {
+          if (rasterizer) {
+            rasterizer->compositor_context()->SetLayerProfilingEnabled(true);
+          }
+        });
+  }
+
+  if (settings_.enable_parallel_software_raster) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         worker_task_runner = vm_->GetConcurrentWorkerTaskRunner(
+             fml::ConcurrentTaskPriority::kUserBlocking)] {
+          if (rasterizer) {
+            rasterizer->SetTileTaskRunner(worker_task_runner);
+          }
+        });
+  }
+
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
@@ -680,6 +1175,10 @@ const fml::RefPtr<fml::RasterThreadMerger> Shell::GetParentRasterThreadMerger()
   return parent_raster_thread_merger_;
 }
 
+const FrameTimingStatistics& Shell::GetFrameTimingStatistics() const {
+  return frame_timing_statistics_;
+}
+
 fml::TaskRunnerAffineWeakPtr<Rasterizer> Shell::GetRasterizer() const {
   FML_DCHECK(is_setup_);
   return weak_rasterizer_;
@@ -770,7 +1269,10 @@ void Shell::OnPlatformViewCreated(std::unique_ptr<Surface> surface) {
                   ui_task_runner = task_runners_.GetUITaskRunner(), ui_task,
                   shared_resource_context = shared_resource_context_,
                   raster_task_runner = task_runners_.GetRasterTaskRunner(),
-                  raster_task, should_post_raster_task, &latch] {
+                  raster_task, should_post_raster_task,
+                  io_task_runner = task_runners_.GetIOTaskRunner(),
+                  warm_up = settings_.warm_up_shaders_with_display_lists,
+                  &latch] {
     if (io_manager && !io_manager->GetResourceContext()) {
       sk_sp<GrDirectContext> resource_context;
       if (shared_resource_context) {
@@ -779,6 +1281,19 @@ void Shell::OnPlatformViewCreated(std::unique_ptr<Surface> surface) {
         resource_context = platform_view->CreateResourceContext();
       }
       io_manager->NotifyResourceContextAvailable(resource_context);
+      // The shader warm-up runs after the platform view is created, and
+      // stores the shaders in the persistent cache that the onscreen context
+      // loads them from.
+      if (warm_up) {
+        io_task_runner->PostTask([io_manager]() {
+          if (io_manager && io_manager->GetResourceContext()) {
+            WarmUpShadersWithDisplayLists(
+                io_manager->GetResourceContext().get(),
+                PersistentCache::GetCacheForProcess()
+                    ->GetDisplayListsFromAssetManager());
+          }
+        });
+      }
     }
     // Step 1: Post a task on the UI thread to tell the engine that it has
     // an output surface.
@@ -891,7 +1406,9 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
 
   // This is the formula Android uses.
   // https://android.googlesource.com/platform/frameworks/base/+/master/libs/hwui/renderthread/CacheManager.cpp#41
-  size_t max_bytes = metrics.physical_width * metrics.physical_height * 12 * 4;
+  resource_cache_base_bytes_ =
+      metrics.physical_width * metrics.physical_height * 12 * 4;
+  size_t max_bytes = memory_budget_.Scale(resource_cache_base_bytes_);
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), max_bytes] {
         if (rasterizer) {
@@ -919,14 +1436,108 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (platform_message_statistics_) {
+    message = platform_message_statistics_->RecordMessage(
+        std::move(message),
+        PlatformMessageStatistics::Direction::kFromPlatform);
+  }
+
+  if (settings_.batch_platform_messages) {
+    if (AddPendingPlatformMessage(std::move(message)) > 1) {
+      // The task of the first pending message dispatches this one too.
+      return;
+    }
+    // The shell outlives the engine, so it's still alive if the engine is.
+    task_runners_.GetUITaskRunner()->PostTask(
+        [this, engine = engine_->GetWeakPtr()]() {
+          if (!engine) {
+            return;
+          }
+          TRACE_EVENT0("flutter", "Shell::DispatchPlatformMessages");
+          for (auto& message : TakeAllPendingPlatformMessages()) {
+            DispatchPlatformMessageToEngine(engine.get(), std::move(message));
+          }
+        });
+    return;
+  }
+
+  if (!settings_.high_priority_platform_channels.empty()) {
+    AddPendingPlatformMessage(std::move(message));
+    // Each task dispatches the next pending message rather than the one it
+    // was posted for, so that the messages of the high priority channels
+    // don't wait for the tasks that were posted before them.
+    task_runners_.GetUITaskRunner()->PostTask(
+        [this, engine = engine_->GetWeakPtr()]() {
+          if (!engine) {
+            return;
+          }
+          if (auto message = TakeNextPendingPlatformMessage()) {
+            DispatchPlatformMessageToEngine(engine.get(), std::move(message));
+          }
+        });
+    return;
+  }
+
   task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
-      [engine = engine_->GetWeakPtr(), message = std::move(message)]() mutable {
+      [this, engine = engine_->GetWeakPtr(),
+       message = std::move(message)]() mutable {
         if (engine) {
-          engine->DispatchPlatformMessage(std::move(message));
+          DispatchPlatformMessageToEngine(engine.get(), std::move(message));
         }
       }));
 }
 
+size_t Shell::AddPendingPlatformMessage(
+    std::unique_ptr<PlatformMessage> message) {
+  const auto& high_priority_channels =
+      settings_.high_priority_platform_channels;
+  const bool is_high_priority =
+      std::find(high_priority_channels.begin(), high_priority_channels.end(),
+                message->channel()) != high_priority_channels.end();
+  std::scoped_lock lock(pending_platform_messages_mutex_);
+  if (is_high_priority) {
+    pending_high_priority_platform_messages_.push_back(std::move(message));
+  } else {
+    pending_platform_messages_.push_back(std::move(message));
+  }
+  return pending_high_priority_platform_messages_.size() +
+         pending_platform_messages_.size();
+}
+
+std::unique_ptr<PlatformMessage> Shell::TakeNextPendingPlatformMessage() {
+  std::scoped_lock lock(pending_platform_messages_mutex_);
+  auto& messages = pending_high_priority_platform_messages_.empty()
+                       ? pending_platform_messages_
+                       : pending_high_priority_platform_messages_;
+  if (messages.empty()) {
+    return nullptr;
+  }
+  auto message = std::move(messages.front());
+  messages.pop_front();
+  return message;
+}
+
+std::deque<std::unique_ptr<PlatformMessage>>
+Shell::TakeAllPendingPlatformMessages() {
+  std::scoped_lock lock(pending_platform_messages_mutex_);
+  std::deque<std::unique_ptr<PlatformMessage>> messages;
+  messages.swap(pending_high_priority_platform_messages_);
+  std::move(pending_platform_messages_.begin(),
+            pending_platform_messages_.end(), std::back_inserter(messages));
+  pending_platform_messages_.clear();
+  return messages;
+}
+
+void Shell::DispatchPlatformMessageToEngine(
+    Engine* engine,
+    std::unique_ptr<PlatformMessage> message) {
+  HandlePlatformMessageTimed(
+      platform_message_statistics_.get(), std::move(message),
+      [engine](std::unique_ptr<PlatformMessage> message) {
+        engine->DispatchPlatformMessage(std::move(message));
+      });
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchPointerDataPacket(
     std::unique_ptr<PointerDataPacket> packet) {
@@ -934,13 +1545,18 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
-  task_runners_.GetUITaskRunner()->PostTask(
+  auto task =
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
         if (engine) {
           engine->DispatchPointerDataPacket(std::move(packet), flow_id);
         }
-      }));
+      });
+  if (settings_.prioritize_pointer_events) {
+    task_runners_.GetUITaskRunner()->PostUserInteractionTask(task);
+  } else {
+    task_runners_.GetUITaskRunner()->PostTask(task);
+  }
   next_pointer_flow_id_++;
 }
 
@@ -1003,12 +1619,41 @@ void Shell::OnPlatformViewSetAccessibilityFeatures(int32_t flags) {
       });
 }
 
+class Shell::TextureFrameBatch {
+ public:
+  // Returns false if the raster thread has already taken the batch.
+  bool Add(int64_t texture_id) {
+    std::scoped_lock lock(mutex_);
+    if (taken_) {
+      return false;
+    }
+    if (std::find(texture_ids_.begin(), texture_ids_.end(), texture_id) ==
+        texture_ids_.end()) {
+      texture_ids_.push_back(texture_id);
+    }
+    return true;
+  }
+
+  std::vector<int64_t> Take() {
+    std::scoped_lock lock(mutex_);
+    taken_ = true;
+    return std::move(texture_ids_);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<int64_t> texture_ids_;
+  bool taken_ = false;
+};
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewRegisterTexture(
     std::shared_ptr<flutter::Texture> texture) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  texture_frame_batch_.reset();
+
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), texture] {
         if (rasterizer) {
@@ -1024,6 +1669,8 @@ void Shell::OnPlatformViewUnregisterTexture(int64_t texture_id) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  texture_frame_batch_.reset();
+
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), texture_id]() {
         if (rasterizer) {
@@ -1039,22 +1686,29 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  // Tell the rasterizer that one of its textures has a new frame available.
+  // The textures that make frames available before the raster thread gets to
+  // the pending batch are added to it, so that a single task marks their
+  // frames and a single frame is scheduled for all of them.
+  if (texture_frame_batch_ && texture_frame_batch_->Add(texture_id)) {
+    return;
+  }
+  texture_frame_batch_ = std::make_shared<TextureFrameBatch>();
+  texture_frame_batch_->Add(texture_id);
+
+  // Tell the rasterizer that its textures have new frames available.
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), texture_id]() {
+      [rasterizer = rasterizer_->GetWeakPtr(), batch = texture_frame_batch_]() {
+        std::vector<int64_t> texture_ids = batch->Take();
+        if (!rasterizer) {
+          return;
+        }
         auto* registry = rasterizer->GetTextureRegistry();
-
         if (!registry) {
           return;
         }
-
-        auto texture = registry->GetTexture(texture_id);
-
-        if (!texture) {
-          return;
+        for (int64_t texture_id : texture_ids) {
+          registry->MarkNewFrameAvailable(texture_id);
         }
-
-        texture->MarkNewFrameAvailable();
       });
 
   // Schedule a new frame without having to rebuild the layer tree.
@@ -1173,13 +1827,68 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
+  if (settings_.semantics_update_interval_ms == 0) {
+    task_runners_.GetPlatformTaskRunner()->PostTask(
+        [view = platform_view_->GetWeakPtr(), update = std::move(update),
+         actions = std::move(actions)] {
+          if (view) {
+            view->UpdateSemantics(std::move(update), std::move(actions));
+          }
+        });
+    return;
+  }
+
+  // Each update carries the whole state of the nodes it contains, so the
+  // later updates of a node replace the earlier ones.
+  for (auto& [id, node] : update) {
+    pending_semantics_nodes_[id] = std::move(node);
+  }
+  for (auto& [id, action] : actions) {
+    pending_semantics_actions_[id] = std::move(action);
+  }
+  if (semantics_update_scheduled_) {
+    return;
+  }
+
+  const fml::TimePoint next_update_time =
+      last_semantics_update_time_ + fml::TimeDelta::FromMilliseconds(
+                                        settings_.semantics_update_interval_ms);
+  if (fml::TimePoint::Now() >= next_update_time) {
+    // The first update after a quiet period is sent right away, so that only
+    // the updates that follow it in quick succession are delayed.
+    SendPendingSemanticsUpdate();
+    return;
+  }
+  semantics_update_scheduled_ = true;
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      // The shell outlives the engine, so it's still alive if the engine is.
+      [this, engine = engine_->GetWeakPtr()]() {
+        if (engine) {
+          semantics_update_scheduled_ = false;
+          SendPendingSemanticsUpdate();
+        }
+      },
+      next_update_time);
+}
+
+void Shell::SendPendingSemanticsUpdate() {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  if (pending_semantics_nodes_.empty() && pending_semantics_actions_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Shell::SendPendingSemanticsUpdate");
+  last_semantics_update_time_ = fml::TimePoint::Now();
   task_runners_.GetPlatformTaskRunner()->PostTask(
-      [view = platform_view_->GetWeakPtr(), update = std::move(update),
-       actions = std::move(actions)] {
+      [view = platform_view_->GetWeakPtr(),
+       update = std::move(pending_semantics_nodes_),
+       actions = std::move(pending_semantics_actions_)] {
         if (view) {
           view->UpdateSemantics(std::move(update), std::move(actions));
         }
       });
+  pending_semantics_nodes_.clear();
+  pending_semantics_actions_.clear();
 }
 
 // |Engine::Delegate|
@@ -1193,14 +1902,29 @@ void Shell::OnEngineHandlePlatformMessage(
     return;
   }
 
+  if (platform_message_statistics_) {
+    message = platform_message_statistics_->RecordMessage(
+        std::move(message), PlatformMessageStatistics::Direction::kToPlatform);
+  }
+
   if (platform_message_handler_) {
-    platform_message_handler_->HandlePlatformMessage(std::move(message));
+    HandlePlatformMessageTimed(
+        platform_message_statistics_.get(), std::move(message),
+        [handler = platform_message_handler_.get()](
+            std::unique_ptr<PlatformMessage> message) {
+          handler->HandlePlatformMessage(std::move(message));
+        });
   } else {
-    task_runners_.GetPlatformTaskRunner()->PostTask(
-        fml::MakeCopyable([view = platform_view_->GetWeakPtr(),
-                           message = std::move(message)]() mutable {
+    task_runners_.GetPlatformTaskRunner()->PostTask(fml::MakeCopyable(
+        [view = platform_view_->GetWeakPtr(),
+         statistics = platform_message_statistics_,
+         message = std::move(message)]() mutable {
           if (view) {
-            view->HandlePlatformMessage(std::move(message));
+            HandlePlatformMessageTimed(
+                statistics.get(), std::move(message),
+                [&view](std::unique_ptr<PlatformMessage> message) {
+                  view->HandlePlatformMessage(std::move(message));
+                });
           }
         }));
   }
@@ -1244,6 +1968,11 @@ void Shell::OnPreEngineRestart() {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
+  // The nodes of the previous isolate must not reach the platform after its
+  // tree was reset.
+  pending_semantics_nodes_.clear();
+  pending_semantics_actions_.clear();
+
   fml::AutoResetWaitableEvent latch;
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetPlatformTaskRunner(),
@@ -1307,6 +2036,42 @@ void Shell::LoadDartDeferredLibrary(
       }));
 }
 
+void Shell::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  if (!snapshot_data || !snapshot_instructions ||
+      !deferred_library_prefetches_->Start(loading_unit_id)) {
+    return;
+  }
+  // Each loading unit is read on a worker of its own, so that the units that
+  // are prefetched together are read concurrently.
+  vm_->GetConcurrentWorkerTaskRunner()->PostTask(fml::MakeCopyable(
+      [prefetches = deferred_library_prefetches_,
+       ui_task_runner = task_runners_.GetUITaskRunner(),
+       engine = weak_engine_, loading_unit_id,
+       data = std::move(snapshot_data),
+       instructions = std::move(snapshot_instructions)]() mutable {
+        TRACE_EVENT0("flutter", "Shell::PrefetchDartDeferredLibrary");
+        PrefetchLoadingUnitPages(*data);
+        PrefetchLoadingUnitPages(*instructions);
+        auto requested = prefetches->Finish(
+            loading_unit_id, {std::move(data), std::move(instructions)});
+        if (!requested) {
+          return;
+        }
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [engine, loading_unit_id,
+             loading_unit = std::move(*requested)]() mutable {
+              if (engine) {
+                engine->LoadDartDeferredLibrary(
+                    loading_unit_id, std::move(loading_unit.snapshot_data),
+                    std::move(loading_unit.snapshot_instructions));
+              }
+            }));
+      }));
+}
+
 void Shell::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                          const std::string error_message,
                                          bool transient) {
@@ -1323,6 +2088,15 @@ void Shell::UpdateAssetResolverByType(
 
 // |Engine::Delegate|
 void Shell::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
+  std::optional<DeferredLibraryPrefetches::LoadingUnit> prefetched;
+  if (deferred_library_prefetches_->Request(loading_unit_id, &prefetched)) {
+    if (prefetched) {
+      LoadDartDeferredLibrary(loading_unit_id,
+                              std::move(prefetched->snapshot_data),
+                              std::move(prefetched->snapshot_instructions));
+    }
+    return;
+  }
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), loading_unit_id] {
         if (view) {
@@ -1361,6 +2135,73 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (!service_isolate_startup_allowed_) {
+    // Starts the service isolate if |lazy_service_isolate_startup| deferred
+    // it. This doesn't depend on whether the timings are reported.
+    service_isolate_startup_allowed_ = true;
+    DartServiceIsolate::AllowStartup();
+  }
+
+  if (!StartupTimings::Get(StartupTimings::Phase::kFirstFrame)) {
+    StartupTimings::Record(StartupTimings::Phase::kFirstFrame,
+                           timing.Get(FrameTiming::kBuildStart),
+                           timing.Get(FrameTiming::kRasterFinish));
+    StartupTimings::Record(StartupTimings::Phase::kFirstLayerTree,
+                           timing.Get(FrameTiming::kBuildStart),
+                           timing.Get(FrameTiming::kBuildFinish));
+    StartupTimings::Record(StartupTimings::Phase::kFirstRaster,
+                           timing.Get(FrameTiming::kRasterStart),
+                           timing.Get(FrameTiming::kRasterFinish));
+    if (settings_.record_snapshot_prefetch_profile &&
+        !settings_.snapshot_prefetch_profile_path.empty()) {
+      vm_->GetConcurrentWorkerTaskRunner()->PostTask(
+          [vm_data = vm_->GetVMData(),
+           path = settings_.snapshot_prefetch_profile_path]() {
+            auto isolate_snapshot = vm_data->GetIsolateSnapshot();
+            if (!isolate_snapshot) {
+              return;
+            }
+            auto profile = SnapshotPrefetchProfile::Record(
+                vm_data->GetVMSnapshot(), *isolate_snapshot);
+            if (!profile.WriteToFile(path)) {
+              FML_LOG(ERROR)
+                  << "Could not write the snapshot prefetch profile to "
+                  << path;
+            }
+          });
+    }
+  }
+
+  const fml::TimeDelta frame_budget =
+      fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count());
+  frame_timing_statistics_.Record(timing, frame_budget);
+
+  // The events that preceded a jank are kept until a jank that they don't
+  // cover, so that they are only copied once for a burst of janky frames.
+  const fml::TimePoint raster_finish = timing.Get(FrameTiming::kRasterFinish);
+  const uint64_t missed_vsyncs = FrameTimingStatistics::MissedVsyncs(
+      timing.Get(FrameTiming::kBuildFinish) -
+          timing.Get(FrameTiming::kBuildStart),
+      timing.Get(FrameTiming::kRasterFinish) -
+          timing.Get(FrameTiming::kRasterStart),
+      frame_budget);
+  if (missed_vsyncs > 0 && raster_finish - jank_time_ > kFlightRecordDuration) {
+    jank_flight_record_ = fml::tracing::FlightRecorder::GetInstance().GetEvents(
+        kFlightRecordDuration, raster_finish);
+    jank_frame_number_ = timing.GetFrameNumber();
+    jank_time_ = raster_finish;
+  }
+
+  if (settings_.enable_adaptive_pipeline_depth ||
+      settings_.frame_pacing_policy != FramePacingPolicy::kDefault) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, timing] {
+          if (engine) {
+            engine->OnFrameRasterized(timing);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1374,6 +2215,10 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetLayerCacheBytes());
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
+  unreported_timings_.push_back(timing.GetShaderCompileCount());
+  unreported_timings_.push_back(
+      timing.GetShaderCompileDuration().ToMicroseconds());
+  unreported_timings_.push_back(timing.GetResourceCachePurgedBytes());
   unreported_timings_.push_back(timing.GetFrameNumber());
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
@@ -1662,6 +2507,9 @@ bool Shell::OnServiceProtocolGetSkSLs(
   response->AddMember("type", "GetSkSLs", response->GetAllocator());
 
   rapidjson::Value shaders_json(rapidjson::kObjectType);
+  // The usage of the SkSLs, by the same keys, which tells the SkSLs that are
+  // needed by the first frames, or rarely used, when curating a bundle.
+  rapidjson::Value usage_json(rapidjson::kObjectType);
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   std::vector<PersistentCache::SkSLCache> sksls = persistent_cache->LoadSkSLs();
   for (const auto& sksl : sksls) {
@@ -1680,8 +2528,21 @@ bool Shell::OnServiceProtocolGetSkSLs(
     }
     rapidjson::Value shader_key(encode_result.second, response->GetAllocator());
     shaders_json.AddMember(shader_key, shader_value, response->GetAllocator());
+    std::optional<PersistentCache::ShaderUsage> usage =
+        persistent_cache->GetShaderUsage(*sksl.key);
+    if (usage) {
+      rapidjson::Value usage_value(rapidjson::kObjectType);
+      usage_value.AddMember("firstUseFrame", usage->first_use_frame,
+                            response->GetAllocator());
+      usage_value.AddMember("launchCount", usage->launch_count,
+                            response->GetAllocator());
+      rapidjson::Value usage_key(encode_result.second,
+                                 response->GetAllocator());
+      usage_json.AddMember(usage_key, usage_value, response->GetAllocator());
+    }
   }
   response->AddMember("SkSLs", shaders_json, response->GetAllocator());
+  response->AddMember("SkSLUsage", usage_json, response->GetAllocator());
   return true;
 }
 
@@ -1702,6 +2563,362 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+static const char* RasterCacheEntryTypeName(RasterCacheEntryInfo::Type type) {
+  switch (type) {
+    case RasterCacheEntryInfo::Type::kPicture:
+      return "picture";
+    case RasterCacheEntryInfo::Type::kDisplayList:
+      return "displayList";
+    case RasterCacheEntryInfo::Type::kLayer:
+      return "layer";
+  }
+  return "unknown";
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetRasterCacheEntries(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto& raster_cache = rasterizer_->compositor_context()->raster_cache();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "RasterCacheEntries", allocator);
+  response->AddMember<uint64_t>("frame", raster_cache.current_frame(),
+                                allocator);
+  response->AddMember<uint64_t>("accessThreshold",
+                                raster_cache.access_threshold(), allocator);
+  response->AddMember<uint64_t>(
+      "cacheLimitPerFrame",
+      raster_cache.picture_and_display_list_cache_limit_per_frame(),
+      allocator);
+  response->AddMember<uint64_t>("hitCount", raster_cache.total_hit_count(),
+                                allocator);
+  response->AddMember<uint64_t>("missCount", raster_cache.total_miss_count(),
+                                allocator);
+  response->AddMember("hitRatio", raster_cache.GetHitRatio(), allocator);
+  rapidjson::Value entries(rapidjson::kArrayType);
+  for (const auto& info : raster_cache.GetEntryInfos()) {
+    rapidjson::Value entry(rapidjson::kObjectType);
+    const char* type = RasterCacheEntryTypeName(info.type);
+    entry.AddMember("type", rapidjson::StringRef(type), allocator);
+    entry.AddMember<uint64_t>("bytes", info.bytes, allocator);
+    entry.AddMember<uint64_t>("accessCount", info.access_count, allocator);
+    entry.AddMember<uint64_t>("age", info.age, allocator);
+    entry.AddMember<uint64_t>("lastUsedFrame", info.last_used_frame,
+                              allocator);
+    entries.PushBack(entry, allocator);
+  }
+  response->AddMember("entries", entries, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetLockContention(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "LockContention", allocator);
+  response->AddMember("enabled", fml::LockContentionCounter::IsEnabled(),
+                      allocator);
+  rapidjson::Value locks(rapidjson::kArrayType);
+  for (const auto& stats : fml::LockContentionCounter::GetAllStats()) {
+    rapidjson::Value lock(rapidjson::kObjectType);
+    lock.AddMember("name", rapidjson::Value(stats.name, allocator), allocator);
+    lock.AddMember<uint64_t>("acquisitions", stats.acquisitions, allocator);
+    lock.AddMember<uint64_t>("contentions", stats.contentions, allocator);
+    lock.AddMember<int64_t>("totalWaitMicros",
+                            stats.total_wait_time.ToMicroseconds(), allocator);
+    lock.AddMember<int64_t>("maxWaitMicros",
+                            stats.max_wait_time.ToMicroseconds(), allocator);
+    lock.AddMember<int64_t>("totalHoldMicros",
+                            stats.total_hold_time.ToMicroseconds(), allocator);
+    lock.AddMember<int64_t>("maxHoldMicros",
+                            stats.max_hold_time.ToMicroseconds(), allocator);
+    locks.PushBack(lock, allocator);
+  }
+  response->AddMember("locks", locks, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetPlatformChannelStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "PlatformChannelStatistics", allocator);
+  response->AddMember("enabled", platform_message_statistics_ != nullptr,
+                      allocator);
+  rapidjson::Value channels(rapidjson::kArrayType);
+  if (platform_message_statistics_) {
+    for (const auto& stats : platform_message_statistics_->GetAllStats()) {
+      rapidjson::Value channel(rapidjson::kObjectType);
+      channel.AddMember("name", rapidjson::Value(stats.channel, allocator),
+                        allocator);
+      channel.AddMember<uint64_t>("messagesFromPlatform",
+                                  stats.messages_from_platform, allocator);
+      channel.AddMember<uint64_t>("bytesFromPlatform",
+                                  stats.bytes_from_platform, allocator);
+      channel.AddMember<uint64_t>("messagesToPlatform",
+                                  stats.messages_to_platform, allocator);
+      channel.AddMember<uint64_t>("bytesToPlatform", stats.bytes_to_platform,
+                                  allocator);
+      channel.AddMember<uint64_t>("responses", stats.responses, allocator);
+      channel.AddMember<int64_t>("totalResponseLatencyMicros",
+                                 stats.total_response_latency.ToMicroseconds(),
+                                 allocator);
+      channel.AddMember<int64_t>("maxResponseLatencyMicros",
+                                 stats.max_response_latency.ToMicroseconds(),
+                                 allocator);
+      channel.AddMember<uint64_t>("handlerInvocations",
+                                  stats.handler_invocations, allocator);
+      channel.AddMember<int64_t>("totalHandlerMicros",
+                                 stats.total_handler_time.ToMicroseconds(),
+                                 allocator);
+      channel.AddMember<int64_t>("maxHandlerMicros",
+                                 stats.max_handler_time.ToMicroseconds(),
+                                 allocator);
+      channels.PushBack(channel, allocator);
+    }
+  }
+  response->AddMember("channels", channels, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetEngineMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto usage = SampleNativeMemoryUsage();
+  const auto& raster_cache = rasterizer_->compositor_context()->raster_cache();
+  usage["rasterCacheLayers"] = raster_cache.EstimateLayerCacheByteSize();
+  usage["rasterCachePictures"] = raster_cache.EstimatePictureCacheByteSize();
+  if (auto skia_bytes = rasterizer_->GetResourceCacheUsage()) {
+    usage["skiaResourceCache"] = *skia_bytes;
+  }
+  auto& allocator = response->GetAllocator();
+  auto to_json = [&allocator](const std::map<std::string, int64_t>& bytes) {
+    rapidjson::Value object(rapidjson::kObjectType);
+    for (const auto& [name, value] : bytes) {
+      object.AddMember(rapidjson::Value(name, allocator),
+                       rapidjson::Value(value), allocator);
+    }
+    return object;
+  };
+  response->SetObject();
+  response->AddMember("type", "EngineMemoryUsage", allocator);
+  response->AddMember("bytes", to_json(usage), allocator);
+  response->AddMember("lowMemoryWarningFreedBytes",
+                      to_json(*low_memory_freed_bytes_), allocator);
+  return true;
+}
+
+static rapidjson::Value FlightRecordToJson(
+    const std::vector<fml::tracing::FlightRecorderEvent>& events,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value array(rapidjson::kArrayType);
+  for (const auto& event : events) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember(
+        "type",
+        rapidjson::StringRef(
+            fml::tracing::FlightRecorder::GetEventTypeName(event.type)),
+        allocator);
+    value.AddMember<int64_t>("timestampMicros", event.timestamp_micros,
+                             allocator);
+    value.AddMember<int64_t>("value", event.value, allocator);
+    array.PushBack(value, allocator);
+  }
+  return array;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFlightRecord(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  fml::TimeDelta duration = kFlightRecordDuration;
+  auto duration_millis = params.find("durationMillis");
+  if (duration_millis != params.end()) {
+    duration = fml::TimeDelta::FromMilliseconds(
+        std::strtoll(duration_millis->second.c_str(), nullptr, 10));
+  }
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FlightRecord", allocator);
+  response->AddMember(
+      "events",
+      FlightRecordToJson(
+          fml::tracing::FlightRecorder::GetInstance().GetEvents(duration),
+          allocator),
+      allocator);
+  if (!jank_flight_record_.empty()) {
+    rapidjson::Value jank(rapidjson::kObjectType);
+    jank.AddMember<uint64_t>("frameNumber", jank_frame_number_, allocator);
+    jank.AddMember<int64_t>("timestampMicros",
+                            jank_time_.ToEpochDelta().ToMicroseconds(),
+                            allocator);
+    jank.AddMember("events", FlightRecordToJson(jank_flight_record_, allocator),
+                   allocator);
+    response->AddMember("lastJank", jank, allocator);
+  }
+  return true;
+}
+
+static rapidjson::Value FrameTimingPercentilesToJson(
+    const FrameTimingPercentiles& percentiles,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value value(rapidjson::kObjectType);
+  value.AddMember<int64_t>("p50Micros", percentiles.p50.ToMicroseconds(),
+                           allocator);
+  value.AddMember<int64_t>("p90Micros", percentiles.p90.ToMicroseconds(),
+                           allocator);
+  value.AddMember<int64_t>("p99Micros", percentiles.p99.ToMicroseconds(),
+                           allocator);
+  value.AddMember<int64_t>("maxMicros", percentiles.max.ToMicroseconds(),
+                           allocator);
+  return value;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameTimingStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const FrameTimingSummary summary = frame_timing_statistics_.GetSummary();
+  auto reset = params.find("reset");
+  if (reset != params.end() && reset->second == "true") {
+    frame_timing_statistics_.Reset();
+  }
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameTimingStatistics", allocator);
+  response->AddMember<uint64_t>("frames", summary.frame_count, allocator);
+  response->AddMember<int64_t>("frameBudgetMicros",
+                               summary.frame_budget.ToMicroseconds(),
+                               allocator);
+  response->AddMember("build",
+                      FrameTimingPercentilesToJson(summary.build, allocator),
+                      allocator);
+  response->AddMember("raster",
+                      FrameTimingPercentilesToJson(summary.raster, allocator),
+                      allocator);
+  response->AddMember("total",
+                      FrameTimingPercentilesToJson(summary.total, allocator),
+                      allocator);
+  rapidjson::Value histogram(rapidjson::kArrayType);
+  for (uint64_t count : summary.missed_vsync_histogram) {
+    histogram.PushBack(count, allocator);
+  }
+  response->AddMember("missedVsyncHistogram", histogram, allocator);
+  response->AddMember<uint64_t>("jankyFrames", summary.janky_frame_count,
+                                allocator);
+  response->AddMember<uint64_t>("missedVsyncs", summary.missed_vsync_count,
+                                allocator);
+  response->AddMember<uint64_t>("totalFrames", summary.total_frame_count,
+                                allocator);
+  response->AddMember<uint64_t>("totalJankyFrames",
+                                summary.total_janky_frame_count, allocator);
+
+  // The shader compilations and the resource cache purges of the process,
+  // which the frame timings report frame by frame.
+  const SkiaGpuStatistics& skia_gpu_statistics =
+      SkiaGpuStatistics::GetInstance();
+  const SkiaGpuCounters counters = skia_gpu_statistics.GetCounters();
+  rapidjson::Value recent_compilations(rapidjson::kArrayType);
+  for (const auto& compilation :
+       skia_gpu_statistics.GetRecentShaderCompilations()) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember<int64_t>(
+        "startMicros", compilation.start.ToEpochDelta().ToMicroseconds(),
+        allocator);
+    value.AddMember<int64_t>("durationMicros",
+                             compilation.duration.ToMicroseconds(), allocator);
+    value.AddMember("key", rapidjson::Value(compilation.key, allocator),
+                    allocator);
+    recent_compilations.PushBack(value, allocator);
+  }
+  rapidjson::Value shader_compilations(rapidjson::kObjectType);
+  shader_compilations.AddMember<uint64_t>(
+      "count", counters.shader_compile_count, allocator);
+  shader_compilations.AddMember<int64_t>(
+      "durationMicros", counters.shader_compile_duration.ToMicroseconds(),
+      allocator);
+  shader_compilations.AddMember("recent", recent_compilations, allocator);
+  response->AddMember("shaderCompilations", shader_compilations, allocator);
+  rapidjson::Value resource_cache_purges(rapidjson::kObjectType);
+  resource_cache_purges.AddMember<uint64_t>(
+      "count", counters.resource_cache_purge_count, allocator);
+  resource_cache_purges.AddMember<uint64_t>(
+      "bytes", counters.resource_cache_purged_bytes, allocator);
+  response->AddMember("resourceCachePurges", resource_cache_purges, allocator);
+  return true;
+}
+
+static void AddLayerProfileStats(
+    const LayerProfiler::Stats& stats,
+    rapidjson::Value& value,
+    rapidjson::Document::AllocatorType& allocator) {
+  auto add_timings = [&](const char* phase,
+                         const LayerProfiler::Timings& timings) {
+    rapidjson::Value object(rapidjson::kObjectType);
+    object.AddMember<int64_t>("inclusiveMicros",
+                              timings.inclusive_time.ToMicroseconds(),
+                              allocator);
+    object.AddMember<int64_t>("exclusiveMicros",
+                              timings.exclusive_time.ToMicroseconds(),
+                              allocator);
+    object.AddMember<uint64_t>("calls", timings.calls, allocator);
+    value.AddMember(rapidjson::StringRef(phase), object, allocator);
+  };
+  add_timings("preroll", stats.preroll);
+  add_timings("paint", stats.paint);
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetLayerProfile(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  LayerProfiler* profiler =
+      rasterizer_ ? rasterizer_->compositor_context()->layer_profiler()
+                  : nullptr;
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "LayerProfile", allocator);
+  response->AddMember("enabled", profiler != nullptr, allocator);
+  rapidjson::Value types(rapidjson::kArrayType);
+  rapidjson::Value layers(rapidjson::kArrayType);
+  if (profiler) {
+    for (const auto& [name, stats] : profiler->stats_by_type()) {
+      rapidjson::Value type(rapidjson::kObjectType);
+      type.AddMember("name", rapidjson::Value(name, allocator), allocator);
+      AddLayerProfileStats(stats, type, allocator);
+      types.PushBack(type, allocator);
+    }
+    for (const auto& [id, layer_stats] : profiler->stats_by_layer()) {
+      rapidjson::Value layer(rapidjson::kObjectType);
+      layer.AddMember<uint64_t>("id", id, allocator);
+      layer.AddMember("type", rapidjson::StringRef(layer_stats.type_name),
+                      allocator);
+      AddLayerProfileStats(layer_stats.stats, layer, allocator);
+      layers.PushBack(layer, allocator);
+    }
+    auto reset = params.find("reset");
+    if (reset != params.end() && reset->second == "true") {
+      profiler->Reset();
+    }
+  }
+  response->AddMember("types", types, allocator);
+  response->AddMember("layers", layers, allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1775,6 +2992,25 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+void Shell::ScreenshotAsync(Rasterizer::ScreenshotType screenshot_type,
+                            bool base64_encode,
+                            Rasterizer::ScreenshotChunkCallback callback) {
+  TRACE_EVENT0("flutter", "Shell::ScreenshotAsync");
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [rasterizer = GetRasterizer(),
+       worker_task_runner = vm_->GetConcurrentWorkerTaskRunner(
+           fml::ConcurrentTaskPriority::kBackground),
+       screenshot_type, base64_encode, callback = std::move(callback)]() {
+        if (!rasterizer) {
+          callback({}, true);
+          return;
+        }
+        rasterizer->ScreenshotLastLayerTreeAsync(
+            screenshot_type, base64_encode, worker_task_runner, callback);
+      });
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_setup_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -1866,6 +3102,24 @@ void Shell::SetGpuAvailability(GpuAvailability availability) {
 void Shell::OnDisplayUpdates(DisplayUpdateType update_type,
                              std::vector<Display> displays) {
   display_manager_->HandleDisplayUpdates(update_type, displays);
+
+  const double refresh_rate = display_manager_->GetMainDisplayRefreshRate();
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = weak_engine_, refresh_rate]() {
+        if (engine) {
+          engine->OnDisplayRefreshRateChanged(refresh_rate);
+        }
+      });
+}
+
+void Shell::SetIdleFrameRateLimit(double frames_per_second) {
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, frames_per_second]() {
+        if (engine) {
+          engine->SetIdleFrameRateLimit(frames_per_second);
+        }
+      });
 }
 
 fml::TimePoint Shell::GetCurrentTimePoint() {
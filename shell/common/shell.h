@@ -5,10 +5,13 @@
 #ifndef SHELL_COMMON_SHELL_H_
 #define SHELL_COMMON_SHELL_H_
 
+#include <deque>
 #include <functional>
+#include <map>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/texture.h"
@@ -25,6 +28,7 @@
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/thread.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_flight_recorder.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
@@ -36,6 +40,9 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_timing_statistics.h"
+#include "flutter/shell/common/memory_budget.h"
+#include "flutter/shell/common/platform_message_statistics.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell_io_manager.h"
@@ -186,10 +193,15 @@ class Shell final : public PlatformView::Delegate,
   ///             second Shell is mostly independent from the original Shell
   ///             and the original Shell doesn't need to keep running for the
   ///             spawned Shell to keep functioning.
+  ///
+  ///             The Shells share their IO manager, with its resource context
+  ///             and unref queue, as well as their font collection and asset
+  ///             manager.
   /// @param[in]  run_configuration  A RunConfiguration used to run the Isolate
   ///             associated with this new Shell. It doesn't have to be the same
   ///             configuration as the current Shell but it needs to be in the
-  ///             same snapshot or AOT.
+  ///             same snapshot or AOT. Its entrypoint is used, but its assets
+  ///             are resolved by the asset manager of the current Shell.
   ///
   /// @see        http://flutter.dev/go/multiple-engines
   std::unique_ptr<Shell> Spawn(
@@ -247,6 +259,12 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::TaskRunnerAffineWeakPtr<Rasterizer> GetRasterizer() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The rolling histograms of the timings of the frames that were
+  ///             rasterized, which can be accessed on any thread.
+  ///
+  const FrameTimingStatistics& GetFrameTimingStatistics() const;
+
   //------------------------------------------------------------------------------
   /// @brief      Engines may only be accessed on the UI thread. This method is
   ///             deprecated, and implementers should instead use other API
@@ -309,6 +327,23 @@ class Shell final : public PlatformView::Delegate,
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Captures a screenshot like `Screenshot`, but without blocking
+  ///             the calling thread or the raster thread on the readback and
+  ///             encoding of the screenshot.
+  ///
+  /// @param[in]  type           The type of screenshot to capture.
+  /// @param[in]  base64_encode  If the screenshot data should be base64
+  ///                            encoded.
+  /// @param[in]  callback       Receives the chunks of the screenshot on a
+  ///                            concurrent worker thread.
+  ///
+  /// @see        `Rasterizer::ScreenshotLastLayerTreeAsync`
+  ///
+  void ScreenshotAsync(Rasterizer::ScreenshotType type,
+                       bool base64_encode,
+                       Rasterizer::ScreenshotChunkCallback callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Pauses the calling thread until the first frame is presented.
   ///
@@ -375,6 +410,17 @@ class Shell final : public PlatformView::Delegate,
   void OnDisplayUpdates(DisplayUpdateType update_type,
                         std::vector<Display> displays);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Limits the rate at which frames begin while the user isn't
+  ///             interacting with the app. Can be called on any thread.
+  ///
+  /// @see        `Engine::SetIdleFrameRateLimit`
+  ///
+  /// @param[in]  frames_per_second  The maximum frame rate, or zero or less to
+  ///                                remove the limit.
+  ///
+  void SetIdleFrameRateLimit(double frames_per_second);
+
   //----------------------------------------------------------------------------
   /// @brief Queries the `DisplayManager` for the main display refresh rate.
   ///
@@ -415,10 +461,38 @@ class Shell final : public PlatformView::Delegate,
   std::unique_ptr<PlatformView> platform_view_;  // on platform task runner
   std::unique_ptr<Engine> engine_;               // on UI task runner
   std::unique_ptr<Rasterizer> rasterizer_;       // on raster task runner
-  std::unique_ptr<ShellIOManager> io_manager_;   // on IO task runner
+  // on IO task runner, and shared with the shells spawned from this one.
+  std::shared_ptr<ShellIOManager> io_manager_;
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
+  // The platform messages that are waiting for the UI thread, unless they are
+  // neither batched nor prioritized. The messages of the high priority channels
+  // are dispatched first.
+  std::mutex pending_platform_messages_mutex_;
+  std::deque<std::unique_ptr<PlatformMessage>>
+      pending_high_priority_platform_messages_;
+  std::deque<std::unique_ptr<PlatformMessage>> pending_platform_messages_;
+  // Only set when platform channel statistics are enabled.
+  const std::shared_ptr<PlatformMessageStatistics> platform_message_statistics_;
+  FrameTimingStatistics frame_timing_statistics_;
+  // The bytes that each subsystem freed in response to the last low memory
+  // warning, as reported by `_flutter.getEngineMemoryUsage`. Only accessed on
+  // the raster thread.
+  const std::shared_ptr<std::map<std::string, int64_t>>
+      low_memory_freed_bytes_;
+  // The flight recorder events that preceded the last frame that missed a
+  // vsync, as reported by `_flutter.getFlightRecord`. Only accessed on the
+  // raster thread.
+  std::vector<fml::tracing::FlightRecorderEvent> jank_flight_record_;
+  uint64_t jank_frame_number_ = 0;
+  fml::TimePoint jank_time_;
+  // The semantics updates that are merged until the semantics update interval
+  // of the settings has passed since the last one was sent to the platform.
+  SemanticsNodeUpdates pending_semantics_nodes_;               // on UI
+  CustomAccessibilityActionUpdates pending_semantics_actions_;  // on UI
+  fml::TimePoint last_semantics_update_time_;                   // on UI
+  bool semantics_update_scheduled_ = false;                     // on UI
 
   fml::WeakPtr<Engine> weak_engine_;  // to be shared across threads
   fml::TaskRunnerAffineWeakPtr<Rasterizer>
@@ -437,6 +511,9 @@ class Shell final : public PlatformView::Delegate,
   uint64_t next_pointer_flow_id_ = 0;
 
   bool first_frame_rasterized_ = false;
+  // Whether a frame of this shell has released a deferred startup of the
+  // service isolate. Only accessed on the raster thread.
+  bool service_isolate_startup_allowed_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
   std::mutex waiting_for_first_frame_mutex_;
   std::condition_variable waiting_for_first_frame_condition_;
@@ -458,6 +535,19 @@ class Shell final : public PlatformView::Delegate,
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
 
+  // The textures with new frames that the platform thread has not yet handed
+  // to the raster thread, which takes them all in a single task. Replaced on
+  // the platform thread whenever the raster thread has taken it, and whenever
+  // a texture is registered or unregistered, which the raster thread has to
+  // do before marking the frames that were made available afterwards.
+  class TextureFrameBatch;
+  std::shared_ptr<TextureFrameBatch> texture_frame_batch_;
+
+  // The deferred libraries that have been prefetched, or are being prefetched
+  // on a worker, and haven't been requested by Dart yet.
+  class DeferredLibraryPrefetches;
+  std::shared_ptr<DeferredLibraryPrefetches> deferred_library_prefetches_;
+
   // protects expected_frame_size_ which is set on platform thread and read on
   // raster thread
   std::mutex resize_mutex_;
@@ -470,6 +560,18 @@ class Shell final : public PlatformView::Delegate,
 
   sk_sp<GrDirectContext> shared_resource_context_;
 
+  // Shared with the shells spawned from this one, which share its resource
+  // context. Null when the decoded image cache is disabled.
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+
+  // Scales the cache budgets to the device memory and the memory pressure.
+  // Only accessed on the platform thread.
+  MemoryBudget memory_budget_{MemoryBudget::GetTotalMemoryBytes()};
+  // The Skia resource cache budget for the current viewport, before it is
+  // scaled by |memory_budget_|.
+  size_t resource_cache_base_bytes_ = 0;
+  bool memory_budget_recovery_pending_ = false;
+
   Shell(DartVMRef vm,
         TaskRunners task_runners,
         fml::RefPtr<fml::RasterThreadMerger> parent_merger,
@@ -480,6 +582,7 @@ class Shell final : public PlatformView::Delegate,
   static std::unique_ptr<Shell> CreateShellOnPlatformThread(
       DartVMRef vm,
       fml::RefPtr<fml::RasterThreadMerger> parent_merger,
+      std::shared_ptr<ShellIOManager> parent_io_manager,
       TaskRunners task_runners,
       const PlatformData& platform_data,
       Settings settings,
@@ -492,6 +595,7 @@ class Shell final : public PlatformView::Delegate,
       const PlatformData& platform_data,
       TaskRunners task_runners,
       fml::RefPtr<fml::RasterThreadMerger> parent_thread_merger,
+      std::shared_ptr<ShellIOManager> parent_io_manager,
       Settings settings,
       DartVMRef vm,
       fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -503,10 +607,21 @@ class Shell final : public PlatformView::Delegate,
   bool Setup(std::unique_ptr<PlatformView> platform_view,
              std::unique_ptr<Engine> engine,
              std::unique_ptr<Rasterizer> rasterizer,
-             std::unique_ptr<ShellIOManager> io_manager);
+             std::shared_ptr<ShellIOManager> io_manager);
 
   void ReportTimings();
 
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  // Applies the budgets of |memory_budget_| to the caches.
+  void ApplyMemoryBudget();
+
+  // Shrinks the cache budgets after a low memory warning and schedules their
+  // recovery.
+  void OnMemoryPressure();
+
+  void ScheduleMemoryBudgetRecovery();
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -521,6 +636,21 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewDispatchPlatformMessage(
       std::unique_ptr<PlatformMessage> message) override;
 
+  // Queues a platform message for the UI thread, and returns the number of
+  // queued messages.
+  size_t AddPendingPlatformMessage(std::unique_ptr<PlatformMessage> message);
+
+  // Takes the next queued platform message for the UI thread, or returns null
+  // if there are none.
+  std::unique_ptr<PlatformMessage> TakeNextPendingPlatformMessage();
+
+  // Takes all of the queued platform messages for the UI thread, in the order
+  // they are dispatched.
+  std::deque<std::unique_ptr<PlatformMessage>> TakeAllPendingPlatformMessages();
+
+  void DispatchPlatformMessageToEngine(Engine* engine,
+                                       std::unique_ptr<PlatformMessage> message);
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchPointerDataPacket(
       std::unique_ptr<PointerDataPacket> packet) override;
@@ -560,6 +690,12 @@ class Shell final : public PlatformView::Delegate,
       std::unique_ptr<const fml::Mapping> snapshot_data,
       std::unique_ptr<const fml::Mapping> snapshot_instructions) override;
 
+  // |PlatformView::Delegate|
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions) override;
+
   void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                     const std::string error_message,
                                     bool transient) override;
@@ -590,6 +726,9 @@ class Shell final : public PlatformView::Delegate,
       SemanticsNodeUpdates update,
       CustomAccessibilityActionUpdates actions) override;
 
+  // Sends the merged semantics updates to the platform view.
+  void SendPendingSemanticsUpdate();
+
   // |Engine::Delegate|
   void OnEngineHandlePlatformMessage(
       std::unique_ptr<PlatformMessage> message) override;
@@ -684,6 +823,65 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Lists the entries of the raster cache along with the hit ratio of the
+  // cache, for tuning the cache thresholds.
+  bool OnServiceProtocolGetRasterCacheEntries(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the contention of the named fml locks. It's only recorded in the
+  // builds with `flutter_enable_lock_contention_tracking`.
+  bool OnServiceProtocolGetLockContention(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the traffic of each platform channel. It's only recorded when
+  // `Settings::enable_platform_channel_statistics` is set.
+  bool OnServiceProtocolGetPlatformChannelStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the native memory of the engine by subsystem, and what each of
+  // them freed in response to the last low memory warning.
+  bool OnServiceProtocolGetEngineMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the events of the flight recorder within the `durationMillis`
+  // parameter, and the events that preceded the last frame that missed a
+  // vsync.
+  bool OnServiceProtocolGetFlightRecord(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the percentiles and the jank counts of the recent frames, and the
+  // shader compilations and resource cache purges of the process. The frame
+  // statistics are cleared once reported if the `reset` parameter is "true".
+  bool OnServiceProtocolGetFrameTimingStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the raster time of each type of layer and of each layer. It's
+  // only recorded when `Settings::enable_layer_profiling` is set. The stats
+  // are cleared once reported if the `reset` parameter is "true".
+  bool OnServiceProtocolGetLayerProfile(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
@@ -4,12 +4,20 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <string>
+
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/startup_timings.h"
+#include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/gpu/gpu_surface_software.h"
+#include "flutter/testing/dart_fixture.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
@@ -120,4 +128,152 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+namespace {
+
+// Rasterizes into an offscreen surface, so that the first frame is rasterized
+// and presented without a GPU.
+class SoftwarePlatformView : public PlatformView,
+                             public GPUSurfaceSoftwareDelegate {
+ public:
+  SoftwarePlatformView(PlatformView::Delegate& delegate,
+                       TaskRunners task_runners)
+      : PlatformView(delegate, std::move(task_runners)) {}
+
+ private:
+  // |PlatformView|
+  std::unique_ptr<Surface> CreateRenderingSurface() override {
+    return std::make_unique<GPUSurfaceSoftware>(this, true);
+  }
+
+  // |GPUSurfaceSoftwareDelegate|
+  sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override {
+    if (!backing_store_ || backing_store_->width() != size.width() ||
+        backing_store_->height() != size.height()) {
+      backing_store_ =
+          SkSurface::MakeRasterN32Premul(size.width(), size.height());
+    }
+    return backing_store_;
+  }
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override {
+    return true;
+  }
+
+  sk_sp<SkSurface> backing_store_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SoftwarePlatformView);
+};
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Measures the startup of a shell in a new VM, from the start of its creation
+/// to the presentation of its first frame, and reports the duration of the
+/// phases of the startup on its critical path.
+///
+/// Each phase of the critical path of the last iteration is reported as a
+/// counter in milliseconds, along with the time spent waiting before it
+/// outside of any phase. The path itself is the label of the benchmark, e.g.
+/// "shell_creation(vm_initialization) > root_isolate_creation > ...", where
+/// the phases of the path that are nested in a phase are in parentheses.
+///
+static void BM_ShellStartupToFirstFrame(benchmark::State& state) {
+  testing::DartFixture fixture;
+  fixture.AddNativeCallback("NotifyNative",
+                            CREATE_NATIVE_ENTRY([](Dart_NativeArguments) {}));
+  std::vector<StartupTimings::CriticalPathStep> critical_path;
+
+  for (auto _ : state) {
+    // The phases are only recorded the first time they run in the process.
+    StartupTimings::ResetForTesting();
+    FML_CHECK(!DartVMRef::IsInstanceRunning());
+
+    auto settings = fixture.CreateSettingsForFixture();
+    fml::AutoResetWaitableEvent first_frame_latch;
+    settings.frame_rasterized_callback =
+        [&first_frame_latch](const FrameTiming&) {
+          first_frame_latch.Signal();
+        };
+    auto thread_host = std::make_unique<ThreadHost>(
+        "io.flutter.bench.", ThreadHost::Type::Platform |
+                                 ThreadHost::Type::RASTER |
+                                 ThreadHost::Type::IO | ThreadHost::Type::UI);
+    TaskRunners task_runners("test",
+                             thread_host->platform_thread->GetTaskRunner(),
+                             thread_host->raster_thread->GetTaskRunner(),
+                             thread_host->ui_thread->GetTaskRunner(),
+                             thread_host->io_thread->GetTaskRunner());
+
+    // The shell is created and run on the platform thread, as the embedders
+    // do.
+    std::unique_ptr<Shell> shell;
+    fml::AutoResetWaitableEvent run_latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners.GetPlatformTaskRunner(), [&]() {
+          shell = Shell::Create(
+              flutter::PlatformData(), task_runners, settings,
+              [](Shell& shell) {
+                return std::make_unique<SoftwarePlatformView>(
+                    shell, shell.GetTaskRunners());
+              },
+              [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+          FML_CHECK(shell);
+          shell->GetPlatformView()->NotifyCreated();
+          shell->GetPlatformView()->SetViewportMetrics(
+              ViewportMetrics(1.0, 800.0, 600.0, 22.0));
+          auto configuration = RunConfiguration::InferFromSettings(settings);
+          configuration.SetEntrypoint("drawFrames");
+          shell->RunEngine(std::move(configuration));
+          run_latch.Signal();
+        });
+    run_latch.Wait();
+    first_frame_latch.Wait();
+
+    const StartupTimings::Timings timings = StartupTimings::GetAll();
+    critical_path = StartupTimings::ComputeCriticalPath(timings);
+    FML_CHECK(!critical_path.empty());
+    const auto& shell_creation =
+        timings[static_cast<size_t>(StartupTimings::Phase::kShellCreation)];
+    fml::TimePoint end = shell_creation->end;
+    for (const auto& step : critical_path) {
+      end = std::max(end, step.interval.end);
+    }
+    state.SetIterationTime((end - shell_creation->start).ToSecondsF());
+
+    fml::AutoResetWaitableEvent shutdown_latch;
+    fml::TaskRunner::RunNowOrPostTask(task_runners.GetPlatformTaskRunner(),
+                                      [&shell, &shutdown_latch]() {
+                                        shell.reset();
+                                        shutdown_latch.Signal();
+                                      });
+    shutdown_latch.Wait();
+    thread_host.reset();
+  }
+
+  std::string label;
+  size_t depth = 0;
+  for (size_t i = 0; i < critical_path.size(); i++) {
+    const auto& step = critical_path[i];
+    for (; depth > step.depth; depth--) {
+      label += ")";
+    }
+    if (i > 0) {
+      label += depth < step.depth ? "(" : " > ";
+    }
+    depth = step.depth;
+    const std::string name = StartupTimings::GetPhaseName(step.phase);
+    label += name;
+    state.counters[name + "_ms"] =
+        (step.interval.end - step.interval.start).ToMillisecondsF();
+    state.counters[name + "_wait_ms"] = step.wait.ToMillisecondsF();
+  }
+  label += std::string(depth, ')');
+  state.SetLabel(label);
+}
+
+BENCHMARK(BM_ShellStartupToFirstFrame)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
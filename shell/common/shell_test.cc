@@ -262,6 +262,16 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kEstimateRasterCacheMemory:
             shell->OnServiceProtocolEstimateRasterCacheMemory(params, response);
             break;
+          case ServiceProtocolEnum::kGetRasterCacheEntries:
+            shell->OnServiceProtocolGetRasterCacheEntries(params, response);
+            break;
+          case ServiceProtocolEnum::kGetLockContention:
+            shell->OnServiceProtocolGetLockContention(params, response);
+            break;
+          case ServiceProtocolEnum::kGetPlatformChannelStatistics:
+            shell->OnServiceProtocolGetPlatformChannelStatistics(params,
+                                                                 response);
+            break;
           case ServiceProtocolEnum::kSetAssetBundlePath:
             shell->OnServiceProtocolSetAssetBundlePath(params, response);
             break;
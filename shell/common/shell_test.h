@@ -103,6 +103,9 @@ class ShellTest : public FixtureTest {
   enum ServiceProtocolEnum {
     kGetSkSLs,
     kEstimateRasterCacheMemory,
+    kGetRasterCacheEntries,
+    kGetLockContention,
+    kGetPlatformChannelStatistics,
     kSetAssetBundlePath,
     kRunInView,
   };
@@ -5,15 +5,18 @@
 #define FML_USED_ON_EMBEDDER
 
 #include <algorithm>
+#include <atomic>
 #include <ctime>
 #include <functional>
 #include <future>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "assets/directory_asset_bundle.h"
 #include "common/graphics/persistent_cache.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/display_list_serialization.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -23,9 +26,11 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/shader_warm_up.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_external_view_embedder.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -37,6 +42,7 @@
 #include "gmock/gmock.h"
 #include "third_party/rapidjson/include/rapidjson/writer.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
 #ifdef SHELL_ENABLE_VULKAN
@@ -93,6 +99,11 @@ class MockPlatformViewDelegate : public PlatformView::Delegate {
                     std::unique_ptr<const fml::Mapping> snapshot_data,
                     std::unique_ptr<const fml::Mapping> snapshot_instructions));
 
+  MOCK_METHOD3(PrefetchDartDeferredLibrary,
+               void(intptr_t loading_unit_id,
+                    std::unique_ptr<const fml::Mapping> snapshot_data,
+                    std::unique_ptr<const fml::Mapping> snapshot_instructions));
+
   MOCK_METHOD3(LoadDartDeferredLibraryError,
                void(intptr_t loading_unit_id,
                     const std::string error_message,
@@ -125,6 +136,9 @@ class MockPlatformView : public PlatformView {
   MOCK_METHOD0(CreateRenderingSurface, std::unique_ptr<Surface>());
   MOCK_CONST_METHOD0(GetPlatformMessageHandler,
                      std::shared_ptr<PlatformMessageHandler>());
+  MOCK_METHOD2(UpdateSemantics,
+               void(SemanticsNodeUpdates updates,
+                    CustomAccessibilityActionUpdates actions));
 };
 
 class MockPlatformMessageHandler : public PlatformMessageHandler {
@@ -348,6 +362,30 @@ TEST_F(ShellTest,
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, VsyncWaiterFallbackFollowsDisplayRefreshRate) {
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::UI);
+  auto ui_task_runner = thread_host.ui_thread->GetTaskRunner();
+  TaskRunners task_runners("test", ui_task_runner, ui_task_runner,
+                           ui_task_runner, ui_task_runner);
+  auto vsync_waiter = std::make_shared<VsyncWaiterFallback>(task_runners, true);
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TimeDelta frame_interval;
+  ui_task_runner->PostTask([&]() {
+    vsync_waiter->OnDisplayRefreshRateChanged(120.0);
+    vsync_waiter->AsyncWaitForVsync(
+        [&](std::unique_ptr<FrameTimingsRecorder> recorder) {
+          frame_interval =
+              recorder->GetVsyncTargetTime() - recorder->GetVsyncStartTime();
+          latch.Signal();
+        });
+  });
+  latch.Wait();
+
+  ASSERT_EQ(frame_interval, fml::TimeDelta::FromSecondsF(1.0 / 120.0));
+}
+
 TEST_F(ShellTest, InitializeWithDisabledGpu) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -537,6 +575,32 @@ TEST_F(ShellTest, NoNeedToReportTimingsByDefault) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, FirstFrameAllowsDeferredServiceIsolateStartup) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  PlatformViewNotifyCreated(shell.get());
+
+  // Stands in for the thread on which the VM creates the service isolate.
+  DartServiceIsolate::DeferStartup();
+  std::atomic<bool> started = false;
+  std::thread service_isolate_thread([&started]() {
+    DartServiceIsolate::WaitUntilStartupAllowed();
+    started = true;
+  });
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  EXPECT_FALSE(started);
+
+  // The frame releases the startup even though no timings are reported.
+  PumpOneFrame(shell.get());
+  ASSERT_FALSE(GetNeedsReportTimings(shell.get()));
+  service_isolate_thread.join();
+  EXPECT_TRUE(started);
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, NeedsReportTimingsIsSetWithCallback) {
   auto settings = CreateSettingsForFixture();
   std::unique_ptr<Shell> shell = CreateShell(settings);
@@ -2116,9 +2180,11 @@ TEST_F(ShellTest,
   DestroyShell(std::move(shell));
 
   const std::string expected_json1 =
-      "{\"type\":\"GetSkSLs\",\"SkSLs\":{\"II\":\"eQ==\",\"IE\":\"eA==\"}}";
+      "{\"type\":\"GetSkSLs\",\"SkSLs\":{\"II\":\"eQ==\",\"IE\":\"eA==\"},"
+      "\"SkSLUsage\":{}}";
   const std::string expected_json2 =
-      "{\"type\":\"GetSkSLs\",\"SkSLs\":{\"IE\":\"eA==\",\"II\":\"eQ==\"}}";
+      "{\"type\":\"GetSkSLs\",\"SkSLs\":{\"IE\":\"eA==\",\"II\":\"eQ==\"},"
+      "\"SkSLUsage\":{}}";
   bool json_is_expected = (expected_json1 == buffer.GetString()) ||
                           (expected_json2 == buffer.GetString());
   ASSERT_TRUE(json_is_expected) << buffer.GetString() << " is not equal to "
@@ -2156,6 +2222,88 @@ TEST_F(ShellTest, RasterizerScreenshot) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, RasterizerScreenshotAsyncMatchesScreenshot) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  PumpOneFrame(shell.get());
+
+  Rasterizer::Screenshot screenshot =
+      shell->Screenshot(Rasterizer::ScreenshotType::CompressedImage, true);
+  ASSERT_NE(screenshot.data, nullptr);
+
+  fml::AutoResetWaitableEvent latch;
+  std::string async_data;
+  size_t chunk_count = 0;
+  shell->ScreenshotAsync(
+      Rasterizer::ScreenshotType::CompressedImage, true,
+      [&](const Rasterizer::Screenshot& chunk, bool is_last) {
+        EXPECT_NE(chunk.data, nullptr);
+        if (chunk.data) {
+          EXPECT_LE(chunk.data->size(), Rasterizer::kScreenshotChunkSize);
+          EXPECT_EQ(chunk.frame_size, screenshot.frame_size);
+          async_data.append(static_cast<const char*>(chunk.data->data()),
+                            chunk.data->size());
+          chunk_count++;
+        }
+        if (is_last) {
+          latch.Signal();
+        }
+      });
+  latch.Wait();
+
+  EXPECT_GE(chunk_count, 1u);
+  EXPECT_EQ(async_data,
+            std::string(static_cast<const char*>(screenshot.data->data()),
+                        screenshot.data->size()));
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
+TEST_F(ShellTest, RasterizerScreenshotAsDisplayListCanWarmUpShaders) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  PumpOneFrame(shell.get());
+
+  Rasterizer::Screenshot screenshot =
+      shell->Screenshot(Rasterizer::ScreenshotType::DisplayList, false);
+  ASSERT_NE(screenshot.data, nullptr);
+  auto display_list = SerializedDisplayList::Make(
+      std::make_unique<fml::NonOwnedMapping>(screenshot.data->bytes(),
+                                             screenshot.data->size()));
+  ASSERT_NE(display_list, nullptr);
+
+  std::vector<std::unique_ptr<fml::Mapping>> display_lists;
+  display_lists.push_back(std::make_unique<fml::NonOwnedMapping>(
+      screenshot.data->bytes(), screenshot.data->size()));
+  // Data that isn't a display list is skipped.
+  display_lists.push_back(
+      std::make_unique<fml::DataMapping>(std::string("not a dl")));
+  sk_sp<GrDirectContext> context = GrDirectContext::MakeMock(nullptr);
+  WarmUpShadersWithDisplayLists(context.get(), std::move(display_lists));
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   Settings settings = CreateSettingsForFixture();
   auto configuration = RunConfiguration::InferFromSettings(settings);
@@ -2790,6 +2938,9 @@ TEST_F(ShellTest, Spawn) {
                    ASSERT_EQ("testCanLaunchSecondaryIsolate",
                              spawn->GetEngine()->GetLastEntrypoint());
                    ASSERT_EQ(initial_route, spawn->GetEngine()->InitialRoute());
+                   // The spawned engine keeps the assets of its spawner.
+                   ASSERT_EQ(spawner->GetEngine()->GetAssetManager(),
+                             spawn->GetEngine()->GetAssetManager());
 
                    // TODO(74520): Remove conditional once isolate groups are
                    // supported by JIT.
@@ -2809,6 +2960,8 @@ TEST_F(ShellTest, Spawn) {
 
         PostSync(
             spawner->GetTaskRunners().GetIOTaskRunner(), [&spawner, &spawn] {
+              ASSERT_EQ(spawner->GetIOManager().get(),
+                        spawn->GetIOManager().get());
               ASSERT_EQ(spawner->GetIOManager()->GetResourceContext().get(),
                         spawn->GetIOManager()->GetResourceContext().get());
             });
@@ -3236,5 +3389,134 @@ TEST_F(ShellTest, UsesPlatformMessageHandler) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, MergesSemanticsUpdatesWithinTheUpdateInterval) {
+  TaskRunners task_runners = GetTaskRunnersForFixture();
+  auto settings = CreateSettingsForFixture();
+  settings.semantics_update_interval_ms = 200;
+  MockPlatformViewDelegate platform_view_delegate;
+
+  // Only accessed on the platform thread while the shell runs.
+  std::vector<SemanticsNodeUpdates> updates;
+  std::vector<fml::TimePoint> update_times;
+  fml::CountDownLatch updates_latch(2);
+  Shell::CreateCallback<PlatformView> platform_view_create_callback =
+      [&](flutter::Shell& shell) {
+        auto result = std::make_unique<MockPlatformView>(platform_view_delegate,
+                                                         task_runners);
+        EXPECT_CALL(*result, UpdateSemantics(_, _))
+            .Times(2)
+            .WillRepeatedly(::testing::Invoke(
+                [&](SemanticsNodeUpdates update,
+                    CustomAccessibilityActionUpdates actions) {
+                  updates.push_back(std::move(update));
+                  update_times.push_back(fml::TimePoint::Now());
+                  updates_latch.CountDown();
+                }));
+        return result;
+      };
+  auto shell = CreateShell(
+      /*settings=*/std::move(settings),
+      /*task_runners=*/task_runners,
+      /*simulate_vsync=*/false,
+      /*shell_test_external_view_embedder=*/nullptr,
+      /*is_gpu_disabled=*/false,
+      /*rendering_backend=*/
+      ShellTestPlatformView::BackendType::kDefaultBackend,
+      /*platform_view_create_callback=*/platform_view_create_callback);
+
+  auto make_update = [](std::vector<std::pair<int32_t, std::string>> labels) {
+    SemanticsNodeUpdates update;
+    for (auto& [id, label] : labels) {
+      update[id].id = id;
+      update[id].label = label;
+    }
+    return update;
+  };
+  const fml::TimePoint start = fml::TimePoint::Now();
+  PostSync(task_runners.GetUITaskRunner(), [&shell, &make_update]() {
+    auto delegate = static_cast<Engine::Delegate*>(shell.get());
+    // Nothing was sent yet, so the first update goes out right away.
+    delegate->OnEngineUpdateSemantics(make_update({{1, "a"}, {2, "b"}}), {});
+    // The following ones wait for the end of the interval.
+    delegate->OnEngineUpdateSemantics(make_update({{4, "stale"}}), {});
+    // A restart drops the nodes of the previous isolate.
+    delegate->OnPreEngineRestart();
+    delegate->OnEngineUpdateSemantics(make_update({{1, "c"}, {3, "d"}}), {});
+    delegate->OnEngineUpdateSemantics(make_update({{3, "e"}}), {});
+  });
+  updates_latch.Wait();
+
+  ASSERT_EQ(updates.size(), 2u);
+  ASSERT_EQ(updates[0].size(), 2u);
+  EXPECT_EQ(updates[0][1].label, "a");
+  EXPECT_EQ(updates[0][2].label, "b");
+  // The delayed updates arrive as one, with the latest copy of each node.
+  ASSERT_EQ(updates[1].size(), 2u);
+  EXPECT_EQ(updates[1][1].label, "c");
+  EXPECT_EQ(updates[1][3].label, "e");
+  EXPECT_GE(update_times[1], start + fml::TimeDelta::FromMilliseconds(200));
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
+TEST_F(ShellTest, BatchesPlatformMessagesSentWhileUIThreadIsBusy) {
+  auto settings = CreateSettingsForFixture();
+  settings.batch_platform_messages = true;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  auto platform_task_runner = shell->GetTaskRunners().GetPlatformTaskRunner();
+  auto ui_task_runner = shell->GetTaskRunners().GetUITaskRunner();
+
+  // Only accessed on the UI thread while the shell runs.
+  std::vector<std::string> handled;
+  fml::AutoResetWaitableEvent latch;
+  AddNativeCallback("NotifyNative", CREATE_NATIVE_ENTRY([&latch](auto args) {
+                      latch.Signal();
+                    }));
+  AddNativeCallback("NotifyMessage",
+                    CREATE_NATIVE_ENTRY([&handled](Dart_NativeArguments args) {
+                      handled.push_back(
+                          tonic::DartConverter<std::string>::FromDart(
+                              Dart_GetNativeArgument(args, 0)));
+                    }));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("notifyPlatformMessages");
+  RunEngine(shell.get(), std::move(configuration));
+  latch.Wait();
+
+  auto send = [&shell](const std::string& text) {
+    shell->GetPlatformView()->DispatchPlatformMessage(
+        std::make_unique<PlatformMessage>(
+            "test/batch", fml::MallocMapping::Copy(text.c_str(), text.length()),
+            nullptr));
+  };
+
+  // Keeps the UI thread busy while the platform sends the messages.
+  fml::AutoResetWaitableEvent ui_busy;
+  fml::AutoResetWaitableEvent ui_released;
+  ui_task_runner->PostTask([&ui_busy, &ui_released]() {
+    ui_busy.Signal();
+    ui_released.Wait();
+  });
+  ui_busy.Wait();
+  PostSync(platform_task_runner, [&send, &handled, &ui_task_runner]() {
+    send("a");
+    ui_task_runner->PostTask([&handled]() { handled.push_back("task"); });
+    send("b");
+    send("c");
+  });
+  ui_released.Signal();
+  PostSync(ui_task_runner, []() {});
+
+  // The messages are handled in order, in the task of the first of them.
+  EXPECT_EQ(handled, std::vector<std::string>({"a", "b", "c", "task"}));
+
+  // Once the batch is flushed, the next message starts a new one.
+  PostSync(platform_task_runner, [&send]() { send("d"); });
+  PostSync(ui_task_runner, []() {});
+  EXPECT_EQ(handled, std::vector<std::string>({"a", "b", "c", "task", "d"}));
+
+  DestroyShell(std::move(shell));
+}
+
 }  // namespace testing
 }  // namespace flutter
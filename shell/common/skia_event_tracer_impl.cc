@@ -9,8 +9,10 @@
 #include <set>
 #include <vector>
 
+#include "flutter/common/graphics/skia_gpu_statistics.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/posix_wrappers.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/skia/include/utils/SkEventTracer.h"
@@ -60,6 +62,11 @@ constexpr char kDevtoolsTagArg[] = "devtoolsTag";
 constexpr char kShadersDevtoolsTag[] = "shaders";
 #endif  // !defined(OS_FUCHSIA)
 
+// The nesting of the shader events of the current thread, and the start of
+// the outermost one, which is the compilation of the shader.
+thread_local int gShaderEventDepth = 0;
+thread_local fml::TimePoint gShaderCompilationStart;
+
 #if defined(OS_FUCHSIA)
 template <class T, class U>
 inline T BitCast(const U& u) {
@@ -81,7 +88,9 @@ class FlutterEventTracer : public SkEventTracer {
 
   FlutterEventTracer(bool enabled,
                      const std::optional<std::vector<std::string>>& allowlist)
-      : enabled_(enabled ? kYes : kNo), shaders_category_flag_(nullptr) {
+      : enabled_(enabled ? kYes : kNo),
+        shaders_category_flag_(nullptr),
+        shaders_traced_(false) {
     if (allowlist.has_value()) {
       allowlist_.emplace();
       for (const std::string& category : *allowlist) {
@@ -99,6 +108,15 @@ class FlutterEventTracer : public SkEventTracer {
                                       const uint8_t* p_arg_types,
                                       const uint64_t* p_arg_values,
                                       uint8_t flags) override {
+    if (shaders_category_flag_ &&
+        category_enabled_flag == shaders_category_flag_) {
+      if (phase == TRACE_EVENT_PHASE_COMPLETE && gShaderEventDepth++ == 0) {
+        gShaderCompilationStart = fml::TimePoint::Now();
+      }
+      if (!shaders_traced_) {
+        return 0;
+      }
+    }
 #if defined(OS_FUCHSIA)
     static trace_site_t trace_site;
     trace_string_ref_t category_ref;
@@ -263,6 +281,17 @@ class FlutterEventTracer : public SkEventTracer {
   void updateTraceEventDuration(const uint8_t* category_enabled_flag,
                                 const char* name,
                                 SkEventTracer::Handle handle) override {
+    if (shaders_category_flag_ &&
+        category_enabled_flag == shaders_category_flag_) {
+      if (gShaderEventDepth > 0 && --gShaderEventDepth == 0) {
+        SkiaGpuStatistics::GetInstance().RecordShaderCompilation(
+            gShaderCompilationStart,
+            fml::TimePoint::Now() - gShaderCompilationStart);
+      }
+      if (!shaders_traced_) {
+        return;
+      }
+    }
     // This is only ever called from a scoped trace event so we will just end
     // the section.
 #if defined(OS_FUCHSIA)
@@ -283,10 +312,17 @@ class FlutterEventTracer : public SkEventTracer {
       } else {
         allowed = false;
       }
+      // The shader events are always enabled for the statistics of the
+      // compilations, and only forwarded to the timeline when allowed.
+      const bool is_shaders_category = kShaderCategoryName == name;
+      if (is_shaders_category) {
+        shaders_traced_ = allowed;
+        allowed = true;
+      }
       flag_it = category_flag_map_.insert(std::make_pair(name, allowed)).first;
       const uint8_t* flag = &flag_it->second;
       reverse_flag_map_.insert(std::make_pair(flag, name));
-      if (kShaderCategoryName == name) {
+      if (is_shaders_category) {
         shaders_category_flag_ = flag;
       }
     }
@@ -309,6 +345,7 @@ class FlutterEventTracer : public SkEventTracer {
   std::map<const char*, uint8_t> category_flag_map_;
   std::map<const uint8_t*, const char*> reverse_flag_map_;
   const uint8_t* shaders_category_flag_;
+  bool shaders_traced_;
   FML_DISALLOW_COPY_AND_ASSIGN(FlutterEventTracer);
 };
 
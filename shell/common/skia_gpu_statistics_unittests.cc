@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/skia_gpu_statistics.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(SkiaGpuStatisticsTest, CountsTheShaderCompilationsAndPurges) {
+  SkiaGpuStatistics statistics;
+  const fml::TimePoint now = fml::TimePoint::Now();
+  statistics.RecordShaderCompilation(now, fml::TimeDelta::FromMilliseconds(3));
+  statistics.RecordShaderCompilation(now, fml::TimeDelta::FromMilliseconds(5));
+  statistics.RecordResourceCachePurge(1024);
+
+  const SkiaGpuCounters counters = statistics.GetCounters();
+  EXPECT_EQ(counters.shader_compile_count, 2u);
+  EXPECT_EQ(counters.shader_compile_duration,
+            fml::TimeDelta::FromMilliseconds(8));
+  EXPECT_EQ(counters.resource_cache_purge_count, 1u);
+  EXPECT_EQ(counters.resource_cache_purged_bytes, 1024u);
+}
+
+TEST(SkiaGpuStatisticsTest, AttachesTheKeysToTheCompilationsOfTheThread) {
+  SkiaGpuStatistics statistics;
+  const fml::TimePoint now = fml::TimePoint::Now();
+  statistics.RecordShaderCompilation(now, fml::TimeDelta::FromMilliseconds(1));
+  std::thread([&statistics, now]() {
+    statistics.RecordShaderCompilation(now,
+                                       fml::TimeDelta::FromMilliseconds(2));
+  }).join();
+  statistics.RecordShaderKey("AAAA");
+  // A key that follows a compilation that already has one is dropped.
+  statistics.RecordShaderKey("BBBB");
+
+  const auto compilations = statistics.GetRecentShaderCompilations();
+  ASSERT_EQ(compilations.size(), 2u);
+  EXPECT_EQ(compilations[0].key, "AAAA");
+  EXPECT_EQ(compilations[0].duration, fml::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(compilations[1].key, "");
+}
+
+TEST(SkiaGpuStatisticsTest, OnlyKeepsTheRecentCompilations) {
+  SkiaGpuStatistics statistics;
+  const fml::TimePoint now = fml::TimePoint::Now();
+  for (size_t i = 0; i < SkiaGpuStatistics::kMaxRecentShaderCompilations + 2;
+       i++) {
+    statistics.RecordShaderCompilation(now,
+                                       fml::TimeDelta::FromMicroseconds(i));
+  }
+  const auto compilations = statistics.GetRecentShaderCompilations();
+  ASSERT_EQ(compilations.size(),
+            SkiaGpuStatistics::kMaxRecentShaderCompilations);
+  EXPECT_EQ(compilations.front().duration, fml::TimeDelta::FromMicroseconds(2));
+  EXPECT_EQ(statistics.GetCounters().shader_compile_count,
+            SkiaGpuStatistics::kMaxRecentShaderCompilations + 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
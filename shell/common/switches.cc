@@ -232,6 +232,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_observatory =
       !command_line.HasOption(FlagForSwitch(Switch::DisableObservatory));
 
+  settings.lazy_service_isolate_startup =
+      command_line.HasOption(FlagForSwitch(Switch::LazyServiceIsolateStartup));
+
   // Enable mDNS Observatory Publication
   settings.enable_observatory_publication = !command_line.HasOption(
       FlagForSwitch(Switch::DisableObservatoryPublication));
@@ -290,6 +293,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_vulkan =
+      command_line.HasOption(FlagForSwitch(Switch::EnableVulkan));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -380,6 +386,11 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::SnapshotPrefetchProfile),
+                              &settings.snapshot_prefetch_profile_path);
+  settings.record_snapshot_prefetch_profile = command_line.HasOption(
+      FlagForSwitch(Switch::RecordSnapshotPrefetchProfile));
+
   if (settings.icu_initialization_required) {
     command_line.GetOptionValue(FlagForSwitch(Switch::ICUDataFilePath),
                                 &settings.icu_data_path);
@@ -406,9 +417,88 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_skparagraph =
       command_line.HasOption(FlagForSwitch(Switch::EnableSkParagraph));
 
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+
+  settings.enable_raster_cache_atlas =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterCacheAtlas));
+
+  settings.enable_shared_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableSharedRasterCache));
+
+  settings.enable_parallel_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableParallelPreroll));
+
+  settings.enable_parallel_software_raster = command_line.HasOption(
+      FlagForSwitch(Switch::EnableParallelSoftwareRaster));
+
+  settings.enable_adaptive_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptivePipelineDepth));
+
+  std::string frame_pacing_policy;
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::FramePacingPolicy),
+                                  &frame_pacing_policy)) {
+    if (frame_pacing_policy == "low-latency") {
+      settings.frame_pacing_policy = FramePacingPolicy::kLowLatency;
+    } else if (frame_pacing_policy == "smooth") {
+      settings.frame_pacing_policy = FramePacingPolicy::kSmooth;
+    }
+  }
+
+  settings.enable_raster_frame_skipping =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterFrameSkipping));
+
+  settings.enable_submit_thread =
+      command_line.HasOption(FlagForSwitch(Switch::EnableSubmitThread));
+
+  settings.enable_gpu_frame_timing =
+      command_line.HasOption(FlagForSwitch(Switch::EnableGpuFrameTiming));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DecodedImageCacheMaxBytes))) {
+    if (!GetSwitchValue(command_line, Switch::DecodedImageCacheMaxBytes,
+                        &settings.decoded_image_cache_max_bytes)) {
+      FML_LOG(INFO) << "Decoded image cache size specified was malformed. "
+                       "Will default to "
+                    << settings.decoded_image_cache_max_bytes;
+    }
+  }
+
+  settings.enable_compact_opaque_images =
+      command_line.HasOption(FlagForSwitch(Switch::EnableCompactOpaqueImages));
+
+  settings.defer_image_uploads =
+      command_line.HasOption(FlagForSwitch(Switch::DeferImageUploads));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::TextLayoutCacheMaxBytes))) {
+    if (!GetSwitchValue(command_line, Switch::TextLayoutCacheMaxBytes,
+                        &settings.text_layout_cache_max_bytes)) {
+      FML_LOG(INFO) << "Text layout cache size specified was malformed. Will "
+                       "default to "
+                    << settings.text_layout_cache_max_bytes;
+    }
+  }
+
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
+  settings.warm_up_glyph_cache =
+      command_line.HasOption(FlagForSwitch(Switch::WarmUpGlyphCache));
+
+  settings.batch_platform_messages =
+      command_line.HasOption(FlagForSwitch(Switch::BatchPlatformMessages));
+
+  settings.enable_platform_channel_statistics = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePlatformChannelStatistics));
+
+  std::string high_priority_platform_channels;
+  if (command_line.GetOptionValue(
+          FlagForSwitch(Switch::HighPriorityPlatformChannels),
+          &high_priority_platform_channels)) {
+    settings.high_priority_platform_channels =
+        ParseCommaDelimited(high_priority_platform_channels);
+  }
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
@@ -442,6 +532,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.cache_sksl =
       command_line.HasOption(FlagForSwitch(Switch::CacheSkSL));
 
+  settings.precompile_sksls_incrementally = command_line.HasOption(
+      FlagForSwitch(Switch::PrecompileSkSLsIncrementally));
+
+  settings.warm_up_shaders_with_display_lists = command_line.HasOption(
+      FlagForSwitch(Switch::WarmUpShadersWithDisplayLists));
+
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
@@ -451,6 +547,27 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
                                 &old_gen_heap_size);
     settings.old_gen_heap_size = std::stoi(old_gen_heap_size);
   }
+
+  settings.enable_pointer_resampling =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerResampling));
+
+  settings.prioritize_pointer_events =
+      command_line.HasOption(FlagForSwitch(Switch::PrioritizePointerEvents));
+
+  settings.enable_layer_profiling =
+      command_line.HasOption(FlagForSwitch(Switch::EnableLayerProfiling));
+
+  settings.defer_layer_tree_construction =
+      command_line.HasOption(FlagForSwitch(Switch::DeferLayerTreeConstruction));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::SemanticsUpdateInterval))) {
+    if (!GetSwitchValue(command_line, Switch::SemanticsUpdateInterval,
+                        &settings.semantics_update_interval_ms)) {
+      FML_LOG(INFO) << "Semantics update interval specified was malformed. "
+                       "Will default to "
+                    << settings.semantics_update_interval_ms;
+    }
+  }
   return settings;
 }
 
@@ -58,6 +58,16 @@ DEF_SWITCH(CacheDirPath,
            "Path to the cache directory. "
            "This is different from the persistent_cache_path in embedder.h, "
            "which is used for Skia shader cache.")
+DEF_SWITCH(SnapshotPrefetchProfile,
+           "snapshot-prefetch-profile",
+           "Path to a profile of the snapshot pages accessed during startup. "
+           "Those pages are read ahead from a background thread while the VM "
+           "is initialized, instead of being faulted in one at a time.")
+DEF_SWITCH(RecordSnapshotPrefetchProfile,
+           "record-snapshot-prefetch-profile",
+           "Record the snapshot pages accessed until the first frame has been "
+           "rasterized to the path of --snapshot-prefetch-profile, on a cold "
+           "test run of the application, instead of prefetching them.")
 DEF_SWITCH(ICUDataFilePath, "icu-data-file-path", "Path to the ICU data file.")
 DEF_SWITCH(ICUSymbolPrefix,
            "icu-symbol-prefix",
@@ -83,6 +93,10 @@ DEF_SWITCH(DisableObservatory,
            "disable-observatory",
            "Disable the Dart Observatory. The observatory is never available "
            "in release mode.")
+DEF_SWITCH(LazyServiceIsolateStartup,
+           "lazy-service-isolate-startup",
+           "Starts the Dart Observatory after the first frame instead of "
+           "during the launch of the engine.")
 DEF_SWITCH(DisableObservatoryPublication,
            "disable-observatory-publication",
            "Disable mDNS Dart Observatory publication.")
@@ -105,6 +119,10 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableVulkan,
+           "enable-vulkan",
+           "Render with Vulkan rather than OpenGL ES on Android. Devices "
+           "without a usable Vulkan driver fall back to OpenGL ES.")
 DEF_SWITCH(SkiaDeterministicRendering,
            "skia-deterministic-rendering",
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
@@ -156,6 +174,19 @@ DEF_SWITCH(CacheSkSL,
            "should only be used during development phases. The generated SkSLs "
            "can later be used in the release build for shader precompilation "
            "at launch in order to eliminate the shader-compile jank.")
+DEF_SWITCH(PrecompileSkSLsIncrementally,
+           "precompile-sksls-incrementally",
+           "Precompile the SkSLs gathered in previous runs, or packaged with "
+           "the application, a few at a time between the frames, instead of "
+           "blocking the first frame until they are all compiled. The shaders "
+           "that a frame needs before they are precompiled are compiled by "
+           "that frame.")
+DEF_SWITCH(WarmUpShadersWithDisplayLists,
+           "warm-up-shaders-with-display-lists",
+           "Replay the serialized display lists packaged with the application "
+           "in its shaders directory, such as the ones dumped with "
+           "--dump-skp-on-shader-compilation, on the IO thread at launch, so "
+           "that the shaders they need are built before the first frames.")
 DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
@@ -177,6 +208,19 @@ DEF_SWITCH(PrefetchedDefaultFontManager,
            "prefetched-default-font-manager",
            "Indicates whether the embedding started a prefetch of the "
            "default font manager before creating the engine.")
+DEF_SWITCH(BatchPlatformMessages,
+           "batch-platform-messages",
+           "Dispatches the platform messages that are sent while the UI "
+           "thread is busy in a single UI task, in order.")
+DEF_SWITCH(EnablePlatformChannelStatistics,
+           "enable-platform-channel-statistics",
+           "Records the traffic of each platform channel, which is reported "
+           "by the _flutter.getPlatformChannelStatistics service extension.")
+DEF_SWITCH(HighPriorityPlatformChannels,
+           "high-priority-platform-channels",
+           "The comma separated list of the platform channels whose messages "
+           "are dispatched ahead of the other waiting platform messages. "
+           "Defaults to the lifecycle, navigation and key event channels.")
 DEF_SWITCH(VerboseLogging,
            "verbose-logging",
            "By default, only errors are logged. This flag enabled logging at "
@@ -214,6 +258,89 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(EnableSkParagraph,
            "enable-skparagraph",
            "Selects the SkParagraph implementation of the text layout engine.")
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Rasterize display list raster cache entries on the IO thread "
+           "instead of during the frame that first asks for them.")
+DEF_SWITCH(EnableRasterCacheAtlas,
+           "enable-raster-cache-atlas",
+           "Pack small raster cache entries into a shared texture atlas "
+           "instead of allocating a texture for each of them.")
+DEF_SWITCH(EnableSharedRasterCache,
+           "enable-shared-raster-cache",
+           "Share the raster cache of a shell with the shells that are "
+           "spawned from it.")
+DEF_SWITCH(EnableParallelPreroll,
+           "enable-parallel-preroll",
+           "Preroll independent layer subtrees concurrently on worker "
+           "threads.")
+DEF_SWITCH(EnableParallelSoftwareRaster,
+           "enable-parallel-software-raster",
+           "Rasterize the frames of software surfaces in bands on worker "
+           "threads.")
+DEF_SWITCH(EnableAdaptivePipelineDepth,
+           "enable-adaptive-pipeline-depth",
+           "Adapt the number of frames that can be queued between the UI and "
+           "raster threads to the durations of recent frames.")
+DEF_SWITCH(FramePacingPolicy,
+           "frame-pacing-policy",
+           "When frames begin relative to vsync. 'low-latency' begins them "
+           "as late as recent frame durations allow, 'smooth' begins them "
+           "before vsync while frames take longer than a frame interval.")
+DEF_SWITCH(EnableRasterFrameSkipping,
+           "enable-raster-frame-skipping",
+           "Discard frames that are already late on the raster thread when a "
+           "newer frame is waiting to be rasterized.")
+DEF_SWITCH(EnableSubmitThread,
+           "enable-submit-thread",
+           "Present frames from a separate thread on surfaces that support "
+           "it, instead of waiting for the buffer swap on the raster thread.")
+DEF_SWITCH(EnableGpuFrameTiming,
+           "enable-gpu-frame-timing",
+           "Measure the GPU time of each frame with GPU timer queries on the "
+           "surfaces that support them, and report it in the frame timings "
+           "and on the timeline.")
+DEF_SWITCH(DecodedImageCacheMaxBytes,
+           "decoded-image-cache-max-bytes",
+           "The number of bytes of decoded images to keep for reuse when the "
+           "same encoded image is decoded again at the same size.")
+DEF_SWITCH(EnableCompactOpaqueImages,
+           "enable-compact-opaque-images",
+           "Store the decoded opaque images with 16 bits per pixel, which "
+           "halves their memory but dithers their colors.")
+DEF_SWITCH(DeferImageUploads,
+           "defer-image-uploads",
+           "Upload the decoded images to the GPU when they are first drawn "
+           "instead of as soon as they are decoded.")
+DEF_SWITCH(TextLayoutCacheMaxBytes,
+           "text-layout-cache-max-bytes",
+           "The number of bytes of shaped words to keep for reuse when the "
+           "same words are laid out again.")
+DEF_SWITCH(SemanticsUpdateInterval,
+           "semantics-update-interval-ms",
+           "The minimum number of milliseconds between two semantics updates "
+           "sent to the platform. The updates produced in between are merged "
+           "into one.")
+DEF_SWITCH(EnablePointerResampling,
+           "enable-pointer-resampling",
+           "Dispatches one move per touch or stylus each frame, resampled at "
+           "the target time of the frame.")
+DEF_SWITCH(PrioritizePointerEvents,
+           "prioritize-pointer-events",
+           "Delivers pointer events to the UI thread ahead of the other tasks "
+           "that are waiting for it.")
+DEF_SWITCH(EnableLayerProfiling,
+           "enable-layer-profiling",
+           "Records the raster time of each layer, which is reported by the "
+           "_flutter.getLayerProfile service extension.")
+DEF_SWITCH(DeferLayerTreeConstruction,
+           "defer-layer-tree-construction",
+           "Records the layers added to a scene and builds its layer tree on "
+           "the raster thread instead of the UI thread.")
+DEF_SWITCH(WarmUpGlyphCache,
+           "warm-up-glyph-cache",
+           "Rasterizes the glyphs that the first frames of the previous launch "
+           "drew into the glyph cache while the app starts.")
 
 DEF_SWITCHES_END
 
@@ -46,5 +46,59 @@ TEST(SwitchesTest, SkiaTraceAllowlistFlag) {
 #endif
 }
 
+TEST(SwitchesTest, HighPriorityPlatformChannelsFlag) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.high_priority_platform_channels.size(), 3ul);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--high-priority-platform-channels=aaa,bbb"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.high_priority_platform_channels,
+            std::vector<std::string>({"aaa", "bbb"}));
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--high-priority-platform-channels="});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.high_priority_platform_channels.empty());
+}
+
+TEST(SwitchesTest, SemanticsUpdateIntervalFlag) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.semantics_update_interval_ms, 0u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--semantics-update-interval-ms=100"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.semantics_update_interval_ms, 100u);
+
+  // A malformed value keeps the default instead of throwing.
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--semantics-update-interval-ms=soon"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.semantics_update_interval_ms, 0u);
+}
+
+TEST(SwitchesTest, TextLayoutCacheMaxBytesFlag) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.text_layout_cache_max_bytes, 2u * 1024 * 1024);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--text-layout-cache-max-bytes=1000"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.text_layout_cache_max_bytes, 1000u);
+
+  // A malformed value keeps the default instead of throwing.
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--text-layout-cache-max-bytes=lots"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.text_layout_cache_max_bytes, 2u * 1024 * 1024);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,30 +6,94 @@
 
 namespace flutter {
 
+ThreadHost::ThreadHostConfig::ThreadHostConfig(
+    const std::string& name_prefix,
+    uint64_t type_mask,
+    const ThreadConfigSetter& setter)
+    : name_prefix(name_prefix), type_mask(type_mask), config_setter(setter) {}
+
+ThreadHost::ThreadHostConfig
+ThreadHost::ThreadHostConfig::MakePerformanceCoreConfig(
+    const std::string& name_prefix,
+    uint64_t type_mask,
+    const ThreadConfigSetter& setter) {
+  ThreadHostConfig host_config(name_prefix, type_mask, setter);
+  host_config.ui_config =
+      ThreadConfig(name_prefix + ".ui", fml::Thread::ThreadPriority::kDisplay,
+                   fml::CpuAffinity::kNotEfficiency);
+  host_config.raster_config = ThreadConfig(
+      name_prefix + ".raster", fml::Thread::ThreadPriority::kRaster,
+      fml::CpuAffinity::kNotEfficiency);
+  host_config.io_config = ThreadConfig(
+      name_prefix + ".io", fml::Thread::ThreadPriority::kBackground);
+  return host_config;
+}
+
+ThreadHost::ThreadConfig ThreadHost::ThreadHostConfig::GetConfig(
+    Type type) const {
+  const std::optional<ThreadConfig>* config = nullptr;
+  std::string suffix;
+  switch (type) {
+    case Type::Platform:
+      config = &platform_config;
+      suffix = ".platform";
+      break;
+    case Type::UI:
+      config = &ui_config;
+      suffix = ".ui";
+      break;
+    case Type::RASTER:
+      config = &raster_config;
+      suffix = ".raster";
+      break;
+    case Type::IO:
+      config = &io_config;
+      suffix = ".io";
+      break;
+    case Type::Profiler:
+      config = &profiler_config;
+      suffix = ".profiler";
+      break;
+  }
+  if (config != nullptr && config->has_value()) {
+    return config->value();
+  }
+  return ThreadConfig(name_prefix + suffix);
+}
+
 ThreadHost::ThreadHost() = default;
 
 ThreadHost::ThreadHost(ThreadHost&&) = default;
 
 ThreadHost::ThreadHost(std::string name_prefix_arg, uint64_t mask)
-    : name_prefix(name_prefix_arg) {
+    : ThreadHost(ThreadHostConfig(name_prefix_arg, mask)) {}
+
+ThreadHost::ThreadHost(const ThreadHostConfig& host_config)
+    : name_prefix(host_config.name_prefix) {
+  const uint64_t mask = host_config.type_mask;
+  auto create_thread = [&host_config](Type type) {
+    return std::make_unique<fml::Thread>(host_config.config_setter,
+                                         host_config.GetConfig(type));
+  };
+
   if (mask & ThreadHost::Type::Platform) {
-    platform_thread = std::make_unique<fml::Thread>(name_prefix + ".platform");
+    platform_thread = create_thread(ThreadHost::Type::Platform);
   }
 
   if (mask & ThreadHost::Type::UI) {
-    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui");
+    ui_thread = create_thread(ThreadHost::Type::UI);
   }
 
   if (mask & ThreadHost::Type::RASTER) {
-    raster_thread = std::make_unique<fml::Thread>(name_prefix + ".raster");
+    raster_thread = create_thread(ThreadHost::Type::RASTER);
   }
 
   if (mask & ThreadHost::Type::IO) {
-    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io");
+    io_thread = create_thread(ThreadHost::Type::IO);
   }
 
   if (mask & ThreadHost::Type::Profiler) {
-    profiler_thread = std::make_unique<fml::Thread>(name_prefix + ".profiler");
+    profiler_thread = create_thread(ThreadHost::Type::Profiler);
   }
 }
 
@@ -6,6 +6,8 @@
 #define FLUTTER_SHELL_COMMON_THREAD_HOST_H_
 
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/thread.h"
@@ -14,6 +16,9 @@ namespace flutter {
 
 /// The collection of all the threads used by the engine.
 struct ThreadHost {
+  using ThreadConfig = fml::Thread::ThreadConfig;
+  using ThreadConfigSetter = fml::Thread::ThreadConfigSetter;
+
   enum Type {
     Platform = 1 << 0,
     UI = 1 << 1,
@@ -22,6 +27,40 @@ struct ThreadHost {
     Profiler = 1 << 4,
   };
 
+  /// Which threads a `ThreadHost` starts and how each of them is configured.
+  struct ThreadHostConfig {
+    explicit ThreadHostConfig(
+        const std::string& name_prefix = "",
+        uint64_t type_mask = 0,
+        const ThreadConfigSetter& setter =
+            fml::Thread::SetCurrentThreadConfig);
+
+    /// The built-in policy for the engine threads. The UI and raster threads
+    /// get the display and raster priorities and are kept off the slowest
+    /// cores of heterogeneous CPUs, where migrations of the scheduler make
+    /// frame times vary. The IO thread gets the background priority.
+    static ThreadHostConfig MakePerformanceCoreConfig(
+        const std::string& name_prefix,
+        uint64_t type_mask,
+        const ThreadConfigSetter& setter =
+            fml::Thread::SetCurrentThreadConfig);
+
+    /// The config of the thread of \p type. Threads without an explicit
+    /// config are named after the prefix and their type and run with the
+    /// normal priority on any core.
+    ThreadConfig GetConfig(Type type) const;
+
+    std::string name_prefix;
+    uint64_t type_mask;
+    ThreadConfigSetter config_setter;
+
+    std::optional<ThreadConfig> platform_config;
+    std::optional<ThreadConfig> ui_config;
+    std::optional<ThreadConfig> raster_config;
+    std::optional<ThreadConfig> io_config;
+    std::optional<ThreadConfig> profiler_config;
+  };
+
   std::string name_prefix;
   std::unique_ptr<fml::Thread> platform_thread;
   std::unique_ptr<fml::Thread> ui_thread;
@@ -37,6 +76,8 @@ struct ThreadHost {
 
   ThreadHost(std::string name_prefix, uint64_t type_mask);
 
+  explicit ThreadHost(const ThreadHostConfig& host_config);
+
   ~ThreadHost();
 };
 
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/thread_host.h"
+
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ThreadHostTest, DefaultConfigsAreNamedAfterTheirType) {
+  ThreadHost::ThreadHostConfig host_config("prefix", ThreadHost::Type::UI);
+  auto config = host_config.GetConfig(ThreadHost::Type::UI);
+  ASSERT_EQ(config.name, "prefix.ui");
+  ASSERT_EQ(config.priority, fml::Thread::ThreadPriority::kNormal);
+  ASSERT_FALSE(config.affinity.has_value());
+}
+
+TEST(ThreadHostTest, PerformanceCoreConfigKeepsFrameThreadsOffSlowCores) {
+  auto host_config = ThreadHost::ThreadHostConfig::MakePerformanceCoreConfig(
+      "prefix", ThreadHost::Type::UI | ThreadHost::Type::RASTER |
+                    ThreadHost::Type::IO);
+  auto ui_config = host_config.GetConfig(ThreadHost::Type::UI);
+  ASSERT_EQ(ui_config.name, "prefix.ui");
+  ASSERT_EQ(ui_config.priority, fml::Thread::ThreadPriority::kDisplay);
+  ASSERT_EQ(ui_config.affinity, fml::CpuAffinity::kNotEfficiency);
+
+  auto raster_config = host_config.GetConfig(ThreadHost::Type::RASTER);
+  ASSERT_EQ(raster_config.priority, fml::Thread::ThreadPriority::kRaster);
+  ASSERT_EQ(raster_config.affinity, fml::CpuAffinity::kNotEfficiency);
+
+  auto io_config = host_config.GetConfig(ThreadHost::Type::IO);
+  ASSERT_EQ(io_config.priority, fml::Thread::ThreadPriority::kBackground);
+  ASSERT_FALSE(io_config.affinity.has_value());
+}
+
+TEST(ThreadHostTest, AppliesConfigsWithTheSetterOfTheHost) {
+  std::mutex mutex;
+  std::set<std::string> names;
+  ThreadHost::ThreadHostConfig host_config(
+      "prefix", ThreadHost::Type::UI | ThreadHost::Type::IO,
+      [&](const fml::Thread::ThreadConfig& config) {
+        std::scoped_lock lock(mutex);
+        names.insert(config.name);
+      });
+  host_config.io_config = fml::Thread::ThreadConfig("custom.io");
+
+  ThreadHost thread_host(host_config);
+  ASSERT_TRUE(thread_host.ui_thread);
+  ASSERT_TRUE(thread_host.io_thread);
+  ASSERT_FALSE(thread_host.raster_thread);
+  std::scoped_lock lock(mutex);
+  ASSERT_EQ(names, std::set<std::string>({"prefix.ui", "custom.io"}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -94,6 +94,11 @@ void VsyncWaiter::ScheduleSecondaryCallback(uintptr_t id,
   AwaitVSyncForSecondaryCallback();
 }
 
+fml::TimePoint VsyncWaiter::GetLastFrameTargetTime() {
+  std::scoped_lock lock(callback_mutex_);
+  return last_frame_target_time_;
+}
+
 void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
                                fml::TimePoint frame_target_time,
                                bool pause_secondary_tasks) {
@@ -109,6 +114,7 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
       secondary_callbacks.push_back(std::move(pair.second));
     }
     secondary_callbacks_.clear();
+    last_frame_target_time_ = frame_target_time;
   }
 
   if (!callback && secondary_callbacks.empty()) {
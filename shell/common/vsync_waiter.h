@@ -32,6 +32,15 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// The target time of the frame of the last vsync that fired a callback,
+  /// which the secondary callbacks of that vsync can sample input for.
+  fml::TimePoint GetLastFrameTargetTime();
+
+  /// Called on the UI task runner when the refresh rate of the main display
+  /// changes. Waiters that are driven by the display ignore it, waiters that
+  /// keep their own clock should adjust their interval to it.
+  virtual void OnDisplayRefreshRateChanged(double refresh_rate) {}
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -75,6 +84,7 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
+  fml::TimePoint last_frame_target_time_;
 
   void PauseDartMicroTasks();
   static void ResumeDartMicroTasks(fml::TaskQueueId ui_task_queue_id);
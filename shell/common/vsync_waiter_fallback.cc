@@ -28,19 +28,27 @@ VsyncWaiterFallback::VsyncWaiterFallback(TaskRunners task_runners,
                                          bool for_testing)
     : VsyncWaiter(std::move(task_runners)),
       phase_(fml::TimePoint::Now()),
+      frame_interval_(fml::TimeDelta::FromSecondsF(1.0 / 60.0)),
       for_testing_(for_testing) {}
 
 VsyncWaiterFallback::~VsyncWaiterFallback() = default;
 
+// |VsyncWaiter|
+void VsyncWaiterFallback::OnDisplayRefreshRateChanged(double refresh_rate) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (refresh_rate <= 0) {
+    return;
+  }
+  frame_interval_ = fml::TimeDelta::FromSecondsF(1.0 / refresh_rate);
+}
+
 // |VsyncWaiter|
 void VsyncWaiterFallback::AwaitVSync() {
   TRACE_EVENT0("flutter", "VSYNC");
 
-  constexpr fml::TimeDelta kSingleFrameInterval =
-      fml::TimeDelta::FromSecondsF(1.0 / 60.0);
   auto frame_start_time =
-      SnapToNextTick(fml::TimePoint::Now(), phase_, kSingleFrameInterval);
-  auto frame_target_time = frame_start_time + kSingleFrameInterval;
+      SnapToNextTick(fml::TimePoint::Now(), phase_, frame_interval_);
+  auto frame_target_time = frame_start_time + frame_interval_;
   std::weak_ptr<VsyncWaiterFallback> weak_this =
       std::static_pointer_cast<VsyncWaiterFallback>(shared_from_this());
 
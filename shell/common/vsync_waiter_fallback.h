@@ -12,7 +12,8 @@
 
 namespace flutter {
 
-/// A |VsyncWaiter| that will fire at 60 fps irrespective of the vsync.
+/// A |VsyncWaiter| that will fire at the refresh rate of the main display
+/// irrespective of the vsync, or at 60 fps if the refresh rate is unknown.
 class VsyncWaiterFallback final : public VsyncWaiter {
  public:
   explicit VsyncWaiterFallback(TaskRunners task_runners,
@@ -20,8 +21,12 @@ class VsyncWaiterFallback final : public VsyncWaiter {
 
   ~VsyncWaiterFallback() override;
 
+  // |VsyncWaiter|
+  void OnDisplayRefreshRateChanged(double refresh_rate) override;
+
  private:
   fml::TimePoint phase_;
+  fml::TimeDelta frame_interval_;
   const bool for_testing_;
 
   // |VsyncWaiter|
@@ -100,6 +100,7 @@ GPUSurfaceGL::~GPUSurfaceGL() {
 
   onscreen_surface_ = nullptr;
   fbo_id_ = 0;
+  frame_timer_ = nullptr;
   if (context_owner_) {
     context_->releaseResourcesAndAbandonContext();
   }
@@ -204,6 +205,24 @@ SkMatrix GPUSurfaceGL::GetRootTransformation() const {
   return delegate_->GLContextSurfaceTransformation();
 }
 
+// Maps the frame damage rects of the |submit_info| into the coordinates of
+// the onscreen surface, which the frame was drawn into with the
+// |root_surface_transformation|.
+static std::optional<std::vector<SkIRect>> GetSurfaceDamage(
+    const SurfaceFrame::SubmitInfo& submit_info,
+    const SkMatrix& root_surface_transformation) {
+  if (!submit_info.frame_damage ||
+      !root_surface_transformation.rectStaysRect()) {
+    return std::nullopt;
+  }
+  std::vector<SkIRect> damage;
+  for (const SkIRect& rect : submit_info.frame_damage_rects) {
+    damage.push_back(
+        root_surface_transformation.mapRect(SkRect::Make(rect)).roundOut());
+  }
+  return damage;
+}
+
 // |Surface|
 std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
   if (delegate_ == nullptr) {
@@ -239,19 +258,61 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
   }
 
   surface->getCanvas()->setMatrix(root_surface_transformation);
-  SurfaceFrame::SubmitCallback submit_callback =
-      [weak = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
-                                          SkCanvas* canvas) {
-        return weak ? weak->PresentSurface(canvas) : false;
-      };
+
+  if (frame_timer_) {
+    frame_timer_->BeginFrame();
+  }
+
+  // The FBO reset after present has to re-wrap the onscreen surface with the
+  // GrDirectContext, so the present can only be split from the flush when
+  // there is none.
+  const bool split_present = delegate_->GLContextAllowsPresentOnAnyThread() &&
+                             !delegate_->GLContextFBOResetAfterPresent();
+
+  SurfaceFrame::SubmitCallback submit_callback;
+  if (split_present) {
+    submit_callback = [weak = weak_factory_.GetWeakPtr()](
+                          const SurfaceFrame& surface_frame, SkCanvas* canvas) {
+      return weak ? weak->FlushSurface(surface_frame, canvas) : false;
+    };
+  } else {
+    submit_callback = [weak = weak_factory_.GetWeakPtr()](
+                          const SurfaceFrame& surface_frame, SkCanvas* canvas) {
+      return weak ? weak->PresentSurface(surface_frame, canvas) : false;
+    };
+  }
 
   framebuffer_info = delegate_->GLContextFramebufferInfo();
-  return std::make_unique<SurfaceFrame>(surface, std::move(framebuffer_info),
-                                        submit_callback,
-                                        std::move(context_switch));
+  if (!framebuffer_info.existing_damage) {
+    framebuffer_info.existing_damage =
+        delegate_->GLContextFBOExistingDamage(fbo_id_);
+  }
+  auto frame = std::make_unique<SurfaceFrame>(
+      surface, std::move(framebuffer_info), submit_callback,
+      std::move(context_switch));
+
+  if (split_present) {
+    // The delegate outlives the frames of the surface, and the rasterizer
+    // waits for pending presents before tearing the surface down.
+    frame->set_present_callback(
+        [delegate = delegate_, fbo_id = fbo_id_, root_surface_transformation](
+            const SurfaceFrame::SubmitInfo& submit_info) {
+          auto context_switch = delegate->GLContextMakeCurrent();
+          if (!context_switch->GetResult()) {
+            return false;
+          }
+          GLPresentInfo present_info;
+          present_info.fbo_id = fbo_id;
+          present_info.frame_damage =
+              GetSurfaceDamage(submit_info, root_surface_transformation);
+          return delegate->GLContextPresent(present_info);
+        });
+  }
+
+  return frame;
 }
 
-bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
+bool GPUSurfaceGL::FlushSurface(const SurfaceFrame& frame, SkCanvas* canvas) {
   if (delegate_ == nullptr || canvas == nullptr || context_ == nullptr) {
     return false;
   }
@@ -261,7 +322,23 @@ bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
     onscreen_surface_->getCanvas()->flush();
   }
 
-  if (!delegate_->GLContextPresent(fbo_id_)) {
+  if (frame_timer_) {
+    frame_timer_->EndFrame(frame.submit_info().frame_number);
+  }
+  return true;
+}
+
+bool GPUSurfaceGL::PresentSurface(const SurfaceFrame& frame,
+                                  SkCanvas* canvas) {
+  if (!FlushSurface(frame, canvas)) {
+    return false;
+  }
+
+  GLPresentInfo present_info;
+  present_info.fbo_id = fbo_id_;
+  present_info.frame_damage =
+      GetSurfaceDamage(frame.submit_info(), GetRootTransformation());
+  if (!delegate_->GLContextPresent(present_info)) {
     return false;
   }
 
@@ -328,4 +405,35 @@ bool GPUSurfaceGL::AllowsDrawingWhenGpuDisabled() const {
   return delegate_->AllowsDrawingWhenGpuDisabled();
 }
 
+// |Surface|
+void GPUSurfaceGL::SetGpuTimingEnabled(bool enabled) {
+  if (!valid_ || enabled == (frame_timer_ != nullptr)) {
+    return;
+  }
+  // The queries of the timer belong to the GL context.
+  auto context_switch = delegate_->GLContextMakeCurrent();
+  if (!context_switch->GetResult()) {
+    FML_LOG(ERROR) << "Could not make the context current to set up the GPU "
+                      "frame timer.";
+    return;
+  }
+  if (!enabled) {
+    frame_timer_ = nullptr;
+    return;
+  }
+  auto frame_timer =
+      std::make_unique<GPUSurfaceGLFrameTimer>(delegate_->GetGLInterface());
+  if (!frame_timer->IsSupported()) {
+    FML_LOG(INFO) << "GPU frame timing is not supported by the GL context.";
+    return;
+  }
+  frame_timer_ = std::move(frame_timer);
+}
+
+// |Surface|
+std::vector<GpuFrameTiming> GPUSurfaceGL::TakeGpuFrameTimings() {
+  return frame_timer_ ? frame_timer_->TakeTimings()
+                      : std::vector<GpuFrameTiming>();
+}
+
 }  // namespace flutter
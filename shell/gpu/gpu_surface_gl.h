@@ -14,6 +14,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
+#include "flutter/shell/gpu/gpu_surface_gl_frame_timer.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -53,6 +54,12 @@ class GPUSurfaceGL : public Surface {
   // |Surface|
   bool AllowsDrawingWhenGpuDisabled() const override;
 
+  // |Surface|
+  void SetGpuTimingEnabled(bool enabled) override;
+
+  // |Surface|
+  std::vector<GpuFrameTiming> TakeGpuFrameTimings() override;
+
  private:
   bool CreateOrUpdateSurfaces(const SkISize& size);
 
@@ -60,7 +67,9 @@ class GPUSurfaceGL : public Surface {
       const SkISize& untransformed_size,
       const SkMatrix& root_surface_transformation);
 
-  bool PresentSurface(SkCanvas* canvas);
+  bool PresentSurface(const SurfaceFrame& frame, SkCanvas* canvas);
+
+  bool FlushSurface(const SurfaceFrame& frame, SkCanvas* canvas);
 
   GPUSurfaceGLDelegate* delegate_;
   sk_sp<GrDirectContext> context_;
@@ -68,6 +77,8 @@ class GPUSurfaceGL : public Surface {
   /// FBO backing the current `onscreen_surface_`.
   uint32_t fbo_id_ = 0;
   bool context_owner_ = false;
+  /// Measures the GPU time of the frames when GPU timing is enabled.
+  std::unique_ptr<GPUSurfaceGLFrameTimer> frame_timer_;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
   // external view embedder may want to render to the root surface. This is a
   // hack to make avoid allocating resources for the root surface when an
@@ -16,6 +16,10 @@ bool GPUSurfaceGLDelegate::GLContextFBOResetAfterPresent() const {
   return false;
 }
 
+bool GPUSurfaceGLDelegate::GLContextAllowsPresentOnAnyThread() const {
+  return false;
+}
+
 SurfaceFrame::FramebufferInfo GPUSurfaceGLDelegate::GLContextFramebufferInfo()
     const {
   SurfaceFrame::FramebufferInfo res;
@@ -23,6 +27,11 @@ SurfaceFrame::FramebufferInfo GPUSurfaceGLDelegate::GLContextFramebufferInfo()
   return res;
 }
 
+std::optional<SkIRect> GPUSurfaceGLDelegate::GLContextFBOExistingDamage(
+    intptr_t fbo_id) const {
+  return std::nullopt;
+}
+
 SkMatrix GPUSurfaceGLDelegate::GLContextSurfaceTransformation() const {
   SkMatrix matrix;
   matrix.setIdentity();
@@ -5,10 +5,14 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 
+#include <optional>
+#include <vector>
+
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
 namespace flutter {
@@ -20,6 +24,19 @@ struct GLFrameInfo {
   uint32_t height;
 };
 
+// A structure to represent the information about a frame which is passed to
+// the embedder when presenting the frame.
+struct GLPresentInfo {
+  uint32_t fbo_id;
+
+  // The rects of the surface that changed since the previous frame, in the
+  // coordinates of the surface with its origin at the top left. If this is
+  // not set, the whole surface must be presented.
+  //
+  // Corresponds to the rects of EGL_KHR_swap_buffers_with_damage.
+  std::optional<std::vector<SkIRect>> frame_damage;
+};
+
 class GPUSurfaceGLDelegate {
  public:
   ~GPUSurfaceGLDelegate();
@@ -33,7 +50,7 @@ class GPUSurfaceGLDelegate {
 
   // Called to present the main GL surface. This is only called for the main GL
   // context and not any of the contexts dedicated for IO.
-  virtual bool GLContextPresent(uint32_t fbo_id) = 0;
+  virtual bool GLContextPresent(const GLPresentInfo& present_info) = 0;
 
   // The ID of the main window bound framebuffer. Typically FBO0.
   virtual intptr_t GLContextFBO(GLFrameInfo frame_info) const = 0;
@@ -45,9 +62,23 @@ class GPUSurfaceGLDelegate {
   // rendering subsequent frames.
   virtual bool GLContextFBOResetAfterPresent() const;
 
+  // Whether |GLContextPresent| may be called on a thread other than the one
+  // the frame was rendered on, after the context has been made current on
+  // that thread with |GLContextMakeCurrent|. Lets the rasterizer present
+  // frames on a dedicated thread while it works on the next one.
+  virtual bool GLContextAllowsPresentOnAnyThread() const;
+
   // Returns framebuffer info for current backbuffer
   virtual SurfaceFrame::FramebufferInfo GLContextFramebufferInfo() const;
 
+  // The area of the framebuffer with the given ID whose contents lag behind
+  // the frames presented since it was last rendered to, which the next frame
+  // has to redraw along with its own damage. Only used if
+  // |GLContextFramebufferInfo| doesn't specify the existing damage. Returns
+  // nullopt, which redraws the whole frame, by default.
+  virtual std::optional<SkIRect> GLContextFBOExistingDamage(
+      intptr_t fbo_id) const;
+
   // A transformation applied to the onscreen surface before the canvas is
   // flushed.
   virtual SkMatrix GLContextSurfaceTransformation() const;
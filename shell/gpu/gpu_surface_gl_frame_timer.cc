@@ -0,0 +1,137 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/gpu/gpu_surface_gl_frame_timer.h"
+
+#include "flutter/fml/logging.h"
+
+// Defined here for the same reason as the formats in gpu_surface_gl.cc. The
+// `EXT` values of GL_EXT_disjoint_timer_query are the same as the desktop ones.
+#define GPU_GL_TIME_ELAPSED 0x88BF
+#define GPU_GL_QUERY_RESULT 0x8866
+#define GPU_GL_QUERY_RESULT_AVAILABLE 0x8867
+#define GPU_GL_GPU_DISJOINT 0x8FBB
+
+namespace flutter {
+
+GPUSurfaceGLFrameTimer::GPUSurfaceGLFrameTimer(
+    sk_sp<const GrGLInterface> gl_interface)
+    : gl_interface_(std::move(gl_interface)),
+      is_gles_(gl_interface_ &&
+               gl_interface_->fStandard == kGLES_GrGLStandard) {}
+
+GPUSurfaceGLFrameTimer::~GPUSurfaceGLFrameTimer() {
+  if (!IsSupported()) {
+    return;
+  }
+  const auto& gl = gl_interface_->fFunctions;
+  if (active_query_ != 0) {
+    gl.fEndQuery(GPU_GL_TIME_ELAPSED);
+    free_queries_.push_back(active_query_);
+  }
+  for (const PendingQuery& pending : pending_queries_) {
+    free_queries_.push_back(pending.query);
+  }
+  if (!free_queries_.empty()) {
+    gl.fDeleteQueries(static_cast<GrGLsizei>(free_queries_.size()),
+                      free_queries_.data());
+  }
+}
+
+bool GPUSurfaceGLFrameTimer::IsSupported() const {
+  if (!gl_interface_) {
+    return false;
+  }
+  // Skia only resolves the 64 bit query results for the contexts that
+  // support timer queries.
+  const auto& gl = gl_interface_->fFunctions;
+  return gl.fGenQueries && gl.fDeleteQueries && gl.fBeginQuery &&
+         gl.fEndQuery && gl.fGetQueryObjectuiv && gl.fGetQueryObjectui64v;
+}
+
+void GPUSurfaceGLFrameTimer::BeginFrame() {
+  if (!IsSupported()) {
+    return;
+  }
+  const auto& gl = gl_interface_->fFunctions;
+
+  // The last frame was dropped without being submitted.
+  if (active_query_ != 0) {
+    gl.fEndQuery(GPU_GL_TIME_ELAPSED);
+    pending_queries_.push_back({active_query_, 0});
+    active_query_ = 0;
+  }
+
+  CollectCompletedQueries();
+  if (pending_queries_.size() >= kMaxPendingQueries) {
+    return;
+  }
+
+  if (free_queries_.empty()) {
+    uint32_t query = 0;
+    gl.fGenQueries(1, &query);
+    if (query == 0) {
+      return;
+    }
+    free_queries_.push_back(query);
+  }
+  active_query_ = free_queries_.back();
+  free_queries_.pop_back();
+  gl.fBeginQuery(GPU_GL_TIME_ELAPSED, active_query_);
+}
+
+void GPUSurfaceGLFrameTimer::EndFrame(uint64_t frame_number) {
+  if (active_query_ == 0) {
+    return;
+  }
+  gl_interface_->fFunctions.fEndQuery(GPU_GL_TIME_ELAPSED);
+  pending_queries_.push_back({active_query_, frame_number});
+  active_query_ = 0;
+}
+
+std::vector<GpuFrameTiming> GPUSurfaceGLFrameTimer::TakeTimings() {
+  std::vector<GpuFrameTiming> timings;
+  timings.swap(completed_timings_);
+  return timings;
+}
+
+void GPUSurfaceGLFrameTimer::CollectCompletedQueries() {
+  if (pending_queries_.empty()) {
+    return;
+  }
+  const auto& gl = gl_interface_->fFunctions;
+
+  // Reading the disjoint flag resets it. It is set when something, like a
+  // change of the GPU frequency, made the results of the queries in flight
+  // meaningless.
+  bool disjoint = false;
+  if (is_gles_) {
+    GrGLint gpu_disjoint = 0;
+    gl.fGetIntegerv(GPU_GL_GPU_DISJOINT, &gpu_disjoint);
+    disjoint = gpu_disjoint != 0;
+  }
+
+  // The queries complete in the order in which they were issued.
+  while (!pending_queries_.empty()) {
+    const PendingQuery pending = pending_queries_.front();
+    GrGLuint available = 0;
+    gl.fGetQueryObjectuiv(pending.query, GPU_GL_QUERY_RESULT_AVAILABLE,
+                          &available);
+    if (!available) {
+      break;
+    }
+    GrGLuint64 elapsed_nanos = 0;
+    gl.fGetQueryObjectui64v(pending.query, GPU_GL_QUERY_RESULT,
+                            &elapsed_nanos);
+    if (pending.frame_number != 0 && !disjoint) {
+      completed_timings_.push_back(
+          {pending.frame_number,
+           fml::TimeDelta::FromNanoseconds(elapsed_nanos)});
+    }
+    free_queries_.push_back(pending.query);
+    pending_queries_.pop_front();
+  }
+}
+
+}  // namespace flutter
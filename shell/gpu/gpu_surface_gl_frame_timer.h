@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_GPU_GPU_SURFACE_GL_FRAME_TIMER_H_
+#define SHELL_GPU_GPU_SURFACE_GL_FRAME_TIMER_H_
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "flutter/flow/surface.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/gpu/gl/GrGLInterface.h"
+
+namespace flutter {
+
+// Measures the GPU time of the frames of a GL surface with `GL_TIME_ELAPSED`
+// queries around the GL commands of each frame. The results of the queries
+// become available after the GPU has finished the frames, so they are polled
+// at the start of the later frames instead of being waited for.
+//
+// All of the methods, including the destructor, must be called with the GL
+// context of the surface current.
+class GPUSurfaceGLFrameTimer {
+ public:
+  // The max number of frames whose measurements may be in flight. Frames
+  // acquired while the GPU is this far behind are not measured.
+  static constexpr size_t kMaxPendingQueries = 4;
+
+  explicit GPUSurfaceGLFrameTimer(sk_sp<const GrGLInterface> gl_interface);
+
+  ~GPUSurfaceGLFrameTimer();
+
+  // Whether the GL context supports timer queries, from either a desktop
+  // GL 3.3 context or the `GL_EXT_disjoint_timer_query` extension.
+  bool IsSupported() const;
+
+  // Polls the queries of the earlier frames and starts measuring the GL
+  // commands of a new frame.
+  void BeginFrame();
+
+  // Stops measuring the frame started by the last `BeginFrame`, once its GL
+  // commands have been flushed.
+  void EndFrame(uint64_t frame_number);
+
+  // Returns the measurements that have completed since the last call.
+  std::vector<GpuFrameTiming> TakeTimings();
+
+ private:
+  struct PendingQuery {
+    uint32_t query;
+    // 0 for the queries of frames that were never submitted, whose results
+    // are discarded.
+    uint64_t frame_number;
+  };
+
+  void CollectCompletedQueries();
+
+  sk_sp<const GrGLInterface> gl_interface_;
+  const bool is_gles_;
+  uint32_t active_query_ = 0;
+  std::deque<PendingQuery> pending_queries_;
+  std::vector<uint32_t> free_queries_;
+  std::vector<GpuFrameTiming> completed_timings_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceGLFrameTimer);
+};
+
+}  // namespace flutter
+
+#endif  // SHELL_GPU_GPU_SURFACE_GL_FRAME_TIMER_H_
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_METAL_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_METAL_H_
 
+#include <map>
+#include <optional>
+
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_metal_delegate.h"
@@ -39,6 +42,16 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetal : public Surface {
   // Accumulated damage for each framebuffer; Key is address of underlying
   // MTLTexture for each drawable
   std::map<uintptr_t, SkIRect> damage_;
+  // Size of the framebuffers whose damage is tracked in |damage_|
+  SkISize damage_frame_size_ = SkISize::MakeEmpty();
+
+  // The texture frames are recorded into when the delegate defers drawable
+  // acquisition, and the surface and the image that wrap it.
+  GrMtlTextureInfo offscreen_texture_;
+  sk_sp<SkSurface> offscreen_surface_;
+  sk_sp<SkImage> offscreen_image_;
+  // Whether |offscreen_texture_| holds the last submitted frame.
+  bool offscreen_contents_valid_ = false;
 
   // |Surface|
   std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override;
@@ -58,11 +71,22 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetal : public Surface {
   std::unique_ptr<SurfaceFrame> AcquireFrameFromCAMetalLayer(
       const SkISize& frame_info);
 
+  std::unique_ptr<SurfaceFrame> AcquireOffscreenFrameForCAMetalLayer(
+      const SkISize& frame_info);
+
   std::unique_ptr<SurfaceFrame> AcquireFrameFromMTLTexture(
       const SkISize& frame_info);
 
   void PrecompileKnownSkSLsIfNecessary();
 
+  // Returns the area of the |texture| that lags behind the front buffer, or
+  // nullopt if the whole texture must be repainted.
+  std::optional<SkIRect> GetExistingDamage(uintptr_t texture,
+                                           const SkISize& frame_size);
+
+  // Records the damage of a submitted frame on all of the other textures.
+  void AccumulateDamage(uintptr_t texture, const SurfaceFrame& surface_frame);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceMetal);
 };
 
@@ -13,6 +13,7 @@
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/gpu/gpu_surface_metal_delegate.h"
+#include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/ports/SkCFObject.h"
@@ -84,6 +85,9 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrame(const SkISize& frame
 
   switch (render_target_type_) {
     case MTLRenderTargetType::kCAMetalLayer:
+      if (delegate_->DefersDrawableAcquisition()) {
+        return AcquireOffscreenFrameForCAMetalLayer(frame_size);
+      }
       return AcquireFrameFromCAMetalLayer(frame_size);
     case MTLRenderTargetType::kMTLTexture:
       return AcquireFrameFromMTLTexture(frame_size);
@@ -104,8 +108,11 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromCAMetalLayer(
 
   auto* mtl_layer = (CAMetalLayer*)layer;
   // Get the drawable eagerly, we will need texture object to identify target framebuffer
-  fml::scoped_nsprotocol<id<CAMetalDrawable>> drawable(
-      reinterpret_cast<id<CAMetalDrawable>>([[mtl_layer nextDrawable] retain]));
+  fml::scoped_nsprotocol<id<CAMetalDrawable>> drawable;
+  {
+    TRACE_EVENT0("flutter", "GPUSurfaceMetal::WaitForDrawable");
+    drawable.reset(reinterpret_cast<id<CAMetalDrawable>>([[mtl_layer nextDrawable] retain]));
+  }
 
   if (!drawable.get()) {
     FML_LOG(ERROR) << "Could not obtain drawable from the metal layer.";
@@ -135,33 +142,123 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromCAMetalLayer(
 
     canvas->flush();
 
-    uintptr_t texture = reinterpret_cast<uintptr_t>(drawable.get().texture);
-    for (auto& entry : damage_) {
-      if (entry.first != texture) {
-        // Accumulate damage for other framebuffers
-        if (surface_frame.submit_info().frame_damage) {
-          entry.second.join(*surface_frame.submit_info().frame_damage);
-        }
-      }
-    }
-    // Reset accumulated damage for current framebuffer
-    damage_[texture] = SkIRect::MakeEmpty();
+    AccumulateDamage(reinterpret_cast<uintptr_t>(drawable.get().texture), surface_frame);
 
     return delegate_->PresentDrawable(drawable);
   };
 
   SurfaceFrame::FramebufferInfo framebuffer_info;
   framebuffer_info.supports_readback = true;
+  framebuffer_info.existing_damage =
+      GetExistingDamage(reinterpret_cast<uintptr_t>(drawable.get().texture), frame_info);
 
-  // Provide accumulated damage to rasterizer (area in current framebuffer that lags behind
-  // front buffer)
-  uintptr_t texture = reinterpret_cast<uintptr_t>(drawable.get().texture);
-  auto i = damage_.find(texture);
-  if (i != damage_.end()) {
-    framebuffer_info.existing_damage = i->second;
+  return std::make_unique<SurfaceFrame>(std::move(surface), framebuffer_info, submit_callback);
+}
+
+std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireOffscreenFrameForCAMetalLayer(
+    const SkISize& frame_info) {
+  auto layer = delegate_->GetCAMetalLayer(frame_info);
+  if (!layer) {
+    FML_LOG(ERROR) << "Invalid CAMetalLayer given by the embedder.";
+    return nullptr;
   }
+  fml::scoped_nsobject<CAMetalLayer> mtl_layer([(CAMetalLayer*)layer retain]);
+
+  id<MTLTexture> offscreen_texture = (id<MTLTexture>)offscreen_texture_.fTexture.get();
+  if (!offscreen_texture ||
+      SkISize::Make(offscreen_texture.width, offscreen_texture.height) != frame_info) {
+    offscreen_surface_.reset();
+    offscreen_image_.reset();
+    offscreen_contents_valid_ = false;
+
+    MTLTextureDescriptor* descriptor =
+        [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:mtl_layer.get().pixelFormat
+                                                           width:frame_info.width()
+                                                          height:frame_info.height()
+                                                       mipmapped:NO];
+    descriptor.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+    descriptor.storageMode = MTLStorageModePrivate;
+    offscreen_texture = [mtl_layer.get().device newTextureWithDescriptor:descriptor];
+    // The texture info takes ownership of the new texture.
+    offscreen_texture_.fTexture.reset(offscreen_texture);
+    if (!offscreen_texture) {
+      FML_LOG(ERROR) << "Could not create the offscreen texture for the CAMetalLayer.";
+      return nullptr;
+    }
 
-  return std::make_unique<SurfaceFrame>(std::move(surface), framebuffer_info, submit_callback);
+    offscreen_surface_ = CreateSurfaceFromMetalTexture(context_.get(), offscreen_texture,
+                                                       kTopLeft_GrSurfaceOrigin,  // origin
+                                                       1,                         // sample count
+                                                       kBGRA_8888_SkColorType,    // color type
+                                                       nullptr,                   // colorspace
+                                                       nullptr  // surface properties
+    );
+    GrBackendTexture backend_texture(frame_info.width(), frame_info.height(), GrMipmapped::kNo,
+                                     offscreen_texture_);
+    offscreen_image_ = SkImage::MakeFromTexture(context_.get(), backend_texture,
+                                                kTopLeft_GrSurfaceOrigin, kBGRA_8888_SkColorType,
+                                                kPremul_SkAlphaType, nullptr);
+  }
+
+  if (!offscreen_surface_ || !offscreen_image_) {
+    FML_LOG(ERROR) << "Could not wrap the offscreen texture for the CAMetalLayer.";
+    return nullptr;
+  }
+
+  // The texture still holds the last frame that was submitted, so only the damage of the new frame
+  // needs to be painted. A frame that is dropped may have left the texture half painted.
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  if (offscreen_contents_valid_) {
+    framebuffer_info.existing_damage = SkIRect::MakeEmpty();
+  }
+  offscreen_contents_valid_ = false;
+
+  auto submit_callback = [this, mtl_layer](const SurfaceFrame& surface_frame,
+                                           SkCanvas* canvas) -> bool {
+    TRACE_EVENT0("flutter", "GPUSurfaceMetal::Submit");
+    if (canvas == nullptr) {
+      FML_DLOG(ERROR) << "Canvas not available.";
+      return false;
+    }
+
+    canvas->flush();
+
+    // The frame is recorded, so this is the latest the drawable can be asked for.
+    fml::scoped_nsprotocol<id<CAMetalDrawable>> drawable;
+    {
+      TRACE_EVENT0("flutter", "GPUSurfaceMetal::WaitForDrawable");
+      drawable.reset(
+          reinterpret_cast<id<CAMetalDrawable>>([[mtl_layer.get() nextDrawable] retain]));
+    }
+    if (!drawable.get()) {
+      FML_LOG(ERROR) << "Could not obtain drawable from the metal layer.";
+      return false;
+    }
+
+    auto drawable_surface = CreateSurfaceFromMetalTexture(context_.get(), drawable.get().texture,
+                                                          kTopLeft_GrSurfaceOrigin,  // origin
+                                                          1,                       // sample count
+                                                          kBGRA_8888_SkColorType,  // color type
+                                                          nullptr,                 // colorspace
+                                                          nullptr  // surface properties
+    );
+    if (!drawable_surface) {
+      FML_LOG(ERROR) << "Could not create the SkSurface from the drawable.";
+      return false;
+    }
+
+    // Drawables are recycled with stale contents, so the whole frame is copied.
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    drawable_surface->getCanvas()->drawImage(offscreen_image_, 0, 0, SkSamplingOptions(), &paint);
+    drawable_surface->getCanvas()->flush();
+    offscreen_contents_valid_ = true;
+
+    return delegate_->PresentDrawable(drawable);
+  };
+
+  return std::make_unique<SurfaceFrame>(offscreen_surface_, framebuffer_info, submit_callback);
 }
 
 std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromMTLTexture(
@@ -183,8 +280,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromMTLTexture(
     return nullptr;
   }
 
-  auto submit_callback = [texture = texture, delegate = delegate_](
-                             const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
+  auto submit_callback = [this, texture = texture](const SurfaceFrame& surface_frame,
+                                                   SkCanvas* canvas) -> bool {
     TRACE_EVENT0("flutter", "GPUSurfaceMetal::PresentTexture");
     if (canvas == nullptr) {
       FML_DLOG(ERROR) << "Canvas not available.";
@@ -193,16 +290,55 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromMTLTexture(
 
     canvas->flush();
 
-    return delegate->PresentTexture(texture);
+    AccumulateDamage(reinterpret_cast<uintptr_t>(texture.texture), surface_frame);
+
+    return delegate_->PresentTexture(texture);
   };
 
   SurfaceFrame::FramebufferInfo framebuffer_info;
   framebuffer_info.supports_readback = true;
+  framebuffer_info.existing_damage =
+      GetExistingDamage(reinterpret_cast<uintptr_t>(mtl_texture), frame_info);
 
   return std::make_unique<SurfaceFrame>(std::move(surface), std::move(framebuffer_info),
                                         submit_callback);
 }
 
+std::optional<SkIRect> GPUSurfaceMetal::GetExistingDamage(uintptr_t texture,
+                                                          const SkISize& frame_size) {
+  // Textures of a different size have been reallocated, their contents and
+  // addresses can't be trusted anymore.
+  if (frame_size != damage_frame_size_) {
+    damage_.clear();
+    damage_frame_size_ = frame_size;
+  }
+
+  // Provide accumulated damage to rasterizer (area in current framebuffer that lags behind
+  // front buffer). Textures that have not been presented yet are repainted entirely.
+  auto i = damage_.find(texture);
+  if (i != damage_.end()) {
+    return i->second;
+  }
+  return std::nullopt;
+}
+
+void GPUSurfaceMetal::AccumulateDamage(uintptr_t texture, const SurfaceFrame& surface_frame) {
+  const auto& frame_damage = surface_frame.submit_info().frame_damage;
+  for (auto& entry : damage_) {
+    if (entry.first != texture) {
+      // Accumulate damage for other framebuffers. A frame without damage
+      // information has replaced the whole texture.
+      if (frame_damage) {
+        entry.second.join(*frame_damage);
+      } else {
+        entry.second = SkIRect::MakeSize(damage_frame_size_);
+      }
+    }
+  }
+  // Reset accumulated damage for current framebuffer
+  damage_[texture] = SkIRect::MakeEmpty();
+}
+
 // |Surface|
 SkMatrix GPUSurfaceMetal::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -94,6 +94,15 @@ class GPUSurfaceMetalDelegate {
   ///
   virtual bool AllowsDrawingWhenGpuDisabled() const;
 
+  //------------------------------------------------------------------------------
+  /// @brief Whether frames are recorded into an offscreen texture and only
+  /// copied to a drawable of the CAMetalLayer once they are submitted. This
+  /// keeps the raster thread from blocking in `nextDrawable` while it records a
+  /// frame, at the cost of a copy of each frame. This is only consulted when
+  /// the specified render target type is `kCAMetalLayer`.
+  ///
+  virtual bool DefersDrawableAcquisition() const;
+
   MTLRenderTargetType GetRenderTargetType();
 
  private:
@@ -4,11 +4,131 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <atomic>
 #include <memory>
+
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
 
 namespace flutter {
 
+namespace {
+
+// The number of rows of the bands that frames are split into when they are
+// rasterized concurrently.
+constexpr int kTileHeight = 128;
+
+// Finds whether a picture has backdrop filters, which read the pixels around
+// the area they are drawn into and so can't be rasterized in separate bands.
+class BackdropFinder final : public SkNoDrawCanvas {
+ public:
+  BackdropFinder(int width, int height) : SkNoDrawCanvas(width, height) {}
+
+  bool has_backdrop() const { return has_backdrop_; }
+
+ protected:
+  // |SkCanvas|
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+    has_backdrop_ = has_backdrop_ || rec.fBackdrop != nullptr;
+    return kNoLayer_SaveLayerStrategy;
+  }
+
+ private:
+  bool has_backdrop_ = false;
+};
+
+// The bands of a frame that are being rasterized. Shared by the raster thread
+// and the workers, which take the bands in order until there are none left.
+struct FrameTiles {
+  FrameTiles(sk_sp<SkPicture> p_picture, const SkPixmap& p_pixmap, int p_count)
+      : picture(std::move(p_picture)),
+        pixmap(p_pixmap),
+        count(p_count),
+        rasterized(p_count) {}
+
+  const sk_sp<SkPicture> picture;
+  const SkPixmap pixmap;
+  const int count;
+  std::atomic_int next_tile = {0};
+  fml::CountDownLatch rasterized;
+};
+
+void RasterizeTile(const FrameTiles& tiles, int index) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTile");
+  SkPixmap tile;
+  const SkIRect tile_bounds = SkIRect::MakeXYWH(0, index * kTileHeight,
+                                                tiles.pixmap.width(),
+                                                kTileHeight);
+  if (!tiles.pixmap.extractSubset(&tile, tile_bounds)) {
+    return;
+  }
+  auto canvas = SkCanvas::MakeRasterDirect(tile.info(), tile.writable_addr(),
+                                           tile.rowBytes());
+  if (!canvas) {
+    return;
+  }
+  canvas->translate(0, -tile_bounds.top());
+  canvas->drawPicture(tiles.picture);
+}
+
+void RasterizeTiles(FrameTiles& tiles) {
+  for (int index = tiles.next_tile++; index < tiles.count;
+       index = tiles.next_tile++) {
+    RasterizeTile(tiles, index);
+    tiles.rasterized.CountDown();
+  }
+}
+
+// Rasterizes the picture into the backing store, in bands that are replayed
+// concurrently on the raster thread and the workers of the |task_runner|.
+void RasterizePicture(sk_sp<SkPicture> picture,
+                      SkSurface* backing_store,
+                      fml::BasicTaskRunner* task_runner) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizePicture");
+  const int tile_count =
+      (backing_store->height() + kTileHeight - 1) / kTileHeight;
+
+  BackdropFinder backdrop_finder(backing_store->width(),
+                                 backing_store->height());
+  picture->playback(&backdrop_finder);
+
+  // Writing to the pixels directly skips the copy on write of the snapshots
+  // that share them, so it has to be triggered first.
+  backing_store->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  SkPixmap pixmap;
+  if (tile_count < 2 || backdrop_finder.has_backdrop() ||
+      !backing_store->peekPixels(&pixmap)) {
+    backing_store->getCanvas()->drawPicture(picture);
+    backing_store->getCanvas()->flush();
+    return;
+  }
+
+  auto tiles =
+      std::make_shared<FrameTiles>(std::move(picture), pixmap, tile_count);
+  for (int i = 1; i < tile_count; i++) {
+    task_runner->PostTask([tiles]() { RasterizeTiles(*tiles); });
+  }
+  RasterizeTiles(*tiles);
+  tiles->rasterized.Wait();
+}
+
+bool PresentBackingStore(GPUSurfaceSoftwareDelegate* delegate,
+                         const SurfaceFrame& surface_frame) {
+  const auto& submit_info = surface_frame.submit_info();
+  if (!submit_info.frame_damage) {
+    // Without damage information, the whole frame has to be presented.
+    return delegate->PresentBackingStore(surface_frame.SkiaSurface());
+  }
+  return delegate->PresentBackingStoreWithDamage(
+      surface_frame.SkiaSurface(), submit_info.frame_damage_rects);
+}
+
+}  // namespace
+
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
                                        bool render_to_surface)
     : delegate_(delegate),
@@ -54,6 +174,39 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  // Backing stores that still hold the last frame only need the areas that
+  // changed since then to be repainted.
+  framebuffer_info.existing_damage = delegate_->GetBackingStoreExistingDamage();
+
+  if (tile_task_runner_) {
+    // Record the frame so that it can be rasterized in bands concurrently
+    // when it is submitted.
+    auto recorder = std::make_shared<SkPictureRecorder>();
+    SkCanvas* recording_canvas =
+        recorder->beginRecording(SkRect::Make(size), SkRTreeFactory{}());
+
+    SurfaceFrame::SubmitCallback on_submit =
+        [self = weak_factory_.GetWeakPtr(), recorder](
+            const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
+      // If the surface itself went away, there is nothing more to do.
+      if (!self || !self->IsValid() || canvas == nullptr ||
+          !self->tile_task_runner_) {
+        return false;
+      }
+
+      RasterizePicture(recorder->finishRecordingAsPicture(),
+                       surface_frame.SkiaSurface().get(),
+                       self->tile_task_runner_.get());
+
+      return PresentBackingStore(self->delegate_, surface_frame);
+    };
+
+    auto frame = std::make_unique<SurfaceFrame>(
+        backing_store, std::move(framebuffer_info), on_submit);
+    frame->set_canvas(recording_canvas);
+    return frame;
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -70,7 +223,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->flush();
 
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
+    return PresentBackingStore(self->delegate_, surface_frame);
   };
 
   return std::make_unique<SurfaceFrame>(backing_store,
@@ -92,4 +245,10 @@ GrDirectContext* GPUSurfaceSoftware::GetContext() {
   return nullptr;
 }
 
+// |Surface|
+void GPUSurfaceSoftware::SetTileTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  tile_task_runner_ = std::move(task_runner);
+}
+
 }  // namespace flutter
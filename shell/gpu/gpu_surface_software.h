@@ -31,6 +31,10 @@ class GPUSurfaceSoftware : public Surface {
   // |Surface|
   GrDirectContext* GetContext() override;
 
+  // |Surface|
+  void SetTileTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner) override;
+
  private:
   GPUSurfaceSoftwareDelegate* delegate_;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
@@ -38,6 +42,9 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  // When set, frames are recorded and then rasterized in bands that are
+  // replayed concurrently on this task runner.
+  std::shared_ptr<fml::BasicTaskRunner> tile_task_runner_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
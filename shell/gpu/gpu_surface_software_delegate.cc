@@ -8,4 +8,15 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+std::optional<SkIRect>
+GPUSurfaceSoftwareDelegate::GetBackingStoreExistingDamage() {
+  return std::nullopt;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::vector<SkIRect>& damage_rects) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
 }  // namespace flutter
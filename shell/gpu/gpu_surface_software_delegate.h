@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <optional>
+#include <vector>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -48,6 +51,36 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called when the GPU surface acquires a backing store, to find
+  ///             the area of it that does not hold the contents of the last
+  ///             presented frame.
+  ///
+  /// @return     The area of the backing store that must be repainted
+  ///             alongside the damage of the new frame, an empty rect if the
+  ///             backing store holds the whole last frame, or `std::nullopt`
+  ///             if the whole backing store must be repainted.
+  ///
+  virtual std::optional<SkIRect> GetBackingStoreExistingDamage();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the platform when a frame has been rendered into the
+  ///             backing store and only the given areas of it changed since
+  ///             the last frame. Platforms that can't update parts of the
+  ///             screen need not override this, as it presents the whole
+  ///             backing store by default.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  damage_rects   The disjoint areas of the backing store that
+  ///                            changed since the last frame.
+  ///
+  /// @return     Returns if the platform could present the backing store onto
+  ///             the screen.
+  ///
+  virtual bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::vector<SkIRect>& damage_rects);
 };
 
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/shell/gpu/gpu_surface_vulkan.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/shell/common/context_options.h"
 
 namespace flutter {
 
@@ -25,7 +26,27 @@ GPUSurfaceVulkan::GPUSurfaceVulkan(
     : window_(context,
               delegate->vk(),
               std::move(native_surface),
-              render_to_surface),
+              render_to_surface,
+              MakeDefaultContextOptions(ContextType::kRender,
+                                        GrBackendApi::kVulkan)),
+      render_to_surface_(render_to_surface),
+      weak_factory_(this) {}
+
+GPUSurfaceVulkan::GPUSurfaceVulkan(
+    std::shared_ptr<vulkan::VulkanApplication> application,
+    std::shared_ptr<vulkan::VulkanDevice> device,
+    const sk_sp<GrDirectContext>& context,
+    GPUSurfaceVulkanDelegate* delegate,
+    std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
+    bool render_to_surface)
+    : window_(std::move(application),
+              std::move(device),
+              context,
+              delegate->vk(),
+              std::move(native_surface),
+              render_to_surface,
+              MakeDefaultContextOptions(ContextType::kRender,
+                                        GrBackendApi::kVulkan)),
       render_to_surface_(render_to_surface),
       weak_factory_(this) {}
 
@@ -56,21 +77,61 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
     return nullptr;
   }
 
+  framebuffer_info.existing_damage = GetExistingDamage(surface.get());
+
   SurfaceFrame::SubmitCallback callback =
-      [weak_this = weak_factory_.GetWeakPtr()](const SurfaceFrame&,
-                                               SkCanvas* canvas) -> bool {
+      [weak_this = weak_factory_.GetWeakPtr(), surface = surface.get()](
+          const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
     // Frames are only ever acquired on the raster thread. This is also the
     // thread on which the weak pointer factory is collected (as this instance
     // is owned by the rasterizer). So this use of weak pointers is safe.
     if (canvas == nullptr || !weak_this) {
       return false;
     }
+    weak_this->AccumulateDamage(surface, surface_frame);
     return weak_this->window_.SwapBuffers();
   };
   return std::make_unique<SurfaceFrame>(
       std::move(surface), std::move(framebuffer_info), std::move(callback));
 }
 
+std::optional<SkIRect> GPUSurfaceVulkan::GetExistingDamage(
+    const SkSurface* surface) {
+  // A recreated swapchain has new images, whose contents are undefined and
+  // whose surfaces may reuse the addresses of the old ones.
+  const SkISize frame_size = SkISize::Make(surface->width(), surface->height());
+  if (window_.GetSwapchainGeneration() != damage_swapchain_generation_ ||
+      frame_size != damage_frame_size_) {
+    damage_.clear();
+    damage_swapchain_generation_ = window_.GetSwapchainGeneration();
+    damage_frame_size_ = frame_size;
+  }
+
+  // Images that have not been presented yet are repainted entirely.
+  auto found = damage_.find(surface);
+  if (found != damage_.end()) {
+    return found->second;
+  }
+  return std::nullopt;
+}
+
+void GPUSurfaceVulkan::AccumulateDamage(const SkSurface* surface,
+                                        const SurfaceFrame& surface_frame) {
+  const auto& frame_damage = surface_frame.submit_info().frame_damage;
+  for (auto& entry : damage_) {
+    if (entry.first != surface) {
+      // The other images lag behind by the damage of this frame. A frame
+      // without damage information has replaced the whole image.
+      if (frame_damage) {
+        entry.second.join(*frame_damage);
+      } else {
+        entry.second = SkIRect::MakeSize(damage_frame_size_);
+      }
+    }
+  }
+  damage_[surface] = SkIRect::MakeEmpty();
+}
+
 SkMatrix GPUSurfaceVulkan::GetRootTransformation() const {
   // This backend does not support delegating to the underlying platform to
   // query for root surface transformations. Just return identity.
@@ -5,7 +5,9 @@
 #ifndef SHELL_GPU_GPU_SURFACE_VULKAN_H_
 #define SHELL_GPU_GPU_SURFACE_VULKAN_H_
 
+#include <map>
 #include <memory>
+#include <optional>
 
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
@@ -36,6 +38,18 @@ class GPUSurfaceVulkan : public Surface {
                    std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
                    bool render_to_surface);
 
+  //------------------------------------------------------------------------------
+  /// @brief      Create a GPUSurfaceVulkan on an existing instance and device,
+  ///             reusing the GrDirectContext built on them, or creating one if
+  ///             it is null.
+  ///
+  GPUSurfaceVulkan(std::shared_ptr<vulkan::VulkanApplication> application,
+                   std::shared_ptr<vulkan::VulkanDevice> device,
+                   const sk_sp<GrDirectContext>& context,
+                   GPUSurfaceVulkanDelegate* delegate,
+                   std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
+                   bool render_to_surface);
+
   ~GPUSurfaceVulkan() override;
 
   // |Surface|
@@ -54,6 +68,18 @@ class GPUSurfaceVulkan : public Surface {
   vulkan::VulkanWindow window_;
   const bool render_to_surface_;
 
+  // Accumulated damage for each swapchain image; Key is the address of the
+  // SkSurface that wraps the image.
+  std::map<const SkSurface*, SkIRect> damage_;
+  // The swapchain generation and size of the images in |damage_|.
+  size_t damage_swapchain_generation_ = 0;
+  SkISize damage_frame_size_ = SkISize::MakeEmpty();
+
+  std::optional<SkIRect> GetExistingDamage(const SkSurface* surface);
+
+  void AccumulateDamage(const SkSurface* surface,
+                        const SurfaceFrame& surface_frame);
+
   fml::WeakPtrFactory<GPUSurfaceVulkan> weak_factory_;
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceVulkan);
 };
@@ -6,6 +6,7 @@
 
 #include <EGL/eglext.h>
 
+#include <cstring>
 #include <utility>
 
 #include "flutter/fml/trace_event.h"
@@ -108,7 +109,15 @@ static bool TeardownContext(EGLDisplay display, EGLContext context) {
 AndroidEGLSurface::AndroidEGLSurface(EGLSurface surface,
                                      EGLDisplay display,
                                      EGLContext context)
-    : surface_(surface), display_(display), context_(context) {}
+    : surface_(surface), display_(display), context_(context) {
+  const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+  if (extensions &&
+      strstr(extensions, "EGL_KHR_swap_buffers_with_damage") != nullptr) {
+    swap_buffers_with_damage_ =
+        reinterpret_cast<PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC>(
+            eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+  }
+}
 
 AndroidEGLSurface::~AndroidEGLSurface() {
   auto result = eglDestroySurface(display_, surface_);
@@ -119,7 +128,17 @@ bool AndroidEGLSurface::IsValid() const {
   return surface_ != EGL_NO_SURFACE;
 }
 
+bool AndroidEGLSurface::IsContextCurrent() const {
+  return eglGetCurrentContext() == context_ &&
+         eglGetCurrentDisplay() == display_ &&
+         eglGetCurrentSurface(EGL_DRAW) == surface_ &&
+         eglGetCurrentSurface(EGL_READ) == surface_;
+}
+
 bool AndroidEGLSurface::MakeCurrent() const {
+  if (IsContextCurrent()) {
+    return true;
+  }
   if (eglMakeCurrent(display_, surface_, surface_, context_) != EGL_TRUE) {
     FML_LOG(ERROR) << "Could not make the context current";
     LogLastEGLError();
@@ -128,9 +147,23 @@ bool AndroidEGLSurface::MakeCurrent() const {
   return true;
 }
 
-bool AndroidEGLSurface::SwapBuffers() {
+bool AndroidEGLSurface::SwapBuffers(
+    const std::optional<std::vector<SkIRect>>& surface_damage) {
   TRACE_EVENT0("flutter", "AndroidContextGL::SwapBuffers");
-  return eglSwapBuffers(display_, surface_);
+  if (!surface_damage || !swap_buffers_with_damage_) {
+    return eglSwapBuffers(display_, surface_);
+  }
+  // The damage rects of EGL have their origin at the bottom left.
+  EGLint height = GetSize().height();
+  std::vector<EGLint> rects;
+  for (const SkIRect& rect : *surface_damage) {
+    rects.push_back(rect.left());
+    rects.push_back(height - rect.bottom());
+    rects.push_back(rect.width());
+    rects.push_back(rect.height());
+  }
+  return swap_buffers_with_damage_(display_, surface_, rects.data(),
+                                   surface_damage->size());
 }
 
 SkISize AndroidEGLSurface::GetSize() const {
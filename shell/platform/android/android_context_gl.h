@@ -5,6 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_GL_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_GL_H_
 
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <optional>
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
@@ -12,6 +18,7 @@
 #include "flutter/shell/platform/android/android_environment_gl.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/surface/android_native_window.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -39,17 +46,37 @@ class AndroidEGLSurface {
   /// @brief      Binds the EGLContext context to the current rendering thread
   ///             and to the draw and read surface.
   ///
+  ///             `eglMakeCurrent` can take hundreds of microseconds on some
+  ///             drivers, so it is not called if the context and the surface
+  ///             are already current on this thread.
+  ///
   /// @return     Whether the surface was made current.
   ///
   bool MakeCurrent() const;
 
+  //----------------------------------------------------------------------------
+  /// @return     Whether the context is current on this thread, with this
+  ///             surface as the draw and read surface.
+  ///
+  bool IsContextCurrent() const;
+
   //----------------------------------------------------------------------------
   /// @brief      This only applies to on-screen surfaces such as those created
   ///             by `AndroidContextGL::CreateOnscreenSurface`.
   ///
+  /// @param[in]  surface_damage  The rects of the surface that changed since
+  ///                             the last swap, with the origin at the top
+  ///                             left. If the
+  ///                             `EGL_KHR_swap_buffers_with_damage` extension
+  ///                             is available, the compositor only has to
+  ///                             recompose these rects. If not set, the whole
+  ///                             surface is damaged.
+  ///
   /// @return     Whether the EGL surface color buffer was swapped.
   ///
-  bool SwapBuffers();
+  bool SwapBuffers(
+      const std::optional<std::vector<SkIRect>>& surface_damage =
+          std::nullopt);
 
   //----------------------------------------------------------------------------
   /// @return     The size of an `EGLSurface`.
@@ -60,6 +87,7 @@ class AndroidEGLSurface {
   const EGLSurface surface_;
   const EGLDisplay display_;
   const EGLContext context_;
+  PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC swap_buffers_with_damage_ = nullptr;
 };
 
 //------------------------------------------------------------------------------
@@ -62,6 +62,30 @@ TEST(AndroidContextGl, CreateSingleThread) {
   context.reset();
   EXPECT_TRUE(main_context->abandoned());
 }
+
+TEST(AndroidContextGl, MakeCurrentTracksTheCurrentContext) {
+  auto environment = fml::MakeRefCounted<AndroidEnvironmentGL>();
+  std::string thread_label =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  fml::RefPtr<fml::TaskRunner> platform_runner =
+      fml::MessageLoop::GetCurrent().GetTaskRunner();
+  TaskRunners task_runners =
+      TaskRunners(thread_label, platform_runner, platform_runner,
+                  platform_runner, platform_runner);
+  auto context = std::make_unique<AndroidContextGL>(
+      AndroidRenderingAPI::kOpenGLES, environment, task_runners);
+  auto surface = context->CreatePbufferSurface();
+  ASSERT_TRUE(surface->IsValid());
+  EXPECT_FALSE(surface->IsContextCurrent());
+  ASSERT_TRUE(surface->MakeCurrent());
+  EXPECT_TRUE(surface->IsContextCurrent());
+  // Making the surface current again doesn't change anything.
+  EXPECT_TRUE(surface->MakeCurrent());
+  EXPECT_TRUE(surface->IsContextCurrent());
+  EXPECT_TRUE(context->ClearCurrent());
+  EXPECT_FALSE(surface->IsContextCurrent());
+}
 }  // namespace android
 }  // namespace testing
 }  // namespace flutter
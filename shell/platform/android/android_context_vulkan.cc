@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_context_vulkan.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+
+namespace flutter {
+
+AndroidContextVulkan::AndroidContextVulkan(const TaskRunners& task_runners)
+    : AndroidContext(AndroidRenderingAPI::kVulkan),
+      task_runners_(task_runners),
+      proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()) {
+  if (!proc_table_->HasAcquiredMandatoryProcAddresses()) {
+    FML_LOG(ERROR) << "Could not load the Vulkan library.";
+    return;
+  }
+
+  std::vector<std::string> extensions = {
+      VK_KHR_SURFACE_EXTENSION_NAME,
+      VK_KHR_ANDROID_SURFACE_EXTENSION_NAME,
+  };
+  application_ = std::make_shared<vulkan::VulkanApplication>(
+      *proc_table_, "Flutter", std::move(extensions));
+  if (!application_->IsValid() || !proc_table_->AreInstanceProcsSetup()) {
+    FML_LOG(ERROR) << "Could not create the Vulkan instance.";
+    return;
+  }
+
+  device_ = application_->AcquireFirstCompatibleLogicalDevice();
+  if (!device_ || !device_->IsValid() || !proc_table_->AreDeviceProcsSetup()) {
+    FML_LOG(ERROR) << "Could not create the Vulkan device.";
+    return;
+  }
+
+  valid_ = true;
+}
+
+AndroidContextVulkan::~AndroidContextVulkan() {
+  sk_sp<GrDirectContext> main_context = GetMainSkiaContext();
+  SetMainSkiaContext(nullptr);
+  if (!main_context) {
+    return;
+  }
+  // The Skia context uses the device, so it is released before the device is
+  // destroyed, and on the raster thread that it was used on.
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(task_runners_.GetRasterTaskRunner(), [&] {
+    main_context->releaseResourcesAndAbandonContext();
+    main_context.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+bool AndroidContextVulkan::IsValid() const {
+  return valid_;
+}
+
+const fml::RefPtr<vulkan::VulkanProcTable>&
+AndroidContextVulkan::GetProcTable() const {
+  return proc_table_;
+}
+
+const std::shared_ptr<vulkan::VulkanApplication>&
+AndroidContextVulkan::GetApplication() const {
+  return application_;
+}
+
+const std::shared_ptr<vulkan::VulkanDevice>& AndroidContextVulkan::GetDevice()
+    const {
+  return device_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_VULKAN_H_
+
+#include <memory>
+
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/shell/platform/android/context/android_context.h"
+#include "flutter/vulkan/vulkan_application.h"
+#include "flutter/vulkan/vulkan_device.h"
+#include "flutter/vulkan/vulkan_proc_table.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The Vulkan instance and device that all of the surfaces of a platform view
+/// render with, so that they can share the main Skia context.
+///
+class AndroidContextVulkan : public AndroidContext {
+ public:
+  explicit AndroidContextVulkan(const TaskRunners& task_runners);
+
+  ~AndroidContextVulkan() override;
+
+  // |AndroidContext|
+  bool IsValid() const override;
+
+  const fml::RefPtr<vulkan::VulkanProcTable>& GetProcTable() const;
+
+  const std::shared_ptr<vulkan::VulkanApplication>& GetApplication() const;
+
+  const std::shared_ptr<vulkan::VulkanDevice>& GetDevice() const;
+
+ private:
+  const TaskRunners task_runners_;
+  // The application and the device use the procs of the table, so it is
+  // declared first to outlive them.
+  fml::RefPtr<vulkan::VulkanProcTable> proc_table_;
+  std::shared_ptr<vulkan::VulkanApplication> application_;
+  std::shared_ptr<vulkan::VulkanDevice> device_;
+  bool valid_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidContextVulkan);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_VULKAN_H_
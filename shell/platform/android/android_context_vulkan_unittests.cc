@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include <memory>
+
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/platform/android/android_context_vulkan.h"
+#include "flutter/shell/platform/android/platform_view_android.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+namespace android {
+namespace {
+TaskRunners MakeTaskRunners(const std::string& thread_label,
+                            const ThreadHost& thread_host) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  fml::RefPtr<fml::TaskRunner> platform_runner =
+      fml::MessageLoop::GetCurrent().GetTaskRunner();
+
+  return TaskRunners(thread_label, platform_runner,
+                     thread_host.raster_thread->GetTaskRunner(),
+                     thread_host.ui_thread->GetTaskRunner(),
+                     thread_host.io_thread->GetTaskRunner());
+}
+
+TaskRunners MakeSingleThreadTaskRunners(const std::string& thread_label) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  fml::RefPtr<fml::TaskRunner> platform_runner =
+      fml::MessageLoop::GetCurrent().GetTaskRunner();
+  return TaskRunners(thread_label, platform_runner, platform_runner,
+                     platform_runner, platform_runner);
+}
+}  // namespace
+
+TEST(AndroidContextVulkan, AbandonsMainSkiaContextWhenDestroyed) {
+  std::string thread_label =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host(thread_label, ThreadHost::Type::UI |
+                                           ThreadHost::Type::RASTER |
+                                           ThreadHost::Type::IO);
+  auto context = std::make_unique<AndroidContextVulkan>(
+      MakeTaskRunners(thread_label, thread_host));
+  if (!context->IsValid()) {
+    GTEST_SKIP() << "Vulkan is not supported on this device";
+  }
+  EXPECT_EQ(context->RenderingApi(), AndroidRenderingAPI::kVulkan);
+  EXPECT_TRUE(context->GetProcTable());
+  EXPECT_TRUE(context->GetApplication());
+  EXPECT_TRUE(context->GetDevice());
+
+  GrMockOptions main_context_options;
+  sk_sp<GrDirectContext> main_context =
+      GrDirectContext::MakeMock(&main_context_options);
+  context->SetMainSkiaContext(main_context);
+  // The context is released on the raster thread, which the destructor waits
+  // for.
+  context.reset();
+  EXPECT_TRUE(main_context->abandoned());
+}
+
+TEST(AndroidContextVulkan, AbandonsMainSkiaContextOnSingleThread) {
+  std::string thread_label =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  auto context = std::make_unique<AndroidContextVulkan>(
+      MakeSingleThreadTaskRunners(thread_label));
+  if (!context->IsValid()) {
+    GTEST_SKIP() << "Vulkan is not supported on this device";
+  }
+
+  GrMockOptions main_context_options;
+  sk_sp<GrDirectContext> main_context =
+      GrDirectContext::MakeMock(&main_context_options);
+  context->SetMainSkiaContext(main_context);
+  context.reset();
+  EXPECT_TRUE(main_context->abandoned());
+}
+
+TEST(AndroidSurfaceFactoryImpl, CreatesSoftwareSurface) {
+  std::shared_ptr<AndroidContext> context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+  AndroidSurfaceFactoryImpl factory(context, nullptr);
+  std::unique_ptr<AndroidSurface> surface = factory.CreateSurface();
+  ASSERT_TRUE(surface);
+  EXPECT_TRUE(surface->IsValid());
+  // The software backend never has a resource context.
+  EXPECT_FALSE(surface->ResourceContextMakeCurrent());
+}
+
+TEST(AndroidSurfaceFactoryImpl, CreatesVulkanSurface) {
+  std::string thread_label =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  std::shared_ptr<AndroidContext> context =
+      std::make_shared<AndroidContextVulkan>(
+          MakeSingleThreadTaskRunners(thread_label));
+  if (!context->IsValid()) {
+    GTEST_SKIP() << "Vulkan is not supported on this device";
+  }
+  AndroidSurfaceFactoryImpl factory(context, nullptr);
+  std::unique_ptr<AndroidSurface> surface = factory.CreateSurface();
+  ASSERT_TRUE(surface);
+  EXPECT_TRUE(surface->IsValid());
+
+  // Without a window there is nothing to render to.
+  EXPECT_FALSE(surface->SetNativeWindow(nullptr));
+  EXPECT_EQ(surface->CreateGPUSurface(nullptr), nullptr);
+  EXPECT_FALSE(context->GetMainSkiaContext());
+
+  // Images are uploaded on the raster thread instead.
+  EXPECT_FALSE(surface->ResourceContextMakeCurrent());
+  EXPECT_TRUE(surface->ResourceContextClearCurrent());
+}
+}  // namespace android
+}  // namespace testing
+}  // namespace flutter
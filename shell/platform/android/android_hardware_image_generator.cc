@@ -0,0 +1,336 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_hardware_image_generator.h"
+
+#include <android/bitmap.h>
+#include <android/hardware_buffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <optional>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+struct AImageDecoderHeaderInfo;
+
+namespace flutter {
+
+namespace {
+
+// From <android/imagedecoder.h>, which only declares the functions when
+// targeting API level 30+. They are looked up at runtime instead.
+constexpr int kImageDecoderSuccess = 0;
+constexpr int kBitmapFlagsAlphaOpaque = 0x1;
+
+// The functions this generator needs, which are missing on the devices
+// older than API level 30.
+struct HardwareImageProcs {
+  int (*decoder_create_from_buffer)(const void*, size_t, AImageDecoder**);
+  void (*decoder_delete)(AImageDecoder*);
+  const AImageDecoderHeaderInfo* (*decoder_get_header_info)(
+      const AImageDecoder*);
+  int (*decoder_set_android_bitmap_format)(AImageDecoder*, int32_t);
+  int (*decoder_set_target_size)(AImageDecoder*, int32_t, int32_t);
+  int (*decoder_decode_image)(AImageDecoder*, void*, size_t, size_t);
+  int32_t (*header_info_get_width)(const AImageDecoderHeaderInfo*);
+  int32_t (*header_info_get_height)(const AImageDecoderHeaderInfo*);
+  const char* (*header_info_get_mime_type)(const AImageDecoderHeaderInfo*);
+  int (*header_info_get_alpha_flags)(const AImageDecoderHeaderInfo*);
+  int (*buffer_allocate)(const AHardwareBuffer_Desc*, AHardwareBuffer**);
+  void (*buffer_acquire)(AHardwareBuffer*);
+  void (*buffer_release)(AHardwareBuffer*);
+  void (*buffer_describe)(const AHardwareBuffer*, AHardwareBuffer_Desc*);
+  int (*buffer_lock)(AHardwareBuffer*, uint64_t, int32_t, const ARect*, void**);
+  int (*buffer_unlock)(AHardwareBuffer*, int32_t*);
+  bool is_valid = false;
+};
+
+template <typename T>
+bool ResolveProc(const fml::RefPtr<fml::NativeLibrary>& library,
+                 const char* name,
+                 T* proc) {
+  *proc = library ? library->ResolveFunction<T>(name).value_or(nullptr)
+                  : nullptr;
+  return *proc != nullptr;
+}
+
+HardwareImageProcs LoadProcs() {
+  HardwareImageProcs procs = {};
+  auto jnigraphics = fml::NativeLibrary::Create("libjnigraphics.so");
+  auto android = fml::NativeLibrary::Create("libandroid.so");
+  procs.is_valid =
+      ResolveProc(jnigraphics, "AImageDecoder_createFromBuffer",
+                  &procs.decoder_create_from_buffer) &&
+      ResolveProc(jnigraphics, "AImageDecoder_delete", &procs.decoder_delete) &&
+      ResolveProc(jnigraphics, "AImageDecoder_getHeaderInfo",
+                  &procs.decoder_get_header_info) &&
+      ResolveProc(jnigraphics, "AImageDecoder_setAndroidBitmapFormat",
+                  &procs.decoder_set_android_bitmap_format) &&
+      ResolveProc(jnigraphics, "AImageDecoder_setTargetSize",
+                  &procs.decoder_set_target_size) &&
+      ResolveProc(jnigraphics, "AImageDecoder_decodeImage",
+                  &procs.decoder_decode_image) &&
+      ResolveProc(jnigraphics, "AImageDecoderHeaderInfo_getWidth",
+                  &procs.header_info_get_width) &&
+      ResolveProc(jnigraphics, "AImageDecoderHeaderInfo_getHeight",
+                  &procs.header_info_get_height) &&
+      ResolveProc(jnigraphics, "AImageDecoderHeaderInfo_getMimeType",
+                  &procs.header_info_get_mime_type) &&
+      ResolveProc(jnigraphics, "AImageDecoderHeaderInfo_getAlphaFlags",
+                  &procs.header_info_get_alpha_flags) &&
+      ResolveProc(android, "AHardwareBuffer_allocate",
+                  &procs.buffer_allocate) &&
+      ResolveProc(android, "AHardwareBuffer_acquire", &procs.buffer_acquire) &&
+      ResolveProc(android, "AHardwareBuffer_release", &procs.buffer_release) &&
+      ResolveProc(android, "AHardwareBuffer_describe",
+                  &procs.buffer_describe) &&
+      ResolveProc(android, "AHardwareBuffer_lock", &procs.buffer_lock) &&
+      ResolveProc(android, "AHardwareBuffer_unlock", &procs.buffer_unlock);
+  return procs;
+}
+
+const HardwareImageProcs& GetProcs() {
+  // The libraries stay loaded by the process once the procs are resolved.
+  static const HardwareImageProcs procs = LoadProcs();
+  return procs;
+}
+
+class AndroidHardwareBufferImage final : public HardwareBufferImage {
+ public:
+  // Takes ownership of the reference to the buffer.
+  AndroidHardwareBufferImage(AHardwareBuffer* buffer,
+                             const SkImageInfo& info,
+                             size_t row_bytes)
+      : buffer_(buffer), info_(info), row_bytes_(row_bytes) {}
+
+  ~AndroidHardwareBufferImage() override { GetProcs().buffer_release(buffer_); }
+
+  // |HardwareBufferImage|
+  sk_sp<SkImage> MakeTextureImage(GrDirectContext* context) override {
+#if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
+    // The image imports the buffer in whichever context draws it, so unlike
+    // a texture of the resource context, it can be drawn on the raster
+    // thread.
+    return SkImage::MakeFromAHardwareBuffer(buffer_, info_.alphaType());
+#else
+    // Skia only wraps the buffers when targeting API level 26+. Draw a copy
+    // of its pixels instead.
+    return nullptr;
+#endif
+  }
+
+  // |HardwareBufferImage|
+  sk_sp<SkImage> MakeRasterImage() override {
+    const auto& procs = GetProcs();
+    void* address = nullptr;
+    if (procs.buffer_lock(buffer_, AHARDWAREBUFFER_USAGE_CPU_READ_RARELY, -1,
+                          nullptr, &address) != 0) {
+      FML_DLOG(ERROR) << "Could not lock the hardware buffer for reading.";
+      return nullptr;
+    }
+
+    // The pixels are read straight from the buffer, which stays locked until
+    // the image is collected.
+    procs.buffer_acquire(buffer_);
+    return SkImage::MakeFromRaster(
+        SkPixmap(info_, address, row_bytes_),
+        [](const void* pixels, SkImage::ReleaseContext context) {
+          auto* buffer = static_cast<AHardwareBuffer*>(context);
+          GetProcs().buffer_unlock(buffer, nullptr);
+          GetProcs().buffer_release(buffer);
+        },
+        buffer_);
+  }
+
+ private:
+  AHardwareBuffer* const buffer_;
+  const SkImageInfo info_;
+  const size_t row_bytes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidHardwareBufferImage);
+};
+
+}  // namespace
+
+AndroidHardwareImageGenerator::AndroidHardwareImageGenerator(
+    sk_sp<SkData> data,
+    const SkImageInfo& image_info)
+    : data_(std::move(data)), image_info_(image_info) {}
+
+AndroidHardwareImageGenerator::~AndroidHardwareImageGenerator() = default;
+
+const SkImageInfo& AndroidHardwareImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int AndroidHardwareImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int AndroidHardwareImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo AndroidHardwareImageGenerator::GetFrameInfo(
+    unsigned int frame_index) const {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize AndroidHardwareImageGenerator::GetScaledDimensions(
+    float desired_scale) {
+  // The decoder scales JPEGs while decoding them, so any size is efficient.
+  if (desired_scale >= 1) {
+    return image_info_.dimensions();
+  }
+  return SkISize::Make(
+      std::max(1, static_cast<int>(
+                      std::round(image_info_.width() * desired_scale))),
+      std::max(1, static_cast<int>(
+                      std::round(image_info_.height() * desired_scale))));
+}
+
+bool AndroidHardwareImageGenerator::GetPixels(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes,
+    unsigned int frame_index,
+    std::optional<unsigned int> prior_frame) {
+  TRACE_EVENT0("flutter", "AndroidHardwareImageGenerator::GetPixels");
+  if (info.colorType() != kRGBA_8888_SkColorType ||
+      (info.alphaType() != kPremul_SkAlphaType &&
+       info.alphaType() != image_info_.alphaType())) {
+    return false;
+  }
+
+  AImageDecoder* decoder = CreateDecoder(info.dimensions());
+  if (!decoder) {
+    return false;
+  }
+  const auto& procs = GetProcs();
+  const bool decoded =
+      procs.decoder_decode_image(decoder, pixels, row_bytes,
+                                 row_bytes * info.height()) ==
+      kImageDecoderSuccess;
+  procs.decoder_delete(decoder);
+  return decoded;
+}
+
+std::unique_ptr<HardwareBufferImage>
+AndroidHardwareImageGenerator::DecodeToHardwareBuffer() {
+  TRACE_EVENT0("flutter",
+               "AndroidHardwareImageGenerator::DecodeToHardwareBuffer");
+  const auto& procs = GetProcs();
+
+  AHardwareBuffer_Desc desc = {};
+  desc.width = image_info_.width();
+  desc.height = image_info_.height();
+  desc.layers = 1;
+  desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+  desc.usage = AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE |
+               AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN |
+               AHARDWAREBUFFER_USAGE_CPU_READ_RARELY;
+  AHardwareBuffer* buffer = nullptr;
+  if (procs.buffer_allocate(&desc, &buffer) != 0) {
+    FML_DLOG(ERROR) << "Could not allocate a hardware buffer of size "
+                    << desc.width << "x" << desc.height;
+    return nullptr;
+  }
+  // The buffer is released by the image from here on.
+  procs.buffer_describe(buffer, &desc);
+  const size_t row_bytes = desc.stride * image_info_.bytesPerPixel();
+  auto image = std::make_unique<AndroidHardwareBufferImage>(buffer, image_info_,
+                                                            row_bytes);
+
+  AImageDecoder* decoder = CreateDecoder(image_info_.dimensions());
+  if (!decoder) {
+    return nullptr;
+  }
+  void* address = nullptr;
+  bool decoded = false;
+  if (procs.buffer_lock(buffer, AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN, -1,
+                        nullptr, &address) == 0) {
+    decoded = procs.decoder_decode_image(decoder, address, row_bytes,
+                                         row_bytes * image_info_.height()) ==
+              kImageDecoderSuccess;
+    procs.buffer_unlock(buffer, nullptr);
+  }
+  procs.decoder_delete(decoder);
+
+  if (!decoded) {
+    FML_DLOG(ERROR) << "Could not decode the image into a hardware buffer.";
+    return nullptr;
+  }
+  return image;
+}
+
+AImageDecoder* AndroidHardwareImageGenerator::CreateDecoder(
+    const SkISize& size) const {
+  const auto& procs = GetProcs();
+  AImageDecoder* decoder = nullptr;
+  if (procs.decoder_create_from_buffer(data_->data(), data_->size(),
+                                       &decoder) != kImageDecoderSuccess) {
+    return nullptr;
+  }
+  if (procs.decoder_set_android_bitmap_format(
+          decoder, ANDROID_BITMAP_FORMAT_RGBA_8888) != kImageDecoderSuccess ||
+      (size != image_info_.dimensions() &&
+       procs.decoder_set_target_size(decoder, size.width(), size.height()) !=
+           kImageDecoderSuccess)) {
+    procs.decoder_delete(decoder);
+    return nullptr;
+  }
+  return decoder;
+}
+
+bool AndroidHardwareImageGenerator::IsAvailable() {
+  return GetProcs().is_valid;
+}
+
+std::shared_ptr<ImageGenerator> AndroidHardwareImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  const auto& procs = GetProcs();
+  if (!procs.is_valid || !data || data->size() == 0) {
+    return nullptr;
+  }
+
+  // The decoder only reads the header when it is created.
+  AImageDecoder* decoder = nullptr;
+  if (procs.decoder_create_from_buffer(data->data(), data->size(), &decoder) !=
+      kImageDecoderSuccess) {
+    return nullptr;
+  }
+  const AImageDecoderHeaderInfo* header =
+      procs.decoder_get_header_info(decoder);
+  const char* mime_type = procs.header_info_get_mime_type(header);
+  // The other formats are mostly small images, or animated, which the Skia
+  // codecs decode as well.
+  const bool is_supported =
+      mime_type && (strcmp(mime_type, "image/jpeg") == 0 ||
+                    strcmp(mime_type, "image/heif") == 0);
+  // The dimensions are those of the image once its EXIF orientation has been
+  // applied, which the decoder does by default.
+  const SkImageInfo image_info = SkImageInfo::Make(
+      procs.header_info_get_width(header), procs.header_info_get_height(header),
+      kRGBA_8888_SkColorType,
+      (procs.header_info_get_alpha_flags(header) & kBitmapFlagsAlphaOpaque)
+          ? kOpaque_SkAlphaType
+          : kPremul_SkAlphaType);
+  procs.decoder_delete(decoder);
+
+  if (!is_supported || image_info.isEmpty()) {
+    return nullptr;
+  }
+  return std::shared_ptr<AndroidHardwareImageGenerator>(
+      new AndroidHardwareImageGenerator(std::move(data), image_info));
+}
+
+}  // namespace flutter
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+struct AImageDecoder;
+
+namespace flutter {
+
+/// @brief  Decodes JPEG and HEIF images, such as the photos of the camera,
+///         with the `AImageDecoder` of the platform (API level 30+), which
+///         uses the hardware decoders of the device where there are some.
+///
+///         Full size images are decoded straight into `AHardwareBuffer`s,
+///         which the GPU imports without copying their pixels. Resized images
+///         are decoded into the buffers of `GetPixels`.
+class AndroidHardwareImageGenerator : public ImageGenerator {
+ public:
+  ~AndroidHardwareImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) const override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(
+      const SkImageInfo& info,
+      void* pixels,
+      size_t row_bytes,
+      unsigned int frame_index = 0,
+      std::optional<unsigned int> prior_frame = std::nullopt) override;
+
+  // |ImageGenerator|
+  std::unique_ptr<HardwareBufferImage> DecodeToHardwareBuffer() override;
+
+  /// @brief  Whether the platform has the `AImageDecoder` and
+  ///         `AHardwareBuffer` APIs this generator needs.
+  static bool IsAvailable();
+
+  /// @brief  Creates a generator for the data, or returns null if it isn't a
+  ///         JPEG or HEIF image.
+  static std::shared_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  AndroidHardwareImageGenerator(sk_sp<SkData> data,
+                                const SkImageInfo& image_info);
+
+  // Creates a decoder for a single decode of the data, as decoders can't be
+  // rewound on all API levels.
+  AImageDecoder* CreateDecoder(const SkISize& size) const;
+
+  const sk_sp<SkData> data_;
+  const SkImageInfo image_info_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AndroidHardwareImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
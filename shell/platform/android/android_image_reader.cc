@@ -0,0 +1,205 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_image_reader.h"
+
+#include <android/native_window.h>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+
+namespace flutter {
+
+namespace {
+
+// From <media/NdkImageReader.h> and <media/NdkImage.h>, which only declare
+// the functions when targeting API level 26+.
+constexpr int kMediaStatusOk = 0;
+
+struct ImageReaderImageListener {
+  void* context;
+  void (*on_image_available)(void* context, AImageReader* reader);
+};
+
+struct ImageCropRect {
+  int32_t left;
+  int32_t top;
+  int32_t right;
+  int32_t bottom;
+};
+
+// The images the reader holds: the one that is shown, the one that replaces
+// it, and one the producer can render to in the meantime.
+constexpr int32_t kMaxImages = 3;
+
+// The functions the reader needs, which are missing on the devices older than
+// API level 26.
+struct ImageReaderProcs {
+  int (*reader_new_with_usage)(int32_t,
+                               int32_t,
+                               int32_t,
+                               uint64_t,
+                               int32_t,
+                               AImageReader**);
+  void (*reader_delete)(AImageReader*);
+  int (*reader_get_window)(AImageReader*, ANativeWindow**);
+  int (*reader_set_image_listener)(AImageReader*, ImageReaderImageListener*);
+  int (*reader_acquire_latest_image_async)(AImageReader*, AImage**, int*);
+  int (*image_get_hardware_buffer)(const AImage*, AHardwareBuffer**);
+  int (*image_get_crop_rect)(const AImage*, ImageCropRect*);
+  void (*image_delete_async)(AImage*, int);
+  void (*buffer_describe)(const AHardwareBuffer*, AHardwareBuffer_Desc*);
+  jobject (*window_to_surface)(JNIEnv*, ANativeWindow*);
+  bool is_valid = false;
+};
+
+template <typename T>
+bool ResolveProc(const fml::RefPtr<fml::NativeLibrary>& library,
+                 const char* name,
+                 T* proc) {
+  *proc = library ? library->ResolveFunction<T>(name).value_or(nullptr)
+                  : nullptr;
+  return *proc != nullptr;
+}
+
+ImageReaderProcs LoadProcs() {
+  ImageReaderProcs procs = {};
+  auto mediandk = fml::NativeLibrary::Create("libmediandk.so");
+  auto android = fml::NativeLibrary::Create("libandroid.so");
+  procs.is_valid =
+      ResolveProc(mediandk, "AImageReader_newWithUsage",
+                  &procs.reader_new_with_usage) &&
+      ResolveProc(mediandk, "AImageReader_delete", &procs.reader_delete) &&
+      ResolveProc(mediandk, "AImageReader_getWindow",
+                  &procs.reader_get_window) &&
+      ResolveProc(mediandk, "AImageReader_setImageListener",
+                  &procs.reader_set_image_listener) &&
+      ResolveProc(mediandk, "AImageReader_acquireLatestImageAsync",
+                  &procs.reader_acquire_latest_image_async) &&
+      ResolveProc(mediandk, "AImage_getHardwareBuffer",
+                  &procs.image_get_hardware_buffer) &&
+      ResolveProc(mediandk, "AImage_getCropRect",
+                  &procs.image_get_crop_rect) &&
+      ResolveProc(mediandk, "AImage_deleteAsync",
+                  &procs.image_delete_async) &&
+      ResolveProc(android, "AHardwareBuffer_describe",
+                  &procs.buffer_describe) &&
+      ResolveProc(android, "ANativeWindow_toSurface",
+                  &procs.window_to_surface);
+  return procs;
+}
+
+const ImageReaderProcs& GetProcs() {
+  // The libraries stay loaded by the process once the procs are resolved.
+  static const ImageReaderProcs procs = LoadProcs();
+  return procs;
+}
+
+}  // namespace
+
+struct AndroidImageReader::Listener {
+  std::function<void()> on_image_available;
+  ImageReaderImageListener image_listener;
+};
+
+std::shared_ptr<AndroidImageReader> AndroidImageReader::Create(
+    int32_t width,
+    int32_t height,
+    int32_t format,
+    uint64_t usage,
+    std::function<void()> on_image_available) {
+  const auto& procs = GetProcs();
+  if (!procs.is_valid) {
+    return nullptr;
+  }
+
+  AImageReader* reader = nullptr;
+  if (procs.reader_new_with_usage(width, height, format, usage, kMaxImages,
+                                  &reader) != kMediaStatusOk) {
+    FML_LOG(ERROR) << "Could not create an image reader of size " << width
+                   << "x" << height << ".";
+    return nullptr;
+  }
+
+  auto listener = std::make_unique<Listener>();
+  listener->on_image_available = std::move(on_image_available);
+  listener->image_listener = {
+      .context = listener.get(),
+      .on_image_available =
+          [](void* context, AImageReader*) {
+            static_cast<Listener*>(context)->on_image_available();
+          },
+  };
+  if (procs.reader_set_image_listener(reader, &listener->image_listener) !=
+      kMediaStatusOk) {
+    FML_LOG(ERROR) << "Could not listen to the images of the reader.";
+    procs.reader_delete(reader);
+    return nullptr;
+  }
+
+  return std::shared_ptr<AndroidImageReader>(
+      new AndroidImageReader(reader, std::move(listener)));
+}
+
+AndroidImageReader::AndroidImageReader(AImageReader* reader,
+                                       std::unique_ptr<Listener> listener)
+    : reader_(reader), listener_(std::move(listener)) {}
+
+AndroidImageReader::~AndroidImageReader() {
+  const auto& procs = GetProcs();
+  // The listener is not called once the reader is deleted.
+  procs.reader_set_image_listener(reader_, nullptr);
+  procs.reader_delete(reader_);
+}
+
+jobject AndroidImageReader::CreateSurface(JNIEnv* env) const {
+  const auto& procs = GetProcs();
+  ANativeWindow* window = nullptr;
+  if (procs.reader_get_window(reader_, &window) != kMediaStatusOk ||
+      !window) {
+    return nullptr;
+  }
+  return procs.window_to_surface(env, window);
+}
+
+AImage* AndroidImageReader::AcquireLatestImage(int* acquire_fence) {
+  AImage* image = nullptr;
+  *acquire_fence = -1;
+  if (GetProcs().reader_acquire_latest_image_async(
+          reader_, &image, acquire_fence) != kMediaStatusOk) {
+    return nullptr;
+  }
+  return image;
+}
+
+void AndroidImageReader::DeleteImage(AImage* image, int release_fence) const {
+  GetProcs().image_delete_async(image, release_fence);
+}
+
+AHardwareBuffer* AndroidImageReader::GetHardwareBuffer(const AImage* image) {
+  AHardwareBuffer* buffer = nullptr;
+  if (GetProcs().image_get_hardware_buffer(image, &buffer) != kMediaStatusOk) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+AHardwareBuffer_Desc AndroidImageReader::DescribeBuffer(
+    const AHardwareBuffer* buffer) {
+  AHardwareBuffer_Desc desc = {};
+  GetProcs().buffer_describe(buffer, &desc);
+  return desc;
+}
+
+SkRect AndroidImageReader::GetCropRect(const AImage* image,
+                                       const SkISize& buffer_size) {
+  ImageCropRect crop_rect = {};
+  if (GetProcs().image_get_crop_rect(image, &crop_rect) != kMediaStatusOk) {
+    return SkRect::Make(buffer_size);
+  }
+  return SkRect::MakeLTRB(crop_rect.left, crop_rect.top, crop_rect.right,
+                          crop_rect.bottom);
+}
+
+}  // namespace flutter
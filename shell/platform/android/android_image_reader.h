@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_READER_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_READER_H_
+
+#include <android/hardware_buffer.h>
+#include <jni.h>
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+struct AImage;
+struct AImageReader;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An `AImageReader` whose images are imported by the external
+///             textures of the rendering backends.
+///
+///             The NDK only declares the functions of the reader when
+///             targeting API level 26+, so they are looked up at runtime, and
+///             the reader can't be created on older devices.
+///
+///             The textures share ownership of the reader with the images
+///             that are still in flight, since deleting the reader deletes
+///             all of its images.
+///
+class AndroidImageReader {
+ public:
+  // The format of the buffers that only the GPU can read, which the producer
+  // may pick the layout of.
+  static constexpr int32_t kFormatPrivate = 0x22;
+  static constexpr int32_t kFormatRGBA8888 = 0x1;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a reader that holds a few images of the given size
+  ///             and format, or returns null if the device can't create one.
+  ///
+  /// @param[in]  on_image_available  Called on an internal thread of the
+  ///                                 reader whenever an image is queued.
+  ///
+  static std::shared_ptr<AndroidImageReader> Create(
+      int32_t width,
+      int32_t height,
+      int32_t format,
+      uint64_t usage,
+      std::function<void()> on_image_available);
+
+  ~AndroidImageReader();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a new local reference to the `android.view.Surface`
+  ///             the producer queues its images to, or null on failure.
+  ///
+  jobject CreateSurface(JNIEnv* env) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the latest queued image from the reader, or returns
+  ///             null if there is none.
+  ///
+  /// @param[out] acquire_fence  The fence that signals once the producer is
+  ///                            done rendering to the image, or -1.
+  ///
+  AImage* AcquireLatestImage(int* acquire_fence);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands the image back to the reader once the fence signals,
+  ///             taking ownership of the fence.
+  ///
+  void DeleteImage(AImage* image, int release_fence) const;
+
+  static AHardwareBuffer* GetHardwareBuffer(const AImage* image);
+
+  static AHardwareBuffer_Desc DescribeBuffer(const AHardwareBuffer* buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the region of the buffer of the image that holds its
+  ///             content.
+  ///
+  static SkRect GetCropRect(const AImage* image, const SkISize& buffer_size);
+
+ private:
+  struct Listener;
+
+  AImageReader* const reader_;
+  const std::unique_ptr<Listener> listener_;
+
+  AndroidImageReader(AImageReader* reader, std::unique_ptr<Listener> listener);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidImageReader);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_READER_H_
@@ -0,0 +1,289 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_image_reader_texture_gl.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES/glext.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+namespace {
+
+// How long to block the raster thread on the fence of an image when the GPU
+// can't wait on it instead.
+constexpr int kFenceTimeoutMs = 100;
+
+bool HasExtension(const char* extensions, const char* name) {
+  if (!extensions) {
+    return false;
+  }
+  const size_t length = strlen(name);
+  for (const char* match = strstr(extensions, name); match;
+       match = strstr(match + length, name)) {
+    if ((match == extensions || match[-1] == ' ') &&
+        (match[length] == ' ' || match[length] == '\0')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The EGL extensions that import the buffers and synchronize with their
+// producer.
+struct EGLProcs {
+  PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC get_native_client_buffer;
+  PFNEGLCREATEIMAGEKHRPROC create_image;
+  PFNEGLDESTROYIMAGEKHRPROC destroy_image;
+  PFNGLEGLIMAGETARGETTEXTURE2DOESPROC image_target_texture;
+  PFNEGLCREATESYNCKHRPROC create_sync;
+  PFNEGLDESTROYSYNCKHRPROC destroy_sync;
+  PFNEGLWAITSYNCKHRPROC wait_sync;
+  PFNEGLDUPNATIVEFENCEFDANDROIDPROC dup_native_fence_fd;
+  bool is_valid = false;
+  bool has_native_fence_sync = false;
+};
+
+template <typename T>
+bool ResolveEGLProc(const char* name, T* proc) {
+  *proc = reinterpret_cast<T>(eglGetProcAddress(name));
+  return *proc != nullptr;
+}
+
+EGLProcs LoadEGLProcs(EGLDisplay display) {
+  EGLProcs procs = {};
+  const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+  procs.is_valid =
+      HasExtension(extensions, "EGL_ANDROID_get_native_client_buffer") &&
+      HasExtension(extensions, "EGL_ANDROID_image_native_buffer") &&
+      ResolveEGLProc("eglGetNativeClientBufferANDROID",
+                     &procs.get_native_client_buffer) &&
+      ResolveEGLProc("eglCreateImageKHR", &procs.create_image) &&
+      ResolveEGLProc("eglDestroyImageKHR", &procs.destroy_image) &&
+      ResolveEGLProc("glEGLImageTargetTexture2DOES",
+                     &procs.image_target_texture);
+  procs.has_native_fence_sync =
+      HasExtension(extensions, "EGL_ANDROID_native_fence_sync") &&
+      HasExtension(extensions, "EGL_KHR_wait_sync") &&
+      ResolveEGLProc("eglCreateSyncKHR", &procs.create_sync) &&
+      ResolveEGLProc("eglDestroySyncKHR", &procs.destroy_sync) &&
+      ResolveEGLProc("eglWaitSyncKHR", &procs.wait_sync) &&
+      ResolveEGLProc("eglDupNativeFenceFDANDROID", &procs.dup_native_fence_fd);
+  return procs;
+}
+
+const EGLProcs& GetEGLProcs(EGLDisplay display) {
+  // Android has a single display, so the procs are resolved once.
+  static const EGLProcs procs = LoadEGLProcs(display);
+  return procs;
+}
+
+// Makes the commands that follow wait for the fence, taking ownership of it.
+void WaitForFence(EGLDisplay display, const EGLProcs& egl, int fence_fd) {
+  if (fence_fd < 0) {
+    return;
+  }
+  if (egl.has_native_fence_sync) {
+    const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fence_fd,
+                                 EGL_NONE};
+    EGLSyncKHR sync =
+        egl.create_sync(display, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+    if (sync != EGL_NO_SYNC_KHR) {
+      // The sync owns the fence from now on, and the GPU rather than the
+      // raster thread waits for it.
+      egl.wait_sync(display, sync, 0);
+      egl.destroy_sync(display, sync);
+      return;
+    }
+  }
+  struct pollfd poll_fd = {.fd = fence_fd, .events = POLLIN};
+  if (poll(&poll_fd, 1, kFenceTimeoutMs) <= 0) {
+    FML_DLOG(WARNING) << "The image of the reader was not ready in time.";
+  }
+  close(fence_fd);
+}
+
+}  // namespace
+
+std::shared_ptr<AndroidImageReaderTextureGL>
+AndroidImageReaderTextureGL::Create(int64_t id,
+                                    int32_t width,
+                                    int32_t height,
+                                    std::function<void()> on_frame_available) {
+  auto reader = AndroidImageReader::Create(
+      width, height, AndroidImageReader::kFormatPrivate,
+      AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE, std::move(on_frame_available));
+  if (!reader) {
+    return nullptr;
+  }
+  return std::shared_ptr<AndroidImageReaderTextureGL>(
+      new AndroidImageReaderTextureGL(id, std::move(reader)));
+}
+
+AndroidImageReaderTextureGL::AndroidImageReaderTextureGL(
+    int64_t id,
+    std::shared_ptr<AndroidImageReader> reader)
+    : Texture(id), reader_(std::move(reader)) {}
+
+AndroidImageReaderTextureGL::~AndroidImageReaderTextureGL() {
+  if (image_) {
+    reader_->DeleteImage(image_, -1);
+  }
+  if (texture_name_ != 0) {
+    glDeleteTextures(1, &texture_name_);
+  }
+}
+
+jobject AndroidImageReaderTextureGL::CreateSurface(JNIEnv* env) const {
+  return reader_->CreateSurface(env);
+}
+
+void AndroidImageReaderTextureGL::OnGrContextCreated() {}
+
+void AndroidImageReaderTextureGL::OnGrContextDestroyed() {
+  // The image outlives the context, so that it is shown again once the
+  // texture is recreated.
+  if (texture_name_ != 0) {
+    glDeleteTextures(1, &texture_name_);
+    texture_name_ = 0;
+  }
+}
+
+void AndroidImageReaderTextureGL::MarkNewFrameAvailable() {
+  new_frame_ready_ = true;
+}
+
+void AndroidImageReaderTextureGL::OnTextureUnregistered() {}
+
+void AndroidImageReaderTextureGL::Paint(SkCanvas& canvas,
+                                        const SkRect& bounds,
+                                        bool freeze,
+                                        GrDirectContext* context,
+                                        const SkSamplingOptions& sampling) {
+  if (!context) {
+    return;
+  }
+  if (!freeze && new_frame_ready_) {
+    AcquireLatestImage();
+    new_frame_ready_ = false;
+  }
+  if (image_ && texture_name_ == 0) {
+    BindImage(image_, -1);
+  }
+  if (texture_name_ == 0) {
+    return;
+  }
+  // The texture binding was changed behind Skia's back.
+  context->resetContext(kTextureBinding_GrGLBackendState);
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_EXTERNAL_OES, texture_name_,
+                                  GL_RGBA8_OES};
+  GrBackendTexture backend_texture(texture_size_.width(),
+                                   texture_size_.height(), GrMipMapped::kNo,
+                                   texture_info);
+  sk_sp<SkImage> image = SkImage::MakeFromTexture(
+      context, backend_texture, kTopLeft_GrSurfaceOrigin,
+      kRGBA_8888_SkColorType, kPremul_SkAlphaType, nullptr);
+  if (image) {
+    canvas.drawImageRect(image, crop_rect_, bounds, sampling, nullptr,
+                         SkCanvas::kFast_SrcRectConstraint);
+  }
+}
+
+void AndroidImageReaderTextureGL::AcquireLatestImage() {
+  TRACE_EVENT0("flutter", "AndroidImageReaderTextureGL::AcquireLatestImage");
+  int acquire_fence = -1;
+  AImage* image = reader_->AcquireLatestImage(&acquire_fence);
+  if (!image) {
+    return;
+  }
+  if (!BindImage(image, acquire_fence)) {
+    reader_->DeleteImage(image, -1);
+    return;
+  }
+
+  ReleaseImage();
+  image_ = image;
+
+  AHardwareBuffer_Desc desc = AndroidImageReader::DescribeBuffer(
+      AndroidImageReader::GetHardwareBuffer(image_));
+  texture_size_ = SkISize::Make(desc.width, desc.height);
+  crop_rect_ = AndroidImageReader::GetCropRect(image_, texture_size_);
+}
+
+bool AndroidImageReaderTextureGL::BindImage(AImage* image, int acquire_fence) {
+  EGLDisplay display = eglGetCurrentDisplay();
+  const auto& egl = GetEGLProcs(display);
+  AHardwareBuffer* buffer = AndroidImageReader::GetHardwareBuffer(image);
+  if (!egl.is_valid || !buffer) {
+    if (acquire_fence >= 0) {
+      close(acquire_fence);
+    }
+    return false;
+  }
+
+  const EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+  EGLImageKHR egl_image = egl.create_image(
+      display, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID,
+      egl.get_native_client_buffer(buffer), attributes);
+  if (egl_image == EGL_NO_IMAGE_KHR) {
+    FML_LOG(ERROR) << "Could not import the image of the reader.";
+    if (acquire_fence >= 0) {
+      close(acquire_fence);
+    }
+    return false;
+  }
+
+  // The producer may still be rendering to the buffer.
+  WaitForFence(display, egl, acquire_fence);
+
+  if (texture_name_ == 0) {
+    glGenTextures(1, &texture_name_);
+  }
+  glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture_name_);
+  egl.image_target_texture(GL_TEXTURE_EXTERNAL_OES, egl_image);
+  // The texture keeps the buffer alive.
+  egl.destroy_image(display, egl_image);
+  return true;
+}
+
+void AndroidImageReaderTextureGL::ReleaseImage() {
+  if (!image_) {
+    return;
+  }
+  EGLDisplay display = eglGetCurrentDisplay();
+  const auto& egl = GetEGLProcs(display);
+  // The fence signals once the frames that sampled the image are drawn, and
+  // only then lets the producer render to its buffer again.
+  int release_fence = -1;
+  if (egl.has_native_fence_sync) {
+    EGLSyncKHR sync =
+        egl.create_sync(display, EGL_SYNC_NATIVE_FENCE_ANDROID, nullptr);
+    if (sync != EGL_NO_SYNC_KHR) {
+      // The fence only gets a file descriptor once it is flushed.
+      glFlush();
+      release_fence = egl.dup_native_fence_fd(display, sync);
+      egl.destroy_sync(display, sync);
+    }
+  }
+  if (release_fence < 0) {
+    glFinish();
+  }
+  reader_->DeleteImage(image_, release_fence);
+  image_ = nullptr;
+}
+
+}  // namespace flutter
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_READER_TEXTURE_GL_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_READER_TEXTURE_GL_H_
+
+#include <GLES/gl.h>
+#include <jni.h>
+
+#include <functional>
+#include <memory>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/fml/macros.h"
+#include "flutter/shell/platform/android/android_image_reader.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A texture that shows the latest image queued to the surface of
+///             an `AImageReader`.
+///
+///             Unlike `AndroidExternalTextureGL`, the hardware buffers of the
+///             images are imported into the raster thread's context as
+///             `EGLImage`s, so showing a frame makes no JNI calls, and the
+///             producer and the compositor synchronize with native fences
+///             instead of stalling each other.
+///
+///             The texture needs API level 26+ and an OpenGL ES context that
+///             supports `EGL_ANDROID_get_native_client_buffer` and
+///             `EGL_ANDROID_image_native_buffer`.
+///
+class AndroidImageReaderTextureGL : public flutter::Texture {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a texture whose reader holds images of the given
+  ///             size, or returns null if the device can't create one.
+  ///
+  /// @param[in]  on_frame_available  Called on an internal thread of the
+  ///                                 reader whenever an image is queued.
+  ///
+  static std::shared_ptr<AndroidImageReaderTextureGL> Create(
+      int64_t id,
+      int32_t width,
+      int32_t height,
+      std::function<void()> on_frame_available);
+
+  ~AndroidImageReaderTextureGL() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a new local reference to the `android.view.Surface`
+  ///             the producer queues its images to, or null on failure.
+  ///
+  jobject CreateSurface(JNIEnv* env) const;
+
+  // |Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrDirectContext* context,
+             const SkSamplingOptions& sampling) override;
+
+  // |Texture|
+  void OnGrContextCreated() override;
+
+  // |Texture|
+  void OnGrContextDestroyed() override;
+
+  // |Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |Texture|
+  void OnTextureUnregistered() override;
+
+ private:
+  const std::shared_ptr<AndroidImageReader> reader_;
+  bool new_frame_ready_ = false;
+  // The image that is bound to the texture, which is handed back to the
+  // reader once the GPU is done sampling it.
+  AImage* image_ = nullptr;
+  GLuint texture_name_ = 0;
+  SkISize texture_size_ = SkISize::MakeEmpty();
+  SkRect crop_rect_ = SkRect::MakeEmpty();
+
+  AndroidImageReaderTextureGL(int64_t id,
+                              std::shared_ptr<AndroidImageReader> reader);
+
+  void AcquireLatestImage();
+
+  // Imports the buffer of the image into the texture once the fence signals,
+  // taking ownership of the fence.
+  bool BindImage(AImage* image, int acquire_fence);
+
+  void ReleaseImage();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidImageReaderTextureGL);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_READER_TEXTURE_GL_H_
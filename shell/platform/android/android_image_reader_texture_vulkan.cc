@@ -0,0 +1,280 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_image_reader_texture_vulkan.h"
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/vulkan/vulkan_interface.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/vk/GrVkTypes.h"
+
+namespace flutter {
+
+namespace {
+
+// How long to block the raster thread on the fence of an image. Unlike GL,
+// the fence is not imported into a semaphore the GPU could wait on.
+constexpr int kFenceTimeoutMs = 100;
+
+constexpr VkImageUsageFlags kImageUsage =
+    VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+// The Vulkan objects of an image, which Skia destroys once it is done
+// sampling them.
+struct ImportedImage {
+  std::shared_ptr<AndroidImageReader> reader;
+  fml::RefPtr<vulkan::VulkanProcTable> vk;
+  std::shared_ptr<vulkan::VulkanDevice> device;
+  AImage* image = nullptr;
+  VkImage vk_image = VK_NULL_HANDLE;
+  VkDeviceMemory vk_memory = VK_NULL_HANDLE;
+
+  ~ImportedImage() {
+    VkDevice vk_device = device->GetHandle();
+    if (vk_image != VK_NULL_HANDLE) {
+      vk->DestroyImage(vk_device, vk_image, nullptr);
+    }
+    if (vk_memory != VK_NULL_HANDLE) {
+      vk->FreeMemory(vk_device, vk_memory, nullptr);
+    }
+    // Skia has already waited for the GPU to finish with the image.
+    reader->DeleteImage(image, -1);
+  }
+};
+
+void ReleaseImportedImage(SkImage::ReleaseContext context) {
+  delete static_cast<ImportedImage*>(context);
+}
+
+void WaitForFence(int fence_fd) {
+  if (fence_fd < 0) {
+    return;
+  }
+  struct pollfd poll_fd = {.fd = fence_fd, .events = POLLIN};
+  if (poll(&poll_fd, 1, kFenceTimeoutMs) <= 0) {
+    FML_DLOG(WARNING) << "The image of the reader was not ready in time.";
+  }
+  close(fence_fd);
+}
+
+}  // namespace
+
+std::shared_ptr<AndroidImageReaderTextureVulkan>
+AndroidImageReaderTextureVulkan::Create(
+    int64_t id,
+    int32_t width,
+    int32_t height,
+    fml::RefPtr<vulkan::VulkanProcTable> vk,
+    std::shared_ptr<vulkan::VulkanDevice> device,
+    std::function<void()> on_frame_available) {
+  if (!device || !device->SupportsHardwareBufferImport()) {
+    return nullptr;
+  }
+  auto reader = AndroidImageReader::Create(
+      width, height, AndroidImageReader::kFormatRGBA8888,
+      AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE, std::move(on_frame_available));
+  if (!reader) {
+    return nullptr;
+  }
+  return std::shared_ptr<AndroidImageReaderTextureVulkan>(
+      new AndroidImageReaderTextureVulkan(id, std::move(reader), std::move(vk),
+                                          std::move(device)));
+}
+
+AndroidImageReaderTextureVulkan::AndroidImageReaderTextureVulkan(
+    int64_t id,
+    std::shared_ptr<AndroidImageReader> reader,
+    fml::RefPtr<vulkan::VulkanProcTable> vk,
+    std::shared_ptr<vulkan::VulkanDevice> device)
+    : Texture(id),
+      reader_(std::move(reader)),
+      vk_(std::move(vk)),
+      device_(std::move(device)) {}
+
+AndroidImageReaderTextureVulkan::~AndroidImageReaderTextureVulkan() = default;
+
+jobject AndroidImageReaderTextureVulkan::CreateSurface(JNIEnv* env) const {
+  return reader_->CreateSurface(env);
+}
+
+void AndroidImageReaderTextureVulkan::OnGrContextCreated() {}
+
+void AndroidImageReaderTextureVulkan::OnGrContextDestroyed() {
+  // The image belongs to the context, so the texture shows nothing until the
+  // producer queues the next one.
+  image_.reset();
+}
+
+void AndroidImageReaderTextureVulkan::MarkNewFrameAvailable() {
+  new_frame_ready_ = true;
+}
+
+void AndroidImageReaderTextureVulkan::OnTextureUnregistered() {}
+
+void AndroidImageReaderTextureVulkan::Paint(SkCanvas& canvas,
+                                            const SkRect& bounds,
+                                            bool freeze,
+                                            GrDirectContext* context,
+                                            const SkSamplingOptions& sampling) {
+  if (!context) {
+    return;
+  }
+  if (!freeze && new_frame_ready_) {
+    AcquireLatestImage(context);
+    new_frame_ready_ = false;
+  }
+  if (image_) {
+    canvas.drawImageRect(image_, crop_rect_, bounds, sampling, nullptr,
+                         SkCanvas::kFast_SrcRectConstraint);
+  }
+}
+
+void AndroidImageReaderTextureVulkan::AcquireLatestImage(
+    GrDirectContext* context) {
+  TRACE_EVENT0("flutter",
+               "AndroidImageReaderTextureVulkan::AcquireLatestImage");
+  int acquire_fence = -1;
+  AImage* image = reader_->AcquireLatestImage(&acquire_fence);
+  if (!image) {
+    return;
+  }
+  sk_sp<SkImage> sk_image = ImportImage(context, image, acquire_fence);
+  if (!sk_image) {
+    return;
+  }
+  // The image stays valid for as long as the Skia image wraps it.
+  crop_rect_ = AndroidImageReader::GetCropRect(image, sk_image->dimensions());
+  image_ = std::move(sk_image);
+}
+
+sk_sp<SkImage> AndroidImageReaderTextureVulkan::ImportImage(
+    GrDirectContext* context,
+    AImage* image,
+    int acquire_fence) {
+  // Deleting the holder hands the image back to the reader and destroys the
+  // Vulkan objects created so far.
+  auto imported = std::make_unique<ImportedImage>();
+  imported->reader = reader_;
+  imported->vk = vk_;
+  imported->device = device_;
+  imported->image = image;
+
+  AHardwareBuffer* buffer = AndroidImageReader::GetHardwareBuffer(image);
+  if (!buffer) {
+    WaitForFence(acquire_fence);
+    return nullptr;
+  }
+  const AHardwareBuffer_Desc desc = AndroidImageReader::DescribeBuffer(buffer);
+  VkDevice vk_device = device_->GetHandle();
+
+  VkAndroidHardwareBufferFormatPropertiesANDROID format_properties = {
+      .sType =
+          VK_STRUCTURE_TYPE_ANDROID_HARDWARE_BUFFER_FORMAT_PROPERTIES_ANDROID,
+  };
+  VkAndroidHardwareBufferPropertiesANDROID buffer_properties = {
+      .sType = VK_STRUCTURE_TYPE_ANDROID_HARDWARE_BUFFER_PROPERTIES_ANDROID,
+      .pNext = &format_properties,
+  };
+  if (VK_CALL_LOG_ERROR(vk_->GetAndroidHardwareBufferPropertiesANDROID(
+          vk_device, buffer, &buffer_properties)) != VK_SUCCESS ||
+      format_properties.format == VK_FORMAT_UNDEFINED ||
+      buffer_properties.memoryTypeBits == 0) {
+    FML_LOG(ERROR) << "Could not import the image of the reader.";
+    WaitForFence(acquire_fence);
+    return nullptr;
+  }
+
+  VkExternalMemoryImageCreateInfo external_image_info = {
+      .sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO,
+      .pNext = nullptr,
+      .handleTypes =
+          VK_EXTERNAL_MEMORY_HANDLE_TYPE_ANDROID_HARDWARE_BUFFER_BIT_ANDROID,
+  };
+  const VkImageCreateInfo image_create_info = {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+      .pNext = &external_image_info,
+      .flags = 0,
+      .imageType = VK_IMAGE_TYPE_2D,
+      .format = format_properties.format,
+      .extent = {desc.width, desc.height, 1},
+      .mipLevels = 1,
+      .arrayLayers = 1,
+      .samples = VK_SAMPLE_COUNT_1_BIT,
+      .tiling = VK_IMAGE_TILING_OPTIMAL,
+      .usage = kImageUsage,
+      .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+      .queueFamilyIndexCount = 0,
+      .pQueueFamilyIndices = nullptr,
+      .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+  if (VK_CALL_LOG_ERROR(vk_->CreateImage(vk_device, &image_create_info,
+                                         nullptr, &imported->vk_image)) !=
+      VK_SUCCESS) {
+    WaitForFence(acquire_fence);
+    return nullptr;
+  }
+
+  VkImportAndroidHardwareBufferInfoANDROID import_info = {
+      .sType = VK_STRUCTURE_TYPE_IMPORT_ANDROID_HARDWARE_BUFFER_INFO_ANDROID,
+      .pNext = nullptr,
+      .buffer = buffer,
+  };
+  VkMemoryDedicatedAllocateInfo dedicated_info = {
+      .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+      .pNext = &import_info,
+      .image = imported->vk_image,
+      .buffer = VK_NULL_HANDLE,
+  };
+  const VkMemoryAllocateInfo allocation_info = {
+      .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+      .pNext = &dedicated_info,
+      .allocationSize = buffer_properties.allocationSize,
+      .memoryTypeIndex = static_cast<uint32_t>(
+          __builtin_ctz(buffer_properties.memoryTypeBits)),
+  };
+  if (VK_CALL_LOG_ERROR(vk_->AllocateMemory(vk_device, &allocation_info,
+                                            nullptr, &imported->vk_memory)) !=
+          VK_SUCCESS ||
+      VK_CALL_LOG_ERROR(vk_->BindImageMemory(vk_device, imported->vk_image,
+                                             imported->vk_memory, 0)) !=
+          VK_SUCCESS) {
+    WaitForFence(acquire_fence);
+    return nullptr;
+  }
+
+  GrVkAlloc alloc;
+  alloc.fMemory = imported->vk_memory;
+  alloc.fOffset = 0;
+  alloc.fSize = allocation_info.allocationSize;
+  alloc.fFlags = 0;
+
+  GrVkImageInfo image_info;
+  image_info.fImage = imported->vk_image;
+  image_info.fAlloc = alloc;
+  image_info.fImageTiling = image_create_info.tiling;
+  image_info.fImageLayout = image_create_info.initialLayout;
+  image_info.fFormat = image_create_info.format;
+  image_info.fImageUsageFlags = image_create_info.usage;
+  image_info.fSampleCount = 1;
+  image_info.fLevelCount = image_create_info.mipLevels;
+  // Skia acquires the image from the producer before sampling it.
+  image_info.fCurrentQueueFamily = VK_QUEUE_FAMILY_FOREIGN_EXT;
+
+  // The producer may still be rendering to the buffer.
+  WaitForFence(acquire_fence);
+
+  GrBackendTexture backend_texture(desc.width, desc.height, image_info);
+  return SkImage::MakeFromTexture(
+      context, backend_texture, kTopLeft_GrSurfaceOrigin,
+      kRGBA_8888_SkColorType, kPremul_SkAlphaType, nullptr,
+      ReleaseImportedImage, imported.release());
+}
+
+}  // namespace flutter
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_READER_TEXTURE_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_READER_TEXTURE_VULKAN_H_
+
+#include <jni.h>
+
+#include <functional>
+#include <memory>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/shell/platform/android/android_image_reader.h"
+#include "flutter/vulkan/vulkan_device.h"
+#include "flutter/vulkan/vulkan_proc_table.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The Vulkan counterpart of `AndroidImageReaderTextureGL`, which
+///             imports the hardware buffers of the images as `VkImage`s.
+///
+///             The images are RGBA, since the buffers of other formats would
+///             need a sampler conversion that Skia can't be handed here. The
+///             device must support `VK_ANDROID_external_memory_android_
+///             hardware_buffer`.
+///
+class AndroidImageReaderTextureVulkan : public flutter::Texture {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a texture whose reader holds images of the given
+  ///             size, or returns null if the device can't create one.
+  ///
+  /// @param[in]  on_frame_available  Called on an internal thread of the
+  ///                                 reader whenever an image is queued.
+  ///
+  static std::shared_ptr<AndroidImageReaderTextureVulkan> Create(
+      int64_t id,
+      int32_t width,
+      int32_t height,
+      fml::RefPtr<vulkan::VulkanProcTable> vk,
+      std::shared_ptr<vulkan::VulkanDevice> device,
+      std::function<void()> on_frame_available);
+
+  ~AndroidImageReaderTextureVulkan() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a new local reference to the `android.view.Surface`
+  ///             the producer queues its images to, or null on failure.
+  ///
+  jobject CreateSurface(JNIEnv* env) const;
+
+  // |Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrDirectContext* context,
+             const SkSamplingOptions& sampling) override;
+
+  // |Texture|
+  void OnGrContextCreated() override;
+
+  // |Texture|
+  void OnGrContextDestroyed() override;
+
+  // |Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |Texture|
+  void OnTextureUnregistered() override;
+
+ private:
+  const std::shared_ptr<AndroidImageReader> reader_;
+  const fml::RefPtr<vulkan::VulkanProcTable> vk_;
+  const std::shared_ptr<vulkan::VulkanDevice> device_;
+  bool new_frame_ready_ = false;
+  // Skia hands the image back to the reader once it is no longer sampled.
+  sk_sp<SkImage> image_;
+  SkRect crop_rect_ = SkRect::MakeEmpty();
+
+  AndroidImageReaderTextureVulkan(int64_t id,
+                                  std::shared_ptr<AndroidImageReader> reader,
+                                  fml::RefPtr<vulkan::VulkanProcTable> vk,
+                                  std::shared_ptr<vulkan::VulkanDevice> device);
+
+  void AcquireLatestImage(GrDirectContext* context);
+
+  // Wraps the buffer of the image in a Skia image, taking ownership of the
+  // image and of the fence.
+  sk_sp<SkImage> ImportImage(GrDirectContext* context,
+                             AImage* image,
+                             int acquire_fence);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidImageReaderTextureVulkan);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_READER_TEXTURE_VULKAN_H_
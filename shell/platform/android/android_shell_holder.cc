@@ -25,12 +25,51 @@
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/platform/android/android_hardware_image_generator.h"
 #include "flutter/shell/platform/android/android_image_generator.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
+#include "flutter/shell/profiling/profiler_metrics_linux.h"
 
 namespace flutter {
 
+static constexpr int kNumProfilerSamplesPerSec = 5;
+
+/// Maps the priorities of the engine threads to nice values.
+static void AndroidPlatformThreadConfigSetter(
+    const fml::Thread::ThreadConfig& config) {
+  fml::Thread::SetCurrentThreadConfig(config);
+  switch (config.priority) {
+    case fml::Thread::ThreadPriority::kBackground: {
+      if (::setpriority(PRIO_PROCESS, gettid(), 1) != 0) {
+        FML_LOG(ERROR) << "Failed to set IO task runner priority";
+      }
+      break;
+    }
+    case fml::Thread::ThreadPriority::kDisplay: {
+      if (::setpriority(PRIO_PROCESS, gettid(), -1) != 0) {
+        FML_LOG(ERROR) << "Failed to set UI task runner priority";
+      }
+      break;
+    }
+    case fml::Thread::ThreadPriority::kRaster: {
+      // Android describes -8 as "most important display threads, for
+      // compositing the screen and retrieving input events". Conservatively
+      // set the raster thread to slightly lower priority than it.
+      if (::setpriority(PRIO_PROCESS, gettid(), -5) != 0) {
+        // Defensive fallback. Depending on the OEM, it may not be possible
+        // to set priority to -5.
+        if (::setpriority(PRIO_PROCESS, gettid(), -2) != 0) {
+          FML_LOG(ERROR) << "Failed to set raster task runner priority";
+        }
+      }
+      break;
+    }
+    case fml::Thread::ThreadPriority::kNormal:
+      break;
+  }
+}
+
 static PlatformData GetDefaultPlatformData() {
   PlatformData platform_data;
   platform_data.lifecycle_state = "AppLifecycleState.detached";
@@ -44,10 +83,14 @@ AndroidShellHolder::AndroidShellHolder(
   static size_t thread_host_count = 1;
   auto thread_label = std::to_string(thread_host_count++);
 
-  thread_host_ = std::make_shared<ThreadHost>();
-  *thread_host_ = {thread_label, ThreadHost::Type::UI |
-                                     ThreadHost::Type::RASTER |
-                                     ThreadHost::Type::IO};
+  uint64_t thread_host_type = ThreadHost::Type::UI | ThreadHost::Type::RASTER |
+                              ThreadHost::Type::IO;
+  if (IsProfilerEnabled()) {
+    thread_host_type |= ThreadHost::Type::Profiler;
+  }
+  thread_host_ = std::make_shared<ThreadHost>(
+      ThreadHost::ThreadHostConfig::MakePerformanceCoreConfig(
+          thread_label, thread_host_type, AndroidPlatformThreadConfigSetter));
 
   fml::WeakPtr<PlatformViewAndroid> weak_platform_view;
   Shell::CreateCallback<PlatformView> on_create_platform_view =
@@ -58,7 +101,8 @@ AndroidShellHolder::AndroidShellHolder(
             shell.GetTaskRunners(),  // task runners
             jni_facade,              // JNI interop
             shell.GetSettings()
-                .enable_software_rendering  // use software rendering
+                .enable_software_rendering,  // use software rendering
+            shell.GetSettings().enable_vulkan  // use Vulkan if supported
         );
         weak_platform_view = platform_view_android->GetWeakPtr();
         auto display = Display(jni_facade->GetDisplayRefreshRate());
@@ -88,29 +132,6 @@ AndroidShellHolder::AndroidShellHolder(
                                     ui_runner,        // ui
                                     io_runner         // io
   );
-  task_runners.GetRasterTaskRunner()->PostTask([]() {
-    // Android describes -8 as "most important display threads, for
-    // compositing the screen and retrieving input events". Conservatively
-    // set the raster thread to slightly lower priority than it.
-    if (::setpriority(PRIO_PROCESS, gettid(), -5) != 0) {
-      // Defensive fallback. Depending on the OEM, it may not be possible
-      // to set priority to -5.
-      if (::setpriority(PRIO_PROCESS, gettid(), -2) != 0) {
-        FML_LOG(ERROR) << "Failed to set raster task runner priority";
-      }
-    }
-  });
-  task_runners.GetUITaskRunner()->PostTask([]() {
-    if (::setpriority(PRIO_PROCESS, gettid(), -1) != 0) {
-      FML_LOG(ERROR) << "Failed to set UI task runner priority";
-    }
-  });
-  task_runners.GetIOTaskRunner()->PostTask([]() {
-    if (::setpriority(PRIO_PROCESS, gettid(), 1) != 0) {
-      FML_LOG(ERROR) << "Failed to set IO task runner priority";
-    }
-  });
-
   shell_ =
       Shell::Create(GetDefaultPlatformData(),  // window data
                     task_runners,              // task runners
@@ -132,11 +153,27 @@ AndroidShellHolder::AndroidShellHolder(
         },
         -1);
     FML_DLOG(INFO) << "Registered Android SDK image decoder (API level 28+)";
+
+    // Camera photos are decoded by the platform ahead of the Skia codecs,
+    // straight into memory that the GPU can import.
+    if (AndroidHardwareImageGenerator::IsAvailable()) {
+      shell_->RegisterImageDecoder(
+          [](sk_sp<SkData> buffer) {
+            return AndroidHardwareImageGenerator::MakeFromData(
+                std::move(buffer));
+          },
+          1);
+      FML_DLOG(INFO) << "Registered Android NDK image decoder (API level 30+)";
+    }
   }
 
   platform_view_ = weak_platform_view;
   FML_DCHECK(platform_view_);
   is_valid_ = shell_ != nullptr;
+
+  if (is_valid_ && IsProfilerEnabled()) {
+    StartProfiler(thread_label);
+  }
 }
 
 AndroidShellHolder::AndroidShellHolder(
@@ -159,6 +196,8 @@ AndroidShellHolder::AndroidShellHolder(
 }
 
 AndroidShellHolder::~AndroidShellHolder() {
+  // The profiler waits for its last sample on the profiler thread.
+  profiler_.reset();
   shell_.reset();
   thread_host_.reset();
 }
@@ -167,6 +206,26 @@ bool AndroidShellHolder::IsValid() const {
   return is_valid_;
 }
 
+bool AndroidShellHolder::IsProfilerEnabled() {
+#if (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG) || \
+    (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_PROFILE)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AndroidShellHolder::StartProfiler(const std::string& thread_label) {
+  FML_DCHECK(thread_host_->profiler_thread);
+  profiler_ = std::make_unique<SamplingProfiler>(
+      thread_label.c_str(), thread_host_->profiler_thread->GetTaskRunner(),
+      [metrics = std::make_shared<ProfilerMetricsLinux>()]() {
+        return metrics->GenerateSample();
+      },
+      kNumProfilerSamplesPerSec);
+  profiler_->Start();
+}
+
 const flutter::Settings& AndroidShellHolder::GetSettings() const {
   return settings_;
 }
@@ -18,6 +18,7 @@
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "flutter/shell/platform/android/platform_message_handler_android.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
+#include "flutter/shell/profiling/sampling_profiler.h"
 
 namespace flutter {
 
@@ -108,6 +109,9 @@ class AndroidShellHolder {
   fml::WeakPtr<PlatformViewAndroid> platform_view_;
   std::shared_ptr<ThreadHost> thread_host_;
   std::unique_ptr<Shell> shell_;
+  // Samples the CPU and memory usage of the process and of the engine threads
+  // in debug and profile builds.
+  std::unique_ptr<SamplingProfiler> profiler_;
   bool is_valid_ = false;
   uint64_t next_pointer_flow_id_ = 0;
   std::shared_ptr<AssetManager> asset_manager_;
@@ -136,6 +140,10 @@ class AndroidShellHolder {
 
   bool IsNDKImageDecoderAvailable();
 
+  static bool IsProfilerEnabled();
+
+  void StartProfiler(const std::string& thread_label);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidShellHolder);
 };
 
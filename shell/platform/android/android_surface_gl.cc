@@ -92,6 +92,9 @@ bool AndroidSurfaceGL::ResourceContextMakeCurrent() {
 
 bool AndroidSurfaceGL::ResourceContextClearCurrent() {
   FML_DCHECK(IsValid());
+  if (eglGetCurrentContext() == EGL_NO_CONTEXT) {
+    return true;
+  }
   EGLBoolean result = eglMakeCurrent(eglGetCurrentDisplay(), EGL_NO_SURFACE,
                                      EGL_NO_SURFACE, EGL_NO_CONTEXT);
   return result == EGL_TRUE;
@@ -126,10 +129,16 @@ bool AndroidSurfaceGL::GLContextClearCurrent() {
   return GLContextPtr()->ClearCurrent();
 }
 
-bool AndroidSurfaceGL::GLContextPresent(uint32_t fbo_id) {
+bool AndroidSurfaceGL::GLContextPresent(const GLPresentInfo& present_info) {
   FML_DCHECK(IsValid());
   FML_DCHECK(onscreen_surface_);
-  return onscreen_surface_->SwapBuffers();
+  return onscreen_surface_->SwapBuffers(present_info.frame_damage);
+}
+
+bool AndroidSurfaceGL::GLContextAllowsPresentOnAnyThread() const {
+  // eglSwapBuffers only requires the context to be current on the calling
+  // thread.
+  return true;
 }
 
 intptr_t AndroidSurfaceGL::GLContextFBO(GLFrameInfo frame_info) const {
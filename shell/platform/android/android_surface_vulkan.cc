@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_surface_vulkan.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/shell/gpu/gpu_surface_vulkan.h"
+#include "flutter/vulkan/vulkan_native_surface_android.h"
+
+namespace flutter {
+
+AndroidSurfaceVulkan::AndroidSurfaceVulkan(
+    const std::shared_ptr<AndroidContext>& android_context)
+    : AndroidSurface(android_context) {}
+
+AndroidSurfaceVulkan::~AndroidSurfaceVulkan() = default;
+
+bool AndroidSurfaceVulkan::IsValid() const {
+  return VulkanContextPtr()->IsValid();
+}
+
+void AndroidSurfaceVulkan::TeardownOnScreenContext() {
+  // The swapchain is owned by the GPU surface, which the rasterizer has
+  // already collected by now.
+  native_window_ = nullptr;
+}
+
+std::unique_ptr<Surface> AndroidSurfaceVulkan::CreateGPUSurface(
+    GrDirectContext* gr_context) {
+  if (!IsValid() || !native_window_ || !native_window_->IsValid()) {
+    return nullptr;
+  }
+
+  auto native_surface = std::make_unique<vulkan::VulkanNativeSurfaceAndroid>(
+      native_window_->handle());
+  if (!native_surface->IsValid()) {
+    return nullptr;
+  }
+
+  sk_sp<GrDirectContext> context =
+      gr_context ? sk_ref_sp(gr_context)
+                 : VulkanContextPtr()->GetMainSkiaContext();
+  auto surface = std::make_unique<GPUSurfaceVulkan>(
+      VulkanContextPtr()->GetApplication(), VulkanContextPtr()->GetDevice(),
+      context, this, std::move(native_surface), true);
+  if (!surface->IsValid()) {
+    return nullptr;
+  }
+
+  // The first surface creates the Skia context that the later surfaces and
+  // the overlay surfaces of platform views reuse.
+  if (!VulkanContextPtr()->GetMainSkiaContext()) {
+    VulkanContextPtr()->SetMainSkiaContext(sk_ref_sp(surface->GetContext()));
+  }
+  return surface;
+}
+
+bool AndroidSurfaceVulkan::OnScreenSurfaceResize(const SkISize& size) {
+  // The swapchain is recreated when the size of the window no longer matches
+  // the size of its images.
+  return true;
+}
+
+bool AndroidSurfaceVulkan::ResourceContextMakeCurrent() {
+  // There is no resource context to upload images on the IO thread with, so
+  // images are uploaded on the raster thread instead.
+  return false;
+}
+
+bool AndroidSurfaceVulkan::ResourceContextClearCurrent() {
+  return true;
+}
+
+bool AndroidSurfaceVulkan::SetNativeWindow(
+    fml::RefPtr<AndroidNativeWindow> window) {
+  native_window_ = std::move(window);
+  return native_window_ && native_window_->IsValid();
+}
+
+fml::RefPtr<vulkan::VulkanProcTable> AndroidSurfaceVulkan::vk() {
+  return VulkanContextPtr()->GetProcTable();
+}
+
+AndroidContextVulkan* AndroidSurfaceVulkan::VulkanContextPtr() const {
+  return reinterpret_cast<AndroidContextVulkan*>(android_context_.get());
+}
+
+}  // namespace flutter
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_VULKAN_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
+#include "flutter/shell/platform/android/android_context_vulkan.h"
+#include "flutter/shell/platform/android/surface/android_surface.h"
+
+namespace flutter {
+
+class AndroidSurfaceVulkan final : public GPUSurfaceVulkanDelegate,
+                                   public AndroidSurface {
+ public:
+  explicit AndroidSurfaceVulkan(
+      const std::shared_ptr<AndroidContext>& android_context);
+
+  ~AndroidSurfaceVulkan() override;
+
+  // |AndroidSurface|
+  bool IsValid() const override;
+
+  // |AndroidSurface|
+  std::unique_ptr<Surface> CreateGPUSurface(
+      GrDirectContext* gr_context) override;
+
+  // |AndroidSurface|
+  void TeardownOnScreenContext() override;
+
+  // |AndroidSurface|
+  bool OnScreenSurfaceResize(const SkISize& size) override;
+
+  // |AndroidSurface|
+  bool ResourceContextMakeCurrent() override;
+
+  // |AndroidSurface|
+  bool ResourceContextClearCurrent() override;
+
+  // |AndroidSurface|
+  bool SetNativeWindow(fml::RefPtr<AndroidNativeWindow> window) override;
+
+  // |GPUSurfaceVulkanDelegate|
+  fml::RefPtr<vulkan::VulkanProcTable> vk() override;
+
+ private:
+  fml::RefPtr<AndroidNativeWindow> native_window_;
+
+  AndroidContextVulkan* VulkanContextPtr() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceVulkan);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_VULKAN_H_
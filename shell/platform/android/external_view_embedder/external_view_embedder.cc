@@ -83,7 +83,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     return;
   }
 
-  std::unordered_map<int64_t, SkRect> overlay_layers;
+  std::unordered_map<int64_t, OverlayContents> overlay_layers;
   std::unordered_map<int64_t, sk_sp<SkPicture>> pictures;
   SkCanvas* background_canvas = frame->SkiaCanvas();
   auto current_frame_view_count = composition_order_.size();
@@ -132,13 +132,16 @@ void AndroidExternalViewEmbedder::SubmitFrame(
       //
       // For example, {0.3, 0.5, 3.1, 4.7} becomes {0, 0, 4, 5}.
       joined_rect.set(joined_rect.roundOut());
-      overlay_layers.insert({view_id, joined_rect});
+      overlay_layers.insert(
+          {view_id, {joined_rect, {{pictures.at(view_id), joined_rect}}}});
       // Clip the background canvas, so it doesn't contain any of the pixels
       // drawn on the overlay layer.
       background_canvas->clipRect(joined_rect, SkClipOp::kDifference);
     }
     background_canvas->drawPicture(pictures.at(view_id));
   }
+  MergeOverlayLayers(overlay_layers);
+
   // Submit the background canvas frame before switching the GL context to
   // the overlay surfaces.
   //
@@ -164,34 +167,87 @@ void AndroidExternalViewEmbedder::SubmitFrame(
         params.sizePoints().height() * device_pixel_ratio_,
         params.mutatorsStack()  //
     );
-    std::unordered_map<int64_t, SkRect>::const_iterator overlay =
+    std::unordered_map<int64_t, OverlayContents>::const_iterator overlay =
         overlay_layers.find(view_id);
     if (overlay == overlay_layers.end()) {
       continue;
     }
     std::unique_ptr<SurfaceFrame> frame =
-        CreateSurfaceIfNeeded(context,               //
-                              view_id,               //
-                              pictures.at(view_id),  //
-                              overlay->second        //
-        );
+        CreateSurfaceIfNeeded(context, overlay->second);
     if (should_submit_current_frame) {
       frame->Submit();
     }
   }
 }
 
+void AndroidExternalViewEmbedder::MergeOverlayLayers(
+    std::unordered_map<int64_t, OverlayContents>& overlay_layers) {
+  // Moving the UI of a platform view below a level in the composition order
+  // moves it below the platform view and the overlay of that level.
+  for (size_t i = 1; i < composition_order_.size(); i++) {
+    auto overlay = overlay_layers.find(composition_order_[i]);
+    if (overlay == overlay_layers.end()) {
+      continue;
+    }
+    const SkRect& rect = overlay->second.rect;
+    auto target = overlay_layers.end();
+    for (size_t level = i; level > 0; level--) {
+      if (rect.intersects(GetViewRect(composition_order_[level]))) {
+        break;
+      }
+      auto lower_overlay = overlay_layers.find(composition_order_[level - 1]);
+      if (lower_overlay == overlay_layers.end()) {
+        continue;
+      }
+      target = lower_overlay;
+      if (rect.intersects(lower_overlay->second.rect)) {
+        break;
+      }
+    }
+    if (target == overlay_layers.end()) {
+      continue;
+    }
+    target->second.rect.join(rect);
+    for (auto& slice : overlay->second.slices) {
+      target->second.slices.push_back(std::move(slice));
+    }
+    overlay_layers.erase(overlay);
+  }
+
+  if (overlay_layers.size() <= kMaxOverlayLayers) {
+    return;
+  }
+  // Past the budget, the remaining UI is drawn into the overlay of the topmost
+  // platform view that has one, so it may cover the platform views in between.
+  std::vector<int64_t> overlay_view_ids;
+  for (int64_t view_id : composition_order_) {
+    if (overlay_layers.count(view_id) == 1) {
+      overlay_view_ids.push_back(view_id);
+    }
+  }
+  OverlayContents topmost_overlay = {SkRect::MakeEmpty(), {}};
+  for (size_t i = kMaxOverlayLayers - 1; i < overlay_view_ids.size(); i++) {
+    auto overlay = overlay_layers.find(overlay_view_ids[i]);
+    topmost_overlay.rect.join(overlay->second.rect);
+    for (auto& slice : overlay->second.slices) {
+      topmost_overlay.slices.push_back(std::move(slice));
+    }
+    overlay_layers.erase(overlay);
+  }
+  overlay_layers.insert({overlay_view_ids.back(), std::move(topmost_overlay)});
+}
+
 // |ExternalViewEmbedder|
 std::unique_ptr<SurfaceFrame>
-AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                   int64_t view_id,
-                                                   sk_sp<SkPicture> picture,
-                                                   const SkRect& rect) {
+AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(
+    GrDirectContext* context,
+    const OverlayContents& overlay) {
   std::shared_ptr<OverlayLayer> layer = surface_pool_->GetLayer(
       context, android_context_, jni_facade_, surface_factory_);
 
   std::unique_ptr<SurfaceFrame> frame =
       layer->surface->AcquireFrame(frame_size_);
+  const SkRect& rect = overlay.rect;
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
   jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
@@ -205,7 +261,13 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
   // Offset the picture since its absolute position on the scene is determined
   // by the position of the overlay view.
   overlay_canvas->translate(-rect.x(), -rect.y());
-  overlay_canvas->drawPicture(picture);
+  for (const auto& [picture, slice_rect] : overlay.slices) {
+    // Clip each picture to its own rect, since the rest of the picture was
+    // drawn into the background canvas.
+    SkAutoCanvasRestore save(overlay_canvas, /*doSave=*/true);
+    overlay_canvas->clipRect(slice_rect);
+    overlay_canvas->drawPicture(picture);
+  }
   return frame;
 }
 
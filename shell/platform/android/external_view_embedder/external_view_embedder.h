@@ -6,6 +6,8 @@
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_H_
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
@@ -87,6 +89,24 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // where the platform view might be momentarily off the screen.
   static const int kDefaultMergedLeaseDuration = 10;
 
+  // The maximum number of overlay layers in a frame. The Flutter UI that would
+  // need more overlays is drawn into the topmost one.
+  //
+  // Each overlay is an Android surface of the size of the frame, so this
+  // bounds the memory and GPU time of screens with many platform views.
+  static const size_t kMaxOverlayLayers = 8;
+
+  // The Flutter UI drawn by an overlay layer.
+  struct OverlayContents {
+    // The bounds of the overlay view.
+    SkRect rect;
+
+    // The pictures drawn into the overlay, in composition order, and the rects
+    // that they are clipped to. Those are disjoint from the rects that the
+    // background canvas draws the pictures into.
+    std::vector<std::pair<sk_sp<SkPicture>, SkRect>> slices;
+  };
+
   // Provides metadata to the Android surfaces.
   const AndroidContext& android_context_;
 
@@ -134,10 +154,18 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
 
   // Creates a Surface when needed or recycles an existing one.
   // Finally, draws the picture on the frame's canvas.
-  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                      int64_t view_id,
-                                                      sk_sp<SkPicture> picture,
-                                                      const SkRect& rect);
+  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(
+      GrDirectContext* context,
+      const OverlayContents& overlay);
+
+  // Reduces the number of overlay layers of the frame.
+  //
+  // The UI of a platform view is merged into the overlay of a platform view
+  // lower in the composition order when it doesn't intersect the platform
+  // views and the overlays in between. Then, if there are still more than
+  // |kMaxOverlayLayers| overlays, the topmost ones are merged into one.
+  void MergeOverlayLayers(
+      std::unordered_map<int64_t, OverlayContents>& overlay_layers);
 };
 
 }  // namespace flutter
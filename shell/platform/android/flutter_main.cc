@@ -22,6 +22,7 @@
 #include "flutter/fml/size.h"
 #include "flutter/lib/ui/plugins/callback_cache.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/startup_timings.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/switches.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -199,6 +200,27 @@ static void PrefetchDefaultFontManager(JNIEnv* env, jclass jcaller) {
   SkFontMgr::RefDefault();
 }
 
+static jlongArray GetStartupTimings(JNIEnv* env, jclass jcaller) {
+  // The start and end of each phase, in nanoseconds, or zeros for the phases
+  // that haven't run yet.
+  constexpr size_t kPhaseCount =
+      static_cast<size_t>(StartupTimings::Phase::kCount);
+  jlong timings[kPhaseCount * 2] = {};
+  for (size_t i = 0; i < kPhaseCount; i++) {
+    auto interval = StartupTimings::Get(static_cast<StartupTimings::Phase>(i));
+    if (interval) {
+      timings[i * 2] = interval->start.ToEpochDelta().ToNanoseconds();
+      timings[i * 2 + 1] = interval->end.ToEpochDelta().ToNanoseconds();
+    }
+  }
+  jlongArray result = env->NewLongArray(fml::size(timings));
+  if (result == nullptr) {
+    return nullptr;
+  }
+  env->SetLongArrayRegion(result, 0, fml::size(timings), timings);
+  return result;
+}
+
 bool FlutterMain::Register(JNIEnv* env) {
   static const JNINativeMethod methods[] = {
       {
@@ -212,6 +234,11 @@ bool FlutterMain::Register(JNIEnv* env) {
           .signature = "()V",
           .fnPtr = reinterpret_cast<void*>(&PrefetchDefaultFontManager),
       },
+      {
+          .name = "nativeGetStartupTimings",
+          .signature = "()[J",
+          .fnPtr = reinterpret_cast<void*>(&GetStartupTimings),
+      },
   };
 
   jclass clazz = env->FindClass("io/flutter/embedding/engine/FlutterJNI");
@@ -36,6 +36,7 @@ import io.flutter.view.FlutterCallbackInformation;
 import java.io.IOException;
 import java.lang.ref.WeakReference;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.Locale;
@@ -146,6 +147,24 @@ public class FlutterJNI {
 
   private static boolean prefetchDefaultFontManagerCalled = false;
 
+  /**
+   * Returns the timestamps of the engine startup phases in this process, on the clock of {@link
+   * System#nanoTime()}.
+   *
+   * <p>The array holds the start and the end, in nanoseconds, of the VM snapshot mapping, the
+   * isolate snapshot mapping, the VM initialization, the root isolate creation, the first frame,
+   * the shell creation, the build of the first layer tree, the first rasterization and the first
+   * submission to the surface, in that order. The phases that haven't run yet are zeros. The VM is
+   * shared by all the engines of the process, so each phase is the first one that ran in the
+   * process.
+   */
+  @NonNull
+  public static long[] getStartupTimings() {
+    return nativeGetStartupTimings();
+  }
+
+  private static native long[] nativeGetStartupTimings();
+
   /**
    * Perform one time initialization of the Dart VM and Flutter engine.
    *
@@ -782,6 +801,28 @@ public class FlutterJNI {
       long textureId,
       @NonNull WeakReference<SurfaceTextureWrapper> textureWrapper);
 
+  /**
+   * Registers a texture that shows the images queued to the returned {@link Surface}.
+   *
+   * <p>Unlike a texture registered with {@link #registerTexture(long, SurfaceTextureWrapper)}, the
+   * images are imported into Flutter's GPU context without calls back into Java, and the frames
+   * are marked available by the engine itself.
+   *
+   * @return The surface to queue the images to, or null if the device doesn't support these
+   *     textures, in which case nothing is registered.
+   */
+  @UiThread
+  @Nullable
+  public Surface registerImageTexture(long textureId, int width, int height) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    return nativeRegisterImageTexture(nativeShellHolderId, textureId, width, height);
+  }
+
+  @Nullable
+  private native Surface nativeRegisterImageTexture(
+      long nativeShellHolderId, long textureId, int width, int height);
+
   /**
    * Call this method to inform Flutter that a texture previously registered with {@link
    * #registerTexture(long, SurfaceTextureWrapper)} has a new frame available.
@@ -1079,6 +1120,107 @@ public class FlutterJNI {
     platformViewsController.onEndFrame();
   }
 
+  // The encoding of the frames of hybrid composition, which must match
+  // shell/platform/android/jni/platform_view_frame_encoder.h.
+  private static final int DISPLAY_PLATFORM_VIEW = 0;
+  private static final int DISPLAY_OVERLAY_SURFACE = 1;
+  private static final int MUTATOR_TRANSFORM = 0;
+  private static final int MUTATOR_CLIP_RECT = 1;
+  private static final int MUTATOR_CLIP_RRECT = 2;
+
+  /**
+   * Called by native once a frame of hybrid composition is submitted, with the layout of all the
+   * platform views and overlay surfaces of the frame.
+   *
+   * <p>This replaces a call to {@link #onDisplayPlatformView} per platform view, a call to {@link
+   * #onDisplayOverlaySurface} per overlay surface, and the calls to {@link #onBeginFrame} and
+   * {@link #onEndFrame}, which are made here in the same order instead.
+   *
+   * <p>The buffer is only valid until this method returns.
+   */
+  @SuppressWarnings("unused")
+  @UiThread
+  public void onDisplayFrame(@NonNull ByteBuffer buffer) {
+    ensureRunningOnMainThread();
+    if (platformViewsController == null) {
+      throw new RuntimeException(
+          "platformViewsController must be set before attempting to display a frame");
+    }
+    buffer.order(ByteOrder.LITTLE_ENDIAN);
+    platformViewsController.onBeginFrame();
+    while (buffer.hasRemaining()) {
+      final int command = buffer.getInt();
+      switch (command) {
+        case DISPLAY_PLATFORM_VIEW:
+          {
+            final int viewId = buffer.getInt();
+            final int x = buffer.getInt();
+            final int y = buffer.getInt();
+            final int width = buffer.getInt();
+            final int height = buffer.getInt();
+            final int viewWidth = buffer.getInt();
+            final int viewHeight = buffer.getInt();
+            final FlutterMutatorsStack mutatorsStack = decodeMutatorsStack(buffer);
+            platformViewsController.onDisplayPlatformView(
+                viewId, x, y, width, height, viewWidth, viewHeight, mutatorsStack);
+            break;
+          }
+        case DISPLAY_OVERLAY_SURFACE:
+          {
+            final int id = buffer.getInt();
+            final int x = buffer.getInt();
+            final int y = buffer.getInt();
+            final int width = buffer.getInt();
+            final int height = buffer.getInt();
+            platformViewsController.onDisplayOverlaySurface(id, x, y, width, height);
+            break;
+          }
+        default:
+          throw new IllegalStateException("Unknown frame command " + command);
+      }
+    }
+    platformViewsController.onEndFrame();
+  }
+
+  @NonNull
+  private static FlutterMutatorsStack decodeMutatorsStack(@NonNull ByteBuffer buffer) {
+    final FlutterMutatorsStack mutatorsStack = new FlutterMutatorsStack();
+    final int count = buffer.getInt();
+    for (int i = 0; i < count; i++) {
+      final int type = buffer.getInt();
+      switch (type) {
+        case MUTATOR_TRANSFORM:
+          mutatorsStack.pushTransform(getFloats(buffer, 9));
+          break;
+        case MUTATOR_CLIP_RECT:
+          mutatorsStack.pushClipRect(
+              buffer.getInt(), buffer.getInt(), buffer.getInt(), buffer.getInt());
+          break;
+        case MUTATOR_CLIP_RRECT:
+          {
+            final int left = buffer.getInt();
+            final int top = buffer.getInt();
+            final int right = buffer.getInt();
+            final int bottom = buffer.getInt();
+            mutatorsStack.pushClipRRect(left, top, right, bottom, getFloats(buffer, 8));
+            break;
+          }
+        default:
+          throw new IllegalStateException("Unknown mutator " + type);
+      }
+    }
+    return mutatorsStack;
+  }
+
+  @NonNull
+  private static float[] getFloats(@NonNull ByteBuffer buffer, int count) {
+    final float[] values = new float[count];
+    for (int i = 0; i < count; i++) {
+      values[i] = buffer.getFloat();
+    }
+    return values;
+  }
+
   @SuppressWarnings("unused")
   @UiThread
   public FlutterOverlaySurface createOverlaySurface() {
@@ -1223,6 +1365,30 @@ public class FlutterJNI {
   private native void nativeLoadDartDeferredLibrary(
       long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
 
+  /**
+   * Searches each of the provided paths for a valid Dart shared library .so file like {@link
+   * #loadDartDeferredLibrary(int, String[])}, and reads it ahead of the loadLibrary() call that
+   * requests it.
+   *
+   * <p>The engine then loads the library as soon as it is requested, without calling {@link
+   * #requestDartDeferredLibrary(int)}. Several libraries can be prefetched concurrently. Assets of
+   * the deferred component should be made available through {@link
+   * #updateJavaAssetManager(AssetManager, String)} before the library is requested.
+   *
+   * @param loadingUnitId The loadingUnitId assigned to the Dart deferred library by gen_snapshot.
+   * @param searchPaths An array of paths in which to look for valid dart shared libraries, in the
+   *     format of {@link #loadDartDeferredLibrary(int, String[])}.
+   */
+  @UiThread
+  public void prefetchDartDeferredLibrary(int loadingUnitId, @NonNull String[] searchPaths) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativePrefetchDartDeferredLibrary(nativeShellHolderId, loadingUnitId, searchPaths);
+  }
+
+  private native void nativePrefetchDartDeferredLibrary(
+      long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
+
   /**
    * Adds the specified AssetManager as an APKAssetResolver in the Flutter Engine's AssetManager.
    *
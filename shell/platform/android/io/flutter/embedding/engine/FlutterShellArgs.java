@@ -34,6 +34,8 @@ public class FlutterShellArgs {
   public static final String ARG_ENABLE_DART_PROFILING = "--enable-dart-profiling";
   public static final String ARG_KEY_ENABLE_SOFTWARE_RENDERING = "enable-software-rendering";
   public static final String ARG_ENABLE_SOFTWARE_RENDERING = "--enable-software-rendering";
+  public static final String ARG_KEY_ENABLE_VULKAN = "enable-vulkan";
+  public static final String ARG_ENABLE_VULKAN = "--enable-vulkan";
   public static final String ARG_KEY_SKIA_DETERMINISTIC_RENDERING = "skia-deterministic-rendering";
   public static final String ARG_SKIA_DETERMINISTIC_RENDERING = "--skia-deterministic-rendering";
   public static final String ARG_KEY_TRACE_SKIA = "trace-skia";
@@ -91,6 +93,9 @@ public class FlutterShellArgs {
     if (intent.getBooleanExtra(ARG_KEY_ENABLE_SOFTWARE_RENDERING, false)) {
       args.add(ARG_ENABLE_SOFTWARE_RENDERING);
     }
+    if (intent.getBooleanExtra(ARG_KEY_ENABLE_VULKAN, false)) {
+      args.add(ARG_ENABLE_VULKAN);
+    }
     if (intent.getBooleanExtra(ARG_KEY_SKIA_DETERMINISTIC_RENDERING, false)) {
       args.add(ARG_SKIA_DETERMINISTIC_RENDERING);
     }
@@ -40,6 +40,8 @@ public class FlutterLoader {
       "io.flutter.embedding.android.OldGenHeapSize";
   private static final String ENABLE_SKPARAGRAPH_META_DATA_KEY =
       "io.flutter.embedding.android.EnableSkParagraph";
+  private static final String ENABLE_VULKAN_META_DATA_KEY =
+      "io.flutter.embedding.android.EnableVulkan";
 
   // Must match values in flutter::switches
   static final String AOT_SHARED_LIBRARY_NAME = "aot-shared-library-name";
@@ -299,6 +301,10 @@ public class FlutterLoader {
         shellArgs.add("--enable-skparagraph");
       }
 
+      if (metaData != null && metaData.getBoolean(ENABLE_VULKAN_META_DATA_KEY)) {
+        shellArgs.add("--enable-vulkan");
+      }
+
       long initTimeMillis = SystemClock.uptimeMillis() - initStartTimestampMillis;
 
       flutterJNI.init(
@@ -114,6 +114,71 @@ public class FlutterRenderer implements TextureRegistry {
     return entry;
   }
 
+  /**
+   * Creates and returns a texture that shows the images queued to its {@link Surface}, or null if
+   * the device or the renderer can't import them.
+   */
+  @Override
+  @Nullable
+  public ImageTextureEntry createImageTexture(int width, int height) {
+    if (Build.VERSION.SDK_INT < Build.VERSION_CODES.O) {
+      return null;
+    }
+    final long id = nextTextureId.getAndIncrement();
+    final Surface surface = flutterJNI.registerImageTexture(id, width, height);
+    if (surface == null) {
+      return null;
+    }
+    Log.v(TAG, "New image texture ID: " + id);
+    return new ImageTextureRegistryEntry(id, surface);
+  }
+
+  final class ImageTextureRegistryEntry implements TextureRegistry.ImageTextureEntry {
+    private final long id;
+    @NonNull private final Surface surface;
+    private boolean released;
+
+    ImageTextureRegistryEntry(long id, @NonNull Surface surface) {
+      this.id = id;
+      this.surface = surface;
+    }
+
+    @Override
+    @NonNull
+    public Surface surface() {
+      return surface;
+    }
+
+    @Override
+    public long id() {
+      return id;
+    }
+
+    @Override
+    public void release() {
+      if (released) {
+        return;
+      }
+      Log.v(TAG, "Releasing an image texture (" + id + ").");
+      surface.release();
+      unregisterTexture(id);
+      released = true;
+    }
+
+    @Override
+    protected void finalize() throws Throwable {
+      try {
+        if (released) {
+          return;
+        }
+
+        handler.post(new SurfaceTextureFinalizerRunnable(id, flutterJNI));
+      } finally {
+        super.finalize();
+      }
+    }
+  }
+
   final class SurfaceTextureRegistryEntry implements TextureRegistry.SurfaceTextureEntry {
     private final long id;
     @NonNull private final SurfaceTextureWrapper textureWrapper;
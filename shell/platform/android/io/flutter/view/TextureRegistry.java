@@ -5,7 +5,9 @@
 package io.flutter.view;
 
 import android.graphics.SurfaceTexture;
+import android.view.Surface;
 import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
 
 // TODO(mattcarroll): re-evalute docs in this class and add nullability annotations.
 /**
@@ -28,6 +30,22 @@ public interface TextureRegistry {
    */
   SurfaceTextureEntry registerSurfaceTexture(@NonNull SurfaceTexture surfaceTexture);
 
+  /**
+   * Creates and registers a texture that shows the images queued to a {@link Surface} of the given
+   * size.
+   *
+   * <p>The images are imported into Flutter's GPU context as hardware buffers, without the per
+   * frame calls back into Java, copies, or stalls of a SurfaceTexture. It needs Android O or newer
+   * and the OpenGL renderer.
+   *
+   * @return An ImageTextureEntry, or null if the textures aren't supported, in which case a
+   *     SurfaceTexture can be used instead.
+   */
+  @Nullable
+  default ImageTextureEntry createImageTexture(int width, int height) {
+    return null;
+  }
+
   /** A registry entry for a managed SurfaceTexture. */
   interface SurfaceTextureEntry {
     /** @return The managed SurfaceTexture. */
@@ -39,4 +57,17 @@ public interface TextureRegistry {
     /** Deregisters and releases this SurfaceTexture. */
     void release();
   }
+
+  /** A registry entry for a texture created with {@link #createImageTexture(int, int)}. */
+  interface ImageTextureEntry {
+    /** @return The surface to queue the images of the texture to. */
+    @NonNull
+    Surface surface();
+
+    /** @return The identity of this texture. */
+    long id();
+
+    /** Deregisters and releases this texture and its surface. */
+    void release();
+  }
 }
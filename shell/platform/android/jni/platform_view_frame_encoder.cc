@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/jni/platform_view_frame_encoder.h"
+
+#include <cstring>
+
+namespace flutter {
+
+PlatformViewFrameEncoder::PlatformViewFrameEncoder() = default;
+
+PlatformViewFrameEncoder::~PlatformViewFrameEncoder() = default;
+
+void PlatformViewFrameEncoder::Reset() {
+  // The capacity is kept, so that the following frames don't allocate.
+  buffer_.clear();
+}
+
+void PlatformViewFrameEncoder::DisplayPlatformView(
+    int view_id,
+    int x,
+    int y,
+    int width,
+    int height,
+    int view_width,
+    int view_height,
+    const MutatorsStack& mutators_stack) {
+  buffer_.insert(buffer_.end(), {kDisplayPlatformView, view_id, x, y, width,
+                                 height, view_width, view_height});
+  // The count is only known once the unsupported mutators are skipped.
+  const size_t count_position = buffer_.size();
+  buffer_.push_back(0);
+  int32_t count = 0;
+  for (auto iter = mutators_stack.Begin(); iter != mutators_stack.End();
+       ++iter) {
+    switch ((*iter)->GetType()) {
+      case transform: {
+        SkScalar matrix[9];
+        (*iter)->GetMatrix().get9(matrix);
+        buffer_.push_back(kTransform);
+        PushFloats(matrix, 9);
+        count++;
+        break;
+      }
+      case clip_rect: {
+        const SkRect& rect = (*iter)->GetRect();
+        buffer_.insert(buffer_.end(), {kClipRect,
+                                       static_cast<int32_t>(rect.left()),
+                                       static_cast<int32_t>(rect.top()),
+                                       static_cast<int32_t>(rect.right()),
+                                       static_cast<int32_t>(rect.bottom())});
+        count++;
+        break;
+      }
+      case clip_rrect: {
+        const SkRRect& rrect = (*iter)->GetRRect();
+        const SkRect& rect = rrect.rect();
+        const SkVector& upper_left = rrect.radii(SkRRect::kUpperLeft_Corner);
+        const SkVector& upper_right = rrect.radii(SkRRect::kUpperRight_Corner);
+        const SkVector& lower_right = rrect.radii(SkRRect::kLowerRight_Corner);
+        const SkVector& lower_left = rrect.radii(SkRRect::kLowerLeft_Corner);
+        const SkScalar radii[8] = {
+            upper_left.x(),  upper_left.y(),  upper_right.x(), upper_right.y(),
+            lower_right.x(), lower_right.y(), lower_left.x(),  lower_left.y(),
+        };
+        buffer_.insert(buffer_.end(), {kClipRRect,
+                                       static_cast<int32_t>(rect.left()),
+                                       static_cast<int32_t>(rect.top()),
+                                       static_cast<int32_t>(rect.right()),
+                                       static_cast<int32_t>(rect.bottom())});
+        PushFloats(radii, 8);
+        count++;
+        break;
+      }
+      // TODO(cyanglaz): Implement other mutators.
+      // https://github.com/flutter/flutter/issues/58426
+      case clip_path:
+      case opacity:
+        break;
+    }
+  }
+  buffer_[count_position] = count;
+}
+
+void PlatformViewFrameEncoder::DisplayOverlaySurface(int surface_id,
+                                                     int x,
+                                                     int y,
+                                                     int width,
+                                                     int height) {
+  buffer_.insert(buffer_.end(),
+                 {kDisplayOverlaySurface, surface_id, x, y, width, height});
+}
+
+const uint8_t* PlatformViewFrameEncoder::data() const {
+  return reinterpret_cast<const uint8_t*>(buffer_.data());
+}
+
+size_t PlatformViewFrameEncoder::size() const {
+  return buffer_.size() * sizeof(int32_t);
+}
+
+void PlatformViewFrameEncoder::PushFloats(const float* values, size_t count) {
+  const size_t position = buffer_.size();
+  buffer_.resize(position + count);
+  memcpy(&buffer_[position], values, count * sizeof(float));
+}
+
+}  // namespace flutter
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_JNI_PLATFORM_VIEW_FRAME_ENCODER_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_JNI_PLATFORM_VIEW_FRAME_ENCODER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/flow/embedded_views.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Records how the platform views and the overlay surfaces of a
+///             hybrid composition frame are laid out, so that the whole frame
+///             is handed to Java in a single JNI call.
+///
+///             The encoding is a sequence of little-endian 32-bit words, and
+///             is decoded in `FlutterJNI.java`. If any of the encoding
+///             structure is changed, the decoder must be updated too.
+///
+///             A platform view is encoded as:
+///               kDisplayPlatformView, view id, x, y, width, height,
+///               view width, view height, mutator count, mutators...
+///             where each mutator is one of:
+///               kTransform, 9 floats of the matrix
+///               kClipRect, left, top, right, bottom
+///               kClipRRect, left, top, right, bottom, 8 floats of the radii
+///
+///             An overlay surface is encoded as:
+///               kDisplayOverlaySurface, surface id, x, y, width, height
+///
+class PlatformViewFrameEncoder {
+ public:
+  enum Command : int32_t {
+    kDisplayPlatformView = 0,
+    kDisplayOverlaySurface = 1,
+  };
+
+  enum Mutator : int32_t {
+    kTransform = 0,
+    kClipRect = 1,
+    kClipRRect = 2,
+  };
+
+  PlatformViewFrameEncoder();
+
+  ~PlatformViewFrameEncoder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the commands of the previous frame.
+  ///
+  void Reset();
+
+  void DisplayPlatformView(int view_id,
+                           int x,
+                           int y,
+                           int width,
+                           int height,
+                           int view_width,
+                           int view_height,
+                           const MutatorsStack& mutators_stack);
+
+  void DisplayOverlaySurface(int surface_id,
+                             int x,
+                             int y,
+                             int width,
+                             int height);
+
+  const uint8_t* data() const;
+
+  size_t size() const;
+
+ private:
+  std::vector<int32_t> buffer_;
+
+  void PushFloats(const float* values, size_t count);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewFrameEncoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_JNI_PLATFORM_VIEW_FRAME_ENCODER_H_
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/jni/platform_view_frame_encoder.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+std::vector<int32_t> Words(const PlatformViewFrameEncoder& encoder) {
+  std::vector<int32_t> words(encoder.size() / sizeof(int32_t));
+  memcpy(words.data(), encoder.data(), encoder.size());
+  return words;
+}
+
+float FloatAt(const std::vector<int32_t>& words, size_t index) {
+  float value;
+  memcpy(&value, &words[index], sizeof(float));
+  return value;
+}
+}  // namespace
+
+TEST(PlatformViewFrameEncoder, EncodesPlatformViewsAndOverlaysInOrder) {
+  PlatformViewFrameEncoder encoder;
+  encoder.DisplayPlatformView(0, 10, 20, 30, 40, 50, 60, MutatorsStack());
+  encoder.DisplayOverlaySurface(1, 2, 3, 4, 5);
+
+  std::vector<int32_t> expected = {
+      PlatformViewFrameEncoder::kDisplayPlatformView,
+      0,
+      10,
+      20,
+      30,
+      40,
+      50,
+      60,
+      0,
+      PlatformViewFrameEncoder::kDisplayOverlaySurface,
+      1,
+      2,
+      3,
+      4,
+      5,
+  };
+  EXPECT_EQ(Words(encoder), expected);
+}
+
+TEST(PlatformViewFrameEncoder, EncodesMutators) {
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(7, 8));
+  stack.PushClipRect(SkRect::MakeLTRB(1, 2, 3, 4));
+  stack.PushClipRRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, 9, 9), 2, 3));
+  // Opacities are not supported yet, and are skipped.
+  stack.PushOpacity(128);
+
+  PlatformViewFrameEncoder encoder;
+  encoder.DisplayPlatformView(3, 0, 0, 100, 100, 100, 100, stack);
+  const std::vector<int32_t> words = Words(encoder);
+  ASSERT_EQ(words.size(), 9u + 10u + 5u + 13u);
+  EXPECT_EQ(words[8], 3);
+
+  EXPECT_EQ(words[9], PlatformViewFrameEncoder::kTransform);
+  EXPECT_FLOAT_EQ(FloatAt(words, 10 + SkMatrix::kMTransX), 7);
+  EXPECT_FLOAT_EQ(FloatAt(words, 10 + SkMatrix::kMTransY), 8);
+
+  EXPECT_EQ(words[19], PlatformViewFrameEncoder::kClipRect);
+  EXPECT_EQ(std::vector<int32_t>(words.begin() + 20, words.begin() + 24),
+            std::vector<int32_t>({1, 2, 3, 4}));
+
+  EXPECT_EQ(words[24], PlatformViewFrameEncoder::kClipRRect);
+  EXPECT_EQ(words[27], 9);
+  EXPECT_FLOAT_EQ(FloatAt(words, 29), 2);
+  EXPECT_FLOAT_EQ(FloatAt(words, 30), 3);
+}
+
+TEST(PlatformViewFrameEncoder, ResetDropsThePreviousFrame) {
+  PlatformViewFrameEncoder encoder;
+  encoder.DisplayOverlaySurface(1, 2, 3, 4, 5);
+  encoder.Reset();
+  EXPECT_EQ(encoder.size(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -11,9 +11,13 @@
 #include "flutter/shell/common/shell_io_manager.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "flutter/shell/platform/android/android_context_gl.h"
+#include "flutter/shell/platform/android/android_context_vulkan.h"
 #include "flutter/shell/platform/android/android_external_texture_gl.h"
+#include "flutter/shell/platform/android/android_image_reader_texture_gl.h"
+#include "flutter/shell/platform/android/android_image_reader_texture_vulkan.h"
 #include "flutter/shell/platform/android/android_surface_gl.h"
 #include "flutter/shell/platform/android/android_surface_software.h"
+#include "flutter/shell/platform/android/android_surface_vulkan.h"
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 #include "flutter/shell/platform/android/surface/snapshot_surface_producer.h"
@@ -39,6 +43,8 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
                                                       jni_facade_);
     case AndroidRenderingAPI::kOpenGLES:
       return std::make_unique<AndroidSurfaceGL>(android_context_, jni_facade_);
+    case AndroidRenderingAPI::kVulkan:
+      return std::make_unique<AndroidSurfaceVulkan>(android_context_);
     default:
       FML_DCHECK(false);
       return nullptr;
@@ -47,10 +53,19 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
 
 static std::shared_ptr<flutter::AndroidContext> CreateAndroidContext(
     bool use_software_rendering,
+    bool enable_vulkan,
     const flutter::TaskRunners task_runners) {
   if (use_software_rendering) {
     return std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
   }
+  if (enable_vulkan) {
+    auto vulkan_context = std::make_shared<AndroidContextVulkan>(task_runners);
+    if (vulkan_context->IsValid()) {
+      return vulkan_context;
+    }
+    FML_LOG(WARNING) << "Vulkan is not supported on this device, falling "
+                        "back to OpenGL ES.";
+  }
   return std::make_unique<AndroidContextGL>(
       AndroidRenderingAPI::kOpenGLES,
       fml::MakeRefCounted<AndroidEnvironmentGL>(), task_runners);
@@ -60,12 +75,14 @@ PlatformViewAndroid::PlatformViewAndroid(
     PlatformView::Delegate& delegate,
     flutter::TaskRunners task_runners,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-    bool use_software_rendering)
-    : PlatformViewAndroid(
-          delegate,
-          std::move(task_runners),
-          std::move(jni_facade),
-          CreateAndroidContext(use_software_rendering, task_runners)) {}
+    bool use_software_rendering,
+    bool enable_vulkan)
+    : PlatformViewAndroid(delegate,
+                          std::move(task_runners),
+                          std::move(jni_facade),
+                          CreateAndroidContext(use_software_rendering,
+                                               enable_vulkan,
+                                               task_runners)) {}
 
 PlatformViewAndroid::PlatformViewAndroid(
     PlatformView::Delegate& delegate,
@@ -113,6 +130,14 @@ void PlatformViewAndroid::NotifyCreated(
 
 void PlatformViewAndroid::NotifySurfaceWindowChanged(
     fml::RefPtr<AndroidNativeWindow> native_window) {
+  if (android_context_ &&
+      android_context_->RenderingApi() == AndroidRenderingAPI::kVulkan) {
+    // The swapchain of the rendering surface is bound to the old window, so
+    // the surface is recreated rather than pointed at the new one.
+    NotifyDestroyed();
+    NotifyCreated(std::move(native_window));
+    return;
+  }
   if (android_surface_) {
     fml::AutoResetWaitableEvent latch;
     fml::TaskRunner::RunNowOrPostTask(
@@ -233,10 +258,63 @@ void PlatformViewAndroid::UpdateSemantics(
 void PlatformViewAndroid::RegisterExternalTexture(
     int64_t texture_id,
     const fml::jni::ScopedJavaGlobalRef<jobject>& surface_texture) {
+  if (android_context_->RenderingApi() != AndroidRenderingAPI::kOpenGLES) {
+    // The frames of a surface texture can only be attached to a GL context.
+    FML_LOG(ERROR) << "Surface textures are only supported with OpenGL ES.";
+    return;
+  }
   RegisterTexture(std::make_shared<AndroidExternalTextureGL>(
       texture_id, surface_texture, std::move(jni_facade_)));
 }
 
+jobject PlatformViewAndroid::RegisterImageReaderTexture(JNIEnv* env,
+                                                        int64_t texture_id,
+                                                        int32_t width,
+                                                        int32_t height) {
+  // The reader calls back on its own thread, but the frames are marked
+  // available on the platform thread like those of the surface textures.
+  auto on_frame_available =
+      [task_runner = task_runners_.GetPlatformTaskRunner(),
+       weak_platform_view = GetWeakPtr(), texture_id]() {
+        task_runner->PostTask([weak_platform_view, texture_id]() {
+          if (weak_platform_view) {
+            weak_platform_view->MarkTextureFrameAvailable(texture_id);
+          }
+        });
+      };
+  switch (android_context_->RenderingApi()) {
+    case AndroidRenderingAPI::kOpenGLES:
+      return RegisterImageReaderTexture(
+          env, AndroidImageReaderTextureGL::Create(texture_id, width, height,
+                                                   on_frame_available));
+    case AndroidRenderingAPI::kVulkan: {
+      auto vulkan_context =
+          std::static_pointer_cast<AndroidContextVulkan>(android_context_);
+      return RegisterImageReaderTexture(
+          env, AndroidImageReaderTextureVulkan::Create(
+                   texture_id, width, height, vulkan_context->GetProcTable(),
+                   vulkan_context->GetDevice(), on_frame_available));
+    }
+    default:
+      return nullptr;
+  }
+}
+
+template <typename T>
+jobject PlatformViewAndroid::RegisterImageReaderTexture(
+    JNIEnv* env,
+    std::shared_ptr<T> texture) {
+  if (!texture) {
+    return nullptr;
+  }
+  jobject surface = texture->CreateSurface(env);
+  if (!surface) {
+    return nullptr;
+  }
+  RegisterTexture(std::move(texture));
+  return surface;
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewAndroid::CreateVSyncWaiter() {
   return std::make_unique<VsyncWaiterAndroid>(task_runners_);
@@ -45,7 +45,8 @@ class PlatformViewAndroid final : public PlatformView {
   PlatformViewAndroid(PlatformView::Delegate& delegate,
                       flutter::TaskRunners task_runners,
                       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-                      bool use_software_rendering);
+                      bool use_software_rendering,
+                      bool enable_vulkan);
 
   //----------------------------------------------------------------------------
   /// @brief      Creates a new PlatformViewAndroid but using an existing
@@ -90,6 +91,19 @@ class PlatformViewAndroid final : public PlatformView {
       int64_t texture_id,
       const fml::jni::ScopedJavaGlobalRef<jobject>& surface_texture);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a texture that shows the images queued to a new
+  ///             `AImageReader`, and returns a local reference to the
+  ///             `android.view.Surface` of the reader.
+  ///
+  /// @return     The surface, or null if the device or the rendering API
+  ///             can't import the images of a reader.
+  ///
+  jobject RegisterImageReaderTexture(JNIEnv* env,
+                                     int64_t texture_id,
+                                     int32_t width,
+                                     int32_t height);
+
   // |PlatformView|
   void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
@@ -166,6 +180,11 @@ class PlatformViewAndroid final : public PlatformView {
 
   void FireFirstFrameCallback();
 
+  // Registers the texture unless it is null, and returns the surface of its
+  // reader.
+  template <typename T>
+  jobject RegisterImageReaderTexture(JNIEnv* env, std::shared_ptr<T> texture);
+
   FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewAndroid);
 };
 }  // namespace flutter
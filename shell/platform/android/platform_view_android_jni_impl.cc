@@ -86,9 +86,7 @@ static jmethodID g_create_overlay_surface_method = nullptr;
 
 static jmethodID g_destroy_overlay_surfaces_method = nullptr;
 
-static jmethodID g_on_begin_frame_method = nullptr;
-
-static jmethodID g_on_end_frame_method = nullptr;
+static jmethodID g_on_display_frame_method = nullptr;
 
 static jmethodID g_java_weak_reference_get_method = nullptr;
 
@@ -105,22 +103,13 @@ static jmethodID g_compute_platform_resolved_locale_method = nullptr;
 static jmethodID g_request_dart_deferred_library_method = nullptr;
 
 // Called By Java
-static jmethodID g_on_display_platform_view_method = nullptr;
 
 // static jmethodID g_on_composite_platform_view_method = nullptr;
 
-static jmethodID g_on_display_overlay_surface_method = nullptr;
-
 static jmethodID g_overlay_surface_id_method = nullptr;
 
 static jmethodID g_overlay_surface_surface_method = nullptr;
 
-// Mutators
-static fml::jni::ScopedJavaGlobalRef<jclass>* g_mutators_stack_class = nullptr;
-static jmethodID g_mutators_stack_init_method = nullptr;
-static jmethodID g_mutators_stack_push_transform_method = nullptr;
-static jmethodID g_mutators_stack_push_cliprect_method = nullptr;
-static jmethodID g_mutators_stack_push_cliprrect_method = nullptr;
 
 // Called By Java
 static jlong AttachJNI(JNIEnv* env, jclass clazz, jobject flutterJNI) {
@@ -468,6 +457,16 @@ static void RegisterTexture(JNIEnv* env,
   );
 }
 
+static jobject RegisterImageTexture(JNIEnv* env,
+                                   jobject jcaller,
+                                   jlong shell_holder,
+                                   jlong texture_id,
+                                   jint width,
+                                   jint height) {
+  return ANDROID_SHELL_HOLDER->GetPlatformView()->RegisterImageReaderTexture(
+      env, static_cast<int64_t>(texture_id), width, height);
+}
+
 static void MarkTextureFrameAvailable(JNIEnv* env,
                                       jobject jcaller,
                                       jlong shell_holder,
@@ -559,13 +558,13 @@ static void DeferredComponentInstallFailure(JNIEnv* env,
                          static_cast<bool>(jTransient));
 }
 
-static void LoadDartDeferredLibrary(JNIEnv* env,
-                                    jobject obj,
-                                    jlong shell_holder,
-                                    jint jLoadingUnitId,
-                                    jobjectArray jSearchPaths) {
-  // Convert java->c++
-  intptr_t loading_unit_id = static_cast<intptr_t>(jLoadingUnitId);
+// Opens the first loading unit library found in the search paths, and
+// resolves the mappings of its snapshot. Returns false if there is none.
+static bool OpenDeferredLibrary(
+    JNIEnv* env,
+    jobjectArray jSearchPaths,
+    std::unique_ptr<const fml::SymbolMapping>* data_mapping,
+    std::unique_ptr<const fml::SymbolMapping>* instructions_mapping) {
   std::vector<std::string> search_paths =
       fml::jni::StringArrayToVector(env, jSearchPaths);
 
@@ -578,26 +577,61 @@ static void LoadDartDeferredLibrary(JNIEnv* env,
     search_paths.pop_back();
   }
   if (handle == nullptr) {
-    LoadLoadingUnitFailure(loading_unit_id,
-                           "No lib .so found for provided search paths.", true);
-    return;
+    return false;
   }
   fml::RefPtr<fml::NativeLibrary> native_lib =
       fml::NativeLibrary::CreateWithHandle(handle, false);
 
   // Resolve symbols.
-  std::unique_ptr<const fml::SymbolMapping> data_mapping =
-      std::make_unique<const fml::SymbolMapping>(
-          native_lib, DartSnapshot::kIsolateDataSymbol);
-  std::unique_ptr<const fml::SymbolMapping> instructions_mapping =
-      std::make_unique<const fml::SymbolMapping>(
-          native_lib, DartSnapshot::kIsolateInstructionsSymbol);
+  *data_mapping = std::make_unique<const fml::SymbolMapping>(
+      native_lib, DartSnapshot::kIsolateDataSymbol);
+  *instructions_mapping = std::make_unique<const fml::SymbolMapping>(
+      native_lib, DartSnapshot::kIsolateInstructionsSymbol);
+  return true;
+}
+
+static void LoadDartDeferredLibrary(JNIEnv* env,
+                                    jobject obj,
+                                    jlong shell_holder,
+                                    jint jLoadingUnitId,
+                                    jobjectArray jSearchPaths) {
+  // Convert java->c++
+  intptr_t loading_unit_id = static_cast<intptr_t>(jLoadingUnitId);
+
+  std::unique_ptr<const fml::SymbolMapping> data_mapping;
+  std::unique_ptr<const fml::SymbolMapping> instructions_mapping;
+  if (!OpenDeferredLibrary(env, jSearchPaths, &data_mapping,
+                           &instructions_mapping)) {
+    LoadLoadingUnitFailure(loading_unit_id,
+                           "No lib .so found for provided search paths.", true);
+    return;
+  }
 
   ANDROID_SHELL_HOLDER->GetPlatformView()->LoadDartDeferredLibrary(
       loading_unit_id, std::move(data_mapping),
       std::move(instructions_mapping));
 }
 
+static void PrefetchDartDeferredLibrary(JNIEnv* env,
+                                        jobject obj,
+                                        jlong shell_holder,
+                                        jint jLoadingUnitId,
+                                        jobjectArray jSearchPaths) {
+  intptr_t loading_unit_id = static_cast<intptr_t>(jLoadingUnitId);
+
+  std::unique_ptr<const fml::SymbolMapping> data_mapping;
+  std::unique_ptr<const fml::SymbolMapping> instructions_mapping;
+  // A loading unit that can't be prefetched is loaded when it is requested.
+  if (!OpenDeferredLibrary(env, jSearchPaths, &data_mapping,
+                           &instructions_mapping)) {
+    return;
+  }
+
+  ANDROID_SHELL_HOLDER->GetPlatformView()->PrefetchDartDeferredLibrary(
+      loading_unit_id, std::move(data_mapping),
+      std::move(instructions_mapping));
+}
+
 static void UpdateJavaAssetManager(JNIEnv* env,
                                    jobject obj,
                                    jlong shell_holder,
@@ -734,6 +768,11 @@ bool RegisterApi(JNIEnv* env) {
                        "WeakReference;)V",
           .fnPtr = reinterpret_cast<void*>(&RegisterTexture),
       },
+      {
+          .name = "nativeRegisterImageTexture",
+          .signature = "(JJII)Landroid/view/Surface;",
+          .fnPtr = reinterpret_cast<void*>(&RegisterImageTexture),
+      },
       {
           .name = "nativeMarkTextureFrameAvailable",
           .signature = "(JJ)V",
@@ -786,6 +825,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(JI[Ljava/lang/String;)V",
           .fnPtr = reinterpret_cast<void*>(&LoadDartDeferredLibrary),
       },
+      {
+          .name = "nativePrefetchDartDeferredLibrary",
+          .signature = "(JI[Ljava/lang/String;)V",
+          .fnPtr = reinterpret_cast<void*>(&PrefetchDartDeferredLibrary),
+      },
       {
           .name = "nativeUpdateJavaAssetManager",
           .signature =
@@ -949,77 +993,11 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
-  g_mutators_stack_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
-      env,
-      env->FindClass(
-          "io/flutter/embedding/engine/mutatorsstack/FlutterMutatorsStack"));
-  if (g_mutators_stack_class == nullptr) {
-    FML_LOG(ERROR) << "Could not locate FlutterMutatorsStack";
-    return false;
-  }
+  g_on_display_frame_method = env->GetMethodID(
+      g_flutter_jni_class->obj(), "onDisplayFrame", "(Ljava/nio/ByteBuffer;)V");
 
-  g_mutators_stack_init_method =
-      env->GetMethodID(g_mutators_stack_class->obj(), "<init>", "()V");
-  if (g_mutators_stack_init_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate FlutterMutatorsStack.init method";
-    return false;
-  }
-
-  g_mutators_stack_push_transform_method =
-      env->GetMethodID(g_mutators_stack_class->obj(), "pushTransform", "([F)V");
-  if (g_mutators_stack_push_transform_method == nullptr) {
-    FML_LOG(ERROR)
-        << "Could not locate FlutterMutatorsStack.pushTransform method";
-    return false;
-  }
-
-  g_mutators_stack_push_cliprect_method = env->GetMethodID(
-      g_mutators_stack_class->obj(), "pushClipRect", "(IIII)V");
-  if (g_mutators_stack_push_cliprect_method == nullptr) {
-    FML_LOG(ERROR)
-        << "Could not locate FlutterMutatorsStack.pushClipRect method";
-    return false;
-  }
-
-  g_mutators_stack_push_cliprrect_method = env->GetMethodID(
-      g_mutators_stack_class->obj(), "pushClipRRect", "(IIII[F)V");
-  if (g_mutators_stack_push_cliprect_method == nullptr) {
-    FML_LOG(ERROR)
-        << "Could not locate FlutterMutatorsStack.pushClipRRect method";
-    return false;
-  }
-
-  g_on_display_platform_view_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onDisplayPlatformView",
-                       "(IIIIIIILio/flutter/embedding/engine/mutatorsstack/"
-                       "FlutterMutatorsStack;)V");
-
-  if (g_on_display_platform_view_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onDisplayPlatformView method";
-    return false;
-  }
-
-  g_on_begin_frame_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onBeginFrame", "()V");
-
-  if (g_on_begin_frame_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onBeginFrame method";
-    return false;
-  }
-
-  g_on_end_frame_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onEndFrame", "()V");
-
-  if (g_on_end_frame_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onEndFrame method";
-    return false;
-  }
-
-  g_on_display_overlay_surface_method = env->GetMethodID(
-      g_flutter_jni_class->obj(), "onDisplayOverlaySurface", "(IIIII)V");
-
-  if (g_on_display_overlay_surface_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onDisplayOverlaySurface method";
+  if (g_on_display_frame_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate onDisplayFrame method";
     return false;
   }
 
@@ -1369,74 +1347,10 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int viewWidth,
     int viewHeight,
     MutatorsStack mutators_stack) {
-  JNIEnv* env = fml::jni::AttachCurrentThread();
-  auto java_object = java_object_.get(env);
-  if (java_object.is_null()) {
-    return;
-  }
-
-  jobject mutatorsStack = env->NewObject(g_mutators_stack_class->obj(),
-                                         g_mutators_stack_init_method);
-
-  std::vector<std::shared_ptr<Mutator>>::const_iterator iter =
-      mutators_stack.Begin();
-  while (iter != mutators_stack.End()) {
-    switch ((*iter)->GetType()) {
-      case transform: {
-        const SkMatrix& matrix = (*iter)->GetMatrix();
-        SkScalar matrix_array[9];
-        matrix.get9(matrix_array);
-        fml::jni::ScopedJavaLocalRef<jfloatArray> transformMatrix(
-            env, env->NewFloatArray(9));
-
-        env->SetFloatArrayRegion(transformMatrix.obj(), 0, 9, matrix_array);
-        env->CallVoidMethod(mutatorsStack,
-                            g_mutators_stack_push_transform_method,
-                            transformMatrix.obj());
-        break;
-      }
-      case clip_rect: {
-        const SkRect& rect = (*iter)->GetRect();
-        env->CallVoidMethod(
-            mutatorsStack, g_mutators_stack_push_cliprect_method,
-            static_cast<int>(rect.left()), static_cast<int>(rect.top()),
-            static_cast<int>(rect.right()), static_cast<int>(rect.bottom()));
-        break;
-      }
-      case clip_rrect: {
-        const SkRRect& rrect = (*iter)->GetRRect();
-        const SkRect& rect = rrect.rect();
-        const SkVector& upper_left = rrect.radii(SkRRect::kUpperLeft_Corner);
-        const SkVector& upper_right = rrect.radii(SkRRect::kUpperRight_Corner);
-        const SkVector& lower_right = rrect.radii(SkRRect::kLowerRight_Corner);
-        const SkVector& lower_left = rrect.radii(SkRRect::kLowerLeft_Corner);
-        SkScalar radiis[8] = {
-            upper_left.x(),  upper_left.y(),  upper_right.x(), upper_right.y(),
-            lower_right.x(), lower_right.y(), lower_left.x(),  lower_left.y(),
-        };
-        fml::jni::ScopedJavaLocalRef<jfloatArray> radiisArray(
-            env, env->NewFloatArray(8));
-        env->SetFloatArrayRegion(radiisArray.obj(), 0, 8, radiis);
-        env->CallVoidMethod(
-            mutatorsStack, g_mutators_stack_push_cliprrect_method,
-            (int)rect.left(), (int)rect.top(), (int)rect.right(),
-            (int)rect.bottom(), radiisArray.obj());
-        break;
-      }
-      // TODO(cyanglaz): Implement other mutators.
-      // https://github.com/flutter/flutter/issues/58426
-      case clip_path:
-      case opacity:
-        break;
-    }
-    ++iter;
-  }
-
-  env->CallVoidMethod(java_object.obj(), g_on_display_platform_view_method,
-                      view_id, x, y, width, height, viewWidth, viewHeight,
-                      mutatorsStack);
-
-  FML_CHECK(fml::jni::CheckException(env));
+  // Java only lays out the views once the frame ends, so the views of the
+  // frame are sent in one call then.
+  frame_encoder_.DisplayPlatformView(view_id, x, y, width, height, viewWidth,
+                                     viewHeight, mutators_stack);
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
@@ -1445,30 +1359,11 @@ void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
     int y,
     int width,
     int height) {
-  JNIEnv* env = fml::jni::AttachCurrentThread();
-
-  auto java_object = java_object_.get(env);
-  if (java_object.is_null()) {
-    return;
-  }
-
-  env->CallVoidMethod(java_object.obj(), g_on_display_overlay_surface_method,
-                      surface_id, x, y, width, height);
-
-  FML_CHECK(fml::jni::CheckException(env));
+  frame_encoder_.DisplayOverlaySurface(surface_id, x, y, width, height);
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewBeginFrame() {
-  JNIEnv* env = fml::jni::AttachCurrentThread();
-
-  auto java_object = java_object_.get(env);
-  if (java_object.is_null()) {
-    return;
-  }
-
-  env->CallVoidMethod(java_object.obj(), g_on_begin_frame_method);
-
-  FML_CHECK(fml::jni::CheckException(env));
+  frame_encoder_.Reset();
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
@@ -1479,7 +1374,15 @@ void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
     return;
   }
 
-  env->CallVoidMethod(java_object.obj(), g_on_end_frame_method);
+  // Java decodes the buffer before the call returns, so it doesn't need to
+  // outlive the call.
+  fml::jni::ScopedJavaLocalRef<jobject> direct_buffer(
+      env, env->NewDirectByteBuffer(
+               const_cast<uint8_t*>(frame_encoder_.data()),
+               frame_encoder_.size()));
+  env->CallVoidMethod(java_object.obj(), g_on_display_frame_method,
+                      direct_buffer.obj());
+  frame_encoder_.Reset();
 
   FML_CHECK(fml::jni::CheckException(env));
 }
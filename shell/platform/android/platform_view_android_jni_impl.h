@@ -7,6 +7,7 @@
 
 #include "flutter/fml/platform/android/jni_weak_ref.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
+#include "flutter/shell/platform/android/jni/platform_view_frame_encoder.h"
 
 namespace flutter {
 
@@ -87,6 +88,9 @@ class PlatformViewAndroidJNIImpl final : public PlatformViewAndroidJNI {
   // Reference to FlutterJNI object.
   const fml::jni::JavaObjectWeakGlobalRef java_object_;
 
+  // The platform views and the overlay surfaces of the current frame.
+  PlatformViewFrameEncoder frame_encoder_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewAndroidJNIImpl);
 };
 
@@ -1,6 +1,8 @@
 package io.flutter.embedding.engine;
 
 import static org.junit.Assert.assertEquals;
+import static org.mockito.ArgumentMatchers.eq;
+import static org.mockito.Mockito.inOrder;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
@@ -18,10 +20,13 @@ import io.flutter.embedding.engine.systemchannels.LocalizationChannel;
 import io.flutter.plugin.localization.LocalizationPlugin;
 import io.flutter.plugin.platform.PlatformViewsController;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Locale;
 import java.util.concurrent.atomic.AtomicInteger;
 import org.junit.Test;
 import org.junit.runner.RunWith;
+import org.mockito.ArgumentCaptor;
+import org.mockito.InOrder;
 import org.robolectric.RobolectricTestRunner;
 import org.robolectric.annotation.Config;
 
@@ -225,6 +230,54 @@ public class FlutterJNITest {
     verify(platformViewsController, times(1)).onEndFrame();
   }
 
+  @Test
+  public void onDisplayFrame__decodesTheFrameInOrder() {
+    PlatformViewsController platformViewsController = mock(PlatformViewsController.class);
+
+    // --- Test Setup ---
+    FlutterJNI flutterJNI = new FlutterJNI();
+    flutterJNI.setPlatformViewsController(platformViewsController);
+
+    ByteBuffer buffer = ByteBuffer.allocate(27 * 4).order(ByteOrder.LITTLE_ENDIAN);
+    // A platform view with a clip rect and a rounded clip rect.
+    buffer.putInt(0).putInt(1).putInt(10).putInt(20).putInt(100).putInt(200);
+    buffer.putInt(100).putInt(200).putInt(2);
+    buffer.putInt(1).putInt(0).putInt(0).putInt(50).putInt(60);
+    buffer.putInt(2).putInt(0).putInt(0).putInt(10).putInt(10);
+    for (int i = 0; i < 8; i++) {
+      buffer.putFloat(1.0f);
+    }
+    buffer.flip();
+    ByteBuffer overlay = ByteBuffer.allocate(6 * 4).order(ByteOrder.LITTLE_ENDIAN);
+    overlay.putInt(1).putInt(3).putInt(1).putInt(2).putInt(3).putInt(4);
+    overlay.flip();
+    ByteBuffer frame = ByteBuffer.allocate(buffer.remaining() + overlay.remaining());
+    frame.put(buffer).put(overlay).flip();
+
+    // --- Execute Test ---
+    flutterJNI.onDisplayFrame(frame);
+
+    // --- Verify Results ---
+    ArgumentCaptor<FlutterMutatorsStack> stack =
+        ArgumentCaptor.forClass(FlutterMutatorsStack.class);
+    InOrder inOrder = inOrder(platformViewsController);
+    inOrder.verify(platformViewsController).onBeginFrame();
+    inOrder
+        .verify(platformViewsController)
+        .onDisplayPlatformView(
+            eq(1), eq(10), eq(20), eq(100), eq(200), eq(100), eq(200), stack.capture());
+    inOrder.verify(platformViewsController).onDisplayOverlaySurface(3, 1, 2, 3, 4);
+    inOrder.verify(platformViewsController).onEndFrame();
+    assertEquals(stack.getValue().getMutators().size(), 2);
+    assertEquals(
+        stack.getValue().getMutators().get(0).getType(),
+        FlutterMutatorsStack.FlutterMutatorType.CLIP_RECT);
+    assertEquals(stack.getValue().getMutators().get(0).getRect().right, 50);
+    assertEquals(
+        stack.getValue().getMutators().get(1).getType(),
+        FlutterMutatorsStack.FlutterMutatorType.CLIP_RRECT);
+  }
+
   @Test
   public void createOverlaySurface__callsPlatformViewsController() {
     PlatformViewsController platformViewsController = mock(PlatformViewsController.class);
@@ -1,6 +1,9 @@
 package io.flutter.embedding.engine.renderer;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.mockito.Matchers.anyInt;
+import static org.mockito.Matchers.anyLong;
 import static org.mockito.Matchers.eq;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.times;
@@ -12,6 +15,7 @@ import android.graphics.SurfaceTexture;
 import android.os.Looper;
 import android.view.Surface;
 import io.flutter.embedding.engine.FlutterJNI;
+import io.flutter.view.TextureRegistry;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.TimeUnit;
 import org.junit.Before;
@@ -198,6 +202,38 @@ public class FlutterRendererTest {
     verify(fakeFlutterJNI, times(0)).unregisterTexture(eq(id));
   }
 
+  @Test
+  @Config(sdk = 26)
+  public void itRegistersAndReleasesImageTexture() {
+    // Setup the test.
+    Surface textureSurface = mock(Surface.class);
+    when(fakeFlutterJNI.registerImageTexture(anyLong(), eq(64), eq(32)))
+        .thenReturn(textureSurface);
+    FlutterRenderer flutterRenderer = new FlutterRenderer(fakeFlutterJNI);
+
+    // Execute the behavior under test.
+    TextureRegistry.ImageTextureEntry entry = flutterRenderer.createImageTexture(64, 32);
+    entry.release();
+    entry.release();
+
+    // Verify behavior under test.
+    assertEquals(textureSurface, entry.surface());
+    verify(fakeFlutterJNI, times(1)).registerImageTexture(eq(entry.id()), eq(64), eq(32));
+    verify(textureSurface, times(1)).release();
+    verify(fakeFlutterJNI, times(1)).unregisterTexture(eq(entry.id()));
+  }
+
+  @Test
+  @Config(sdk = 26)
+  public void itReturnsNullWhenImageTexturesAreNotSupported() {
+    // Setup the test.
+    when(fakeFlutterJNI.registerImageTexture(anyLong(), anyInt(), anyInt())).thenReturn(null);
+    FlutterRenderer flutterRenderer = new FlutterRenderer(fakeFlutterJNI);
+
+    // Execute the behavior under test and verify it.
+    assertNull(flutterRenderer.createImageTexture(64, 32));
+  }
+
   void runFinalization(FlutterRenderer.SurfaceTextureRegistryEntry entry) {
     CountDownLatch latch = new CountDownLatch(1);
     Thread fakeFinalizer =
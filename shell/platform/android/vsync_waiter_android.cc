@@ -4,11 +4,16 @@
 
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
+#include <time.h>
+
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #include <utility>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
 #include "flutter/fml/size.h"
@@ -18,9 +23,98 @@ namespace flutter {
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
+static jfieldID g_refresh_rate_fps_field_ = nullptr;
+
+namespace {
+
+// From <android/choreographer.h>, which only declares the functions when
+// targeting the API levels that introduced them. They are looked up at
+// runtime instead.
+struct AChoreographer;
+using FrameCallback64 = void (*)(int64_t frame_time_nanos, void* data);
+using RefreshRateCallback = void (*)(int64_t vsync_period_nanos, void* data);
+
+// The functions that let a thread with a looper wait for vsync without
+// calling into Java. The 64-bit frame callback needs API level 29, and the
+// refresh rate callback API level 30.
+struct ChoreographerProcs {
+  AChoreographer* (*get_instance)();
+  void (*post_frame_callback64)(AChoreographer*, FrameCallback64, void*);
+  void (*register_refresh_rate_callback)(AChoreographer*,
+                                         RefreshRateCallback,
+                                         void*);
+  bool is_valid = false;
+};
+
+template <typename T>
+bool ResolveProc(const fml::RefPtr<fml::NativeLibrary>& library,
+                 const char* name,
+                 T* proc) {
+  *proc = library ? library->ResolveFunction<T>(name).value_or(nullptr)
+                  : nullptr;
+  return *proc != nullptr;
+}
+
+ChoreographerProcs LoadProcs() {
+  ChoreographerProcs procs = {};
+  auto android = fml::NativeLibrary::Create("libandroid.so");
+  procs.is_valid =
+      ResolveProc(android, "AChoreographer_getInstance",
+                  &procs.get_instance) &&
+      ResolveProc(android, "AChoreographer_postFrameCallback64",
+                  &procs.post_frame_callback64);
+  ResolveProc(android, "AChoreographer_registerRefreshRateCallback",
+              &procs.register_refresh_rate_callback);
+  return procs;
+}
+
+const ChoreographerProcs& GetProcs() {
+  // The library stays loaded by the process once the procs are resolved.
+  static const ChoreographerProcs procs = LoadProcs();
+  return procs;
+}
+
+constexpr int64_t kDefaultRefreshPeriodNanos = 1000000000 / 60;
+
+// The refresh period of the display, which all the engines of the process
+// share.
+std::atomic<int64_t> g_refresh_period_nanos = kDefaultRefreshPeriodNanos;
+
+// Same as `System.nanoTime()`, which is the clock of the frame times of the
+// choreographer.
+int64_t MonotonicNanos() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+}  // namespace
 
 VsyncWaiterAndroid::VsyncWaiterAndroid(flutter::TaskRunners task_runners)
-    : VsyncWaiter(std::move(task_runners)) {}
+    : VsyncWaiter(std::move(task_runners)) {
+  if (!GetProcs().is_valid) {
+    return;
+  }
+  // The refresh rate is tracked by the choreographer of the main thread for
+  // as long as the process lives, so that it isn't unregistered from another
+  // thread.
+  static std::once_flag refresh_rate_flag;
+  std::call_once(refresh_rate_flag, [this]() {
+    JNIEnv* env = fml::jni::AttachCurrentThread();
+    jfloat fps = env->GetStaticFloatField(g_vsync_waiter_class->obj(),
+                                          g_refresh_rate_fps_field_);
+    if (fps > 0) {
+      g_refresh_period_nanos = static_cast<int64_t>(1000000000.0 / fps);
+    }
+    if (GetProcs().register_refresh_rate_callback) {
+      task_runners_.GetPlatformTaskRunner()->PostTask([]() {
+        GetProcs().register_refresh_rate_callback(
+            GetProcs().get_instance(), &OnChoreographerRefreshRateChanged,
+            nullptr);
+      });
+    }
+  });
+}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
 
@@ -29,6 +123,19 @@ void VsyncWaiterAndroid::AwaitVSync() {
   auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
   jlong java_baton = reinterpret_cast<jlong>(weak_this);
 
+  if (GetProcs().is_valid) {
+    // The UI thread has a looper, so its own choreographer calls it back
+    // without going through the Java choreographer of the platform thread.
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(), [java_baton]() {
+          const auto& procs = GetProcs();
+          procs.post_frame_callback64(procs.get_instance(),
+                                      &OnChoreographerFrame,
+                                      reinterpret_cast<void*>(java_baton));
+        });
+    return;
+  }
+
   task_runners_.GetPlatformTaskRunner()->PostTask([java_baton]() {
     JNIEnv* env = fml::jni::AttachCurrentThread();
     env->CallStaticVoidMethod(g_vsync_waiter_class->obj(),     //
@@ -44,12 +151,39 @@ void VsyncWaiterAndroid::OnNativeVsync(JNIEnv* env,
                                        jlong frameDelayNanos,
                                        jlong refreshPeriodNanos,
                                        jlong java_baton) {
+  OnVsync(frameDelayNanos, refreshPeriodNanos, java_baton);
+}
+
+// static
+void VsyncWaiterAndroid::OnChoreographerFrame(int64_t frame_time_nanos,
+                                              void* data) {
+  int64_t frame_delay_nanos = MonotonicNanos() - frame_time_nanos;
+  if (frame_delay_nanos < 0) {
+    frame_delay_nanos = 0;
+  }
+  OnVsync(frame_delay_nanos, g_refresh_period_nanos,
+          reinterpret_cast<jlong>(data));
+}
+
+// static
+void VsyncWaiterAndroid::OnChoreographerRefreshRateChanged(
+    int64_t vsync_period_nanos,
+    void* data) {
+  if (vsync_period_nanos > 0) {
+    g_refresh_period_nanos = vsync_period_nanos;
+  }
+}
+
+// static
+void VsyncWaiterAndroid::OnVsync(int64_t frame_delay_nanos,
+                                 int64_t refresh_period_nanos,
+                                 jlong java_baton) {
   TRACE_EVENT0("flutter", "VSYNC");
 
-  auto frame_time =
-      fml::TimePoint::Now() - fml::TimeDelta::FromNanoseconds(frameDelayNanos);
+  auto frame_time = fml::TimePoint::Now() -
+                    fml::TimeDelta::FromNanoseconds(frame_delay_nanos);
   auto target_time =
-      frame_time + fml::TimeDelta::FromNanoseconds(refreshPeriodNanos);
+      frame_time + fml::TimeDelta::FromNanoseconds(refresh_period_nanos);
 
   ConsumePendingCallback(java_baton, frame_time, target_time);
 }
@@ -91,6 +225,11 @@ bool VsyncWaiterAndroid::Register(JNIEnv* env) {
 
   FML_CHECK(g_async_wait_for_vsync_method_ != nullptr);
 
+  g_refresh_rate_fps_field_ =
+      env->GetStaticFieldID(g_vsync_waiter_class->obj(), "refreshRateFPS", "F");
+
+  FML_CHECK(g_refresh_rate_fps_field_ != nullptr);
+
   return env->RegisterNatives(clazz, methods, fml::size(methods)) == 0;
 }
 
@@ -32,6 +32,16 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
                             jlong refreshPeriodNanos,
                             jlong java_baton);
 
+  // Called by the `AChoreographer` of the thread that requested the frame.
+  static void OnChoreographerFrame(int64_t frame_time_nanos, void* data);
+
+  static void OnChoreographerRefreshRateChanged(int64_t vsync_period_nanos,
+                                                void* data);
+
+  static void OnVsync(int64_t frame_delay_nanos,
+                      int64_t refresh_period_nanos,
+                      jlong java_baton);
+
   static void ConsumePendingCallback(jlong java_baton,
                                      fml::TimePoint frame_start_time,
                                      fml::TimePoint frame_target_time);
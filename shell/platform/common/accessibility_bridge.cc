@@ -5,6 +5,7 @@
 #include "accessibility_bridge.h"
 
 #include <functional>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/third_party/accessibility/ax/ax_tree_update.h"
@@ -50,30 +51,72 @@ void AccessibilityBridge::CommitUpdates() {
   // entire subtree into a list. We pick another node from the remaining update,
   // and keep doing so until the update map is empty. We then concatenate the
   // lists in the reversed order, this guarantees parent updates always come
-  // before child updates.
+  // before child updates. The nodes are moved rather than copied, since large
+  // subtrees are reparented in a single update.
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
+  // Only the nodes that changed since they were last committed are
+  // serialized, and nodes that only moved keep the rest of their data. Nodes
+  // that this update creates, which includes the subtrees of reparented
+  // nodes, must be serialized in full.
+  std::unordered_set<int32_t> created_ids;
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
-      ConvertFluterUpdate(node, update);
+    for (SemanticsNode& node : results[i - 1]) {
+      auto committed = committed_semantics_nodes_.find(node.id);
+      const bool created = committed == committed_semantics_nodes_.end() ||
+                           created_ids.count(node.id) > 0;
+      if (created) {
+        created_ids.insert(node.children_in_traversal_order.begin(),
+                           node.children_in_traversal_order.end());
+      } else if (node.children_in_traversal_order !=
+                 committed->second.children_in_traversal_order) {
+        const std::unordered_set<int32_t> old_children(
+            committed->second.children_in_traversal_order.begin(),
+            committed->second.children_in_traversal_order.end());
+        for (int32_t child : node.children_in_traversal_order) {
+          if (old_children.count(child) == 0) {
+            created_ids.insert(child);
+          }
+        }
+      }
+
+      // The labels of custom actions are part of the data of their nodes.
+      const bool custom_actions_updated =
+          !node.custom_accessibility_actions.empty() &&
+          !pending_semantics_custom_action_updates_.empty();
+      if (created || custom_actions_updated ||
+          !HasSameContent(committed->second, node)) {
+        ConvertFluterUpdate(node, update);
+      } else if (!HasSameGeometry(committed->second, node)) {
+        ConvertFlutterGeometryUpdate(node, update);
+      } else {
+        SetTreeData(node, update);
+      }
+      committed_semantics_nodes_[node.id] = std::move(node);
     }
   }
 
-  tree_.Unserialize(update);
   pending_semantics_node_updates_.clear();
   pending_semantics_custom_action_updates_.clear();
+  if (update.nodes.empty() && !update.has_tree_data) {
+    return;
+  }
+  tree_.Unserialize(update);
 
   std::string error = tree_.error();
   if (!error.empty()) {
     BASE_LOG() << "Failed to update ui::AXTree, error: " << error;
+    // The tree may not match the committed nodes anymore, so the next updates
+    // are converted in full.
+    committed_semantics_nodes_.clear();
     return;
   }
   // Handles accessibility events as the result of the semantics update.
@@ -156,6 +199,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -180,17 +224,55 @@ void AccessibilityBridge::OnAtomicUpdateFinished(
 // Private method.
 void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
-    auto iter = pending_semantics_node_updates_.find(child);
-    if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
-      pending_semantics_node_updates_.erase(iter);
+  // Walks the subtree breadth first, which keeps parents before their
+  // children without recursing or copying the nodes.
+  result.push_back(std::move(target));
+  for (size_t i = result.size() - 1; i < result.size(); i++) {
+    for (size_t j = 0; j < result[i].children_in_traversal_order.size(); j++) {
+      auto iter = pending_semantics_node_updates_.find(
+          result[i].children_in_traversal_order[j]);
+      if (iter != pending_semantics_node_updates_.end()) {
+        result.push_back(std::move(iter->second));
+        pending_semantics_node_updates_.erase(iter);
+      }
     }
   }
 }
 
+bool AccessibilityBridge::HasSameContent(const SemanticsNode& a,
+                                         const SemanticsNode& b) {
+  return a.flags == b.flags && a.actions == b.actions &&
+         a.text_selection_base == b.text_selection_base &&
+         a.text_selection_extent == b.text_selection_extent &&
+         a.scroll_child_count == b.scroll_child_count &&
+         a.scroll_index == b.scroll_index &&
+         a.scroll_position == b.scroll_position &&
+         a.scroll_extent_max == b.scroll_extent_max &&
+         a.scroll_extent_min == b.scroll_extent_min &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.label == b.label && a.hint == b.hint && a.value == b.value &&
+         a.increased_value == b.increased_value &&
+         a.decreased_value == b.decreased_value &&
+         a.text_direction == b.text_direction &&
+         a.children_in_traversal_order == b.children_in_traversal_order &&
+         a.custom_accessibility_actions == b.custom_accessibility_actions;
+}
+
+bool AccessibilityBridge::HasSameGeometry(const SemanticsNode& a,
+                                          const SemanticsNode& b) {
+  return a.rect.left == b.rect.left && a.rect.top == b.rect.top &&
+         a.rect.right == b.rect.right && a.rect.bottom == b.rect.bottom &&
+         a.transform.scaleX == b.transform.scaleX &&
+         a.transform.skewX == b.transform.skewX &&
+         a.transform.transX == b.transform.transX &&
+         a.transform.skewY == b.transform.skewY &&
+         a.transform.scaleY == b.transform.scaleY &&
+         a.transform.transY == b.transform.transY &&
+         a.transform.pers0 == b.transform.pers0 &&
+         a.transform.pers1 == b.transform.pers1 &&
+         a.transform.pers2 == b.transform.pers2;
+}
+
 void AccessibilityBridge::ConvertFluterUpdate(const SemanticsNode& node,
                                               ui::AXTreeUpdate& tree_update) {
   ui::AXNodeData node_data;
@@ -204,6 +286,31 @@ void AccessibilityBridge::ConvertFluterUpdate(const SemanticsNode& node,
   SetStringListAttributesFromFlutterUpdate(node_data, node);
   SetNameFromFlutterUpdate(node_data, node);
   SetValueFromFlutterUpdate(node_data, node);
+  SetBoundsFromFlutterUpdate(node_data, node);
+  for (auto child : node.children_in_traversal_order) {
+    node_data.child_ids.push_back(child);
+  }
+  SetTreeData(node, tree_update);
+  tree_update.nodes.push_back(std::move(node_data));
+}
+
+void AccessibilityBridge::ConvertFlutterGeometryUpdate(
+    const SemanticsNode& node,
+    ui::AXTreeUpdate& tree_update) {
+  ui::AXNode* ax_node = tree_.GetFromId(node.id);
+  if (!ax_node) {
+    ConvertFluterUpdate(node, tree_update);
+    return;
+  }
+  ui::AXNodeData node_data = ax_node->data();
+  SetBoundsFromFlutterUpdate(node_data, node);
+  SetTreeData(node, tree_update);
+  tree_update.nodes.push_back(std::move(node_data));
+}
+
+void AccessibilityBridge::SetBoundsFromFlutterUpdate(
+    ui::AXNodeData& node_data,
+    const SemanticsNode& node) {
   node_data.relative_bounds.bounds.SetRect(node.rect.left, node.rect.top,
                                            node.rect.right - node.rect.left,
                                            node.rect.bottom - node.rect.top);
@@ -212,11 +319,6 @@ void AccessibilityBridge::ConvertFluterUpdate(const SemanticsNode& node,
       node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
       node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
       0, 0);
-  for (auto child : node.children_in_traversal_order) {
-    node_data.child_ids.push_back(child);
-  }
-  SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
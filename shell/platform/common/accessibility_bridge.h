@@ -209,6 +209,9 @@ class AccessibilityBridge
   ui::AXTree tree_;
   ui::AXEventGenerator event_generator_;
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
+  // The last update of each node in the tree, which later updates are
+  // compared against to skip what didn't change.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
@@ -218,6 +221,12 @@ class AccessibilityBridge
   void GetSubTreeList(SemanticsNode target, std::vector<SemanticsNode>& result);
   void ConvertFluterUpdate(const SemanticsNode& node,
                            ui::AXTreeUpdate& tree_update);
+  // Converts an update that only changed the bounds of a node in the tree.
+  void ConvertFlutterGeometryUpdate(const SemanticsNode& node,
+                                    ui::AXTreeUpdate& tree_update);
+  // Whether the nodes are the same, ignoring their rects and transforms.
+  static bool HasSameContent(const SemanticsNode& a, const SemanticsNode& b);
+  static bool HasSameGeometry(const SemanticsNode& a, const SemanticsNode& b);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
                                 const SemanticsNode& node);
   void SetStateFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -236,6 +245,8 @@ class AccessibilityBridge
                                 const SemanticsNode& node);
   void SetValueFromFlutterUpdate(ui::AXNodeData& node_data,
                                  const SemanticsNode& node);
+  void SetBoundsFromFlutterUpdate(ui::AXNodeData& node_data,
+                                  const SemanticsNode& node);
   void SetTreeData(const SemanticsNode& node, ui::AXTreeUpdate& tree_update);
   SemanticsNode FromFlutterSemanticsNode(
       const FlutterSemanticsNode* flutter_node);
@@ -289,5 +289,107 @@ TEST(AccessibilityBridgeTest, doesNotAssignEditableRootToSelectableText) {
       ax::mojom::BoolAttribute::kEditableRoot));
 }
 
+TEST(AccessibilityBridgeTest, onlyUpdatesTheBoundsOfMovedNodes) {
+  TestAccessibilityBridgeDelegate* delegate =
+      new TestAccessibilityBridgeDelegate();
+  std::unique_ptr<TestAccessibilityBridgeDelegate> ptr(delegate);
+  std::shared_ptr<AccessibilityBridge> bridge =
+      std::make_shared<AccessibilityBridge>(std::move(ptr));
+  FlutterSemanticsNode root = {};
+  root.id = 0;
+  root.text_selection_base = -1;
+  root.text_selection_extent = -1;
+  root.label = "root";
+  root.hint = "";
+  root.value = "";
+  root.increased_value = "";
+  root.decreased_value = "";
+  root.rect = {0, 0, 100, 100};
+  root.transform = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  root.child_count = 1;
+  int32_t children[] = {1};
+  root.children_in_traversal_order = children;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+
+  FlutterSemanticsNode child1 = root;
+  child1.id = 1;
+  child1.label = "child 1";
+  child1.rect = {0, 0, 10, 10};
+  child1.child_count = 0;
+  child1.children_in_traversal_order = nullptr;
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+
+  bridge->CommitUpdates();
+  delegate->accessibilitiy_events.clear();
+
+  // Resending a node that didn't change doesn't touch the tree.
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(delegate->accessibilitiy_events.empty());
+
+  // Moving a node keeps the rest of its data.
+  child1.rect = {0, 20, 10, 30};
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+  bridge->CommitUpdates();
+
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  EXPECT_EQ(child1_node->GetName(), "child 1");
+  EXPECT_EQ(child1_node->GetData().relative_bounds.bounds.y(), 20);
+  EXPECT_EQ(child1_node->GetData().relative_bounds.bounds.height(), 10);
+}
+
+TEST(AccessibilityBridgeTest, canReparentUnchangedNodes) {
+  std::shared_ptr<AccessibilityBridge> bridge =
+      std::make_shared<AccessibilityBridge>(
+          std::make_unique<TestAccessibilityBridgeDelegate>());
+  FlutterSemanticsNode root = {};
+  root.id = 0;
+  root.text_selection_base = -1;
+  root.text_selection_extent = -1;
+  root.label = "root";
+  root.hint = "";
+  root.value = "";
+  root.increased_value = "";
+  root.decreased_value = "";
+  root.rect = {0, 0, 100, 100};
+  root.transform = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  root.child_count = 2;
+  int32_t children[] = {1, 2};
+  root.children_in_traversal_order = children;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+
+  FlutterSemanticsNode child1 = root;
+  child1.id = 1;
+  child1.label = "child 1";
+  child1.child_count = 0;
+  child1.children_in_traversal_order = nullptr;
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+
+  FlutterSemanticsNode child2 = child1;
+  child2.id = 2;
+  child2.label = "child 2";
+  bridge->AddFlutterSemanticsNodeUpdate(&child2);
+
+  bridge->CommitUpdates();
+
+  // Move child 2 under child 1. Child 2 itself didn't change, but the tree
+  // recreates it, so it has to be serialized in full.
+  root.child_count = 1;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  child1.child_count = 1;
+  int32_t child1_children[] = {2};
+  child1.children_in_traversal_order = child1_children;
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+  bridge->AddFlutterSemanticsNodeUpdate(&child2);
+
+  bridge->CommitUpdates();
+
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  ASSERT_TRUE(child2_node);
+  EXPECT_EQ(child1_node->GetChildCount(), 1);
+  EXPECT_EQ(child2_node->GetName(), "child 2");
+}
+
 }  // namespace testing
 }  // namespace flutter
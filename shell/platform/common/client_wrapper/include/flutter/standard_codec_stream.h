@@ -0,0 +1,250 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "byte_streams.h"
+#include "encodable_value.h"
+#include "standard_codec_serializer.h"
+
+// Streaming alternatives to StandardCodecSerializer, for messages that are
+// large enough that building an EncodableValue tree for them is costly.
+
+namespace flutter {
+
+// A read-only view of a typed data list (e.g., a Uint8List or Float64List) of
+// the standard codec, which references the encoded message rather than
+// copying its elements.
+//
+// The view is only valid as long as the buffer of the message it was read
+// from.
+template <typename T>
+class TypedDataView {
+ public:
+  TypedDataView(const uint8_t* bytes, size_t size)
+      : bytes_(bytes), size_(size) {}
+
+  // Returns the number of elements of the list.
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  // Returns the element at |index|, which must be less than size().
+  //
+  // The elements are aligned relative to the start of the message, so they
+  // are only aligned in memory if the message buffer is; they are copied out
+  // rather than accessed in place for that reason.
+  T operator[](size_t index) const {
+    T value;
+    std::memcpy(&value, bytes_ + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+  // Returns the encoded elements, which are size() * sizeof(T) bytes long.
+  const uint8_t* bytes() const { return bytes_; }
+
+  // Returns a copy of the elements.
+  std::vector<T> ToVector() const {
+    std::vector<T> vector(size_);
+    if (size_ > 0) {
+      std::memcpy(vector.data(), bytes_, size_ * sizeof(T));
+    }
+    return vector;
+  }
+
+ private:
+  const uint8_t* bytes_;
+  size_t size_;
+};
+
+// The interface of the handlers of the values read by a
+// StandardCodecStreamReader.
+//
+// Each method returns whether reading should continue; returning false stops
+// the read, which then fails. The default implementations ignore the values.
+class StandardCodecValueHandler {
+ public:
+  virtual ~StandardCodecValueHandler() = default;
+
+  virtual bool OnNull() { return true; }
+
+  virtual bool OnBool(bool value) { return true; }
+
+  virtual bool OnInt32(int32_t value) { return true; }
+
+  virtual bool OnInt64(int64_t value) { return true; }
+
+  virtual bool OnDouble(double value) { return true; }
+
+  // |value| is only valid until the buffer of the message is released.
+  virtual bool OnString(std::string_view value) { return true; }
+
+  // The typed data views are only valid until the buffer of the message is
+  // released.
+  virtual bool OnUInt8List(TypedDataView<uint8_t> value) { return true; }
+
+  virtual bool OnInt32List(TypedDataView<int32_t> value) { return true; }
+
+  virtual bool OnInt64List(TypedDataView<int64_t> value) { return true; }
+
+  virtual bool OnFloat32List(TypedDataView<float> value) { return true; }
+
+  virtual bool OnFloat64List(TypedDataView<double> value) { return true; }
+
+  // Called before the |size| values of a list.
+  virtual bool OnListStart(size_t size) { return true; }
+
+  // Called after the last value of a list.
+  virtual bool OnListEnd() { return true; }
+
+  // Called before the |size| entries of a map, each of which is reported as
+  // its key followed by its value.
+  virtual bool OnMapStart(size_t size) { return true; }
+
+  // Called after the last entry of a map.
+  virtual bool OnMapEnd() { return true; }
+};
+
+// Reads the values of a message encoded with the standard codec, reporting
+// them to a StandardCodecValueHandler as they are read instead of building
+// EncodableValues for them.
+//
+// Values of custom types can't be read this way, since their encoding is only
+// known to the StandardCodecSerializer subclass that wrote them; reading such
+// a value fails.
+class StandardCodecStreamReader {
+ public:
+  // Creates a reader reading from |bytes|, which must have a length of |size|.
+  // |bytes| must remain valid for the lifetime of this object, and of any
+  // string or typed data view reported by it.
+  StandardCodecStreamReader(const uint8_t* bytes, size_t size);
+
+  ~StandardCodecStreamReader();
+
+  // Prevent copying.
+  StandardCodecStreamReader(StandardCodecStreamReader const&) = delete;
+  StandardCodecStreamReader& operator=(StandardCodecStreamReader const&) =
+      delete;
+
+  // Reads the next value, including any nested values, and reports it to
+  // |handler|.
+  //
+  // Returns false if the message is malformed, if the value is of an unknown
+  // type, or if the handler stopped the read. The position of the reader is
+  // unspecified after a failed read.
+  bool ReadValue(StandardCodecValueHandler* handler);
+
+  // Returns whether the whole message has been read.
+  bool AtEnd() const { return location_ >= size_; }
+
+ private:
+  // Reads the value whose discrimination byte was |type|.
+  bool ReadValueOfType(uint8_t type, StandardCodecValueHandler* handler);
+
+  // Reads the variable-length size from the current position, or returns
+  // false if the message ends.
+  bool ReadSize(size_t* size);
+
+  // Returns the next |length| bytes and advances past them, or returns null
+  // if the message ends before them.
+  const uint8_t* ReadBytesInPlace(size_t length);
+
+  // Advances to the next multiple of |alignment| relative to the start of the
+  // message, unless the position is already aligned.
+  void ReadAlignment(uint8_t alignment);
+
+  // Reads a fixed-type list whose values are of type T, and returns a view of
+  // it in |view|.
+  template <typename T>
+  bool ReadTypedData(TypedDataView<T>* view);
+
+  // The buffer to read from.
+  const uint8_t* bytes_;
+  // The total size of the buffer.
+  size_t size_;
+  // The current read location.
+  size_t location_ = 0;
+};
+
+// Writes values in the standard codec encoding as they are provided, without
+// requiring an EncodableValue tree to be built for them first.
+//
+// Lists and maps are written by calling WriteListStart or WriteMapStart, then
+// writing exactly |size| values for a list, or |size| pairs of a key followed
+// by its value for a map.
+class StandardCodecStreamWriter {
+ public:
+  // Creates a writer that writes into |stream|, using |serializer| for the
+  // EncodableValues passed to WriteValue. The default serializer is used if
+  // |serializer| is null.
+  //
+  // |stream| and |serializer| must remain valid for the lifetime of this
+  // object.
+  explicit StandardCodecStreamWriter(
+      ByteStreamWriter* stream,
+      const StandardCodecSerializer* serializer = nullptr);
+
+  ~StandardCodecStreamWriter();
+
+  // Prevent copying.
+  StandardCodecStreamWriter(StandardCodecStreamWriter const&) = delete;
+  StandardCodecStreamWriter& operator=(StandardCodecStreamWriter const&) =
+      delete;
+
+  void WriteNull();
+
+  void WriteBool(bool value);
+
+  void WriteInt32(int32_t value);
+
+  void WriteInt64(int64_t value);
+
+  void WriteDouble(double value);
+
+  void WriteString(std::string_view value);
+
+  // Writes the |size| elements of |data| as a typed data list, without
+  // requiring them to be copied into a std::vector.
+  void WriteUInt8List(const uint8_t* data, size_t size);
+
+  void WriteInt32List(const int32_t* data, size_t size);
+
+  void WriteInt64List(const int64_t* data, size_t size);
+
+  void WriteFloat32List(const float* data, size_t size);
+
+  void WriteFloat64List(const double* data, size_t size);
+
+  // Starts a list of |size| values.
+  void WriteListStart(size_t size);
+
+  // Starts a map of |size| entries.
+  void WriteMapStart(size_t size);
+
+  // Writes |value| with the serializer of this writer, e.g. for the parts of
+  // a message that are small, or that contain custom types.
+  void WriteValue(const EncodableValue& value);
+
+ private:
+  // Writes the |size| elements of |data| as a fixed-type list, whose encoded
+  // type is |type|.
+  template <typename T>
+  void WriteTypedData(uint8_t type, const T* data, size_t size);
+
+  // Writes the variable-length size encoding.
+  void WriteSize(size_t size);
+
+  ByteStreamWriter* stream_;
+  const StandardCodecSerializer* serializer_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
@@ -3,9 +3,10 @@
 // found in the LICENSE file.
 
 // This file contains what would normally be standard_codec_serializer.cc,
-// standard_message_codec.cc, and standard_method_codec.cc. They are grouped
-// together to simplify use of the client wrapper, since the common case is
-// that any client that needs one of these files needs all three.
+// standard_codec_stream.cc, standard_message_codec.cc, and
+// standard_method_codec.cc. They are grouped together to simplify use of the
+// client wrapper, since the common case is that any client that needs one of
+// these files needs all of them.
 
 #include <cassert>
 #include <cstring>
@@ -16,6 +17,7 @@
 
 #include "byte_buffer_streams.h"
 #include "include/flutter/standard_codec_serializer.h"
+#include "include/flutter/standard_codec_stream.h"
 #include "include/flutter/standard_message_codec.h"
 #include "include/flutter/standard_method_codec.h"
 
@@ -78,6 +80,21 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
+// Writes the variable-length size encoding of |size| to |stream|.
+void WriteSizeToStream(size_t size, ByteStreamWriter* stream) {
+  if (size < 254) {
+    stream->WriteByte(static_cast<uint8_t>(size));
+  } else if (size <= 0xffff) {
+    stream->WriteByte(254);
+    uint16_t value = static_cast<uint16_t>(size);
+    stream->WriteBytes(reinterpret_cast<uint8_t*>(&value), 2);
+  } else {
+    stream->WriteByte(255);
+    uint32_t value = static_cast<uint32_t>(size);
+    stream->WriteBytes(reinterpret_cast<uint8_t*>(&value), 4);
+  }
+}
+
 }  // namespace
 
 StandardCodecSerializer::StandardCodecSerializer() = default;
@@ -243,17 +260,7 @@ size_t StandardCodecSerializer::ReadSize(ByteStreamReader* stream) const {
 
 void StandardCodecSerializer::WriteSize(size_t size,
                                         ByteStreamWriter* stream) const {
-  if (size < 254) {
-    stream->WriteByte(static_cast<uint8_t>(size));
-  } else if (size <= 0xffff) {
-    stream->WriteByte(254);
-    uint16_t value = static_cast<uint16_t>(size);
-    stream->WriteBytes(reinterpret_cast<uint8_t*>(&value), 2);
-  } else {
-    stream->WriteByte(255);
-    uint32_t value = static_cast<uint32_t>(size);
-    stream->WriteBytes(reinterpret_cast<uint8_t*>(&value), 4);
-  }
+  WriteSizeToStream(size, stream);
 }
 
 template <typename T>
@@ -287,6 +294,298 @@ void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
                      count * type_size);
 }
 
+// ===== standard_codec_stream.h =====
+
+StandardCodecStreamReader::StandardCodecStreamReader(const uint8_t* bytes,
+                                                     size_t size)
+    : bytes_(bytes), size_(size) {}
+
+StandardCodecStreamReader::~StandardCodecStreamReader() = default;
+
+bool StandardCodecStreamReader::ReadValue(StandardCodecValueHandler* handler) {
+  const uint8_t* type = ReadBytesInPlace(1);
+  if (!type) {
+    return false;
+  }
+  return ReadValueOfType(*type, handler);
+}
+
+bool StandardCodecStreamReader::ReadValueOfType(
+    uint8_t type,
+    StandardCodecValueHandler* handler) {
+  switch (static_cast<EncodedType>(type)) {
+    case EncodedType::kNull:
+      return handler->OnNull();
+    case EncodedType::kTrue:
+      return handler->OnBool(true);
+    case EncodedType::kFalse:
+      return handler->OnBool(false);
+    case EncodedType::kInt32: {
+      const uint8_t* bytes = ReadBytesInPlace(4);
+      if (!bytes) {
+        return false;
+      }
+      int32_t value;
+      std::memcpy(&value, bytes, 4);
+      return handler->OnInt32(value);
+    }
+    case EncodedType::kInt64: {
+      const uint8_t* bytes = ReadBytesInPlace(8);
+      if (!bytes) {
+        return false;
+      }
+      int64_t value;
+      std::memcpy(&value, bytes, 8);
+      return handler->OnInt64(value);
+    }
+    case EncodedType::kFloat64: {
+      ReadAlignment(8);
+      const uint8_t* bytes = ReadBytesInPlace(8);
+      if (!bytes) {
+        return false;
+      }
+      double value;
+      std::memcpy(&value, bytes, 8);
+      return handler->OnDouble(value);
+    }
+    case EncodedType::kLargeInt:
+    case EncodedType::kString: {
+      size_t size;
+      if (!ReadSize(&size)) {
+        return false;
+      }
+      const uint8_t* bytes = ReadBytesInPlace(size);
+      if (!bytes) {
+        return false;
+      }
+      return handler->OnString(
+          std::string_view(reinterpret_cast<const char*>(bytes), size));
+    }
+    case EncodedType::kUInt8List: {
+      TypedDataView<uint8_t> view(nullptr, 0);
+      return ReadTypedData(&view) && handler->OnUInt8List(view);
+    }
+    case EncodedType::kInt32List: {
+      TypedDataView<int32_t> view(nullptr, 0);
+      return ReadTypedData(&view) && handler->OnInt32List(view);
+    }
+    case EncodedType::kInt64List: {
+      TypedDataView<int64_t> view(nullptr, 0);
+      return ReadTypedData(&view) && handler->OnInt64List(view);
+    }
+    case EncodedType::kFloat64List: {
+      TypedDataView<double> view(nullptr, 0);
+      return ReadTypedData(&view) && handler->OnFloat64List(view);
+    }
+    case EncodedType::kList: {
+      size_t length;
+      // Each value takes at least one byte.
+      if (!ReadSize(&length) || length > size_ - location_ ||
+          !handler->OnListStart(length)) {
+        return false;
+      }
+      for (size_t i = 0; i < length; ++i) {
+        if (!ReadValue(handler)) {
+          return false;
+        }
+      }
+      return handler->OnListEnd();
+    }
+    case EncodedType::kMap: {
+      size_t length;
+      // Each entry takes at least two bytes.
+      if (!ReadSize(&length) || length > (size_ - location_) / 2 ||
+          !handler->OnMapStart(length)) {
+        return false;
+      }
+      for (size_t i = 0; i < length; ++i) {
+        if (!ReadValue(handler) || !ReadValue(handler)) {
+          return false;
+        }
+      }
+      return handler->OnMapEnd();
+    }
+    case EncodedType::kFloat32List: {
+      TypedDataView<float> view(nullptr, 0);
+      return ReadTypedData(&view) && handler->OnFloat32List(view);
+    }
+  }
+  std::cerr << "Unknown type in StandardCodecStreamReader::ReadValueOfType: "
+            << static_cast<int>(type) << std::endl;
+  return false;
+}
+
+bool StandardCodecStreamReader::ReadSize(size_t* size) {
+  const uint8_t* byte = ReadBytesInPlace(1);
+  if (!byte) {
+    return false;
+  }
+  if (*byte < 254) {
+    *size = *byte;
+    return true;
+  } else if (*byte == 254) {
+    const uint8_t* bytes = ReadBytesInPlace(2);
+    if (!bytes) {
+      return false;
+    }
+    uint16_t value;
+    std::memcpy(&value, bytes, 2);
+    *size = value;
+    return true;
+  } else {
+    const uint8_t* bytes = ReadBytesInPlace(4);
+    if (!bytes) {
+      return false;
+    }
+    uint32_t value;
+    std::memcpy(&value, bytes, 4);
+    *size = value;
+    return true;
+  }
+}
+
+const uint8_t* StandardCodecStreamReader::ReadBytesInPlace(size_t length) {
+  if (location_ > size_ || length > size_ - location_) {
+    std::cerr << "Invalid read in StandardCodecStreamReader" << std::endl;
+    return nullptr;
+  }
+  const uint8_t* bytes = bytes_ + location_;
+  location_ += length;
+  return bytes;
+}
+
+void StandardCodecStreamReader::ReadAlignment(uint8_t alignment) {
+  uint8_t mod = location_ % alignment;
+  if (mod) {
+    location_ += alignment - mod;
+  }
+}
+
+template <typename T>
+bool StandardCodecStreamReader::ReadTypedData(TypedDataView<T>* view) {
+  size_t count;
+  if (!ReadSize(&count)) {
+    return false;
+  }
+  uint8_t type_size = static_cast<uint8_t>(sizeof(T));
+  if (type_size > 1) {
+    ReadAlignment(type_size);
+  }
+  if (location_ > size_ || count > (size_ - location_) / type_size) {
+    std::cerr << "Invalid read in StandardCodecStreamReader" << std::endl;
+    return false;
+  }
+  const uint8_t* bytes = ReadBytesInPlace(count * type_size);
+  if (!bytes) {
+    return false;
+  }
+  *view = TypedDataView<T>(bytes, count);
+  return true;
+}
+
+StandardCodecStreamWriter::StandardCodecStreamWriter(
+    ByteStreamWriter* stream,
+    const StandardCodecSerializer* serializer)
+    : stream_(stream),
+      serializer_(serializer ? serializer
+                             : &StandardCodecSerializer::GetInstance()) {}
+
+StandardCodecStreamWriter::~StandardCodecStreamWriter() = default;
+
+void StandardCodecStreamWriter::WriteNull() {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kNull));
+}
+
+void StandardCodecStreamWriter::WriteBool(bool value) {
+  stream_->WriteByte(static_cast<uint8_t>(value ? EncodedType::kTrue
+                                                : EncodedType::kFalse));
+}
+
+void StandardCodecStreamWriter::WriteInt32(int32_t value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kInt32));
+  stream_->WriteInt32(value);
+}
+
+void StandardCodecStreamWriter::WriteInt64(int64_t value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kInt64));
+  stream_->WriteInt64(value);
+}
+
+void StandardCodecStreamWriter::WriteDouble(double value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kFloat64));
+  stream_->WriteAlignment(8);
+  stream_->WriteDouble(value);
+}
+
+void StandardCodecStreamWriter::WriteString(std::string_view value) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kString));
+  WriteSize(value.size());
+  if (!value.empty()) {
+    stream_->WriteBytes(reinterpret_cast<const uint8_t*>(value.data()),
+                        value.size());
+  }
+}
+
+void StandardCodecStreamWriter::WriteUInt8List(const uint8_t* data,
+                                               size_t size) {
+  WriteTypedData(static_cast<uint8_t>(EncodedType::kUInt8List), data, size);
+}
+
+void StandardCodecStreamWriter::WriteInt32List(const int32_t* data,
+                                               size_t size) {
+  WriteTypedData(static_cast<uint8_t>(EncodedType::kInt32List), data, size);
+}
+
+void StandardCodecStreamWriter::WriteInt64List(const int64_t* data,
+                                               size_t size) {
+  WriteTypedData(static_cast<uint8_t>(EncodedType::kInt64List), data, size);
+}
+
+void StandardCodecStreamWriter::WriteFloat32List(const float* data,
+                                                 size_t size) {
+  WriteTypedData(static_cast<uint8_t>(EncodedType::kFloat32List), data, size);
+}
+
+void StandardCodecStreamWriter::WriteFloat64List(const double* data,
+                                                 size_t size) {
+  WriteTypedData(static_cast<uint8_t>(EncodedType::kFloat64List), data, size);
+}
+
+void StandardCodecStreamWriter::WriteListStart(size_t size) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kList));
+  WriteSize(size);
+}
+
+void StandardCodecStreamWriter::WriteMapStart(size_t size) {
+  stream_->WriteByte(static_cast<uint8_t>(EncodedType::kMap));
+  WriteSize(size);
+}
+
+void StandardCodecStreamWriter::WriteValue(const EncodableValue& value) {
+  serializer_->WriteValue(value, stream_);
+}
+
+template <typename T>
+void StandardCodecStreamWriter::WriteTypedData(uint8_t type,
+                                               const T* data,
+                                               size_t size) {
+  stream_->WriteByte(type);
+  WriteSize(size);
+  if (size == 0) {
+    return;
+  }
+  uint8_t type_size = static_cast<uint8_t>(sizeof(T));
+  if (type_size > 1) {
+    stream_->WriteAlignment(type_size);
+  }
+  stream_->WriteBytes(reinterpret_cast<const uint8_t*>(data),
+                      size * type_size);
+}
+
+void StandardCodecStreamWriter::WriteSize(size_t size) {
+  WriteSizeToStream(size, stream_);
+}
+
 // ===== standard_message_codec.h =====
 
 // static
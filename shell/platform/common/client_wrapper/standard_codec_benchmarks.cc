@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/allocation_counter.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A map of 1000 entries, such as the arguments of a method with many fields.
+EncodableValue CreateLargeMap() {
+  EncodableMap map;
+  for (int i = 0; i < 1000; i++) {
+    EncodableValue key("key" + std::to_string(i));
+    switch (i % 4) {
+      case 0:
+        map[key] = EncodableValue(i);
+        break;
+      case 1:
+        map[key] = EncodableValue(i * 0.5);
+        break;
+      case 2:
+        map[key] = EncodableValue("value" + std::to_string(i));
+        break;
+      default:
+        map[key] = EncodableValue(i % 8 == 3);
+        break;
+    }
+  }
+  return EncodableValue(map);
+}
+
+// 1 MiB of bytes, such as an image.
+EncodableValue CreateByteArray() {
+  std::vector<uint8_t> bytes(1 << 20);
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(i);
+  }
+  return EncodableValue(bytes);
+}
+
+EncodableValue CreateNestedList(int depth) {
+  EncodableList list;
+  for (int i = 0; i < 4; i++) {
+    list.push_back(depth > 1 ? CreateNestedList(depth - 1) : EncodableValue(i));
+  }
+  return EncodableValue(list);
+}
+
+// Lists of 4 elements, 6 levels deep, such as a tree of semantics.
+EncodableValue CreateNestedLists() {
+  return CreateNestedList(6);
+}
+
+void BM_StandardMessageCodecEncode(benchmark::State& state,
+                                   EncodableValue (*create_message)()) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  const EncodableValue message = create_message();
+  size_t encoded_size = 0;
+  {
+    benchmarking::ScopedAllocationCounter allocations(state);
+    for (auto _ : state) {
+      auto encoded = codec.EncodeMessage(message);
+      encoded_size = encoded->size();
+      benchmark::DoNotOptimize(encoded);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * encoded_size);
+}
+
+void BM_StandardMessageCodecDecode(benchmark::State& state,
+                                   EncodableValue (*create_message)()) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  const auto encoded = codec.EncodeMessage(create_message());
+  {
+    benchmarking::ScopedAllocationCounter allocations(state);
+    for (auto _ : state) {
+      auto decoded = codec.DecodeMessage(*encoded);
+      benchmark::DoNotOptimize(decoded);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_StandardMessageCodecEncode, LargeMap, CreateLargeMap)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecEncode, ByteArray, CreateByteArray)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecEncode, NestedLists, CreateNestedLists)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecDecode, LargeMap, CreateLargeMap)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecDecode, ByteArray, CreateByteArray)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecDecode, NestedLists, CreateNestedLists)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
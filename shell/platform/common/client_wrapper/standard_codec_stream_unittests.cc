@@ -0,0 +1,211 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_stream.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/byte_buffer_streams.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+// Records the values it is given as a flat list of strings.
+class RecordingHandler : public StandardCodecValueHandler {
+ public:
+  bool OnNull() override { return Record("null"); }
+
+  bool OnBool(bool value) override {
+    return Record(value ? "true" : "false");
+  }
+
+  bool OnInt32(int32_t value) override {
+    return Record("int32 " + std::to_string(value));
+  }
+
+  bool OnInt64(int64_t value) override {
+    return Record("int64 " + std::to_string(value));
+  }
+
+  bool OnDouble(double value) override {
+    return Record("double " + std::to_string(value));
+  }
+
+  bool OnString(std::string_view value) override {
+    return Record("string " + std::string(value));
+  }
+
+  bool OnUInt8List(TypedDataView<uint8_t> value) override {
+    uint8_lists.push_back(value.ToVector());
+    return Record("uint8list");
+  }
+
+  bool OnFloat64List(TypedDataView<double> value) override {
+    float64_lists.push_back(value.ToVector());
+    return Record("float64list");
+  }
+
+  bool OnListStart(size_t size) override {
+    return Record("list " + std::to_string(size));
+  }
+
+  bool OnListEnd() override { return Record("end list"); }
+
+  bool OnMapStart(size_t size) override {
+    return Record("map " + std::to_string(size));
+  }
+
+  bool OnMapEnd() override { return Record("end map"); }
+
+  std::vector<std::string> values;
+  std::vector<std::vector<uint8_t>> uint8_lists;
+  std::vector<std::vector<double>> float64_lists;
+
+ private:
+  bool Record(std::string value) {
+    values.push_back(std::move(value));
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(StandardCodecStream, ReaderReportsValuesInOrder) {
+  EncodableValue value(EncodableList{
+      EncodableValue(),
+      EncodableValue(true),
+      EncodableValue(int32_t{-7}),
+      EncodableValue(int64_t{1} << 40),
+      EncodableValue(1.5),
+      EncodableValue("hello"),
+      EncodableValue(std::vector<uint8_t>{1, 2, 3}),
+      EncodableValue(std::vector<double>{0.5, 2.0}),
+      EncodableValue(EncodableMap{
+          {EncodableValue("key"), EncodableValue(false)},
+      }),
+  });
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+
+  RecordingHandler handler;
+  StandardCodecStreamReader reader(encoded->data(), encoded->size());
+  ASSERT_TRUE(reader.ReadValue(&handler));
+  EXPECT_TRUE(reader.AtEnd());
+  EXPECT_EQ(handler.values,
+            (std::vector<std::string>{
+                "list 9", "null", "true", "int32 -7",
+                "int64 1099511627776", "double 1.500000", "string hello",
+                "uint8list", "float64list", "map 1", "string key", "false",
+                "end map", "end list"}));
+  EXPECT_EQ(handler.uint8_lists,
+            (std::vector<std::vector<uint8_t>>{{1, 2, 3}}));
+  EXPECT_EQ(handler.float64_lists,
+            (std::vector<std::vector<double>>{{0.5, 2.0}}));
+}
+
+TEST(StandardCodecStream, TypedDataViewsReferenceTheMessage) {
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(
+      EncodableValue(std::vector<uint8_t>{4, 5, 6}));
+  ASSERT_TRUE(encoded);
+
+  class Handler : public StandardCodecValueHandler {
+   public:
+    bool OnUInt8List(TypedDataView<uint8_t> value) override {
+      bytes = value.bytes();
+      size = value.size();
+      return true;
+    }
+    const uint8_t* bytes = nullptr;
+    size_t size = 0;
+  } handler;
+  StandardCodecStreamReader reader(encoded->data(), encoded->size());
+  ASSERT_TRUE(reader.ReadValue(&handler));
+  EXPECT_EQ(handler.size, 3u);
+  // The type and the size of the list precede its elements.
+  EXPECT_EQ(handler.bytes, encoded->data() + 2);
+}
+
+TEST(StandardCodecStream, ReaderRejectsMalformedMessages) {
+  for (const std::vector<uint8_t>& message : {
+           std::vector<uint8_t>{},
+           // A string that is longer than the message.
+           std::vector<uint8_t>{7, 10, 'a'},
+           // A list that is longer than the message.
+           std::vector<uint8_t>{12, 254, 0xff, 0xff},
+           // A Float64List that is longer than the message.
+           std::vector<uint8_t>{11, 2, 0, 0, 0, 0, 0, 0, 1, 2, 3},
+           // An unknown type.
+           std::vector<uint8_t>{128},
+       }) {
+    StandardCodecValueHandler handler;
+    StandardCodecStreamReader reader(message.data(), message.size());
+    EXPECT_FALSE(reader.ReadValue(&handler));
+  }
+}
+
+TEST(StandardCodecStream, HandlerCanStopTheRead) {
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(
+      EncodableValue(EncodableList{EncodableValue(1), EncodableValue(2)}));
+  ASSERT_TRUE(encoded);
+
+  class Handler : public StandardCodecValueHandler {
+   public:
+    bool OnInt32(int32_t value) override {
+      count++;
+      return false;
+    }
+    int count = 0;
+  } handler;
+  StandardCodecStreamReader reader(encoded->data(), encoded->size());
+  EXPECT_FALSE(reader.ReadValue(&handler));
+  EXPECT_EQ(handler.count, 1);
+}
+
+TEST(StandardCodecStream, WriterMatchesTheSerializer) {
+  const std::vector<uint8_t> bytes = {1, 2, 3};
+  const std::vector<double> doubles = {0.5, 2.0};
+  const std::vector<int32_t> ints = {1, -1};
+  std::vector<uint8_t> written;
+  ByteBufferStreamWriter stream(&written);
+  StandardCodecStreamWriter writer(&stream);
+  writer.WriteMapStart(2);
+  writer.WriteString("bytes");
+  writer.WriteListStart(3);
+  writer.WriteUInt8List(bytes.data(), bytes.size());
+  writer.WriteFloat64List(doubles.data(), doubles.size());
+  writer.WriteInt32List(ints.data(), ints.size());
+  writer.WriteString("values");
+  writer.WriteListStart(5);
+  writer.WriteNull();
+  writer.WriteBool(true);
+  writer.WriteInt64(int64_t{1} << 40);
+  writer.WriteDouble(3.25);
+  writer.WriteValue(EncodableValue(EncodableList{EncodableValue(7)}));
+
+  EncodableValue expected(EncodableMap{
+      {EncodableValue("bytes"),
+       EncodableValue(EncodableList{
+           EncodableValue(bytes),
+           EncodableValue(doubles),
+           EncodableValue(ints),
+       })},
+      {EncodableValue("values"),
+       EncodableValue(EncodableList{
+           EncodableValue(),
+           EncodableValue(true),
+           EncodableValue(int64_t{1} << 40),
+           EncodableValue(3.25),
+           EncodableValue(EncodableList{EncodableValue(7)}),
+       })},
+  });
+  auto decoded = StandardMessageCodec::GetInstance().DecodeMessage(written);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(*decoded, expected);
+}
+
+}  // namespace flutter
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <string>
+
+#include "flutter/benchmarking/allocation_counter.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/json_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// The payloads have the same shapes as the ones of
+// client_wrapper/standard_codec_benchmarks.cc.
+
+// A map of 1000 entries, such as the arguments of a method with many fields.
+rapidjson::Document CreateLargeMap() {
+  rapidjson::Document document(rapidjson::kObjectType);
+  auto& allocator = document.GetAllocator();
+  for (int i = 0; i < 1000; i++) {
+    const std::string name = "key" + std::to_string(i);
+    rapidjson::Value key(name.c_str(), name.size(), allocator);
+    switch (i % 4) {
+      case 0:
+        document.AddMember(key, rapidjson::Value(i), allocator);
+        break;
+      case 1:
+        document.AddMember(key, rapidjson::Value(i * 0.5), allocator);
+        break;
+      case 2: {
+        const std::string value = "value" + std::to_string(i);
+        document.AddMember(
+            key, rapidjson::Value(value.c_str(), value.size(), allocator),
+            allocator);
+        break;
+      }
+      default:
+        document.AddMember(key, rapidjson::Value(i % 8 == 3), allocator);
+        break;
+    }
+  }
+  return document;
+}
+
+// JSON has no byte arrays, so the bytes are a list of numbers. 64 KiB of
+// them, since they are much larger to encode than in the other codecs.
+rapidjson::Document CreateByteArray() {
+  rapidjson::Document document(rapidjson::kArrayType);
+  auto& allocator = document.GetAllocator();
+  for (int i = 0; i < (1 << 16); i++) {
+    document.PushBack(rapidjson::Value(i % 256), allocator);
+  }
+  return document;
+}
+
+void AddNestedListElements(rapidjson::Value& list,
+                           int depth,
+                           rapidjson::Document::AllocatorType& allocator) {
+  for (int i = 0; i < 4; i++) {
+    if (depth > 1) {
+      rapidjson::Value child(rapidjson::kArrayType);
+      AddNestedListElements(child, depth - 1, allocator);
+      list.PushBack(child, allocator);
+    } else {
+      list.PushBack(rapidjson::Value(i), allocator);
+    }
+  }
+}
+
+// Lists of 4 elements, 6 levels deep, such as a tree of semantics.
+rapidjson::Document CreateNestedLists() {
+  rapidjson::Document document(rapidjson::kArrayType);
+  AddNestedListElements(document, 6, document.GetAllocator());
+  return document;
+}
+
+// The allocations that rapidjson makes with malloc, in chunks for the values
+// of the documents, aren't counted.
+void BM_JsonMessageCodecEncode(benchmark::State& state,
+                               rapidjson::Document (*create_message)()) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  const rapidjson::Document message = create_message();
+  size_t encoded_size = 0;
+  {
+    benchmarking::ScopedAllocationCounter allocations(state);
+    for (auto _ : state) {
+      auto encoded = codec.EncodeMessage(message);
+      encoded_size = encoded->size();
+      benchmark::DoNotOptimize(encoded);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * encoded_size);
+}
+
+void BM_JsonMessageCodecDecode(benchmark::State& state,
+                               rapidjson::Document (*create_message)()) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  const auto encoded = codec.EncodeMessage(create_message());
+  size_t document_size = 0;
+  {
+    benchmarking::ScopedAllocationCounter allocations(state);
+    for (auto _ : state) {
+      auto decoded = codec.DecodeMessage(*encoded);
+      document_size = decoded->GetAllocator().Size();
+      benchmark::DoNotOptimize(decoded);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+  // The memory that the values of a decoded document take.
+  state.counters["document_bytes"] = document_size;
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_JsonMessageCodecEncode, LargeMap, CreateLargeMap)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_JsonMessageCodecEncode, ByteArray, CreateByteArray)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_JsonMessageCodecEncode, NestedLists, CreateNestedLists)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_JsonMessageCodecDecode, LargeMap, CreateLargeMap)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_JsonMessageCodecDecode, ByteArray, CreateByteArray)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_JsonMessageCodecDecode, NestedLists, CreateNestedLists)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
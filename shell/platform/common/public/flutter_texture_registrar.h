@@ -23,9 +23,21 @@ typedef struct FlutterDesktopTextureRegistrar*
 // Additional types may be added in the future.
 typedef enum {
   // A Pixel buffer-based texture.
-  kFlutterDesktopPixelBufferTexture
+  kFlutterDesktopPixelBufferTexture,
+  // A platform-specific GPU surface-backed texture.
+  kFlutterDesktopGpuSurfaceTexture
 } FlutterDesktopTextureType;
 
+// Supported GPU surface types.
+typedef enum {
+  // Uninitialized.
+  kFlutterDesktopGpuSurfaceTypeNone,
+  // A DXGI shared texture handle (Windows only).
+  // See
+  // https://docs.microsoft.com/en-us/windows/win32/api/dxgi/nf-dxgi-idxgiresource-getsharedhandle
+  kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle
+} FlutterDesktopGpuSurfaceType;
+
 // An image buffer object.
 typedef struct {
   // The pixel data buffer.
@@ -62,10 +74,62 @@ typedef struct {
   void* user_data;
 } FlutterDesktopPixelBufferTextureConfig;
 
+// A GPU surface descriptor.
+typedef struct {
+  // The size of this struct. Must be
+  // sizeof(FlutterDesktopGpuSurfaceDescriptor).
+  size_t struct_size;
+  // The surface handle. The expected type depends on the
+  // |FlutterDesktopGpuSurfaceType|.
+  //
+  // For |kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle|, this is the shared
+  // handle of a 32-bit BGRA or RGBA D3D11 texture, which the engine samples
+  // in place instead of copying it.
+  void* handle;
+  // The physical width of the surface.
+  size_t width;
+  // The physical height of the surface.
+  size_t height;
+  // An optional callback that gets invoked when the |handle| has been
+  // imported by the engine.
+  void (*release_callback)(void* release_context);
+  // Opaque data passed to |release_callback|.
+  void* release_context;
+} FlutterDesktopGpuSurfaceDescriptor;
+
+// The GPU surface callback definition provided to the Flutter engine to
+// obtain the surface to show. It is invoked with the intended surface size
+// specified by |width| and |height| and the |user_data| held by
+// FlutterDesktopGpuSurfaceTextureConfig.
+//
+// As this is called from the render thread, the callee must take care of
+// proper synchronization. The engine samples the surface until the callback
+// returns a descriptor with a different handle, so the producer must not
+// render into the surface while it is shown, for example by alternating
+// between several surfaces or by guarding them with an IDXGIKeyedMutex.
+typedef const FlutterDesktopGpuSurfaceDescriptor* (
+    *FlutterDesktopGpuSurfaceTextureCallback)(size_t width,
+                                              size_t height,
+                                              void* user_data);
+
+// An object used to configure GPU surface textures.
+typedef struct {
+  // The size of this struct. Must be
+  // sizeof(FlutterDesktopGpuSurfaceTextureConfig).
+  size_t struct_size;
+  // The type of the GPU surface.
+  FlutterDesktopGpuSurfaceType type;
+  // The callback used by the engine to obtain the surface descriptor.
+  FlutterDesktopGpuSurfaceTextureCallback callback;
+  // Opaque data that will get passed to the provided |callback|.
+  void* user_data;
+} FlutterDesktopGpuSurfaceTextureConfig;
+
 typedef struct {
   FlutterDesktopTextureType type;
   union {
     FlutterDesktopPixelBufferTextureConfig pixel_buffer_config;
+    FlutterDesktopGpuSurfaceTextureConfig gpu_surface_config;
   };
 } FlutterDesktopTextureInfo;
 
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_editing_delta.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace flutter {
+
+namespace {
+
+// Returns true if |code_unit| is a leading surrogate of a surrogate pair.
+bool IsLeadingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xD800;
+}
+
+// Returns true if |code_unit| is a trailing surrogate of a surrogate pair.
+bool IsTrailingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xDC00;
+}
+
+// Encodes UTF-16 as UTF-8. Unpaired surrogates are replaced with U+FFFD.
+std::string ToUtf8(const std::u16string& text) {
+  std::string result;
+  result.reserve(text.size());
+  for (size_t i = 0; i < text.size(); i++) {
+    char32_t code_point = text[i];
+    if (IsLeadingSurrogate(text[i]) && i + 1 < text.size() &&
+        IsTrailingSurrogate(text[i + 1])) {
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                   (text[i + 1] - 0xDC00);
+      i++;
+    } else if (IsLeadingSurrogate(text[i]) || IsTrailingSurrogate(text[i])) {
+      code_point = 0xFFFD;
+    }
+    if (code_point < 0x80) {
+      result.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      result.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+      result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+      result.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+      result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+      result.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+      result.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TextEditingDelta::TextEditingDelta(std::u16string text_before_change,
+                                   TextRange range,
+                                   std::u16string text)
+    : old_text_(std::move(text_before_change)),
+      delta_text_(std::move(text)),
+      delta_start_(static_cast<int>(range.start())),
+      delta_end_(static_cast<int>(range.end())) {}
+
+TextEditingDelta::TextEditingDelta(std::u16string text)
+    : old_text_(std::move(text)), delta_start_(-1), delta_end_(-1) {}
+
+TextEditingDelta TextEditingDelta::FromChange(
+    std::u16string text_before_change,
+    const std::u16string& text_after_change) {
+  if (text_before_change == text_after_change) {
+    return TextEditingDelta(std::move(text_before_change));
+  }
+  const size_t max_common =
+      std::min(text_before_change.size(), text_after_change.size());
+  size_t prefix = 0;
+  while (prefix < max_common &&
+         text_before_change[prefix] == text_after_change[prefix]) {
+    prefix++;
+  }
+  size_t suffix = 0;
+  while (suffix < max_common - prefix &&
+         text_before_change[text_before_change.size() - 1 - suffix] ==
+             text_after_change[text_after_change.size() - 1 - suffix]) {
+    suffix++;
+  }
+  // Don't split surrogate pairs between the unchanged text and the delta.
+  if (prefix > 0 && IsLeadingSurrogate(text_before_change[prefix - 1])) {
+    prefix--;
+  }
+  if (suffix > 0 &&
+      IsTrailingSurrogate(
+          text_before_change[text_before_change.size() - suffix])) {
+    suffix--;
+  }
+  TextRange range(prefix, text_before_change.size() - suffix);
+  std::u16string text = text_after_change.substr(
+      prefix, text_after_change.size() - suffix - prefix);
+  return TextEditingDelta(std::move(text_before_change), range,
+                          std::move(text));
+}
+
+std::string TextEditingDelta::old_text() const {
+  return ToUtf8(old_text_);
+}
+
+std::string TextEditingDelta::delta_text() const {
+  return ToUtf8(delta_text_);
+}
+
+}  // namespace flutter
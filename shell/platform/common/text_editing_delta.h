@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_TEXT_EDITING_DELTA_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_EDITING_DELTA_H_
+
+#include <string>
+
+#include "flutter/shell/platform/common/text_range.h"
+
+namespace flutter {
+
+// A change to the text of a text input client, as sent to the framework with
+// "TextInputClient.updateEditingStateWithDeltas" when the client enabled the
+// delta model.
+//
+// The range of the delta, in UTF-16 code units of the text before the change,
+// is replaced with the delta text. A delta that doesn't change the text, for
+// example one that only moves the selection, has a range of -1 to -1.
+class TextEditingDelta {
+ public:
+  TextEditingDelta(std::u16string text_before_change,
+                   TextRange range,
+                   std::u16string text);
+
+  // A delta that doesn't change the text.
+  explicit TextEditingDelta(std::u16string text);
+
+  // The smallest delta that turns |text_before_change| into
+  // |text_after_change|.
+  static TextEditingDelta FromChange(std::u16string text_before_change,
+                                     const std::u16string& text_after_change);
+
+  // The text before the change, encoded as UTF-8.
+  std::string old_text() const;
+
+  // The text that replaces the range, encoded as UTF-8.
+  std::string delta_text() const;
+
+  int delta_start() const { return delta_start_; }
+
+  int delta_end() const { return delta_end_; }
+
+  bool operator==(const TextEditingDelta& other) const {
+    return old_text_ == other.old_text_ && delta_text_ == other.delta_text_ &&
+           delta_start_ == other.delta_start_ && delta_end_ == other.delta_end_;
+  }
+
+ private:
+  std::u16string old_text_;
+  std::u16string delta_text_;
+  int delta_start_;
+  int delta_end_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_TEXT_EDITING_DELTA_H_
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_editing_delta.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextEditingDelta, Insertion) {
+  TextEditingDelta delta = TextEditingDelta::FromChange(u"ABCD", u"ABxCD");
+  EXPECT_EQ(delta.old_text(), "ABCD");
+  EXPECT_EQ(delta.delta_text(), "x");
+  EXPECT_EQ(delta.delta_start(), 2);
+  EXPECT_EQ(delta.delta_end(), 2);
+}
+
+TEST(TextEditingDelta, Deletion) {
+  TextEditingDelta delta = TextEditingDelta::FromChange(u"ABCD", u"AD");
+  EXPECT_EQ(delta.delta_text(), "");
+  EXPECT_EQ(delta.delta_start(), 1);
+  EXPECT_EQ(delta.delta_end(), 3);
+}
+
+TEST(TextEditingDelta, Replacement) {
+  TextEditingDelta delta = TextEditingDelta::FromChange(u"ABCD", u"AxyD");
+  EXPECT_EQ(delta.delta_text(), "xy");
+  EXPECT_EQ(delta.delta_start(), 1);
+  EXPECT_EQ(delta.delta_end(), 3);
+}
+
+TEST(TextEditingDelta, RepeatedCharacters) {
+  TextEditingDelta delta = TextEditingDelta::FromChange(u"aaa", u"aaaa");
+  EXPECT_EQ(delta.delta_text(), "a");
+  EXPECT_EQ(delta.delta_start(), 3);
+  EXPECT_EQ(delta.delta_end(), 3);
+}
+
+TEST(TextEditingDelta, NoChange) {
+  TextEditingDelta delta = TextEditingDelta::FromChange(u"ABCD", u"ABCD");
+  EXPECT_EQ(delta, TextEditingDelta(u"ABCD"));
+  EXPECT_EQ(delta.delta_text(), "");
+  EXPECT_EQ(delta.delta_start(), -1);
+  EXPECT_EQ(delta.delta_end(), -1);
+}
+
+TEST(TextEditingDelta, DoesNotSplitSurrogatePairs) {
+  // U+1F604 and U+1F603 share their leading surrogate.
+  TextEditingDelta delta =
+      TextEditingDelta::FromChange(u"A\U0001F604B", u"A\U0001F603B");
+  EXPECT_EQ(delta.old_text(), "A\xF0\x9F\x98\x84" "B");
+  EXPECT_EQ(delta.delta_text(), "\xF0\x9F\x98\x83");
+  EXPECT_EQ(delta.delta_start(), 1);
+  EXPECT_EQ(delta.delta_end(), 3);
+}
+
+}  // namespace flutter
@@ -174,6 +174,9 @@ class TextInputModel {
   // Gets the current text as UTF-8.
   std::string GetText() const;
 
+  // Gets the current text as UTF-16, without converting it.
+  const std::u16string& GetTextUtf16() const { return text_; }
+
   // Gets the cursor position as a byte offset in UTF-8 string returned from
   // GetText().
   int GetCursorOffset() const;
@@ -31,6 +31,16 @@ typedef void (^FlutterBinaryMessageHandler)(NSData* _Nullable message, FlutterBi
 
 typedef int64_t FlutterBinaryMessengerConnection;
 
+/**
+ * A queue on which the messages of a channel are handled instead of the
+ * platform thread.
+ *
+ * Task queues are opaque objects created by
+ * `-[FlutterBinaryMessenger makeBackgroundTaskQueue]`.
+ */
+@protocol FlutterTaskQueue <NSObject>
+@end
+
 /**
  * A facility for communicating with the Flutter side using asynchronous message
  * passing with binary messages.
@@ -88,6 +98,37 @@ FLUTTER_DARWIN_EXPORT
  * @param connection The result from `setMessageHandlerOnChannel:binaryMessageHandler:`.
  */
 - (void)cleanUpConnection:(FlutterBinaryMessengerConnection)connection;
+
+@optional
+/**
+ * Creates a serial queue that runs the message handlers of the channels that
+ * are set up with it on a background thread.
+ *
+ * The messages of those channels are delivered to the queue without going
+ * through the platform thread, so handlers doing heavy work, such as database
+ * access or cryptography, don't block the platform thread.
+ *
+ * @return The task queue.
+ */
+- (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue;
+
+/**
+ * Registers a message handler for incoming binary messages from the Flutter side
+ * on the specified channel, running it on the specified task queue.
+ *
+ * Replaces any existing handler. Use a `nil` handler for unregistering the
+ * existing handler.
+ *
+ * @param channel The channel name.
+ * @param handler The message handler.
+ * @param taskQueue The queue on which the handler runs, or `nil` to run it on
+ *   the platform thread.
+ * @return An identifier that represents the connection that was just created to the channel.
+ */
+- (FlutterBinaryMessengerConnection)
+    setMessageHandlerOnChannel:(NSString*)channel
+          binaryMessageHandler:(FlutterBinaryMessageHandler _Nullable)handler
+                     taskQueue:(NSObject<FlutterTaskQueue>* _Nullable)taskQueue;
 @end
 NS_ASSUME_NONNULL_END
 #endif  // FLUTTER_FLUTTERBINARYMESSENGER_H_
@@ -88,6 +88,25 @@ FLUTTER_DARWIN_EXPORT
              binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
                        codec:(NSObject<FlutterMessageCodec>*)codec;
 
+/**
+ * Initializes a `FlutterBasicMessageChannel` with the specified name, binary messenger,
+ * message codec, and task queue.
+ *
+ * The handler of the channel runs on the task queue, which is created by
+ * `-[FlutterBinaryMessenger makeBackgroundTaskQueue]`, instead of the platform
+ * thread.
+ *
+ * @param name The channel name.
+ * @param messenger The binary messenger.
+ * @param codec The message codec.
+ * @param taskQueue The task queue, or `nil` to handle the messages on the
+ *   platform thread.
+ */
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                       codec:(NSObject<FlutterMessageCodec>*)codec
+                   taskQueue:(NSObject<FlutterTaskQueue>* _Nullable)taskQueue;
+
 /**
  * Sends the specified message to the Flutter side, ignoring any reply.
  *
@@ -213,6 +232,25 @@ FLUTTER_DARWIN_EXPORT
              binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
                        codec:(NSObject<FlutterMethodCodec>*)codec;
 
+/**
+ * Initializes a `FlutterMethodChannel` with the specified name, binary messenger,
+ * method codec, and task queue.
+ *
+ * The handler of the channel runs on the task queue, which is created by
+ * `-[FlutterBinaryMessenger makeBackgroundTaskQueue]`, instead of the platform
+ * thread.
+ *
+ * @param name The channel name.
+ * @param messenger The binary messenger.
+ * @param codec The method codec.
+ * @param taskQueue The task queue, or `nil` to handle the messages on the
+ *   platform thread.
+ */
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                       codec:(NSObject<FlutterMethodCodec>*)codec
+                   taskQueue:(NSObject<FlutterTaskQueue>* _Nullable)taskQueue;
+
 // clang-format off
 /**
  * Invokes the specified Flutter method with the specified arguments, expecting
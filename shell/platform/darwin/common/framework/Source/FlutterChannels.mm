@@ -16,11 +16,28 @@ static void ResizeChannelBuffer(NSObject<FlutterBinaryMessenger>* binaryMessenge
   [binaryMessenger sendOnChannel:FlutterChannelBuffersChannel message:message];
 }
 
+static FlutterBinaryMessengerConnection SetMessageHandler(
+    NSObject<FlutterBinaryMessenger>* messenger,
+    NSString* name,
+    FlutterBinaryMessageHandler handler,
+    NSObject<FlutterTaskQueue>* taskQueue) {
+  if (taskQueue) {
+    NSCAssert([messenger respondsToSelector:@selector(setMessageHandlerOnChannel:
+                                                            binaryMessageHandler:taskQueue:)],
+              @"The binary messenger doesn't support task queues.");
+    return [messenger setMessageHandlerOnChannel:name
+                            binaryMessageHandler:handler
+                                       taskQueue:taskQueue];
+  }
+  return [messenger setMessageHandlerOnChannel:name binaryMessageHandler:handler];
+}
+
 @implementation FlutterBasicMessageChannel {
   NSObject<FlutterBinaryMessenger>* _messenger;
   NSString* _name;
   NSObject<FlutterMessageCodec>* _codec;
   FlutterBinaryMessengerConnection _connection;
+  NSObject<FlutterTaskQueue>* _taskQueue;
 }
 + (instancetype)messageChannelWithName:(NSString*)name
                        binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger {
@@ -40,11 +57,19 @@ static void ResizeChannelBuffer(NSObject<FlutterBinaryMessenger>* binaryMessenge
 - (instancetype)initWithName:(NSString*)name
              binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
                        codec:(NSObject<FlutterMessageCodec>*)codec {
+  return [self initWithName:name binaryMessenger:messenger codec:codec taskQueue:nil];
+}
+
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                       codec:(NSObject<FlutterMessageCodec>*)codec
+                   taskQueue:(NSObject<FlutterTaskQueue>*)taskQueue {
   self = [super init];
   NSAssert(self, @"Super init cannot be nil");
   _name = [name retain];
   _messenger = [messenger retain];
   _codec = [codec retain];
+  _taskQueue = [taskQueue retain];
   return self;
 }
 
@@ -52,6 +77,7 @@ static void ResizeChannelBuffer(NSObject<FlutterBinaryMessenger>* binaryMessenge
   [_name release];
   [_messenger release];
   [_codec release];
+  [_taskQueue release];
   [super dealloc];
 }
 
@@ -84,7 +110,7 @@ static void ResizeChannelBuffer(NSObject<FlutterBinaryMessenger>* binaryMessenge
       callback([codec encode:reply]);
     });
   };
-  _connection = [_messenger setMessageHandlerOnChannel:_name binaryMessageHandler:messageHandler];
+  _connection = SetMessageHandler(_messenger, _name, messageHandler, _taskQueue);
 }
 
 - (void)resizeChannelBuffer:(NSInteger)newSize {
@@ -175,6 +201,7 @@ NSObject const* FlutterMethodNotImplemented = [NSObject new];
   NSString* _name;
   NSObject<FlutterMethodCodec>* _codec;
   FlutterBinaryMessengerConnection _connection;
+  NSObject<FlutterTaskQueue>* _taskQueue;
 }
 
 + (instancetype)methodChannelWithName:(NSString*)name
@@ -193,11 +220,19 @@ NSObject const* FlutterMethodNotImplemented = [NSObject new];
 - (instancetype)initWithName:(NSString*)name
              binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
                        codec:(NSObject<FlutterMethodCodec>*)codec {
+  return [self initWithName:name binaryMessenger:messenger codec:codec taskQueue:nil];
+}
+
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                       codec:(NSObject<FlutterMethodCodec>*)codec
+                   taskQueue:(NSObject<FlutterTaskQueue>*)taskQueue {
   self = [super init];
   NSAssert(self, @"Super init cannot be nil");
   _name = [name retain];
   _messenger = [messenger retain];
   _codec = [codec retain];
+  _taskQueue = [taskQueue retain];
   return self;
 }
 
@@ -205,6 +240,7 @@ NSObject const* FlutterMethodNotImplemented = [NSObject new];
   [_name release];
   [_messenger release];
   [_codec release];
+  [_taskQueue release];
   [super dealloc];
 }
 
@@ -250,7 +286,7 @@ NSObject const* FlutterMethodNotImplemented = [NSObject new];
         callback([codec encodeSuccessEnvelope:result]);
     });
   };
-  _connection = [_messenger setMessageHandlerOnChannel:_name binaryMessageHandler:messageHandler];
+  _connection = SetMessageHandler(_messenger, _name, messageHandler, _taskQueue);
 }
 
 - (void)resizeChannelBuffer:(NSInteger)newSize {
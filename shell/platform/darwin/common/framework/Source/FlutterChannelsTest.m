@@ -211,4 +211,32 @@
   OCMVerify([binaryMessenger cleanUpConnection:connection]);
 }
 
+- (void)testMethodChannelWithTaskQueue {
+  NSString* channelName = @"foo";
+  FlutterBinaryMessengerConnection connection = 123;
+  id binaryMessenger = OCMProtocolMock(@protocol(FlutterBinaryMessenger));
+  id codec = OCMProtocolMock(@protocol(FlutterMethodCodec));
+  id taskQueue = OCMProtocolMock(@protocol(FlutterTaskQueue));
+  FlutterMethodChannel* channel = [[FlutterMethodChannel alloc] initWithName:channelName
+                                                             binaryMessenger:binaryMessenger
+                                                                       codec:codec
+                                                                   taskQueue:taskQueue];
+  XCTAssertNotNil(channel);
+
+  OCMStub([binaryMessenger setMessageHandlerOnChannel:channelName
+                                 binaryMessageHandler:[OCMArg any]
+                                            taskQueue:taskQueue])
+      .andReturn(connection);
+
+  FlutterMethodCallHandler handler =
+      ^(FlutterMethodCall* _Nonnull call, FlutterResult _Nonnull result) {
+      };
+  [channel setMethodCallHandler:handler];
+  OCMVerify([binaryMessenger setMessageHandlerOnChannel:channelName
+                                   binaryMessageHandler:[OCMArg isNotNil]
+                                              taskQueue:taskQueue]);
+  [channel setMethodCallHandler:nil];
+  OCMVerify([binaryMessenger cleanUpConnection:connection]);
+}
+
 @end
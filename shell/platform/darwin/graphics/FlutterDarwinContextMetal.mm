@@ -93,6 +93,7 @@ FLUTTER_ASSERT_ARC
     createExternalTextureWithIdentifier:(int64_t)textureID
                                 texture:(NSObject<FlutterTexture>*)texture {
   return [[FlutterDarwinExternalTextureMetal alloc] initWithTextureCache:_textureCache
+                                                                  device:_device
                                                                textureID:textureID
                                                                  texture:texture];
 }
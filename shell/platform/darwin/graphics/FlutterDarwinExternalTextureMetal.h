@@ -17,6 +17,13 @@
                             width:(size_t)width
                            height:(size_t)height;
 
++ (sk_sp<SkImage>)wrapYUVATexture:(nonnull id<MTLTexture>)yTex
+                            UVTex:(nonnull id<MTLTexture>)uvTex
+                        grContext:(nonnull GrDirectContext*)grContext
+                            width:(size_t)width
+                           height:(size_t)height
+                       colorSpace:(SkYUVColorSpace)colorSpace;
+
 + (sk_sp<SkImage>)wrapRGBATexture:(nonnull id<MTLTexture>)rgbaTex
                         grContext:(nonnull GrDirectContext*)grContext
                             width:(size_t)width
@@ -27,6 +34,7 @@
 @interface FlutterDarwinExternalTextureMetal : NSObject
 
 - (nullable instancetype)initWithTextureCache:(nonnull CVMetalTextureCacheRef)textureCache
+                                       device:(nonnull id<MTLDevice>)device
                                     textureID:(int64_t)textureID
                                       texture:(nonnull NSObject<FlutterTexture>*)texture;
 
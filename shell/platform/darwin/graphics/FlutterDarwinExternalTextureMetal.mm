@@ -4,6 +4,10 @@
 
 #import "flutter/shell/platform/darwin/graphics/FlutterDarwinExternalTextureMetal.h"
 
+#import <IOSurface/IOSurfaceRef.h>
+
+#include <unordered_map>
+
 #include "flutter/fml/logging.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterMacros.h"
 #include "third_party/skia/include/core/SkYUVAInfo.h"
@@ -14,21 +18,73 @@
 
 FLUTTER_ASSERT_ARC
 
+namespace {
+
+// The number of IOSurfaces the textures are kept for. Video and camera pipelines cycle through a
+// small pool of pixel buffers, so a few entries are enough to never wrap the same surface twice.
+constexpr size_t kMaxCachedSurfaces = 8;
+
+// The Metal textures that alias the planes of an IOSurface. They stay valid for as long as the
+// surface lives, and see every frame the producer renders into it without a copy.
+struct SurfaceTextures {
+  id<MTLTexture> planes[2];
+  uint64_t lastUsed = 0;
+};
+
+SkYUVColorSpace YUVColorSpaceOfPixelBuffer(CVPixelBufferRef pixelBuffer, OSType pixelFormat) {
+  const bool fullRange = pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange;
+  CFTypeRef matrix = CVBufferGetAttachment(pixelBuffer, kCVImageBufferYCbCrMatrixKey, nullptr);
+  if (matrix && CFEqual(matrix, kCVImageBufferYCbCrMatrix_ITU_R_709_2)) {
+    return fullRange ? kRec709_Full_SkYUVColorSpace : kRec709_Limited_SkYUVColorSpace;
+  }
+  return fullRange ? kJPEG_Full_SkYUVColorSpace : kRec601_Limited_SkYUVColorSpace;
+}
+
+id<MTLTexture> NewTextureOfSurfacePlane(id<MTLDevice> device,
+                                        IOSurfaceRef surface,
+                                        size_t plane,
+                                        MTLPixelFormat pixelFormat) API_AVAILABLE(ios(11.0)) {
+  // Surfaces with a single plane, like BGRA ones, report no planes at all.
+  const bool planar = IOSurfaceGetPlaneCount(surface) > 0;
+  MTLTextureDescriptor* descriptor = [MTLTextureDescriptor
+      texture2DDescriptorWithPixelFormat:pixelFormat
+                                   width:planar ? IOSurfaceGetWidthOfPlane(surface, plane)
+                                                : IOSurfaceGetWidth(surface)
+                                  height:planar ? IOSurfaceGetHeightOfPlane(surface, plane)
+                                                : IOSurfaceGetHeight(surface)
+                               mipmapped:NO];
+  descriptor.usage = MTLTextureUsageShaderRead;
+  id<MTLTexture> texture = [device newTextureWithDescriptor:descriptor
+                                                  iosurface:surface
+                                                      plane:plane];
+  if (!texture) {
+    FML_DLOG(ERROR) << "Could not create Metal texture from IOSurface plane " << plane;
+  }
+  return texture;
+}
+
+}  // namespace
+
 @implementation FlutterDarwinExternalTextureMetal {
   CVMetalTextureCacheRef _textureCache;
+  id<MTLDevice> _device;
   NSObject<FlutterTexture>* _externalTexture;
   BOOL _textureFrameAvailable;
   sk_sp<SkImage> _externalImage;
   CVPixelBufferRef _lastPixelBuffer;
   OSType _pixelFormat;
+  std::unordered_map<IOSurfaceID, SurfaceTextures> _surfaceTextures;
+  uint64_t _surfaceTexturesClock;
 }
 
 - (instancetype)initWithTextureCache:(nonnull CVMetalTextureCacheRef)textureCache
+                              device:(nonnull id<MTLDevice>)device
                            textureID:(int64_t)textureID
                              texture:(NSObject<FlutterTexture>*)texture {
   if (self = [super init]) {
     _textureCache = textureCache;
     CFRetain(_textureCache);
+    _device = device;
     _textureID = textureID;
     _externalTexture = texture;
     return self;
@@ -95,7 +151,7 @@ FLUTTER_ASSERT_ARC
   // The image must be reset because it is tied to the onscreen context. But the pixel buffer that
   // created the image is still around. In case of context reacquisition, that last pixel
   // buffer will be used to materialize the image in case the application fails to provide a new
-  // one.
+  // one. The textures of the cached surfaces are only tied to the device, so they are kept.
   _externalImage.reset();
   CVMetalTextureCacheFlush(_textureCache,  // cache
                            0               // options (must be zero)
@@ -121,8 +177,13 @@ FLUTTER_ASSERT_ARC
   }
 
   sk_sp<SkImage> image = nullptr;
-  if (_pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange ||
-      _pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) {
+  SurfaceTextures* surfaceTextures = [self texturesOfSurfaceOfPixelBuffer:pixelBuffer];
+  if (surfaceTextures) {
+    image = [self wrapSurfaceTextures:*surfaceTextures
+                          pixelBuffer:pixelBuffer
+                            grContext:grContext];
+  } else if (_pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange ||
+             _pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) {
     image = [self wrapNV12ExternalPixelBuffer:pixelBuffer grContext:grContext];
   } else {
     image = [self wrapRGBAExternalPixelBuffer:pixelBuffer grContext:grContext];
@@ -135,6 +196,82 @@ FLUTTER_ASSERT_ARC
   return image;
 }
 
+// Returns the textures that alias the IOSurface backing the pixel buffer, creating them the first
+// time the surface is seen. Unlike the texture cache, this makes no CoreVideo calls and creates no
+// Metal objects for the surfaces that a producer hands out again. Only the surfaces are retained,
+// so the pixel buffers still go back to the pool of the producer once it releases them.
+//
+// Returns null if the pixel buffer is not backed by an IOSurface or the platform can't alias it.
+- (SurfaceTextures*)texturesOfSurfaceOfPixelBuffer:(CVPixelBufferRef)pixelBuffer {
+  if (@available(iOS 11.0, *)) {
+    IOSurfaceRef surface = CVPixelBufferGetIOSurface(pixelBuffer);
+    if (!surface) {
+      return nullptr;
+    }
+
+    // The textures retain the surface, so its identifier isn't reused while it is in the cache.
+    const IOSurfaceID surfaceID = IOSurfaceGetID(surface);
+    auto found = _surfaceTextures.find(surfaceID);
+    if (found != _surfaceTextures.end()) {
+      found->second.lastUsed = ++_surfaceTexturesClock;
+      return &found->second;
+    }
+
+    SurfaceTextures textures;
+    if (_pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange ||
+        _pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) {
+      textures.planes[0] = NewTextureOfSurfacePlane(_device, surface, 0u, MTLPixelFormatR8Unorm);
+      textures.planes[1] = NewTextureOfSurfacePlane(_device, surface, 1u, MTLPixelFormatRG8Unorm);
+      if (!textures.planes[0] || !textures.planes[1]) {
+        return nullptr;
+      }
+    } else if (_pixelFormat == kCVPixelFormatType_32BGRA) {
+      textures.planes[0] = NewTextureOfSurfacePlane(_device, surface, 0u, MTLPixelFormatBGRA8Unorm);
+      if (!textures.planes[0]) {
+        return nullptr;
+      }
+    } else {
+      return nullptr;
+    }
+
+    if (_surfaceTextures.size() >= kMaxCachedSurfaces) {
+      auto leastRecentlyUsed = _surfaceTextures.begin();
+      for (auto it = _surfaceTextures.begin(); it != _surfaceTextures.end(); ++it) {
+        if (it->second.lastUsed < leastRecentlyUsed->second.lastUsed) {
+          leastRecentlyUsed = it;
+        }
+      }
+      _surfaceTextures.erase(leastRecentlyUsed);
+    }
+
+    textures.lastUsed = ++_surfaceTexturesClock;
+    return &_surfaceTextures.emplace(surfaceID, textures).first->second;
+  }
+  return nullptr;
+}
+
+- (sk_sp<SkImage>)wrapSurfaceTextures:(const SurfaceTextures&)textures
+                          pixelBuffer:(CVPixelBufferRef)pixelBuffer
+                            grContext:(GrDirectContext*)grContext {
+  const size_t width = CVPixelBufferGetWidth(pixelBuffer);
+  const size_t height = CVPixelBufferGetHeight(pixelBuffer);
+  if (textures.planes[1]) {
+    // Skia converts the planes to RGB while sampling them in the draw, so a frame costs no
+    // conversion pass of its own.
+    return [FlutterDarwinExternalTextureSkImageWrapper
+        wrapYUVATexture:textures.planes[0]
+                  UVTex:textures.planes[1]
+              grContext:grContext
+                  width:width
+                 height:height
+             colorSpace:YUVColorSpaceOfPixelBuffer(pixelBuffer, _pixelFormat)];
+  }
+  return [FlutterDarwinExternalTextureSkImageWrapper wrapRGBATexture:textures.planes[0]
+                                                           grContext:grContext
+                                                               width:width
+                                                              height:height];
+}
+
 - (sk_sp<SkImage>)wrapNV12ExternalPixelBuffer:(CVPixelBufferRef)pixelBuffer
                                     grContext:(GrDirectContext*)grContext {
   SkISize textureSize =
@@ -183,11 +320,13 @@ FLUTTER_ASSERT_ARC
   id<MTLTexture> uvTex = CVMetalTextureGetTexture(uvMetalTexture);
   CVBufferRelease(uvMetalTexture);
 
-  return [FlutterDarwinExternalTextureSkImageWrapper wrapYUVATexture:yTex
-                                                               UVTex:uvTex
-                                                           grContext:grContext
-                                                               width:textureSize.width()
-                                                              height:textureSize.height()];
+  return [FlutterDarwinExternalTextureSkImageWrapper
+      wrapYUVATexture:yTex
+                UVTex:uvTex
+            grContext:grContext
+                width:textureSize.width()
+               height:textureSize.height()
+           colorSpace:YUVColorSpaceOfPixelBuffer(pixelBuffer, _pixelFormat)];
 }
 
 - (sk_sp<SkImage>)wrapRGBAExternalPixelBuffer:(CVPixelBufferRef)pixelBuffer
@@ -229,6 +368,20 @@ FLUTTER_ASSERT_ARC
                         grContext:(nonnull GrDirectContext*)grContext
                             width:(size_t)width
                            height:(size_t)height {
+  return [self wrapYUVATexture:yTex
+                         UVTex:uvTex
+                     grContext:grContext
+                         width:width
+                        height:height
+                    colorSpace:kRec601_SkYUVColorSpace];
+}
+
++ (sk_sp<SkImage>)wrapYUVATexture:(id<MTLTexture>)yTex
+                            UVTex:(id<MTLTexture>)uvTex
+                        grContext:(nonnull GrDirectContext*)grContext
+                            width:(size_t)width
+                           height:(size_t)height
+                       colorSpace:(SkYUVColorSpace)colorSpace {
   GrMtlTextureInfo ySkiaTextureInfo;
   ySkiaTextureInfo.fTexture = sk_cf_obj<const void*>{(__bridge_retained const void*)yTex};
 
@@ -241,12 +394,15 @@ FLUTTER_ASSERT_ARC
   GrMtlTextureInfo uvSkiaTextureInfo;
   uvSkiaTextureInfo.fTexture = sk_cf_obj<const void*>{(__bridge_retained const void*)uvTex};
 
-  skiaBackendTextures[1] = GrBackendTexture(/*width=*/width,
-                                            /*height=*/height,
+  // The chroma plane of a 4:2:0 buffer is half the size of the luma plane in both directions.
+  const bool subsampled = uvTex.width < width && uvTex.height < height;
+  skiaBackendTextures[1] = GrBackendTexture(/*width=*/subsampled ? uvTex.width : width,
+                                            /*height=*/subsampled ? uvTex.height : height,
                                             /*mipMapped=*/GrMipMapped::kNo,
                                             /*textureInfo=*/uvSkiaTextureInfo);
   SkYUVAInfo yuvaInfo(skiaBackendTextures[0].dimensions(), SkYUVAInfo::PlaneConfig::kY_UV,
-                      SkYUVAInfo::Subsampling::k444, kRec601_SkYUVColorSpace);
+                      subsampled ? SkYUVAInfo::Subsampling::k420 : SkYUVAInfo::Subsampling::k444,
+                      colorSpace);
   GrYUVABackendTextures yuvaBackendTextures(yuvaInfo, skiaBackendTextures,
                                             kTopLeft_GrSurfaceOrigin);
 
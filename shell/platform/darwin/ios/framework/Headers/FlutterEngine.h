@@ -412,6 +412,19 @@ FLUTTER_DARWIN_EXPORT
  */
 @property(nonatomic, assign) BOOL isGpuDisabled;
 
+/**
+ * The timestamps of the engine startup phases in this process, for startup telemetry that doesn't
+ * need a tracing session.
+ *
+ * The keys are `vmSnapshotMapping`, `isolateSnapshotMapping`, `vmInitialization`,
+ * `rootIsolateCreation`, `firstFrame`, `shellCreation`, `firstLayerTree`, `firstRaster` and
+ * `firstPresent`, and the values are the start and the end of the phase, in nanoseconds on the
+ * monotonic clock of the engine. The phases that haven't run yet are absent.
+ * The Dart VM is shared by all the engines of the process, so each phase is the first one that ran
+ * in the process.
+ */
+@property(class, nonatomic, readonly) NSDictionary<NSString*, NSArray<NSNumber*>*>* startupTimings;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -46,6 +46,29 @@
   }
 }
 
+- (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue {
+  if (self.parent) {
+    return [self.parent makeBackgroundTaskQueue];
+  } else {
+    FML_LOG(WARNING) << "Communicating on a dead channel.";
+    return nil;
+  }
+}
+
+- (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(NSString*)channel
+                                          binaryMessageHandler:(FlutterBinaryMessageHandler)handler
+                                                     taskQueue:
+                                                         (NSObject<FlutterTaskQueue>*)taskQueue {
+  if (self.parent) {
+    return [self.parent setMessageHandlerOnChannel:channel
+                              binaryMessageHandler:handler
+                                         taskQueue:taskQueue];
+  } else {
+    FML_LOG(WARNING) << "Communicating on a dead channel.";
+    return -1;
+  }
+}
+
 - (void)cleanUpConnection:(FlutterBinaryMessengerConnection)connection {
   if (self.parent) {
     return [self.parent cleanUpConnection:connection];
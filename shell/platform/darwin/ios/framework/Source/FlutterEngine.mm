@@ -12,6 +12,7 @@
 #include "flutter/fml/platform/darwin/platform_version.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/ptrace_check.h"
+#include "flutter/runtime/startup_timings.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/shell.h"
@@ -29,6 +30,7 @@
 #import "flutter/shell/platform/darwin/ios/framework/Source/platform_message_response_darwin.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/profiler_metrics_ios.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/vsync_waiter_ios.h"
+#import "flutter/shell/platform/darwin/ios/ios_image_generator.h"
 #import "flutter/shell/platform/darwin/ios/platform_view_ios.h"
 #import "flutter/shell/platform/darwin/ios/rendering_api_selection.h"
 #include "flutter/shell/profiling/sampling_profiler.h"
@@ -181,6 +183,22 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   _platformViewsController.reset(new flutter::FlutterPlatformViewsController());
 }
 
+// Lets the platform views be composited without merging the raster thread into the platform
+// thread, if the app opted in. The drawables can only be presented with the platform views'
+// transaction with Metal.
+- (void)enableRasterThreadCompositingIfNeeded:(const flutter::TaskRunners&)taskRunners {
+  NSNumber* compositesOnRasterThread = [[NSBundle mainBundle]
+      objectForInfoDictionaryKey:@"FLTPlatformViewsCompositeOnRasterThread"];
+  if (!compositesOnRasterThread.boolValue) {
+    return;
+  }
+  if (_renderingApi != flutter::IOSRenderingAPI::kMetal) {
+    FML_LOG(WARNING) << "FLTPlatformViewsCompositeOnRasterThread requires Metal.";
+    return;
+  }
+  _platformViewsController->EnableRasterThreadCompositing(taskRunners.GetPlatformTaskRunner());
+}
+
 - (flutter::IOSRenderingAPI)platformViewsRenderingAPI {
   return _renderingApi;
 }
@@ -577,6 +595,9 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   [self maybeSetupPlatformViewChannels];
   _shell->SetGpuAvailability(_isGpuDisabled ? flutter::GpuAvailability::kUnavailable
                                             : flutter::GpuAvailability::kAvailable);
+  // Camera photos are decoded by ImageIO ahead of the Skia codecs.
+  _shell->RegisterImageDecoder(
+      [](sk_sp<SkData> buffer) { return flutter::IOSImageGenerator::MakeFromData(buffer); }, 1);
 }
 
 + (BOOL)isProfilerEnabled {
@@ -588,6 +609,31 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   return profilerEnabled;
 }
 
++ (NSDictionary<NSString*, NSArray<NSNumber*>*>*)startupTimings {
+  static const std::pair<flutter::StartupTimings::Phase, NSString*> kPhases[] = {
+      {flutter::StartupTimings::Phase::kVMSnapshotMapping, @"vmSnapshotMapping"},
+      {flutter::StartupTimings::Phase::kIsolateSnapshotMapping, @"isolateSnapshotMapping"},
+      {flutter::StartupTimings::Phase::kVMInitialization, @"vmInitialization"},
+      {flutter::StartupTimings::Phase::kRootIsolateCreation, @"rootIsolateCreation"},
+      {flutter::StartupTimings::Phase::kFirstFrame, @"firstFrame"},
+      {flutter::StartupTimings::Phase::kShellCreation, @"shellCreation"},
+      {flutter::StartupTimings::Phase::kFirstLayerTree, @"firstLayerTree"},
+      {flutter::StartupTimings::Phase::kFirstRaster, @"firstRaster"},
+      {flutter::StartupTimings::Phase::kFirstPresent, @"firstPresent"},
+  };
+  NSMutableDictionary<NSString*, NSArray<NSNumber*>*>* timings = [NSMutableDictionary dictionary];
+  for (const auto& [phase, name] : kPhases) {
+    auto interval = flutter::StartupTimings::Get(phase);
+    if (interval) {
+      timings[name] = @[
+        @(interval->start.ToEpochDelta().ToNanoseconds()),
+        @(interval->end.ToEpochDelta().ToNanoseconds())
+      ];
+    }
+  }
+  return timings;
+}
+
 + (NSString*)generateThreadLabel:(NSString*)labelPrefix {
   static size_t s_shellCount = 0;
   return [NSString stringWithFormat:@"%@.%zu", labelPrefix, ++s_shellCount];
@@ -647,6 +693,7 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
   flutter::Shell::CreateCallback<flutter::PlatformView> on_create_platform_view =
       [self](flutter::Shell& shell) {
         [self recreatePlatformViewController];
+        [self enableRasterThreadCompositingIfNeeded:shell.GetTaskRunners()];
         return std::make_unique<flutter::PlatformViewIOS>(
             shell, self->_renderingApi, self->_platformViewsController, shell.GetTaskRunners());
       };
@@ -932,9 +979,26 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
 - (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(NSString*)channel
                                           binaryMessageHandler:
                                               (FlutterBinaryMessageHandler)handler {
+  return [self setMessageHandlerOnChannel:channel binaryMessageHandler:handler taskQueue:nil];
+}
+
+- (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue {
+  dispatch_queue_t queue = dispatch_queue_create("io.flutter.background_task_queue",
+                                                 DISPATCH_QUEUE_SERIAL);
+  FlutterDispatchTaskQueue* taskQueue =
+      [[[FlutterDispatchTaskQueue alloc] initWithQueue:queue] autorelease];
+  dispatch_release(queue);
+  return taskQueue;
+}
+
+- (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(NSString*)channel
+                                          binaryMessageHandler:(FlutterBinaryMessageHandler)handler
+                                                     taskQueue:
+                                                         (NSObject<FlutterTaskQueue>*)taskQueue {
   NSParameterAssert(channel);
   if (_shell && _shell->IsSetup()) {
-    self.iosPlatformView->GetPlatformMessageRouter().SetMessageHandler(channel.UTF8String, handler);
+    self.iosPlatformView->GetPlatformMessageRouter().SetMessageHandler(channel.UTF8String,
+                                                                       handler, taskQueue);
     return _connections->AquireConnection(channel.UTF8String);
   } else {
     NSAssert(!handler, @"Setting a message handler before the FlutterEngine has been run.");
@@ -1085,6 +1149,7 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
   flutter::Shell::CreateCallback<flutter::PlatformView> on_create_platform_view =
       [result, context](flutter::Shell& shell) {
         [result recreatePlatformViewController];
+        [result enableRasterThreadCompositingIfNeeded:shell.GetTaskRunners()];
         return std::make_unique<flutter::PlatformViewIOS>(
             shell, context, result->_platformViewsController, shell.GetTaskRunners());
       };
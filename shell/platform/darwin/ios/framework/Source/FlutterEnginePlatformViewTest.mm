@@ -41,6 +41,10 @@ class FakeDelegate : public PlatformView::Delegate {
                                std::unique_ptr<const fml::Mapping> snapshot_data,
                                std::unique_ptr<const fml::Mapping> snapshot_instructions) override {
   }
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions) override {}
   void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                     const std::string error_message,
                                     bool transient) override {}
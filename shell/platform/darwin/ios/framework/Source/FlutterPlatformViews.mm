@@ -12,6 +12,7 @@
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/rtree.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
+#include "flutter/fml/trace_event.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterChannels.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterOverlayView.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterPlatformViews_Internal.h"
@@ -21,56 +22,63 @@
 
 namespace flutter {
 
+void FlutterPlatformViewLayerPool::AllocateLayer(GrDirectContext* gr_context,
+                                                 std::shared_ptr<IOSContext> ios_context) {
+  // Any UIKit related code has to run on main thread.
+  FML_DCHECK([[NSThread currentThread] isMainThread]);
+  std::shared_ptr<FlutterPlatformViewLayer> layer;
+  fml::scoped_nsobject<FlutterOverlayView> overlay_view;
+  fml::scoped_nsobject<FlutterOverlayView> overlay_view_wrapper;
+
+  if (!gr_context) {
+    overlay_view.reset([[FlutterOverlayView alloc] init]);
+    overlay_view_wrapper.reset([[FlutterOverlayView alloc] init]);
+
+    auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
+    std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
+    std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface();
+
+    layer = std::make_shared<FlutterPlatformViewLayer>(
+        std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
+        std::move(surface));
+  } else {
+    CGFloat screenScale = [UIScreen mainScreen].scale;
+    overlay_view.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
+    overlay_view_wrapper.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
+
+    auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
+    std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
+    std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface(gr_context);
+
+    layer = std::make_shared<FlutterPlatformViewLayer>(
+        std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
+        std::move(surface));
+    layer->gr_context = gr_context;
+  }
+  // The overlay view wrapper masks the overlay view.
+  // This is required to keep the backing surface size unchanged between frames.
+  //
+  // Otherwise, changing the size of the overlay would require a new surface,
+  // which can be very expensive.
+  //
+  // This is the case of an animation in which the overlay size is changing in every frame.
+  //
+  // +------------------------+
+  // |   overlay_view         |
+  // |    +--------------+    |              +--------------+
+  // |    |    wrapper   |    |  == mask =>  | overlay_view |
+  // |    +--------------+    |              +--------------+
+  // +------------------------+
+  overlay_view_wrapper.get().clipsToBounds = YES;
+  [overlay_view_wrapper.get() addSubview:overlay_view];
+  layers_.push_back(layer);
+}
+
 std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer(
     GrDirectContext* gr_context,
     std::shared_ptr<IOSContext> ios_context) {
   if (available_layer_index_ >= layers_.size()) {
-    std::shared_ptr<FlutterPlatformViewLayer> layer;
-    fml::scoped_nsobject<FlutterOverlayView> overlay_view;
-    fml::scoped_nsobject<FlutterOverlayView> overlay_view_wrapper;
-
-    if (!gr_context) {
-      overlay_view.reset([[FlutterOverlayView alloc] init]);
-      overlay_view_wrapper.reset([[FlutterOverlayView alloc] init]);
-
-      auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
-      std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
-      std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface();
-
-      layer = std::make_shared<FlutterPlatformViewLayer>(
-          std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
-          std::move(surface));
-    } else {
-      CGFloat screenScale = [UIScreen mainScreen].scale;
-      overlay_view.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
-      overlay_view_wrapper.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
-
-      auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
-      std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
-      std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface(gr_context);
-
-      layer = std::make_shared<FlutterPlatformViewLayer>(
-          std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
-          std::move(surface));
-      layer->gr_context = gr_context;
-    }
-    // The overlay view wrapper masks the overlay view.
-    // This is required to keep the backing surface size unchanged between frames.
-    //
-    // Otherwise, changing the size of the overlay would require a new surface,
-    // which can be very expensive.
-    //
-    // This is the case of an animation in which the overlay size is changing in every frame.
-    //
-    // +------------------------+
-    // |   overlay_view         |
-    // |    +--------------+    |              +--------------+
-    // |    |    wrapper   |    |  == mask =>  | overlay_view |
-    // |    +--------------+    |              +--------------+
-    // +------------------------+
-    overlay_view_wrapper.get().clipsToBounds = YES;
-    [overlay_view_wrapper.get() addSubview:overlay_view];
-    layers_.push_back(layer);
+    AllocateLayer(gr_context, ios_context);
   }
   std::shared_ptr<FlutterPlatformViewLayer> layer = layers_[available_layer_index_];
   if (gr_context != layer->gr_context) {
@@ -85,6 +93,18 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer
   return layer;
 }
 
+void FlutterPlatformViewLayerPool::ReserveLayers(size_t count,
+                                                 GrDirectContext* gr_context,
+                                                 std::shared_ptr<IOSContext> ios_context) {
+  while (layers_.size() < count) {
+    AllocateLayer(gr_context, ios_context);
+  }
+}
+
+size_t FlutterPlatformViewLayerPool::GetLayerCount() const {
+  return layers_.size();
+}
+
 void FlutterPlatformViewLayerPool::RecycleLayers() {
   available_layer_index_ = 0;
 }
@@ -111,6 +131,15 @@ UIViewController* FlutterPlatformViewsController::getFlutterViewController() {
   return flutter_view_controller_.get();
 }
 
+void FlutterPlatformViewsController::EnableRasterThreadCompositing(
+    fml::RefPtr<fml::TaskRunner> platform_task_runner) {
+  platform_task_runner_ = std::move(platform_task_runner);
+}
+
+bool FlutterPlatformViewsController::CompositesOnRasterThread() const {
+  return platform_task_runner_ != nullptr;
+}
+
 void FlutterPlatformViewsController::OnMethodCall(FlutterMethodCall* call, FlutterResult& result) {
   if ([[call method] isEqualToString:@"create"]) {
     OnCreate(call, result);
@@ -191,7 +220,10 @@ void FlutterPlatformViewsController::OnDispose(FlutterMethodCall* call, FlutterR
     return;
   }
   // We wait for next submitFrame to dispose views.
-  views_to_dispose_.insert(viewId);
+  {
+    std::scoped_lock lock(views_to_dispose_mutex_);
+    views_to_dispose_.insert(viewId);
+  }
   result(nil);
 }
 
@@ -258,6 +290,10 @@ bool FlutterPlatformViewsController::HasPlatformViewThisOrNextFrame() {
   return composition_order_.size() > 0 || active_composition_order_.size() > 0;
 }
 
+size_t FlutterPlatformViewsController::MaxLayerCount(size_t num_platform_views) {
+  return kMaxLayerAllocations * num_platform_views * (num_platform_views + 1) / 2;
+}
+
 const int FlutterPlatformViewsController::kDefaultMergedLeaseDuration;
 
 PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
@@ -267,6 +303,13 @@ PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
   if (!HasPlatformViewThisOrNextFrame()) {
     return PostPrerollResult::kSuccess;
   }
+  if (CompositesOnRasterThread() &&
+      layer_pool_->GetLayerCount() >= MaxLayerCount(composition_order_.size())) {
+    // The frame can be composited on the raster thread, and the UIKit changes are committed on
+    // the platform thread later. If the threads are still merged, the lease isn't extended, so
+    // that they are unmerged once it expires.
+    return PostPrerollResult::kSuccess;
+  }
   if (!raster_thread_merger->IsMerged()) {
     // The raster thread merger may be disabled if the rasterizer is being
     // created or teared down.
@@ -284,7 +327,11 @@ PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
   // In order to sync the rendering of the platform views (quartz) with skia's rendering,
   // We need to begin an explicit CATransaction. This transaction needs to be submitted
   // after the current frame is submitted.
-  BeginCATransaction();
+  //
+  // When compositing on the raster thread, the transaction is begun by the deferred commit.
+  if (!CompositesOnRasterThread()) {
+    BeginCATransaction();
+  }
   raster_thread_merger->ExtendLeaseTo(kDefaultMergedLeaseDuration);
   return PostPrerollResult::kSuccess;
 }
@@ -329,7 +376,7 @@ std::vector<SkCanvas*> FlutterPlatformViewsController::GetCurrentCanvases() {
 }
 
 int FlutterPlatformViewsController::CountClips(const MutatorsStack& mutators_stack) {
-  std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator iter = mutators_stack.Bottom();
+  auto iter = mutators_stack.Bottom();
   int clipCount = 0;
   while (iter != mutators_stack.Top()) {
     if ((*iter)->IsClipType()) {
@@ -420,12 +467,13 @@ void FlutterPlatformViewsController::CompositeWithParams(int view_id,
 }
 
 SkCanvas* FlutterPlatformViewsController::CompositeEmbeddedView(int view_id) {
-  // Any UIKit related code has to run on main thread.
-  FML_DCHECK([[NSThread currentThread] isMainThread]);
-  // Do nothing if the view doesn't need to be composited.
-  if (views_to_recomposite_.count(view_id) == 0) {
+  // Do nothing if the view doesn't need to be composited, or if that is deferred to the
+  // platform thread.
+  if (views_to_recomposite_.count(view_id) == 0 || CompositesOnRasterThread()) {
     return picture_recorders_[view_id]->getRecordingCanvas();
   }
+  // Any UIKit related code has to run on main thread.
+  FML_DCHECK([[NSThread currentThread] isMainThread]);
   CompositeWithParams(view_id, current_composition_params_[view_id]);
   views_to_recomposite_.erase(view_id);
   return picture_recorders_[view_id]->getRecordingCanvas();
@@ -464,13 +512,40 @@ SkRect FlutterPlatformViewsController::GetPlatformViewRect(int view_id) {
 bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
                                                  std::shared_ptr<IOSContext> ios_context,
                                                  std::unique_ptr<SurfaceFrame> frame) {
+  // When compositing on the raster thread, the UIKit changes are committed on the platform thread
+  // later.
+  const bool defers_commit = CompositesOnRasterThread();
   // Any UIKit related code has to run on main thread.
-  FML_DCHECK([[NSThread currentThread] isMainThread]);
+  FML_DCHECK(defers_commit || [[NSThread currentThread] isMainThread]);
   if (flutter_view_ == nullptr) {
     return frame->Submit();
   }
 
-  DisposeViews();
+  std::shared_ptr<DeferredCommit> commit;
+  if (defers_commit) {
+    commit = std::make_shared<DeferredCommit>();
+    {
+      std::scoped_lock lock(views_to_dispose_mutex_);
+      commit->views_to_dispose.swap(views_to_dispose_);
+    }
+    if (!HasPlatformViewThisOrNextFrame() && commit->views_to_dispose.empty() &&
+        pending_commit_count_ == 0) {
+      return frame->Submit();
+    }
+    for (int64_t view_id : commit->views_to_dispose) {
+      current_composition_params_.erase(view_id);
+      views_to_recomposite_.erase(view_id);
+    }
+    if ([[NSThread currentThread] isMainThread]) {
+      // The threads are merged, so allocate the layers the following frames may need, and let
+      // them be composited on the raster thread again.
+      layer_pool_->ReserveLayers(MaxLayerCount(composition_order_.size()), gr_context,
+                                 ios_context);
+    }
+    ios_context->BeginDeferringPresents();
+  } else {
+    DisposeViews();
+  }
 
   SkCanvas* background_canvas = frame->SkiaCanvas();
 
@@ -494,7 +569,10 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
     // current platform view or any of the previous platform views.
     for (size_t j = i + 1; j > 0; j--) {
       int64_t current_platform_view_id = composition_order_[j - 1];
-      SkRect platform_view_rect = GetPlatformViewRect(current_platform_view_id);
+      // The UIKit views may not reflect the current frame yet when the commit is deferred.
+      SkRect platform_view_rect =
+          defers_commit ? current_composition_params_[current_platform_view_id].finalBoundingRect()
+                        : GetPlatformViewRect(current_platform_view_id);
       std::list<SkRect> intersection_rects =
           rtree->searchNonOverlappingDrawnRects(platform_view_rect);
       auto allocation_size = intersection_rects.size();
@@ -536,25 +614,54 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
                                                                    picture,                   //
                                                                    joined_rect,               //
                                                                    current_platform_view_id,  //
-                                                                   overlay_id                 //
+                                                                   overlay_id,                //
+                                                                   !defers_commit             //
         );
         did_submit &= layer->did_submit_last_frame;
         platform_view_layers[current_platform_view_id].push_back(layer);
+        if (defers_commit) {
+          commit->layer_rects[current_platform_view_id].push_back(joined_rect);
+        }
         overlay_id++;
       }
     }
     background_canvas->drawPicture(picture);
   }
-  // If a layer was allocated in the previous frame, but it's not used in the current frame,
-  // then it can be removed from the scene.
-  RemoveUnusedLayers();
-  // Organize the layers by their z indexes.
-  BringLayersIntoView(platform_view_layers);
+  if (defers_commit) {
+    commit->unused_layers = layer_pool_->GetUnusedLayers();
+    for (int64_t view_id : composition_order_) {
+      if (views_to_recomposite_.erase(view_id) == 1) {
+        commit->views_to_recomposite.emplace(view_id, current_composition_params_[view_id]);
+      }
+    }
+    commit->composition_order = composition_order_;
+    commit->previous_composition_order = active_composition_order_;
+    commit->layers = std::move(platform_view_layers);
+  } else {
+    // If a layer was allocated in the previous frame, but it's not used in the current frame,
+    // then it can be removed from the scene.
+    RemoveUnusedLayers(layer_pool_->GetUnusedLayers(), composition_order_,
+                       active_composition_order_);
+    // Organize the layers by their z indexes.
+    BringLayersIntoView(composition_order_, platform_view_layers);
+  }
+  active_composition_order_ = composition_order_;
   // Mark all layers as available, so they can be used in the next frame.
   layer_pool_->RecycleLayers();
 
   did_submit &= frame->Submit();
 
+  if (defers_commit) {
+    commit->present = ios_context->EndDeferringPresents();
+    pending_commit_count_++;
+    auto weak_platform_views_controller = GetWeakPtr();
+    platform_task_runner_->PostTask([weak_platform_views_controller, commit]() {
+      if (weak_platform_views_controller) {
+        weak_platform_views_controller->CommitDeferredFrame(*commit);
+      }
+    });
+  }
+
   // If the frame is submitted with embedded platform views,
   // there should be a |[CATransaction begin]| call in this frame prior to all the drawing.
   // If that case, we need to commit the transaction.
@@ -562,14 +669,42 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
   return did_submit;
 }
 
-void FlutterPlatformViewsController::BringLayersIntoView(LayersMap layer_map) {
+void FlutterPlatformViewsController::CommitDeferredFrame(const DeferredCommit& commit) {
+  TRACE_EVENT0("flutter", "FlutterPlatformViewsController::CommitDeferredFrame");
+  FML_DCHECK([[NSThread currentThread] isMainThread]);
+  pending_commit_count_--;
+  if (flutter_view_ == nullptr) {
+    commit.present();
+    return;
+  }
+  // The drawables are presented in the same transaction as the changes of the platform views, so
+  // both show up at the same time.
+  [CATransaction begin];
+  DisposeViews(commit.views_to_dispose);
+  for (const auto& [view_id, params] : commit.views_to_recomposite) {
+    CompositeWithParams(view_id, params);
+  }
+  for (const auto& [view_id, rects] : commit.layer_rects) {
+    const std::vector<std::shared_ptr<FlutterPlatformViewLayer>>& layers =
+        commit.layers.at(view_id);
+    for (size_t i = 0; i < rects.size(); i++) {
+      LayoutOverlay(*layers[i], rects[i], view_id, i);
+    }
+  }
+  RemoveUnusedLayers(commit.unused_layers, commit.composition_order,
+                     commit.previous_composition_order);
+  BringLayersIntoView(commit.composition_order, commit.layers);
+  commit.present();
+  [CATransaction commit];
+}
+
+void FlutterPlatformViewsController::BringLayersIntoView(
+    const std::vector<int64_t>& composition_order,
+    LayersMap layer_map) {
   FML_DCHECK(flutter_view_);
   UIView* flutter_view = flutter_view_.get();
   auto zIndex = 0;
-  // Clear the `active_composition_order_`, which will be populated down below.
-  active_composition_order_.clear();
-  for (size_t i = 0; i < composition_order_.size(); i++) {
-    int64_t platform_view_id = composition_order_[i];
+  for (int64_t platform_view_id : composition_order) {
     std::vector<std::shared_ptr<FlutterPlatformViewLayer>> layers = layer_map[platform_view_id];
     UIView* platform_view_root = root_views_[platform_view_id].get();
 
@@ -585,7 +720,6 @@ void FlutterPlatformViewsController::BringLayersIntoView(LayersMap layer_map) {
         layer->overlay_view_wrapper.get().layer.zPosition = zIndex++;
       }
     }
-    active_composition_order_.push_back(platform_view_id);
   }
 }
 
@@ -595,24 +729,14 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
     sk_sp<SkPicture> picture,
     SkRect rect,
     int64_t view_id,
-    int64_t overlay_id) {
+    int64_t overlay_id,
+    bool layout_overlay) {
   FML_DCHECK(flutter_view_);
   std::shared_ptr<FlutterPlatformViewLayer> layer = layer_pool_->GetLayer(gr_context, ios_context);
 
-  UIView* overlay_view_wrapper = layer->overlay_view_wrapper.get();
-  auto screenScale = [UIScreen mainScreen].scale;
-  // Set the size of the overlay view wrapper.
-  // This wrapper view masks the overlay view.
-  overlay_view_wrapper.frame = CGRectMake(rect.x() / screenScale, rect.y() / screenScale,
-                                          rect.width() / screenScale, rect.height() / screenScale);
-  // Set a unique view identifier, so the overlay wrapper can be identified in unit tests.
-  overlay_view_wrapper.accessibilityIdentifier =
-      [NSString stringWithFormat:@"platform_view[%lld].overlay[%lld]", view_id, overlay_id];
-
-  UIView* overlay_view = layer->overlay_view.get();
-  // Set the size of the overlay view.
-  // This size is equal to the device screen size.
-  overlay_view.frame = flutter_view_.get().bounds;
+  if (layout_overlay) {
+    LayoutOverlay(*layer, rect, view_id, overlay_id);
+  }
 
   std::unique_ptr<SurfaceFrame> frame = layer->surface->AcquireFrame(frame_size_);
   // If frame is null, AcquireFrame already printed out an error message.
@@ -630,18 +754,40 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   return layer;
 }
 
-void FlutterPlatformViewsController::RemoveUnusedLayers() {
-  std::vector<std::shared_ptr<FlutterPlatformViewLayer>> layers = layer_pool_->GetUnusedLayers();
+void FlutterPlatformViewsController::LayoutOverlay(const FlutterPlatformViewLayer& layer,
+                                                   SkRect rect,
+                                                   int64_t view_id,
+                                                   int64_t overlay_id) {
+  UIView* overlay_view_wrapper = layer.overlay_view_wrapper.get();
+  auto screenScale = [UIScreen mainScreen].scale;
+  // Set the size of the overlay view wrapper.
+  // This wrapper view masks the overlay view.
+  overlay_view_wrapper.frame = CGRectMake(rect.x() / screenScale, rect.y() / screenScale,
+                                          rect.width() / screenScale, rect.height() / screenScale);
+  // Set a unique view identifier, so the overlay wrapper can be identified in unit tests.
+  overlay_view_wrapper.accessibilityIdentifier =
+      [NSString stringWithFormat:@"platform_view[%lld].overlay[%lld]", view_id, overlay_id];
+
+  UIView* overlay_view = layer.overlay_view.get();
+  // Set the size of the overlay view.
+  // This size is equal to the device screen size.
+  overlay_view.frame = flutter_view_.get().bounds;
+}
+
+void FlutterPlatformViewsController::RemoveUnusedLayers(
+    const std::vector<std::shared_ptr<FlutterPlatformViewLayer>>& layers,
+    const std::vector<int64_t>& composition_order,
+    const std::vector<int64_t>& previous_composition_order) {
   for (const std::shared_ptr<FlutterPlatformViewLayer>& layer : layers) {
     [layer->overlay_view_wrapper removeFromSuperview];
   }
 
   std::unordered_set<int64_t> composition_order_set;
-  for (int64_t view_id : composition_order_) {
+  for (int64_t view_id : composition_order) {
     composition_order_set.insert(view_id);
   }
   // Remove unused platform views.
-  for (int64_t view_id : active_composition_order_) {
+  for (int64_t view_id : previous_composition_order) {
     if (composition_order_set.find(view_id) == composition_order_set.end()) {
       UIView* platform_view_root = root_views_[view_id].get();
       [platform_view_root removeFromSuperview];
@@ -650,23 +796,37 @@ void FlutterPlatformViewsController::RemoveUnusedLayers() {
 }
 
 void FlutterPlatformViewsController::DisposeViews() {
-  if (views_to_dispose_.empty()) {
+  std::unordered_set<int64_t> views_to_dispose;
+  {
+    std::scoped_lock lock(views_to_dispose_mutex_);
+    views_to_dispose.swap(views_to_dispose_);
+  }
+  if (views_to_dispose.empty()) {
+    return;
+  }
+
+  for (int64_t viewId : views_to_dispose) {
+    current_composition_params_.erase(viewId);
+    views_to_recomposite_.erase(viewId);
+  }
+  DisposeViews(views_to_dispose);
+}
+
+void FlutterPlatformViewsController::DisposeViews(const std::unordered_set<int64_t>& view_ids) {
+  if (view_ids.empty()) {
     return;
   }
 
   FML_DCHECK([[NSThread currentThread] isMainThread]);
 
-  for (int64_t viewId : views_to_dispose_) {
+  for (int64_t viewId : view_ids) {
     UIView* root_view = root_views_[viewId].get();
     [root_view removeFromSuperview];
     views_.erase(viewId);
     touch_interceptors_.erase(viewId);
     root_views_.erase(viewId);
-    current_composition_params_.erase(viewId);
     clip_count_.erase(viewId);
-    views_to_recomposite_.erase(viewId);
   }
-  views_to_dispose_.clear();
 }
 
 void FlutterPlatformViewsController::BeginCATransaction() {
@@ -5,9 +5,14 @@
 #ifndef FLUTTER_SHELL_PLATFORM_DARWIN_IOS_FRAMEWORK_SOURCE_FLUTTERPLATFORMVIEWS_INTERNAL_H_
 #define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_FRAMEWORK_SOURCE_FLUTTERPLATFORMVIEWS_INTERNAL_H_
 
+#include <atomic>
+#include <mutex>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/common/shell.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterBinaryMessenger.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterChannels.h"
@@ -96,6 +101,15 @@ class FlutterPlatformViewLayerPool {
   std::shared_ptr<FlutterPlatformViewLayer> GetLayer(GrDirectContext* gr_context,
                                                      std::shared_ptr<IOSContext> ios_context);
 
+  // Allocates new layers until the pool holds at least `count` layers, without marking any of them
+  // as used. Must run on the platform thread.
+  void ReserveLayers(size_t count,
+                     GrDirectContext* gr_context,
+                     std::shared_ptr<IOSContext> ios_context);
+
+  // The number of layers in the pool, used or not.
+  size_t GetLayerCount() const;
+
   // Gets the layers in the pool that aren't currently used.
   // This method doesn't mark the layers as unused.
   std::vector<std::shared_ptr<FlutterPlatformViewLayer>> GetUnusedLayers();
@@ -119,6 +133,9 @@ class FlutterPlatformViewLayerPool {
   size_t available_layer_index_ = 0;
   std::vector<std::shared_ptr<FlutterPlatformViewLayer>> layers_;
 
+  // Allocates a new layer and appends it to `layers_`.
+  void AllocateLayer(GrDirectContext* gr_context, std::shared_ptr<IOSContext> ios_context);
+
   FML_DISALLOW_COPY_AND_ASSIGN(FlutterPlatformViewLayerPool);
 };
 
@@ -136,6 +153,19 @@ class FlutterPlatformViewsController {
 
   UIViewController* getFlutterViewController();
 
+  // Composites the platform views without merging the raster thread into the platform thread.
+  //
+  // The raster thread draws the overlays, and posts the UIKit changes of each frame to
+  // `platform_task_runner`, which applies them and presents the frame in a single CATransaction.
+  // The threads are only merged for the frames that need more overlay layers than the pool has,
+  // since those can only be created on the platform thread.
+  //
+  // The presents can only be deferred to the platform thread with Metal.
+  void EnableRasterThreadCompositing(fml::RefPtr<fml::TaskRunner> platform_task_runner);
+
+  // Whether |EnableRasterThreadCompositing| was called.
+  bool CompositesOnRasterThread() const;
+
   void RegisterViewFactory(
       NSObject<FlutterPlatformViewFactory>* factory,
       NSString* factoryId,
@@ -182,6 +212,24 @@ class FlutterPlatformViewsController {
 
   using LayersMap = std::map<int64_t, std::vector<std::shared_ptr<FlutterPlatformViewLayer>>>;
 
+  // The UIKit changes of a frame that was composited on the raster thread.
+  struct DeferredCommit {
+    std::unordered_set<int64_t> views_to_dispose;
+    std::map<int64_t, EmbeddedViewParams> views_to_recomposite;
+    std::vector<int64_t> composition_order;
+    std::vector<int64_t> previous_composition_order;
+    LayersMap layers;
+    // The rects of the `layers`, keyed by the same platform view ids.
+    std::map<int64_t, std::vector<SkRect>> layer_rects;
+    std::vector<std::shared_ptr<FlutterPlatformViewLayer>> unused_layers;
+    // Presents the drawables of the frame.
+    fml::closure present;
+  };
+
+  // The most overlay layers a frame with `num_platform_views` views may use. Each view can get up
+  // to `kMaxLayerAllocations` overlays for itself and for each view below it.
+  static size_t MaxLayerCount(size_t num_platform_views);
+
   void OnCreate(FlutterMethodCall* call, FlutterResult& result);
   void OnDispose(FlutterMethodCall* call, FlutterResult& result);
   void OnAcceptGesture(FlutterMethodCall* call, FlutterResult& result);
@@ -189,6 +237,13 @@ class FlutterPlatformViewsController {
   // Dispose the views in `views_to_dispose_`.
   void DisposeViews();
 
+  // Removes the views from the platform thread's state. Must run on the platform thread.
+  void DisposeViews(const std::unordered_set<int64_t>& view_ids);
+
+  // Applies the UIKit changes of a frame that was composited on the raster thread, and presents
+  // the frame in the same CATransaction.
+  void CommitDeferredFrame(const DeferredCommit& commit);
+
   // Returns true if there are embedded views in the scene at current frame
   // Or there will be embedded views in the next frame.
   // TODO(cyanglaz): https://github.com/flutter/flutter/issues/56474
@@ -218,18 +273,30 @@ class FlutterPlatformViewsController {
 
   // Allocates a new FlutterPlatformViewLayer if needed, draws the pixels within the rect from
   // the picture on the layer's canvas.
+  //
+  // The overlay view is only laid out when `layout_overlay` is true, otherwise that is left to
+  // the platform thread.
   std::shared_ptr<FlutterPlatformViewLayer> GetLayer(GrDirectContext* gr_context,
                                                      std::shared_ptr<IOSContext> ios_context,
                                                      sk_sp<SkPicture> picture,
                                                      SkRect rect,
                                                      int64_t view_id,
-                                                     int64_t overlay_id);
-  // Removes overlay views and platform views that aren't needed in the current frame.
+                                                     int64_t overlay_id,
+                                                     bool layout_overlay);
+  // Sets the frame of the overlay view of the layer to the rect.
   // Must run on the platform thread.
-  void RemoveUnusedLayers();
+  void LayoutOverlay(const FlutterPlatformViewLayer& layer,
+                     SkRect rect,
+                     int64_t view_id,
+                     int64_t overlay_id);
+  // Removes overlay views and platform views that aren't needed in the `composition_order`.
+  // Must run on the platform thread.
+  void RemoveUnusedLayers(const std::vector<std::shared_ptr<FlutterPlatformViewLayer>>& layers,
+                          const std::vector<int64_t>& composition_order,
+                          const std::vector<int64_t>& previous_composition_order);
   // Appends the overlay views and platform view and sets their z index based on the composition
   // order.
-  void BringLayersIntoView(LayersMap layer_map);
+  void BringLayersIntoView(const std::vector<int64_t>& composition_order, LayersMap layer_map);
 
   // Begin a CATransaction.
   // This transaction needs to be balanced with |CommitCATransactionIfNeeded|.
@@ -283,6 +350,19 @@ class FlutterPlatformViewsController {
   // Method channel `OnDispose` calls adds the views to be disposed to this set to be disposed on
   // the next frame.
   std::unordered_set<int64_t> views_to_dispose_;
+  // Guards `views_to_dispose_`, which the raster thread reads when it doesn't run on the platform
+  // thread.
+  std::mutex views_to_dispose_mutex_;
+
+  // The task runner the UIKit changes are posted to when compositing on the raster thread, or null
+  // if the threads must be merged to composite platform views.
+  fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+
+  // The number of deferred commits that were posted, but not applied yet.
+  //
+  // The frames have to keep deferring their presents to the platform thread while this isn't 0,
+  // so they aren't shown before the previous frames.
+  std::atomic<int> pending_commit_count_{0};
 
   // A vector of embedded view IDs according to their composition order.
   // The last ID in this vector belond to the that is composited on top of all others.
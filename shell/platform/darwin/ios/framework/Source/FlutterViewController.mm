@@ -1603,6 +1603,20 @@ static flutter::PointerData::DeviceKind DeviceKindFromTouchType(UITouch* touch)
                                               binaryMessageHandler:handler];
 }
 
+- (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue {
+  return [_engine.get().binaryMessenger makeBackgroundTaskQueue];
+}
+
+- (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(NSString*)channel
+                                          binaryMessageHandler:(FlutterBinaryMessageHandler)handler
+                                                     taskQueue:
+                                                         (NSObject<FlutterTaskQueue>*)taskQueue {
+  NSAssert(channel, @"The channel must not be null");
+  return [_engine.get().binaryMessenger setMessageHandlerOnChannel:channel
+                                              binaryMessageHandler:handler
+                                                         taskQueue:taskQueue];
+}
+
 - (void)cleanUpConnection:(FlutterBinaryMessengerConnection)connection {
   [_engine.get().binaryMessenger cleanUpConnection:connection];
 }
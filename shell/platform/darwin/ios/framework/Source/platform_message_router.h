@@ -5,33 +5,72 @@
 #ifndef SHELL_PLATFORM_IOS_FRAMEWORK_SOURCE_PLATFORM_MESSAGE_ROUTER_H_
 #define SHELL_PLATFORM_IOS_FRAMEWORK_SOURCE_PLATFORM_MESSAGE_ROUTER_H_
 
+#include <mutex>
 #include <unordered_map>
 
+#include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/platform/darwin/scoped_block.h"
+#include "flutter/fml/platform/darwin/scoped_nsobject.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/shell/common/platform_message_handler.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterBinaryMessenger.h"
 
+/**
+ * A `FlutterTaskQueue` backed by a dispatch queue.
+ */
+@interface FlutterDispatchTaskQueue : NSObject <FlutterTaskQueue>
+- (instancetype)initWithQueue:(dispatch_queue_t)queue;
+@property(nonatomic, readonly) dispatch_queue_t queue;
+@end
+
 namespace flutter {
 
-class PlatformMessageRouter {
+/**
+ * Routes the platform messages of the engine to the message handlers of their channels.
+ *
+ * Messages are handled from the UI thread. The handlers of the channels that were set up
+ * with a task queue run on that queue directly, and the others run on the platform thread.
+ */
+class PlatformMessageRouter : public PlatformMessageHandler {
  public:
-  PlatformMessageRouter();
-  ~PlatformMessageRouter();
+  explicit PlatformMessageRouter(fml::RefPtr<fml::TaskRunner> platform_task_runner);
+  ~PlatformMessageRouter() override;
+
+  // |PlatformMessageHandler|
+  void HandlePlatformMessage(std::unique_ptr<flutter::PlatformMessage> message) override;
 
-  void HandlePlatformMessage(
-      std::unique_ptr<flutter::PlatformMessage> message) const;
+  // |PlatformMessageHandler|
+  void InvokePlatformMessageResponseCallback(int response_id,
+                                             std::unique_ptr<fml::Mapping> mapping) override;
 
+  // |PlatformMessageHandler|
+  void InvokePlatformMessageEmptyResponseCallback(int response_id) override;
+
+  /**
+   * Sets the handler of the channel. Callable on any thread.
+   *
+   * @param task_queue The queue that the handler runs on, or `nil` to run it on the
+   *   platform thread.
+   */
   void SetMessageHandler(const std::string& channel,
-                         FlutterBinaryMessageHandler handler);
+                         FlutterBinaryMessageHandler handler,
+                         NSObject<FlutterTaskQueue>* task_queue = nil);
 
  private:
-  std::unordered_map<std::string, fml::ScopedBlock<FlutterBinaryMessageHandler>>
-      message_handlers_;
+  struct HandlerInfo {
+    fml::scoped_nsprotocol<NSObject<FlutterTaskQueue>*> task_queue;
+    fml::ScopedBlock<FlutterBinaryMessageHandler> handler;
+  };
+
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  std::mutex message_handlers_mutex_;
+  std::unordered_map<std::string, HandlerInfo> message_handlers_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PlatformMessageRouter);
 };
 
 }  // namespace flutter
 
-#endif  // SHELL_PLATFORM_IOS_FRAMEWORK_SOURCE_ACCESSIBILITY_BRIDGE_H_
+#endif  // SHELL_PLATFORM_IOS_FRAMEWORK_SOURCE_PLATFORM_MESSAGE_ROUTER_H_
@@ -6,46 +6,114 @@
 
 #include <vector>
 
+#include "flutter/fml/logging.h"
 #import "flutter/shell/platform/darwin/common/buffer_conversions.h"
 
+@implementation FlutterDispatchTaskQueue {
+  dispatch_queue_t _queue;
+}
+
+- (instancetype)initWithQueue:(dispatch_queue_t)queue {
+  self = [super init];
+  if (self) {
+    _queue = queue;
+    dispatch_retain(_queue);
+  }
+  return self;
+}
+
+- (void)dealloc {
+  dispatch_release(_queue);
+  [super dealloc];
+}
+
+- (dispatch_queue_t)queue {
+  return _queue;
+}
+
+@end
+
 namespace flutter {
 
-PlatformMessageRouter::PlatformMessageRouter() = default;
+namespace {
+
+void RunMessageHandler(FlutterBinaryMessageHandler handler, flutter::PlatformMessage& message) {
+  fml::RefPtr<flutter::PlatformMessageResponse> completer = message.response();
+  NSData* data = nil;
+  if (message.hasData()) {
+    data = ConvertMappingToNSData(message.releaseData());
+  }
+  handler(data, ^(NSData* reply) {
+    if (completer) {
+      if (reply) {
+        completer->Complete(ConvertNSDataToMappingPtr(reply));
+      } else {
+        completer->CompleteEmpty();
+      }
+    }
+  });
+}
+
+}  // namespace
+
+PlatformMessageRouter::PlatformMessageRouter(fml::RefPtr<fml::TaskRunner> platform_task_runner)
+    : platform_task_runner_(std::move(platform_task_runner)) {}
 
 PlatformMessageRouter::~PlatformMessageRouter() = default;
 
 void PlatformMessageRouter::HandlePlatformMessage(
-    std::unique_ptr<flutter::PlatformMessage> message) const {
-  fml::RefPtr<flutter::PlatformMessageResponse> completer = message->response();
-  auto it = message_handlers_.find(message->channel());
-  if (it != message_handlers_.end()) {
-    FlutterBinaryMessageHandler handler = it->second;
-    NSData* data = nil;
-    if (message->hasData()) {
-      data = ConvertMappingToNSData(message->releaseData());
+    std::unique_ptr<flutter::PlatformMessage> message) {
+  HandlerInfo handler_info;
+  {
+    std::scoped_lock lock(message_handlers_mutex_);
+    auto it = message_handlers_.find(message->channel());
+    if (it != message_handlers_.end()) {
+      handler_info = it->second;
     }
-    handler(data, ^(NSData* reply) {
-      if (completer) {
-        if (reply) {
-          completer->Complete(ConvertNSDataToMappingPtr(reply));
-        } else {
-          completer->CompleteEmpty();
-        }
-      }
+  }
+
+  if (handler_info.handler.get() == nil) {
+    if (message->response()) {
+      message->response()->CompleteEmpty();
+    }
+    return;
+  }
+
+  // Blocks can only capture copyable objects.
+  std::shared_ptr<flutter::PlatformMessage> shared_message = std::move(message);
+  fml::ScopedBlock<FlutterBinaryMessageHandler> handler = handler_info.handler;
+  if (handler_info.task_queue.get() != nil) {
+    FlutterDispatchTaskQueue* task_queue = (FlutterDispatchTaskQueue*)handler_info.task_queue.get();
+    dispatch_async(task_queue.queue, ^{
+      RunMessageHandler(handler.get(), *shared_message);
     });
   } else {
-    if (completer) {
-      completer->CompleteEmpty();
-    }
+    platform_task_runner_->PostTask(
+        [handler, shared_message]() { RunMessageHandler(handler.get(), *shared_message); });
   }
 }
 
+void PlatformMessageRouter::InvokePlatformMessageResponseCallback(
+    int response_id,
+    std::unique_ptr<fml::Mapping> mapping) {
+  // The responses of the iOS embedding are completed through the response of the message.
+  FML_DCHECK(false);
+}
+
+void PlatformMessageRouter::InvokePlatformMessageEmptyResponseCallback(int response_id) {
+  FML_DCHECK(false);
+}
+
 void PlatformMessageRouter::SetMessageHandler(const std::string& channel,
-                                              FlutterBinaryMessageHandler handler) {
+                                              FlutterBinaryMessageHandler handler,
+                                              NSObject<FlutterTaskQueue>* task_queue) {
+  FML_DCHECK(!task_queue || [task_queue isKindOfClass:[FlutterDispatchTaskQueue class]]);
+  std::scoped_lock lock(message_handlers_mutex_);
   message_handlers_.erase(channel);
   if (handler) {
-    message_handlers_[channel] =
-        fml::ScopedBlock<FlutterBinaryMessageHandler>{handler, fml::OwnershipPolicy::Retain};
+    HandlerInfo& handler_info = message_handlers_[channel];
+    handler_info.task_queue.reset([task_queue retain]);
+    handler_info.handler.reset(handler, fml::OwnershipPolicy::Retain);
   }
 }
 
@@ -9,8 +9,10 @@
 
 #include <cassert>
 #include <optional>
+#include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/shell/profiling/sampling_profiler.h"
 
 namespace flutter {
@@ -32,6 +34,13 @@ class ProfilerMetricsIOS {
 
   std::optional<MemoryUsageInfo> MemoryUsage();
 
+  std::optional<std::vector<ThreadCpuUsageInfo>> ThreadCpuUsage();
+
+  std::optional<HeapUsageInfo> HeapUsage();
+
+  fml::TimePoint last_heap_sample_time_;
+  size_t last_heap_bytes_ = 0;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ProfilerMetricsIOS);
 };
 
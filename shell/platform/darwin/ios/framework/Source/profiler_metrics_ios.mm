@@ -5,6 +5,7 @@
 #import "flutter/shell/platform/darwin/ios/framework/Source/profiler_metrics_ios.h"
 
 #import <Foundation/Foundation.h>
+#include <malloc/malloc.h>
 
 #import "flutter/shell/platform/darwin/ios/framework/Source/IOKit.h"
 
@@ -151,7 +152,11 @@ std::optional<GpuUsageInfo> PollGpuUsage() {
 }  // namespace
 
 ProfileSample ProfilerMetricsIOS::GenerateSample() {
-  return {.cpu_usage = CpuUsage(), .memory_usage = MemoryUsage(), .gpu_usage = PollGpuUsage()};
+  return {.cpu_usage = CpuUsage(),
+          .memory_usage = MemoryUsage(),
+          .gpu_usage = PollGpuUsage(),
+          .thread_cpu_usage = ThreadCpuUsage(),
+          .heap_usage = HeapUsage()};
 }
 
 std::optional<CpuUsageInfo> ProfilerMetricsIOS::CpuUsage() {
@@ -240,4 +245,56 @@ std::optional<MemoryUsageInfo> ProfilerMetricsIOS::MemoryUsage() {
   return memory_usage_info;
 }
 
+std::optional<std::vector<ThreadCpuUsageInfo>> ProfilerMetricsIOS::ThreadCpuUsage() {
+  MachThreads mach_threads = MachThreads();
+  kern_return_t kernel_return_code =
+      task_threads(mach_task_self(), &mach_threads.threads, &mach_threads.thread_count);
+  if (kernel_return_code != KERN_SUCCESS) {
+    FML_LOG(ERROR) << "Error retrieving task information: "
+                   << mach_error_string(kernel_return_code);
+    return std::nullopt;
+  }
+
+  std::vector<ThreadCpuUsageInfo> threads;
+  for (mach_msg_type_number_t i = 0; i < mach_threads.thread_count; i++) {
+    thread_extended_info_data_t extended_thread_info;
+    mach_msg_type_number_t thread_info_count = THREAD_EXTENDED_INFO_COUNT;
+    kernel_return_code =
+        thread_info(mach_threads.threads[i], THREAD_EXTENDED_INFO,
+                    reinterpret_cast<thread_info_t>(&extended_thread_info), &thread_info_count);
+    // The threads that were destroyed since they were listed are skipped, like in `CpuUsage`.
+    if (kernel_return_code != KERN_SUCCESS) {
+      continue;
+    }
+    std::string name(extended_thread_info.pth_name,
+                     strnlen(extended_thread_info.pth_name, MAXTHREADNAMESIZE));
+    if (!IsEngineThreadName(name)) {
+      continue;
+    }
+    threads.push_back({.name = std::move(name),
+                       .cpu_usage = extended_thread_info.pth_cpu_usage * 100.0 /
+                                    static_cast<float>(TH_USAGE_SCALE)});
+  }
+  return threads;
+}
+
+std::optional<HeapUsageInfo> ProfilerMetricsIOS::HeapUsage() {
+  // Sums up the statistics of all the malloc zones.
+  malloc_statistics_t statistics;
+  malloc_zone_statistics(nullptr, &statistics);
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const double growth = static_cast<double>(statistics.size_in_use) -
+                        static_cast<double>(last_heap_bytes_);
+  // There is no rate until the second sample.
+  const double elapsed_seconds = last_heap_sample_time_ == fml::TimePoint()
+                                     ? 0.0
+                                     : (now - last_heap_sample_time_).ToSecondsF();
+  last_heap_sample_time_ = now;
+  last_heap_bytes_ = statistics.size_in_use;
+  flutter::HeapUsageInfo heap_usage_info = {
+      .allocated_memory = statistics.size_in_use / 1024.0 / 1024.0,
+      .allocation_rate = elapsed_seconds > 0.0 ? growth / 1024.0 / 1024.0 / elapsed_seconds : 0.0};
+  return heap_usage_info;
+}
+
 }  // namespace flutter
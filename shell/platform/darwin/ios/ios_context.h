@@ -9,6 +9,7 @@
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/common/graphics/texture.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterTexture.h"
@@ -120,6 +121,32 @@ class IOSContext {
   ///
   virtual sk_sp<GrDirectContext> GetMainContext() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the surfaces of this context hold on to the frames they
+  ///             present instead of presenting them, until
+  ///             `EndDeferringPresents` is called.
+  ///
+  ///             This lets the platform thread present the frames rendered on
+  ///             the raster thread in the same `CATransaction` as the changes
+  ///             to the platform views they are composited with.
+  ///
+  /// @attention  This must be balanced on the thread that renders to the
+  ///             surfaces.
+  ///
+  /// @return     Whether the client rendering API can defer presents. OpenGL
+  ///             can't, as its renderbuffers have to be presented on the
+  ///             thread the context is current on.
+  ///
+  virtual bool BeginDeferringPresents();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops deferring presents.
+  ///
+  /// @return     A closure that presents the deferred frames with the current
+  ///             `CATransaction` of the thread it is called on.
+  ///
+  virtual fml::closure EndDeferringPresents();
+
  protected:
   IOSContext();
 
@@ -35,4 +35,12 @@ std::unique_ptr<IOSContext> IOSContext::Create(IOSRenderingAPI rendering_api) {
   return nullptr;
 }
 
+bool IOSContext::BeginDeferringPresents() {
+  return false;
+}
+
+fml::closure IOSContext::EndDeferringPresents() {
+  return [] {};
+}
+
 }  // namespace flutter
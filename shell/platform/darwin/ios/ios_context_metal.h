@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_CONTEXT_METAL_H_
 
 #include <Metal/Metal.h>
+#include <QuartzCore/CAMetalLayer.h>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/darwin/cf_utils.h"
@@ -29,10 +30,26 @@ class IOSContextMetal final : public IOSContext {
 
   sk_sp<GrDirectContext> GetResourceContext() const;
 
+  // |IOSContext|
+  bool BeginDeferringPresents() override;
+
+  // |IOSContext|
+  fml::closure EndDeferringPresents() override;
+
+  // Whether the drawables the surfaces present are kept until
+  // |EndDeferringPresents|.
+  bool IsDeferringPresents() const;
+
+  // Keeps the drawable to be presented by the closure |EndDeferringPresents|
+  // returns.
+  void DeferPresent(id<CAMetalDrawable> drawable);
+
  private:
   fml::scoped_nsobject<FlutterDarwinContextMetal> darwin_context_metal_;
   fml::scoped_nsprotocol<id<MTLCommandQueue>> main_command_queue_;
   fml::CFRef<CVMetalTextureCacheRef> texture_cache_;
+  // The drawables whose presents are deferred, or nil if presents aren't.
+  fml::scoped_nsobject<NSMutableArray> deferred_drawables_;
 
   // |IOSContext|
   sk_sp<GrDirectContext> CreateResourceContext() override;
@@ -50,6 +50,33 @@ sk_sp<GrDirectContext> IOSContextMetal::GetResourceContext() const {
   return darwin_context_metal_.get().resourceContext;
 }
 
+// |IOSContext|
+bool IOSContextMetal::BeginDeferringPresents() {
+  FML_DCHECK(!deferred_drawables_);
+  deferred_drawables_.reset([[NSMutableArray alloc] init]);
+  return true;
+}
+
+// |IOSContext|
+fml::closure IOSContextMetal::EndDeferringPresents() {
+  fml::scoped_nsobject<NSMutableArray> drawables(deferred_drawables_);
+  deferred_drawables_.reset();
+  return [drawables]() {
+    for (id<CAMetalDrawable> drawable in drawables.get()) {
+      [drawable present];
+    }
+  };
+}
+
+bool IOSContextMetal::IsDeferringPresents() const {
+  return deferred_drawables_.get() != nil;
+}
+
+void IOSContextMetal::DeferPresent(id<CAMetalDrawable> drawable) {
+  FML_DCHECK(deferred_drawables_);
+  [deferred_drawables_.get() addObject:drawable];
+}
+
 // |IOSContext|
 sk_sp<GrDirectContext> IOSContextMetal::CreateResourceContext() {
   return darwin_context_metal_.get().resourceContext;
@@ -92,4 +92,10 @@ bool IOSExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return true;
 }
 
+// |ExternalViewEmbedder|
+bool IOSExternalViewEmbedder::SupportsUnmergedSubmission() {
+  FML_CHECK(platform_views_controller_);
+  return platform_views_controller_->CompositesOnRasterThread();
+}
+
 }  // namespace flutter
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_IMAGE_GENERATOR_H_
+#define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_IMAGE_GENERATOR_H_
+
+#include <ImageIO/ImageIO.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/platform/darwin/cf_utils.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+/// @brief  Decodes JPEG and HEIF images, such as the photos of the camera,
+///         with ImageIO, which uses the hardware decoders of the device.
+///
+///         The images are oriented and scaled to the requested size while
+///         they are decoded.
+class IOSImageGenerator : public ImageGenerator {
+ public:
+  ~IOSImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(unsigned int frame_index) const override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index = 0,
+                 std::optional<unsigned int> prior_frame = std::nullopt) override;
+
+  /// @brief  Creates a generator for the data, or returns null if it isn't a
+  ///         JPEG or HEIF image.
+  static std::shared_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  IOSImageGenerator(sk_sp<SkData> data,
+                    fml::CFRef<CGImageSourceRef> source,
+                    const SkImageInfo& image_info);
+
+  // The source reads the bytes of the data without copying them.
+  const sk_sp<SkData> data_;
+  const fml::CFRef<CGImageSourceRef> source_;
+  const SkImageInfo image_info_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(IOSImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_IMAGE_GENERATOR_H_
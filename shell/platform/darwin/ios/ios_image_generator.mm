@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/ios/ios_image_generator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/size.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IOSImageGenerator::IOSImageGenerator(sk_sp<SkData> data,
+                                     fml::CFRef<CGImageSourceRef> source,
+                                     const SkImageInfo& image_info)
+    : data_(std::move(data)), source_(std::move(source)), image_info_(image_info) {}
+
+IOSImageGenerator::~IOSImageGenerator() = default;
+
+const SkImageInfo& IOSImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int IOSImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int IOSImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo IOSImageGenerator::GetFrameInfo(unsigned int frame_index) const {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize IOSImageGenerator::GetScaledDimensions(float desired_scale) {
+  // ImageIO scales JPEGs while decoding them, so any size is efficient.
+  if (desired_scale >= 1) {
+    return image_info_.dimensions();
+  }
+  return SkISize::Make(
+      std::max(1, static_cast<int>(std::round(image_info_.width() * desired_scale))),
+      std::max(1, static_cast<int>(std::round(image_info_.height() * desired_scale))));
+}
+
+bool IOSImageGenerator::GetPixels(const SkImageInfo& info,
+                                  void* pixels,
+                                  size_t row_bytes,
+                                  unsigned int frame_index,
+                                  std::optional<unsigned int> prior_frame) {
+  TRACE_EVENT0("flutter", "IOSImageGenerator::GetPixels");
+  if (info.colorType() != kRGBA_8888_SkColorType ||
+      (info.alphaType() != kPremul_SkAlphaType && info.alphaType() != image_info_.alphaType())) {
+    return false;
+  }
+
+  // Thumbnails are decoded at the largest size the decoder can efficiently
+  // produce, with the EXIF orientation applied.
+  const int max_pixel_size = std::max(info.width(), info.height());
+  fml::CFRef<CFNumberRef> max_pixel_size_number(
+      CFNumberCreate(kCFAllocatorDefault, kCFNumberIntType, &max_pixel_size));
+  const void* keys[] = {
+      kCGImageSourceCreateThumbnailFromImageAlways,
+      kCGImageSourceCreateThumbnailWithTransform,
+      kCGImageSourceShouldCacheImmediately,
+      kCGImageSourceThumbnailMaxPixelSize,
+  };
+  const void* values[] = {
+      kCFBooleanTrue,
+      kCFBooleanTrue,
+      kCFBooleanTrue,
+      max_pixel_size_number,
+  };
+  fml::CFRef<CFDictionaryRef> options(
+      CFDictionaryCreate(kCFAllocatorDefault, keys, values, fml::size(keys),
+                         &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks));
+  fml::CFRef<CGImageRef> image(CGImageSourceCreateThumbnailAtIndex(source_, 0, options));
+  if (!image) {
+    FML_DLOG(ERROR) << "Could not decode the image with ImageIO.";
+    return false;
+  }
+
+  fml::CFRef<CGColorSpaceRef> color_space(CGColorSpaceCreateWithName(kCGColorSpaceSRGB));
+  fml::CFRef<CGContextRef> context(
+      CGBitmapContextCreate(pixels, info.width(), info.height(), 8, row_bytes, color_space,
+                            kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big));
+  if (!context) {
+    return false;
+  }
+  CGContextSetBlendMode(context, kCGBlendModeCopy);
+  CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+  CGContextDrawImage(context, CGRectMake(0, 0, info.width(), info.height()), image);
+  return true;
+}
+
+static bool IsSupportedType(CFStringRef type) {
+  // The other formats are mostly small images, or animated, which the Skia
+  // codecs decode as well.
+  return type && (CFStringCompare(type, CFSTR("public.jpeg"), 0) == kCFCompareEqualTo ||
+                  CFStringCompare(type, CFSTR("public.heic"), 0) == kCFCompareEqualTo ||
+                  CFStringCompare(type, CFSTR("public.heif"), 0) == kCFCompareEqualTo);
+}
+
+static int GetIntProperty(CFDictionaryRef properties, CFStringRef key, int default_value) {
+  auto number = static_cast<CFNumberRef>(CFDictionaryGetValue(properties, key));
+  int value = default_value;
+  if (!number || !CFNumberGetValue(number, kCFNumberIntType, &value)) {
+    return default_value;
+  }
+  return value;
+}
+
+std::shared_ptr<ImageGenerator> IOSImageGenerator::MakeFromData(sk_sp<SkData> data) {
+  if (!data || data->size() == 0) {
+    return nullptr;
+  }
+
+  fml::CFRef<CFDataRef> cf_data(CFDataCreateWithBytesNoCopy(
+      kCFAllocatorDefault, data->bytes(), data->size(), kCFAllocatorNull));
+  fml::CFRef<CGImageSourceRef> source(CGImageSourceCreateWithData(cf_data, nullptr));
+  if (!source || !IsSupportedType(CGImageSourceGetType(source))) {
+    return nullptr;
+  }
+
+  // Only the header is read until the image is decoded.
+  fml::CFRef<CFDictionaryRef> properties(CGImageSourceCopyPropertiesAtIndex(source, 0, nullptr));
+  if (!properties) {
+    return nullptr;
+  }
+  int width = GetIntProperty(properties, kCGImagePropertyPixelWidth, 0);
+  int height = GetIntProperty(properties, kCGImagePropertyPixelHeight, 0);
+  // The EXIF orientations 5 to 8 rotate the image by 90 degrees.
+  if (GetIntProperty(properties, kCGImagePropertyOrientation, 1) >= 5) {
+    std::swap(width, height);
+  }
+  const bool has_alpha =
+      CFDictionaryGetValue(properties, kCGImagePropertyHasAlpha) == kCFBooleanTrue;
+  const SkImageInfo image_info =
+      SkImageInfo::Make(width, height, kRGBA_8888_SkColorType,
+                        has_alpha ? kPremul_SkAlphaType : kOpaque_SkAlphaType);
+  if (image_info.isEmpty()) {
+    return nullptr;
+  }
+
+  return std::shared_ptr<IOSImageGenerator>(
+      new IOSImageGenerator(std::move(data), std::move(source), image_info));
+}
+
+}  // namespace flutter
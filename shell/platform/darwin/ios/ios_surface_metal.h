@@ -27,6 +27,9 @@ class SK_API_AVAILABLE_CA_METAL_LAYER IOSSurfaceMetal final : public IOSSurface,
   id<MTLDevice> device_;
   id<MTLCommandQueue> command_queue_;
   bool is_valid_ = false;
+  // The number of drawables the layer may have in flight, or 0 for the default of the system.
+  NSUInteger maximum_drawable_count_ = 0;
+  bool defers_drawable_acquisition_ = false;
 
   // |IOSSurface|
   bool IsValid() const override;
@@ -52,6 +55,9 @@ class SK_API_AVAILABLE_CA_METAL_LAYER IOSSurfaceMetal final : public IOSSurface,
   // |GPUSurfaceMetalDelegate|
   bool AllowsDrawingWhenGpuDisabled() const override;
 
+  // |GPUSurfaceMetalDelegate|
+  bool DefersDrawableAcquisition() const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(IOSSurfaceMetal);
 };
 
@@ -24,6 +24,23 @@ IOSSurfaceMetal::IOSSurfaceMetal(fml::scoped_nsobject<CAMetalLayer> layer,
   auto darwin_context = metal_context->GetDarwinContext().get();
   command_queue_ = darwin_context.commandQueue;
   device_ = darwin_context.device;
+
+  // CAMetalLayer only supports keeping 2 or 3 drawables in flight.
+  NSBundle* mainBundle = [NSBundle mainBundle];
+  NSNumber* maximumDrawableCount =
+      [mainBundle objectForInfoDictionaryKey:@"FLTMetalMaximumDrawableCount"];
+  if (maximumDrawableCount != nil) {
+    if (maximumDrawableCount.unsignedIntegerValue == 2 ||
+        maximumDrawableCount.unsignedIntegerValue == 3) {
+      maximum_drawable_count_ = maximumDrawableCount.unsignedIntegerValue;
+    } else {
+      FML_LOG(ERROR) << "FLTMetalMaximumDrawableCount must be 2 or 3.";
+    }
+  }
+  NSNumber* defersDrawableAcquisition =
+      [mainBundle objectForInfoDictionaryKey:@"FLTMetalDefersDrawableAcquisition"];
+  defers_drawable_acquisition_ =
+      (defersDrawableAcquisition != nil) ? defersDrawableAcquisition.boolValue : false;
 }
 
 // |IOSSurface|
@@ -64,8 +81,16 @@ GPUCAMetalLayerHandle IOSSurfaceMetal::GetCAMetalLayer(const SkISize& frame_info
 
   // When there are platform views in the scene, the drawable needs to be presented in the same
   // transaction as the one created for platform views. When the drawable are being presented from
-  // the raster thread, there is no such transaction.
-  layer.presentsWithTransaction = [[NSThread currentThread] isMainThread];
+  // the raster thread, there is no such transaction, unless the platform thread presents them later
+  // with the transaction that updates the platform views.
+  layer.presentsWithTransaction = [[NSThread currentThread] isMainThread] ||
+                                  CastToMetalContext(GetContext())->IsDeferringPresents();
+
+  if (maximum_drawable_count_ != 0) {
+    if (@available(iOS 11.2, *)) {
+      layer.maximumDrawableCount = maximum_drawable_count_;
+    }
+  }
 
   return layer;
 }
@@ -82,6 +107,11 @@ bool IOSSurfaceMetal::PresentDrawable(GrMTLHandle drawable) const {
   [command_buffer.get() commit];
   [command_buffer.get() waitUntilScheduled];
 
+  auto metal_context = CastToMetalContext(GetContext());
+  if (metal_context->IsDeferringPresents()) {
+    metal_context->DeferPresent(reinterpret_cast<id<CAMetalDrawable>>(drawable));
+    return true;
+  }
   [reinterpret_cast<id<CAMetalDrawable>>(drawable) present];
   return true;
 }
@@ -103,4 +133,9 @@ bool IOSSurfaceMetal::AllowsDrawingWhenGpuDisabled() const {
   return false;
 }
 
+// |GPUSurfaceMetalDelegate|
+bool IOSSurfaceMetal::DefersDrawableAcquisition() const {
+  return defers_drawable_acquisition_;
+}
+
 }  // namespace flutter
@@ -15,11 +15,18 @@ bool IOSSwitchableGLContext::SetCurrent() {
   FML_DCHECK(context_ != nullptr);
   EAGLContext* current_context = EAGLContext.currentContext;
   previous_context_ = current_context;
+  // Switching to the context that is already current still flushes it.
+  if (current_context == context_) {
+    return true;
+  }
   return [EAGLContext setCurrentContext:context_];
 };
 
 bool IOSSwitchableGLContext::RemoveCurrent() {
   FML_DCHECK_CREATION_THREAD_IS_CURRENT(checker);
+  if (EAGLContext.currentContext == previous_context_) {
+    return true;
+  }
   return [EAGLContext setCurrentContext:previous_context_];
 };
 }
@@ -59,6 +59,9 @@ class PlatformViewIOS final : public PlatformView {
    */
   PlatformMessageRouter& GetPlatformMessageRouter();
 
+  // |PlatformView|
+  std::shared_ptr<PlatformMessageHandler> GetPlatformMessageHandler() const override;
+
   /**
    * Returns the `FlutterViewController` currently attached to the `FlutterEngine` owning
    * this PlatformViewIOS.
@@ -139,7 +142,7 @@ class PlatformViewIOS final : public PlatformView {
   std::unique_ptr<IOSSurface> ios_surface_;
   std::shared_ptr<IOSContext> ios_context_;
   const std::shared_ptr<FlutterPlatformViewsController>& platform_views_controller_;
-  PlatformMessageRouter platform_message_router_;
+  std::shared_ptr<PlatformMessageRouter> platform_message_router_;
   AccessibilityBridgePtr accessibility_bridge_;
   fml::scoped_nsprotocol<FlutterTextInputPlugin*> text_input_plugin_;
   fml::closure firstFrameCallback_;
@@ -53,6 +53,8 @@ PlatformViewIOS::PlatformViewIOS(
     : PlatformView(delegate, std::move(task_runners)),
       ios_context_(context),
       platform_views_controller_(platform_views_controller),
+      platform_message_router_(
+          std::make_shared<PlatformMessageRouter>(task_runners_.GetPlatformTaskRunner())),
       accessibility_bridge_([this](bool enabled) { PlatformView::SetSemanticsEnabled(enabled); }) {}
 
 PlatformViewIOS::PlatformViewIOS(
@@ -68,12 +70,17 @@ PlatformViewIOS::PlatformViewIOS(
 PlatformViewIOS::~PlatformViewIOS() = default;
 
 PlatformMessageRouter& PlatformViewIOS::GetPlatformMessageRouter() {
+  return *platform_message_router_;
+}
+
+// |PlatformView|
+std::shared_ptr<PlatformMessageHandler> PlatformViewIOS::GetPlatformMessageHandler() const {
   return platform_message_router_;
 }
 
 // |PlatformView|
 void PlatformViewIOS::HandlePlatformMessage(std::unique_ptr<flutter::PlatformMessage> message) {
-  platform_message_router_.HandlePlatformMessage(std::move(message));
+  platform_message_router_->HandlePlatformMessage(std::move(message));
 }
 
 fml::WeakPtr<FlutterViewController> PlatformViewIOS::GetOwnerViewController() const {
@@ -62,6 +62,47 @@
 
 @end
 
+@interface TestPooledExternalTexture : NSObject <FlutterTexture>
+
+- (nonnull instancetype)initWidth:(size_t)width
+                           height:(size_t)height
+                  pixelFormatType:(OSType)pixelFormatType;
+
+@property(nonatomic, readonly) NSUInteger copyCount;
+
+@end
+
+@implementation TestPooledExternalTexture {
+  CVPixelBufferRef _pixelBuffer;
+}
+
+- (nonnull instancetype)initWidth:(size_t)width
+                           height:(size_t)height
+                  pixelFormatType:(OSType)pixelFormatType {
+  if (self = [super init]) {
+    NSDictionary* options = @{
+      (NSString*)kCVPixelBufferMetalCompatibilityKey : @YES,
+      (NSString*)kCVPixelBufferIOSurfacePropertiesKey : @{},
+    };
+    CVReturn status = CVPixelBufferCreate(kCFAllocatorDefault, width, height, pixelFormatType,
+                                          (__bridge CFDictionaryRef)options, &_pixelBuffer);
+    NSAssert(status == kCVReturnSuccess && _pixelBuffer != NULL, @"Failed to create pixel buffer.");
+  }
+  return self;
+}
+
+- (void)dealloc {
+  CVPixelBufferRelease(_pixelBuffer);
+}
+
+// Hands out the same IOSurface-backed buffer every frame, like a pool that cycles one buffer.
+- (CVPixelBufferRef)copyPixelBuffer {
+  _copyCount++;
+  return CVPixelBufferRetain(_pixelBuffer);
+}
+
+@end
+
 namespace flutter::testing {
 
 TEST(FlutterEmbedderExternalTextureUnittests, TestTextureResolution) {
@@ -262,4 +303,52 @@ TEST(FlutterEmbedderExternalTextureUnittests, TestPopulateExternalTextureYUVA2)
   gpuSurface->makeImageSnapshot();
 }
 
+TEST(FlutterEmbedderExternalTextureUnittests, TestPaintPooledIOSurfaceTextureYUVA) {
+  // Constants.
+  const size_t width = 100;
+  const size_t height = 100;
+  const int64_t texture_id = 1;
+
+  // Set up the surface.
+  FlutterDarwinContextMetal* darwinContextMetal =
+      [[FlutterDarwinContextMetal alloc] initWithDefaultMTLDevice];
+  SkImageInfo info = SkImageInfo::MakeN32Premul(width, height);
+  GrDirectContext* grContext = darwinContextMetal.mainContext.get();
+  sk_sp<SkSurface> gpuSurface(SkSurface::MakeRenderTarget(grContext, SkBudgeted::kNo, info));
+
+  // Create a texture whose frames all come from the same IOSurface.
+  TestPooledExternalTexture* testExternalTexture =
+      [[TestPooledExternalTexture alloc] initWidth:width
+                                            height:height
+                                   pixelFormatType:kCVPixelFormatType_420YpCbCr8BiPlanarFullRange];
+  FlutterDarwinExternalTextureMetal* texture =
+      [darwinContextMetal createExternalTextureWithIdentifier:texture_id
+                                                      texture:testExternalTexture];
+  ASSERT_TRUE(texture != nil);
+
+  // Render a few frames, which reuse the textures of the surface.
+  SkRect bounds = SkRect::MakeWH(info.width(), info.height());
+  SkSamplingOptions sampling = SkSamplingOptions(SkFilterMode::kNearest);
+  for (int frame = 0; frame < 3; frame++) {
+    [texture markNewFrameAvailable];
+    [texture paint:*gpuSurface->getCanvas()
+            bounds:bounds
+            freeze:NO
+         grContext:grContext
+          sampling:sampling];
+  }
+  EXPECT_EQ(testExternalTexture.copyCount, 3u);
+
+  // A frozen texture keeps showing the last frame without asking for a new one.
+  [texture markNewFrameAvailable];
+  [texture paint:*gpuSurface->getCanvas()
+          bounds:bounds
+          freeze:YES
+       grContext:grContext
+        sampling:sampling];
+  EXPECT_EQ(testExternalTexture.copyCount, 3u);
+
+  gpuSurface->makeImageSnapshot();
+}
+
 }  // namespace flutter::testing
@@ -5,6 +5,7 @@
 #define FML_USED_ON_EMBEDDER
 #define RAPIDJSON_HAS_STDSTRING 1
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -44,6 +45,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/runtime/startup_timings.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -51,6 +53,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
+#include "flutter/shell/platform/embedder/embedder_ring_buffer.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
 #include "flutter/shell/platform/embedder/embedder_task_runner.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
@@ -118,8 +121,8 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+  if (!SAFE_EXISTS_ONE_OF(software_config, surface_present_callback,
+                          surface_present_with_info_callback)) {
     return false;
   }
 
@@ -183,7 +186,8 @@ InferOpenGLPlatformViewCreationCallback(
     flutter::PlatformViewEmbedder::PlatformDispatchTable
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+        external_view_embedder,
+    flutter::EmbedderEngine* spawner) {
 #ifdef SHELL_ENABLE_GL
   if (config->type != kOpenGL) {
     return nullptr;
@@ -195,18 +199,32 @@ InferOpenGLPlatformViewCreationCallback(
   auto gl_clear_current = [ptr = config->open_gl.clear_current,
                            user_data]() -> bool { return ptr(user_data); };
 
-  auto gl_present = [present = config->open_gl.present,
-                     present_with_info = config->open_gl.present_with_info,
-                     user_data](uint32_t fbo_id) -> bool {
-    if (present) {
-      return present(user_data);
-    } else {
-      FlutterPresentInfo present_info = {};
-      present_info.struct_size = sizeof(FlutterPresentInfo);
-      present_info.fbo_id = fbo_id;
-      return present_with_info(user_data, &present_info);
-    }
-  };
+  auto gl_present =
+      [present = config->open_gl.present,
+       present_with_info = config->open_gl.present_with_info,
+       user_data](flutter::GLPresentInfo gl_present_info) -> bool {
+        if (present) {
+          return present(user_data);
+        } else {
+          std::vector<FlutterRect> damage_rects;
+          if (gl_present_info.frame_damage) {
+            for (const SkIRect& irect : *gl_present_info.frame_damage) {
+              SkRect rect = SkRect::Make(irect);
+              damage_rects.push_back(
+                  {rect.left(), rect.top(), rect.right(), rect.bottom()});
+            }
+          }
+          FlutterPresentInfo present_info = {};
+          present_info.struct_size = sizeof(FlutterPresentInfo);
+          present_info.fbo_id = gl_present_info.fbo_id;
+          present_info.frame_damage.struct_size = sizeof(FlutterDamage);
+          if (gl_present_info.frame_damage) {
+            present_info.frame_damage.num_rects = damage_rects.size();
+            present_info.frame_damage.damage = damage_rects.data();
+          }
+          return present_with_info(user_data, &present_info);
+        }
+      };
 
   auto gl_fbo_callback =
       [fbo_callback = config->open_gl.fbo_callback,
@@ -269,9 +287,40 @@ InferOpenGLPlatformViewCreationCallback(
 #endif
   }
 
+  std::function<std::optional<SkIRect>(intptr_t)>
+      gl_populate_existing_damage = nullptr;
+  if (SAFE_ACCESS(open_gl_config, populate_existing_damage, nullptr) !=
+      nullptr) {
+    gl_populate_existing_damage =
+        [ptr = config->open_gl.populate_existing_damage,
+         user_data](intptr_t fbo_id) -> std::optional<SkIRect> {
+      FlutterDamage existing_damage = {};
+      existing_damage.struct_size = sizeof(FlutterDamage);
+      ptr(user_data, fbo_id, &existing_damage);
+      if (existing_damage.num_rects == 0 || !existing_damage.damage) {
+        return std::nullopt;
+      }
+      SkIRect damage = SkIRect::MakeEmpty();
+      for (size_t i = 0; i < existing_damage.num_rects; i++) {
+        const FlutterRect& rect = existing_damage.damage[i];
+        damage.join(SkRect::MakeLTRB(rect.left, rect.top, rect.right,
+                                     rect.bottom)
+                        .roundOut());
+      }
+      return damage;
+    };
+  }
+
   bool fbo_reset_after_present =
       SAFE_ACCESS(open_gl_config, fbo_reset_after_present, false);
 
+  // Engines spawned from one another that render with the same OpenGL context
+  // may share their Skia context. The context of the spawner is only known
+  // once the platform view is created, as the spawner must be running by then.
+  bool share_skia_context_with_spawner =
+      spawner != nullptr &&
+      SAFE_ACCESS(open_gl_config, share_skia_context_with_spawner, false);
+
   flutter::EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table = {
       gl_make_current,                     // gl_make_current_callback
       gl_clear_current,                    // gl_clear_current_callback
@@ -280,19 +329,35 @@ InferOpenGLPlatformViewCreationCallback(
       gl_make_resource_current_callback,   // gl_make_resource_current_callback
       gl_surface_transformation_callback,  // gl_surface_transformation_callback
       gl_proc_resolver,                    // gl_proc_resolver
+      gl_populate_existing_damage,         // gl_populate_existing_damage
   };
 
   return fml::MakeCopyable(
       [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
-       external_view_embedder =
-           std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+       external_view_embedder = std::move(external_view_embedder),
+       spawner = share_skia_context_with_spawner ? spawner : nullptr](
+          flutter::Shell& shell) mutable {
+        std::shared_ptr<flutter::EmbedderSurfaceGL::SharedSkiaContext>
+            shared_skia_context;
+        if (spawner != nullptr && spawner->IsValid()) {
+          if (auto spawner_view = spawner->GetShell().GetPlatformView()) {
+            shared_skia_context =
+                static_cast<flutter::PlatformViewEmbedder*>(spawner_view.get())
+                    ->GetSharedSkiaContext();
+          }
+        }
+        if (!shared_skia_context) {
+          shared_skia_context = std::make_shared<
+              flutter::EmbedderSurfaceGL::SharedSkiaContext>();
+        }
         return std::make_unique<flutter::PlatformViewEmbedder>(
             shell,                    // delegate
             shell.GetTaskRunners(),   // task runners
             gl_dispatch_table,        // embedder GL dispatch table
             fbo_reset_after_present,  // fbo reset after present
             platform_dispatch_table,  // embedder platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            std::move(external_view_embedder),  // external view embedder
+            std::move(shared_skia_context)      // shared Skia context
         );
       });
 #else
@@ -381,9 +446,36 @@ InferSoftwarePlatformViewCreationCallback(
   }
 
   auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
+      [present = config->software.surface_present_callback,
+       present_with_info = SAFE_ACCESS(&config->software,
+                                       surface_present_with_info_callback,
+                                       nullptr),
+       user_data](const flutter::EmbedderSurfaceSoftware::SoftwarePresentInfo&
+                      software_present_info) -> bool {
+    if (present) {
+      return present(user_data, software_present_info.allocation,
+                     software_present_info.row_bytes,
+                     software_present_info.height);
+    }
+    std::vector<FlutterRect> damage_rects;
+    if (software_present_info.frame_damage) {
+      for (const SkIRect& irect : *software_present_info.frame_damage) {
+        SkRect rect = SkRect::Make(irect);
+        damage_rects.push_back(
+            {rect.left(), rect.top(), rect.right(), rect.bottom()});
+      }
+    }
+    FlutterSoftwarePresentInfo present_info = {};
+    present_info.struct_size = sizeof(FlutterSoftwarePresentInfo);
+    present_info.allocation = software_present_info.allocation;
+    present_info.row_bytes = software_present_info.row_bytes;
+    present_info.height = software_present_info.height;
+    present_info.frame_damage.struct_size = sizeof(FlutterDamage);
+    if (software_present_info.frame_damage) {
+      present_info.frame_damage.num_rects = damage_rects.size();
+      present_info.frame_damage.damage = damage_rects.data();
+    }
+    return present_with_info(user_data, &present_info);
   };
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
@@ -412,7 +504,8 @@ InferPlatformViewCreationCallback(
     flutter::PlatformViewEmbedder::PlatformDispatchTable
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+        external_view_embedder,
+    flutter::EmbedderEngine* spawner) {
   if (config == nullptr) {
     return nullptr;
   }
@@ -421,7 +514,7 @@ InferPlatformViewCreationCallback(
     case kOpenGL:
       return InferOpenGLPlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder));
+          std::move(external_view_embedder), spawner);
     case kSoftware:
       return InferSoftwarePlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
@@ -692,6 +785,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  bool merge_non_overlapping_layers =
+      SAFE_ACCESS(compositor, merge_non_overlapping_layers, false);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -718,8 +813,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       };
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
+              avoid_backing_store_cache, merge_non_overlapping_layers,
+              create_render_target_callback, present_callback),
           false};
 }
 
@@ -1009,6 +1104,21 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
 
+  settings.raster_cache_max_bytes =
+      SAFE_ACCESS(args, raster_cache_max_bytes, 0);
+
+  switch (SAFE_ACCESS(args, frame_pacing_policy,
+                      kFlutterFramePacingPolicyDefault)) {
+    case kFlutterFramePacingPolicyLowLatency:
+      settings.frame_pacing_policy = flutter::FramePacingPolicy::kLowLatency;
+      break;
+    case kFlutterFramePacingPolicySmooth:
+      settings.frame_pacing_policy = flutter::FramePacingPolicy::kSmooth;
+      break;
+    case kFlutterFramePacingPolicyDefault:
+      break;
+  }
+
   flutter::PlatformViewEmbedder::UpdateSemanticsNodesCallback
       update_semantics_nodes_callback = nullptr;
   if (SAFE_ACCESS(args, update_semantics_node_callback, nullptr) != nullptr) {
@@ -1193,9 +1303,32 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           on_pre_engine_restart_callback,             //
       };
 
+  auto spawner = reinterpret_cast<flutter::EmbedderEngine*>(
+      SAFE_ACCESS(args, spawner, nullptr));
+  if (spawner != nullptr) {
+    if (!spawner->IsValid()) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "The engine to spawn from was not running.");
+    }
+    if (SAFE_ACCESS(args, custom_task_runners, nullptr) != nullptr) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "Spawned engines use the task runners of the engine they are "
+          "spawned from, but custom task runners were specified.");
+    }
+  }
+
+  if (spawner == nullptr && config->type == kOpenGL &&
+      SAFE_ACCESS(&config->open_gl, share_skia_context_with_spawner, false)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The OpenGL renderer config specified that the Skia context be shared "
+        "with the spawner, but no engine to spawn from was specified.");
+  }
+
   auto on_create_platform_view = InferPlatformViewCreationCallback(
       config, user_data, platform_dispatch_table,
-      std::move(external_view_embedder_result.first));
+      std::move(external_view_embedder_result.first), spawner);
 
   if (!on_create_platform_view) {
     return LOG_EMBEDDER_ERROR(
@@ -1230,9 +1363,11 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
         }
         return texture;
       };
-      external_texture_resolver =
-          std::make_unique<ExternalTextureResolver>(external_texture_callback);
     }
+    // Without the callback, the textures only show the frames that the
+    // embedder pushes to them.
+    external_texture_resolver =
+        std::make_unique<ExternalTextureResolver>(external_texture_callback);
   }
 #endif
 #ifdef SHELL_ENABLE_METAL
@@ -1259,9 +1394,13 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   }
 #endif
 
-  auto thread_host =
-      flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          SAFE_ACCESS(args, custom_task_runners, nullptr));
+  // Spawned engines share the threads of their spawner.
+  std::shared_ptr<flutter::EmbedderThreadHost> thread_host =
+      spawner != nullptr
+          ? spawner->GetThreadHost()
+          : flutter::EmbedderThreadHost::
+                CreateEmbedderOrEngineManagedThreadHost(
+                    SAFE_ACCESS(args, custom_task_runners, nullptr));
 
   if (!thread_host || !thread_host->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
@@ -1308,13 +1447,14 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   // Create the engine but don't launch the shell or run the root isolate.
   auto embedder_engine = std::make_unique<flutter::EmbedderEngine>(
-      std::move(thread_host),               //
-      std::move(task_runners),              //
-      std::move(settings),                  //
-      std::move(run_configuration),         //
-      on_create_platform_view,              //
-      on_create_rasterizer,                 //
-      std::move(external_texture_resolver)  //
+      std::move(thread_host),                //
+      std::move(task_runners),               //
+      std::move(settings),                   //
+      std::move(run_configuration),          //
+      on_create_platform_view,               //
+      on_create_rasterizer,                  //
+      std::move(external_texture_resolver),  //
+      spawner                                //
   );
 
   // Release the ownership of the embedder engine to the caller.
@@ -1633,9 +1773,12 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "running Flutter application.");
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
+// Sends the message with a copy of its data, or with the data itself if the
+// ownership of the data was handed over.
+static FlutterEngineResult InternalSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
+    const FlutterPlatformMessage* flutter_message,
+    fml::MallocMapping* owned_message_data) {
   if (engine == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
   }
@@ -1673,7 +1816,10 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
   } else {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel,
-        fml::MallocMapping::Copy(message_data, message_size), response);
+        owned_message_data
+            ? std::move(*owned_message_data)
+            : fml::MallocMapping::Copy(message_data, message_size),
+        response);
   }
 
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
@@ -1684,6 +1830,28 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  return InternalSendPlatformMessage(engine, flutter_message, nullptr);
+}
+
+FlutterEngineResult FlutterEngineSendOwnedPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  // The data is owned from here on, so that it's released if the message
+  // can't be sent.
+  fml::MallocMapping message_data(
+      flutter_message == nullptr
+          ? nullptr
+          : const_cast<uint8_t*>(
+                SAFE_ACCESS(flutter_message, message, nullptr)),
+      flutter_message == nullptr
+          ? 0
+          : SAFE_ACCESS(flutter_message, message_size, 0));
+  return InternalSendPlatformMessage(engine, flutter_message, &message_data);
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -1823,6 +1991,33 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEnginePushExternalTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterExternalTextureFrame* frame) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+  if (texture_identifier == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid texture identifier.");
+  }
+  if (frame == nullptr || !STRUCT_HAS_MEMBER(frame, fence)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid frame.");
+  }
+  if (frame->type != kOpenGL) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Only OpenGL frames can be pushed to external textures.");
+  }
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->PushTextureFrame(texture_identifier, *frame)) {
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not push the frame to the specified texture.");
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineUpdateSemanticsEnabled(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     bool enabled) {
@@ -1966,6 +2161,31 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "Could not run the specified task.");
 }
 
+FlutterEngineResult FlutterEngineRunExpiredTasks(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    uint64_t* next_task_target_time_nanos) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  auto next_target_time = fml::TimePoint::Max();
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->RunExpiredTasks(
+          task_runner, &next_target_time)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Could not run the expired tasks of the specified task runner.");
+  }
+
+  if (next_task_target_time_nanos != nullptr) {
+    *next_task_target_time_nanos =
+        next_target_time == fml::TimePoint::Max()
+            ? UINT64_MAX
+            : next_target_time.ToEpochDelta().ToNanoseconds();
+  }
+  return kSuccess;
+}
+
 static bool DispatchJSONPlatformMessage(FLUTTER_API_SYMBOL(FlutterEngine)
                                             engine,
                                         rapidjson::Document document,
@@ -2186,6 +2406,123 @@ FlutterEngineResult FlutterEnginePostDartObject(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer_out) {
+  if (engine == nullptr ||
+      !reinterpret_cast<flutter::EmbedderEngine*>(engine)->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (port == ILLEGAL_PORT) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Attempted to post to an illegal port.");
+  }
+
+  if (capacity == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The ring buffer capacity must not be zero.");
+  }
+
+  if (ring_buffer_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Ring buffer out parameter was null.");
+  }
+
+  auto ring_buffer = fml::MakeRefCounted<flutter::EmbedderRingBuffer>(
+      capacity, [port]() { Dart_PostInteger(port, 0); });
+
+  // The Dart isolate holds a reference to the ring buffer for as long as it
+  // references its bytes.
+  Dart_CObject data = {};
+  data.type = Dart_CObject_kExternalTypedData;
+  data.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+  data.value.as_external_typed_data.length = ring_buffer->GetCapacity();
+  data.value.as_external_typed_data.data = ring_buffer->GetData();
+  data.value.as_external_typed_data.peer = ring_buffer.get();
+  data.value.as_external_typed_data.callback =
+      +[](void* unused_isolate_callback_data, void* peer) {
+        reinterpret_cast<flutter::EmbedderRingBuffer*>(peer)->Release();
+      };
+
+  Dart_CObject address = {};
+  address.type = Dart_CObject_kInt64;
+  address.value.as_int64 = reinterpret_cast<int64_t>(ring_buffer.get());
+
+  Dart_CObject* values[] = {&data, &address};
+  Dart_CObject message = {};
+  message.type = Dart_CObject_kArray;
+  message.value.as_array.length = 2;
+  message.value.as_array.values = values;
+
+  ring_buffer->AddRef();
+  if (!Dart_PostCObject(port, &message)) {
+    ring_buffer->Release();
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not post the ring buffer to the Dart VM.");
+  }
+
+  // The embedder's reference is released by FlutterEngineCollectRingBuffer.
+  ring_buffer->AddRef();
+  *ring_buffer_out =
+      reinterpret_cast<FlutterEngineRingBuffer>(ring_buffer.get());
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    size_t* written_out) {
+  if (ring_buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Ring buffer was null.");
+  }
+
+  if (data == nullptr && size > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Data was null but its size wasn't zero.");
+  }
+
+  size_t written =
+      size == 0 ? 0
+                : reinterpret_cast<flutter::EmbedderRingBuffer*>(ring_buffer)
+                      ->Write(data, size);
+  if (written_out != nullptr) {
+    *written_out = written;
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FlutterEngineRingBuffer ring_buffer) {
+  if (ring_buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Ring buffer was null.");
+  }
+
+  reinterpret_cast<flutter::EmbedderRingBuffer*>(ring_buffer)->Release();
+  return kSuccess;
+}
+
+size_t FlutterEngineRingBufferAcquireRead(FlutterEngineRingBuffer ring_buffer,
+                                          size_t* offset_out) {
+  if (ring_buffer == nullptr || offset_out == nullptr) {
+    return 0;
+  }
+  return reinterpret_cast<flutter::EmbedderRingBuffer*>(ring_buffer)
+      ->AcquireRead(offset_out);
+}
+
+void FlutterEngineRingBufferReleaseRead(FlutterEngineRingBuffer ring_buffer,
+                                        size_t size) {
+  if (ring_buffer == nullptr) {
+    return;
+  }
+  reinterpret_cast<flutter::EmbedderRingBuffer*>(ring_buffer)
+      ->ReleaseRead(size);
+}
+
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) raw_engine) {
   auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
@@ -2265,27 +2602,217 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
 
   auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
 
+  flutter::DisplayUpdateType display_update_type;
   switch (update_type) {
-    case kFlutterEngineDisplaysUpdateTypeStartup: {
-      std::vector<flutter::Display> displays;
-      for (size_t i = 0; i < display_count; i++) {
-        flutter::Display display =
-            flutter::Display(embedder_displays[i].refresh_rate);
-        if (!embedder_displays[i].single_display) {
-          display = flutter::Display(embedder_displays[i].display_id,
-                                     embedder_displays[i].refresh_rate);
-        }
-        displays.push_back(display);
-      }
-      engine->GetShell().OnDisplayUpdates(flutter::DisplayUpdateType::kStartup,
-                                          displays);
-      return kSuccess;
-    }
+    case kFlutterEngineDisplaysUpdateTypeStartup:
+      display_update_type = flutter::DisplayUpdateType::kStartup;
+      break;
+    case kFlutterEngineDisplaysUpdateTypeConfigurationChanged:
+      display_update_type = flutter::DisplayUpdateType::kConfigurationChanged;
+      break;
     default:
       return LOG_EMBEDDER_ERROR(
           kInvalidArguments,
           "Invalid FlutterEngineDisplaysUpdateType type specified.");
   }
+
+  std::vector<flutter::Display> displays;
+  for (size_t i = 0; i < display_count; i++) {
+    flutter::Display display =
+        flutter::Display(embedder_displays[i].refresh_rate);
+    if (!embedder_displays[i].single_display) {
+      display = flutter::Display(embedder_displays[i].display_id,
+                                 embedder_displays[i].refresh_rate);
+    }
+    displays.push_back(display);
+  }
+  engine->GetShell().OnDisplayUpdates(display_update_type, displays);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSetIdleFrameRateLimit(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    double frames_per_second) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (!(frames_per_second >= 0)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The frame rate limit must not be negative.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->SetIdleFrameRateLimit(frames_per_second)) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not set the idle frame rate limit.");
+  }
+
+  return kSuccess;
+}
+
+static FlutterRasterCacheEntryType ToEmbedderEntryType(
+    flutter::RasterCacheEntryInfo::Type type) {
+  switch (type) {
+    case flutter::RasterCacheEntryInfo::Type::kPicture:
+      return kFlutterRasterCacheEntryTypePicture;
+    case flutter::RasterCacheEntryInfo::Type::kDisplayList:
+      return kFlutterRasterCacheEntryTypeDisplayList;
+    case flutter::RasterCacheEntryInfo::Type::kLayer:
+      return kFlutterRasterCacheEntryTypeLayer;
+  }
+  return kFlutterRasterCacheEntryTypePicture;
+}
+
+FlutterEngineResult FlutterEngineGetRasterCacheStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterRasterCacheStatisticsCallback callback,
+    void* user_data) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid raster cache statistics callback.");
+  }
+
+  auto& shell = engine->GetShell();
+  fml::TaskRunner::RunNowOrPostTask(
+      shell.GetTaskRunners().GetRasterTaskRunner(),
+      [rasterizer = shell.GetRasterizer(), callback, user_data]() {
+        if (!rasterizer) {
+          return;
+        }
+        const auto& raster_cache =
+            rasterizer->compositor_context()->raster_cache();
+        std::vector<FlutterRasterCacheEntry> entries;
+        for (const auto& info : raster_cache.GetEntryInfos()) {
+          FlutterRasterCacheEntry entry = {};
+          entry.struct_size = sizeof(FlutterRasterCacheEntry);
+          entry.type = ToEmbedderEntryType(info.type);
+          entry.size_in_bytes = info.bytes;
+          entry.access_count = info.access_count;
+          entry.age_in_frames = info.age;
+          entry.last_used_frame = info.last_used_frame;
+          entries.push_back(entry);
+        }
+        FlutterRasterCacheStatistics statistics = {};
+        statistics.struct_size = sizeof(FlutterRasterCacheStatistics);
+        statistics.frame = raster_cache.current_frame();
+        statistics.hit_count = raster_cache.total_hit_count();
+        statistics.miss_count = raster_cache.total_miss_count();
+        statistics.hit_ratio = raster_cache.GetHitRatio();
+        statistics.access_threshold = raster_cache.access_threshold();
+        statistics.cache_limit_per_frame =
+            raster_cache.picture_and_display_list_cache_limit_per_frame();
+        statistics.entry_count = entries.size();
+        statistics.entries = entries.data();
+        callback(&statistics, user_data);
+      });
+  return kSuccess;
+}
+
+static void SetStartupPhase(flutter::StartupTimings::Phase phase,
+                            FlutterEngineStartupPhase* embedder_phase) {
+  auto interval = flutter::StartupTimings::Get(phase);
+  if (!interval) {
+    *embedder_phase = {};
+    return;
+  }
+  embedder_phase->start_nanos = interval->start.ToEpochDelta().ToNanoseconds();
+  embedder_phase->end_nanos = interval->end.ToEpochDelta().ToNanoseconds();
+}
+
+FlutterEngineResult FlutterEngineGetStartupTimings(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterEngineStartupTimings* timings) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (timings == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid startup timings specified.");
+  }
+
+  using Phase = flutter::StartupTimings::Phase;
+  if (STRUCT_HAS_MEMBER(timings, vm_snapshot_mapping)) {
+    SetStartupPhase(Phase::kVMSnapshotMapping, &timings->vm_snapshot_mapping);
+  }
+  if (STRUCT_HAS_MEMBER(timings, isolate_snapshot_mapping)) {
+    SetStartupPhase(Phase::kIsolateSnapshotMapping,
+                    &timings->isolate_snapshot_mapping);
+  }
+  if (STRUCT_HAS_MEMBER(timings, vm_initialization)) {
+    SetStartupPhase(Phase::kVMInitialization, &timings->vm_initialization);
+  }
+  if (STRUCT_HAS_MEMBER(timings, root_isolate_creation)) {
+    SetStartupPhase(Phase::kRootIsolateCreation,
+                    &timings->root_isolate_creation);
+  }
+  if (STRUCT_HAS_MEMBER(timings, first_frame)) {
+    SetStartupPhase(Phase::kFirstFrame, &timings->first_frame);
+  }
+  if (STRUCT_HAS_MEMBER(timings, shell_creation)) {
+    SetStartupPhase(Phase::kShellCreation, &timings->shell_creation);
+  }
+  if (STRUCT_HAS_MEMBER(timings, first_layer_tree)) {
+    SetStartupPhase(Phase::kFirstLayerTree, &timings->first_layer_tree);
+  }
+  if (STRUCT_HAS_MEMBER(timings, first_raster)) {
+    SetStartupPhase(Phase::kFirstRaster, &timings->first_raster);
+  }
+  if (STRUCT_HAS_MEMBER(timings, first_present)) {
+    SetStartupPhase(Phase::kFirstPresent, &timings->first_present);
+  }
+  return kSuccess;
+}
+
+static FlutterFrameTimingPercentiles ToEmbedderPercentiles(
+    const flutter::FrameTimingPercentiles& percentiles) {
+  return {
+      .p50_nanos = static_cast<uint64_t>(percentiles.p50.ToNanoseconds()),
+      .p90_nanos = static_cast<uint64_t>(percentiles.p90.ToNanoseconds()),
+      .p99_nanos = static_cast<uint64_t>(percentiles.p99.ToNanoseconds()),
+      .max_nanos = static_cast<uint64_t>(percentiles.max.ToNanoseconds()),
+  };
+}
+
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterFrameTimingStatistics* statistics) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (statistics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame timing statistics specified.");
+  }
+
+  const flutter::FrameTimingSummary summary =
+      engine->GetShell().GetFrameTimingStatistics().GetSummary();
+  if (STRUCT_HAS_MEMBER(statistics, total_janky_frame_count)) {
+    statistics->frame_count = summary.frame_count;
+    statistics->frame_budget_nanos = summary.frame_budget.ToNanoseconds();
+    statistics->build = ToEmbedderPercentiles(summary.build);
+    statistics->raster = ToEmbedderPercentiles(summary.raster);
+    statistics->total = ToEmbedderPercentiles(summary.total);
+    static_assert(kFlutterMissedVsyncBucketCount ==
+                  std::tuple_size_v<decltype(summary.missed_vsync_histogram)>);
+    std::copy(summary.missed_vsync_histogram.begin(),
+              summary.missed_vsync_histogram.end(),
+              statistics->missed_vsyncs);
+    statistics->janky_frame_count = summary.janky_frame_count;
+    statistics->missed_vsync_count = summary.missed_vsync_count;
+    statistics->total_frame_count = summary.total_frame_count;
+    statistics->total_janky_frame_count = summary.total_janky_frame_count;
+  }
+  return kSuccess;
 }
 
 FlutterEngineResult FlutterEngineGetProcAddresses(
@@ -2338,6 +2865,16 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
+  SET_PROC(GetRasterCacheStatistics, FlutterEngineGetRasterCacheStatistics);
+  SET_PROC(GetStartupTimings, FlutterEngineGetStartupTimings);
+  SET_PROC(SendOwnedPlatformMessage, FlutterEngineSendOwnedPlatformMessage);
+  SET_PROC(CreateRingBuffer, FlutterEngineCreateRingBuffer);
+  SET_PROC(RingBufferWrite, FlutterEngineRingBufferWrite);
+  SET_PROC(CollectRingBuffer, FlutterEngineCollectRingBuffer);
+  SET_PROC(PushExternalTextureFrame, FlutterEnginePushExternalTextureFrame);
+  SET_PROC(RunExpiredTasks, FlutterEngineRunExpiredTasks);
+  SET_PROC(SetIdleFrameRateLimit, FlutterEngineSetIdleFrameRateLimit);
+  SET_PROC(GetFrameTimingStatistics, FlutterEngineGetFrameTimingStatistics);
 #undef SET_PROC
 
   return kSuccess;
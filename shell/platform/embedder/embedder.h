@@ -299,6 +299,30 @@ typedef struct {
   VoidCallback destruction_callback;
 } FlutterOpenGLFramebuffer;
 
+/// A frame that the embedder pushes to an external texture with
+/// `FlutterEnginePushExternalTextureFrame`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterExternalTextureFrame).
+  size_t struct_size;
+  /// The type of the texture, which must match the type of the renderer of the
+  /// engine. Only `kOpenGL` is currently supported.
+  FlutterRendererType type;
+  union {
+    /// The OpenGL texture of the frame. Its destruction callback is invoked
+    /// once the engine no longer samples the texture or waits on the fence,
+    /// either on an engine managed thread or, if the frame is replaced before
+    /// being sampled, on the thread that pushed the newer frame.
+    FlutterOpenGLTexture open_gl;
+  };
+  /// An optional fence that is signaled once the embedder finished rendering
+  /// into the texture. The GPU waits on it before sampling the texture, without
+  /// blocking the raster thread. For OpenGL, this is a `GLsync` created by
+  /// `glFenceSync` in a context that shares with the one of the engine. The
+  /// embedder keeps ownership of it, and may delete it in the destruction
+  /// callback of the texture.
+  void* fence;
+} FlutterExternalTextureFrame;
+
 typedef bool (*BoolCallback)(void* /* user data */);
 typedef FlutterTransformation (*TransformationCallback)(void* /* user data */);
 typedef uint32_t (*UIntCallback)(void* /* user data */);
@@ -368,6 +392,18 @@ typedef uint32_t (*UIntFrameInfoCallback)(
     void* /* user data */,
     const FlutterFrameInfo* /* frame info */);
 
+/// A structure to represent the damaged area of a surface as a list of
+/// rectangles.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterDamage).
+  size_t struct_size;
+  /// The number of rectangles in `damage`.
+  size_t num_rects;
+  /// The rectangles of the damaged area, in the coordinates of the surface
+  /// with the origin at the top left. The rectangles don't overlap each other.
+  FlutterRect* damage;
+} FlutterDamage;
+
 /// This information is passed to the embedder when a surface is presented.
 ///
 /// See: \ref FlutterOpenGLRendererConfig.present_with_info.
@@ -376,13 +412,54 @@ typedef struct {
   size_t struct_size;
   /// Id of the fbo backing the surface that was presented.
   uint32_t fbo_id;
+  /// The area of the surface that changed since the previous frame, which is
+  /// the only area a compositor that supports it (for example with
+  /// `eglSwapBuffersWithDamageKHR`) has to recompose. If `damage` is null,
+  /// the whole surface has changed. The rectangles are only valid for the
+  /// duration of the callback.
+  FlutterDamage frame_damage;
 } FlutterPresentInfo;
 
+/// This information is passed to the embedder when a software surface is
+/// presented.
+///
+/// See: \ref FlutterSoftwareRendererConfig.surface_present_with_info_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwarePresentInfo).
+  size_t struct_size;
+  /// The buffer that was presented. The buffer is owned by the Flutter engine
+  /// and stays the same between frames of the same size, so that only the
+  /// damaged area has to be copied out of it.
+  const void* allocation;
+  /// The number of bytes in a row of the buffer.
+  size_t row_bytes;
+  /// The number of rows of the buffer.
+  size_t height;
+  /// The area of the buffer that changed since the previous frame, which is
+  /// the only area that has to be copied to the screen. If `damage` is null,
+  /// the whole buffer has changed. The rectangles are only valid for the
+  /// duration of the callback.
+  FlutterDamage frame_damage;
+} FlutterSoftwarePresentInfo;
+
+typedef bool (*SoftwareSurfacePresentWithInfoCallback)(
+    void* /* user data */,
+    const FlutterSoftwarePresentInfo* /* present info */);
+
 /// Callback for when a surface is presented.
 typedef bool (*BoolPresentInfoCallback)(
     void* /* user data */,
     const FlutterPresentInfo* /* present info */);
 
+/// Callback for when the engine needs the existing damage of a frame buffer
+/// object.
+///
+/// See: \ref FlutterOpenGLRendererConfig.populate_existing_damage.
+typedef void (*FlutterFrameBufferWithDamageCallback)(
+    void* /* user data */,
+    intptr_t /* fbo id */,
+    FlutterDamage* /* existing damage */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterOpenGLRendererConfig).
   size_t struct_size;
@@ -441,6 +518,33 @@ typedef struct {
   /// `FlutterPresentInfo` struct that the embedder can use to release any
   /// resources. The return value indicates success of the present call.
   BoolPresentInfoCallback present_with_info;
+  /// Only valid for engines that specify a `spawner` in their project args.
+  /// When true, the engine renders with the same Skia context as the engine
+  /// it is spawned from (if that engine renders with OpenGL), instead of
+  /// creating its own. This lets engines that render the windows of one
+  /// application share the GPU resources cached in the context, such as
+  /// glyphs, images and shader programs, and share their raster cache when
+  /// `--enable-shared-raster-cache` is specified.
+  ///
+  /// The `make_current` callbacks of both engines must make the same OpenGL
+  /// context current (on the render thread, which spawned engines share),
+  /// binding their own window surface to it. The context is collected once
+  /// the last of the engines sharing it is shut down.
+  bool share_skia_context_with_spawner;
+  /// This is an optional callback. The engine invokes it before rendering a
+  /// frame to the frame buffer object with the given id, and the embedder
+  /// sets the `num_rects` and `damage` of the existing damage to the area of
+  /// the frame buffer object whose contents lag behind the frames presented
+  /// since it was last rendered to (for example the frames presented from the
+  /// other buffers of a double or triple buffered surface). The engine then
+  /// only redraws that area and the area that changed since the previous
+  /// frame, which `present_with_info` receives as the frame damage.
+  ///
+  /// A single empty rect means that the frame buffer object holds the
+  /// previous frame. If the callback isn't specified or doesn't set any
+  /// rects, the whole frame is redrawn. The rects must stay valid until the
+  /// callback returns.
+  FlutterFrameBufferWithDamageCallback populate_existing_damage;
 } FlutterOpenGLRendererConfig;
 
 /// Alias for id<MTLDevice>.
@@ -544,11 +648,24 @@ typedef struct {
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
+  /// Specifying one (and only one) of the `surface_present_callback` or
+  /// `surface_present_with_info_callback` callbacks is required.
+  ///
   /// The callback presented to the embedder to present a fully populated buffer
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// Specifying one (and only one) of the `surface_present_callback` or
+  /// `surface_present_with_info_callback` callbacks is required.
+  ///
+  /// The callback presented to the embedder to present a populated buffer to
+  /// the user, along with the area of it that changed since the previous
+  /// frame. Only the changed area of the buffer is repainted when the buffer
+  /// has not been resized since the previous frame, so embedders that keep a
+  /// copy of the buffer (for example in the framebuffer of a display) only
+  /// need to update the damaged area of the copy.
+  SoftwareSurfacePresentWithInfoCallback surface_present_with_info_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -904,6 +1021,11 @@ typedef void (*FlutterTaskRunnerPostTaskCallback)(
     uint64_t /* target time nanos */,
     void* /* user data */);
 
+typedef void (*FlutterTaskRunnerWakeCallback)(
+    FlutterTaskRunner /* task runner */,
+    uint64_t /* target time nanos */,
+    void* /* user data */);
+
 /// An interface used by the Flutter engine to execute tasks at the target time
 /// on a specified thread. There should be a 1-1 relationship between a thread
 /// and a task runner. It is undefined behavior to run a task on a thread that
@@ -926,11 +1048,20 @@ typedef struct {
   /// delta, `FlutterEngineGetCurrentTime` may be called and the difference used
   /// as the delta.
   ///
-  /// @attention     This field is required.
+  /// @attention     This field is required, unless a `wake_callback` is
+  ///                specified.
   FlutterTaskRunnerPostTaskCallback post_task_callback;
   /// A unique identifier for the task runner. If multiple task runners service
   /// tasks on the same thread, their identifiers must match.
   size_t identifier;
+  /// May be called from any thread. If specified, the engine keeps the tasks
+  /// of this task runner in its own queue, sorted by target time, and the
+  /// `post_task_callback` is not used. Instead, this callback is invoked when
+  /// the earliest target time of the queued tasks becomes earlier than the one
+  /// the embedder was last told of. At that target time, the embedder must
+  /// call `FlutterEngineRunExpiredTasks` on the thread associated with the task
+  /// runner to run all the tasks that are due in one call.
+  FlutterTaskRunnerWakeCallback wake_callback;
 } FlutterTaskRunnerDescription;
 
 typedef struct {
@@ -1087,6 +1218,19 @@ typedef enum {
   kFlutterLayerContentTypePlatformView,
 } FlutterLayerContentType;
 
+/// Describes how the backing store of a `FlutterLayer` changed in the frame
+/// that presents it.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterBackingStorePresentInfo).
+  size_t struct_size;
+  /// The area of the backing store that changed since the engine last rendered
+  /// into it, in the coordinates of the backing store. A compositor that kept
+  /// what it composed from the previous contents of the backing store only has
+  /// to recompose this area. If `damage` is null, the whole backing store may
+  /// have changed.
+  FlutterDamage paint_region;
+} FlutterBackingStorePresentInfo;
+
 typedef struct {
   /// This size of this struct. Must be sizeof(FlutterLayer).
   size_t struct_size;
@@ -1106,6 +1250,10 @@ typedef struct {
   FlutterPoint offset;
   /// The size of the layer (in physical pixels).
   FlutterSize size;
+  /// How the backing store of a `kFlutterLayerContentTypeBackingStore` layer
+  /// changed, or null for other layers. It's only valid for the duration of
+  /// the present callback.
+  const FlutterBackingStorePresentInfo* backing_store_present_info;
 } FlutterLayer;
 
 typedef bool (*FlutterBackingStoreCreateCallback)(
@@ -1145,6 +1293,12 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// Render the contents that the engine draws above a platform view into the
+  /// backing store of a lower layer when they don't overlap the platform views
+  /// in between. This reduces the number of backing store layers presented to
+  /// the embedder, but means that there need not be a backing store layer
+  /// after each platform view layer.
+  bool merge_non_overlapping_layers;
 } FlutterCompositor;
 
 typedef struct {
@@ -1214,11 +1368,19 @@ typedef enum {
   ///    2. The display is drawable, e.g. it isn't being mirrored from another
   ///    connected display or sleeping.
   kFlutterEngineDisplaysUpdateTypeStartup,
+  /// The configuration of the active `FlutterEngineDisplay`s changed after
+  /// start-up, e.g. the refresh rate of a variable refresh rate display. The
+  /// displays replace the ones that were previously reported.
+  kFlutterEngineDisplaysUpdateTypeConfigurationChanged,
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
 typedef int64_t FlutterEngineDartPort;
 
+/// A single-producer single-consumer ring buffer through which the embedder
+/// streams bytes to a Dart isolate. See `FlutterEngineCreateRingBuffer`.
+typedef struct _FlutterEngineRingBuffer* FlutterEngineRingBuffer;
+
 typedef enum {
   kFlutterEngineDartObjectTypeNull,
   kFlutterEngineDartObjectTypeBool,
@@ -1315,6 +1477,138 @@ typedef enum {
 typedef void (*FlutterNativeThreadCallback)(FlutterNativeThreadType type,
                                             void* user_data);
 
+typedef enum {
+  /// The entry caches the rasterization of a picture.
+  kFlutterRasterCacheEntryTypePicture,
+  /// The entry caches the rasterization of a display list.
+  kFlutterRasterCacheEntryTypeDisplayList,
+  /// The entry caches the rasterization of a layer and its children.
+  kFlutterRasterCacheEntryTypeLayer,
+} FlutterRasterCacheEntryType;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterRasterCacheEntry).
+  size_t struct_size;
+  FlutterRasterCacheEntryType type;
+  /// The size of the cached image in bytes, or 0 if the entry has not been
+  /// rasterized yet.
+  size_t size_in_bytes;
+  /// The number of times the entry was prepared or drawn.
+  size_t access_count;
+  /// The number of frames since the entry was rasterized.
+  size_t age_in_frames;
+  /// The last frame, as counted by `FlutterRasterCacheStatistics.frame`, in
+  /// which the entry was used.
+  size_t last_used_frame;
+} FlutterRasterCacheEntry;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterRasterCacheStatistics).
+  size_t struct_size;
+  /// The number of frames rendered with the raster cache.
+  size_t frame;
+  /// The number of draws that found a cached image.
+  size_t hit_count;
+  /// The number of draws that found no cached image.
+  size_t miss_count;
+  /// The fraction of draws that found a cached image.
+  double hit_ratio;
+  /// The number of frames that a picture must be drawn in before it is
+  /// cached.
+  size_t access_threshold;
+  /// The max number of pictures that are rasterized in a single frame.
+  size_t cache_limit_per_frame;
+  /// The number of entries in the `entries` array.
+  size_t entry_count;
+  const FlutterRasterCacheEntry* entries;
+} FlutterRasterCacheStatistics;
+
+/// A callback made by the engine in response to
+/// `FlutterEngineGetRasterCacheStatistics` on the render thread. The
+/// statistics are only valid for the duration of the call.
+typedef void (*FlutterRasterCacheStatisticsCallback)(
+    const FlutterRasterCacheStatistics* statistics,
+    void* user_data);
+
+typedef struct {
+  /// The time the phase began, in nanoseconds on the clock of
+  /// `FlutterEngineGetCurrentTime`, or 0 if it hasn't run in the process.
+  uint64_t start_nanos;
+  /// The time the phase ended, on the same clock.
+  uint64_t end_nanos;
+} FlutterEngineStartupPhase;
+
+/// The phases of the engine startup. The VM and its snapshots are shared by
+/// all the engines of the process, so each phase is the first one that ran in
+/// the process.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineStartupTimings).
+  size_t struct_size;
+  /// Mapping the VM snapshot.
+  FlutterEngineStartupPhase vm_snapshot_mapping;
+  /// Mapping the isolate snapshot.
+  FlutterEngineStartupPhase isolate_snapshot_mapping;
+  /// Initializing the Dart VM, which includes mapping the snapshots if the
+  /// embedder didn't provide them.
+  FlutterEngineStartupPhase vm_initialization;
+  /// Creating and running the root isolate.
+  FlutterEngineStartupPhase root_isolate_creation;
+  /// Building and rasterizing the first frame.
+  FlutterEngineStartupPhase first_frame;
+  /// Creating the shell of the engine, which includes initializing the Dart VM
+  /// if it isn't running yet.
+  FlutterEngineStartupPhase shell_creation;
+  /// Building the layer tree of the first frame.
+  FlutterEngineStartupPhase first_layer_tree;
+  /// Rasterizing the first frame.
+  FlutterEngineStartupPhase first_raster;
+  /// Submitting the first frame to the surface.
+  FlutterEngineStartupPhase first_present;
+} FlutterEngineStartupTimings;
+
+/// The nearest-rank percentiles of the durations of a phase of the recent
+/// frames, in nanoseconds.
+typedef struct {
+  uint64_t p50_nanos;
+  uint64_t p90_nanos;
+  uint64_t p99_nanos;
+  uint64_t max_nanos;
+} FlutterFrameTimingPercentiles;
+
+/// The number of buckets of `FlutterFrameTimingStatistics.missed_vsyncs`.
+#define kFlutterMissedVsyncBucketCount 4
+
+/// The timings of the most recent frames rasterized by an engine. A frame
+/// misses a vsync for each frame budget beyond the first that the slower of
+/// its build and its rasterization takes.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingStatistics).
+  size_t struct_size;
+  /// The number of recent frames that the percentiles and the jank counts
+  /// cover.
+  size_t frame_count;
+  /// The frame budget of the display when the most recent frame was
+  /// rasterized, in nanoseconds.
+  uint64_t frame_budget_nanos;
+  /// From the start to the end of the build on the UI thread.
+  FlutterFrameTimingPercentiles build;
+  /// From the start to the end of the rasterization on the render thread.
+  FlutterFrameTimingPercentiles raster;
+  /// From the vsync that the frame was scheduled for to the end of its
+  /// rasterization.
+  FlutterFrameTimingPercentiles total;
+  /// The number of the recent frames that missed 0, 1, 2 and 3 or more
+  /// vsyncs.
+  size_t missed_vsyncs[kFlutterMissedVsyncBucketCount];
+  /// The recent frames that missed at least one vsync, and the vsyncs they
+  /// missed.
+  size_t janky_frame_count;
+  size_t missed_vsync_count;
+  /// The frames since the engine was launched.
+  size_t total_frame_count;
+  size_t total_janky_frame_count;
+} FlutterFrameTimingStatistics;
+
 /// AOT data source type.
 typedef enum {
   kFlutterEngineAOTDataSourceTypeElfPath
@@ -1345,6 +1639,18 @@ typedef void (*FlutterLogMessageCallback)(const char* /* tag */,
 /// FlutterEngine instance in AOT mode.
 typedef struct _FlutterEngineAOTData* FlutterEngineAOTData;
 
+/// When the engine begins frames relative to vsync.
+typedef enum {
+  /// Frames begin at vsync.
+  kFlutterFramePacingPolicyDefault,
+  /// Frames begin as late after vsync as the durations of recent frames
+  /// allow, so that they reflect the latest input.
+  kFlutterFramePacingPolicyLowLatency,
+  /// Frames begin before vsync while building and rasterizing a frame takes
+  /// longer than a frame interval, so that consecutive frames overlap.
+  kFlutterFramePacingPolicySmooth,
+} FlutterFramePacingPolicy;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterProjectArgs).
   size_t struct_size;
@@ -1589,6 +1895,36 @@ typedef struct {
   //
   // The first argument is the `user_data` from `FlutterEngineInitialize`.
   OnPreEngineRestartCallback on_pre_engine_restart_callback;
+
+  // The number of bytes of cached images that the raster cache may keep
+  // alive across frames in which they are not used.
+  //
+  // Cached images that are not used in a frame are evicted at the end of
+  // that frame unless this budget is set. With a budget, they are kept and
+  // the least recently used are evicted once the budget is exceeded. A value
+  // of 0 keeps the default behavior.
+  size_t raster_cache_max_bytes;
+
+  // When the engine begins frames relative to vsync. Defaults to
+  // `kFlutterFramePacingPolicyDefault`, which begins them at vsync.
+  FlutterFramePacingPolicy frame_pacing_policy;
+
+  // A running engine that this engine is spawned from.
+  //
+  // A spawned engine is lightweight: instead of creating its own, it shares
+  // the threads, the Dart VM isolate group, the settings, the asset manager
+  // and the font collection of the spawner, so the fonts of the assets are
+  // only loaded once. This suits running many engines in one process, such
+  // as to render previews on a server. The renderer configuration and the
+  // callbacks of the platform view (platform messages, semantics, vsync) are
+  // still those given to this engine. Specifying a `vsync_callback` gives the
+  // embedder explicit control over when frames are rendered.
+  //
+  // The spawner must run the same Dart code, use the same renderer type and
+  // keep running until `FlutterEngineRunInitialized` returns for this engine.
+  // It may be shut down before this engine. `custom_task_runners` may not be
+  // specified for a spawned engine.
+  FLUTTER_API_SYMBOL(FlutterEngine) spawner;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -1776,6 +2112,29 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message to the Flutter application like
+///             `FlutterEngineSendPlatformMessage`, but hands the ownership of
+///             the message data over to the engine instead of having the
+///             engine copy it. Large messages are then given to the Dart
+///             application without any copy. This is meant for the channels
+///             that stream large amounts of data, such as the frames of a
+///             camera.
+///
+/// @param[in]  engine   A running engine instance.
+/// @param[in]  message  The message to send. Its `message` data must have
+///                      been allocated with `malloc`. The engine releases it
+///                      with `free` once it's done with it, even if the call
+///                      fails. The embedder must not access the data after
+///                      this call.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendOwnedPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -1924,6 +2283,31 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
 
+//------------------------------------------------------------------------------
+/// @brief      Push a new frame to a registered external texture. Unlike
+///             `FlutterEngineMarkExternalTextureFrameAvailable`, the raster
+///             thread doesn't call back into the embedder for the texture of
+///             the frame, but samples the latest pushed frame once its fence is
+///             signaled on the GPU. Frames that are replaced before they are
+///             sampled are dropped. This call is thread safe.
+///
+/// @see        FlutterEngineRegisterExternalTexture()
+/// @see        FlutterEngineMarkExternalTextureFrameAvailable()
+///
+/// @param[in]  engine              A running engine instance.
+/// @param[in]  texture_identifier  The identifier of the texture whose frame
+///                                 is pushed.
+/// @param[in]  frame               The frame, which the engine takes ownership
+///                                 of on success.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePushExternalTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterExternalTextureFrame* frame);
+
 //------------------------------------------------------------------------------
 /// @brief      Enable or disable accessibility semantics.
 ///
@@ -2105,6 +2489,31 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task);
 
+//------------------------------------------------------------------------------
+/// @brief      Inform the engine to run all the tasks of a task runner whose
+///             target time has expired, in target time order. The task runner
+///             must have been described with a
+///             `FlutterTaskRunnerDescription.wake_callback`, and this call
+///             must be made on the thread associated with it. Tasks posted
+///             while this call runs tasks are run by the next call.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  task_runner  The task runner given to the engine via the
+///                          `FlutterTaskRunnerDescription.wake_callback`.
+/// @param[out] next_task_target_time_nanos
+///                          The target time of the earliest task still queued,
+///                          or `UINT64_MAX` if there is none. The wake
+///                          callback isn't invoked for this target time. May
+///                          be null.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRunExpiredTasks(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    uint64_t* next_task_target_time_nanos);
+
 //------------------------------------------------------------------------------
 /// @brief      Notify a running engine instance that the locale has been
 ///             updated. The preferred locale must be the first item in the list
@@ -2174,6 +2583,115 @@ FlutterEngineResult FlutterEnginePostDartObject(
     FlutterEngineDartPort port,
     const FlutterEngineDartObject* object);
 
+//------------------------------------------------------------------------------
+/// @brief      Creates a ring buffer through which the embedder can stream
+///             bytes (e.g. audio samples or sensor readings) to the isolate
+///             listening on the port, without posting a message for each
+///             write.
+///
+///             On success, a list of two objects is posted to the port: a
+///             Uint8List that references the bytes of the ring buffer in
+///             place, and the address of the ring buffer as an integer. The
+///             Dart code consumes the buffer through `dart:ffi`, by looking
+///             up `FlutterEngineRingBufferAcquireRead` and
+///             `FlutterEngineRingBufferReleaseRead` in the process and passing
+///             them that address. It must keep the Uint8List reachable for as
+///             long as it uses the address.
+///
+///             Afterwards, an integer is posted to the port each time a write
+///             makes the buffer readable after the consumer found it empty
+///             in a call to `FlutterEngineRingBufferAcquireRead`. Writes made
+///             while the consumer hasn't caught up don't post anything.
+///
+///             A single thread of the embedder may write into the ring buffer
+///             at a time, and a single Dart isolate may read from it. The ring
+///             buffer must be collected before the engine is deinitialized.
+///
+/// @see        FlutterEngineRingBufferWrite()
+/// @see        FlutterEngineCollectRingBuffer()
+///
+/// @param[in]  engine           A running engine instance.
+/// @param[in]  port             The send port of the consuming isolate.
+/// @param[in]  capacity         The size of the ring buffer, in bytes.
+/// @param[out] ring_buffer_out  The ring buffer created when this call is
+///                              successful.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Writes as many bytes as fit in the ring buffer. The bytes that
+///             don't fit are not written; the embedder may retry them once
+///             the consumer has caught up. Can be called on any thread, but
+///             only from one thread at a time.
+///
+/// @param[in]  ring_buffer  The ring buffer to write into.
+/// @param[in]  data         The bytes to write.
+/// @param[in]  size         The number of bytes to write.
+/// @param[out] written_out  The number of bytes that were written. May be
+///                          null.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    size_t* written_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Releases the embedder's reference to the ring buffer. The bytes
+///             of the ring buffer stay valid until the Dart isolate releases
+///             its Uint8List. The ring buffer must not be written into after
+///             this call.
+///
+/// @param[in]  ring_buffer  The ring buffer to collect.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FlutterEngineRingBuffer ring_buffer);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the next contiguous range of readable bytes of the ring
+///             buffer. This is called by the consuming Dart isolate through
+///             `dart:ffi`, not by the embedder.
+///
+///             If the ring buffer is empty, an integer will be posted to the
+///             port of the ring buffer after the next write.
+///
+/// @param[in]  ring_buffer  The address of the ring buffer.
+/// @param[out] offset_out   The offset of the range in the Uint8List of the
+///                          ring buffer.
+///
+/// @return     The size of the range, which is zero if the ring buffer is
+///             empty.
+///
+FLUTTER_EXPORT
+size_t FlutterEngineRingBufferAcquireRead(FlutterEngineRingBuffer ring_buffer,
+                                          size_t* offset_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Releases the first bytes of the range returned by the last call
+///             to `FlutterEngineRingBufferAcquireRead`, so that their space can
+///             be written into again. This is called by the consuming Dart
+///             isolate through `dart:ffi`, not by the embedder.
+///
+/// @param[in]  ring_buffer  The address of the ring buffer.
+/// @param[in]  size         The number of bytes that were read.
+///
+FLUTTER_EXPORT
+void FlutterEngineRingBufferReleaseRead(FlutterEngineRingBuffer ring_buffer,
+                                        size_t size);
+
 //------------------------------------------------------------------------------
 /// @brief      Posts a low memory notification to a running engine instance.
 ///             The engine will do its best to release non-critical resources in
@@ -2251,6 +2769,80 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
     const FlutterEngineDisplay* displays,
     size_t display_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Limits the rate at which a running engine instance produces
+///             frames while the user isn't interacting with it, which is
+///             until a second after the last pointer event sent with
+///             `FlutterEngineSendPointerEvent`. The frames requested by the
+///             framework sooner than that after the last frame are coalesced
+///             into a single frame, so that for example a blinking cursor on
+///             an otherwise static screen doesn't keep the engine rendering
+///             at the refresh rate of the display. Window metrics changes are
+///             never held back.
+///
+/// @param[in]  engine             A running engine instance.
+/// @param[in]  frames_per_second  The maximum number of frames per second
+///                                while the user isn't interacting, or zero
+///                                to remove the limit.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSetIdleFrameRateLimit(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    double frames_per_second);
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the entries of the raster cache of a running engine
+///             instance along with the hit ratio of the cache, for telemetry
+///             used to tune the raster cache thresholds.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   The callback that is called on the render thread
+///                        with the statistics.
+/// @param[in]  user_data  A baton passed by the engine to the callback. This
+///                        baton is not interpreted by the engine in any way.
+///
+/// @return     Returns if the callback was successfully posted to the render
+///             thread.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetRasterCacheStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterRasterCacheStatisticsCallback callback,
+    void* user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the monotonic timestamps of the engine startup phases, for
+///             startup telemetry that doesn't need a tracing session.
+///
+/// @param[in]  engine   A running engine instance.
+/// @param[out] timings  The timings, whose struct_size must be set. The phases
+///                      that haven't run yet are zero.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetStartupTimings(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStartupTimings* timings);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the percentiles and the jank counts of the frames recently
+///             rasterized by the engine, for jank telemetry that doesn't need
+///             a tracing session nor Dart. This call can be made on any
+///             thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[out] statistics  The statistics, whose struct_size must be set.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStatistics* statistics);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2292,6 +2884,9 @@ typedef FlutterEngineResult (*FlutterEngineSendKeyEventFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
+typedef FlutterEngineResult (*FlutterEngineSendOwnedPlatformMessageFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message);
 typedef FlutterEngineResult (
     *FlutterEnginePlatformMessageCreateResponseHandleFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -2356,6 +2951,26 @@ typedef FlutterEngineResult (*FlutterEnginePostDartObjectFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterEngineDartPort port,
     const FlutterEngineDartObject* object);
+typedef FlutterEngineResult (*FlutterEngineCreateRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer_out);
+typedef FlutterEngineResult (*FlutterEngineRingBufferWriteFnPtr)(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    size_t* written_out);
+typedef FlutterEngineResult (*FlutterEngineCollectRingBufferFnPtr)(
+    FlutterEngineRingBuffer ring_buffer);
+typedef FlutterEngineResult (*FlutterEnginePushExternalTextureFrameFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterExternalTextureFrame* frame);
+typedef FlutterEngineResult (*FlutterEngineRunExpiredTasksFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    uint64_t* next_task_target_time_nanos);
 typedef FlutterEngineResult (*FlutterEngineNotifyLowMemoryWarningFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 typedef FlutterEngineResult (*FlutterEnginePostCallbackOnAllNativeThreadsFnPtr)(
@@ -2367,6 +2982,19 @@ typedef FlutterEngineResult (*FlutterEngineNotifyDisplayUpdateFnPtr)(
     FlutterEngineDisplaysUpdateType update_type,
     const FlutterEngineDisplay* displays,
     size_t display_count);
+typedef FlutterEngineResult (*FlutterEngineSetIdleFrameRateLimitFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    double frames_per_second);
+typedef FlutterEngineResult (*FlutterEngineGetRasterCacheStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterRasterCacheStatisticsCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetStartupTimingsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStartupTimings* timings);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStatistics* statistics);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2411,6 +3039,16 @@ typedef struct {
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
+  FlutterEngineGetRasterCacheStatisticsFnPtr GetRasterCacheStatistics;
+  FlutterEngineGetStartupTimingsFnPtr GetStartupTimings;
+  FlutterEngineSendOwnedPlatformMessageFnPtr SendOwnedPlatformMessage;
+  FlutterEngineCreateRingBufferFnPtr CreateRingBuffer;
+  FlutterEngineRingBufferWriteFnPtr RingBufferWrite;
+  FlutterEngineCollectRingBufferFnPtr CollectRingBuffer;
+  FlutterEnginePushExternalTextureFrameFnPtr PushExternalTextureFrame;
+  FlutterEngineRunExpiredTasksFnPtr RunExpiredTasks;
+  FlutterEngineSetIdleFrameRateLimitFnPtr SetIdleFrameRateLimit;
+  FlutterEngineGetFrameTimingStatisticsFnPtr GetFrameTimingStatistics;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
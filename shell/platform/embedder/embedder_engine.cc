@@ -22,14 +22,16 @@ struct ShellArgs {
 };
 
 EmbedderEngine::EmbedderEngine(
-    std::unique_ptr<EmbedderThreadHost> thread_host,
+    std::shared_ptr<EmbedderThreadHost> thread_host,
     flutter::TaskRunners task_runners,
     flutter::Settings settings,
     RunConfiguration run_configuration,
     Shell::CreateCallback<PlatformView> on_create_platform_view,
     Shell::CreateCallback<Rasterizer> on_create_rasterizer,
-    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver)
+    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver,
+    EmbedderEngine* spawner)
     : thread_host_(std::move(thread_host)),
+      spawner_(spawner),
       task_runners_(task_runners),
       run_configuration_(std::move(run_configuration)),
       shell_args_(std::make_unique<ShellArgs>(std::move(settings),
@@ -49,9 +51,14 @@ bool EmbedderEngine::LaunchShell() {
     FML_DLOG(ERROR) << "Shell already initialized";
   }
 
-  shell_ = Shell::Create(
-      flutter::PlatformData(), task_runners_, shell_args_->settings,
-      shell_args_->on_create_platform_view, shell_args_->on_create_rasterizer);
+  if (spawner_) {
+    SpawnShell();
+  } else {
+    shell_ = Shell::Create(flutter::PlatformData(), task_runners_,
+                           shell_args_->settings,
+                           shell_args_->on_create_platform_view,
+                           shell_args_->on_create_rasterizer);
+  }
 
   // Reset the args no matter what. They will never be used to initialize a
   // shell again.
@@ -60,12 +67,31 @@ bool EmbedderEngine::LaunchShell() {
   return IsValid();
 }
 
+bool EmbedderEngine::SpawnShell() {
+  if (!spawner_->IsValid()) {
+    FML_LOG(ERROR) << "The engine to spawn from was not running.";
+    return false;
+  }
+
+  // The spawned shell shares the asset manager of its spawner, and is returned
+  // with its root isolate running.
+  shell_ = spawner_->GetShell().Spawn(std::move(run_configuration_),
+                                      /*initial_route=*/"",
+                                      shell_args_->on_create_platform_view,
+                                      shell_args_->on_create_rasterizer);
+  return IsValid();
+}
+
 bool EmbedderEngine::CollectShell() {
   shell_.reset();
   return IsValid();
 }
 
 bool EmbedderEngine::RunRootIsolate() {
+  if (spawner_) {
+    // The root isolate of a spawned shell runs once the shell is spawned.
+    return IsValid();
+  }
   if (!IsValid() || !run_configuration_.IsValid()) {
     return false;
   }
@@ -171,6 +197,7 @@ bool EmbedderEngine::UnregisterTexture(int64_t texture) {
   if (!IsValid()) {
     return false;
   }
+  external_texture_resolver_->OnTextureUnregistered(texture);
   shell_->GetPlatformView()->UnregisterTexture(texture);
   return true;
 }
@@ -183,6 +210,23 @@ bool EmbedderEngine::MarkTextureFrameAvailable(int64_t texture) {
   return true;
 }
 
+bool EmbedderEngine::PushTextureFrame(int64_t texture,
+                                      const FlutterExternalTextureFrame& frame) {
+  if (!IsValid() ||
+      !external_texture_resolver_->PushExternalTextureFrame(texture, frame)) {
+    return false;
+  }
+  // Unlike marking a frame available, the texture keeps showing its last frame
+  // until the new one is sampled, so only a frame needs to be scheduled.
+  shell_->GetTaskRunners().GetUITaskRunner()->PostTask(
+      [engine = shell_->GetEngine()]() {
+        if (engine) {
+          engine->ScheduleFrame(false);
+        }
+      });
+  return true;
+}
+
 bool EmbedderEngine::SetSemanticsEnabled(bool enabled) {
   if (!IsValid()) {
     return false;
@@ -241,6 +285,15 @@ bool EmbedderEngine::ReloadSystemFonts() {
   return shell_->ReloadSystemFonts();
 }
 
+bool EmbedderEngine::SetIdleFrameRateLimit(double frames_per_second) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  shell_->SetIdleFrameRateLimit(frames_per_second);
+  return true;
+}
+
 bool EmbedderEngine::PostRenderThreadTask(const fml::closure& task) {
   if (!IsValid()) {
     return false;
@@ -261,6 +314,13 @@ bool EmbedderEngine::RunTask(const FlutterTask* task) {
                                 task->task);
 }
 
+bool EmbedderEngine::RunExpiredTasks(FlutterTaskRunner task_runner,
+                                     fml::TimePoint* next_target_time) {
+  // Like |RunTask|, this doesn't need the shell to be running.
+  return thread_host_->RunExpiredTasks(
+      reinterpret_cast<int64_t>(task_runner), next_target_time);
+}
+
 bool EmbedderEngine::PostTaskOnEngineManagedNativeThreads(
     std::function<void(FlutterNativeThreadType)> closure) const {
   if (!IsValid() || closure == nullptr) {
@@ -294,4 +354,8 @@ Shell& EmbedderEngine::GetShell() {
   return *shell_.get();
 }
 
+std::shared_ptr<EmbedderThreadHost> EmbedderEngine::GetThreadHost() const {
+  return thread_host_;
+}
+
 }  // namespace flutter
@@ -22,14 +22,15 @@ struct ShellArgs;
 // instance of the Flutter engine.
 class EmbedderEngine {
  public:
-  EmbedderEngine(std::unique_ptr<EmbedderThreadHost> thread_host,
+  EmbedderEngine(std::shared_ptr<EmbedderThreadHost> thread_host,
                  TaskRunners task_runners,
                  Settings settings,
                  RunConfiguration run_configuration,
                  Shell::CreateCallback<PlatformView> on_create_platform_view,
                  Shell::CreateCallback<Rasterizer> on_create_rasterizer,
                  std::unique_ptr<EmbedderExternalTextureResolver>
-                     external_texture_resolver);
+                     external_texture_resolver,
+                 EmbedderEngine* spawner = nullptr);
 
   ~EmbedderEngine();
 
@@ -76,6 +77,9 @@ class EmbedderEngine {
 
   bool MarkTextureFrameAvailable(int64_t texture);
 
+  bool PushTextureFrame(int64_t texture,
+                        const FlutterExternalTextureFrame& frame);
+
   bool SetSemanticsEnabled(bool enabled);
 
   bool SetAccessibilityFeatures(int32_t flags);
@@ -90,23 +94,39 @@ class EmbedderEngine {
 
   bool ReloadSystemFonts();
 
+  bool SetIdleFrameRateLimit(double frames_per_second);
+
   bool PostRenderThreadTask(const fml::closure& task);
 
   bool RunTask(const FlutterTask* task);
 
+  bool RunExpiredTasks(FlutterTaskRunner task_runner,
+                       fml::TimePoint* next_target_time);
+
   bool PostTaskOnEngineManagedNativeThreads(
       std::function<void(FlutterNativeThreadType)> closure) const;
 
   Shell& GetShell();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The threads of the engine, which the engines spawned from it
+  ///             share.
+  ///
+  std::shared_ptr<EmbedderThreadHost> GetThreadHost() const;
+
  private:
-  const std::unique_ptr<EmbedderThreadHost> thread_host_;
+  const std::shared_ptr<EmbedderThreadHost> thread_host_;
+  // The engine whose shell the shell of this engine is spawned from, which is
+  // only used when launching the shell.
+  EmbedderEngine* spawner_;
   TaskRunners task_runners_;
   RunConfiguration run_configuration_;
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
 
+  bool SpawnShell();
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
 
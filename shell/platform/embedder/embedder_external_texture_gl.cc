@@ -4,19 +4,53 @@
 
 #include "flutter/shell/platform/embedder/embedder_external_texture_gl.h"
 
+#include <utility>
+
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/gpu/GrBackendSemaphore.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
 
+EmbedderExternalTextureGLFrameSlot::EmbedderExternalTextureGLFrameSlot() =
+    default;
+
+EmbedderExternalTextureGLFrameSlot::~EmbedderExternalTextureGLFrameSlot() {
+  if (frame_ && frame_->texture.destruction_callback) {
+    frame_->texture.destruction_callback(frame_->texture.user_data);
+  }
+}
+
+void EmbedderExternalTextureGLFrameSlot::Push(const Frame& frame) {
+  std::optional<Frame> replaced_frame;
+  {
+    std::scoped_lock lock(mutex_);
+    replaced_frame = std::exchange(frame_, frame);
+  }
+  // The replaced frame was never sampled, so it can be released right away.
+  if (replaced_frame && replaced_frame->texture.destruction_callback) {
+    replaced_frame->texture.destruction_callback(
+        replaced_frame->texture.user_data);
+  }
+}
+
+std::optional<EmbedderExternalTextureGLFrameSlot::Frame>
+EmbedderExternalTextureGLFrameSlot::Take() {
+  std::scoped_lock lock(mutex_);
+  return std::exchange(frame_, std::nullopt);
+}
+
 EmbedderExternalTextureGL::EmbedderExternalTextureGL(
     int64_t texture_identifier,
-    const ExternalTextureCallback& callback)
-    : Texture(texture_identifier), external_texture_callback_(callback) {
-  FML_DCHECK(external_texture_callback_);
+    const ExternalTextureCallback& callback,
+    std::shared_ptr<EmbedderExternalTextureGLFrameSlot> pushed_frame_slot)
+    : Texture(texture_identifier),
+      external_texture_callback_(callback),
+      pushed_frame_slot_(std::move(pushed_frame_slot)) {
+  FML_DCHECK(pushed_frame_slot_);
 }
 
 EmbedderExternalTextureGL::~EmbedderExternalTextureGL() = default;
@@ -27,12 +61,14 @@ void EmbedderExternalTextureGL::Paint(SkCanvas& canvas,
                                       bool freeze,
                                       GrDirectContext* context,
                                       const SkSamplingOptions& sampling) {
-  if (last_image_ == nullptr) {
-    last_image_ =
-        ResolveTexture(Id(),                                           //
-                       context,                                        //
-                       SkISize::Make(bounds.width(), bounds.height())  //
-        );
+  const SkISize size = SkISize::Make(bounds.width(), bounds.height());
+  if (auto frame = pushed_frame_slot_->Take()) {
+    // The previous image releases its frame once Skia is done with it.
+    last_image_ = ResolvePushedFrame(*frame, context, size);
+  }
+
+  if (last_image_ == nullptr && external_texture_callback_) {
+    last_image_ = ResolveTexture(Id(), context, size);
   }
 
   if (last_image_) {
@@ -57,20 +93,45 @@ sk_sp<SkImage> EmbedderExternalTextureGL::ResolveTexture(
     return nullptr;
   }
 
-  GrGLTextureInfo gr_texture_info = {texture->target, texture->name,
-                                     texture->format};
+  return MakeImage(*texture, context, size);
+}
+
+sk_sp<SkImage> EmbedderExternalTextureGL::ResolvePushedFrame(
+    const EmbedderExternalTextureGLFrameSlot::Frame& frame,
+    GrDirectContext* context,
+    const SkISize& size) {
+  if (frame.fence) {
+    // Makes the GPU wait for the embedder to finish rendering into the texture
+    // before sampling it, without blocking this thread. The embedder keeps
+    // ownership of the fence.
+    GrBackendSemaphore semaphore;
+    semaphore.initGL(static_cast<GrGLsync>(frame.fence));
+    if (!context->wait(1, &semaphore, /*deleteSemaphoresAfterWait=*/false)) {
+      FML_LOG(ERROR) << "Could not wait on the fence of the external texture "
+                        "frame, so it may be sampled before it's complete.";
+    }
+  }
+  return MakeImage(frame.texture, context, size);
+}
+
+sk_sp<SkImage> EmbedderExternalTextureGL::MakeImage(
+    const FlutterOpenGLTexture& texture,
+    GrDirectContext* context,
+    const SkISize& size) {
+  GrGLTextureInfo gr_texture_info = {texture.target, texture.name,
+                                     texture.format};
 
   size_t width = size.width();
   size_t height = size.height();
 
-  if (texture->width != 0 && texture->height != 0) {
-    width = texture->width;
-    height = texture->height;
+  if (texture.width != 0 && texture.height != 0) {
+    width = texture.width;
+    height = texture.height;
   }
 
   GrBackendTexture gr_backend_texture(width, height, GrMipMapped::kNo,
                                       gr_texture_info);
-  SkImage::TextureReleaseProc release_proc = texture->destruction_callback;
+  SkImage::TextureReleaseProc release_proc = texture.destruction_callback;
   auto image =
       SkImage::MakeFromTexture(context,                   // context
                                gr_backend_texture,        // texture handle
@@ -78,15 +139,15 @@ sk_sp<SkImage> EmbedderExternalTextureGL::ResolveTexture(
                                kRGBA_8888_SkColorType,    // color type
                                kPremul_SkAlphaType,       // alpha type
                                nullptr,                   // colorspace
-                               release_proc,       // texture release proc
-                               texture->user_data  // texture release context
+                               release_proc,      // texture release proc
+                               texture.user_data  // texture release context
       );
 
   if (!image) {
     // In case Skia rejects the image, call the release proc so that
     // embedders can perform collection of intermediates.
     if (release_proc) {
-      release_proc(texture->user_data);
+      release_proc(texture.user_data);
     }
     FML_LOG(ERROR) << "Could not create external texture->";
     return nullptr;
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_GL_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_GL_H_
 
+#include <memory>
+#include <mutex>
+#include <optional>
+
 #include "flutter/common/graphics/texture.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -13,24 +17,65 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// The latest frame that the embedder pushed to an external texture, until the
+/// raster thread samples it. Callable on any thread.
+///
+class EmbedderExternalTextureGLFrameSlot {
+ public:
+  struct Frame {
+    FlutterOpenGLTexture texture;
+    void* fence;
+  };
+
+  EmbedderExternalTextureGLFrameSlot();
+
+  ~EmbedderExternalTextureGLFrameSlot();
+
+  // Replaces the frame, releasing the previous one if it wasn't taken.
+  void Push(const Frame& frame);
+
+  std::optional<Frame> Take();
+
+ private:
+  std::mutex mutex_;
+  std::optional<Frame> frame_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalTextureGLFrameSlot);
+};
+
 class EmbedderExternalTextureGL : public flutter::Texture {
  public:
   using ExternalTextureCallback = std::function<
       std::unique_ptr<FlutterOpenGLTexture>(int64_t, size_t, size_t)>;
 
-  EmbedderExternalTextureGL(int64_t texture_identifier,
-                            const ExternalTextureCallback& callback);
+  // The callback may be empty, in which case the texture only shows the frames
+  // that are pushed to the slot.
+  EmbedderExternalTextureGL(
+      int64_t texture_identifier,
+      const ExternalTextureCallback& callback,
+      std::shared_ptr<EmbedderExternalTextureGLFrameSlot> pushed_frame_slot);
 
   ~EmbedderExternalTextureGL();
 
  private:
   const ExternalTextureCallback& external_texture_callback_;
+  const std::shared_ptr<EmbedderExternalTextureGLFrameSlot> pushed_frame_slot_;
   sk_sp<SkImage> last_image_;
 
   sk_sp<SkImage> ResolveTexture(int64_t texture_id,
                                 GrDirectContext* context,
                                 const SkISize& size);
 
+  sk_sp<SkImage> ResolvePushedFrame(
+      const EmbedderExternalTextureGLFrameSlot::Frame& frame,
+      GrDirectContext* context,
+      const SkISize& size);
+
+  sk_sp<SkImage> MakeImage(const FlutterOpenGLTexture& texture,
+                           GrDirectContext* context,
+                           const SkISize& size);
+
   // |flutter::Texture|
   void Paint(SkCanvas& canvas,
              const SkRect& bounds,
@@ -11,7 +11,7 @@ namespace flutter {
 #ifdef SHELL_ENABLE_GL
 EmbedderExternalTextureResolver::EmbedderExternalTextureResolver(
     EmbedderExternalTextureGL::ExternalTextureCallback gl_callback)
-    : gl_callback_(gl_callback) {}
+    : gl_(true), gl_callback_(gl_callback) {}
 #endif
 
 #ifdef SHELL_ENABLE_METAL
@@ -23,9 +23,14 @@ EmbedderExternalTextureResolver::EmbedderExternalTextureResolver(
 std::unique_ptr<Texture>
 EmbedderExternalTextureResolver::ResolveExternalTexture(int64_t texture_id) {
 #ifdef SHELL_ENABLE_GL
-  if (gl_callback_) {
-    return std::make_unique<EmbedderExternalTextureGL>(texture_id,
-                                                       gl_callback_);
+  if (gl_) {
+    auto frame_slot = std::make_shared<EmbedderExternalTextureGLFrameSlot>();
+    {
+      std::scoped_lock lock(gl_frame_slots_mutex_);
+      gl_frame_slots_[texture_id] = frame_slot;
+    }
+    return std::make_unique<EmbedderExternalTextureGL>(
+        texture_id, gl_callback_, std::move(frame_slot));
   }
 #endif
 
@@ -41,7 +46,7 @@ EmbedderExternalTextureResolver::ResolveExternalTexture(int64_t texture_id) {
 
 bool EmbedderExternalTextureResolver::SupportsExternalTextures() {
 #ifdef SHELL_ENABLE_GL
-  if (gl_callback_) {
+  if (gl_) {
     return true;
   }
 #endif
@@ -55,4 +60,34 @@ bool EmbedderExternalTextureResolver::SupportsExternalTextures() {
   return false;
 }
 
+bool EmbedderExternalTextureResolver::PushExternalTextureFrame(
+    int64_t texture_id,
+    const FlutterExternalTextureFrame& frame) {
+#ifdef SHELL_ENABLE_GL
+  if (gl_ && frame.type == kOpenGL) {
+    std::shared_ptr<EmbedderExternalTextureGLFrameSlot> frame_slot;
+    {
+      std::scoped_lock lock(gl_frame_slots_mutex_);
+      auto found = gl_frame_slots_.find(texture_id);
+      if (found == gl_frame_slots_.end()) {
+        return false;
+      }
+      frame_slot = found->second;
+    }
+    frame_slot->Push({frame.open_gl, frame.fence});
+    return true;
+  }
+#endif
+
+  return false;
+}
+
+void EmbedderExternalTextureResolver::OnTextureUnregistered(
+    int64_t texture_id) {
+#ifdef SHELL_ENABLE_GL
+  std::scoped_lock lock(gl_frame_slots_mutex_);
+  gl_frame_slots_.erase(texture_id);
+#endif
+}
+
 }  // namespace flutter
@@ -6,8 +6,11 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_RESOLVER_H_
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/shell/platform/embedder/embedder.h"
 
 #ifdef SHELL_ENABLE_GL
 #include "flutter/shell/platform/embedder/embedder_external_texture_gl.h"
@@ -25,6 +28,8 @@ class EmbedderExternalTextureResolver {
   ~EmbedderExternalTextureResolver() = default;
 
 #ifdef SHELL_ENABLE_GL
+  // The callback may be empty if the embedder only pushes frames to its
+  // textures.
   explicit EmbedderExternalTextureResolver(
       EmbedderExternalTextureGL::ExternalTextureCallback gl_callback);
 #endif
@@ -38,9 +43,21 @@ class EmbedderExternalTextureResolver {
 
   bool SupportsExternalTextures();
 
+  // Pushes a frame to a texture that was resolved by this resolver. Callable on
+  // any thread.
+  bool PushExternalTextureFrame(int64_t texture_id,
+                                const FlutterExternalTextureFrame& frame);
+
+  void OnTextureUnregistered(int64_t texture_id);
+
  private:
 #ifdef SHELL_ENABLE_GL
+  bool gl_ = false;
   EmbedderExternalTextureGL::ExternalTextureCallback gl_callback_;
+  std::mutex gl_frame_slots_mutex_;
+  std::unordered_map<int64_t,
+                     std::shared_ptr<EmbedderExternalTextureGLFrameSlot>>
+      gl_frame_slots_;
 #endif
 
 #ifdef SHELL_ENABLE_METAL
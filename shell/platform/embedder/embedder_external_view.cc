@@ -31,9 +31,11 @@ EmbedderExternalView::EmbedderExternalView(
       view_identifier_(view_identifier),
       embedded_view_params_(std::move(params)),
       recorder_(std::make_unique<SkPictureRecorder>()),
-      canvas_spy_(std::make_unique<CanvasSpy>(
-          recorder_->beginRecording(frame_size.width(), frame_size.height()))) {
-}
+      // The bounding box hierarchy trims the cull rect of the picture to its
+      // contents, which bounds the damage of the render target.
+      canvas_spy_(std::make_unique<CanvasSpy>(recorder_->beginRecording(
+          SkRect::MakeIWH(frame_size.width(), frame_size.height()),
+          SkRTreeFactory{}()))) {}
 
 EmbedderExternalView::~EmbedderExternalView() = default;
 
@@ -59,7 +61,8 @@ bool EmbedderExternalView::HasPlatformView() const {
 }
 
 bool EmbedderExternalView::HasEngineRenderedContents() const {
-  return canvas_spy_->DidDrawIntoCanvas();
+  return (canvas_spy_->DidDrawIntoCanvas() && !contents_merged_) ||
+         !merged_pictures_.empty();
 }
 
 EmbedderExternalView::ViewIdentifier EmbedderExternalView::GetViewIdentifier()
@@ -71,14 +74,48 @@ const EmbeddedViewParams* EmbedderExternalView::GetEmbeddedViewParams() const {
   return embedded_view_params_.get();
 }
 
-bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
+sk_sp<SkPicture> EmbedderExternalView::GetPicture() {
+  if (!picture_) {
+    picture_ = recorder_->finishRecordingAsPicture();
+  }
+  return picture_;
+}
+
+SkRect EmbedderExternalView::GetContentBounds() {
+  SkRect bounds = SkRect::MakeEmpty();
+  if (canvas_spy_->DidDrawIntoCanvas() && !contents_merged_) {
+    if (auto picture = GetPicture()) {
+      bounds = picture->cullRect();
+    }
+  }
+  for (const auto& merged_picture : merged_pictures_) {
+    bounds.join(merged_picture->cullRect());
+  }
+  return bounds;
+}
+
+void EmbedderExternalView::MergeContents(EmbedderExternalView& view) {
+  FML_DCHECK(&view != this);
+  FML_DCHECK(view.merged_pictures_.empty())
+      << "Contents may only be merged into views lower in the composition "
+         "order than the view they are merged from.";
+  if (!view.HasEngineRenderedContents()) {
+    return;
+  }
+  if (auto picture = view.GetPicture()) {
+    merged_pictures_.push_back(std::move(picture));
+  }
+  view.contents_merged_ = true;
+}
+
+bool EmbedderExternalView::Render(EmbedderRenderTarget& render_target) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
 
   FML_DCHECK(HasEngineRenderedContents())
       << "Unnecessarily asked to render into a render target when there was "
          "nothing to render.";
 
-  auto picture = recorder_->finishRecordingAsPicture();
+  auto picture = GetPicture();
   if (!picture) {
     return false;
   }
@@ -99,8 +136,18 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
   canvas->setMatrix(surface_transformation_);
   canvas->clear(SK_ColorTRANSPARENT);
   canvas->drawPicture(picture);
+  for (const auto& merged_picture : merged_pictures_) {
+    canvas->drawPicture(merged_picture);
+  }
   canvas->flush();
 
+  SkIRect content_bounds =
+      surface_transformation_.mapRect(GetContentBounds()).roundOut();
+  if (!content_bounds.intersect(SkIRect::MakeSize(render_surface_size_))) {
+    content_bounds.setEmpty();
+  }
+  render_target.SetContentBounds(content_bounds);
+
   return true;
 }
 
@@ -8,12 +8,14 @@
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/canvas_spy.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace flutter {
@@ -108,7 +110,23 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
-  bool Render(const EmbedderRenderTarget& render_target);
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of the contents rendered by the engine into this
+  ///             view, including the contents merged into it. Recording into
+  ///             the canvas of the view must be complete.
+  ///
+  SkRect GetContentBounds();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Moves the contents rendered by the engine into another view
+  ///             lower in the composition order on top of the contents of
+  ///             this one, so that the other view no longer needs a render
+  ///             target of its own. Recording into the canvases of both views
+  ///             must be complete.
+  ///
+  void MergeContents(EmbedderExternalView& view);
+
+  bool Render(EmbedderRenderTarget& render_target);
 
  private:
   const SkISize render_surface_size_;
@@ -117,6 +135,11 @@ class EmbedderExternalView {
   std::unique_ptr<EmbeddedViewParams> embedded_view_params_;
   std::unique_ptr<SkPictureRecorder> recorder_;
   std::unique_ptr<CanvasSpy> canvas_spy_;
+  sk_sp<SkPicture> picture_;
+  std::vector<sk_sp<SkPicture>> merged_pictures_;
+  bool contents_merged_ = false;
+
+  sk_sp<SkPicture> GetPicture();
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalView);
 };
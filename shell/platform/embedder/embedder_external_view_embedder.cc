@@ -5,7 +5,9 @@
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 
 #include <algorithm>
+#include <optional>
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -14,9 +16,11 @@ namespace flutter {
 
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    bool merge_non_overlapping_layers,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
+      merge_non_overlapping_layers_(merge_non_overlapping_layers),
       create_render_target_callback_(create_render_target_callback),
       present_callback_(present_callback) {
   FML_DCHECK(create_render_target_callback_);
@@ -133,15 +137,63 @@ static FlutterBackingStoreConfig MakeBackingStoreConfig(
 }
 
 // |ExternalViewEmbedder|
+void EmbedderExternalViewEmbedder::MergeNonOverlappingContents() {
+  TRACE_EVENT0("flutter",
+               "EmbedderExternalViewEmbedder::MergeNonOverlappingContents");
+
+  // The contents of each interleaving level are moved into the lowest level
+  // they may be rendered into without changing what is presented. Moving them
+  // below a level moves them below the platform view and the contents of that
+  // level, so none of those may overlap them. Only the root level and the
+  // levels that still have contents of their own will have a render target.
+  for (size_t i = 1; i < composition_order_.size(); i++) {
+    auto& external_view = pending_views_.at(composition_order_[i]);
+    if (!external_view->HasEngineRenderedContents()) {
+      continue;
+    }
+    const SkRect content_bounds = external_view->GetContentBounds();
+
+    std::optional<size_t> target_level;
+    for (size_t level = i; level > 0; level--) {
+      const auto& level_view = pending_views_.at(composition_order_[level]);
+      if (content_bounds.intersects(
+              level_view->GetEmbeddedViewParams()->finalBoundingRect())) {
+        break;
+      }
+
+      auto& lower_view = pending_views_.at(composition_order_[level - 1]);
+      if (!lower_view->HasEngineRenderedContents()) {
+        if (lower_view->IsRootView()) {
+          target_level = level - 1;
+        }
+        continue;
+      }
+      target_level = level - 1;
+      if (content_bounds.intersects(lower_view->GetContentBounds())) {
+        break;
+      }
+    }
+
+    if (target_level.has_value()) {
+      pending_views_.at(composition_order_[target_level.value()])
+          ->MergeContents(*external_view);
+    }
+  }
+}
+
 void EmbedderExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     std::unique_ptr<SurfaceFrame> frame) {
+  if (merge_non_overlapping_layers_) {
+    MergeNonOverlappingContents();
+  }
+
   auto [matched_render_targets, pending_keys] =
       render_target_cache_.GetExistingTargetsInCache(pending_views_);
 
-  // This is where unused render targets will be collected. Control may flow to
-  // the embedder. Here, the embedder has the opportunity to trample on the
-  // OpenGL context.
+  // This is where render targets that went unused for a few frames will be
+  // collected. Control may flow to the embedder. Here, the embedder has the
+  // opportunity to trample on the OpenGL context.
   //
   // For optimum performance, we should tell the render target cache to clear
   // its unused entries before allocating new ones. This collection step before
@@ -152,7 +204,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.CollectUnusedRenderTargets();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -246,7 +298,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       if (external_view->HasEngineRenderedContents()) {
         const auto& exteral_render_target = matched_render_targets.at(view_id);
         presented_layers.PushBackingStoreLayer(
-            exteral_render_target->GetBackingStore());
+            exteral_render_target->GetBackingStore(),  // backing store
+            exteral_render_target->GetDamage()         // damage
+        );
       }
     }
 
@@ -261,8 +315,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // @warning: Embedder may trample on our OpenGL context here.
   deferred_cleanup_render_targets.clear();
 
-  // Hold all rendered layers in the render target cache for one frame to
-  // see if they may be reused next frame.
+  // Hold all rendered layers in the render target cache for a few frames to
+  // see if they may be reused in the next ones.
   for (auto& render_target : matched_render_targets) {
     if (!avoid_backing_store_cache_) {
       render_target_cache_.CacheRenderTarget(render_target.first,
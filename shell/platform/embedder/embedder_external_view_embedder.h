@@ -44,6 +44,13 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      will beinvoked every frame for every
   ///                                      engine composited layer. The result
   ///                                      will not cached.
+  /// @param[in] merge_non_overlapping_layers
+  ///                                      If set, the contents rendered by the
+  ///                                      engine above a platform view that
+  ///                                      don't overlap the platform views
+  ///                                      below them are rendered into a
+  ///                                      lower layer instead of a layer of
+  ///                                      their own.
   ///
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
@@ -55,6 +62,7 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      bool merge_non_overlapping_layers,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -105,6 +113,7 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
 
  private:
   const bool avoid_backing_store_cache_;
+  const bool merge_non_overlapping_layers_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
@@ -117,6 +126,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
 
   void Reset();
 
+  void MergeNonOverlappingContents();
+
   SkMatrix GetSurfaceTransformation() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalViewEmbedder);
@@ -17,13 +17,30 @@ EmbedderLayers::EmbedderLayers(SkISize frame_size,
 
 EmbedderLayers::~EmbedderLayers() = default;
 
-void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
+void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store,
+                                           std::optional<SkIRect> damage) {
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
   layer.type = kFlutterLayerContentTypeBackingStore;
   layer.backing_store = store;
 
+  auto present_info = std::make_unique<FlutterBackingStorePresentInfo>();
+  present_info->struct_size = sizeof(FlutterBackingStorePresentInfo);
+  present_info->paint_region.struct_size = sizeof(FlutterDamage);
+  if (damage.has_value()) {
+    auto rect = std::make_unique<FlutterRect>();
+    rect->left = damage->left();
+    rect->top = damage->top();
+    rect->right = damage->right();
+    rect->bottom = damage->bottom();
+    present_info->paint_region.num_rects = damage->isEmpty() ? 0 : 1;
+    present_info->paint_region.damage = rect.get();
+    damage_rects_referenced_.push_back(std::move(rect));
+  }
+  layer.backing_store_present_info = present_info.get();
+  present_infos_referenced_.push_back(std::move(present_info));
+
   const auto layer_bounds =
       SkRect::MakeWH(frame_size_.width(), frame_size_.height());
 
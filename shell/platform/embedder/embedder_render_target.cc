@@ -34,4 +34,20 @@ sk_sp<SkSurface> EmbedderRenderTarget::GetRenderSurface() const {
   return render_surface_;
 }
 
+void EmbedderRenderTarget::SetContentBounds(const SkIRect& content_bounds) {
+  if (content_bounds_.has_value()) {
+    SkIRect damage = content_bounds_.value();
+    damage.join(content_bounds);
+    damage_ = damage;
+  } else {
+    damage_ = SkIRect::MakeWH(render_surface_->width(),
+                              render_surface_->height());
+  }
+  content_bounds_ = content_bounds;
+}
+
+std::optional<SkIRect> EmbedderRenderTarget::GetDamage() const {
+  return damage_;
+}
+
 }  // namespace flutter
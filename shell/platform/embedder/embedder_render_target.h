@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_H_
 
+#include <optional>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -65,10 +67,33 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Records the bounds of the contents that were just rendered into
+  ///             the render surface, which is transparent outside of them.
+  ///
+  ///             The area that changed since the previous contents is the union
+  ///             of their bounds, or the whole surface if this is the first
+  ///             time the target is rendered into.
+  ///
+  /// @param[in]  content_bounds  The bounds of the contents, in the
+  ///                             coordinates of the render surface.
+  ///
+  void SetContentBounds(const SkIRect& content_bounds);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The area of the render surface that changed when it was last
+  ///             rendered into.
+  ///
+  /// @return     The damage, or nothing if it's unknown.
+  ///
+  std::optional<SkIRect> GetDamage() const;
+
  private:
   FlutterBackingStore backing_store_;
   sk_sp<SkSurface> render_surface_;
   fml::closure on_release_;
+  std::optional<SkIRect> content_bounds_;
+  std::optional<SkIRect> damage_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTarget);
 };
@@ -4,9 +4,12 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t max_unused_frames)
+    : max_unused_frames_(max_unused_frames) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -17,33 +20,83 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
 
+  // Views that rendered into a target of the same size before get it back
+  // first, so that the pooling doesn't shuffle targets between views.
+  std::vector<EmbedderExternalView::ViewIdentifier> views_without_own_target;
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
     auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.size() == 0) {
-      unmatched_identifiers.insert(view.first);
-    } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+        cached_render_targets_[external_view->GetRenderSurfaceSize()];
+    auto found = std::find_if(
+        compatible_targets.begin(), compatible_targets.end(),
+        [&view](const CachedRenderTarget& cached) {
+          return EmbedderExternalView::ViewIdentifier::Equal{}(
+              cached.view_identifier, view.first);
+        });
+    if (found == compatible_targets.end()) {
+      views_without_own_target.push_back(view.first);
+      continue;
+    }
+    resolved_render_targets[view.first] = std::move(found->target);
+    compatible_targets.erase(found);
+  }
+
+  for (const auto& view_identifier : views_without_own_target) {
+    const auto& external_view = pending_views.at(view_identifier);
+    auto& compatible_targets =
+        cached_render_targets_[external_view->GetRenderSurfaceSize()];
+    if (compatible_targets.empty()) {
+      unmatched_identifiers.insert(view_identifier);
+      continue;
     }
+    // Take the most recently used target.
+    auto found = std::min_element(
+        compatible_targets.begin(), compatible_targets.end(),
+        [](const CachedRenderTarget& lhs, const CachedRenderTarget& rhs) {
+          return lhs.unused_frames < rhs.unused_frames;
+        });
+    resolved_render_targets[view_identifier] = std::move(found->target);
+    compatible_targets.erase(found);
   }
+
   return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
 }
 
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::CollectUnusedRenderTargets() {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> collected_targets;
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end();) {
+    auto& targets = it->second;
+    for (auto& cached : targets) {
+      cached.unused_frames++;
+      if (cached.unused_frames > max_unused_frames_) {
+        collected_targets.emplace(std::move(cached.target));
+      }
+    }
+    targets.erase(std::remove_if(targets.begin(), targets.end(),
+                                 [](const CachedRenderTarget& cached) {
+                                   return cached.target == nullptr;
+                                 }),
+                  targets.end());
+    if (targets.empty()) {
+      it = cached_render_targets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return collected_targets;
+}
+
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
   for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
+    for (auto& cached : targets.second) {
+      cleared_targets.emplace(std::move(cached.target));
     }
   }
   cached_render_targets_.clear();
@@ -57,9 +110,9 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
     return;
   }
   auto surface = target->GetRenderSurface();
-  auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, SkISize::Make(surface->width(), surface->height())};
-  cached_render_targets_[desc].push(std::move(target));
+  auto size = SkISize::Make(surface->width(), surface->height());
+  cached_render_targets_[size].push_back(
+      {view_identifier, std::move(target), 0});
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
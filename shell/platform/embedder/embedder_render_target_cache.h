@@ -6,10 +6,11 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 
@@ -19,9 +20,21 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             The render targets are pooled by size. A view prefers the
+///             target it rendered into in a previous frame, but takes any
+///             cached target of its size otherwise, so that embedders don't
+///             have to create new backing stores when platform views come and
+///             go. Targets that stay unused for more than a few frames are
+///             collected.
+///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  /// The number of frames a render target is kept in the cache without being
+  /// used before it is collected.
+  static constexpr size_t kDefaultMaxUnusedFrames = 2;
+
+  explicit EmbedderRenderTargetCache(
+      size_t max_unused_frames = kDefaultMaxUnusedFrames);
 
   ~EmbedderRenderTargetCache();
 
@@ -35,6 +48,15 @@ class EmbedderRenderTargetCache {
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Ages the render targets that are left in the cache for a
+  ///             frame, and removes the ones that have been unused for too
+  ///             long.
+  ///
+  /// @return     The removed render targets, to be released by the caller.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> CollectUnusedRenderTargets();
+
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
@@ -44,12 +66,23 @@ class EmbedderRenderTargetCache {
   size_t GetCachedTargetsCount() const;
 
  private:
+  struct CachedRenderTarget {
+    // The view that last rendered into the target.
+    EmbedderExternalView::ViewIdentifier view_identifier;
+    std::unique_ptr<EmbedderRenderTarget> target;
+    size_t unused_frames = 0;
+  };
+
+  struct SizeHash {
+    std::size_t operator()(const SkISize& size) const {
+      return fml::HashCombine(size.width(), size.height());
+    }
+  };
+
   using CachedRenderTargets =
-      std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
-                         EmbedderExternalView::RenderTargetDescriptor::Hash,
-                         EmbedderExternalView::RenderTargetDescriptor::Equal>;
+      std::unordered_map<SkISize, std::vector<CachedRenderTarget>, SizeHash>;
 
+  const size_t max_unused_frames_;
   CachedRenderTargets cached_render_targets_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
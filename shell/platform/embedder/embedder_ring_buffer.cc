@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+EmbedderRingBuffer::EmbedderRingBuffer(size_t capacity,
+                                       ReadableCallback readable_callback)
+    : capacity_(capacity),
+      data_(std::make_unique<uint8_t[]>(capacity)),
+      readable_callback_(std::move(readable_callback)) {
+  FML_DCHECK(capacity_ > 0);
+}
+
+EmbedderRingBuffer::~EmbedderRingBuffer() = default;
+
+size_t EmbedderRingBuffer::Write(const uint8_t* data, size_t size) {
+  const uint64_t write_position =
+      write_position_.load(std::memory_order_relaxed);
+  const uint64_t read_position = read_position_.load(std::memory_order_acquire);
+  const size_t free_size = capacity_ - (write_position - read_position);
+  size = std::min(size, free_size);
+  if (size == 0) {
+    return 0;
+  }
+
+  const size_t offset = write_position % capacity_;
+  const size_t first_size = std::min(size, capacity_ - offset);
+  std::memcpy(data_.get() + offset, data, first_size);
+  std::memcpy(data_.get(), data + first_size, size - first_size);
+
+  // Sequentially consistent, so that either the consumer sees the new position
+  // after it armed the callback, or this sees the armed callback.
+  write_position_.store(write_position + size);
+  if (readable_callback_armed_.exchange(false) && readable_callback_) {
+    readable_callback_();
+  }
+  return size;
+}
+
+size_t EmbedderRingBuffer::AcquireRead(size_t* offset) {
+  const uint64_t read_position = read_position_.load(std::memory_order_relaxed);
+  uint64_t write_position = write_position_.load(std::memory_order_acquire);
+  if (write_position == read_position) {
+    readable_callback_armed_.store(true);
+    // A write may have completed before the callback was armed.
+    write_position = write_position_.load();
+    if (write_position == read_position) {
+      return 0;
+    }
+  }
+
+  *offset = read_position % capacity_;
+  return std::min<uint64_t>(write_position - read_position,
+                            capacity_ - *offset);
+}
+
+void EmbedderRingBuffer::ReleaseRead(size_t size) {
+  const uint64_t read_position = read_position_.load(std::memory_order_relaxed);
+  FML_DCHECK(read_position + size <=
+             write_position_.load(std::memory_order_relaxed));
+  read_position_.store(read_position + size, std::memory_order_release);
+}
+
+}  // namespace flutter
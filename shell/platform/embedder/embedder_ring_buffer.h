@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RING_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A single-producer single-consumer ring buffer through which an
+///             embedder thread streams bytes to a Dart isolate without posting
+///             a message for each write.
+///
+///             The consumer reads the bytes in place and is only notified
+///             when the buffer becomes readable after it found it empty, so a
+///             producer that writes faster than the consumer reads doesn't
+///             schedule any work on the consumer thread.
+///
+///             The buffer is shared between the embedder, which writes into
+///             it, and the Dart isolate, which references the bytes through an
+///             external typed data. Either may release it first.
+///
+class EmbedderRingBuffer
+    : public fml::RefCountedThreadSafe<EmbedderRingBuffer> {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      The callback invoked on the producer thread when a write makes
+  ///             the buffer readable after the consumer found it empty.
+  ///
+  using ReadableCallback = std::function<void()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes as many of the bytes as fit in the buffer. Must only be
+  ///             called by the producer.
+  ///
+  /// @return     The number of bytes that were written.
+  ///
+  size_t Write(const uint8_t* data, size_t size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the next contiguous range of readable bytes. Must only be
+  ///             called by the consumer.
+  ///
+  ///             If there are no readable bytes, the next write invokes the
+  ///             readable callback.
+  ///
+  /// @param[out] offset  The offset of the range from the start of the data.
+  ///
+  /// @return     The size of the range, which is zero if the buffer is empty.
+  ///
+  size_t AcquireRead(size_t* offset);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the first bytes of the range returned by the last
+  ///             call to `AcquireRead`, making their space available to the
+  ///             producer. Must only be called by the consumer.
+  ///
+  void ReleaseRead(size_t size);
+
+  uint8_t* GetData() const { return data_.get(); }
+
+  size_t GetCapacity() const { return capacity_; }
+
+ private:
+  const size_t capacity_;
+  const std::unique_ptr<uint8_t[]> data_;
+  const ReadableCallback readable_callback_;
+  // The positions are the total numbers of bytes written and read. They are on
+  // separate cache lines since they are written from different threads.
+  alignas(64) std::atomic<uint64_t> write_position_ = 0;
+  alignas(64) std::atomic<uint64_t> read_position_ = 0;
+  // Whether the consumer found the buffer empty and is waiting for the
+  // readable callback.
+  std::atomic<bool> readable_callback_armed_ = true;
+
+  EmbedderRingBuffer(size_t capacity, ReadableCallback readable_callback);
+
+  ~EmbedderRingBuffer();
+
+  FML_FRIEND_MAKE_REF_COUNTED(EmbedderRingBuffer);
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(EmbedderRingBuffer);
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRingBuffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RING_BUFFER_H_
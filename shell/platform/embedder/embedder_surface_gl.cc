@@ -8,15 +8,58 @@
 
 namespace flutter {
 
+namespace {
+
+// A GL surface that renders with a shared Skia context, which it abandons if
+// it is the last of the surfaces using it to be collected.
+class SharedContextGPUSurfaceGL final : public GPUSurfaceGL {
+ public:
+  SharedContextGPUSurfaceGL(
+      std::shared_ptr<EmbedderSurfaceGL::SharedSkiaContext> shared_context,
+      GPUSurfaceGLDelegate* delegate,
+      bool render_to_surface)
+      : GPUSurfaceGL(shared_context->context, delegate, render_to_surface),
+        shared_context_(std::move(shared_context)),
+        delegate_(delegate) {
+    shared_context_->surface_count++;
+  }
+
+  ~SharedContextGPUSurfaceGL() override {
+    if (--shared_context_->surface_count > 0 || !shared_context_->context) {
+      return;
+    }
+    auto context_switch = delegate_->GLContextMakeCurrent();
+    if (context_switch->GetResult()) {
+      shared_context_->context->releaseResourcesAndAbandonContext();
+    } else {
+      FML_LOG(ERROR) << "Could not make the context current to destroy the "
+                        "shared GrDirectContext resources.";
+    }
+    shared_context_->context = nullptr;
+    delegate_->GLContextClearCurrent();
+  }
+
+ private:
+  const std::shared_ptr<EmbedderSurfaceGL::SharedSkiaContext> shared_context_;
+  GPUSurfaceGLDelegate* const delegate_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedContextGPUSurfaceGL);
+};
+
+}  // namespace
+
 EmbedderSurfaceGL::EmbedderSurfaceGL(
     GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    std::shared_ptr<SharedSkiaContext> shared_skia_context)
     : gl_dispatch_table_(gl_dispatch_table),
       fbo_reset_after_present_(fbo_reset_after_present),
-      external_view_embedder_(external_view_embedder) {
+      external_view_embedder_(external_view_embedder),
+      shared_skia_context_(std::move(shared_skia_context)) {
   // Make sure all required members of the dispatch table are checked.
-  if (!gl_dispatch_table_.gl_make_current_callback ||
+  if (!shared_skia_context_ ||
+      !gl_dispatch_table_.gl_make_current_callback ||
       !gl_dispatch_table_.gl_clear_current_callback ||
       !gl_dispatch_table_.gl_present_callback ||
       !gl_dispatch_table_.gl_fbo_callback) {
@@ -45,8 +88,8 @@ bool EmbedderSurfaceGL::GLContextClearCurrent() {
 }
 
 // |GPUSurfaceGLDelegate|
-bool EmbedderSurfaceGL::GLContextPresent(uint32_t fbo_id) {
-  return gl_dispatch_table_.gl_present_callback(fbo_id);
+bool EmbedderSurfaceGL::GLContextPresent(const GLPresentInfo& present_info) {
+  return gl_dispatch_table_.gl_present_callback(present_info);
 }
 
 // |GPUSurfaceGLDelegate|
@@ -59,6 +102,16 @@ bool EmbedderSurfaceGL::GLContextFBOResetAfterPresent() const {
   return fbo_reset_after_present_;
 }
 
+// |GPUSurfaceGLDelegate|
+std::optional<SkIRect> EmbedderSurfaceGL::GLContextFBOExistingDamage(
+    intptr_t fbo_id) const {
+  auto callback = gl_dispatch_table_.gl_populate_existing_damage;
+  if (!callback) {
+    return std::nullopt;
+  }
+  return callback(fbo_id);
+}
+
 // |GPUSurfaceGLDelegate|
 SkMatrix EmbedderSurfaceGL::GLContextSurfaceTransformation() const {
   auto callback = gl_dispatch_table_.gl_surface_transformation_callback;
@@ -78,8 +131,13 @@ EmbedderSurfaceGL::GLProcResolver EmbedderSurfaceGL::GetGLProcResolver() const {
 // |EmbedderSurface|
 std::unique_ptr<Surface> EmbedderSurfaceGL::CreateGPUSurface() {
   const bool render_to_surface = !external_view_embedder_;
-  return std::make_unique<GPUSurfaceGL>(this,  // GPU surface GL delegate
-                                        render_to_surface  // render to surface
+  if (!shared_skia_context_->context) {
+    shared_skia_context_->context = GPUSurfaceGL::MakeGLContext(this);
+  }
+  return std::make_unique<SharedContextGPUSurfaceGL>(
+      shared_skia_context_,  // shared Skia context
+      this,                  // GPU surface GL delegate
+      render_to_surface      // render to surface
   );
 }
 
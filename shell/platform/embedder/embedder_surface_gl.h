@@ -18,18 +18,32 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   struct GLDispatchTable {
     std::function<bool(void)> gl_make_current_callback;           // required
     std::function<bool(void)> gl_clear_current_callback;          // required
-    std::function<bool(uint32_t)> gl_present_callback;            // required
+    std::function<bool(GLPresentInfo)> gl_present_callback;       // required
     std::function<intptr_t(GLFrameInfo)> gl_fbo_callback;         // required
     std::function<bool(void)> gl_make_resource_current_callback;  // optional
     std::function<SkMatrix(void)>
         gl_surface_transformation_callback;              // optional
     std::function<void*(const char*)> gl_proc_resolver;  // optional
+    std::function<std::optional<SkIRect>(intptr_t)>
+        gl_populate_existing_damage;  // optional
+  };
+
+  // The Skia context that the surfaces of an engine, and of the engines
+  // spawned from it that opted into sharing it, render with. It is created
+  // by the first of the surfaces to be set up and abandoned when the last of
+  // them is collected, so that the raster and GPU resource caches can be
+  // shared by all of the engines. Only accessed on the raster thread, which
+  // spawned engines share.
+  struct SharedSkiaContext {
+    sk_sp<GrDirectContext> context;
+    size_t surface_count = 0;
   };
 
   EmbedderSurfaceGL(
       GLDispatchTable gl_dispatch_table,
       bool fbo_reset_after_present,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<SharedSkiaContext> shared_skia_context);
 
   ~EmbedderSurfaceGL() override;
 
@@ -39,6 +53,7 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   bool fbo_reset_after_present_;
 
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  std::shared_ptr<SharedSkiaContext> shared_skia_context_;
 
   // |EmbedderSurface|
   bool IsValid() const override;
@@ -56,7 +71,7 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   bool GLContextClearCurrent() override;
 
   // |GPUSurfaceGLDelegate|
-  bool GLContextPresent(uint32_t fbo_id) override;
+  bool GLContextPresent(const GLPresentInfo& present_info) override;
 
   // |GPUSurfaceGLDelegate|
   intptr_t GLContextFBO(GLFrameInfo frame_info) const override;
@@ -64,6 +79,10 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   // |GPUSurfaceGLDelegate|
   bool GLContextFBOResetAfterPresent() const override;
 
+  // |GPUSurfaceGLDelegate|
+  std::optional<SkIRect> GLContextFBOExistingDamage(
+      intptr_t fbo_id) const override;
+
   // |GPUSurfaceGLDelegate|
   SkMatrix GLContextSurfaceTransformation() const override;
 
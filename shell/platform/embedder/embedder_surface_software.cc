@@ -63,6 +63,8 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return sk_surface_;
   }
 
+  sk_surface_has_last_frame_ = false;
+
   SkImageInfo info = SkImageInfo::MakeN32(
       size.fWidth, size.fHeight, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
   sk_surface_ = SkSurface::MakeRaster(info, nullptr);
@@ -78,6 +80,32 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
 // |GPUSurfaceSoftwareDelegate|
 bool EmbedderSurfaceSoftware::PresentBackingStore(
     sk_sp<SkSurface> backing_store) {
+  return Present(std::move(backing_store), std::nullopt);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+std::optional<SkIRect>
+EmbedderSurfaceSoftware::GetBackingStoreExistingDamage() {
+  if (!sk_surface_has_last_frame_) {
+    return std::nullopt;
+  }
+  // The frame that is about to be rendered only differs from the contents of
+  // the backing store by the damage of the new frame. Until it has been
+  // presented, the backing store can't be assumed to hold a whole frame.
+  sk_surface_has_last_frame_ = false;
+  return SkIRect::MakeEmpty();
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::vector<SkIRect>& damage_rects) {
+  return Present(std::move(backing_store), damage_rects);
+}
+
+bool EmbedderSurfaceSoftware::Present(
+    sk_sp<SkSurface> backing_store,
+    std::optional<std::vector<SkIRect>> frame_damage) {
   if (!IsValid()) {
     FML_LOG(ERROR) << "Tried to present an invalid software surface.";
     return false;
@@ -99,11 +127,16 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
-  return software_dispatch_table_.software_present_backing_store(
-      pixmap.addr(),      //
-      pixmap.rowBytes(),  //
-      pixmap.height()     //
-  );
+  SoftwarePresentInfo present_info = {
+      pixmap.addr(),           // allocation
+      pixmap.rowBytes(),       // row bytes
+      pixmap.height(),         // height
+      std::move(frame_damage)  // frame damage
+  };
+  const bool presented =
+      software_dispatch_table_.software_present_backing_store(present_info);
+  sk_surface_has_last_frame_ = presented && backing_store == sk_surface_;
+  return presented;
 }
 
 }  // namespace flutter
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include <optional>
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
@@ -15,8 +18,18 @@ namespace flutter {
 class EmbedderSurfaceSoftware final : public EmbedderSurface,
                                       public GPUSurfaceSoftwareDelegate {
  public:
+  struct SoftwarePresentInfo {
+    const void* allocation;
+    size_t row_bytes;
+    size_t height;
+
+    // The rects of the buffer that changed since the previous frame, with the
+    // origin at the top left. If this is not set, the whole buffer changed.
+    std::optional<std::vector<SkIRect>> frame_damage;
+  };
+
   struct SoftwareDispatchTable {
-    std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
+    std::function<bool(const SoftwarePresentInfo&)>
         software_present_backing_store;  // required
   };
 
@@ -30,6 +43,9 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
+  // Whether |sk_surface_| still holds the last frame that was presented, in
+  // which case only the areas that changed since then need to be repainted.
+  bool sk_surface_has_last_frame_ = false;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
   // |EmbedderSurface|
@@ -47,6 +63,17 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  std::optional<SkIRect> GetBackingStoreExistingDamage() override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::vector<SkIRect>& damage_rects) override;
+
+  bool Present(sk_sp<SkSurface> backing_store,
+               std::optional<std::vector<SkIRect>> frame_damage);
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
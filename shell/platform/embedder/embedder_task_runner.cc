@@ -16,7 +16,8 @@ EmbedderTaskRunner::EmbedderTaskRunner(DispatchTable table,
       dispatch_table_(std::move(table)),
       placeholder_id_(
           fml::MessageLoopTaskQueues::GetInstance()->CreateTaskQueue()) {
-  FML_DCHECK(dispatch_table_.post_task_callback);
+  FML_DCHECK(dispatch_table_.post_task_callback ||
+             dispatch_table_.wake_callback);
   FML_DCHECK(dispatch_table_.runs_task_on_current_thread_callback);
 }
 
@@ -36,6 +37,23 @@ void EmbedderTaskRunner::PostTaskForTime(const fml::closure& task,
     return;
   }
 
+  if (dispatch_table_.wake_callback) {
+    bool wake = false;
+    {
+      // Release the lock before the jump via the dispatch table.
+      std::scoped_lock lock(tasks_mutex_);
+      queued_tasks_.push({target_time, ++last_baton_, task});
+      if (target_time < wake_target_time_) {
+        wake_target_time_ = target_time;
+        wake = true;
+      }
+    }
+    if (wake) {
+      dispatch_table_.wake_callback(this, target_time);
+    }
+    return;
+  }
+
   uint64_t baton = 0;
 
   {
@@ -78,6 +96,38 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
   return true;
 }
 
+bool EmbedderTaskRunner::RunExpiredTasks(fml::TimePoint* next_target_time) {
+  if (!dispatch_table_.wake_callback) {
+    FML_LOG(ERROR) << "Embedder attempted to run the expired tasks of a task "
+                      "runner without a wake callback.";
+    return false;
+  }
+
+  std::vector<fml::closure> expired_tasks;
+
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    const auto now = fml::TimePoint::Now();
+    while (!queued_tasks_.empty() && queued_tasks_.top().target_time <= now) {
+      expired_tasks.push_back(queued_tasks_.top().task);
+      queued_tasks_.pop();
+    }
+    // The embedder is told of the next target time by the return value.
+    wake_target_time_ = queued_tasks_.empty() ? fml::TimePoint::Max()
+                                              : queued_tasks_.top().target_time;
+    if (next_target_time) {
+      *next_target_time = wake_target_time_;
+    }
+
+    // Let go of the tasks mutex befor executing the tasks.
+  }
+
+  for (const auto& task : expired_tasks) {
+    task();
+  }
+  return true;
+}
+
 // |fml::TaskRunner|
 fml::TaskQueueId EmbedderTaskRunner::GetTaskQueueId() {
   return placeholder_id_;
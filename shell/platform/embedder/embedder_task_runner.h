@@ -6,7 +6,9 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 
 #include <mutex>
+#include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
@@ -39,6 +41,18 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
     /// thread.
     ///
     std::function<bool(void)> runs_task_on_current_thread_callback;
+    //--------------------------------------------------------------------------
+    /// Optional. If specified, the tasks are kept in a queue of the task
+    /// runner, sorted by target time, instead of being handed to the embedder
+    /// one by one via the `post_task_callback`. This callback is invoked when
+    /// the earliest target time of the queued tasks becomes earlier than the
+    /// one the embedder knows of. The embedder must then call
+    /// `EmbedderTaskRunner::RunExpiredTasks` on the correct thread at that
+    /// time.
+    ///
+    std::function<void(EmbedderTaskRunner* task_runner,
+                       fml::TimePoint target_time)>
+        wake_callback;
   };
 
   //----------------------------------------------------------------------------
@@ -71,12 +85,46 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
 
   bool PostTask(uint64_t baton);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the queued tasks whose target time has expired, in
+  ///             target time order. Only valid if the dispatch table has a
+  ///             `wake_callback`. Tasks posted by these tasks are run by the
+  ///             next call.
+  ///
+  /// @param[out] next_target_time  The target time of the earliest task still
+  ///                               queued, or `fml::TimePoint::Max()` if there
+  ///                               is none. The wake callback isn't invoked
+  ///                               for this time. May be null.
+  ///
+  /// @return     If the tasks could be run.
+  ///
+  bool RunExpiredTasks(fml::TimePoint* next_target_time);
+
  private:
+  struct QueuedTask {
+    fml::TimePoint target_time;
+    uint64_t order;
+    fml::closure task;
+
+    struct Later {
+      bool operator()(const QueuedTask& lhs, const QueuedTask& rhs) const {
+        return lhs.target_time == rhs.target_time
+                   ? lhs.order > rhs.order
+                   : lhs.target_time > rhs.target_time;
+      }
+    };
+  };
+
   const size_t embedder_identifier_;
   DispatchTable dispatch_table_;
   std::mutex tasks_mutex_;
   uint64_t last_baton_;
   std::unordered_map<uint64_t, fml::closure> pending_tasks_;
+  std::priority_queue<QueuedTask, std::vector<QueuedTask>, QueuedTask::Later>
+      queued_tasks_;
+  // The earliest target time that the embedder was told to run the expired
+  // tasks at.
+  fml::TimePoint wake_target_time_ = fml::TimePoint::Max();
   fml::TaskQueueId placeholder_id_;
 
   // |fml::TaskRunner|
@@ -42,7 +42,10 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
     return {false, {}};
   }
 
-  if (SAFE_ACCESS(description, post_task_callback, nullptr) == nullptr) {
+  auto wake_callback_c = SAFE_ACCESS(description, wake_callback, nullptr);
+
+  if (SAFE_ACCESS(description, post_task_callback, nullptr) == nullptr &&
+      wake_callback_c == nullptr) {
     FML_LOG(ERROR)
         << "FlutterTaskRunnerDescription.post_task_callback was nullptr.";
     return {false, {}};
@@ -72,7 +75,20 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
       // runs_task_on_current_thread_callback
       [runs_task_on_current_thread_callback_c, user_data]() -> bool {
         return runs_task_on_current_thread_callback_c(user_data);
-      }};
+      },
+      // wake_callback
+      nullptr,
+  };
+
+  if (wake_callback_c) {
+    task_runner_dispatch_table.post_task_callback = nullptr;
+    task_runner_dispatch_table.wake_callback =
+        [wake_callback_c, user_data](EmbedderTaskRunner* task_runner,
+                                     fml::TimePoint target_time) -> void {
+      wake_callback_c(reinterpret_cast<FlutterTaskRunner>(task_runner),
+                      target_time.ToEpochDelta().ToNanoseconds(), user_data);
+    };
+  }
 
   return {true, fml::MakeRefCounted<EmbedderTaskRunner>(
                     task_runner_dispatch_table,
@@ -270,4 +286,14 @@ bool EmbedderThreadHost::PostTask(int64_t runner, uint64_t task) const {
   return found->second->PostTask(task);
 }
 
+bool EmbedderThreadHost::RunExpiredTasks(
+    int64_t runner,
+    fml::TimePoint* next_target_time) const {
+  auto found = runners_map_.find(runner);
+  if (found == runners_map_.end()) {
+    return false;
+  }
+  return found->second->RunExpiredTasks(next_target_time);
+}
+
 }  // namespace flutter
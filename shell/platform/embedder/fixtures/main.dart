@@ -885,6 +885,26 @@ void compositor_can_post_only_platform_views() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+void can_merge_non_overlapping_layers() {
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset(0.0, 0.0), CreateColoredBox(Color.fromARGB(255, 255, 0, 0), Size(50.0, 50.0)));
+    builder.pushOffset(100.0, 0.0);
+    builder.addPlatformView(42, width: 50.0, height: 50.0);
+    builder.pop();
+    // Does not overlap platform view 42, so drawn into the root layer.
+    builder.addPicture(Offset(200.0, 0.0), CreateColoredBox(Color.fromARGB(255, 0, 0, 255), Size(50.0, 50.0)));
+    builder.pushOffset(0.0, 100.0);
+    builder.addPlatformView(24, width: 50.0, height: 50.0);
+    builder.pop();
+    // Overlaps platform view 24, so drawn into a layer of its own.
+    builder.addPicture(Offset(0.0, 100.0), CreateColoredBox(Color.fromARGB(255, 0, 255, 0), Size(50.0, 50.0)));
+    PlatformDispatcher.instance.views.first.render(builder.build());
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 void render_targets_are_recycled() {
   int frame_count = 0;
@@ -968,3 +988,56 @@ void invalid_backingstore() {
   };
   PlatformDispatcher.instance.scheduleFrame();
 }
+
+/// Paints a scene that changes on every frame and follows the pointer, and
+/// schedules the next frame as soon as the current one is drawn, for
+/// //flutter/shell/platform/embedder/tests/embedder_frame_benchmarks.cc.
+@pragma('vm:entry-point')
+void frame_benchmark() {
+  Offset pointer = Offset.zero;
+  bool pointerDown = false;
+  int frame = 0;
+  PlatformDispatcher.instance.onPointerDataPacket = (PointerDataPacket packet) {
+    for (final PointerData data in packet.data) {
+      pointer = Offset(data.physicalX, data.physicalY);
+      pointerDown = data.change == PointerChange.down ||
+          data.change == PointerChange.move;
+    }
+  };
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    final Size size = PlatformDispatcher.instance.views.first.physicalSize;
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    final Paint paint = Paint();
+    canvas.drawRect(Offset.zero & size, paint..color = Color(0xFFFFFFFF));
+    // A grid of rotating tiles, so that every frame rasterizes something new.
+    const double tile = 40.0;
+    for (double y = 0.0; y < size.height; y += tile) {
+      for (double x = 0.0; x < size.width; x += tile) {
+        canvas.save();
+        canvas.translate(x + tile / 2, y + tile / 2);
+        canvas.rotate((frame + x + y) / 60.0);
+        paint.color = Color.fromARGB(255, x.toInt() % 256, y.toInt() % 256,
+            (frame * 4) % 256);
+        canvas.drawRRect(
+            RRect.fromRectAndRadius(
+                Rect.fromCenter(
+                    center: Offset.zero, width: tile * 0.7, height: tile * 0.7),
+                Radius.circular(tile / 8)),
+            paint);
+        canvas.restore();
+      }
+    }
+    if (pointerDown) {
+      canvas.drawCircle(pointer, 60.0, paint..color = Color(0x800000FF));
+    }
+    final SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset.zero, recorder.endRecording());
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    frame++;
+  };
+  PlatformDispatcher.instance.onDrawFrame = () {
+    PlatformDispatcher.instance.scheduleFrame();
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
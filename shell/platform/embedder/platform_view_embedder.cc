@@ -26,14 +26,22 @@ PlatformViewEmbedder::PlatformViewEmbedder(
     EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
     PlatformDispatchTable platform_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    std::shared_ptr<EmbedderSurfaceGL::SharedSkiaContext> shared_skia_context)
     : PlatformView(delegate, std::move(task_runners)),
       external_view_embedder_(external_view_embedder),
+      shared_skia_context_(std::move(shared_skia_context)),
       embedder_surface_(
           std::make_unique<EmbedderSurfaceGL>(gl_dispatch_table,
                                               fbo_reset_after_present,
-                                              external_view_embedder_)),
+                                              external_view_embedder_,
+                                              shared_skia_context_)),
       platform_dispatch_table_(platform_dispatch_table) {}
+
+std::shared_ptr<EmbedderSurfaceGL::SharedSkiaContext>
+PlatformViewEmbedder::GetSharedSkiaContext() const {
+  return shared_skia_context_;
+}
 #endif
 
 #ifdef SHELL_ENABLE_METAL
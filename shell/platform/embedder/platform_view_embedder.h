@@ -66,7 +66,9 @@ class PlatformViewEmbedder final : public PlatformView {
       EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
       bool fbo_reset_after_present,
       PlatformDispatchTable platform_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<EmbedderSurfaceGL::SharedSkiaContext>
+          shared_skia_context);
 #endif
 
 #ifdef SHELL_ENABLE_METAL
@@ -89,8 +91,19 @@ class PlatformViewEmbedder final : public PlatformView {
   // |PlatformView|
   void HandlePlatformMessage(std::unique_ptr<PlatformMessage> message) override;
 
+#ifdef SHELL_ENABLE_GL
+  // The Skia context that the OpenGL surfaces of this platform view render
+  // with, or null if the platform view does not render with OpenGL. Engines
+  // spawned from this one may render with it too.
+  std::shared_ptr<EmbedderSurfaceGL::SharedSkiaContext> GetSharedSkiaContext()
+      const;
+#endif
+
  private:
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+#ifdef SHELL_ENABLE_GL
+  std::shared_ptr<EmbedderSurfaceGL::SharedSkiaContext> shared_skia_context_;
+#endif
   std::unique_ptr<EmbedderSurface> embedder_surface_;
   PlatformDispatchTable platform_dispatch_table_;
 
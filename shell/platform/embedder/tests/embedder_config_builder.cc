@@ -154,6 +154,48 @@ void EmbedderConfigBuilder::SetOpenGLPresentCallBack() {
 #endif
 }
 
+void EmbedderConfigBuilder::SetOpenGLPopulateExistingDamageCallBack() {
+#ifdef SHELL_ENABLE_GL
+  // SetOpenGLRendererConfig must be called before this.
+  FML_CHECK(renderer_config_.type == FlutterRendererType::kOpenGL);
+  renderer_config_.open_gl.populate_existing_damage =
+      [](void* context, intptr_t fbo_id, FlutterDamage* existing_damage) {
+        reinterpret_cast<EmbedderTestContextGL*>(context)
+            ->GLPopulateExistingDamage(fbo_id, existing_damage);
+      };
+#endif
+}
+
+void EmbedderConfigBuilder::SetOpenGLShareSkiaContextWithSpawner() {
+#ifdef SHELL_ENABLE_GL
+  // SetOpenGLRendererConfig must be called before this.
+  FML_CHECK(renderer_config_.type == FlutterRendererType::kOpenGL);
+  renderer_config_.open_gl.share_skia_context_with_spawner = true;
+#endif
+}
+
+void EmbedderConfigBuilder::SetSoftwarePresentWithInfoCallBack() {
+  // SetSoftwareRendererConfig must be called before this.
+  FML_CHECK(renderer_config_.type == FlutterRendererType::kSoftware);
+  renderer_config_.software.surface_present_callback = nullptr;
+  renderer_config_.software.surface_present_with_info_callback =
+      [](void* context, const FlutterSoftwarePresentInfo* present_info) {
+        auto image_info = SkImageInfo::MakeN32Premul(SkISize::Make(
+            present_info->row_bytes / 4, present_info->height));
+        SkBitmap bitmap;
+        if (!bitmap.installPixels(image_info,
+                                  const_cast<void*>(present_info->allocation),
+                                  present_info->row_bytes)) {
+          FML_LOG(ERROR) << "Could not copy pixels for the software "
+                            "composition from the engine.";
+          return false;
+        }
+        bitmap.setImmutable();
+        return reinterpret_cast<EmbedderTestContextSoftware*>(context)->Present(
+            SkImage::MakeFromBitmap(bitmap));
+      };
+}
+
 void EmbedderConfigBuilder::SetOpenGLRendererConfig(SkISize surface_size) {
 #ifdef SHELL_ENABLE_GL
   renderer_config_.type = FlutterRendererType::kOpenGL;
@@ -62,6 +62,19 @@ class EmbedderConfigBuilder {
   // test this behavior.
   void SetOpenGLPresentCallBack();
 
+  // Used to set an `open_gl.populate_existing_damage` that forwards to the
+  // callback of the test context, so that frames only redraw their damage.
+  void SetOpenGLPopulateExistingDamageCallBack();
+
+  // Used to set `open_gl.share_skia_context_with_spawner`, so that an engine
+  // spawned from another renders with the Skia context of its spawner.
+  void SetOpenGLShareSkiaContextWithSpawner();
+
+  // Used to explicitly set a `software.surface_present_with_info_callback`
+  // instead of the `software.surface_present_callback` set by the ctor for
+  // this class.
+  void SetSoftwarePresentWithInfoCallBack();
+
   void SetAssetsPath();
 
   void SetSnapshots();
@@ -0,0 +1,212 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Benchmarks of whole frames, from the vsync to the presentation of the frame
+// on the surface, of an engine that is run through the embedder API.
+//
+// The vsync is faked so that the frames are produced in lockstep: the vsync
+// that an engine requests is only fired once its previous frame was presented.
+// Each iteration of a benchmark is one frame. The time of the iteration is the
+// time from the vsync to the presentation, and the percentiles of the build and
+// raster times that the engine measured are reported as counters, in
+// microseconds.
+
+#define FML_USED_ON_EMBEDDER
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr int kSurfaceWidth = 800;
+constexpr int kSurfaceHeight = 600;
+constexpr uint64_t kFrameIntervalNanos = 1000000000 / 60;
+// The number of frames of a pointer drag, from the down to the up.
+constexpr int kDragFrameCount = 60;
+
+// Holds the baton of the vsync that the engine requested until the benchmark
+// fires it.
+class FakeVsyncSource {
+ public:
+  void OnVsyncRequested(intptr_t baton) {
+    {
+      std::scoped_lock lock(mutex_);
+      baton_ = baton;
+    }
+    requested_.Signal();
+  }
+
+  intptr_t WaitForVsyncRequest() {
+    requested_.Wait();
+    std::scoped_lock lock(mutex_);
+    return baton_;
+  }
+
+ private:
+  std::mutex mutex_;
+  intptr_t baton_ = 0;
+  fml::AutoResetWaitableEvent requested_;
+};
+
+// The pointer event of the given frame of a drag across the surface.
+FlutterPointerEvent GetDragEvent(int frame) {
+  const int step = frame % kDragFrameCount;
+  FlutterPointerEvent event = {};
+  event.struct_size = sizeof(event);
+  if (step == 0) {
+    event.phase = kDown;
+  } else if (step == kDragFrameCount - 1) {
+    event.phase = kUp;
+  } else {
+    event.phase = kMove;
+  }
+  event.timestamp = FlutterEngineGetCurrentTime() / 1000;
+  event.x = kSurfaceWidth * (step + 0.5) / kDragFrameCount;
+  event.y = kSurfaceHeight / 2.0;
+  event.device_kind = kFlutterPointerDeviceKindTouch;
+  return event;
+}
+
+class FrameBenchmarkEngine {
+ public:
+  FrameBenchmarkEngine()
+      : platform_thread_("io.flutter.bench.platform"),
+        context_(GetFixturesPath()) {
+    context_.SetVsyncCallback(
+        [this](intptr_t baton) { vsync_.OnVsyncRequested(baton); });
+
+    fml::AutoResetWaitableEvent launched;
+    platform_thread_.GetTaskRunner()->PostTask([&]() {
+      EmbedderConfigBuilder builder(context_);
+      builder.SetSoftwareRendererConfig(
+          SkISize::Make(kSurfaceWidth, kSurfaceHeight));
+      builder.SetupVsyncCallback();
+      builder.SetDartEntrypoint("frame_benchmark");
+      engine_ = builder.LaunchEngine();
+      FML_CHECK(engine_.is_valid());
+
+      FlutterWindowMetricsEvent event = {};
+      event.struct_size = sizeof(event);
+      event.width = kSurfaceWidth;
+      event.height = kSurfaceHeight;
+      event.pixel_ratio = 1.0;
+      FML_CHECK(FlutterEngineSendWindowMetricsEvent(engine_.get(), &event) ==
+                kSuccess);
+      launched.Signal();
+    });
+    launched.Wait();
+  }
+
+  ~FrameBenchmarkEngine() {
+    fml::AutoResetWaitableEvent shut_down;
+    platform_thread_.GetTaskRunner()->PostTask([&]() {
+      engine_.reset();
+      shut_down.Signal();
+    });
+    shut_down.Wait();
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fires the vsync that the engine requested, and waits for the
+  ///             frame to be presented.
+  ///
+  /// @return     The time from the vsync to the presentation, in nanoseconds.
+  ///
+  uint64_t PumpFrame(const FlutterPointerEvent* pointer_event) {
+    const intptr_t baton = vsync_.WaitForVsyncRequest();
+
+    fml::AutoResetWaitableEvent presented;
+    context_.SetNextSceneCallback(
+        [&presented](sk_sp<SkImage> image) { presented.Signal(); });
+
+    if (pointer_event) {
+      FML_CHECK(FlutterEngineSendPointerEvent(engine_.get(), pointer_event,
+                                              1) == kSuccess);
+    }
+    const uint64_t vsync_time = FlutterEngineGetCurrentTime();
+    FML_CHECK(FlutterEngineOnVsync(engine_.get(), baton, vsync_time,
+                                   vsync_time + kFrameIntervalNanos) ==
+              kSuccess);
+    presented.Wait();
+    return FlutterEngineGetCurrentTime() - vsync_time;
+  }
+
+  FlutterFrameTimingStatistics GetFrameTimingStatistics() {
+    FlutterFrameTimingStatistics statistics = {};
+    statistics.struct_size = sizeof(statistics);
+    FML_CHECK(FlutterEngineGetFrameTimingStatistics(
+                  engine_.get(), &statistics) == kSuccess);
+    return statistics;
+  }
+
+ private:
+  fml::Thread platform_thread_;
+  EmbedderTestContextSoftware context_;
+  FakeVsyncSource vsync_;
+  UniqueEngine engine_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameBenchmarkEngine);
+};
+
+void ReportPercentiles(benchmark::State& state,
+                       const char* phase,
+                       const FlutterFrameTimingPercentiles& percentiles) {
+  const std::string prefix = phase;
+  state.counters[prefix + "_p50_micros"] = percentiles.p50_nanos / 1000.0;
+  state.counters[prefix + "_p90_micros"] = percentiles.p90_nanos / 1000.0;
+  state.counters[prefix + "_p99_micros"] = percentiles.p99_nanos / 1000.0;
+  state.counters[prefix + "_max_micros"] = percentiles.max_nanos / 1000.0;
+}
+
+}  // namespace
+
+static void BM_EmbedderFrames(benchmark::State& state, bool drag) {
+  FrameBenchmarkEngine engine;
+  // The first frame isn't representative of the others, it also warms up the
+  // isolate.
+  engine.PumpFrame(nullptr);
+
+  int frame = 0;
+  for (auto _ : state) {
+    FlutterPointerEvent pointer_event = {};
+    if (drag) {
+      pointer_event = GetDragEvent(frame);
+    }
+    const uint64_t frame_nanos = engine.PumpFrame(drag ? &pointer_event
+                                                       : nullptr);
+    state.SetIterationTime(frame_nanos / 1e9);
+    frame++;
+  }
+
+  const FlutterFrameTimingStatistics statistics =
+      engine.GetFrameTimingStatistics();
+  ReportPercentiles(state, "build", statistics.build);
+  ReportPercentiles(state, "raster", statistics.raster);
+  ReportPercentiles(state, "total", statistics.total);
+  state.counters["janky_frames"] = statistics.janky_frame_count;
+  state.counters["missed_vsyncs"] = statistics.missed_vsync_count;
+}
+
+BENCHMARK_CAPTURE(BM_EmbedderFrames, Animation, false)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_EmbedderFrames, AnimationWithDrag, true)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace testing
+}  // namespace flutter
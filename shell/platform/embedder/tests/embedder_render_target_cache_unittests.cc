@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+std::unique_ptr<EmbedderRenderTarget> MakeRenderTarget(const SkISize& size,
+                                                       size_t* released) {
+  return std::make_unique<EmbedderRenderTarget>(
+      FlutterBackingStore{}, SkSurface::MakeRasterN32Premul(size.width(),
+                                                            size.height()),
+      [released]() { (*released)++; });
+}
+
+std::unique_ptr<EmbedderExternalView> MakeViewWithContents(
+    const SkISize& frame_size,
+    EmbedderExternalView::ViewIdentifier view_identifier) {
+  auto view = std::make_unique<EmbedderExternalView>(
+      frame_size, SkMatrix::I(), view_identifier,
+      std::make_unique<EmbeddedViewParams>());
+  view->GetCanvas()->drawRect(SkRect::MakeXYWH(10, 10, 20, 20), SkPaint());
+  return view;
+}
+}  // namespace
+
+TEST(EmbedderRenderTargetCacheTest, ViewsTakeCachedTargetsOfTheirSize) {
+  const SkISize frame_size = SkISize::Make(100, 100);
+  size_t released = 0;
+  EmbedderRenderTargetCache cache;
+  auto target = MakeRenderTarget(frame_size, &released);
+  auto* target_pointer = target.get();
+  cache.CacheRenderTarget(1, std::move(target));
+
+  // The target of view 1 is pooled and given to view 2.
+  EmbedderExternalView::PendingViews pending_views;
+  pending_views[2] = MakeViewWithContents(frame_size, 2);
+  auto [matched_targets, unmatched_views] =
+      cache.GetExistingTargetsInCache(pending_views);
+  ASSERT_EQ(matched_targets.size(), 1u);
+  EXPECT_EQ(matched_targets[2].get(), target_pointer);
+  EXPECT_TRUE(unmatched_views.empty());
+
+  // The targets of other sizes aren't.
+  cache.CacheRenderTarget(2, std::move(matched_targets[2]));
+  pending_views.clear();
+  pending_views[2] = MakeViewWithContents(SkISize::Make(50, 50), 2);
+  auto [other_matched_targets, other_unmatched_views] =
+      cache.GetExistingTargetsInCache(pending_views);
+  EXPECT_TRUE(other_matched_targets.empty());
+  EXPECT_EQ(other_unmatched_views.size(), 1u);
+  EXPECT_EQ(released, 0u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, CollectsTargetsThatStayUnused) {
+  size_t released = 0;
+  EmbedderRenderTargetCache cache(/*max_unused_frames=*/2);
+  cache.CacheRenderTarget(1, MakeRenderTarget(SkISize::Make(10, 10), &released));
+
+  EXPECT_TRUE(cache.CollectUnusedRenderTargets().empty());
+  EXPECT_TRUE(cache.CollectUnusedRenderTargets().empty());
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+
+  cache.CollectUnusedRenderTargets();
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+  EXPECT_EQ(released, 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, RenderTargetDamageCoversOldAndNewContents) {
+  const SkISize frame_size = SkISize::Make(100, 100);
+  size_t released = 0;
+  auto target = MakeRenderTarget(frame_size, &released);
+  EXPECT_FALSE(target->GetDamage().has_value());
+
+  // The whole target is damaged the first time it's rendered into.
+  auto view = MakeViewWithContents(frame_size, 1);
+  ASSERT_TRUE(view->Render(*target));
+  EXPECT_EQ(target->GetDamage(), SkIRect::MakeWH(100, 100));
+
+  view = std::make_unique<EmbedderExternalView>(
+      frame_size, SkMatrix::I(), 1, std::make_unique<EmbeddedViewParams>());
+  view->GetCanvas()->drawRect(SkRect::MakeXYWH(50, 50, 10, 10), SkPaint());
+  ASSERT_TRUE(view->Render(*target));
+  EXPECT_EQ(target->GetDamage(), SkIRect::MakeLTRB(10, 10, 60, 60));
+}
+
+}  // namespace testing
+}  // namespace flutter
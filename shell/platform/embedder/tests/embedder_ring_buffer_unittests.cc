@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_ring_buffer.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(EmbedderRingBufferTest, WritesWrapAroundTheEndOfTheBuffer) {
+  auto ring_buffer = fml::MakeRefCounted<EmbedderRingBuffer>(8, nullptr);
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  ASSERT_EQ(ring_buffer->Write(data, 6), 6u);
+
+  size_t offset = 0;
+  ASSERT_EQ(ring_buffer->AcquireRead(&offset), 6u);
+  EXPECT_EQ(offset, 0u);
+  ring_buffer->ReleaseRead(4);
+
+  // Only the free space is written into.
+  ASSERT_EQ(ring_buffer->Write(data, 6), 6u);
+  ASSERT_EQ(ring_buffer->Write(data, 6), 0u);
+
+  // The readable bytes are returned up to the end of the buffer, then from
+  // its start.
+  ASSERT_EQ(ring_buffer->AcquireRead(&offset), 4u);
+  EXPECT_EQ(offset, 4u);
+  EXPECT_EQ(ring_buffer->GetData()[4], 5u);
+  EXPECT_EQ(ring_buffer->GetData()[6], 1u);
+  ring_buffer->ReleaseRead(4);
+  ASSERT_EQ(ring_buffer->AcquireRead(&offset), 4u);
+  EXPECT_EQ(offset, 0u);
+  EXPECT_EQ(ring_buffer->GetData()[0], 3u);
+  ring_buffer->ReleaseRead(4);
+  EXPECT_EQ(ring_buffer->AcquireRead(&offset), 0u);
+}
+
+TEST(EmbedderRingBufferTest, NotifiesOnlyWhenTheConsumerFoundItEmpty) {
+  size_t notifications = 0;
+  auto ring_buffer = fml::MakeRefCounted<EmbedderRingBuffer>(
+      16, [&notifications]() { notifications++; });
+  const uint8_t data[] = {1, 2};
+
+  ring_buffer->Write(data, 2);
+  EXPECT_EQ(notifications, 1u);
+  ring_buffer->Write(data, 2);
+  EXPECT_EQ(notifications, 1u);
+
+  size_t offset = 0;
+  ASSERT_EQ(ring_buffer->AcquireRead(&offset), 4u);
+  ring_buffer->ReleaseRead(4);
+  ring_buffer->Write(data, 2);
+  // The consumer hasn't found the buffer empty since the last notification.
+  EXPECT_EQ(notifications, 1u);
+
+  ASSERT_EQ(ring_buffer->AcquireRead(&offset), 2u);
+  ring_buffer->ReleaseRead(2);
+  ASSERT_EQ(ring_buffer->AcquireRead(&offset), 0u);
+  ring_buffer->Write(data, 2);
+  EXPECT_EQ(notifications, 2u);
+}
+
+TEST(EmbedderRingBufferTest, ConsumerReadsAllBytesInOrder) {
+  auto ring_buffer = fml::MakeRefCounted<EmbedderRingBuffer>(64, nullptr);
+  constexpr size_t kByteCount = 1 << 14;
+
+  std::thread producer([&ring_buffer]() {
+    size_t written = 0;
+    while (written < kByteCount) {
+      uint8_t data[7];
+      for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<uint8_t>(written + i);
+      }
+      size_t size = ring_buffer->Write(
+          data, std::min(sizeof(data), kByteCount - written));
+      if (size == 0) {
+        std::this_thread::yield();
+      }
+      written += size;
+    }
+  });
+
+  size_t read = 0;
+  while (read < kByteCount) {
+    size_t offset = 0;
+    size_t size = ring_buffer->AcquireRead(&offset);
+    if (size == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < size; i++) {
+      ASSERT_EQ(ring_buffer->GetData()[offset + i],
+                static_cast<uint8_t>(read + i));
+    }
+    ring_buffer->ReleaseRead(size);
+    read += size;
+  }
+  producer.join();
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+EmbedderTaskRunner::DispatchTable CreateWakingDispatchTable(
+    std::vector<fml::TimePoint>& wake_times) {
+  EmbedderTaskRunner::DispatchTable table = {};
+  table.runs_task_on_current_thread_callback = []() { return true; };
+  table.wake_callback = [&wake_times](EmbedderTaskRunner* task_runner,
+                                      fml::TimePoint target_time) {
+    wake_times.push_back(target_time);
+  };
+  return table;
+}
+}  // namespace
+
+TEST(EmbedderTaskRunnerTest, WakesOnlyForEarlierTargetTimes) {
+  std::vector<fml::TimePoint> wake_times;
+  auto task_runner = fml::MakeRefCounted<EmbedderTaskRunner>(
+      CreateWakingDispatchTable(wake_times), 0u);
+  // Tasks are posted via the |fml::TaskRunner| interface.
+  fml::TaskRunner* runner = task_runner.get();
+
+  const auto now = fml::TimePoint::Now();
+  runner->PostTaskForTime([]() {}, now + fml::TimeDelta::FromSeconds(10));
+  runner->PostTaskForTime([]() {}, now + fml::TimeDelta::FromSeconds(20));
+  runner->PostTaskForTime([]() {}, now + fml::TimeDelta::FromSeconds(5));
+
+  ASSERT_EQ(wake_times.size(), 2u);
+  EXPECT_EQ(wake_times[0], now + fml::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(wake_times[1], now + fml::TimeDelta::FromSeconds(5));
+}
+
+TEST(EmbedderTaskRunnerTest, RunsExpiredTasksInTargetTimeOrder) {
+  std::vector<fml::TimePoint> wake_times;
+  auto task_runner = fml::MakeRefCounted<EmbedderTaskRunner>(
+      CreateWakingDispatchTable(wake_times), 0u);
+  // Tasks are posted via the |fml::TaskRunner| interface.
+  fml::TaskRunner* runner = task_runner.get();
+
+  std::vector<int> order;
+  const auto now = fml::TimePoint::Now();
+  const auto later = now + fml::TimeDelta::FromSeconds(60);
+  runner->PostTaskForTime([&order]() { order.push_back(2); },
+                               now - fml::TimeDelta::FromMilliseconds(1));
+  runner->PostTaskForTime([&order]() { order.push_back(3); },
+                               now - fml::TimeDelta::FromMilliseconds(1));
+  runner->PostTaskForTime([&order]() { order.push_back(1); },
+                               now - fml::TimeDelta::FromMilliseconds(2));
+  runner->PostTaskForTime([&order]() { order.push_back(4); }, later);
+
+  fml::TimePoint next_target_time;
+  ASSERT_TRUE(task_runner->RunExpiredTasks(&next_target_time));
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(next_target_time, later);
+
+  // Tasks posted by the expired tasks wake the embedder again.
+  wake_times.clear();
+  runner->PostTaskForTime(
+      [runner, &order]() {
+        order.push_back(5);
+        runner->PostTaskForTime([&order]() { order.push_back(6); },
+                                     fml::TimePoint::Now());
+      },
+      now);
+  ASSERT_TRUE(task_runner->RunExpiredTasks(&next_target_time));
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 5}));
+  ASSERT_EQ(wake_times.size(), 2u);
+  ASSERT_TRUE(task_runner->RunExpiredTasks(&next_target_time));
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 5, 6}));
+  EXPECT_EQ(next_target_time, later);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -15,6 +15,8 @@ class EmbedderTestContextGL : public EmbedderTestContext {
  public:
   using GLGetFBOCallback = std::function<void(FlutterFrameInfo frame_info)>;
   using GLPresentCallback = std::function<void(uint32_t fbo_id)>;
+  using GLPopulateExistingDamageCallback =
+      std::function<void(intptr_t fbo_id, FlutterDamage* existing_damage)>;
 
   EmbedderTestContextGL(std::string assets_path = "");
 
@@ -53,6 +55,18 @@ class EmbedderTestContextGL : public EmbedderTestContext {
   ///
   void SetGLPresentCallback(GLPresentCallback callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets a callback that will be invoked (on the raster task
+  ///             runner) when the engine asks the embedder for the existing
+  ///             damage of an fbo. Only used if the builder set
+  ///             `open_gl.populate_existing_damage`.
+  ///
+  /// @param[in]  callback  The callback to set. The previous callback will be
+  ///                       un-registered.
+  ///
+  void SetGLPopulateExistingDamageCallback(
+      GLPopulateExistingDamageCallback callback);
+
  protected:
   virtual void SetupCompositor() override;
 
@@ -65,6 +79,7 @@ class EmbedderTestContextGL : public EmbedderTestContext {
   std::mutex gl_callback_mutex_;
   GLGetFBOCallback gl_get_fbo_callback_;
   GLPresentCallback gl_present_callback_;
+  GLPopulateExistingDamageCallback gl_populate_existing_damage_callback_;
 
   void SetupSurface(SkISize surface_size) override;
 
@@ -76,6 +91,9 @@ class EmbedderTestContextGL : public EmbedderTestContext {
 
   uint32_t GLGetFramebuffer(FlutterFrameInfo frame_info);
 
+  void GLPopulateExistingDamage(intptr_t fbo_id,
+                                FlutterDamage* existing_damage);
+
   bool GLMakeResourceCurrent();
 
   void* GLGetProcAddress(const char* name);
@@ -67,6 +67,107 @@ TEST_F(EmbedderTest, CanLaunchAndShutdownWithValidProjectArgs) {
   engine.reset();
 }
 
+TEST_F(EmbedderTest, CanSpawnEngineFromRunningEngine) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  fml::AutoResetWaitableEvent latch;
+  context.AddIsolateCreateCallback([&latch]() { latch.Signal(); });
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  latch.Wait();
+
+  EmbedderConfigBuilder spawned_builder(context);
+  spawned_builder.SetSoftwareRendererConfig();
+  spawned_builder.GetProjectArgs().spawner = engine.get();
+  auto spawned_engine = spawned_builder.LaunchEngine();
+  ASSERT_TRUE(spawned_engine.is_valid());
+  // The spawned engine runs a root isolate of its own.
+  latch.Wait();
+
+  // The spawned engine keeps running without its spawner.
+  engine.reset();
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(spawned_engine.get(), &event),
+            kSuccess);
+  spawned_engine.reset();
+}
+
+TEST_F(EmbedderTest, CanNotSpawnEngineWithCustomTaskRunners) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterTaskRunnerDescription platform_task_runner = {};
+  platform_task_runner.struct_size = sizeof(platform_task_runner);
+  platform_task_runner.runs_task_on_current_thread_callback =
+      [](void*) { return true; };
+  platform_task_runner.post_task_callback = [](FlutterTask, uint64_t, void*) {};
+  FlutterCustomTaskRunners custom_task_runners = {};
+  custom_task_runners.struct_size = sizeof(custom_task_runners);
+  custom_task_runners.platform_task_runner = &platform_task_runner;
+
+  EmbedderConfigBuilder spawned_builder(context);
+  spawned_builder.SetSoftwareRendererConfig();
+  spawned_builder.GetProjectArgs().spawner = engine.get();
+  spawned_builder.GetProjectArgs().custom_task_runners = &custom_task_runners;
+  auto spawned_engine = spawned_builder.LaunchEngine();
+  ASSERT_FALSE(spawned_engine.is_valid());
+}
+
+TEST_F(EmbedderTest, CanGetStartupTimings) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  fml::AutoResetWaitableEvent latch;
+  context.AddIsolateCreateCallback([&latch]() { latch.Signal(); });
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  latch.Wait();
+
+  ASSERT_EQ(FlutterEngineGetStartupTimings(engine.get(), nullptr),
+            kInvalidArguments);
+  FlutterEngineStartupTimings timings = {};
+  timings.struct_size = sizeof(timings);
+  ASSERT_EQ(FlutterEngineGetStartupTimings(engine.get(), &timings), kSuccess);
+  // The VM is initialized before the engine is launched.
+  EXPECT_GT(timings.vm_initialization.start_nanos, 0u);
+  EXPECT_LE(timings.vm_initialization.start_nanos,
+            timings.vm_initialization.end_nanos);
+  EXPECT_LE(timings.vm_initialization.end_nanos,
+            FlutterEngineGetCurrentTime());
+  // The shell is created when the engine is launched.
+  EXPECT_GT(timings.shell_creation.start_nanos, 0u);
+  EXPECT_LE(timings.shell_creation.start_nanos,
+            timings.shell_creation.end_nanos);
+  engine.reset();
+}
+
+TEST_F(EmbedderTest, CanGetFrameTimingStatistics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  ASSERT_EQ(FlutterEngineGetFrameTimingStatistics(engine.get(), nullptr),
+            kInvalidArguments);
+  FlutterFrameTimingStatistics statistics = {};
+  statistics.struct_size = sizeof(statistics);
+  ASSERT_EQ(FlutterEngineGetFrameTimingStatistics(engine.get(), &statistics),
+            kSuccess);
+  EXPECT_LE(statistics.frame_count, statistics.total_frame_count);
+  EXPECT_LE(statistics.janky_frame_count, statistics.frame_count);
+  EXPECT_LE(statistics.build.p50_nanos, statistics.build.max_nanos);
+  engine.reset();
+}
+
 // TODO(41999): Disabled because flaky.
 TEST_F(EmbedderTest, DISABLED_CanLaunchAndShutdownMultipleTimes) {
   EmbedderConfigBuilder builder(
@@ -362,6 +463,74 @@ TEST_F(EmbedderTest, PlatformMessagesCanReceiveResponse) {
   captures.latch.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that the engine takes the ownership of the data of the messages sent
+/// with `FlutterEngineSendOwnedPlatformMessage`, whose large data reaches the
+/// Dart application without being copied.
+///
+TEST_F(EmbedderTest, OwnedPlatformMessagesCanReceiveResponse) {
+  static constexpr size_t kMessageSize = 1 << 16;
+  fml::AutoResetWaitableEvent latch;
+
+  CreateNewThread()->PostTask([&]() {
+    auto& context =
+        GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+    EmbedderConfigBuilder builder(context);
+    builder.SetSoftwareRendererConfig();
+    builder.SetDartEntrypoint("platform_messages_response");
+
+    fml::AutoResetWaitableEvent ready;
+    context.AddNativeCallback(
+        "SignalNativeTest",
+        CREATE_NATIVE_ENTRY(
+            [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+    auto engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+
+    FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+    auto callback = [](const uint8_t* data, size_t size,
+                       void* user_data) -> void {
+      ASSERT_EQ(size, kMessageSize);
+      for (size_t i = 0; i < size; i++) {
+        ASSERT_EQ(data[i], static_cast<uint8_t>(i));
+      }
+      reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)->Signal();
+    };
+    auto result = FlutterPlatformMessageCreateResponseHandle(
+        engine.get(), callback, &latch, &response_handle);
+    ASSERT_EQ(result, kSuccess);
+
+    auto* message_data = static_cast<uint8_t*>(malloc(kMessageSize));
+    for (size_t i = 0; i < kMessageSize; i++) {
+      message_data[i] = static_cast<uint8_t>(i);
+    }
+    FlutterPlatformMessage message = {};
+    message.struct_size = sizeof(FlutterPlatformMessage);
+    message.channel = "test_channel";
+    message.message = message_data;
+    message.message_size = kMessageSize;
+    message.response_handle = response_handle;
+
+    ready.Wait();
+    result = FlutterEngineSendOwnedPlatformMessage(engine.get(), &message);
+    ASSERT_EQ(result, kSuccess);
+
+    result = FlutterPlatformMessageReleaseResponseHandle(engine.get(),
+                                                         response_handle);
+    ASSERT_EQ(result, kSuccess);
+
+    // The data of a message that can't be sent is released too.
+    message.channel = nullptr;
+    message.message = static_cast<uint8_t*>(malloc(kMessageSize));
+    message.response_handle = nullptr;
+    ASSERT_EQ(FlutterEngineSendOwnedPlatformMessage(engine.get(), &message),
+              kInvalidArguments);
+  });
+
+  latch.Wait();
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a platform message can be sent with no response handle. Instead
 /// of the platform message integrity checked via a response handle, a native
@@ -1035,6 +1204,35 @@ TEST_F(EmbedderTest, VerifyB143464703WithSoftwareBackend) {
       ImageMatchesFixture("verifyb143464703_soft_noxform.png", rendered_scene));
 }
 
+TEST_F(EmbedderTest, CanRenderSceneWithSoftwarePresentWithInfoCallback) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("can_render_scene_without_custom_compositor");
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetSoftwarePresentWithInfoCallBack();
+
+  auto rendered_scene = context.GetNextSceneImage();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  auto image = rendered_scene.get();
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->width(), 800);
+  ASSERT_EQ(image->height(), 600);
+  ASSERT_GE(context.GetSurfacePresentCount(), 1u);
+}
+
 TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
 
@@ -1053,6 +1251,24 @@ TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   ASSERT_EQ(FlutterEngineNotifyLowMemoryWarning(engine.get()), kSuccess);
 }
 
+TEST_F(EmbedderTest, CanSetIdleFrameRateLimit) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  ASSERT_EQ(FlutterEngineSetIdleFrameRateLimit(engine.get(), 1.0), kSuccess);
+  ASSERT_EQ(FlutterEngineSetIdleFrameRateLimit(engine.get(), 0.0), kSuccess);
+  ASSERT_EQ(FlutterEngineSetIdleFrameRateLimit(engine.get(), -1.0),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineSetIdleFrameRateLimit(nullptr, 1.0),
+            kInvalidArguments);
+}
+
 TEST_F(EmbedderTest, CanPostTaskToAllNativeThreads) {
   UniqueEngine engine;
   size_t worker_count = 0;
@@ -1194,6 +1194,53 @@ TEST_F(EmbedderTest, CanRenderSceneWithoutCustomCompositor) {
                                   rendered_scene));
 }
 
+TEST_F(EmbedderTest, CanRenderSceneWithSkiaContextSharedWithSpawner) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  EmbedderConfigBuilder spawned_builder(context);
+  spawned_builder.SetDartEntrypoint(
+      "can_render_scene_without_custom_compositor");
+  spawned_builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  spawned_builder.SetOpenGLShareSkiaContextWithSpawner();
+  spawned_builder.GetProjectArgs().spawner = engine.get();
+
+  auto rendered_scene = context.GetNextSceneImage();
+
+  auto spawned_engine = spawned_builder.LaunchEngine();
+  ASSERT_TRUE(spawned_engine.is_valid());
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(spawned_engine.get(), &event),
+            kSuccess);
+
+  ASSERT_TRUE(ImageMatchesFixture("scene_without_custom_compositor.png",
+                                  rendered_scene));
+
+  // The shared context outlives the spawner.
+  engine.reset();
+  spawned_engine.reset();
+}
+
+TEST_F(EmbedderTest, CanNotShareSkiaContextWithoutSpawner) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetOpenGLShareSkiaContextWithSpawner();
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
 TEST_F(EmbedderTest, CanRenderSceneWithoutCustomCompositorWithTransformation) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
@@ -2916,6 +2963,54 @@ TEST_F(EmbedderTest, CompositorCanPostOnlyPlatformViews) {
   ASSERT_EQ(context.GetCompositor().GetPendingBackingStoresCount(), 0u);
 }
 
+TEST_F(EmbedderTest, CompositorMergesLayersThatDoNotOverlapPlatformViews) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor();
+  builder.GetCompositor().merge_non_overlapping_layers = true;
+  builder.SetDartEntrypoint("can_merge_non_overlapping_layers");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::AutoResetWaitableEvent latch;
+
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 4u);
+
+        // Layer 0 (Root), which also holds the contents above platform view
+        // 42.
+        ASSERT_EQ(layers[0]->type, kFlutterLayerContentTypeBackingStore);
+
+        // Layer 1
+        ASSERT_EQ(layers[1]->type, kFlutterLayerContentTypePlatformView);
+        ASSERT_EQ(layers[1]->platform_view->identifier, 42);
+
+        // Layer 2
+        ASSERT_EQ(layers[2]->type, kFlutterLayerContentTypePlatformView);
+        ASSERT_EQ(layers[2]->platform_view->identifier, 24);
+
+        // Layer 3
+        ASSERT_EQ(layers[3]->type, kFlutterLayerContentTypeBackingStore);
+
+        latch.Signal();
+      });
+
+  auto engine = builder.LaunchEngine();
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+  latch.Wait();
+}
+
 TEST_F(EmbedderTest, CompositorRenderTargetsAreRecycled) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
@@ -3138,6 +3233,49 @@ TEST_F(EmbedderTest, PresentInfoContainsValidFBOId) {
   frame_latch.Wait();
 }
 
+TEST_F(EmbedderTest, ExistingDamageIsPopulatedForTheWindowFBO) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetOpenGLPopulateExistingDamageCallBack();
+  builder.SetDartEntrypoint("push_frames_over_and_over");
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              /* Nothing to do. */
+                            }));
+
+  fml::CountDownLatch frame_latch(10);
+  const uint32_t window_fbo_id =
+      static_cast<EmbedderTestContextGL&>(context).GetWindowFBOId();
+  // The window FBO holds the previous frame.
+  static FlutterRect no_damage = {0, 0, 0, 0};
+  static_cast<EmbedderTestContextGL&>(context)
+      .SetGLPopulateExistingDamageCallback(
+          [window_fbo_id](intptr_t fbo_id, FlutterDamage* existing_damage) {
+            ASSERT_EQ(fbo_id, static_cast<intptr_t>(window_fbo_id));
+            existing_damage->num_rects = 1;
+            existing_damage->damage = &no_damage;
+          });
+  static_cast<EmbedderTestContextGL&>(context).SetGLPresentCallback(
+      [&frame_latch](uint32_t fbo_id) { frame_latch.CountDown(); });
+
+  frame_latch.Wait();
+}
+
 TEST_F(EmbedderTest, SetSingleDisplayConfigurationWithDisplayId) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
@@ -3222,6 +3360,53 @@ TEST_F(EmbedderTest, SetSingleDisplayConfigurationWithoutDisplayId) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, DisplayConfigurationChangeUpdatesRefreshRate) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("empty_scene");
+  fml::AutoResetWaitableEvent latch;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) { latch.Signal(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineDisplay display;
+  display.struct_size = sizeof(FlutterEngineDisplay);
+  display.single_display = true;
+  display.refresh_rate = 60;
+
+  ASSERT_EQ(FlutterEngineNotifyDisplayUpdate(
+                engine.get(), kFlutterEngineDisplaysUpdateTypeStartup,
+                &display, 1),
+            kSuccess);
+
+  display.refresh_rate = 120;
+  ASSERT_EQ(FlutterEngineNotifyDisplayUpdate(
+                engine.get(),
+                kFlutterEngineDisplaysUpdateTypeConfigurationChanged, &display,
+                1),
+            kSuccess);
+
+  flutter::Shell& shell = ToEmbedderEngine(engine.get())->GetShell();
+  ASSERT_EQ(shell.GetMainDisplayRefreshRate(), display.refresh_rate);
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+}
+
 TEST_F(EmbedderTest, SetValidMultiDisplayConfiguration) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
@@ -3656,7 +3841,8 @@ TEST_F(EmbedderTest, ExternalTextureGLRefreshedTooOften) {
         res->width = res->height = 100;
         return res;
       });
-  EmbedderExternalTextureGL texture(1, callback);
+  EmbedderExternalTextureGL texture(
+      1, callback, std::make_shared<EmbedderExternalTextureGLFrameSlot>());
 
   auto skia_surface = surface.GetOnscreenSurface();
   auto canvas = skia_surface->getCanvas();
@@ -3680,5 +3866,61 @@ TEST_F(EmbedderTest, ExternalTextureGLRefreshedTooOften) {
   EXPECT_TRUE(resolve_called);
 }
 
+TEST_F(EmbedderTest, ExternalTextureGLSamplesTheLatestPushedFrame) {
+  TestGLSurface surface(SkISize::Make(100, 100));
+  auto context = surface.GetGrContext();
+
+  typedef void (*glGenTexturesProc)(uint32_t n, uint32_t * textures);
+  glGenTexturesProc glGenTextures;
+
+  glGenTextures = reinterpret_cast<glGenTexturesProc>(
+      surface.GetProcAddress("glGenTextures"));
+
+  uint32_t names[2];
+  glGenTextures(2, names);
+
+  size_t released[2] = {0, 0};
+  auto make_frame = [&](size_t index) {
+    EmbedderExternalTextureGLFrameSlot::Frame frame = {};
+    frame.texture.target = GR_GL_TEXTURE_2D;
+    frame.texture.name = names[index];
+    frame.texture.format = GR_GL_RGBA8;
+    frame.texture.user_data = &released[index];
+    frame.texture.destruction_callback = [](void* user_data) {
+      (*reinterpret_cast<size_t*>(user_data))++;
+    };
+    frame.texture.width = frame.texture.height = 100;
+    return frame;
+  };
+
+  // Without the callback, the texture only shows the pushed frames.
+  EmbedderExternalTextureGL::ExternalTextureCallback callback;
+  auto frame_slot = std::make_shared<EmbedderExternalTextureGLFrameSlot>();
+  EmbedderExternalTextureGL texture(1, callback, frame_slot);
+
+  // The first frame is released as soon as it's replaced, as it was never
+  // sampled.
+  frame_slot->Push(make_frame(0));
+  frame_slot->Push(make_frame(1));
+  EXPECT_EQ(released[0], 1u);
+  EXPECT_EQ(released[1], 0u);
+
+  auto skia_surface = surface.GetOnscreenSurface();
+  auto canvas = skia_surface->getCanvas();
+
+  Texture* texture_ = &texture;
+  texture_->Paint(*canvas, SkRect::MakeXYWH(0, 0, 100, 100), false,
+                  context.get(), SkSamplingOptions(SkFilterMode::kLinear));
+  EXPECT_FALSE(frame_slot->Take().has_value());
+
+  // The sampled frame is released once the next one replaces its image.
+  frame_slot->Push(make_frame(0));
+  texture_->Paint(*canvas, SkRect::MakeXYWH(0, 0, 100, 100), false,
+                  context.get(), SkSamplingOptions(SkFilterMode::kLinear));
+  context->flushAndSubmit(/*syncCpu=*/true);
+  EXPECT_EQ(released[1], 1u);
+  EXPECT_EQ(released[0], 1u);
+}
+
 }  // namespace testing
 }  // namespace flutter
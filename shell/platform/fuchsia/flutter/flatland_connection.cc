@@ -6,10 +6,41 @@
 
 #include <zircon/status.h>
 
+#include <algorithm>
+
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 
 namespace flutter_runner {
 
+namespace {
+
+fml::TimePoint TimePointFromZxTime(zx_time_t time) {
+  return fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(time));
+}
+
+}  // namespace
+
+FlatlandConnection::FrameTimes FlatlandConnection::GetTargetTimes(
+    fml::TimePoint now,
+    fml::TimeDelta frame_budget,
+    fml::TimePoint last_targeted_presentation_time,
+    const std::deque<FlatlandPresentationInfo>& future_presentation_infos) {
+  for (const auto& [latch_point, presentation_time] :
+       future_presentation_infos) {
+    // Only produce one frame per presentation, and only frames that can
+    // still be built and rasterized before the latch point.
+    if (presentation_time <= last_targeted_presentation_time ||
+        latch_point - frame_budget < now) {
+      continue;
+    }
+    return {latch_point - frame_budget, presentation_time, latch_point};
+  }
+
+  return {now, now + kDefaultFlatlandPresentationInterval,
+          fml::TimePoint::Max()};
+}
+
 FlatlandConnection::FlatlandConnection(
     std::string debug_label,
     fuchsia::ui::composition::FlatlandHandle flatland,
@@ -20,6 +51,9 @@ FlatlandConnection::FlatlandConnection(
     : flatland_(flatland.Bind()),
       error_callback_(error_callback),
       on_frame_presented_callback_(std::move(on_frame_presented_callback)) {
+  threadsafe_state_.frame_budget_ = vsync_offset > fml::TimeDelta::Zero()
+                                        ? vsync_offset
+                                        : kInitialFlatlandFrameBudget;
   flatland_.set_error_handler([callback = error_callback_](zx_status_t status) {
     FML_LOG(ERROR) << "Flatland disconnected: " << zx_status_get_string(status);
     callback();
@@ -37,6 +71,22 @@ FlatlandConnection::~FlatlandConnection() = default;
 
 // This method is called from the raster thread.
 void FlatlandConnection::Present() {
+  // Measure how long the frame took to build and rasterize, so that the next
+  // frames start as late as they can afford to.
+  {
+    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+    const fml::TimePoint frame_start =
+        threadsafe_state_.last_frame_times_.frame_start;
+    const fml::TimePoint now = fml::TimePoint::Now();
+    if (frame_start != fml::TimePoint() && frame_start <= now) {
+      frame_durations_.push_back(now - frame_start);
+      if (frame_durations_.size() > kFlatlandFrameDurationWindow) {
+        frame_durations_.pop_front();
+      }
+    }
+  }
+  UpdateFrameBudget();
+
   if (present_credits_ > 0) {
     DoPresent();
   } else {
@@ -49,6 +99,12 @@ void FlatlandConnection::DoPresent() {
   FML_CHECK(present_credits_ > 0);
   --present_credits_;
 
+  {
+    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+    targeted_latch_points_.push_back(
+        threadsafe_state_.last_frame_times_.latch_point);
+  }
+
   fuchsia::ui::composition::PresentArgs present_args;
   // TODO(fxbug.dev/64201): compute a better presentation time;
   present_args.set_requested_presentation_time(0);
@@ -74,19 +130,24 @@ void FlatlandConnection::AwaitVsync(FireCallbackCallback callback) {
     return;
   }
 
+  FireCallbackCallback fire_callback;
+  FrameTimes frame_times;
   {
     std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
     threadsafe_state_.fire_callback_ = callback;
 
     if (threadsafe_state_.fire_callback_pending_) {
-      fml::TimePoint now = fml::TimePoint::Now();
-      // TODO(fxbug.dev/64201): Calculate correct frame times.
-      threadsafe_state_.fire_callback_(
-          now, now + kDefaultFlatlandPresentationInterval);
+      frame_times = ScheduleFrameLocked();
+      fire_callback = std::move(threadsafe_state_.fire_callback_);
       threadsafe_state_.fire_callback_ = nullptr;
       threadsafe_state_.fire_callback_pending_ = false;
     }
   }
+
+  // The callback is fired without holding the lock, as it may present.
+  if (fire_callback) {
+    fire_callback(frame_times.frame_start, frame_times.frame_target);
+  }
 }
 
 // This method is called from the UI thread.
@@ -107,21 +168,37 @@ void FlatlandConnection::OnNextFrameBegin(
     fuchsia::ui::composition::OnNextFrameBeginValues values) {
   present_credits_ += values.additional_present_credits();
 
+  if (values.has_future_presentation_infos()) {
+    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+    threadsafe_state_.future_presentation_infos_.clear();
+    for (const auto& info : values.future_presentation_infos()) {
+      threadsafe_state_.future_presentation_infos_.emplace_back(
+          TimePointFromZxTime(info.latch_point()),
+          TimePointFromZxTime(info.presentation_time()));
+    }
+  }
+
   if (present_pending_ && present_credits_ > 0) {
     DoPresent();
     present_pending_ = false;
   }
 
   if (present_credits_ > 0) {
-    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
-    if (threadsafe_state_.fire_callback_) {
-      fml::TimePoint now = fml::TimePoint::Now();
-      // TODO(fxbug.dev/64201): Calculate correct frame times.
-      threadsafe_state_.fire_callback_(
-          now, now + kDefaultFlatlandPresentationInterval);
-      threadsafe_state_.fire_callback_ = nullptr;
-    } else {
-      threadsafe_state_.fire_callback_pending_ = true;
+    FireCallbackCallback fire_callback;
+    FrameTimes frame_times;
+    {
+      std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+      if (threadsafe_state_.fire_callback_) {
+        frame_times = ScheduleFrameLocked();
+        fire_callback = std::move(threadsafe_state_.fire_callback_);
+        threadsafe_state_.fire_callback_ = nullptr;
+      } else {
+        threadsafe_state_.fire_callback_pending_ = true;
+      }
+    }
+
+    if (fire_callback) {
+      fire_callback(frame_times.frame_start, frame_times.frame_target);
     }
   }
 }
@@ -129,9 +206,65 @@ void FlatlandConnection::OnNextFrameBegin(
 // This method is called from the raster thread.
 void FlatlandConnection::OnFramePresented(
     fuchsia::scenic::scheduling::FramePresentedInfo info) {
+  // Grow the margin whenever a present was latched later than the latch
+  // point its frame was started for, and shrink it once frames have been
+  // making their latch points for a while.
+  for (const auto& present_info : info.presentation_infos) {
+    if (targeted_latch_points_.empty()) {
+      break;
+    }
+    const fml::TimePoint targeted_latch_point = targeted_latch_points_.front();
+    targeted_latch_points_.pop_front();
+    if (!present_info.has_latched_time()) {
+      continue;
+    }
+
+    if (TimePointFromZxTime(present_info.latched_time()) >
+        targeted_latch_point) {
+      TRACE_EVENT_INSTANT0("flutter", "FlatlandConnection::MissedLatchPoint");
+      frame_margin_ = std::min(frame_margin_ + kFlatlandFrameMarginStep,
+                               kMaxFlatlandFrameMargin);
+      on_time_frames_ = 0;
+    } else if (++on_time_frames_ >= kFlatlandOnTimeFramesToShrinkMargin) {
+      frame_margin_ = std::max(frame_margin_ - kFlatlandFrameMarginStep,
+                               kMinFlatlandFrameMargin);
+      on_time_frames_ = 0;
+    }
+  }
+  UpdateFrameBudget();
+
   on_frame_presented_callback_(std::move(info));
 }
 
+// This method is called from the raster thread.
+void FlatlandConnection::UpdateFrameBudget() {
+  if (frame_durations_.empty()) {
+    return;
+  }
+
+  const fml::TimeDelta slowest_frame =
+      *std::max_element(frame_durations_.begin(), frame_durations_.end());
+  std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+  threadsafe_state_.frame_budget_ = slowest_frame + frame_margin_;
+}
+
+// This method is called from either the UI thread or the raster thread.
+FlatlandConnection::FrameTimes FlatlandConnection::ScheduleFrameLocked() {
+  const FrameTimes frame_times = GetTargetTimes(
+      fml::TimePoint::Now(), threadsafe_state_.frame_budget_,
+      threadsafe_state_.last_targeted_presentation_time_,
+      threadsafe_state_.future_presentation_infos_);
+  TRACE_DURATION("flutter", "FlatlandConnection::FireCallback",
+                 "frame_budget(us)",
+                 threadsafe_state_.frame_budget_.ToMicroseconds());
+  if (frame_times.latch_point != fml::TimePoint::Max()) {
+    threadsafe_state_.last_targeted_presentation_time_ =
+        frame_times.frame_target;
+  }
+  threadsafe_state_.last_frame_times_ = frame_times;
+  return frame_times;
+}
+
 // This method is called from the raster thread.
 void FlatlandConnection::EnqueueAcquireFence(zx::event fence) {
   acquire_fences_.push_back(std::move(fence));
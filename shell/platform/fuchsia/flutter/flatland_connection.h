@@ -10,12 +10,15 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 #include "vsync_waiter.h"
 
 #include <cstdint>
+#include <deque>
 #include <mutex>
 #include <string>
+#include <utility>
 
 namespace flutter_runner {
 
@@ -26,6 +29,30 @@ using on_frame_presented_event =
 static constexpr fml::TimeDelta kDefaultFlatlandPresentationInterval =
     fml::TimeDelta::FromSecondsF(0);
 
+// How long before a latch point frames start until the time it takes to
+// build and rasterize them has been measured, unless the product
+// configuration sets a vsync offset.  This is one vsync interval at 60hz.
+static constexpr fml::TimeDelta kInitialFlatlandFrameBudget =
+    fml::TimeDelta::FromMicroseconds(16667);
+
+// The time that is added to the slowest recent frame, so that small
+// variations in frame times don't make frames miss their latch point.  It
+// grows by a step each time a frame misses, and shrinks back by a step after
+// |kFlatlandOnTimeFramesToShrinkMargin| frames in a row made it.
+static constexpr fml::TimeDelta kMinFlatlandFrameMargin =
+    fml::TimeDelta::FromMilliseconds(1);
+static constexpr fml::TimeDelta kMaxFlatlandFrameMargin =
+    fml::TimeDelta::FromMilliseconds(8);
+static constexpr fml::TimeDelta kFlatlandFrameMarginStep =
+    fml::TimeDelta::FromMilliseconds(1);
+static constexpr size_t kFlatlandOnTimeFramesToShrinkMargin = 120;
+
+// The number of recent frames whose build and raster times are considered.
+static constexpr size_t kFlatlandFrameDurationWindow = 30;
+
+// A latch point and the presentation time of the frames latched at it.
+using FlatlandPresentationInfo = std::pair<fml::TimePoint, fml::TimePoint>;
+
 // The component residing on the raster thread that is responsible for
 // maintaining the Flatland instance connection and presenting updates.
 class FlatlandConnection final {
@@ -39,6 +66,25 @@ class FlatlandConnection final {
 
   ~FlatlandConnection();
 
+  struct FrameTimes {
+    fml::TimePoint frame_start;
+    fml::TimePoint frame_target;
+    // The latch point the frame is expected to make, or the maximum time
+    // point if there was no feedback from Scenic to pick it from.
+    fml::TimePoint latch_point;
+  };
+
+  // Returns the times of the next frame.  It targets the earliest future
+  // presentation after |last_targeted_presentation_time| whose latch point
+  // is at least |frame_budget| away, and starts the frame as late as that
+  // budget allows.  Frames start |now| and target the default interval if
+  // there is no such presentation.
+  static FrameTimes GetTargetTimes(
+      fml::TimePoint now,
+      fml::TimeDelta frame_budget,
+      fml::TimePoint last_targeted_presentation_time,
+      const std::deque<FlatlandPresentationInfo>& future_presentation_infos);
+
   void Present();
 
   // Used to implement VsyncWaiter functionality.
@@ -68,6 +114,15 @@ class FlatlandConnection final {
   void OnFramePresented(fuchsia::scenic::scheduling::FramePresentedInfo info);
   void DoPresent();
 
+  // Returns the times of the next frame, and records them as the times of
+  // the frame that the next |Present| submits.
+  //
+  // Precondition: |threadsafe_state_.mutex_| is held.
+  FrameTimes ScheduleFrameLocked();
+
+  // Recomputes the frame budget from the recent frame durations and margin.
+  void UpdateFrameBudget();
+
   fuchsia::ui::composition::FlatlandPtr flatland_;
 
   fml::closure error_callback_;
@@ -86,8 +141,23 @@ class FlatlandConnection final {
     std::mutex mutex_;
     FireCallbackCallback fire_callback_;
     bool fire_callback_pending_ = false;
+    std::deque<FlatlandPresentationInfo> future_presentation_infos_;
+    fml::TimeDelta frame_budget_;
+    fml::TimePoint last_targeted_presentation_time_;
+    // The times of the last frame that was started, which is the frame that
+    // the next |Present| submits.
+    FrameTimes last_frame_times_;
   } threadsafe_state_;
 
+  // The time it took to build and rasterize each recent frame, from its
+  // start to its |Present|.
+  std::deque<fml::TimeDelta> frame_durations_;
+  fml::TimeDelta frame_margin_ = kMinFlatlandFrameMargin;
+  size_t on_time_frames_ = 0;
+  // The latch points targeted by the presents that Scenic hasn't latched yet,
+  // in the order of the presents.
+  std::deque<fml::TimePoint> targeted_latch_points_;
+
   bool first_call_to_await_vsync_ = true;
 
   std::vector<zx::event> acquire_fences_;
@@ -116,20 +116,32 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
   {
     TRACE_EVENT0("flutter", "CreateSurfaces");
 
-    for (const auto& layer : frame_layers_) {
+    for (auto& layer : frame_layers_) {
       if (!layer.second.canvas_spy->DidDrawIntoCanvas()) {
         continue;
       }
 
-      auto surface =
-          surface_producer_.ProduceSurface(layer.second.surface_size);
+      // Flatland has no damage regions for images, so overlays only get a
+      // surface for the region they drew into, which is all that is
+      // rasterized, sampled and composited.
+      layer.second.picture = layer.second.recorder->finishRecordingAsPicture();
+      FML_CHECK(layer.second.picture != nullptr);
+      if (layer.first.has_value() &&
+          !layer.second.surface_rect.intersect(
+              layer.second.picture->cullRect().roundOut())) {
+        layer.second.surface_rect.setEmpty();
+        continue;
+      }
+
+      const SkISize surface_size = layer.second.surface_rect.size();
+      auto surface = surface_producer_.ProduceSurface(surface_size);
       if (!surface) {
         const std::string layer_id_str =
             layer.first.has_value() ? std::to_string(layer.first.value())
                                     : "Background";
         FML_LOG(ERROR) << "Failed to create surface for layer " << layer_id_str
-                       << "; size (" << layer.second.surface_size.width()
-                       << ", " << layer.second.surface_size.height() << ")";
+                       << "; size (" << surface_size.width() << ", "
+                       << surface_size.height() << ")";
         FML_DCHECK(false);
         continue;
       }
@@ -223,7 +235,8 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
 
       // Acquire the surface associated with the layer.
       SurfaceProducerSurface* surface_for_layer = nullptr;
-      if (layer->second.canvas_spy->DidDrawIntoCanvas()) {
+      if (layer->second.canvas_spy->DidDrawIntoCanvas() &&
+          !layer->second.surface_rect.isEmpty()) {
         const auto& surface_index = frame_surface_indices.find(layer_id);
         if (surface_index != frame_surface_indices.end()) {
           FML_CHECK(surface_index->second < frame_surfaces.size());
@@ -249,21 +262,32 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
           flatland_layers_.emplace_back(std::move(new_layer));
         }
 
-        // Update the image content and set size.
-        flatland_.flatland()->SetContent(
-            flatland_layers_[flatland_layer_index].transform_id,
-            {surface_for_layer->GetImageId()});
+        // Update the image content and set size.  The surface may be larger
+        // than the layer, so only the region the layer drew into is sampled.
+        auto& flatland_layer = flatland_layers_[flatland_layer_index];
+        const SkIRect& surface_rect = layer->second.surface_rect;
+        flatland_.flatland()->SetContent(flatland_layer.transform_id,
+                                         {surface_for_layer->GetImageId()});
+        flatland_.flatland()->SetImageSampleRegion(
+            {surface_for_layer->GetImageId()},
+            {0.f, 0.f, static_cast<float>(surface_rect.width()),
+             static_cast<float>(surface_rect.height())});
         flatland_.flatland()->SetImageDestinationSize(
             {surface_for_layer->GetImageId()},
-            {static_cast<uint32_t>(surface_for_layer->GetSize().width()),
-             static_cast<uint32_t>(surface_for_layer->GetSize().height())});
+            {static_cast<uint32_t>(surface_rect.width()),
+             static_cast<uint32_t>(surface_rect.height())});
+        if (surface_rect.x() != flatland_layer.translation.x ||
+            surface_rect.y() != flatland_layer.translation.y) {
+          flatland_layer.translation = {.x = surface_rect.x(),
+                                        .y = surface_rect.y()};
+          flatland_.flatland()->SetTranslation(flatland_layer.transform_id,
+                                               flatland_layer.translation);
+        }
 
         // Attach the FlatlandLayer to the main scene graph.
-        flatland_.flatland()->AddChild(
-            root_transform_id_,
-            flatland_layers_[flatland_layer_index].transform_id);
-        child_transforms_.emplace_back(
-            flatland_layers_[flatland_layer_index].transform_id);
+        flatland_.flatland()->AddChild(root_transform_id_,
+                                       flatland_layer.transform_id);
+        child_transforms_.emplace_back(flatland_layer.transform_id);
       }
 
       // Reset for the next pass:
@@ -291,22 +315,21 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
           frame_surfaces[surface_index.second].get();
       FML_CHECK(surface != nullptr);
 
+      const auto& layer = frame_layers_.find(surface_index.first);
+      FML_CHECK(layer != frame_layers_.end());
+      const SkIRect& surface_rect = layer->second.surface_rect;
+
       sk_sp<SkSurface> sk_surface = surface->GetSkiaSurface();
       FML_CHECK(sk_surface != nullptr);
-      FML_CHECK(SkISize::Make(sk_surface->width(), sk_surface->height()) ==
-                frame_size_);
+      FML_CHECK(sk_surface->width() >= surface_rect.width() &&
+                sk_surface->height() >= surface_rect.height());
       SkCanvas* canvas = sk_surface->getCanvas();
       FML_CHECK(canvas != nullptr);
 
-      const auto& layer = frame_layers_.find(surface_index.first);
-      FML_CHECK(layer != frame_layers_.end());
-      sk_sp<SkPicture> picture =
-          layer->second.recorder->finishRecordingAsPicture();
-      FML_CHECK(picture != nullptr);
-
-      canvas->setMatrix(SkMatrix::I());
+      canvas->setMatrix(
+          SkMatrix::Translate(-surface_rect.x(), -surface_rect.y()));
       canvas->clear(SK_ColorTRANSPARENT);
-      canvas->drawPicture(picture);
+      canvas->drawPicture(layer->second.picture);
       canvas->flush();
     }
   }
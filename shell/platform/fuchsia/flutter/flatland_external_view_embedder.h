@@ -19,7 +19,9 @@
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/canvas_spy.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -143,15 +145,23 @@ class FlatlandExternalViewEmbedder final
                   std::optional<flutter::EmbeddedViewParams> view_params)
         : embedded_view_params(std::move(view_params)),
           recorder(std::make_unique<SkPictureRecorder>()),
-          canvas_spy(std::make_unique<flutter::CanvasSpy>(
-              recorder->beginRecording(frame_size.width(),
-                                       frame_size.height()))),
-          surface_size(frame_size) {}
+          surface_rect(SkIRect::MakeSize(frame_size)) {
+      // Overlays record into an R-tree, which trims the cull rect of their
+      // pictures down to the bounds of what was drawn.
+      SkRTreeFactory rtree_factory;
+      canvas_spy = std::make_unique<flutter::CanvasSpy>(
+          recorder->beginRecording(
+              SkRect::Make(frame_size),
+              embedded_view_params.has_value() ? &rtree_factory : nullptr));
+    }
 
     std::optional<flutter::EmbeddedViewParams> embedded_view_params;
     std::unique_ptr<SkPictureRecorder> recorder;
     std::unique_ptr<flutter::CanvasSpy> canvas_spy;
-    SkISize surface_size;
+    sk_sp<SkPicture> picture;
+    // The region of the frame that the surface of the layer covers.  It is
+    // empty if the layer drew nothing inside of the frame.
+    SkIRect surface_rect;
   };
   using EmbedderLayerId = std::optional<uint32_t>;
   constexpr static EmbedderLayerId kRootLayerId = EmbedderLayerId{};
@@ -166,6 +176,7 @@ class FlatlandExternalViewEmbedder final
   struct FlatlandLayer {
     // Transform on which Images are set.
     fuchsia::ui::composition::TransformId transform_id;
+    fuchsia::math::Vec translation = {.x = 0, .y = 0};
   };
 
   FlatlandConnection& flatland_;
@@ -8,6 +8,7 @@
 #include <fuchsia/ui/composition/cpp/fidl.h>
 #include <lib/async-testing/test_loop.h>
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -418,4 +419,74 @@ TEST_F(FlatlandConnectionTest, PresentCreditExhaustion) {
   EXPECT_EQ(num_release_fences, num_onfb);
 }
 
+TEST(FlatlandConnectionTargetTimesTest, StartsFramesAsLateAsTheBudgetAllows) {
+  const fml::TimePoint now = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  const fml::TimeDelta frame_budget = fml::TimeDelta::FromMilliseconds(5);
+  const std::deque<FlatlandPresentationInfo> future_presentation_infos = {
+      {now + fml::TimeDelta::FromMilliseconds(10),
+       now + fml::TimeDelta::FromMilliseconds(15)},
+      {now + fml::TimeDelta::FromMilliseconds(26),
+       now + fml::TimeDelta::FromMilliseconds(31)},
+  };
+
+  const auto frame_times = FlatlandConnection::GetTargetTimes(
+      now, frame_budget, fml::TimePoint(), future_presentation_infos);
+  EXPECT_EQ(frame_times.frame_start,
+            now + fml::TimeDelta::FromMilliseconds(5));
+  EXPECT_EQ(frame_times.frame_target,
+            now + fml::TimeDelta::FromMilliseconds(15));
+  EXPECT_EQ(frame_times.latch_point,
+            now + fml::TimeDelta::FromMilliseconds(10));
+}
+
+TEST(FlatlandConnectionTargetTimesTest, SkipsLatchPointsThatAreTooClose) {
+  const fml::TimePoint now = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  const fml::TimeDelta frame_budget = fml::TimeDelta::FromMilliseconds(12);
+  const std::deque<FlatlandPresentationInfo> future_presentation_infos = {
+      {now + fml::TimeDelta::FromMilliseconds(10),
+       now + fml::TimeDelta::FromMilliseconds(15)},
+      {now + fml::TimeDelta::FromMilliseconds(26),
+       now + fml::TimeDelta::FromMilliseconds(31)},
+  };
+
+  const auto frame_times = FlatlandConnection::GetTargetTimes(
+      now, frame_budget, fml::TimePoint(), future_presentation_infos);
+  EXPECT_EQ(frame_times.frame_start,
+            now + fml::TimeDelta::FromMilliseconds(14));
+  EXPECT_EQ(frame_times.frame_target,
+            now + fml::TimeDelta::FromMilliseconds(31));
+}
+
+TEST(FlatlandConnectionTargetTimesTest, TargetsEachPresentationOnce) {
+  const fml::TimePoint now = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  const fml::TimeDelta frame_budget = fml::TimeDelta::FromMilliseconds(5);
+  const std::deque<FlatlandPresentationInfo> future_presentation_infos = {
+      {now + fml::TimeDelta::FromMilliseconds(10),
+       now + fml::TimeDelta::FromMilliseconds(15)},
+      {now + fml::TimeDelta::FromMilliseconds(26),
+       now + fml::TimeDelta::FromMilliseconds(31)},
+  };
+
+  const auto frame_times = FlatlandConnection::GetTargetTimes(
+      now, frame_budget, now + fml::TimeDelta::FromMilliseconds(15),
+      future_presentation_infos);
+  EXPECT_EQ(frame_times.frame_target,
+            now + fml::TimeDelta::FromMilliseconds(31));
+}
+
+TEST(FlatlandConnectionTargetTimesTest, StartsNowWithoutFeedback) {
+  const fml::TimePoint now = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+
+  const auto frame_times = FlatlandConnection::GetTargetTimes(
+      now, kInitialFlatlandFrameBudget, fml::TimePoint(), {});
+  EXPECT_EQ(frame_times.frame_start, now);
+  EXPECT_EQ(frame_times.frame_target,
+            now + kDefaultFlatlandPresentationInterval);
+  EXPECT_EQ(frame_times.latch_point, fml::TimePoint::Max());
+}
+
 }  // namespace flutter_runner::testing
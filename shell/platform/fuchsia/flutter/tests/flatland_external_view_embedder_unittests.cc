@@ -215,14 +215,18 @@ Matcher<FakeGraph> IsFlutterGraph(
 }
 
 Matcher<std::shared_ptr<FakeTransform>> IsImageLayer(
-    const fuchsia::math::SizeU& layer_size) {
+    const fuchsia::math::SizeU& layer_size,
+    const fuchsia::math::Vec& layer_translation =
+        FakeTransform::kDefaultTranslation) {
+  const fuchsia::math::RectF sample_region{
+      0.f, 0.f, static_cast<float>(layer_size.width),
+      static_cast<float>(layer_size.height)};
   return Pointee(FieldsAre(
-      /*id*/ _, FakeTransform::kDefaultTranslation,
-      FakeTransform::kDefaultClipBounds, FakeTransform::kDefaultOrientation,
-      FakeTransform::kDefaultOpacity, IsEmpty(),
+      /*id*/ _, layer_translation, FakeTransform::kDefaultClipBounds,
+      FakeTransform::kDefaultOrientation, FakeTransform::kDefaultOpacity,
+      IsEmpty(),
       Pointee(VariantWith<FakeImage>(FieldsAre(
-          /*id*/ _, IsImageProperties(layer_size),
-          FakeImage::kDefaultSampleRegion, layer_size,
+          /*id*/ _, IsImageProperties(layer_size), sample_region, layer_size,
           /*buffer_import_token*/ _, /*vmo_index*/ 0)))));
 }
 
@@ -495,6 +499,13 @@ TEST_F(FlatlandExternalViewEmbedderTest, SceneWithOneView) {
   const fuchsia::math::SizeU frame_size{
       static_cast<uint32_t>(frame_size_signed.width()),
       static_cast<uint32_t>(frame_size_signed.height())};
+  // The overlay only gets a surface for the rect it draws.
+  const fuchsia::math::SizeU overlay_size{
+      static_cast<uint32_t>(frame_size_signed.width() / 32),
+      static_cast<uint32_t>(frame_size_signed.height() / 32)};
+  const fuchsia::math::Vec overlay_translation{
+      .x = frame_size_signed.width() * 3 / 4,
+      .y = frame_size_signed.height() / 2};
   DrawFrameWithView(
       external_view_embedder, frame_size_signed, 1.f, child_view_id,
       child_view_params,
@@ -534,7 +545,7 @@ TEST_F(FlatlandExternalViewEmbedderTest, SceneWithOneView) {
           parent_viewport_watcher, viewport_creation_token, view_ref, /*layers*/
           {IsImageLayer(frame_size),
            IsViewportLayer(child_view_token, child_view_size, {0, 0}),
-           IsImageLayer(frame_size)}));
+           IsImageLayer(overlay_size, overlay_translation)}));
 
   // Destroy the view.  The scene graph shouldn't change yet.
   external_view_embedder.DestroyView(
@@ -545,7 +556,7 @@ TEST_F(FlatlandExternalViewEmbedderTest, SceneWithOneView) {
           parent_viewport_watcher, viewport_creation_token, view_ref, /*layers*/
           {IsImageLayer(frame_size),
            IsViewportLayer(child_view_token, child_view_size, {0, 0}),
-           IsImageLayer(frame_size)}));
+           IsImageLayer(overlay_size, overlay_translation)}));
 
   // Draw another frame without the view.  The scene graph shouldn't change yet.
   DrawSimpleFrame(
@@ -566,7 +577,7 @@ TEST_F(FlatlandExternalViewEmbedderTest, SceneWithOneView) {
           parent_viewport_watcher, viewport_creation_token, view_ref, /*layers*/
           {IsImageLayer(frame_size),
            IsViewportLayer(child_view_token, child_view_size, {0, 0}),
-           IsImageLayer(frame_size)}));
+           IsImageLayer(overlay_size, overlay_translation)}));
 
   // Pump the message loop.  The scene updates should propagate to flatland.
   loop().RunUntilIdle();
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/fuchsia/flutter/vulkan_surface.h"
+
+#include <fuchsia/ui/scenic/cpp/fidl.h>
+#include <lib/sys/cpp/component_context.h>
+
+#include <memory>
+#include <optional>
+
+#include "flutter/fml/memory/memory_accounting.h"
+#include "flutter/fml/message_loop_impl.h"
+#include "flutter/shell/platform/fuchsia/flutter/vulkan_surface_producer.h"
+#include "gtest/gtest.h"
+
+namespace flutter_runner {
+namespace testing {
+
+class VulkanSurfaceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // The VulkanSurfaceProducer needs the default async dispatcher of a
+    // message loop.
+    loop_ = fml::MessageLoopImpl::Create();
+    context_ = sys::ComponentContext::CreateAndServeOutgoingDirectory();
+    scenic_ = context_->svc()->Connect<fuchsia::ui::scenic::Scenic>();
+    session_.emplace(scenic_.get());
+    surface_producer_ =
+        std::make_unique<VulkanSurfaceProducer>(&session_.value());
+  }
+
+  static int64_t DeviceMemoryBytes() {
+    return fml::MemoryAccounting::GetBytes(
+        fml::MemoryCategory::kVulkanDeviceMemory);
+  }
+
+  fml::RefPtr<fml::MessageLoopImpl> loop_;
+  std::unique_ptr<sys::ComponentContext> context_;
+  fuchsia::ui::scenic::ScenicPtr scenic_;
+  std::optional<scenic::Session> session_;
+  std::unique_ptr<VulkanSurfaceProducer> surface_producer_;
+};
+
+TEST_F(VulkanSurfaceTest, ChargesDeviceMemoryUntilDestroyed) {
+  ASSERT_TRUE(surface_producer_->IsValid());
+  const int64_t bytes_before = DeviceMemoryBytes();
+
+  auto surface =
+      surface_producer_->ProduceOffscreenSurface(SkISize::Make(100, 100));
+  ASSERT_TRUE(surface);
+  ASSERT_TRUE(surface->IsValid());
+  // The image has 4 bytes per pixel, plus any padding the driver adds.
+  EXPECT_GE(DeviceMemoryBytes() - bytes_before, 100 * 100 * 4);
+
+  surface.reset();
+  EXPECT_EQ(DeviceMemoryBytes(), bytes_before);
+}
+
+}  // namespace testing
+}  // namespace flutter_runner
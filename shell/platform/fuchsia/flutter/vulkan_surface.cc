@@ -346,6 +346,7 @@ bool VulkanSurface::AllocateDeviceMemory(
                   }};
 
     vk_memory_info_ = allocation_info;
+    memory_account_.Reset(allocation_info.allocationSize);
   }
 
   // Bind image memory.
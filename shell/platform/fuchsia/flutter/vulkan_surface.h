@@ -14,6 +14,7 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_accounting.h"
 #include "flutter/vulkan/vulkan_command_buffer.h"
 #include "flutter/vulkan/vulkan_handle.h"
 #include "flutter/vulkan/vulkan_proc_table.h"
@@ -164,6 +165,8 @@ class VulkanSurface final : public SurfaceProducerSurface {
   VulkanImage vulkan_image_;
   vulkan::VulkanHandle<VkDeviceMemory> vk_memory_;
   VkMemoryAllocateInfo vk_memory_info_;
+  fml::ScopedMemoryAccount memory_account_{
+      fml::MemoryCategory::kVulkanDeviceMemory};
   vulkan::VulkanHandle<VkFence> command_buffer_fence_;
   sk_sp<SkSurface> sk_surface_;
   uint32_t buffer_id_ = 0;
@@ -76,22 +76,36 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::GetCachedOrCreateSurface(
     const SkISize& size) {
   TRACE_EVENT2("flutter", "VulkanSurfacePool::GetCachedOrCreateSurface",
                "width", size.width(), "height", size.height());
-  // First try to find a surface that exactly matches |size|.
+  // First try to find a surface that exactly matches the bucket of |size|.
+  const SkISize bucketed_size = GetBucketedSize(size);
   {
-    auto exact_match_it =
-        std::find_if(available_surfaces_.begin(), available_surfaces_.end(),
-                     [&size](const auto& surface) {
-                       return surface->IsValid() && surface->GetSize() == size;
-                     });
+    auto exact_match_it = std::find_if(
+        available_surfaces_.begin(), available_surfaces_.end(),
+        [&bucketed_size](const auto& surface) {
+          return surface->IsValid() && surface->GetSize() == bucketed_size;
+        });
     if (exact_match_it != available_surfaces_.end()) {
       auto acquired_surface = std::move(*exact_match_it);
       available_surfaces_.erase(exact_match_it);
+      trace_surfaces_reused_++;
       TRACE_EVENT_INSTANT0("flutter", "Exact match found");
       return acquired_surface;
     }
   }
 
-  return CreateSurface(size);
+  return CreateSurface(bucketed_size);
+}
+
+SkISize VulkanSurfacePool::GetBucketedSize(const SkISize& size) const {
+  if (scenic_session_) {
+    return size;
+  }
+
+  auto round_up = [](int32_t dimension) {
+    return ((dimension + kSurfaceSizeBucket - 1) / kSurfaceSizeBucket) *
+           kSurfaceSizeBucket;
+  };
+  return SkISize::Make(round_up(size.width()), round_up(size.height()));
 }
 
 void VulkanSurfacePool::SubmitSurface(
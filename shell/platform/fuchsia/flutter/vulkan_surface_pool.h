@@ -21,6 +21,10 @@ class VulkanSurfacePool final {
   static constexpr int kMaxSurfaces = 12;
   // If a surface doesn't get used for 3 or more generations, we discard it.
   static constexpr int kMaxSurfaceAge = 3;
+  // Flatland only samples the part of an image that a layer drew into, so
+  // its surfaces are allocated in multiples of this size, letting layers of
+  // similar sizes share them.
+  static constexpr int kSurfaceSizeBucket = 64;
 
   VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
                     sk_sp<GrDirectContext> context,
@@ -55,6 +59,10 @@ class VulkanSurfacePool final {
 
   std::unique_ptr<VulkanSurface> GetCachedOrCreateSurface(const SkISize& size);
 
+  // Returns the size of the bucket |size| falls into.  Gfx expects surfaces
+  // of exactly the requested size, so it is only rounded up for Flatland.
+  SkISize GetBucketedSize(const SkISize& size) const;
+
   void RecycleSurface(std::unique_ptr<VulkanSurface> surface);
 
   void RecyclePendingSurface(uintptr_t surface_key);
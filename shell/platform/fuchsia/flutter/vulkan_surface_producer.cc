@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/context_options.h"
 #include "third_party/skia/include/gpu/GrBackendSemaphore.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -137,8 +138,10 @@ bool VulkanSurfaceProducer::Initialize(scenic::Session* scenic_session) {
                      backend_context.fPhysicalDevice, 0, nullptr,
                      countof(device_extensions), device_extensions);
   backend_context.fVkExtensions = &vk_extensions;
-  GrContextOptions options;
-  options.fReduceOpsTaskSplitting = GrContextOptions::Enable::kNo;
+  // The persistent cache stores the shaders, and the pipeline cache of the
+  // device, which the rasterizer stores after the frames.
+  GrContextOptions options = flutter::MakeDefaultContextOptions(
+      flutter::ContextType::kRender, GrBackendApi::kVulkan);
 
   context_ = GrDirectContext::MakeVulkan(backend_context, options);
 
@@ -10,6 +10,7 @@
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/binary_messenger.h"
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/method_channel.h"
+#include "flutter/shell/platform/common/text_editing_delta.h"
 #include "flutter/shell/platform/common/text_input_model.h"
 #include "flutter/shell/platform/glfw/keyboard_hook_handler.h"
 #include "flutter/shell/platform/glfw/public/flutter_glfw.h"
@@ -38,9 +39,15 @@ class TextInputPlugin : public KeyboardHookHandler {
   void CharHook(GLFWwindow* window, unsigned int code_point) override;
 
  private:
-  // Sends the current state of the given model to the Flutter engine.
+  // Sends the current state of the given model to the Flutter engine, or the
+  // change since the last state it knows of if the client enabled the delta
+  // model.
   void SendStateUpdate(const TextInputModel& model);
 
+  // Sends a change of the given model to the Flutter engine.
+  void SendStateUpdateWithDelta(const TextInputModel& model,
+                                const TextEditingDelta& delta);
+
   // Sends an action triggered by the Enter key to the Flutter engine.
   void EnterPressed(TextInputModel* model);
 
@@ -58,6 +65,14 @@ class TextInputPlugin : public KeyboardHookHandler {
   // The active model. nullptr if not set.
   std::unique_ptr<TextInputModel> active_model_;
 
+  // Whether the active client receives the changes of the text as deltas
+  // instead of the whole editing state.
+  bool enable_delta_model_ = false;
+
+  // The text of the active model as the framework last saw it, which the
+  // deltas are computed against. Only kept with the delta model.
+  std::u16string framework_text_;
+
   // Keyboard type of the client. See available options:
   // https://api.flutter.dev/flutter/services/TextInputType-class.html
   std::string input_type_;
@@ -0,0 +1,275 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <errno.h>
+#include <gmodule.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+
+// Values from drm_fourcc.h.
+static constexpr uint64_t kDrmFormatModInvalid = 0x00ffffffffffffffULL;
+static constexpr uint32_t kDrmFormatAbgr8888 = 0x34324241;  // AB24
+static constexpr uint32_t kDrmFormatXbgr8888 = 0x34324258;  // XB24
+static constexpr uint32_t kDrmFormatArgb8888 = 0x34325241;  // AR24
+static constexpr uint32_t kDrmFormatXrgb8888 = 0x34325258;  // XR24
+
+// The longest time to block the raster thread for a fence, if the GPU can't
+// wait for it.
+static constexpr int kFenceTimeoutMs = 100;
+
+// The EGL attributes of the file descriptor, offset, stride and modifier of
+// each plane.
+static const EGLint kPlaneAttributes[FL_DMABUF_TEXTURE_MAX_PLANES][5] = {
+    {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT},
+};
+
+G_DEFINE_QUARK(fl_dmabuf_texture_error_quark, fl_dmabuf_texture_error)
+
+typedef struct {
+  GLuint texture_id;
+  GLenum texture_target;
+} FlDmaBufTexturePrivate;
+
+// Added here to stop the compiler from optimising this function away.
+G_MODULE_EXPORT GType fl_dmabuf_texture_get_type();
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface) {}
+
+G_DEFINE_TYPE_WITH_CODE(FlDmaBufTexture,
+                        fl_dmabuf_texture,
+                        G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(fl_texture_get_type(),
+                                              fl_dmabuf_texture_iface_init);
+                        G_ADD_PRIVATE(FlDmaBufTexture))
+
+static void fl_dmabuf_texture_dispose(GObject* object) {
+  FlDmaBufTexture* self = FL_DMABUF_TEXTURE(object);
+  FlDmaBufTexturePrivate* priv = reinterpret_cast<FlDmaBufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  if (priv->texture_id) {
+    glDeleteTextures(1, &priv->texture_id);
+    priv->texture_id = 0;
+  }
+
+  G_OBJECT_CLASS(fl_dmabuf_texture_parent_class)->dispose(object);
+}
+
+// Returns true if buffers in the format can be sampled as a 2D texture
+// rather than as an external texture, which are converted to RGB by the
+// driver.
+static bool is_rgb_format(uint32_t fourcc) {
+  switch (fourcc) {
+    case kDrmFormatAbgr8888:
+    case kDrmFormatXbgr8888:
+    case kDrmFormatArgb8888:
+    case kDrmFormatXrgb8888:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Makes the commands that follow wait for the fence, which is closed.
+static void wait_for_fence(EGLDisplay display, int fence_fd) {
+  if (epoxy_has_egl_extension(display, "EGL_ANDROID_native_fence_sync") &&
+      epoxy_has_egl_extension(display, "EGL_KHR_wait_sync")) {
+    const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fence_fd,
+                                 EGL_NONE};
+    EGLSyncKHR sync =
+        eglCreateSyncKHR(display, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+    if (sync != EGL_NO_SYNC_KHR) {
+      // The sync owns the fence now, and the GPU waits for it without
+      // blocking the raster thread.
+      eglWaitSyncKHR(display, sync, 0);
+      eglDestroySyncKHR(display, sync);
+      return;
+    }
+  }
+
+  // Otherwise wait on the CPU, as sync files are pollable.
+  struct pollfd poll_fd = {};
+  poll_fd.fd = fence_fd;
+  poll_fd.events = POLLIN;
+  int result;
+  do {
+    result = poll(&poll_fd, 1, kFenceTimeoutMs);
+  } while (result < 0 && errno == EINTR);
+  if (result <= 0) {
+    g_warning("Failed to wait for DMA-BUF fence");
+  }
+  close(fence_fd);
+}
+
+// Imports the buffer as an EGLImage, or returns EGL_NO_IMAGE_KHR on failure.
+static EGLImageKHR create_image(EGLDisplay display,
+                                const FlDmaBufBuffer* buffer,
+                                GError** error) {
+  if (buffer->n_planes < 1 || buffer->n_planes > FL_DMABUF_TEXTURE_MAX_PLANES) {
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR, FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "Invalid number of DMA-BUF planes %u", buffer->n_planes);
+    return EGL_NO_IMAGE_KHR;
+  }
+  bool has_modifier = buffer->modifier != kDrmFormatModInvalid;
+  if ((has_modifier || buffer->n_planes > 3) &&
+      !epoxy_has_egl_extension(display,
+                               "EGL_EXT_image_dma_buf_import_modifiers")) {
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR,
+                FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED,
+                "The OpenGL context can't import DMA-BUFs with modifiers or "
+                "four planes");
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  std::vector<EGLint> attributes = {
+      EGL_WIDTH,
+      static_cast<EGLint>(buffer->width),
+      EGL_HEIGHT,
+      static_cast<EGLint>(buffer->height),
+      EGL_LINUX_DRM_FOURCC_EXT,
+      static_cast<EGLint>(buffer->fourcc),
+  };
+  for (uint32_t i = 0; i < buffer->n_planes; i++) {
+    const EGLint* names = kPlaneAttributes[i];
+    const FlDmaBufPlane& plane = buffer->planes[i];
+    attributes.insert(attributes.end(),
+                      {names[0], plane.fd, names[1],
+                       static_cast<EGLint>(plane.offset), names[2],
+                       static_cast<EGLint>(plane.stride)});
+    if (has_modifier) {
+      attributes.insert(
+          attributes.end(),
+          {names[3], static_cast<EGLint>(buffer->modifier & 0xffffffff),
+           names[4], static_cast<EGLint>(buffer->modifier >> 32)});
+    }
+  }
+  attributes.push_back(EGL_NONE);
+
+  EGLImageKHR image =
+      eglCreateImageKHR(display, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT,
+                        nullptr, attributes.data());
+  if (image == EGL_NO_IMAGE_KHR) {
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR, FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "Failed to import DMA-BUF: EGL error 0x%x", eglGetError());
+  }
+  return image;
+}
+
+gboolean fl_dmabuf_texture_populate(FlDmaBufTexture* texture,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error) {
+  FlDmaBufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmaBufTexturePrivate* priv = reinterpret_cast<FlDmaBufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  EGLDisplay display = eglGetCurrentDisplay();
+  if (display == EGL_NO_DISPLAY ||
+      !epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import") ||
+      !epoxy_has_gl_extension("GL_OES_EGL_image")) {
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR,
+                FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED,
+                "The OpenGL context can't import DMA-BUFs");
+    return FALSE;
+  }
+
+  FlDmaBufBuffer buffer = {};
+  buffer.width = width;
+  buffer.height = height;
+  buffer.modifier = kDrmFormatModInvalid;
+  buffer.fence_fd = -1;
+  if (!FL_DMABUF_TEXTURE_GET_CLASS(self)->get_buffer(self, &buffer, error)) {
+    return FALSE;
+  }
+
+  GLenum target = GL_TEXTURE_2D;
+  if (!is_rgb_format(buffer.fourcc)) {
+    target = GL_TEXTURE_EXTERNAL_OES;
+    if (!epoxy_has_gl_extension("GL_OES_EGL_image_external")) {
+      g_set_error(error, FL_DMABUF_TEXTURE_ERROR,
+                  FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED,
+                  "The OpenGL context can't sample DMA-BUFs in non-RGB "
+                  "formats");
+      if (buffer.fence_fd >= 0) {
+        close(buffer.fence_fd);
+      }
+      return FALSE;
+    }
+  }
+
+  EGLImageKHR image = create_image(display, &buffer, error);
+  if (image == EGL_NO_IMAGE_KHR) {
+    if (buffer.fence_fd >= 0) {
+      close(buffer.fence_fd);
+    }
+    return FALSE;
+  }
+
+  // A texture can't change its target, so a new one is made when buffers
+  // switch between RGB and non-RGB formats.
+  if (priv->texture_id != 0 && priv->texture_target != target) {
+    glDeleteTextures(1, &priv->texture_id);
+    priv->texture_id = 0;
+  }
+  if (priv->texture_id == 0) {
+    glGenTextures(1, &priv->texture_id);
+    priv->texture_target = target;
+    glBindTexture(target, priv->texture_id);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  } else {
+    glBindTexture(target, priv->texture_id);
+  }
+  // The texture keeps the buffer alive as its storage, so the image is not
+  // needed once it is bound.
+  glEGLImageTargetTexture2DOES(target, image);
+  eglDestroyImageKHR(display, image);
+
+  GLenum gl_error = glGetError();
+  if (gl_error != GL_NO_ERROR) {
+    g_warning("Failed to bind DMA-BUF to texture: glGetError %x", gl_error);
+  }
+
+  if (buffer.fence_fd >= 0) {
+    wait_for_fence(display, buffer.fence_fd);
+  }
+
+  opengl_texture->target = target;
+  opengl_texture->name = priv->texture_id;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = buffer.width;
+  opengl_texture->height = buffer.height;
+
+  return TRUE;
+}
+
+static void fl_dmabuf_texture_class_init(FlDmaBufTextureClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_dmabuf_texture_dispose;
+}
+
+static void fl_dmabuf_texture_init(FlDmaBufTexture* self) {}
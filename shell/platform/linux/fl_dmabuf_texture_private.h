@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_PRIVATE_H_
+
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
+
+G_BEGIN_DECLS
+
+#define FL_DMABUF_TEXTURE_ERROR fl_dmabuf_texture_error_quark()
+
+typedef enum {
+  // The OpenGL context used by Flutter can't import DMA-BUFs.
+  FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED,
+  FL_DMABUF_TEXTURE_ERROR_FAILED,
+} FlDmaBufTextureError;
+
+GQuark fl_dmabuf_texture_error_quark(void) G_GNUC_CONST;
+
+/**
+ * fl_dmabuf_texture_populate:
+ * @texture: an #FlDmaBufTexture.
+ * @width: width of the texture.
+ * @height: height of the texture.
+ * @opengl_texture: (out): return an #FlutterOpenGLTexture.
+ * @error: (allow-none): #GError location to store the error occurring, or
+ * %NULL to ignore.
+ *
+ * Attempts to populate the specified @opengl_texture with texture details
+ * such as the name, width, height and the pixel format, binding the current
+ * buffer of @texture to the OpenGL texture.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean fl_dmabuf_texture_populate(FlDmaBufTexture* texture,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_PRIVATE_H_
@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_texture_private.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "gtest/gtest.h"
+
+#include <epoxy/gl.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static constexpr uint32_t BUFFER_WIDTH = 4u;
+static constexpr uint32_t BUFFER_HEIGHT = 4u;
+static constexpr uint32_t REAL_BUFFER_WIDTH = 2u;
+static constexpr uint32_t REAL_BUFFER_HEIGHT = 2u;
+
+static constexpr uint32_t DRM_FORMAT_ABGR8888 = 0x34324241;
+static constexpr uint32_t DRM_FORMAT_NV12 = 0x3231564e;
+static constexpr uint64_t DRM_FORMAT_MOD_INVALID = 0x00ffffffffffffff;
+
+G_DECLARE_FINAL_TYPE(FlTestDmaBufTexture,
+                     fl_test_dmabuf_texture,
+                     FL,
+                     TEST_DMABUF_TEXTURE,
+                     FlDmaBufTexture)
+
+/// A texture that returns a fixed buffer, or fails if it has no planes.
+struct _FlTestDmaBufTexture {
+  FlDmaBufTexture parent_instance;
+
+  FlDmaBufBuffer buffer;
+};
+
+G_DEFINE_TYPE(FlTestDmaBufTexture,
+              fl_test_dmabuf_texture,
+              fl_dmabuf_texture_get_type())
+
+static gboolean fl_test_dmabuf_texture_get_buffer(FlDmaBufTexture* texture,
+                                                  FlDmaBufBuffer* buffer,
+                                                  GError** error) {
+  FlTestDmaBufTexture* self = FL_TEST_DMABUF_TEXTURE(texture);
+
+  EXPECT_EQ(buffer->width, BUFFER_WIDTH);
+  EXPECT_EQ(buffer->height, BUFFER_HEIGHT);
+  EXPECT_EQ(buffer->modifier, DRM_FORMAT_MOD_INVALID);
+  EXPECT_EQ(buffer->fence_fd, -1);
+  if (self->buffer.n_planes == 0) {
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR, FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "No buffer");
+    return FALSE;
+  }
+
+  *buffer = self->buffer;
+
+  return TRUE;
+}
+
+static void fl_test_dmabuf_texture_class_init(
+    FlTestDmaBufTextureClass* klass) {
+  FL_DMABUF_TEXTURE_CLASS(klass)->get_buffer =
+      fl_test_dmabuf_texture_get_buffer;
+}
+
+static void fl_test_dmabuf_texture_init(FlTestDmaBufTexture* self) {}
+
+// Creates a texture with a buffer in the format, and no buffer if @n_planes
+// is zero.
+static FlTestDmaBufTexture* fl_test_dmabuf_texture_new(uint32_t fourcc,
+                                                       uint32_t n_planes) {
+  FlTestDmaBufTexture* self = FL_TEST_DMABUF_TEXTURE(
+      g_object_new(fl_test_dmabuf_texture_get_type(), nullptr));
+  self->buffer.width = REAL_BUFFER_WIDTH;
+  self->buffer.height = REAL_BUFFER_HEIGHT;
+  self->buffer.fourcc = fourcc;
+  self->buffer.modifier = DRM_FORMAT_MOD_INVALID;
+  self->buffer.n_planes = n_planes;
+  for (uint32_t i = 0; i < n_planes; i++) {
+    self->buffer.planes[i].fd = 3;
+    self->buffer.planes[i].offset = i * REAL_BUFFER_WIDTH * 4;
+    self->buffer.planes[i].stride = REAL_BUFFER_WIDTH * 4;
+  }
+  self->buffer.fence_fd = -1;
+  return self;
+}
+
+// Test that getting the texture ID works.
+TEST(FlDmaBufTextureTest, TextureID) {
+  g_autoptr(FlTexture) texture =
+      FL_TEXTURE(fl_test_dmabuf_texture_new(DRM_FORMAT_ABGR8888, 1));
+  EXPECT_EQ(fl_texture_get_texture_id(texture),
+            reinterpret_cast<int64_t>(texture));
+}
+
+// Test that populating an OpenGL texture works.
+TEST(FlDmaBufTextureTest, PopulateTexture) {
+  g_autoptr(FlDmaBufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new(DRM_FORMAT_ABGR8888, 1));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dmabuf_texture_populate(texture, BUFFER_WIDTH, BUFFER_HEIGHT,
+                                         &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.target, static_cast<uint32_t>(GL_TEXTURE_2D));
+  EXPECT_EQ(opengl_texture.width, REAL_BUFFER_WIDTH);
+  EXPECT_EQ(opengl_texture.height, REAL_BUFFER_HEIGHT);
+}
+
+// Test that buffers with a modifier can be imported.
+TEST(FlDmaBufTextureTest, PopulateTextureWithModifier) {
+  FlTestDmaBufTexture* test_texture =
+      fl_test_dmabuf_texture_new(DRM_FORMAT_ABGR8888, 1);
+  test_texture->buffer.modifier = 0x0100000000000001;  // Y_TILED
+  g_autoptr(FlDmaBufTexture) texture = FL_DMABUF_TEXTURE(test_texture);
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dmabuf_texture_populate(texture, BUFFER_WIDTH, BUFFER_HEIGHT,
+                                         &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+}
+
+// Test that failing to get a buffer is reported.
+TEST(FlDmaBufTextureTest, PopulateTextureWithoutBuffer) {
+  g_autoptr(FlDmaBufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new(DRM_FORMAT_ABGR8888, 0));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(texture, BUFFER_WIDTH, BUFFER_HEIGHT,
+                                          &opengl_texture, &error));
+  EXPECT_TRUE(g_error_matches(error, FL_DMABUF_TEXTURE_ERROR,
+                              FL_DMABUF_TEXTURE_ERROR_FAILED));
+}
+
+// Test that the fence of a buffer is waited for and closed.
+TEST(FlDmaBufTextureTest, PopulateTextureWaitsForFence) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  // A signalled fence is readable.
+  ASSERT_EQ(write(fds[1], "x", 1), 1);
+
+  FlTestDmaBufTexture* test_texture =
+      fl_test_dmabuf_texture_new(DRM_FORMAT_ABGR8888, 1);
+  test_texture->buffer.fence_fd = fds[0];
+  g_autoptr(FlDmaBufTexture) texture = FL_DMABUF_TEXTURE(test_texture);
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dmabuf_texture_populate(texture, BUFFER_WIDTH, BUFFER_HEIGHT,
+                                         &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(fcntl(fds[0], F_GETFD), -1);
+  close(fds[1]);
+}
+
+// Test that multi-planar buffers are rejected when they can't be sampled,
+// closing their fence.
+TEST(FlDmaBufTextureTest, PopulateTextureWithUnsupportedFormat) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+
+  FlTestDmaBufTexture* test_texture =
+      fl_test_dmabuf_texture_new(DRM_FORMAT_NV12, 2);
+  test_texture->buffer.fence_fd = fds[0];
+  g_autoptr(FlDmaBufTexture) texture = FL_DMABUF_TEXTURE(test_texture);
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(texture, BUFFER_WIDTH, BUFFER_HEIGHT,
+                                          &opengl_texture, &error));
+  EXPECT_TRUE(g_error_matches(error, FL_DMABUF_TEXTURE_ERROR,
+                              FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED));
+  EXPECT_EQ(fcntl(fds[0], F_GETFD), -1);
+  close(fds[1]);
+}
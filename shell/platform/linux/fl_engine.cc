@@ -11,6 +11,7 @@
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/linux/fl_binary_messenger_private.h"
 #include "flutter/shell/platform/linux/fl_dart_project_private.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 #include "flutter/shell/platform/linux/fl_plugin_registrar_private.h"
@@ -40,6 +41,10 @@ struct _FlEngine {
   FLUTTER_API_SYMBOL(FlutterEngine) engine;
   FlutterEngineProcTable embedder_api;
 
+  // Refresh rate of the display last reported to the engine, or 0 if none has
+  // been reported yet.
+  gdouble display_refresh_rate;
+
   // Function to call when a platform message is received.
   FlEnginePlatformMessageHandler platform_message_handler;
   gpointer platform_message_handler_data;
@@ -248,6 +253,9 @@ static bool fl_engine_gl_external_texture_frame_callback(
     result =
         fl_pixel_buffer_texture_populate(FL_PIXEL_BUFFER_TEXTURE(texture),
                                          width, height, opengl_texture, &error);
+  } else if (FL_IS_DMABUF_TEXTURE(texture)) {
+    result = fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(texture), width,
+                                        height, opengl_texture, &error);
   } else {
     g_warning("Unsupported texture type %" G_GINT64_FORMAT, texture_id);
     return false;
@@ -700,6 +708,29 @@ void fl_engine_send_window_metrics_event(FlEngine* self,
   self->embedder_api.SendWindowMetricsEvent(self->engine, &event);
 }
 
+void fl_engine_send_display_refresh_rate(FlEngine* self,
+                                        gdouble refresh_rate) {
+  g_return_if_fail(FL_IS_ENGINE(self));
+
+  if (self->engine == nullptr || refresh_rate <= 0 ||
+      refresh_rate == self->display_refresh_rate) {
+    return;
+  }
+
+  FlutterEngineDisplay display = {};
+  display.struct_size = sizeof(FlutterEngineDisplay);
+  display.single_display = true;
+  display.refresh_rate = refresh_rate;
+  FlutterEngineDisplaysUpdateType update_type =
+      self->display_refresh_rate == 0
+          ? kFlutterEngineDisplaysUpdateTypeStartup
+          : kFlutterEngineDisplaysUpdateTypeConfigurationChanged;
+  if (self->embedder_api.NotifyDisplayUpdate(self->engine, update_type,
+                                             &display, 1) == kSuccess) {
+    self->display_refresh_rate = refresh_rate;
+  }
+}
+
 void fl_engine_send_mouse_pointer_event(FlEngine* self,
                                         FlutterPointerPhase phase,
                                         size_t timestamp,
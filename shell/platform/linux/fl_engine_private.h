@@ -167,6 +167,18 @@ void fl_engine_send_window_metrics_event(FlEngine* engine,
                                          size_t height,
                                          double pixel_ratio);
 
+/**
+ * fl_engine_send_display_refresh_rate:
+ * @engine: an #FlEngine.
+ * @refresh_rate: refresh rate of the display in frames per second.
+ *
+ * Tells the engine the refresh rate of the display the view is shown on, so
+ * that frames are scheduled and measured against it. Rates that are unknown
+ * or that were already reported are ignored.
+ */
+void fl_engine_send_display_refresh_rate(FlEngine* engine,
+                                         gdouble refresh_rate);
+
 /**
  * fl_engine_send_mouse_pointer_event:
  * @engine: an #FlEngine.
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 #include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -28,6 +29,11 @@ static constexpr int kValueList = 12;
 static constexpr int kValueMap = 13;
 static constexpr int kValueFloat32List = 14;
 
+// Typed data lists of at least this many bytes reference the message they are
+// decoded from rather than copying it. Smaller lists are copied so they don't
+// keep the whole message alive.
+static constexpr size_t kTypedDataViewThreshold = 1024;
+
 struct _FlStandardMessageCodec {
   FlMessageCodec parent_instance;
 };
@@ -207,6 +213,38 @@ static FlValue* read_float64_value(GBytes* buffer,
   return value;
 }
 
+// Creates a typed data list of @length elements of @element_size bytes from
+// the data at @offset in @buffer, which must have been checked to contain it.
+static FlValue* read_typed_list(FlValueType type,
+                                GBytes* buffer,
+                                size_t offset,
+                                size_t element_size,
+                                uint32_t length) {
+  if (element_size * length >= kTypedDataViewThreshold) {
+    return fl_value_new_typed_list_view(type, buffer, offset, length);
+  }
+
+  const uint8_t* data = get_data(buffer, &offset);
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return fl_value_new_uint8_list(data, length);
+    case FL_VALUE_TYPE_INT32_LIST:
+      return fl_value_new_int32_list(reinterpret_cast<const int32_t*>(data),
+                                     length);
+    case FL_VALUE_TYPE_INT64_LIST:
+      return fl_value_new_int64_list(reinterpret_cast<const int64_t*>(data),
+                                     length);
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return fl_value_new_float32_list(reinterpret_cast<const float*>(data),
+                                       length);
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return fl_value_new_float_list(reinterpret_cast<const double*>(data),
+                                     length);
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+}
+
 // Reads an UTF-8 text string from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_STRING if successful or %NULL
 // on error.
@@ -243,7 +281,8 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_UINT8_LIST, buffer, *offset,
+                                   sizeof(uint8_t), length);
   *offset += length;
   return value;
 }
@@ -266,8 +305,8 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_INT32_LIST, buffer, *offset,
+                                   sizeof(int32_t), length);
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -290,8 +329,8 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_INT64_LIST, buffer, *offset,
+                                   sizeof(int64_t), length);
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -314,8 +353,8 @@ static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(float) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float32_list(
-      reinterpret_cast<const float*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_FLOAT32_LIST, buffer,
+                                   *offset, sizeof(float), length);
   *offset += sizeof(float) * length;
   return value;
 }
@@ -338,8 +377,8 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_FLOAT_LIST, buffer, *offset,
+                                   sizeof(double), length);
   *offset += sizeof(double) * length;
   return value;
 }
@@ -357,7 +396,10 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) list = fl_value_new_list();
+  // Each value takes at least one byte, so a malformed length can't reserve
+  // more than the size of the message.
+  g_autoptr(FlValue) list = fl_value_new_list_sized(
+      MIN(length, g_bytes_get_size(buffer) - *offset));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) child =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
@@ -383,7 +425,8 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  g_autoptr(FlValue) map = fl_value_new_map_sized(
+      MIN(length, (g_bytes_get_size(buffer) - *offset) / 2));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) key =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
@@ -408,7 +451,8 @@ static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
   FlStandardMessageCodec* self =
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(
+      fl_standard_message_codec_get_encoded_size(self, message, 0));
   if (!fl_standard_message_codec_write_value(self, buffer, message, error)) {
     return nullptr;
   }
@@ -470,6 +514,91 @@ void fl_standard_message_codec_write_size(FlStandardMessageCodec* codec,
   }
 }
 
+// Returns the encoded size of a size field in Flutter Standard encoding.
+static size_t get_size_size(uint32_t size) {
+  if (size < 254) {
+    return sizeof(uint8_t);
+  } else if (size <= 0xffff) {
+    return sizeof(uint8_t) + sizeof(uint16_t);
+  } else {
+    return sizeof(uint8_t) + sizeof(uint32_t);
+  }
+}
+
+// Returns @offset advanced to the next multiple of @align bytes.
+static size_t get_aligned_offset(size_t offset, size_t align) {
+  return offset % align == 0 ? offset : offset + align - offset % align;
+}
+
+// Returns the offset after a typed data list of @length elements of
+// @element_size bytes written at @offset.
+static size_t get_typed_list_end(size_t offset,
+                                 size_t element_size,
+                                 size_t length) {
+  offset += sizeof(uint8_t) + get_size_size(length);
+  return get_aligned_offset(offset, element_size) + element_size * length;
+}
+
+size_t fl_standard_message_codec_get_encoded_size(FlStandardMessageCodec* self,
+                                                  FlValue* value,
+                                                  size_t offset) {
+  if (value == nullptr) {
+    return offset + sizeof(uint8_t);
+  }
+
+  switch (fl_value_get_type(value)) {
+    case FL_VALUE_TYPE_NULL:
+    case FL_VALUE_TYPE_BOOL:
+      return offset + sizeof(uint8_t);
+    case FL_VALUE_TYPE_INT: {
+      int64_t v = fl_value_get_int(value);
+      return offset + sizeof(uint8_t) +
+             (v >= INT32_MIN && v <= INT32_MAX ? sizeof(int32_t)
+                                               : sizeof(int64_t));
+    }
+    case FL_VALUE_TYPE_FLOAT:
+      return get_aligned_offset(offset + sizeof(uint8_t), 8) + sizeof(double);
+    case FL_VALUE_TYPE_STRING: {
+      size_t length = strlen(fl_value_get_string(value));
+      return offset + sizeof(uint8_t) + get_size_size(length) + length;
+    }
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return get_typed_list_end(offset, sizeof(uint8_t),
+                                fl_value_get_length(value));
+    case FL_VALUE_TYPE_INT32_LIST:
+      return get_typed_list_end(offset, sizeof(int32_t),
+                                fl_value_get_length(value));
+    case FL_VALUE_TYPE_INT64_LIST:
+      return get_typed_list_end(offset, sizeof(int64_t),
+                                fl_value_get_length(value));
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return get_typed_list_end(offset, sizeof(float),
+                                fl_value_get_length(value));
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return get_typed_list_end(offset, sizeof(double),
+                                fl_value_get_length(value));
+    case FL_VALUE_TYPE_LIST:
+      offset += sizeof(uint8_t) + get_size_size(fl_value_get_length(value));
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        offset = fl_standard_message_codec_get_encoded_size(
+            self, fl_value_get_list_value(value, i), offset);
+      }
+      return offset;
+    case FL_VALUE_TYPE_MAP:
+      offset += sizeof(uint8_t) + get_size_size(fl_value_get_length(value));
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        offset = fl_standard_message_codec_get_encoded_size(
+            self, fl_value_get_map_key(value, i), offset);
+        offset = fl_standard_message_codec_get_encoded_size(
+            self, fl_value_get_map_value(value, i), offset);
+      }
+      return offset;
+  }
+
+  // Unsupported types fail to be written, so their size doesn't matter.
+  return offset;
+}
+
 gboolean fl_standard_message_codec_read_size(FlStandardMessageCodec* codec,
                                              GBytes* buffer,
                                              size_t* offset,
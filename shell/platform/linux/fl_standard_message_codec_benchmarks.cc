@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
+
+// The payloads have the same shapes as the ones of
+// common/client_wrapper/standard_codec_benchmarks.cc. The values and the
+// messages are allocated with g_malloc, so unlike the C++ codecs the
+// allocations aren't counted.
+
+// A map of 1000 entries, such as the arguments of a method with many fields.
+static FlValue* create_large_map() {
+  FlValue* map = fl_value_new_map();
+  for (int i = 0; i < 1000; i++) {
+    g_autofree gchar* key = g_strdup_printf("key%d", i);
+    FlValue* value;
+    switch (i % 4) {
+      case 0:
+        value = fl_value_new_int(i);
+        break;
+      case 1:
+        value = fl_value_new_float(i * 0.5);
+        break;
+      case 2: {
+        g_autofree gchar* string = g_strdup_printf("value%d", i);
+        value = fl_value_new_string(string);
+        break;
+      }
+      default:
+        value = fl_value_new_bool(i % 8 == 3);
+        break;
+    }
+    fl_value_set_string_take(map, key, value);
+  }
+  return map;
+}
+
+// 1 MiB of bytes, such as an image.
+static FlValue* create_byte_array() {
+  std::vector<uint8_t> bytes(1 << 20);
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(i);
+  }
+  return fl_value_new_uint8_list(bytes.data(), bytes.size());
+}
+
+static FlValue* create_nested_list(int depth) {
+  FlValue* list = fl_value_new_list();
+  for (int i = 0; i < 4; i++) {
+    fl_value_append_take(list, depth > 1 ? create_nested_list(depth - 1)
+                                         : fl_value_new_int(i));
+  }
+  return list;
+}
+
+// Lists of 4 elements, 6 levels deep, such as a tree of semantics.
+static FlValue* create_nested_lists() {
+  return create_nested_list(6);
+}
+
+static void BM_FlStandardMessageCodecEncode(benchmark::State& state,
+                                            FlValue* (*create_message)()) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FlValue) message = create_message();
+  size_t encoded_size = 0;
+  for (auto _ : state) {
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(GBytes) encoded = fl_message_codec_encode_message(
+        FL_MESSAGE_CODEC(codec), message, &error);
+    encoded_size = g_bytes_get_size(encoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded_size);
+}
+
+static void BM_FlStandardMessageCodecDecode(benchmark::State& state,
+                                            FlValue* (*create_message)()) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FlValue) message = create_message();
+  g_autoptr(GBytes) encoded = fl_message_codec_encode_message(
+      FL_MESSAGE_CODEC(codec), message, nullptr);
+  for (auto _ : state) {
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(FlValue) decoded = fl_message_codec_decode_message(
+        FL_MESSAGE_CODEC(codec), encoded, &error);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * g_bytes_get_size(encoded));
+}
+
+BENCHMARK_CAPTURE(BM_FlStandardMessageCodecEncode, LargeMap, create_large_map)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_FlStandardMessageCodecEncode,
+                  ByteArray,
+                  create_byte_array)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_FlStandardMessageCodecEncode,
+                  NestedLists,
+                  create_nested_lists)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_FlStandardMessageCodecDecode, LargeMap, create_large_map)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_FlStandardMessageCodecDecode,
+                  ByteArray,
+                  create_byte_array)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_FlStandardMessageCodecDecode,
+                  NestedLists,
+                  create_nested_lists)
+    ->Unit(benchmark::kMicrosecond);
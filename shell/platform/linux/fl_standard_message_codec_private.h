@@ -57,6 +57,23 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* codec,
                                                FlValue* value,
                                                GError** error);
 
+/**
+ * fl_standard_message_codec_get_encoded_size:
+ * @codec: an #FlStandardMessageCodec.
+ * @value: (allow-none): value to measure.
+ * @offset: position in the buffer @value would be written at.
+ *
+ * Computes where an #FlValue written at @offset in Flutter Standard encoding
+ * would end, so buffers can be allocated at their final size before writing.
+ * The offset matters since some values are aligned relative to the start of
+ * the buffer.
+ *
+ * Returns: the position in the buffer after @value.
+ */
+size_t fl_standard_message_codec_get_encoded_size(FlStandardMessageCodec* codec,
+                                                  FlValue* value,
+                                                  size_t offset);
+
 /**
  * fl_standard_message_codec_read_value:
  * @codec: an #FlStandardMessageCodec.
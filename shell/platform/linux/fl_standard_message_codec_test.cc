@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
+#include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
 #include "flutter/shell/platform/linux/testing/fl_test.h"
 #include "gtest/gtest.h"
 
@@ -1087,3 +1088,72 @@ TEST(FlStandardMessageCodecTest, EncodeDecode) {
 
   ASSERT_TRUE(fl_value_equal(input, output));
 }
+
+TEST(FlStandardMessageCodecTest, DecodeLargeTypedDataReferencesMessage) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+
+  double data[1024];
+  for (size_t i = 0; i < G_N_ELEMENTS(data); i++) {
+    data[i] = i * 0.5;
+  }
+  g_autoptr(FlValue) input = fl_value_new_list();
+  fl_value_append_take(input, fl_value_new_int(1));
+  fl_value_append_take(input,
+                       fl_value_new_float_list(data, G_N_ELEMENTS(data)));
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), input, &error);
+  ASSERT_NE(message, nullptr);
+  EXPECT_EQ(error, nullptr);
+
+  g_autoptr(FlValue) output =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  ASSERT_NE(output, nullptr);
+  EXPECT_EQ(error, nullptr);
+  ASSERT_TRUE(fl_value_equal(input, output));
+
+  // The list elements are read in place from the message.
+  const uint8_t* message_data =
+      static_cast<const uint8_t*>(g_bytes_get_data(message, nullptr));
+  const uint8_t* list_data = reinterpret_cast<const uint8_t*>(
+      fl_value_get_float_list(fl_value_get_list_value(output, 1)));
+  EXPECT_GE(list_data, message_data);
+  EXPECT_LT(list_data, message_data + g_bytes_get_size(message));
+
+  // The list keeps the message alive.
+  g_autoptr(FlValue) list = fl_value_ref(fl_value_get_list_value(output, 1));
+  g_clear_pointer(&output, fl_value_unref);
+  g_clear_pointer(&message, g_bytes_unref);
+  EXPECT_EQ(fl_value_get_float_list(list)[1023], 511.5);
+}
+
+TEST(FlStandardMessageCodecTest, EncodedSizeMatchesMessageSize) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+
+  g_autoptr(FlValue) input = fl_value_new_map();
+  fl_value_set_string_take(input, "null", fl_value_new_null());
+  fl_value_set_string_take(input, "int32", fl_value_new_int(42));
+  fl_value_set_string_take(input, "int64", fl_value_new_int(G_MAXINT64));
+  fl_value_set_string_take(input, "float", fl_value_new_float(M_PI));
+  g_autofree gchar* long_string = g_strnfill(300, 'a');
+  fl_value_set_string_take(input, "string", fl_value_new_string(long_string));
+  uint8_t bytes[] = {1, 2, 3};
+  fl_value_set_string_take(input, "uint8",
+                           fl_value_new_uint8_list(bytes, sizeof(bytes)));
+  float floats[] = {1.0, 2.0};
+  fl_value_set_string_take(input, "float32",
+                           fl_value_new_float32_list(floats, 2));
+  g_autoptr(FlValue) list = fl_value_new_list();
+  fl_value_append_take(list, fl_value_new_bool(TRUE));
+  fl_value_append_take(list, fl_value_new_float(0.5));
+  fl_value_set_string(input, "list", list);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), input, &error);
+  ASSERT_NE(message, nullptr);
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(fl_standard_message_codec_get_encoded_size(codec, input, 0),
+            g_bytes_get_size(message));
+}
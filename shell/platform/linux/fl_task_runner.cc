@@ -5,8 +5,22 @@
 #include "flutter/shell/platform/linux/fl_task_runner.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 
-static constexpr int kMicrosecondsPerNanosecond = 1000;
-static constexpr int kMillisecondsPerMicrosecond = 1000;
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+static constexpr gint64 kNanosecondsPerMicrosecond = 1000;
+static constexpr gint64 kNanosecondsPerSecond = 1000000000;
+
+// A main loop source that dispatches the tasks of a task runner once they
+// expire. It waits on a timer file descriptor armed with the nanosecond
+// deadline of the earliest task, instead of a millisecond timeout.
+typedef struct {
+  GSource parent;
+  FlTaskRunner* task_runner;
+  gpointer timer_tag;
+} FlTaskRunnerSource;
 
 struct _FlTaskRunner {
   GObject parent_instance;
@@ -16,109 +30,165 @@ struct _FlTaskRunner {
   GMutex mutex;
   GCond cond;
 
-  guint timeout_source_id;
-  GList /*<FlTaskRunnerTask>*/* pending_tasks;
+  int timer_fd;
+  GSource* source;
+  // Pending tasks, ordered by their time and then by the order in which they
+  // were posted.
+  GSequence /*<FlTaskRunnerTask>*/* pending_tasks;
+  guint64 next_task_order;
+  // The deadline the timer is armed with, or G_MAXINT64 if it is disarmed.
+  gint64 timer_time_nanos;
   gboolean blocking_main_thread;
 };
 
 typedef struct _FlTaskRunnerTask {
-  // absolute time of task (based on g_get_monotonic_time)
-  gint64 task_time_micros;
+  // absolute time of task (based on CLOCK_MONOTONIC, like the engine time)
+  gint64 task_time_nanos;
+  guint64 order;
   FlutterTask task;
 } FlTaskRunnerTask;
 
 G_DEFINE_TYPE(FlTaskRunner, fl_task_runner, G_TYPE_OBJECT)
 
-// Removes expired tasks from the task queue and executes them.
-// The execution is performed with mutex unlocked.
+static gint64 get_monotonic_time_nanos() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * kNanosecondsPerSecond + now.tv_nsec;
+}
+
+static gint compare_tasks(gconstpointer a,
+                          gconstpointer b,
+                          gpointer user_data) {
+  const FlTaskRunnerTask* task_a = static_cast<const FlTaskRunnerTask*>(a);
+  const FlTaskRunnerTask* task_b = static_cast<const FlTaskRunnerTask*>(b);
+  if (task_a->task_time_nanos != task_b->task_time_nanos) {
+    return task_a->task_time_nanos < task_b->task_time_nanos ? -1 : 1;
+  }
+  return task_a->order < task_b->order ? -1 : 1;
+}
+
+// Returns the absolute time of next expired task (in nanoseconds, based on
+// CLOCK_MONOTONIC). If no task is scheduled returns G_MAXINT64.
+static gint64 fl_task_runner_next_task_expiration_time_locked(
+    FlTaskRunner* self) {
+  GSequenceIter* first = g_sequence_get_begin_iter(self->pending_tasks);
+  if (g_sequence_iter_is_end(first)) {
+    return G_MAXINT64;
+  }
+  return static_cast<FlTaskRunnerTask*>(g_sequence_get(first))
+      ->task_time_nanos;
+}
+
+// Removes expired tasks from the task queue and executes them, all of them in
+// a single batch. The execution is performed with mutex unlocked.
 static void fl_task_runner_process_expired_tasks_locked(FlTaskRunner* self) {
-  GList* expired_tasks = nullptr;
-
-  gint64 current_time = g_get_monotonic_time();
-
-  GList* l = self->pending_tasks;
-  while (l != nullptr) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    if (task->task_time_micros <= current_time) {
-      GList* link = l;
-      l = l->next;
-      self->pending_tasks = g_list_remove_link(self->pending_tasks, link);
-      expired_tasks = g_list_concat(expired_tasks, link);
-    } else {
-      l = l->next;
+  g_autoptr(GArray) expired_tasks =
+      g_array_new(FALSE, FALSE, sizeof(FlutterTask));
+
+  gint64 current_time = get_monotonic_time_nanos();
+
+  GSequenceIter* iter = g_sequence_get_begin_iter(self->pending_tasks);
+  while (!g_sequence_iter_is_end(iter)) {
+    FlTaskRunnerTask* task =
+        static_cast<FlTaskRunnerTask*>(g_sequence_get(iter));
+    if (task->task_time_nanos > current_time) {
+      break;
     }
+    g_array_append_val(expired_tasks, task->task);
+    GSequenceIter* next = g_sequence_iter_next(iter);
+    g_sequence_remove(iter);
+    iter = next;
+  }
+
+  if (expired_tasks->len == 0) {
+    return;
   }
 
   g_mutex_unlock(&self->mutex);
 
-  l = expired_tasks;
-  while (l != nullptr && self->engine) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    fl_engine_execute_task(self->engine, &task->task);
-    l = l->next;
+  for (guint i = 0; i < expired_tasks->len && self->engine; i++) {
+    fl_engine_execute_task(self->engine,
+                           &g_array_index(expired_tasks, FlutterTask, i));
   }
 
-  g_list_free_full(expired_tasks, g_free);
-
   g_mutex_lock(&self->mutex);
 }
 
-static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self);
+// Arms the timer with the time of the next task, which wakes up the main loop
+// once that task expires. A time in the past wakes it up immediately.
+static void fl_task_runner_arm_timer_locked(FlTaskRunner* self) {
+  gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
+  if (min_time == self->timer_time_nanos) {
+    return;
+  }
+  self->timer_time_nanos = min_time;
+
+  struct itimerspec timer_spec = {};
+  if (min_time != G_MAXINT64) {
+    // A zero deadline would disarm the timer.
+    min_time = MAX(min_time, 1);
+    timer_spec.it_value.tv_sec = min_time / kNanosecondsPerSecond;
+    timer_spec.it_value.tv_nsec = min_time % kNanosecondsPerSecond;
+  }
+  if (timerfd_settime(self->timer_fd, TFD_TIMER_ABSTIME, &timer_spec,
+                      nullptr) != 0) {
+    g_warning("Failed to arm the task runner timer: %s", g_strerror(errno));
+  }
+}
+
+static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
+  if (self->blocking_main_thread) {
+    // Wake up blocked thread
+    g_cond_signal(&self->cond);
+  } else {
+    fl_task_runner_arm_timer_locked(self);
+  }
+}
 
-// Invoked from a timeout source. Removes and executes expired tasks
-// and reschedules timeout if needed.
-static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
-  FlTaskRunner* self = FL_TASK_RUNNER(data);
+// Invoked from the main loop when the timer expired. Executes all of the
+// expired tasks and rearms the timer for the next one.
+static gboolean fl_task_runner_source_dispatch(GSource* source,
+                                               GSourceFunc callback,
+                                               gpointer user_data) {
+  FlTaskRunnerSource* task_runner_source =
+      reinterpret_cast<FlTaskRunnerSource*>(source);
+  FlTaskRunner* self = task_runner_source->task_runner;
+
+  if (g_source_query_unix_fd(source, task_runner_source->timer_tag) &
+      G_IO_IN) {
+    guint64 expirations;
+    // Resets the readiness of the timer, which is non-blocking.
+    if (read(self->timer_fd, &expirations, sizeof(expirations)) < 0 &&
+        errno != EAGAIN) {
+      g_warning("Failed to read the task runner timer: %s", g_strerror(errno));
+    }
+  }
 
   g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);
   (void)locker;  // unused variable
 
   g_object_ref(self);
 
-  self->timeout_source_id = 0;
+  // The timer has fired, so it has to be armed again even for the same time.
+  self->timer_time_nanos = G_MAXINT64;
   fl_task_runner_process_expired_tasks_locked(self);
 
-  // reschedule timeout
+  // reschedule timer
   fl_task_runner_tasks_did_change_locked(self);
 
   g_object_unref(self);
 
-  return FALSE;
-}
-
-// Returns the absolute time of next expired task (in microseconds, based on
-// g_get_monotonic_time). If no task is scheduled returns G_MAXINT64.
-static gint64 fl_task_runner_next_task_expiration_time_locked(
-    FlTaskRunner* self) {
-  gint64 min_time = G_MAXINT64;
-  GList* l = self->pending_tasks;
-  while (l != nullptr) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    min_time = MIN(min_time, task->task_time_micros);
-    l = l->next;
-  }
-  return min_time;
+  return G_SOURCE_CONTINUE;
 }
 
-static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
-  if (self->blocking_main_thread) {
-    // Wake up blocked thread
-    g_cond_signal(&self->cond);
-  } else {
-    // Reschedule timeout
-    if (self->timeout_source_id != 0) {
-      g_source_remove(self->timeout_source_id);
-      self->timeout_source_id = 0;
-    }
-    gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
-    if (min_time != G_MAXINT64) {
-      gint64 remaining = MAX(min_time - g_get_monotonic_time(), 0);
-      self->timeout_source_id =
-          g_timeout_add(remaining / kMillisecondsPerMicrosecond + 1,
-                        fl_task_runner_on_expired_timeout, self);
-    }
-  }
-}
+static GSourceFuncs fl_task_runner_source_funcs = {
+    nullptr,                         // prepare
+    nullptr,                         // check
+    fl_task_runner_source_dispatch,  // dispatch
+    nullptr,                         // finalize
+    nullptr,                         // closure_callback
+    nullptr,                         // closure_marshal
+};
 
 static void engine_weak_notify_cb(gpointer user_data,
                                   GObject* where_the_object_was) {
@@ -138,13 +208,19 @@ void fl_task_runner_dispose(GObject* object) {
     self->engine = nullptr;
   }
 
+  if (self->source != nullptr) {
+    g_source_destroy(self->source);
+    g_clear_pointer(&self->source, g_source_unref);
+  }
+  if (self->timer_fd >= 0) {
+    close(self->timer_fd);
+    self->timer_fd = -1;
+  }
+
   g_mutex_clear(&self->mutex);
   g_cond_clear(&self->cond);
 
-  g_list_free_full(self->pending_tasks, g_free);
-  if (self->timeout_source_id != 0) {
-    g_source_remove(self->timeout_source_id);
-  }
+  g_clear_pointer(&self->pending_tasks, g_sequence_free);
 
   G_OBJECT_CLASS(fl_task_runner_parent_class)->dispose(object);
 }
@@ -156,6 +232,23 @@ static void fl_task_runner_class_init(FlTaskRunnerClass* klass) {
 static void fl_task_runner_init(FlTaskRunner* self) {
   g_mutex_init(&self->mutex);
   g_cond_init(&self->cond);
+
+  self->pending_tasks = g_sequence_new(g_free);
+  self->timer_time_nanos = G_MAXINT64;
+  self->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (self->timer_fd < 0) {
+    g_error("Failed to create the task runner timer: %s", g_strerror(errno));
+  }
+
+  self->source =
+      g_source_new(&fl_task_runner_source_funcs, sizeof(FlTaskRunnerSource));
+  g_source_set_name(self->source, "FlTaskRunner");
+  FlTaskRunnerSource* task_runner_source =
+      reinterpret_cast<FlTaskRunnerSource*>(self->source);
+  task_runner_source->task_runner = self;
+  task_runner_source->timer_tag =
+      g_source_add_unix_fd(self->source, self->timer_fd, G_IO_IN);
+  g_source_attach(self->source, nullptr);
 }
 
 FlTaskRunner* fl_task_runner_new(FlEngine* engine) {
@@ -174,10 +267,15 @@ void fl_task_runner_post_task(FlTaskRunner* self,
 
   FlTaskRunnerTask* runner_task = g_new0(FlTaskRunnerTask, 1);
   runner_task->task = task;
-  runner_task->task_time_micros =
-      target_time_nanos / kMicrosecondsPerNanosecond;
-
-  self->pending_tasks = g_list_append(self->pending_tasks, runner_task);
+  // G_MAXINT64 stands for no task.
+  runner_task->task_time_nanos =
+      target_time_nanos < static_cast<uint64_t>(G_MAXINT64)
+          ? static_cast<gint64>(target_time_nanos)
+          : G_MAXINT64 - 1;
+  runner_task->order = self->next_task_order++;
+
+  g_sequence_insert_sorted(self->pending_tasks, runner_task, compare_tasks,
+                           nullptr);
   fl_task_runner_tasks_did_change_locked(self);
 }
 
@@ -191,12 +289,19 @@ void fl_task_runner_block_main_thread(FlTaskRunner* self) {
 
   self->blocking_main_thread = true;
   while (self->blocking_main_thread) {
-    g_cond_wait_until(&self->cond, &self->mutex,
-                      fl_task_runner_next_task_expiration_time_locked(self));
+    gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
+    // The condition only waits with microsecond precision, so it is rounded
+    // up to not wake up before the task expired.
+    g_cond_wait_until(
+        &self->cond, &self->mutex,
+        min_time == G_MAXINT64
+            ? G_MAXINT64
+            : (min_time + kNanosecondsPerMicrosecond - 1) /
+                  kNanosecondsPerMicrosecond);
     fl_task_runner_process_expired_tasks_locked(self);
   }
 
-  // Tasks might have changed in the meanwhile, reschedule timeout
+  // Tasks might have changed in the meanwhile, reschedule timer
   fl_task_runner_tasks_did_change_locked(self);
 
   g_object_unref(self);
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Included first as it collides with the X11 headers.
+#include "gtest/gtest.h"
+
+#include <time.h>
+
+#include <vector>
+
+#include "flutter/shell/platform/embedder/test_utils/proc_table_replacement.h"
+#include "flutter/shell/platform/linux/fl_engine_private.h"
+#include "flutter/shell/platform/linux/fl_task_runner.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+
+static constexpr uint64_t kNanosecondsPerMillisecond = 1000000;
+
+// Returns the current time in the clock of the engine.
+static uint64_t get_time_nanos() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * G_GUINT64_CONSTANT(1000000000) + now.tv_nsec;
+}
+
+static gboolean timeout_cb(gpointer user_data) {
+  *static_cast<gboolean*>(user_data) = TRUE;
+  return G_SOURCE_REMOVE;
+}
+
+// Checks that delayed tasks run once they expire, in the order of their
+// times and then of their posting, from the timer source on the main loop.
+TEST(FlTaskRunnerTest, RunsDelayedTasksInOrder) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  std::vector<uint64_t> executed;
+  std::vector<uint64_t> execution_times;
+  embedder_api->RunTask = MOCK_ENGINE_PROC(
+      RunTask, ([&executed, &execution_times](auto engine,
+                                             const FlutterTask* task) {
+        executed.push_back(task->task);
+        execution_times.push_back(get_time_nanos());
+        return kSuccess;
+      }));
+
+  g_autoptr(FlTaskRunner) task_runner = fl_task_runner_new(engine);
+  uint64_t now = get_time_nanos();
+  std::vector<uint64_t> target_times = {
+      now + 20 * kNanosecondsPerMillisecond,
+      now + 10 * kNanosecondsPerMillisecond,
+      now + 10 * kNanosecondsPerMillisecond,
+      now,
+  };
+  for (size_t i = 0; i < target_times.size(); i++) {
+    fl_task_runner_post_task(task_runner, FlutterTask{nullptr, i},
+                             target_times[i]);
+  }
+
+  gboolean timed_out = FALSE;
+  guint timeout_id = g_timeout_add_seconds(5, timeout_cb, &timed_out);
+  while (executed.size() < target_times.size() && !timed_out) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+  ASSERT_FALSE(timed_out);
+  g_source_remove(timeout_id);
+
+  EXPECT_EQ(executed, std::vector<uint64_t>({3, 1, 2, 0}));
+  // The timer has nanosecond precision, so no task runs before its time.
+  for (size_t i = 0; i < executed.size(); i++) {
+    EXPECT_GE(execution_times[i], target_times[executed[i]]);
+  }
+}
+
+// Checks that a task posted for an earlier time than the pending ones rearms
+// the timer for that time.
+TEST(FlTaskRunnerTest, RearmsTimerForEarlierTask) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  std::vector<uint64_t> executed;
+  embedder_api->RunTask = MOCK_ENGINE_PROC(
+      RunTask, ([&executed](auto engine, const FlutterTask* task) {
+        executed.push_back(task->task);
+        return kSuccess;
+      }));
+
+  g_autoptr(FlTaskRunner) task_runner = fl_task_runner_new(engine);
+  uint64_t now = get_time_nanos();
+  fl_task_runner_post_task(task_runner, FlutterTask{nullptr, 0},
+                           now + 60000 * kNanosecondsPerMillisecond);
+  fl_task_runner_post_task(task_runner, FlutterTask{nullptr, 1},
+                           now + 5 * kNanosecondsPerMillisecond);
+
+  gboolean timed_out = FALSE;
+  guint timeout_id = g_timeout_add_seconds(5, timeout_cb, &timed_out);
+  while (executed.empty() && !timed_out) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+  ASSERT_FALSE(timed_out);
+  g_source_remove(timeout_id);
+
+  // The task far in the future is still pending.
+  EXPECT_EQ(executed, std::vector<uint64_t>({1}));
+}
@@ -6,6 +6,7 @@
 
 #include <gtk/gtk.h>
 
+#include "flutter/shell/platform/common/text_editing_delta.h"
 #include "flutter/shell/platform/common/text_input_model.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_json_method_codec.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_method_channel.h"
@@ -21,6 +22,8 @@ static constexpr char kClearClientMethod[] = "TextInput.clearClient";
 static constexpr char kHideMethod[] = "TextInput.hide";
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+static constexpr char kUpdateEditingStateWithDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 static constexpr char kSetEditableSizeAndTransform[] =
     "TextInput.setEditableSizeAndTransform";
@@ -29,6 +32,7 @@ static constexpr char kSetMarkedTextRect[] = "TextInput.setMarkedTextRect";
 static constexpr char kInputActionKey[] = "inputAction";
 static constexpr char kTextInputTypeKey[] = "inputType";
 static constexpr char kTextInputTypeNameKey[] = "name";
+static constexpr char kEnableDeltaModelKey[] = "enableDeltaModel";
 static constexpr char kTextKey[] = "text";
 static constexpr char kSelectionBaseKey[] = "selectionBase";
 static constexpr char kSelectionExtentKey[] = "selectionExtent";
@@ -36,6 +40,11 @@ static constexpr char kSelectionAffinityKey[] = "selectionAffinity";
 static constexpr char kSelectionIsDirectionalKey[] = "selectionIsDirectional";
 static constexpr char kComposingBaseKey[] = "composingBase";
 static constexpr char kComposingExtentKey[] = "composingExtent";
+static constexpr char kDeltasKey[] = "deltas";
+static constexpr char kDeltaOldTextKey[] = "oldText";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
 
 static constexpr char kTransform[] = "transform";
 
@@ -75,6 +84,14 @@ struct FlTextInputPluginPrivate {
 
   flutter::TextInputModel* text_model;
 
+  // Whether the client receives the changes of the text as deltas instead of
+  // the whole editing state.
+  gboolean enable_delta_model;
+
+  // The text of the model as Flutter last saw it, which the deltas are
+  // computed against. Only kept with the delta model.
+  std::u16string* framework_text;
+
   // The owning Flutter view.
   FlView* view;
 
@@ -116,11 +133,86 @@ static void update_editing_state_response_cb(GObject* object,
   }
 }
 
+// Called when a response is received from
+// TextInputClient.updateEditingStateWithDeltas()
+static void update_editing_state_with_deltas_response_cb(GObject* object,
+                                                         GAsyncResult* result,
+                                                         gpointer user_data) {
+  g_autoptr(GError) error = nullptr;
+  if (!finish_method(object, result, &error)) {
+    g_warning("Failed to call %s: %s", kUpdateEditingStateWithDeltasMethod,
+              error->message);
+  }
+}
+
+// Informs Flutter of the change of the text since the last state it knows of.
+static void update_editing_state_with_delta(FlTextInputPlugin* self) {
+  FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
+      fl_text_input_plugin_get_instance_private(self));
+
+  // Flutter applies the delta to the text it already has, so only the
+  // changed range of the text needs to be found here.
+  flutter::TextEditingDelta delta = flutter::TextEditingDelta::FromChange(
+      std::move(*priv->framework_text), priv->text_model->GetTextUtf16());
+  *priv->framework_text = priv->text_model->GetTextUtf16();
+
+  g_autoptr(FlValue) args = fl_value_new_list();
+  fl_value_append_take(args, fl_value_new_int(priv->client_id));
+  g_autoptr(FlValue) value = fl_value_new_map();
+
+  fl_value_set_string_take(value, kDeltaOldTextKey,
+                           fl_value_new_string(delta.old_text().c_str()));
+  fl_value_set_string_take(value, kDeltaTextKey,
+                           fl_value_new_string(delta.delta_text().c_str()));
+  fl_value_set_string_take(value, kDeltaStartKey,
+                           fl_value_new_int(delta.delta_start()));
+  fl_value_set_string_take(value, kDeltaEndKey,
+                           fl_value_new_int(delta.delta_end()));
+
+  flutter::TextRange selection = priv->text_model->selection();
+  fl_value_set_string_take(value, kSelectionBaseKey,
+                           fl_value_new_int(selection.base()));
+  fl_value_set_string_take(value, kSelectionExtentKey,
+                           fl_value_new_int(selection.extent()));
+
+  int composing_base = priv->text_model->composing()
+                           ? priv->text_model->composing_range().base()
+                           : -1;
+  int composing_extent = priv->text_model->composing()
+                             ? priv->text_model->composing_range().extent()
+                             : -1;
+  fl_value_set_string_take(value, kComposingBaseKey,
+                           fl_value_new_int(composing_base));
+  fl_value_set_string_take(value, kComposingExtentKey,
+                           fl_value_new_int(composing_extent));
+
+  // The following keys are not implemented and set to default values.
+  fl_value_set_string_take(value, kSelectionAffinityKey,
+                           fl_value_new_string(kTextAffinityDownstream));
+  fl_value_set_string_take(value, kSelectionIsDirectionalKey,
+                           fl_value_new_bool(FALSE));
+
+  g_autoptr(FlValue) deltas = fl_value_new_list();
+  fl_value_append(deltas, value);
+  g_autoptr(FlValue) deltas_value = fl_value_new_map();
+  fl_value_set_string(deltas_value, kDeltasKey, deltas);
+  fl_value_append(args, deltas_value);
+
+  fl_method_channel_invoke_method(
+      priv->channel, kUpdateEditingStateWithDeltasMethod, args, nullptr,
+      update_editing_state_with_deltas_response_cb, self);
+}
+
 // Informs Flutter of text input changes.
 static void update_editing_state(FlTextInputPlugin* self) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
 
+  if (priv->enable_delta_model) {
+    update_editing_state_with_delta(self);
+    return;
+  }
+
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_int(priv->client_id));
   g_autoptr(FlValue) value = fl_value_new_map();
@@ -274,6 +366,14 @@ static FlMethodResponse* set_client(FlTextInputPlugin* self, FlValue* args) {
     priv->input_action = g_strdup(fl_value_get_string(input_action_value));
   }
 
+  priv->enable_delta_model = FALSE;
+  FlValue* enable_delta_model_value =
+      fl_value_lookup_string(config_value, kEnableDeltaModelKey);
+  if (fl_value_get_type(enable_delta_model_value) == FL_VALUE_TYPE_BOOL) {
+    priv->enable_delta_model = fl_value_get_bool(enable_delta_model_value);
+  }
+  priv->framework_text->clear();
+
   // Reset the input type, then set only if appropriate.
   priv->input_type = FL_TEXT_INPUT_TYPE_TEXT;
   FlValue* input_type_value =
@@ -342,6 +442,9 @@ static FlMethodResponse* set_editing_state(FlTextInputPlugin* self,
   priv->text_model->SetText(text);
   priv->text_model->SetSelection(
       flutter::TextRange(selection_base, selection_extent));
+  if (priv->enable_delta_model) {
+    *priv->framework_text = priv->text_model->GetTextUtf16();
+  }
 
   int64_t composing_base =
       fl_value_get_int(fl_value_lookup_string(args, kComposingBaseKey));
@@ -499,6 +602,10 @@ static void fl_text_input_plugin_dispose(GObject* object) {
     delete priv->text_model;
     priv->text_model = nullptr;
   }
+  if (priv->framework_text != nullptr) {
+    delete priv->framework_text;
+    priv->framework_text = nullptr;
+  }
   priv->view = nullptr;
 
   G_OBJECT_CLASS(fl_text_input_plugin_parent_class)->dispose(object);
@@ -607,6 +714,7 @@ static void fl_text_input_plugin_init(FlTextInputPlugin* self) {
                           G_CALLBACK(im_delete_surrounding_cb), self,
                           G_CONNECT_SWAPPED);
   priv->text_model = new flutter::TextInputModel();
+  priv->framework_text = new std::u16string();
 }
 
 FlTextInputPlugin* fl_text_input_plugin_new(
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -37,30 +38,40 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // The buffer that @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  // The buffer that @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  // The buffer that @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   float* values;
   size_t values_length;
+  // The buffer that @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueFloat32List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // The buffer that @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
@@ -86,6 +97,43 @@ static void fl_value_destroy(gpointer value) {
   fl_value_unref(static_cast<FlValue*>(value));
 }
 
+// Frees the values of a typed data list, or releases the buffer they point
+// into.
+template <typename T>
+static void free_typed_list_values(T* self) {
+  if (self->bytes != nullptr) {
+    g_bytes_unref(self->bytes);
+  } else {
+    g_free(self->values);
+  }
+}
+
+// Creates a typed data list that references the elements at @offset in @bytes,
+// or copies them if they aren't aligned for their type.
+template <typename T, typename ElementType>
+static FlValue* new_typed_list_view(FlValueType type,
+                                    GBytes* bytes,
+                                    size_t offset,
+                                    size_t data_length) {
+  g_return_val_if_fail(
+      data_length <= (g_bytes_get_size(bytes) - offset) / sizeof(ElementType),
+      nullptr);
+
+  T* self = reinterpret_cast<T*>(fl_value_new(type, sizeof(T)));
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(bytes, nullptr)) + offset;
+  self->values_length = data_length;
+  if (reinterpret_cast<uintptr_t>(data) % alignof(ElementType) == 0) {
+    self->values = reinterpret_cast<ElementType*>(const_cast<uint8_t*>(data));
+    self->bytes = g_bytes_ref(bytes);
+  } else {
+    self->values = static_cast<ElementType*>(
+        g_malloc(sizeof(ElementType) * data_length));
+    memcpy(self->values, data, sizeof(ElementType) * data_length);
+  }
+  return reinterpret_cast<FlValue*>(self);
+}
+
 // Finds the index of a key in a FlValueMap.
 // FIXME(robert-ancell) This is highly inefficient, and should be optimized if
 // necessary.
@@ -342,6 +390,13 @@ G_MODULE_EXPORT FlValue* fl_value_new_list() {
   return reinterpret_cast<FlValue*>(self);
 }
 
+FlValue* fl_value_new_list_sized(size_t reserved_size) {
+  FlValueList* self = reinterpret_cast<FlValueList*>(
+      fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
+  self->values = g_ptr_array_new_full(reserved_size, fl_value_destroy);
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
     const gchar* const* str_array) {
   g_return_val_if_fail(str_array != nullptr, nullptr);
@@ -360,6 +415,42 @@ G_MODULE_EXPORT FlValue* fl_value_new_map() {
   return reinterpret_cast<FlValue*>(self);
 }
 
+FlValue* fl_value_new_map_sized(size_t reserved_size) {
+  FlValueMap* self = reinterpret_cast<FlValueMap*>(
+      fl_value_new(FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
+  self->keys = g_ptr_array_new_full(reserved_size, fl_value_destroy);
+  self->values = g_ptr_array_new_full(reserved_size, fl_value_destroy);
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_new_typed_list_view(FlValueType type,
+                                      GBytes* bytes,
+                                      size_t offset,
+                                      size_t data_length) {
+  g_return_val_if_fail(bytes != nullptr, nullptr);
+  g_return_val_if_fail(offset <= g_bytes_get_size(bytes), nullptr);
+
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return new_typed_list_view<FlValueUint8List, uint8_t>(type, bytes,
+                                                            offset, data_length);
+    case FL_VALUE_TYPE_INT32_LIST:
+      return new_typed_list_view<FlValueInt32List, int32_t>(type, bytes,
+                                                            offset, data_length);
+    case FL_VALUE_TYPE_INT64_LIST:
+      return new_typed_list_view<FlValueInt64List, int64_t>(type, bytes,
+                                                            offset, data_length);
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return new_typed_list_view<FlValueFloat32List, float>(type, bytes, offset,
+                                                            data_length);
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return new_typed_list_view<FlValueFloatList, double>(type, bytes, offset,
+                                                           data_length);
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+}
+
 G_MODULE_EXPORT FlValue* fl_value_ref(FlValue* self) {
   g_return_val_if_fail(self != nullptr, nullptr);
   self->ref_count++;
@@ -382,27 +473,27 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      free_typed_list_values(v);
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      free_typed_list_values(v);
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      free_typed_list_values(v);
       break;
     }
     case FL_VALUE_TYPE_FLOAT32_LIST: {
       FlValueFloat32List* v = reinterpret_cast<FlValueFloat32List*>(self);
-      g_free(v->values);
+      free_typed_list_values(v);
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      free_typed_list_values(v);
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_value_new_typed_list_view:
+ * @type: the type of the list, one of the typed data list types.
+ * @bytes: buffer containing the list elements.
+ * @offset: offset of the first element in @bytes.
+ * @data_length: number of elements in the list.
+ *
+ * Creates a typed data list whose elements are read in place from @bytes
+ * rather than copied. The value keeps a reference to @bytes for as long as it
+ * is alive. The elements are copied if they aren't aligned in memory.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_typed_list_view(FlValueType type,
+                                      GBytes* bytes,
+                                      size_t offset,
+                                      size_t data_length);
+
+/**
+ * fl_value_new_list_sized:
+ * @reserved_size: number of values to reserve space for.
+ *
+ * Creates an empty ordered list with space reserved for @reserved_size values.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_list_sized(size_t reserved_size);
+
+/**
+ * fl_value_new_map_sized:
+ * @reserved_size: number of entries to reserve space for.
+ *
+ * Creates an empty map with space reserved for @reserved_size entries.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_map_sized(size_t reserved_size);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
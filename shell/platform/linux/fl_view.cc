@@ -165,6 +165,22 @@ static gboolean fl_view_send_pointer_button_event(FlView* self,
   return TRUE;
 }
 
+// Updates the engine with the refresh rate of the monitor the view is on.
+static void fl_view_update_refresh_rate(FlView* self) {
+  GdkWindow* window = gtk_widget_get_window(GTK_WIDGET(self));
+  if (window == nullptr) {
+    return;
+  }
+  GdkMonitor* monitor = gdk_display_get_monitor_at_window(
+      gtk_widget_get_display(GTK_WIDGET(self)), window);
+  if (monitor == nullptr) {
+    return;
+  }
+  // GDK reports the refresh rate in millihertz, or 0 if it is unknown.
+  fl_engine_send_display_refresh_rate(
+      self->engine, gdk_monitor_get_refresh_rate(monitor) / 1000.0);
+}
+
 // Updates the engine with the current window metrics.
 static void fl_view_geometry_changed(FlView* self) {
   GtkAllocation allocation;
@@ -174,6 +190,9 @@ static void fl_view_geometry_changed(FlView* self) {
       self->engine, allocation.width * scale_factor,
       allocation.height * scale_factor, scale_factor);
 
+  // The view may have moved to a monitor with a different refresh rate.
+  fl_view_update_refresh_rate(self);
+
   fl_renderer_wait_for_frame(self->renderer, allocation.width * scale_factor,
                              allocation.height * scale_factor);
 }
@@ -360,6 +379,8 @@ static void fl_view_realize(GtkWidget* widget) {
     g_warning("Failed to start Flutter engine: %s", error->message);
     return;
   }
+
+  fl_view_update_refresh_rate(self);
 }
 
 static void fl_view_get_preferred_width(GtkWidget* widget,
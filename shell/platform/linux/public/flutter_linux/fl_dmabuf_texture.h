@@ -0,0 +1,157 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include "fl_texture.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FL_DMABUF_TEXTURE_MAX_PLANES:
+ *
+ * The maximum number of planes of a buffer of an #FlDmaBufTexture.
+ */
+#define FL_DMABUF_TEXTURE_MAX_PLANES 4
+
+/**
+ * FlDmaBufPlane:
+ * @fd: file descriptor of the DMA-BUF holding the plane. It remains owned by
+ * the texture. Planes may share a file descriptor.
+ * @offset: offset in bytes of the plane in the DMA-BUF.
+ * @stride: number of bytes per row of the plane.
+ *
+ * The layout of a plane of an #FlDmaBufBuffer.
+ */
+typedef struct {
+  int fd;
+  uint32_t offset;
+  uint32_t stride;
+} FlDmaBufPlane;
+
+/**
+ * FlDmaBufBuffer:
+ * @width: width of the buffer in pixels.
+ * @height: height of the buffer in pixels.
+ * @fourcc: DRM fourcc code of the pixel format of the buffer, as defined in
+ * drm_fourcc.h.
+ * @modifier: DRM format modifier of the buffer, or DRM_FORMAT_MOD_INVALID if
+ * the buffer has no explicit modifier.
+ * @n_planes: number of planes of the pixel format, up to
+ * #FL_DMABUF_TEXTURE_MAX_PLANES.
+ * @planes: the layout of each plane.
+ * @fence_fd: a sync file that signals once the buffer has been written, or
+ * -1 if it already has. Flutter takes ownership of it.
+ *
+ * A frame of an #FlDmaBufTexture.
+ */
+typedef struct {
+  uint32_t width;
+  uint32_t height;
+  uint32_t fourcc;
+  uint64_t modifier;
+  uint32_t n_planes;
+  FlDmaBufPlane planes[FL_DMABUF_TEXTURE_MAX_PLANES];
+  int fence_fd;
+} FlDmaBufBuffer;
+
+G_DECLARE_DERIVABLE_TYPE(FlDmaBufTexture,
+                         fl_dmabuf_texture,
+                         FL,
+                         DMABUF_TEXTURE,
+                         GObject)
+
+/**
+ * FlDmaBufTexture:
+ *
+ * #FlDmaBufTexture represents an OpenGL texture that samples DMA-BUFs, such
+ * as the frames produced by a VA-API or V4L2 video decoder or camera.
+ *
+ * Unlike #FlPixelBufferTexture, the pixels are not copied: the buffer is
+ * imported into the OpenGL context used by Flutter as an EGLImage and drawn
+ * into the Flutter scene like any other texture. This requires Flutter to
+ * render with EGL (for example on Wayland) and the
+ * EGL_EXT_image_dma_buf_import extension. Multi-planar formats like NV12 are
+ * sampled as external textures and also require the
+ * GL_OES_EGL_image_external extension. When the buffer can't be imported the
+ * texture is not drawn, so producers that need to support other setups
+ * should fall back to an #FlPixelBufferTexture.
+ *
+ * The following example shows how to implement an #FlDmaBufTexture.
+ * ![<!-- language="C" -->
+ *   // Type definition, constructor, init, destructor and class_init are
+ *   // omitted.
+ *   struct _VideoDmaBufTexture {  // extends FlDmaBufTexture
+ *     FlDmaBufTexture parent_instance;
+ *
+ *     VideoFrame *frame;  // the most recently decoded frame.
+ *   }
+ *
+ *   G_DEFINE_TYPE(VideoDmaBufTexture,
+ *                 video_dmabuf_texture,
+ *                 fl_dmabuf_texture_get_type ())
+ *
+ *   static gboolean
+ *   video_dmabuf_texture_get_buffer (FlDmaBufTexture* texture,
+ *                                    FlDmaBufBuffer* buffer,
+ *                                    GError** error) {
+ *     // This method is called on Render Thread. Be careful with your
+ *     // cross-thread operation.
+ *     VideoDmaBufTexture *self = VIDEO_DMABUF_TEXTURE (texture);
+ *
+ *     // The buffer must not be written to while Flutter may draw it, so
+ *     // decode the next frame into another buffer and call
+ *     // fl_texture_registrar_mark_texture_frame_available () once its
+ *     // decoding has been submitted.
+ *     buffer->width = self->frame->width;
+ *     buffer->height = self->frame->height;
+ *     buffer->fourcc = DRM_FORMAT_NV12;
+ *     buffer->modifier = self->frame->modifier;
+ *     buffer->n_planes = 2;
+ *     for (int i = 0; i < 2; i++) {
+ *       buffer->planes[i].fd = self->frame->fd;
+ *       buffer->planes[i].offset = self->frame->offsets[i];
+ *       buffer->planes[i].stride = self->frame->strides[i];
+ *     }
+ *     // Flutter waits on the GPU for the decoder to finish writing.
+ *     buffer->fence_fd = dup (self->frame->fence_fd);
+ *     return TRUE;
+ *   }
+ * ]|
+ */
+
+struct _FlDmaBufTextureClass {
+  GObjectClass parent_class;
+
+  /**
+   * FlDmaBufTexture::get_buffer:
+   * @texture: an #FlDmaBufTexture.
+   * @buffer: (inout): the frame to draw. Its width and height are initially
+   * the size of the texture in the Flutter scene, its modifier is
+   * DRM_FORMAT_MOD_INVALID and its fence_fd is -1.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Retrieve the DMA-BUF holding the current frame of the texture.
+   *
+   * As this method is usually invoked from the render thread, you must
+   * take care of proper synchronization. The contents of the buffer must not
+   * change until this method returns another buffer or the texture is
+   * unregistered.
+   *
+   * Returns: %TRUE on success.
+   */
+  gboolean (*get_buffer)(FlDmaBufTexture* texture,
+                         FlDmaBufBuffer* buffer,
+                         GError** error);
+};
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
@@ -6,6 +6,8 @@
 #include <epoxy/egl.h>
 #include <epoxy/gl.h>
 
+#include <cstring>
+
 typedef struct {
   EGLint config_id;
   EGLint buffer_size;
@@ -45,11 +47,19 @@ typedef struct {
 typedef struct {
 } MockSurface;
 
+typedef struct {
+} MockImage;
+
+typedef struct {
+} MockSync;
+
 static bool display_initialized = false;
 static MockDisplay mock_display;
 static MockConfig mock_config;
 static MockContext mock_context;
 static MockSurface mock_surface;
+static MockImage mock_image;
+static MockSync mock_sync;
 
 static EGLint mock_error = EGL_SUCCESS;
 
@@ -135,6 +145,30 @@ EGLContext _eglCreateContext(EGLDisplay dpy,
   return &mock_context;
 }
 
+EGLImageKHR _eglCreateImageKHR(EGLDisplay dpy,
+                               EGLContext ctx,
+                               EGLenum target,
+                               EGLClientBuffer buffer,
+                               const EGLint* attrib_list) {
+  if (!check_display(dpy)) {
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  mock_error = EGL_SUCCESS;
+  return &mock_image;
+}
+
+EGLSyncKHR _eglCreateSyncKHR(EGLDisplay dpy,
+                             EGLenum type,
+                             const EGLint* attrib_list) {
+  if (!check_display(dpy)) {
+    return EGL_NO_SYNC_KHR;
+  }
+
+  mock_error = EGL_SUCCESS;
+  return &mock_sync;
+}
+
 EGLSurface _eglCreatePbufferSurface(EGLDisplay dpy,
                                     EGLConfig config,
                                     const EGLint* attrib_list) {
@@ -254,6 +288,26 @@ EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
   }
 }
 
+EGLBoolean _eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image) {
+  if (!check_display(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
+EGLBoolean _eglDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync) {
+  if (!check_display(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
+EGLDisplay _eglGetCurrentDisplay() {
+  return &mock_display;
+}
+
 EGLDisplay _eglGetDisplay(EGLNativeDisplayType display_id) {
   return &mock_display;
 }
@@ -326,6 +380,14 @@ EGLBoolean _eglMakeCurrent(EGLDisplay dpy,
   return bool_success();
 }
 
+EGLint _eglWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags) {
+  if (!check_display(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
 EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   if (!check_display(dpy) || !check_initialized(dpy)) {
     return EGL_FALSE;
@@ -342,6 +404,8 @@ void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
 
+static void _glEGLImageTargetTexture2DOES(GLenum target, GLeglImageOES image) {}
+
 static void _glFramebufferTexture2D(GLenum target,
                                     GLenum attachment,
                                     GLenum textarget,
@@ -378,8 +442,13 @@ static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
 
+bool epoxy_has_egl_extension(EGLDisplay dpy, const char* extension) {
+  return strcmp(extension, "EGL_EXT_image_dma_buf_import") == 0 ||
+         strcmp(extension, "EGL_EXT_image_dma_buf_import_modifiers") == 0;
+}
+
 bool epoxy_has_gl_extension(const char* extension) {
-  return false;
+  return strcmp(extension, "GL_OES_EGL_image") == 0;
 }
 
 bool epoxy_is_desktop_gl(void) {
@@ -419,6 +488,14 @@ EGLContext (*epoxy_eglCreateContext)(EGLDisplay dpy,
                                      EGLConfig config,
                                      EGLContext share_context,
                                      const EGLint* attrib_list);
+EGLImageKHR (*epoxy_eglCreateImageKHR)(EGLDisplay dpy,
+                                       EGLContext ctx,
+                                       EGLenum target,
+                                       EGLClientBuffer buffer,
+                                       const EGLint* attrib_list);
+EGLSyncKHR (*epoxy_eglCreateSyncKHR)(EGLDisplay dpy,
+                                     EGLenum type,
+                                     const EGLint* attrib_list);
 EGLSurface (*epoxy_eglCreatePbufferSurface)(EGLDisplay dpy,
                                             EGLConfig config,
                                             const EGLint* attrib_list);
@@ -430,6 +507,9 @@ EGLBoolean (*epoxy_eglGetConfigAttrib)(EGLDisplay dpy,
                                        EGLConfig config,
                                        EGLint attribute,
                                        EGLint* value);
+EGLBoolean (*epoxy_eglDestroyImageKHR)(EGLDisplay dpy, EGLImageKHR image);
+EGLBoolean (*epoxy_eglDestroySyncKHR)(EGLDisplay dpy, EGLSyncKHR sync);
+EGLDisplay (*epoxy_eglGetCurrentDisplay)();
 EGLDisplay (*epoxy_eglGetDisplay)(EGLNativeDisplayType display_id);
 EGLint (*epoxy_eglGetError)();
 void (*(*epoxy_eglGetProcAddress)(const char* procname))(void);
@@ -439,11 +519,13 @@ EGLBoolean (*epoxy_eglMakeCurrent)(EGLDisplay dpy,
                                    EGLSurface read,
                                    EGLContext ctx);
 EGLBoolean (*epoxy_eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
+EGLint (*epoxy_eglWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags);
 
 void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
+void (*epoxy_glEGLImageTargetTexture2DOES)(GLenum target, GLeglImageOES image);
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
                                      GLenum attachment,
                                      GLenum textarget,
@@ -468,20 +550,27 @@ static void library_init() {
   epoxy_eglBindAPI = _eglBindAPI;
   epoxy_eglChooseConfig = _eglChooseConfig;
   epoxy_eglCreateContext = _eglCreateContext;
+  epoxy_eglCreateImageKHR = _eglCreateImageKHR;
   epoxy_eglCreatePbufferSurface = _eglCreatePbufferSurface;
+  epoxy_eglCreateSyncKHR = _eglCreateSyncKHR;
   epoxy_eglCreateWindowSurface = _eglCreateWindowSurface;
   epoxy_eglGetConfigAttrib = _eglGetConfigAttrib;
+  epoxy_eglDestroyImageKHR = _eglDestroyImageKHR;
+  epoxy_eglDestroySyncKHR = _eglDestroySyncKHR;
+  epoxy_eglGetCurrentDisplay = _eglGetCurrentDisplay;
   epoxy_eglGetDisplay = _eglGetDisplay;
   epoxy_eglGetError = _eglGetError;
   epoxy_eglGetProcAddress = _eglGetProcAddress;
   epoxy_eglInitialize = _eglInitialize;
   epoxy_eglMakeCurrent = _eglMakeCurrent;
   epoxy_eglSwapBuffers = _eglSwapBuffers;
+  epoxy_eglWaitSyncKHR = _eglWaitSyncKHR;
 
   epoxy_glBindFramebuffer = _glBindFramebuffer;
   epoxy_glBindTexture = _glBindTexture;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
+  epoxy_glEGLImageTargetTexture2DOES = _glEGLImageTargetTexture2DOES;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenTextures = _glGenTextures;
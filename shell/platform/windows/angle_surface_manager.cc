@@ -4,6 +4,11 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <dxgi1_6.h>
+#include <wrl/client.h>
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -24,24 +29,96 @@ static void LogEglError(std::string message) {
   std::cerr << "EGL: eglGetError returned " << error << std::endl;
 }
 
+// Returns whether the space-separated |extensions| contain |name|.
+static bool HasExtension(const char* extensions, const char* name) {
+  if (!extensions) {
+    return false;
+  }
+  const size_t length = strlen(name);
+  for (const char* match = strstr(extensions, name); match;
+       match = strstr(match + length, name)) {
+    if ((match == extensions || match[-1] == ' ') &&
+        (match[length] == ' ' || match[length] == '\0')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// From EGL_ANGLE_platform_angle_d3d_luid, which selects the adapter of the
+// D3D11 renderer by its LUID.
+#ifndef EGL_PLATFORM_ANGLE_D3D_LUID_HIGH_ANGLE
+#define EGL_PLATFORM_ANGLE_D3D_LUID_HIGH_ANGLE 0x34A0
+#define EGL_PLATFORM_ANGLE_D3D_LUID_LOW_ANGLE 0x34A1
+#endif
+
+// Gets the LUID of the adapter that DXGI ranks first for |gpu_preference|.
+// Returns false if there is none or if the system can't rank the adapters,
+// which requires IDXGIFactory6.
+static bool GetPreferredAdapterLuid(FlutterDesktopGpuPreference gpu_preference,
+                                    LUID* luid) {
+  if (gpu_preference == kFlutterDesktopGpuPreferenceDefault) {
+    return false;
+  }
+  Microsoft::WRL::ComPtr<IDXGIFactory6> factory;
+  if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) {
+    return false;
+  }
+  const DXGI_GPU_PREFERENCE dxgi_preference =
+      gpu_preference == kFlutterDesktopGpuPreferenceHighPerformance
+          ? DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE
+          : DXGI_GPU_PREFERENCE_MINIMUM_POWER;
+  Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+  if (FAILED(factory->EnumAdapterByGpuPreference(0, dxgi_preference,
+                                                 IID_PPV_ARGS(&adapter)))) {
+    return false;
+  }
+  DXGI_ADAPTER_DESC1 desc;
+  if (FAILED(adapter->GetDesc1(&desc))) {
+    return false;
+  }
+  *luid = desc.AdapterLuid;
+  return true;
+}
+
+// Returns the display |attributes| with the ones that select the adapter with
+// |luid|.
+static std::vector<EGLint> WithAdapterLuid(const EGLint* attributes,
+                                           const LUID& luid) {
+  std::vector<EGLint> result;
+  for (const EGLint* attribute = attributes; *attribute != EGL_NONE;
+       attribute += 2) {
+    result.push_back(attribute[0]);
+    result.push_back(attribute[1]);
+  }
+  result.push_back(EGL_PLATFORM_ANGLE_D3D_LUID_HIGH_ANGLE);
+  result.push_back(luid.HighPart);
+  result.push_back(EGL_PLATFORM_ANGLE_D3D_LUID_LOW_ANGLE);
+  result.push_back(static_cast<EGLint>(luid.LowPart));
+  result.push_back(EGL_NONE);
+  return result;
+}
+
 namespace flutter {
 
 int AngleSurfaceManager::instance_count_ = 0;
 
-std::unique_ptr<AngleSurfaceManager> AngleSurfaceManager::Create() {
+std::unique_ptr<AngleSurfaceManager> AngleSurfaceManager::Create(
+    FlutterDesktopGpuPreference gpu_preference) {
   std::unique_ptr<AngleSurfaceManager> manager;
-  manager.reset(new AngleSurfaceManager());
+  manager.reset(new AngleSurfaceManager(gpu_preference));
   if (!manager->initialize_succeeded_) {
     return nullptr;
   }
   return std::move(manager);
 }
 
-AngleSurfaceManager::AngleSurfaceManager()
+AngleSurfaceManager::AngleSurfaceManager(
+    FlutterDesktopGpuPreference gpu_preference)
     : egl_config_(nullptr),
       egl_display_(EGL_NO_DISPLAY),
       egl_context_(EGL_NO_CONTEXT) {
-  initialize_succeeded_ = Initialize();
+  initialize_succeeded_ = Initialize(gpu_preference);
   ++instance_count_;
 }
 
@@ -74,7 +151,8 @@ bool AngleSurfaceManager::InitializeEGL(
   return true;
 }
 
-bool AngleSurfaceManager::Initialize() {
+bool AngleSurfaceManager::Initialize(
+    FlutterDesktopGpuPreference gpu_preference) {
   const EGLint config_attributes[] = {EGL_RED_SIZE,   8, EGL_GREEN_SIZE,   8,
                                       EGL_BLUE_SIZE,  8, EGL_ALPHA_SIZE,   8,
                                       EGL_DEPTH_SIZE, 8, EGL_STENCIL_SIZE, 8,
@@ -136,6 +214,20 @@ bool AngleSurfaceManager::Initialize() {
     return false;
   }
 
+  // The hardware renderers are first tried with the preferred adapter, if it
+  // is not the default one.
+  std::vector<std::vector<EGLint>> preferred_adapter_configs;
+  LUID luid;
+  if (GetPreferredAdapterLuid(gpu_preference, &luid)) {
+    preferred_adapter_configs.push_back(
+        WithAdapterLuid(d3d11_display_attributes, luid));
+    preferred_adapter_configs.push_back(
+        WithAdapterLuid(d3d11_fl_9_3_display_attributes, luid));
+    display_attributes_configs.insert(display_attributes_configs.begin(),
+                                      {preferred_adapter_configs[0].data(),
+                                       preferred_adapter_configs[1].data()});
+  }
+
   // Attempt to initialize ANGLE's renderer in order of: D3D11, D3D11 Feature
   // Level 9_3 and finally D3D11 WARP.
   for (auto config : display_attributes_configs) {
@@ -145,6 +237,13 @@ bool AngleSurfaceManager::Initialize() {
     }
   }
 
+  const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+  supports_direct_composition_ =
+      HasExtension(extensions, "EGL_ANGLE_direct_composition");
+  supports_post_sub_buffer_ =
+      HasExtension(extensions, "EGL_NV_post_sub_buffer");
+  QueryAdapterDescription();
+
   EGLint numConfigs = 0;
   if ((eglChooseConfig(egl_display_, config_attributes, &egl_config_, 1,
                        &numConfigs) == EGL_FALSE) ||
@@ -171,6 +270,34 @@ bool AngleSurfaceManager::Initialize() {
   return true;
 }
 
+void AngleSurfaceManager::QueryAdapterDescription() {
+  auto query_display_attrib = reinterpret_cast<PFNEGLQUERYDISPLAYATTRIBEXTPROC>(
+      eglGetProcAddress("eglQueryDisplayAttribEXT"));
+  auto query_device_attrib = reinterpret_cast<PFNEGLQUERYDEVICEATTRIBEXTPROC>(
+      eglGetProcAddress("eglQueryDeviceAttribEXT"));
+  if (!query_display_attrib || !query_device_attrib) {
+    return;
+  }
+  EGLAttrib egl_device = 0;
+  EGLAttrib d3d11_device = 0;
+  if (query_display_attrib(egl_display_, EGL_DEVICE_EXT, &egl_device) !=
+          EGL_TRUE ||
+      query_device_attrib(reinterpret_cast<EGLDeviceEXT>(egl_device),
+                          EGL_D3D11_DEVICE_ANGLE, &d3d11_device) != EGL_TRUE) {
+    return;
+  }
+  Microsoft::WRL::ComPtr<IDXGIDevice> dxgi_device;
+  Microsoft::WRL::ComPtr<IDXGIAdapter> adapter;
+  DXGI_ADAPTER_DESC desc;
+  if (FAILED(reinterpret_cast<IUnknown*>(d3d11_device)
+                 ->QueryInterface(IID_PPV_ARGS(&dxgi_device))) ||
+      FAILED(dxgi_device->GetAdapter(&adapter)) ||
+      FAILED(adapter->GetDesc(&desc))) {
+    return;
+  }
+  adapter_description_ = desc.Description;
+}
+
 void AngleSurfaceManager::CleanUp() {
   EGLBoolean result = EGL_FALSE;
 
@@ -215,9 +342,18 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
 #ifdef WINUWP
   const EGLint surfaceAttributes[] = {EGL_NONE};
 #else
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
+  // DirectComposition surfaces are presented with a flip model swap chain,
+  // which composes the frames without copying them to a redirection surface
+  // of the window and supports dirty rects.
+  const EGLint surfaceAttributes[] = {EGL_FIXED_SIZE_ANGLE,
+                                      EGL_TRUE,
+                                      EGL_WIDTH,
+                                      width,
+                                      EGL_HEIGHT,
+                                      height,
+                                      EGL_DIRECT_COMPOSITION_ANGLE,
+                                      supports_direct_composition_,
+                                      EGL_NONE};
 #endif
 
 #ifdef WINUWP
@@ -241,6 +377,14 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
     LogEglError("Surface creation failed.");
   }
 
+  // Frames only redraw their damage if the swap chain keeps the rest of the
+  // previous frame.
+  surface_preserves_contents_ =
+      surface != EGL_NO_SURFACE &&
+      eglSurfaceAttrib(egl_display_, surface, EGL_SWAP_BEHAVIOR,
+                       EGL_BUFFER_PRESERVED) == EGL_TRUE;
+  surface_has_frame_ = false;
+
   surface_width_ = width;
   surface_height_ = height;
   render_surface_ = surface;
@@ -313,7 +457,44 @@ bool AngleSurfaceManager::MakeResourceCurrent() {
 }
 
 EGLBoolean AngleSurfaceManager::SwapBuffers() {
-  return (eglSwapBuffers(egl_display_, render_surface_));
+  EGLBoolean result = eglSwapBuffers(egl_display_, render_surface_);
+  surface_has_frame_ = surface_has_frame_ || result == EGL_TRUE;
+  return result;
+}
+
+EGLBoolean AngleSurfaceManager::SwapBuffersWithDamage(const RECT& damage) {
+  // Presenting part of the surface shows the rest of the previous frame, so
+  // the whole surface is presented until it has one.
+  if (!supports_post_sub_buffer_ || !surface_has_frame_) {
+    return SwapBuffers();
+  }
+  // eglPostSubBufferNV takes the rect with the origin at the bottom left.
+  EGLint left = std::max<EGLint>(damage.left, 0);
+  EGLint right = std::min<EGLint>(damage.right, surface_width_);
+  EGLint top = std::max<EGLint>(damage.top, 0);
+  EGLint bottom = std::min<EGLint>(damage.bottom, surface_height_);
+  if (left >= right || top >= bottom) {
+    // Nothing changed, but the frame still has to be presented to keep the
+    // swap chain in sync with vsync.
+    left = top = 0;
+    right = bottom = 1;
+  }
+  return eglPostSubBufferNV(egl_display_, render_surface_, left,
+                            surface_height_ - bottom, right - left,
+                            bottom - top);
+}
+
+bool AngleSurfaceManager::SurfacePreservesContents() const {
+  return render_surface_ != EGL_NO_SURFACE && surface_preserves_contents_ &&
+         surface_has_frame_;
+}
+
+EGLSurface AngleSurfaceManager::CreateSurfaceFromHandle(
+    EGLenum handle_type,
+    EGLClientBuffer handle,
+    const EGLint* attributes) const {
+  return eglCreatePbufferFromClientBuffer(egl_display_, handle_type, handle,
+                                          egl_config_, attributes);
 }
 
 }  // namespace flutter
@@ -15,7 +15,9 @@
 // Windows platform specific includes
 #include <windows.h>
 #include <memory>
+#include <string>
 
+#include "flutter/shell/platform/windows/public/flutter_windows.h"
 #include "window_binding_handler.h"
 
 namespace flutter {
@@ -24,7 +26,11 @@ namespace flutter {
 // destroy surfaces
 class AngleSurfaceManager {
  public:
-  static std::unique_ptr<AngleSurfaceManager> Create();
+  // Creates a manager whose displays render with the GPU adapter that DXGI
+  // ranks first for |gpu_preference|, falling back to the default adapter.
+  static std::unique_ptr<AngleSurfaceManager> Create(
+      FlutterDesktopGpuPreference gpu_preference =
+          kFlutterDesktopGpuPreferenceDefault);
   ~AngleSurfaceManager();
 
   // Disallow copy/move.
@@ -69,14 +75,45 @@ class AngleSurfaceManager {
   // not null.
   EGLBoolean SwapBuffers();
 
+  // Presents the |damage| area of the surface, in physical pixels with the
+  // origin at the top left, and reuses the rest of the previous frame.
+  //
+  // On surfaces backed by a flip model swap chain, such as the ones created
+  // for DirectComposition, this presents with IDXGISwapChain1::Present1 and
+  // the area as its dirty rect, so that only the area has to be copied and
+  // recomposited. Falls back to |SwapBuffers| if ANGLE can't present part of
+  // the surface.
+  EGLBoolean SwapBuffersWithDamage(const RECT& damage);
+
+  // Whether the contents of the surface are preserved between frames, so
+  // that the next frame only needs to redraw the area that changed.
+  bool SurfacePreservesContents() const;
+
+  // Creates a |EGLSurface| from the provided handle.
+  EGLSurface CreateSurfaceFromHandle(EGLenum handle_type,
+                                     EGLClientBuffer handle,
+                                     const EGLint* attributes) const;
+
+  // Gets the |EGLDisplay|.
+  EGLDisplay egl_display() const { return egl_display_; }
+
+  // The description of the GPU adapter of the display, as reported by its
+  // driver, or empty if it is not known.
+  const std::wstring& adapter_description() const {
+    return adapter_description_;
+  }
+
  private:
-  bool Initialize();
+  bool Initialize(FlutterDesktopGpuPreference gpu_preference);
   void CleanUp();
 
+  // Reads |adapter_description_| from the D3D11 device of the display.
+  void QueryAdapterDescription();
+
  private:
   // Creates a new surface manager retaining reference to the passed-in target
   // for the lifetime of the manager.
-  AngleSurfaceManager();
+  explicit AngleSurfaceManager(FlutterDesktopGpuPreference gpu_preference);
 
   // Attempts to initialize EGL using ANGLE.
   bool InitializeEGL(
@@ -108,6 +145,23 @@ class AngleSurfaceManager {
   EGLint surface_width_ = 0;
   EGLint surface_height_ = 0;
 
+  // Whether ANGLE can back window surfaces with a DirectComposition visual
+  // and a flip model swap chain (EGL_ANGLE_direct_composition).
+  bool supports_direct_composition_ = false;
+
+  // See |adapter_description|.
+  std::wstring adapter_description_;
+
+  // Whether ANGLE can present part of a surface (EGL_NV_post_sub_buffer).
+  bool supports_post_sub_buffer_ = false;
+
+  // Whether eglSwapBuffers preserves the contents of |render_surface_|.
+  bool surface_preserves_contents_ = false;
+
+  // Whether a frame has been presented since |render_surface_| was created,
+  // before which its contents are undefined.
+  bool surface_has_frame_ = false;
+
   // Number of active instances of AngleSurfaceManager
   static int instance_count_;
 };
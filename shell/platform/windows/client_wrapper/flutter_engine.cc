@@ -30,6 +30,19 @@ FlutterEngine::FlutterEngine(const DartProject& project) {
   c_engine_properties.dart_entrypoint_argv =
       entrypoint_argv.size() > 0 ? entrypoint_argv.data() : nullptr;
 
+  switch (project.gpu_preference()) {
+    case GpuPreference::kDefault:
+      c_engine_properties.gpu_preference = kFlutterDesktopGpuPreferenceDefault;
+      break;
+    case GpuPreference::kHighPerformance:
+      c_engine_properties.gpu_preference =
+          kFlutterDesktopGpuPreferenceHighPerformance;
+      break;
+    case GpuPreference::kLowPower:
+      c_engine_properties.gpu_preference = kFlutterDesktopGpuPreferenceLowPower;
+      break;
+  }
+
   engine_ = FlutterDesktopEngineCreate(&c_engine_properties);
 
   auto core_messenger = FlutterDesktopEngineGetMessenger(engine_);
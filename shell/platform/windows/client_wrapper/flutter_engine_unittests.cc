@@ -28,6 +28,7 @@ class TestFlutterWindowsApi : public testing::StubFlutterWindowsApi {
       dart_entrypoint_arguments_.push_back(
           std::string(engine_properties.dart_entrypoint_argv[i]));
     }
+    gpu_preference_ = engine_properties.gpu_preference;
     return reinterpret_cast<FlutterDesktopEngineRef>(1);
   }
 
@@ -68,6 +69,8 @@ class TestFlutterWindowsApi : public testing::StubFlutterWindowsApi {
     return dart_entrypoint_arguments_;
   }
 
+  FlutterDesktopGpuPreference gpu_preference() { return gpu_preference_; }
+
  private:
   bool create_called_ = false;
   bool run_called_ = false;
@@ -75,6 +78,8 @@ class TestFlutterWindowsApi : public testing::StubFlutterWindowsApi {
   bool reload_fonts_called_ = false;
   bool reload_brightness_called_ = false;
   std::vector<std::string> dart_entrypoint_arguments_;
+  FlutterDesktopGpuPreference gpu_preference_ =
+      kFlutterDesktopGpuPreferenceDefault;
 };
 
 }  // namespace
@@ -171,4 +176,17 @@ TEST(FlutterEngineTest, DartEntrypointArgs) {
   EXPECT_TRUE(arguments[1] == arguments_ref[1]);
 }
 
+TEST(FlutterEngineTest, GpuPreference) {
+  testing::ScopedStubFlutterWindowsApi scoped_api_stub(
+      std::make_unique<TestFlutterWindowsApi>());
+  auto test_api = static_cast<TestFlutterWindowsApi*>(scoped_api_stub.stub());
+
+  DartProject project(L"data");
+  project.set_gpu_preference(GpuPreference::kHighPerformance);
+
+  FlutterEngine engine(project);
+  EXPECT_EQ(test_api->gpu_preference(),
+            kFlutterDesktopGpuPreferenceHighPerformance);
+}
+
 }  // namespace flutter
@@ -10,6 +10,18 @@
 
 namespace flutter {
 
+// The preference for the GPU that renders the views of an engine, on systems
+// with more than one, such as laptops with an integrated and a discrete GPU.
+enum class GpuPreference {
+  // The GPU that the system picks, which is usually the one that drives the
+  // display.
+  kDefault,
+  // The GPU with the most performance.
+  kHighPerformance,
+  // The GPU that uses the least power.
+  kLowPower,
+};
+
 // A set of Flutter and Dart assets used to initialize a Flutter engine.
 class DartProject {
  public:
@@ -59,6 +71,15 @@ class DartProject {
     return dart_entrypoint_arguments_;
   }
 
+  // Sets the GPU that should render the views of the engine. The preference
+  // is ignored if the system can't pick the GPU by preference.
+  void set_gpu_preference(GpuPreference gpu_preference) {
+    gpu_preference_ = gpu_preference;
+  }
+
+  // Returns the preference for the GPU that renders the views of the engine.
+  GpuPreference gpu_preference() const { return gpu_preference_; }
+
  private:
   // Accessors for internals are private, so that they can be changed if more
   // flexible options for project structures are needed later without it
@@ -81,6 +102,8 @@ class DartProject {
   std::wstring aot_library_path_;
   // The list of arguments to pass through to the Dart entrypoint.
   std::vector<std::string> dart_entrypoint_arguments_;
+  // The GPU that should render the views of the engine.
+  GpuPreference gpu_preference_ = GpuPreference::kDefault;
 };
 
 }  // namespace flutter
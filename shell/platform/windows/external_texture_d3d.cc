@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/external_texture_d3d.h"
+
+#include <iostream>
+
+namespace flutter {
+
+ExternalTextureD3d::ExternalTextureD3d(
+    FlutterDesktopGpuSurfaceTextureCallback texture_callback,
+    void* user_data,
+    const AngleSurfaceManager* surface_manager,
+    const GlProcs& gl_procs)
+    : texture_callback_(texture_callback),
+      user_data_(user_data),
+      surface_manager_(surface_manager),
+      gl_(gl_procs) {}
+
+ExternalTextureD3d::~ExternalTextureD3d() {
+  ReleaseImage();
+  if (gl_texture_ != 0) {
+    gl_.glDeleteTextures(1, &gl_texture_);
+  }
+}
+
+bool ExternalTextureD3d::PopulateTexture(size_t width,
+                                         size_t height,
+                                         FlutterOpenGLTexture* opengl_texture) {
+  const FlutterDesktopGpuSurfaceDescriptor* descriptor =
+      texture_callback_(width, height, user_data_);
+  if (!CreateOrUpdateTexture(descriptor)) {
+    return false;
+  }
+
+  // Populate the texture object used by the engine.
+  opengl_texture->target = GL_TEXTURE_2D;
+  opengl_texture->name = gl_texture_;
+  opengl_texture->format = GL_RGBA8_OES;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = width_;
+  opengl_texture->height = height_;
+
+  return true;
+}
+
+bool ExternalTextureD3d::CreateOrUpdateTexture(
+    const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
+  if (!descriptor || !descriptor->handle) {
+    ReleaseImage();
+    return false;
+  }
+
+  if (descriptor->handle != last_surface_handle_) {
+    ReleaseImage();
+
+    const EGLint attributes[] = {
+        EGL_WIDTH,          static_cast<EGLint>(descriptor->width),
+        EGL_HEIGHT,         static_cast<EGLint>(descriptor->height),
+        EGL_TEXTURE_TARGET, EGL_TEXTURE_2D,
+        EGL_TEXTURE_FORMAT, EGL_TEXTURE_RGBA,
+        EGL_NONE};
+
+    egl_surface_ = surface_manager_->CreateSurfaceFromHandle(
+        EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE, descriptor->handle, attributes);
+    if (egl_surface_ == EGL_NO_SURFACE) {
+      std::cerr << "Creating D3D surface failed." << std::endl;
+      return false;
+    }
+
+    if (gl_texture_ == 0) {
+      gl_.glGenTextures(1, &gl_texture_);
+
+      gl_.glBindTexture(GL_TEXTURE_2D, gl_texture_);
+
+      gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+      gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+      gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+      gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    } else {
+      gl_.glBindTexture(GL_TEXTURE_2D, gl_texture_);
+    }
+
+    // The texture samples the shared D3D11 texture until the surface is
+    // released, so new frames rendered into it show up without a copy.
+    if (eglBindTexImage(surface_manager_->egl_display(), egl_surface_,
+                        EGL_BACK_BUFFER) == EGL_FALSE) {
+      std::cerr << "Binding D3D surface failed." << std::endl;
+      eglDestroySurface(surface_manager_->egl_display(), egl_surface_);
+      egl_surface_ = EGL_NO_SURFACE;
+      return false;
+    }
+
+    last_surface_handle_ = descriptor->handle;
+    width_ = descriptor->width;
+    height_ = descriptor->height;
+  }
+
+  if (descriptor->release_callback) {
+    descriptor->release_callback(descriptor->release_context);
+  }
+  return true;
+}
+
+void ExternalTextureD3d::ReleaseImage() {
+  if (egl_surface_ != EGL_NO_SURFACE) {
+    EGLDisplay display = surface_manager_->egl_display();
+    eglReleaseTexImage(display, egl_surface_, EGL_BACK_BUFFER);
+    eglDestroySurface(display, egl_surface_);
+    egl_surface_ = EGL_NO_SURFACE;
+  }
+  last_surface_handle_ = nullptr;
+}
+
+}  // namespace flutter
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
+
+#include <stdint.h>
+
+#include "flutter/shell/platform/common/public/flutter_texture_registrar.h"
+#include "flutter/shell/platform/windows/angle_surface_manager.h"
+#include "flutter/shell/platform/windows/external_texture.h"
+#include "flutter/shell/platform/windows/external_texture_gl.h"
+
+namespace flutter {
+
+// An external texture that samples the D3D11 texture behind a DXGI shared
+// handle in place.
+//
+// Unlike |ExternalTextureGL|, the frames aren't copied through system memory:
+// ANGLE opens the shared texture on its D3D11 device, and the texture is
+// bound to an OpenGL texture as the image of a pbuffer surface.
+class ExternalTextureD3d : public ExternalTexture {
+ public:
+  ExternalTextureD3d(FlutterDesktopGpuSurfaceTextureCallback texture_callback,
+                     void* user_data,
+                     const AngleSurfaceManager* surface_manager,
+                     const GlProcs& gl_procs);
+
+  virtual ~ExternalTextureD3d();
+
+  // Attempts to populate the specified |opengl_texture| with texture details
+  // such as the name, width, height and the pixel format of the surface
+  // provided by |texture_callback_|. The surface is only imported again when
+  // the callback returns a different handle.
+  // Returns true on success or false if the surface could not be imported.
+  bool PopulateTexture(size_t width,
+                       size_t height,
+                       FlutterOpenGLTexture* opengl_texture) override;
+
+ private:
+  // Imports the surface described by |descriptor| unless it is the one bound
+  // to |gl_texture_| already.
+  bool CreateOrUpdateTexture(
+      const FlutterDesktopGpuSurfaceDescriptor* descriptor);
+
+  // Unbinds and destroys the pbuffer surface of the current handle.
+  void ReleaseImage();
+
+  FlutterDesktopGpuSurfaceTextureCallback texture_callback_ = nullptr;
+  void* user_data_ = nullptr;
+  const AngleSurfaceManager* surface_manager_ = nullptr;
+  const GlProcs& gl_;
+  GLuint gl_texture_ = 0;
+  EGLSurface egl_surface_ = EGL_NO_SURFACE;
+  void* last_surface_handle_ = nullptr;
+  size_t width_ = 0;
+  size_t height_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
@@ -11,6 +11,7 @@
 
 #include "flutter/shell/platform/common/public/flutter_texture_registrar.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/windows/external_texture.h"
 
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
@@ -43,8 +44,8 @@ struct GlProcs {
   bool valid;
 };
 
-// An abstraction of an OpenGL texture.
-class ExternalTextureGL {
+// An OpenGL texture that the pixel buffers of an embedder are copied to.
+class ExternalTextureGL : public ExternalTexture {
  public:
   ExternalTextureGL(FlutterDesktopPixelBufferTextureCallback texture_callback,
                     void* user_data,
@@ -52,9 +53,6 @@ class ExternalTextureGL {
 
   virtual ~ExternalTextureGL();
 
-  // Returns the unique id of this texture.
-  int64_t texture_id() { return reinterpret_cast<int64_t>(this); }
-
   void MarkFrameAvailable();
 
   // Attempts to populate the specified |opengl_texture| with texture details
@@ -63,7 +61,7 @@ class ExternalTextureGL {
   // Returns true on success or false if the pixel buffer could not be copied.
   bool PopulateTexture(size_t width,
                        size_t height,
-                       FlutterOpenGLTexture* opengl_texture);
+                       FlutterOpenGLTexture* opengl_texture) override;
 
  private:
   // Attempts to copy the pixel buffer returned by |texture_callback_| to
@@ -15,7 +15,8 @@ namespace flutter {
 FlutterProjectBundle::FlutterProjectBundle(
     const FlutterDesktopEngineProperties& properties)
     : assets_path_(properties.assets_path),
-      icu_path_(properties.icu_data_path) {
+      icu_path_(properties.icu_data_path),
+      gpu_preference_(properties.gpu_preference) {
   if (properties.aot_library_path != nullptr) {
     aot_library_path_ = std::filesystem::path(properties.aot_library_path);
   }
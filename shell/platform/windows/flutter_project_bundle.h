@@ -56,6 +56,11 @@ class FlutterProjectBundle {
     return dart_entrypoint_arguments_;
   }
 
+  // Returns the preference for the GPU that renders the views.
+  FlutterDesktopGpuPreference gpu_preference() const {
+    return gpu_preference_;
+  }
+
  private:
   std::filesystem::path assets_path_;
   std::filesystem::path icu_path_;
@@ -68,6 +73,8 @@ class FlutterProjectBundle {
 
   // Engine switches.
   std::vector<std::string> engine_switches_;
+
+  FlutterDesktopGpuPreference gpu_preference_;
 };
 
 }  // namespace flutter
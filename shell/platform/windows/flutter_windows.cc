@@ -112,6 +112,21 @@ void FlutterDesktopEngineReloadPlatformBrightness(
   EngineFromHandle(engine)->ReloadPlatformBrightness();
 }
 
+bool FlutterDesktopEngineGetGpuAdapterDescription(
+    FlutterDesktopEngineRef engine,
+    wchar_t* description,
+    size_t length) {
+  flutter::AngleSurfaceManager* surface_manager =
+      EngineFromHandle(engine)->surface_manager();
+  if (!surface_manager || surface_manager->adapter_description().empty() ||
+      length == 0) {
+    return false;
+  }
+  wcsncpy_s(description, length, surface_manager->adapter_description().c_str(),
+            _TRUNCATE);
+  return true;
+}
+
 FlutterDesktopPluginRegistrarRef FlutterDesktopEngineGetPluginRegistrar(
     FlutterDesktopEngineRef engine,
     const char* plugin_name) {
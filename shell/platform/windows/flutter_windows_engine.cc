@@ -44,13 +44,22 @@ FlutterRendererConfig GetOpenGLRendererConfig() {
     }
     return host->view()->ClearContext();
   };
-  config.open_gl.present = [](void* user_data) -> bool {
+  config.open_gl.present_with_info =
+      [](void* user_data, const FlutterPresentInfo* info) -> bool {
     auto host = static_cast<FlutterWindowsEngine*>(user_data);
     if (!host->view()) {
       return false;
     }
-    return host->view()->SwapBuffers();
+    return host->view()->SwapBuffers(info->frame_damage);
   };
+  config.open_gl.populate_existing_damage =
+      [](void* user_data, intptr_t fbo_id, FlutterDamage* existing_damage) {
+        auto host = static_cast<FlutterWindowsEngine*>(user_data);
+        if (!host->view()) {
+          return;
+        }
+        host->view()->PopulateExistingDamage(existing_damage);
+      };
   config.open_gl.fbo_reset_after_present = true;
   config.open_gl.fbo_with_frame_info_callback =
       [](void* user_data, const FlutterFrameInfo* info) -> uint32_t {
@@ -167,7 +176,7 @@ FlutterWindowsEngine::FlutterWindowsEngine(const FlutterProjectBundle& project)
   FlutterWindowsTextureRegistrar::ResolveGlFunctions(gl_procs_);
   texture_registrar_ =
       std::make_unique<FlutterWindowsTextureRegistrar>(this, gl_procs_);
-  surface_manager_ = AngleSurfaceManager::Create();
+  surface_manager_ = AngleSurfaceManager::Create(project_->gpu_preference());
 #ifndef WINUWP
   window_proc_delegate_manager_ =
       std::make_unique<WindowProcDelegateManagerWin32>();
@@ -283,6 +292,7 @@ bool FlutterWindowsEngine::RunWithEntrypoint(const char* entrypoint) {
   }
 
   SendSystemSettings();
+  SendDisplayRefreshRate();
 
   return true;
 }
@@ -427,6 +437,24 @@ void FlutterWindowsEngine::SendSystemSettings() {
   settings_channel_->Send(settings);
 }
 
+void FlutterWindowsEngine::SendDisplayRefreshRate() {
+#ifndef WINUWP
+  DEVMODEW mode = {};
+  mode.dmSize = sizeof(mode);
+  // Frequencies of 0 and 1 stand for the default rate of the hardware.
+  if (!::EnumDisplaySettingsW(nullptr, ENUM_CURRENT_SETTINGS, &mode) ||
+      mode.dmDisplayFrequency <= 1) {
+    return;
+  }
+  FlutterEngineDisplay display = {};
+  display.struct_size = sizeof(FlutterEngineDisplay);
+  display.single_display = true;
+  display.refresh_rate = mode.dmDisplayFrequency;
+  embedder_api_.NotifyDisplayUpdate(
+      engine_, kFlutterEngineDisplaysUpdateTypeStartup, &display, 1);
+#endif
+}
+
 bool FlutterWindowsEngine::RegisterExternalTexture(int64_t texture_id) {
   return (embedder_api_.RegisterExternalTexture(engine_, texture_id) ==
           kSuccess);
@@ -165,6 +165,12 @@ class FlutterWindowsEngine {
   // system changes.
   void SendSystemSettings();
 
+  // Sends the refresh rate of the primary display to the engine, so that
+  // frames are scheduled and measured against it.
+  //
+  // Should be called just after the engine is run.
+  void SendDisplayRefreshRate();
+
   // The handle to the embedder.h engine instance.
   FLUTTER_API_SYMBOL(FlutterEngine) engine_ = nullptr;
 
@@ -93,6 +93,18 @@ TEST(FlutterWindowsEngine, RunDoesExpectedInitialization) {
         return kSuccess;
       }));
 
+  // And it should send the refresh rate of the display, if it is known.
+  modifier.embedder_api().NotifyDisplayUpdate = MOCK_ENGINE_PROC(
+      NotifyDisplayUpdate,
+      ([](auto engine, FlutterEngineDisplaysUpdateType update_type,
+          const FlutterEngineDisplay* displays, size_t display_count) {
+        EXPECT_EQ(update_type, kFlutterEngineDisplaysUpdateTypeStartup);
+        EXPECT_EQ(display_count, 1U);
+        EXPECT_GT(displays[0].refresh_rate, 1);
+
+        return kSuccess;
+      }));
+
   // Set the AngleSurfaceManager to !nullptr to test ANGLE rendering.
   modifier.SetSurfaceManager(reinterpret_cast<AngleSurfaceManager*>(1));
 
@@ -126,14 +138,19 @@ TEST(FlutterWindowsEngine, RunWithoutANGLEUsesSoftware) {
         return kSuccess;
       }));
 
-  // Stub out UpdateLocales and SendPlatformMessage as we don't have a fully
-  // initialized engine instance.
+  // Stub out UpdateLocales, SendPlatformMessage and NotifyDisplayUpdate as we
+  // don't have a fully initialized engine instance.
   modifier.embedder_api().UpdateLocales = MOCK_ENGINE_PROC(
       UpdateLocales, ([](auto engine, const FlutterLocale** locales,
                          size_t locales_count) { return kSuccess; }));
   modifier.embedder_api().SendPlatformMessage =
       MOCK_ENGINE_PROC(SendPlatformMessage,
                        ([](auto engine, auto message) { return kSuccess; }));
+  modifier.embedder_api().NotifyDisplayUpdate = MOCK_ENGINE_PROC(
+      NotifyDisplayUpdate,
+      ([](auto engine, FlutterEngineDisplaysUpdateType update_type,
+          const FlutterEngineDisplay* displays,
+          size_t display_count) { return kSuccess; }));
 
   // Set the AngleSurfaceManager to nullptr to test software fallback path.
   modifier.SetSurfaceManager(nullptr);
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/windows/flutter_windows_texture_registrar.h"
 
+#include "flutter/shell/platform/windows/external_texture_d3d.h"
 #include "flutter/shell/platform/windows/flutter_windows_engine.h"
 
 #include <iostream>
@@ -22,25 +23,55 @@ int64_t FlutterWindowsTextureRegistrar::RegisterTexture(
     return -1;
   }
 
-  if (texture_info->type != kFlutterDesktopPixelBufferTexture) {
-    std::cerr << "Attempted to register texture of unsupport type."
-              << std::endl;
-    return -1;
-  }
+  if (texture_info->type == kFlutterDesktopPixelBufferTexture) {
+    if (!texture_info->pixel_buffer_config.callback) {
+      std::cerr << "Invalid pixel buffer texture callback." << std::endl;
+      return -1;
+    }
 
-  if (!texture_info->pixel_buffer_config.callback) {
-    std::cerr << "Invalid pixel buffer texture callback." << std::endl;
-    return -1;
+    return EmplaceTexture(std::make_unique<flutter::ExternalTextureGL>(
+        texture_info->pixel_buffer_config.callback,
+        texture_info->pixel_buffer_config.user_data, gl_procs_));
+  } else if (texture_info->type == kFlutterDesktopGpuSurfaceTexture) {
+    const FlutterDesktopGpuSurfaceTextureConfig* gpu_surface_config =
+        &texture_info->gpu_surface_config;
+
+    if (gpu_surface_config->type !=
+        kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle) {
+      std::cerr << "Attempted to register texture of unsupported GPU surface "
+                   "type."
+                << std::endl;
+      return -1;
+    }
+
+    if (!gpu_surface_config->callback) {
+      std::cerr << "Invalid GPU surface descriptor callback." << std::endl;
+      return -1;
+    }
+
+    // Shared handles are opened on the D3D11 device of ANGLE, so software
+    // rendering can't show them.
+    AngleSurfaceManager* surface_manager = engine_->surface_manager();
+    if (!surface_manager) {
+      std::cerr << "GPU surface textures require ANGLE." << std::endl;
+      return -1;
+    }
+
+    return EmplaceTexture(std::make_unique<flutter::ExternalTextureD3d>(
+        gpu_surface_config->callback, gpu_surface_config->user_data,
+        surface_manager, gl_procs_));
   }
 
-  auto texture_gl = std::make_unique<flutter::ExternalTextureGL>(
-      texture_info->pixel_buffer_config.callback,
-      texture_info->pixel_buffer_config.user_data, gl_procs_);
-  int64_t texture_id = texture_gl->texture_id();
+  std::cerr << "Attempted to register texture of unsupport type." << std::endl;
+  return -1;
+}
 
+int64_t FlutterWindowsTextureRegistrar::EmplaceTexture(
+    std::unique_ptr<ExternalTexture> texture) {
+  int64_t texture_id = texture->texture_id();
   {
     std::lock_guard<std::mutex> lock(map_mutex_);
-    textures_[texture_id] = std::move(texture_gl);
+    textures_[texture_id] = std::move(texture);
   }
 
   engine_->task_runner()->RunNowOrPostTask([engine = engine_, texture_id]() {
@@ -79,7 +110,7 @@ bool FlutterWindowsTextureRegistrar::PopulateTexture(
     size_t width,
     size_t height,
     FlutterOpenGLTexture* opengl_texture) {
-  flutter::ExternalTextureGL* texture;
+  flutter::ExternalTexture* texture;
   {
     std::lock_guard<std::mutex> lock(map_mutex_);
     auto it = textures_.find(texture_id);
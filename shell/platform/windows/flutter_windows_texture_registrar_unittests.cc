@@ -152,6 +152,58 @@ TEST(FlutterWindowsTextureRegistrarTest, PopulatePixelBufferTexture) {
   EXPECT_TRUE(release_callback_called);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest, RegisterUnknownGpuSurfaceType) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
+
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl->gl_procs());
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopGpuSurfaceTexture;
+  texture_info.gpu_surface_config.struct_size =
+      sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+  texture_info.gpu_surface_config.type = kFlutterDesktopGpuSurfaceTypeNone;
+  texture_info.gpu_surface_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+    return nullptr;
+  };
+
+  EXPECT_EQ(registrar.RegisterTexture(&texture_info), -1);
+}
+
+TEST(FlutterWindowsTextureRegistrarTest,
+     RegisterGpuSurfaceTextureRequiresSurfaceManager) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  EngineModifier modifier(engine.get());
+  modifier.SetSurfaceManager(nullptr);
+  std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
+
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl->gl_procs());
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopGpuSurfaceTexture;
+  texture_info.gpu_surface_config.struct_size =
+      sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+  texture_info.gpu_surface_config.type =
+      kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle;
+  texture_info.gpu_surface_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+    return nullptr;
+  };
+
+  bool register_called = false;
+  modifier.embedder_api().RegisterExternalTexture = MOCK_ENGINE_PROC(
+      RegisterExternalTexture, ([&register_called](auto engine, auto id) {
+        register_called = true;
+        return kSuccess;
+      }));
+
+  EXPECT_EQ(registrar.RegisterTexture(&texture_info), -1);
+  EXPECT_FALSE(register_called);
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulateInvalidTexture) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
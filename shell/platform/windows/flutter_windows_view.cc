@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/windows/flutter_windows_view.h"
 
 #include <chrono>
+#include <cmath>
 
 #include "flutter/shell/platform/windows/keyboard_key_channel_handler.h"
 #include "flutter/shell/platform/windows/keyboard_key_embedder_handler.h"
@@ -504,10 +505,28 @@ bool FlutterWindowsView::ClearContext() {
   return engine_->surface_manager()->ClearContext();
 }
 
-bool FlutterWindowsView::SwapBuffers() {
+bool FlutterWindowsView::SwapBuffers(const FlutterDamage& frame_damage) {
   // Called on an engine-controlled (non-platform) thread.
   std::unique_lock<std::mutex> lock(resize_mutex_);
 
+  auto present = [this, &frame_damage]() -> bool {
+    AngleSurfaceManager* surface_manager = engine_->surface_manager();
+    if (frame_damage.num_rects == 0 || !frame_damage.damage) {
+      return surface_manager->SwapBuffers();
+    }
+    // Present1 takes any number of dirty rects, but ANGLE only forwards one.
+    RECT damage = {};
+    for (size_t i = 0; i < frame_damage.num_rects; i++) {
+      const FlutterRect& rect = frame_damage.damage[i];
+      RECT dirty_rect = {static_cast<LONG>(std::floor(rect.left)),
+                         static_cast<LONG>(std::floor(rect.top)),
+                         static_cast<LONG>(std::ceil(rect.right)),
+                         static_cast<LONG>(std::ceil(rect.bottom))};
+      UnionRect(&damage, &damage, &dirty_rect);
+    }
+    return surface_manager->SwapBuffersWithDamage(damage);
+  };
+
   switch (resize_status_) {
     // SwapBuffer requests during resize are ignored until the frame with the
     // right dimensions has been generated. This is marked with
@@ -522,20 +541,31 @@ bool FlutterWindowsView::SwapBuffers() {
       // SwapBuffers waits for vsync and there's no point doing that for
       // invisible windows.
       if (visible) {
-        swap_buffers_result = engine_->surface_manager()->SwapBuffers();
+        swap_buffers_result = present();
       }
       resize_status_ = ResizeState::kDone;
       lock.unlock();
       resize_cv_.notify_all();
       binding_handler_->OnWindowResized();
       if (!visible) {
-        swap_buffers_result = engine_->surface_manager()->SwapBuffers();
+        swap_buffers_result = present();
       }
       return swap_buffers_result;
     }
     case ResizeState::kDone:
     default:
-      return engine_->surface_manager()->SwapBuffers();
+      return present();
+  }
+}
+
+void FlutterWindowsView::PopulateExistingDamage(
+    FlutterDamage* existing_damage) {
+  // The engine redraws the whole frame until the surface holds the previous
+  // one, for example after it was recreated for a resize.
+  static FlutterRect no_damage = {0, 0, 0, 0};
+  if (engine_->surface_manager()->SurfacePreservesContents()) {
+    existing_damage->num_rects = 1;
+    existing_damage->damage = &no_damage;
   }
 }
 
@@ -77,7 +77,14 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   bool ClearContext();
   bool MakeCurrent();
   bool MakeResourceCurrent();
-  bool SwapBuffers();
+
+  // Presents the |frame_damage| area of the frame and keeps the rest of the
+  // previous frame, or presents the whole frame if the damage has no rects.
+  bool SwapBuffers(const FlutterDamage& frame_damage);
+
+  // Populates the |existing_damage| of the window frame buffer, which is
+  // empty when the surface holds the previous frame.
+  void PopulateExistingDamage(FlutterDamage* existing_damage);
 
   // Callback for presenting a software bitmap.
   bool PresentSoftwareBitmap(const void* allocation,
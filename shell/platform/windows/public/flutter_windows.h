@@ -34,6 +34,18 @@ typedef struct FlutterDesktopView* FlutterDesktopViewRef;
 struct FlutterDesktopEngine;
 typedef struct FlutterDesktopEngine* FlutterDesktopEngineRef;
 
+// The preference for the GPU that renders the views of an engine, on systems
+// with more than one, such as laptops with an integrated and a discrete GPU.
+typedef enum {
+  // The GPU that the system picks, which is usually the one that drives the
+  // display.
+  kFlutterDesktopGpuPreferenceDefault,
+  // The GPU with the most performance.
+  kFlutterDesktopGpuPreferenceHighPerformance,
+  // The GPU that uses the least power.
+  kFlutterDesktopGpuPreferenceLowPower,
+} FlutterDesktopGpuPreference;
+
 // Properties for configuring a Flutter engine instance.
 typedef struct {
   // The path to the flutter_assets folder for the application to be run.
@@ -59,6 +71,11 @@ typedef struct {
   // to FlutterDesktopEngineCreate.
   const char** dart_entrypoint_argv;
 
+  // The GPU that should render the views of the engine. The preference is
+  // ignored if the system can't pick the GPU by preference, which requires
+  // Windows 10 version 1803 or later.
+  FlutterDesktopGpuPreference gpu_preference;
+
 } FlutterDesktopEngineProperties;
 
 // ========== View Controller ==========
@@ -177,6 +194,16 @@ FLUTTER_EXPORT void FlutterDesktopEngineReloadSystemFonts(
 FLUTTER_EXPORT void FlutterDesktopEngineReloadPlatformBrightness(
     FlutterDesktopEngineRef engine);
 
+// Copies the description of the GPU adapter that renders the views of
+// |engine|, as reported by its driver, to |description|, truncated to fit the
+// |length| characters of the buffer including the null terminator.
+//
+// Returns false if the adapter is not known.
+FLUTTER_EXPORT bool FlutterDesktopEngineGetGpuAdapterDescription(
+    FlutterDesktopEngineRef engine,
+    wchar_t* description,
+    size_t length);
+
 // Returns the plugin registrar handle for the plugin with the given name.
 //
 // The name must be unique across the application.
@@ -7,6 +7,13 @@
 #include <algorithm>
 #include <iostream>
 
+// Available since Windows 10 version 1803. Older versions fail to create the
+// timer with it, and fall back to a timer with the resolution of the system
+// timer.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace flutter {
 
 TaskRunnerWin32Window::TaskRunnerWin32Window() {
@@ -18,6 +25,7 @@ TaskRunnerWin32Window::TaskRunnerWin32Window() {
   if (window_handle_) {
     SetWindowLongPtr(window_handle_, GWLP_USERDATA,
                      reinterpret_cast<LONG_PTR>(this));
+    StartTimerThread();
   } else {
     auto error = GetLastError();
     LPWSTR message = nullptr;
@@ -32,6 +40,7 @@ TaskRunnerWin32Window::TaskRunnerWin32Window() {
 }
 
 TaskRunnerWin32Window::~TaskRunnerWin32Window() {
+  StopTimerThread();
   if (window_handle_) {
     DestroyWindow(window_handle_);
     window_handle_ = nullptr;
@@ -83,6 +92,24 @@ void TaskRunnerWin32Window::ProcessTasks() {
 }
 
 void TaskRunnerWin32Window::SetTimer(std::chrono::nanoseconds when) {
+  if (timer_) {
+    if (when == std::chrono::nanoseconds::max()) {
+      CancelWaitableTimer(timer_);
+    } else if (when <= std::chrono::nanoseconds::zero()) {
+      CancelWaitableTimer(timer_);
+      WakeUp();
+    } else {
+      // Negative due times are relative, in 100 nanosecond intervals.
+      LARGE_INTEGER due_time;
+      due_time.QuadPart = -std::max<LONGLONG>(when.count() / 100, 1);
+      if (!SetWaitableTimer(timer_, &due_time, 0, nullptr, nullptr, FALSE)) {
+        std::cerr << "Failed to set the task runner timer." << std::endl;
+        WakeUp();
+      }
+    }
+    return;
+  }
+
   if (when == std::chrono::nanoseconds::max()) {
     KillTimer(window_handle_, 0);
   } else {
@@ -91,6 +118,45 @@ void TaskRunnerWin32Window::SetTimer(std::chrono::nanoseconds when) {
   }
 }
 
+bool TaskRunnerWin32Window::StartTimerThread() {
+  timer_ = CreateWaitableTimerEx(nullptr, nullptr,
+                                 CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                 TIMER_ALL_ACCESS);
+  if (!timer_) {
+    timer_ = CreateWaitableTimerEx(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+  }
+  timer_thread_stop_event_ = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+  if (!timer_ || !timer_thread_stop_event_) {
+    StopTimerThread();
+    return false;
+  }
+  timer_thread_ = std::thread([this]() { TimerThreadMain(); });
+  return true;
+}
+
+void TaskRunnerWin32Window::StopTimerThread() {
+  if (timer_thread_.joinable()) {
+    SetEvent(timer_thread_stop_event_);
+    timer_thread_.join();
+  }
+  if (timer_) {
+    CloseHandle(timer_);
+    timer_ = nullptr;
+  }
+  if (timer_thread_stop_event_) {
+    CloseHandle(timer_thread_stop_event_);
+    timer_thread_stop_event_ = nullptr;
+  }
+}
+
+void TaskRunnerWin32Window::TimerThreadMain() {
+  const HANDLE handles[] = {timer_thread_stop_event_, timer_};
+  while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) ==
+         WAIT_OBJECT_0 + 1) {
+    WakeUp();
+  }
+}
+
 WNDCLASS TaskRunnerWin32Window::RegisterWindowClass() {
   window_class_name_ = L"FlutterTaskRunnerWindow";
 
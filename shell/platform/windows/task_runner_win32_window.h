@@ -10,11 +10,19 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace flutter {
 
-// Hidden HWND responsible for processing flutter tasks on main thread
+// Hidden HWND responsible for processing flutter tasks on main thread.
+//
+// Delayed tasks are scheduled with a high resolution waitable timer, which a
+// background thread waits on and then wakes the main thread with a posted
+// message. Unlike WM_TIMER, which is only generated when the message queue is
+// otherwise empty and is limited to the resolution of the system timer, this
+// runs the tasks on time even though the host application owns the message
+// loop.
 class TaskRunnerWin32Window {
  public:
   class Delegate {
@@ -39,6 +47,16 @@ class TaskRunnerWin32Window {
 
   void SetTimer(std::chrono::nanoseconds when);
 
+  // Creates |timer_| and the thread that waits for it. Returns false if the
+  // system can't create waitable timers, in which case WM_TIMER is used.
+  bool StartTimerThread();
+
+  void StopTimerThread();
+
+  // Waits for |timer_| on |timer_thread_| and wakes up the main thread each
+  // time it is signaled, until |timer_thread_stop_event_| is signaled.
+  void TimerThreadMain();
+
   WNDCLASS RegisterWindowClass();
 
   LRESULT
@@ -54,6 +72,11 @@ class TaskRunnerWin32Window {
   HWND window_handle_;
   std::wstring window_class_name_;
   std::vector<Delegate*> delegates_;
+
+  // The timer of the next delayed task, or null if WM_TIMER is used instead.
+  HANDLE timer_ = nullptr;
+  HANDLE timer_thread_stop_event_ = nullptr;
+  std::thread timer_thread_;
 };
 }  // namespace flutter
 
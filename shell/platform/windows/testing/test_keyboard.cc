@@ -168,6 +168,10 @@ void MockEmbedderApiForKeyboard(EngineModifier& modifier,
       [](auto engine, const FlutterLocale** locales, size_t locales_count) {
         return kSuccess;
       };
+  modifier.embedder_api().NotifyDisplayUpdate =
+      [](auto engine, FlutterEngineDisplaysUpdateType update_type,
+         const FlutterEngineDisplay* displays,
+         size_t display_count) { return kSuccess; };
   modifier.embedder_api().SendWindowMetricsEvent =
       [](auto engine, const FlutterWindowMetricsEvent* event) {
         return kSuccess;
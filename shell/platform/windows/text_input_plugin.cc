@@ -24,11 +24,14 @@ static constexpr char kMultilineInputType[] = "TextInputType.multiline";
 
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+static constexpr char kUpdateEditingStateWithDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 
 static constexpr char kTextInputAction[] = "inputAction";
 static constexpr char kTextInputType[] = "inputType";
 static constexpr char kTextInputTypeName[] = "name";
+static constexpr char kEnableDeltaModel[] = "enableDeltaModel";
 static constexpr char kComposingBaseKey[] = "composingBase";
 static constexpr char kComposingExtentKey[] = "composingExtent";
 static constexpr char kSelectionAffinityKey[] = "selectionAffinity";
@@ -37,6 +40,11 @@ static constexpr char kSelectionBaseKey[] = "selectionBase";
 static constexpr char kSelectionExtentKey[] = "selectionExtent";
 static constexpr char kSelectionIsDirectionalKey[] = "selectionIsDirectional";
 static constexpr char kTextKey[] = "text";
+static constexpr char kDeltasKey[] = "deltas";
+static constexpr char kDeltaOldTextKey[] = "oldText";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
 static constexpr char kXKey[] = "x";
 static constexpr char kYKey[] = "y";
 static constexpr char kWidthKey[] = "width";
@@ -190,7 +198,14 @@ void TextInputPlugin::HandleMethodCall(
         input_type_ = input_type_json->value.GetString();
       }
     }
+    enable_delta_model_ = false;
+    auto enable_delta_model_json = client_config.FindMember(kEnableDeltaModel);
+    if (enable_delta_model_json != client_config.MemberEnd() &&
+        enable_delta_model_json->value.IsBool()) {
+      enable_delta_model_ = enable_delta_model_json->value.GetBool();
+    }
     active_model_ = std::make_unique<TextInputModel>();
+    framework_text_.clear();
   } else if (method.compare(kSetEditingStateMethod) == 0) {
     if (!method_call.arguments() || method_call.arguments()->IsNull()) {
       result->Error(kBadArgumentError, "Method invoked without args");
@@ -226,6 +241,9 @@ void TextInputPlugin::HandleMethodCall(
     }
     active_model_->SetText(text->value.GetString());
     active_model_->SetSelection(TextRange(selection_base, selection_extent));
+    if (enable_delta_model_) {
+      framework_text_ = active_model_->GetTextUtf16();
+    }
 
     base = args.FindMember(kComposingBaseKey);
     extent = args.FindMember(kComposingExtentKey);
@@ -314,6 +332,16 @@ Rect TextInputPlugin::GetCursorRect() const {
 }
 
 void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
+  if (enable_delta_model_) {
+    // The framework applies the delta to the text it already has, so only
+    // the changed range of the text needs to be found here.
+    TextEditingDelta delta = TextEditingDelta::FromChange(
+        std::move(framework_text_), model.GetTextUtf16());
+    framework_text_ = model.GetTextUtf16();
+    SendStateUpdateWithDelta(model, delta);
+    return;
+  }
+
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
   args->PushBack(client_id_, allocator);
@@ -338,6 +366,43 @@ void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
   channel_->InvokeMethod(kUpdateEditingStateMethod, std::move(args));
 }
 
+void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
+                                               const TextEditingDelta& delta) {
+  auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = args->GetAllocator();
+  args->PushBack(client_id_, allocator);
+
+  rapidjson::Value delta_json(rapidjson::kObjectType);
+  delta_json.AddMember(
+      kDeltaOldTextKey,
+      rapidjson::Value(delta.old_text(), allocator).Move(), allocator);
+  delta_json.AddMember(
+      kDeltaTextKey, rapidjson::Value(delta.delta_text(), allocator).Move(),
+      allocator);
+  delta_json.AddMember(kDeltaStartKey, delta.delta_start(), allocator);
+  delta_json.AddMember(kDeltaEndKey, delta.delta_end(), allocator);
+
+  TextRange selection = model.selection();
+  delta_json.AddMember(kSelectionAffinityKey, kAffinityDownstream, allocator);
+  delta_json.AddMember(kSelectionBaseKey, selection.base(), allocator);
+  delta_json.AddMember(kSelectionExtentKey, selection.extent(), allocator);
+  delta_json.AddMember(kSelectionIsDirectionalKey, false, allocator);
+
+  int composing_base = model.composing() ? model.composing_range().base() : -1;
+  int composing_extent =
+      model.composing() ? model.composing_range().extent() : -1;
+  delta_json.AddMember(kComposingBaseKey, composing_base, allocator);
+  delta_json.AddMember(kComposingExtentKey, composing_extent, allocator);
+
+  rapidjson::Value deltas(rapidjson::kArrayType);
+  deltas.PushBack(delta_json, allocator);
+  rapidjson::Value object(rapidjson::kObjectType);
+  object.AddMember(kDeltasKey, deltas, allocator);
+  args->PushBack(object, allocator);
+
+  channel_->InvokeMethod(kUpdateEditingStateWithDeltasMethod, std::move(args));
+}
+
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType) {
     model->AddText(std::u16string({u'\n'}));
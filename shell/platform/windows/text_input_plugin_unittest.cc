@@ -5,6 +5,7 @@
 
 #include <rapidjson/document.h>
 #include <memory>
+#include <vector>
 
 #include "flutter/shell/platform/common/json_message_codec.h"
 #include "flutter/shell/platform/common/json_method_codec.h"
@@ -81,5 +82,47 @@ TEST(TextInputPluginTest, ClearClientResetsComposing) {
   EXPECT_TRUE(delegate.ime_was_reset());
 }
 
+TEST(TextInputPluginTest, SendsDeltasWhenDeltaModelIsEnabled) {
+  std::vector<std::unique_ptr<MethodCall<rapidjson::Document>>> sent_calls;
+  auto& codec = JsonMethodCodec::GetInstance();
+  TestBinaryMessenger messenger(
+      [&](const std::string& channel, const uint8_t* message,
+          size_t message_size, BinaryReply reply) {
+        sent_calls.push_back(codec.DecodeMethodCall(message, message_size));
+      });
+  BinaryReply reply_handler = [](const uint8_t* reply, size_t reply_size) {};
+
+  EmptyTextInputPluginDelegate delegate;
+  TextInputPlugin handler(&messenger, &delegate);
+
+  auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = args->GetAllocator();
+  args->PushBack(123, allocator);
+  rapidjson::Value config(rapidjson::kObjectType);
+  config.AddMember("enableDeltaModel", true, allocator);
+  args->PushBack(config, allocator);
+  auto message =
+      codec.EncodeMethodCall({"TextInput.setClient", std::move(args)});
+  messenger.SimulateEngineMessage("flutter/textinput", message->data(),
+                                  message->size(), reply_handler);
+
+  handler.TextHook(nullptr, u"ab");
+  handler.TextHook(nullptr, u"c");
+
+  ASSERT_EQ(sent_calls.size(), 2u);
+  EXPECT_EQ(sent_calls[1]->method_name(),
+            "TextInputClient.updateEditingStateWithDeltas");
+  const rapidjson::Document& sent_args = *sent_calls[1]->arguments();
+  EXPECT_EQ(sent_args[0].GetInt(), 123);
+  const rapidjson::Value& delta = sent_args[1]["deltas"][0];
+  EXPECT_STREQ(delta["oldText"].GetString(), "ab");
+  EXPECT_STREQ(delta["deltaText"].GetString(), "c");
+  EXPECT_EQ(delta["deltaStart"].GetInt(), 2);
+  EXPECT_EQ(delta["deltaEnd"].GetInt(), 2);
+  EXPECT_EQ(delta["selectionBase"].GetInt(), 3);
+  EXPECT_EQ(delta["selectionExtent"].GetInt(), 3);
+  EXPECT_EQ(delta["composingBase"].GetInt(), -1);
+}
+
 }  // namespace testing
 }  // namespace flutter
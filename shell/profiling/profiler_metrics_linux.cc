@@ -0,0 +1,217 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/profiling/profiler_metrics_linux.h"
+
+#include <dirent.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr double kBytesPerMB = 1024.0 * 1024.0;
+
+// The fields of `/proc/<pid>/stat` that are sampled.
+struct ProcStat {
+  uint64_t cpu_ticks = 0;
+  uint32_t num_threads = 0;
+};
+
+std::optional<std::string> ReadProcFile(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+// See `man 5 proc` for the layout. The name of the thread is in parentheses
+// and may itself contain spaces and parentheses, so the fields are counted
+// from the last closing one.
+std::optional<ProcStat> ReadProcStat(const std::string& path) {
+  auto contents = ReadProcFile(path);
+  if (!contents) {
+    return std::nullopt;
+  }
+  size_t name_end = contents->rfind(')');
+  if (name_end == std::string::npos) {
+    return std::nullopt;
+  }
+  std::istringstream fields(contents->substr(name_end + 1));
+  // Fields 3 to 13 come before `utime`, and 16 to 19 before `num_threads`.
+  std::string skipped;
+  for (int field = 3; field <= 13; field++) {
+    fields >> skipped;
+  }
+  uint64_t user_ticks = 0;
+  uint64_t system_ticks = 0;
+  fields >> user_ticks >> system_ticks;
+  for (int field = 16; field <= 19; field++) {
+    fields >> skipped;
+  }
+  ProcStat stat;
+  fields >> stat.num_threads;
+  if (fields.fail()) {
+    return std::nullopt;
+  }
+  stat.cpu_ticks = user_ticks + system_ticks;
+  return stat;
+}
+
+double TicksToPercent(uint64_t ticks, fml::TimeDelta elapsed) {
+  static const long ticks_per_second = sysconf(_SC_CLK_TCK);
+  if (ticks_per_second <= 0 || elapsed <= fml::TimeDelta::Zero()) {
+    return 0.0;
+  }
+  return 100.0 * ticks / ticks_per_second / elapsed.ToSecondsF();
+}
+
+size_t AllocatedHeapBytes() {
+#if defined(__GLIBC__)
+  // glibc doesn't count the chunks that it maps directly as in use.
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 info = mallinfo2();
+#else
+  struct mallinfo info = mallinfo();
+#endif
+  return static_cast<size_t>(info.uordblks) + static_cast<size_t>(info.hblkhd);
+#else
+  return mallinfo().uordblks;
+#endif  // defined(__GLIBC__)
+}
+
+}  // namespace
+
+ProfilerMetricsLinux::ProfilerMetricsLinux()
+    : last_sample_time_(fml::TimePoint::Now()),
+      last_heap_bytes_(AllocatedHeapBytes()) {
+  auto stat = ReadProcStat("/proc/self/stat");
+  if (stat) {
+    last_process_cpu_ticks_ = stat->cpu_ticks;
+  }
+}
+
+ProfileSample ProfilerMetricsLinux::GenerateSample() {
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const fml::TimeDelta elapsed = now - last_sample_time_;
+  last_sample_time_ = now;
+  return {.cpu_usage = CpuUsage(elapsed),
+          .memory_usage = MemoryUsage(),
+          .gpu_usage = std::nullopt,
+          .thread_cpu_usage = ThreadCpuUsage(elapsed),
+          .heap_usage = HeapUsage(elapsed)};
+}
+
+std::optional<CpuUsageInfo> ProfilerMetricsLinux::CpuUsage(
+    fml::TimeDelta elapsed) {
+  auto stat = ReadProcStat("/proc/self/stat");
+  if (!stat) {
+    FML_LOG(ERROR) << "Error reading the CPU usage of the process.";
+    return std::nullopt;
+  }
+  const uint64_t ticks = stat->cpu_ticks - last_process_cpu_ticks_;
+  last_process_cpu_ticks_ = stat->cpu_ticks;
+  // Like on iOS, the usage is spread across all the cores.
+  const long num_cores = sysconf(_SC_NPROCESSORS_ONLN);
+  return CpuUsageInfo{
+      .num_threads = stat->num_threads,
+      .total_cpu_usage =
+          TicksToPercent(ticks, elapsed) / std::max(num_cores, 1L)};
+}
+
+std::optional<MemoryUsageInfo> ProfilerMetricsLinux::MemoryUsage() {
+  auto contents = ReadProcFile("/proc/self/statm");
+  if (!contents) {
+    FML_LOG(ERROR) << "Error reading the memory usage of the process.";
+    return std::nullopt;
+  }
+  uint64_t size_pages = 0;
+  uint64_t resident_pages = 0;
+  uint64_t shared_pages = 0;
+  std::istringstream fields(*contents);
+  fields >> size_pages >> resident_pages >> shared_pages;
+  if (fields.fail()) {
+    return std::nullopt;
+  }
+  // The resident pages that are not backed by a file can't be paged out.
+  const double page_size = sysconf(_SC_PAGESIZE);
+  return MemoryUsageInfo{
+      .dirty_memory_usage =
+          (resident_pages - shared_pages) * page_size / kBytesPerMB,
+      .owned_shared_memory_usage = shared_pages * page_size / kBytesPerMB};
+}
+
+std::optional<std::vector<ThreadCpuUsageInfo>>
+ProfilerMetricsLinux::ThreadCpuUsage(fml::TimeDelta elapsed) {
+  DIR* tasks = opendir("/proc/self/task");
+  if (!tasks) {
+    FML_LOG(ERROR) << "Error listing the threads of the process.";
+    return std::nullopt;
+  }
+  std::vector<ThreadCpuUsageInfo> threads;
+  std::unordered_map<pid_t, uint64_t> thread_cpu_ticks;
+  while (dirent* entry = readdir(tasks)) {
+    const pid_t tid = atoi(entry->d_name);
+    if (tid <= 0) {
+      continue;
+    }
+    const std::string task_path =
+        std::string{"/proc/self/task/"} + entry->d_name;
+    auto name = ReadProcFile(task_path + "/comm");
+    if (!name) {
+      // The thread has exited since the directory was listed.
+      continue;
+    }
+    if (!name->empty() && name->back() == '\n') {
+      name->pop_back();
+    }
+    if (!IsEngineThreadName(*name)) {
+      continue;
+    }
+    auto stat = ReadProcStat(task_path + "/stat");
+    if (!stat) {
+      continue;
+    }
+    thread_cpu_ticks[tid] = stat->cpu_ticks;
+    auto last_ticks = last_thread_cpu_ticks_.find(tid);
+    if (last_ticks != last_thread_cpu_ticks_.end()) {
+      threads.push_back(
+          {.name = std::move(*name),
+           .cpu_usage =
+               TicksToPercent(stat->cpu_ticks - last_ticks->second, elapsed)});
+    }
+  }
+  closedir(tasks);
+  // Forget the threads that exited.
+  last_thread_cpu_ticks_ = std::move(thread_cpu_ticks);
+  return threads;
+}
+
+std::optional<HeapUsageInfo> ProfilerMetricsLinux::HeapUsage(
+    fml::TimeDelta elapsed) {
+  const size_t heap_bytes = AllocatedHeapBytes();
+  const double growth =
+      static_cast<double>(heap_bytes) - static_cast<double>(last_heap_bytes_);
+  last_heap_bytes_ = heap_bytes;
+  const double elapsed_seconds = elapsed.ToSecondsF();
+  return HeapUsageInfo{
+      .allocated_memory = heap_bytes / kBytesPerMB,
+      .allocation_rate = elapsed_seconds > 0.0
+                             ? growth / kBytesPerMB / elapsed_seconds
+                             : 0.0};
+}
+
+}  // namespace flutter
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PROFILING_PROFILER_METRICS_LINUX_H_
+#define FLUTTER_SHELL_PROFILING_PROFILER_METRICS_LINUX_H_
+
+#include <sys/types.h>
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/shell/profiling/sampling_profiler.h"
+
+namespace flutter {
+
+/**
+ * @brief Utility class that gathers profiling metrics used by
+ * `flutter::SamplingProfiler` on Linux and Android, from `/proc/self` and
+ * `mallinfo`.
+ *
+ * The CPU usage and the allocation rate are measured since the previous
+ * sample, so the threads that are seen for the first time are only reported
+ * by the next sample.
+ *
+ * @see flutter::SamplingProfiler
+ */
+class ProfilerMetricsLinux {
+ public:
+  ProfilerMetricsLinux();
+
+  ProfileSample GenerateSample();
+
+ private:
+  fml::TimePoint last_sample_time_;
+  uint64_t last_process_cpu_ticks_ = 0;
+  std::unordered_map<pid_t, uint64_t> last_thread_cpu_ticks_;
+  size_t last_heap_bytes_ = 0;
+
+  std::optional<CpuUsageInfo> CpuUsage(fml::TimeDelta elapsed);
+
+  std::optional<MemoryUsageInfo> MemoryUsage();
+
+  std::optional<std::vector<ThreadCpuUsageInfo>> ThreadCpuUsage(
+      fml::TimeDelta elapsed);
+
+  std::optional<HeapUsageInfo> HeapUsage(fml::TimeDelta elapsed);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProfilerMetricsLinux);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PROFILING_PROFILER_METRICS_LINUX_H_
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/profiling/profiler_metrics_linux.h"
+
+#include <algorithm>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ProfilerMetricsLinuxTest, SamplesTheEngineThreads) {
+  ProfilerMetricsLinux metrics;
+  fml::Thread ui_thread("1.ui");
+  fml::Thread other_thread("other");
+
+  // The threads are only reported once they were seen by a previous sample.
+  fml::AutoResetWaitableEvent latch;
+  ui_thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+  metrics.GenerateSample();
+
+  ui_thread.GetTaskRunner()->PostTask([&latch]() {
+    const auto end =
+        fml::TimePoint::Now() + fml::TimeDelta::FromMilliseconds(50);
+    while (fml::TimePoint::Now() < end) {
+    }
+    latch.Signal();
+  });
+  latch.Wait();
+  ProfileSample sample = metrics.GenerateSample();
+
+  ASSERT_TRUE(sample.cpu_usage.has_value());
+  EXPECT_GE(sample.cpu_usage->num_threads, 3u);
+  ASSERT_TRUE(sample.memory_usage.has_value());
+  EXPECT_GT(sample.memory_usage->dirty_memory_usage, 0.0);
+  ASSERT_TRUE(sample.heap_usage.has_value());
+  EXPECT_GT(sample.heap_usage->allocated_memory, 0.0);
+
+  ASSERT_TRUE(sample.thread_cpu_usage.has_value());
+  const auto& threads = *sample.thread_cpu_usage;
+  auto ui_usage = std::find_if(
+      threads.begin(), threads.end(),
+      [](const ThreadCpuUsageInfo& thread) { return thread.name == "1.ui"; });
+  ASSERT_NE(ui_usage, threads.end());
+  EXPECT_GE(ui_usage->cpu_usage, 0.0);
+  EXPECT_TRUE(std::none_of(
+      threads.begin(), threads.end(),
+      [](const ThreadCpuUsageInfo& thread) { return thread.name == "other"; }));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -6,6 +6,42 @@
 
 namespace flutter {
 
+namespace {
+
+bool StartsWith(std::string_view string, std::string_view prefix) {
+  return string.substr(0, prefix.size()) == prefix;
+}
+
+bool EndsWith(std::string_view string, std::string_view suffix) {
+  return string.size() >= suffix.size() &&
+         string.substr(string.size() - suffix.size()) == suffix;
+}
+
+// Adds the CPU usage of all the engine threads to the timeline as a single
+// counter, so that the timeline stacks them.
+void TraceThreadCpuUsage(const std::vector<ThreadCpuUsageInfo>& threads) {
+  if (threads.empty()) {
+    return;
+  }
+  std::vector<const char*> names;
+  std::vector<std::string> values;
+  names.reserve(threads.size());
+  values.reserve(threads.size());
+  for (const auto& thread : threads) {
+    names.push_back(thread.name.c_str());
+    values.push_back(std::to_string(thread.cpu_usage));
+  }
+  fml::tracing::TraceTimelineEvent("flutter::profiling", "ThreadCpuUsage", 0,
+                                   Dart_Timeline_Event_Counter, names, values);
+}
+
+}  // namespace
+
+bool IsEngineThreadName(std::string_view name) {
+  return EndsWith(name, ".ui") || EndsWith(name, ".raster") ||
+         EndsWith(name, ".io") || StartsWith(name, "io.worker.");
+}
+
 SamplingProfiler::SamplingProfiler(
     const char* thread_label,
     fml::RefPtr<fml::TaskRunner> profiler_task_runner,
@@ -77,6 +113,16 @@ void SamplingProfiler::SampleRepeatedly(fml::TimeDelta task_delay) const {
           TRACE_EVENT_INSTANT1("flutter::profiling", "GpuUsage", "gpu_usage",
                                gpu_usage.c_str());
         }
+        if (usage.thread_cpu_usage) {
+          TraceThreadCpuUsage(*usage.thread_cpu_usage);
+        }
+        if (usage.heap_usage) {
+          FML_TRACE_COUNTER("flutter::profiling", "HeapUsage", 0,
+                            "allocated_memory",
+                            usage.heap_usage->allocated_memory,
+                            "allocation_rate",
+                            usage.heap_usage->allocation_rate);
+        }
         if (shutdown_latch.load()) {
           shutdown_latch.load()->Signal();
         } else {
@@ -9,6 +9,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/task_runner.h"
@@ -50,10 +52,35 @@ struct GpuUsageInfo {
   double percent_usage;
 };
 
+/**
+ * @brief CPU usage of one of the threads of the engine. `name` is the name of
+ * the thread, for example `1.ui` or `io.worker.2`. `cpu_usage` is the
+ * percentage (between [0, 100]) of a single core that the thread used since
+ * the previous sample.
+ *
+ * @see flutter::IsEngineThreadName
+ */
+struct ThreadCpuUsageInfo {
+  std::string name;
+  double cpu_usage;
+};
+
+/**
+ * @brief Native heap stats. `allocated_memory` is the memory (in MB) that is
+ * allocated from the native heap of the process. `allocation_rate` is how fast
+ * (in MB per second) `allocated_memory` grew since the previous sample, it is
+ * negative when more memory was freed than allocated.
+ */
+struct HeapUsageInfo {
+  double allocated_memory;
+  double allocation_rate;
+};
+
 /**
  * @brief Container for the metrics we collect during each run of `Sampler`.
- * This currently holds `CpuUsageInfo` and `MemoryUsageInfo` but the intent
- * is to expand it to other metrics.
+ * This currently holds `CpuUsageInfo`, `MemoryUsageInfo`, `GpuUsageInfo`, the
+ * `ThreadCpuUsageInfo` of the engine threads and `HeapUsageInfo`, but the
+ * intent is to expand it to other metrics.
  *
  * @see flutter::Sampler
  */
@@ -61,8 +88,17 @@ struct ProfileSample {
   std::optional<CpuUsageInfo> cpu_usage;
   std::optional<MemoryUsageInfo> memory_usage;
   std::optional<GpuUsageInfo> gpu_usage;
+  std::optional<std::vector<ThreadCpuUsageInfo>> thread_cpu_usage;
+  std::optional<HeapUsageInfo> heap_usage;
 };
 
+/**
+ * @brief Whether the thread with the given name is one of the UI, raster, IO
+ * or worker threads of the engine, whose CPU usage is reported by
+ * `ProfileSample::thread_cpu_usage`.
+ */
+bool IsEngineThreadName(std::string_view name);
+
 /**
  * @brief Sampler is run during `SamplingProfiler::SampleRepeatedly`. Each
  * platform should implement its version of a `Sampler` if they decide to
@@ -61,4 +61,14 @@ TEST(SamplingProfilerTest, DeleteAfterStart) {
   ASSERT_EQ(invoke_count_at_delete, invoke_count.load());
 }
 
+TEST(SamplingProfilerTest, IsEngineThreadName) {
+  EXPECT_TRUE(IsEngineThreadName("1.ui"));
+  EXPECT_TRUE(IsEngineThreadName("io.flutter.1.raster"));
+  EXPECT_TRUE(IsEngineThreadName("1.io"));
+  EXPECT_TRUE(IsEngineThreadName("io.worker.3"));
+  EXPECT_FALSE(IsEngineThreadName("1.platform"));
+  EXPECT_FALSE(IsEngineThreadName("io.flutter.1.profiler"));
+  EXPECT_FALSE(IsEngineThreadName("RenderThread"));
+}
+
 }  // namespace flutter
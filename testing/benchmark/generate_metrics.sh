@@ -13,4 +13,9 @@ set -ex
 ./fml_benchmarks --benchmark_format=json > fml_benchmarks.json
 ./shell_benchmarks --benchmark_format=json > shell_benchmarks.json
 ./ui_benchmarks --benchmark_format=json > ui_benchmarks.json
+./flow_benchmarks --benchmark_format=json > flow_benchmarks.json
+./embedder_benchmarks --benchmark_format=json > embedder_benchmarks.json
+./client_wrapper_benchmarks --benchmark_format=json > client_wrapper_benchmarks.json
+./common_cpp_benchmarks --benchmark_format=json > common_cpp_benchmarks.json
+./flutter_linux_benchmarks --benchmark_format=json > flutter_linux_benchmarks.json
 
@@ -92,6 +92,8 @@ void testNoCrashes() {
     testCanvas((Canvas canvas) => canvas.drawPoints(PointMode.points, <Offset>[], paint));
     testCanvas((Canvas canvas) => canvas.drawRawAtlas(image, Float32List(0), Float32List(0), Int32List(0), BlendMode.src, rect, paint));
     testCanvas((Canvas canvas) => canvas.drawRawPoints(PointMode.points, Float32List(0), paint));
+    testCanvas((Canvas canvas) => canvas.drawRawRects(Float32List(0), paint));
+    testCanvas((Canvas canvas) => canvas.drawRawCircles(Float32List(0), paint));
     testCanvas((Canvas canvas) => canvas.drawRect(rect, paint));
     testCanvas((Canvas canvas) => canvas.drawRRect(rrect, paint));
     testCanvas((Canvas canvas) => canvas.drawShadow(path, color, double.nan, false));
@@ -183,6 +185,28 @@ void main() {
     expect(areEqual, true);
   });
 
+  test('Picture.toImages matches .toImage', () async {
+    final List<Picture> pictures = <Picture>[
+      for (final Color color in const <Color>[Color(0xFFFF0000), Color(0xFF0000FF)])
+        (() {
+          final PictureRecorder recorder = PictureRecorder();
+          Canvas(recorder).drawColor(color, BlendMode.src);
+          return recorder.endRecording();
+        })(),
+    ];
+
+    final List<Image> images = await Picture.toImages(pictures, 10, 10);
+    expect(images.length, equals(2));
+    for (int i = 0; i < pictures.length; i++) {
+      final Image expected = await pictures[i].toImage(10, 10);
+      expect(images[i].width, equals(10));
+      expect(images[i].height, equals(10));
+      final ByteData expectedData = (await expected.toByteData())!;
+      final ByteData actualData = (await images[i].toByteData())!;
+      expect(actualData.buffer.asUint8List(), equals(expectedData.buffer.asUint8List()));
+    }
+  });
+
   Gradient makeGradient() {
     return Gradient.linear(
       Offset.zero,
@@ -265,6 +289,29 @@ void main() {
     expectArgumentError(() => canvas.drawRawAtlas(image, Float32List(4), Float32List(4), Int32List(2), BlendMode.src, rect, paint));
   });
 
+  test('Raw rects and circles match drawing them one at a time', () async {
+    final Paint paint = Paint()..color = const Color(0xFF00FF00);
+    final Image expected = await toImage((Canvas canvas) {
+      canvas.drawRect(const Rect.fromLTRB(10, 10, 30, 20), paint);
+      canvas.drawRect(const Rect.fromLTRB(40, 50, 60, 90), paint);
+      canvas.drawCircle(const Offset(20, 70), 10, paint);
+      canvas.drawCircle(const Offset(80, 20), 15, paint);
+    }, 100, 100);
+    final Image actual = await toImage((Canvas canvas) {
+      canvas.drawRawRects(Float32List.fromList(<double>[10, 10, 30, 20, 40, 50, 60, 90]), paint);
+      canvas.drawRawCircles(Float32List.fromList(<double>[20, 70, 10, 80, 20, 15]), paint);
+    }, 100, 100);
+
+    final ByteData expectedData = (await expected.toByteData())!;
+    final ByteData actualData = (await actual.toByteData())!;
+    expect(actualData.buffer.asUint8List(), equals(expectedData.buffer.asUint8List()));
+
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    expectArgumentError(() => canvas.drawRawRects(Float32List(3), paint));
+    expectArgumentError(() => canvas.drawRawCircles(Float32List(4), paint));
+  });
+
   test('Canvas preserves perspective data in Matrix4', () async {
     final double rotateAroundX = pi / 6;  // 30 degrees
     final double rotateAroundY = pi / 9;  // 20 degrees
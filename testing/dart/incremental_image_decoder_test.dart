@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+import 'dart:ui';
+
+import 'package:litetest/litetest.dart';
+import 'package:path/path.dart' as path;
+
+void main() {
+  test('decodes a png from chunks', () async {
+    final Uint8List bytes = await _getSkiaResource('mandrill_128.png').readAsBytes();
+    final List<Image> progress = <Image>[];
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder(
+      onProgress: progress.add,
+    );
+    for (int offset = 0; offset < bytes.length; offset += 1024) {
+      decoder.addChunk(Uint8List.sublistView(
+          bytes, offset, (offset + 1024).clamp(0, bytes.length)));
+    }
+    final Image image = await decoder.close();
+
+    expect(image.width, 128);
+    expect(image.height, 128);
+    for (final Image partial in progress) {
+      expect(partial.width, 128);
+      expect(partial.height, 128);
+      partial.dispose();
+    }
+    image.dispose();
+  });
+
+  test('decodes a png to the target size', () async {
+    final Uint8List bytes = await _getSkiaResource('mandrill_128.png').readAsBytes();
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder(
+      targetWidth: 64,
+    );
+    decoder.addChunk(Uint8List.sublistView(bytes, 0, bytes.length ~/ 2));
+    decoder.addChunk(Uint8List.sublistView(bytes, bytes.length ~/ 2));
+    final Image image = await decoder.close();
+
+    expect(image.width, 64);
+    expect(image.height, 64);
+    image.dispose();
+  });
+
+  test('decodes the first frame of an animated gif', () async {
+    final Uint8List bytes = await _getSkiaResource('test640x479.gif').readAsBytes();
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder();
+    for (int offset = 0; offset < bytes.length; offset += 4096) {
+      decoder.addChunk(Uint8List.sublistView(
+          bytes, offset, (offset + 4096).clamp(0, bytes.length)));
+    }
+    final Image image = await decoder.close();
+
+    expect(image.width, 640);
+    expect(image.height, 479);
+    image.dispose();
+  });
+
+  test('falls back to the regular decoder', () async {
+    // JPEGs are not decoded incrementally.
+    final Uint8List bytes = await _getSkiaResource('mandrill_512_q075.jpg').readAsBytes();
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder(
+      targetHeight: 128,
+    );
+    decoder.addChunk(bytes);
+    final Image image = await decoder.close();
+
+    expect(image.width, 128);
+    expect(image.height, 128);
+    image.dispose();
+  });
+
+  test('fails for invalid data', () async {
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder();
+    decoder.addChunk(Uint8List.fromList(List<int>.filled(64, 0xAB)));
+
+    bool failed = false;
+    try {
+      await decoder.close();
+    } catch (_) {
+      failed = true;
+    }
+    expect(failed, true);
+  });
+
+  test('throws when adding chunks after close', () async {
+    final Uint8List bytes = await readFile('2x2.png');
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder();
+    decoder.addChunk(bytes);
+    final Image image = await decoder.close();
+
+    bool threw = false;
+    try {
+      decoder.addChunk(bytes);
+    } on StateError {
+      threw = true;
+    }
+    expect(threw, true);
+    image.dispose();
+  });
+}
+
+Future<Uint8List> readFile(String fileName) async {
+  final File file =
+      File(path.join('flutter', 'testing', 'resources', fileName));
+  return file.readAsBytes();
+}
+
+/// Returns a File handle to a file in the skia/resources directory.
+File _getSkiaResource(String fileName) {
+  // As Platform.script is not working for flutter_tester
+  // (https://github.com/flutter/flutter/issues/12847), this is currently
+  // assuming the curent working directory is engine/src.
+  final String assetPath =
+    path.join('third_party', 'skia', 'resources', 'images', fileName);
+  return File(assetPath);
+}
@@ -206,4 +206,52 @@ void main() {
     expect(line.start, 6);
     expect(line.end, 10);
   });
+
+  Paragraph buildAhemParagraph(String text) {
+    final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+      fontFamily: 'Ahem',
+      fontSize: 10.0,
+    ));
+    builder.addText(text);
+    return builder.build();
+  }
+
+  test('layoutAll lays out each paragraph like layout', () {
+    final List<Paragraph> paragraphs = <Paragraph>[
+      for (int i = 0; i < 20; i++) buildAhemParagraph('Test Ahem ' * (i + 1)),
+    ];
+    final List<ParagraphConstraints> constraints = <ParagraphConstraints>[
+      for (int i = 0; i < 20; i++) ParagraphConstraints(width: 50.0 + 10.0 * i),
+    ];
+    Paragraph.layoutAll(paragraphs, constraints);
+
+    for (int i = 0; i < paragraphs.length; i++) {
+      final Paragraph expected = buildAhemParagraph('Test Ahem ' * (i + 1));
+      expected.layout(constraints[i]);
+      // Each paragraph gets the constraints of the same index.
+      expect(paragraphs[i].width, constraints[i].width);
+      expect(paragraphs[i].height, expected.height);
+      expect(paragraphs[i].longestLine, expected.longestLine);
+      expect(paragraphs[i].computeLineMetrics().length,
+          expected.computeLineMetrics().length);
+    }
+  });
+
+  test('layoutAll uses the last constraints of a repeated paragraph', () {
+    final Paragraph paragraph = buildAhemParagraph('Test Ahem');
+    final Paragraph other = buildAhemParagraph('Test');
+    Paragraph.layoutAll(
+      <Paragraph>[paragraph, other, paragraph],
+      const <ParagraphConstraints>[
+        ParagraphConstraints(width: 200.0),
+        ParagraphConstraints(width: 100.0),
+        ParagraphConstraints(width: 50.0),
+      ],
+    );
+
+    expect(paragraph.width, 50.0);
+    // Wraps to two lines at the last width.
+    expect(paragraph.height, closeTo(20.0, 0.001));
+    expect(other.width, 100.0);
+  });
 }
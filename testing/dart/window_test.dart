@@ -68,6 +68,25 @@ void main() {
             'frameNumber: 29)');
   });
 
+  test('FrameTiming reports the shader compilations and cache purges', () {
+    final FrameTiming timing = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+      shaderCompileCount: 2,
+      shaderCompileDurationMicros: 6500,
+      resourceCachePurgedBytes: 4096,
+      frameNumber: 31,
+    );
+    expect(timing.shaderCompileCount, 2);
+    expect(timing.shaderCompileDuration, const Duration(microseconds: 6500));
+    expect(timing.resourceCachePurgedBytes, 4096);
+    expect(timing.frameNumber, 31);
+  });
+
   test('computePlatformResolvedLocale basic', () {
     final List<Locale> supportedLocales = <Locale>[
       const Locale.fromSubtags(languageCode: 'zh', scriptCode: 'Hans', countryCode: 'CN'),
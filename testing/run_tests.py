@@ -194,6 +194,8 @@ def RunCCTests(build_dir, filter, coverage, capture_core_dump):
       '--golden-dir=%s' % golden_dir,
       '--font-file=%s' % roboto_font_path,
     ]
+  RunEngineExecutable(build_dir, 'assets_unittests', filter, shuffle_flags, coverage=coverage)
+
   RunEngineExecutable(build_dir, 'flow_unittests', filter, flow_flags + shuffle_flags, coverage=coverage)
 
   RunEngineExecutable(build_dir, 'fml_unittests', filter, [ fml_unittests_filter ] + shuffle_flags)
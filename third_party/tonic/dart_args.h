@@ -238,6 +238,29 @@ void DartCallConstructor(Sig func, Dart_NativeArguments args) {
   wrappable->AssociateWithDartWrapper(wrapper);
 }
 
+// Calls a method of a wrappable from an FFI native. The VM passes the peer of
+// the receiver, read from its native field, and the arguments unboxed, so no
+// Dart API is involved and the native can be a leaf call. Only methods that
+// take and return arithmetic values can be bound this way.
+template <typename Sig, Sig method>
+struct FfiDispatcher;
+
+template <typename C,
+          typename ResultType,
+          typename... ArgTypes,
+          ResultType (C::*method)(ArgTypes...)>
+struct FfiDispatcher<ResultType (C::*)(ArgTypes...), method> {
+  static_assert(std::is_void<ResultType>::value ||
+                    std::is_arithmetic<ResultType>::value,
+                "FFI natives must return an arithmetic value.");
+  static_assert(std::conjunction<std::is_arithmetic<ArgTypes>...>::value,
+                "FFI natives must only take arithmetic arguments.");
+
+  static ResultType Call(DartWrappable* receiver, ArgTypes... args) {
+    return (static_cast<C*>(receiver)->*method)(args...);
+  }
+};
+
 }  // namespace tonic
 
 #endif  // LIB_TONIC_DART_ARGS_H_
@@ -33,6 +33,13 @@
         tonic::IndicesForSignature < decltype(&CLASS::METHOD)> ::count, true \
   }
 
+#define DART_REGISTER_FFI_NATIVE(CLASS, METHOD)                  \
+  {#CLASS "::" #METHOD,                                          \
+   reinterpret_cast<void*>(                                      \
+       &tonic::FfiDispatcher<decltype(&CLASS::METHOD),           \
+                             &CLASS::METHOD>::Call),             \
+   tonic::IndicesForSignature<decltype(&CLASS::METHOD)>::count + 1},
+
 #define DART_BIND_ALL(CLASS, FOR_EACH)                              \
   FOR_EACH(DART_NATIVE_CALLBACK)                                    \
   void CLASS::RegisterNatives(tonic::DartLibraryNatives* natives) { \
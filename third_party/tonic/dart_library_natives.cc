@@ -19,6 +19,12 @@ void DartLibraryNatives::Register(std::initializer_list<Entry> entries) {
   }
 }
 
+void DartLibraryNatives::RegisterFfi(std::initializer_list<FfiEntry> entries) {
+  for (const FfiEntry& entry : entries) {
+    ffi_entries_.emplace(entry.symbol, entry);
+  }
+}
+
 Dart_NativeFunction DartLibraryNatives::GetNativeFunction(
     Dart_Handle name,
     int argument_count,
@@ -42,4 +48,15 @@ const uint8_t* DartLibraryNatives::GetSymbol(
   return reinterpret_cast<const uint8_t*>(it->second);
 }
 
+void* DartLibraryNatives::GetFfiNativeFunction(const char* name,
+                                               uintptr_t argument_count) {
+  auto it = ffi_entries_.find(name);
+  if (it == ffi_entries_.end())
+    return nullptr;
+  const FfiEntry& entry = it->second;
+  if (static_cast<uintptr_t>(entry.argument_count) != argument_count)
+    return nullptr;
+  return entry.function;
+}
+
 }  // namespace tonic
@@ -26,16 +26,28 @@ class DartLibraryNatives {
     bool auto_setup_scope;
   };
 
+  // A native bound with @FfiNative. |argument_count| includes the receiver.
+  struct FfiEntry {
+    const char* symbol;
+    void* function;
+    int argument_count;
+  };
+
   void Register(std::initializer_list<Entry> entries);
 
+  void RegisterFfi(std::initializer_list<FfiEntry> entries);
+
   Dart_NativeFunction GetNativeFunction(Dart_Handle name,
                                         int argument_count,
                                         bool* auto_setup_scope);
   const uint8_t* GetSymbol(Dart_NativeFunction native_function);
 
+  void* GetFfiNativeFunction(const char* name, uintptr_t argument_count);
+
  private:
   std::unordered_map<std::string, Entry> entries_;
   std::unordered_map<Dart_NativeFunction, const char*> symbols_;
+  std::unordered_map<std::string, FfiEntry> ffi_entries_;
 
   TONIC_DISALLOW_COPY_AND_ASSIGN(DartLibraryNatives);
 };
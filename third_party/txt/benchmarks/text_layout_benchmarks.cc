@@ -0,0 +1,331 @@
+/*
+ * Copyright 2019 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <minikin/Hyphenator.h>
+#include <minikin/Layout.h>
+#include <minikin/LineBreaker.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+#include "third_party/icu/source/common/unicode/locid.h"
+#include "third_party/icu/source/common/unicode/unistr.h"
+#include "txt/font_collection.h"
+#include "txt/paragraph_builder_txt.h"
+#include "txt/paragraph_txt.h"
+
+// Counts the allocations of the whole executable, so that the benchmarks below
+// can report the allocations per layout alongside the time.
+static std::atomic<size_t> g_allocation_count(0);
+
+void* operator new(size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+  std::free(ptr);
+}
+
+namespace txt {
+
+namespace {
+
+class AllocationCounter {
+ public:
+  AllocationCounter() : start_(g_allocation_count.load()) {}
+
+  // Reports the allocations made since the counter was created, averaged over
+  // the iterations of the benchmark.
+  void Report(benchmark::State& state) const {
+    state.counters["allocs"] =
+        benchmark::Counter(g_allocation_count.load() - start_,
+                           benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  const size_t start_;
+};
+
+std::u16string ToU16String(const std::string& text) {
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  return std::u16string(icu_text.getBuffer(),
+                        icu_text.getBuffer() + icu_text.length());
+}
+
+// Repeats the text until it is at least the given number of UTF-16 code units.
+std::u16string RepeatText(const std::string& text, size_t length) {
+  const std::u16string unit = ToU16String(text);
+  std::u16string result;
+  while (result.length() < length) {
+    result += unit;
+  }
+  return result;
+}
+
+const char* kLatinText =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
+    "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
+    "commodo consequat. ";
+
+// Long words with soft hyphens, which the hyphenator breaks without patterns.
+const char* kSoftHyphenText =
+    "Inter\u00ADnatio\u00ADnal\u00ADiza\u00ADtion and local\u00ADiza\u00ADtion "
+    "are incom\u00ADpre\u00ADhen\u00ADsi\u00ADbil\u00ADi\u00ADties of "
+    "elec\u00ADtro\u00ADen\u00ADceph\u00ADa\u00ADlo\u00ADgraph\u00ADi\u00ADcal "
+    "engi\u00ADneer\u00ADing. ";
+
+const char* kMixedBidiText =
+    "محادثة First Line مع الطيار الآلي 1234 and the second run, "
+    "الصفحة الرئيسية Home Page. ";
+
+const char* kCJKText =
+    "左線読設重説切後碁給能上目秘使約。満毎冠行来昼本可必図将発確年。今属場育"
+    "図情闘陰野高備込制詩西校客。審対江置講今固残必託地集済決維駆年策。立得庭";
+
+const char* kEmojiText =
+    "😀😃😄😁😆😅😂🤣☺😇🙂😍😡😟😢😻👽💩👍👎🙏👌👋👄👁👦👼👨‍🚀👨‍🚒🙋‍♂️👳"
+    "👨‍👨‍👧‍👧 ";
+
+}  // namespace
+
+class TextLayoutFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State& state) {
+    font_collection_ = GetTestFontCollection();
+    // The paragraphs below are laid out again and again, which would otherwise
+    // measure copies out of the paragraph cache instead of the layout.
+    font_collection_->GetParagraphCache().SetMaxEntries(0);
+  }
+
+  void TearDown(const benchmark::State& state) {
+    font_collection_.reset();
+    minikin::Layout::setCacheMaxBytes(minikin::Layout::kDefaultCacheMaxBytes);
+  }
+
+ protected:
+  std::unique_ptr<Paragraph> BuildTextParagraph(
+      const std::u16string& text,
+      const std::string& family,
+      TextDirection direction = TextDirection::ltr) {
+    ParagraphStyle paragraph_style;
+    paragraph_style.text_direction = direction;
+    ParagraphBuilderTxt builder(paragraph_style, font_collection_);
+
+    TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, family);
+    text_style.color = SK_ColorBLACK;
+    builder.PushStyle(text_style);
+    builder.AddText(text);
+    builder.Pop();
+    return BuildParagraph(builder);
+  }
+
+  // Lays the paragraph out on every iteration, with the word layouts cached
+  // by minikin across the iterations.
+  void RunLayout(benchmark::State& state, Paragraph& paragraph) {
+    AllocationCounter allocations;
+    while (state.KeepRunning()) {
+      paragraph.SetDirty();
+      paragraph.Layout(300);
+    }
+    allocations.Report(state);
+  }
+
+  std::shared_ptr<FontCollection> font_collection_;
+};
+
+// -----------------------------------------------------------------------------
+//
+// Line breaking, with and without hyphenation.
+//
+// -----------------------------------------------------------------------------
+
+BENCHMARK_DEFINE_F(TextLayoutFixture, LineBreakHyphenation)
+(benchmark::State& state) {
+  const std::u16string text = RepeatText(kSoftHyphenText, 1 << 12);
+  minikin::FontStyle font(4, false);
+  minikin::MinikinPaint paint;
+  paint.size = 14;
+  auto collection = font_collection_->GetMinikinFontCollectionForFamilies(
+      std::vector<std::string>(1, "Roboto"), "en-US");
+
+  minikin::LineBreaker breaker;
+  breaker.setLocale();
+  breaker.setStrategy(minikin::kBreakStrategy_HighQuality);
+  breaker.setHyphenationFrequency(
+      static_cast<minikin::HyphenationFrequency>(state.range(0)));
+
+  AllocationCounter allocations;
+  while (state.KeepRunning()) {
+    breaker.resize(text.size());
+    memcpy(breaker.buffer(), text.data(), text.size() * sizeof(text[0]));
+    breaker.setText();
+    breaker.setLineWidths(0, 0, 300);
+    breaker.addStyleRun(&paint, collection, font, 0, text.size(), false);
+    benchmark::DoNotOptimize(breaker.computeBreaks());
+    breaker.finish();
+  }
+  allocations.Report(state);
+}
+BENCHMARK_REGISTER_F(TextLayoutFixture, LineBreakHyphenation)
+    ->Arg(minikin::kHyphenationFrequency_None)
+    ->Arg(minikin::kHyphenationFrequency_Normal)
+    ->Arg(minikin::kHyphenationFrequency_Full);
+
+BENCHMARK_F(TextLayoutFixture, HyphenateSoftHyphens)(benchmark::State& state) {
+  // There is no hyphenation pattern data in the tree, so the hyphenator only
+  // processes the soft hyphens of the words.
+  std::unique_ptr<minikin::Hyphenator> hyphenator(
+      minikin::Hyphenator::loadBinary(nullptr, 2, 2));
+  const std::u16string text = ToU16String(kSoftHyphenText);
+  const icu::Locale locale("en", "US");
+
+  std::vector<std::pair<size_t, size_t>> words;
+  size_t word_start = 0;
+  for (size_t i = 0; i <= text.size(); ++i) {
+    if (i == text.size() || text[i] == ' ') {
+      if (i > word_start) {
+        words.emplace_back(word_start, i - word_start);
+      }
+      word_start = i + 1;
+    }
+  }
+
+  std::vector<minikin::HyphenationType> result;
+  AllocationCounter allocations;
+  while (state.KeepRunning()) {
+    for (const auto& word : words) {
+      hyphenator->hyphenate(
+          &result, reinterpret_cast<const uint16_t*>(text.data()) + word.first,
+          word.second, locale);
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  allocations.Report(state);
+}
+
+// -----------------------------------------------------------------------------
+//
+// Paragraphs of scripts that take the slower paths of the layout.
+//
+// -----------------------------------------------------------------------------
+
+BENCHMARK_DEFINE_F(TextLayoutFixture, LatinLayout)(benchmark::State& state) {
+  auto paragraph =
+      BuildTextParagraph(RepeatText(kLatinText, state.range(0)), "Roboto");
+  RunLayout(state, *paragraph);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(TextLayoutFixture, LatinLayout)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 14)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK_DEFINE_F(TextLayoutFixture, MixedBidiLayout)
+(benchmark::State& state) {
+  auto paragraph =
+      BuildTextParagraph(RepeatText(kMixedBidiText, state.range(0)),
+                         "Noto Naskh Arabic", TextDirection::rtl);
+  RunLayout(state, *paragraph);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(TextLayoutFixture, MixedBidiLayout)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 14)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK_DEFINE_F(TextLayoutFixture, CJKLayout)(benchmark::State& state) {
+  auto paragraph = BuildTextParagraph(RepeatText(kCJKText, state.range(0)),
+                                      "Noto Sans CJK JP");
+  RunLayout(state, *paragraph);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(TextLayoutFixture, CJKLayout)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 14)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK_DEFINE_F(TextLayoutFixture, EmojiLayout)(benchmark::State& state) {
+  auto paragraph = BuildTextParagraph(RepeatText(kEmojiText, state.range(0)),
+                                      "Noto Color Emoji");
+  RunLayout(state, *paragraph);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(TextLayoutFixture, EmojiLayout)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 12)
+    ->Complexity(benchmark::oN);
+
+// -----------------------------------------------------------------------------
+//
+// Shaping with cold and warm caches of the layouts of words.
+//
+// -----------------------------------------------------------------------------
+
+BENCHMARK_F(TextLayoutFixture, ColdCacheLayout)(benchmark::State& state) {
+  auto paragraph =
+      BuildTextParagraph(RepeatText(kLatinText, 1 << 12), "Roboto");
+  AllocationCounter allocations;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    minikin::Layout::purgeCaches();
+    paragraph->SetDirty();
+    state.ResumeTiming();
+    paragraph->Layout(300);
+  }
+  allocations.Report(state);
+}
+
+BENCHMARK_F(TextLayoutFixture, WarmCacheLayout)(benchmark::State& state) {
+  auto paragraph =
+      BuildTextParagraph(RepeatText(kLatinText, 1 << 12), "Roboto");
+  paragraph->Layout(300);
+  RunLayout(state, *paragraph);
+}
+
+// Lays out more distinct words than the smaller caches hold, so that the
+// words are evicted before they are laid out again.
+BENCHMARK_DEFINE_F(TextLayoutFixture, LayoutCacheSizeSweep)
+(benchmark::State& state) {
+  minikin::Layout::purgeCaches();
+  minikin::Layout::setCacheMaxBytes(state.range(0));
+  std::u16string text;
+  for (size_t i = 0; text.size() < (1 << 14); ++i) {
+    text += ToU16String(std::to_string(i * 7919) + "word ");
+  }
+  auto paragraph = BuildTextParagraph(text, "Roboto");
+  RunLayout(state, *paragraph);
+}
+BENCHMARK_REGISTER_F(TextLayoutFixture, LayoutCacheSizeSweep)
+    ->Arg(0)
+    ->RangeMultiplier(4)
+    ->Range(1 << 14, 1 << 22);
+
+}  // namespace txt
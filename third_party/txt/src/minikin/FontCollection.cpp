@@ -536,6 +536,33 @@ void FontCollection::itemize(const uint16_t* string,
     }
     prevCh = ch;
     run->end = nextUtf16Pos;  // exclusive
+
+    // The characters that the first family covers are always matched to it,
+    // so they continue its run without being scored, except for a character
+    // followed by a variation selector, which is matched with it.
+    if (lastFamily == mFamilies[0].get() && nextCh != kEndOfString) {
+      size_t span = lastFamily->getCoverage().getBmpSpan(
+          string + nextUtf16Pos, string_size - nextUtf16Pos);
+      if (span > 0 && nextUtf16Pos + span < string_size) {
+        uint32_t afterSpan;
+        size_t afterSpanPos = nextUtf16Pos + span;
+        U16_NEXT(string, afterSpanPos, string_size, afterSpan);
+        if (isVariationSelector(afterSpan)) {
+          span--;
+        }
+      }
+      if (span > 0) {
+        prevCh = string[nextUtf16Pos + span - 1];
+        nextUtf16Pos += span;
+        run->end = nextUtf16Pos;
+        readLength = nextUtf16Pos;
+        if (readLength < string_size) {
+          U16_NEXT(string, readLength, string_size, nextCh);
+        } else {
+          nextCh = kEndOfString;
+        }
+      }
+    }
   } while (nextCh != kEndOfString);
 }
 
@@ -20,11 +20,17 @@
 #include <unicode/ubidi.h>
 #include <unicode/utf16.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <fstream>
 #include <iostream>  // for debugging
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "flutter/fml/memory/memory_accounting.h"
+#include "flutter/fml/trace_event.h"
+
 #include <log/log.h>
 #include <utils/JenkinsHash.h>
 #include <utils/LruCache.h>
@@ -51,6 +57,10 @@ struct LayoutContext {
   std::vector<hb_font_t*> hbFonts;  // parallel to mFaces
 
   void clearHbFonts() {
+    if (hbFonts.empty()) {
+      return;
+    }
+    std::scoped_lock _l(gMinikinLock);
     for (size_t i = 0; i < hbFonts.size(); i++) {
       hb_font_set_funcs(hbFonts[i], nullptr, nullptr, nullptr);
       hb_font_destroy(hbFonts[i]);
@@ -99,6 +109,11 @@ class LayoutCacheKey {
     mChars = NULL;
   }
 
+  // The bytes of the copy of the text.
+  size_t getMemoryUsage() const {
+    return sizeof(*this) + mNchars * sizeof(uint16_t);
+  }
+
   void doLayout(Layout* layout,
                 LayoutContext* ctx,
                 const std::shared_ptr<FontCollection>& collection) const {
@@ -129,42 +144,140 @@ class LayoutCacheKey {
   android::hash_t computeHash() const;
 };
 
-class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
+// The layouts of the words laid out by all the threads. The cache is split in
+// shards that have a lock each, so that the threads only contend for the cache
+// when they look up words of the same shard.
+class LayoutCache {
  public:
-  LayoutCache() : mCache(kMaxEntries) {
-    mCache.setOnEntryRemovedListener(this);
+  LayoutCache() : mMaxBytes(Layout::kDefaultCacheMaxBytes) {}
+
+  void clear() {
+    for (Shard& shard : mShards) {
+      shard.clear();
+    }
   }
 
-  void clear() { mCache.clear(); }
+  void setMaxBytes(size_t maxBytes) {
+    mMaxBytes = maxBytes;
+    for (Shard& shard : mShards) {
+      shard.trim(maxBytes / kShardCount);
+    }
+  }
 
-  Layout* get(LayoutCacheKey& key,
-              LayoutContext* ctx,
-              const std::shared_ptr<FontCollection>& collection) {
-    Layout* layout = mCache.get(key);
-    if (layout == NULL) {
-      key.copyText();
-      layout = new Layout();
-      key.doLayout(layout, ctx, collection);
-      mCache.put(key, layout);
+  std::shared_ptr<const Layout> get(
+      LayoutCacheKey& key,
+      LayoutContext* ctx,
+      const std::shared_ptr<FontCollection>& collection) {
+    const size_t maxShardBytes = mMaxBytes / kShardCount;
+    Shard& shard = mShards[key.hash() % kShardCount];
+    std::shared_ptr<const Layout> layout =
+        maxShardBytes > 0 ? shard.get(key) : nullptr;
+    if (layout) {
+      countLookup(true);
+      return layout;
     }
-    return layout;
+    countLookup(false);
+
+    // The words are shaped outside the lock of the shard, so two threads may
+    // shape the same word, in which case the first layout is kept.
+    auto newLayout = std::make_shared<Layout>();
+    {
+      std::scoped_lock _l(gMinikinLock);
+      key.doLayout(newLayout.get(), ctx, collection);
+    }
+    if (maxShardBytes > 0) {
+      shard.put(key, newLayout, maxShardBytes);
+    }
+    return newLayout;
   }
 
  private:
-  // callback for OnEntryRemoved
-  void operator()(LayoutCacheKey& key, Layout*& value) {
-    key.freeText();
-    delete value;
-  }
+  struct Entry {
+    // LruCache makes its null value from 0.
+    Entry(std::shared_ptr<const Layout> layout = nullptr, size_t bytes = 0)
+        : layout(std::move(layout)), bytes(bytes) {}
+
+    std::shared_ptr<const Layout> layout;
+    size_t bytes;
+  };
+
+  class Shard : private android::OnEntryRemoved<LayoutCacheKey, Entry> {
+   public:
+    Shard()
+        : mCache(
+              android::LruCache<LayoutCacheKey, Entry>::kUnlimitedCapacity) {
+      mCache.setOnEntryRemovedListener(this);
+    }
+
+    void clear() {
+      std::scoped_lock _l(mMutex);
+      mCache.clear();
+    }
+
+    std::shared_ptr<const Layout> get(const LayoutCacheKey& key) {
+      std::scoped_lock _l(mMutex);
+      return mCache.get(key).layout;
+    }
+
+    void put(LayoutCacheKey& key,
+             const std::shared_ptr<const Layout>& layout,
+             size_t maxBytes) {
+      std::scoped_lock _l(mMutex);
+      if (mCache.get(key).layout) {
+        return;
+      }
+      key.copyText();
+      const size_t bytes = key.getMemoryUsage() + layout->getMemoryUsage();
+      mCache.put(key, {layout, bytes});
+      mBytes += bytes;
+      fml::MemoryAccounting::Add(fml::MemoryCategory::kTextLayoutCache, bytes);
+      trimLocked(maxBytes);
+    }
+
+    void trim(size_t maxBytes) {
+      std::scoped_lock _l(mMutex);
+      trimLocked(maxBytes);
+    }
+
+   private:
+    void trimLocked(size_t maxBytes) {
+      while (mBytes > maxBytes && mCache.removeOldest()) {
+      }
+    }
 
-  android::LruCache<LayoutCacheKey, Layout*> mCache;
+    // callback for OnEntryRemoved
+    void operator()(LayoutCacheKey& key, Entry& value) {
+      key.freeText();
+      mBytes -= value.bytes;
+      fml::MemoryAccounting::Add(fml::MemoryCategory::kTextLayoutCache,
+                                 -static_cast<int64_t>(value.bytes));
+    }
+
+    std::mutex mMutex;
+    android::LruCache<LayoutCacheKey, Entry> mCache;
+    size_t mBytes = 0;
+  };
+
+  // Reports the hits and misses of the cache to the timeline once every
+  // kLookupsPerTrace lookups, as there is a lookup for each word.
+  void countLookup(bool hit) {
+    const uint64_t hits = hit ? ++mHits : mHits.load();
+    const uint64_t misses = hit ? mMisses.load() : ++mMisses;
+    if ((hits + misses) % kLookupsPerTrace == 0) {
+      FML_TRACE_COUNTER("flutter", "minikin::LayoutCache",
+                        reinterpret_cast<int64_t>(this),  //
+                        "Hits", hits,                     //
+                        "Misses", misses);
+    }
+  }
 
-  // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
-  // Layout*>::kUnlimitedCapacity;
+  static constexpr size_t kShardCount = 16;
+  static constexpr uint64_t kLookupsPerTrace = 1024;
 
-  // TODO: eviction based on memory footprint; for now, we just use a constant
-  // number of strings
-  static const size_t kMaxEntries = 5000;
+  std::array<Shard, kShardCount> mShards;
+  std::atomic<size_t> mMaxBytes;
+  std::atomic<uint64_t> mHits = 0;
+  std::atomic<uint64_t> mMisses = 0;
 };
 
 class LayoutEngine {
@@ -588,8 +701,7 @@ void Layout::doLayout(const uint16_t* buf,
                       const FontStyle& style,
                       const MinikinPaint& paint,
                       const std::shared_ptr<FontCollection>& collection) {
-  std::scoped_lock _l(gMinikinLock);
-
+  // The words that aren't in the cache lock gMinikinLock as they are shaped.
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
@@ -612,8 +724,6 @@ float Layout::measureText(const uint16_t* buf,
                           const MinikinPaint& paint,
                           const std::shared_ptr<FontCollection>& collection,
                           float* advances) {
-  std::scoped_lock _l(gMinikinLock);
-
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
@@ -711,7 +821,10 @@ float Layout::doLayoutWord(const uint16_t* buf,
   float advance;
   if (ctx->paint.skipCache()) {
     Layout layoutForWord;
-    key.doLayout(&layoutForWord, ctx, collection);
+    {
+      std::scoped_lock _l(gMinikinLock);
+      key.doLayout(&layoutForWord, ctx, collection);
+    }
     if (layout) {
       layout->appendLayout(&layoutForWord, bufStart, wordSpacing);
     }
@@ -720,9 +833,10 @@ float Layout::doLayoutWord(const uint16_t* buf,
     }
     advance = layoutForWord.getAdvance();
   } else {
-    Layout* layoutForWord = cache.get(key, ctx, collection);
+    std::shared_ptr<const Layout> layoutForWord =
+        cache.get(key, ctx, collection);
     if (layout) {
-      layout->appendLayout(layoutForWord, bufStart, wordSpacing);
+      layout->appendLayout(layoutForWord.get(), bufStart, wordSpacing);
     }
     if (advances) {
       layoutForWord->getAdvances(advances);
@@ -1105,7 +1219,9 @@ void Layout::doLayoutRun(const uint16_t* buf,
   mAdvance = x;
 }
 
-void Layout::appendLayout(Layout* src, size_t start, float extraAdvance) {
+void Layout::appendLayout(const Layout* src,
+                          size_t start,
+                          float extraAdvance) {
   int fontMapStack[16];
   int* fontMap;
   if (src->mFaces.size() < sizeof(fontMapStack) / sizeof(fontMapStack[0])) {
@@ -1184,7 +1300,7 @@ float Layout::getAdvance() const {
   return mAdvance;
 }
 
-void Layout::getAdvances(float* advances) {
+void Layout::getAdvances(float* advances) const {
   memcpy(advances, &mAdvances[0], mAdvances.size() * sizeof(float));
 }
 
@@ -1193,10 +1309,20 @@ void Layout::getBounds(MinikinRect* bounds) const {
 }
 
 void Layout::purgeCaches() {
-  std::scoped_lock _l(gMinikinLock);
   LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
   layoutCache.clear();
+  std::scoped_lock _l(gMinikinLock);
   purgeHbFontCacheLocked();
 }
 
+void Layout::setCacheMaxBytes(size_t maxBytes) {
+  LayoutEngine::getInstance().layoutCache.setMaxBytes(maxBytes);
+}
+
+size_t Layout::getMemoryUsage() const {
+  return sizeof(*this) + mGlyphs.capacity() * sizeof(LayoutGlyph) +
+         mAdvances.capacity() * sizeof(float) +
+         mFaces.capacity() * sizeof(FakedFont);
+}
+
 }  // namespace minikin
@@ -106,7 +106,7 @@ class Layout {
 
   // Get advances, copying into caller-provided buffer. The size of this
   // buffer must match the length of the string (count arg to doLayout).
-  void getAdvances(float* advances);
+  void getAdvances(float* advances) const;
 
   // The i parameter is an offset within the buf relative to start, it is <
   // count, where start and count are the parameters to doLayout
@@ -117,6 +117,16 @@ class Layout {
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
+  // The default number of bytes of the layouts of words that are cached.
+  static constexpr size_t kDefaultCacheMaxBytes = 2 * 1024 * 1024;
+
+  // Sets the number of bytes of the layouts of words that are cached, evicting
+  // the least recently used words that are over it. 0 disables the cache.
+  static void setCacheMaxBytes(size_t maxBytes);
+
+  // The bytes of this layout, including its own size.
+  size_t getMemoryUsage() const;
+
  private:
   friend class LayoutCacheKey;
 
@@ -163,7 +173,7 @@ class Layout {
                    const std::shared_ptr<FontCollection>& collection);
 
   // Append another layout (for example, cached value) into this one
-  void appendLayout(Layout* src, size_t start, float extraAdvance);
+  void appendLayout(const Layout* src, size_t start, float extraAdvance);
 
   std::vector<LayoutGlyph> mGlyphs;
   std::vector<float> mAdvances;
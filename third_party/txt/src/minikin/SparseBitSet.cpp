@@ -118,6 +118,31 @@ int SparseBitSet::CountLeadingZeros(element x) {
 }
 #endif
 
+size_t SparseBitSet::getBmpSpan(const uint16_t* text, size_t length) const {
+  size_t i = 0;
+  while (i < length) {
+    const uint32_t ch = text[i];
+    // The surrogates are all on pages of their own, so the other characters
+    // of the page of a non surrogate are not surrogates either.
+    if (ch >= mMaxVal || (ch & 0xF800) == 0xD800) {
+      return i;
+    }
+    const uint32_t page = ch >> kLogValuesPerPage;
+    if (mIndices[page] == mZeroPageIndex) {
+      return i;
+    }
+    const element* bitmap = &mBitmaps[mIndices[page]];
+    for (; i < length && (text[i] >> kLogValuesPerPage) == page; i++) {
+      const uint32_t index = text[i] & kPageMask;
+      if ((bitmap[index >> kLogBitsPerEl] & (kElFirst >> (index & kElMask))) ==
+          0) {
+        return i;
+      }
+    }
+  }
+  return length;
+}
+
 uint32_t SparseBitSet::nextSetBit(uint32_t fromIndex) const {
   if (fromIndex >= mMaxVal) {
     return kNotFound;
@@ -59,6 +59,12 @@ class SparseBitSet {
   // One more than the maximum value in the set, or zero if empty
   uint32_t length() const { return mMaxVal; }
 
+  // The number of leading UTF-16 code units of the text that are BMP
+  // characters in the set, which stops at the first surrogate. The characters
+  // of the same page are tested against its bitmap without looking the page
+  // up again for each of them.
+  size_t getBmpSpan(const uint16_t* text, size_t length) const;
+
   // The next set bit starting at fromIndex, inclusive, or kNotFound
   // if none exists.
   uint32_t nextSetBit(uint32_t fromIndex) const;
@@ -21,6 +21,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +38,9 @@ namespace {
 
 const std::shared_ptr<minikin::FontFamily> g_null_family;
 
+// The first line of a serialized fallback font index.
+constexpr char kFallbackFontIndexHeader[] = "txt-fallback-font-index 1";
+
 }  // anonymous namespace
 
 FontCollection::FamilyKey::FamilyKey(const std::vector<std::string>& families,
@@ -164,9 +168,12 @@ FontCollection::GetMinikinFontCollectionForFamilies(
     const std::string& locale) {
   // Look inside the font collections cache first.
   FamilyKey family_key(font_families, locale);
-  auto cached = font_collections_cache_.find(family_key);
-  if (cached != font_collections_cache_.end()) {
-    return cached->second;
+  {
+    std::scoped_lock lock(cache_mutex_);
+    auto cached = font_collections_cache_.find(family_key);
+    if (cached != font_collections_cache_.end()) {
+      return cached->second;
+    }
   }
 
   std::vector<std::shared_ptr<minikin::FontFamily>> minikin_families;
@@ -194,10 +201,12 @@ FontCollection::GetMinikinFontCollectionForFamilies(
   }
   // Default font family also not found. We fail to get a FontCollection.
   if (minikin_families.empty()) {
+    std::scoped_lock lock(cache_mutex_);
     font_collections_cache_[family_key] = nullptr;
     return nullptr;
   }
   if (enable_font_fallback_) {
+    std::scoped_lock lock(cache_mutex_);
     for (const std::string& fallback_family :
          fallback_fonts_for_locale_[locale]) {
       auto it = fallback_fonts_.find(fallback_family);
@@ -210,6 +219,7 @@ FontCollection::GetMinikinFontCollectionForFamilies(
   auto font_collection =
       minikin::FontCollection::Create(std::move(minikin_families));
   if (!font_collection) {
+    std::scoped_lock lock(cache_mutex_);
     font_collections_cache_[family_key] = nullptr;
     return nullptr;
   }
@@ -219,6 +229,7 @@ FontCollection::GetMinikinFontCollectionForFamilies(
   }
 
   // Cache the font collection for future queries.
+  std::scoped_lock lock(cache_mutex_);
   font_collections_cache_[family_key] = font_collection;
 
   return font_collection;
@@ -238,6 +249,18 @@ std::shared_ptr<minikin::FontFamily> FontCollection::FindFontFamilyInManagers(
   return nullptr;
 }
 
+sk_sp<SkTypeface> FontCollection::MatchTypeface(
+    const std::string& family_name,
+    const SkFontStyle& style) const {
+  for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
+    sk_sp<SkTypeface> typeface(
+        manager->matchFamilyStyle(family_name.c_str(), style));
+    if (typeface)
+      return typeface;
+  }
+  return nullptr;
+}
+
 void FontCollection::SortSkTypefaces(
     std::vector<sk_sp<SkTypeface>>& sk_typefaces) {
   std::sort(
@@ -321,16 +344,113 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
   // Check if the ch's matched font has been cached. We cache the results of
   // this method as repeated matchFamilyStyleCharacter calls can become
   // extremely laggy when typing a large number of complex emojis.
+  std::scoped_lock lock(cache_mutex_);
   auto lookup = fallback_match_cache_.find(ch);
   if (lookup != fallback_match_cache_.end()) {
     return *lookup->second;
   }
   const std::shared_ptr<minikin::FontFamily>* match =
-      &DoMatchFallbackFont(ch, locale);
+      &MatchIndexedFallbackFont(ch, locale);
+  if (!*match) {
+    match = &DoMatchFallbackFont(ch, locale);
+    if (*match)
+      has_new_fallback_fonts_ = true;
+  }
   fallback_match_cache_.insert(std::make_pair(ch, match));
   return *match;
 }
 
+const std::shared_ptr<minikin::FontFamily>&
+FontCollection::MatchIndexedFallbackFont(uint32_t ch,
+                                         const std::string& locale) {
+  auto range = fallback_font_index_.upper_bound(ch);
+  if (range == fallback_font_index_.begin())
+    return g_null_family;
+  --range;
+  if (ch > range->second.end)
+    return g_null_family;
+
+  const std::string& family_name = range->second.family_name;
+  for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
+    const std::shared_ptr<minikin::FontFamily>& family =
+        GetFallbackFontFamily(manager, family_name);
+    if (family) {
+      AddFallbackFontForLocale(family_name, locale);
+      return family;
+    }
+  }
+  return g_null_family;
+}
+
+void FontCollection::AddFallbackFontForLocale(const std::string& family_name,
+                                              const std::string& locale) {
+  std::vector<std::string>& families = fallback_fonts_for_locale_[locale];
+  if (std::find(families.begin(), families.end(), family_name) ==
+      families.end())
+    families.push_back(family_name);
+}
+
+std::string FontCollection::SerializeFallbackFontIndex() {
+  std::scoped_lock lock(cache_mutex_);
+  std::unordered_map<const std::shared_ptr<minikin::FontFamily>*, std::string>
+      family_names;
+  for (const auto& [family_name, family] : fallback_fonts_)
+    family_names[&family] = family_name;
+
+  // The matched characters are merged into the loaded ranges, and the
+  // adjacent characters of the same family are merged into one range.
+  std::map<uint32_t, FallbackFontRange> index = fallback_font_index_;
+  for (const auto& [ch, family] : fallback_match_cache_) {
+    auto family_name = family_names.find(family);
+    if (family_name != family_names.end())
+      index[ch] = {ch, family_name->second};
+  }
+
+  std::ostringstream stream;
+  stream << kFallbackFontIndexHeader << '\n';
+  auto range = index.begin();
+  while (range != index.end()) {
+    uint32_t start = range->first;
+    FallbackFontRange merged = range->second;
+    for (++range; range != index.end() && range->first <= merged.end + 1 &&
+                  range->second.family_name == merged.family_name;
+         ++range) {
+      merged.end = std::max(merged.end, range->second.end);
+    }
+    stream << start << ' ' << merged.end << ' ' << merged.family_name << '\n';
+  }
+  has_new_fallback_fonts_ = false;
+  return stream.str();
+}
+
+bool FontCollection::LoadFallbackFontIndex(const std::string& index) {
+  std::istringstream stream(index);
+  std::string line;
+  if (!std::getline(stream, line) || line != kFallbackFontIndexHeader)
+    return false;
+
+  std::map<uint32_t, FallbackFontRange> ranges;
+  while (std::getline(stream, line)) {
+    std::istringstream line_stream(line);
+    uint32_t start;
+    FallbackFontRange range;
+    if (!(line_stream >> start >> range.end) || line_stream.get() != ' ' ||
+        !std::getline(line_stream, range.family_name) || start > range.end ||
+        range.family_name.empty())
+      return false;
+    ranges[start] = std::move(range);
+  }
+
+  std::scoped_lock lock(cache_mutex_);
+  fallback_font_index_ = std::move(ranges);
+  return true;
+}
+
+bool FontCollection::HasNewFallbackFonts() {
+  std::scoped_lock lock(cache_mutex_);
+  return has_new_fallback_fonts_;
+}
+
 const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     uint32_t ch,
     std::string locale) {
@@ -346,12 +466,7 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     SkString sk_family_name;
     typeface->getFamilyName(&sk_family_name);
     std::string family_name(sk_family_name.c_str());
-
-    if (std::find(fallback_fonts_for_locale_[locale].begin(),
-                  fallback_fonts_for_locale_[locale].end(),
-                  family_name) == fallback_fonts_for_locale_[locale].end())
-      fallback_fonts_for_locale_[locale].push_back(family_name);
-
+    AddFallbackFontForLocale(family_name, locale);
     return GetFallbackFontFamily(manager, family_name);
   }
   return g_null_family;
@@ -382,7 +497,11 @@ FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
 }
 
 void FontCollection::ClearFontFamilyCache() {
-  font_collections_cache_.clear();
+  {
+    std::scoped_lock lock(cache_mutex_);
+    font_collections_cache_.clear();
+  }
+  paragraph_cache_.Clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   if (skt_collection_) {
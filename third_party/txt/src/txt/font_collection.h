@@ -17,7 +17,9 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -29,6 +31,7 @@
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "txt/asset_font_manager.h"
+#include "txt/paragraph_cache.h"
 #include "txt/text_style.h"
 
 #if FLUTTER_ENABLE_SKSHAPER
@@ -65,9 +68,32 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // missing from the requested font family.
   void DisableFontFallback();
 
-  // Remove all entries in the font family cache.
+  // Serializes the ranges of characters that MatchFallbackFont has matched to
+  // fallback font families, so that a later launch can load them with
+  // LoadFallbackFontIndex instead of searching the fonts of the system again.
+  std::string SerializeFallbackFontIndex();
+
+  // Loads an index of SerializeFallbackFontIndex. The characters of the index
+  // are matched to their font family by name, and are searched for again if
+  // the family is no longer available. Returns false if the index is invalid.
+  bool LoadFallbackFontIndex(const std::string& index);
+
+  // Whether MatchFallbackFont has matched characters that are not in the index
+  // since it was last serialized.
+  bool HasNewFallbackFonts();
+
+  // Matches the typeface of the family that is closest to the style, or
+  // returns null if no font manager has the family.
+  sk_sp<SkTypeface> MatchTypeface(const std::string& family_name,
+                                  const SkFontStyle& style) const;
+
+  // Remove all entries in the font family cache, and the cached layouts of
+  // the paragraphs.
   void ClearFontFamilyCache();
 
+  // The layouts of the paragraphs that were laid out with this collection.
+  ParagraphCache& GetParagraphCache() { return paragraph_cache_; }
+
 #if FLUTTER_ENABLE_SKSHAPER
 
   // Construct a Skia text layout FontCollection based on this collection.
@@ -94,6 +120,11 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
+  // Guards the caches below, which are looked up by the paragraphs that are
+  // laid out on several threads at once. Minikin only calls back into the
+  // collection with gMinikinLock held, so this is never held while taking
+  // gMinikinLock, except in MatchFallbackFont.
+  std::mutex cache_mutex_;
   std::unordered_map<FamilyKey,
                      std::shared_ptr<minikin::FontCollection>,
                      FamilyKey::Hasher>
@@ -106,7 +137,16 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       fallback_fonts_;
   std::unordered_map<std::string, std::vector<std::string>>
       fallback_fonts_for_locale_;
+  // The font families of the ranges of characters of a loaded fallback font
+  // index, keyed by the first character of the range.
+  struct FallbackFontRange {
+    uint32_t end;
+    std::string family_name;
+  };
+  std::map<uint32_t, FallbackFontRange> fallback_font_index_;
+  bool has_new_fallback_fonts_ = false;
   bool enable_font_fallback_;
+  ParagraphCache paragraph_cache_;
 
 #if FLUTTER_ENABLE_SKSHAPER
   // An equivalent font collection usable by the Skia text shaper library.
@@ -119,6 +159,15 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       uint32_t ch,
       std::string locale);
 
+  // Finds the font family of ch in the fallback font index, if there is one.
+  const std::shared_ptr<minikin::FontFamily>& MatchIndexedFallbackFont(
+      uint32_t ch,
+      const std::string& locale);
+
+  // Adds a fallback font family to the fallback fonts of the locale.
+  void AddFallbackFontForLocale(const std::string& family_name,
+                                const std::string& locale);
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
   std::shared_ptr<minikin::FontFamily> FindFontFamilyInManagers(
@@ -18,6 +18,9 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_H_
 #define LIB_TXT_SRC_PARAGRAPH_H_
 
+#include <string>
+#include <vector>
+
 #include "line_metrics.h"
 #include "paragraph_style.h"
 
@@ -83,6 +86,35 @@ class Paragraph {
     TextBox(SkRect r, TextDirection d) : rect(r), direction(d) {}
   };
 
+  // The code units and horizontal extent of a glyph, or of a cluster of glyphs
+  // that can't be split, that has been laid out.
+  struct GlyphInfo {
+    size_t start;
+    size_t end;
+    double left;
+    double right;
+  };
+
+  // A run of glyphs with the same style and direction on a line.
+  struct GlyphRunInfo {
+    size_t line_number;
+    TextDirection direction;
+    size_t start;
+    size_t end;
+    SkRect bounds;
+    // The glyphs of the run are the glyphs of GlyphLayout::glyphs from
+    // glyph_start to glyph_end, sorted by code unit index.
+    size_t glyph_start;
+    size_t glyph_end;
+  };
+
+  // The positions of all of the glyphs of a laid out paragraph, sorted by code
+  // unit index.
+  struct GlyphLayout {
+    std::vector<GlyphRunInfo> runs;
+    std::vector<GlyphInfo> glyphs;
+  };
+
   template <typename T>
   struct Range {
     Range() : start(), end() {}
@@ -175,6 +207,22 @@ class Paragraph {
   virtual Range<size_t> GetWordBoundary(size_t offset) = 0;
 
   virtual std::vector<LineMetrics>& GetLineMetrics() = 0;
+
+  // Returns the runs and glyph positions of the whole paragraph at once, for
+  // the callers that would otherwise query the boxes of each glyph one by one.
+  // Coordinates have the top left corner of the paragraph as the origin.
+  virtual GlyphLayout GetGlyphLayout() { return GlyphLayout(); }
+
+  // Replaces the text between the start and end indexes with the given text,
+  // which takes the style of the text before it. The paragraph has to be laid
+  // out again, which only breaks the lines of the edited text again. Returns
+  // false if the paragraph can't be edited, in which case it is unchanged and
+  // has to be built again with the new text.
+  virtual bool ReplaceText(size_t start,
+                           size_t end,
+                           const std::u16string& text) {
+    return false;
+  }
 };
 
 }  // namespace txt
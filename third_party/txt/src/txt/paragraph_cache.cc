@@ -0,0 +1,90 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paragraph_cache.h"
+
+#include "flutter/fml/trace_event.h"
+#include "paragraph_txt.h"
+
+namespace txt {
+
+ParagraphCache::ParagraphCache() = default;
+
+ParagraphCache::~ParagraphCache() = default;
+
+bool ParagraphCache::FindLayout(ParagraphTxt& paragraph) {
+  const size_t hash = paragraph.GetContentHash();
+  std::shared_ptr<const ParagraphTxt> cached;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = index_.find(hash);
+    if (found == index_.end())
+      return false;
+    entries_.splice(entries_.begin(), entries_, found->second);
+    cached = found->second->paragraph;
+  }
+  // The layout is copied outside of the lock, as the cached paragraph is never
+  // changed.
+  if (!cached || !paragraph.HasSameContent(*cached))
+    return false;
+  TRACE_EVENT0("flutter", "ParagraphCache::FindLayout");
+  paragraph.CopyLayout(*cached);
+  return true;
+}
+
+void ParagraphCache::StoreLayout(const ParagraphTxt& paragraph) {
+  const size_t hash = paragraph.GetContentHash();
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = index_.find(hash);
+    if (found == index_.end()) {
+      entries_.push_front(Entry{hash, nullptr});
+      index_[hash] = entries_.begin();
+      TrimLocked();
+      return;
+    }
+    // Either the same content or one with the same hash is already cached.
+    if (found->second->paragraph)
+      return;
+  }
+
+  std::shared_ptr<const ParagraphTxt> copy = paragraph.CopyForCache();
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(hash);
+  if (found != index_.end() && !found->second->paragraph)
+    found->second->paragraph = std::move(copy);
+}
+
+void ParagraphCache::SetMaxEntries(size_t max_entries) {
+  std::scoped_lock lock(mutex_);
+  max_entries_ = max_entries;
+  TrimLocked();
+}
+
+void ParagraphCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+}
+
+void ParagraphCache::TrimLocked() {
+  while (entries_.size() > max_entries_) {
+    index_.erase(entries_.back().hash);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace txt
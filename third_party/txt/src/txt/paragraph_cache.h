@@ -0,0 +1,77 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+
+namespace txt {
+
+class ParagraphTxt;
+
+// Keeps the layouts of the paragraphs that were recently laid out, keyed by
+// their text, styles and width, so that a paragraph that is built again with
+// the same content, such as on every frame of an animation, is laid out by
+// copying the cached layout instead of shaping its text again.
+//
+// A content is only copied into the cache when it is laid out for the second
+// time, so that the paragraphs that are laid out once don't pay for the copy.
+class ParagraphCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 256;
+
+  ParagraphCache();
+
+  ~ParagraphCache();
+
+  // Copies the cached layout of a paragraph with the same content at the same
+  // width into the paragraph. Returns false if there is none.
+  bool FindLayout(ParagraphTxt& paragraph);
+
+  // Caches the layout of a paragraph that has just been laid out.
+  void StoreLayout(const ParagraphTxt& paragraph);
+
+  void SetMaxEntries(size_t max_entries);
+
+  void Clear();
+
+ private:
+  struct Entry {
+    size_t hash;
+    // Null until the content is laid out a second time.
+    std::shared_ptr<const ParagraphTxt> paragraph;
+  };
+
+  void TrimLocked();
+
+  std::mutex mutex_;
+  size_t max_entries_ = kDefaultMaxEntries;
+  // The most recently used entries first.
+  std::list<Entry> entries_;
+  std::unordered_map<size_t, std::list<Entry>::iterator> index_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_CACHE_H_
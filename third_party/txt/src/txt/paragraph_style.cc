@@ -54,4 +54,26 @@ TextAlign ParagraphStyle::effective_align() const {
   }
 }
 
+bool ParagraphStyle::equals(const ParagraphStyle& other) const {
+  return font_weight == other.font_weight && font_style == other.font_style &&
+         font_family == other.font_family && font_size == other.font_size &&
+         height == other.height &&
+         has_height_override == other.has_height_override &&
+         text_height_behavior == other.text_height_behavior &&
+         strut_enabled == other.strut_enabled &&
+         strut_font_weight == other.strut_font_weight &&
+         strut_font_style == other.strut_font_style &&
+         strut_font_families == other.strut_font_families &&
+         strut_font_size == other.strut_font_size &&
+         strut_height == other.strut_height &&
+         strut_has_height_override == other.strut_has_height_override &&
+         strut_half_leading == other.strut_half_leading &&
+         strut_leading == other.strut_leading &&
+         force_strut_height == other.force_strut_height &&
+         text_align == other.text_align &&
+         text_direction == other.text_direction &&
+         max_lines == other.max_lines && ellipsis == other.ellipsis &&
+         locale == other.locale && break_strategy == other.break_strategy;
+}
+
 }  // namespace txt
@@ -110,6 +110,8 @@ class ParagraphStyle {
 
   // Return a text alignment value that is not dependent on the text direction.
   TextAlign effective_align() const;
+
+  bool equals(const ParagraphStyle& other) const;
 };
 
 }  // namespace txt
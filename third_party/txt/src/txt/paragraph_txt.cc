@@ -23,10 +23,13 @@
 #include <cstring>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <numeric>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "font_collection.h"
 #include "font_skia.h"
@@ -36,6 +39,7 @@
 #include "minikin/LayoutUtils.h"
 #include "minikin/LineBreaker.h"
 #include "minikin/MinikinFont.h"
+#include "minikin/MinikinInternal.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkFontMetrics.h"
@@ -246,15 +250,64 @@ void ParagraphTxt::SetInlinePlaceholders(
     std::vector<PlaceholderRun> inline_placeholders,
     std::unordered_set<size_t> obj_replacement_char_indexes) {
   needs_layout_ = true;
+  block_line_breaks_.clear();
   inline_placeholders_ = std::move(inline_placeholders);
   obj_replacement_char_indexes_ = std::move(obj_replacement_char_indexes);
 }
 
+bool ParagraphTxt::ReplaceText(size_t start,
+                               size_t end,
+                               const std::u16string& text) {
+  // The indexes of the placeholders would have to be moved as well.
+  if (start > end || end > text_.size() || runs_.size() == 0 ||
+      !inline_placeholders_.empty() || !obj_replacement_char_indexes_.empty())
+    return false;
+
+  text_.erase(text_.begin() + start, text_.begin() + end);
+  text_.insert(text_.begin() + start, text.begin(), text.end());
+  runs_.ReplaceRange(start, end, text.size());
+  needs_layout_ = true;
+
+  // The blocks between hard breaks that the edit doesn't touch keep their line
+  // breaks, which are moved after the edit.
+  auto move_index = [&](size_t index) {
+    return index - end + start + text.size();
+  };
+  std::vector<BlockLineBreaks> kept_blocks;
+  for (BlockLineBreaks& block : block_line_breaks_) {
+    if (block.end < start) {
+      kept_blocks.push_back(std::move(block));
+    } else if (block.start > end) {
+      block.start = move_index(block.start);
+      block.end = move_index(block.end);
+      for (LineMetrics& line : block.lines) {
+        line.start_index = move_index(line.start_index);
+        line.end_index = move_index(line.end_index);
+        line.end_excluding_whitespace =
+            move_index(line.end_excluding_whitespace);
+        line.end_including_newline = move_index(line.end_including_newline);
+      }
+      kept_blocks.push_back(std::move(block));
+    }
+  }
+  block_line_breaks_ = std::move(kept_blocks);
+  return true;
+}
+
 bool ParagraphTxt::ComputeLineBreaks() {
   line_metrics_.clear();
   line_widths_.clear();
   max_intrinsic_width_ = 0;
 
+  // The line breaks of the blocks are only kept for the width they were
+  // computed at.
+  std::vector<BlockLineBreaks> kept_blocks;
+  if (block_line_breaks_width_ == width_)
+    kept_blocks = std::move(block_line_breaks_);
+  block_line_breaks_.clear();
+  block_line_breaks_width_ = width_;
+  auto kept_block = kept_blocks.begin();
+
   std::vector<size_t> newline_positions;
   // Discover and add all hard breaks.
   for (size_t i = 0; i < text_.size(); ++i) {
@@ -283,6 +336,20 @@ bool ParagraphTxt::ComputeLineBreaks() {
       continue;
     }
 
+    while (kept_block != kept_blocks.end() && kept_block->start < block_start)
+      ++kept_block;
+    if (kept_block != kept_blocks.end() && kept_block->start == block_start &&
+        kept_block->end == block_end) {
+      line_metrics_.insert(line_metrics_.end(), kept_block->lines.begin(),
+                           kept_block->lines.end());
+      line_widths_.insert(line_widths_.end(), kept_block->line_widths.begin(),
+                          kept_block->line_widths.end());
+      max_intrinsic_width_ =
+          std::max(max_intrinsic_width_, kept_block->total_width);
+      block_line_breaks_.push_back(std::move(*kept_block));
+      continue;
+    }
+
     // Setup breaker. We wait to set the line width in order to account for the
     // widths of the inline placeholders, which are calculated in the loop over
     // the runs.
@@ -375,6 +442,12 @@ bool ParagraphTxt::ComputeLineBreaks() {
                                  line_end_including_newline, hard_break);
       line_widths_.push_back(breaker_.getWidths()[i]);
     }
+    block_line_breaks_.push_back(
+        {block_start, block_end, block_total_width,
+         std::vector<LineMetrics>(line_metrics_.end() - breaks_count,
+                                  line_metrics_.end()),
+         std::vector<double>(line_widths_.end() - breaks_count,
+                             line_widths_.end())});
 
     breaker_.finish();
   }
@@ -673,7 +746,49 @@ void ParagraphTxt::Layout(double width) {
 
   width_ = rounded_width;
 
+  // Shaping doesn't depend on the width, and the shaped words are still in
+  // the layout cache, so a width that breaks the lines at the same places as
+  // the last layout only costs the line breaking.
+  const bool can_keep_layout = !needs_layout_ && has_complete_layout_ &&
+                               IsLayoutIndependentOfWidth();
+  std::vector<LineMetrics> previous_line_metrics;
+  std::vector<double> previous_line_widths;
+  if (can_keep_layout) {
+    previous_line_metrics = std::move(line_metrics_);
+    previous_line_widths = std::move(line_widths_);
+  }
+
+  // A paragraph that is built again with the same content, such as on every
+  // frame of an animation, copies the layout of the previous one.
+  const bool can_use_cache = CanUseParagraphCache();
+  if (!can_keep_layout && can_use_cache &&
+      font_collection_->GetParagraphCache().FindLayout(*this)) {
+    needs_layout_ = false;
+    has_complete_layout_ = true;
+    return;
+  }
+
   needs_layout_ = false;
+  has_complete_layout_ = false;
+
+  const bool computed_line_breaks = ComputeLineBreaks();
+  if (computed_line_breaks && can_keep_layout &&
+      line_widths_ == previous_line_widths &&
+      std::equal(line_metrics_.begin(), line_metrics_.end(),
+                 previous_line_metrics.begin(), previous_line_metrics.end(),
+                 [](const LineMetrics& a, const LineMetrics& b) {
+                   return a.start_index == b.start_index &&
+                          a.end_index == b.end_index &&
+                          a.end_excluding_whitespace ==
+                              b.end_excluding_whitespace &&
+                          a.end_including_newline == b.end_including_newline &&
+                          a.hard_break == b.hard_break;
+                 })) {
+    // The previous metrics also have the heights and baselines of the lines.
+    line_metrics_ = std::move(previous_line_metrics);
+    has_complete_layout_ = true;
+    return;
+  }
 
   records_.clear();
   glyph_lines_.clear();
@@ -683,7 +798,7 @@ void ParagraphTxt::Layout(double width) {
   min_left_ = std::numeric_limits<double>::max();
   final_line_count_ = 0;
 
-  if (!ComputeLineBreaks())
+  if (!computed_line_breaks)
     return;
 
   std::vector<BidiRun> bidi_runs;
@@ -1187,6 +1302,17 @@ void ParagraphTxt::Layout(double width) {
             });
 
   longest_line_ = max_right_ - min_left_;
+  has_complete_layout_ = true;
+
+  if (can_use_cache)
+    font_collection_->GetParagraphCache().StoreLayout(*this);
+}
+
+bool ParagraphTxt::IsLayoutIndependentOfWidth() const {
+  // Ellipses are added to the lines that overflow the width, and the lines
+  // that are not aligned left are positioned relative to the width.
+  return paragraph_style_.ellipsis.empty() &&
+         paragraph_style_.effective_align() == TextAlign::left;
 }
 
 void ParagraphTxt::UpdateLineMetrics(const SkFontMetrics& metrics,
@@ -1369,6 +1495,7 @@ double ParagraphTxt::GetLongestLine() {
 
 void ParagraphTxt::SetParagraphStyle(const ParagraphStyle& style) {
   needs_layout_ = true;
+  block_line_breaks_.clear();
   paragraph_style_ = style;
 }
 
@@ -1377,12 +1504,96 @@ void ParagraphTxt::SetFontCollection(
   font_collection_ = std::move(font_collection);
 }
 
+bool ParagraphTxt::CanUseParagraphCache() const {
+  return font_collection_ != nullptr && !text_.empty() &&
+         inline_placeholders_.empty() && obj_replacement_char_indexes_.empty();
+}
+
+size_t ParagraphTxt::GetContentHash() const {
+  size_t hash = fml::HashCombine(width_, runs_.size(),
+                                 paragraph_style_.font_size,
+                                 paragraph_style_.max_lines);
+  fml::HashCombineSeed(
+      hash, std::u16string_view(reinterpret_cast<const char16_t*>(text_.data()),
+                                text_.size()));
+  return hash;
+}
+
+bool ParagraphTxt::HasSameContent(const ParagraphTxt& other) const {
+  return width_ == other.width_ && text_ == other.text_ &&
+         paragraph_style_.equals(other.paragraph_style_) &&
+         runs_.IsIdenticalTo(other.runs_) && inline_placeholders_.empty() &&
+         other.inline_placeholders_.empty();
+}
+
+void ParagraphTxt::CopyLayout(const ParagraphTxt& other) {
+  // The layout points to the styles of the other paragraph, which are at the
+  // same indexes in this one.
+  auto style = [&](const TextStyle* other_style) {
+    return &runs_.GetStyle(other_style - &other.runs_.GetStyle(0));
+  };
+
+  width_ = other.width_;
+  line_metrics_ = other.line_metrics_;
+  for (LineMetrics& line : line_metrics_) {
+    for (auto& [index, run_metrics] : line.run_metrics)
+      run_metrics.text_style = style(run_metrics.text_style);
+  }
+  final_line_count_ = other.final_line_count_;
+  line_widths_ = other.line_widths_;
+  block_line_breaks_ = other.block_line_breaks_;
+  block_line_breaks_width_ = other.block_line_breaks_width_;
+
+  // The text blobs are immutable, so they are shared with the other paragraph.
+  records_.clear();
+  records_.reserve(other.records_.size());
+  for (const PaintRecord& record : other.records_) {
+    records_.emplace_back(record.style(), record.offset(),
+                          sk_ref_sp(record.text()), record.metrics(),
+                          record.line(), record.x_start(), record.x_end(),
+                          record.isGhost());
+  }
+
+  did_exceed_max_lines_ = other.did_exceed_max_lines_;
+  strut_ = other.strut_;
+  max_right_ = other.max_right_;
+  min_left_ = other.min_left_;
+
+  glyph_lines_.clear();
+  glyph_lines_.reserve(other.glyph_lines_.size());
+  for (const GlyphLine& glyph_line : other.glyph_lines_)
+    glyph_lines_.push_back(glyph_line);
+  code_unit_runs_ = other.code_unit_runs_;
+  for (CodeUnitRun& code_unit_run : code_unit_runs_)
+    code_unit_run.style = style(code_unit_run.style);
+  inline_placeholder_code_unit_runs_.clear();
+
+  longest_line_ = other.longest_line_;
+  max_intrinsic_width_ = other.max_intrinsic_width_;
+  min_intrinsic_width_ = other.min_intrinsic_width_;
+  alphabetic_baseline_ = other.alphabetic_baseline_;
+  ideographic_baseline_ = other.ideographic_baseline_;
+}
+
+std::shared_ptr<const ParagraphTxt> ParagraphTxt::CopyForCache() const {
+  auto copy = std::make_shared<ParagraphTxt>();
+  copy->text_ = text_;
+  copy->runs_ = StyledRuns(runs_);
+  copy->paragraph_style_ = paragraph_style_;
+  copy->CopyLayout(*this);
+  copy->needs_layout_ = false;
+  copy->has_complete_layout_ = true;
+  return copy;
+}
+
 std::shared_ptr<minikin::FontCollection>
 ParagraphTxt::GetMinikinFontCollectionForStyle(const TextStyle& style) {
   std::string locale;
   if (!style.locale.empty()) {
     uint32_t language_list_id =
         minikin::FontStyle::registerLanguageList(style.locale);
+    // The cache may be growing for a paragraph laid out on another thread.
+    std::scoped_lock lock(minikin::gMinikinLock);
     const minikin::FontLanguages& langs =
         minikin::FontLanguageListCache::getById(language_list_id);
     if (langs.size()) {
@@ -2016,6 +2227,8 @@ bool ParagraphTxt::DidExceedMaxLines() {
 
 void ParagraphTxt::SetDirty(bool dirty) {
   needs_layout_ = dirty;
+  if (dirty)
+    block_line_breaks_.clear();
 }
 
 std::vector<LineMetrics>& ParagraphTxt::GetLineMetrics() {
@@ -2023,4 +2236,42 @@ std::vector<LineMetrics>& ParagraphTxt::GetLineMetrics() {
   return line_metrics_;
 }
 
+Paragraph::GlyphLayout ParagraphTxt::GetGlyphLayout() {
+  FML_DCHECK(!needs_layout_) << "only valid after layout";
+  GlyphLayout layout;
+  size_t glyph_count = 0;
+  for (const CodeUnitRun& run : code_unit_runs_)
+    glyph_count += run.positions.size();
+  layout.runs.reserve(code_unit_runs_.size());
+  layout.glyphs.reserve(glyph_count);
+
+  for (const CodeUnitRun& run : code_unit_runs_) {
+    // The same vertical extent as the tight boxes of GetRectsForRange.
+    double baseline = line_metrics_[run.line_number].baseline;
+    SkScalar top = baseline + run.font_metrics.fAscent;
+    SkScalar bottom = baseline + run.font_metrics.fDescent;
+    if (run.placeholder_run != nullptr) {
+      top = baseline - run.placeholder_run->baseline_offset;
+      bottom = baseline + run.placeholder_run->height -
+               run.placeholder_run->baseline_offset;
+    }
+
+    GlyphRunInfo run_info;
+    run_info.line_number = run.line_number;
+    run_info.direction = run.direction;
+    run_info.start = run.code_units.start;
+    run_info.end = run.code_units.end;
+    run_info.bounds = SkRect::MakeLTRB(run.x_pos.start, top, run.x_pos.end,
+                                       bottom);
+    run_info.glyph_start = layout.glyphs.size();
+    for (const GlyphPosition& gp : run.positions) {
+      layout.glyphs.push_back({gp.code_units.start, gp.code_units.end,
+                               gp.x_pos.start, gp.x_pos.end});
+    }
+    run_info.glyph_end = layout.glyphs.size();
+    layout.runs.push_back(run_info);
+  }
+  return layout;
+}
+
 }  // namespace txt
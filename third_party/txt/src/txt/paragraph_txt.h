@@ -121,6 +121,12 @@ class ParagraphTxt : public Paragraph {
   // line in the final layout.
   std::vector<LineMetrics>& GetLineMetrics() override;
 
+  GlyphLayout GetGlyphLayout() override;
+
+  bool ReplaceText(size_t start,
+                   size_t end,
+                   const std::u16string& text) override;
+
   // Sets the needs_layout_ to dirty. When Layout() is called, a new Layout will
   // be performed when this is set to true. Can also be used to prevent a new
   // Layout from being calculated by setting to false.
@@ -128,8 +134,13 @@ class ParagraphTxt : public Paragraph {
 
  private:
   friend class ParagraphBuilderTxt;
+  friend class ParagraphCache;
   FRIEND_TEST(ParagraphTest, SimpleParagraph);
   FRIEND_TEST(ParagraphTest, SimpleParagraphSmall);
+  FRIEND_TEST(ParagraphTest, RelayoutKeepsTheLayoutOfTheSameLineBreaks);
+  FRIEND_TEST(ParagraphTest, ReplaceTextBreaksTheEditedBlock);
+  FRIEND_TEST(ParagraphTest, RebuiltParagraphCopiesTheCachedLayout);
+  FRIEND_TEST(ParagraphTest, GlyphLayoutMatchesTheRectsForRange);
   FRIEND_TEST(ParagraphTest, SimpleRedParagraph);
   FRIEND_TEST(ParagraphTest, RainbowParagraph);
   FRIEND_TEST(ParagraphTest, DefaultStyleParagraph);
@@ -190,6 +201,18 @@ class ParagraphTxt : public Paragraph {
   size_t final_line_count_;
   std::vector<double> line_widths_;
 
+  // The line breaks of a block of text between hard breaks, which are kept for
+  // the blocks that ReplaceText doesn't change.
+  struct BlockLineBreaks {
+    size_t start;
+    size_t end;
+    double total_width;
+    std::vector<LineMetrics> lines;
+    std::vector<double> line_widths;
+  };
+  std::vector<BlockLineBreaks> block_line_breaks_;
+  double block_line_breaks_width_ = -1;
+
   // Stores the result of Layout().
   std::vector<PaintRecord> records_;
 
@@ -319,6 +342,9 @@ class ParagraphTxt : public Paragraph {
   double ideographic_baseline_ = std::numeric_limits<double>::max();
 
   bool needs_layout_ = true;
+  // Whether the last layout completed, so that its results can be kept when
+  // the paragraph is laid out again at a width that doesn't change them.
+  bool has_complete_layout_ = false;
 
   struct WaveCoordinates {
     double x_start;
@@ -338,6 +364,22 @@ class ParagraphTxt : public Paragraph {
 
   void SetFontCollection(std::shared_ptr<FontCollection> font_collection);
 
+  // Whether the layout can be copied from and into the ParagraphCache, which
+  // doesn't handle the pointers of the layout into the placeholders.
+  bool CanUseParagraphCache() const;
+
+  // Hashes the text, styles and width that the layout depends on.
+  size_t GetContentHash() const;
+
+  bool HasSameContent(const ParagraphTxt& other) const;
+
+  // Copies the layout of a paragraph with the same content.
+  void CopyLayout(const ParagraphTxt& other);
+
+  // Copies the content and layout into a paragraph for the ParagraphCache,
+  // which doesn't have a font collection.
+  std::shared_ptr<const ParagraphTxt> CopyForCache() const;
+
   void SetInlinePlaceholders(
       std::vector<PlaceholderRun> inline_placeholders,
       std::unordered_set<size_t> obj_replacement_char_indexes);
@@ -345,6 +387,9 @@ class ParagraphTxt : public Paragraph {
   // Break the text into lines.
   bool ComputeLineBreaks();
 
+  // Whether the layout only depends on the width through the line breaks.
+  bool IsLayoutIndependentOfWidth() const;
+
   // Break the text into runs based on LTR/RTL text direction.
   bool ComputeBidiRuns(std::vector<BidiRun>* result);
 
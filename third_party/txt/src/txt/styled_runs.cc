@@ -16,6 +16,8 @@
 
 #include "styled_runs.h"
 
+#include <algorithm>
+
 #include "flutter/fml/logging.h"
 #include "utils/WindowsUtils.h"
 
@@ -25,6 +27,8 @@ StyledRuns::StyledRuns() = default;
 
 StyledRuns::~StyledRuns() = default;
 
+StyledRuns::StyledRuns(const StyledRuns& other) = default;
+
 StyledRuns::StyledRuns(StyledRuns&& other) {
   styles_.swap(other.styles_);
   runs_.swap(other.runs_);
@@ -73,4 +77,72 @@ StyledRuns::Run StyledRuns::GetRun(size_t index) const {
   return Run{styles_[run.style_index], run.start, run.end};
 }
 
+void StyledRuns::ReplaceRange(size_t start, size_t end, size_t length) {
+  if (runs_.empty())
+    return;
+
+  // The text at the start of the paragraph takes the style of the text after
+  // it instead.
+  const size_t position = start > 0 ? start - 1 : 0;
+  size_t inserted_style_index = runs_.front().style_index;
+  for (const IndexedRun& run : runs_) {
+    if (run.start <= position && position < run.end) {
+      inserted_style_index = run.style_index;
+      break;
+    }
+  }
+
+  std::vector<IndexedRun> runs;
+  runs.reserve(runs_.size() + 1);
+  auto add_run = [&runs](size_t style_index, size_t start, size_t end) {
+    if (start == end)
+      return;
+    if (!runs.empty() && runs.back().style_index == style_index &&
+        runs.back().end == start) {
+      runs.back().end = end;
+    } else {
+      runs.emplace_back(style_index, start, end);
+    }
+  };
+  for (const IndexedRun& run : runs_) {
+    if (run.start < start)
+      add_run(run.style_index, run.start, std::min(run.end, start));
+  }
+  add_run(inserted_style_index, start, start + length);
+  for (const IndexedRun& run : runs_) {
+    if (run.end > end) {
+      add_run(run.style_index, std::max(run.start, end) - end + start + length,
+              run.end - end + start + length);
+    }
+  }
+  runs_ = std::move(runs);
+}
+
+static bool AreStylesIdentical(const TextStyle& a, const TextStyle& b) {
+  return a.equals(b) && a.font_size == b.font_size &&
+         a.text_baseline == b.text_baseline &&
+         a.has_background == b.has_background &&
+         a.background == b.background &&
+         a.has_foreground == b.has_foreground &&
+         a.font_features.GetFontFeatures() ==
+             b.font_features.GetFontFeatures();
+}
+
+bool StyledRuns::IsIdenticalTo(const StyledRuns& other) const {
+  if (runs_.size() != other.runs_.size() ||
+      styles_.size() != other.styles_.size())
+    return false;
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    if (runs_[i].style_index != other.runs_[i].style_index ||
+        runs_[i].start != other.runs_[i].start ||
+        runs_[i].end != other.runs_[i].end)
+      return false;
+  }
+  for (size_t i = 0; i < styles_.size(); ++i) {
+    if (!AreStylesIdentical(styles_[i], other.styles_[i]))
+      return false;
+  }
+  return true;
+}
+
 }  // namespace txt
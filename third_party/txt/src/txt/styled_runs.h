@@ -40,7 +40,7 @@ class StyledRuns {
 
   ~StyledRuns();
 
-  StyledRuns(const StyledRuns& other) = delete;
+  StyledRuns(const StyledRuns& other);
 
   StyledRuns(StyledRuns&& other);
 
@@ -60,6 +60,15 @@ class StyledRuns {
 
   Run GetRun(size_t index) const;
 
+  // Updates the runs for the replacement of the text between start and end
+  // with `length` code units, which take the style of the text before them.
+  void ReplaceRange(size_t start, size_t end, size_t length);
+
+  // Whether the runs have the same ranges and styles, including the properties
+  // of the styles that TextStyle::equals doesn't compare, so that the text of
+  // both is laid out and painted the same.
+  bool IsIdenticalTo(const StyledRuns& other) const;
+
  private:
   FRIEND_TEST(ParagraphTest, SimpleParagraph);
   FRIEND_TEST(ParagraphTest, SimpleParagraphSmall);
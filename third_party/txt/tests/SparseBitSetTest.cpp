@@ -51,4 +51,22 @@ TEST(SparseBitSetTest, randomTest) {
   }
 }
 
+TEST(SparseBitSetTest, bmpSpan) {
+  const uint32_t ranges[] = {'a', 'z' + 1, 0x4E00, 0x4E10};
+  SparseBitSet bitset(ranges, 2);
+
+  const uint16_t latin[] = {'h', 'e', 'l', 'l', 'o', '?', 'a'};
+  EXPECT_EQ(bitset.getBmpSpan(latin, 7), 5u);
+  EXPECT_EQ(bitset.getBmpSpan(latin, 3), 3u);
+
+  const uint16_t cjk[] = {'a', 0x4E00, 0x4E0F, 0x4E10};
+  EXPECT_EQ(bitset.getBmpSpan(cjk, 4), 3u);
+
+  // The span stops at the surrogates.
+  const uint16_t emoji[] = {'a', 0xD83D, 0xDE00};
+  EXPECT_EQ(bitset.getBmpSpan(emoji, 3), 1u);
+
+  EXPECT_EQ(SparseBitSet().getBmpSpan(latin, 7), 0u);
+}
+
 }  // namespace minikin
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <thread>
+
 #include "flutter/fml/logging.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/utils/SkCustomTypeface.h"
@@ -138,6 +140,54 @@ TEST(FontCollectionTest, CheckSkTypefacesSorting) {
             SkFontStyle::kExpanded_Width);
 }
 
+TEST(FontCollectionTest, LoadsTheFallbackFontIndex) {
+  std::shared_ptr<FontCollection> collection = GetTestFontCollection();
+  EXPECT_FALSE(collection->LoadFallbackFontIndex("unknown index"));
+  EXPECT_FALSE(collection->LoadFallbackFontIndex(
+      "txt-fallback-font-index 1\n200 100 Roboto\n"));
+  ASSERT_TRUE(collection->LoadFallbackFontIndex(
+      "txt-fallback-font-index 1\n100 200 Roboto\n300 300 Not A Font\n"));
+
+  // The characters of the index don't need a search of the fonts.
+  EXPECT_NE(collection->MatchFallbackFont(150, ""), nullptr);
+  EXPECT_FALSE(collection->HasNewFallbackFonts());
+
+  // The loaded ranges are serialized again with the matched characters.
+  EXPECT_EQ(collection->SerializeFallbackFontIndex(),
+            "txt-fallback-font-index 1\n100 200 Roboto\n300 300 Not A "
+            "Font\n");
+}
+
+TEST(FontCollectionTest, ConcurrentLookupsOfTheSameFamilies) {
+  std::shared_ptr<FontCollection> collection = GetTestFontCollection();
+  collection->ClearFontFamilyCache();
+
+  // The threads that miss the cache all create a collection, and one of them
+  // is kept in the cache. One more thread clears the cache meanwhile.
+  constexpr size_t kThreadCount = 8;
+  std::vector<std::shared_ptr<minikin::FontCollection>> results(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&collection, &results, i]() {
+      results[i] = collection->GetMinikinFontCollectionForFamilies(
+          std::vector<std::string>(1, "Roboto"), "en-US");
+    });
+  }
+  threads.emplace_back([&collection]() { collection->ClearFontFamilyCache(); });
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& result : results) {
+    EXPECT_NE(result, nullptr);
+  }
+  auto cached = collection->GetMinikinFontCollectionForFamilies(
+      std::vector<std::string>(1, "Roboto"), "en-US");
+  EXPECT_EQ(collection->GetMinikinFontCollectionForFamilies(
+                std::vector<std::string>(1, "Roboto"), "en-US"),
+            cached);
+}
+
 #if 0
 
 TEST(FontCollection, HasDefaultRegistrations) {
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/memory/memory_accounting.h"
+#include "minikin/Layout.h"
+#include "render_test.h"
+#include "txt/font_collection.h"
+
+namespace txt {
+
+// The layout cache is internal to minikin, so these tests observe it through
+// the bytes it reports to the memory accounting.
+class LayoutCacheTest : public RenderTest {
+ protected:
+  void SetUp() override {
+    RenderTest::SetUp();
+    minikin::Layout::purgeCaches();
+    collection_ =
+        GetTestFontCollection()->GetMinikinFontCollectionForFamilies(
+            {"Roboto"}, "en-US");
+    ASSERT_TRUE(collection_);
+  }
+
+  void TearDown() override {
+    minikin::Layout::setCacheMaxBytes(
+        minikin::Layout::kDefaultCacheMaxBytes);
+    minikin::Layout::purgeCaches();
+    RenderTest::TearDown();
+  }
+
+  float Measure(const std::u16string& text) const {
+    minikin::MinikinPaint paint;
+    paint.size = 14;
+    return minikin::Layout::measureText(
+        reinterpret_cast<const uint16_t*>(text.data()), 0, text.size(),
+        text.size(), false, minikin::FontStyle(), paint, collection_,
+        nullptr);
+  }
+
+  static int64_t CachedBytes() {
+    return fml::MemoryAccounting::GetBytes(
+        fml::MemoryCategory::kTextLayoutCache);
+  }
+
+  static std::vector<std::u16string> Words(size_t count) {
+    std::vector<std::u16string> words;
+    for (size_t i = 0; i < count; i++) {
+      std::string word = "word" + std::to_string(i);
+      words.emplace_back(word.begin(), word.end());
+    }
+    return words;
+  }
+
+ private:
+  std::shared_ptr<minikin::FontCollection> collection_;
+};
+
+TEST_F(LayoutCacheTest, CachesEachWordOnce) {
+  EXPECT_EQ(CachedBytes(), 0);
+
+  const float hello = Measure(u"hello");
+  const int64_t hello_bytes = CachedBytes();
+  EXPECT_GT(hello_bytes, 0);
+
+  // A hit returns the same layout without adding an entry.
+  EXPECT_EQ(Measure(u"hello"), hello);
+  EXPECT_EQ(CachedBytes(), hello_bytes);
+
+  Measure(u"world");
+  EXPECT_GT(CachedBytes(), hello_bytes);
+
+  minikin::Layout::purgeCaches();
+  EXPECT_EQ(CachedBytes(), 0);
+}
+
+TEST_F(LayoutCacheTest, EvictsWordsOverTheBudget) {
+  constexpr size_t kMaxBytes = 16 * 1024;
+  minikin::Layout::setCacheMaxBytes(kMaxBytes);
+  std::vector<std::u16string> words = Words(500);
+  std::vector<float> widths;
+  for (const std::u16string& word : words) {
+    widths.push_back(Measure(word));
+    EXPECT_LE(CachedBytes(), static_cast<int64_t>(kMaxBytes));
+  }
+  EXPECT_GT(CachedBytes(), 0);
+
+  // Evicted words are laid out again the same way.
+  for (size_t i = 0; i < words.size(); i++) {
+    EXPECT_EQ(Measure(words[i]), widths[i]);
+  }
+
+  // Lowering the budget evicts the words over it right away.
+  minikin::Layout::setCacheMaxBytes(kMaxBytes / 2);
+  EXPECT_LE(CachedBytes(), static_cast<int64_t>(kMaxBytes / 2));
+
+  // A budget of 0 disables the cache.
+  minikin::Layout::setCacheMaxBytes(0);
+  EXPECT_EQ(CachedBytes(), 0);
+  EXPECT_EQ(Measure(words[0]), widths[0]);
+  EXPECT_EQ(CachedBytes(), 0);
+}
+
+TEST_F(LayoutCacheTest, ConcurrentLookupsAcrossShards) {
+  // The words are spread over all of the shards. Their count is prime, so that
+  // every thread below visits all of them.
+  std::vector<std::u16string> words = Words(211);
+  std::vector<float> widths;
+  for (const std::u16string& word : words) {
+    widths.push_back(Measure(word));
+  }
+  const int64_t bytes = CachedBytes();
+  minikin::Layout::purgeCaches();
+
+  // Each thread looks the words up in a different order, so that the threads
+  // miss, shape and insert the same words at the same time.
+  constexpr size_t kThreadCount = 8;
+  std::vector<std::vector<float>> thread_widths(
+      kThreadCount, std::vector<float>(words.size()));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadCount; t++) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < words.size(); i++) {
+        const size_t word = (i * (2 * t + 1) + t) % words.size();
+        thread_widths[t][word] = Measure(words[word]);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < kThreadCount; t++) {
+    EXPECT_EQ(thread_widths[t], widths);
+  }
+  // A word shaped by several threads at once is cached only once.
+  EXPECT_EQ(CachedBytes(), bytes);
+}
+
+}  // namespace txt
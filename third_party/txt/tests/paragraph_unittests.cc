@@ -16,6 +16,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 #include "flutter/fml/logging.h"
 #include "render_test.h"
@@ -118,6 +119,207 @@ TEST_F(ParagraphTest, SimpleParagraphSmall) {
 // line at the end as a result of the line breaking algorithm. This causes
 // the final_line_count_ to be one less than line metrics. This tests that we
 // properly handle this case and do not segfault.
+TEST_F(ParagraphTest, RelayoutKeepsTheLayoutOfTheSameLineBreaks) {
+  const char* text = "Hello World Text Dialog";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_EQ(paragraph->line_metrics_.size(), 1ull);
+  ASSERT_FALSE(paragraph->records_.empty());
+  const SkTextBlob* blob = paragraph->records_[0].text();
+  const double height = paragraph->GetHeight();
+
+  // The text still fits on one line, so the same records are kept.
+  paragraph->Layout(GetTestCanvasWidth() - 10);
+  EXPECT_EQ(paragraph->GetMaxWidth(), GetTestCanvasWidth() - 10);
+  ASSERT_EQ(paragraph->line_metrics_.size(), 1ull);
+  EXPECT_EQ(paragraph->records_[0].text(), blob);
+  EXPECT_EQ(paragraph->GetHeight(), height);
+
+  // The text has to be broken into more lines.
+  paragraph->Layout(paragraph->GetLongestLine() / 2);
+  EXPECT_GT(paragraph->line_metrics_.size(), 1ull);
+  EXPECT_GT(paragraph->GetHeight(), height);
+}
+
+TEST_F(ParagraphTest, ReplaceTextBreaksTheEditedBlock) {
+  txt::ParagraphStyle paragraph_style;
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  auto build_paragraph = [&](const char* text) {
+    auto icu_text = icu::UnicodeString::fromUTF8(text);
+    std::u16string u16_text(icu_text.getBuffer(),
+                            icu_text.getBuffer() + icu_text.length());
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    return BuildParagraph(builder);
+  };
+
+  auto paragraph = build_paragraph("Hello World\nText Dialog\nEnd");
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_EQ(paragraph->line_metrics_.size(), 3ull);
+  ASSERT_EQ(paragraph->block_line_breaks_.size(), 3ull);
+
+  EXPECT_TRUE(paragraph->ReplaceText(12, 16, u"Long Text"));
+  EXPECT_EQ(paragraph->runs_.size(), 1ull);
+  // The blocks before and after the edit keep their line breaks.
+  ASSERT_EQ(paragraph->block_line_breaks_.size(), 2ull);
+  EXPECT_EQ(paragraph->block_line_breaks_[1].start, 29ull);
+  paragraph->Layout(GetTestCanvasWidth());
+
+  auto expected = build_paragraph("Hello World\nLong Text Dialog\nEnd");
+  expected->Layout(GetTestCanvasWidth());
+  EXPECT_EQ(paragraph->text_, expected->text_);
+  ASSERT_EQ(paragraph->line_metrics_.size(), expected->line_metrics_.size());
+  for (size_t i = 0; i < expected->line_metrics_.size(); ++i) {
+    EXPECT_EQ(paragraph->line_metrics_[i].start_index,
+              expected->line_metrics_[i].start_index);
+    EXPECT_EQ(paragraph->line_metrics_[i].end_index,
+              expected->line_metrics_[i].end_index);
+    EXPECT_EQ(paragraph->line_metrics_[i].end_including_newline,
+              expected->line_metrics_[i].end_including_newline);
+    EXPECT_EQ(paragraph->line_widths_[i], expected->line_widths_[i]);
+  }
+  EXPECT_EQ(paragraph->GetMaxIntrinsicWidth(),
+            expected->GetMaxIntrinsicWidth());
+  EXPECT_EQ(paragraph->GetHeight(), expected->GetHeight());
+
+  EXPECT_FALSE(paragraph->ReplaceText(30, 40, u""));
+}
+
+TEST_F(ParagraphTest, LaysOutParagraphsWithLocalesConcurrently) {
+  // Each locale is added to minikin's language list cache while the other
+  // threads look up theirs, which must be done under gMinikinLock.
+  const std::vector<std::string> locales = {"en-US", "fr-FR", "de-DE",
+                                            "ja-JP", "ko-KR", "ru-RU",
+                                            "ar-EG", "zh-Hant"};
+  std::vector<std::unique_ptr<ParagraphTxt>> paragraphs;
+  for (const std::string& locale : locales) {
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.locale = locale;
+    builder.PushStyle(text_style);
+    builder.AddText(u"Hello World Text Dialog");
+    builder.Pop();
+    paragraphs.push_back(BuildParagraph(builder));
+  }
+
+  std::vector<std::thread> threads;
+  for (auto& paragraph : paragraphs) {
+    threads.emplace_back([&paragraph, this]() {
+      paragraph->Layout(GetTestCanvasWidth());
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& paragraph : paragraphs) {
+    EXPECT_EQ(paragraph->line_metrics_.size(), 1ull);
+    EXPECT_GT(paragraph->GetLongestLine(), 0);
+  }
+}
+
+TEST_F(ParagraphTest, RebuiltParagraphCopiesTheCachedLayout) {
+  const char* text = "Hello World Text Dialog";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+  std::shared_ptr<txt::FontCollection> font_collection =
+      GetTestFontCollection();
+  auto build_paragraph = [&] {
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, font_collection);
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.color = SK_ColorBLACK;
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(GetTestCanvasWidth());
+    return paragraph;
+  };
+
+  // The layout is only cached when the content is laid out a second time.
+  auto first = build_paragraph();
+  auto second = build_paragraph();
+  ASSERT_FALSE(first->records_.empty());
+  ASSERT_FALSE(second->records_.empty());
+  EXPECT_NE(first->records_[0].text(), second->records_[0].text());
+
+  auto third = build_paragraph();
+  ASSERT_EQ(third->records_.size(), second->records_.size());
+  EXPECT_EQ(third->records_[0].text(), second->records_[0].text());
+  EXPECT_EQ(third->GetHeight(), second->GetHeight());
+  EXPECT_EQ(third->GetLongestLine(), second->GetLongestLine());
+  ASSERT_EQ(third->line_metrics_.size(), 1ull);
+  EXPECT_EQ(third->line_metrics_[0].run_metrics.begin()->second.text_style,
+            &third->runs_.GetStyle(0));
+  EXPECT_EQ(third->code_unit_runs_[0].style, &third->runs_.GetStyle(0));
+}
+
+TEST_F(ParagraphTest, GlyphLayoutMatchesTheRectsForRange) {
+  const char* text = "Hello World\nText Dialog";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+
+  Paragraph::GlyphLayout layout = paragraph->GetGlyphLayout();
+  ASSERT_EQ(layout.runs.size(), paragraph->code_unit_runs_.size());
+  ASSERT_GE(layout.runs.size(), 2ull);
+  EXPECT_EQ(layout.runs.front().line_number, 0ull);
+  EXPECT_EQ(layout.runs.back().line_number, 1ull);
+  EXPECT_EQ(layout.runs.back().glyph_end, layout.glyphs.size());
+
+  for (const Paragraph::GlyphRunInfo& run : layout.runs) {
+    for (size_t i = run.glyph_start; i < run.glyph_end; ++i) {
+      const Paragraph::GlyphInfo& glyph = layout.glyphs[i];
+      if (glyph.right == glyph.left)
+        continue;
+      std::vector<txt::Paragraph::TextBox> boxes =
+          paragraph->GetRectsForRange(glyph.start, glyph.end,
+                                      Paragraph::RectHeightStyle::kTight,
+                                      Paragraph::RectWidthStyle::kTight);
+      ASSERT_EQ(boxes.size(), 1ull);
+      EXPECT_FLOAT_EQ(boxes[0].rect.left(), glyph.left);
+      EXPECT_FLOAT_EQ(boxes[0].rect.right(), glyph.right);
+      EXPECT_FLOAT_EQ(boxes[0].rect.top(), run.bounds.top());
+      EXPECT_FLOAT_EQ(boxes[0].rect.bottom(), run.bounds.bottom());
+    }
+  }
+}
+
 TEST_F(ParagraphTest, GetGlyphPositionAtCoordinateSegfault) {
   const char* text = "Hello World\nText Dialog";
   auto icu_text = icu::UnicodeString::fromUTF8(text);
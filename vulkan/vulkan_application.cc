@@ -37,7 +37,7 @@ VulkanApplication::VulkanApplication(
   if (enable_instance_debugging) {
     enabled_extensions.emplace_back(VulkanDebugReport::DebugExtensionName());
   }
-#if OS_FUCHSIA
+#if OS_FUCHSIA || OS_ANDROID
   if (ExtensionSupported(supported_extensions,
                          VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME)) {
     // VK_KHR_get_physical_device_properties2 is a dependency of the memory
@@ -106,6 +106,8 @@ VulkanApplication::VulkanApplication(
     return;
   }
 
+  enabled_extensions_ = std::move(enabled_extensions);
+
   instance_ = {instance, [this](VkInstance i) {
                  FML_DLOG(INFO) << "Destroying Vulkan instance";
                  vk.DestroyInstance(i, nullptr);
@@ -139,6 +141,11 @@ const VulkanHandle<VkInstance>& VulkanApplication::GetInstance() const {
   return instance_;
 }
 
+const std::vector<std::string>& VulkanApplication::GetEnabledExtensions()
+    const {
+  return enabled_extensions_;
+}
+
 void VulkanApplication::ReleaseInstanceOwnership() {
   instance_.ReleaseOwnership();
 }
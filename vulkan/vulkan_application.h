@@ -40,6 +40,9 @@ class VulkanApplication {
 
   const VulkanHandle<VkInstance>& GetInstance() const;
 
+  // The extensions the instance was created with.
+  const std::vector<std::string>& GetEnabledExtensions() const;
+
   void ReleaseInstanceOwnership();
 
   std::unique_ptr<VulkanDevice> AcquireFirstCompatibleLogicalDevice() const;
@@ -48,6 +51,7 @@ class VulkanApplication {
   VulkanProcTable& vk;
   VulkanHandle<VkInstance> instance_;
   uint32_t api_version_;
+  std::vector<std::string> enabled_extensions_;
   std::unique_ptr<VulkanDebugReport> debug_report_;
   bool valid_;
   bool enable_validation_layers_;
@@ -4,6 +4,8 @@
 
 #include "vulkan_device.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <vector>
@@ -18,6 +20,21 @@ namespace vulkan {
 constexpr auto kVulkanInvalidGraphicsQueueIndex =
     std::numeric_limits<uint32_t>::max();
 
+#if OS_ANDROID
+// The extensions that import hardware buffers as images, with the ones they
+// depend on that are core in Vulkan 1.1.
+static const char* kHardwareBufferImportExtensions[] = {
+    VK_KHR_MAINTENANCE1_EXTENSION_NAME,
+    VK_KHR_BIND_MEMORY_2_EXTENSION_NAME,
+    VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+    VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,
+    VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
+    VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,
+    VK_EXT_QUEUE_FAMILY_FOREIGN_EXTENSION_NAME,
+    VK_ANDROID_EXTERNAL_MEMORY_ANDROID_HARDWARE_BUFFER_EXTENSION_NAME,
+};
+#endif  // OS_ANDROID
+
 static uint32_t FindGraphicsQueueIndex(
     const std::vector<VkQueueFamilyProperties>& properties) {
   for (uint32_t i = 0, count = static_cast<uint32_t>(properties.size());
@@ -59,7 +76,7 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
       .pQueuePriorities = priorities,
   };
 
-  const char* extensions[] = {
+  std::vector<const char*> extensions = {
 #if OS_ANDROID
     VK_KHR_SWAPCHAIN_EXTENSION_NAME,
 #endif
@@ -73,6 +90,27 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
 #endif
   };
 
+#if OS_ANDROID
+  // Hardware buffers are only imported by the devices that have all of the
+  // extensions, which lets external textures be drawn without copies.
+  const auto supported_extensions = GetSupportedExtensions();
+  const bool supports_hardware_buffer_import = std::all_of(
+      std::begin(kHardwareBufferImportExtensions),
+      std::end(kHardwareBufferImportExtensions), [&](const char* name) {
+        return std::any_of(supported_extensions.begin(),
+                           supported_extensions.end(),
+                           [name](const VkExtensionProperties& properties) {
+                             return strcmp(properties.extensionName, name) ==
+                                    0;
+                           });
+      });
+  if (supports_hardware_buffer_import) {
+    extensions.insert(extensions.end(),
+                      std::begin(kHardwareBufferImportExtensions),
+                      std::end(kHardwareBufferImportExtensions));
+  }
+#endif  // OS_ANDROID
+
   auto enabled_layers =
       DeviceLayersToEnable(vk, physical_device_, enable_validation_layers_);
 
@@ -90,8 +128,8 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
       .pQueueCreateInfos = &queue_create,
       .enabledLayerCount = static_cast<uint32_t>(enabled_layers.size()),
       .ppEnabledLayerNames = layers,
-      .enabledExtensionCount = sizeof(extensions) / sizeof(const char*),
-      .ppEnabledExtensionNames = extensions,
+      .enabledExtensionCount = static_cast<uint32_t>(extensions.size()),
+      .ppEnabledExtensionNames = extensions.data(),
       .pEnabledFeatures = nullptr,
   };
 
@@ -105,6 +143,7 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
 
   device_ = {device,
              [this](VkDevice device) { vk.DestroyDevice(device, nullptr); }};
+  enabled_extensions_.assign(extensions.begin(), extensions.end());
 
   if (!vk.SetupDeviceProcAddresses(device_)) {
     FML_DLOG(INFO) << "Could not set up device proc addresses.";
@@ -122,6 +161,12 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
 
   queue_ = queue;
 
+#if OS_ANDROID
+  supports_hardware_buffer_import_ =
+      supports_hardware_buffer_import &&
+      vk.GetAndroidHardwareBufferPropertiesANDROID;
+#endif  // OS_ANDROID
+
   const VkCommandPoolCreateInfo command_pool_create_info = {
       .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
       .pNext = nullptr,
@@ -181,6 +226,14 @@ uint32_t VulkanDevice::GetGraphicsQueueIndex() const {
   return graphics_queue_index_;
 }
 
+const std::vector<std::string>& VulkanDevice::GetEnabledExtensions() const {
+  return enabled_extensions_;
+}
+
+bool VulkanDevice::SupportsHardwareBufferImport() const {
+  return supports_hardware_buffer_import_;
+}
+
 bool VulkanDevice::GetSurfaceCapabilities(
     const VulkanSurface& surface,
     VkSurfaceCapabilitiesKHR* capabilities) const {
@@ -270,6 +323,25 @@ std::vector<VkQueueFamilyProperties> VulkanDevice::GetQueueFamilyProperties()
   return properties;
 }
 
+std::vector<VkExtensionProperties> VulkanDevice::GetSupportedExtensions()
+    const {
+  uint32_t count = 0;
+  if (VK_CALL_LOG_ERROR(vk.EnumerateDeviceExtensionProperties(
+          physical_device_, nullptr, &count, nullptr)) != VK_SUCCESS) {
+    return {};
+  }
+
+  std::vector<VkExtensionProperties> properties;
+  properties.resize(count, {});
+  if (VK_CALL_LOG_ERROR(vk.EnumerateDeviceExtensionProperties(
+          physical_device_, nullptr, &count, properties.data())) !=
+      VK_SUCCESS) {
+    return {};
+  }
+
+  return properties;
+}
+
 int VulkanDevice::ChooseSurfaceFormat(const VulkanSurface& surface,
                                       std::vector<VkFormat> desired_formats,
                                       VkSurfaceFormatKHR* format) const {
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_VULKAN_VULKAN_DEVICE_H_
 #define FLUTTER_VULKAN_VULKAN_DEVICE_H_
 
+#include <string>
 #include <vector>
 
 #include "flutter/fml/compiler_specific.h"
@@ -36,6 +37,12 @@ class VulkanDevice {
 
   uint32_t GetGraphicsQueueIndex() const;
 
+  // The extensions the device was created with.
+  const std::vector<std::string>& GetEnabledExtensions() const;
+
+  // Whether Android hardware buffers can be imported as images.
+  bool SupportsHardwareBufferImport() const;
+
   void ReleaseDeviceOwnership();
 
   [[nodiscard]] bool GetSurfaceCapabilities(
@@ -71,11 +78,15 @@ class VulkanDevice {
   VulkanHandle<VkQueue> queue_;
   VulkanHandle<VkCommandPool> command_pool_;
   uint32_t graphics_queue_index_;
+  std::vector<std::string> enabled_extensions_;
+  bool supports_hardware_buffer_import_ = false;
   bool valid_;
   bool enable_validation_layers_;
 
   std::vector<VkQueueFamilyProperties> GetQueueFamilyProperties() const;
 
+  std::vector<VkExtensionProperties> GetSupportedExtensions() const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(VulkanDevice);
 };
 
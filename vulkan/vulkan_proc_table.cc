@@ -74,6 +74,7 @@ bool VulkanProcTable::SetupInstanceProcAddresses(
   ACQUIRE_PROC(CreateDevice, handle);
   ACQUIRE_PROC(DestroyDevice, handle);
   ACQUIRE_PROC(DestroyInstance, handle);
+  ACQUIRE_PROC(EnumerateDeviceExtensionProperties, handle);
   ACQUIRE_PROC(EnumerateDeviceLayerProperties, handle);
   ACQUIRE_PROC(EnumeratePhysicalDevices, handle);
   ACQUIRE_PROC(GetDeviceProcAddr, handle);
@@ -135,6 +136,12 @@ bool VulkanProcTable::SetupDeviceProcAddresses(
   ACQUIRE_PROC(DestroySwapchainKHR, handle);
   ACQUIRE_PROC(GetSwapchainImagesKHR, handle);
   ACQUIRE_PROC(QueuePresentKHR, handle);
+  // Only the devices that import hardware buffers have this function, so its
+  // absence is not an error.
+  [this, &handle]() -> bool {
+    ACQUIRE_PROC(GetAndroidHardwareBufferPropertiesANDROID, handle);
+    return true;
+  }();
 #endif  // OS_ANDROID
 #if OS_FUCHSIA
   ACQUIRE_PROC(ImportSemaphoreZirconHandleFUCHSIA, handle);
@@ -88,6 +88,7 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(DestroySwapchainKHR);
   DEFINE_PROC(DeviceWaitIdle);
   DEFINE_PROC(EndCommandBuffer);
+  DEFINE_PROC(EnumerateDeviceExtensionProperties);
   DEFINE_PROC(EnumerateDeviceLayerProperties);
   DEFINE_PROC(EnumerateInstanceExtensionProperties);
   DEFINE_PROC(EnumerateInstanceLayerProperties);
@@ -113,6 +114,7 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(GetSwapchainImagesKHR);
   DEFINE_PROC(QueuePresentKHR);
   DEFINE_PROC(CreateAndroidSurfaceKHR);
+  DEFINE_PROC(GetAndroidHardwareBufferPropertiesANDROID);
 #endif  // OS_ANDROID
 #if OS_FUCHSIA
   DEFINE_PROC(ImportSemaphoreZirconHandleFUCHSIA);
@@ -20,16 +20,19 @@ namespace vulkan {
 
 VulkanWindow::VulkanWindow(fml::RefPtr<VulkanProcTable> proc_table,
                            std::unique_ptr<VulkanNativeSurface> native_surface,
-                           bool render_to_surface)
+                           bool render_to_surface,
+                           const GrContextOptions& context_options)
     : VulkanWindow(/*context/*/ nullptr,
                    proc_table,
                    std::move(native_surface),
-                   render_to_surface) {}
+                   render_to_surface,
+                   context_options) {}
 
 VulkanWindow::VulkanWindow(const sk_sp<GrDirectContext>& context,
                            fml::RefPtr<VulkanProcTable> proc_table,
                            std::unique_ptr<VulkanNativeSurface> native_surface,
-                           bool render_to_surface)
+                           bool render_to_surface,
+                           const GrContextOptions& context_options)
     : valid_(false), vk(std::move(proc_table)), skia_gr_context_(context) {
   if (!vk || !vk->HasAcquiredMandatoryProcAddresses()) {
     FML_DLOG(INFO) << "Proc table has not acquired mandatory proc addresses.";
@@ -70,6 +73,46 @@ VulkanWindow::VulkanWindow(const sk_sp<GrDirectContext>& context,
     return;
   }
 
+  SetUpSurface(std::move(native_surface), render_to_surface, context_options);
+}
+
+VulkanWindow::VulkanWindow(std::shared_ptr<VulkanApplication> application,
+                           std::shared_ptr<VulkanDevice> device,
+                           const sk_sp<GrDirectContext>& context,
+                           fml::RefPtr<VulkanProcTable> proc_table,
+                           std::unique_ptr<VulkanNativeSurface> native_surface,
+                           bool render_to_surface,
+                           const GrContextOptions& context_options)
+    : valid_(false),
+      vk(std::move(proc_table)),
+      application_(std::move(application)),
+      logical_device_(std::move(device)),
+      skia_gr_context_(context) {
+  if (!vk || !vk->IsValid()) {
+    FML_DLOG(INFO) << "Proc table has not set up the device procs.";
+    return;
+  }
+
+  if (!application_ || !application_->IsValid() || !logical_device_ ||
+      !logical_device_->IsValid()) {
+    FML_DLOG(INFO) << "The shared application or device is invalid.";
+    return;
+  }
+
+  if (native_surface == nullptr || !native_surface->IsValid()) {
+    FML_DLOG(INFO) << "Native surface is invalid.";
+    return;
+  }
+
+  SetUpSurface(std::move(native_surface), render_to_surface, context_options);
+}
+
+VulkanWindow::~VulkanWindow() = default;
+
+void VulkanWindow::SetUpSurface(
+    std::unique_ptr<VulkanNativeSurface> native_surface,
+    bool render_to_surface,
+    const GrContextOptions& context_options) {
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
   // external view embedder may want to render to the root surface.
   if (!render_to_surface) {
@@ -87,7 +130,7 @@ VulkanWindow::VulkanWindow(const sk_sp<GrDirectContext>& context,
 
   // Create the Skia GrDirectContext.
 
-  if (!skia_gr_context_ && !CreateSkiaGrContext()) {
+  if (!skia_gr_context_ && !CreateSkiaGrContext(context_options)) {
     FML_DLOG(INFO) << "Could not create Skia context.";
     return;
   }
@@ -102,8 +145,6 @@ VulkanWindow::VulkanWindow(const sk_sp<GrDirectContext>& context,
   valid_ = true;
 }
 
-VulkanWindow::~VulkanWindow() = default;
-
 bool VulkanWindow::IsValid() const {
   return valid_;
 }
@@ -112,15 +153,14 @@ GrDirectContext* VulkanWindow::GetSkiaGrContext() {
   return skia_gr_context_.get();
 }
 
-bool VulkanWindow::CreateSkiaGrContext() {
+bool VulkanWindow::CreateSkiaGrContext(const GrContextOptions& options) {
   GrVkBackendContext backend_context;
+  GrVkExtensions extensions;
 
-  if (!CreateSkiaBackendContext(&backend_context)) {
+  if (!CreateSkiaBackendContext(&backend_context, &extensions)) {
     return false;
   }
 
-  GrContextOptions options;
-  options.fReduceOpsTaskSplitting = GrContextOptions::Enable::kNo;
   sk_sp<GrDirectContext> context =
       GrDirectContext::MakeVulkan(backend_context, options);
 
@@ -135,13 +175,29 @@ bool VulkanWindow::CreateSkiaGrContext() {
   return true;
 }
 
-bool VulkanWindow::CreateSkiaBackendContext(GrVkBackendContext* context) {
+bool VulkanWindow::CreateSkiaBackendContext(GrVkBackendContext* context,
+                                            GrVkExtensions* extensions) {
   auto getProc = vk->CreateSkiaGetProc();
 
   if (getProc == nullptr) {
     return false;
   }
 
+  // Let Skia know of the extensions that were enabled, such as the ones that
+  // import external memory.
+  std::vector<const char*> instance_extensions;
+  for (const auto& extension : application_->GetEnabledExtensions()) {
+    instance_extensions.push_back(extension.c_str());
+  }
+  std::vector<const char*> device_extensions;
+  for (const auto& extension : logical_device_->GetEnabledExtensions()) {
+    device_extensions.push_back(extension.c_str());
+  }
+  extensions->init(getProc, application_->GetInstance(),
+                   logical_device_->GetPhysicalDeviceHandle(),
+                   instance_extensions.size(), instance_extensions.data(),
+                   device_extensions.size(), device_extensions.data());
+
   uint32_t skia_features = 0;
   if (!logical_device_->GetPhysicalDeviceFeaturesSkia(&skia_features)) {
     return false;
@@ -157,6 +213,7 @@ bool VulkanWindow::CreateSkiaBackendContext(GrVkBackendContext* context) {
                          kKHR_swapchain_GrVkExtensionFlag |
                          surface_->GetNativeSurface().GetSkiaExtensionName();
   context->fFeatures = skia_features;
+  context->fVkExtensions = extensions;
   context->fGetProc = std::move(getProc);
   context->fOwnsInstanceAndDevice = false;
   return true;
@@ -236,6 +293,10 @@ bool VulkanWindow::SwapBuffers() {
   return swapchain_->Submit();
 }
 
+size_t VulkanWindow::GetSwapchainGeneration() const {
+  return swapchain_generation_;
+}
+
 bool VulkanWindow::RecreateSwapchain() {
   // This way, we always lose our reference to the old swapchain. Even if we
   // cannot create a new one to replace it.
@@ -266,6 +327,7 @@ bool VulkanWindow::RecreateSwapchain() {
   }
 
   swapchain_ = std::move(swapchain);
+  swapchain_generation_++;
   return true;
 }
 
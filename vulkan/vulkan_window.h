@@ -17,6 +17,7 @@
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkBackendContext.h"
+#include "third_party/skia/include/gpu/vk/GrVkExtensions.h"
 #include "vulkan_proc_table.h"
 
 namespace vulkan {
@@ -33,20 +34,41 @@ class VulkanWindow {
  public:
   //------------------------------------------------------------------------------
   /// @brief      Construct a VulkanWindow. Let it implicitly create a
-  ///             GrDirectContext.
+  ///             GrDirectContext with the given options, whose persistent
+  ///             cache also stores the pipeline cache of the device.
   ///
   VulkanWindow(fml::RefPtr<VulkanProcTable> proc_table,
                std::unique_ptr<VulkanNativeSurface> native_surface,
-               bool render_to_surface);
+               bool render_to_surface,
+               const GrContextOptions& context_options);
 
   //------------------------------------------------------------------------------
   /// @brief      Construct a VulkanWindow. Let reuse an existing
-  ///             GrDirectContext built by another VulkanWindow.
+  ///             GrDirectContext built by another VulkanWindow, or create one
+  ///             with the given options if it is null.
   ///
   VulkanWindow(const sk_sp<GrDirectContext>& context,
                fml::RefPtr<VulkanProcTable> proc_table,
                std::unique_ptr<VulkanNativeSurface> native_surface,
-               bool render_to_surface);
+               bool render_to_surface,
+               const GrContextOptions& context_options);
+
+  //------------------------------------------------------------------------------
+  /// @brief      Construct a VulkanWindow on the instance and device of other
+  ///             windows. Let it reuse the GrDirectContext built on that
+  ///             device, or create one with the given options if it is null.
+  ///
+  ///             Unlike a window that creates its own device, this lets the
+  ///             windows of a platform share a context, and the textures
+  ///             that live in it.
+  ///
+  VulkanWindow(std::shared_ptr<VulkanApplication> application,
+               std::shared_ptr<VulkanDevice> device,
+               const sk_sp<GrDirectContext>& context,
+               fml::RefPtr<VulkanProcTable> proc_table,
+               std::unique_ptr<VulkanNativeSurface> native_surface,
+               bool render_to_surface,
+               const GrContextOptions& context_options);
 
   ~VulkanWindow();
 
@@ -58,18 +80,28 @@ class VulkanWindow {
 
   bool SwapBuffers();
 
+  // Incremented every time the swapchain is recreated. Surfaces acquired
+  // from an earlier generation of the swapchain are no longer in use.
+  size_t GetSwapchainGeneration() const;
+
  private:
   bool valid_;
+  size_t swapchain_generation_ = 0;
   fml::RefPtr<VulkanProcTable> vk;
-  std::unique_ptr<VulkanApplication> application_;
-  std::unique_ptr<VulkanDevice> logical_device_;
+  std::shared_ptr<VulkanApplication> application_;
+  std::shared_ptr<VulkanDevice> logical_device_;
   std::unique_ptr<VulkanSurface> surface_;
   std::unique_ptr<VulkanSwapchain> swapchain_;
   sk_sp<GrDirectContext> skia_gr_context_;
 
-  bool CreateSkiaGrContext();
+  void SetUpSurface(std::unique_ptr<VulkanNativeSurface> native_surface,
+                    bool render_to_surface,
+                    const GrContextOptions& context_options);
+
+  bool CreateSkiaGrContext(const GrContextOptions& options);
 
-  bool CreateSkiaBackendContext(GrVkBackendContext* context);
+  bool CreateSkiaBackendContext(GrVkBackendContext* context,
+                                GrVkExtensions* extensions);
 
   [[nodiscard]] bool RecreateSwapchain();
 